@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include <limits>
 #include <set>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
@@ -11,29 +12,50 @@
 
 using namespace std;
 
+namespace {
+
+/// The depth stored for the objects never used.
+const unsigned int noDepth = std::numeric_limits<unsigned int>::max();
+
+/**
+ * \brief Return a vector that can be modified, copying \a shared first if it
+ * is still shared with another context.
+ */
+template <typename T>
+std::vector<T>& GetWritable(std::shared_ptr<std::vector<T>>& shared) {
+  if (!shared)
+    shared = std::make_shared<std::vector<T>>();
+  else if (shared.use_count() > 1)
+    shared = std::make_shared<std::vector<T>>(*shared);
+
+  return *shared;
+}
+
+}  // namespace
+
 namespace gd {
 
 void EventsCodeGenerationContext::InheritsFrom(
     const EventsCodeGenerationContext& parent_) {
   parent = &parent_;
 
+  // The identifiers and the vectors indexed by them are shared with the
+  // parent: they are copied only if the child modifies them.
+  if (!parent_.objectsIds) parent_.objectsIds = std::make_shared<ObjectsIds>();
+  objectsIds = parent_.objectsIds;
+  alreadyDeclaredObjectsLists = parent_.alreadyDeclaredObjectsLists;
+  depthOfLastUse = parent_.depthOfLastUse;
+
   // Objects lists declared by parent became "already declared" in the child
   // context.
-  alreadyDeclaredObjectsLists = parent_.alreadyDeclaredObjectsLists;
-  std::copy(parent_.objectsListsToBeDeclared.begin(),
-            parent_.objectsListsToBeDeclared.end(),
-            std::inserter(alreadyDeclaredObjectsLists,
-                          alreadyDeclaredObjectsLists.begin()));
-  std::copy(parent_.objectsListsWithoutPickingToBeDeclared.begin(),
-            parent_.objectsListsWithoutPickingToBeDeclared.end(),
-            std::inserter(alreadyDeclaredObjectsLists,
-                          alreadyDeclaredObjectsLists.begin()));
-  std::copy(parent_.emptyObjectsListsToBeDeclared.begin(),
-            parent_.emptyObjectsListsToBeDeclared.end(),
-            std::inserter(alreadyDeclaredObjectsLists,
-                          alreadyDeclaredObjectsLists.begin()));
+  for (const gd::String& objectName : parent_.objectsListsToBeDeclared)
+    SetObjectDeclared(objectName);
+  for (const gd::String& objectName :
+       parent_.objectsListsWithoutPickingToBeDeclared)
+    SetObjectDeclared(objectName);
+  for (const gd::String& objectName : parent_.emptyObjectsListsToBeDeclared)
+    SetObjectDeclared(objectName);
 
-  depthOfLastUse = parent_.depthOfLastUse;
   customConditionDepth = parent_.customConditionDepth;
   contextDepth = parent_.GetContextDepth() + 1;
   if (parent_.maxDepthLevel) {
@@ -49,12 +71,80 @@ void EventsCodeGenerationContext::Reuse(
     contextDepth = parent_.GetContextDepth();  // Keep same context depth
 }
 
+std::size_t EventsCodeGenerationContext::GetObjectId(
+    const gd::String& objectName) const {
+  if (!objectsIds) objectsIds = std::make_shared<ObjectsIds>();
+
+  auto it = objectsIds->ids.find(objectName);
+  if (it != objectsIds->ids.end()) return it->second;
+
+  std::size_t id = objectsIds->names.size();
+  objectsIds->ids[objectName] = id;
+  objectsIds->names.push_back(objectName);
+  return id;
+}
+
+bool EventsCodeGenerationContext::FindObjectId(const gd::String& objectName,
+                                               std::size_t& id) const {
+  if (!objectsIds) return false;
+
+  auto it = objectsIds->ids.find(objectName);
+  if (it == objectsIds->ids.end()) return false;
+
+  id = it->second;
+  return true;
+}
+
+bool EventsCodeGenerationContext::ObjectAlreadyDeclared(
+    const gd::String& objectName) const {
+  std::size_t id = 0;
+  return FindObjectId(objectName, id) && alreadyDeclaredObjectsLists &&
+         id < alreadyDeclaredObjectsLists->size() &&
+         (*alreadyDeclaredObjectsLists)[id];
+}
+
+void EventsCodeGenerationContext::SetObjectDeclared(
+    const gd::String& objectName) {
+  if (ObjectAlreadyDeclared(objectName)) return;
+
+  std::size_t id = GetObjectId(objectName);
+  std::vector<bool>& alreadyDeclared =
+      GetWritable(alreadyDeclaredObjectsLists);
+  if (id >= alreadyDeclared.size()) alreadyDeclared.resize(id + 1, false);
+  alreadyDeclared[id] = true;
+}
+
+std::set<gd::String>
+EventsCodeGenerationContext::GetObjectsListsAlreadyDeclared() const {
+  std::set<gd::String> alreadyDeclared;
+  if (!alreadyDeclaredObjectsLists) return alreadyDeclared;
+
+  for (std::size_t id = 0; id < alreadyDeclaredObjectsLists->size(); ++id) {
+    if ((*alreadyDeclaredObjectsLists)[id])
+      alreadyDeclared.insert(objectsIds->names[id]);
+  }
+
+  return alreadyDeclared;
+}
+
+void EventsCodeGenerationContext::SetDepthOfLastUse(
+    const gd::String& objectName) {
+  std::size_t id = GetObjectId(objectName);
+  if (depthOfLastUse && id < depthOfLastUse->size() &&
+      (*depthOfLastUse)[id] == GetContextDepth())
+    return;
+
+  std::vector<unsigned int>& depths = GetWritable(depthOfLastUse);
+  if (id >= depths.size()) depths.resize(id + 1, noDepth);
+  depths[id] = GetContextDepth();
+}
+
 void EventsCodeGenerationContext::ObjectsListNeeded(
     const gd::String& objectName) {
   if (!IsToBeDeclared(objectName))
     objectsListsToBeDeclared.insert(objectName);
 
-  depthOfLastUse[objectName] = GetContextDepth();
+  SetDepthOfLastUse(objectName);
 }
 
 void EventsCodeGenerationContext::ObjectsListWithoutPickingNeeded(
@@ -62,7 +152,7 @@ void EventsCodeGenerationContext::ObjectsListWithoutPickingNeeded(
   if (!IsToBeDeclared(objectName))
     objectsListsWithoutPickingToBeDeclared.insert(objectName);
 
-  depthOfLastUse[objectName] = GetContextDepth();
+  SetDepthOfLastUse(objectName);
 }
 
 void EventsCodeGenerationContext::EmptyObjectsListNeeded(
@@ -70,7 +160,7 @@ void EventsCodeGenerationContext::EmptyObjectsListNeeded(
   if (!IsToBeDeclared(objectName))
     emptyObjectsListsToBeDeclared.insert(objectName);
 
-  depthOfLastUse[objectName] = GetContextDepth();
+  SetDepthOfLastUse(objectName);
 }
 
 std::set<gd::String> EventsCodeGenerationContext::GetAllObjectsToBeDeclared()
@@ -87,7 +177,10 @@ std::set<gd::String> EventsCodeGenerationContext::GetAllObjectsToBeDeclared()
 
 unsigned int EventsCodeGenerationContext::GetLastDepthObjectListWasNeeded(
     const gd::String& name) const {
-  if (depthOfLastUse.count(name) != 0) return depthOfLastUse.find(name)->second;
+  std::size_t id = 0;
+  if (FindObjectId(name, id) && depthOfLastUse &&
+      id < depthOfLastUse->size() && (*depthOfLastUse)[id] != noDepth)
+    return (*depthOfLastUse)[id];
 
   std::cout << "WARNING: During code generation, the last depth of an object "
                "list was 0."
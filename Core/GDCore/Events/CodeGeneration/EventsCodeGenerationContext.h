@@ -5,9 +5,10 @@
  */
 #ifndef EVENTSCODEGENERATIONCONTEXT_H
 #define EVENTSCODEGENERATIONCONTEXT_H
-#include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include "GDCore/String.h"
 
 namespace gd {
@@ -22,6 +23,12 @@ namespace gd {
  * - If conditions are being generated, the context keeps track of the depth of
  * the conditions (see GetCurrentConditionDepth)
  * - You can also get the context depth of the last use of an object list.
+ *
+ * The objects lists already declared and the depths of their last use are
+ * stored in vectors indexed by identifiers given to the objects names, shared
+ * by all the contexts of a generation. These vectors are shared with the
+ * parent context until they are modified, so that creating a child context
+ * for each event does not copy them.
  */
 class GD_CORE_API EventsCodeGenerationContext {
   friend class EventsCodeGenerator;
@@ -137,17 +144,12 @@ class GD_CORE_API EventsCodeGenerationContext {
    * Return true if an object list has already been declared (or is going to be
    * declared).
    */
-  bool ObjectAlreadyDeclared(const gd::String& objectName) const {
-    return (alreadyDeclaredObjectsLists.find(objectName) !=
-            alreadyDeclaredObjectsLists.end());
-  };
+  bool ObjectAlreadyDeclared(const gd::String& objectName) const;
 
   /**
    * \brief Consider that \a objectName is now declared in the context.
    */
-  void SetObjectDeclared(const gd::String& objectName) {
-    alreadyDeclaredObjectsLists.insert(objectName);
-  }
+  void SetObjectDeclared(const gd::String& objectName);
 
   /**
    * Return all the objects lists which will be declared by the current context
@@ -184,9 +186,7 @@ class GD_CORE_API EventsCodeGenerationContext {
    * Return the objects lists which are already declared and can be used in the
    * current context without declaration.
    */
-  const std::set<gd::String>& GetObjectsListsAlreadyDeclared() const {
-    return alreadyDeclaredObjectsLists;
-  };
+  std::set<gd::String> GetObjectsListsAlreadyDeclared() const;
 
   /**
    * \brief Get the depth of the context that was in effect when \a objectName
@@ -243,9 +243,38 @@ class GD_CORE_API EventsCodeGenerationContext {
                emptyObjectsListsToBeDeclared.end();
   };
 
-  std::set<gd::String>
+  /**
+   * \brief The identifiers of the objects names, shared by a context and
+   * all the contexts inheriting from it.
+   */
+  struct ObjectsIds {
+    std::unordered_map<gd::String, std::size_t> ids;
+    std::vector<gd::String> names;  ///< The names, indexed by identifier.
+  };
+
+  /**
+   * \brief Return the identifier of \a objectName, giving it one if
+   * necessary.
+   */
+  std::size_t GetObjectId(const gd::String& objectName) const;
+
+  /**
+   * \brief Return true if \a objectName has an identifier, stored in \a id.
+   */
+  bool FindObjectId(const gd::String& objectName, std::size_t& id) const;
+
+  /**
+   * \brief Store that \a objectName was needed at the depth of the context.
+   */
+  void SetDepthOfLastUse(const gd::String& objectName);
+
+  mutable std::shared_ptr<ObjectsIds> objectsIds;  ///< Created by the first
+                                                   ///< context needing it.
+  std::shared_ptr<std::vector<bool>>
       alreadyDeclaredObjectsLists;  ///< Objects lists already needed in a
-                                    ///< parent context.
+                                    ///< parent context, indexed by object
+                                    ///< identifier. Shared with the parent
+                                    ///< until modified.
   std::set<gd::String>
       objectsListsToBeDeclared;  ///< Objects lists that will be declared in
                                  ///< this context.
@@ -260,8 +289,10 @@ class GD_CORE_API EventsCodeGenerationContext {
                                       ///< but not filled with scene's
                                       ///< objects and not filled with any
                                       ///< previously existing objects list.
-  std::map<gd::String, unsigned int>
-      depthOfLastUse;  ///< The context depth when an object was last used.
+  std::shared_ptr<std::vector<unsigned int>>
+      depthOfLastUse;  ///< The context depth when an object was last used,
+                       ///< indexed by object identifier. Shared with the
+                       ///< parent until modified.
   gd::String
       currentObject;  ///< The object being used by an action or condition.
   unsigned int contextDepth;  ///< The depth of the context : 0 for a newly
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <utility>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
 #include "GDCore/Events/CodeGeneration/ExpressionCodeGenerator.h"
 #include "GDCore/Events/CodeGeneration/ExpressionsCodeGeneration.h"
@@ -207,6 +208,62 @@ gd::String EventsCodeGenerator::GenerateCompoundOperatorCall(
          rhs + ")";
 }
 
+gd::String EventsCodeGenerator::GenerateSettersCall(
+    const gd::InstructionMetadata& instrInfos,
+    const vector<gd::String>& arguments,
+    const gd::String& objectPart,
+    std::size_t startFromArgument) {
+  std::vector<std::size_t> operatorsIndexes;
+  for (std::size_t i = startFromArgument;
+       i < instrInfos.parameters.size() && i < arguments.size();
+       ++i) {
+    if (instrInfos.parameters[i].type == "operator")
+      operatorsIndexes.push_back(i);
+  }
+
+  // Ensure that there is at least one parameter after each operator
+  const auto& settersAndGetters =
+      instrInfos.codeExtraInformation.optionalSettersAndGetters;
+  if (operatorsIndexes.empty() || settersAndGetters.empty() ||
+      operatorsIndexes.back() + 1 >= arguments.size()) {
+    ReportError();
+    return "";
+  }
+
+  // The operators being known at compile time, generate directly the
+  // operations instead of passing the operators to a function.
+  gd::String calls;
+  for (std::size_t i = 0; i < settersAndGetters.size(); ++i) {
+    std::size_t operatorIndex =
+        operatorsIndexes[std::min(i, operatorsIndexes.size() - 1)];
+
+    gd::String operatorStr = arguments[operatorIndex];
+    if (operatorStr.size() > 2)
+      operatorStr = operatorStr.substr(
+          1,
+          operatorStr.length() - 1 -
+              1);  // Operator contains quote which must be removed.
+
+    gd::String rhs = arguments[operatorIndex + 1];
+    gd::String value;
+    if (operatorStr == "=")
+      value = rhs;
+    else if (operatorStr == "+" || operatorStr == "-" || operatorStr == "*" ||
+             operatorStr == "/")
+      value = objectPart + settersAndGetters[i].second + "() " + operatorStr +
+              " (" + rhs + ")";
+    else {
+      ReportError();
+      return "";
+    }
+
+    if (!calls.empty()) calls += ";\n";
+    calls += objectPart + settersAndGetters[i].first + "(" + value + ")";
+  }
+
+  return calls;
+}
+
 gd::String EventsCodeGenerator::GenerateMutatorCall(
     const gd::InstructionMetadata& instrInfos,
     const vector<gd::String>& arguments,
@@ -282,16 +339,13 @@ gd::String EventsCodeGenerator::GenerateConditionCode(
   }
 
   // Insert code only parameters and be sure there is no lack of parameter.
-  while (condition.GetParameters().size() < instrInfos.parameters.size()) {
-    vector<gd::Expression> parameters = condition.GetParameters();
-    parameters.push_back(gd::Expression(""));
-    condition.SetParameters(parameters);
-  }
+  if (condition.GetParametersCount() < instrInfos.parameters.size())
+    condition.SetParametersCount(instrInfos.parameters.size());
 
   // Verify that there are not mismatch between object type in parameters
   for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
     if (ParameterMetadata::IsObject(instrInfos.parameters[pNb].type)) {
-      gd::String objectInParameter =
+      const gd::String& objectInParameter =
           condition.GetParameter(pNb).GetPlainString();
 
       if (!GetObjectsAndGroups().HasObjectNamed(objectInParameter) &&
@@ -411,15 +465,19 @@ gd::String EventsCodeGenerator::GenerateConditionCode(
 gd::String EventsCodeGenerator::GenerateConditionsListCode(
     gd::InstructionsList& conditions, EventsCodeGenerationContext& context) {
   gd::String outputCode;
+  AppendConditionsListCode(conditions, context, outputCode);
+  return outputCode;
+}
 
+void EventsCodeGenerator::AppendConditionsListCode(
+    gd::InstructionsList& conditions,
+    EventsCodeGenerationContext& context,
+    gd::String& outputCode) {
   for (std::size_t i = 0; i < conditions.size(); ++i)
     outputCode += GenerateBooleanInitializationToFalse(
         "condition" + gd::String::From(i) + "IsTrue", context);
 
   for (std::size_t cId = 0; cId < conditions.size(); ++cId) {
-    gd::InstructionMetadata instrInfos = MetadataProvider::GetConditionMetadata(
-        platform, conditions[cId].GetType());
-
     gd::String conditionCode =
         GenerateConditionCode(conditions[cId],
                               "condition" + gd::String::From(cId) + "IsTrue",
@@ -444,8 +502,6 @@ gd::String EventsCodeGenerator::GenerateConditionsListCode(
   }
 
   maxConditionsListsSize = std::max(maxConditionsListsSize, conditions.size());
-
-  return outputCode;
 }
 
 /**
@@ -466,16 +522,14 @@ gd::String EventsCodeGenerator::GenerateActionCode(
   }
 
   // Be sure there is no lack of parameter.
-  while (action.GetParameters().size() < instrInfos.parameters.size()) {
-    vector<gd::Expression> parameters = action.GetParameters();
-    parameters.push_back(gd::Expression(""));
-    action.SetParameters(parameters);
-  }
+  if (action.GetParametersCount() < instrInfos.parameters.size())
+    action.SetParametersCount(instrInfos.parameters.size());
 
   // Verify that there are not mismatch between object type in parameters
   for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
     if (ParameterMetadata::IsObject(instrInfos.parameters[pNb].type)) {
-      gd::String objectInParameter = action.GetParameter(pNb).GetPlainString();
+      const gd::String& objectInParameter =
+          action.GetParameter(pNb).GetPlainString();
       if (!GetObjectsAndGroups().HasObjectNamed(objectInParameter) &&
           !GetGlobalObjectsAndGroups().HasObjectNamed(objectInParameter) &&
           !GetObjectsAndGroups().GetObjectGroups().Has(objectInParameter) &&
@@ -575,18 +629,21 @@ gd::String EventsCodeGenerator::GenerateActionCode(
 gd::String EventsCodeGenerator::GenerateActionsListCode(
     gd::InstructionsList& actions, EventsCodeGenerationContext& context) {
   gd::String outputCode;
-  for (std::size_t aId = 0; aId < actions.size(); ++aId) {
-    gd::InstructionMetadata instrInfos =
-        MetadataProvider::GetActionMetadata(platform, actions[aId].GetType());
+  AppendActionsListCode(actions, context, outputCode);
+  return outputCode;
+}
 
+void EventsCodeGenerator::AppendActionsListCode(
+    gd::InstructionsList& actions,
+    EventsCodeGenerationContext& context,
+    gd::String& outputCode) {
+  for (std::size_t aId = 0; aId < actions.size(); ++aId) {
     gd::String actionCode = GenerateActionCode(actions[aId], context);
 
     outputCode += "{";
     if (!actions[aId].GetType().empty()) outputCode += actionCode;
     outputCode += "}";
   }
-
-  return outputCode;
 }
 
 gd::String EventsCodeGenerator::GenerateParameterCodes(
@@ -677,6 +734,7 @@ vector<gd::String> EventsCodeGenerator::GenerateParametersCodes(
     std::vector<std::pair<gd::String, gd::String> >*
         supplementaryParametersTypes) {
   vector<gd::String> arguments;
+  arguments.reserve(parametersInfo.size());
 
   gd::ParameterMetadataTools::IterateOverParameters(
       parameters,
@@ -691,7 +749,7 @@ vector<gd::String> EventsCodeGenerator::GenerateParametersCodes(
                                    context,
                                    lastObjectName,
                                    supplementaryParametersTypes);
-        arguments.push_back(argOutput);
+        arguments.push_back(std::move(argOutput));
       });
 
   return arguments;
@@ -702,6 +760,20 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   return ConvertToStringExplicit(behaviorName);
 }
 
+gd::String EventsCodeGenerator::GenerateFrameObjectsListDeclaration(
+    const gd::String& listName, const gd::String& initialization) {
+  // The list is taken from the lists kept by the runtime context, which is
+  // given back at the end of the scope, so that no memory is allocated once
+  // the lists are large enough.
+  gd::String declarationCode = "RuntimeContext::FrameObjectsList " +
+                               listName + "Frame(*runtimeContext" +
+                               (initialization.empty() ? "" : ", ") +
+                               initialization + ");\n";
+  declarationCode += "std::vector<RuntimeObject*> & " + listName + " = " +
+                     listName + "Frame.Get();\n";
+  return declarationCode;
+}
+
 gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     EventsCodeGenerationContext& context) {
   auto declareObjectList = [this](gd::String object,
@@ -727,8 +799,8 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
         GetObjectListName(object, *context.GetParentContext());
     declarationCode += "std::vector<RuntimeObject*> & " + objectListName +
                        "T = " + copiedListName + ";\n";
-    declarationCode += "std::vector<RuntimeObject*> " + objectListName + " = " +
-                       objectListName + "T;\n";
+    declarationCode += GenerateFrameObjectsListDeclaration(
+        objectListName, objectListName + "T");
     return declarationCode;
   };
 
@@ -736,10 +808,15 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   for (auto object : context.GetObjectsListsToBeDeclared()) {
     gd::String objectListDeclaration = "";
     if (!context.ObjectAlreadyDeclared(object)) {
-      objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) +
-                              " = runtimeContext->GetObjectsRawPointers(\"" +
-                              ConvertToString(object) + "\");\n";
+      // The identifier of the objects is resolved only once, when the
+      // compiled code is loaded, to avoid hashing the name at each frame.
+      gd::String typeIdName = ManObjListName(object) + "TypeId";
+      AddGlobalDeclaration("static const std::size_t " + typeIdName +
+                           " = RuntimeContext::GetObjectTypeId(\"" +
+                           ConvertToString(object) + "\");\n");
+
+      objectListDeclaration = GenerateFrameObjectsListDeclaration(
+          GetObjectListName(object, context), typeIdName);
       context.SetObjectDeclared(object);
     } else
       objectListDeclaration = declareObjectList(object, context);
@@ -749,8 +826,8 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   for (auto object : context.GetObjectsListsToBeDeclaredWithoutPicking()) {
     gd::String objectListDeclaration = "";
     if (!context.ObjectAlreadyDeclared(object)) {
-      objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) + ";\n";
+      objectListDeclaration =
+          GenerateFrameObjectsListDeclaration(GetObjectListName(object, context));
       context.SetObjectDeclared(object);
     } else
       objectListDeclaration = declareObjectList(object, context);
@@ -760,12 +837,12 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   for (auto object : context.GetObjectsListsToBeDeclaredEmpty()) {
     gd::String objectListDeclaration = "";
     if (!context.ObjectAlreadyDeclared(object)) {
-      objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) + ";\n";
+      objectListDeclaration =
+          GenerateFrameObjectsListDeclaration(GetObjectListName(object, context));
       context.SetObjectDeclared(object);
     } else
-      objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) + ";\n";
+      objectListDeclaration =
+          GenerateFrameObjectsListDeclaration(GetObjectListName(object, context));
 
     declarationsCode += objectListDeclaration + "\n";
   }
@@ -773,12 +850,140 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   return declarationsCode;
 }
 
+gd::String EventsCodeGenerator::GenerateLoopObjectsDeclarationCode(
+    EventsCodeGenerationContext& context,
+    const std::set<gd::String>& repickedObjects,
+    gd::String& refillCode) {
+  // The lists are declared before the loop, so that they are acquired only
+  // once from the runtime context, and filled again in place (keeping their
+  // memory) only when the iteration can pick other objects.
+  auto declareObjectList = [this, &repickedObjects, &refillCode](
+                               gd::String object,
+                               gd::EventsCodeGenerationContext& context,
+                               bool refill) {
+    gd::String objectListName = GetObjectListName(object, context);
+    if (!context.GetParentContext()) {
+      std::cout << "ERROR: During code generation, a context tried to use an "
+                   "already declared object list without having a parent"
+                << std::endl;
+      return "/* Could not declare " + objectListName + " */";
+    }
+
+    if (context.IsSameObjectsList(object, *context.GetParentContext()))
+      return "/* Reuse " + objectListName + " */";
+
+    gd::String declarationCode;
+    gd::String copiedListName =
+        GetObjectListName(object, *context.GetParentContext());
+    declarationCode += "std::vector<RuntimeObject*> & " + objectListName +
+                       "T = " + copiedListName + ";\n";
+    if (refill || repickedObjects.count(object) != 0) {
+      declarationCode += GenerateFrameObjectsListDeclaration(objectListName);
+      refillCode += objectListName + ".assign(" + objectListName +
+                    "T.begin(), " + objectListName + "T.end());\n";
+    } else {
+      declarationCode += GenerateFrameObjectsListDeclaration(
+          objectListName, objectListName + "T");
+    }
+    return declarationCode;
+  };
+
+  gd::String declarationsCode;
+  for (auto object : context.GetObjectsListsToBeDeclared()) {
+    gd::String objectListDeclaration = "";
+    if (!context.ObjectAlreadyDeclared(object)) {
+      // The instances can be created or deleted by the iterations: they are
+      // always picked again.
+      gd::String typeIdName = ManObjListName(object) + "TypeId";
+      AddGlobalDeclaration("static const std::size_t " + typeIdName +
+                           " = RuntimeContext::GetObjectTypeId(\"" +
+                           ConvertToString(object) + "\");\n");
+
+      gd::String objectListName = GetObjectListName(object, context);
+      objectListDeclaration =
+          GenerateFrameObjectsListDeclaration(objectListName);
+      refillCode += "runtimeContext->GetObjectsRawPointers(" + typeIdName +
+                    ", " + objectListName + ");\n";
+      context.SetObjectDeclared(object);
+    } else
+      objectListDeclaration = declareObjectList(object, context, false);
+
+    declarationsCode += objectListDeclaration + "\n";
+  }
+  for (auto object : context.GetObjectsListsToBeDeclaredWithoutPicking()) {
+    gd::String objectListDeclaration = "";
+    if (!context.ObjectAlreadyDeclared(object)) {
+      gd::String objectListName = GetObjectListName(object, context);
+      objectListDeclaration =
+          GenerateFrameObjectsListDeclaration(objectListName);
+      refillCode += objectListName + ".clear();\n";
+      context.SetObjectDeclared(object);
+    } else
+      objectListDeclaration = declareObjectList(object, context, true);
+
+    declarationsCode += objectListDeclaration + "\n";
+  }
+  for (auto object : context.GetObjectsListsToBeDeclaredEmpty()) {
+    gd::String objectListName = GetObjectListName(object, context);
+    if (!context.ObjectAlreadyDeclared(object))
+      context.SetObjectDeclared(object);
+
+    declarationsCode +=
+        GenerateFrameObjectsListDeclaration(objectListName) + "\n";
+    refillCode += objectListName + ".clear();\n";
+  }
+
+  return declarationsCode;
+}
+
+std::set<gd::String> EventsCodeGenerator::GetObjectsPickedInLoop(
+    const std::set<gd::String>& objectsNeededByConditions,
+    const gd::InstructionsList& actions,
+    const EventsCodeGenerationContext& context) const {
+  std::set<gd::String> pickedObjects = objectsNeededByConditions;
+  for (std::size_t i = 0; i < actions.size(); ++i) {
+    const gd::Instruction& action = actions[i];
+    const gd::InstructionMetadata& instrInfos =
+        MetadataProvider::GetActionMetadata(platform, action.GetType());
+
+    // Actions with a custom code generator can pick any of their objects.
+    bool customCodeGenerator =
+        instrInfos.codeExtraInformation.HasCustomCodeGenerator();
+    for (std::size_t pNb = 0; pNb < instrInfos.parameters.size() &&
+                              pNb < action.GetParametersCount();
+         ++pNb) {
+      const gd::String& type = instrInfos.parameters[pNb].type;
+      if ((customCodeGenerator && ParameterMetadata::IsObject(type)) ||
+          type == "objectList" || type == "objectListWithoutPicking") {
+        for (const gd::String& object : ExpandObjectsName(
+                 action.GetParameter(pNb).GetPlainString(), context))
+          pickedObjects.insert(object);
+      }
+    }
+
+    std::set<gd::String> subInstructionsObjects = GetObjectsPickedInLoop(
+        std::set<gd::String>(), action.GetSubInstructions(), context);
+    pickedObjects.insert(subInstructionsObjects.begin(),
+                         subInstructionsObjects.end());
+  }
+
+  return pickedObjects;
+}
+
 /**
  * Generate events list code.
  */
 gd::String EventsCodeGenerator::GenerateEventsListCode(
-    gd::EventsList& events, const EventsCodeGenerationContext& parentContext) {
+    gd::EventsList& events, const EventsCodeGenerationContext& context) {
   gd::String output;
+  AppendEventsListCode(events, context, output);
+  return output;
+}
+
+void EventsCodeGenerator::AppendEventsListCode(
+    gd::EventsList& events,
+    const EventsCodeGenerationContext& parentContext,
+    gd::String& output) {
   for (std::size_t eId = 0; eId < events.size(); ++eId) {
     // Each event has its own context : Objects picked in an event are totally
     // different than the one picked in another.
@@ -803,11 +1008,28 @@ gd::String EventsCodeGenerator::GenerateEventsListCode(
     gd::String scopeEnd = GenerateScopeEnd(context);
     gd::String declarationsCode = GenerateObjectsDeclarationCode(context);
 
-    output += "\n" + scopeBegin + "\n" + declarationsCode + "\n" +
-              eventCoreCode + "\n" + scopeEnd + "\n";
-  }
+    // Measure the time spent in the events of the root list.
+    gd::String profilerSection;
+    if (parentContext.GetParentContext() == nullptr) {
+      auto profilerId = rootEventsProfilerIds.find(&events[eId]);
+      if (profilerId != rootEventsProfilerIds.end())
+        profilerSection = "Event #" + gd::String::From(profilerId->second + 1);
+    }
 
-  return output;
+    output += "\n";
+    if (!profilerSection.empty())
+      output += GenerateProfilerSectionBegin(profilerSection) + "\n";
+    output += scopeBegin;
+    output += "\n";
+    output += declarationsCode;
+    output += "\n";
+    output += eventCoreCode;
+    output += "\n";
+    output += scopeEnd;
+    output += "\n";
+    if (!profilerSection.empty())
+      output += GenerateProfilerSectionEnd(profilerSection) + "\n";
+  }
 }
 
 gd::String EventsCodeGenerator::ConvertToString(gd::String plainString) {
@@ -828,35 +1050,47 @@ std::vector<gd::String> EventsCodeGenerator::ExpandObjectsName(
     const gd::String& objectName,
     const EventsCodeGenerationContext& context) const {
   // Note: this logic is duplicated in EventsContextAnalyzer::ExpandObjectsName
-  std::vector<gd::String> realObjects;
-  if (globalObjectsAndGroups.GetObjectGroups().Has(objectName))
-    realObjects = globalObjectsAndGroups.GetObjectGroups()
-                      .Get(objectName)
-                      .GetAllObjectsNames();
-  else if (objectsAndGroups.GetObjectGroups().Has(objectName))
-    realObjects =
-        objectsAndGroups.GetObjectGroups().Get(objectName).GetAllObjectsNames();
-  else
-    realObjects.push_back(objectName);
-
-  // If current object is present, use it and only it.
-  if (find(realObjects.begin(),
-           realObjects.end(),
-           context.GetCurrentObject()) != realObjects.end()) {
-    realObjects.clear();
-    realObjects.push_back(context.GetCurrentObject());
-  }
-
-  // Ensure that all returned objects actually exists.
-  for (std::size_t i = 0; i < realObjects.size();) {
-    if (!objectsAndGroups.HasObjectNamed(realObjects[i]) &&
-        !globalObjectsAndGroups.HasObjectNamed(realObjects[i]))
-      realObjects.erase(realObjects.begin() + i);
+  auto it = expandedObjectsNames.find(objectName);
+  if (it == expandedObjectsNames.end()) {
+    // Groups are expanded only the first time they are used, as they can be
+    // used by a lot of instructions and have a lot of objects.
+    std::vector<gd::String> realObjects;
+    if (globalObjectsAndGroups.GetObjectGroups().Has(objectName))
+      realObjects = globalObjectsAndGroups.GetObjectGroups()
+                        .Get(objectName)
+                        .GetAllObjectsNames();
+    else if (objectsAndGroups.GetObjectGroups().Has(objectName))
+      realObjects = objectsAndGroups.GetObjectGroups()
+                        .Get(objectName)
+                        .GetAllObjectsNames();
     else
-      ++i;
+      realObjects.push_back(objectName);
+
+    ExpandedObjectsName expanded;
+    for (auto& realObject : realObjects) {
+      if (objectsAndGroups.HasObjectNamed(realObject) ||
+          globalObjectsAndGroups.HasObjectNamed(realObject))
+        expanded.existingObjects.push_back(realObject);
+      else
+        expanded.missingObjects.push_back(realObject);
+    }
+
+    it = expandedObjectsNames.emplace(objectName, std::move(expanded)).first;
   }
 
-  return realObjects;
+  // If current object is present, use it and only it (if it actually exists).
+  const ExpandedObjectsName& expanded = it->second;
+  const gd::String& currentObject = context.GetCurrentObject();
+  if (find(expanded.existingObjects.begin(),
+           expanded.existingObjects.end(),
+           currentObject) != expanded.existingObjects.end())
+    return std::vector<gd::String>(1, currentObject);
+  if (find(expanded.missingObjects.begin(),
+           expanded.missingObjects.end(),
+           currentObject) != expanded.missingObjects.end())
+    return std::vector<gd::String>();
+
+  return expanded.existingObjects;
 }
 
 void EventsCodeGenerator::DeleteUselessEvents(gd::EventsList& events) {
@@ -879,12 +1113,124 @@ void EventsCodeGenerator::PreprocessEventList(gd::EventsList& listEvent) {
     if (i <
         listEvent.GetEventsCount()) {  // Be sure that that there is still an
                                        // event! ( Preprocess can remove it. )
+      if (!listEvent[i].IsDisabled() &&
+          !FoldConstantConditions(listEvent[i])) {
+        // The event can never be run: don't generate any code for it.
+        listEvent.RemoveEvent(i);
+        --i;
+        continue;
+      }
+
       if (listEvent[i].CanHaveSubEvents())
         PreprocessEventList(listEvent[i].GetSubEvents());
     }
   }
 }
 
+namespace {
+gd::String TrimSpaces(const gd::String& expression) {
+  const std::string& raw = expression.Raw();
+  std::size_t begin = raw.find_first_not_of(" \t\n\r");
+  if (begin == std::string::npos) return "";
+
+  std::size_t end = raw.find_last_not_of(" \t\n\r");
+  return gd::String::FromUTF8(raw.substr(begin, end - begin + 1));
+}
+
+bool IsNumberLiteral(const gd::String& expression) {
+  const std::string& raw = expression.Raw();
+  std::size_t i = 0;
+  if (i < raw.size() && raw[i] == '-') i++;
+
+  bool digitFound = false, dotFound = false;
+  for (; i < raw.size(); ++i) {
+    if (raw[i] >= '0' && raw[i] <= '9')
+      digitFound = true;
+    else if (raw[i] == '.' && !dotFound)
+      dotFound = true;
+    else
+      return false;
+  }
+
+  return digitFound;
+}
+
+bool IsTextLiteral(const gd::String& expression) {
+  const std::string& raw = expression.Raw();
+  if (raw.size() < 2 || raw.front() != '"' || raw.back() != '"') return false;
+
+  // Escaped characters and concatenations are not handled.
+  return raw.find_first_of("\"\\", 1) == raw.size() - 1;
+}
+
+template <typename T>
+bool Compare(const T& lhs, const gd::String& relationalOperator, const T& rhs) {
+  if (relationalOperator == ">") return lhs > rhs;
+  if (relationalOperator == "<") return lhs < rhs;
+  if (relationalOperator == ">=") return lhs >= rhs;
+  if (relationalOperator == "<=") return lhs <= rhs;
+  if (relationalOperator == "!=") return lhs != rhs;
+  return lhs == rhs;
+}
+
+/**
+ * \brief Return 1 if the condition is always true, 0 if it is always false,
+ * and -1 if its value is not known before running the game.
+ */
+int EvaluateConstantCondition(const gd::Instruction& condition) {
+  bool value;
+  const gd::String& type = condition.GetType();
+  if (type == "Toujours") {
+    value = true;
+  } else if ((type == "Egal" || type == "StrEqual") &&
+             condition.GetParametersCount() >= 3) {
+    gd::String lhs = TrimSpaces(condition.GetParameter(0).GetPlainString());
+    gd::String relationalOperator =
+        TrimSpaces(condition.GetParameter(1).GetPlainString());
+    gd::String rhs = TrimSpaces(condition.GetParameter(2).GetPlainString());
+    if (relationalOperator != "" && relationalOperator != "=" &&
+        relationalOperator != ">" && relationalOperator != "<" &&
+        relationalOperator != ">=" && relationalOperator != "<=" &&
+        relationalOperator != "!=")
+      return -1;
+
+    if (type == "Egal" && IsNumberLiteral(lhs) && IsNumberLiteral(rhs))
+      value = Compare(lhs.To<double>(), relationalOperator, rhs.To<double>());
+    else if (type == "StrEqual" && IsTextLiteral(lhs) && IsTextLiteral(rhs) &&
+             (relationalOperator == "=" || relationalOperator == "!="))
+      value = Compare(lhs.Raw(), relationalOperator, rhs.Raw());
+    else
+      return -1;
+  } else {
+    return -1;
+  }
+
+  return condition.IsInverted() ? !value : value;
+}
+}  // namespace
+
+bool EventsCodeGenerator::FoldConstantConditions(gd::BaseEvent& event) {
+  // Other events can use their conditions in a different way (for example in
+  // a loop), so only standard events are changed.
+  gd::StandardEvent* standardEvent = dynamic_cast<gd::StandardEvent*>(&event);
+  if (!standardEvent) return true;
+
+  gd::InstructionsList& conditions = standardEvent->GetConditions();
+  for (std::size_t i = 0; i < conditions.size();) {
+    int value = EvaluateConstantCondition(conditions[i]);
+    if (value == 0) return false;
+
+    // Conditions of an event are all true for the event to be run: a
+    // condition always true can be removed.
+    if (value == 1)
+      conditions.Remove(i);
+    else
+      ++i;
+  }
+
+  return true;
+}
+
 void EventsCodeGenerator::ReportError() { errorOccurred = true; }
 
 gd::String EventsCodeGenerator::GenerateObjectFunctionCall(
@@ -1055,6 +1401,9 @@ gd::String EventsCodeGenerator::GenerateObjectAction(
           instrInfos.codeExtraInformation.functionCallName,
           instrInfos.codeExtraInformation.optionalAssociatedInstruction,
           2);
+    else if (instrInfos.codeExtraInformation.accessType ==
+             gd::InstructionMetadata::ExtraInformation::SettersAndGetters)
+      call = GenerateSettersCall(instrInfos, arguments, "", 1);
     else
       call = GenerateCompoundOperatorCall(
           instrInfos,
@@ -1116,6 +1465,20 @@ gd::String EventsCodeGenerator::GetObjectListName(
   return ManObjListName(name);
 }
 
+gd::String EventsCodeGenerator::GenerateFreeFunctionCall(
+    const std::vector<gd::String>& arguments,
+    const gd::ExpressionMetadata& expressionMetadata,
+    gd::EventsCodeGenerationContext& context) {
+  gd::String argumentsStr;
+  for (std::size_t i = 0; i < arguments.size(); ++i) {
+    if (i != 0) argumentsStr += ", ";
+    argumentsStr += arguments[i];
+  }
+
+  return expressionMetadata.codeExtraInformation.functionCallName + "(" +
+         argumentsStr + ")";
+}
+
 gd::String EventsCodeGenerator::GenerateArgumentsList(
     const std::vector<gd::String>& arguments, size_t startFrom) {
   gd::String argumentsStr;
@@ -6,7 +6,9 @@
 #ifndef GDCORE_EVENTSCODEGENERATOR_H
 #define GDCORE_EVENTSCODEGENERATOR_H
 
+#include <map>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "GDCore/Events/Event.h"
@@ -25,6 +27,7 @@ class BehaviorMetadata;
 class InstructionMetadata;
 class EventsCodeGenerationContext;
 class ExpressionCodeGenerationInformation;
+class ExpressionMetadata;
 class InstructionMetadata;
 class Platform;
 }  // namespace gd
@@ -68,19 +71,52 @@ class GD_CORE_API EventsCodeGenerator {
    * \brief Preprocess an events list (replacing for example links with the
    * linked events).
    *
+   * The conditions of standard events that are constant are also folded (see
+   * FoldConstantConditions).
+   *
    * This should be called before any code generation.
    */
   void PreprocessEventList(gd::EventsList& listEvent);
 
+  /**
+   * \brief Remove from the conditions of a standard event the ones that are
+   * always true ("Always", or comparisons of two numbers or two texts written
+   * as literals).
+   *
+   * \return false if a condition of the event is always false, meaning that
+   * the event (and its sub events) can never be run and can be removed. true
+   * otherwise (including for events that are not standard events, which are
+   * not changed).
+   */
+  static bool FoldConstantConditions(gd::BaseEvent& event);
+
   /**
    * \brief Generate code for executing an event list
    *
    * \param events std::vector of events
    * \param context Context used for generation
    * \return Code
+   *
+   * \see AppendEventsListCode
    */
-  virtual gd::String GenerateEventsListCode(
-      gd::EventsList& events, const EventsCodeGenerationContext& context);
+  gd::String GenerateEventsListCode(gd::EventsList& events,
+                                    const EventsCodeGenerationContext& context);
+
+  /**
+   * \brief Generate code for executing an event list, and append it to the
+   * given output.
+   *
+   * Prefer this to GenerateEventsListCode when the code is part of the code of
+   * a parent event: the code of sub events is then written once, instead of
+   * being copied at each level of nesting.
+   *
+   * \param events std::vector of events
+   * \param context Context used for generation
+   * \param output The code to which the generated code is appended.
+   */
+  virtual void AppendEventsListCode(gd::EventsList& events,
+                                    const EventsCodeGenerationContext& context,
+                                    gd::String& output);
 
   /**
    * \brief Generate code for executing a condition list
@@ -94,9 +130,21 @@ class GD_CORE_API EventsCodeGenerator {
    * \param context Context used for generation
    * \return Code. Boolean containing conditions result are name
    * conditionXIsTrue, with X = the number of the condition, starting from 0.
+   *
+   * \see AppendConditionsListCode
+   */
+  gd::String GenerateConditionsListCode(gd::InstructionsList& conditions,
+                                        EventsCodeGenerationContext& context);
+
+  /**
+   * \brief Generate code for executing a condition list, and append it to the
+   * given output.
+   *
+   * \see GenerateConditionsListCode
    */
-  virtual gd::String GenerateConditionsListCode(
-      gd::InstructionsList& conditions, EventsCodeGenerationContext& context);
+  virtual void AppendConditionsListCode(gd::InstructionsList& conditions,
+                                        EventsCodeGenerationContext& context,
+                                        gd::String& output);
 
   /**
    * \brief Generate code for executing an action list
@@ -108,9 +156,21 @@ class GD_CORE_API EventsCodeGenerator {
    * \param actions std::vector of actions
    * \param context Context used for generation
    * \return Code
+   *
+   * \see AppendActionsListCode
    */
-  virtual gd::String GenerateActionsListCode(
-      gd::InstructionsList& actions, EventsCodeGenerationContext& context);
+  gd::String GenerateActionsListCode(gd::InstructionsList& actions,
+                                     EventsCodeGenerationContext& context);
+
+  /**
+   * \brief Generate code for executing an action list, and append it to the
+   * given output.
+   *
+   * \see GenerateActionsListCode
+   */
+  virtual void AppendActionsListCode(gd::InstructionsList& actions,
+                                     EventsCodeGenerationContext& context,
+                                     gd::String& output);
 
   /**
    * \brief Generate the code for a parameter of an action/condition/expression.
@@ -170,6 +230,56 @@ class GD_CORE_API EventsCodeGenerator {
   virtual gd::String GenerateObjectsDeclarationCode(
       EventsCodeGenerationContext& context);
 
+  /**
+   * \brief Generate the C++ code declaring a list of objects reused from one
+   * frame to another (see RuntimeContext::FrameObjectsList in GDCpp).
+   *
+   * \param listName The name of the list to be declared.
+   * \param initialization If not empty, the identifier of the objects
+   * (see RuntimeContext::GetObjectTypeId) or a list used to fill the list.
+   */
+  gd::String GenerateFrameObjectsListDeclaration(
+      const gd::String& listName, const gd::String& initialization = "");
+
+  /**
+   * \brief Generate code for declaring the objects lists of the context of a
+   * loop (a Repeat or While event), before the loop.
+   *
+   * Contrary to GenerateObjectsDeclarationCode, the lists are declared only
+   * once for all the iterations: only the lists that must be picked again at
+   * each iteration are filled by \a refillCode, to be inserted at the
+   * beginning of each iteration. These are the lists of \a repickedObjects,
+   * the lists of all the instances of the objects and the lists declared
+   * without picking or empty.
+   *
+   * \param context The context of the loop. Its lists can't be reused by the
+   * sub-events (see EventsCodeGenerationContext::ForbidReuse).
+   * \param repickedObjects The objects picked by the loop (see
+   * GetObjectsPickedInLoop).
+   * \param refillCode Filled with the code to be inserted at the beginning of
+   * each iteration.
+   */
+  virtual gd::String GenerateLoopObjectsDeclarationCode(
+      EventsCodeGenerationContext& context,
+      const std::set<gd::String>& repickedObjects,
+      gd::String& refillCode);
+
+  /**
+   * \brief Return the objects whose lists can be modified by an iteration of
+   * a loop, apart from its sub-events.
+   *
+   * \param objectsNeededByConditions The objects of the conditions of the loop,
+   * which can be filtered by them.
+   * \param actions The actions of the loop: the objects of their parameters
+   * of type "objectList" or "objectListWithoutPicking", and of the actions
+   * having a custom code generator, are added.
+   * \param context The context of the loop.
+   */
+  std::set<gd::String> GetObjectsPickedInLoop(
+      const std::set<gd::String>& objectsNeededByConditions,
+      const gd::InstructionsList& actions,
+      const EventsCodeGenerationContext& context) const;
+
   /**
    * \brief Must convert a plain string ( with line feed, quotes ) to a string
    that can be inserted into code.
@@ -331,6 +441,9 @@ class GD_CORE_API EventsCodeGenerator {
    * "current" object in the context ( i.e: The object being used for launching
    * an action... ), none of the two rules below apply, and the list will only
    * contains the context "current" object name.
+   *
+   * \note The groups are expanded once for the whole code generation: the
+   * groups and objects must not be changed while the code is generated.
    */
   std::vector<gd::String> ExpandObjectsName(
       const gd::String& objectName,
@@ -396,6 +509,18 @@ class GD_CORE_API EventsCodeGenerator {
     return "";
   };
 
+  /**
+   * \brief Set the identifiers of the events of the root events list, so that
+   * the time spent in each of these events is measured by a profiler section
+   * called "Event #" followed by the identifier of the event plus one.
+   *
+   * The events without an identifier are not measured.
+   */
+  void SetRootEventsProfilerIds(
+      const std::map<const gd::BaseEvent*, std::size_t>& ids) {
+    rootEventsProfilerIds = ids;
+  };
+
   /**
    * \brief Get the namespace to be used to store code generated
    * objects/values/functions, with the extra "dot" at the end to be used to
@@ -504,12 +629,65 @@ class GD_CORE_API EventsCodeGenerator {
     return ".getChild(" + expressionCode + ")";
   };
 
+  /**
+   * \brief Generate the code to get a child of a variable, using a list of
+   * children names known when the code is generated (for example, `b` and `c`
+   * for `MyVariable.b.c`).
+   *
+   * By default, GenerateVariableAccessor is used for each child. Platforms can
+   * override this to resolve the path once instead of searching for each
+   * child every time the code is run.
+   *
+   * \param variableCode The code to get the variable, returned by
+   * GenerateGetVariable.
+   */
+  virtual gd::String GenerateVariableChildrenAccessor(
+      const gd::String& variableCode,
+      const std::vector<gd::String>& childrenNames,
+      const VariableScope& scope) {
+    gd::String output = variableCode;
+    for (auto& childName : childrenNames)
+      output += GenerateVariableAccessor(childName);
+
+    return output;
+  };
+
   /**
    * \brief Generate the code to reference a variable which is
    * in an empty/null state.
    */
   virtual gd::String GenerateBadVariable() { return "fakeBadVariable"; }
 
+  /**
+   * \brief Declare a new temporary, used to evaluate only once a sub expression
+   * used several times in an expression.
+   *
+   * \param type The type of the sub expression ("number" or "string").
+   * \return The name of the temporary, or an empty string if temporaries are
+   * not supported (the default), in which case the sub expression is generated
+   * each time it is used.
+   * \see GenerateExpressionWithTemporaries
+   */
+  virtual gd::String GenerateExpressionTemporary(const gd::String& type) {
+    return "";
+  }
+
+  /**
+   * \brief Generate the code of an expression using temporaries.
+   *
+   * \param type The type of the expression ("number" or "string").
+   * \param temporaries The names of the temporaries (declared with
+   * GenerateExpressionTemporary) and the code of their sub expressions,
+   * which must be evaluated in this order before the expression.
+   * \param expressionCode The code of the expression.
+   */
+  virtual gd::String GenerateExpressionWithTemporaries(
+      const gd::String& type,
+      const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+      const gd::String& expressionCode) {
+    return expressionCode;
+  }
+
   /**
    * \brief Generate the code to reference an object.
    * \param objectName the name of the object.
@@ -549,6 +727,20 @@ class GD_CORE_API EventsCodeGenerator {
       gd::String defaultOutput,
       gd::EventsCodeGenerationContext& context);
 
+  /**
+   * \brief Call a free function (i.e: not related to an object or a behavior)
+   * from an expression.
+   *
+   * \param arguments The code already generated for the arguments
+   * \param expressionMetadata Metadata about the function being called.
+   * \param context The context : May be used to get information about the
+   * current scope.
+   */
+  virtual gd::String GenerateFreeFunctionCall(
+      const std::vector<gd::String>& arguments,
+      const gd::ExpressionMetadata& expressionMetadata,
+      gd::EventsCodeGenerationContext& context);
+
   /**
    * \brief Call a function of a behavior of the current object.
    * \note The current object is the object being manipulated by a condition or
@@ -685,6 +877,21 @@ class GD_CORE_API EventsCodeGenerator {
                                  const gd::String& callStartString,
                                  std::size_t startFromArgument = 0);
 
+  /**
+   * \brief Generate the calls to the setters declared with
+   * gd::InstructionMetadata::ExtraInformation::SetSettersAndGetters, the
+   * operators being inlined in the code.
+   *
+   * \param objectPart The string to be placed before the setters and getters.
+   * Example: MyObject->
+   * \return The calls, separated by a semicolon and a new line (but without
+   * the ending semicolon).
+   */
+  gd::String GenerateSettersCall(const gd::InstructionMetadata& instrInfos,
+                                 const std::vector<gd::String>& arguments,
+                                 const gd::String& objectPart,
+                                 std::size_t startFromArgument = 0);
+
   /**
    * \brief Return the "true" keyword in the target language.
    */
@@ -736,6 +943,20 @@ class GD_CORE_API EventsCodeGenerator {
   size_t maxCustomConditionsDepth;  ///< The maximum depth value for all the
                                     ///< custom conditions created.
   size_t maxConditionsListsSize;  ///< The maximum size of a list of conditions.
+  std::map<const gd::BaseEvent*, std::size_t>
+      rootEventsProfilerIds;  ///< See SetRootEventsProfilerIds.
+
+  /**
+   * \brief The objects of a group (or the object itself), found by
+   * ExpandObjectsName.
+   */
+  struct ExpandedObjectsName {
+    std::vector<gd::String> existingObjects;
+    std::vector<gd::String> missingObjects;  ///< The names of the group which
+                                             ///< are not objects.
+  };
+  mutable std::unordered_map<gd::String, ExpandedObjectsName>
+      expandedObjectsNames;  ///< The groups expanded by ExpandObjectsName.
 };
 
 }  // namespace gd
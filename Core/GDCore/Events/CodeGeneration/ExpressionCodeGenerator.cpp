@@ -10,6 +10,7 @@
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
 #include "GDCore/Events/Parsers/ExpressionParser2Node.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
@@ -35,6 +36,34 @@ namespace gd {
 
 bool ExpressionCodeGenerator::useOldExpressionParser = false;
 
+namespace {
+/**
+ * Parse the expression, reusing the tree of the same expression parsed before
+ * if the code is generated for a project.
+ */
+std::shared_ptr<gd::ExpressionNode> ParseExpression(
+    EventsCodeGenerator& codeGenerator,
+    const gd::String& type,
+    const gd::String& expression,
+    const gd::String& objectName = "") {
+  if (codeGenerator.HasProjectAndLayout()) {
+    return codeGenerator.GetProject()
+        .GetExpressionParser2Cache()
+        .ParseExpression(codeGenerator.GetPlatform(),
+                         codeGenerator.GetGlobalObjectsAndGroups(),
+                         codeGenerator.GetObjectsAndGroups(),
+                         type,
+                         expression,
+                         objectName);
+  }
+
+  gd::ExpressionParser2 parser(codeGenerator.GetPlatform(),
+                               codeGenerator.GetGlobalObjectsAndGroups(),
+                               codeGenerator.GetObjectsAndGroups());
+  return parser.ParseExpression(type, expression, objectName);
+}
+}  // namespace
+
 gd::String ExpressionCodeGenerator::GenerateExpressionCode(
     EventsCodeGenerator& codeGenerator,
     EventsCodeGenerationContext& context,
@@ -135,10 +164,7 @@ gd::String ExpressionCodeGenerator::GenerateExpressionCode(
   }
   // end of compatibility code
 
-  gd::ExpressionParser2 parser(codeGenerator.GetPlatform(),
-                               codeGenerator.GetGlobalObjectsAndGroups(),
-                               codeGenerator.GetObjectsAndGroups());
-  auto node = parser.ParseExpression(type, expression, objectName);
+  auto node = ParseExpression(codeGenerator, type, expression, objectName);
   gd::ExpressionValidator validator;
   node->Visit(validator);
 
@@ -151,11 +177,50 @@ gd::String ExpressionCodeGenerator::GenerateExpressionCode(
     return generator.GenerateDefaultValue(type);
   }
 
+  gd::ExpressionOptimizer optimizer;
+  node->Visit(optimizer);
+
+  // Results of functions are stored in temporaries evaluated before the
+  // expression, which is only possible for expressions giving a value.
+  Optimizations optimizations{optimizer, type == "number" || type == "string"};
+  generator.optimizations = &optimizations;
   node->Visit(generator);
-  return generator.GetOutput();
+
+  if (optimizations.temporaries.empty()) return generator.GetOutput();
+  return codeGenerator.GenerateExpressionWithTemporaries(
+      type, optimizations.temporaries, generator.GetOutput());
+}
+
+gd::String ExpressionCodeGenerator::GenerateConstant(
+    const ExpressionNode& node) {
+  return GenerateConstant(*optimizations->optimizer.GetConstant(node));
+}
+
+gd::String ExpressionCodeGenerator::GenerateConstant(
+    const ExpressionOptimizer::Constant& constant) {
+  if (constant.isText)
+    return codeGenerator.ConvertToStringExplicit(constant.text);
+
+  gd::String number = ExpressionOptimizer::NumberToString(constant.number);
+  return constant.number < 0 ? "(" + number + ")" : number;
 }
 
 void ExpressionCodeGenerator::OnVisitOperatorNode(OperatorNode& node) {
+  if (optimizations && optimizations->optimizer.GetConstant(node)) {
+    output += GenerateConstant(node);
+    return;
+  }
+  const ExpressionOptimizer::FoldedPrefix* foldedPrefix =
+      optimizations ? optimizations->optimizer.GetFoldedPrefix(node) : nullptr;
+  if (foldedPrefix) {
+    output += GenerateConstant(foldedPrefix->value);
+    output += " ";
+    output.push_back(foldedPrefix->rest->op);
+    output += " ";
+    foldedPrefix->rest->rightHandSide->Visit(*this);
+    return;
+  }
+
   node.leftHandSide->Visit(*this);
   output += " ";
   output.push_back(node.op);
@@ -165,6 +230,11 @@ void ExpressionCodeGenerator::OnVisitOperatorNode(OperatorNode& node) {
 
 void ExpressionCodeGenerator::OnVisitUnaryOperatorNode(
     UnaryOperatorNode& node) {
+  if (optimizations && optimizations->optimizer.GetConstant(node)) {
+    output += GenerateConstant(node);
+    return;
+  }
+
   output.push_back(node.op);
   output += "(";  // Add extra parenthesis to ensure that things like --2 are
                   // properly outputted as -(-2) (GDevelop don't have -- or ++
@@ -175,6 +245,11 @@ void ExpressionCodeGenerator::OnVisitUnaryOperatorNode(
 
 void ExpressionCodeGenerator::OnVisitSubExpressionNode(
     SubExpressionNode& node) {
+  if (optimizations && optimizations->optimizer.GetConstant(node)) {
+    output += GenerateConstant(node);
+    return;
+  }
+
   output += "(";
   node.expression->Visit(*this);
   output += ")";
@@ -198,9 +273,24 @@ void ExpressionCodeGenerator::OnVisitVariableNode(VariableNode& node) {
                  ? gd::EventsCodeGenerator::LAYOUT_VARIABLE
                  : gd::EventsCodeGenerator::OBJECT_VARIABLE);
 
-  output += codeGenerator.GenerateGetVariable(
+  gd::String variableCode = codeGenerator.GenerateGetVariable(
       node.name, scope, context, node.objectName);
-  if (node.child) node.child->Visit(*this);
+
+  // The children accessed by their names (until a child accessed with an
+  // expression) are generated at once, so that the path can be resolved only
+  // once by the platform.
+  std::vector<gd::String> childrenNames;
+  ExpressionNode* child = node.child.get();
+  while (auto accessor = dynamic_cast<VariableAccessorNode*>(child)) {
+    childrenNames.push_back(accessor->name);
+    child = accessor->child.get();
+  }
+
+  output += childrenNames.empty()
+                ? variableCode
+                : codeGenerator.GenerateVariableChildrenAccessor(
+                      variableCode, childrenNames, scope);
+  if (child) child->Visit(*this);
 }
 
 void ExpressionCodeGenerator::OnVisitVariableAccessorNode(
@@ -212,6 +302,7 @@ void ExpressionCodeGenerator::OnVisitVariableAccessorNode(
 void ExpressionCodeGenerator::OnVisitVariableBracketAccessorNode(
     VariableBracketAccessorNode& node) {
   ExpressionCodeGenerator generator(codeGenerator, context);
+  generator.optimizations = optimizations;
   node.expression->Visit(generator);
   output +=
       codeGenerator.GenerateVariableBracketAccessor(generator.GetOutput());
@@ -231,28 +322,56 @@ void ExpressionCodeGenerator::OnVisitIdentifierNode(IdentifierNode& node) {
 }
 
 void ExpressionCodeGenerator::OnVisitFunctionNode(FunctionNode& node) {
-  if (gd::MetadataProvider::IsBadExpressionMetadata(node.expressionMetadata)) {
-    output += "/* Error during generation, function not found: " +
-              codeGenerator.ConvertToString(node.functionName) + " for type " +
-              node.type + " */ " + GenerateDefaultValue(node.type);
+  if (!optimizations || !optimizations->reuseResults ||
+      !optimizations->optimizer.IsResultReusable(node)) {
+    output += GenerateFunctionCode(node);
+    return;
+  }
+
+  // The function is called several times: its result is evaluated once in
+  // a temporary, used by all the calls.
+  gd::String key = ExpressionOptimizer::GetFunctionKey(node);
+  auto it = optimizations->temporariesNames.find(key);
+  if (it != optimizations->temporariesNames.end()) {
+    output += it->second;
+    return;
+  }
+
+  gd::String code = GenerateFunctionCode(node);
+  gd::String temporary = codeGenerator.GenerateExpressionTemporary(node.type);
+  if (temporary.empty()) {
+    // Temporaries are not supported by the platform.
+    optimizations->reuseResults = false;
+    output += code;
     return;
   }
 
+  optimizations->temporaries.push_back(std::make_pair(temporary, code));
+  optimizations->temporariesNames[key] = temporary;
+  output += temporary;
+}
+
+gd::String ExpressionCodeGenerator::GenerateFunctionCode(FunctionNode& node) {
+  if (gd::MetadataProvider::IsBadExpressionMetadata(node.expressionMetadata)) {
+    return "/* Error during generation, function not found: " +
+           codeGenerator.ConvertToString(node.functionName) + " for type " +
+           node.type + " */ " + GenerateDefaultValue(node.type);
+  }
+
   if (!node.objectName.empty()) {
     if (!node.behaviorName.empty()) {
-      output += GenerateBehaviorFunctionCode(node.type,
-                                             node.objectName,
-                                             node.behaviorName,
-                                             node.parameters,
-                                             node.expressionMetadata);
+      return GenerateBehaviorFunctionCode(node.type,
+                                          node.objectName,
+                                          node.behaviorName,
+                                          node.parameters,
+                                          node.expressionMetadata);
     } else {
-      output += GenerateObjectFunctionCode(
+      return GenerateObjectFunctionCode(
           node.type, node.objectName, node.parameters, node.expressionMetadata);
     }
-  } else {
-    output +=
-        GenerateFreeFunctionCode(node.parameters, node.expressionMetadata);
   }
+
+  return GenerateFreeFunctionCode(node.parameters, node.expressionMetadata);
 }
 
 gd::String ExpressionCodeGenerator::GenerateFreeFunctionCode(
@@ -267,11 +386,10 @@ gd::String ExpressionCodeGenerator::GenerateFreeFunctionCode(
         PrintParameters(parameters), codeGenerator, context);
   }
 
-  gd::String parametersCode =
-      GenerateParametersCodes(parameters, expressionMetadata, 0);
-
-  return expressionMetadata.codeExtraInformation.functionCallName + "(" +
-         parametersCode + ")";
+  return codeGenerator.GenerateFreeFunctionCall(
+      GenerateParametersCodesList(parameters, expressionMetadata, 0),
+      expressionMetadata,
+      context);
 }
 
 gd::String ExpressionCodeGenerator::GenerateObjectFunctionCode(
@@ -384,32 +502,46 @@ gd::String ExpressionCodeGenerator::GenerateParametersCodes(
     const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
     const ExpressionMetadata& expressionMetadata,
     size_t initialParameterIndex) {
-  size_t nonCodeOnlyParameterIndex = 0;
+  std::vector<gd::String> parametersCodes = GenerateParametersCodesList(
+      parameters, expressionMetadata, initialParameterIndex);
+
   gd::String parametersCode;
+  for (std::size_t i = 0; i < parametersCodes.size(); ++i) {
+    if (i != 0) parametersCode += ", ";
+    parametersCode += parametersCodes[i];
+  }
+
+  return parametersCode;
+}
+
+std::vector<gd::String> ExpressionCodeGenerator::GenerateParametersCodesList(
+    const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+    const ExpressionMetadata& expressionMetadata,
+    size_t initialParameterIndex) {
+  size_t nonCodeOnlyParameterIndex = 0;
+  std::vector<gd::String> parametersCodes;
   for (std::size_t i = initialParameterIndex;
        i < expressionMetadata.parameters.size();
        ++i) {
-    if (i != initialParameterIndex) parametersCode += ", ";
-
+    gd::String parameterCode;
     auto& parameterMetadata = expressionMetadata.parameters[i];
     if (!parameterMetadata.IsCodeOnly()) {
       ExpressionCodeGenerator generator(codeGenerator, context);
+      generator.optimizations = optimizations;
       if (nonCodeOnlyParameterIndex < parameters.size()) {
         parameters[nonCodeOnlyParameterIndex]->Visit(generator);
-        parametersCode += generator.GetOutput();
+        parameterCode += generator.GetOutput();
       } else if (parameterMetadata.IsOptional()) {
         // Optional parameters default value were not parsed at the time of the
         // expression parsing. Parse them now.
-        ExpressionParser2 parser(codeGenerator.GetPlatform(),
-                                 codeGenerator.GetGlobalObjectsAndGroups(),
-                                 codeGenerator.GetObjectsAndGroups());
-        auto node = parser.ParseExpression(parameterMetadata.GetType(),
-                                           parameterMetadata.GetDefaultValue());
+        auto node = ParseExpression(codeGenerator,
+                                    parameterMetadata.GetType(),
+                                    parameterMetadata.GetDefaultValue());
 
         node->Visit(generator);
-        parametersCode += generator.GetOutput();
+        parameterCode += generator.GetOutput();
       } else {
-        parametersCode +=
+        parameterCode +=
             "/* Error during generation, parameter not existing in the nodes "
             "*/ " +
             GenerateDefaultValue(parameterMetadata.GetType());
@@ -417,16 +549,18 @@ gd::String ExpressionCodeGenerator::GenerateParametersCodes(
 
       nonCodeOnlyParameterIndex++;
     } else {
-      parametersCode +=
+      parameterCode +=
           codeGenerator.GenerateParameterCodes(parameterMetadata.GetExtraInfo(),
                                                parameterMetadata,
                                                context,
                                                "",
                                                nullptr);
     }
+
+    parametersCodes.push_back(parameterCode);
   }
 
-  return parametersCode;
+  return parametersCodes;
 }
 
 std::vector<gd::Expression> ExpressionCodeGenerator::PrintParameters(
@@ -7,8 +7,10 @@
 #ifndef GDCORE_ExpressionCodeGenerator_H
 #define GDCORE_ExpressionCodeGenerator_H
 
+#include <map>
 #include <memory>
 #include <vector>
+#include "GDCore/Events/CodeGeneration/ExpressionOptimizer.h"
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2Node.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
@@ -31,13 +33,21 @@ namespace gd {
  * Almost all code generation is dedicated to the gd::EventsCodeGenerator,
  * so that it can be adapted to the target.
  *
+ * When the code is generated with GenerateExpressionCode, the expression is
+ * optimized using gd::ExpressionOptimizer: the sub expressions made only of
+ * literals are folded and the results of functions without side effect are
+ * reused when they are called several times. Visiting the nodes directly
+ * generates the code as written.
+ *
  * \see gd::ExpressionParser2
  */
 class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
  public:
   ExpressionCodeGenerator(EventsCodeGenerator& codeGenerator_,
                           EventsCodeGenerationContext& context_)
-      : codeGenerator(codeGenerator_), context(context_){};
+      : codeGenerator(codeGenerator_),
+        context(context_),
+        optimizations(nullptr){};
   virtual ~ExpressionCodeGenerator(){};
 
   /**
@@ -82,6 +92,23 @@ class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
   void OnVisitEmptyNode(EmptyNode& node) override;
 
  private:
+  /**
+   * \brief The state shared by the generators of an optimized expression.
+   */
+  struct Optimizations {
+    const ExpressionOptimizer& optimizer;
+    bool reuseResults;  ///< false if the results of functions can't be stored
+                        ///< in temporaries.
+    std::map<gd::String, gd::String>
+        temporariesNames;  ///< The temporaries, by function key.
+    std::vector<std::pair<gd::String, gd::String>>
+        temporaries;  ///< The temporaries and their code, in the order in
+                      ///< which they must be evaluated.
+  };
+
+  gd::String GenerateFunctionCode(FunctionNode& node);
+  gd::String GenerateConstant(const ExpressionNode& node);
+  gd::String GenerateConstant(const ExpressionOptimizer::Constant& constant);
   gd::String GenerateFreeFunctionCode(
       const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata);
@@ -100,6 +127,10 @@ class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
       const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata,
       size_t initialParameterIndex);
+  std::vector<gd::String> GenerateParametersCodesList(
+      const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+      const ExpressionMetadata& expressionMetadata,
+      size_t initialParameterIndex);
   gd::String GenerateDefaultValue(const gd::String& type);
   static std::vector<gd::Expression> PrintParameters(
       const std::vector<std::unique_ptr<ExpressionNode>>& parameters);
@@ -107,6 +138,7 @@ class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
   gd::String output;
   EventsCodeGenerator& codeGenerator;
   EventsCodeGenerationContext& context;
+  Optimizations* optimizations;  ///< nullptr if no optimization is done.
 
   static bool useOldExpressionParser;
 };
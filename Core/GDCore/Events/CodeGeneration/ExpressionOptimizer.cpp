@@ -0,0 +1,209 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Events/CodeGeneration/ExpressionOptimizer.h"
+#include <cmath>
+#include <locale>
+#include <sstream>
+#include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+
+namespace gd {
+
+bool ExpressionOptimizer::IsResultReusable(FunctionNode& node) const {
+  if (!hasOnlySideEffectFreeFunctions) return false;
+  if (node.type != "number" && node.type != "string") return false;
+
+  auto it = functionsCallsCount.find(GetFunctionKey(node));
+  return it != functionsCallsCount.end() && it->second >= 2;
+}
+
+gd::String ExpressionOptimizer::GetFunctionKey(FunctionNode& node) {
+  return node.type + ":" + ExpressionParser2NodePrinter::PrintNode(node);
+}
+
+gd::String ExpressionOptimizer::NumberToString(double number) {
+  // Use the shortest representation giving back the same number.
+  for (int precision : {15, 17}) {
+    std::ostringstream stream;
+    stream.imbue(std::locale::classic());
+    stream.precision(precision);
+    stream << number;
+
+    std::istringstream check(stream.str());
+    check.imbue(std::locale::classic());
+    double parsedNumber = 0;
+    check >> parsedNumber;
+    if (parsedNumber == number || precision == 17)
+      return gd::String::FromUTF8(stream.str());
+  }
+
+  return "0";
+}
+
+const ExpressionOptimizer::Constant* ExpressionOptimizer::GetValue(
+    const ExpressionNode& node) const {
+  auto it = literals.find(&node);
+  if (it != literals.end()) return &it->second;
+
+  return GetConstant(node);
+}
+
+void ExpressionOptimizer::OnVisitSubExpressionNode(SubExpressionNode& node) {
+  if (!node.expression) return;
+  node.expression->Visit(*this);
+
+  const Constant* value = GetValue(*node.expression);
+  if (value) constants[&node] = *value;
+}
+
+bool ExpressionOptimizer::Compute(gd::String::value_type op,
+                                  const Constant& lhs,
+                                  const Constant& rhs,
+                                  Constant& result) {
+  if (lhs.isText != rhs.isText) return false;
+
+  if (lhs.isText) {
+    if (op != '+') return false;
+    result = Constant{true, 0, lhs.text + rhs.text};
+    return true;
+  }
+
+  double number = 0;
+  if (op == '+')
+    number = lhs.number + rhs.number;
+  else if (op == '-')
+    number = lhs.number - rhs.number;
+  else if (op == '*')
+    number = lhs.number * rhs.number;
+  else if (op == '/')
+    number = lhs.number / rhs.number;
+  else
+    return false;
+
+  // Keep divisions by zero (and overflows) as they are written, as infinity
+  // and NaN have no literal.
+  if (!std::isfinite(number)) return false;
+  result = Constant{false, number, ""};
+  return true;
+}
+
+void ExpressionOptimizer::OnVisitOperatorNode(OperatorNode& node) {
+  if (!node.leftHandSide || !node.rightHandSide) return;
+
+  if (node.op != '+' && node.op != '-') {
+    // Terms ("*" and "/") are stored from left to right: "a * b / c" is
+    // "(a * b) / c".
+    node.leftHandSide->Visit(*this);
+    node.rightHandSide->Visit(*this);
+
+    const Constant* lhs = GetValue(*node.leftHandSide);
+    const Constant* rhs = GetValue(*node.rightHandSide);
+    Constant result;
+    if (lhs && rhs && Compute(node.op, *lhs, *rhs, result))
+      constants[&node] = result;
+    return;
+  }
+
+  // Additions and subtractions are stored from right to left: "a - b + c" is
+  // stored as "a - (b + c)" but is evaluated (and generated) as
+  // "(a - b) + c". So the terms are visited as a single list, where the
+  // literals at the beginning can be folded.
+  node.leftHandSide->Visit(*this);
+  const Constant* value = GetValue(*node.leftHandSide);
+  Constant prefixValue = value ? *value : Constant{false, 0, ""};
+  OperatorNode* prefixEnd = nullptr;
+
+  OperatorNode* current = &node;
+  while (current) {
+    OperatorNode* next =
+        dynamic_cast<OperatorNode*>(current->rightHandSide.get());
+    if (next && next->leftHandSide && next->rightHandSide &&
+        (next->op == '+' || next->op == '-')) {
+      next->leftHandSide->Visit(*this);
+    } else {
+      current->rightHandSide->Visit(*this);
+      next = nullptr;
+    }
+
+    ExpressionNode& term =
+        next ? *next->leftHandSide : *current->rightHandSide;
+    const Constant* termValue = GetValue(term);
+    if (value && termValue &&
+        Compute(current->op, prefixValue, *termValue, prefixValue)) {
+      prefixEnd = next;
+    } else {
+      value = nullptr;
+    }
+
+    current = next;
+  }
+
+  if (value)
+    constants[&node] = prefixValue;
+  else if (prefixEnd)
+    foldedPrefixes[&node] = FoldedPrefix{prefixValue, prefixEnd};
+}
+
+void ExpressionOptimizer::OnVisitUnaryOperatorNode(UnaryOperatorNode& node) {
+  if (!node.factor) return;
+  node.factor->Visit(*this);
+
+  const Constant* value = GetValue(*node.factor);
+  if (!value || value->isText) return;
+
+  if (node.op == '-')
+    constants[&node] = Constant{false, -value->number, ""};
+  else if (node.op == '+')
+    constants[&node] = *value;
+}
+
+void ExpressionOptimizer::OnVisitNumberNode(NumberNode& node) {
+  std::istringstream stream(node.number.Raw());
+  stream.imbue(std::locale::classic());
+  double number = 0;
+  if (stream >> number) literals[&node] = Constant{false, number, ""};
+}
+
+void ExpressionOptimizer::OnVisitTextNode(TextNode& node) {
+  literals[&node] = Constant{true, 0, node.text};
+}
+
+void ExpressionOptimizer::OnVisitVariableNode(VariableNode& node) {
+  if (node.child) node.child->Visit(*this);
+}
+
+void ExpressionOptimizer::OnVisitVariableAccessorNode(
+    VariableAccessorNode& node) {
+  if (node.child) node.child->Visit(*this);
+}
+
+void ExpressionOptimizer::OnVisitVariableBracketAccessorNode(
+    VariableBracketAccessorNode& node) {
+  if (node.expression) node.expression->Visit(*this);
+  if (node.child) node.child->Visit(*this);
+}
+
+void ExpressionOptimizer::OnVisitFunctionNode(FunctionNode& node) {
+  if (MetadataProvider::IsBadExpressionMetadata(node.expressionMetadata) ||
+      !node.expressionMetadata.IsSideEffectFree())
+    hasOnlySideEffectFreeFunctions = false;
+
+  // The parameters of functions with a custom code generator are not
+  // generated from the nodes, so the calls they contain are not counted.
+  if (customCodeGeneratorsDepth == 0)
+    functionsCallsCount[GetFunctionKey(node)]++;
+
+  bool hasCustomCodeGenerator =
+      node.expressionMetadata.codeExtraInformation.HasCustomCodeGenerator();
+  if (hasCustomCodeGenerator) customCodeGeneratorsDepth++;
+  for (auto& parameter : node.parameters) {
+    if (parameter) parameter->Visit(*this);
+  }
+  if (hasCustomCodeGenerator) customCodeGeneratorsDepth--;
+}
+
+}  // namespace gd
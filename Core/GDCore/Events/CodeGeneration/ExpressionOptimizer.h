@@ -0,0 +1,139 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if defined(GD_IDE_ONLY)
+#ifndef GDCORE_EXPRESSIONOPTIMIZER_H
+#define GDCORE_EXPRESSIONOPTIMIZER_H
+
+#include <map>
+#include <unordered_map>
+#include "GDCore/Events/Parsers/ExpressionParser2Node.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Analyze the tree of an expression to find what can be simplified
+ * during the code generation.
+ *
+ * The tree itself is not modified (it can be shared by the
+ * gd::ExpressionParser2Cache). Instead, the optimizer finds:
+ * - the sub expressions made only of literals, and their values, so that they
+ * are generated as a single literal (for example, `2*3+Variable(x)` is
+ * generated as `6 + ...`),
+ * - the calls to functions that are used several times in the expression and
+ * can be evaluated only once (for example, `Player.X()` in
+ * `Player.X() + Player.X()/2`).
+ *
+ * \see gd::ExpressionCodeGenerator
+ * \see gd::ExpressionMetadata::SetSideEffectFree
+ */
+class GD_CORE_API ExpressionOptimizer : public ExpressionParser2NodeWorker {
+ public:
+  /**
+   * \brief The value of a sub expression made only of literals.
+   */
+  struct Constant {
+    bool isText;
+    double number;
+    gd::String text;
+  };
+
+  /**
+   * \brief The literals at the beginning of a list of additions and
+   * subtractions, folded into a single value.
+   *
+   * For example, `1 + 2 - Variable(x) + 3` is generated as `3 - ...`, the rest
+   * of the expression being the right hand side of `rest`.
+   */
+  struct FoldedPrefix {
+    Constant value;
+    OperatorNode* rest;  ///< The operator after the folded literals.
+  };
+
+  ExpressionOptimizer()
+      : hasOnlySideEffectFreeFunctions(true), customCodeGeneratorsDepth(0){};
+  virtual ~ExpressionOptimizer(){};
+
+  /**
+   * \brief Return the value of the node if it is made only of literals, or
+   * nullptr otherwise.
+   *
+   * \note Numbers and texts nodes are not reported, as they are already
+   * literals.
+   */
+  const Constant* GetConstant(const ExpressionNode& node) const {
+    auto it = constants.find(&node);
+    return it != constants.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * \brief Return the literals folded at the beginning of the additions and
+   * subtractions starting with the node, or nullptr if there are none.
+   */
+  const FoldedPrefix* GetFoldedPrefix(const OperatorNode& node) const {
+    auto it = foldedPrefixes.find(&node);
+    return it != foldedPrefixes.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * \brief Return true if the function is called several times in the
+   * expression and its result can be reused for all the calls.
+   *
+   * This is only the case if all the functions of the expression are without
+   * side effect: otherwise, a function could change the result of the
+   * others.
+   */
+  bool IsResultReusable(FunctionNode& node) const;
+
+  /**
+   * \brief Return a key identifying the calls to the same function with the
+   * same parameters.
+   */
+  static gd::String GetFunctionKey(FunctionNode& node);
+
+  /**
+   * \brief Convert a number to a literal, keeping all its precision.
+   */
+  static gd::String NumberToString(double number);
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode& node) override;
+  void OnVisitOperatorNode(OperatorNode& node) override;
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode& node) override;
+  void OnVisitNumberNode(NumberNode& node) override;
+  void OnVisitTextNode(TextNode& node) override;
+  void OnVisitVariableNode(VariableNode& node) override;
+  void OnVisitVariableAccessorNode(VariableAccessorNode& node) override;
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode& node) override;
+  void OnVisitIdentifierNode(IdentifierNode& node) override {}
+  void OnVisitFunctionNode(FunctionNode& node) override;
+  void OnVisitEmptyNode(EmptyNode& node) override {}
+
+ private:
+  const Constant* GetValue(const ExpressionNode& node) const;
+  static bool Compute(gd::String::value_type op,
+                      const Constant& lhs,
+                      const Constant& rhs,
+                      Constant& result);
+
+  std::unordered_map<const ExpressionNode*, Constant>
+      constants;  ///< The sub expressions made only of literals.
+  std::unordered_map<const ExpressionNode*, Constant>
+      literals;  ///< The numbers and texts nodes.
+  std::unordered_map<const ExpressionNode*, FoldedPrefix> foldedPrefixes;
+  std::map<gd::String, std::size_t>
+      functionsCallsCount;  ///< The number of calls of each function with the
+                            ///< same parameters (see GetFunctionKey).
+  bool hasOnlySideEffectFreeFunctions;
+  std::size_t customCodeGeneratorsDepth;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_EXPRESSIONOPTIMIZER_H
+#endif
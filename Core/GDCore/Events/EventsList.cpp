@@ -14,6 +14,12 @@ namespace gd {
 
 EventsList::EventsList() {}
 
+EventsList::~EventsList() {
+  // The events still used elsewhere must not point to this list anymore.
+  for (auto& event : events)
+    if (event.use_count() > 1) UnnestEventLists(*event);
+}
+
 void EventsList::InsertEvents(const EventsList& otherEvents,
                               size_t begin,
                               size_t end,
@@ -23,33 +29,38 @@ void EventsList::InsertEvents(const EventsList& otherEvents,
   if (end >= otherEvents.size()) end = otherEvents.size() - 1;
 
   for (std::size_t insertPos = 0; insertPos <= (end - begin); insertPos++) {
+    std::shared_ptr<gd::BaseEvent> event =
+        CloneRememberingOriginalEvent(otherEvents.events[begin + insertPos]);
+    NestEventLists(*event);
     if (position != (size_t)-1 && position + insertPos < events.size())
-      events.insert(
-          events.begin() + position + insertPos,
-          CloneRememberingOriginalEvent(otherEvents.events[begin + insertPos]));
+      events.insert(events.begin() + position + insertPos, event);
     else
-      events.push_back(
-          CloneRememberingOriginalEvent(otherEvents.events[begin + insertPos]));
+      events.push_back(event);
   }
+  modificationCounter.Increment();
 }
 
 gd::BaseEvent& EventsList::InsertEvent(const gd::BaseEvent& evt,
                                        size_t position) {
   std::shared_ptr<gd::BaseEvent> event(evt.Clone());
+  NestEventLists(*event);
   if (position < events.size())
     events.insert(events.begin() + position, event);
   else
     events.push_back(event);
+  modificationCounter.Increment();
 
   return *event;
 }
 
 void EventsList::InsertEvent(std::shared_ptr<gd::BaseEvent> event,
                              size_t position) {
+  NestEventLists(*event);
   if (position < events.size())
     events.insert(events.begin() + position, event);
   else
     events.push_back(event);
+  modificationCounter.Increment();
 }
 
 gd::BaseEvent& EventsList::InsertNewEvent(gd::Project& project,
@@ -66,13 +77,17 @@ gd::BaseEvent& EventsList::InsertNewEvent(gd::Project& project,
 }
 
 void EventsList::RemoveEvent(size_t index) {
+  UnnestEventLists(*events[index]);
   events.erase(events.begin() + index);
+  modificationCounter.Increment();
 }
 
 void EventsList::RemoveEvent(const gd::BaseEvent& event) {
   for (size_t i = 0; i < events.size(); ++i) {
     if (events[i].get() == &event) {
+      UnnestEventLists(*events[i]);
       events.erase(events.begin() + i);
+      modificationCounter.Increment();
       return;
     }
   }
@@ -99,6 +114,13 @@ bool EventsList::Contains(const gd::BaseEvent& eventToSearch,
   return false;
 }
 
+void EventsList::Clear() {
+  for (auto& event : events)
+    if (event.use_count() > 1) UnnestEventLists(*event);
+  events.clear();
+  modificationCounter.Increment();
+}
+
 EventsList::EventsList(const EventsList& other) { Init(other); }
 
 EventsList& EventsList::operator=(const EventsList& other) {
@@ -108,9 +130,32 @@ EventsList& EventsList::operator=(const EventsList& other) {
 }
 
 void EventsList::Init(const gd::EventsList& other) {
+  for (auto& event : events)
+    if (event.use_count() > 1) UnnestEventLists(*event);
   events.clear();
-  for (size_t i = 0; i < other.events.size(); ++i)
+  for (size_t i = 0; i < other.events.size(); ++i) {
     events.push_back(CloneRememberingOriginalEvent(other.events[i]));
+    NestEventLists(*events.back());
+  }
+  modificationCounter.Increment();
+}
+
+void EventsList::NestEventLists(gd::BaseEvent& event) {
+  if (event.CanHaveSubEvents())
+    event.GetSubEvents().modificationCounter.SetParent(modificationCounter);
+  for (gd::InstructionsList* conditions : event.GetAllConditionsVectors())
+    conditions->modificationCounter.SetParent(modificationCounter);
+  for (gd::InstructionsList* actions : event.GetAllActionsVectors())
+    actions->modificationCounter.SetParent(modificationCounter);
+}
+
+void EventsList::UnnestEventLists(gd::BaseEvent& event) {
+  if (event.CanHaveSubEvents())
+    event.GetSubEvents().modificationCounter.RemoveParent(modificationCounter);
+  for (gd::InstructionsList* conditions : event.GetAllConditionsVectors())
+    conditions->modificationCounter.RemoveParent(modificationCounter);
+  for (gd::InstructionsList* actions : event.GetAllActionsVectors())
+    actions->modificationCounter.RemoveParent(modificationCounter);
 }
 
 }  // namespace gd
@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include "GDCore/String.h"
+#include "GDCore/Tools/ModificationCounter.h"
 namespace gd {
 class Project;
 }
@@ -34,7 +35,7 @@ class GD_CORE_API EventsList {
  public:
   EventsList();
   EventsList(const EventsList&);
-  virtual ~EventsList(){};
+  ~EventsList();
   EventsList& operator=(const EventsList& rhs);
 
   /**
@@ -129,7 +130,23 @@ class GD_CORE_API EventsList {
   /**
    * \brief Clear the list of events.
    */
-  void Clear() { return events.clear(); };
+  void Clear();
+
+  /**
+   * \brief Return a number incremented each time events are inserted in or
+   * removed from the list, or from the lists nested in it (the sub events,
+   * conditions and actions of its events).
+   *
+   * The count of a list nested in another one is the count of the root list:
+   * it's incremented by the changes of any of the lists of the root list.
+   *
+   * \note Changes made to the events themselves (their parameters...) are
+   * not counted.
+   * \see gd::ModificationCounter
+   */
+  std::size_t GetModificationCount() const {
+    return modificationCounter.GetCount();
+  }
 
   /** \name Utilities
    * Utility methods
@@ -188,8 +205,23 @@ class GD_CORE_API EventsList {
   ///@}
 
  private:
+  gd::ModificationCounter modificationCounter;  ///< Declared before the events
+                                               ///< as their lists can use it
+                                               ///< when they are destroyed.
   std::vector<std::shared_ptr<BaseEvent> > events;
 
+  /**
+   * Nest the lists of the event in this list, so that their changes are
+   * counted by this list.
+   */
+  void NestEventLists(gd::BaseEvent& event);
+
+  /**
+   * Stop nesting the lists of the event in this list, for an event that is
+   * removed from the list but can still be used.
+   */
+  void UnnestEventLists(gd::BaseEvent& event);
+
   /**
    * Initialize from another list of events, copying events. Used by copy-ctor
    * and assign-op. Don't forget to update me if members were changed!
@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_EXPRESSION_H
 #define GDCORE_EXPRESSION_H
+#include <utility>
 #include "GDCore/String.h"
 
 namespace gd {
@@ -29,7 +30,8 @@ class GD_CORE_API Expression {
   /**
    * \brief Construct an expression from a string
    */
-  Expression(gd::String plainString_) : plainString(plainString_){};
+  Expression(gd::String plainString_)
+      : plainString(std::move(plainString_)){};
 
   /**
    * \brief Construct an expression from a const char *
@@ -46,6 +48,13 @@ class GD_CORE_API Expression {
    */
   inline const char* c_str() const { return plainString.c_str(); };
 
+  // The destructor being virtual, the copy and move operations must be
+  // declared explicitly so that expressions can be moved without copying
+  // their string.
+  Expression(const Expression&) = default;
+  Expression(Expression&&) = default;
+  Expression& operator=(const Expression&) = default;
+  Expression& operator=(Expression&&) = default;
   virtual ~Expression(){};
 
  private:
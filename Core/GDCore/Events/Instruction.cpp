@@ -6,6 +6,7 @@
 #include "GDCore/Events/Instruction.h"
 #include <assert.h>
 #include <iostream>
+#include <utility>
 #include <vector>
 #include "GDCore/Events/Expression.h"
 #include "GDCore/Events/InstructionsList.h"
@@ -16,17 +17,17 @@ namespace gd {
 gd::Expression Instruction::badExpression("");
 
 Instruction::Instruction(gd::String type_)
-    : type(type_),
+    : type(std::move(type_)),
       inverted(false) {
   parameters.reserve(8);
 }
 
 Instruction::Instruction(gd::String type_,
-                         const std::vector<gd::Expression>& parameters_,
+                         std::vector<gd::Expression> parameters_,
                          bool inverted_)
-    : type(type_),
+    : type(std::move(type_)),
       inverted(inverted_),
-      parameters(parameters_) {
+      parameters(std::move(parameters_)) {
   parameters.reserve(8);
 }
 
@@ -43,17 +44,15 @@ gd::Expression& Instruction::GetParameter(std::size_t index) {
 }
 
 void Instruction::SetParametersCount(std::size_t size) {
-  while (size < parameters.size())
-    parameters.erase(parameters.begin() + parameters.size() - 1);
-  while (size > parameters.size()) parameters.push_back(gd::Expression(""));
+  parameters.resize(size);
 }
 
-void Instruction::SetParameter(std::size_t nb, const gd::Expression& val) {
+void Instruction::SetParameter(std::size_t nb, gd::Expression val) {
   if (nb >= parameters.size()) {
     std::cout << "Trying to write an out of bound parameter.\n\n" << std::endl;
     return;
   }
-  parameters[nb] = val;
+  parameters[nb] = std::move(val);
 }
 
 }  // namespace gd
@@ -9,6 +9,7 @@
 #include "GDCore/Events/Expression.h"
 #include "GDCore/Events/InstructionsList.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/SharedString.h"
 
 namespace gd {
 
@@ -41,9 +42,13 @@ class GD_CORE_API Instruction {
    * instructions).
    */
   Instruction(gd::String type_,
-              const std::vector<gd::Expression>& parameters_,
+              std::vector<gd::Expression> parameters_,
               bool inverted = false);
 
+  Instruction(const Instruction&) = default;
+  Instruction(Instruction&&) = default;
+  Instruction& operator=(const Instruction&) = default;
+  Instruction& operator=(Instruction&&) = default;
   virtual ~Instruction(){};
 
   /**
@@ -103,7 +108,7 @@ class GD_CORE_API Instruction {
    * \param nb The parameter number
    * \param val The new value of the parameter
    */
-  void SetParameter(std::size_t nb, const gd::Expression& val);
+  void SetParameter(std::size_t nb, gd::Expression val);
 
   /** \brief Get a reference to the std::vector containing the parameters.
    * \return A std::vector containing the parameters
@@ -115,8 +120,8 @@ class GD_CORE_API Instruction {
   /** \brief Replace all the parameters by new ones.
    * \param val A vector containing the new parameters.
    */
-  inline void SetParameters(const std::vector<gd::Expression>& val) {
-    parameters = val;
+  inline void SetParameters(std::vector<gd::Expression> val) {
+    parameters = std::move(val);
   }
 
   /**
@@ -132,7 +137,7 @@ class GD_CORE_API Instruction {
   inline gd::InstructionsList& GetSubInstructions() { return subInstructions; };
 
  private:
-  gd::String type;  ///< Instruction type
+  gd::SharedString type;  ///< Instruction type
   bool inverted;  ///< True if the instruction if inverted. Only applicable for
                   ///< instruction used as conditions by events
   mutable std::vector<gd::Expression>
@@ -11,6 +11,19 @@
 
 namespace gd {
 
+template <>
+void SPtrList<gd::Instruction>::NestElementLists(gd::Instruction& instruction) {
+  instruction.GetSubInstructions().modificationCounter.SetParent(
+      modificationCounter);
+}
+
+template <>
+void SPtrList<gd::Instruction>::UnnestElementLists(
+    gd::Instruction& instruction) {
+  instruction.GetSubInstructions().modificationCounter.RemoveParent(
+      modificationCounter);
+}
+
 void InstructionsList::InsertInstructions(const InstructionsList& list,
                                           size_t begin,
                                           size_t end,
@@ -23,12 +36,14 @@ void InstructionsList::InsertInstructions(const InstructionsList& list,
     const Instruction& instruction = *list.elements[begin + insertPos];
     std::shared_ptr<Instruction> copiedInstruction =
         std::make_shared<Instruction>(instruction);
+    NestElementLists(*copiedInstruction);
     if (position != (size_t)-1 && position + insertPos < elements.size())
       elements.insert(elements.begin() + position + insertPos,
                       copiedInstruction);
     else
       elements.push_back(copiedInstruction);
   }
+  modificationCounter.Increment();
 }
 
 void InstructionsList::SerializeTo(SerializerElement& element) const {
@@ -21,6 +21,13 @@ class SerializerElement;
 
 namespace gd {
 
+// The sub instructions of the instructions of a list are nested in the list.
+template <>
+void SPtrList<gd::Instruction>::NestElementLists(gd::Instruction& instruction);
+template <>
+void SPtrList<gd::Instruction>::UnnestElementLists(
+    gd::Instruction& instruction);
+
 class InstructionsList : public SPtrList<gd::Instruction> {
  public:
   void InsertInstructions(const InstructionsList& list,
@@ -39,6 +39,7 @@ ExpressionParser2::ExpressionParser2(
     const gd::ObjectsContainer& objectsContainer_)
     : expression(""),
       currentPosition(0),
+      currentCodePointPosition(0),
       platform(platform_),
       globalObjectsContainer(globalObjectsContainer_),
       objectsContainer(objectsContainer_) {}
@@ -153,7 +154,7 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
       parsedText += GetCurrentChar();
     }
 
-    currentPosition++;
+    SkipChar();
   }
 
   auto text = gd::make_unique<TextNode>(parsedText);
@@ -196,7 +197,7 @@ std::unique_ptr<NumberNode> ExpressionParser2::ReadNumber() {
       break;
     }
 
-    currentPosition++;
+    SkipChar();
   }
 
   // parsedNumber can be empty in the only case where we have only seen
@@ -16,6 +16,7 @@
 #include "GDCore/String.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/MakeUnique.h"
+#include "GDCore/Utf8/utf8.h"
 namespace gd {
 class Expression;
 class ObjectsContainer;
@@ -61,6 +62,7 @@ class GD_CORE_API ExpressionParser2 {
     expression = expression_;
 
     currentPosition = 0;
+    currentCodePointPosition = 0;
     return Start(type, objectName);
   }
 
@@ -226,15 +228,21 @@ class GD_CORE_API ExpressionParser2 {
       const gd::String &type) {
     size_t identifierStartPosition = GetCurrentPosition();
     gd::String name = ReadIdentifierName();
+    size_t identifierEndPosition = identifierStartPosition + name.size();
 
     SkipWhitespace();
 
     if (IsNamespaceSeparator()) {
       SkipNamespaceSeparator();
 
+      size_t namePartStartPosition = GetCurrentPosition();
+      gd::String namePart = ReadIdentifierName();
       name += NAMESPACE_SEPARATOR;
-      name += ReadIdentifierName();
+      name += namePart;
+      identifierEndPosition = namePartStartPosition + namePart.size();
     }
+    ExpressionParserLocation identifierNameLocation(identifierStartPosition,
+                                                    identifierEndPosition);
 
     if (IsAnyChar("(")) {
       SkipChar();
@@ -242,9 +250,10 @@ class GD_CORE_API ExpressionParser2 {
     } else if (IsAnyChar(DOT)) {
       SkipChar();
       return ObjectFunctionOrBehaviorFunction(
-          type, name, identifierStartPosition);
+          type, name, identifierNameLocation);
     } else {
       auto identifier = gd::make_unique<IdentifierNode>(name, type);
+      identifier->identifierNameLocation = identifierNameLocation;
       if (type == "string") {
         identifier->diagnostic =
             RaiseTypeError(_("You must wrap your text inside double quotes "
@@ -328,7 +337,8 @@ class GD_CORE_API ExpressionParser2 {
   std::unique_ptr<FunctionOrEmptyNode> ObjectFunctionOrBehaviorFunction(
       const gd::String &type,
       const gd::String &objectName,
-      size_t functionStartPosition) {
+      const ExpressionParserLocation &objectNameLocation) {
+    size_t functionStartPosition = objectNameLocation.GetStartPosition();
     gd::String objectFunctionOrBehaviorName = ReadIdentifierName();
 
     SkipWhitespace();
@@ -338,7 +348,7 @@ class GD_CORE_API ExpressionParser2 {
       return BehaviorFunction(type,
                               objectName,
                               objectFunctionOrBehaviorName,
-                              functionStartPosition);
+                              objectNameLocation);
     } else if (IsAnyChar("(")) {
       SkipChar();
 
@@ -361,6 +371,7 @@ class GD_CORE_API ExpressionParser2 {
                                         std::move(parametersAndError.first),
                                         metadata,
                                         objectFunctionOrBehaviorName);
+      function->objectNameLocation = objectNameLocation;
       function->diagnostic = std::move(parametersAndError.second);
       if (!function->diagnostic)
         function->diagnostic =
@@ -381,7 +392,8 @@ class GD_CORE_API ExpressionParser2 {
       const gd::String &type,
       const gd::String &objectName,
       const gd::String &behaviorName,
-      size_t functionStartPosition) {
+      const ExpressionParserLocation &objectNameLocation) {
+    size_t functionStartPosition = objectNameLocation.GetStartPosition();
     gd::String functionName = ReadIdentifierName();
 
     SkipWhitespace();
@@ -409,6 +421,7 @@ class GD_CORE_API ExpressionParser2 {
                                         std::move(parametersAndError.first),
                                         metadata,
                                         functionName);
+      function->objectNameLocation = objectNameLocation;
       function->diagnostic = std::move(parametersAndError.second);
       if (!function->diagnostic)
         function->diagnostic =
@@ -426,10 +439,11 @@ class GD_CORE_API ExpressionParser2 {
 
   std::pair<std::vector<std::unique_ptr<ExpressionNode>>,
             std::unique_ptr<gd::ExpressionParserError>>
-  Parameters(std::vector<gd::ParameterMetadata> parameterMetadata,
+  Parameters(const std::vector<gd::ParameterMetadata> &parameterMetadata,
              const gd::String &objectName = "",
              const gd::String &behaviorName = "") {
     std::vector<std::unique_ptr<ExpressionNode>> parameters;
+    parameters.reserve(parameterMetadata.size());
 
     // By convention, object is always the first parameter, and behavior the
     // second one.
@@ -576,21 +590,30 @@ class GD_CORE_API ExpressionParser2 {
   ///@}
 
   /** \name Parsing tokens
-   * Read tokens or characters
+   * Read tokens or characters.
+   *
+   * The expression is read byte by byte: gd::String::operator[] and
+   * gd::String::size are linear in the length of the string, as it is
+   * encoded in UTF-8. Code points are only decoded when a character that is
+   * not ASCII is found.
    */
   ///@{
-  void SkipChar() { currentPosition++; }
+  void SkipChar() {
+    if (IsEndReached()) return;
+
+    currentPosition += GetCurrentCharSize();
+    currentCodePointPosition++;
+  }
 
   void SkipWhitespace() {
-    while (currentPosition < expression.size() &&
-           WHITESPACES.find(expression[currentPosition]) != gd::String::npos) {
-      currentPosition++;
+    while (IsAnyChar(WHITESPACES)) {
+      SkipChar();
     }
   }
 
   void SkipIfIsAnyChar(const gd::String &allowedCharacters) {
     if (IsAnyChar(allowedCharacters)) {
-      currentPosition++;
+      SkipChar();
     }
   }
 
@@ -598,65 +621,55 @@ class GD_CORE_API ExpressionParser2 {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
     if (IsNamespaceSeparator()) {
-      currentPosition += NAMESPACE_SEPARATOR.size();
+      SkipChar();
+      SkipChar();
     }
   }
 
   bool IsAnyChar(const gd::String &allowedCharacters) {
-    if (currentPosition < expression.size() &&
-        allowedCharacters.find(expression[currentPosition]) !=
-            gd::String::npos) {
-      return true;
+    if (IsEndReached()) return false;
+
+    unsigned char byte = expression.Raw()[currentPosition];
+    if (byte < 0x80) {
+      return allowedCharacters.Raw().find(static_cast<char>(byte)) !=
+             std::string::npos;
     }
 
-    return false;
+    return allowedCharacters.find(GetCurrentChar()) != gd::String::npos;
   }
 
   bool IsIdentifierAllowedChar() {
-    if (currentPosition < expression.size() &&
-        PARAMETERS_SEPARATOR.find(expression[currentPosition]) ==
-            gd::String::npos &&
-        DOT.find(expression[currentPosition]) == gd::String::npos &&
-        QUOTE.find(expression[currentPosition]) == gd::String::npos &&
-        BRACKETS.find(expression[currentPosition]) == gd::String::npos &&
-        EXPRESSION_OPERATORS.find(expression[currentPosition]) ==
-            gd::String::npos &&
-        TERM_OPERATORS.find(expression[currentPosition]) == gd::String::npos) {
-      return true;
-    }
-
-    return false;
+    return !IsEndReached() && !IsAnyChar(PARAMETERS_SEPARATOR) &&
+           !IsAnyChar(DOT) && !IsAnyChar(QUOTE) && !IsAnyChar(BRACKETS) &&
+           !IsAnyChar(EXPRESSION_OPERATORS) && !IsAnyChar(TERM_OPERATORS);
   }
 
   bool IsNamespaceSeparator() {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
-    return (currentPosition + NAMESPACE_SEPARATOR.size() <= expression.size() &&
-            expression.substr(currentPosition, NAMESPACE_SEPARATOR.size()) ==
-                NAMESPACE_SEPARATOR);
+    return expression.Raw().compare(currentPosition,
+                                    NAMESPACE_SEPARATOR.Raw().size(),
+                                    NAMESPACE_SEPARATOR.Raw()) == 0;
   }
 
-  bool IsEndReached() { return currentPosition >= expression.size(); }
+  bool IsEndReached() { return currentPosition >= expression.Raw().size(); }
 
   gd::String ReadIdentifierName() {
-    gd::String name;
-    while (currentPosition < expression.size() &&
-           (IsIdentifierAllowedChar()
-            // Allow whitespace in identifier name for compatibility
-            || expression[currentPosition] == ' ')) {
-      name += expression[currentPosition];
-      currentPosition++;
-    }
+    size_t nameStartPosition = currentPosition;
+    size_t nameEndPosition = currentPosition;
+    while (IsIdentifierAllowedChar()
+           // Allow whitespace in identifier name for compatibility
+           || IsAnyChar(" ")) {
+      bool isWhitespace = IsAnyChar(WHITESPACES);
+      SkipChar();
 
-    // Trim whitespace at the end (we allow them for compatibility inside
-    // the name, but after the last character that is not whitespace, they
-    // should be ignore again).
-    size_t lastCharacterPos = name.find_last_not_of(WHITESPACES);
-    if (!name.empty() && (lastCharacterPos + 1) < name.size()) {
-      name.erase(lastCharacterPos + 1);
+      // Trim whitespace at the end (we allow them for compatibility inside
+      // the name, but after the last character that is not whitespace, they
+      // should be ignore again).
+      if (!isWhitespace) nameEndPosition = currentPosition;
     }
 
-    return name;
+    return GetExpressionPart(nameStartPosition, nameEndPosition);
   }
 
   std::unique_ptr<TextNode> ReadText();
@@ -664,36 +677,64 @@ class GD_CORE_API ExpressionParser2 {
   std::unique_ptr<NumberNode> ReadNumber();
 
   std::unique_ptr<EmptyNode> ReadUntilWhitespace(gd::String type) {
-    gd::String text;
-    while (currentPosition < expression.size() &&
-           WHITESPACES.find(expression[currentPosition]) == gd::String::npos) {
-      text += expression[currentPosition];
-      currentPosition++;
+    size_t textStartPosition = currentPosition;
+    while (!IsEndReached() && !IsAnyChar(WHITESPACES)) {
+      SkipChar();
     }
 
-    return gd::make_unique<EmptyNode>(type, text);
+    return gd::make_unique<EmptyNode>(
+        type, GetExpressionPart(textStartPosition, currentPosition));
   }
 
   std::unique_ptr<EmptyNode> ReadUntilEnd(gd::String type) {
-    gd::String text;
-    while (currentPosition < expression.size()) {
-      text += expression[currentPosition];
-      currentPosition++;
+    size_t textStartPosition = currentPosition;
+    while (!IsEndReached()) {
+      SkipChar();
     }
 
-    return gd::make_unique<EmptyNode>(type, text);
+    return gd::make_unique<EmptyNode>(
+        type, GetExpressionPart(textStartPosition, currentPosition));
   }
 
-  size_t GetCurrentPosition() { return currentPosition; }
+  /**
+   * \brief Return the position, in characters (code points), reached in the
+   * expression. This is the position used in diagnostics.
+   */
+  size_t GetCurrentPosition() { return currentCodePointPosition; }
 
   gd::String::value_type GetCurrentChar() {
-    if (currentPosition < expression.size()) {
-      return expression[currentPosition];
+    if (!IsEndReached()) {
+      unsigned char byte = expression.Raw()[currentPosition];
+      if (byte < 0x80) return byte;
+
+      return ::utf8::unchecked::peek_next(expression.Raw().begin() +
+                                          currentPosition);
     }
 
     return '\n';  // Should not arise, unless GetCurrentChar was called when
                   // IsEndReached() is true (which is a logical error).
   }
+
+  /**
+   * \brief Return the number of bytes of the current character.
+   */
+  size_t GetCurrentCharSize() {
+    size_t size = ::utf8::internal::sequence_length(expression.Raw().begin() +
+                                                    currentPosition);
+    size_t remainingSize = expression.Raw().size() - currentPosition;
+    return size == 0 ? 1 : (size < remainingSize ? size : remainingSize);
+  }
+
+  /**
+   * \brief Return the part of the expression between the given positions (in
+   * bytes).
+   */
+  gd::String GetExpressionPart(size_t startPosition, size_t endPosition) {
+    gd::String part;
+    part.Raw() = expression.Raw().substr(startPosition,
+                                         endPosition - startPosition);
+    return part;
+  }
   ///@}
 
   /** \name Raising errors
@@ -740,7 +781,9 @@ class GD_CORE_API ExpressionParser2 {
   }
 
   gd::String expression;
-  std::size_t currentPosition;
+  std::size_t currentPosition;  ///< The position in the expression, in bytes.
+  std::size_t currentCodePointPosition;  ///< The position in the expression,
+                                         ///< in characters (code points).
 
   const gd::Platform &platform;
   const gd::ObjectsContainer &globalObjectsContainer;
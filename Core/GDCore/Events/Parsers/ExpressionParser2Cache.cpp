@@ -0,0 +1,236 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
+#include <functional>
+#include <iterator>
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Node.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/Layout.h"
+
+namespace gd {
+
+namespace {
+/**
+ * \brief Go through the nodes to find the objects and behaviors whose types
+ * were used to parse the expression, and count the nodes.
+ */
+class ExpressionDependenciesFinder : public ExpressionParser2NodeWorker {
+ public:
+  ExpressionDependenciesFinder() : nodesCount(0){};
+  virtual ~ExpressionDependenciesFinder(){};
+
+  const std::vector<gd::String>& GetObjectsNames() const {
+    return objectsNames;
+  }
+  const std::vector<gd::String>& GetBehaviorsNames() const {
+    return behaviorsNames;
+  }
+  std::size_t GetNodesCount() const { return nodesCount; }
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode& node) override {
+    nodesCount++;
+    node.expression->Visit(*this);
+  }
+  void OnVisitOperatorNode(OperatorNode& node) override {
+    nodesCount++;
+    node.leftHandSide->Visit(*this);
+    node.rightHandSide->Visit(*this);
+  }
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode& node) override {
+    nodesCount++;
+    node.factor->Visit(*this);
+  }
+  void OnVisitNumberNode(NumberNode& node) override { nodesCount++; }
+  void OnVisitTextNode(TextNode& node) override { nodesCount++; }
+  void OnVisitVariableNode(VariableNode& node) override {
+    nodesCount++;
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableAccessorNode(VariableAccessorNode& node) override {
+    nodesCount++;
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode& node) override {
+    nodesCount++;
+    node.expression->Visit(*this);
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitIdentifierNode(IdentifierNode& node) override { nodesCount++; }
+  void OnVisitFunctionNode(FunctionNode& node) override {
+    nodesCount++;
+    // See gd::ExpressionParser2: the type of the object is used to find
+    // object functions, and the type of the behavior for behavior functions.
+    if (!node.behaviorName.empty())
+      behaviorsNames.push_back(node.behaviorName);
+    else if (!node.objectName.empty())
+      objectsNames.push_back(node.objectName);
+
+    for (auto& parameter : node.parameters) {
+      parameter->Visit(*this);
+    }
+  }
+  void OnVisitEmptyNode(EmptyNode& node) override { nodesCount++; }
+
+ private:
+  std::vector<gd::String> objectsNames;
+  std::vector<gd::String> behaviorsNames;
+  std::size_t nodesCount;
+};
+
+/**
+ * The estimated memory used by a node, including its diagnostic and
+ * strings.
+ */
+const std::size_t nodeMemoryEstimate = 128;
+}  // namespace
+
+std::size_t ExpressionParser2Cache::KeyHash::operator()(const Key& key) const {
+  std::hash<std::string> hash;
+  std::size_t seed = hash(key.expression.Raw());
+  seed ^= hash(key.type.Raw()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= hash(key.objectName.Raw()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+ExpressionParser2Cache::ExpressionParser2Cache(std::size_t maximumMemory_)
+    : memory(0),
+      maximumMemory(maximumMemory_),
+      platform(nullptr),
+      platformExtensionsVersion(0) {}
+
+ExpressionParser2Cache::~ExpressionParser2Cache() {}
+
+std::shared_ptr<gd::ExpressionNode> ExpressionParser2Cache::ParseExpression(
+    const gd::Platform& platform_,
+    const gd::ObjectsContainer& globalObjectsContainer,
+    const gd::ObjectsContainer& objectsContainer,
+    const gd::String& type,
+    const gd::String& expression,
+    const gd::String& objectName) {
+  Key key{type, expression, objectName};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Trees refer to the metadata of the extensions: they can't be reused if
+    // the extensions changed.
+    if (platform != &platform_ ||
+        platformExtensionsVersion != platform_.GetExtensionsVersion()) {
+      RemoveEntries();
+      platform = &platform_;
+      platformExtensionsVersion = platform_.GetExtensionsVersion();
+    }
+
+    auto it = entriesByKey.find(key);
+    if (it != entriesByKey.end()) {
+      if (IsStillValid(*it->second, globalObjectsContainer, objectsContainer)) {
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->node;
+      }
+
+      RemoveEntry(it->second);
+    }
+  }
+
+  // Parse without holding the lock, so that other threads can use the cache
+  // in the meantime.
+  gd::ExpressionParser2 parser(
+      platform_, globalObjectsContainer, objectsContainer);
+  std::shared_ptr<gd::ExpressionNode> node =
+      parser.ParseExpression(type, expression, objectName);
+
+  ExpressionDependenciesFinder finder;
+  node->Visit(finder);
+
+  Entry entry;
+  entry.key = std::move(key);
+  entry.node = node;
+  for (const gd::String& name : finder.GetObjectsNames()) {
+    entry.objectsTypes.emplace_back(
+        name,
+        gd::GetTypeOfObject(globalObjectsContainer, objectsContainer, name));
+  }
+  for (const gd::String& name : finder.GetBehaviorsNames()) {
+    entry.behaviorsTypes.emplace_back(
+        name,
+        gd::GetTypeOfBehavior(globalObjectsContainer, objectsContainer, name));
+  }
+  entry.memory =
+      sizeof(Entry) + 2 * (expression.Raw().size() + type.Raw().size() +
+                           objectName.Raw().size()) +
+      finder.GetNodesCount() * nodeMemoryEstimate;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Don't keep the tree if the cache was emptied for another platform (or
+  // other extensions) in the meantime.
+  if (platform != &platform_ ||
+      platformExtensionsVersion != platform_.GetExtensionsVersion())
+    return node;
+
+  // Another thread may have parsed the same expression in the meantime.
+  auto it = entriesByKey.find(entry.key);
+  if (it != entriesByKey.end()) RemoveEntry(it->second);
+
+  memory += entry.memory;
+  entries.push_front(std::move(entry));
+  entriesByKey[entries.front().key] = entries.begin();
+  RemoveEntriesAboveMaximumMemory();
+
+  return node;
+}
+
+bool ExpressionParser2Cache::IsStillValid(
+    const Entry& entry,
+    const gd::ObjectsContainer& globalObjectsContainer,
+    const gd::ObjectsContainer& objectsContainer) {
+  for (const auto& objectType : entry.objectsTypes) {
+    if (gd::GetTypeOfObject(globalObjectsContainer,
+                            objectsContainer,
+                            objectType.first) != objectType.second)
+      return false;
+  }
+  for (const auto& behaviorType : entry.behaviorsTypes) {
+    if (gd::GetTypeOfBehavior(globalObjectsContainer,
+                              objectsContainer,
+                              behaviorType.first) != behaviorType.second)
+      return false;
+  }
+
+  return true;
+}
+
+void ExpressionParser2Cache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  RemoveEntries();
+}
+
+void ExpressionParser2Cache::SetMaximumMemory(std::size_t maximumMemory_) {
+  std::lock_guard<std::mutex> lock(mutex);
+  maximumMemory = maximumMemory_;
+  RemoveEntriesAboveMaximumMemory();
+}
+
+void ExpressionParser2Cache::RemoveEntry(std::list<Entry>::iterator it) {
+  memory -= it->memory;
+  entriesByKey.erase(it->key);
+  entries.erase(it);
+}
+
+void ExpressionParser2Cache::RemoveEntries() {
+  entriesByKey.clear();
+  entries.clear();
+  memory = 0;
+}
+
+void ExpressionParser2Cache::RemoveEntriesAboveMaximumMemory() {
+  while (memory > maximumMemory && !entries.empty())
+    RemoveEntry(std::prev(entries.end()));
+}
+
+}  // namespace gd
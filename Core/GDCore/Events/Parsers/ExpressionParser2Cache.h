@@ -0,0 +1,155 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_EXPRESSIONPARSER2CACHE_H
+#define GDCORE_EXPRESSIONPARSER2CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "GDCore/String.h"
+namespace gd {
+struct ExpressionNode;
+class ObjectsContainer;
+class Platform;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Keep the trees of the last parsed expressions, so that expressions
+ * parsed again (for code generation, validation or when searching in events)
+ * are not parsed once more.
+ *
+ * Trees are stored according to the expression, its type and the object name
+ * given to gd::ExpressionParser2::ParseExpression. The objects and behaviors
+ * used by a tree are checked before returning it: a tree parsed for a layout
+ * is reused for any other layout where these objects and behaviors have the
+ * same types. The cache is emptied when the extensions of the platform are
+ * changed.
+ *
+ * The least recently used trees are removed when the memory used by the cache
+ * (estimated from the number of nodes) is above the maximum.
+ *
+ * \warning The returned trees are shared: they must not be modified (for
+ * example by renaming functions or objects). Parse the expression with
+ * gd::ExpressionParser2 to get a tree that can be modified.
+ *
+ * The cache can be used by several threads at the same time (for example
+ * when generating the code of several layouts): expressions are parsed
+ * outside of the lock, so that threads don't wait for each other.
+ *
+ * \see gd::Project::GetExpressionParser2Cache
+ * \see gd::ExpressionParser2
+ */
+class GD_CORE_API ExpressionParser2Cache {
+ public:
+  ExpressionParser2Cache(std::size_t maximumMemory = 16 * 1024 * 1024);
+  virtual ~ExpressionParser2Cache();
+
+  /**
+   * \brief Return the tree of the given expression, parsed with the given
+   * type, from the cache if possible.
+   *
+   * \see gd::ExpressionParser2::ParseExpression
+   */
+  std::shared_ptr<gd::ExpressionNode> ParseExpression(
+      const gd::Platform &platform,
+      const gd::ObjectsContainer &globalObjectsContainer,
+      const gd::ObjectsContainer &objectsContainer,
+      const gd::String &type,
+      const gd::String &expression,
+      const gd::String &objectName = "");
+
+  /**
+   * \brief Remove all the trees from the cache.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the number of trees in the cache.
+   */
+  std::size_t GetTreesCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  /**
+   * \brief Return the estimated memory used by the trees of the cache, in
+   * bytes.
+   */
+  std::size_t GetMemory() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memory;
+  }
+
+  /**
+   * \brief Change the maximum memory, in bytes, that can be used by the
+   * trees of the cache.
+   */
+  void SetMaximumMemory(std::size_t maximumMemory_);
+
+  /**
+   * \brief Return the maximum memory, in bytes, that can be used by the
+   * trees of the cache.
+   */
+  std::size_t GetMaximumMemory() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maximumMemory;
+  }
+
+ private:
+  struct Key {
+    gd::String type;
+    gd::String expression;
+    gd::String objectName;
+
+    bool operator==(const Key &other) const {
+      return expression == other.expression && type == other.type &&
+             objectName == other.objectName;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<gd::ExpressionNode> node;
+    std::vector<std::pair<gd::String, gd::String>>
+        objectsTypes;  ///< The objects used by the tree, with their types.
+    std::vector<std::pair<gd::String, gd::String>>
+        behaviorsTypes;  ///< The behaviors used by the tree, with their types.
+    std::size_t memory;  ///< The estimated memory used by the entry.
+  };
+
+  static bool IsStillValid(const Entry &entry,
+                           const gd::ObjectsContainer &globalObjectsContainer,
+                           const gd::ObjectsContainer &objectsContainer);
+  void RemoveEntry(std::list<Entry>::iterator it);
+  void RemoveEntries();
+  void RemoveEntriesAboveMaximumMemory();
+
+  std::list<Entry> entries;  ///< The entries, the most recently used first.
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entriesByKey;
+  std::size_t memory;
+  std::size_t maximumMemory;
+
+  const gd::Platform *platform;  ///< The platform of the cached trees.
+  std::size_t platformExtensionsVersion;  ///< The version of the extensions
+                                          ///< of the platform used for the
+                                          ///< cached trees.
+
+  mutable std::mutex mutex;  ///< Protects all the members above.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_EXPRESSIONPARSER2CACHE_H
@@ -4,7 +4,149 @@
  * reserved. This project is released under the MIT License.
  */
 #include "ExpressionParser2Node.h"
+#include <mutex>
+#include <new>
 
 namespace gd {
 gd::String ExpressionParserDiagnostic::noMessage = "";
-}
\ No newline at end of file
+
+namespace {
+const std::size_t slotsSizeGranularity = 16;
+const std::size_t slotsSizeClassesCount = 16;  // Slots up to 256 bytes.
+const std::size_t slotsPerChunk = 64;
+
+struct FreeSlot {
+  FreeSlot *next;
+};
+
+FreeSlot *PopSlot(FreeSlot *&list) {
+  FreeSlot *slot = list;
+  list = slot->next;
+  return slot;
+}
+
+void PushSlot(FreeSlot *&list, FreeSlot *slot) {
+  slot->next = list;
+  list = slot;
+}
+
+/**
+ * \brief The lists of free slots, one for each size class.
+ */
+struct FreeSlotsLists {
+  FreeSlot *lists[slotsSizeClassesCount] = {};
+};
+
+/**
+ * \brief The slots given back by threads that exited (or freed after their
+ * own free slots were destroyed), available to any thread.
+ *
+ * It is never destroyed, so that nodes destroyed at the very end of the
+ * program can still give back their memory.
+ */
+struct SharedFreeSlots {
+  std::mutex mutex;
+  FreeSlotsLists freeSlots;
+};
+
+SharedFreeSlots &GetSharedFreeSlots() {
+  static SharedFreeSlots *sharedFreeSlots = new SharedFreeSlots;
+  return *sharedFreeSlots;
+}
+
+thread_local bool threadFreeSlotsDestroyed = false;
+
+/**
+ * \brief The free slots of a thread. On exit of the thread, they are given
+ * to the shared free slots.
+ */
+struct ThreadFreeSlots {
+  ~ThreadFreeSlots() {
+    SharedFreeSlots &shared = GetSharedFreeSlots();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (std::size_t i = 0; i < slotsSizeClassesCount; ++i) {
+      while (freeSlots.lists[i])
+        PushSlot(shared.freeSlots.lists[i], PopSlot(freeSlots.lists[i]));
+    }
+    threadFreeSlotsDestroyed = true;
+  }
+
+  FreeSlotsLists freeSlots;
+};
+
+thread_local ThreadFreeSlots threadFreeSlots;
+
+/**
+ * \brief Add a new chunk of slots to the (empty) given list.
+ *
+ * Chunks are never given back to the system: the memory used is bounded by
+ * the largest number of nodes that were alive at the same time.
+ */
+void AddChunk(FreeSlot *&list, std::size_t sizeClass) {
+  std::size_t slotSize = (sizeClass + 1) * slotsSizeGranularity;
+  char *chunk = static_cast<char *>(::operator new(slotSize * slotsPerChunk));
+  for (std::size_t i = slotsPerChunk; i > 0; --i)
+    PushSlot(list, reinterpret_cast<FreeSlot *>(chunk + (i - 1) * slotSize));
+}
+
+/**
+ * \brief Fill the (empty) list of free slots of the thread, either with the
+ * shared free slots or with a new chunk.
+ */
+void RefillFreeSlots(FreeSlot *&list, std::size_t sizeClass) {
+  SharedFreeSlots &shared = GetSharedFreeSlots();
+  {
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (shared.freeSlots.lists[sizeClass]) {
+      list = shared.freeSlots.lists[sizeClass];
+      shared.freeSlots.lists[sizeClass] = nullptr;
+      return;
+    }
+  }
+
+  AddChunk(list, sizeClass);
+}
+
+std::size_t GetSizeClass(std::size_t size) {
+  return size ? (size - 1) / slotsSizeGranularity : 0;
+}
+}  // namespace
+
+void *AllocateExpressionTreeMemory(std::size_t size) {
+  std::size_t sizeClass = GetSizeClass(size);
+  if (sizeClass >= slotsSizeClassesCount) return ::operator new(size);
+
+  if (threadFreeSlotsDestroyed) {
+    SharedFreeSlots &shared = GetSharedFreeSlots();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    FreeSlot *&list = shared.freeSlots.lists[sizeClass];
+    if (!list) AddChunk(list, sizeClass);
+    return PopSlot(list);
+  }
+
+  FreeSlot *&list = threadFreeSlots.freeSlots.lists[sizeClass];
+  if (!list) RefillFreeSlots(list, sizeClass);
+  return PopSlot(list);
+}
+
+void FreeExpressionTreeMemory(void *pointer, std::size_t size) {
+  if (!pointer) return;
+
+  std::size_t sizeClass = GetSizeClass(size);
+  if (sizeClass >= slotsSizeClassesCount) {
+    ::operator delete(pointer);
+    return;
+  }
+
+  FreeSlot *slot = static_cast<FreeSlot *>(pointer);
+  if (threadFreeSlotsDestroyed) {
+    SharedFreeSlots &shared = GetSharedFreeSlots();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    PushSlot(shared.freeSlots.lists[sizeClass], slot);
+    return;
+  }
+
+  PushSlot(threadFreeSlots.freeSlots.lists[sizeClass], slot);
+}
+
+}  // namespace gd
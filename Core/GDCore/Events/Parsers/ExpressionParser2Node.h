@@ -6,6 +6,7 @@
 #ifndef GDCORE_EXPRESSIONPARSER2NODES_H
 #define GDCORE_EXPRESSIONPARSER2NODES_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include "ExpressionParser2NodeWorker.h"
@@ -20,15 +21,41 @@ class ExpressionMetadata;
 
 namespace gd {
 
+/**
+ * \brief Allocate memory for a node or a diagnostic of an expression tree.
+ *
+ * Trees are made of many small nodes that are created and destroyed
+ * together, at each parsing. Memory is taken from chunks of slots of the same
+ * size, and freed slots are recycled for the next nodes instead of being given
+ * back to the system, so that parsing an expression almost never calls the
+ * system allocator.
+ *
+ * \see gd::FreeExpressionTreeMemory
+ */
+void GD_CORE_API *AllocateExpressionTreeMemory(std::size_t size);
+
+/**
+ * \brief Give back memory allocated by gd::AllocateExpressionTreeMemory.
+ */
+void GD_CORE_API FreeExpressionTreeMemory(void *pointer, std::size_t size);
+
 /**
  * \brief A diagnostic that can be attached to a gd::ExpressionNode.
  */
 struct ExpressionParserDiagnostic {
+  virtual ~ExpressionParserDiagnostic(){};
   virtual bool IsError() { return false; }
   virtual const gd::String &GetMessage() { return noMessage; }
   virtual size_t GetStartPosition() { return 0; }
   virtual size_t GetEndPosition() { return 0; }
 
+  static void *operator new(std::size_t size) {
+    return AllocateExpressionTreeMemory(size);
+  }
+  static void operator delete(void *pointer, std::size_t size) {
+    FreeExpressionTreeMemory(pointer, size);
+  }
+
  private:
   static gd::String noMessage;
 };
@@ -66,6 +93,29 @@ struct ExpressionParserError : public ExpressionParserDiagnostic {
   size_t endPosition;
 };
 
+/**
+ * \brief A range of the expression, covered by a part of a node (for example
+ * the name of an object). Positions are in characters, like the positions of
+ * the diagnostics.
+ */
+struct ExpressionParserLocation {
+  ExpressionParserLocation()
+      : isValid(false), startPosition(0), endPosition(0){};
+  ExpressionParserLocation(size_t startPosition_, size_t endPosition_)
+      : isValid(true),
+        startPosition(startPosition_),
+        endPosition(endPosition_){};
+
+  bool IsValid() const { return isValid; }
+  size_t GetStartPosition() const { return startPosition; }
+  size_t GetEndPosition() const { return endPosition; }
+
+ private:
+  bool isValid;
+  size_t startPosition;
+  size_t endPosition;
+};
+
 /**
  * \brief The base node, from which all nodes in the tree of
  * an expression inherits from.
@@ -74,6 +124,13 @@ struct ExpressionNode {
   virtual ~ExpressionNode(){};
   virtual void Visit(ExpressionParser2NodeWorker &worker){};
 
+  static void *operator new(std::size_t size) {
+    return AllocateExpressionTreeMemory(size);
+  }
+  static void operator delete(void *pointer, std::size_t size) {
+    FreeExpressionTreeMemory(pointer, size);
+  }
+
   std::unique_ptr<ExpressionParserDiagnostic> diagnostic;
 };
 
@@ -218,6 +275,9 @@ struct IdentifierNode : public IdentifierOrFunctionOrEmptyNode {
 
   gd::String identifierName;
   gd::String type;
+  ExpressionParserLocation
+      identifierNameLocation;  ///< The location of the identifier name in the
+                               ///< expression.
 };
 
 struct FunctionOrEmptyNode : public IdentifierOrFunctionOrEmptyNode {
@@ -271,6 +331,9 @@ struct FunctionNode : public FunctionOrEmptyNode {
   std::vector<std::unique_ptr<ExpressionNode>> parameters;
   const ExpressionMetadata &expressionMetadata;
   gd::String functionName;
+  ExpressionParserLocation
+      objectNameLocation;  ///< The location of the object name in the
+                           ///< expression, if any.
 };
 
 /**
@@ -98,7 +98,7 @@ void EventsListSerialization::UpdateInstructionsFromGD31x(
         instr.GetType() == "ModVarGlobalTxt") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 1) parameters.erase(parameters.begin() + 0);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     }
 
     if (instr.GetType() == "VarSceneDef" || instr.GetType() == "VarGlobalDef" ||
@@ -142,7 +142,7 @@ void EventsListSerialization::UpdateInstructionsFromGD2x(
                instr.GetType() == "CentreCamera") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 3) parameters.erase(parameters.begin() + 2);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     } else if (instr.GetType() == "AjoutObjConcern" ||
                instr.GetType() == "AjoutHasard") {
       instr.SetParameter(1, instr.GetParameter(3));
@@ -151,20 +151,20 @@ void EventsListSerialization::UpdateInstructionsFromGD2x(
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 3) parameters.erase(parameters.begin() + 2);
       if (parameters.size() >= 3) parameters.erase(parameters.begin() + 2);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     } else if (instr.GetType() == "Create") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 2) parameters.erase(parameters.begin() + 1);
       if (parameters.size() >= 2) parameters.erase(parameters.begin() + 1);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     } else if (instr.GetType() == "CreateByName") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 2) parameters.erase(parameters.begin() + 1);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     } else if (instr.GetType() == "NbObjet") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 2) parameters.erase(parameters.begin() + 1);
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     } else if (instr.GetType() == "Distance") {
       std::vector<gd::Expression> parameters = instr.GetParameters();
       if (parameters.size() >= 3) parameters.erase(parameters.begin() + 2);
@@ -175,7 +175,7 @@ void EventsListSerialization::UpdateInstructionsFromGD2x(
       } else {
         instr.SetInverted(false);
       }
-      instr.SetParameters(parameters);
+      instr.SetParameters(std::move(parameters));
     }
 
     // Common updates for some parameters
@@ -288,7 +288,7 @@ void gd::EventsListSerialization::UnserializeInstructionsFrom(
             gd::Expression(parametersElem.GetChild(j).GetValue().GetString()));
     }
 
-    instruction.SetParameters(parameters);
+    instruction.SetParameters(std::move(parameters));
 
     // Read sub instructions
     if (instrElement.HasChild("subInstructions"))
@@ -308,7 +308,7 @@ void gd::EventsListSerialization::UnserializeInstructionsFrom(
           instrElement.GetChild("subActions", 0, "SubActions"));
     // end of compatibility code
 
-    instructions.Insert(instruction);
+    instructions.Insert(std::move(instruction));
   }
 
   // Compatibility with GD <= 3.1
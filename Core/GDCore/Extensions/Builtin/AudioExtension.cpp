@@ -291,6 +291,20 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsAudioExtension(
       .SetDefaultValue("1")
       .MarkAsSimple();
 
+  extension
+      .AddAction("PrefetchMusic",
+                 _("Prefetch a music file"),
+                 _("Prepare a music file in the background, so that playing it "
+                   "later does not pause the game (for example when changing "
+                   "the scene)."),
+                 _("Prefetch the music _PARAM1_"),
+                 _("Audio"),
+                 "res/actions/music24.png",
+                 "res/actions/music.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("musicfile", _("Audio file (or audio resource name)"))
+      .MarkAsAdvanced();
+
   extension
       .AddCondition("MusicPlaying",
                     _("A music file is being played"),
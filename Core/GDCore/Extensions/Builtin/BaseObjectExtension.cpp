@@ -734,21 +734,24 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("X position of the object"),
                     _("Position"),
                     "res/actions/position.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Y",
                     _("Y position"),
                     _("Y position of the object"),
                     _("Position"),
                     "res/actions/position.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Angle",
                     _("Angle"),
                     _("Current angle, in degrees, of the object"),
                     _("Angle"),
                     "res/actions/direction.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("ForceX",
                     _("Average X coordinates of forces"),
@@ -791,7 +794,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("Width of the object"),
                     _("Size"),
                     "res/actions/scaleWidth.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Largeur",
                     _("Width"),
@@ -806,7 +810,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("Height of the object"),
                     _("Size"),
                     "res/actions/scaleHeight.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Hauteur",
                     _("Height"),
@@ -821,7 +826,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("Z order of an object"),
                     _("Visibility"),
                     "res/actions/planicon.png")
-      .AddParameter("object", _("Object"));
+      .AddParameter("object", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Plan",
                     _("Z order"),
@@ -837,7 +843,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("Position"),
                     "res/conditions/distance.png")
       .AddParameter("object", _("Object"))
-      .AddParameter("objectPtr", _("Object"));
+      .AddParameter("objectPtr", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("SqDistance",
                     _("Square distance between two objects"),
@@ -845,7 +852,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsBaseObjectExtension(
                     _("Position"),
                     "res/conditions/distance.png")
       .AddParameter("object", _("Object"))
-      .AddParameter("objectPtr", _("Object"));
+      .AddParameter("objectPtr", _("Object"))
+      .SetSideEffectFree();
 
   obj.AddExpression("Variable",
                     _("Object's variable"),
@@ -435,7 +435,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsCameraExtension(
       .AddCodeOnlyParameter("currentScene", "")
       .AddParameter("layer", _("Layer"))
       .AddParameter("expression", _("Camera number (default : 0)"))
-      .SetDefaultValue("0");
+      .SetDefaultValue("0")
+      .SetSideEffectFree();
 
   extension
       .AddExpression("CameraHeight",
@@ -446,7 +447,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsCameraExtension(
       .AddCodeOnlyParameter("currentScene", "")
       .AddParameter("layer", _("Layer"))
       .AddParameter("expression", _("Camera number (default : 0)"))
-      .SetDefaultValue("0");
+      .SetDefaultValue("0")
+      .SetSideEffectFree();
 
   extension
       .AddExpression(
@@ -506,7 +508,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsCameraExtension(
       .AddParameter("layer", _("Layer"), "", true)
       .SetDefaultValue("\"\"")
       .AddParameter("expression", _("Camera number (default : 0)"), "", true)
-      .SetDefaultValue("0");
+      .SetDefaultValue("0")
+      .SetSideEffectFree();
 
   extension
       .AddExpression("VueX",
@@ -531,7 +534,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsCameraExtension(
       .AddParameter("layer", _("Layer"), "", true)
       .SetDefaultValue("\"\"")
       .AddParameter("expression", _("Camera number (default : 0)"), "", true)
-      .SetDefaultValue("0");
+      .SetDefaultValue("0")
+      .SetSideEffectFree();
 
   extension
       .AddExpression("VueY",
@@ -556,7 +560,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsCameraExtension(
       .AddParameter("layer", _("Layer"), "", true)
       .SetDefaultValue("\"\"")
       .AddParameter("expression", _("Camera number (default : 0)"), "", true)
-      .SetDefaultValue("0");
+      .SetDefaultValue("0")
+      .SetSideEffectFree();
 
   extension
       .AddExpression("VueRotation",
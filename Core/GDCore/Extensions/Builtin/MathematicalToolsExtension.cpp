@@ -28,7 +28,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("First angle"))
-      .AddParameter("expression", _("Second angle"));
+      .AddParameter("expression", _("Second angle"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("mod",
@@ -37,7 +38,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("x (as in x mod y)"))
-      .AddParameter("expression", _("y (as in x mod y)"));
+      .AddParameter("expression", _("y (as in x mod y)"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("min",
@@ -46,7 +48,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("First expression"))
-      .AddParameter("expression", _("Second expression"));
+      .AddParameter("expression", _("Second expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("max",
@@ -55,7 +58,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("First expression"))
-      .AddParameter("expression", _("Second expression"));
+      .AddParameter("expression", _("Second expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("abs",
@@ -63,7 +67,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Absolute value"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("acos",
@@ -71,7 +76,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Arccosine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("acosh",
@@ -79,7 +85,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Hyperbolic arccosine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("asin",
@@ -87,7 +94,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Arcsine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("asinh",
@@ -95,7 +103,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Arcsine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("atan",
@@ -103,7 +112,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Arctangent"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("atan2",
@@ -112,7 +122,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("Y"))
-      .AddParameter("expression", _("X"));
+      .AddParameter("expression", _("X"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("atanh",
@@ -120,7 +131,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Hyperbolic arctangent"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("cbrt",
@@ -128,7 +140,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Cube root"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("ceil",
@@ -136,7 +149,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Round number up to an integer"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("floor",
@@ -144,7 +158,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Round number down to an integer"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("cos",
@@ -152,7 +167,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Cosine of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("cosh",
@@ -160,7 +176,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Hyperbolic cosine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("cot",
@@ -168,7 +185,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Cotangent of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("csc",
@@ -176,7 +194,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Cosecant of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("int",
@@ -185,7 +204,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .SetHidden()
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("rint",
@@ -194,7 +214,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .SetHidden()
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("round",
@@ -202,7 +223,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Round a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("exp",
@@ -210,7 +232,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Exponential of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("log",
@@ -218,7 +241,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Logarithm"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("ln",
@@ -227,7 +251,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .SetHidden()
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("log2",
@@ -235,7 +260,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Base 2 Logarithm"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("log10",
@@ -243,7 +269,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Base-10 logarithm"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("nthroot",
@@ -252,7 +279,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("Number"))
-      .AddParameter("expression", _("N"));
+      .AddParameter("expression", _("N"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("pow",
@@ -261,7 +289,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Mathematical tools"),
                      "res/mathfunction.png")
       .AddParameter("expression", _("Number"))
-      .AddParameter("expression", _("The exponent (n in x^n)"));
+      .AddParameter("expression", _("The exponent (n in x^n)"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("sec",
@@ -269,7 +298,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Secant"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("sign",
@@ -277,7 +307,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Return the sign of a number (1,-1 or 0)"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("sin",
@@ -285,7 +316,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Sine of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("sinh",
@@ -293,7 +325,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Hyperbolic sine"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("sqrt",
@@ -301,7 +334,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Square root of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("tan",
@@ -309,7 +343,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Tangent of a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("tanh",
@@ -317,7 +352,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Hyperbolic tangent"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("trunc",
@@ -325,7 +361,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      _("Troncate a number"),
                      _("Mathematical tools"),
                      "res/mathfunction.png")
-      .AddParameter("expression", _("Expression"));
+      .AddParameter("expression", _("Expression"))
+      .SetSideEffectFree();
 
   extension
       .AddExpression("lerp",
@@ -335,7 +372,8 @@ BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(
                      "res/mathfunction.png")
       .AddParameter("expression", _("a (in a+(b-a)*x)"))
       .AddParameter("expression", _("b (in a+(b-a)*x)"))
-      .AddParameter("expression", _("x (in a+(b-a)*x)"));
+      .AddParameter("expression", _("x (in a+(b-a)*x)"))
+      .SetSideEffectFree();
 
 #endif
 }
@@ -65,6 +65,107 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsNetworkExtension(
                     _("Path to file (for example : /folder/file.txt)"))
       .AddParameter("string", _("Save as"));
 
+  extension
+      .AddAction(
+          "SendAsyncRequest",
+          _("Send a request to a web page in the background"),
+          _("Send a request to the specified web page, without pausing the "
+            "game while waiting for the response. Use the condition \"Request "
+            "finished\" to know when the response is stored in the variable. "
+            "The request is cancelled if the scene is closed."),
+          _("Send _PARAM5_ request _PARAM1_ to _PARAM2__PARAM3_ with body: "
+            "_PARAM4_ in the background"),
+          _("Network"),
+          "res/actions/net24.png",
+          "res/actions/net.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("string", _("Name of the request"))
+      .AddParameter("string", _("Host (example: http://www.some-server.org/)"))
+      .AddParameter("string", _("Path to page (Example: /page.php)"))
+      .AddParameter("string", _("Request body content"))
+      .AddParameter(
+          "string",
+          _("Method: \"POST\" or \"GET\" (if empty, GET will be used)"),
+          "",
+          true)
+      .SetDefaultValue("\"GET\"")
+      .AddParameter(
+          "string",
+          _("Content type (application/x-www-form-urlencoded by default)"),
+          "",
+          true)
+      .AddParameter(
+          "scenevar", _("Store the response in this variable"), "", true)
+      .AddParameter("expression",
+                    _("Timeout, in seconds (0 for no timeout)"),
+                    "",
+                    true)
+      .SetDefaultValue("30")
+      .MarkAsComplex();
+
+  extension
+      .AddAction(
+          "DownloadFileAsync",
+          _("Download a file in the background"),
+          _("Download a file from a web site, without pausing the game. Use "
+            "the condition \"Request finished\" to know when the file is "
+            "saved. The download is cancelled if the scene is closed."),
+          _("Download file _PARAM3_ from _PARAM2_ under the name of _PARAM4_ "
+            "in the background (request _PARAM1_)"),
+          _("Network"),
+          "res/actions/net24.png",
+          "res/actions/net.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("string", _("Name of the request"))
+      .AddParameter("string", _("Host (for example : http://www.website.com)"))
+      .AddParameter("string",
+                    _("Path to file (for example : /folder/file.txt)"))
+      .AddParameter("string", _("Save as"))
+      .AddParameter("expression",
+                    _("Timeout, in seconds (0 for no timeout)"),
+                    "",
+                    true)
+      .SetDefaultValue("30")
+      .MarkAsAdvanced();
+
+  extension
+      .AddAction("CancelAsyncRequest",
+                 _("Cancel a request"),
+                 _("Cancel a request sent in the background. Its response is "
+                   "ignored."),
+                 _("Cancel the request _PARAM1_"),
+                 _("Network"),
+                 "res/actions/net24.png",
+                 "res/actions/net.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("string", _("Name of the request"))
+      .MarkAsAdvanced();
+
+  extension
+      .AddCondition("AsyncRequestFinished",
+                    _("Request finished"),
+                    _("Check if a request sent in the background is finished "
+                      "(successfully or not)."),
+                    _("The request _PARAM1_ is finished"),
+                    _("Network"),
+                    "res/actions/net24.png",
+                    "res/actions/net.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("string", _("Name of the request"));
+
+  extension
+      .AddCondition("AsyncRequestSucceeded",
+                    _("Request succeeded"),
+                    _("Check if a request sent in the background is finished "
+                      "and the server answered successfully."),
+                    _("The request _PARAM1_ succeeded"),
+                    _("Network"),
+                    "res/actions/net24.png",
+                    "res/actions/net.png")
+      .AddCodeOnlyParameter("currentScene", "")
+      .AddParameter("string", _("Name of the request"))
+      .MarkAsAdvanced();
+
   extension
       .AddAction(
           "JSONToVariableStructure",
@@ -114,7 +114,11 @@ void Sprite::SetCustomCollisionMask(
 #if !defined(EMSCRIPTEN)
 void Sprite::LoadImage(std::shared_ptr<SFMLTextureWrapper> image_) {
   sfmlImage = image_;
-  sfmlSprite.setTexture(sfmlImage->texture, true);
+  if (sfmlImage->atlas) {
+    sfmlSprite.setTexture(sfmlImage->atlas->texture);
+    sfmlSprite.setTextureRect(sfmlImage->atlasRect);
+  } else
+    sfmlSprite.setTexture(sfmlImage->texture, true);
   hasItsOwnImage = false;
 
   if (automaticCentre)
@@ -124,9 +128,19 @@ void Sprite::LoadImage(std::shared_ptr<SFMLTextureWrapper> image_) {
 
 void Sprite::MakeSpriteOwnsItsImage() {
   if (!hasItsOwnImage || sfmlImage == std::shared_ptr<SFMLTextureWrapper>()) {
-    sfmlImage = std::make_shared<SFMLTextureWrapper>(
-        sfmlImage->texture);  // Copy the texture.
-    sfmlSprite.setTexture(sfmlImage->texture);
+    if (sfmlImage->atlas) {
+      // The texture of the atlas is shared: create a texture from the image.
+      auto ownImage = std::make_shared<SFMLTextureWrapper>();
+      ownImage->image = sfmlImage->image;
+      ownImage->texture.loadFromImage(ownImage->image);
+      ownImage->texture.setSmooth(sfmlImage->atlas->texture.isSmooth());
+      sfmlImage = ownImage;
+      sfmlSprite.setTexture(sfmlImage->texture, true);
+    } else {
+      sfmlImage = std::make_shared<SFMLTextureWrapper>(
+          sfmlImage->texture);  // Copy the texture.
+      sfmlSprite.setTexture(sfmlImage->texture);
+    }
     hasItsOwnImage = true;
   }
 }
@@ -491,6 +491,7 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsSpriteExtension(
                     _("Position"),
                     "res/actions/position.png")
       .SetHidden()
+      .SetSideEffectFree()
       .AddParameter("object", _("Object"), "Sprite")
       .AddParameter("string", _("Name of the point"), "", true);
 
@@ -500,6 +501,7 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsSpriteExtension(
                     _("Position"),
                     "res/actions/position.png")
       .SetHidden()
+      .SetSideEffectFree()
       .AddParameter("object", _("Object"), "Sprite")
       .AddParameter("string", _("Name of the point"), "", true);
 
@@ -508,7 +510,7 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsSpriteExtension(
                     _("X position of a point"),
                     _("Position"),
                     "res/actions/position.png")
-
+      .SetSideEffectFree()
       .AddParameter("object", _("Object"), "Sprite")
       .AddParameter("string", _("Name of the point"));
 
@@ -517,7 +519,7 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsSpriteExtension(
                     _("Y position of a point"),
                     _("Position"),
                     "res/actions/position.png")
-
+      .SetSideEffectFree()
       .AddParameter("object", _("Object"), "Sprite")
       .AddParameter("string", _("Name of the point"));
 
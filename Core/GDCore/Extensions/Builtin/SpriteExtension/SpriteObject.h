@@ -116,6 +116,18 @@ class GD_CORE_API SpriteObject : public gd::Object {
    */
   void MoveAnimation(std::size_t oldIndex, std::size_t newIndex);
 
+  /**
+   * \brief Return true if the animations must be played even when the object
+   * is hidden or far from the screen.
+   */
+  bool GetUpdateIfNotVisible() const { return updateIfNotVisible; }
+
+  /**
+   * \brief Set if the animations must be played even when the object is
+   * hidden or far from the screen.
+   */
+  void SetUpdateIfNotVisible(bool enable) { updateIfNotVisible = enable; }
+
   /**
    * \brief Return a read-only reference to the vector containing all the
    * animation of the object.
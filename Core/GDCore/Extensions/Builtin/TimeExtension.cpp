@@ -127,7 +127,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsTimeExtension(
                      _("Time elapsed since the last image"),
                      _("Time"),
                      "res/actions/time.png")
-      .AddCodeOnlyParameter("currentScene", "");
+      .AddCodeOnlyParameter("currentScene", "")
+      .SetSideEffectFree();
 
   extension
       .AddExpression("TempsFrame",
@@ -100,7 +100,8 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsWindowExtension(
           _("Width of the scene window (or scene canvas for HTML5 games)"),
           _("Screen"),
           "res/window.png")
-      .AddCodeOnlyParameter("currentScene", "");
+      .AddCodeOnlyParameter("currentScene", "")
+      .SetSideEffectFree();
 
   extension
       .AddExpression(
@@ -109,21 +110,26 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsWindowExtension(
           _("Height of the scene window (or scene canvas for HTML5 games)"),
           _("Screen"),
           "res/window.png")
-      .AddCodeOnlyParameter("currentScene", "");
+      .AddCodeOnlyParameter("currentScene", "")
+      .SetSideEffectFree();
 
-  extension.AddExpression(
-      "ScreenWidth",
-      _("Width of the screen/page"),
-      _("Width of the screen (or the page for HTML5 games in browser)"),
-      _("Screen"),
-      "res/display16.png");
+  extension
+      .AddExpression(
+          "ScreenWidth",
+          _("Width of the screen/page"),
+          _("Width of the screen (or the page for HTML5 games in browser)"),
+          _("Screen"),
+          "res/display16.png")
+      .SetSideEffectFree();
 
-  extension.AddExpression(
-      "ScreenHeight",
-      _("Height of the screen/page"),
-      _("Height of the screen (or the page for HTML5 games in browser)"),
-      _("Screen"),
-      "res/display16.png");
+  extension
+      .AddExpression(
+          "ScreenHeight",
+          _("Height of the screen/page"),
+          _("Height of the screen (or the page for HTML5 games in browser)"),
+          _("Screen"),
+          "res/display16.png")
+      .SetSideEffectFree();
 
   extension.AddExpression("ColorDepth",
                           _("Color depth"),
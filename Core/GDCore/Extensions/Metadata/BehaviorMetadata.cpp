@@ -58,9 +58,8 @@ gd::InstructionMetadata& BehaviorMetadata::AddCondition(
                                                            sentence,
                                                            group,
                                                            icon,
-                                                           smallicon)
-                                           .SetHelpPath(GetHelpPath());
-  return conditionsInfos[nameWithNamespace];
+                                                           smallicon);
+  return conditionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -82,9 +81,8 @@ gd::InstructionMetadata& BehaviorMetadata::AddAction(
                                                         sentence,
                                                         group,
                                                         icon,
-                                                        smallicon)
-                                        .SetHelpPath(GetHelpPath());
-  return actionsInfos[nameWithNamespace];
+                                                        smallicon);
+  return actionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -105,9 +103,8 @@ gd::InstructionMetadata& BehaviorMetadata::AddScopedCondition(
                                                            sentence,
                                                            group,
                                                            icon,
-                                                           smallicon)
-                                           .SetHelpPath(GetHelpPath());
-  return conditionsInfos[nameWithNamespace];
+                                                           smallicon);
+  return conditionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -128,9 +125,8 @@ gd::InstructionMetadata& BehaviorMetadata::AddScopedAction(
                                                         sentence,
                                                         group,
                                                         icon,
-                                                        smallicon)
-                                        .SetHelpPath(GetHelpPath());
-  return actionsInfos[nameWithNamespace];
+                                                        smallicon);
+  return actionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
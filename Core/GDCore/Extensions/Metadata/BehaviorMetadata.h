@@ -37,6 +37,10 @@ class GD_CORE_API BehaviorMetadata {
       std::shared_ptr<gd::Behavior> instance,
       std::shared_ptr<gd::BehaviorsSharedData> sharedDatasInstance);
   BehaviorMetadata(){};
+  BehaviorMetadata(const BehaviorMetadata&) = default;
+  BehaviorMetadata(BehaviorMetadata&&) = default;
+  BehaviorMetadata& operator=(const BehaviorMetadata&) = default;
+  BehaviorMetadata& operator=(BehaviorMetadata&&) = default;
   virtual ~BehaviorMetadata(){};
 
   /**
@@ -19,6 +19,7 @@ ExpressionMetadata::ExpressionMetadata(const gd::String& extensionNamespace_,
       description(description_),
       group(group_),
       shown(true),
+      sideEffectFree(false),
       smallIconFilename(smallicon_),
       extensionNamespace(extensionNamespace_) {
 }
@@ -125,6 +125,10 @@ class GD_CORE_API ExpressionMetadata {
                      const gd::String& description,
                      const gd::String& group,
                      const gd::String& smallicon);
+  ExpressionMetadata(const ExpressionMetadata&) = default;
+  ExpressionMetadata(ExpressionMetadata&&) = default;
+  ExpressionMetadata& operator=(const ExpressionMetadata&) = default;
+  ExpressionMetadata& operator=(ExpressionMetadata&&) = default;
   virtual ~ExpressionMetadata(){};
 
   /**
@@ -132,6 +136,19 @@ class GD_CORE_API ExpressionMetadata {
    */
   ExpressionMetadata& SetHidden();
 
+  /**
+   * \brief Declare that the expression has no side effect: during the
+   * evaluation of an expression, it always returns the same result for the
+   * same parameters.
+   *
+   * This allows the code generation to evaluate it only once when it is used
+   * several times in an expression.
+   */
+  ExpressionMetadata& SetSideEffectFree() {
+    sideEffectFree = true;
+    return *this;
+  }
+
   /**
    * \brief Set the group of the instruction in the IDE.
    */
@@ -189,9 +206,10 @@ class GD_CORE_API ExpressionMetadata {
 
   /** Don't use this constructor. Only here to fullfil std::map requirements
    */
-  ExpressionMetadata() : shown(false){};
+  ExpressionMetadata() : shown(false), sideEffectFree(false){};
 
   bool IsShown() const { return shown; }
+  bool IsSideEffectFree() const { return sideEffectFree; }
   const gd::String& GetFullName() const { return fullname; }
   const gd::String& GetDescription() const { return description; }
   const gd::String& GetGroup() const { return group; }
@@ -212,6 +230,7 @@ class GD_CORE_API ExpressionMetadata {
   gd::String description;
   gd::String group;
   bool shown;
+  bool sideEffectFree;
 
   gd::String smallIconFilename;
   gd::String extensionNamespace;
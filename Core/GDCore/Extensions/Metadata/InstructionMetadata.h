@@ -227,6 +227,10 @@ class GD_CORE_API InstructionMetadata {
                       const gd::String &group,
                       const gd::String &icon,
                       const gd::String &smallIcon);
+  InstructionMetadata(const InstructionMetadata&) = default;
+  InstructionMetadata(InstructionMetadata&&) = default;
+  InstructionMetadata& operator=(const InstructionMetadata&) = default;
+  InstructionMetadata& operator=(InstructionMetadata&&) = default;
   virtual ~InstructionMetadata(){};
 
   const gd::String &GetFullName() const { return fullname; }
@@ -364,7 +368,12 @@ class GD_CORE_API InstructionMetadata {
    */
   class ExtraInformation {
    public:
-    enum AccessType { Reference, MutatorAndOrAccessor, Mutators };
+    enum AccessType {
+      Reference,
+      MutatorAndOrAccessor,
+      Mutators,
+      SettersAndGetters
+    };
     ExtraInformation() : accessType(Reference), hasCustomCodeGenerator(false){};
     virtual ~ExtraInformation(){};
 
@@ -422,6 +431,31 @@ class GD_CORE_API InstructionMetadata {
       return *this;
     }
 
+    /**
+     * \brief Declare that the instruction changes several values, each one
+     * with a setter and a getter, so that the code generator inlines the
+     * operations instead of calling a function with the operators.
+     *
+     * The n-th value is changed using the n-th operator (and the parameter
+     * after it) of the instruction, or the last one if there are fewer
+     * operators than values. SetManipulatedType must be called with "number"
+     * or "string".
+     *
+     * Usage example:
+     * \code
+     *  objectActions["MettreXY"]
+     *      .SetManipulatedType("number")
+     *      .SetSettersAndGetters({{"SetX", "GetX"}, {"SetY", "GetY"}});
+     * \endcode
+     */
+    ExtraInformation &SetSettersAndGetters(
+        const std::vector<std::pair<gd::String, gd::String> >
+            &settersAndGetters) {
+      optionalSettersAndGetters = settersAndGetters;
+      accessType = SettersAndGetters;
+      return *this;
+    }
+
     /**
      * \brief Erase any existing include file and add the specified include.
      */
@@ -476,6 +510,9 @@ class GD_CORE_API InstructionMetadata {
     AccessType accessType;
     gd::String optionalAssociatedInstruction;
     std::map<gd::String, gd::String> optionalMutators;
+    std::vector<std::pair<gd::String, gd::String> >
+        optionalSettersAndGetters;  ///< The setters and getters of the values
+                                    ///< changed by the instruction.
     bool hasCustomCodeGenerator;
     std::function<gd::String(Instruction &instruction,
                              gd::EventsCodeGenerator &codeGenerator,
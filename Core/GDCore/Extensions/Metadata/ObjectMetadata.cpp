@@ -76,9 +76,8 @@ gd::InstructionMetadata& ObjectMetadata::AddCondition(
                                                            sentence,
                                                            group,
                                                            icon,
-                                                           smallicon)
-                                           .SetHelpPath(GetHelpPath());
-  return conditionsInfos[nameWithNamespace];
+                                                           smallicon);
+  return conditionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -100,9 +99,8 @@ gd::InstructionMetadata& ObjectMetadata::AddAction(
                                                         sentence,
                                                         group,
                                                         icon,
-                                                        smallicon)
-                                        .SetHelpPath(GetHelpPath());
-  return actionsInfos[nameWithNamespace];
+                                                        smallicon);
+  return actionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -51,6 +51,10 @@ class GD_CORE_API ObjectMetadata {
                  const gd::String& icon24x24_,
                  CreateFunPtr createFunPtrP);
   ObjectMetadata() : createFunPtr(NULL) {}
+  ObjectMetadata(const ObjectMetadata&) = default;
+  ObjectMetadata(ObjectMetadata&&) = default;
+  ObjectMetadata& operator=(const ObjectMetadata&) = default;
+  ObjectMetadata& operator=(ObjectMetadata&&) = default;
   virtual ~ObjectMetadata(){};
 
   /**
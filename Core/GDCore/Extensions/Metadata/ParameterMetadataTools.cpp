@@ -60,11 +60,13 @@ void ParameterMetadataTools::IterateOverParameters(
     std::function<void(const gd::ParameterMetadata& parameterMetadata,
                        const gd::String& parameterValue,
                        const gd::String& lastObjectName)> fn) {
+  static const gd::String emptyValue;
   gd::String lastObjectName = "";
   for (std::size_t pNb = 0; pNb < parametersMetadata.size(); ++pNb) {
     const gd::ParameterMetadata& parameterMetadata = parametersMetadata[pNb];
+    // Both alternatives are references, so that the value is not copied.
     const gd::String& parameterValue =
-        pNb < parameters.size() ? parameters[pNb].GetPlainString() : "";
+        pNb < parameters.size() ? parameters[pNb].GetPlainString() : emptyValue;
     const gd::String& parameterValueOrDefault =
         parameterValue.empty() && parameterMetadata.optional
             ? parameterMetadata.defaultValue
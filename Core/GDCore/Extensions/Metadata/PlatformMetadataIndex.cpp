@@ -0,0 +1,90 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/PlatformMetadataIndex.h"
+#include <map>
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+
+namespace gd {
+
+namespace {
+/**
+ * \brief Add the metadata to the index, unless a metadata with the same name
+ * was already added by a previous extension.
+ */
+template <class T>
+void AddToIndex(std::unordered_map<gd::String, ExtensionAndMetadata<T>>& index,
+                const gd::PlatformExtension& extension,
+                const std::map<gd::String, T>& allMetadata) {
+  for (const auto& it : allMetadata)
+    index.emplace(it.first, ExtensionAndMetadata<T>(extension, it.second));
+}
+}  // namespace
+
+PlatformMetadataIndex::PlatformMetadataIndex(const gd::Platform& platform)
+    : extensionsVersion(platform.GetExtensionsVersion()) {
+  for (auto& extension : platform.GetAllPlatformExtensions()) {
+    AddToIndex(freeActions, *extension, extension->GetAllActions());
+    AddToIndex(freeConditions, *extension, extension->GetAllConditions());
+    AddToIndex(expressions, *extension, extension->GetAllExpressions());
+    AddToIndex(strExpressions, *extension, extension->GetAllStrExpressions());
+
+    // Free instructions are searched first, then object instructions and
+    // then behavior instructions.
+    AddToIndex(actions, *extension, extension->GetAllActions());
+    AddToIndex(conditions, *extension, extension->GetAllConditions());
+
+    for (const gd::String& objectType : extension->GetExtensionObjectsTypes()) {
+      objects.emplace(
+          objectType,
+          ExtensionAndMetadata<ObjectMetadata>(
+              *extension, extension->GetObjectMetadata(objectType)));
+
+      const auto& objectActions = extension->GetAllActionsForObject(objectType);
+      const auto& objectConditions =
+          extension->GetAllConditionsForObject(objectType);
+      AddToIndex(actions, *extension, objectActions);
+      AddToIndex(conditions, *extension, objectConditions);
+      AddToIndex(objectsActions[objectType], *extension, objectActions);
+      AddToIndex(objectsConditions[objectType], *extension, objectConditions);
+      AddToIndex(objectsExpressions[objectType],
+                 *extension,
+                 extension->GetAllExpressionsForObject(objectType));
+      AddToIndex(objectsStrExpressions[objectType],
+                 *extension,
+                 extension->GetAllStrExpressionsForObject(objectType));
+    }
+
+    for (const gd::String& behaviorType : extension->GetBehaviorsTypes()) {
+      behaviors.emplace(
+          behaviorType,
+          ExtensionAndMetadata<BehaviorMetadata>(
+              *extension, extension->GetBehaviorMetadata(behaviorType)));
+
+      const auto& behaviorActions =
+          extension->GetAllActionsForBehavior(behaviorType);
+      const auto& behaviorConditions =
+          extension->GetAllConditionsForBehavior(behaviorType);
+      AddToIndex(actions, *extension, behaviorActions);
+      AddToIndex(conditions, *extension, behaviorConditions);
+      AddToIndex(behaviorsActions[behaviorType], *extension, behaviorActions);
+      AddToIndex(
+          behaviorsConditions[behaviorType], *extension, behaviorConditions);
+      AddToIndex(behaviorsExpressions[behaviorType],
+                 *extension,
+                 extension->GetAllExpressionsForBehavior(behaviorType));
+      AddToIndex(behaviorsStrExpressions[behaviorType],
+                 *extension,
+                 extension->GetAllStrExpressionsForBehavior(behaviorType));
+    }
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,207 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_PLATFORMMETADATAINDEX_H
+#define GDCORE_PLATFORMMETADATAINDEX_H
+#include <unordered_map>
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/String.h"
+namespace gd {
+class Platform;
+class PlatformExtension;
+class BehaviorMetadata;
+class ObjectMetadata;
+class InstructionMetadata;
+class ExpressionMetadata;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Index of the metadata of all the extensions of a platform, so that
+ * gd::MetadataProvider finds an instruction, an expression, an object or a
+ * behavior without going through all the extensions.
+ *
+ * The index is built from the extensions in the order they were added to the
+ * platform: when several extensions declare the same name, the metadata of
+ * the first one is used, as when going through the extensions.
+ *
+ * \note The index is built by gd::Platform::GetMetadataIndex and is built
+ * again after an extension is added or removed. The metadata of an extension
+ * must not be changed after the extension is added to the platform.
+ *
+ * \see gd::MetadataProvider
+ */
+class GD_CORE_API PlatformMetadataIndex {
+ public:
+  PlatformMetadataIndex(const gd::Platform& platform);
+  virtual ~PlatformMetadataIndex(){};
+
+  /**
+   * \brief Return the behavior with the given type, or nullptr if not found.
+   */
+  const ExtensionAndMetadata<BehaviorMetadata>* FindBehavior(
+      const gd::String& behaviorType) const {
+    return Find(behaviors, behaviorType);
+  }
+
+  /**
+   * \brief Return the object with the given type, or nullptr if not found.
+   */
+  const ExtensionAndMetadata<ObjectMetadata>* FindObject(
+      const gd::String& objectType) const {
+    return Find(objects, objectType);
+  }
+
+  /**
+   * \brief Return the action with the given type (free, object or behavior
+   * action), or nullptr if not found.
+   */
+  const ExtensionAndMetadata<InstructionMetadata>* FindAction(
+      const gd::String& actionType) const {
+    return Find(actions, actionType);
+  }
+
+  /**
+   * \brief Return the condition with the given type (free, object or
+   * behavior condition), or nullptr if not found.
+   */
+  const ExtensionAndMetadata<InstructionMetadata>* FindCondition(
+      const gd::String& conditionType) const {
+    return Find(conditions, conditionType);
+  }
+
+  /** \name Free instructions and expressions
+   */
+  ///@{
+  const ExtensionAndMetadata<InstructionMetadata>* FindFreeAction(
+      const gd::String& name) const {
+    return Find(freeActions, name);
+  }
+  const ExtensionAndMetadata<InstructionMetadata>* FindFreeCondition(
+      const gd::String& name) const {
+    return Find(freeConditions, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindExpression(
+      const gd::String& name) const {
+    return Find(expressions, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindStrExpression(
+      const gd::String& name) const {
+    return Find(strExpressions, name);
+  }
+  ///@}
+
+  /** \name Object instructions and expressions
+   * The functions of the base object (declared with an empty type) are
+   * returned if no function is declared for the given object type.
+   */
+  ///@{
+  const ExtensionAndMetadata<InstructionMetadata>* FindObjectAction(
+      const gd::String& objectType, const gd::String& name) const {
+    return FindWithBase(objectsActions, objectType, name);
+  }
+  const ExtensionAndMetadata<InstructionMetadata>* FindObjectCondition(
+      const gd::String& objectType, const gd::String& name) const {
+    return FindWithBase(objectsConditions, objectType, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindObjectExpression(
+      const gd::String& objectType, const gd::String& name) const {
+    return FindWithBase(objectsExpressions, objectType, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindObjectStrExpression(
+      const gd::String& objectType, const gd::String& name) const {
+    return FindWithBase(objectsStrExpressions, objectType, name);
+  }
+  ///@}
+
+  /** \name Behavior instructions and expressions
+   * The functions of the base behavior (declared with an empty type) are
+   * returned if no function is declared for the given behavior type.
+   */
+  ///@{
+  const ExtensionAndMetadata<InstructionMetadata>* FindBehaviorAction(
+      const gd::String& behaviorType, const gd::String& name) const {
+    return FindWithBase(behaviorsActions, behaviorType, name);
+  }
+  const ExtensionAndMetadata<InstructionMetadata>* FindBehaviorCondition(
+      const gd::String& behaviorType, const gd::String& name) const {
+    return FindWithBase(behaviorsConditions, behaviorType, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindBehaviorExpression(
+      const gd::String& behaviorType, const gd::String& name) const {
+    return FindWithBase(behaviorsExpressions, behaviorType, name);
+  }
+  const ExtensionAndMetadata<ExpressionMetadata>* FindBehaviorStrExpression(
+      const gd::String& behaviorType, const gd::String& name) const {
+    return FindWithBase(behaviorsStrExpressions, behaviorType, name);
+  }
+  ///@}
+
+  /**
+   * \brief Return the version of the extensions of the platform used to
+   * build the index.
+   *
+   * \see gd::Platform::GetExtensionsVersion
+   */
+  std::size_t GetExtensionsVersion() const { return extensionsVersion; }
+
+ private:
+  template <class T>
+  using MetadataByName =
+      std::unordered_map<gd::String, ExtensionAndMetadata<T>>;
+  template <class T>
+  using MetadataByTypeAndName =
+      std::unordered_map<gd::String, MetadataByName<T>>;
+
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const MetadataByName<T>& index,
+                                             const gd::String& name) {
+    auto it = index.find(name);
+    return it != index.end() ? &it->second : nullptr;
+  }
+
+  template <class T>
+  static const ExtensionAndMetadata<T>* FindWithBase(
+      const MetadataByTypeAndName<T>& index,
+      const gd::String& type,
+      const gd::String& name) {
+    auto it = index.find(type);
+    if (it != index.end()) {
+      const ExtensionAndMetadata<T>* metadata = Find(it->second, name);
+      if (metadata) return metadata;
+    }
+
+    it = index.find("");
+    return it != index.end() ? Find(it->second, name) : nullptr;
+  }
+
+  MetadataByName<BehaviorMetadata> behaviors;
+  MetadataByName<ObjectMetadata> objects;
+  MetadataByName<InstructionMetadata> actions;
+  MetadataByName<InstructionMetadata> conditions;
+
+  MetadataByName<InstructionMetadata> freeActions;
+  MetadataByName<InstructionMetadata> freeConditions;
+  MetadataByName<ExpressionMetadata> expressions;
+  MetadataByName<ExpressionMetadata> strExpressions;
+
+  MetadataByTypeAndName<InstructionMetadata> objectsActions;
+  MetadataByTypeAndName<InstructionMetadata> objectsConditions;
+  MetadataByTypeAndName<ExpressionMetadata> objectsExpressions;
+  MetadataByTypeAndName<ExpressionMetadata> objectsStrExpressions;
+
+  MetadataByTypeAndName<InstructionMetadata> behaviorsActions;
+  MetadataByTypeAndName<InstructionMetadata> behaviorsConditions;
+  MetadataByTypeAndName<ExpressionMetadata> behaviorsExpressions;
+  MetadataByTypeAndName<ExpressionMetadata> behaviorsStrExpressions;
+
+  std::size_t extensionsVersion;  ///< The version of the extensions of the
+                                  ///< platform used to build the index.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_PLATFORMMETADATAINDEX_H
@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "Platform.h"
+#include "GDCore/Extensions/Metadata/PlatformMetadataIndex.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/String.h"
@@ -14,7 +15,7 @@ using namespace std;
 
 namespace gd {
 
-Platform::Platform() {}
+Platform::Platform() : extensionsVersion(0), metadataIndexBuilt(false) {}
 
 Platform::~Platform() {}
 
@@ -29,6 +30,8 @@ bool Platform::AddExtension(std::shared_ptr<gd::PlatformExtension> extension) {
   std::cout << std::endl;
 
   extensionsLoaded.push_back(extension);
+  extensionsVersion++;
+  metadataIndexBuilt = false;
 
   // Load all creation/destruction functions for objects provided by the
   // extension
@@ -61,6 +64,20 @@ void Platform::RemoveExtension(const gd::String& name) {
                   return extension->GetName() == name;
                 }),
       extensionsLoaded.end());
+  extensionsVersion++;
+  metadataIndexBuilt = false;
+}
+
+const gd::PlatformMetadataIndex& Platform::GetMetadataIndex() const {
+  if (!metadataIndexBuilt.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(metadataIndexMutex);
+    if (!metadataIndexBuilt.load(std::memory_order_relaxed)) {
+      metadataIndex.reset(new gd::PlatformMetadataIndex(*this));
+      metadataIndexBuilt.store(true, std::memory_order_release);
+    }
+  }
+
+  return *metadataIndex;
 }
 
 bool Platform::IsExtensionLoaded(const gd::String& name) const {
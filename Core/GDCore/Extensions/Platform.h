@@ -6,8 +6,10 @@
 
 #ifndef GDCORE_PLATFORM_H
 #define GDCORE_PLATFORM_H
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -23,6 +25,7 @@ class BehaviorsSharedData;
 class PlatformExtension;
 class LayoutEditorCanvas;
 class ProjectExporter;
+class PlatformMetadataIndex;
 }  // namespace gd
 
 typedef std::function<std::unique_ptr<gd::Object>(gd::String name)>
@@ -123,6 +126,26 @@ class GD_CORE_API Platform {
    * anymore.
    */
   virtual void RemoveExtension(const gd::String& name);
+
+  /**
+   * \brief Return a number that is changed each time an extension is added
+   * or removed.
+   *
+   * Can be used to know if something computed from the metadata of the
+   * extensions must be computed again.
+   */
+  std::size_t GetExtensionsVersion() const { return extensionsVersion; }
+
+  /**
+   * \brief Return the index of the metadata of the extensions, used by
+   * gd::MetadataProvider to find metadata without going through all the
+   * extensions.
+   *
+   * The index is built when first used after an extension was added or
+   * removed. It can be used by several threads at the same time, as long as
+   * no extension is added or removed in the meantime.
+   */
+  const gd::PlatformMetadataIndex& GetMetadataIndex() const;
   ///@}
 
   /** \name Factory method
@@ -172,6 +195,13 @@ class GD_CORE_API Platform {
  private:
   std::vector<std::shared_ptr<PlatformExtension>>
       extensionsLoaded;  ///< Extensions of the platform
+  std::size_t extensionsVersion;  ///< Changed each time an extension is added
+                                  ///< or removed.
+  mutable std::unique_ptr<gd::PlatformMetadataIndex>
+      metadataIndex;  ///< Built when first used, see GetMetadataIndex.
+  mutable std::atomic<bool> metadataIndexBuilt;
+  mutable std::mutex metadataIndexMutex;  ///< Protects the building of the
+                                          ///< index.
   std::map<gd::String, CreateFunPtr>
       creationFunctionTable;  ///< Creation functions for objects
 };
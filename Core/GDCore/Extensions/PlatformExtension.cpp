@@ -47,9 +47,8 @@ gd::InstructionMetadata& PlatformExtension::AddCondition(
                                                            sentence,
                                                            group,
                                                            icon,
-                                                           smallicon)
-                                           .SetHelpPath(GetHelpPath());
-  return conditionsInfos[nameWithNamespace];
+                                                           smallicon);
+  return conditionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -71,9 +70,8 @@ gd::InstructionMetadata& PlatformExtension::AddAction(
                                                         sentence,
                                                         group,
                                                         icon,
-                                                        smallicon)
-                                        .SetHelpPath(GetHelpPath());
-  return actionsInfos[nameWithNamespace];
+                                                        smallicon);
+  return actionsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 #endif
 }
 
@@ -128,10 +126,9 @@ gd::ObjectMetadata& PlatformExtension::AddObject(
                                                    fullname,
                                                    description,
                                                    icon24x24,
-                                                   instance)
-                                        .SetHelpPath(GetHelpPath());
+                                                   instance);
 
-  return objectsInfos[nameWithNamespace];
+  return objectsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 }
 
 gd::BehaviorMetadata& PlatformExtension::AddBehavior(
@@ -155,9 +152,8 @@ gd::BehaviorMetadata& PlatformExtension::AddBehavior(
                                                       icon24x24,
                                                       className,
                                                       instance,
-                                                      sharedDatasInstance)
-                                         .SetHelpPath(GetHelpPath());
-  return behaviorsInfo[nameWithNamespace];
+                                                      sharedDatasInstance);
+  return behaviorsInfo[nameWithNamespace].SetHelpPath(GetHelpPath());
 }
 
 gd::EventMetadata& PlatformExtension::AddEvent(
@@ -424,6 +420,7 @@ void PlatformExtension::StripUnimplementedInstructionsAndExpressions() {
            GetAllActions().begin();
        it != GetAllActions().end();) {
     if (it->second.codeExtraInformation.functionCallName.empty() &&
+        it->second.codeExtraInformation.optionalSettersAndGetters.empty() &&
         !it->second.codeExtraInformation.HasCustomCodeGenerator()) {
       GetAllActions().erase(it++);
     } else
@@ -470,6 +467,7 @@ void PlatformExtension::StripUnimplementedInstructionsAndExpressions() {
              obj.actionsInfos.begin();
          it != obj.actionsInfos.end();) {
       if (it->second.codeExtraInformation.functionCallName.empty() &&
+          it->second.codeExtraInformation.optionalSettersAndGetters.empty() &&
           !it->second.codeExtraInformation.HasCustomCodeGenerator()) {
         obj.actionsInfos.erase(it++);
       } else
@@ -517,6 +515,7 @@ void PlatformExtension::StripUnimplementedInstructionsAndExpressions() {
              obj.actionsInfos.begin();
          it != obj.actionsInfos.end();) {
       if (it->second.codeExtraInformation.functionCallName.empty() &&
+          it->second.codeExtraInformation.optionalSettersAndGetters.empty() &&
           !it->second.codeExtraInformation.HasCustomCodeGenerator()) {
         obj.actionsInfos.erase(it++);
       } else
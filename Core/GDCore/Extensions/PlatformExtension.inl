@@ -27,10 +27,9 @@ gd::ObjectMetadata& PlatformExtension::AddObject(const gd::String& name,
                      icon24x24,
                      [](gd::String name) -> std::unique_ptr<gd::Object> {
                        return gd::make_unique<T>(name);
-                     })
-          .SetHelpPath(GetHelpPath());
+                     });
 
-  return objectsInfos[nameWithNamespace];
+  return objectsInfos[nameWithNamespace].SetHelpPath(GetHelpPath());
 }
 
 }  // namespace gd
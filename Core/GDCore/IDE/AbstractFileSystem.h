@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_ABSTRACTFILESYSTEM
 #define GDCORE_ABSTRACTFILESYSTEM
+#include <cstdint>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -120,6 +121,20 @@ class GD_CORE_API AbstractFileSystem {
    */
   virtual gd::String ReadFile(const gd::String& file) = 0;
 
+  /**
+   * \brief Get the size (in bytes) and the time of the last modification (in
+   * milliseconds) of a file, allowing to quickly know if a file changed.
+   *
+   * \return true if the information could be read. The default
+   * implementation always returns false, meaning that the information is not
+   * available.
+   */
+  virtual bool GetFileInfo(const gd::String& file,
+                           std::uint64_t& size,
+                           std::int64_t& lastModificationTime) {
+    return false;
+  };
+
   /**
    * \brief Return a vector containing the files in the specified path
    *
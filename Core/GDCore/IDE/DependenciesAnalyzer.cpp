@@ -17,19 +17,30 @@
 
 DependenciesAnalyzer::DependenciesAnalyzer(gd::Project& project_,
                                            gd::Layout& layout_)
-    : project(project_), layout(&layout_), externalEvents(NULL) {
+    : linkedEventsDependencies(std::make_shared<std::map<
+                                   std::pair<gd::String, bool>,
+                                   LinkedEventsDependencies> >()),
+      project(project_),
+      layout(&layout_),
+      externalEvents(NULL) {
   parentScenes.push_back(layout->GetName());
 }
 
 DependenciesAnalyzer::DependenciesAnalyzer(gd::Project& project_,
                                            gd::ExternalEvents& externalEvents_)
-    : project(project_), layout(NULL), externalEvents(&externalEvents_) {
+    : linkedEventsDependencies(std::make_shared<std::map<
+                                   std::pair<gd::String, bool>,
+                                   LinkedEventsDependencies> >()),
+      project(project_),
+      layout(NULL),
+      externalEvents(&externalEvents_) {
   parentExternalEvents.push_back(externalEvents->GetName());
 }
 
 DependenciesAnalyzer::DependenciesAnalyzer(const DependenciesAnalyzer& parent)
     : parentScenes(parent.parentScenes),
       parentExternalEvents(parent.parentExternalEvents),
+      linkedEventsDependencies(parent.linkedEventsDependencies),
       project(parent.project),
       layout(NULL),
       externalEvents(NULL) {}
@@ -51,7 +62,7 @@ bool DependenciesAnalyzer::Analyze(gd::EventsList& events, bool isOnTopLevel) {
   for (unsigned int i = 0; i < events.size(); ++i) {
     gd::LinkEvent* linkEvent = dynamic_cast<gd::LinkEvent*>(&events[i]);
     if (linkEvent) {
-      DependenciesAnalyzer analyzer(*this);
+      const LinkedEventsDependencies* dependencies = nullptr;
 
       gd::String linked = linkEvent->GetTarget();
       if (project.HasExternalEventsNamed(linked)) {
@@ -63,10 +74,8 @@ bool DependenciesAnalyzer::Analyze(gd::EventsList& events, bool isOnTopLevel) {
         externalEventsDependencies.insert(
             linked);  // There is a direct dependency
         if (!isOnTopLevel) notTopLevelExternalEventsDependencies.insert(linked);
-        analyzer.AddParentExternalEvents(linked);
-        if (!analyzer.Analyze(project.GetExternalEvents(linked).GetEvents(),
-                              isOnTopLevel))
-          return false;
+        dependencies = AnalyzeLinkedEvents(linked, true, isOnTopLevel);
+        if (!dependencies) return false;
 
       } else if (project.HasLayoutNamed(linked)) {
         if (std::find(parentScenes.begin(), parentScenes.end(), linked) !=
@@ -75,35 +84,32 @@ bool DependenciesAnalyzer::Analyze(gd::EventsList& events, bool isOnTopLevel) {
 
         scenesDependencies.insert(linked);  // There is a direct dependency
         if (!isOnTopLevel) notTopLevelScenesDependencies.insert(linked);
-        analyzer.AddParentScene(linked);
-        if (!analyzer.Analyze(project.GetLayout(linked).GetEvents(),
-                              isOnTopLevel))
-          return false;
+        dependencies = AnalyzeLinkedEvents(linked, false, isOnTopLevel);
+        if (!dependencies) return false;
       }
 
       // Update with indirect dependencies.
-      scenesDependencies.insert(analyzer.GetScenesDependencies().begin(),
-                                analyzer.GetScenesDependencies().end());
-      externalEventsDependencies.insert(
-          analyzer.GetExternalEventsDependencies().begin(),
-          analyzer.GetExternalEventsDependencies().end());
-      sourceFilesDependencies.insert(
-          analyzer.GetSourceFilesDependencies().begin(),
-          analyzer.GetSourceFilesDependencies().end());
-      notTopLevelScenesDependencies.insert(
-          analyzer.GetNotTopLevelScenesDependencies().begin(),
-          analyzer.GetNotTopLevelScenesDependencies().end());
-      notTopLevelExternalEventsDependencies.insert(
-          analyzer.GetNotTopLevelExternalEventsDependencies().begin(),
-          analyzer.GetNotTopLevelExternalEventsDependencies().end());
-
-      if (!isOnTopLevel) {
+      if (dependencies) {
+        scenesDependencies.insert(dependencies->scenes.begin(),
+                                  dependencies->scenes.end());
+        externalEventsDependencies.insert(dependencies->externalEvents.begin(),
+                                          dependencies->externalEvents.end());
+        sourceFilesDependencies.insert(dependencies->sourceFiles.begin(),
+                                       dependencies->sourceFiles.end());
         notTopLevelScenesDependencies.insert(
-            analyzer.GetScenesDependencies().begin(),
-            analyzer.GetScenesDependencies().end());
+            dependencies->notTopLevelScenes.begin(),
+            dependencies->notTopLevelScenes.end());
         notTopLevelExternalEventsDependencies.insert(
-            analyzer.GetExternalEventsDependencies().begin(),
-            analyzer.GetExternalEventsDependencies().end());
+            dependencies->notTopLevelExternalEvents.begin(),
+            dependencies->notTopLevelExternalEvents.end());
+
+        if (!isOnTopLevel) {
+          notTopLevelScenesDependencies.insert(dependencies->scenes.begin(),
+                                               dependencies->scenes.end());
+          notTopLevelExternalEventsDependencies.insert(
+              dependencies->externalEvents.begin(),
+              dependencies->externalEvents.end());
+        }
       }
     }
 
@@ -126,6 +132,47 @@ bool DependenciesAnalyzer::Analyze(gd::EventsList& events, bool isOnTopLevel) {
   return true;
 }
 
+const DependenciesAnalyzer::LinkedEventsDependencies*
+DependenciesAnalyzer::AnalyzeLinkedEvents(const gd::String& linked,
+                                          bool isExternalEvents,
+                                          bool isOnTopLevel) {
+  auto key = std::make_pair(linked, isOnTopLevel);
+  auto it = linkedEventsDependencies->find(key);
+  if (it != linkedEventsDependencies->end()) {
+    // The linked events were analyzed before, without circular dependencies.
+    // There is a circular dependency only if they depend on the events being
+    // analyzed.
+    for (const gd::String& parentScene : parentScenes)
+      if (it->second.scenes.count(parentScene)) return nullptr;
+    for (const gd::String& parentExternalEvent : parentExternalEvents)
+      if (it->second.externalEvents.count(parentExternalEvent)) return nullptr;
+
+    return &it->second;
+  }
+
+  DependenciesAnalyzer analyzer(*this);
+  if (isExternalEvents) {
+    analyzer.AddParentExternalEvents(linked);
+    if (!analyzer.Analyze(project.GetExternalEvents(linked).GetEvents(),
+                          isOnTopLevel))
+      return nullptr;
+  } else {
+    analyzer.AddParentScene(linked);
+    if (!analyzer.Analyze(project.GetLayout(linked).GetEvents(), isOnTopLevel))
+      return nullptr;
+  }
+
+  LinkedEventsDependencies& dependencies = (*linkedEventsDependencies)[key];
+  dependencies.scenes = std::move(analyzer.scenesDependencies);
+  dependencies.externalEvents = std::move(analyzer.externalEventsDependencies);
+  dependencies.sourceFiles = std::move(analyzer.sourceFilesDependencies);
+  dependencies.notTopLevelScenes =
+      std::move(analyzer.notTopLevelScenesDependencies);
+  dependencies.notTopLevelExternalEvents =
+      std::move(analyzer.notTopLevelExternalEventsDependencies);
+  return &dependencies;
+}
+
 gd::String DependenciesAnalyzer::ExternalEventsCanBeCompiledForAScene() {
   if (!externalEvents) {
     std::cout << "ERROR: ExternalEventsCanBeCompiledForAScene called without "
@@ -138,7 +185,9 @@ gd::String DependenciesAnalyzer::ExternalEventsCanBeCompiledForAScene() {
   for (unsigned int i = 0; i < project.GetLayoutsCount(); ++i) {
     // For each layout, compute the dependencies and the dependencies which are
     // not coming from a top level event.
+    // The dependencies of the linked events are the same for all layouts.
     DependenciesAnalyzer analyzer(project, project.GetLayout(i));
+    analyzer.linkedEventsDependencies = linkedEventsDependencies;
     if (!analyzer.Analyze()) continue;  // Analyze failed -> Cyclic dependencies
     const std::set<gd::String>& dependencies =
         analyzer.GetExternalEventsDependencies();
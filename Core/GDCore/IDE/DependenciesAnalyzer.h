@@ -6,9 +6,11 @@
 #if defined(GD_IDE_ONLY)
 #ifndef DEPENDENCIESANALYZER_H
 #define DEPENDENCIESANALYZER_H
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include "GDCore/String.h"
 namespace gd {
@@ -29,6 +31,11 @@ class ExternalEvents;
 
 /**
  * \brief Compute the dependencies of a scene or external events.
+ *
+ * The dependencies of each layout or external events linked by the events
+ * are computed only once, even if they are linked several times (directly or
+ * not). They are remembered by the analyzer, so it must not be used anymore
+ * after the events of the project are modified.
  */
 class GD_CORE_API DependenciesAnalyzer {
  public:
@@ -126,6 +133,31 @@ class GD_CORE_API DependenciesAnalyzer {
    */
   bool Analyze(gd::EventsList& events, bool isOnTopLevel);
 
+  /**
+   * \brief The dependencies of linked layout or external events.
+   */
+  struct LinkedEventsDependencies {
+    std::set<gd::String> scenes;
+    std::set<gd::String> externalEvents;
+    std::set<gd::String> sourceFiles;
+    std::set<gd::String> notTopLevelScenes;
+    std::set<gd::String> notTopLevelExternalEvents;
+  };
+
+  /**
+   * \brief Return the dependencies of the layout or external events linked by
+   * a link event, computing them if they were not computed before.
+   *
+   * \param linked The name of the linked layout or external events.
+   * \param isExternalEvents True if the external events are linked, false if
+   * it's the layout.
+   * \param isOnTopLevel True if the link event is on the top level.
+   * \return The dependencies, or nullptr if there is a circular dependency.
+   */
+  const LinkedEventsDependencies* AnalyzeLinkedEvents(const gd::String& linked,
+                                                      bool isExternalEvents,
+                                                      bool isOnTopLevel);
+
   /**
    * \brief Internal constructor used when analyzing a linked layout/external
    * events.
@@ -160,6 +192,12 @@ class GD_CORE_API DependenciesAnalyzer {
       parentScenes;  ///< Used to check for circular dependencies.
   std::vector<gd::String>
       parentExternalEvents;  ///< Used to check for circular dependencies.
+  std::shared_ptr<
+      std::map<std::pair<gd::String, bool>, LinkedEventsDependencies> >
+      linkedEventsDependencies;  ///< The dependencies of the linked events
+                                 ///< already analyzed, by name and by
+                                 ///< "isOnTopLevel". Shared with the analyzers
+                                 ///< of the linked events.
 
   gd::Project& project;
   gd::Layout* layout;
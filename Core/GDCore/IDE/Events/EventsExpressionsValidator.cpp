@@ -0,0 +1,123 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Events/EventsExpressionsValidator.h"
+#include <algorithm>
+#include <functional>
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/IDE/Events/ArbitraryEventsWorker.h"
+#include "GDCore/IDE/Events/ExpressionValidator.h"
+#include "GDCore/Tools/Threads.h"
+
+namespace gd {
+
+namespace {
+
+/**
+ * \brief A parameter of an instruction containing an expression.
+ */
+struct ExpressionParameter {
+  const gd::Instruction* instruction;
+  std::size_t parameterIndex;
+  const char* type;  ///< "number" or "string".
+};
+
+/**
+ * \brief List the parameters of the instructions containing an expression.
+ */
+class ExpressionParametersLister : public ArbitraryEventsWorker {
+ public:
+  ExpressionParametersLister(const gd::Platform& platform_,
+                             std::vector<ExpressionParameter>& parameters_)
+      : platform(platform_), parameters(parameters_){};
+  virtual ~ExpressionParametersLister(){};
+
+ private:
+  bool DoVisitInstruction(gd::Instruction& instruction,
+                          bool isCondition) override {
+    const gd::InstructionMetadata& metadata =
+        isCondition ? MetadataProvider::GetConditionMetadata(
+                          platform, instruction.GetType())
+                    : MetadataProvider::GetActionMetadata(
+                          platform, instruction.GetType());
+
+    for (std::size_t i = 0; i < instruction.GetParametersCount() &&
+                            i < metadata.GetParametersCount();
+         ++i) {
+      const gd::String& type = metadata.GetParameter(i).GetType();
+      if (ParameterMetadata::IsExpression("number", type))
+        parameters.push_back(ExpressionParameter{&instruction, i, "number"});
+      else if (ParameterMetadata::IsExpression("string", type))
+        parameters.push_back(ExpressionParameter{&instruction, i, "string"});
+    }
+
+    return false;
+  }
+
+  const gd::Platform& platform;
+  std::vector<ExpressionParameter>& parameters;
+};
+
+}  // namespace
+
+std::vector<EventsExpressionError> EventsExpressionsValidator::Validate(
+    const gd::Platform& platform,
+    gd::ExpressionParser2Cache& cache,
+    const gd::ObjectsContainer& globalObjectsContainer,
+    const gd::ObjectsContainer& objectsContainer,
+    gd::EventsList& events,
+    std::size_t threadsCount) {
+  std::vector<ExpressionParameter> parameters;
+  ExpressionParametersLister lister(platform, parameters);
+  lister.Launch(events);
+
+  // Validate the expressions by batches, each one having its own errors so
+  // that the threads don't wait for each other.
+  const std::size_t batchSize = 64;
+  std::size_t batchesCount = (parameters.size() + batchSize - 1) / batchSize;
+  std::vector<std::vector<EventsExpressionError> > batchesErrors(batchesCount);
+
+  std::vector<std::function<void()> > batches;
+  for (std::size_t batch = 0; batch < batchesCount; ++batch) {
+    batches.push_back([&, batch]() {
+      std::size_t end = std::min(parameters.size(), (batch + 1) * batchSize);
+      for (std::size_t i = batch * batchSize; i < end; ++i) {
+        const ExpressionParameter& parameter = parameters[i];
+        auto node = cache.ParseExpression(
+            platform,
+            globalObjectsContainer,
+            objectsContainer,
+            parameter.type,
+            parameter.instruction->GetParameter(parameter.parameterIndex)
+                .GetPlainString());
+
+        // The tree is shared with the cache, but the validator doesn't
+        // modify it.
+        gd::ExpressionValidator validator;
+        node->Visit(validator);
+        for (auto error : validator.GetErrors()) {
+          batchesErrors[batch].push_back(
+              EventsExpressionError(parameter.instruction,
+                                    parameter.parameterIndex,
+                                    error->GetMessage(),
+                                    error->GetStartPosition(),
+                                    error->GetEndPosition()));
+        }
+      }
+    });
+  }
+  gd::CallOnThreads(batches, threadsCount);
+
+  std::vector<EventsExpressionError> errors;
+  for (auto& batchErrors : batchesErrors)
+    errors.insert(errors.end(), batchErrors.begin(), batchErrors.end());
+
+  return errors;
+}
+
+}  // namespace gd
@@ -0,0 +1,103 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_EVENTSEXPRESSIONSVALIDATOR_H
+#define GDCORE_EVENTSEXPRESSIONSVALIDATOR_H
+
+#include <cstddef>
+#include <vector>
+#include "GDCore/String.h"
+namespace gd {
+class EventsList;
+class ExpressionParser2Cache;
+class Instruction;
+class ObjectsContainer;
+class Platform;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief An error in an expression used as a parameter of an instruction.
+ *
+ * \see gd::EventsExpressionsValidator
+ */
+class GD_CORE_API EventsExpressionError {
+ public:
+  EventsExpressionError(const gd::Instruction* instruction_,
+                        std::size_t parameterIndex_,
+                        const gd::String& message_,
+                        std::size_t startPosition_,
+                        std::size_t endPosition_)
+      : instruction(instruction_),
+        parameterIndex(parameterIndex_),
+        message(message_),
+        startPosition(startPosition_),
+        endPosition(endPosition_){};
+  ~EventsExpressionError(){};
+
+  /**
+   * \brief The instruction with the invalid expression.
+   * \warning Only valid as long as the events are not modified.
+   */
+  const gd::Instruction* GetInstruction() const { return instruction; }
+
+  /**
+   * \brief The index of the parameter with the invalid expression.
+   */
+  std::size_t GetParameterIndex() const { return parameterIndex; }
+
+  const gd::String& GetMessage() const { return message; }
+  std::size_t GetStartPosition() const { return startPosition; }
+  std::size_t GetEndPosition() const { return endPosition; }
+
+ private:
+  const gd::Instruction* instruction;
+  std::size_t parameterIndex;
+  gd::String message;
+  std::size_t startPosition;
+  std::size_t endPosition;
+};
+
+/**
+ * \brief Validate all the expressions used as parameters of the instructions
+ * of events, on several threads.
+ *
+ * The expressions are parsed using the given cache, so that expressions that
+ * were already parsed (for example by a previous validation of the same
+ * events, or by the code generation) are not parsed again.
+ *
+ * \see gd::ExpressionValidator
+ * \see gd::ExpressionParser2Cache
+ *
+ * \ingroup IDE
+ */
+class GD_CORE_API EventsExpressionsValidator {
+ public:
+  /**
+   * \brief Return the errors of all the expressions used as parameters of the
+   * instructions of the events (and of their sub events).
+   *
+   * The errors are returned in the order of the events and instructions.
+   *
+   * \param threadsCount The number of threads used to parse and validate the
+   * expressions, including the calling thread.
+   * \warning The events must not be modified while they are validated.
+   */
+  static std::vector<EventsExpressionError> Validate(
+      const gd::Platform& platform,
+      gd::ExpressionParser2Cache& cache,
+      const gd::ObjectsContainer& globalObjectsContainer,
+      const gd::ObjectsContainer& objectsContainer,
+      gd::EventsList& events,
+      std::size_t threadsCount);
+
+ private:
+  EventsExpressionsValidator(){};
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_EVENTSEXPRESSIONSVALIDATOR_H
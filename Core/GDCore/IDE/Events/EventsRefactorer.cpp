@@ -5,6 +5,7 @@
  */
 
 #include "GDCore/IDE/Events/EventsRefactorer.h"
+#include <algorithm>
 #include <memory>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Event.h"
@@ -22,6 +23,16 @@ using namespace std;
 
 namespace gd {
 
+namespace {
+/**
+ * \brief Return false if the name is not written in the expression: the
+ * expression can't use it and doesn't need to be parsed.
+ */
+bool MayUseName(const gd::String& expression, const gd::String& name) {
+  return expression.Raw().find(name.Raw()) != std::string::npos;
+}
+}  // namespace
+
 /**
  * \brief Go through the nodes and change the given object name to a new one.
  *
@@ -34,12 +45,48 @@ class GD_CORE_API ExpressionObjectRenamer : public ExpressionParser2NodeWorker {
       : hasDoneRenaming(false), objectName(objectName_), objectNewName(objectNewName_){};
   virtual ~ExpressionObjectRenamer(){};
 
-  static bool Rename(gd::ExpressionNode & node, const gd::String& objectName, const gd::String& objectNewName) {
+  /**
+   * \brief Rename the object in the tree of \a expression, and set the
+   * renamed expression in \a renamedExpression.
+   *
+   * Only the object names are replaced in the expression, so that the rest of
+   * it is kept as written.
+   *
+   * \return true if the object was renamed.
+   */
+  static bool Rename(gd::ExpressionNode & node, const gd::String& expression, const gd::String& objectName, const gd::String& objectNewName, gd::String& renamedExpression) {
     if (ExpressionValidator::HasNoErrors(node)) {  
       ExpressionObjectRenamer renamer(objectName, objectNewName);
       node.Visit(renamer);
+      if (!renamer.HasDoneRenaming()) return false;
+
+      // Replace the names from the end, so that the positions of the
+      // previous ones are unchanged.
+      std::sort(renamer.renamedLocations.begin(),
+                renamer.renamedLocations.end(),
+                [](const gd::ExpressionParserLocation& a,
+                   const gd::ExpressionParserLocation& b) {
+                  return a.GetStartPosition() < b.GetStartPosition();
+                });
+      renamedExpression = expression;
+      for (auto it = renamer.renamedLocations.rbegin();
+           it != renamer.renamedLocations.rend();
+           ++it) {
+        std::size_t start = it->GetStartPosition();
+        std::size_t length = it->GetEndPosition() - start;
+        if (!it->IsValid() ||
+            renamedExpression.substr(start, length) != objectName) {
+          // Should not happen, but print the tree if the locations are wrong.
+          renamedExpression = ExpressionParser2NodePrinter::PrintNode(node);
+          return true;
+        }
+
+        renamedExpression = renamedExpression.substr(0, start) +
+                            objectNewName +
+                            renamedExpression.substr(start + length);
+      }
 
-      return renamer.HasDoneRenaming();
+      return true;
     }
 
     return false;
@@ -75,12 +122,14 @@ class GD_CORE_API ExpressionObjectRenamer : public ExpressionParser2NodeWorker {
     if (gd::ParameterMetadata::IsObject(node.type) && node.identifierName == objectName) {
       hasDoneRenaming = true;
       node.identifierName = objectNewName;
+      renamedLocations.push_back(node.identifierNameLocation);
     }
   }
   void OnVisitFunctionNode(FunctionNode& node) override {
     if (node.objectName == objectName) {
       hasDoneRenaming = true;
       node.objectName = objectNewName;
+      renamedLocations.push_back(node.objectNameLocation);
     }
     for (auto& parameter : node.parameters) {
       parameter->Visit(*this);
@@ -92,6 +141,8 @@ class GD_CORE_API ExpressionObjectRenamer : public ExpressionParser2NodeWorker {
   bool hasDoneRenaming;
   const gd::String& objectName;
   const gd::String& objectNewName;
+  std::vector<gd::ExpressionParserLocation>
+      renamedLocations;  ///< The locations of the renamed names.
 };
 
 /**
@@ -172,7 +223,7 @@ bool EventsRefactorer::RenameObjectInActions(const gd::Platform& platform,
   bool somethingModified = false;
 
   for (std::size_t aId = 0; aId < actions.size(); ++aId) {
-    gd::InstructionMetadata instrInfos =
+    const gd::InstructionMetadata& instrInfos =
         MetadataProvider::GetActionMetadata(platform, actions[aId].GetType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Replace object's name in parameters
@@ -182,21 +233,33 @@ bool EventsRefactorer::RenameObjectInActions(const gd::Platform& platform,
       // Replace object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            actions[aId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, oldName)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("number", actions[aId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("number", expression);
         
-        if (ExpressionObjectRenamer::Rename(*node, oldName, newName)) {
-          actions[aId].SetParameter(pNb, ExpressionParser2NodePrinter::PrintNode(*node));
+        gd::String renamedExpression;
+        if (ExpressionObjectRenamer::Rename(
+                *node, expression, oldName, newName, renamedExpression)) {
+          actions[aId].SetParameter(pNb, renamedExpression);
         }
       }
       // Replace object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            actions[aId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, oldName)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("string", actions[aId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("string", expression);
         
-        if (ExpressionObjectRenamer::Rename(*node, oldName, newName)) {
-          actions[aId].SetParameter(pNb, ExpressionParser2NodePrinter::PrintNode(*node));
+        gd::String renamedExpression;
+        if (ExpressionObjectRenamer::Rename(
+                *node, expression, oldName, newName, renamedExpression)) {
+          actions[aId].SetParameter(pNb, renamedExpression);
         }
       }
     }
@@ -225,8 +288,9 @@ bool EventsRefactorer::RenameObjectInConditions(
   bool somethingModified = false;
 
   for (std::size_t cId = 0; cId < conditions.size(); ++cId) {
-    gd::InstructionMetadata instrInfos = MetadataProvider::GetConditionMetadata(
-        platform, conditions[cId].GetType());
+    const gd::InstructionMetadata& instrInfos =
+        MetadataProvider::GetConditionMetadata(platform,
+                                               conditions[cId].GetType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Replace object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].type) &&
@@ -235,21 +299,33 @@ bool EventsRefactorer::RenameObjectInConditions(
       // Replace object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            conditions[cId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, oldName)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("number", conditions[cId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("number", expression);
         
-        if (ExpressionObjectRenamer::Rename(*node, oldName, newName)) {
-          conditions[cId].SetParameter(pNb, ExpressionParser2NodePrinter::PrintNode(*node));
+        gd::String renamedExpression;
+        if (ExpressionObjectRenamer::Rename(
+                *node, expression, oldName, newName, renamedExpression)) {
+          conditions[cId].SetParameter(pNb, renamedExpression);
         }
       }
       // Replace object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            conditions[cId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, oldName)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("string", conditions[cId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("string", expression);
         
-        if (ExpressionObjectRenamer::Rename(*node, oldName, newName)) {
-          conditions[cId].SetParameter(pNb, ExpressionParser2NodePrinter::PrintNode(*node));
+        gd::String renamedExpression;
+        if (ExpressionObjectRenamer::Rename(
+                *node, expression, oldName, newName, renamedExpression)) {
+          conditions[cId].SetParameter(pNb, renamedExpression);
         }
       }
     }
@@ -309,7 +385,7 @@ bool EventsRefactorer::RemoveObjectInActions(const gd::Platform& platform,
   for (std::size_t aId = 0; aId < actions.size(); ++aId) {
     bool deleteMe = false;
 
-    gd::InstructionMetadata instrInfos =
+    const gd::InstructionMetadata& instrInfos =
         MetadataProvider::GetActionMetadata(platform, actions[aId].GetType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Find object's name in parameters
@@ -321,8 +397,12 @@ bool EventsRefactorer::RemoveObjectInActions(const gd::Platform& platform,
       // Find object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            actions[aId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, name)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("number", actions[aId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("number", expression);
         
         if (ExpressionObjectFinder::CheckIfHasObject(*node, name)) {
           deleteMe = true;
@@ -332,8 +412,12 @@ bool EventsRefactorer::RemoveObjectInActions(const gd::Platform& platform,
       // Find object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            actions[aId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, name)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("string", actions[aId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("string", expression);
         
         if (ExpressionObjectFinder::CheckIfHasObject(*node, name)) {
           deleteMe = true;
@@ -370,8 +454,9 @@ bool EventsRefactorer::RemoveObjectInConditions(
   for (std::size_t cId = 0; cId < conditions.size(); ++cId) {
     bool deleteMe = false;
 
-    gd::InstructionMetadata instrInfos = MetadataProvider::GetConditionMetadata(
-        platform, conditions[cId].GetType());
+    const gd::InstructionMetadata& instrInfos =
+        MetadataProvider::GetConditionMetadata(platform,
+                                               conditions[cId].GetType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Find object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].type) &&
@@ -382,8 +467,12 @@ bool EventsRefactorer::RemoveObjectInConditions(
       // Find object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            conditions[cId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, name)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("number", conditions[cId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("number", expression);
         
         if (ExpressionObjectFinder::CheckIfHasObject(*node, name)) {
           deleteMe = true;
@@ -393,8 +482,12 @@ bool EventsRefactorer::RemoveObjectInConditions(
       // Find object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].type)) {
+        const gd::String& expression =
+            conditions[cId].GetParameter(pNb).GetPlainString();
+        if (!MayUseName(expression, name)) continue;
+
         gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression("string", conditions[cId].GetParameter(pNb).GetPlainString());
+        auto node = parser.ParseExpression("string", expression);
         
         if (ExpressionObjectFinder::CheckIfHasObject(*node, name)) {
           deleteMe = true;
@@ -598,35 +691,42 @@ vector<EventsSearchResult> EventsRefactorer::SearchInEvents(
     bool inActions) {
   vector<EventsSearchResult> results;
 
+  // Case fold the searched string only once, instead of for each parameter.
+  const gd::String searchedString = matchCase ? search : search.CaseFold();
+
   for (std::size_t i = 0; i < events.size(); ++i) {
     bool eventAddedInResults = false;
 
     if (inConditions) {
-      vector<gd::InstructionsList*> conditionsVectors =
-          events[i].GetAllConditionsVectors();
+      const gd::BaseEvent& event = events[i];
+      vector<const gd::InstructionsList*> conditionsVectors =
+          event.GetAllConditionsVectors();
       for (std::size_t j = 0; j < conditionsVectors.size(); ++j) {
         if (!eventAddedInResults &&
-            SearchStringInConditions(
-                project, layout, *conditionsVectors[j], search, matchCase)) {
+            SearchStringInInstructions(
+                *conditionsVectors[j], searchedString, matchCase)) {
           results.push_back(EventsSearchResult(
               std::weak_ptr<gd::BaseEvent>(events.GetEventSmartPtr(i)),
               &events,
               i));
+          eventAddedInResults = true;
         }
       }
     }
 
     if (inActions) {
-      vector<gd::InstructionsList*> actionsVectors =
-          events[i].GetAllActionsVectors();
+      const gd::BaseEvent& event = events[i];
+      vector<const gd::InstructionsList*> actionsVectors =
+          event.GetAllActionsVectors();
       for (std::size_t j = 0; j < actionsVectors.size(); ++j) {
         if (!eventAddedInResults &&
-            SearchStringInActions(
-                project, layout, *actionsVectors[j], search, matchCase)) {
+            SearchStringInInstructions(
+                *actionsVectors[j], searchedString, matchCase)) {
           results.push_back(EventsSearchResult(
               std::weak_ptr<gd::BaseEvent>(events.GetEventSmartPtr(i)),
               &events,
               i));
+          eventAddedInResults = true;
         }
       }
     }
@@ -636,7 +736,7 @@ vector<EventsSearchResult> EventsRefactorer::SearchInEvents(
           SearchInEvents(project,
                          layout,
                          events[i].GetSubEvents(),
-                         search,
+                         searchedString,
                          matchCase,
                          inConditions,
                          inActions);
@@ -648,63 +748,26 @@ vector<EventsSearchResult> EventsRefactorer::SearchInEvents(
   return results;
 }
 
-bool EventsRefactorer::SearchStringInActions(gd::ObjectsContainer& project,
-                                             gd::ObjectsContainer& layout,
-                                             gd::InstructionsList& actions,
-                                             gd::String search,
-                                             bool matchCase) {
-  for (std::size_t aId = 0; aId < actions.size(); ++aId) {
-    for (std::size_t pNb = 0; pNb < actions[aId].GetParameters().size();
-         ++pNb) {
-      size_t foundPosition =
-          matchCase
-              ? actions[aId].GetParameter(pNb).GetPlainString().find(search)
-              : actions[aId]
-                    .GetParameter(pNb)
-                    .GetPlainString()
-                    .FindCaseInsensitive(search);
-
-      if (foundPosition != gd::String::npos) return true;
-    }
-
-    if (!actions[aId].GetSubInstructions().empty() &&
-        SearchStringInActions(project,
-                              layout,
-                              actions[aId].GetSubInstructions(),
-                              search,
-                              matchCase))
-      return true;
-  }
-
-  return false;
-}
-
-bool EventsRefactorer::SearchStringInConditions(
-    gd::ObjectsContainer& project,
-    gd::ObjectsContainer& layout,
-    gd::InstructionsList& conditions,
-    gd::String search,
+bool EventsRefactorer::SearchStringInInstructions(
+    const gd::InstructionsList& instructions,
+    const gd::String& search,
     bool matchCase) {
-  for (std::size_t cId = 0; cId < conditions.size(); ++cId) {
-    for (std::size_t pNb = 0; pNb < conditions[cId].GetParameters().size();
-         ++pNb) {
-      size_t foundPosition =
-          matchCase
-              ? conditions[cId].GetParameter(pNb).GetPlainString().find(search)
-              : conditions[cId]
-                    .GetParameter(pNb)
-                    .GetPlainString()
-                    .FindCaseInsensitive(search);
+  for (std::size_t i = 0; i < instructions.size(); ++i) {
+    const gd::Instruction& instruction = instructions[i];
+    for (std::size_t pNb = 0; pNb < instruction.GetParametersCount(); ++pNb) {
+      // Only the presence of the string matters: there is no need to compute
+      // its position in the original parameter (like FindCaseInsensitive does).
+      const gd::String& parameter =
+          instruction.GetParameter(pNb).GetPlainString();
+      size_t foundPosition = matchCase ? parameter.find(search)
+                                       : parameter.CaseFold().find(search);
 
       if (foundPosition != gd::String::npos) return true;
     }
 
-    if (!conditions[cId].GetSubInstructions().empty() &&
-        SearchStringInConditions(project,
-                                 layout,
-                                 conditions[cId].GetSubInstructions(),
-                                 search,
-                                 matchCase))
+    if (!instruction.GetSubInstructions().empty() &&
+        SearchStringInInstructions(
+            instruction.GetSubInstructions(), search, matchCase))
       return true;
   }
 
@@ -192,16 +192,17 @@ class GD_CORE_API EventsRefactorer {
                                      gd::String newString,
                                      bool matchCase);
 
-  static bool SearchStringInActions(gd::ObjectsContainer& project,
-                                    gd::ObjectsContainer& layout,
-                                    gd::InstructionsList& actions,
-                                    gd::String search,
-                                    bool matchCase);
-  static bool SearchStringInConditions(gd::ObjectsContainer& project,
-                                       gd::ObjectsContainer& layout,
-                                       gd::InstructionsList& conditions,
-                                       gd::String search,
-                                       bool matchCase);
+  /**
+   * \brief Return true if a parameter of the instructions (or of their sub
+   * instructions) contains the searched string.
+   *
+   * \param search The searched string. It must be case folded if \a matchCase
+   * is false, so that it's not done again for each instruction list.
+   */
+  static bool SearchStringInInstructions(
+      const gd::InstructionsList& instructions,
+      const gd::String& search,
+      bool matchCase);
 
   EventsRefactorer(){};
 };
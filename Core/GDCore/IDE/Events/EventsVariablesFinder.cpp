@@ -8,6 +8,7 @@
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/Instruction.h"
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
@@ -22,21 +23,42 @@ using namespace std;
 
 namespace gd {
 
+namespace {
+
+/**
+ * \brief Add the variable in the parameter of the given type to the usage.
+ *
+ * \return true if the parameter is a variable.
+ */
+bool AddVariable(EventsVariablesUsage& usage,
+                 const gd::String& parameterType,
+                 const gd::String& objectName,
+                 const gd::String& variableName) {
+  if (parameterType == "globalvar")
+    usage.globalVariables.insert(variableName);
+  else if (parameterType == "scenevar")
+    usage.layoutVariables.insert(variableName);
+  else if (parameterType == "objectvar")
+    usage.objectsVariables[objectName].insert(variableName);
+  else
+    return false;
+
+  return true;
+}
+
+}  // namespace
+
 /**
- * \brief Go through the nodes and change the given object name to a new one.
+ * \brief Go through the nodes and store the variables used as parameters of
+ * functions.
  *
  * \see gd::ExpressionParser2
  */
-class GD_CORE_API ExpressionParameterSearcher
+class GD_CORE_API ExpressionVariablesSearcher
     : public ExpressionParser2NodeWorker {
  public:
-  ExpressionParameterSearcher(std::set<gd::String>& results_,
-                              const gd::String& parameterType_,
-                              const gd::String& objectName_ = "")
-      : results(results_),
-        parameterType(parameterType_),
-        objectName(objectName_){};
-  virtual ~ExpressionParameterSearcher(){};
+  ExpressionVariablesSearcher(EventsVariablesUsage& usage_) : usage(usage_){};
+  virtual ~ExpressionVariablesSearcher(){};
 
  protected:
   void OnVisitSubExpressionNode(SubExpressionNode& node) override {
@@ -64,42 +86,51 @@ class GD_CORE_API ExpressionParameterSearcher
   }
   void OnVisitIdentifierNode(IdentifierNode& node) override {}
   void OnVisitFunctionNode(FunctionNode& node) override {
-    bool considerFunction = objectName.empty() || node.objectName == objectName;
-    for (size_t i = 0; i < node.parameters.size() &&
-                       i < node.expressionMetadata.parameters.size();
-         ++i) {
-      auto& parameterMetadata = node.expressionMetadata.parameters[i];
-      if (considerFunction && parameterMetadata.GetType() == parameterType) {
-        // Store the value of the parameter
-        results.insert(
-            gd::ExpressionParser2NodePrinter::PrintNode(*node.parameters[i]));
-      } else {
-        node.parameters[i]->Visit(*this);
-      }
+    // Like in the parser, the parameters written in the expression don't
+    // include the object, the behavior and the code only parameters.
+    const auto& parametersMetadata = node.expressionMetadata.parameters;
+    size_t metadataIndex = !node.behaviorName.empty()
+                               ? 2
+                               : (!node.objectName.empty() ? 1 : 0);
+    for (size_t i = 0; i < node.parameters.size(); ++i, ++metadataIndex) {
+      while (metadataIndex < parametersMetadata.size() &&
+             parametersMetadata[metadataIndex].IsCodeOnly())
+        metadataIndex++;
+
+      bool isVariable =
+          metadataIndex < parametersMetadata.size() &&
+          AddVariable(
+              usage,
+              parametersMetadata[metadataIndex].GetType(),
+              node.objectName,
+              gd::ExpressionParser2NodePrinter::PrintNode(*node.parameters[i]));
+      if (!isVariable) node.parameters[i]->Visit(*this);
     }
   }
   void OnVisitEmptyNode(EmptyNode& node) override {}
 
  private:
-  std::set<gd::String>& results;  ///< Reference to the std::set where argument
-                                  ///< values must be stored.
-  gd::String parameterType;  ///< The type of the parameters to be searched for.
-  gd::String objectName;     ///< If not empty, parameters will be taken into
-                             ///< account only if related to this object.
+  EventsVariablesUsage& usage;  ///< Where the variables found are stored.
 };
 
+EventsVariablesUsage EventsVariablesFinder::FindAllVariables(
+    const gd::Platform& platform,
+    const gd::Project& project,
+    const gd::Layout& layout) {
+  EventsVariablesUsage usage;
+  FindVariablesInEvents(platform, project, layout, layout.GetEvents(), usage);
+
+  return usage;
+}
+
 std::set<gd::String> EventsVariablesFinder::FindAllGlobalVariables(
     const gd::Platform& platform, const gd::Project& project) {
   std::set<gd::String> results;
 
   for (std::size_t i = 0; i < project.GetLayoutsCount(); ++i) {
-    std::set<gd::String> results2 =
-        FindArgumentsInEvents(platform,
-                              project,
-                              project.GetLayout(i),
-                              project.GetLayout(i).GetEvents(),
-                              "globalvar");
-    results.insert(results2.begin(), results2.end());
+    EventsVariablesUsage usage =
+        FindAllVariables(platform, project, project.GetLayout(i));
+    results.insert(usage.globalVariables.begin(), usage.globalVariables.end());
   }
 
   return results;
@@ -109,13 +140,7 @@ std::set<gd::String> EventsVariablesFinder::FindAllLayoutVariables(
     const gd::Platform& platform,
     const gd::Project& project,
     const gd::Layout& layout) {
-  std::set<gd::String> results;
-
-  std::set<gd::String> results2 = FindArgumentsInEvents(
-      platform, project, layout, layout.GetEvents(), "scenevar");
-  results.insert(results2.begin(), results2.end());
-
-  return results;
+  return FindAllVariables(platform, project, layout).layoutVariables;
 }
 
 std::set<gd::String> EventsVariablesFinder::FindAllObjectVariables(
@@ -123,135 +148,99 @@ std::set<gd::String> EventsVariablesFinder::FindAllObjectVariables(
     const gd::Project& project,
     const gd::Layout& layout,
     const gd::Object& object) {
-  std::set<gd::String> results;
-
-  std::set<gd::String> results2 = FindArgumentsInEvents(platform,
-                                                        project,
-                                                        layout,
-                                                        layout.GetEvents(),
-                                                        "objectvar",
-                                                        object.GetName());
-  results.insert(results2.begin(), results2.end());
-
-  return results;
+  EventsVariablesUsage usage = FindAllVariables(platform, project, layout);
+  return usage.objectsVariables[object.GetName()];
 }
 
-std::set<gd::String> EventsVariablesFinder::FindArgumentsInInstructions(
+void EventsVariablesFinder::FindVariablesInInstructions(
     const gd::Platform& platform,
     const gd::Project& project,
     const gd::Layout& layout,
     const gd::InstructionsList& instructions,
     bool instructionsAreConditions,
-    const gd::String& parameterType,
-    const gd::String& objectName) {
-  std::set<gd::String> results;
-
+    EventsVariablesUsage& usage) {
   for (std::size_t aId = 0; aId < instructions.size(); ++aId) {
+    const gd::Instruction& instruction = instructions[aId];
     gd::String lastObjectParameter = "";
-    gd::InstructionMetadata instrInfos =
-        instructionsAreConditions ? MetadataProvider::GetConditionMetadata(
-                                        platform, instructions[aId].GetType())
-                                  : MetadataProvider::GetActionMetadata(
-                                        platform, instructions[aId].GetType());
-    for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
-      // The parameter has the searched type...
-      if (instrInfos.parameters[pNb].type == parameterType) {
-        //...remember the value of the parameter.
-        if (objectName.empty() || lastObjectParameter == objectName)
-          results.insert(instructions[aId].GetParameter(pNb).GetPlainString());
-      }
-      // Search in expressions
-      else if (ParameterMetadata::IsExpression(
-                   "number", instrInfos.parameters[pNb].type)) {
-        gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression(
-            "number", instructions[aId].GetParameter(pNb).GetPlainString());
+    const gd::InstructionMetadata& instrInfos =
+        instructionsAreConditions
+            ? MetadataProvider::GetConditionMetadata(platform,
+                                                     instruction.GetType())
+            : MetadataProvider::GetActionMetadata(platform,
+                                                  instruction.GetType());
+    for (std::size_t pNb = 0; pNb < instrInfos.parameters.size() &&
+                              pNb < instruction.GetParametersCount();
+         ++pNb) {
+      const gd::String& type = instrInfos.parameters[pNb].type;
+      const gd::String& value = instruction.GetParameter(pNb).GetPlainString();
+
+      // The parameter is a variable: remember it.
+      if (AddVariable(usage, type, lastObjectParameter, value)) continue;
 
-        ExpressionParameterSearcher searcher(
-            results, parameterType, objectName);
-        node->Visit(searcher);
-      }
-      // Search in gd::String expressions
-      else if (ParameterMetadata::IsExpression(
-                   "string", instrInfos.parameters[pNb].type)) {
-        gd::ExpressionParser2 parser(platform, project, layout);
-        auto node = parser.ParseExpression(
-            "number", instructions[aId].GetParameter(pNb).GetPlainString());
-
-        ExpressionParameterSearcher searcher(
-            results, parameterType, objectName);
+      // Search in expressions
+      if (ParameterMetadata::IsExpression("number", type) ||
+          ParameterMetadata::IsExpression("string", type)) {
+        auto node = project.GetExpressionParser2Cache().ParseExpression(
+            platform,
+            project,
+            layout,
+            ParameterMetadata::IsExpression("number", type) ? "number"
+                                                            : "string",
+            value);
+
+        ExpressionVariablesSearcher searcher(usage);
         node->Visit(searcher);
       }
       // Remember the value of the last "object" parameter.
-      else if (gd::ParameterMetadata::IsObject(
-                   instrInfos.parameters[pNb].type)) {
-        lastObjectParameter =
-            instructions[aId].GetParameter(pNb).GetPlainString();
+      else if (gd::ParameterMetadata::IsObject(type)) {
+        lastObjectParameter = value;
       }
     }
 
-    if (!instructions[aId].GetSubInstructions().empty())
-      FindArgumentsInInstructions(platform,
+    if (!instruction.GetSubInstructions().empty())
+      FindVariablesInInstructions(platform,
                                   project,
                                   layout,
-                                  instructions[aId].GetSubInstructions(),
+                                  instruction.GetSubInstructions(),
                                   instructionsAreConditions,
-                                  parameterType);
+                                  usage);
   }
-
-  return results;
 }
 
-std::set<gd::String> EventsVariablesFinder::FindArgumentsInEvents(
+void EventsVariablesFinder::FindVariablesInEvents(
     const gd::Platform& platform,
     const gd::Project& project,
     const gd::Layout& layout,
     const gd::EventsList& events,
-    const gd::String& parameterType,
-    const gd::String& objectName) {
-  std::set<gd::String> results;
+    EventsVariablesUsage& usage) {
   for (std::size_t i = 0; i < events.size(); ++i) {
     vector<const gd::InstructionsList*> conditionsVectors =
         events[i].GetAllConditionsVectors();
     for (std::size_t j = 0; j < conditionsVectors.size(); ++j) {
-      std::set<gd::String> results2 =
-          FindArgumentsInInstructions(platform,
-                                      project,
-                                      layout,
-                                      *conditionsVectors[j],
-                                      /*conditions=*/true,
-                                      parameterType,
-                                      objectName);
-      results.insert(results2.begin(), results2.end());
+      FindVariablesInInstructions(platform,
+                                  project,
+                                  layout,
+                                  *conditionsVectors[j],
+                                  /*conditions=*/true,
+                                  usage);
     }
 
     vector<const gd::InstructionsList*> actionsVectors =
         events[i].GetAllActionsVectors();
     for (std::size_t j = 0; j < actionsVectors.size(); ++j) {
-      std::set<gd::String> results2 =
-          FindArgumentsInInstructions(platform,
-                                      project,
-                                      layout,
-                                      *actionsVectors[j],
-                                      /*conditions=*/false,
-                                      parameterType,
-                                      objectName);
-      results.insert(results2.begin(), results2.end());
+      FindVariablesInInstructions(platform,
+                                  project,
+                                  layout,
+                                  *actionsVectors[j],
+                                  /*conditions=*/false,
+                                  usage);
     }
 
     if (events[i].CanHaveSubEvents()) {
-      std::set<gd::String> results2 =
-          FindArgumentsInEvents(platform,
-                                project,
-                                layout,
-                                events[i].GetSubEvents(),
-                                parameterType,
-                                objectName);
-      results.insert(results2.begin(), results2.end());
+      FindVariablesInEvents(
+          platform, project, layout, events[i].GetSubEvents(), usage);
     }
   }
-
-  return results;
 }
 
 }  // namespace gd
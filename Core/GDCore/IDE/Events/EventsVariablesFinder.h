@@ -5,6 +5,7 @@
  */
 #ifndef EVENTSVARIABLESFINDER_H
 #define EVENTSVARIABLESFINDER_H
+#include <map>
 #include <set>
 #include <vector>
 #include "GDCore/Events/Event.h"
@@ -19,6 +20,22 @@ class Layout;
 
 namespace gd {
 
+/**
+ * \brief The names of the global, layout and object variables used in events.
+ *
+ * \see EventsVariablesFinder::FindAllVariables
+ */
+class GD_CORE_API EventsVariablesUsage {
+ public:
+  EventsVariablesUsage(){};
+  ~EventsVariablesUsage(){};
+
+  std::set<gd::String> globalVariables;  ///< The global variables used.
+  std::set<gd::String> layoutVariables;  ///< The layout variables used.
+  std::map<gd::String, std::set<gd::String> >
+      objectsVariables;  ///< The variables used for each object, by name.
+};
+
 /**
  * \brief Perform a search over a project or a layout, searching for layout,
  * global or object variables.
@@ -29,6 +46,21 @@ namespace gd {
  */
 class EventsVariablesFinder {
  public:
+  /**
+   * Find all the global, layout and object variables used in the events of
+   * the layout, going through the events only once.
+   *
+   * Prefer this to calling FindAllLayoutVariables and FindAllObjectVariables
+   * for each object, which would go through all the events each time.
+   *
+   * \param project The project
+   * \param layout The layout to be scanned
+   * \return The names of the variables used in the layout events.
+   */
+  static EventsVariablesUsage FindAllVariables(const gd::Platform& platform,
+                                               const gd::Project& project,
+                                               const gd::Layout& layout);
+
   /**
    * Construct a list containing the name of all global variables used in the
    * project.
@@ -69,51 +101,37 @@ class EventsVariablesFinder {
 
  private:
   /**
-   * Construct a list of the value of the arguments for parameters of type @
-   * parameterType
+   * Add the variables used in the parameters of the instructions (and of
+   * their sub instructions) to \a usage.
    *
    * \param project The project used
    * \param project The layout used
    * \param instructions The instructions to be analyzed
    * \param instructionsAreConditions True if the instructions are conditions.
-   * \param parameterType The parameters type to be analyzed
-   * \param objectName If not empty, parameters will be taken into account only
-   * if the last object parameter is filled with this value.
-   *
-   * \return A std::set filled with the values used for all parameters of the
-   * specified type
+   * \param usage The variables found.
    */
-  static std::set<gd::String> FindArgumentsInInstructions(
+  static void FindVariablesInInstructions(
       const gd::Platform& platform,
       const gd::Project& project,
       const gd::Layout& layout,
       const gd::InstructionsList& instructions,
       bool instructionsAreConditions,
-      const gd::String& parameterType,
-      const gd::String& objectName = "");
+      EventsVariablesUsage& usage);
 
   /**
-   * Construct a list of the value of the arguments for parameters of type @
-   * parameterType
+   * Add the variables used in the events (and in their sub events) to
+   * \a usage.
    *
    * \param project The project used
    * \param project The layout used
    * \param events The events to be analyzed
-   * \param parameterType The parameters type to be analyzed
-   * \param objectName If not empty, parameters will be taken into account
-   * only if the last object parameter is filled with
-   * this value.
-   *
-   * \return A std::set filled with the values used for all parameters of the
-   * specified type
+   * \param usage The variables found.
    */
-  static std::set<gd::String> FindArgumentsInEvents(
-      const gd::Platform& platform,
-      const gd::Project& project,
-      const gd::Layout& layout,
-      const gd::EventsList& events,
-      const gd::String& parameterType,
-      const gd::String& objectName = "");
+  static void FindVariablesInEvents(const gd::Platform& platform,
+                                    const gd::Project& project,
+                                    const gd::Layout& layout,
+                                    const gd::EventsList& events,
+                                    EventsVariablesUsage& usage);
 
   EventsVariablesFinder(){};
   virtual ~EventsVariablesFinder(){};
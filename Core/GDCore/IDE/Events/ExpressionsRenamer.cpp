@@ -13,6 +13,7 @@
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/Events/ExpressionValidator.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
@@ -120,6 +121,16 @@ bool ExpressionsRenamer::DoVisitInstruction(gd::Instruction& instruction,
                                : gd::MetadataProvider::GetActionMetadata(
                                      platform, instruction.GetType());
 
+  // Spaces are allowed between the namespace and the name of a free function:
+  // only search for the name.
+  const gd::String& separator = gd::PlatformExtension::GetNamespaceSeparator();
+  const std::string& functionName = oldFunctionName.Raw();
+  std::size_t separatorPosition = functionName.rfind(separator.Raw());
+  std::string nameWithoutNamespace =
+      separatorPosition != std::string::npos
+          ? functionName.substr(separatorPosition + separator.Raw().size())
+          : functionName;
+
   for (std::size_t pNb = 0; pNb < metadata.parameters.size() &&
                             pNb < instruction.GetParametersCount();
        ++pNb) {
@@ -127,6 +138,11 @@ bool ExpressionsRenamer::DoVisitInstruction(gd::Instruction& instruction,
     const gd::String& expression =
         instruction.GetParameter(pNb).GetPlainString();
 
+    // The function can't be called if its name is not written in the
+    // expression: don't parse it.
+    if (expression.Raw().find(nameWithoutNamespace) == std::string::npos)
+      continue;
+
     gd::ExpressionParser2 parser(
         platform, GetGlobalObjectsContainer(), GetObjectsContainer());
 
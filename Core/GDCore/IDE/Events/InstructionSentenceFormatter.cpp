@@ -23,6 +23,8 @@ using namespace std;
 namespace gd {
 
 InstructionSentenceFormatter *InstructionSentenceFormatter::_singleton = NULL;
+const std::size_t InstructionSentenceFormatter::maximumCachedTextsCount =
+    10000;
 
 gd::String InstructionSentenceFormatter::Translate(
     const gd::Instruction &instr, const gd::InstructionMetadata &metadata) {
@@ -45,6 +47,30 @@ gd::String InstructionSentenceFormatter::Translate(
 std::vector<std::pair<gd::String, gd::TextFormatting> >
 InstructionSentenceFormatter::GetAsFormattedText(
     const Instruction &instr, const gd::InstructionMetadata &metadata) {
+  // Everything the formatted sentence depends on is part of the key, so that
+  // modified instructions (or metadata) are formatted again.
+  std::string key = instr.GetType().Raw();
+  key += '\0';
+  key += metadata.GetSentence().Raw();
+  for (std::size_t i = 0; i < metadata.parameters.size(); ++i) {
+    key += '\0';
+    key += metadata.parameters[i].type.Raw();
+    key += '\0';
+    key += instr.GetParameter(i).GetPlainString().Raw();
+  }
+
+  auto it = formattedTextsCache.find(key);
+  if (it != formattedTextsCache.end()) return it->second;
+
+  if (formattedTextsCache.size() >= maximumCachedTextsCount)
+    formattedTextsCache.clear();
+
+  return formattedTextsCache[key] = FormatAsText(instr, metadata);
+}
+
+std::vector<std::pair<gd::String, gd::TextFormatting> >
+InstructionSentenceFormatter::FormatAsText(
+    const Instruction &instr, const gd::InstructionMetadata &metadata) {
   std::vector<std::pair<gd::String, gd::TextFormatting> > formattedStr;
 
   gd::String sentence = metadata.GetSentence();
@@ -162,6 +188,7 @@ gd::String InstructionSentenceFormatter::LabelFromType(const gd::String &type) {
 void InstructionSentenceFormatter::LoadTypesFormattingFromConfig() {
   // Load default configuration
   typesFormatting.clear();
+  ClearCache();
   typesFormatting["expression"].SetColor(27, 143, 1).SetBold();
   typesFormatting["object"].SetColor(182, 97, 10).SetBold();
   typesFormatting["behavior"].SetColor(119, 119, 119).SetBold();
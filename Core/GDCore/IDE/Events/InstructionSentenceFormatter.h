@@ -8,6 +8,8 @@
 #ifndef TRANSLATEACTION_H
 #define TRANSLATEACTION_H
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "GDCore/String.h"
@@ -37,10 +39,18 @@ class GD_CORE_API InstructionSentenceFormatter {
 
   /**
    * \brief Create a formatted sentence from an instruction and its metadata.
+   *
+   * The formatted sentences are cached, so that the events sheet can render
+   * the same instructions again without formatting them again.
    */
   std::vector<std::pair<gd::String, gd::TextFormatting> > GetAsFormattedText(
       const gd::Instruction &instr, const gd::InstructionMetadata &metadata);
 
+  /**
+   * \brief Remove all the formatted sentences stored in the cache.
+   */
+  void ClearCache() { formattedTextsCache.clear(); }
+
   /**
    * \brief Return the TextFormatting object associated to the \a type.
    */
@@ -53,6 +63,7 @@ class GD_CORE_API InstructionSentenceFormatter {
 
   /**
    * \brief Load the configuration from the default configuration.
+   * \note The cache of formatted sentences is cleared.
    */
   void LoadTypesFormattingFromConfig();
 
@@ -77,7 +88,19 @@ class GD_CORE_API InstructionSentenceFormatter {
 
  private:
   InstructionSentenceFormatter(){};
+
+  std::vector<std::pair<gd::String, gd::TextFormatting> > FormatAsText(
+      const gd::Instruction &instr, const gd::InstructionMetadata &metadata);
+
   static InstructionSentenceFormatter *_singleton;
+
+  /// The formatted sentences, by instruction type, sentence, parameters types
+  /// and values. The sentence of the metadata is translated, so the cache is
+  /// valid whatever the locale.
+  std::unordered_map<std::string,
+                     std::vector<std::pair<gd::String, gd::TextFormatting> > >
+      formattedTextsCache;
+  static const std::size_t maximumCachedTextsCount;
 };
 
 }  // namespace gd
@@ -5,6 +5,7 @@
  */
 
 #include "GDCore/IDE/ExtensionsLoader.h"
+#include <algorithm>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
@@ -25,6 +26,9 @@ using namespace std;
 
 namespace gd {
 
+std::map<gd::String, std::vector<gd::String> >
+    ExtensionsLoader::librariesLoaded;
+
 void ExtensionsLoader::LoadAllExtensions(const gd::String &directory,
                                          gd::Platform &platform,
                                          bool forgiving) {
@@ -51,7 +55,8 @@ void ExtensionsLoader::LoadAllExtensions(const gd::String &directory,
     return;
   }
 
-  std::vector<gd::String> librariesLoaded;
+  std::vector<gd::String> &directoryLibrariesLoaded =
+      librariesLoaded[directory];
   while ((lecture = readdir(rep))) {
     gd::String lec = lecture->d_name;
     // Load all extensions, except the legacy ones finishing by *Automatism.xgd*
@@ -61,8 +66,12 @@ void ExtensionsLoader::LoadAllExtensions(const gd::String &directory,
             string::npos &&
         lec.find("Automatism.xgd" + suffix) == string::npos) {
 
-      LoadExtension(directory + "/" + lec, platform, forgiving);
-      librariesLoaded.push_back(directory + "/" + lec);
+      gd::String fullpath = directory + "/" + lec;
+      if (LoadExtension(fullpath, platform, forgiving) &&
+          std::find(directoryLibrariesLoaded.begin(),
+                    directoryLibrariesLoaded.end(),
+                    fullpath) == directoryLibrariesLoaded.end())
+        directoryLibrariesLoaded.push_back(fullpath);
 
       l++;
     }
@@ -99,7 +108,18 @@ void ExtensionsLoader::ExtensionsLoadingDone(const gd::String &directory) {
 
 #if defined(LINUX) || defined(MACOS)
 
-  // List all extensions loaded
+  auto it = librariesLoaded.find(directory);
+  if (it != librariesLoaded.end()) {
+    // The libraries that failed to load or that are not extensions for any
+    // platform don't need to be opened again.
+    for (const gd::String &library : it->second)
+      SetLibraryGlobal(library.c_str());
+
+    librariesLoaded.erase(it);
+    return;
+  }
+
+  // List all extensions (if they were not loaded by LoadAllExtensions)
   struct dirent *lecture;
   DIR *rep;
   rep = opendir(directory.c_str());
@@ -139,13 +159,13 @@ void ExtensionsLoader::ExtensionsLoadingDone(const gd::String &directory) {
 #endif
 }
 
-void ExtensionsLoader::LoadExtension(const gd::String &fullpath,
+bool ExtensionsLoader::LoadExtension(const gd::String &fullpath,
                                      gd::Platform &platform,
                                      bool forgiving) {
   if (platform.GetExtensionCreateFunctionName().empty()) {
     cout << "Unable to load extension " << fullpath << ":" << endl;
     cout << "The plaftorm does not support extensions creation." << endl;
-    return;
+    return false;
   }
 
   Handle extensionHdl = OpenLibrary(fullpath.c_str());
@@ -154,7 +174,7 @@ void ExtensionsLoader::LoadExtension(const gd::String &fullpath,
 
     cout << "Unable to load extension " << fullpath << "." << endl;
     cout << "Error returned : \"" << error << "\"" << endl;
-    return;
+    return false;
   }
 
   createExtension create_extension = (createExtension)GetSymbol(
@@ -167,7 +187,7 @@ void ExtensionsLoader::LoadExtension(const gd::String &fullpath,
     }
 
     CloseLibrary(extensionHdl);
-    return;
+    return false;
   }
 
   gd::PlatformExtension *extensionPtr = create_extension();
@@ -213,13 +233,13 @@ void ExtensionsLoader::LoadExtension(const gd::String &fullpath,
     delete extensionPtr;
     CloseLibrary(extensionHdl);
 
-    return;
+    return false;
 #endif
   }
 
   std::shared_ptr<gd::PlatformExtension> extension(extensionPtr);
   platform.AddExtension(extension);
-  return;
+  return true;
 }
 
 }  // namespace gd
@@ -6,6 +6,7 @@
 
 #ifndef EXTENSIONSLOADER_H
 #define EXTENSIONSLOADER_H
+#include <map>
 #include <vector>
 #include "GDCore/String.h"
 namespace gd {
@@ -52,8 +53,10 @@ class GD_CORE_API ExtensionsLoader {
    * \param forgiving If set to true, files will try to be opened, but a failure
    * when searching for the platform creation function symbol won't be logged as
    * an error. (All other errors are still reparted as usual).
+   *
+   * \return true if the extension was added to the platform.
    */
-  static void LoadExtension(const gd::String& fullpath,
+  static bool LoadExtension(const gd::String& fullpath,
                             gd::Platform& platform,
                             bool forgiving = false);
 
@@ -61,7 +64,9 @@ class GD_CORE_API ExtensionsLoader {
    * \brief To be called when extensions loading is done.
    *
    * This is necessary on Linux to make symbols exported by extensions
-   * available. \param directory The directory where extensions have been loaded
+   * available. Only the libraries of the extensions that were loaded by
+   * LoadAllExtensions are processed (the directory is not listed again).
+   * \param directory The directory where extensions have been loaded
    * from.
    */
   static void ExtensionsLoadingDone(const gd::String& directory);
@@ -69,6 +74,10 @@ class GD_CORE_API ExtensionsLoader {
  private:
   ExtensionsLoader(){};
   virtual ~ExtensionsLoader(){};
+
+  static std::map<gd::String, std::vector<gd::String> >
+      librariesLoaded;  ///< The libraries of the extensions loaded by
+                        ///< LoadAllExtensions, for each directory.
 };
 
 }  // namespace gd
@@ -0,0 +1,191 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if !defined(EMSCRIPTEN)
+#include "GDCore/IDE/Project/ProjectImagesPacker.h"
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
+#include "GDCore/IDE/Project/ResourcesInUseHelper.h"
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
+#include "GDCore/Project/ExternalEvents.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/PlatformSpecificAssets.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/ResourcesLoader.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCore/Tools/Localization.h"
+#include "GDCore/Tools/Log.h"
+
+namespace gd {
+
+namespace {
+/**
+ * \brief Copy \a image in \a atlas at the given position, repeating the
+ * borders of the image in the \a padding around it so that smoothed textures
+ * don't bleed.
+ */
+void CopyWithExtrudedBorders(sf::Image& atlas,
+                             const sf::Image& image,
+                             unsigned int x,
+                             unsigned int y,
+                             unsigned int padding) {
+  int width = image.getSize().x;
+  int height = image.getSize().y;
+  int extrusion = padding;
+  for (int dy = -extrusion; dy < height + extrusion; ++dy) {
+    for (int dx = -extrusion; dx < width + extrusion; ++dx) {
+      atlas.setPixel(x + dx,
+                     y + dy,
+                     image.getPixel(std::min(std::max(dx, 0), width - 1),
+                                    std::min(std::max(dy, 0), height - 1)));
+    }
+  }
+}
+}  // namespace
+
+std::size_t ProjectImagesPacker::PackImages(gd::Project& project,
+                                            gd::AbstractFileSystem& fs,
+                                            const gd::String& exportDirectory,
+                                            unsigned int atlasMaximumSize) {
+  // The images of a layout are packed together. The "global group" gathers
+  // the images of global objects and the images used by several layouts.
+  const std::size_t globalGroup = project.GetLayoutsCount();
+  std::map<gd::String, std::size_t> imagesGroups;
+  gd::ResourcesInUseHelper otherResources;
+  auto addObjectImages = [&](gd::Object& object, std::size_t group) {
+    if (object.GetType() != "Sprite") {
+      object.ExposeResources(otherResources);
+      return;
+    }
+
+    gd::ResourcesInUseHelper spriteResources;
+    object.ExposeResources(spriteResources);
+    for (const gd::String& image : spriteResources.GetAllImages()) {
+      auto it = imagesGroups.find(image);
+      if (it == imagesGroups.end())
+        imagesGroups[image] = group;
+      else if (it->second != group)
+        it->second = globalGroup;
+    }
+  };
+
+  for (std::size_t j = 0; j < project.GetObjectsCount(); ++j)
+    addObjectImages(project.GetObject(j), globalGroup);
+  for (std::size_t s = 0; s < project.GetLayoutsCount(); s++) {
+    gd::Layout& layout = project.GetLayout(s);
+    for (std::size_t j = 0; j < layout.GetObjectsCount(); ++j)
+      addObjectImages(layout.GetObject(j), s);
+
+    LaunchResourceWorkerOnEvents(project, layout.GetEvents(), otherResources);
+  }
+  for (std::size_t s = 0; s < project.GetExternalEventsCount(); s++) {
+    LaunchResourceWorkerOnEvents(
+        project, project.GetExternalEvents(s).GetEvents(), otherResources);
+  }
+  for (std::size_t e = 0; e < project.GetEventsFunctionsExtensionsCount();
+       e++) {
+    auto& eventsFunctionsExtension = project.GetEventsFunctionsExtension(e);
+    for (auto&& eventsFunction : eventsFunctionsExtension.GetInternalVector()) {
+      LaunchResourceWorkerOnEvents(
+          project, eventsFunction->GetEvents(), otherResources);
+    }
+  }
+  project.GetPlatformSpecificAssets().ExposeResources(otherResources);
+
+  // Load the images to be packed, separating smoothed and not smoothed images
+  // as the smoothing is a property of the texture of the atlas.
+  const std::set<gd::String>& otherImages = otherResources.GetAllImages();
+  auto& resourcesManager = project.GetResourcesManager();
+  std::map<std::pair<std::size_t, bool>, gd::TextureAtlasPacker> packers;
+  std::map<gd::String, sf::Image> images;
+  for (const auto& imageGroup : imagesGroups) {
+    const gd::String& name = imageGroup.first;
+    if (otherImages.find(name) != otherImages.end() ||
+        !resourcesManager.HasResource(name))
+      continue;
+
+    auto imageResource =
+        dynamic_cast<ImageResource*>(&resourcesManager.GetResource(name));
+    if (!imageResource) continue;
+
+    gd::String file = imageResource->GetFile();
+    fs.MakeAbsolute(file, exportDirectory);
+    sf::Image& image = images[name];
+    ResourcesLoader::Get()->LoadSFMLImage(file, image);
+
+    auto packerKey =
+        std::make_pair(imageGroup.second, imageResource->IsSmooth());
+    auto packer = packers.find(packerKey);
+    if (packer == packers.end()) {
+      packer = packers
+                   .insert(std::make_pair(
+                       packerKey, gd::TextureAtlasPacker(atlasMaximumSize)))
+                   .first;
+    }
+
+    if (image.getSize().x == 0 || image.getSize().y == 0 ||
+        !packer->second.AddImage(name, image.getSize().x, image.getSize().y))
+      images.erase(name);
+  }
+
+  // Write the atlases and update the resources.
+  std::size_t packedImagesCount = 0;
+  std::size_t atlasesCount = 0;
+  for (auto& keyAndPacker : packers) {
+    gd::TextureAtlasPacker& packer = keyAndPacker.second;
+    packer.Pack();
+    if (packer.GetRegions().size() < 2)
+      continue;  // Not worth an atlas.
+
+    for (std::size_t i = 0; i < packer.GetAtlasesCount(); ++i) {
+      sf::Image atlas;
+      atlas.create(packer.GetAtlasWidth(i),
+                   packer.GetAtlasHeight(i),
+                   sf::Color(0, 0, 0, 0));
+      for (const auto& region : packer.GetRegions()) {
+        if (region.second.atlas != i) continue;
+        CopyWithExtrudedBorders(atlas,
+                                images[region.first],
+                                region.second.x,
+                                region.second.y,
+                                packer.GetPadding());
+      }
+
+      gd::String atlasFile =
+          "gdatlas" + gd::String::From(atlasesCount) + ".png";
+      gd::String atlasPath = atlasFile;
+      fs.MakeAbsolute(atlasPath, exportDirectory);
+      ++atlasesCount;
+      if (!atlas.saveToFile(atlasPath.ToLocale())) {
+        gd::LogWarning(_("Unable to write the atlas \"") + atlasPath +
+                       _("\"."));
+        continue;
+      }
+
+      for (const auto& region : packer.GetRegions()) {
+        if (region.second.atlas != i) continue;
+        auto& imageResource = dynamic_cast<ImageResource&>(
+            resourcesManager.GetResource(region.first));
+        imageResource.SetAtlas(atlasFile,
+                               region.second.x,
+                               region.second.y,
+                               region.second.width,
+                               region.second.height);
+        ++packedImagesCount;
+      }
+    }
+  }
+
+  return packedImagesCount;
+}
+
+}  // namespace gd
+#endif
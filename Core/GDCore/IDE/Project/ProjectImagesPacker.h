@@ -0,0 +1,57 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if !defined(EMSCRIPTEN)
+#ifndef GDCORE_PROJECTIMAGESPACKER_H
+#define GDCORE_PROJECTIMAGESPACKER_H
+#include "GDCore/String.h"
+namespace gd {
+class Project;
+class AbstractFileSystem;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Pack the images displayed by the sprites of each layout of a project
+ * into texture atlases.
+ *
+ * Only the images used exclusively by Sprite objects are packed: images used
+ * by other objects, by events or as platform specific assets are left as they
+ * are. The images used by a single layout are packed in the atlases of this
+ * layout, and the images used by several layouts or by global objects are
+ * packed in atlases shared by all layouts.
+ *
+ * \see gd::TextureAtlasPacker
+ * \see gd::ImageResource::SetAtlas
+ *
+ * \ingroup IDE
+ */
+class GD_CORE_API ProjectImagesPacker {
+ public:
+  /**
+   * \brief Pack the images of \a project, which resources must have already
+   * been copied to \a exportDirectory (see gd::ProjectResourcesCopier).
+   *
+   * The atlases are written in \a exportDirectory, and the image resources of
+   * \a project are updated with the part of the atlas containing them.
+   *
+   * \param project The project to be used
+   * \param fs The abstract file system to be used
+   * \param exportDirectory The directory where resources were copied to
+   * \param atlasMaximumSize The maximum width and height of the atlases
+   *
+   * \return The number of images packed in atlases.
+   */
+  static std::size_t PackImages(gd::Project& project,
+                                gd::AbstractFileSystem& fs,
+                                const gd::String& exportDirectory,
+                                unsigned int atlasMaximumSize = 2048);
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_PROJECTIMAGESPACKER_H
+#endif
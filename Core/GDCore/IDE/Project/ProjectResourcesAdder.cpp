@@ -7,6 +7,7 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/IDE/Project/ResourcesInUseHelper.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
 
@@ -14,6 +15,44 @@ using namespace std;
 
 namespace gd {
 
+namespace {
+
+/**
+ * \brief Add to the strings the given string and all the strings quoted
+ * inside it (like "MyImage" in the parameter "\"MyImage\"").
+ */
+void AddStrings(const gd::String& str, std::set<gd::String>& strings) {
+  if (str.empty()) return;
+  strings.insert(str);
+
+  const std::string& raw = str.Raw();
+  for (std::size_t start = raw.find_first_of("\"'");
+       start != std::string::npos;) {
+    std::size_t end = raw.find(raw[start], start + 1);
+    if (end == std::string::npos) break;
+
+    if (end > start + 1)
+      strings.insert(
+          gd::String::FromUTF8(raw.substr(start + 1, end - start - 1)));
+    start = raw.find_first_of("\"'", end + 1);
+  }
+}
+
+void AddAllStrings(const gd::SerializerElement& element,
+                   std::set<gd::String>& strings) {
+  if (!element.IsValueUndefined() && element.GetValue().IsString())
+    AddStrings(element.GetValue().GetString(), strings);
+
+  for (auto& attribute : element.GetAllAttributes())
+    if (attribute.second.IsString())
+      AddStrings(attribute.second.GetString(), strings);
+
+  for (auto& child : element.GetAllChildren())
+    AddAllStrings(*child.second, strings);
+}
+
+}  // namespace
+
 bool ProjectResourcesAdder::AddAllMissing(gd::Project& project,
                                           const gd::String& resourceType) {
   // Search for resources used in the project
@@ -66,4 +105,41 @@ void ProjectResourcesAdder::RemoveAllUseless(gd::Project& project,
   }
 }
 
+std::vector<gd::String> ProjectResourcesAdder::GetAllUnreferenced(
+    gd::Project& project, const gd::String& resourceType) {
+  std::vector<gd::String> uselessResources =
+      GetAllUseless(project, resourceType);
+  if (uselessResources.empty()) return uselessResources;
+
+  // Search for all the strings used in the project (except in the resources
+  // themselves).
+  gd::SerializerElement projectElement;
+  project.SerializeTo(projectElement);
+  projectElement.RemoveChild("resources");
+  std::set<gd::String> strings;
+  AddAllStrings(projectElement, strings);
+
+  std::vector<gd::String> unreferencedResources;
+  for (const gd::String& name : uselessResources) {
+    const gd::Resource& resource =
+        project.GetResourcesManager().GetResource(name);
+    if (strings.find(name) == strings.end() &&
+        (resource.GetFile().empty() ||
+         strings.find(resource.GetFile()) == strings.end()))
+      unreferencedResources.push_back(name);
+  }
+
+  return unreferencedResources;
+}
+
+void ProjectResourcesAdder::RemoveAllUnreferenced(
+    gd::Project& project, const gd::String& resourceType) {
+  std::vector<gd::String> unreferencedResources =
+      GetAllUnreferenced(project, resourceType);
+
+  for (std::size_t i = 0; i < unreferencedResources.size(); ++i) {
+    project.GetResourcesManager().RemoveResource(unreferencedResources[i]);
+  }
+}
+
 }  // namespace gd
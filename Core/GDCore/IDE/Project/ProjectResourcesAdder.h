@@ -50,6 +50,36 @@ class GD_CORE_API ProjectResourcesAdder {
    * \param resourceType The type of the resource the be searched
    */
   static void RemoveAllUseless(gd::Project& project, const gd::String & resourceType);
+
+  /**
+   * \brief Find all resources of the specified kind that are not used by the
+   * project, and that are not referred to anywhere in the project.
+   *
+   * Unlike GetAllUseless, a resource is considered as used if its name or its
+   * file is used in a string of the project (in a parameter of an event, a
+   * property of an object...), even if it was not exposed as a resource. This
+   * is used to only export the resources that are really needed.
+   *
+   * \note Resources only referred to by names built at runtime (or by names
+   * used in external source files) can't be found.
+   *
+   * \param project The project to be crawled.
+   * \param resourceType The type of the resource the be searched
+   *
+   * \return A vector containing the name of all unreferenced resources
+   */
+  static std::vector<gd::String> GetAllUnreferenced(gd::Project& project, const gd::String & resourceType);
+
+  /**
+   * \brief Remove all resources of the specified kind that are not used, nor
+   * referred to, by the project.
+   *
+   * \see GetAllUnreferenced
+   *
+   * \param project The project to be crawled.
+   * \param resourceType The type of the resource the be searched
+   */
+  static void RemoveAllUnreferenced(gd::Project& project, const gd::String & resourceType);
 };
 
 }  // namespace gd
@@ -4,7 +4,11 @@
  * reserved. This project is released under the MIT License.
  */
 #include "ProjectResourcesCopier.h"
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <set>
+#include <vector>
 #include "GDCore/CommonTools.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Project/ResourcesAbsolutePathChecker.h"
@@ -12,11 +16,39 @@
 #include "GDCore/Project/Project.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/Threads.h"
 
 using namespace std;
 
 namespace gd {
 
+namespace {
+
+/**
+ * \brief Return true if the destination is a copy of the source file that is
+ * still up to date, so that the file does not need to be copied again.
+ */
+bool IsUnchangedCopy(AbstractFileSystem& fs,
+                     const gd::String& source,
+                     const gd::String& destination) {
+  if (!fs.FileExists(source) || !fs.FileExists(destination)) return false;
+
+  std::uint64_t sourceSize = 0, destinationSize = 0;
+  std::int64_t sourceTime = 0, destinationTime = 0;
+  if (fs.GetFileInfo(source, sourceSize, sourceTime) &&
+      fs.GetFileInfo(destination, destinationSize, destinationTime)) {
+    if (sourceSize != destinationSize) return false;
+
+    // The source was not modified since it was copied.
+    if (destinationTime >= sourceTime) return true;
+  }
+
+  // Compare the contents if the files can't be told apart otherwise.
+  return fs.ReadFile(source) == fs.ReadFile(destination);
+}
+
+}  // namespace
+
 bool ProjectResourcesCopier::CopyAllResourcesTo(
     gd::Project& originalProject,
     AbstractFileSystem& fs,
@@ -24,7 +56,8 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
     bool updateOriginalProject,
     wxProgressDialog* optionalProgressDialog,
     bool askAboutAbsoluteFilenames,
-    bool preserveDirectoryStructure) {
+    bool preserveDirectoryStructure,
+    std::size_t threadsCount) {
   // Check if there are some resources with absolute filenames
   gd::ResourcesAbsolutePathChecker absolutePathChecker(fs);
   originalProject.ExposeResources(absolutePathChecker);
@@ -52,7 +85,13 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
   // Copy resources
   map<gd::String, gd::String>& resourcesNewFilename =
       resourcesMergingHelper.GetAllResourcesOldAndNewFilename();
-  unsigned int i = 0;
+  struct FileCopy {
+    gd::String source;
+    gd::String destination;
+    bool failed = false;
+  };
+  std::vector<FileCopy> fileCopies;
+  std::set<gd::String> directories;
   for (map<gd::String, gd::String>::const_iterator it =
            resourcesNewFilename.begin();
        it != resourcesNewFilename.end();
@@ -62,18 +101,34 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
       gd::String destinationFile = it->second;
       fs.MakeAbsolute(destinationFile, destinationDirectory);
 
-      // Be sure the directory exists
+      // Be sure the directory exists (before copying files on several
+      // threads).
       gd::String dir = fs.DirNameFrom(destinationFile);
-      if (!fs.DirExists(dir)) fs.MkDir(dir);
+      if (directories.insert(dir).second && !fs.DirExists(dir)) fs.MkDir(dir);
 
-      // We can now copy the file
-      if (!fs.CopyFile(it->first, destinationFile)) {
-        gd::LogWarning(_("Unable to copy \"") + it->first + _("\" to \"") +
-                       destinationFile + _("\"."));
-      }
+      FileCopy fileCopy;
+      fileCopy.source = it->first;
+      fileCopy.destination = destinationFile;
+      fileCopies.push_back(fileCopy);
     }
+  }
+
+  std::vector<std::function<void()> > copies;
+  for (FileCopy& fileCopy : fileCopies) {
+    copies.push_back([&fs, &fileCopy]() {
+      if (IsUnchangedCopy(fs, fileCopy.source, fileCopy.destination)) return;
 
-    ++i;
+      // We can now copy the file
+      fileCopy.failed = !fs.CopyFile(fileCopy.source, fileCopy.destination);
+    });
+  }
+  gd::CallOnThreads(copies, threadsCount);
+
+  for (const FileCopy& fileCopy : fileCopies) {
+    if (fileCopy.failed) {
+      gd::LogWarning(_("Unable to copy \"") + fileCopy.source +
+                     _("\" to \"") + fileCopy.destination + _("\"."));
+    }
   }
 
   return true;
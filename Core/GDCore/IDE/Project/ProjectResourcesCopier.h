@@ -5,6 +5,7 @@
  */
 #ifndef PROJECTRESOURCESCOPIER_H
 #define PROJECTRESOURCESCOPIER_H
+#include <cstddef>
 #include "GDCore/String.h"
 namespace gd {
 class Project;
@@ -38,7 +39,16 @@ class GD_CORE_API ProjectResourcesCopier {
    * destination directory and their filenames updated. \param
    * preserveDirectoryStructure If set to true (default), the directories of the
    * resources will be preserved when copying. Otherwise, everything will be
-   * send in the destinationDirectory.
+   * send in the destinationDirectory. \param threadsCount The number of
+   * threads copying the files (including the calling thread). The file system
+   * must support being used by several threads at the same time if it's more
+   * than 1.
+   *
+   * Files that are unchanged since they were copied in the destination
+   * directory (by a previous export for example) are not copied again. They
+   * are compared using their sizes and modification times when the file
+   * system gives them (see gd::AbstractFileSystem::GetFileInfo), and using
+   * their contents otherwise.
    *
    * \return true if no error happened
    */
@@ -49,7 +59,8 @@ class GD_CORE_API ProjectResourcesCopier {
       bool updateOriginalProject,
       wxProgressDialog* optionalProgressDialog = NULL,
       bool askAboutAbsoluteFilenames = true,
-      bool preserveDirectoryStructure = true);
+      bool preserveDirectoryStructure = true,
+      std::size_t threadsCount = 1);
 };
 
 }  // namespace gd
@@ -0,0 +1,81 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include <algorithm>
+
+namespace gd {
+
+bool TextureAtlasPacker::AddImage(const gd::String& name,
+                                  unsigned int width,
+                                  unsigned int height) {
+  if (width + 2 * padding > maximumSize || height + 2 * padding > maximumSize)
+    return false;
+
+  return imagesSizes.emplace(name, std::make_pair(width, height)).second;
+}
+
+void TextureAtlasPacker::Pack() {
+  regions.clear();
+  atlasesSizes.clear();
+
+  // Put the tallest images first, so that shelves are filled with images of
+  // similar heights. Images with the same size are kept sorted by name, so
+  // that the packing does not change between two exports.
+  typedef std::pair<const gd::String, std::pair<unsigned int, unsigned int> >
+      ImageSize;
+  std::vector<const ImageSize*> images;
+  for (const auto& imageSize : imagesSizes) images.push_back(&imageSize);
+  std::stable_sort(images.begin(),
+                   images.end(),
+                   [](const ImageSize* image1, const ImageSize* image2) {
+                     if (image1->second.second != image2->second.second)
+                       return image1->second.second > image2->second.second;
+                     return image1->second.first > image2->second.first;
+                   });
+
+  std::vector<Shelf> shelves;
+  for (const ImageSize* image : images) {
+    unsigned int width = image->second.first + 2 * padding;
+    unsigned int height = image->second.second + 2 * padding;
+
+    auto shelf = std::find_if(
+        shelves.begin(), shelves.end(), [&](const Shelf& shelf) {
+          return shelf.height >= height && shelf.width + width <= maximumSize;
+        });
+    if (shelf == shelves.end()) {
+      // Start a new shelf below the others, in a new atlas if necessary.
+      auto atlas = std::find_if(
+          atlasesSizes.begin(),
+          atlasesSizes.end(),
+          [&](const std::pair<unsigned int, unsigned int>& atlasSize) {
+            return atlasSize.second + height <= maximumSize;
+          });
+      if (atlas == atlasesSizes.end())
+        atlas = atlasesSizes.insert(atlasesSizes.end(), std::make_pair(0, 0));
+
+      Shelf newShelf;
+      newShelf.atlas = atlas - atlasesSizes.begin();
+      newShelf.y = atlas->second;
+      newShelf.height = height;
+      newShelf.width = 0;
+      atlas->second += height;
+      shelf = shelves.insert(shelves.end(), newShelf);
+    }
+
+    Region& region = regions[image->first];
+    region.atlas = shelf->atlas;
+    region.x = shelf->width + padding;
+    region.y = shelf->y + padding;
+    region.width = image->second.first;
+    region.height = image->second.second;
+
+    shelf->width += width;
+    atlasesSizes[shelf->atlas].first =
+        std::max(atlasesSizes[shelf->atlas].first, shelf->width);
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,110 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_TEXTUREATLASPACKER_H
+#define GDCORE_TEXTUREATLASPACKER_H
+#include <map>
+#include <vector>
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Compute where images must be put in texture atlases, so that sprites
+ * using different images can be drawn with the same texture.
+ *
+ * Images are put on "shelves" (rows of images), from the tallest to the
+ * shortest, and a new atlas is started when an image can't fit in the atlases
+ * already started. Images are separated by a padding, which can be filled with
+ * their borders to avoid bleeding when textures are smoothed.
+ *
+ * \see gd::ProjectImagesPacker
+ *
+ * \ingroup IDE
+ */
+class GD_CORE_API TextureAtlasPacker {
+ public:
+  /**
+   * \brief The part of an atlas where an image is put.
+   */
+  struct Region {
+    std::size_t atlas;  ///< The index of the atlas.
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  /**
+   * \brief Create a packer for atlases of at most \a maximumSize pixels wide
+   * and high, with \a padding pixels around each image.
+   */
+  TextureAtlasPacker(unsigned int maximumSize = 2048, unsigned int padding = 2)
+      : maximumSize(maximumSize), padding(padding){};
+  virtual ~TextureAtlasPacker(){};
+
+  /**
+   * \brief Add an image to be packed.
+   * \return false if the image is too large to be put in an atlas (it is not
+   * added) or if an image with the same name was already added.
+   */
+  bool AddImage(const gd::String& name, unsigned int width, unsigned int height);
+
+  /**
+   * \brief Compute the regions of the images added.
+   */
+  void Pack();
+
+  /**
+   * \brief Return the regions of the images, found by their names, computed
+   * by the last call to Pack.
+   */
+  const std::map<gd::String, Region>& GetRegions() const { return regions; }
+
+  /**
+   * \brief Return the number of atlases computed by the last call to Pack.
+   */
+  std::size_t GetAtlasesCount() const { return atlasesSizes.size(); }
+
+  /**
+   * \brief Return the width of an atlas, i.e the smallest width containing
+   * its images and their padding.
+   */
+  unsigned int GetAtlasWidth(std::size_t atlas) const {
+    return atlasesSizes[atlas].first;
+  }
+
+  /**
+   * \brief Return the height of an atlas, i.e the smallest height containing
+   * its images and their padding.
+   */
+  unsigned int GetAtlasHeight(std::size_t atlas) const {
+    return atlasesSizes[atlas].second;
+  }
+
+  /**
+   * \brief Return the padding around each image.
+   */
+  unsigned int GetPadding() const { return padding; }
+
+ private:
+  struct Shelf {
+    std::size_t atlas;
+    unsigned int y;
+    unsigned int height;
+    unsigned int width;  ///< The width already used.
+  };
+
+  unsigned int maximumSize;
+  unsigned int padding;
+  std::map<gd::String, std::pair<unsigned int, unsigned int> >
+      imagesSizes;  ///< The sizes of the images added.
+
+  std::map<gd::String, Region> regions;
+  std::vector<std::pair<unsigned int, unsigned int> > atlasesSizes;
+};
+
+}  // namespace gd
+#endif  // GDCORE_TEXTUREATLASPACKER_H
@@ -8,6 +8,7 @@
 #include "GDCore/Project/ExternalLayout.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/SerializerElement.h"
 
 namespace gd {
 
@@ -77,4 +78,31 @@ void GD_CORE_API ProjectStripper::StripProjectForExternalLayoutEdition(
   }
 }
 
+void GD_CORE_API ProjectStripper::SerializeProjectForRuntime(
+    const gd::Project& project, gd::SerializerElement& element) {
+  project.SerializeTo(element);
+
+  element.RemoveChild("objectsGroups");
+  element.RemoveChild("externalEvents");
+  element.RemoveChild("eventsFunctionsExtensions");
+  element.RemoveChild("externalSourceFiles");
+
+  gd::SerializerElement& propertiesElement = element.GetChild("properties");
+  propertiesElement.RemoveChild("latestCompilationDirectory");
+  propertiesElement.RemoveChild("platformSpecificAssets");
+
+  gd::SerializerElement& layoutsElement = element.GetChild("layouts");
+  for (std::size_t i = 0; i < layoutsElement.GetChildrenCount(); ++i) {
+    gd::SerializerElement& layoutElement = layoutsElement.GetChild(i);
+    layoutElement.RemoveChild("events");
+    layoutElement.RemoveChild("objectsGroups");
+    layoutElement.RemoveChild("uiSettings");
+  }
+
+  gd::SerializerElement& externalLayoutsElement =
+      element.GetChild("externalLayouts");
+  for (std::size_t i = 0; i < externalLayoutsElement.GetChildrenCount(); ++i)
+    externalLayoutsElement.GetChild(i).RemoveChild("editionSettings");
+}
+
 }  // namespace gd
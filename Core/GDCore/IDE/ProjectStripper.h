@@ -7,6 +7,7 @@
 #define GDCORE_PROJECTSTRIPPER_H
 namespace gd {
 class Project;
+class SerializerElement;
 }
 namespace gd {
 class String;
@@ -45,6 +46,22 @@ class GD_CORE_API ProjectStripper {
   static void StripProjectForExternalLayoutEdition(
       gd::Project& project, const gd::String& externalLayoutName);
 
+  /**
+   * \brief Serialize only the content of the project used by the game
+   * engines: events, objects groups, external events, events functions
+   * extensions, external source files and the settings of the editors are
+   * not serialized.
+   *
+   * The element can be unserialized by gd::Project::UnserializeFrom like a
+   * full project (the missing parts are empty). Layouts, objects and
+   * instances are still serialized as arrays, so that the element is compact
+   * when written in the binary format (see gd::Serializer::ToBinary).
+   *
+   * \note Unlike StripProjectForExport, the project is not modified.
+   */
+  static void SerializeProjectForRuntime(const gd::Project& project,
+                                         gd::SerializerElement& element);
+
  private:
   ProjectStripper(){};
   virtual ~ProjectStripper(){};
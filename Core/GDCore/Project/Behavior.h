@@ -7,6 +7,7 @@
 #define GDCORE_BEHAVIOR_H
 #include <map>
 #include "GDCore/String.h"
+#include "GDCore/Tools/SharedString.h"
 #if defined(GD_IDE_ONLY)
 namespace gd {
 class PropertyDescriptor;
@@ -85,7 +86,7 @@ class GD_CORE_API Behavior {
   virtual void InitializeContent(gd::SerializerElement& behaviorContent){};
 
  private:
-  gd::String type;
+  gd::SharedString type;
 };
 
 }  // namespace gd
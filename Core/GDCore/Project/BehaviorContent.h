@@ -8,6 +8,7 @@
 #include <map>
 #include "GDCore/Serialization/Serializer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/SharedString.h"
 #if defined(GD_IDE_ONLY)
 namespace gd {
 class PropertyDescriptor;
@@ -77,8 +78,9 @@ class GD_CORE_API BehaviorContent {
 
  protected:
   gd::String name;  ///< Name of the behavior
-  gd::String type;  ///< The type of the behavior that is represented. Usually
-                    ///< in the form "ExtensionName::BehaviorTypeName"
+  gd::SharedString type;  ///< The type of the behavior that is
+                          ///< represented. Usually in the form
+                          ///< "ExtensionName::BehaviorTypeName"
 
   gd::SerializerElement content;  // Storage for the behavior properties
 };
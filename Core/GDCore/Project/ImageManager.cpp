@@ -5,9 +5,21 @@
  */
 #include "GDCore/Project/ImageManager.h"
 #include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include "GDCore/Project/ResourcesLoader.h"
 #include "GDCore/Project/ResourcesManager.h"
 #include "GDCore/Tools/InvalidImage.h"
+#include "GDCore/Tools/KtxImage.h"
+#include "GDCore/Tools/MakeUnique.h"
+#include "GDCore/Tools/OpenGLTools.h"
+#include "GDCore/Tools/Threads.h"
+#if !defined(EMSCRIPTEN)
+#include <system_error>
+#include <thread>
+#endif
 #if !defined(ANDROID) && !defined(MACOS)
 #include <GL/glu.h>
 #endif
@@ -15,7 +27,247 @@
 
 namespace gd {
 
-ImageManager::ImageManager() : resourcesManager(NULL) {
+namespace {
+
+/**
+ * \brief Return the file of the image to be decoded: the original image if
+ * the file is a compressed texture (see ImageManager).
+ */
+gd::String GetDecodedFile(const ImageResource& image) {
+  const gd::String& file = image.GetFile();
+  if (!KtxImage::IsKtxFile(file.ToUTF8())) return file;
+
+  return file.substr(0, file.size() - 4);
+}
+
+/**
+ * \brief Create the texture of an image decoded in \a texture.image, or from
+ * the compressed texture if the file of the image is a KTX file supported by
+ * the GPU.
+ */
+void CreateTexture(const ImageResource& image, SFMLTextureWrapper& texture) {
+  gd::KtxImage ktxImage;
+  if (KtxImage::IsKtxFile(image.GetFile().ToUTF8()) &&
+      ResourcesLoader::Get()->LoadKtxImage(image.GetFile(), ktxImage) &&
+      OpenGLTools::UploadCompressedTexture(ktxImage, texture.texture)) {
+    texture.compressedBytes = ktxImage.GetLevel(0).size();
+  } else {
+    texture.texture.loadFromImage(texture.image);
+    texture.compressedBytes = 0;
+  }
+  texture.texture.setSmooth(image.smooth);
+  texture.collisionMasks.reset();
+}
+
+}  // namespace
+
+/**
+ * \brief Decode images using background threads, and hold the decoded images
+ * until the main thread turns them into textures.
+ *
+ * Images are decoded by the thread calling TakeDecodedImage if no thread can
+ * be started (for example with Emscripten).
+ */
+class ImageManager::Preloader {
+ public:
+  struct Image {
+    gd::String name;
+    gd::String file;
+    std::shared_ptr<SFMLTextureWrapper> texture;  ///< Its image is decoded by
+                                                  ///< the background threads.
+    std::size_t generation;  ///< Used to forget the images decoded after a
+                             ///< call to Clear.
+  };
+
+  Preloader()
+      : imagesCount(0),
+        uploadedImagesCount(0),
+        threadsStarted(false),
+        generation(0),
+        stopping(false) {}
+
+  ~Preloader() {
+#if !defined(EMSCRIPTEN)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    condition.notify_all();
+    for (auto& thread : threads) thread.join();
+#endif
+  }
+
+  /**
+   * \brief Add an image to be decoded, unless it is already being preloaded.
+   */
+  void Add(const gd::String& name, const gd::String& file) {
+    if (!names.insert(name).second) return;
+
+    auto image = gd::make_unique<Image>();
+    image->name = name;
+    image->file = file;
+    image->texture = std::make_shared<SFMLTextureWrapper>();
+    imagesCount++;
+
+    StartThreads();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      image->generation = generation;
+      imagesToDecode.push_back(std::move(image));
+    }
+    condition.notify_one();
+  }
+
+  /**
+   * \brief Return the next decoded image, or nullptr if none is decoded yet.
+   */
+  std::unique_ptr<Image> TakeDecodedImage() {
+    std::unique_ptr<Image> image;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!decodedImages.empty()) {
+        image = std::move(decodedImages.front());
+        decodedImages.pop_front();
+      } else if (!HasThreads() && !imagesToDecode.empty()) {
+        image = std::move(imagesToDecode.front());
+        imagesToDecode.pop_front();
+      } else {
+        return nullptr;
+      }
+    }
+
+    if (!HasThreads()) Decode(*image);
+    ImageTaken(image->name);
+    return image;
+  }
+
+  /**
+   * \brief Return the decoded image with the specified name, or nullptr if it
+   * is not decoded yet.
+   */
+  std::unique_ptr<Image> TakeDecodedImage(const gd::String& name) {
+    if (names.find(name) == names.end()) return nullptr;
+
+    std::unique_ptr<Image> image;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = std::find_if(decodedImages.begin(),
+                             decodedImages.end(),
+                             [&name](const std::unique_ptr<Image>& image) {
+                               return image->name == name;
+                             });
+      if (it == decodedImages.end()) return nullptr;
+
+      image = std::move(*it);
+      decodedImages.erase(it);
+    }
+
+    ImageTaken(name);
+    return image;
+  }
+
+  /**
+   * \brief Forget all the images added, decoded or not.
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    imagesToDecode.clear();
+    decodedImages.clear();
+    generation++;
+    names.clear();
+    imagesCount = 0;
+    uploadedImagesCount = 0;
+  }
+
+  std::size_t GetImagesCount() const { return imagesCount; }
+  std::size_t GetUploadedImagesCount() const { return uploadedImagesCount; }
+
+ private:
+  static void Decode(Image& image) {
+    ResourcesLoader::Get()->LoadSFMLImage(image.file, image.texture->image);
+  }
+
+  void ImageTaken(const gd::String& name) {
+    names.erase(name);
+    uploadedImagesCount++;
+  }
+
+  bool HasThreads() const {
+#if !defined(EMSCRIPTEN)
+    return !threads.empty();
+#else
+    return false;
+#endif
+  }
+
+  void StartThreads() {
+    if (threadsStarted) return;
+    threadsStarted = true;
+
+#if !defined(EMSCRIPTEN)
+    ResourcesLoader::Get();  // Created before being used by the threads.
+
+    // Leave a core to the main thread, which uploads the textures.
+    std::size_t threadsCount = std::min<std::size_t>(
+        std::max<std::size_t>(gd::GetHardwareThreadsCount(), 2) - 1, 4);
+    for (std::size_t i = 0; i < threadsCount; ++i) {
+      try {
+        threads.push_back(std::thread(&Preloader::DecodeImages, this));
+      } catch (const std::system_error&) {
+        break;  // Threads are not available: use the threads started.
+      }
+    }
+#endif
+  }
+
+  void DecodeImages() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      condition.wait(
+          lock, [this]() { return stopping || !imagesToDecode.empty(); });
+      if (stopping) return;
+
+      std::unique_ptr<Image> image = std::move(imagesToDecode.front());
+      imagesToDecode.pop_front();
+      lock.unlock();
+      Decode(*image);
+      lock.lock();
+
+      if (image->generation == generation)
+        decodedImages.push_back(std::move(image));
+    }
+  }
+
+  // Only used by the main thread:
+  std::set<gd::String> names;  ///< The images added and not taken yet.
+  std::size_t imagesCount;
+  std::size_t uploadedImagesCount;
+  bool threadsStarted;
+
+  // Shared with the background threads:
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::unique_ptr<Image> > imagesToDecode;
+  std::deque<std::unique_ptr<Image> > decodedImages;
+  std::size_t generation;
+  bool stopping;
+#if !defined(EMSCRIPTEN)
+  std::vector<std::thread> threads;
+#endif
+};
+
+ImageManager::ImageManager()
+    :
+#if defined(GD_IDE_ONLY)
+      preventUnloading(false),
+#endif
+      preloader(gd::make_unique<Preloader>()),
+      useCounter(0),
+      memoryBudget(0),
+      hits(0),
+      misses(0),
+      evictions(0),
+      resourcesManager(NULL) {
 #if !defined(EMSCRIPTEN)
   badTexture = std::make_shared<SFMLTextureWrapper>();
   badTexture->texture.loadFromMemory(gd::InvalidImageData,
@@ -25,17 +277,48 @@ ImageManager::ImageManager() : resourcesManager(NULL) {
 #endif
 }
 
+ImageManager::ImageManager(const ImageManager& other)
+    : alreadyLoadedImages(other.alreadyLoadedImages),
+      permanentlyLoadedImages(other.permanentlyLoadedImages),
+#if defined(GD_IDE_ONLY)
+      unloadingPreventer(other.unloadingPreventer),
+      preventUnloading(other.preventUnloading),
+#endif
+      alreadyLoadedOpenGLTextures(other.alreadyLoadedOpenGLTextures),
+      alreadyLoadedAtlases(other.alreadyLoadedAtlases),
+      preloader(gd::make_unique<Preloader>()),
+      preloadedImages(other.preloadedImages),
+      lastUses(other.lastUses),
+      useCounter(other.useCounter),
+      memoryBudget(other.memoryBudget),
+      hits(0),
+      misses(0),
+      evictions(0),
+      badTexture(other.badTexture),
+      badOpenGLTexture(other.badOpenGLTexture),
+      resourcesManager(other.resourcesManager) {}
+
+ImageManager::~ImageManager() {}
+
 std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
     const gd::String& name) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (!resourcesManager) {
     std::cout << "ImageManager has no ResourcesManager associated with.";
     return badTexture;
   }
 
-  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
-      !alreadyLoadedImages.find(name)->second.expired())
-    return alreadyLoadedImages.find(name)->second.lock();
+  auto it = alreadyLoadedImages.find(name);
+  if (it != alreadyLoadedImages.end()) {
+    std::shared_ptr<SFMLTextureWrapper> texture = it->second.lock();
+    if (texture) {
+      hits++;
+      lastUses[name] = ++useCounter;
+      return texture;
+    }
+  }
 
+  misses++;
   std::cout << "ImageManager: Loading " << name << ".";
 
   // Load only an image when necessary
@@ -43,19 +326,22 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
     ImageResource& image =
         dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
 
-    auto texture = std::make_shared<SFMLTextureWrapper>();
-    ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), texture->image);
-    texture->texture.loadFromImage(texture->image);
-    texture->texture.setSmooth(image.smooth);
-
-    alreadyLoadedImages[name] = texture;
-#if defined(GD_IDE_ONLY)
-    if (preventUnloading)
-      unloadingPreventer.push_back(
-          texture);  // If unload prevention is activated, add the image to the
-                     // list dedicated to prevent images from being unloaded.
-#endif
+    // Use the image if it was already decoded by the preloading threads.
+    std::shared_ptr<SFMLTextureWrapper> texture;
+    std::unique_ptr<Preloader::Image> preloadedImage =
+        preloader->TakeDecodedImage(name);
+    if (preloadedImage) {
+      texture = preloadedImage->texture;
+      preloadedImages[name] = texture;
+    } else if (image.IsInAtlas()) {
+      texture = LoadImageFromAtlas(image);
+    } else {
+      texture = std::make_shared<SFMLTextureWrapper>();
+      ResourcesLoader::Get()->LoadSFMLImage(GetDecodedFile(image),
+                                            texture->image);
+    }
 
+    AddLoadedImage(name, image, texture);
     return texture;
   } catch (...) {
   }
@@ -65,7 +351,225 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
   return badTexture;
 }
 
+void ImageManager::AddLoadedImage(
+    const gd::String& name,
+    const ImageResource& image,
+    const std::shared_ptr<SFMLTextureWrapper>& texture) const {
+  if (!texture->atlas) CreateTexture(image, *texture);
+  AccountTextureMemory(*texture);
+
+  alreadyLoadedImages[name] = texture;
+  lastUses[name] = ++useCounter;
+#if defined(GD_IDE_ONLY)
+  if (preventUnloading)
+    unloadingPreventer[name] =
+        texture;  // If unload prevention is activated, add the image to the
+                  // list dedicated to prevent images from being unloaded.
+#endif
+
+  ReleaseImagesOverBudget();
+}
+
+void ImageManager::SetMemoryBudget(std::size_t bytes) {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  memoryBudget = bytes;
+  ReleaseImagesOverBudget();
+}
+
+ImageManager::Stats ImageManager::GetStats() const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  Stats stats;
+  stats.hits = hits;
+  stats.misses = misses;
+  stats.evictions = evictions;
+  stats.texturesCount = 0;
+  for (auto& it : alreadyLoadedImages)
+    if (!it.second.expired()) stats.texturesCount++;
+  for (auto& it : alreadyLoadedAtlases)
+    if (!it.second.expired()) stats.texturesCount++;
+  stats.residentBytes = GetResidentBytes();
+
+  return stats;
+}
+
+std::size_t ImageManager::GetTextureBytes(const SFMLTextureWrapper& texture) {
+  if (texture.atlas) return 0;
+  if (texture.compressedBytes) return texture.compressedBytes;
+
+  sf::Vector2u size = texture.texture.getSize();
+  return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+void ImageManager::AccountTextureMemory(SFMLTextureWrapper& texture) {
+  sf::Vector2u imageSize = texture.image.getSize();
+  texture.memoryAccount.SetBytes(
+      GetTextureBytes(texture) +
+      static_cast<std::size_t>(imageSize.x) * imageSize.y * 4);
+}
+
+std::size_t ImageManager::GetResidentBytes() const {
+  std::size_t bytes = 0;
+  for (auto& it : alreadyLoadedImages) {
+    std::shared_ptr<SFMLTextureWrapper> texture = it.second.lock();
+    if (texture) bytes += GetTextureBytes(*texture);
+  }
+  for (auto& it : alreadyLoadedAtlases) {
+    std::shared_ptr<SFMLTextureWrapper> atlas = it.second.lock();
+    if (atlas) bytes += GetTextureBytes(*atlas);
+  }
+
+  return bytes;
+}
+
+void ImageManager::ReleaseImagesOverBudget() const {
+  if (memoryBudget == 0) return;
+
+  std::size_t residentBytes = GetResidentBytes();
+  if (residentBytes <= memoryBudget) return;
+
+  // The images kept by the manager, except the permanent ones, can be
+  // released, the least recently used first.
+  std::vector<std::pair<std::size_t, gd::String> > releasableImages;
+  auto addReleasableImage = [&](const gd::String& name) {
+    if (permanentlyLoadedImages.find(name) != permanentlyLoadedImages.end())
+      return;
+    releasableImages.push_back(std::make_pair(lastUses[name], name));
+  };
+  for (auto& it : preloadedImages) addReleasableImage(it.first);
+#if defined(GD_IDE_ONLY)
+  for (auto& it : unloadingPreventer)
+    if (preloadedImages.find(it.first) == preloadedImages.end())
+      addReleasableImage(it.first);
+#endif
+  std::sort(releasableImages.begin(), releasableImages.end());
+
+  for (auto& releasableImage : releasableImages) {
+    if (residentBytes <= memoryBudget) break;
+
+    const gd::String& name = releasableImage.second;
+    std::weak_ptr<SFMLTextureWrapper> texture = alreadyLoadedImages[name];
+    std::shared_ptr<SFMLTextureWrapper> atlas;
+    std::size_t bytes = 0;
+    if (auto lockedTexture = texture.lock()) {
+      bytes = GetTextureBytes(*lockedTexture);
+      atlas = lockedTexture->atlas;
+    }
+
+    preloadedImages.erase(name);
+#if defined(GD_IDE_ONLY)
+    unloadingPreventer.erase(name);
+#endif
+    evictions++;
+
+    // The memory is only freed if the image is not used anymore.
+    if (texture.expired()) residentBytes -= std::min(bytes, residentBytes);
+    if (atlas && atlas.use_count() == 1) {
+      bytes = GetTextureBytes(*atlas);
+      residentBytes -= std::min(bytes, residentBytes);
+    }
+  }
+}
+
+std::shared_ptr<SFMLTextureWrapper> ImageManager::LoadImageFromAtlas(
+    const ImageResource& image) const {
+  std::shared_ptr<SFMLTextureWrapper> atlas;
+  auto it = alreadyLoadedAtlases.find(image.GetAtlasFile());
+  if (it != alreadyLoadedAtlases.end()) atlas = it->second.lock();
+  if (!atlas) {
+    atlas = std::make_shared<SFMLTextureWrapper>();
+    ResourcesLoader::Get()->LoadSFMLImage(image.GetAtlasFile(), atlas->image);
+    atlas->texture.loadFromImage(atlas->image);
+    atlas->texture.setSmooth(image.smooth);
+    AccountTextureMemory(*atlas);
+    alreadyLoadedAtlases[image.GetAtlasFile()] = atlas;
+  }
+
+  // The image is still copied, for pixel perfect collisions and changes made
+  // to the image of an object.
+  auto texture = std::make_shared<SFMLTextureWrapper>();
+  texture->atlas = atlas;
+  texture->atlasRect = sf::IntRect(image.GetAtlasX(),
+                                   image.GetAtlasY(),
+                                   image.GetAtlasWidth(),
+                                   image.GetAtlasHeight());
+  texture->image.create(image.GetAtlasWidth(), image.GetAtlasHeight());
+  texture->image.copy(atlas->image, 0, 0, texture->atlasRect);
+  return texture;
+}
+
+void ImageManager::PreloadImages(const std::set<gd::String>& names) {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  if (!resourcesManager) {
+    std::cout << "ImageManager has no ResourcesManager associated with.";
+    return;
+  }
+
+  // Keep the textures already loaded, and forget the images preloaded before
+  // that are not requested anymore.
+  std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
+      newPreloadedImages;
+  preloader->Clear();
+  for (const gd::String& name : names) {
+    if (HasLoadedSFMLTexture(name)) {
+      newPreloadedImages[name] = alreadyLoadedImages[name].lock();
+      continue;
+    }
+
+    try {
+      ImageResource& image =
+          dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
+      if (image.IsInAtlas())  // Atlases are loaded once for all their images.
+        newPreloadedImages[name] = GetSFMLTexture(name);
+      else
+        preloader->Add(name, GetDecodedFile(image));
+    } catch (...) { /*The resource is not an image*/
+    }
+  }
+  preloadedImages.swap(newPreloadedImages);
+}
+
+bool ImageManager::UploadPreloadedImages(sf::Time timeBudget) {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  sf::Clock clock;
+  while (clock.getElapsedTime() < timeBudget) {
+    std::unique_ptr<Preloader::Image> preloadedImage =
+        preloader->TakeDecodedImage();
+    if (!preloadedImage) break;
+
+    const gd::String& name = preloadedImage->name;
+    if (!HasLoadedSFMLTexture(name)) {
+      try {
+        ImageResource& image =
+            dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
+        AddLoadedImage(name, image, preloadedImage->texture);
+      } catch (...) { /*The resource is not an image anymore*/
+        continue;
+      }
+    }
+    std::shared_ptr<SFMLTextureWrapper> texture =
+        alreadyLoadedImages[name].lock();
+    if (texture) preloadedImages[name] = texture;
+  }
+
+  return preloader->GetUploadedImagesCount() >= preloader->GetImagesCount();
+}
+
+float ImageManager::GetPreloadingProgress() const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  if (preloader->GetImagesCount() == 0) return 1;
+
+  return static_cast<float>(preloader->GetUploadedImagesCount()) /
+         preloader->GetImagesCount();
+}
+
+void ImageManager::ReleasePreloadedImages() {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
+  preloadedImages.clear();
+  preloader->Clear();
+}
+
 bool ImageManager::HasLoadedSFMLTexture(const gd::String& name) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
       !alreadyLoadedImages.find(name)->second.expired())
     return true;
@@ -76,6 +580,7 @@ bool ImageManager::HasLoadedSFMLTexture(const gd::String& name) const {
 void ImageManager::SetSFMLTextureAsPermanentlyLoaded(
     const gd::String& name,
     std::shared_ptr<SFMLTextureWrapper>& texture) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (alreadyLoadedImages.find(name) == alreadyLoadedImages.end() ||
       alreadyLoadedImages.find(name)->second.expired())
     alreadyLoadedImages[name] = texture;
@@ -85,6 +590,7 @@ void ImageManager::SetSFMLTextureAsPermanentlyLoaded(
 }
 
 void ImageManager::ReloadImage(const gd::String& name) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (!resourcesManager) {
     std::cout << "ImageManager has no ResourcesManager associated with.";
     return;
@@ -106,9 +612,11 @@ void ImageManager::ReloadImage(const gd::String& name) const {
 
     std::cout << "ImageManager: Reload " << name << std::endl;
 
-    ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), oldTexture->image);
-    oldTexture->texture.loadFromImage(oldTexture->image);
-    oldTexture->texture.setSmooth(image.smooth);
+    ResourcesLoader::Get()->LoadSFMLImage(GetDecodedFile(image),
+                                          oldTexture->image);
+    oldTexture->atlas.reset();
+    CreateTexture(image, *oldTexture);
+    AccountTextureMemory(*oldTexture);
 
     return;
   } catch (...) { /*The ressource is not an image*/
@@ -122,6 +630,7 @@ void ImageManager::ReloadImage(const gd::String& name) const {
 
 std::shared_ptr<OpenGLTextureWrapper> ImageManager::GetOpenGLTexture(
     const gd::String& name) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (alreadyLoadedOpenGLTextures.find(name) !=
           alreadyLoadedOpenGLTextures.end() &&
       !alreadyLoadedOpenGLTextures.find(name)->second.expired())
@@ -136,6 +645,7 @@ std::shared_ptr<OpenGLTextureWrapper> ImageManager::GetOpenGLTexture(
 }
 
 void ImageManager::LoadPermanentImages() {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   if (!resourcesManager) {
     std::cout << "ImageManager has no ResourcesManager associated with.";
     return;
@@ -164,16 +674,18 @@ void ImageManager::LoadPermanentImages() {
 
 #if defined(GD_IDE_ONLY)
 void ImageManager::PreventImagesUnloading() {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   preventUnloading = true;
   for (auto it = alreadyLoadedImages.begin(); it != alreadyLoadedImages.end();
        ++it) {
     std::shared_ptr<SFMLTextureWrapper> image = (it->second).lock();
     if (image != std::shared_ptr<SFMLTextureWrapper>())
-      unloadingPreventer.push_back(image);
+      unloadingPreventer[it->first] = image;
   }
 }
 
 void ImageManager::EnableImagesUnloading() {
+  std::lock_guard<std::recursive_mutex> lock(mutex);
   preventUnloading = false;
   unloadingPreventer
       .clear();  // Images which are not used anymore will thus be destroyed (As
@@ -184,9 +696,13 @@ void ImageManager::EnableImagesUnloading() {
 }  // namespace gd
 
 SFMLTextureWrapper::SFMLTextureWrapper(const sf::Texture& texture_)
-    : texture(texture_), image(texture.copyToImage()) {}
+    : texture(texture_),
+      image(texture.copyToImage()),
+      compressedBytes(0),
+      memoryAccount(gd::SystemStats::Textures) {}
 
-SFMLTextureWrapper::SFMLTextureWrapper() {}
+SFMLTextureWrapper::SFMLTextureWrapper()
+    : compressedBytes(0), memoryAccount(gd::SystemStats::Textures) {}
 
 SFMLTextureWrapper::~SFMLTextureWrapper() {}
 
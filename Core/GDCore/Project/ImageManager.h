@@ -11,14 +11,20 @@
 #include <SFML/OpenGL.hpp>
 #include <SFML/System.hpp>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 #include "GDCore/String.h"
+#include "GDCore/Tools/SystemStats.h"
 namespace gd {
+class ImageResource;
 class ResourcesManager;
 }
 class OpenGLTextureWrapper;
 class SFMLTextureWrapper;
+class CollisionMasksCache;
 #undef LoadImage  // thx windows.h
 
 namespace gd {
@@ -30,7 +36,19 @@ namespace gd {
  * Image manager is used by objects to obtain their images from the image name.
  *
  * Images are loaded dynamically when necessary, and are unloaded if there is no
- * more shared_ptr pointing on an image.
+ * more shared_ptr pointing on an image. Images kept in memory by the manager
+ * while they are not used (preloaded images, images kept by
+ * PreventImagesUnloading) are released, the least recently used first, when
+ * the textures use more memory than the budget set with SetMemoryBudget.
+ *
+ * The methods can be called by several threads, but the textures must be
+ * created by a thread having an OpenGL context.
+ *
+ * The file of an image can be a texture compressed for the GPU, in a KTX file
+ * named after the original image (for example "player.png.ktx"). The
+ * compressed texture is then used if the GPU supports its format, and the
+ * original image is still decoded as it is used for pixel perfect collisions
+ * and changes made to the images.
  *
  * You should in particular be interested by gd::ImageManager::GetOpenGLTexture
  * and gd::ImageManager::GetSFMLTexture.
@@ -43,7 +61,13 @@ namespace gd {
 class GD_CORE_API ImageManager {
  public:
   ImageManager();
-  virtual ~ImageManager(){};
+
+  /**
+   * \brief Copy the images loaded by another manager. Images being preloaded
+   * by \a other are not preloaded by the copy.
+   */
+  ImageManager(const ImageManager& other);
+  virtual ~ImageManager();
 
   /**
    * \brief Get a shared pointer to an OpenGL texture. The shared pointer must
@@ -98,6 +122,85 @@ class GD_CORE_API ImageManager {
    */
   void ReloadImage(const gd::String& name) const;
 
+  /** \name Memory budget
+   */
+  ///@{
+  /**
+   * \brief Statistics about the textures handled by the manager.
+   */
+  struct Stats {
+    std::size_t hits;       ///< Textures requested that were already loaded.
+    std::size_t misses;     ///< Textures requested that had to be loaded.
+    std::size_t evictions;  ///< Images released to stay within the budget.
+    std::size_t texturesCount;  ///< Textures currently loaded (atlases
+                                ///< included).
+    std::size_t residentBytes;  ///< Estimated memory used by the textures
+                                ///< currently loaded.
+  };
+
+  /**
+   * \brief Set the estimated memory, in bytes, that the textures can use
+   * before the images kept by the manager while not used are released.
+   *
+   * \note The images that are used (i.e: for which a shared pointer is kept
+   * by an object) and the images loaded permanently are never released, so
+   * the budget can be exceeded. 0 (the default) means no limit.
+   */
+  void SetMemoryBudget(std::size_t bytes);
+
+  /**
+   * \brief Return the memory budget set with SetMemoryBudget.
+   */
+  std::size_t GetMemoryBudget() const { return memoryBudget; }
+
+  /**
+   * \brief Return the statistics about the textures handled by the manager.
+   */
+  Stats GetStats() const;
+  ///@}
+
+  /** \name Images preloading
+   * Images can be decoded by background threads before being requested, so
+   * that the game does not stop when they are first used.
+   */
+  ///@{
+  /**
+   * \brief Start decoding the specified images in background threads.
+   *
+   * The decoded images are turned into textures by UploadPreloadedImages, and
+   * are then kept in memory until ReleasePreloadedImages is called. Images
+   * already loaded in memory are not decoded again.
+   *
+   * \note The images preloaded by a previous call and not in \a names are
+   * released, so this can be called for each new scene.
+   */
+  void PreloadImages(const std::set<gd::String>& names);
+
+  /**
+   * \brief Turn the images decoded by the background threads into textures,
+   * until all of them are uploaded or \a timeBudget is elapsed.
+   *
+   * \note Must be called by the thread owning the OpenGL context, usually once
+   * per frame while a loading screen is displayed.
+   * \return true if all the preloaded images are available as textures.
+   */
+  bool UploadPreloadedImages(sf::Time timeBudget);
+
+  /**
+   * \brief Return the proportion, between 0 and 1, of the images given to
+   * PreloadImages that are available as textures.
+   */
+  float GetPreloadingProgress() const;
+
+  /**
+   * \brief Stop keeping the preloaded textures in memory, and forget the
+   * images that are not decoded yet.
+   *
+   * The textures still used (see GetSFMLTexture) stay loaded.
+   */
+  void ReleasePreloadedImages();
+  ///@}
+
 #if defined(GD_IDE_ONLY)
   /**
    * \brief When called, images won't be unloaded from memory until
@@ -113,6 +216,46 @@ class GD_CORE_API ImageManager {
 #endif
 
  private:
+  class Preloader;
+
+  /**
+   * \brief Create the texture of an image decoded in \a texture->image, and
+   * make it available to GetSFMLTexture.
+   */
+  void AddLoadedImage(const gd::String& name,
+                      const ImageResource& image,
+                      const std::shared_ptr<SFMLTextureWrapper>& texture) const;
+
+  /**
+   * \brief Create the texture wrapper of an image packed in an atlas, loading
+   * the atlas if it is not loaded yet.
+   */
+  std::shared_ptr<SFMLTextureWrapper> LoadImageFromAtlas(
+      const ImageResource& image) const;
+
+  /**
+   * \brief Return the estimated memory used by the textures loaded.
+   */
+  std::size_t GetResidentBytes() const;
+
+  /**
+   * \brief Release the least recently used images kept by the manager while
+   * not used, until the textures are within the memory budget.
+   */
+  void ReleaseImagesOverBudget() const;
+
+  /**
+   * \brief Return the estimated memory used by the texture itself (the atlas
+   * of an image packed in an atlas is not counted).
+   */
+  static std::size_t GetTextureBytes(const SFMLTextureWrapper& texture);
+
+  /**
+   * \brief Update the memory accounted for the texture and its image (see
+   * gd::SystemStats::Textures), once they were loaded.
+   */
+  static void AccountTextureMemory(SFMLTextureWrapper& texture);
+
   mutable std::map<gd::String, std::weak_ptr<SFMLTextureWrapper> >
       alreadyLoadedImages;  ///< Reference all images loaded in memory.
   mutable std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
@@ -130,13 +273,33 @@ class GD_CORE_API ImageManager {
    * \see PreventImagesUnloading
    * \see EnableImagesUnloading
    */
-  mutable std::vector<std::shared_ptr<SFMLTextureWrapper> > unloadingPreventer;
+  mutable std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
+      unloadingPreventer;
   bool preventUnloading;  ///< True if no images must be currently unloaded.
 #endif
 
   mutable std::map<gd::String, std::weak_ptr<OpenGLTextureWrapper> >
       alreadyLoadedOpenGLTextures;  ///< Reference all OpenGL textures loaded in
                                     ///< memory.
+  mutable std::map<gd::String, std::weak_ptr<SFMLTextureWrapper> >
+      alreadyLoadedAtlases;  ///< Reference the atlases loaded in memory, by
+                             ///< their files.
+
+  std::unique_ptr<Preloader>
+      preloader;  ///< The images being decoded by background threads.
+  mutable std::map<gd::String, std::shared_ptr<SFMLTextureWrapper> >
+      preloadedImages;  ///< The textures created from the preloaded images,
+                        ///< kept until ReleasePreloadedImages is called.
+
+  mutable std::map<gd::String, std::size_t>
+      lastUses;  ///< The value of useCounter when each image was last got.
+  mutable std::size_t useCounter;
+  std::size_t memoryBudget;  ///< 0 means no limit.
+  mutable std::size_t hits;
+  mutable std::size_t misses;
+  mutable std::size_t evictions;
+  mutable std::recursive_mutex mutex;  ///< Protects everything, as the
+                                       ///< methods call each other.
 
   mutable std::shared_ptr<SFMLTextureWrapper> badTexture;
   mutable std::shared_ptr<OpenGLTextureWrapper> badOpenGLTexture;
@@ -161,7 +324,23 @@ class GD_CORE_API SFMLTextureWrapper {
   sf::Texture texture;
   sf::Image image;  ///< Associated sfml image, used for pixel perfect collision
                     ///< for example. If you update the image, call
-                    ///< LoadFromImage on texture to update it also.
+                    ///< LoadFromImage on texture to update it also, and reset
+                    ///< collisionMasks.
+
+  std::shared_ptr<SFMLTextureWrapper>
+      atlas;  ///< The atlas containing the image, if the image is packed in an
+              ///< atlas (see gd::ImageResource::IsInAtlas). \a texture is then
+              ///< empty, and the part \a atlasRect of the texture of the atlas
+              ///< must be drawn instead.
+  sf::IntRect atlasRect;  ///< The part of the atlas containing the image.
+  std::size_t compressedBytes;  ///< The size of the texture if it was created
+                                ///< from a compressed texture, 0 otherwise.
+  std::shared_ptr<CollisionMasksCache>
+      collisionMasks;  ///< The masks of the opaque pixels of \a image, created
+                       ///< by the game engine when testing pixel perfect
+                       ///< collisions. Reset it when \a image is modified.
+  gd::MemoryAccount memoryAccount;  ///< The memory of the texture and of the
+                                    ///< image, set by gd::ImageManager.
 };
 
 /**
@@ -8,6 +8,7 @@
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/JsonReader.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #if defined(GD_IDE_ONLY)
 #include "GDCore/IDE/Dialogs/PropertyDescriptor.h"
@@ -67,6 +68,98 @@ void InitialInstance::UnserializeFrom(const SerializerElement& element) {
       element.GetChild("initialVariables", 0, "InitialVariables"));
 }
 
+namespace {
+/**
+ * \brief Read the properties stored in an array of objects having a name and
+ * a value, starting at the current token of the reader.
+ */
+template <typename T, typename ValueType>
+void UnserializePropertiesFrom(
+    gd::JsonReader& reader,
+    std::map<gd::String, T>& properties,
+    ValueType (SerializerValue::*getValue)() const) {
+  if (reader.GetToken() != gd::JsonReader::BeginArray) {
+    reader.SkipValue();
+    return;
+  }
+
+  while (reader.Next() == gd::JsonReader::BeginObject) {
+    gd::String name;
+    SerializerValue value;
+    while (reader.Next() == gd::JsonReader::Name) {
+      std::string memberName = reader.GetString();
+      reader.Next();
+      if (memberName == "name")
+        name = reader.GetValue().GetString();
+      else if (memberName == "value")
+        value = reader.GetValue();
+      else
+        reader.SkipValue();
+    }
+
+    properties[name] = (value.*getValue)();
+  }
+}
+}  // namespace
+
+void InitialInstance::UnserializeFrom(gd::JsonReader& reader) {
+  SetObjectName("");
+  SetX(0);
+  SetY(0);
+  SetAngle(0);
+  SetHasCustomSize(false);
+  SetCustomWidth(0);
+  SetCustomHeight(0);
+  SetZOrder(0);
+  SetLayer("");
+  SetLocked(false);
+  floatInfos.clear();
+  stringInfos.clear();
+  GetVariables().Clear();
+
+  if (reader.GetToken() != gd::JsonReader::BeginObject) {
+    reader.SkipValue();
+    return;
+  }
+
+  while (reader.Next() == gd::JsonReader::Name) {
+    std::string name = reader.GetString();
+    reader.Next();
+    if (name == "name" || name == "nom")
+      SetObjectName(reader.GetValue().GetString());
+    else if (name == "x")
+      SetX(reader.GetValue().GetDouble());
+    else if (name == "y")
+      SetY(reader.GetValue().GetDouble());
+    else if (name == "angle")
+      SetAngle(reader.GetValue().GetDouble());
+    else if (name == "customSize" || name == "personalizedSize")
+      SetHasCustomSize(reader.GetValue().GetBool());
+    else if (name == "width")
+      SetCustomWidth(reader.GetValue().GetDouble());
+    else if (name == "height")
+      SetCustomHeight(reader.GetValue().GetDouble());
+    else if (name == "zOrder" || name == "plan")
+      SetZOrder(reader.GetValue().GetInt());
+    else if (name == "layer")
+      SetLayer(reader.GetValue().GetString());
+    else if (name == "locked")
+      SetLocked(reader.GetValue().GetBool());
+    else if (name == "numberProperties" || name == "floatInfos")
+      UnserializePropertiesFrom(
+          reader, floatInfos, &SerializerValue::GetDouble);
+    else if (name == "stringProperties" || name == "stringInfos")
+      UnserializePropertiesFrom(
+          reader, stringInfos, &SerializerValue::GetString);
+    else if (name == "initialVariables" || name == "InitialVariables") {
+      SerializerElement variablesElement;
+      reader.ReadElement(variablesElement);
+      GetVariables().UnserializeFrom(variablesElement);
+    } else
+      reader.SkipValue();
+  }
+}
+
 void InitialInstance::SerializeTo(SerializerElement& element) const {
   element.SetAttribute("name", GetObjectName());
   element.SetAttribute("x", GetX());
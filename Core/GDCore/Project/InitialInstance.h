@@ -9,10 +9,12 @@
 #include <map>
 #include "GDCore/Project/VariablesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/SharedString.h"
 namespace gd {
 class PropertyDescriptor;
 class Project;
 class Layout;
+class JsonReader;
 }
 
 namespace gd {
@@ -240,6 +242,13 @@ class GD_CORE_API InitialInstance {
    * \brief Unserialize the instances container.
    */
   virtual void UnserializeFrom(const SerializerElement& element);
+
+  /**
+   * \brief Unserialize the instance from the value starting at the current
+   * token of the reader, without building a gd::SerializerElement for the
+   * instance (only its variables are read into an element).
+   */
+  void UnserializeFrom(gd::JsonReader& reader);
   ///@}
 
   // More properties can be stored in floatInfos and stringInfos.
@@ -249,15 +258,15 @@ class GD_CORE_API InitialInstance {
   std::map<gd::String, gd::String>
       stringInfos;  ///< More data which can be used by the object
  private:
-  gd::String objectName;  ///< Object name
-  float x;                ///< Object initial X position
-  float y;                ///< Object initial Y position
-  float angle;            ///< Object initial angle
-  int zOrder;             ///< Object initial Z order
-  gd::String layer;       ///< Object initial layer
-  bool personalizedSize;  ///< True if object has a custom size
-  float width;            ///< Object custom width
-  float height;           ///< Object custom height
+  gd::SharedString objectName;  ///< Object name
+  float x;                      ///< Object initial X position
+  float y;                      ///< Object initial Y position
+  float angle;                  ///< Object initial angle
+  int zOrder;                   ///< Object initial Z order
+  gd::SharedString layer;       ///< Object initial layer
+  bool personalizedSize;        ///< True if object has a custom size
+  float width;                  ///< Object custom width
+  float height;                 ///< Object custom height
   gd::VariablesContainer initialVariables;  ///< Instance specific variables
   bool locked;                              ///< True if the instance is locked
 
@@ -6,10 +6,12 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <unordered_set>
 
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/InitialInstance.h"
 #include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Serialization/JsonReader.h"
 #include "GDCore/Serialization/SerializerElement.h"
 
 using namespace std;
@@ -18,69 +20,152 @@ namespace gd {
 
 gd::InitialInstance InitialInstancesContainer::badPosition;
 
+InitialInstancesContainer::InitialInstancesContainer(
+    const InitialInstancesContainer& other) {
+  operator=(other);
+}
+
+InitialInstancesContainer::InitialInstancesContainer(
+    InitialInstancesContainer&& other) noexcept {
+  Swap(other);
+}
+
 InitialInstancesContainer::~InitialInstancesContainer() {}
 
+InitialInstancesContainer& InitialInstancesContainer::operator=(
+    const InitialInstancesContainer& other) {
+  if (this != &other) {
+    // Copy the instances in new blocks, without the removed instances.
+    std::vector<std::vector<gd::InitialInstance> > newBlocks;
+    std::vector<gd::InitialInstance*> newInstances;
+    newInstances.reserve(other.initialInstances.size());
+    for (const gd::InitialInstance* instance : other.initialInstances) {
+      if (newBlocks.empty() || newBlocks.back().size() == blockSize) {
+        newBlocks.push_back(std::vector<gd::InitialInstance>());
+        newBlocks.back().reserve(blockSize);
+      }
+      newBlocks.back().push_back(*instance);
+      newInstances.push_back(&newBlocks.back().back());
+    }
+
+    blocks.swap(newBlocks);
+    initialInstances.swap(newInstances);
+    freeInstances.clear();
+  }
+
+  return *this;
+}
+
+InitialInstancesContainer& InitialInstancesContainer::operator=(
+    InitialInstancesContainer&& other) noexcept {
+  if (this != &other) {
+    blocks.clear();
+    initialInstances.clear();
+    freeInstances.clear();
+    Swap(other);
+  }
+
+  return *this;
+}
+
 std::size_t InitialInstancesContainer::GetInstancesCount() const {
   return initialInstances.size();
 }
 
+gd::InitialInstance& InitialInstancesContainer::AddInstance() {
+  gd::InitialInstance* instance = nullptr;
+  if (!freeInstances.empty()) {
+    instance = freeInstances.back();
+    freeInstances.pop_back();
+  } else {
+    if (blocks.empty() || blocks.back().size() == blockSize) {
+      blocks.push_back(std::vector<gd::InitialInstance>());
+      blocks.back().reserve(blockSize);
+    }
+    blocks.back().push_back(gd::InitialInstance());
+    instance = &blocks.back().back();
+  }
+
+  initialInstances.push_back(instance);
+  return *instance;
+}
+
+void InitialInstancesContainer::FreeInstance(gd::InitialInstance& instance) {
+  instance = gd::InitialInstance();
+  freeInstances.push_back(&instance);
+}
+
 void InitialInstancesContainer::UnserializeFrom(
     const SerializerElement& element) {
+  blocks.clear();
   initialInstances.clear();
+  freeInstances.clear();
 
   element.ConsiderAsArrayOf("instance", "Objet");
-  for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
-    gd::InitialInstance instance;
-    instance.UnserializeFrom(element.GetChild(i));
-    initialInstances.push_back(instance);
+  initialInstances.reserve(element.GetChildrenCount());
+  for (std::size_t i = 0; i < element.GetChildrenCount(); ++i)
+    AddInstance().UnserializeFrom(element.GetChild(i));
+}
+
+void InitialInstancesContainer::UnserializeFrom(gd::JsonReader& reader) {
+  blocks.clear();
+  initialInstances.clear();
+  freeInstances.clear();
+  if (reader.GetToken() != gd::JsonReader::BeginArray) {
+    reader.SkipValue();
+    return;
+  }
+
+  while (reader.Next() != gd::JsonReader::EndArray && !reader.HasError() &&
+         reader.GetToken() != gd::JsonReader::End) {
+    AddInstance().UnserializeFrom(reader);
   }
 }
 
 void InitialInstancesContainer::IterateOverInstances(
     gd::InitialInstanceFunctor& func) {
-  for (auto& instance : initialInstances) func(instance);
+  // Instances inserted by the functor are iterated over too.
+  for (std::size_t i = 0; i < initialInstances.size(); ++i)
+    func(*initialInstances[i]);
 }
 
 void InitialInstancesContainer::IterateOverInstancesWithZOrdering(
     gd::InitialInstanceFunctor& func, const gd::String& layerName) {
-  std::vector<std::reference_wrapper<gd::InitialInstance>> sortedInstances;
+  std::vector<gd::InitialInstance*> sortedInstances;
   std::copy_if(initialInstances.begin(),
                initialInstances.end(),
-               std::inserter(sortedInstances, sortedInstances.begin()),
-               [&layerName](InitialInstance& instance) {
-                 return instance.GetLayer() == layerName;
+               std::back_inserter(sortedInstances),
+               [&layerName](const InitialInstance* instance) {
+                 return instance->GetLayer() == layerName;
                });
 
   std::sort(sortedInstances.begin(),
             sortedInstances.end(),
-            [](gd::InitialInstance& a, gd::InitialInstance& b) {
-              return a.GetZOrder() < b.GetZOrder();
+            [](const gd::InitialInstance* a, const gd::InitialInstance* b) {
+              return a->GetZOrder() < b->GetZOrder();
             });
 
-  for (auto& instance : sortedInstances) func(instance);
+  for (gd::InitialInstance* instance : sortedInstances) func(*instance);
 }
 
 #if defined(GD_IDE_ONLY)
 gd::InitialInstance& InitialInstancesContainer::InsertNewInitialInstance() {
-  gd::InitialInstance newInstance;
-  initialInstances.push_back(newInstance);
-
-  return initialInstances.back();
+  return AddInstance();
 }
 
 void InitialInstancesContainer::RemoveInstanceIf(
     std::function<bool(const gd::InitialInstance&)> predicat) {
-  // Note that we can't use erase–remove idiom here because remove_if would
-  // move the instances, and the container must guarantee that
-  // iterators/pointers to instances always remain valid.
-  for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(),
-                                                end = initialInstances.end();
-       it != end;) {
-    if (predicat(*it))
-      it = initialInstances.erase(it);
+  // Only the pointers are moved, so that pointers to the other instances
+  // always remain valid.
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < initialInstances.size(); ++i) {
+    gd::InitialInstance* instance = initialInstances[i];
+    if (predicat(*instance))
+      FreeInstance(*instance);
     else
-      ++it;
+      initialInstances[kept++] = instance;
   }
+  initialInstances.resize(kept);
 }
 
 void InitialInstancesContainer::RemoveInstance(
@@ -90,14 +175,75 @@ void InitialInstancesContainer::RemoveInstance(
   });
 }
 
+void InitialInstancesContainer::RemoveInstances(
+    const std::vector<gd::InitialInstance*>& instancesToRemove) {
+  if (instancesToRemove.empty()) return;
+
+  std::unordered_set<const gd::InitialInstance*> instances(
+      instancesToRemove.begin(), instancesToRemove.end());
+  RemoveInstanceIf([&instances](const InitialInstance& currentInstance) {
+    return instances.find(&currentInstance) != instances.end();
+  });
+}
+
+void InitialInstancesContainer::MoveInstances(
+    const std::vector<gd::InitialInstance*>& instancesToMove,
+    float offsetX,
+    float offsetY) {
+  for (gd::InitialInstance* instance : instancesToMove) {
+    instance->SetX(instance->GetX() + offsetX);
+    instance->SetY(instance->GetY() + offsetY);
+  }
+}
+
+std::vector<gd::InitialInstance*> InitialInstancesContainer::DuplicateInstances(
+    const std::vector<gd::InitialInstance*>& instancesToDuplicate,
+    float offsetX,
+    float offsetY) {
+  std::vector<gd::InitialInstance*> newInstances;
+  newInstances.reserve(instancesToDuplicate.size());
+  initialInstances.reserve(initialInstances.size() +
+                           instancesToDuplicate.size());
+
+  // The instances are never moved in memory, so the instances to duplicate
+  // stay valid when new instances are added.
+  for (const gd::InitialInstance* instance : instancesToDuplicate) {
+    gd::InitialInstance& newInstance = AddInstance();
+    newInstance = *instance;
+    newInstance.SetX(newInstance.GetX() + offsetX);
+    newInstance.SetY(newInstance.GetY() + offsetY);
+    newInstances.push_back(&newInstance);
+  }
+
+  return newInstances;
+}
+
+std::vector<gd::InitialInstance*> InitialInstancesContainer::GetInstancesInRect(
+    const gd::String& layerName,
+    float left,
+    float top,
+    float right,
+    float bottom) {
+  std::vector<gd::InitialInstance*> instances;
+  for (gd::InitialInstance* instance : initialInstances) {
+    if (instance->GetLayer() == layerName && instance->GetX() >= left &&
+        instance->GetX() <= right && instance->GetY() >= top &&
+        instance->GetY() <= bottom)
+      instances.push_back(instance);
+  }
+
+  return instances;
+}
+
 gd::InitialInstance& InitialInstancesContainer::InsertInitialInstance(
     const gd::InitialInstance& instance) {
   try {
     const gd::InitialInstance& castedInstance =
         dynamic_cast<const gd::InitialInstance&>(instance);
-    initialInstances.push_back(castedInstance);
+    gd::InitialInstance& newInstance = AddInstance();
+    newInstance = castedInstance;
 
-    return initialInstances.back();
+    return newInstance;
   } catch (...) {
     std::cout
         << "WARNING: Tried to add an gd::InitialInstance which is not a GD C++ "
@@ -109,8 +255,8 @@ gd::InitialInstance& InitialInstancesContainer::InsertInitialInstance(
 
 void InitialInstancesContainer::RenameInstancesOfObject(
     const gd::String& oldName, const gd::String& newName) {
-  for (gd::InitialInstance& instance : initialInstances) {
-    if (instance.GetObjectName() == oldName) instance.SetObjectName(newName);
+  for (gd::InitialInstance* instance : initialInstances) {
+    if (instance->GetObjectName() == oldName) instance->SetObjectName(newName);
   }
 }
 
@@ -130,8 +276,8 @@ void InitialInstancesContainer::RemoveAllInstancesOnLayer(
 
 void InitialInstancesContainer::MoveInstancesToLayer(
     const gd::String& fromLayer, const gd::String& toLayer) {
-  for (gd::InitialInstance& instance : initialInstances) {
-    if (instance.GetLayer() == fromLayer) instance.SetLayer(toLayer);
+  for (gd::InitialInstance* instance : initialInstances) {
+    if (instance->GetLayer() == fromLayer) instance->SetLayer(toLayer);
   }
 }
 
@@ -139,8 +285,8 @@ bool InitialInstancesContainer::SomeInstancesAreOnLayer(
     const gd::String& layerName) {
   return std::any_of(initialInstances.begin(),
                      initialInstances.end(),
-                     [&layerName](const InitialInstance& currentInstance) {
-                       return currentInstance.GetLayer() == layerName;
+                     [&layerName](const InitialInstance* currentInstance) {
+                       return currentInstance->GetLayer() == layerName;
                      });
 }
 
@@ -148,8 +294,8 @@ bool InitialInstancesContainer::HasInstancesOfObject(
     const gd::String& objectName) {
   return std::any_of(initialInstances.begin(),
                      initialInstances.end(),
-                     [&objectName](const InitialInstance& currentInstance) {
-                       return currentInstance.GetObjectName() == objectName;
+                     [&objectName](const InitialInstance* currentInstance) {
+                       return currentInstance->GetObjectName() == objectName;
                      });
 }
 
@@ -168,11 +314,15 @@ void InitialInstancesContainer::Create(
 
 void InitialInstancesContainer::SerializeTo(SerializerElement& element) const {
   element.ConsiderAsArrayOf("instance");
-  for (auto instance : initialInstances)
-    instance.SerializeTo(element.AddChild("instance"));
+  for (const gd::InitialInstance* instance : initialInstances)
+    instance->SerializeTo(element.AddChild("instance"));
 }
 
-void InitialInstancesContainer::Clear() { initialInstances.clear(); }
+void InitialInstancesContainer::Clear() {
+  blocks.clear();
+  initialInstances.clear();
+  freeInstances.clear();
+}
 #endif
 
 InitialInstanceFunctor::~InitialInstanceFunctor(){};
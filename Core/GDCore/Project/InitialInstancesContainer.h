@@ -6,7 +6,9 @@
 
 #ifndef GDCORE_INITIALINSTANCESCONTAINER_H
 #define GDCORE_INITIALINSTANCESCONTAINER_H
-#include <list>
+#include <functional>
+#include <memory>
+#include <vector>
 #include "GDCore/Project/InitialInstance.h"
 #include "GDCore/String.h"
 namespace gd {
@@ -17,6 +19,7 @@ class Project;
 }
 namespace gd {
 class SerializerElement;
+class JsonReader;
 }
 
 namespace gd {
@@ -28,18 +31,27 @@ namespace gd {
  * to the elements of the container are not invalidated when
  * a change occurs (through InsertNewInitialInstance or RemoveInstance
  * for example). <br>
- * Thus, the implementations uses a std::list
- * for holding the instances. In this way, the container is not required
- * to provide a direct access to element based on an index. Instead,
- * the method IterateOverInstances is used to perform operations.
+ * Thus, the instances are stored in blocks of fixed size that are never
+ * reallocated, and the slots of removed instances are reused by the next
+ * inserted instances. The order of the instances is kept in a separate array
+ * of pointers, so that iterating over the instances goes through contiguous
+ * memory. The container is not required to provide a direct access to
+ * element based on an index. Instead, the method IterateOverInstances is used
+ * to perform operations.
  *
  * \see gd::InitialInstanceFunctor
  */
 class GD_CORE_API InitialInstancesContainer {
  public:
   InitialInstancesContainer(){};
+  InitialInstancesContainer(const InitialInstancesContainer &other);
+  InitialInstancesContainer(InitialInstancesContainer &&other) noexcept;
   virtual ~InitialInstancesContainer();
 
+  InitialInstancesContainer &operator=(const InitialInstancesContainer &other);
+  InitialInstancesContainer &operator=(
+      InitialInstancesContainer &&other) noexcept;
+
   /**
    * \brief Return a pointer to a copy of the container.
    * A such method is needed as the IDE may want to store copies of some
@@ -118,6 +130,45 @@ class GD_CORE_API InitialInstancesContainer {
    */
   void RemoveInstance(const gd::InitialInstance &instance);
 
+  /**
+   * \brief Remove the specified \a instances.
+   *
+   * The instances are all removed in a single pass, so prefer this to calling
+   * RemoveInstance for each instance when removing a lot of them.
+   */
+  void RemoveInstances(
+      const std::vector<gd::InitialInstance *> &instancesToRemove);
+
+  /**
+   * \brief Move the specified \a instances by the given offset.
+   */
+  void MoveInstances(const std::vector<gd::InitialInstance *> &instancesToMove,
+                     float offsetX,
+                     float offsetY);
+
+  /**
+   * \brief Insert a copy of the specified \a instances at the end of the list,
+   * moved by the given offset, and return the new instances.
+   */
+  std::vector<gd::InitialInstance *> DuplicateInstances(
+      const std::vector<gd::InitialInstance *> &instancesToDuplicate,
+      float offsetX,
+      float offsetY);
+
+  /**
+   * \brief Return the instances of the layer named \a layerName having their
+   * position inside the given rectangle (bounds included).
+   *
+   * \note The size of the instances depends on their object, so only their
+   * position is checked.
+   */
+  std::vector<gd::InitialInstance *> GetInstancesInRect(
+      const gd::String &layerName,
+      float left,
+      float top,
+      float right,
+      float bottom);
+
   /**
    * \brief Remove all instances from layer \a layerName.
    */
@@ -174,13 +225,51 @@ class GD_CORE_API InitialInstancesContainer {
    * \brief Unserialize the instances container.
    */
   virtual void UnserializeFrom(const SerializerElement &element);
+
+  /**
+   * \brief Unserialize the instances from the array starting at the current
+   * token of the reader. Each instance is read directly from the tokens
+   * (see gd::InitialInstance::UnserializeFrom).
+   */
+  void UnserializeFrom(gd::JsonReader &reader);
+
+  /**
+   * \brief Exchange the instances of the container with the instances of
+   * another container, without copying them.
+   */
+  void Swap(InitialInstancesContainer &other) {
+    blocks.swap(other.blocks);
+    initialInstances.swap(other.initialInstances);
+    freeInstances.swap(other.freeInstances);
+  }
   ///@}
 
  private:
   void RemoveInstanceIf(
       std::function<bool(const gd::InitialInstance &)> predicat);
 
-  std::list<gd::InitialInstance> initialInstances;
+  /**
+   * \brief Return a slot for a new instance, at the end of the instances.
+   * The instance in the slot is a blank instance.
+   */
+  gd::InitialInstance &AddInstance();
+
+  /**
+   * \brief Reset the instance and keep its slot for the next inserted
+   * instance. The instance must have been removed from initialInstances.
+   */
+  void FreeInstance(gd::InitialInstance &instance);
+
+  static const std::size_t blockSize = 64;  ///< Instances per block.
+
+  std::vector<std::vector<gd::InitialInstance> >
+      blocks;  ///< The storage of the instances. Each block is reserved to
+               ///< blockSize instances and never grows beyond, so that its
+               ///< instances are never moved.
+  std::vector<gd::InitialInstance *>
+      initialInstances;  ///< The instances, in their order.
+  std::vector<gd::InitialInstance *>
+      freeInstances;  ///< The slots of the removed instances.
 
   static gd::InitialInstance badPosition;
 };
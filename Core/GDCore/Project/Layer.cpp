@@ -13,7 +13,7 @@ namespace gd {
 Camera Layer::badCamera;
 Effect Layer::badEffect;
 
-Layer::Layer() : isVisible(true) {}
+Layer::Layer() : isVisible(true), isCached(false) {}
 
 /**
  * Change cameras count, automatically adding/removing them.
@@ -29,6 +29,7 @@ void Layer::SetCameraCount(std::size_t n) {
 void Layer::SerializeTo(SerializerElement& element) const {
   element.SetAttribute("name", GetName());
   element.SetAttribute("visibility", GetVisibility());
+  element.SetAttribute("cached", IsCached());
 
   SerializerElement& camerasElement = element.AddChild("cameras");
   camerasElement.ConsiderAsArrayOf("camera");
@@ -61,6 +62,7 @@ void Layer::SerializeTo(SerializerElement& element) const {
 void Layer::UnserializeFrom(const SerializerElement& element) {
   SetName(element.GetStringAttribute("name", "", "Name"));
   SetVisibility(element.GetBoolAttribute("visibility", true, "Visibility"));
+  SetCached(element.GetBoolAttribute("cached", false));
 
   // Compatibility with GD <= 3.3
   if (element.HasChild("Camera")) {
@@ -51,6 +51,17 @@ class GD_CORE_API Layer {
    */
   bool GetVisibility() const { return isVisible; }
 
+  /**
+   * \brief Change if the layer is cached: its objects are rendered once in a
+   * texture, which is displayed again until they are modified.
+   */
+  void SetCached(bool isCached_) { isCached = isCached_; }
+
+  /**
+   * \brief Return true if the layer is cached.
+   */
+  bool IsCached() const { return isCached; }
+
   /** \name Cameras
    */
   ///@{
@@ -173,6 +184,7 @@ class GD_CORE_API Layer {
  private:
   gd::String name;                  ///< The name of the layer
   bool isVisible;                   ///< True if the layer is visible
+  bool isCached;                    ///< True if the layer is rendered once in a texture
   std::vector<gd::Camera> cameras;  ///< The camera displayed by the layer
   std::vector<std::shared_ptr<gd::Effect>>
       effects;  ///< The effects applied to the layer.
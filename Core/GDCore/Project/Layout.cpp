@@ -20,6 +20,7 @@
 #include "GDCore/Project/ObjectGroup.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 #include "GDCore/Tools/PolymorphicClone.h"
@@ -47,10 +48,14 @@ Layout::Layout()
       backgroundColorB(209),
       stopSoundsOnStartup(true),
       standardSortMethod(true),
+      keepObjectsOrder(false),
+      streamingChunkSize(0),
+      streamingRadius(2000),
       oglFOV(90.0f),
       oglZNear(1.0f),
       oglZFar(500.0f),
-      disableInputWhenNotFocused(true)
+      disableInputWhenNotFocused(true),
+      loaded(true)
 #if defined(GD_IDE_ONLY)
       ,
       profiler(NULL)
@@ -66,6 +71,16 @@ void Layout::SetName(const gd::String& name_) {
   mangledName = gd::SceneNameMangler::GetMangledSceneName(name);
 };
 
+std::size_t Layout::GetModificationCount() const {
+  std::size_t modificationCount =
+      GetObjectsModificationCount() + variables.GetModificationCount();
+#if defined(GD_IDE_ONLY)
+  modificationCount += events.GetModificationCount();
+#endif
+
+  return modificationCount;
+}
+
 bool Layout::HasBehaviorSharedData(const gd::String& behaviorName) {
   return behaviorsSharedData.find(behaviorName) != behaviorsSharedData.end();
 }
@@ -248,6 +263,11 @@ void Layout::UpdateBehaviorsSharedData(gd::Project& project) {
 }
 
 void Layout::SerializeTo(SerializerElement& element) const {
+  if (!loaded) {
+    element = gd::Serializer::FromBinary(*serializedContent);
+    return;
+  }
+
   element.SetAttribute("name", GetName());
   element.SetAttribute("mangledName", GetMangledName());
   element.SetAttribute("r", (int)GetBackgroundColorRed());
@@ -259,6 +279,9 @@ void Layout::SerializeTo(SerializerElement& element) const {
   element.SetAttribute("oglZFar", oglZFar);
   element.SetAttribute("standardSortMethod", standardSortMethod);
   element.SetAttribute("stopSoundsOnStartup", stopSoundsOnStartup);
+  element.SetAttribute("keepObjectsOrder", keepObjectsOrder);
+  element.SetAttribute("streamingChunkSize", streamingChunkSize);
+  element.SetAttribute("streamingRadius", streamingRadius);
   element.SetAttribute("disableInputWhenNotFocused",
                        disableInputWhenNotFocused);
 
@@ -320,6 +343,9 @@ void Layout::UnserializeFrom(gd::Project& project,
   oglZFar = element.GetDoubleAttribute("oglZFar");
   standardSortMethod = element.GetBoolAttribute("standardSortMethod");
   stopSoundsOnStartup = element.GetBoolAttribute("stopSoundsOnStartup");
+  keepObjectsOrder = element.GetBoolAttribute("keepObjectsOrder", false);
+  streamingChunkSize = element.GetDoubleAttribute("streamingChunkSize", 0);
+  streamingRadius = element.GetDoubleAttribute("streamingRadius", 2000);
   disableInputWhenNotFocused =
       element.GetBoolAttribute("disableInputWhenNotFocused");
 
@@ -377,6 +403,37 @@ void Layout::UnserializeFrom(gd::Project& project,
   }
 }
 
+void Layout::UnserializeLazilyFrom(const SerializerElement& element) {
+  SetName(element.GetStringAttribute("name", "", "nom"));
+  serializedContent =
+      std::make_shared<const std::string>(gd::Serializer::ToBinary(element));
+  loaded = false;
+}
+
+void Layout::Load(gd::Project& project) {
+  if (loaded) return;
+
+  SerializerElement element = gd::Serializer::FromBinary(*serializedContent);
+  gd::String layoutName = name;
+#if defined(GD_IDE_ONLY)
+  UpdateBehaviorsSharedData(project);
+#endif
+  UnserializeFrom(project, element);
+  SetName(layoutName);
+  loaded = true;
+}
+
+void Layout::Unload() {
+  if (!loaded || !serializedContent) return;
+
+  gd::String layoutName = name;
+  std::shared_ptr<const std::string> content = serializedContent;
+  Init(gd::Layout());
+  SetName(layoutName);
+  serializedContent = content;
+  loaded = false;
+}
+
 void Layout::Init(const Layout& other) {
   SetName(other.name);
   backgroundColorR = other.backgroundColorR;
@@ -388,12 +445,18 @@ void Layout::Init(const Layout& other) {
   oglZNear = other.oglZNear;
   oglZFar = other.oglZFar;
   stopSoundsOnStartup = other.stopSoundsOnStartup;
+  keepObjectsOrder = other.keepObjectsOrder;
+  streamingChunkSize = other.streamingChunkSize;
+  streamingRadius = other.streamingRadius;
   disableInputWhenNotFocused = other.disableInputWhenNotFocused;
+  serializedContent = other.serializedContent;
+  loaded = other.loaded;
   initialInstances = other.initialInstances;
   initialLayers = other.initialLayers;
   variables = other.GetVariables();
 
   initialObjects = gd::Clone(other.initialObjects);
+  objectsModificationCount++;
 
   behaviorsSharedData.clear();
   for (const auto& it : other.behaviorsSharedData) {
@@ -8,6 +8,7 @@
 #define GDCORE_LAYOUT_H
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Project/BehaviorsSharedData.h"
@@ -104,6 +105,20 @@ class GD_CORE_API Layout : public ObjectsContainer {
    */
   void SetWindowDefaultTitle(const gd::String& title_) { title = title_; };
 
+  /**
+   * \brief Return a number incremented each time the objects, the variables
+   * or the events of the layout are modified.
+   *
+   * This is the sum of the modification counts of the objects, variables and
+   * events containers, so only the changes counted by these containers are
+   * counted.
+   *
+   * \see gd::ObjectsContainer::GetObjectsModificationCount
+   * \see gd::VariablesContainer::GetModificationCount
+   * \see gd::EventsList::GetModificationCount
+   */
+  std::size_t GetModificationCount() const;
+
   ///@}
 
   /** \name Layout's initial instances
@@ -346,6 +361,45 @@ class GD_CORE_API Layout : public ObjectsContainer {
    */
   bool StopSoundsOnStartup() const { return stopSoundsOnStartup; }
 
+  /**
+   * Set if the objects must stay in the order they were created when objects
+   * are deleted. If false, deleting an object can change the order of the
+   * other objects, but is faster.
+   */
+  void SetKeepObjectsOrder(bool enable = true) { keepObjectsOrder = enable; }
+
+  /**
+   * Return true if the objects must stay in the order they were created when
+   * objects are deleted.
+   */
+  bool KeepObjectsOrder() const { return keepObjectsOrder; }
+
+  /**
+   * Set the size of the chunks in which the initial instances are grouped to
+   * be streamed: the objects of the instances are only created when their
+   * chunk is near the camera. 0 (the default) disables the streaming: all
+   * objects are created when the scene starts.
+   */
+  void SetStreamingChunkSize(float size) { streamingChunkSize = size; }
+
+  /**
+   * Return the size of the chunks of the streamed instances, or 0 if
+   * instances are not streamed.
+   */
+  float GetStreamingChunkSize() const { return streamingChunkSize; }
+
+  /**
+   * Set the distance from the camera within which the chunks of initial
+   * instances are loaded, when instances are streamed.
+   */
+  void SetStreamingRadius(float radius) { streamingRadius = radius; }
+
+  /**
+   * Return the distance from the camera within which the chunks of initial
+   * instances are loaded.
+   */
+  float GetStreamingRadius() const { return streamingRadius; }
+
   /**
    * Set OpenGL default field of view
    */
@@ -392,6 +446,38 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * \brief Unserialize the layout.
    */
   void UnserializeFrom(gd::Project& project, const SerializerElement& element);
+
+  /**
+   * \brief Keep the layout serialized, to unserialize it only when Load is
+   * called. Only the name of the layout is unserialized.
+   *
+   * The element is stored in the binary format of gd::Serializer, shared by
+   * the copies of the layout.
+   *
+   * \see gd::Project::SetLayoutsLoadedLazily
+   */
+  void UnserializeLazilyFrom(const SerializerElement& element);
+
+  /**
+   * \brief Return false if the layout was kept serialized by
+   * UnserializeLazilyFrom and is not loaded.
+   */
+  bool IsLoaded() const { return loaded; }
+
+  /**
+   * \brief Unserialize the layout if it was kept serialized by
+   * UnserializeLazilyFrom and is not loaded. Does nothing otherwise.
+   */
+  void Load(gd::Project& project);
+
+  /**
+   * \brief Release the content of the layout if it was unserialized lazily,
+   * so that it is unserialized again by the next call to Load. Does nothing
+   * otherwise.
+   *
+   * \warning Changes made to the layout since it was loaded are lost.
+   */
+  void Unload();
 ///@}
 
 // TODO: GD C++ Platform specific code below
@@ -422,12 +508,22 @@ class GD_CORE_API Layout : public ObjectsContainer {
   bool stopSoundsOnStartup;  ///< True to make the scene stop all sounds at
                              ///< startup.
   bool standardSortMethod;   ///< True to sort objects using standard sort.
+  bool keepObjectsOrder;     ///< True to keep the order of objects when
+                             ///< objects are deleted.
+  float streamingChunkSize;  ///< Size of the chunks of streamed instances, 0
+                             ///< if instances are not streamed.
+  float streamingRadius;     ///< Distance from the camera within which chunks
+                             ///< are loaded.
   float oglFOV;              ///< OpenGL Field Of View value
   float oglZNear;            ///< OpenGL Near Z position
   float oglZFar;             ///< OpenGL Far Z position
   bool disableInputWhenNotFocused;  /// If set to true, the input must be
                                     /// disabled when the window do not have the
                                     /// focus.
+  std::shared_ptr<const std::string>
+      serializedContent;  ///< The layout in the binary format of
+                          ///< gd::Serializer, if unserialized lazily.
+  bool loaded;  ///< False if the layout is kept in serializedContent.
   static gd::Layer badLayer;  ///< Null object, returned when GetLayer can not
                               ///< find an appropriate layer.
   static gd::BehaviorContent
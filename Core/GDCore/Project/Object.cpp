@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCore/Project/Object.h"
+#include <atomic>
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Project/Behavior.h"
 #include "GDCore/Project/Layout.h"
@@ -17,10 +18,24 @@ namespace gd {
 
 Object::~Object() {}
 
+namespace {
+std::atomic<std::size_t> namesModificationCount(0);
+}
+
 Object::Object(const gd::String& name_) : name(name_) {}
 
+void Object::SetName(const gd::String& name_) {
+  name = name_;
+  namesModificationCount++;
+}
+
+std::size_t Object::GetNamesModificationCount() {
+  return namesModificationCount;
+}
+
 void Object::Init(const gd::Object& object) {
   name = object.name;
+  namesModificationCount++;
   type = object.type;
   objectVariables = object.objectVariables;
   tags = object.tags;
@@ -111,6 +126,7 @@ void Object::UnserializeFrom(gd::Project& project,
                              const SerializerElement& element) {
   type = element.GetStringAttribute("type");
   name = element.GetStringAttribute("name", name, "nom");
+  namesModificationCount++;
   tags = element.GetStringAttribute("tags");
 
   objectVariables.UnserializeFrom(
@@ -74,7 +74,15 @@ class GD_CORE_API Object {
 
   /** \brief Change the name of the object with the name passed as parameter.
    */
-  void SetName(const gd::String& name_) { name = name_; };
+  void SetName(const gd::String& name_);
+
+  /**
+   * \brief Return a number incremented each time the name of an object
+   * (any object) is changed after its construction.
+   *
+   * \see gd::ObjectsContainer::GetObject
+   */
+  static std::size_t GetNamesModificationCount();
 
   /** \brief Return the name of the object.
    */
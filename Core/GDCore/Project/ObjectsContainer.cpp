@@ -12,7 +12,10 @@
 
 namespace gd {
 
-ObjectsContainer::ObjectsContainer() {}
+ObjectsContainer::ObjectsContainer()
+    : objectsModificationCount(0),
+      indexedObjectsModificationCount(gd::String::npos),
+      indexedNamesModificationCount(gd::String::npos) {}
 
 ObjectsContainer::~ObjectsContainer() {}
 
@@ -27,6 +30,7 @@ void ObjectsContainer::SerializeObjectsTo(SerializerElement& element) const {
 
 void ObjectsContainer::UnserializeObjectsFrom(
     gd::Project& project, const SerializerElement& element) {
+  objectsModificationCount++;
   initialObjects.clear();
   element.ConsiderAsArrayOf("object", "Objet");
   for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
@@ -45,20 +49,33 @@ void ObjectsContainer::UnserializeObjectsFrom(
   }
 }
 
+std::size_t ObjectsContainer::FindObject(const gd::String& name) const {
+  std::lock_guard<std::mutex> lock(objectsIndexMutex);
+  std::size_t namesModificationCount = gd::Object::GetNamesModificationCount();
+  if (indexedObjectsModificationCount != objectsModificationCount ||
+      indexedNamesModificationCount != namesModificationCount) {
+    // Iterate backward so that the first object with a name is indexed, as
+    // returned before by the linear search.
+    objectsIndex.clear();
+    for (std::size_t i = initialObjects.size(); i-- > 0;)
+      objectsIndex[initialObjects[i]->GetName()] = i;
+
+    indexedObjectsModificationCount = objectsModificationCount;
+    indexedNamesModificationCount = namesModificationCount;
+  }
+
+  auto it = objectsIndex.find(name);
+  return it != objectsIndex.end() ? it->second : gd::String::npos;
+}
+
 bool ObjectsContainer::HasObjectNamed(const gd::String& name) const {
-  return (find_if(initialObjects.begin(),
-                  initialObjects.end(),
-                  bind2nd(gd::ObjectHasName(), name)) != initialObjects.end());
+  return FindObject(name) != gd::String::npos;
 }
 gd::Object& ObjectsContainer::GetObject(const gd::String& name) {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    bind2nd(gd::ObjectHasName(), name)));
+  return *initialObjects[FindObject(name)];
 }
 const gd::Object& ObjectsContainer::GetObject(const gd::String& name) const {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    bind2nd(gd::ObjectHasName(), name)));
+  return *initialObjects[FindObject(name)];
 }
 gd::Object& ObjectsContainer::GetObject(std::size_t index) {
   return *initialObjects[index];
@@ -67,10 +84,7 @@ const gd::Object& ObjectsContainer::GetObject(std::size_t index) const {
   return *initialObjects[index];
 }
 std::size_t ObjectsContainer::GetObjectPosition(const gd::String& name) const {
-  for (std::size_t i = 0; i < initialObjects.size(); ++i) {
-    if (initialObjects[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  return FindObject(name);
 }
 std::size_t ObjectsContainer::GetObjectsCount() const {
   return initialObjects.size();
@@ -80,6 +94,7 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
                                               const gd::String& objectType,
                                               const gd::String& name,
                                               std::size_t position) {
+  objectsModificationCount++;
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
       position < initialObjects.size() ? initialObjects.begin() + position
                                        : initialObjects.end(),
@@ -91,6 +106,7 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
 
 gd::Object& ObjectsContainer::InsertObject(const gd::Object& object,
                                            std::size_t position) {
+  objectsModificationCount++;
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
       position < initialObjects.size() ? initialObjects.begin() + position
                                        : initialObjects.end(),
@@ -105,6 +121,7 @@ void ObjectsContainer::SwapObjects(std::size_t firstObjectIndex,
       secondObjectIndex >= initialObjects.size())
     return;
 
+  objectsModificationCount++;
   std::iter_swap(initialObjects.begin() + firstObjectIndex,
                  initialObjects.begin() + secondObjectIndex);
 }
@@ -113,19 +130,18 @@ void ObjectsContainer::MoveObject(std::size_t oldIndex, std::size_t newIndex) {
   if (oldIndex >= initialObjects.size() || newIndex >= initialObjects.size())
     return;
 
+  objectsModificationCount++;
   std::unique_ptr<gd::Object> object = std::move(initialObjects[oldIndex]);
   initialObjects.erase(initialObjects.begin() + oldIndex);
   initialObjects.insert(initialObjects.begin() + newIndex, std::move(object));
 }
 
 void ObjectsContainer::RemoveObject(const gd::String& name) {
-  std::vector<std::unique_ptr<gd::Object> >::iterator object =
-      find_if(initialObjects.begin(),
-              initialObjects.end(),
-              bind2nd(ObjectHasName(), name));
-  if (object == initialObjects.end()) return;
+  std::size_t position = FindObject(name);
+  if (position == gd::String::npos) return;
 
-  initialObjects.erase(object);
+  objectsModificationCount++;
+  initialObjects.erase(initialObjects.begin() + position);
 }
 
 }  // namespace gd
@@ -6,6 +6,8 @@
 #ifndef GDCORE_OBJECTSCONTAINER_H
 #define GDCORE_OBJECTSCONTAINER_H
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/String.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
@@ -129,8 +131,12 @@ class GD_CORE_API ObjectsContainer {
 
   /**
    * Provide a raw access to the vector containing the objects
+   *
+   * \note Counted as a modification of the objects, as they can be modified
+   * using this access.
    */
   std::vector<std::unique_ptr<gd::Object> >& GetObjects() {
+    objectsModificationCount++;
     return initialObjects;
   }
 
@@ -140,6 +146,17 @@ class GD_CORE_API ObjectsContainer {
   const std::vector<std::unique_ptr<gd::Object> >& GetObjects() const {
     return initialObjects;
   }
+
+  /**
+   * \brief Return a number incremented each time objects are added, removed
+   * or moved in the container, or accessed with the raw (non const) access
+   * given by GetObjects.
+   *
+   * \note Changes made to the objects themselves are not counted.
+   */
+  std::size_t GetObjectsModificationCount() const {
+    return objectsModificationCount;
+  }
   ///@}
 
   /** \name Saving and loading
@@ -180,7 +197,26 @@ class GD_CORE_API ObjectsContainer {
  protected:
   std::vector<std::unique_ptr<gd::Object> >
       initialObjects;  ///< Objects contained.
+  std::size_t objectsModificationCount;  ///< Incremented each time objects
+                                         ///< are added, removed or moved.
   gd::ObjectGroupsContainer objectGroups;
+
+ private:
+  /**
+   * \brief Return the position of the first object with the name, or
+   * gd::String::npos, using an index of the objects by their names.
+   *
+   * The index is built again when objects were added, removed or moved, or
+   * when an object was renamed (see gd::Object::GetNamesModificationCount).
+   * It's protected by a mutex as the container can be read by several threads
+   * (when generating the code of layouts for example).
+   */
+  std::size_t FindObject(const gd::String& name) const;
+
+  mutable std::unordered_map<gd::String, std::size_t> objectsIndex;
+  mutable std::size_t indexedObjectsModificationCount;
+  mutable std::size_t indexedNamesModificationCount;
+  mutable std::mutex objectsIndexMutex;
 };
 
 }  // namespace gd
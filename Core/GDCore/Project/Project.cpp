@@ -9,9 +9,13 @@
 #include <stdlib.h>
 #include <SFML/System/Utf.hpp>
 #include <fstream>
+#include <functional>
+#include <list>
 #include <map>
+#include <mutex>
 #include <vector>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
 #include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
 #include "GDCore/Extensions/Platform.h"
@@ -27,13 +31,16 @@
 #include "GDCore/Project/ObjectGroupsContainer.h"
 #include "GDCore/Project/ResourcesManager.h"
 #include "GDCore/Project/SourceFile.h"
+#include "GDCore/Serialization/JsonReader.h"
 #include "GDCore/Serialization/Serializer.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/MakeUnique.h"
 #include "GDCore/Tools/PolymorphicClone.h"
+#include "GDCore/Tools/Threads.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "GDCore/Utf8/utf8.h"
 
@@ -60,6 +67,7 @@ Project::Project()
       verticalSync(false),
       scaleMode("linear"),
       sizeOnStartupMode("adaptWidth"),
+      layoutsLoadedLazily(false),
       imageManager(std::make_shared<ImageManager>())
 #if defined(GD_IDE_ONLY)
       ,
@@ -521,7 +529,8 @@ void Project::RemoveEventsFunctionsExtension(const gd::String& name) {
 }
 #endif
 
-void Project::UnserializeFrom(const SerializerElement& element) {
+void Project::UnserializeFrom(const SerializerElement& element,
+                              std::size_t threadsCount) {
 // Checking version
 #if defined(GD_IDE_ONLY)
   gd::String updateText;
@@ -764,6 +773,10 @@ void Project::UnserializeFrom(const SerializerElement& element) {
   UnserializeObjectsFrom(*this, element.GetChild("objects", 0, "Objects"));
   GetVariables().UnserializeFrom(element.GetChild("variables", 0, "Variables"));
 
+  // The layouts and the external events are only unserializing their own
+  // content (reading the platforms and the extensions): they are inserted
+  // first, then unserialized at the same time.
+  std::vector<std::function<void()> > unserializations;
   scenes.clear();
   const SerializerElement& layoutsElement =
       element.GetChild("layouts", 0, "Scenes");
@@ -773,7 +786,15 @@ void Project::UnserializeFrom(const SerializerElement& element) {
 
     gd::Layout& layout = InsertNewLayout(
         layoutElement.GetStringAttribute("name", "", "nom"), -1);
-    layout.UnserializeFrom(*this, layoutElement);
+    if (layoutsLoadedLazily) {
+      unserializations.push_back([&layout, &layoutElement]() {
+        layout.UnserializeLazilyFrom(layoutElement);
+      });
+    } else {
+      unserializations.push_back([this, &layout, &layoutElement]() {
+        layout.UnserializeFrom(*this, layoutElement);
+      });
+    }
   }
 
 #if defined(GD_IDE_ONLY)
@@ -788,9 +809,16 @@ void Project::UnserializeFrom(const SerializerElement& element) {
     gd::ExternalEvents& externalEvents = InsertNewExternalEvents(
         externalEventElement.GetStringAttribute("name", "", "Name"),
         GetExternalEventsCount());
-    externalEvents.UnserializeFrom(*this, externalEventElement);
+    unserializations.push_back(
+        [this, &externalEvents, &externalEventElement]() {
+          externalEvents.UnserializeFrom(*this, externalEventElement);
+        });
   }
+#endif
+
+  gd::CallOnThreads(unserializations, threadsCount);
 
+#if defined(GD_IDE_ONLY)
   eventsFunctionsExtensions.clear();
   const SerializerElement& eventsFunctionsExtensionsElement =
       element.GetChild("eventsFunctionsExtensions");
@@ -839,6 +867,87 @@ void Project::UnserializeFrom(const SerializerElement& element) {
 #endif
 }
 
+namespace {
+/**
+ * \brief Read an array of layouts or of external layouts into an element,
+ * except their instances which are decoded directly into containers (an
+ * empty array of instances is stored in the element).
+ */
+void UnserializeLayoutsFromJSON(
+    gd::JsonReader& reader,
+    SerializerElement& layoutsElement,
+    std::list<gd::InitialInstancesContainer>& layoutsInstances) {
+  if (reader.GetToken() != gd::JsonReader::BeginArray) {
+    reader.ReadElement(layoutsElement);
+    return;
+  }
+
+  layoutsElement.ConsiderAsArray();
+  while (reader.Next() != gd::JsonReader::EndArray) {
+    if (reader.HasError() || reader.GetToken() == gd::JsonReader::End) return;
+
+    SerializerElement& layoutElement = layoutsElement.AddChild("");
+    layoutsInstances.push_back(gd::InitialInstancesContainer());
+    if (reader.GetToken() != gd::JsonReader::BeginObject) {
+      reader.ReadElement(layoutElement);
+      continue;
+    }
+
+    while (reader.Next() == gd::JsonReader::Name) {
+      gd::String name = gd::String::FromUTF8(reader.GetString());
+      reader.Next();
+      if (name == "instances") {
+        layoutsInstances.back().UnserializeFrom(reader);
+        layoutElement.AddChild(name).ConsiderAsArray();
+      } else {
+        reader.ReadElement(layoutElement.AddChild(name));
+      }
+
+      if (reader.HasError()) return;
+    }
+  }
+}
+}  // namespace
+
+void Project::UnserializeFromJSON(const std::string& json,
+                                  std::size_t threadsCount) {
+  gd::JsonReader reader(json);
+  SerializerElement element;
+  std::list<gd::InitialInstancesContainer> layoutsInstances;
+  std::list<gd::InitialInstancesContainer> externalLayoutsInstances;
+  if (reader.Next() == gd::JsonReader::BeginObject) {
+    while (reader.Next() == gd::JsonReader::Name) {
+      gd::String name = gd::String::FromUTF8(reader.GetString());
+      reader.Next();
+      if (name == "layouts" && !layoutsLoadedLazily)
+        UnserializeLayoutsFromJSON(
+            reader, element.AddChild(name), layoutsInstances);
+      else if (name == "externalLayouts")
+        UnserializeLayoutsFromJSON(
+            reader, element.AddChild(name), externalLayoutsInstances);
+      else
+        reader.ReadElement(element.AddChild(name));
+
+      if (reader.HasError()) break;
+    }
+  }
+  if (reader.HasError()) std::cout << "Parsing error: Invalid project JSON.";
+
+  UnserializeFrom(element, threadsCount);
+
+  // The layouts were inserted in the same order as in the JSON.
+  std::size_t i = 0;
+  for (auto& instances : layoutsInstances) {
+    if (i >= GetLayoutsCount()) break;
+    GetLayout(i++).GetInitialInstances().Swap(instances);
+  }
+  i = 0;
+  for (auto& instances : externalLayoutsInstances) {
+    if (i >= GetExternalLayoutsCount()) break;
+    GetExternalLayout(i++).GetInitialInstances().Swap(instances);
+  }
+}
+
 #if defined(GD_IDE_ONLY)
 void Project::SerializeTo(SerializerElement& element) const {
   SerializerElement& versionElement = element.AddChild("gdVersion");
@@ -1036,6 +1145,16 @@ gd::SourceFile& Project::InsertNewSourceFile(const gd::String& name,
 
   return newlyInsertedSourceFile;
 }
+
+gd::ExpressionParser2Cache& Project::GetExpressionParser2Cache() const {
+  // The cache can be asked for by threads generating code at the same time.
+  static std::mutex creationMutex;
+  std::lock_guard<std::mutex> lock(creationMutex);
+  if (!expressionParser2Cache)
+    expressionParser2Cache = gd::make_unique<gd::ExpressionParser2Cache>();
+
+  return *expressionParser2Cache;
+}
 #endif
 
 Project::Project(const Project& other) { Init(other); }
@@ -1057,6 +1176,7 @@ void Project::Init(const gd::Project& game) {
   verticalSync = game.verticalSync;
   scaleMode = game.scaleMode;
   sizeOnStartupMode = game.sizeOnStartupMode;
+  layoutsLoadedLazily = game.layoutsLoadedLazily;
 
 #if defined(GD_IDE_ONLY)
   author = game.author;
@@ -1084,6 +1204,7 @@ void Project::Init(const gd::Project& game) {
   imageManager->SetResourcesManager(&resourcesManager);
 
   initialObjects = gd::Clone(game.initialObjects);
+  objectsModificationCount++;
 
   scenes = gd::Clone(game.scenes);
 
@@ -31,6 +31,7 @@ class Behavior;
 class BehaviorsSharedData;
 class BaseEvent;
 class SerializerElement;
+class ExpressionParser2Cache;
 }  // namespace gd
 #undef GetObject  // Disable an annoying macro
 #undef CreateEvent
@@ -465,12 +466,52 @@ class GD_CORE_API Project : public ObjectsContainer {
    */
   void RemoveLayout(const gd::String& name);
 
+  /**
+   * \brief Set if the layouts must be kept serialized when the project is
+   * unserialized, to be unserialized only when gd::Layout::Load is called
+   * (typically when a game starts a scene).
+   *
+   * \see gd::Layout::UnserializeLazilyFrom
+   */
+  void SetLayoutsLoadedLazily(bool enable) { layoutsLoadedLazily = enable; }
+
+  /**
+   * \brief Return true if the layouts are kept serialized when the project is
+   * unserialized.
+   */
+  bool AreLayoutsLoadedLazily() const { return layoutsLoadedLazily; }
+
   ///@}
 
   /**
    * \brief Unserialize the project from an element.
+   *
+   * \param threadsCount The number of threads unserializing the layouts and
+   * the external events, including the calling thread. Once the extensions
+   * and the global objects are known, the layouts and the external events
+   * are unserialized at the same time, then the rest of the project is
+   * unserialized by the calling thread.
+   *
+   * \note Threads are not used when compiled with Emscripten, unless built
+   * with EMSCRIPTEN_THREADS.
+   */
+  void UnserializeFrom(const SerializerElement& element,
+                       std::size_t threadsCount = 1);
+
+  /**
+   * \brief Unserialize the project from JSON, reading it with a
+   * gd::JsonReader.
+   *
+   * Same as unserializing the element returned by gd::Serializer::FromJSON,
+   * but the instances of the layouts and of the external layouts, usually the
+   * largest part of a project, are decoded directly from the JSON without
+   * building any gd::SerializerElement for them (except for the layouts if
+   * they are loaded lazily, see SetLayoutsLoadedLazily).
+   *
+   * \param threadsCount See UnserializeFrom.
    */
-  void UnserializeFrom(const SerializerElement& element);
+  void UnserializeFromJSON(const std::string& json,
+                           std::size_t threadsCount = 1);
 
 #if defined(GD_IDE_ONLY)
   /**
@@ -898,6 +939,18 @@ class GD_CORE_API Project : public ObjectsContainer {
 #endif
 ///@}
 
+#if defined(GD_IDE_ONLY)
+  /**
+   * \brief Return the cache of the trees of the expressions parsed for the
+   * project.
+   *
+   * \note The cache can be used by several threads at the same time.
+   *
+   * \see gd::ExpressionParser2Cache
+   */
+  gd::ExpressionParser2Cache& GetExpressionParser2Cache() const;
+#endif
+
 // TODO: Put this in private part
 #if defined(GD_IDE_ONLY)
   std::vector<gd::String> imagesChanged;  ///< Images that have been changed and
@@ -928,6 +981,8 @@ class GD_CORE_API Project : public ObjectsContainer {
       sizeOnStartupMode;  ///< How to adapt the game size to the screen. Can be
                           ///< "adaptWidth", "adaptHeight" or empty
   std::vector<std::unique_ptr<gd::Layout> > scenes;  ///< List of all scenes
+  bool layoutsLoadedLazily;  ///< True to keep the layouts serialized when
+                             ///< unserializing the project.
   gd::VariablesContainer variables;  ///< Initial global variables
   std::vector<std::unique_ptr<gd::ExternalLayout> >
       externalLayouts;  ///< List of all externals layouts
@@ -970,6 +1025,8 @@ class GD_CORE_API Project : public ObjectsContainer {
   mutable unsigned int gdBuildVersion;  ///< The GD build version used the last
                                         ///< time the project was saved.
   mutable bool dirty;  ///< True to flag the project as being modified.
+  mutable std::unique_ptr<gd::ExpressionParser2Cache>
+      expressionParser2Cache;  ///< Created when first used, not copied.
 #endif
 };
 
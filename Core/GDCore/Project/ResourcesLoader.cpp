@@ -7,6 +7,7 @@
 #include <utility>
 #include "GDCore/String.h"
 #include "GDCore/Tools/FileStream.h"
+#include "GDCore/Tools/KtxImage.h"
 #undef LoadImage  // Undef a macro from windows.h
 
 using namespace std;
@@ -36,6 +37,21 @@ void ResourcesLoader::LoadSFMLTexture(const gd::String &filename,
     cout << "Failed to load a SFML texture: " << filename << endl;
 }
 
+bool ResourcesLoader::LoadKtxImage(const gd::String &filename,
+                                   gd::KtxImage &image) {
+  gd::FileStream file(filename, ios::in | ios::binary | ios::ate);
+  std::streamoff size = file.is_open() ? std::streamoff(file.tellg()) : -1;
+  if (size >= 0) {
+    std::string content(static_cast<std::size_t>(size), '\0');
+    file.seekg(0, ios::beg);
+    file.read(&content[0], content.size());
+    if (image.LoadFromMemory(content.data(), content.size())) return true;
+  }
+
+  cout << "Failed to load a KTX image: " << filename << endl;
+  return false;
+}
+
 std::pair<sf::Font *, StreamHolder *> ResourcesLoader::LoadFont(
     const gd::String &filename) {
   sf::Font *font = new sf::Font();
@@ -10,6 +10,9 @@
 #include "GDCore/String.h"
 #include "GDCore/Tools/FileStream.h"
 #undef LoadImage  // Undef macro from windows.h
+namespace gd {
+class KtxImage;
+}
 
 namespace gd {
 
@@ -46,6 +49,12 @@ class GD_CORE_API ResourcesLoader {
   sf::Texture LoadSFMLTexture(const gd::String &filename);
   void LoadSFMLTexture(const gd::String &filename, sf::Texture &texture);
 
+  /**
+   * Load a texture compressed in a format of the GPU, from a KTX file.
+   * \return false if the file can't be read or is not a supported KTX file.
+   */
+  bool LoadKtxImage(const gd::String &filename, gd::KtxImage &image);
+
   /**
    * Load a SFML Font.
    * \warning The function calling LoadFont is the owner of the returned font
@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include "GDCore/CommonTools.h"
@@ -19,6 +20,19 @@ namespace gd {
 
 gd::String Resource::badStr;
 
+namespace {
+std::atomic<std::size_t> resourcesNamesModificationCount(0);
+}
+
+void Resource::SetName(const gd::String& name_) {
+  name = name_;
+  resourcesNamesModificationCount++;
+}
+
+std::size_t Resource::GetNamesModificationCount() {
+  return resourcesNamesModificationCount;
+}
+
 Resource ResourcesManager::badResource;
 #if defined(GD_IDE_ONLY)
 ResourceFolder ResourcesManager::badFolder;
@@ -37,6 +51,7 @@ void ResourceFolder::Init(const ResourceFolder& other) {
 #endif
 
 void ResourcesManager::Init(const ResourcesManager& other) {
+  resourcesModificationCount++;
   resources.clear();
   for (std::size_t i = 0; i < other.resources.size(); ++i) {
     resources.push_back(std::shared_ptr<Resource>(other.resources[i]->Clone()));
@@ -49,20 +64,33 @@ void ResourcesManager::Init(const ResourcesManager& other) {
 #endif
 }
 
-Resource& ResourcesManager::GetResource(const gd::String& name) {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return *resources[i];
+std::size_t ResourcesManager::IndexOfResource(const gd::String& name) const {
+  std::lock_guard<std::mutex> lock(resourcesIndexMutex);
+  std::size_t namesModificationCount = Resource::GetNamesModificationCount();
+  if (indexedResourcesModificationCount != resourcesModificationCount ||
+      indexedNamesModificationCount != namesModificationCount) {
+    // Iterate backward so that the first resource with a name is indexed, as
+    // returned before by the linear search.
+    resourcesIndex.clear();
+    for (std::size_t i = resources.size(); i-- > 0;)
+      resourcesIndex[resources[i]->GetName()] = i;
+
+    indexedResourcesModificationCount = resourcesModificationCount;
+    indexedNamesModificationCount = namesModificationCount;
   }
 
-  return badResource;
+  auto it = resourcesIndex.find(name);
+  return it != resourcesIndex.end() ? it->second : gd::String::npos;
 }
 
-const Resource& ResourcesManager::GetResource(const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return *resources[i];
-  }
+Resource& ResourcesManager::GetResource(const gd::String& name) {
+  std::size_t index = IndexOfResource(name);
+  return index != gd::String::npos ? *resources[index] : badResource;
+}
 
-  return badResource;
+const Resource& ResourcesManager::GetResource(const gd::String& name) const {
+  std::size_t index = IndexOfResource(name);
+  return index != gd::String::npos ? *resources[index] : badResource;
 }
 
 std::shared_ptr<Resource> ResourcesManager::CreateResource(
@@ -81,11 +109,7 @@ std::shared_ptr<Resource> ResourcesManager::CreateResource(
 }
 
 bool ResourcesManager::HasResource(const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return true;
-  }
-
-  return false;
+  return IndexOfResource(name) != gd::String::npos;
 }
 
 std::vector<gd::String> ResourcesManager::GetAllResourceNames() const {
@@ -134,6 +158,7 @@ bool ResourcesManager::AddResource(const gd::Resource& resource) {
       std::shared_ptr<Resource>(resource.Clone());
   if (newResource == std::shared_ptr<Resource>()) return false;
 
+  resourcesModificationCount++;
   resources.push_back(newResource);
   return true;
 }
@@ -147,6 +172,7 @@ bool ResourcesManager::AddResource(const gd::String& name,
   res->SetFile(filename);
   res->SetName(name);
 
+  resourcesModificationCount++;
   resources.push_back(res);
 
   return true;
@@ -224,25 +250,25 @@ bool ResourceFolder::MoveResourceDownInList(const gd::String& name) {
 }
 
 bool ResourcesManager::MoveResourceUpInList(const gd::String& name) {
+  resourcesModificationCount++;
   return gd::MoveResourceUpInList(resources, name);
 }
 
 bool ResourcesManager::MoveResourceDownInList(const gd::String& name) {
+  resourcesModificationCount++;
   return gd::MoveResourceDownInList(resources, name);
 }
 
 std::size_t ResourcesManager::GetResourcePosition(
     const gd::String& name) const {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  return IndexOfResource(name);
 }
 
 void ResourcesManager::MoveResource(std::size_t oldIndex,
                                     std::size_t newIndex) {
   if (oldIndex >= resources.size() || newIndex >= resources.size()) return;
 
+  resourcesModificationCount++;
   auto resource = resources[oldIndex];
   resources.erase(resources.begin() + oldIndex);
   resources.insert(resources.begin() + newIndex, resource);
@@ -272,11 +298,9 @@ bool ResourcesManager::MoveFolderDownInList(const gd::String& name) {
 
 std::shared_ptr<gd::Resource> ResourcesManager::GetResourceSPtr(
     const gd::String& name) {
-  for (std::size_t i = 0; i < resources.size(); ++i) {
-    if (resources[i]->GetName() == name) return resources[i];
-  }
-
-  return std::shared_ptr<gd::Resource>();
+  std::size_t index = IndexOfResource(name);
+  return index != gd::String::npos ? resources[index]
+                                   : std::shared_ptr<gd::Resource>();
 }
 
 bool ResourcesManager::HasFolder(const gd::String& name) const {
@@ -360,6 +384,7 @@ void ResourceFolder::RemoveResource(const gd::String& name) {
 }
 
 void ResourcesManager::RemoveResource(const gd::String& name) {
+  resourcesModificationCount++;
   for (std::size_t i = 0; i < resources.size();) {
     if (resources[i] != std::shared_ptr<Resource>() &&
         resources[i]->GetName() == name)
@@ -401,6 +426,7 @@ void ResourceFolder::SerializeTo(SerializerElement& element) const {
 #endif
 
 void ResourcesManager::UnserializeFrom(const SerializerElement& element) {
+  resourcesModificationCount++;
   resources.clear();
   const SerializerElement& resourcesElement =
       element.GetChild("resources", 0, "Resources");
@@ -469,6 +495,17 @@ void ImageResource::UnserializeFrom(const SerializerElement& element) {
   smooth = element.GetBoolAttribute("smoothed");
   SetUserAdded(element.GetBoolAttribute("userAdded"));
   SetFile(element.GetStringAttribute("file"));
+
+  if (element.HasChild("atlas")) {
+    const SerializerElement& atlasElement = element.GetChild("atlas");
+    SetAtlas(atlasElement.GetStringAttribute("file"),
+             atlasElement.GetIntAttribute("x"),
+             atlasElement.GetIntAttribute("y"),
+             atlasElement.GetIntAttribute("width"),
+             atlasElement.GetIntAttribute("height"));
+  } else {
+    SetAtlas("", 0, 0, 0, 0);
+  }
 }
 
 #if defined(GD_IDE_ONLY)
@@ -479,6 +516,16 @@ void ImageResource::SerializeTo(SerializerElement& element) const {
   element.SetAttribute(
       "file", GetFile());  // Keep the resource path in the current locale (but
                            // save it in UTF8 for compatibility on other OSes)
+
+  // Only set in exported games.
+  if (IsInAtlas()) {
+    SerializerElement& atlasElement = element.AddChild("atlas");
+    atlasElement.SetAttribute("file", atlasFile);
+    atlasElement.SetAttribute("x", static_cast<int>(atlasX));
+    atlasElement.SetAttribute("y", static_cast<int>(atlasY));
+    atlasElement.SetAttribute("width", static_cast<int>(atlasWidth));
+    atlasElement.SetAttribute("height", static_cast<int>(atlasHeight));
+  }
 }
 #endif
 
@@ -558,7 +605,10 @@ ResourceFolder& ResourceFolder::operator=(const ResourceFolder& other) {
 }
 #endif
 
-ResourcesManager::ResourcesManager(const ResourcesManager& other) {
+ResourcesManager::ResourcesManager(const ResourcesManager& other)
+    : resourcesModificationCount(0),
+      indexedResourcesModificationCount(gd::String::npos),
+      indexedNamesModificationCount(gd::String::npos) {
   Init(other);
 }
 
@@ -568,9 +618,10 @@ ResourcesManager& ResourcesManager::operator=(const ResourcesManager& other) {
   return *this;
 }
 
-ResourcesManager::ResourcesManager() {
-  // ctor
-}
+ResourcesManager::ResourcesManager()
+    : resourcesModificationCount(0),
+      indexedResourcesModificationCount(gd::String::npos),
+      indexedNamesModificationCount(gd::String::npos) {}
 
 ResourcesManager::~ResourcesManager() {
   // dtor
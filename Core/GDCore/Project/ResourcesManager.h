@@ -6,6 +6,8 @@
 #ifndef GDCORE_RESOURCESMANAGER_H
 #define GDCORE_RESOURCESMANAGER_H
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/String.h"
 namespace gd {
@@ -30,12 +32,20 @@ class GD_CORE_API Resource {
 
   /** \brief Change the name of the resource with the name passed as parameter.
    */
-  virtual void SetName(const gd::String& name_) { name = name_; }
+  virtual void SetName(const gd::String& name_);
 
   /** \brief Return the name of the resource.
    */
   virtual const gd::String& GetName() const { return name; }
 
+  /**
+   * \brief Return a number incremented each time the name of a resource (any
+   * resource) is changed.
+   *
+   * \see gd::ResourcesManager::GetResource
+   */
+  static std::size_t GetNamesModificationCount();
+
   /** \brief Change the kind of the resource
    */
   virtual void SetKind(const gd::String& newKind) { kind = newKind; }
@@ -154,7 +164,14 @@ class GD_CORE_API Resource {
  */
 class GD_CORE_API ImageResource : public Resource {
  public:
-  ImageResource() : Resource(), smooth(true), alwaysLoaded(false) {
+  ImageResource()
+      : Resource(),
+        smooth(true),
+        alwaysLoaded(false),
+        atlasX(0),
+        atlasY(0),
+        atlasWidth(0),
+        atlasHeight(0) {
     SetKind("image");
   };
   virtual ~ImageResource(){};
@@ -202,10 +219,54 @@ class GD_CORE_API ImageResource : public Resource {
    */
   void SetSmooth(bool enable = true) { smooth = enable; }
 
+  /** \name Texture atlas
+   * Images can be packed in texture atlases when a game is exported (see
+   * gd::ProjectImagesPacker). The image is then the part of the atlas given by
+   * these members.
+   */
+  ///@{
+  /**
+   * \brief Return true if the image is packed in an atlas.
+   */
+  bool IsInAtlas() const { return !atlasFile.empty(); }
+
+  /**
+   * \brief Return the file of the atlas containing the image, or an empty
+   * string if the image is not packed in an atlas.
+   */
+  const gd::String& GetAtlasFile() const { return atlasFile; }
+
+  /**
+   * \brief Set the atlas containing the image, and the part of the atlas
+   * where the image is.
+   */
+  void SetAtlas(const gd::String& atlasFile_,
+                unsigned int x,
+                unsigned int y,
+                unsigned int width,
+                unsigned int height) {
+    atlasFile = atlasFile_;
+    atlasX = x;
+    atlasY = y;
+    atlasWidth = width;
+    atlasHeight = height;
+  }
+
+  unsigned int GetAtlasX() const { return atlasX; }
+  unsigned int GetAtlasY() const { return atlasY; }
+  unsigned int GetAtlasWidth() const { return atlasWidth; }
+  unsigned int GetAtlasHeight() const { return atlasHeight; }
+  ///@}
+
   bool smooth;        ///< True if smoothing filter is applied
   bool alwaysLoaded;  ///< True if the image must always be loaded in memory.
  private:
   gd::String file;
+  gd::String atlasFile;  ///< The atlas containing the image, if any.
+  unsigned int atlasX;
+  unsigned int atlasY;
+  unsigned int atlasWidth;
+  unsigned int atlasHeight;
 };
 
 /**
@@ -432,7 +493,25 @@ class GD_CORE_API ResourcesManager {
  private:
   void Init(const ResourcesManager& other);
 
+  /**
+   * \brief Return the position of the first resource with the name, or
+   * gd::String::npos, using an index of the resources by their names.
+   *
+   * The index is built again when resources were added, removed or moved, or
+   * when a resource was renamed (see gd::Resource::GetNamesModificationCount).
+   * It's protected by a mutex as resources can be read by several threads
+   * (when exporting a game for example).
+   */
+  std::size_t IndexOfResource(const gd::String& name) const;
+
   std::vector<std::shared_ptr<Resource> > resources;
+  std::size_t resourcesModificationCount;  ///< Incremented each time
+                                           ///< resources are added, removed
+                                           ///< or moved.
+  mutable std::unordered_map<gd::String, std::size_t> resourcesIndex;
+  mutable std::size_t indexedResourcesModificationCount;
+  mutable std::size_t indexedNamesModificationCount;
+  mutable std::mutex resourcesIndexMutex;
 #if defined(GD_IDE_ONLY)
   std::vector<ResourceFolder> folders;
 #endif
@@ -5,7 +5,11 @@
  */
 
 #include "GDCore/Project/Variable.h"
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 #include "GDCore/TinyXml/tinyxml.h"
@@ -14,33 +18,92 @@ using namespace std;
 
 namespace gd {
 
+namespace {
+/**
+ * \brief Read the number at the beginning of the string, as it would be read
+ * from a stream: leading spaces are skipped and 0 is returned if the string
+ * does not start with a number.
+ */
+double StringToNumber(const gd::String& str) {
+  const char* position = str.Raw().c_str();
+  while (std::isspace(static_cast<unsigned char>(*position))) position++;
+
+  // Hexadecimal numbers, infinity and NaN are not read by streams.
+  const char* digits = position;
+  if (*digits == '+' || *digits == '-') digits++;
+  if (!std::isdigit(static_cast<unsigned char>(*digits)) && *digits != '.')
+    return 0;
+  if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) return 0;
+
+  return std::strtod(position, NULL);
+}
+
+/**
+ * \brief Write the number with the same format as a stream (6 significant
+ * digits).
+ */
+gd::String NumberToString(double number) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%g", number);
+  return buffer;
+}
+
+std::atomic<std::size_t> lastStructureVersion(0);
+}  // namespace
+
+std::size_t Variable::NewStructureVersion() {
+  return ++lastStructureVersion;
+}
+
 /**
  * Get value as a double
  */
 double Variable::GetValue() const {
-  if (!isNumber) {
-    stringstream ss;
-    ss << str;
-    ss >> value;
-    isNumber = true;
+  if (!isValueUpToDate) {
+    value = StringToNumber(str);
+    isValueUpToDate = true;
   }
+  isNumber = true;
 
   return value;
 }
 
 const gd::String& Variable::GetString() const {
-  if (isNumber) {
-    stringstream s;
-    s << (value);
-    str = s.str();
-    isNumber = false;
+  if (!isStringUpToDate) {
+    str = NumberToString(value);
+    isStringUpToDate = true;
   }
+  isNumber = false;
 
   return str;
 }
 
+Variable::ChildrenList::iterator Variable::FindChildPosition(
+    const gd::String& name) const {
+  return std::lower_bound(
+      children.begin(),
+      children.end(),
+      name,
+      [](const ChildrenList::value_type& child, const gd::String& name) {
+        return child.first < name;
+      });
+}
+
+void Variable::SetChild(const gd::String& name,
+                        std::shared_ptr<Variable> child) {
+  auto it = FindChildPosition(name);
+  if (it != children.end() && it->first == name) {
+    it->second = std::move(child);
+    structureVersion = NewStructureVersion();
+  } else
+    children.emplace(it, name, std::move(child));
+}
+
 bool Variable::HasChild(const gd::String& name) const {
-  return isStructure && children.find(name) != children.end();
+  if (!isStructure) return false;
+
+  auto it = FindChildPosition(name);
+  return it != children.end() && it->first == name;
 }
 
 /**
@@ -50,12 +113,12 @@ bool Variable::HasChild(const gd::String& name) const {
  * the specified child, an empty variable is returned.
  */
 Variable& Variable::GetChild(const gd::String& name) {
-  auto it = children.find(name);
-  if (it != children.end()) return *it->second;
+  auto it = FindChildPosition(name);
+  if (it != children.end() && it->first == name) return *it->second;
 
   isStructure = true;
-  children[name] = std::make_shared<gd::Variable>();
-  return *children[name];
+  return *children.emplace(it, name, std::make_shared<gd::Variable>())
+              ->second;
 }
 
 /**
@@ -65,25 +128,33 @@ Variable& Variable::GetChild(const gd::String& name) {
  * the specified child, an empty variable is returned.
  */
 const Variable& Variable::GetChild(const gd::String& name) const {
-  auto it = children.find(name);
-  if (it != children.end()) return *it->second;
+  auto it = FindChildPosition(name);
+  if (it != children.end() && it->first == name) return *it->second;
 
   isStructure = true;
-  children[name] = std::make_shared<gd::Variable>();
-  return *children[name];
+  return *children.emplace(it, name, std::make_shared<gd::Variable>())
+              ->second;
 }
 
 void Variable::RemoveChild(const gd::String& name) {
   if (!isStructure) return;
-  children.erase(name);
+
+  auto it = FindChildPosition(name);
+  if (it != children.end() && it->first == name) {
+    children.erase(it);
+    structureVersion = NewStructureVersion();
+  }
 }
 
 bool Variable::RenameChild(const gd::String& oldName,
                            const gd::String& newName) {
   if (!isStructure || !HasChild(oldName) || HasChild(newName)) return false;
 
-  children[newName] = children[oldName];
-  children.erase(oldName);
+  auto it = FindChildPosition(oldName);
+  std::shared_ptr<Variable> child = std::move(it->second);
+  children.erase(it);
+  SetChild(newName, std::move(child));
+  structureVersion = NewStructureVersion();
 
   return true;
 }
@@ -91,6 +162,7 @@ bool Variable::RenameChild(const gd::String& oldName,
 void Variable::ClearChildren() {
   if (!isStructure) return;
   children.clear();
+  structureVersion = NewStructureVersion();
 }
 
 void Variable::SerializeTo(SerializerElement& element) const {
@@ -117,8 +189,9 @@ void Variable::UnserializeFrom(const SerializerElement& element) {
     for (int i = 0; i < childrenElement.GetChildrenCount(); ++i) {
       const SerializerElement& childElement = childrenElement.GetChild(i);
       gd::String name = childElement.GetStringAttribute("name", "", "Name");
-      children[name] = std::make_shared<gd::Variable>();
-      children[name]->UnserializeFrom(childElement);
+      auto child = std::make_shared<gd::Variable>();
+      child->UnserializeFrom(childElement);
+      SetChild(name, std::move(child));
     }
   } else
     SetString(element.GetStringAttribute("value", "", "Value"));
@@ -153,8 +226,9 @@ void Variable::LoadFromXml(const TiXmlElement* element) {
     while (child) {
       gd::String name =
           child->Attribute("Name") ? child->Attribute("Name") : "";
-      children[name] = std::make_shared<gd::Variable>();
-      children[name]->LoadFromXml(child);
+      auto childVariable = std::make_shared<gd::Variable>();
+      childVariable->LoadFromXml(child);
+      SetChild(name, std::move(childVariable));
 
       child = child->NextSiblingElement();
     }
@@ -185,6 +259,7 @@ void Variable::RemoveRecursively(const gd::Variable& variableToRemove) {
   for (auto it = children.begin(); it != children.end();) {
     if (it->second.get() == &variableToRemove) {
       it = children.erase(it);
+      structureVersion = NewStructureVersion();
     } else {
       it->second->RemoveRecursively(variableToRemove);
       it++;
@@ -196,7 +271,10 @@ Variable::Variable(const Variable& other)
     : value(other.value),
       str(other.str),
       isNumber(other.isNumber),
-      isStructure(other.isStructure) {
+      isValueUpToDate(other.isValueUpToDate),
+      isStringUpToDate(other.isStringUpToDate),
+      isStructure(other.isStructure),
+      structureVersion(NewStructureVersion()) {
   CopyChildren(other);
 }
 
@@ -205,6 +283,8 @@ Variable& Variable::operator=(const Variable& other) {
     value = other.value;
     str = other.str;
     isNumber = other.isNumber;
+    isValueUpToDate = other.isValueUpToDate;
+    isStringUpToDate = other.isStringUpToDate;
     isStructure = other.isStructure;
     CopyChildren(other);
   }
@@ -213,9 +293,12 @@ Variable& Variable::operator=(const Variable& other) {
 }
 
 void Variable::CopyChildren(const gd::Variable& other) {
+  // Children of the other variable are already sorted.
   children.clear();
+  structureVersion = NewStructureVersion();
+  children.reserve(other.children.size());
   for (auto& it : other.children) {
-    children[it.first] = std::make_shared<gd::Variable>(*it.second);
+    children.emplace_back(it.first, std::make_shared<gd::Variable>(*it.second));
   }
 }
 }  // namespace gd
@@ -8,6 +8,8 @@
 #define GDCORE_VARIABLE_H
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "GDCore/String.h"
 namespace gd {
 class SerializerElement;
@@ -26,10 +28,22 @@ namespace gd {
  */
 class GD_CORE_API Variable {
  public:
+  /**
+   * \brief The children of a structure, sorted by name.
+   */
+  typedef std::vector<std::pair<gd::String, std::shared_ptr<Variable>>>
+      ChildrenList;
+
   /**
    * \brief Default constructor creating a variable with 0 as value.
    */
-  Variable() : value(0), isNumber(true), isStructure(false){};
+  Variable()
+      : value(0),
+        isNumber(true),
+        isValueUpToDate(true),
+        isStringUpToDate(false),
+        isStructure(false),
+        structureVersion(NewStructureVersion()){};
   Variable(const Variable&);
   virtual ~Variable(){};
 
@@ -52,6 +66,25 @@ class GD_CORE_API Variable {
   void SetString(const gd::String& newStr) {
     str = newStr;
     isNumber = false;
+    isValueUpToDate = false;
+    isStringUpToDate = true;
+    isStructure = false;
+  }
+
+  /**
+   * \brief Append \a val to the content of the variable, considered as a
+   * string.
+   *
+   * The string is modified in place (its capacity growing geometrically), so
+   * that appending in a loop is not copying the whole content each time.
+   * A number is only converted to a string at the first append.
+   */
+  void AppendString(const gd::String& val) {
+    GetString();
+    str += val;
+    isNumber = false;
+    isValueUpToDate = false;
+    isStringUpToDate = true;
     isStructure = false;
   }
 
@@ -66,6 +99,8 @@ class GD_CORE_API Variable {
   void SetValue(double val) {
     value = val;
     isNumber = true;
+    isValueUpToDate = true;
+    isStringUpToDate = false;
     isStructure = false;
   }
 
@@ -87,7 +122,7 @@ class GD_CORE_API Variable {
   // Operators are overloaded to allow accessing to variable using a simple
   // string-like semantic.
   void operator=(const gd::String& val) { SetString(val); };
-  void operator+=(const gd::String& val) { SetString(GetString() + val); }
+  void operator+=(const gd::String& val) { AppendString(val); }
 
   bool operator==(const gd::String& val) const { return GetString() == val; };
   bool operator!=(const gd::String& val) const { return GetString() != val; };
@@ -165,12 +200,9 @@ class GD_CORE_API Variable {
   std::vector<gd::String> GetAllChildrenNames() const;
 
   /**
-   * \brief Get the map containing all the children.
+   * \brief Get all the children, sorted by name.
    */
-  const std::map<gd::String, std::shared_ptr<Variable>>& GetAllChildren()
-      const {
-    return children;
-  }
+  const ChildrenList& GetAllChildren() const { return children; }
 
   /**
    * \brief Search if a variable is part of the children, optionally recursively
@@ -181,6 +213,19 @@ class GD_CORE_API Variable {
    * \brief Remove the specified variable if it can be found in the children
    */
   void RemoveRecursively(const gd::Variable& variableToRemove);
+
+  /**
+   * \brief Return a number changed each time a child is removed, renamed or
+   * replaced.
+   *
+   * As long as the number is the same, the children returned by GetChild are
+   * still children of the variable, so that a pointer to them can be kept
+   * instead of searching them again.
+   *
+   * \note The numbers are unique for all variables: a variable created at the
+   * address of a destroyed one has a different number.
+   */
+  std::size_t GetStructureVersion() const { return structureVersion; }
   ///@}
 
   /** \name Serialization
@@ -212,11 +257,34 @@ class GD_CORE_API Variable {
   mutable double value;
   mutable gd::String str;
   mutable bool isNumber;     ///< True if the type of the variable is a number.
+  mutable bool isValueUpToDate;   ///< True if value is the content of the
+                                  ///< variable, converted if necessary.
+  mutable bool isStringUpToDate;  ///< True if str is the content of the
+                                  ///< variable, converted if necessary.
   mutable bool isStructure;  ///< False when the variable is a primitive ( i.e:
                              ///< Number or String ), true when it is a
                              ///< structure and has may have children.
-  mutable std::map<gd::String, std::shared_ptr<Variable>>
-      children;  ///< Children, when the variable is considered as a structure.
+  mutable ChildrenList children;  ///< Children, when the variable is
+                                 ///< considered as a structure. Stored in a
+                                 ///< vector (rather than a map) to avoid an
+                                 ///< allocation for each child.
+  std::size_t structureVersion;  ///< See GetStructureVersion.
+
+  /**
+   * Return a new number, never returned before, for GetStructureVersion.
+   */
+  static std::size_t NewStructureVersion();
+
+  /**
+   * Return the position of the child with the specified name, or the
+   * position where it would be inserted.
+   */
+  ChildrenList::iterator FindChildPosition(const gd::String& name) const;
+
+  /**
+   * Set the child with the specified name, replacing any existing child.
+   */
+  void SetChild(const gd::String& name, std::shared_ptr<Variable> child);
 
   /**
    * Initialize children by copying them from another variable.  Used by
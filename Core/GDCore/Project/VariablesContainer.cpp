@@ -32,7 +32,7 @@ class VariableHasName {
 };
 }  // namespace
 
-VariablesContainer::VariablesContainer() {}
+VariablesContainer::VariablesContainer() : modificationCount(0) {}
 
 bool VariablesContainer::Has(const gd::String& name) const {
   auto i =
@@ -77,6 +77,7 @@ const gd::String& VariablesContainer::GetNameAt(std::size_t index) const {
 Variable& VariablesContainer::Insert(const gd::String& name,
                                      const gd::Variable& variable,
                                      std::size_t position) {
+  modificationCount++;
   auto newVariable = std::make_shared<gd::Variable>(variable);
   if (position < variables.size()) {
     variables.insert(variables.begin() + position,
@@ -90,14 +91,17 @@ Variable& VariablesContainer::Insert(const gd::String& name,
 
 #if defined(GD_IDE_ONLY)
 void VariablesContainer::Remove(const gd::String& varName) {
-  variables.erase(
-      std::remove_if(
-          variables.begin(), variables.end(), VariableHasName(varName)),
-      variables.end());
+  auto removedVariables = std::remove_if(
+      variables.begin(), variables.end(), VariableHasName(varName));
+  if (removedVariables == variables.end()) return;
+
+  modificationCount++;
+  variables.erase(removedVariables, variables.end());
 }
 
 void VariablesContainer::RemoveRecursively(
     const gd::Variable& variableToRemove) {
+  modificationCount++;
   variables.erase(
       std::remove_if(
           variables.begin(),
@@ -134,7 +138,10 @@ bool VariablesContainer::Rename(const gd::String& oldName,
 
   auto i = std::find_if(
       variables.begin(), variables.end(), VariableHasName(oldName));
-  if (i != variables.end()) i->first = newName;
+  if (i != variables.end()) {
+    i->first = newName;
+    modificationCount++;
+  }
 
   return true;
 }
@@ -145,6 +152,7 @@ void VariablesContainer::Swap(std::size_t firstVariableIndex,
       secondVariableIndex >= variables.size())
     return;
 
+  modificationCount++;
   auto temp = variables[firstVariableIndex];
   variables[firstVariableIndex] = variables[secondVariableIndex];
   variables[secondVariableIndex] = temp;
@@ -153,6 +161,7 @@ void VariablesContainer::Swap(std::size_t firstVariableIndex,
 void VariablesContainer::Move(std::size_t oldIndex, std::size_t newIndex) {
   if (oldIndex >= variables.size() || newIndex >= variables.size()) return;
 
+  modificationCount++;
   auto nameAndVariable = variables[oldIndex];
   variables.erase(variables.begin() + oldIndex);
   variables.insert(variables.begin() + newIndex, nameAndVariable);
@@ -181,7 +190,8 @@ void VariablesContainer::UnserializeFrom(const SerializerElement& element) {
   }
 }
 
-VariablesContainer::VariablesContainer(const VariablesContainer& other) {
+VariablesContainer::VariablesContainer(const VariablesContainer& other)
+    : modificationCount(0) {
   Init(other);
 }
 
@@ -193,6 +203,7 @@ VariablesContainer& VariablesContainer::operator=(
 }
 
 void VariablesContainer::Init(const gd::VariablesContainer& other) {
+  modificationCount++;
   variables.clear();
   for (auto& it : other.variables) {
     variables.push_back(
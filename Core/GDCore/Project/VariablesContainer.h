@@ -136,7 +136,18 @@ class GD_CORE_API VariablesContainer {
   /**
    * \brief Clear all variables of the container.
    */
-  inline void Clear() { variables.clear(); }
+  inline void Clear() {
+    variables.clear();
+    modificationCount++;
+  }
+
+  /**
+   * \brief Return a number incremented each time variables are added, removed,
+   * renamed or moved in the container.
+   *
+   * \note Changes made to the variables themselves are not counted.
+   */
+  std::size_t GetModificationCount() const { return modificationCount; }
   ///@}
 
   /** \name Saving and loading
@@ -156,6 +167,8 @@ class GD_CORE_API VariablesContainer {
 
  private:
   std::vector<std::pair<gd::String, std::shared_ptr<gd::Variable>>> variables;
+  std::size_t modificationCount;  ///< Incremented each time the container is
+                                  ///< modified.
   static gd::Variable badVariable;
   static gd::String badName;
 
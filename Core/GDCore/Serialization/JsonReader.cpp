@@ -0,0 +1,299 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/JsonReader.h"
+#include <cstdlib>
+#include <cstring>
+#include "GDCore/Serialization/SerializerElement.h"
+
+namespace gd {
+
+JsonReader::JsonReader(const char* data, std::size_t size)
+    : position(data),
+      end(data + size),
+      token(End),
+      expectName(false),
+      numberValue(0),
+      boolValue(false) {}
+
+JsonReader::JsonReader(const std::string& json)
+    : position(json.data()),
+      end(json.data() + json.size()),
+      token(End),
+      expectName(false),
+      numberValue(0),
+      boolValue(false) {}
+
+JsonReader::Token JsonReader::Next() {
+  if (token == Error) return Error;
+
+  // Separators are skipped like blanks: the structure is given by the
+  // brackets and by the names of the members.
+  while (position < end && (*position == ' ' || *position == '\n' ||
+                            *position == '\r' || *position == '\t' ||
+                            *position == ',' || *position == ':'))
+    position++;
+
+  if (position >= end) {
+    token = containers.empty() ? End : Error;
+    return token;
+  }
+
+  char c = *position;
+  bool inObject = !containers.empty() && containers.back() == 'o';
+  if (c == '}' || c == ']') {
+    char container = c == '}' ? 'o' : 'a';
+    if (containers.empty() || containers.back() != container) {
+      SetError();
+      return token;
+    }
+
+    position++;
+    containers.pop_back();
+    token = c == '}' ? EndObject : EndArray;
+    expectName = !containers.empty() && containers.back() == 'o';
+    return token;
+  }
+
+  if (c == '"' && inObject && expectName) {
+    ReadStringToken();
+    if (token != Error) token = Name;
+    expectName = false;
+    return token;
+  }
+  if (inObject && expectName) {  // A member without a name.
+    SetError();
+    return token;
+  }
+
+  if (c == '{' || c == '[') {
+    position++;
+    containers.push_back(c == '{' ? 'o' : 'a');
+    token = c == '{' ? BeginObject : BeginArray;
+    expectName = c == '{';
+    return token;
+  }
+
+  if (c == '"')
+    ReadStringToken();
+  else if (c == 't' || c == 'f' || c == 'n')
+    ReadLiteralToken();
+  else
+    ReadNumberToken();
+
+  expectName = inObject;
+  return token;
+}
+
+void JsonReader::ReadStringToken() {
+  position++;  // Skip the opening quote.
+  stringValue.clear();
+
+  while (position < end) {
+    // Copy the characters up to the next quote or escape sequence at once.
+    const char* runEnd = position;
+    while (runEnd < end && *runEnd != '"' && *runEnd != '\\') runEnd++;
+    stringValue.append(position, runEnd);
+    position = runEnd;
+    if (position >= end) break;
+
+    if (*position == '"') {
+      position++;
+      token = String;
+      return;
+    }
+
+    position++;  // Skip the backslash.
+    if (position >= end) break;
+
+    char escaped = *(position++);
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/':
+        stringValue.push_back(escaped);
+        break;
+      case 'b':
+        stringValue.push_back('\b');
+        break;
+      case 'f':
+        stringValue.push_back('\f');
+        break;
+      case 'n':
+        stringValue.push_back('\n');
+        break;
+      case 'r':
+        stringValue.push_back('\r');
+        break;
+      case 't':
+        stringValue.push_back('\t');
+        break;
+      case 'u': {
+        unsigned int codePoint = 0;
+        if (!ReadHex4(codePoint)) {
+          SetError();
+          return;
+        }
+
+        // Combine the surrogate pairs, used for the characters outside of the
+        // basic multilingual plane.
+        unsigned int lowSurrogate = 0;
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && end - position >= 6 &&
+            position[0] == '\\' && position[1] == 'u') {
+          const char* highSurrogateEnd = position;
+          position += 2;
+          if (ReadHex4(lowSurrogate) && lowSurrogate >= 0xDC00 &&
+              lowSurrogate <= 0xDFFF)
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                        (lowSurrogate - 0xDC00);
+          else
+            position = highSurrogateEnd;
+        }
+
+        AppendCodePoint(codePoint);
+      } break;
+      default:  // Unknown escape sequences are kept as is.
+        stringValue.push_back('\\');
+        stringValue.push_back(escaped);
+        break;
+    }
+  }
+
+  SetError();  // The string is not terminated.
+}
+
+bool JsonReader::ReadHex4(unsigned int& codePoint) {
+  if (end - position < 4) return false;
+
+  codePoint = 0;
+  for (int i = 0; i < 4; ++i) {
+    char c = *(position++);
+    codePoint <<= 4;
+    if (c >= '0' && c <= '9')
+      codePoint |= c - '0';
+    else if (c >= 'a' && c <= 'f')
+      codePoint |= c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      codePoint |= c - 'A' + 10;
+    else
+      return false;
+  }
+
+  return true;
+}
+
+void JsonReader::AppendCodePoint(unsigned int codePoint) {
+  if (codePoint < 0x80) {
+    stringValue.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    stringValue.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    stringValue.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    stringValue.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+void JsonReader::ReadLiteralToken() {
+  const char* literals[] = {"true", "false", "null"};
+  const Token literalsTokens[] = {Boolean, Boolean, Null};
+  for (int i = 0; i < 3; ++i) {
+    std::size_t length = std::strlen(literals[i]);
+    if (static_cast<std::size_t>(end - position) >= length &&
+        std::strncmp(position, literals[i], length) == 0) {
+      position += length;
+      token = literalsTokens[i];
+      boolValue = i == 0;
+      return;
+    }
+  }
+
+  SetError();
+}
+
+void JsonReader::ReadNumberToken() {
+  // Copy the number so that it is null terminated for strtod (the JSON can be
+  // a buffer without a terminating null character).
+  char buffer[64];
+  std::size_t length = 0;
+  while (position < end && length < sizeof(buffer) - 1 &&
+         ((*position >= '0' && *position <= '9') || *position == '-' ||
+          *position == '+' || *position == '.' || *position == 'e' ||
+          *position == 'E'))
+    buffer[length++] = *(position++);
+  buffer[length] = '\0';
+
+  char* numberEnd = NULL;
+  numberValue = std::strtod(buffer, &numberEnd);
+  if (length == 0 || numberEnd != buffer + length)
+    SetError();
+  else
+    token = Number;
+}
+
+SerializerValue JsonReader::GetValue() const {
+  if (token == String)
+    return SerializerValue(gd::String::FromUTF8(stringValue).ReplaceInvalid());
+  else if (token == Number)
+    return SerializerValue(numberValue);
+  else if (token == Boolean)
+    return SerializerValue(boolValue);
+  else if (token == Null)
+    return SerializerValue(0.0);  // As read by gd::Serializer::FromJSON.
+
+  return SerializerValue();
+}
+
+void JsonReader::SkipValue() {
+  if (token != BeginObject && token != BeginArray) return;
+
+  std::size_t depth = containers.size();
+  while (containers.size() >= depth) {
+    Token skippedToken = Next();
+    if (skippedToken == End) SetError();
+    if (token == Error) return;
+  }
+}
+
+void JsonReader::ReadElement(SerializerElement& element) {
+  if (token == BeginObject) {
+    while (Next() == Name) {
+      gd::String name = gd::String::FromUTF8(stringValue).ReplaceInvalid();
+      Next();
+      ReadElement(element.AddChild(name));
+      if (token == Error) return;
+    }
+
+    if (token != EndObject) SetError();
+  } else if (token == BeginArray) {
+    element.ConsiderAsArray();
+    while (Next() != EndArray) {
+      if (token == Error || token == End) {
+        SetError();
+        return;
+      }
+
+      ReadElement(element.AddChild(""));
+      if (token == Error) return;
+    }
+  } else if (token == String || token == Number || token == Boolean ||
+             token == Null) {
+    element.SetValue(GetValue());
+  } else {
+    SetError();
+  }
+}
+
+}  // namespace gd
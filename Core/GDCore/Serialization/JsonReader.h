@@ -0,0 +1,126 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_JSONREADER_H
+#define GDCORE_JSONREADER_H
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "GDCore/Serialization/SerializerValue.h"
+namespace gd {
+class SerializerElement;
+}
+
+namespace gd {
+
+/**
+ * \brief A streaming ("pull") JSON reader, reading the tokens one by one.
+ *
+ * Unlike gd::Serializer::FromJSON, the reader does not build a
+ * gd::SerializerElement tree of the whole JSON: classes can read their members
+ * directly from the tokens, and only materialize the parts they need with
+ * ReadElement. The JSON is not copied: it must stay alive while it's read.
+ *
+ * Typical usage, to read an object:
+ * \code
+ * gd::JsonReader reader(json);
+ * if (reader.Next() == gd::JsonReader::BeginObject) {
+ *   while (reader.Next() == gd::JsonReader::Name) {
+ *     std::string name = reader.GetString();
+ *     reader.Next();  // Move to the value of the member.
+ *     if (name == "x")
+ *       x = reader.GetValue().GetDouble();
+ *     else
+ *       reader.SkipValue();
+ *   }
+ * }
+ * \endcode
+ *
+ * \see gd::Serializer
+ */
+class GD_CORE_API JsonReader {
+ public:
+  /**
+   * \brief The tokens of a JSON.
+   */
+  enum Token {
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+    Name,  ///< The name of a member of an object (see GetString).
+    String,
+    Number,
+    Boolean,
+    Null,
+    End,   ///< The end of the JSON was reached.
+    Error  ///< The JSON is invalid. Next will always return Error.
+  };
+
+  JsonReader(const char* data, std::size_t size);
+  JsonReader(const std::string& json);
+  virtual ~JsonReader(){};
+
+  /**
+   * \brief Read the next token.
+   */
+  Token Next();
+
+  /**
+   * \brief Return the last token read by Next.
+   */
+  Token GetToken() const { return token; }
+
+  /**
+   * \brief Return true if the JSON was found to be invalid.
+   */
+  bool HasError() const { return token == Error; }
+
+  /**
+   * \brief Get the decoded UTF8 content of the current Name or String token.
+   */
+  const std::string& GetString() const { return stringValue; }
+
+  /**
+   * \brief Get the value of the current String, Number, Boolean or Null
+   * token, with the same type as it would have in an element read by
+   * gd::Serializer::FromJSON.
+   */
+  SerializerValue GetValue() const;
+
+  /**
+   * \brief Skip the value starting at the current token (the whole object or
+   * array if the current token is BeginObject or BeginArray).
+   */
+  void SkipValue();
+
+  /**
+   * \brief Read the value starting at the current token into the element, as
+   * gd::Serializer::FromJSON would do.
+   */
+  void ReadElement(SerializerElement& element);
+
+ private:
+  void SetError() { token = Error; }
+  void ReadStringToken();
+  void ReadLiteralToken();
+  void ReadNumberToken();
+  void AppendCodePoint(unsigned int codePoint);
+  bool ReadHex4(unsigned int& codePoint);
+
+  const char* position;
+  const char* end;
+  Token token;
+  std::vector<char> containers;  ///< 'o' for objects, 'a' for arrays.
+  bool expectName;  ///< True if the next string is the name of a member.
+  std::string stringValue;
+  double numberValue;
+  bool boolValue;
+};
+
+}  // namespace gd
+
+#endif
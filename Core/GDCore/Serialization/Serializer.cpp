@@ -5,13 +5,17 @@
  */
 
 #include "GDCore/Serialization/Serializer.h"
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Serialization/XmlReader.h"
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
 #endif
@@ -23,12 +27,9 @@ void Serializer::ToXML(SerializerElement& element, TiXmlElement* xmlElement) {
   if (!xmlElement) return;
 
   if (element.IsValueUndefined()) {
-    const std::map<gd::String, SerializerValue>& attributes =
+    const std::vector<std::pair<gd::String, SerializerValue> >& attributes =
         element.GetAllAttributes();
-    for (std::map<gd::String, SerializerValue>::const_iterator it =
-             attributes.begin();
-         it != attributes.end();
-         ++it) {
+    for (auto it = attributes.begin(); it != attributes.end(); ++it) {
       const SerializerValue& attr = it->second;
 
       if (attr.IsBoolean())
@@ -44,12 +45,9 @@ void Serializer::ToXML(SerializerElement& element, TiXmlElement* xmlElement) {
         xmlElement->SetAttribute(it->first.c_str(), attr.GetString().c_str());
     }
 
-    const std::vector<
-        std::pair<gd::String, std::shared_ptr<SerializerElement> > >& children =
+    const std::vector<std::pair<gd::String, SerializerElement*> >& children =
         element.GetAllChildren();
     for (size_t i = 0; i < children.size(); ++i) {
-      if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
       TiXmlElement* xmlChild = new TiXmlElement(children[i].first.c_str());
       xmlElement->LinkEndChild(xmlChild);
       ToXML(*children[i].second, xmlChild);
@@ -95,6 +93,16 @@ void Serializer::FromXML(SerializerElement& element,
 }
 #endif
 
+bool Serializer::FromXML(SerializerElement& element,
+                         const char* data,
+                         std::size_t size) {
+  XmlReader reader(data, size);
+  if (reader.Next() != XmlReader::BeginElement) return false;
+
+  reader.ReadElement(element);
+  return !reader.HasError();
+}
+
 namespace {
 
 /**
@@ -208,12 +216,9 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
             << std::endl;
       }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
+      const std::vector<std::pair<gd::String, SerializerElement*> >&
           children = element.GetAllChildren();
       for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
         if (children[i].first != element.ConsideredAsArrayOf()) {
           std::cout
               << "WARNING: A SerializerElement is considered as an array of "
@@ -237,12 +242,9 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
       gd::String str = "{";
       bool firstChild = true;
 
-      const std::map<gd::String, SerializerValue>& attributes =
+      const std::vector<std::pair<gd::String, SerializerValue> >& attributes =
           element.GetAllAttributes();
-      for (std::map<gd::String, SerializerValue>::const_iterator it =
-               attributes.begin();
-           it != attributes.end();
-           ++it) {
+      for (auto it = attributes.begin(); it != attributes.end(); ++it) {
         if (!firstChild) str += ",";
         str += StringToQuotedJSONString(it->first.c_str()) + ": " +
                ValueToJSON(it->second);
@@ -250,12 +252,9 @@ gd::String Serializer::ToJSON(const SerializerElement& element) {
         firstChild = false;
       }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
+      const std::vector<std::pair<gd::String, SerializerElement*> >&
           children = element.GetAllChildren();
       for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
 
         if (!firstChild) str += ",";
         str += StringToQuotedJSONString(children[i].first.c_str()) + ": " +
@@ -485,4 +484,328 @@ SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
   return element;
 }
 
+// Private functions for binary serialization
+namespace {
+const char binaryMagic[4] = {'G', 'D', 'B', 'N'};
+const std::uint32_t binaryVersion = 1;
+const std::size_t binaryHeaderSize = 8;
+
+/**
+ * The types of the values, as stored in the binary format.
+ */
+enum BinaryValueType {
+  BinaryUnknown = 0,
+  BinaryBoolean,
+  BinaryString,
+  BinaryInt,
+  BinaryDouble
+};
+
+/**
+ * The flags of an element, as stored in the binary format.
+ */
+enum BinaryElementFlags {
+  BinaryHasValue = 1,
+  BinaryIsArray = 2,
+};
+
+/**
+ * \brief Write the elements, storing all the strings in a table.
+ */
+class BinaryWriter {
+ public:
+  void WriteVarint(std::uint32_t value, std::string& output) {
+    while (value >= 0x80) {
+      output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    output.push_back(static_cast<char>(value));
+  }
+
+  void WriteString(const gd::String& str, std::string& output) {
+    auto it = stringsIndices.find(str.Raw());
+    if (it != stringsIndices.end()) {
+      WriteVarint(it->second, output);
+      return;
+    }
+
+    std::uint32_t index = static_cast<std::uint32_t>(strings.size());
+    strings.push_back(&stringsIndices.emplace(str.Raw(), index).first->first);
+    WriteVarint(index, output);
+  }
+
+  void WriteValue(const SerializerValue& value, std::string& output) {
+    if (value.IsBoolean()) {
+      output.push_back(BinaryBoolean);
+      output.push_back(value.GetBool() ? 1 : 0);
+    } else if (value.IsString()) {
+      output.push_back(BinaryString);
+      WriteString(value.GetString(), output);
+    } else if (value.IsInt()) {
+      output.push_back(BinaryInt);
+      std::int32_t intValue = value.GetInt();
+      WriteVarint((static_cast<std::uint32_t>(intValue) << 1) ^
+                      static_cast<std::uint32_t>(intValue >> 31),
+                  output);  // Zigzag encoding, for small negative numbers.
+    } else if (value.IsDouble()) {
+      output.push_back(BinaryDouble);
+      double doubleValue = value.GetDouble();
+      std::uint64_t bits;
+      std::memcpy(&bits, &doubleValue, sizeof(bits));
+      for (int i = 0; i < 8; ++i)
+        output.push_back(static_cast<char>((bits >> (i * 8)) & 0xFF));
+    } else {
+      output.push_back(BinaryUnknown);
+      WriteString(value.GetString(), output);
+    }
+  }
+
+  void WriteElement(const SerializerElement& element, std::string& output) {
+    std::uint32_t flags = 0;
+    if (!element.IsValueUndefined()) flags |= BinaryHasValue;
+    if (element.ConsideredAsArray()) flags |= BinaryIsArray;
+    WriteVarint(flags, output);
+
+    if (!element.IsValueUndefined()) WriteValue(element.GetValue(), output);
+    if (element.ConsideredAsArray())
+      WriteString(element.ConsideredAsArrayOf(), output);
+
+    const std::vector<std::pair<gd::String, SerializerValue> >& attributes =
+        element.GetAllAttributes();
+    WriteVarint(static_cast<std::uint32_t>(attributes.size()), output);
+    for (const auto& attribute : attributes) {
+      WriteString(attribute.first, output);
+      WriteValue(attribute.second, output);
+    }
+
+    const std::vector<std::pair<gd::String, SerializerElement*> >& children =
+        element.GetAllChildren();
+    WriteVarint(static_cast<std::uint32_t>(children.size()), output);
+    for (const auto& child : children) {
+      WriteString(child.first, output);
+
+      // Reserve the size of the child, written when the child is written.
+      std::size_t sizePosition = output.size();
+      output.append(4, '\0');
+      WriteElement(*child.second, output);
+
+      std::uint32_t childSize =
+          static_cast<std::uint32_t>(output.size() - sizePosition - 4);
+      for (int i = 0; i < 4; ++i)
+        output[sizePosition + i] =
+            static_cast<char>((childSize >> (i * 8)) & 0xFF);
+    }
+  }
+
+  void WriteStringsTable(std::string& output) {
+    WriteVarint(static_cast<std::uint32_t>(strings.size()), output);
+    for (const std::string* str : strings) {
+      WriteVarint(static_cast<std::uint32_t>(str->size()), output);
+      output.append(*str);
+    }
+  }
+
+ private:
+  std::unordered_map<std::string, std::uint32_t> stringsIndices;
+  std::vector<const std::string*> strings;  ///< Pointers to the keys of
+                                            ///< stringsIndices, by index.
+};
+
+/**
+ * \brief Read the elements from binary data, without copying the data.
+ */
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, std::size_t size)
+      : position(reinterpret_cast<const unsigned char*>(data)),
+        end(reinterpret_cast<const unsigned char*>(data) + size),
+        error(false) {}
+
+  bool HasError() const { return error; }
+
+  std::uint32_t ReadVarint() {
+    std::uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      if (position >= end) break;
+
+      unsigned char byte = *(position++);
+      value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return value;
+    }
+
+    error = true;
+    return 0;
+  }
+
+  std::uint32_t ReadUint32() {
+    if (end - position < 4) {
+      error = true;
+      return 0;
+    }
+
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+      value |= static_cast<std::uint32_t>(*(position++)) << (i * 8);
+    return value;
+  }
+
+  void ReadStringsTable() {
+    std::uint32_t count = ReadVarint();
+    if (error || count > static_cast<std::size_t>(end - position)) {
+      error = true;
+      return;
+    }
+
+    strings.reserve(count);
+    for (std::uint32_t i = 0; i < count && !error; ++i) {
+      std::uint32_t length = ReadVarint();
+      if (error || length > static_cast<std::size_t>(end - position)) {
+        error = true;
+        return;
+      }
+
+      strings.push_back(
+          gd::String::FromUTF8(
+              std::string(reinterpret_cast<const char*>(position), length))
+              .ReplaceInvalid());
+      position += length;
+    }
+  }
+
+  const gd::String& ReadString() {
+    std::uint32_t index = ReadVarint();
+    if (error || index >= strings.size()) {
+      error = true;
+      return emptyString;
+    }
+
+    return strings[index];
+  }
+
+  SerializerValue ReadValue() {
+    SerializerValue value;
+    if (position >= end) {
+      error = true;
+      return value;
+    }
+
+    unsigned char type = *(position++);
+    if (type == BinaryBoolean) {
+      if (position >= end) {
+        error = true;
+        return value;
+      }
+      value.SetBool(*(position++) != 0);
+    } else if (type == BinaryString) {
+      value.SetString(ReadString());
+    } else if (type == BinaryInt) {
+      std::uint32_t zigzag = ReadVarint();
+      value.SetInt(
+          static_cast<std::int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1))));
+    } else if (type == BinaryDouble) {
+      if (end - position < 8) {
+        error = true;
+        return value;
+      }
+
+      std::uint64_t bits = 0;
+      for (int i = 0; i < 8; ++i)
+        bits |= static_cast<std::uint64_t>(*(position++)) << (i * 8);
+      double doubleValue;
+      std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+      value.SetDouble(doubleValue);
+    } else if (type == BinaryUnknown) {
+      value.Set(ReadString());
+    } else {
+      error = true;
+    }
+
+    return value;
+  }
+
+  void ReadElement(SerializerElement& element) {
+    std::uint32_t flags = ReadVarint();
+    if (flags & BinaryHasValue) element.SetValue(ReadValue());
+    if (flags & BinaryIsArray) element.ConsiderAsArrayOf(ReadString());
+
+    std::uint32_t attributesCount = ReadVarint();
+    for (std::uint32_t i = 0; i < attributesCount && !error; ++i) {
+      const gd::String& name = ReadString();
+      SerializerValue value = ReadValue();
+      if (value.IsBoolean())
+        element.SetAttribute(name, value.GetBool());
+      else if (value.IsInt())
+        element.SetAttribute(name, value.GetInt());
+      else if (value.IsDouble())
+        element.SetAttribute(name, value.GetDouble());
+      else
+        element.SetAttribute(name, value.GetString());
+    }
+
+    std::uint32_t childrenCount = ReadVarint();
+    for (std::uint32_t i = 0; i < childrenCount && !error; ++i) {
+      const gd::String& name = ReadString();
+      std::uint32_t childSize = ReadUint32();
+      if (error || childSize > static_cast<std::size_t>(end - position)) {
+        error = true;
+        return;
+      }
+
+      const unsigned char* childEnd = position + childSize;
+      ReadElement(element.AddChild(name));
+      if (position != childEnd) error = true;
+    }
+  }
+
+ private:
+  const unsigned char* position;
+  const unsigned char* end;
+  bool error;
+  std::vector<gd::String> strings;
+  gd::String emptyString;
+};
+}  // namespace
+
+std::string Serializer::ToBinary(const SerializerElement& element) {
+  BinaryWriter writer;
+  std::string body;
+  writer.WriteElement(element, body);
+
+  std::string output(binaryMagic, sizeof(binaryMagic));
+  for (int i = 0; i < 4; ++i)
+    output.push_back(static_cast<char>((binaryVersion >> (i * 8)) & 0xFF));
+  writer.WriteStringsTable(output);
+  output.append(body);
+  return output;
+}
+
+bool Serializer::IsBinary(const char* data, std::size_t size) {
+  return data && size >= binaryHeaderSize &&
+         std::memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+SerializerElement Serializer::FromBinary(const char* data, std::size_t size) {
+  SerializerElement element;
+  if (!IsBinary(data, size)) {
+    std::cout << "Parsing error: Not a binary serialized element.";
+    return element;
+  }
+
+  BinaryReader reader(data + sizeof(binaryMagic),
+                      size - sizeof(binaryMagic));
+  if (reader.ReadUint32() > binaryVersion) {
+    std::cout << "Parsing error: Binary format too recent.";
+    return element;
+  }
+
+  reader.ReadStringsTable();
+  if (!reader.HasError()) reader.ReadElement(element);
+  if (reader.HasError()) {
+    std::cout << "Parsing error: Invalid binary data.";
+    return SerializerElement();
+  }
+
+  return element;
+}
+
 }  // namespace gd
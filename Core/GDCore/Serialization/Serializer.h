@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_SERIALIZER_H
 #define GDCORE_SERIALIZER_H
+#include <cstddef>
 #include <string>
 #include "GDCore/Serialization/SerializerElement.h"
 class TiXmlElement;
@@ -14,7 +15,7 @@ namespace gd {
 
 /**
  * \brief The class used to save/load projects and GDCore classes
- * from/to XML or JSON.
+ * from/to XML, JSON or a compact binary format.
  */
 class GD_CORE_API Serializer {
  public:
@@ -27,6 +28,20 @@ class GD_CORE_API Serializer {
   static void FromXML(SerializerElement& element,
                       const TiXmlElement* xmlElement);
 #endif
+
+  /**
+   * \brief Unserialize the root element of a XML into \a element, reading
+   * the XML in place instead of building a TinyXml document first.
+   *
+   * \return false if the XML is invalid or has no root element.
+   * \see gd::XmlReader
+   */
+  static bool FromXML(SerializerElement& element,
+                      const char* data,
+                      std::size_t size);
+  static bool FromXML(SerializerElement& element, const std::string& xml) {
+    return FromXML(element, xml.data(), xml.size());
+  }
   ///@}
 
   /** \name JSON serialization.
@@ -40,6 +55,43 @@ class GD_CORE_API Serializer {
   }
   ///@}
 
+  /** \name Binary serialization.
+   * Serialize a SerializerElement from/to a compact binary format.
+   *
+   * The data starts with a header (a magic number and the version of the
+   * format), followed by a table of all the strings used by the elements
+   * (names and string values are stored once), then by the root element.
+   * Numbers are stored as varints and the children are prefixed by their
+   * size, so that the data is read in a single pass without any parsing.
+   */
+  ///@{
+  /**
+   * \brief Serialize the element to the binary format.
+   * \return The binary data (not an UTF8 string).
+   */
+  static std::string ToBinary(const SerializerElement& element);
+
+  /**
+   * \brief Unserialize an element from binary data.
+   *
+   * The data is only read, so it can be a memory-mapped file.
+   * \return The element, or an empty element if the data is invalid.
+   */
+  static SerializerElement FromBinary(const char* data, std::size_t size);
+  static SerializerElement FromBinary(const std::string& data) {
+    return FromBinary(data.data(), data.size());
+  }
+
+  /**
+   * \brief Return true if the data starts with the header of the binary
+   * format (see ToBinary).
+   */
+  static bool IsBinary(const char* data, std::size_t size);
+  static bool IsBinary(const std::string& data) {
+    return IsBinary(data.data(), data.size());
+  }
+  ///@}
+
   virtual ~Serializer(){};
 
  private:
@@ -1,57 +1,99 @@
 #include "GDCore/Serialization/SerializerElement.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace gd {
 
-SerializerElement SerializerElement::nullElement;
+namespace {
+const std::size_t firstChildrenBlockSize = 2;
+const std::size_t maxChildrenBlockSize = 256;
+const std::size_t minIndexedChildrenCount = 16;
 
-SerializerElement::SerializerElement() : valueUndefined(true), isArray(false) {}
+bool AttributeNameLess(const std::pair<gd::String, SerializerValue>& attribute,
+                       const gd::String& name) {
+  return attribute.first < name;
+}
+}  // namespace
+
+SerializerElement::SerializerElement()
+    : valueUndefined(true),
+      lastBlockSize(0),
+      lastBlockUsedCount(0),
+      isArray(false) {}
 
 SerializerElement::SerializerElement(const SerializerValue& value)
-    : valueUndefined(false), elementValue(value), isArray(false) {}
+    : valueUndefined(false),
+      elementValue(value),
+      lastBlockSize(0),
+      lastBlockUsedCount(0),
+      isArray(false) {}
 
 SerializerElement::~SerializerElement() {}
 
+SerializerElement& SerializerElement::GetNullElement() {
+  static thread_local SerializerElement nullElement;
+  return nullElement;
+}
+
 const SerializerValue& SerializerElement::GetValue() const {
-  if (valueUndefined && attributes.find("value") != attributes.end())
-    return attributes.find("value")->second;
+  const SerializerValue* valueAttribute =
+      valueUndefined ? FindAttribute("value") : NULL;
+  if (valueAttribute) return *valueAttribute;
 
   return elementValue;
 }
 
+const SerializerValue* SerializerElement::FindAttribute(
+    const gd::String& name) const {
+  auto it = std::lower_bound(
+      attributes.begin(), attributes.end(), name, AttributeNameLess);
+  return it != attributes.end() && it->first == name ? &it->second : NULL;
+}
+
+SerializerValue& SerializerElement::GetOrCreateAttribute(
+    const gd::String& name) {
+  auto it = std::lower_bound(
+      attributes.begin(), attributes.end(), name, AttributeNameLess);
+  if (it == attributes.end() || it->first != name)
+    it = attributes.insert(it, std::make_pair(name, SerializerValue()));
+
+  return it->second;
+}
+
 SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                                                    bool value) {
-  attributes[name].SetBool(value);
+  GetOrCreateAttribute(name).SetBool(value);
   return *this;
 }
 
 SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                                                    const gd::String& value) {
-  attributes[name].SetString(value);
+  GetOrCreateAttribute(name).SetString(value);
   return *this;
 }
 
 SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                                                    int value) {
-  attributes[name].SetInt(value);
+  GetOrCreateAttribute(name).SetInt(value);
   return *this;
 }
 
 SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                                                    double value) {
-  attributes[name].SetDouble(value);
+  GetOrCreateAttribute(name).SetDouble(value);
   return *this;
 }
 
 bool SerializerElement::GetBoolAttribute(const gd::String& name,
                                          bool defaultValue,
                                          gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end()) {
-    return attributes.find(name)->second.GetBool();
-  } else if (!deprecatedName.empty() &&
-             attributes.find(deprecatedName) != attributes.end()) {
-    return attributes.find(deprecatedName)->second.GetBool();
+  const SerializerValue* attribute = FindAttribute(name);
+  if (!attribute && !deprecatedName.empty())
+    attribute = FindAttribute(deprecatedName);
+
+  if (attribute) {
+    return attribute->GetBool();
   } else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -70,11 +112,12 @@ gd::String SerializerElement::GetStringAttribute(  // TODO: Use const ref?
     const gd::String& name,
     gd::String defaultValue,
     gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetString();
-  else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetString();
+  const SerializerValue* attribute = FindAttribute(name);
+  if (!attribute && !deprecatedName.empty())
+    attribute = FindAttribute(deprecatedName);
+
+  if (attribute)
+    return attribute->GetString();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -88,11 +131,12 @@ gd::String SerializerElement::GetStringAttribute(  // TODO: Use const ref?
 int SerializerElement::GetIntAttribute(const gd::String& name,
                                        int defaultValue,
                                        gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetInt();
-  else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetInt();
+  const SerializerValue* attribute = FindAttribute(name);
+  if (!attribute && !deprecatedName.empty())
+    attribute = FindAttribute(deprecatedName);
+
+  if (attribute)
+    return attribute->GetInt();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -106,11 +150,12 @@ int SerializerElement::GetIntAttribute(const gd::String& name,
 double SerializerElement::GetDoubleAttribute(const gd::String& name,
                                              double defaultValue,
                                              gd::String deprecatedName) const {
-  if (attributes.find(name) != attributes.end())
-    return attributes.find(name)->second.GetDouble();
-  else if (!deprecatedName.empty() &&
-           attributes.find(deprecatedName) != attributes.end())
-    return attributes.find(deprecatedName)->second.GetDouble();
+  const SerializerValue* attribute = FindAttribute(name);
+  if (!attribute && !deprecatedName.empty())
+    attribute = FindAttribute(deprecatedName);
+
+  if (attribute)
+    return attribute->GetDouble();
   else {
     if (HasChild(name, deprecatedName)) {
       SerializerElement& child = GetChild(name, 0, deprecatedName);
@@ -122,7 +167,20 @@ double SerializerElement::GetDoubleAttribute(const gd::String& name,
 }
 
 bool SerializerElement::HasAttribute(const gd::String& name) const {
-  return attributes.find(name) != attributes.end();
+  return FindAttribute(name) != NULL;
+}
+
+SerializerElement* SerializerElement::NewChildElement() {
+  if (childrenBlocks.empty() || lastBlockUsedCount >= lastBlockSize) {
+    lastBlockSize = childrenBlocks.empty()
+                        ? firstChildrenBlockSize
+                        : std::min(lastBlockSize * 2, maxChildrenBlockSize);
+    childrenBlocks.push_back(std::unique_ptr<SerializerElement[]>(
+        new SerializerElement[lastBlockSize]));
+    lastBlockUsedCount = 0;
+  }
+
+  return &childrenBlocks.back()[lastBlockUsedCount++];
 }
 
 SerializerElement& SerializerElement::AddChild(gd::String name) {
@@ -136,24 +194,43 @@ SerializerElement& SerializerElement::AddChild(gd::String name) {
     }
   }
 
-  std::shared_ptr<SerializerElement> newElement(new SerializerElement);
+  SerializerElement* newElement = NewChildElement();
+  if (childrenIndex)  // Only the first child having the name is indexed.
+    childrenIndex->insert(std::make_pair(name, children.size()));
   children.push_back(std::make_pair(name, newElement));
 
   return *newElement;
 }
 
+std::size_t SerializerElement::FindIndexedChild(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (!childrenIndex) {
+    childrenIndex.reset(new std::unordered_map<gd::String, std::size_t>);
+    for (std::size_t i = 0; i < children.size(); ++i)
+      childrenIndex->insert(std::make_pair(children[i].first, i));
+  }
+
+  std::size_t position = children.size();
+  auto it = childrenIndex->find(name);
+  if (it != childrenIndex->end()) position = it->second;
+  if (!deprecatedName.empty()) {
+    it = childrenIndex->find(deprecatedName);
+    if (it != childrenIndex->end()) position = std::min(position, it->second);
+  }
+
+  return position;
+}
+
 SerializerElement& SerializerElement::GetChild(std::size_t index) const {
   if (arrayOf.empty()) {
     std::cout << "ERROR: Getting a child from its index whereas the parent is "
                  "not considered as an array."
               << std::endl;
-    return nullElement;
+    return GetNullElement();
   }
 
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
     if (children[i].first == arrayOf || children[i].first.empty() ||
         (!deprecatedArrayOf.empty() &&
          children[i].first == deprecatedArrayOf)) {
@@ -166,7 +243,7 @@ SerializerElement& SerializerElement::GetChild(std::size_t index) const {
 
   std::cout << "ERROR: Request out of bound child at index " << index
             << std::endl;
-  return nullElement;
+  return GetNullElement();
 }
 
 SerializerElement& SerializerElement::GetChild(
@@ -179,12 +256,13 @@ SerializerElement& SerializerElement::GetChild(
                 << arrayOf << ")." << std::endl;
       name = arrayOf;
     }
+  } else if (index == 0 && children.size() >= minIndexedChildrenCount) {
+    std::size_t position = FindIndexedChild(name, deprecatedName);
+    if (position < children.size()) return *children[position].second;
   }
 
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
     if (children[i].first == name ||
         (!arrayOf.empty() && children[i].first.empty()) ||
         (!deprecatedName.empty() && children[i].first == deprecatedName)) {
@@ -197,7 +275,7 @@ SerializerElement& SerializerElement::GetChild(
 
   std::cout << "Child " << name << " not found in SerializerElement::GetChild"
             << std::endl;
-  return nullElement;
+  return GetNullElement();
 }
 
 std::size_t SerializerElement::GetChildrenCount(
@@ -217,8 +295,6 @@ std::size_t SerializerElement::GetChildrenCount(
 
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
     if (children[i].first == name ||
         (!arrayOf.empty() && children[i].first.empty()) ||
         (!deprecatedName.empty() && children[i].first == deprecatedName))
@@ -230,9 +306,10 @@ std::size_t SerializerElement::GetChildrenCount(
 
 bool SerializerElement::HasChild(const gd::String& name,
                                  gd::String deprecatedName) const {
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+  if (children.size() >= minIndexedChildrenCount)
+    return FindIndexedChild(name, deprecatedName) < children.size();
 
+  for (size_t i = 0; i < children.size(); ++i) {
     if (children[i].first == name ||
         (!deprecatedName.empty() && children[i].first == deprecatedName))
       return true;
@@ -243,25 +320,42 @@ bool SerializerElement::HasChild(const gd::String& name,
 
 void SerializerElement::RemoveChild(const gd::String &name) {
   for (size_t i = 0; i < children.size();) {
-    if (children[i].first == name)
+    if (children[i].first == name) {
+      // The storage of the child is only released with the parent, but its
+      // content is released now.
+      *children[i].second = SerializerElement();
       children.erase(children.begin() + i);
-    else
+    } else
       ++i;
   }
+
+  childrenIndex.reset();
 }
 
 void SerializerElement::Init(const gd::SerializerElement& other) {
+  // Copy the children first, as other could be one of the children.
+  std::vector<std::pair<gd::String, SerializerElement*> > newChildren;
+  std::vector<std::unique_ptr<SerializerElement[]> > newChildrenBlocks;
+  std::size_t newBlockSize = other.children.size();
+  if (!other.children.empty()) {
+    newChildrenBlocks.push_back(std::unique_ptr<SerializerElement[]>(
+        new SerializerElement[newBlockSize]));
+    for (std::size_t i = 0; i < other.children.size(); ++i) {
+      newChildrenBlocks.back()[i] = *other.children[i].second;
+      newChildren.push_back(std::make_pair(other.children[i].first,
+                                           &newChildrenBlocks.back()[i]));
+    }
+  }
+
   valueUndefined = other.valueUndefined;
   elementValue = other.elementValue;
   attributes = other.attributes;
 
-  children.clear();
-  for (const auto& child : other.children) {
-    children.push_back(
-        std::make_pair(child.first,
-                       std::shared_ptr<SerializerElement>(
-                           new SerializerElement(*child.second))));
-  }
+  children.swap(newChildren);
+  childrenBlocks.swap(newChildrenBlocks);
+  lastBlockSize = newBlockSize;
+  lastBlockUsedCount = newBlockSize;
+  childrenIndex.reset();
 
   isArray = other.isArray;
   arrayOf = other.arrayOf;
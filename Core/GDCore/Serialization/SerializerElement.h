@@ -6,9 +6,10 @@
 
 #ifndef GDCORE_SERIALIZERELEMENT_H
 #define GDCORE_SERIALIZERELEMENT_H
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "GDCore/Serialization/SerializerValue.h"
 #include "GDCore/String.h"
@@ -27,6 +28,14 @@ namespace gd {
  * It also has specialized methods in GDevelop.js (see postjs.js) to be
  * converted to a JavaScript object.
  *
+ * The attributes are stored in a vector sorted by name, and the children are
+ * allocated by blocks owned by their parent: building a tree does not allocate
+ * each element separately. Children of elements having a lot of children are
+ * found using an index of their names, built on the first search.
+ *
+ * \warning As the index is built when searching a child, an element must not
+ * be read by several threads at the same time (different elements can).
+ *
  * \see gd::Serializer
  */
 class GD_CORE_API SerializerElement {
@@ -55,6 +64,16 @@ class GD_CORE_API SerializerElement {
     return *this;
   }
 
+  /**
+   * Move constructor. The children are moved without being copied.
+   */
+  SerializerElement(gd::SerializerElement &&object) = default;
+
+  /**
+   * Move assignment operator. The children are moved without being copied.
+   */
+  SerializerElement &operator=(gd::SerializerElement &&object) = default;
+
   virtual ~SerializerElement();
 
   /** \name Value
@@ -310,9 +329,10 @@ class GD_CORE_API SerializerElement {
   bool HasAttribute(const gd::String &name) const;
 
   /**
-   * \brief Return all the attributes of the element.
+   * \brief Return all the attributes of the element, sorted by name.
    */
-  const std::map<gd::String, SerializerValue> &GetAllAttributes() const {
+  const std::vector<std::pair<gd::String, SerializerValue> > &GetAllAttributes()
+      const {
     return attributes;
   };
   ///@}
@@ -419,27 +439,55 @@ class GD_CORE_API SerializerElement {
   /**
    * \brief Return all the children of the element.
    */
-  const std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
+  const std::vector<std::pair<gd::String, SerializerElement *> >
       &GetAllChildren() const {
     return children;
   };
   ///@}
 
-  static SerializerElement nullElement;
-
  private:
+  /**
+   * \brief Get the element returned when a child is not found.
+   *
+   * There is one for each thread, as it can be modified by the callers of
+   * GetChild (and elements can be read by several threads at the same time,
+   * see gd::Project::UnserializeFrom).
+   */
+  static SerializerElement &GetNullElement();
+
   /**
    * Initialize element using another element. Used by copy-ctor and assign-op.
    * Don't forget to update me if members were changed!
    */
   void Init(const gd::SerializerElement& other);
 
+  const SerializerValue *FindAttribute(const gd::String &name) const;
+  SerializerValue &GetOrCreateAttribute(const gd::String &name);
+  SerializerElement *NewChildElement();
+
+  /**
+   * \brief Return the position of the first child having the name (or the
+   * deprecated name), using the index of the children names.
+   * \return The position, or children.size() if there is no such child.
+   */
+  std::size_t FindIndexedChild(const gd::String &name,
+                               const gd::String &deprecatedName) const;
+
   bool valueUndefined;  ///< If true, the element does not have a value.
   SerializerValue elementValue;
 
-  std::map<gd::String, SerializerValue> attributes;
-  std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
-      children;
+  std::vector<std::pair<gd::String, SerializerValue> >
+      attributes;  ///< The attributes, sorted by name.
+  std::vector<std::pair<gd::String, SerializerElement *> >
+      children;  ///< The children, stored in childrenBlocks.
+  std::vector<std::unique_ptr<SerializerElement[]> >
+      childrenBlocks;  ///< The storage of the children, allocated by blocks
+                       ///< of increasing size.
+  std::size_t lastBlockSize;
+  std::size_t lastBlockUsedCount;
+  mutable std::unique_ptr<std::unordered_map<gd::String, std::size_t> >
+      childrenIndex;  ///< The position of the first child having a given
+                      ///< name, built when needed (see FindIndexedChild).
   mutable bool isArray;        ///< true if element is considered as an array
   mutable gd::String arrayOf;  ///< The name of the children (was useful for XML
                                ///< parsed elements).
@@ -0,0 +1,361 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/XmlReader.h"
+#include <algorithm>
+#include <cstring>
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+
+namespace gd {
+
+namespace {
+bool IsWhiteSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool IsNameCharacter(char c) {
+  return !IsWhiteSpace(c) && c != '/' && c != '>' && c != '<' && c != '=' &&
+         c != '"' && c != '\'' && c != '\0';
+}
+
+bool StartsWith(const char* position, const char* end, const char* prefix) {
+  std::size_t length = std::strlen(prefix);
+  return static_cast<std::size_t>(end - position) >= length &&
+         std::strncmp(position, prefix, length) == 0;
+}
+}  // namespace
+
+XmlReader::XmlReader(const char* data, std::size_t size)
+    : position(data), end(data + size), token(End), inTag(false) {
+  if (StartsWith(position, end, "\xEF\xBB\xBF")) position += 3;  // UTF8 BOM
+}
+
+XmlReader::XmlReader(const std::string& xml)
+    : XmlReader(xml.data(), xml.size()) {}
+
+XmlReader::Token XmlReader::Next() {
+  if (token == Error) return Error;
+
+  if (inTag) {
+    SkipWhiteSpace();
+    if (position >= end) {
+      SetError();
+      return token;
+    }
+
+    if (*position == '/') {  // An empty element.
+      if (!StartsWith(position, end, "/>")) {
+        SetError();
+        return token;
+      }
+
+      position += 2;
+      inTag = false;
+      name.assign(openElements.back().first, openElements.back().second);
+      openElements.pop_back();
+      token = EndElement;
+      return token;
+    }
+    if (*position != '>') {
+      ReadAttributeToken();
+      return token;
+    }
+
+    position++;
+    inTag = false;
+  }
+
+  for (;;) {
+    if (position >= end) {
+      token = openElements.empty() ? End : Error;
+      return token;
+    }
+
+    if (*position != '<') {
+      const char* textEnd = static_cast<const char*>(
+          std::memchr(position, '<', end - position));
+      if (!textEnd) textEnd = end;
+
+      // Texts outside of the elements are ignored, like blank texts.
+      if (!openElements.empty()) ReadText(textEnd, true);
+      position = textEnd;
+      if (!openElements.empty() && !stringValue.empty()) {
+        token = Text;
+        return token;
+      }
+    } else if (StartsWith(position, end, "<!--")) {
+      position += 4;
+      if (!SkipPast("-->")) SetError();
+    } else if (StartsWith(position, end, "<![CDATA[")) {
+      position += 9;
+      const char* cdataStart = position;
+      if (!SkipPast("]]>")) {
+        SetError();
+        return token;
+      }
+
+      // CDATA sections are kept as is, even when blank.
+      stringValue.assign(cdataStart, position - 3);
+      if (!openElements.empty()) {
+        token = Text;
+        return token;
+      }
+    } else if (StartsWith(position, end, "<?")) {
+      position += 2;
+      if (!SkipPast("?>")) SetError();
+    } else if (StartsWith(position, end, "</")) {
+      position += 2;
+      ReadEndElementToken();
+      return token;
+    } else if (StartsWith(position, end, "<!")) {
+      position += 2;
+      if (!SkipPast(">")) SetError();
+    } else {
+      position++;
+      const char* nameStart = position;
+      if (!ReadName()) {
+        SetError();
+        return token;
+      }
+
+      openElements.push_back(std::make_pair(
+          nameStart, static_cast<std::size_t>(position - nameStart)));
+      inTag = true;
+      token = BeginElement;
+      return token;
+    }
+
+    if (token == Error) return token;
+  }
+}
+
+bool XmlReader::SkipPast(const char* delimiter) {
+  const char* delimiterEnd = delimiter + std::strlen(delimiter);
+  const char* found = std::search(position, end, delimiter, delimiterEnd);
+  if (found == end) {
+    position = end;
+    return false;
+  }
+
+  position = found + (delimiterEnd - delimiter);
+  return true;
+}
+
+void XmlReader::SkipWhiteSpace() {
+  while (position < end && IsWhiteSpace(*position)) position++;
+}
+
+bool XmlReader::ReadName() {
+  const char* nameStart = position;
+  while (position < end && IsNameCharacter(*position)) position++;
+  if (position == nameStart) return false;
+
+  name.assign(nameStart, position);
+  return true;
+}
+
+void XmlReader::ReadAttributeToken() {
+  if (!ReadName()) {
+    SetError();
+    return;
+  }
+
+  SkipWhiteSpace();
+  if (position >= end || *position != '=') {
+    SetError();
+    return;
+  }
+
+  position++;
+  SkipWhiteSpace();
+  if (position >= end || (*position != '"' && *position != '\'')) {
+    SetError();
+    return;
+  }
+
+  char quote = *(position++);
+  const char* valueEnd =
+      static_cast<const char*>(std::memchr(position, quote, end - position));
+  if (!valueEnd) {
+    SetError();
+    return;
+  }
+
+  ReadText(valueEnd, false);
+  position = valueEnd + 1;
+  token = Attribute;
+}
+
+void XmlReader::ReadEndElementToken() {
+  const char* nameStart = position;
+  if (!ReadName()) {
+    SetError();
+    return;
+  }
+
+  SkipWhiteSpace();
+  if (position >= end || *position != '>' || openElements.empty() ||
+      openElements.back().second !=
+          static_cast<std::size_t>(position - nameStart) ||
+      std::strncmp(openElements.back().first, nameStart,
+                   openElements.back().second) != 0) {
+    SetError();  // Not the end of the last opened element.
+    return;
+  }
+
+  position++;
+  openElements.pop_back();
+  token = EndElement;
+}
+
+void XmlReader::ReadText(const char* textEnd, bool condenseWhiteSpace) {
+  stringValue.clear();
+  const char* current = position;
+  if (condenseWhiteSpace) {
+    while (current < textEnd && IsWhiteSpace(*current)) current++;
+  }
+
+  bool whiteSpace = false;
+  while (current < textEnd) {
+    if (condenseWhiteSpace && IsWhiteSpace(*current)) {
+      whiteSpace = true;
+      current++;
+      continue;
+    }
+
+    // White spaces are replaced by a single space, only if followed by
+    // another character.
+    if (whiteSpace) {
+      stringValue.push_back(' ');
+      whiteSpace = false;
+    }
+
+    if (*current == '&') {
+      current = ReadEntity(current, textEnd);
+      continue;
+    }
+
+    // Copy the characters up to the next entity or white space at once.
+    const char* runEnd = current;
+    while (runEnd < textEnd && *runEnd != '&' &&
+           !(condenseWhiteSpace && IsWhiteSpace(*runEnd)))
+      runEnd++;
+    stringValue.append(current, runEnd);
+    current = runEnd;
+  }
+}
+
+const char* XmlReader::ReadEntity(const char* entity, const char* textEnd) {
+  const char* names[] = {"&amp;", "&lt;", "&gt;", "&quot;", "&apos;"};
+  const char characters[] = {'&', '<', '>', '"', '\''};
+  for (int i = 0; i < 5; ++i) {
+    if (StartsWith(entity, textEnd, names[i])) {
+      stringValue.push_back(characters[i]);
+      return entity + std::strlen(names[i]);
+    }
+  }
+
+  if (StartsWith(entity, textEnd, "&#")) {
+    const char* current = entity + 2;
+    bool hexadecimal = current < textEnd && *current == 'x';
+    if (hexadecimal) current++;
+
+    unsigned long codePoint = 0;
+    const char* digitsStart = current;
+    for (; current < textEnd && *current != ';'; ++current) {
+      char c = *current;
+      if (c >= '0' && c <= '9')
+        codePoint = codePoint * (hexadecimal ? 16 : 10) + (c - '0');
+      else if (hexadecimal && c >= 'a' && c <= 'f')
+        codePoint = codePoint * 16 + (c - 'a' + 10);
+      else if (hexadecimal && c >= 'A' && c <= 'F')
+        codePoint = codePoint * 16 + (c - 'A' + 10);
+      else
+        break;
+      if (codePoint > 0x10FFFF) break;
+    }
+
+    if (current < textEnd && *current == ';' && current != digitsStart) {
+      AppendCodePoint(codePoint);
+      return current + 1;
+    }
+  }
+
+  // The ampersand of unknown entities is dropped, like TinyXml does.
+  return entity + 1;
+}
+
+void XmlReader::AppendCodePoint(unsigned long codePoint) {
+  if (codePoint < 0x80) {
+    stringValue.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    stringValue.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    stringValue.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    stringValue.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    stringValue.push_back(
+        static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    stringValue.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+void XmlReader::SkipElement() {
+  if (token != BeginElement) return;
+
+  std::size_t depth = openElements.size();
+  while (openElements.size() >= depth) {
+    Token skippedToken = Next();
+    if (skippedToken == End) SetError();
+    if (token == Error) return;
+  }
+}
+
+void XmlReader::ReadElement(SerializerElement& element) {
+  if (token != BeginElement) {
+    SetError();
+    return;
+  }
+
+  while (Next() == Attribute) {
+    element.SetAttribute(gd::String::FromUTF8(name).ReplaceInvalid(),
+                         gd::String::FromUTF8(stringValue).ReplaceInvalid());
+  }
+
+  // As TinyXml's GetText, the value is the text only if it's the first child
+  // of the element.
+  bool hasChildNode = false;
+  for (;;) {
+    if (token == BeginElement) {
+      ReadElement(
+          element.AddChild(gd::String::FromUTF8(name).ReplaceInvalid()));
+      if (token == Error) return;
+    } else if (token == Text) {
+      if (!hasChildNode) {
+        SerializerValue value;
+        value.Set(gd::String::FromUTF8(stringValue).ReplaceInvalid());
+        element.SetValue(value);
+      }
+    } else if (token == EndElement) {
+      return;
+    } else {
+      SetError();
+      return;
+    }
+
+    hasChildNode = true;
+    Next();
+  }
+}
+
+}  // namespace gd
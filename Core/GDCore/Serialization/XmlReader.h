@@ -0,0 +1,125 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_XMLREADER_H
+#define GDCORE_XMLREADER_H
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+namespace gd {
+class SerializerElement;
+}
+
+namespace gd {
+
+/**
+ * \brief A streaming ("pull") XML reader, reading the tokens one by one.
+ *
+ * The XML is read in place, without building a DOM like TinyXml: names are
+ * checked directly in the XML, and the decoded names and strings reuse the
+ * same buffers, so that reading does not allocate memory once they are large
+ * enough. The XML is not copied: it must stay alive while it's read.
+ *
+ * The text of the elements is read as TinyXml does: the white spaces are
+ * condensed (except in CDATA sections) and blank texts are skipped. The XML
+ * declaration, comments, processing instructions and DOCTYPE are skipped.
+ *
+ * Typical usage, to read the attributes of the root element:
+ * \code
+ * gd::XmlReader reader(xml);
+ * if (reader.Next() == gd::XmlReader::BeginElement) {
+ *   while (reader.Next() == gd::XmlReader::Attribute) {
+ *     if (reader.GetName() == "version") version = reader.GetString();
+ *   }
+ * }
+ * \endcode
+ *
+ * \see gd::Serializer::FromXML
+ */
+class GD_CORE_API XmlReader {
+ public:
+  /**
+   * \brief The tokens of a XML.
+   */
+  enum Token {
+    BeginElement,  ///< The start of an element (see GetName).
+    Attribute,     ///< An attribute of the element (see GetName, GetString).
+    Text,          ///< The text, or a CDATA section, of an element.
+    EndElement,    ///< The end of an element (see GetName).
+    End,           ///< The end of the XML was reached.
+    Error          ///< The XML is invalid. Next will always return Error.
+  };
+
+  XmlReader(const char* data, std::size_t size);
+  XmlReader(const std::string& xml);
+  virtual ~XmlReader(){};
+
+  /**
+   * \brief Read the next token.
+   *
+   * The attributes of an element are read after its BeginElement token, before
+   * its content.
+   */
+  Token Next();
+
+  /**
+   * \brief Return the last token read by Next.
+   */
+  Token GetToken() const { return token; }
+
+  /**
+   * \brief Return true if the XML was found to be invalid.
+   */
+  bool HasError() const { return token == Error; }
+
+  /**
+   * \brief Get the name of the current element or attribute.
+   */
+  const std::string& GetName() const { return name; }
+
+  /**
+   * \brief Get the decoded content of the current Attribute or Text token.
+   */
+  const std::string& GetString() const { return stringValue; }
+
+  /**
+   * \brief Skip the element starting at the current BeginElement token, up to
+   * its EndElement token.
+   */
+  void SkipElement();
+
+  /**
+   * \brief Read the element starting at the current BeginElement token into
+   * \a element, as gd::Serializer::FromXML would do with the element read by
+   * TinyXml.
+   */
+  void ReadElement(SerializerElement& element);
+
+ private:
+  void SetError() { token = Error; }
+  bool SkipPast(const char* delimiter);
+  void SkipWhiteSpace();
+  bool ReadName();
+  void ReadAttributeToken();
+  void ReadEndElementToken();
+  void ReadText(const char* textEnd, bool condenseWhiteSpace);
+  const char* ReadEntity(const char* entity, const char* textEnd);
+  void AppendCodePoint(unsigned long codePoint);
+
+  const char* position;
+  const char* end;
+  Token token;
+  bool inTag;  ///< True while the attributes of an element are read.
+  std::vector<std::pair<const char*, std::size_t> >
+      openElements;  ///< The names of the elements, pointing in the XML.
+  std::string name;
+  std::string stringValue;
+};
+
+}  // namespace gd
+
+#endif
@@ -81,9 +81,23 @@ String& String::operator=(const std::u32string &string)
     return *this;
 }
 
+String::size_type String::GetASCIIPrefixSize() const
+{
+    size_type prefixSize = 0;
+    while(prefixSize < m_string.size() && static_cast<unsigned char>(m_string[prefixSize]) < 0x80)
+        ++prefixSize;
+
+    return prefixSize;
+}
+
 String::size_type String::size() const
 {
-    return std::distance(begin(), end());
+    //Each character of the ASCII prefix is one byte: only decode the rest.
+    size_type prefixSize = GetASCIIPrefixSize();
+    if(prefixSize == m_string.size())
+        return prefixSize;
+
+    return prefixSize + std::distance(const_iterator(m_string.begin() + prefixSize), end());
 }
 
 String::iterator String::begin()
@@ -237,8 +251,12 @@ String& String::ReplaceInvalid( value_type replacement )
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
-    const_iterator it = begin();
-    std::advance(it, position);
+    size_type prefixSize = GetASCIIPrefixSize();
+    if(position < prefixSize)
+        return static_cast<unsigned char>(m_string[position]);
+
+    const_iterator it(m_string.begin() + prefixSize);
+    std::advance(it, position - prefixSize);
     return *it;
 }
 
@@ -427,6 +445,15 @@ String String::substr( String::size_type start, String::size_type length ) const
 {
     String str;
 
+    if(IsASCII())
+    {
+        if(start > m_string.size())
+            throw std::out_of_range("[gd::String::substr] starting pos greater than size");
+
+        str.m_string = m_string.substr(start, length);
+        return str;
+    }
+
     const_iterator startIt = begin();
     while(start > 0 && startIt != end())
     {
@@ -450,6 +477,10 @@ String String::substr( String::size_type start, String::size_type length ) const
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
+    //For ASCII strings, positions in bytes and in characters are the same.
+    if(IsASCII())
+        return pos < m_string.size() ? m_string.find( search.m_string, pos ) : npos;
+
     const_iterator it = begin();
 
     //Move to pos
@@ -488,6 +519,9 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
+    if(IsASCII())
+        return m_string.rfind( search.m_string, pos );
+
     //Move to pos + 1 (we will then get the last byte of the character at pos)
     const_iterator it = begin();
     std::string::const_iterator baseIt;
@@ -553,11 +587,18 @@ namespace priv
 
 String::size_type String::find_first_of( const String &match, size_type startPos ) const
 {
+    //Characters of an ASCII string can only match the ASCII characters (bytes) of match.
+    if(IsASCII())
+        return m_string.find_first_of( match.m_string, startPos );
+
     return priv::find_first_of(*this, match, startPos, false);
 }
 
 String::size_type String::find_first_not_of( const String &match, size_type startPos ) const
 {
+    if(IsASCII())
+        return m_string.find_first_not_of( match.m_string, startPos );
+
     return priv::find_first_of(*this, match, startPos, true);
 }
 
@@ -587,11 +628,17 @@ namespace priv
 
 String::size_type String::find_last_of( const String &match, size_type endPos ) const
 {
+    if(IsASCII())
+        return m_string.find_last_of( match.m_string, endPos );
+
     return priv::find_last_of( *this, match, endPos, false );
 }
 
 String::size_type String::find_last_not_of( const String &match, size_type endPos ) const
 {
+    if(IsASCII())
+        return m_string.find_last_not_of( match.m_string, endPos );
+
     return priv::find_last_of( *this, match, endPos, true );
 }
 
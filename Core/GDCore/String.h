@@ -29,6 +29,9 @@ class String;
  *
  * This class represents an UTF8 encoded string. It provides almost the same features as the STL std::string class
  * but is UTF8 aware (size() returns the number of characters, not the number of bytes for example).
+ *
+ * When the string only contains ASCII characters, operator[], substr and the searches work
+ * directly on the bytes.
  */
 class GD_CORE_API String
 {
@@ -367,8 +370,9 @@ public:
     /**
      * \brief Returns the code point at the specified position
      * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
-     * provided by this class instead.
+     * position (unless the string only contains ASCII characters). You should
+     * avoid to use it in a loop and use the iterators provided by this class
+     * instead.
      */
     value_type operator[]( const size_type position ) const;
 
@@ -633,6 +637,18 @@ public:
  */
 
 private:
+    /**
+     * \brief Return the number of bytes before the first non-ASCII character (the
+     * number of bytes of the string if it only contains ASCII characters).
+     */
+    size_type GetASCIIPrefixSize() const;
+
+    /**
+     * \brief Return true if the string only contains ASCII characters, in which case
+     * each character is one byte in the internal std::string.
+     */
+    bool IsASCII() const { return GetASCIIPrefixSize() == m_string.size(); }
+
     std::string m_string; ///< Internal std::string container
 
 };
@@ -0,0 +1,122 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/KtxImage.h"
+#include <cstdint>
+#include <cstring>
+
+namespace gd {
+
+namespace {
+
+const unsigned char ktxIdentifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+const std::size_t headerSize = 64;
+
+/**
+ * \brief Read the 32 bits integers of a KTX file, written with the
+ * endianness of the machine that created it.
+ */
+class Reader {
+ public:
+  Reader(const char* data_)
+      : data(reinterpret_cast<const unsigned char*>(data_)), swap(false){};
+
+  void SetSwap(bool swap_) { swap = swap_; }
+
+  std::uint32_t Read(std::size_t position) const {
+    const unsigned char* p = data + position;
+    if (swap)
+      return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+             (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+
+    return (std::uint32_t(p[3]) << 24) | (std::uint32_t(p[2]) << 16) |
+           (std::uint32_t(p[1]) << 8) | std::uint32_t(p[0]);
+  }
+
+ private:
+  const unsigned char* data;
+  bool swap;
+};
+
+}  // namespace
+
+bool KtxImage::LoadFromMemory(const char* data, std::size_t size) {
+  width = 0;
+  height = 0;
+  internalFormat = 0;
+  levels.clear();
+
+  if (!data || size < headerSize ||
+      std::memcmp(data, ktxIdentifier, sizeof(ktxIdentifier)) != 0)
+    return false;
+
+  Reader reader(data);
+  std::uint32_t endianness = reader.Read(12);
+  if (endianness == 0x01020304)
+    reader.SetSwap(true);
+  else if (endianness != 0x04030201)
+    return false;
+
+  std::uint32_t glType = reader.Read(16);
+  std::uint32_t glFormat = reader.Read(24);
+  std::uint32_t glInternalFormat = reader.Read(28);
+  std::uint32_t pixelWidth = reader.Read(36);
+  std::uint32_t pixelHeight = reader.Read(40);
+  std::uint32_t pixelDepth = reader.Read(44);
+  std::uint32_t arrayElementsCount = reader.Read(48);
+  std::uint32_t facesCount = reader.Read(52);
+  std::uint32_t levelsCount = reader.Read(56);
+  std::uint32_t keyValueDataSize = reader.Read(60);
+
+  // Only compressed (glType and glFormat are 0) 2D textures are supported.
+  if (glType != 0 || glFormat != 0 || pixelWidth == 0 || pixelHeight == 0 ||
+      pixelDepth > 1 || arrayElementsCount > 1 || facesCount != 1)
+    return false;
+  if (levelsCount == 0) levelsCount = 1;
+
+  std::size_t position = headerSize;
+  if (keyValueDataSize > size - position) return false;
+  position += keyValueDataSize;
+
+  for (std::uint32_t level = 0; level < levelsCount; ++level) {
+    if (size - position < 4) return false;
+    std::size_t levelSize = reader.Read(position);
+    position += 4;
+    if (levelSize > size - position) return false;
+
+    levels.push_back(std::string(data + position, levelSize));
+    position += levelSize;
+    position += (4 - levelSize % 4) % 4;  // Levels are aligned on 4 bytes.
+    if (position > size) position = size;
+  }
+
+  width = pixelWidth;
+  height = pixelHeight;
+  internalFormat = glInternalFormat;
+  return true;
+}
+
+bool KtxImage::IsKtxFile(const std::string& filename) {
+  const std::string extension = ".ktx";
+  if (filename.size() < extension.size()) return false;
+
+  for (std::size_t i = 0; i < extension.size(); ++i) {
+    char c = filename[filename.size() - extension.size() + i];
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+    if (c != extension[i]) return false;
+  }
+
+  return true;
+}
+
+std::size_t KtxImage::GetDataSize() const {
+  std::size_t dataSize = 0;
+  for (auto& level : levels) dataSize += level.size();
+
+  return dataSize;
+}
+
+}  // namespace gd
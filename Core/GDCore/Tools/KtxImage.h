@@ -0,0 +1,76 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_KTXIMAGE_H
+#define GDCORE_KTXIMAGE_H
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief A texture compressed in a format of the GPU (ETC2, ASTC, BC7...),
+ * read from a KTX (version 1) file.
+ *
+ * Only 2D textures in a compressed format are supported: the textures can
+ * then be given as is to the GPU (see OpenGLTools::UploadCompressedTexture).
+ *
+ * \see gd::ResourcesLoader::LoadKtxImage
+ * \ingroup Tools
+ */
+class GD_CORE_API KtxImage {
+ public:
+  KtxImage() : width(0), height(0), internalFormat(0){};
+
+  /**
+   * \brief Read the texture from the content of a KTX file.
+   * \return false if the content is not a valid KTX file, or if the texture
+   * is not a compressed 2D texture.
+   */
+  bool LoadFromMemory(const char* data, std::size_t size);
+
+  /**
+   * \brief Return true if the extension of the file is the one of KTX files.
+   */
+  static bool IsKtxFile(const std::string& filename);
+
+  unsigned int GetWidth() const { return width; }
+  unsigned int GetHeight() const { return height; }
+
+  /**
+   * \brief Return the OpenGL internal format of the texture (for example
+   * GL_COMPRESSED_RGBA8_ETC2_EAC).
+   */
+  unsigned int GetInternalFormat() const { return internalFormat; }
+
+  /**
+   * \brief Return the number of mipmap levels, the first one being the full
+   * size texture.
+   */
+  std::size_t GetLevelsCount() const { return levels.size(); }
+
+  /**
+   * \brief Return the compressed data of a mipmap level.
+   */
+  const std::string& GetLevel(std::size_t level) const {
+    return levels[level];
+  }
+
+  /**
+   * \brief Return the size of the compressed data of all the levels.
+   */
+  std::size_t GetDataSize() const;
+
+ private:
+  unsigned int width;
+  unsigned int height;
+  unsigned int internalFormat;
+  std::vector<std::string> levels;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_KTXIMAGE_H
@@ -6,10 +6,52 @@
 
 #if defined(EMSCRIPTEN)
 #include <emscripten.h>
+#include <atomic>
+#include <unordered_map>
 #include "GDCore/String.h"
 
+namespace {
+/**
+ * \brief The translated strings, by the address of the untranslated string
+ * literals (the same string being translated each time its metadata are
+ * declared).
+ *
+ * Each thread has its own cache, so that the threads translating strings
+ * (when exporting or validating the events) don't need to lock it.
+ */
+struct TranslationsCache {
+  std::unordered_map<const char*, gd::String> translations;
+  unsigned int generation = 0;
+};
+thread_local TranslationsCache translationsCache;
+
+/**
+ * \brief Incremented when the translation function is changed, to tell the
+ * caches of all the threads that their translations are outdated.
+ */
+std::atomic<unsigned int> translationsGeneration(0);
+}  // namespace
+
+/**
+ * \brief Clear the cached translations. Must be called from JavaScript after
+ * Module['getTranslation'] is changed (when the language is changed).
+ */
+extern "C" void EMSCRIPTEN_KEEPALIVE ClearTranslationsCache() {
+  ++translationsGeneration;
+}
+
 namespace gd {
-gd::String GetTranslation(const char* str) {  // TODO: Inline?
+gd::String GetTranslation(const char* str) {
+  unsigned int generation =
+      translationsGeneration.load(std::memory_order_relaxed);
+  if (generation != translationsCache.generation) {
+    translationsCache.translations.clear();
+    translationsCache.generation = generation;
+  }
+
+  auto it = translationsCache.translations.find(str);
+  if (it != translationsCache.translations.end()) return it->second;
+
   const char* translatedStr = (const char*)EM_ASM_INT(
       {
         var getTranslation = Module['getTranslation'];
@@ -29,7 +71,7 @@ gd::String GetTranslation(const char* str) {  // TODO: Inline?
         return ensureString(translatedStr);
       },
       str);
-  return gd::String(translatedStr);  // TODO: Is copying necessary?
+  return translationsCache.translations[str] = gd::String(translatedStr);
 }
 }  // namespace gd
 #endif
\ No newline at end of file
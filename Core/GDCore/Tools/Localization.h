@@ -27,6 +27,13 @@
 #endif
 
 namespace gd {
+/**
+ * \brief Return the translation of a string literal.
+ *
+ * The translations are cached by the address of the literal (in one cache per
+ * thread), until ClearTranslationsCache is called from JavaScript after the
+ * translation function of the module is changed.
+ */
 gd::String GetTranslation(const char* str);
 }
 
@@ -3,25 +3,203 @@
  * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
+#include "GDCore/Tools/Log.h"
+#include <chrono>
 #include <iostream>
 #include "GDCore/String.h"
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+#include <system_error>
+#include <thread>
+#endif
 
 namespace gd {
 
 void GD_CORE_API LogWarning(const gd::String& msg) {
-  std::cout << "WARNING: " << msg;
+  Logger::Get().Log(Logger::Warning, msg);
 }
 
 void GD_CORE_API LogError(const gd::String& msg) {
-  std::cout << "ERROR: " << msg;
+  Logger::Get().Log(Logger::Error, msg);
 }
 
 void GD_CORE_API LogMessage(const gd::String& msg) {
-  std::cout << "MESSAGE: " << msg;
+  Logger::Get().Log(Logger::Message, msg);
 }
 
 void GD_CORE_API LogStatus(const gd::String& msg) {
-  std::cout << "STATUS: " << msg;
+  Logger::Get().Log(Logger::Status, msg);
+}
+
+/**
+ * \brief A bounded multi-producer queue: each slot has a sequence number
+ * telling if it can be written (sequence == position) or read (sequence ==
+ * position + 1), so that producers only compete on the position where they
+ * write.
+ */
+struct Logger::Queue {
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    Level level;
+    long long timestamp;
+    gd::String message;
+  };
+
+  Queue(std::size_t capacity)
+      : slots(new Slot[capacity]),
+        mask(capacity - 1),
+        writePosition(0),
+        readPosition(0),
+        writtenPosition(0),
+        running(true) {
+    for (std::size_t i = 0; i < capacity; ++i)
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  bool Push(Level level, long long timestamp, const gd::String& message) {
+    std::size_t position = writePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots[position & mask];
+      std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence == position) {
+        if (writePosition.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed))
+          break;
+      } else if (sequence < position) {
+        return false;  // The buffer is full.
+      } else {
+        position = writePosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->level = level;
+    slot->timestamp = timestamp;
+    slot->message = message;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Write the messages pushed, from the background thread.
+   * \return true if messages were written.
+   */
+  bool WriteMessages(const Sink& sink) {
+    bool written = false;
+    for (;;) {
+      Slot& slot = slots[readPosition & mask];
+      if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+        break;
+
+      sink(slot.level, slot.timestamp, slot.message);
+      slot.message.clear();
+      slot.sequence.store(readPosition + mask + 1, std::memory_order_release);
+      writtenPosition.store(++readPosition, std::memory_order_release);
+      written = true;
+    }
+
+    return written;
+  }
+
+  std::unique_ptr<Slot[]> slots;
+  std::size_t mask;
+  std::atomic<std::size_t> writePosition;
+  std::size_t readPosition;  ///< Only used by the background thread.
+  std::atomic<std::size_t> writtenPosition;
+  std::atomic<bool> running;
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  std::thread thread;
+#endif
+};
+
+namespace {
+long long GetTimestamp() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+Logger& Logger::Get() {
+  static Logger logger;
+  return logger;
+}
+
+Logger::Logger()
+    : sink(&Logger::WriteToStandardOutput),
+      minimumLevel(Status),
+      droppedMessagesCount(0) {}
+
+Logger::~Logger() { Stop(); }
+
+void Logger::WriteToStandardOutput(Level level,
+                                   long long timestamp,
+                                   const gd::String& message) {
+  static const char* prefixes[] = {"STATUS: ", "MESSAGE: ", "WARNING: ",
+                                   "ERROR: "};
+  std::cout << prefixes[level] << message;
+}
+
+void Logger::Start(std::size_t capacity) {
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  if (queue) return;
+
+  std::size_t roundedCapacity = 2;
+  while (roundedCapacity < capacity) roundedCapacity *= 2;
+  std::unique_ptr<Queue> newQueue(new Queue(roundedCapacity));
+
+  Queue* startedQueue = newQueue.get();
+  const Sink& threadSink = sink;
+  try {
+    newQueue->thread = std::thread([startedQueue, &threadSink]() {
+      while (startedQueue->running.load(std::memory_order_acquire)) {
+        if (!startedQueue->WriteMessages(threadSink))
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      startedQueue->WriteMessages(threadSink);
+    });
+  } catch (const std::system_error&) {
+    return;  // Threads are not available: messages are written when logged.
+  }
+
+  queue = std::move(newQueue);
+#endif
+}
+
+void Logger::Stop() {
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  if (!queue) return;
+
+  queue->running.store(false, std::memory_order_release);
+  queue->thread.join();
+  queue.reset();
+#endif
+}
+
+void Logger::Flush() {
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  if (!queue) return;
+
+  std::size_t position = queue->writePosition.load(std::memory_order_acquire);
+  while (queue->writtenPosition.load(std::memory_order_acquire) < position)
+    std::this_thread::yield();
+#endif
+}
+
+void Logger::SetSink(Sink sink_) {
+  if (queue) return;
+  sink = sink_ ? sink_ : Sink(&Logger::WriteToStandardOutput);
+}
+
+void Logger::Log(Level level, const gd::String& message) {
+  if (!IsLevelEnabled(level)) return;
+
+  if (!queue) {
+    sink(level, GetTimestamp(), message);
+    return;
+  }
+
+  if (!queue->Push(level, GetTimestamp(), message))
+    droppedMessagesCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 }  // namespace gd
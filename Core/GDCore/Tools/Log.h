@@ -5,6 +5,10 @@
  */
 #ifndef GDCORE_LOG_H
 #define GDCORE_LOG_H
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 #include "GDCore/String.h"
 
@@ -33,6 +37,119 @@ void GD_CORE_API LogMessage(const gd::String& msg);
  */
 void GD_CORE_API LogStatus(const gd::String& msg);
 
+/**
+ * \brief Write the messages of the log functions (see gd::LogWarning...).
+ *
+ * By default, messages are written to the standard output when they are
+ * logged. Once Start is called, messages are pushed in a lock-free ring buffer
+ * with their timestamp, and written by a background thread: logging only
+ * costs the formatting of the message, which is itself skipped when the level
+ * of the message is not enabled (see LogLazily).
+ *
+ * When the buffer is full, messages are dropped instead of blocking the
+ * threads logging them (see GetDroppedMessagesCount).
+ *
+ * \note Without threads (Emscripten), messages are always written when they
+ * are logged.
+ */
+class GD_CORE_API Logger {
+ public:
+  enum Level { Status = 0, Message, Warning, Error };
+
+  /**
+   * \brief The function writing a message, with its level and its timestamp
+   * (in nanoseconds, from a steady clock).
+   */
+  typedef std::function<void(
+      Level level, long long timestamp, const gd::String& message)>
+      Sink;
+
+  /**
+   * \brief Return the logger used by the log functions.
+   */
+  static Logger& Get();
+
+  Logger();
+  virtual ~Logger();
+
+  /**
+   * \brief Start writing the messages in a background thread.
+   * \param capacity The number of messages that can wait to be written,
+   * rounded up to a power of two.
+   * \note Start and Stop must not be called while other threads are logging.
+   */
+  void Start(std::size_t capacity = 4096);
+
+  /**
+   * \brief Write the remaining messages and stop the background thread.
+   */
+  void Stop();
+
+  /**
+   * \brief Wait for the messages logged until now to be written.
+   */
+  void Flush();
+
+  /**
+   * \brief Change the function writing the messages.
+   * \note Must not be called while the logger is started.
+   */
+  void SetSink(Sink sink_);
+
+  /**
+   * \brief Only log the messages having at least this level.
+   */
+  void SetMinimumLevel(Level level) {
+    minimumLevel.store(level, std::memory_order_relaxed);
+  }
+
+  bool IsLevelEnabled(Level level) const {
+    return level >= minimumLevel.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * \brief Log a message, if its level is enabled.
+   */
+  void Log(Level level, const gd::String& message);
+
+  /**
+   * \brief Log the message returned by \a format, only called if the level
+   * is enabled.
+   */
+  template <typename FormatFunction>
+  void LogLazily(Level level, FormatFunction format) {
+    if (IsLevelEnabled(level)) Log(level, gd::String(format()));
+  }
+
+  /**
+   * \brief Return the number of messages dropped because the buffer was full.
+   */
+  std::size_t GetDroppedMessagesCount() const {
+    return droppedMessagesCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Queue;
+
+  static void WriteToStandardOutput(Level level,
+                                    long long timestamp,
+                                    const gd::String& message);
+
+  Sink sink;
+  std::atomic<int> minimumLevel;
+  std::atomic<std::size_t> droppedMessagesCount;
+  std::unique_ptr<Queue> queue;  ///< The buffer and the thread, if started.
+};
+
+/**
+ * \brief Log the message returned by \a format, only formatted if the level
+ * is enabled.
+ */
+template <typename FormatFunction>
+void LogLazily(Logger::Level level, FormatFunction format) {
+  Logger::Get().LogLazily(level, format);
+}
+
 }  // namespace gd
 
 #endif  // GDCORE_LOG_H
@@ -0,0 +1,100 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_MODIFICATIONCOUNTER_H
+#define GDCORE_MODIFICATIONCOUNTER_H
+#include <cstddef>
+#include <cstdint>
+
+namespace gd {
+
+/**
+ * \brief The modification count of a list (gd::EventsList,
+ * gd::InstructionsList), counting the changes of the list and of the lists
+ * nested in it.
+ *
+ * A list nested in another one (the sub events, conditions and actions of an
+ * event of the list, the sub instructions of an instruction of the list) has
+ * no count of its own: its counter points to the counter of the parent list,
+ * so that its changes are counted by the root list. The counters are aligned:
+ * the lowest bit of their single word tells if it stores the count of a root
+ * list or the pointer to a parent counter.
+ *
+ * A copy of a counter is not nested and its count is 0, as it's the counter
+ * of a new list.
+ *
+ * \see gd::EventsList::GetModificationCount
+ * \see gd::SPtrList::GetModificationCount
+ */
+class ModificationCounter {
+ public:
+  ModificationCounter() : value(1){};
+  ModificationCounter(const ModificationCounter&) : value(1){};
+  ModificationCounter& operator=(const ModificationCounter&) { return *this; };
+
+  /**
+   * \brief Return the count of the root list (the list itself if it's not
+   * nested in another one).
+   */
+  std::size_t GetCount() const { return GetRoot().value >> 1; }
+
+  /**
+   * \brief Increment the count of the root list.
+   */
+  void Increment() { GetRoot().value += 2; }
+
+  /**
+   * \brief Nest the list in the list of \a parent, so that its changes are
+   * counted by the root of \a parent.
+   *
+   * The count of the root is raised to the count of this list if needed, so
+   * that the count of this list never decreases. Nothing is done if \a parent
+   * is nested in this list.
+   */
+  void SetParent(ModificationCounter& parent) {
+    ModificationCounter* root = &parent;
+    while (!root->IsRoot()) {
+      if (root == this) return;
+      root = root->GetParent();
+    }
+    if (root == this) return;
+
+    std::uintptr_t count = GetCount();
+    if ((root->value >> 1) < count) root->value = (count << 1) | 1;
+    value = reinterpret_cast<std::uintptr_t>(&parent);
+  }
+
+  /**
+   * \brief Stop nesting the list in the list of \a parent, if it is nested in
+   * it. The list keeps the count of the root it was nested in.
+   */
+  void RemoveParent(const ModificationCounter& parent) {
+    if (value != reinterpret_cast<std::uintptr_t>(&parent)) return;
+
+    value = (static_cast<std::uintptr_t>(parent.GetCount()) << 1) | 1;
+  }
+
+ private:
+  bool IsRoot() const { return value & 1; }
+
+  ModificationCounter* GetParent() const {
+    return reinterpret_cast<ModificationCounter*>(value);
+  }
+
+  ModificationCounter& GetRoot() const {
+    const ModificationCounter* counter = this;
+    while (!counter->IsRoot()) counter = counter->GetParent();
+
+    return const_cast<ModificationCounter&>(*counter);
+  }
+
+  std::uintptr_t value;  ///< The count shifted left and with the lowest bit
+                         ///< set for a root list, else the pointer to the
+                         ///< counter of the parent list.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_MODIFICATIONCOUNTER_H
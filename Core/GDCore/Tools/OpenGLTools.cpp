@@ -1,5 +1,15 @@
+#include <SFML/Graphics/Texture.hpp>
 #include <SFML/OpenGL.hpp>
+#include <SFML/Window/Context.hpp>
+#include <algorithm>
 #include <cmath>
+#include <vector>
+#include "GDCore/Tools/KtxImage.h"
+
+#if !defined(GL_NUM_COMPRESSED_TEXTURE_FORMATS)
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS 0x86A2
+#define GL_COMPRESSED_TEXTURE_FORMATS 0x86A3
+#endif
 
 namespace OpenGLTools {
 
@@ -16,4 +26,54 @@ void GD_CORE_API PerspectiveGL(GLdouble fovY,
   glFrustum(-fW, fW, -fH, fH, zNear, zFar);
 }
 
+bool GD_CORE_API UploadCompressedTexture(const gd::KtxImage& image,
+                                         sf::Texture& texture) {
+  if (image.GetLevelsCount() == 0) return false;
+
+  GLint formatsCount = 0;
+  glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatsCount);
+  if (formatsCount <= 0) return false;
+  std::vector<GLint> formats(formatsCount);
+  glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]);
+  if (std::find(formats.begin(),
+                formats.end(),
+                static_cast<GLint>(image.GetInternalFormat())) ==
+      formats.end())
+    return false;
+
+  // Not part of OpenGL 1.1, so it must be loaded (on Windows in particular).
+#if defined(_WIN32)
+  typedef void(__stdcall * CompressedTexImage2D)(
+      GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*);
+#else
+  typedef void (*CompressedTexImage2D)(
+      GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*);
+#endif
+  CompressedTexImage2D compressedTexImage2D =
+      reinterpret_cast<CompressedTexImage2D>(
+          sf::Context::getFunction("glCompressedTexImage2D"));
+  if (!compressedTexImage2D) return false;
+
+  // The texture is created by SFML, then its storage is replaced by the
+  // compressed data.
+  if (!texture.create(image.GetWidth(), image.GetHeight())) return false;
+
+  while (glGetError() != GL_NO_ERROR)
+    ;  // Forget the previous errors.
+  sf::Texture::bind(&texture);
+  const std::string& data = image.GetLevel(0);
+  compressedTexImage2D(GL_TEXTURE_2D,
+                       0,
+                       image.GetInternalFormat(),
+                       image.GetWidth(),
+                       image.GetHeight(),
+                       0,
+                       data.size(),
+                       data.data());
+  bool uploaded = glGetError() == GL_NO_ERROR;
+  sf::Texture::bind(NULL);
+
+  return uploaded;
+}
+
 }  // namespace OpenGLTools
@@ -1,4 +1,10 @@
 #include <SFML/OpenGL.hpp>
+namespace gd {
+class KtxImage;
+}
+namespace sf {
+class Texture;
+}
 
 namespace OpenGLTools {
 
@@ -6,4 +12,18 @@ void GD_CORE_API PerspectiveGL(GLdouble fovY,
                                GLdouble aspect,
                                GLdouble zNear,
                                GLdouble zFar);
+
+/**
+ * \brief Create the texture from a texture in a compressed format of the GPU,
+ * without decoding it.
+ *
+ * Only the first mipmap level is used, as SFML textures have no mipmaps by
+ * default.
+ *
+ * \note Must be called by a thread having an OpenGL context.
+ * \return false if the format is not supported by the GPU (or if the upload
+ * failed): the texture must then be loaded from a decoded image instead.
+ */
+bool GD_CORE_API UploadCompressedTexture(const gd::KtxImage& image,
+                                         sf::Texture& texture);
 }
@@ -10,7 +10,13 @@
 #define GDCORE_SPTRLIST
 
 #include <memory>
+#include <utility>
 #include <vector>
+#include "GDCore/Tools/ModificationCounter.h"
+
+namespace gd {
+class EventsList;
+}
 
 namespace gd {
 
@@ -19,8 +25,10 @@ class SPtrList {
  public:
   SPtrList();
   SPtrList(const SPtrList<T>&);
-  virtual ~SPtrList(){};
+  SPtrList(SPtrList<T>&&);
+  ~SPtrList();
   SPtrList<T>& operator=(const SPtrList<T>& rhs);
+  SPtrList<T>& operator=(SPtrList<T>&& rhs);
 
   /**
    * \brief Insert the specified element to the list
@@ -32,6 +40,13 @@ class SPtrList {
    */
   T& Insert(const T& element, size_t position = (size_t)-1);
 
+  /**
+   * \brief Insert the specified element to the list
+   * \note The element passed by parameter is moved into the list.
+   * \return A reference to the element in the list
+   */
+  T& Insert(T&& element, size_t position = (size_t)-1);
+
   /**
    * \brief Insert the specified element to the list.
    * \note The element passed by parameter is not copied.
@@ -90,7 +105,20 @@ class SPtrList {
   /**
    * \brief Clear the list of elements.
    */
-  void Clear() { return elements.clear(); };
+  void Clear();
+
+  /**
+   * \brief Return a number incremented each time elements are inserted in or
+   * removed from the list, or from the lists nested in it (the sub
+   * instructions of its instructions).
+   *
+   * The count of a list nested in another one is the count of the root list:
+   * it's incremented by the changes of any of the lists of the root list.
+   *
+   * \note Changes made to the elements themselves are not counted.
+   * \see gd::ModificationCounter
+   */
+  size_t GetModificationCount() const { return modificationCounter.GetCount(); }
 
   /** \name Utilities
    * Utility methods
@@ -147,6 +175,10 @@ class SPtrList {
   ///@}
 
  protected:
+  gd::ModificationCounter modificationCounter;  ///< Declared before the
+                                               ///< elements as their lists
+                                               ///< can use it when they are
+                                               ///< destroyed.
   std::vector<std::shared_ptr<T> > elements;
 
   /**
@@ -154,6 +186,27 @@ class SPtrList {
    * copy-ctor and assign-op. Don't forget to update me if members were changed!
    */
   void Init(const SPtrList<T>& other);
+
+  /**
+   * Nest the lists of the element in this list, so that their changes are
+   * counted by this list. Does nothing by default: specialized for the
+   * elements having lists.
+   */
+  void NestElementLists(T& element) {}
+
+  /**
+   * Stop nesting the lists of the element in this list, for an element that is
+   * removed from the list but can still be used.
+   */
+  void UnnestElementLists(T& element) {}
+
+  /**
+   * Stop nesting the lists of the elements that are still used elsewhere,
+   * before they are removed from the list.
+   */
+  void UnnestSharedElementsLists();
+
+  friend class gd::EventsList;  // Nests the instructions of its events.
 };
 
 }  // namespace gd
@@ -11,6 +11,12 @@ namespace gd {
 template <typename T>
 SPtrList<T>::SPtrList() {}
 
+template <typename T>
+SPtrList<T>::~SPtrList() {
+  // The elements still used elsewhere must not point to this list anymore.
+  UnnestSharedElementsLists();
+}
+
 template <typename T>
 void SPtrList<T>::Insert(const SPtrList<T>& otherElements,
                          size_t begin,
@@ -21,45 +27,67 @@ void SPtrList<T>::Insert(const SPtrList<T>& otherElements,
   if (end >= otherElements.size()) end = otherElements.size() - 1;
 
   for (std::size_t insertPos = 0; insertPos <= (end - begin); insertPos++) {
+    std::shared_ptr<T> element = CloneRememberingOriginalElement(
+        otherElements.elements[begin + insertPos]);
+    NestElementLists(*element);
     if (position != (size_t)-1 && position + insertPos < elements.size())
-      elements.insert(elements.begin() + position + insertPos,
-                      CloneRememberingOriginalElement(
-                          otherElements.elements[begin + insertPos]));
+      elements.insert(elements.begin() + position + insertPos, element);
     else
-      elements.push_back(CloneRememberingOriginalElement(
-          otherElements.elements[begin + insertPos]));
+      elements.push_back(element);
   }
+  modificationCounter.Increment();
 }
 
 template <typename T>
 T& SPtrList<T>::Insert(const T& evt, size_t position) {
   std::shared_ptr<T> element = std::make_shared<T>(evt);
+  NestElementLists(*element);
   if (position < elements.size())
     elements.insert(elements.begin() + position, element);
   else
     elements.push_back(element);
+  modificationCounter.Increment();
+
+  return *element;
+}
+
+template <typename T>
+T& SPtrList<T>::Insert(T&& evt, size_t position) {
+  std::shared_ptr<T> element = std::make_shared<T>(std::move(evt));
+  NestElementLists(*element);
+  if (position < elements.size())
+    elements.insert(elements.begin() + position, element);
+  else
+    elements.push_back(element);
+  modificationCounter.Increment();
 
   return *element;
 }
 
 template <typename T>
 void SPtrList<T>::Insert(std::shared_ptr<T> element, size_t position) {
+  NestElementLists(*element);
   if (position < elements.size())
     elements.insert(elements.begin() + position, element);
   else
     elements.push_back(element);
+  modificationCounter.Increment();
 }
 
 template <typename T>
 void SPtrList<T>::Remove(size_t index) {
+  UnnestElementLists(*elements[index]);
   elements.erase(elements.begin() + index);
+  modificationCounter.Increment();
 }
 
 template <typename T>
 void SPtrList<T>::Remove(const T& element) {
   for (size_t i = 0; i < elements.size(); ++i) {
     if (elements[i].get() == &element) {
+      UnnestElementLists(*elements[i]);
       elements.erase(elements.begin() + i);
+      modificationCounter.Increment();
       return;
     }
   }
@@ -74,11 +102,25 @@ bool SPtrList<T>::Contains(const T& elementToSearch) const {
   return false;
 }
 
+template <typename T>
+void SPtrList<T>::Clear() {
+  UnnestSharedElementsLists();
+  elements.clear();
+  modificationCounter.Increment();
+}
+
 template <typename T>
 SPtrList<T>::SPtrList(const SPtrList<T>& other) {
   Init(other);
 }
 
+template <typename T>
+SPtrList<T>::SPtrList(SPtrList<T>&& other)
+    : elements(std::move(other.elements)) {
+  // The lists of the elements were nested in the other list.
+  for (auto& element : elements) NestElementLists(*element);
+}
+
 template <typename T>
 SPtrList<T>& SPtrList<T>::operator=(const SPtrList<T>& other) {
   if (this != &other) Init(other);
@@ -86,11 +128,35 @@ SPtrList<T>& SPtrList<T>::operator=(const SPtrList<T>& other) {
   return *this;
 }
 
+template <typename T>
+SPtrList<T>& SPtrList<T>::operator=(SPtrList<T>&& other) {
+  if (this == &other) return *this;
+
+  // Don't take the modification count of the other list, so that the count of
+  // this list is still increasing.
+  UnnestSharedElementsLists();
+  elements = std::move(other.elements);
+  for (auto& element : elements) NestElementLists(*element);
+  modificationCounter.Increment();
+
+  return *this;
+}
+
 template <typename T>
 void SPtrList<T>::Init(const gd::SPtrList<T>& other) {
+  UnnestSharedElementsLists();
   elements.clear();
-  for (size_t i = 0; i < other.elements.size(); ++i)
+  for (size_t i = 0; i < other.elements.size(); ++i) {
     elements.push_back(std::make_shared<T>(other[i]));
+    NestElementLists(*elements.back());
+  }
+  modificationCounter.Increment();
+}
+
+template <typename T>
+void SPtrList<T>::UnnestSharedElementsLists() {
+  for (auto& element : elements)
+    if (element.use_count() > 1) UnnestElementLists(*element);
 }
 
 }  // namespace gd
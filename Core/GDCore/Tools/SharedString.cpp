@@ -0,0 +1,99 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/SharedString.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct StringPointerHash {
+  std::size_t operator()(const gd::String* string) const {
+    return std::hash<gd::String>()(*string);
+  }
+};
+
+struct StringPointerEqual {
+  bool operator()(const gd::String* a, const gd::String* b) const {
+    return *a == *b;
+  }
+};
+
+/**
+ * \brief The shared strings, indexed by their content (the key points to
+ * the storage of the string, so that the content is not stored twice).
+ */
+struct StringsPool {
+  std::mutex mutex;
+  std::unordered_map<const gd::String*,
+                     std::weak_ptr<const gd::String>,
+                     StringPointerHash,
+                     StringPointerEqual>
+      strings;
+};
+
+StringsPool& GetPool() {
+  // Never destroyed, as shared strings can be destroyed by static
+  // destructors.
+  static StringsPool* pool = new StringsPool;
+  return *pool;
+}
+
+const std::shared_ptr<const gd::String>& GetEmptyString() {
+  static std::shared_ptr<const gd::String>* emptyString =
+      new std::shared_ptr<const gd::String>(std::make_shared<gd::String>());
+  return *emptyString;
+}
+
+/**
+ * \brief Remove the storage of a shared string from the pool when it is no
+ * longer used.
+ */
+void ReleaseString(const gd::String* string) {
+  StringsPool& pool = GetPool();
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto it = pool.strings.find(string);
+    // The entry can have been replaced by a new storage for the same content
+    // while this one was being released.
+    if (it != pool.strings.end() && it->first == string) pool.strings.erase(it);
+  }
+  delete string;
+}
+
+}  // namespace
+
+namespace gd {
+
+SharedString::SharedString() : string(GetEmptyString()) {}
+
+std::shared_ptr<const gd::String> SharedString::Intern(
+    const gd::String& string) {
+  if (string.empty()) return GetEmptyString();
+
+  StringsPool& pool = GetPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  auto it = pool.strings.find(&string);
+  if (it != pool.strings.end()) {
+    std::shared_ptr<const gd::String> sharedString = it->second.lock();
+    if (sharedString) return sharedString;
+
+    pool.strings.erase(it);  // Being released.
+  }
+
+  std::shared_ptr<const gd::String> sharedString(new gd::String(string),
+                                                   ReleaseString);
+  pool.strings[sharedString.get()] = sharedString;
+  return sharedString;
+}
+
+std::size_t SharedString::GetSharedStringsCount() {
+  StringsPool& pool = GetPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.strings.size();
+}
+
+}  // namespace gd
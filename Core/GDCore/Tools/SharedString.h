@@ -0,0 +1,76 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_SHAREDSTRING_H
+#define GDCORE_SHAREDSTRING_H
+#include <cstddef>
+#include <memory>
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief An immutable string whose storage is shared by all the shared
+ * strings with the same content.
+ *
+ * Used for the identifier-like members repeated in a project (the types of
+ * the instructions and the behaviors, the objects and the layers of the
+ * initial instances...), so that a loaded project keeps only one copy of
+ * each of them. As the storage is unique, two shared strings are compared
+ * by comparing their storage.
+ *
+ * The storage is freed when the last shared string using it is destroyed.
+ * This is unlike the InternedString of the C++ platform runtime (the names
+ * of the layers and of the behaviors of a running game), which are never
+ * released, are only constructed explicitly and store the hash of the
+ * string: the project edited in the IDE can be changed at any time, so the
+ * strings that are no longer used must be released instead.
+ *
+ * \note Sharing a string is thread-safe.
+ * \ingroup Tools
+ */
+class GD_CORE_API SharedString {
+ public:
+  SharedString();
+  SharedString(const gd::String& string_) : string(Intern(string_)){};
+  SharedString(const char* string_) : string(Intern(string_)){};
+
+  SharedString& operator=(const gd::String& string_) {
+    string = Intern(string_);
+    return *this;
+  }
+
+  /**
+   * \brief Return the content of the string.
+   */
+  const gd::String& Get() const { return *string; }
+  operator const gd::String&() const { return *string; }
+
+  bool empty() const { return string->empty(); }
+
+  bool operator==(const SharedString& other) const {
+    return string == other.string;
+  }
+  bool operator!=(const SharedString& other) const {
+    return string != other.string;
+  }
+  bool operator==(const gd::String& other) const { return *string == other; }
+  bool operator!=(const gd::String& other) const { return *string != other; }
+  bool operator==(const char* other) const { return *string == other; }
+  bool operator!=(const char* other) const { return *string != other; }
+
+  /**
+   * \brief Return the number of different strings currently shared.
+   */
+  static std::size_t GetSharedStringsCount();
+
+ private:
+  static std::shared_ptr<const gd::String> Intern(const gd::String& string);
+
+  std::shared_ptr<const gd::String> string;
+};
+
+}  // namespace gd
+#endif  // GDCORE_SHAREDSTRING_H
@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "SystemStats.h"
+#include <atomic>
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
@@ -14,6 +15,22 @@
 
 namespace gd {
 
+namespace {
+// Function local statics are used so that memory can be accounted during the
+// static initialization.
+std::atomic<std::size_t>* GetUsedMemories() {
+  static std::atomic<std::size_t>
+      usedMemories[SystemStats::MemoryCategoriesCount];
+  return usedMemories;
+}
+
+std::atomic<std::size_t>* GetHighWaterMarks() {
+  static std::atomic<std::size_t>
+      highWaterMarks[SystemStats::MemoryCategoriesCount];
+  return highWaterMarks;
+}
+}  // namespace
+
 int parseLine(char* line) {
   int i = strlen(line);
   while (*line < '0' || *line > '9') line++;
@@ -48,4 +65,50 @@ size_t SystemStats::GetUsedVirtualMemory() {
 #endif
 }
 
+void SystemStats::AddUsedMemory(MemoryCategory category, std::size_t bytes) {
+  std::size_t usedMemory = GetUsedMemories()[category].fetch_add(bytes) + bytes;
+
+  std::atomic<std::size_t>& highWaterMark = GetHighWaterMarks()[category];
+  std::size_t previousMark = highWaterMark.load();
+  while (previousMark < usedMemory &&
+         !highWaterMark.compare_exchange_weak(previousMark, usedMemory))
+    ;
+}
+
+void SystemStats::RemoveUsedMemory(MemoryCategory category, std::size_t bytes) {
+  GetUsedMemories()[category].fetch_sub(bytes);
+}
+
+std::size_t SystemStats::GetUsedMemory(MemoryCategory category) {
+  return GetUsedMemories()[category].load();
+}
+
+std::size_t SystemStats::GetUsedMemoryHighWaterMark(MemoryCategory category) {
+  return GetHighWaterMarks()[category].load();
+}
+
+void SystemStats::ResetUsedMemoryHighWaterMarks() {
+  for (std::size_t i = 0; i < MemoryCategoriesCount; ++i)
+    GetHighWaterMarks()[i].store(GetUsedMemories()[i].load());
+}
+
+const char* SystemStats::GetMemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+    case Textures:
+      return "Textures";
+    case Sounds:
+      return "Sounds";
+    case Objects:
+      return "Objects";
+    case Variables:
+      return "Variables";
+    case ParticleSystems:
+      return "Particle systems";
+    case Physics:
+      return "Physics";
+    default:
+      return "Unknown";
+  }
+}
+
 }  // namespace gd
@@ -3,7 +3,6 @@
  * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
-#if defined(GD_IDE_ONLY)
 #ifndef GDCORE_SYSTEMSTATS_H
 #define GDCORE_SYSTEMSTATS_H
 #include <cstddef>
@@ -13,21 +12,117 @@ namespace gd {
 /**
  * \brief Tool class to provide information about the system.
  *
+ * The memory used by the main subsystems of the game engine is accounted in
+ * categories, so that it can be known which one uses the memory of a game
+ * (see GetUsedMemory). The accounting is done by the subsystems themselves,
+ * usually with a gd::MemoryAccount: the values are estimations of the memory
+ * of their main allocations, not of every allocation.
+ *
  * \ingroup Tools
  */
 class GD_CORE_API SystemStats {
  public:
+  /**
+   * \brief The categories of the memory accounted.
+   */
+  enum MemoryCategory {
+    Textures = 0,     ///< The textures and images of gd::ImageManager.
+    Sounds,           ///< The sound buffers and the musics loaded in memory.
+    Objects,          ///< The objects instances (without their variables).
+    Variables,        ///< The variables of the scenes and of the objects.
+    ParticleSystems,  ///< The particles of the particle emitters.
+    Physics,          ///< The bodies and contacts of the physics worlds.
+    MemoryCategoriesCount
+  };
+
   /**
    * Return the virtual memory used by the process, in KB.
    * @return 0 if the information is not available
    */
   static size_t GetUsedVirtualMemory();
 
+  /**
+   * \brief Account memory allocated by a subsystem, in bytes.
+   * \note Can be called by any thread.
+   */
+  static void AddUsedMemory(MemoryCategory category, std::size_t bytes);
+
+  /**
+   * \brief Account memory freed by a subsystem, in bytes.
+   * \note Can be called by any thread.
+   */
+  static void RemoveUsedMemory(MemoryCategory category, std::size_t bytes);
+
+  /**
+   * \brief Return the memory currently accounted in a category, in bytes.
+   */
+  static std::size_t GetUsedMemory(MemoryCategory category);
+
+  /**
+   * \brief Return the maximum memory accounted in a category since the start
+   * of the process (or the last call to ResetUsedMemoryHighWaterMarks), in
+   * bytes.
+   */
+  static std::size_t GetUsedMemoryHighWaterMark(MemoryCategory category);
+
+  /**
+   * \brief Reset the high-water marks to the memory currently accounted.
+   */
+  static void ResetUsedMemoryHighWaterMarks();
+
+  /**
+   * \brief Return the name of a category, in English.
+   */
+  static const char* GetMemoryCategoryName(MemoryCategory category);
+
  private:
   SystemStats(){};
   virtual ~SystemStats(){};
 };
 
+/**
+ * \brief The memory accounted for an object (a texture, a sound...) in a
+ * category of gd::SystemStats.
+ *
+ * The memory is removed from the category when the account is destroyed.
+ * Copying an account accounts the same memory again, as the object owning it
+ * is copied.
+ *
+ * \ingroup Tools
+ */
+class GD_CORE_API MemoryAccount {
+ public:
+  MemoryAccount(SystemStats::MemoryCategory category_)
+      : category(category_), bytes(0){};
+  MemoryAccount(const MemoryAccount& other)
+      : category(other.category), bytes(0) {
+    SetBytes(other.bytes);
+  };
+  MemoryAccount& operator=(const MemoryAccount& other) {
+    SetBytes(other.bytes);  // The category is kept.
+    return *this;
+  }
+  ~MemoryAccount() { SetBytes(0); };
+
+  /**
+   * \brief Change the memory accounted, in bytes.
+   */
+  void SetBytes(std::size_t newBytes) {
+    if (newBytes > bytes)
+      SystemStats::AddUsedMemory(category, newBytes - bytes);
+    else if (newBytes < bytes)
+      SystemStats::RemoveUsedMemory(category, bytes - newBytes);
+    bytes = newBytes;
+  }
+
+  void AddBytes(std::size_t addedBytes) { SetBytes(bytes + addedBytes); }
+
+  std::size_t GetBytes() const { return bytes; }
+
+ private:
+  SystemStats::MemoryCategory category;
+  std::size_t bytes;
+};
+
 }  // namespace gd
 #endif  // GDCORE_SYSTEMSTATS_H
-#endif
@@ -0,0 +1,50 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/Threads.h"
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+#include <atomic>
+#include <system_error>
+#include <thread>
+#endif
+
+namespace gd {
+
+void CallOnThreads(const std::vector<std::function<void()> >& functions,
+                   std::size_t threadsCount) {
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  std::atomic<std::size_t> nextFunction(0);
+  auto callFunctions = [&functions, &nextFunction]() {
+    for (std::size_t i = nextFunction++; i < functions.size();
+         i = nextFunction++)
+      functions[i]();
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < threadsCount && i < functions.size(); ++i) {
+    try {
+      threads.push_back(std::thread(callFunctions));
+    } catch (const std::system_error&) {
+      break;  // Threads are not available: use the threads started.
+    }
+  }
+
+  callFunctions();
+  for (auto& thread : threads) thread.join();
+#else
+  for (const auto& function : functions) function();
+#endif
+}
+
+std::size_t GetHardwareThreadsCount() {
+#if !defined(EMSCRIPTEN) || defined(GD_EMSCRIPTEN_THREADS)
+  std::size_t count = std::thread::hardware_concurrency();
+  return count ? count : 1;
+#else
+  return 1;
+#endif
+}
+
+}  // namespace gd
@@ -0,0 +1,38 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_THREADS_H
+#define GDCORE_THREADS_H
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief Call the functions on the specified number of threads, including the
+ * calling thread. The threads claim the functions to call (in order) until
+ * none is left, and the function returns once all of them are called.
+ *
+ * The functions are called by the calling thread only with Emscripten (unless
+ * built with EMSCRIPTEN_THREADS) or if threads can't be started.
+ *
+ * \ingroup Tools
+ */
+void GD_CORE_API CallOnThreads(
+    const std::vector<std::function<void()> >& functions,
+    std::size_t threadsCount);
+
+/**
+ * \brief Return the number of threads that can run at the same time on the
+ * system (at least 1).
+ *
+ * \ingroup Tools
+ */
+std::size_t GD_CORE_API GetHardwareThreadsCount();
+
+}  // namespace gd
+
+#endif  // GDCORE_THREADS_H
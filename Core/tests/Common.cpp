@@ -12,6 +12,7 @@
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Serialization.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/Variable.h"
 #include "GDCore/Serialization/Serializer.h"
@@ -26,6 +27,30 @@ TEST_CASE("Project", "[common]") {
     REQUIRE(project.GetName() == "myname");
   }
 }
+
+TEST_CASE("ObjectsContainer", "[common]") {
+  SECTION("Lookup by name") {
+    gd::Layout layout;
+    layout.InsertObject(gd::Object("Object1"), 0);
+    layout.InsertObject(gd::Object("Object2"), 1);
+    REQUIRE(layout.HasObjectNamed("Object1") == true);
+    REQUIRE(layout.GetObjectPosition("Object2") == 1);
+    REQUIRE(layout.HasObjectNamed("Object3") == false);
+
+    layout.SwapObjects(0, 1);
+    REQUIRE(layout.GetObjectPosition("Object2") == 0);
+    REQUIRE(layout.GetObject("Object1").GetName() == "Object1");
+
+    layout.GetObject("Object2").SetName("Object3");
+    REQUIRE(layout.HasObjectNamed("Object2") == false);
+    REQUIRE(layout.GetObjectPosition("Object3") == 0);
+
+    layout.RemoveObject("Object3");
+    REQUIRE(layout.GetObjectPosition("Object1") == 0);
+    REQUIRE(layout.HasObjectNamed("Object3") == false);
+  }
+}
+
 TEST_CASE("EventsList", "[common][events]") {
   SECTION("Basics") {
     gd::EventsList list;
@@ -79,6 +104,36 @@ TEST_CASE("EventsList", "[common][events]") {
   }
 }
 
+TEST_CASE("SystemStats", "[common]") {
+  SECTION("Memory accounts") {
+    gd::SystemStats::MemoryCategory category = gd::SystemStats::Sounds;
+    std::size_t startMemory = gd::SystemStats::GetUsedMemory(category);
+    gd::SystemStats::ResetUsedMemoryHighWaterMarks();
+    {
+      gd::MemoryAccount account(category);
+      account.SetBytes(1000);
+      REQUIRE(gd::SystemStats::GetUsedMemory(category) == startMemory + 1000);
+
+      gd::MemoryAccount copiedAccount(account);
+      REQUIRE(copiedAccount.GetBytes() == 1000);
+      REQUIRE(gd::SystemStats::GetUsedMemory(category) == startMemory + 2000);
+
+      account.SetBytes(500);
+      copiedAccount.AddBytes(100);
+      REQUIRE(gd::SystemStats::GetUsedMemory(category) == startMemory + 1600);
+    }
+    REQUIRE(gd::SystemStats::GetUsedMemory(category) == startMemory);
+    REQUIRE(gd::SystemStats::GetUsedMemoryHighWaterMark(category) ==
+            startMemory + 2000);
+
+    gd::SystemStats::ResetUsedMemoryHighWaterMarks();
+    REQUIRE(gd::SystemStats::GetUsedMemoryHighWaterMark(category) ==
+            startMemory);
+    REQUIRE(gd::String(gd::SystemStats::GetMemoryCategoryName(category)) ==
+            "Sounds");
+  }
+}
+
 TEST_CASE("VersionWrapper", "[common]") {
   REQUIRE(gd::VersionWrapper::IsOlder(1, 9, 9, 9, 2, 0, 0, 0) == true);
   REQUIRE(gd::VersionWrapper::IsOlder(2, 0, 0, 0, 1, 9, 9, 9) == false);
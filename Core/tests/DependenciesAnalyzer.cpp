@@ -8,6 +8,7 @@
  */
 #include "GDCore/IDE/DependenciesAnalyzer.h"
 #include "GDCore/Events/Builtin/LinkEvent.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/Layout.h"
@@ -141,4 +142,51 @@ TEST_CASE("DependenciesAnalyzer", "[common]") {
     DependenciesAnalyzer analyzer(project, layout3);
     REQUIRE(analyzer.Analyze() == false);
   }
+
+  SECTION("Can analyze external events linked several times") {
+    gd::Project project;
+    auto& layout1 = project.InsertNewLayout("Layout1", 0);
+    auto& layout2 = project.InsertNewLayout("Layout2", 1);
+    auto& externalEvents1 =
+        project.InsertNewExternalEvents("ExternalEvents1", 0);
+    auto& externalEvents2 =
+        project.InsertNewExternalEvents("ExternalEvents2", 0);
+    auto& externalEvents3 =
+        project.InsertNewExternalEvents("ExternalEvents3", 0);
+    project.InsertNewExternalEvents("ExternalEvents4", 0);
+
+    // Layout1 links ExternalEvents1 and ExternalEvents2, which both link
+    // ExternalEvents3 (at the top level for ExternalEvents1, in a sub event
+    // for ExternalEvents2). ExternalEvents3 links ExternalEvents4.
+    gd::LinkEvent linkEvent;
+    linkEvent.SetTarget("ExternalEvents1");
+    layout1.GetEvents().InsertEvent(linkEvent);
+    linkEvent.SetTarget("ExternalEvents2");
+    layout1.GetEvents().InsertEvent(linkEvent);
+    linkEvent.SetTarget("ExternalEvents3");
+    externalEvents1.GetEvents().InsertEvent(linkEvent);
+    gd::StandardEvent standardEvent;
+    standardEvent.GetSubEvents().InsertEvent(linkEvent);
+    externalEvents2.GetEvents().InsertEvent(standardEvent);
+    linkEvent.SetTarget("ExternalEvents4");
+    externalEvents3.GetEvents().InsertEvent(linkEvent);
+    layout2.GetEvents().InsertEvent(linkEvent);
+
+    DependenciesAnalyzer analyzer(project, layout1);
+    REQUIRE(analyzer.Analyze() == true);
+    REQUIRE(analyzer.GetExternalEventsDependencies().size() == 4);
+    REQUIRE(analyzer.GetNotTopLevelExternalEventsDependencies().size() == 2);
+    REQUIRE(analyzer.GetNotTopLevelExternalEventsDependencies().count(
+                "ExternalEvents3") == 1);
+    REQUIRE(analyzer.GetNotTopLevelExternalEventsDependencies().count(
+                "ExternalEvents4") == 1);
+
+    DependenciesAnalyzer analyzer1(project, externalEvents1);
+    REQUIRE(analyzer1.ExternalEventsCanBeCompiledForAScene() == "Layout1");
+    DependenciesAnalyzer analyzer3(project, externalEvents3);
+    REQUIRE(analyzer3.ExternalEventsCanBeCompiledForAScene() == "");
+    DependenciesAnalyzer analyzer4(
+        project, project.GetExternalEvents("ExternalEvents4"));
+    REQUIRE(analyzer4.ExternalEventsCanBeCompiledForAScene() == "Layout2");
+  }
 }
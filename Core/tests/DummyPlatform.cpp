@@ -36,6 +36,7 @@ void SetupProjectWithDummyPlatform(gd::Project &project,
       .AddParameter("expression", "Parameter 1 (a number)")
       .SetFunctionName("doSomething");
   extension->AddExpression("GetNumber", "Get me a number", "", "", "")
+      .SetSideEffectFree()
       .SetFunctionName("getNumber");
   extension
       ->AddExpression(
@@ -94,6 +95,7 @@ void SetupProjectWithDummyPlatform(gd::Project &project,
       .SetFunctionName("returnVariable");
   object.AddExpression("GetObjectNumber", "Get number from object", "", "", "")
       .AddParameter("object", _("Object"), "Sprite")
+      .SetSideEffectFree()
       .SetFunctionName("getObjectNumber");
   object
       .AddStrExpression("GetObjectStringWith1Param",
@@ -44,6 +44,122 @@ TEST_CASE("Events", "[common][events]") {
     REQUIRE(list[1].GetType() == "ChangedInstructionType");
   }
 
+  SECTION("Instructions and parameters moves") {
+    // Parameters are long enough to not be stored inline in the string, so
+    // that a copy can be detected by a change of the address of the
+    // characters.
+    gd::Expression expression("A long enough parameter, not copied");
+    const char* characters = expression.c_str();
+    gd::Instruction instr("InstructionType");
+    instr.SetParametersCount(2);
+    instr.SetParameter(1, std::move(expression));
+    REQUIRE(instr.GetParameter(1).c_str() == characters);
+
+    std::vector<gd::Expression> parameters;
+    parameters.push_back(gd::Expression("Another long parameter, not copied"));
+    const char* parametersCharacters = parameters[0].c_str();
+    instr.SetParameters(std::move(parameters));
+    REQUIRE(instr.GetParameter(0).c_str() == parametersCharacters);
+
+    gd::InstructionsList list;
+    gd::Instruction& inserted = list.Insert(std::move(instr));
+    REQUIRE(inserted.GetParameter(0).c_str() == parametersCharacters);
+
+    gd::InstructionsList movedList = std::move(list);
+    REQUIRE(&movedList[0] == &inserted);
+
+    // Copies are still independent.
+    gd::InstructionsList copiedList = movedList;
+    REQUIRE(copiedList[0].GetParameter(0).c_str() != parametersCharacters);
+    REQUIRE(copiedList[0].GetParameter(0).GetPlainString() ==
+            "Another long parameter, not copied");
+  }
+
+  SECTION("Modification counts") {
+    gd::Layout layout;
+    gd::EventsList& events = layout.GetEvents();
+    std::size_t layoutCount = layout.GetModificationCount();
+
+    gd::StandardEvent event;
+    events.InsertEvent(event);
+    REQUIRE(events.GetModificationCount() > 0);
+    std::size_t eventsCount = events.GetModificationCount();
+    REQUIRE(layout.GetModificationCount() > layoutCount);
+    layoutCount = layout.GetModificationCount();
+
+    // The changes of the nested lists are counted by the root list.
+    gd::InstructionsList& actions =
+        dynamic_cast<gd::StandardEvent&>(events[0]).GetActions();
+    actions.Insert(gd::Instruction("InstructionType"));
+    actions.Insert(gd::Instruction("InstructionType"));
+    REQUIRE(events.GetModificationCount() == eventsCount + 2);
+    REQUIRE(actions.GetModificationCount() == eventsCount + 2);
+    actions.Remove(0);
+    REQUIRE(events.GetModificationCount() == eventsCount + 3);
+
+    actions[0].GetSubInstructions().Insert(gd::Instruction("SubInstruction"));
+    REQUIRE(events.GetModificationCount() == eventsCount + 4);
+    events[0].GetSubEvents().InsertEvent(event);
+    REQUIRE(events.GetModificationCount() == eventsCount + 5);
+    dynamic_cast<gd::StandardEvent&>(events[0].GetSubEvents()[0])
+        .GetConditions()
+        .Insert(gd::Instruction("InstructionType"));
+    REQUIRE(events.GetModificationCount() == eventsCount + 6);
+    REQUIRE(layout.GetModificationCount() > layoutCount);
+    layoutCount = layout.GetModificationCount();
+
+    // Changes to the elements are not counted...
+    actions[0].SetType("ChangedInstructionType");
+    REQUIRE(events.GetModificationCount() == eventsCount + 6);
+
+    // ...but replacing a list is, even when moving another list.
+    gd::InstructionsList otherActions;
+    otherActions.Insert(gd::Instruction("InstructionType"))
+        .GetSubInstructions()
+        .Insert(gd::Instruction("SubInstruction"));
+    actions = otherActions;
+    REQUIRE(events.GetModificationCount() == eventsCount + 7);
+    actions = std::move(otherActions);
+    REQUIRE(events.GetModificationCount() == eventsCount + 8);
+    actions[0].GetSubInstructions().Clear();
+    REQUIRE(events.GetModificationCount() == eventsCount + 9);
+
+    // The events removed from the list are not nested in it anymore, even
+    // when they are still used after the list is destroyed.
+    std::shared_ptr<gd::BaseEvent> removedEvent = events.GetEventSmartPtr(0);
+    events.RemoveEvent(0);
+    REQUIRE(events.GetModificationCount() == eventsCount + 10);
+    removedEvent->GetSubEvents().Clear();
+    REQUIRE(events.GetModificationCount() == eventsCount + 10);
+    REQUIRE(removedEvent->GetSubEvents().GetModificationCount() ==
+            eventsCount + 10);
+    {
+      gd::EventsList otherEvents;
+      otherEvents.InsertEvent(removedEvent);
+      removedEvent->GetSubEvents().InsertEvent(event);
+      REQUIRE(otherEvents.GetModificationCount() ==
+              removedEvent->GetSubEvents().GetModificationCount());
+    }
+    std::size_t removedEventCount =
+        removedEvent->GetSubEvents().GetModificationCount();
+    removedEvent->GetSubEvents().RemoveEvent(0);
+    REQUIRE(removedEvent->GetSubEvents().GetModificationCount() ==
+            removedEventCount + 1);
+
+    events = gd::EventsList();
+    REQUIRE(events.GetModificationCount() == eventsCount + 11);
+    REQUIRE(layout.GetModificationCount() > layoutCount);
+    layoutCount = layout.GetModificationCount();
+
+    layout.GetVariables().InsertNew("Variable", 0);
+    REQUIRE(layout.GetModificationCount() > layoutCount);
+    layoutCount = layout.GetModificationCount();
+
+    gd::Layout otherLayout;
+    layout = otherLayout;
+    REQUIRE(layout.GetModificationCount() > layoutCount);
+  }
+
   SECTION("StandardEvent") {
     gd::Instruction instr("InstructionType");
     gd::StandardEvent event;
@@ -123,6 +123,12 @@ TEST_CASE("EventsCodeGenerationContext", "[common][events]") {
     REQUIRE(c3.ObjectAlreadyDeclared("some object") == false);
     c3.SetObjectDeclared("some object");
     REQUIRE(c3.ObjectAlreadyDeclared("some object") == true);
+
+    // The declared lists are only shared with the parent and the siblings
+    // until they are modified.
+    REQUIRE(c1.ObjectAlreadyDeclared("some object") == false);
+    REQUIRE(c2.ObjectAlreadyDeclared("some object") == false);
+    REQUIRE(c5.ObjectAlreadyDeclared("some object") == false);
   }
 
   SECTION("Object list last depth") {
@@ -134,6 +140,11 @@ TEST_CASE("EventsCodeGenerationContext", "[common][events]") {
     REQUIRE(c5.GetLastDepthObjectListWasNeeded("c2.object1") == 1);
     REQUIRE(c5.GetLastDepthObjectListWasNeeded("c5.object1") == 2);
     REQUIRE(c5.GetLastDepthObjectListWasNeeded("c5.empty1") == 2);
+
+    // Needing a list in a child context does not change the depth in the
+    // parent contexts.
+    REQUIRE(c1.GetLastDepthObjectListWasNeeded("c1.object2") == 0);
+    REQUIRE(c2.GetLastDepthObjectListWasNeeded("c1.object2") == 0);
   }
 
   SECTION("SetCurrentObject") {
@@ -8,13 +8,36 @@
  */
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
 #include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/ObjectGroup.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Tools/VersionWrapper.h"
+#include "DummyPlatform.h"
 #include "catch.hpp"
 
+namespace {
+
+class CodeGeneratorForSetters : public gd::EventsCodeGenerator {
+ public:
+  CodeGeneratorForSetters(gd::Project& project,
+                          gd::Layout& layout,
+                          const gd::Platform& platform)
+      : gd::EventsCodeGenerator(project, layout, platform){};
+
+  using gd::EventsCodeGenerator::GenerateSettersCall;
+};
+
+}  // namespace
+
 TEST_CASE("EventsCodeGenerator", "[common][events]") {
   SECTION("Basics") {
     gd::Project project;
@@ -31,4 +54,194 @@ TEST_CASE("EventsCodeGenerator", "[common][events]") {
     REQUIRE(codeGenerator.ConvertToString("{\"hello\":\r\n\"world \\\" \"}") ==
             "{\\\"hello\\\":\\r\\n\\\"world \\\\\\\" \\\"}");
   }
+  SECTION("Code is appended to the output") {
+    gd::Project project;
+    auto& layout = project.InsertNewLayout("Layout 1", 0);
+    gd::Platform platform;
+    gd::EventsCodeGenerator codeGenerator(project, layout, platform);
+
+    gd::EventsList events;
+    events.InsertEvent(gd::StandardEvent());
+    events.InsertEvent(gd::StandardEvent());
+    unsigned int maxDepthLevelReached = 0;
+    gd::EventsCodeGenerationContext context(&maxDepthLevelReached);
+
+    gd::String output = "// Code before the events\n";
+    codeGenerator.AppendEventsListCode(events, context, output);
+    REQUIRE(output == "// Code before the events\n" +
+                          codeGenerator.GenerateEventsListCode(events, context));
+  }
+
+  SECTION("Constant conditions are folded") {
+    gd::Project project;
+    auto& layout = project.InsertNewLayout("Layout 1", 0);
+    gd::Platform platform;
+    gd::EventsCodeGenerator codeGenerator(project, layout, platform);
+
+    auto makeCondition = [](const gd::String& type,
+                            std::vector<gd::String> parameters,
+                            bool inverted = false) {
+      gd::Instruction condition(type);
+      condition.SetParametersCount(parameters.size());
+      for (std::size_t i = 0; i < parameters.size(); ++i)
+        condition.SetParameter(i, parameters[i]);
+      condition.SetInverted(inverted);
+      return condition;
+    };
+
+    gd::EventsList events;
+    gd::StandardEvent alwaysRunEvent;
+    alwaysRunEvent.GetConditions().Insert(makeCondition("Toujours", {""}));
+    alwaysRunEvent.GetConditions().Insert(
+        makeCondition("Egal", {"Variable(MyVar)", ">", "1"}));
+    alwaysRunEvent.GetConditions().Insert(
+        makeCondition("Egal", {" 1.5 ", "<", "2"}));
+    alwaysRunEvent.GetConditions().Insert(
+        makeCondition("StrEqual", {"\"Hello\"", "!=", "\"World\""}));
+    events.InsertEvent(alwaysRunEvent);
+
+    gd::StandardEvent neverRunEvent;
+    neverRunEvent.GetConditions().Insert(
+        makeCondition("Egal", {"Variable(MyVar)", ">", "1"}));
+    neverRunEvent.GetConditions().Insert(
+        makeCondition("Toujours", {""}, true));
+    neverRunEvent.GetSubEvents().InsertEvent(alwaysRunEvent);
+    events.InsertEvent(neverRunEvent);
+
+    gd::StandardEvent otherNeverRunEvent;
+    otherNeverRunEvent.GetConditions().Insert(
+        makeCondition("StrEqual", {"\"Hello\"", "=", "\"World\""}));
+    events.InsertEvent(otherNeverRunEvent);
+
+    gd::StandardEvent disabledEvent;
+    disabledEvent.SetDisabled();
+    disabledEvent.GetConditions().Insert(makeCondition("Toujours", {""}, true));
+    events.InsertEvent(disabledEvent);
+
+    codeGenerator.PreprocessEventList(events);
+    REQUIRE(events.GetEventsCount() == 2);
+    auto& conditions =
+        dynamic_cast<gd::StandardEvent&>(events.GetEvent(0)).GetConditions();
+    REQUIRE(conditions.size() == 1);
+    REQUIRE(conditions[0].GetParameter(0).GetPlainString() ==
+            "Variable(MyVar)");
+    REQUIRE(events.GetEvent(1).IsDisabled());
+  }
+  SECTION("Groups are expanded into their objects") {
+    gd::Project project;
+    gd::Platform platform;
+    SetupProjectWithDummyPlatform(project, platform);
+    auto& layout = project.InsertNewLayout("Layout 1", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyObject", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyOtherObject", 1);
+    gd::ObjectGroup group;
+    group.SetName("MyGroup");
+    group.AddObject("MyObject");
+    group.AddObject("MyOtherObject");
+    group.AddObject("MissingObject");
+    layout.GetObjectGroups().Insert(group);
+    gd::EventsCodeGenerator codeGenerator(project, layout, platform);
+
+    unsigned int maxDepthLevelReached = 0;
+    gd::EventsCodeGenerationContext context(&maxDepthLevelReached);
+    for (std::size_t i = 0; i < 2; ++i) {
+      REQUIRE(codeGenerator.ExpandObjectsName("MyGroup", context) ==
+              std::vector<gd::String>({"MyObject", "MyOtherObject"}));
+      REQUIRE(codeGenerator.ExpandObjectsName("MyObject", context) ==
+              std::vector<gd::String>({"MyObject"}));
+      REQUIRE(codeGenerator.ExpandObjectsName("MissingObject", context)
+                  .empty());
+    }
+
+    context.SetCurrentObject("MyOtherObject");
+    REQUIRE(codeGenerator.ExpandObjectsName("MyGroup", context) ==
+            std::vector<gd::String>({"MyOtherObject"}));
+    REQUIRE(codeGenerator.ExpandObjectsName("MyObject", context) ==
+            std::vector<gd::String>({"MyObject"}));
+    context.SetCurrentObject("MissingObject");
+    REQUIRE(codeGenerator.ExpandObjectsName("MyGroup", context).empty());
+  }
+  SECTION("Objects lists of loops are declared once") {
+    gd::Project project;
+    gd::Platform platform;
+    SetupProjectWithDummyPlatform(project, platform);
+    auto& layout = project.InsertNewLayout("Layout 1", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyObject", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyOtherObject", 1);
+    gd::EventsCodeGenerator codeGenerator(project, layout, platform);
+
+    unsigned int maxDepthLevelReached = 0;
+    gd::EventsCodeGenerationContext parentContext(&maxDepthLevelReached);
+    parentContext.ObjectsListNeeded("MyObject");
+    codeGenerator.GenerateObjectsDeclarationCode(parentContext);
+
+    auto generateLoopCode = [&](const std::set<gd::String>& pickedObjects,
+                                gd::String& refillCode) {
+      gd::EventsCodeGenerationContext context;
+      context.InheritsFrom(parentContext);
+      context.ForbidReuse();
+      context.ObjectsListNeeded("MyObject");
+      context.ObjectsListNeeded("MyOtherObject");
+      gd::String declarationCode =
+          codeGenerator.GenerateLoopObjectsDeclarationCode(
+              context, pickedObjects, refillCode);
+      return std::make_pair(
+          declarationCode,
+          codeGenerator.GetObjectListName("MyObject", context));
+    };
+
+    // The list copied from the parent context is filled only once, while
+    // all the instances are picked again at each iteration.
+    gd::String refillCode;
+    auto code = generateLoopCode({}, refillCode);
+    REQUIRE(code.first.find(code.second + "Frame(*runtimeContext, " +
+                            code.second + "T)") != gd::String::npos);
+    REQUIRE(refillCode.find(code.second) == gd::String::npos);
+    REQUIRE(refillCode.find("GetObjectsRawPointers") != gd::String::npos);
+
+    gd::String pickedRefillCode;
+    code = generateLoopCode({"MyObject"}, pickedRefillCode);
+    REQUIRE(code.first.find(code.second + "Frame(*runtimeContext)") !=
+            gd::String::npos);
+    REQUIRE(pickedRefillCode.find(code.second + ".assign(" + code.second +
+                                  "T.begin(), " + code.second + "T.end());") !=
+            gd::String::npos);
+  }
+  SECTION("Operators are inlined in the calls to setters") {
+    gd::Project project;
+    auto& layout = project.InsertNewLayout("Layout 1", 0);
+    gd::Platform platform;
+    CodeGeneratorForSetters codeGenerator(project, layout, platform);
+
+    gd::InstructionMetadata positionMetadata(
+        "", "MettreXY", "", "", "", "", "", "");
+    positionMetadata.AddParameter("object", "Object")
+        .AddParameter("operator", "Modification's sign")
+        .AddParameter("expression", "X position")
+        .AddParameter("operator", "Modification's sign")
+        .AddParameter("expression", "Y position")
+        .SetManipulatedType("number")
+        .SetSettersAndGetters({{"SetX", "GetX"}, {"SetY", "GetY"}});
+
+    REQUIRE(codeGenerator.GenerateSettersCall(
+                positionMetadata,
+                {"object", "\"+\"", "1 + 2", "\"=\"", "3"},
+                "object->",
+                1) ==
+            "object->SetX(object->GetX() + (1 + 2));\nobject->SetY(3)");
+
+    gd::InstructionMetadata scaleMetadata(
+        "", "ChangeScale", "", "", "", "", "", "");
+    scaleMetadata.AddParameter("object", "Object")
+        .AddParameter("operator", "Modification's sign")
+        .AddParameter("expression", "Value")
+        .SetManipulatedType("number")
+        .SetSettersAndGetters(
+            {{"SetScaleX", "GetScaleX"}, {"SetScaleY", "GetScaleY"}});
+
+    REQUIRE(codeGenerator.GenerateSettersCall(
+                scaleMetadata, {"object", "\"*\"", "2"}, "object->", 1) ==
+            "object->SetScaleX(object->GetScaleX() * (2));\n"
+            "object->SetScaleY(object->GetScaleY() * (2))");
+  }
 }
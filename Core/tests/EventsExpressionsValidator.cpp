@@ -0,0 +1,68 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Events/EventsExpressionsValidator.h"
+#include "DummyPlatform.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/Event.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+
+gd::Instruction MakeAction(const gd::String &expression) {
+  gd::Instruction instruction;
+  instruction.SetType("MyExtension::DoSomething");
+  instruction.SetParametersCount(1);
+  instruction.SetParameter(0, expression);
+  return instruction;
+}
+
+}  // namespace
+
+TEST_CASE("EventsExpressionsValidator", "[common][events]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+  auto &layout = project.InsertNewLayout("Layout1", 0);
+
+  // Many valid expressions, two invalid ones (one in a sub event).
+  gd::StandardEvent event;
+  for (std::size_t i = 0; i < 200; ++i)
+    event.GetActions().Insert(MakeAction("1 + " + gd::String::From(i)));
+  event.GetActions().Insert(MakeAction("1 +"), 10);
+
+  gd::StandardEvent subEvent;
+  subEvent.GetActions().Insert(MakeAction("MyExtension::GetNumber()"));
+  subEvent.GetActions().Insert(MakeAction("MyExtension::UnknownFunction()"));
+  event.GetSubEvents().InsertEvent(subEvent);
+  auto &insertedEvent =
+      dynamic_cast<gd::StandardEvent &>(layout.GetEvents().InsertEvent(event));
+  auto &insertedSubEvent =
+      dynamic_cast<gd::StandardEvent &>(insertedEvent.GetSubEvents()[0]);
+
+  for (std::size_t threadsCount : {1, 4}) {
+    gd::ExpressionParser2Cache cache;
+    auto errors = gd::EventsExpressionsValidator::Validate(
+        platform, cache, project, layout, layout.GetEvents(), threadsCount);
+
+    REQUIRE(errors.size() == 2);
+    REQUIRE(errors[0].GetInstruction() == &insertedEvent.GetActions()[10]);
+    REQUIRE(errors[0].GetParameterIndex() == 0);
+    REQUIRE(errors[1].GetInstruction() == &insertedSubEvent.GetActions()[1]);
+    REQUIRE(errors[1].GetMessage() != "");
+
+    // Expressions are parsed once, and reused by a new validation.
+    REQUIRE(cache.GetTreesCount() == 203);
+    errors = gd::EventsExpressionsValidator::Validate(
+        platform, cache, project, layout, layout.GetEvents(), threadsCount);
+    REQUIRE(errors.size() == 2);
+    REQUIRE(cache.GetTreesCount() == 203);
+  }
+}
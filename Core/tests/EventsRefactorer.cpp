@@ -0,0 +1,133 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering events refactoring
+ */
+#include "GDCore/IDE/Events/EventsRefactorer.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/Event.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Platform.h"
+#include "catch.hpp"
+
+namespace {
+
+gd::Instruction MakeInstruction(const gd::String &parameter) {
+  gd::Instruction instruction;
+  instruction.SetType("MyExtension::DoSomething");
+  instruction.SetParametersCount(1);
+  instruction.SetParameter(0, parameter);
+  return instruction;
+}
+
+}  // namespace
+
+TEST_CASE("EventsRefactorer", "[common][events]") {
+  SECTION("RenameObjectInEvents") {
+    gd::Project project;
+    gd::Platform platform;
+    SetupProjectWithDummyPlatform(project, platform);
+    auto &layout = project.InsertNewLayout("Scene", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyObject", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyObject2", 1);
+
+    gd::StandardEvent event;
+    event.GetActions().Insert(MakeInstruction(
+        "MyObject.GetObjectNumber()+MyObject2.GetObjectNumber() * 2"));
+    event.GetActions().Insert(MakeInstruction("1 +  2"));
+    event.GetActions().Insert(
+        MakeInstruction("MyObject2.GetObjectNumber()+MyObject.GetObjectNumber()"));
+    gd::StandardEvent subEvent;
+    subEvent.GetActions().Insert(MakeInstruction(
+        "MyObject.GetObjectNumber( ) + MyObject.GetObjectNumber()"));
+    event.GetSubEvents().InsertEvent(subEvent);
+    auto &insertedEvent = dynamic_cast<gd::StandardEvent &>(
+        layout.GetEvents().InsertEvent(event));
+    auto &insertedSubEvent =
+        dynamic_cast<gd::StandardEvent &>(insertedEvent.GetSubEvents()[0]);
+
+    gd::EventsRefactorer::RenameObjectInEvents(platform,
+                                               project,
+                                               layout,
+                                               layout.GetEvents(),
+                                               "MyObject",
+                                               "MyRenamedObject");
+
+    // Only the object names are changed, the rest of the expressions is kept
+    // as written.
+    auto &actions = insertedEvent.GetActions();
+    REQUIRE(actions[0].GetParameter(0).GetPlainString() ==
+            "MyRenamedObject.GetObjectNumber()+MyObject2.GetObjectNumber() * 2");
+    REQUIRE(actions[1].GetParameter(0).GetPlainString() ==
+            "1 +  2");
+    REQUIRE(actions[2].GetParameter(0).GetPlainString() ==
+            "MyObject2.GetObjectNumber()+MyRenamedObject.GetObjectNumber()");
+    REQUIRE(insertedSubEvent.GetActions()[0].GetParameter(0).GetPlainString() ==
+            "MyRenamedObject.GetObjectNumber( ) + "
+            "MyRenamedObject.GetObjectNumber()");
+  }
+
+  SECTION("SearchInEvents") {
+    gd::Project project;
+    gd::Layout layout;
+    gd::EventsList events;
+
+    // An event using the string in both a condition and an action.
+    {
+      gd::StandardEvent event;
+      event.GetConditions().Insert(MakeInstruction("\"Hello World\""));
+      event.GetActions().Insert(MakeInstruction("MyObject"));
+      event.GetActions().Insert(MakeInstruction("\"hello world\""));
+      events.InsertEvent(event);
+    }
+
+    // An event using the string only in a sub instruction, and with a sub
+    // event using it.
+    {
+      gd::StandardEvent event;
+      gd::Instruction instruction = MakeInstruction("Something else");
+      instruction.GetSubInstructions().Insert(MakeInstruction("HELLO WORLD"));
+      event.GetConditions().Insert(instruction);
+
+      gd::StandardEvent subEvent;
+      subEvent.GetActions().Insert(MakeInstruction("Straße: Hello World"));
+      event.GetSubEvents().InsertEvent(subEvent);
+      events.InsertEvent(event);
+    }
+
+    auto results = gd::EventsRefactorer::SearchInEvents(
+        project, layout, events, "Hello World", true, true, true);
+    REQUIRE(results.size() == 2);
+    REQUIRE(&results[0].GetEventsList() == &events);
+    REQUIRE(results[0].GetPositionInList() == 0);
+    REQUIRE(&results[1].GetEventsList() == &events[1].GetSubEvents());
+
+    results = gd::EventsRefactorer::SearchInEvents(
+        project, layout, events, "hello world", false, true, true);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].GetPositionInList() == 0);
+    REQUIRE(results[1].GetPositionInList() == 1);
+    REQUIRE(&results[2].GetEventsList() == &events[1].GetSubEvents());
+
+    results = gd::EventsRefactorer::SearchInEvents(
+        project, layout, events, "STRASSE", false, true, true);
+    REQUIRE(results.size() == 1);
+
+    results = gd::EventsRefactorer::SearchInEvents(
+        project, layout, events, "hello world", false, false, true);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].GetPositionInList() == 0);
+    REQUIRE(&results[1].GetEventsList() == &events[1].GetSubEvents());
+
+    results = gd::EventsRefactorer::SearchInEvents(
+        project, layout, events, "Not used", false, true, true);
+    REQUIRE(results.size() == 0);
+  }
+}
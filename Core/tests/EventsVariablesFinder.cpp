@@ -0,0 +1,92 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering EventsVariablesFinder
+ */
+#include "GDCore/IDE/Events/EventsVariablesFinder.h"
+#include "DummyPlatform.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/Event.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+
+gd::Instruction MakeAction(const gd::String &expression) {
+  gd::Instruction instruction;
+  instruction.SetType("MyExtension::DoSomething");
+  instruction.SetParametersCount(1);
+  instruction.SetParameter(0, expression);
+  return instruction;
+}
+
+}  // namespace
+
+TEST_CASE("EventsVariablesFinder", "[common][events]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+  auto &layout = project.InsertNewLayout("Layout1", 0);
+  auto &object = layout.InsertNewObject(
+      project, "MyExtension::Sprite", "MySpriteObject", 0);
+  auto &otherObject = layout.InsertNewObject(
+      project, "MyExtension::Sprite", "MyOtherSpriteObject", 1);
+
+  {
+    gd::StandardEvent event;
+    event.GetActions().Insert(
+        MakeAction("MyExtension::GetVariableAsNumber(MyLayoutVar) + "
+                   "MyExtension::GetGlobalVariableAsNumber(MyGlobalVar)"));
+
+    gd::Instruction action = MakeAction("1");
+    action.GetSubInstructions().Insert(
+        MakeAction("MySpriteObject.GetObjectVariableAsNumber(MyObjectVar)"));
+    event.GetActions().Insert(action);
+
+    gd::StandardEvent subEvent;
+    subEvent.GetActions().Insert(MakeAction(
+        "MyExtension::GetVariableAsNumber(MyOtherLayoutVar) + "
+        "MyOtherSpriteObject.GetObjectVariableAsNumber(MyOtherObjectVar)"));
+    event.GetSubEvents().InsertEvent(subEvent);
+    layout.GetEvents().InsertEvent(event);
+  }
+
+  std::set<gd::String> globalVariables{"MyGlobalVar"};
+  std::set<gd::String> layoutVariables{"MyLayoutVar", "MyOtherLayoutVar"};
+  std::set<gd::String> objectVariables{"MyObjectVar"};
+  std::set<gd::String> otherObjectVariables{"MyOtherObjectVar"};
+
+  SECTION("FindAllVariables") {
+    gd::EventsVariablesUsage usage =
+        gd::EventsVariablesFinder::FindAllVariables(platform, project, layout);
+    REQUIRE(usage.globalVariables == globalVariables);
+    REQUIRE(usage.layoutVariables ==
+            layoutVariables);
+    REQUIRE(usage.objectsVariables.size() == 2);
+    REQUIRE(usage.objectsVariables["MySpriteObject"] ==
+            objectVariables);
+    REQUIRE(usage.objectsVariables["MyOtherSpriteObject"] ==
+            otherObjectVariables);
+  }
+
+  SECTION("Variables of a kind") {
+    REQUIRE(gd::EventsVariablesFinder::FindAllGlobalVariables(
+                platform, project) == globalVariables);
+    REQUIRE(gd::EventsVariablesFinder::FindAllLayoutVariables(
+                platform, project, layout) ==
+            layoutVariables);
+    REQUIRE(gd::EventsVariablesFinder::FindAllObjectVariables(
+                platform, project, layout, object) ==
+            objectVariables);
+    REQUIRE(gd::EventsVariablesFinder::FindAllObjectVariables(
+                platform, project, layout, otherObject) ==
+            otherObjectVariables);
+  }
+}
@@ -14,6 +14,40 @@
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
 
+namespace {
+
+/**
+ * \brief A code generator storing the results of functions in temporaries.
+ */
+class CodeGeneratorWithTemporaries : public gd::EventsCodeGenerator {
+ public:
+  CodeGeneratorWithTemporaries(gd::Project& project,
+                               const gd::Layout& layout,
+                               const gd::Platform& platform)
+      : gd::EventsCodeGenerator(project, layout, platform),
+        temporariesCount(0){};
+
+  gd::String GenerateExpressionTemporary(const gd::String& type) override {
+    return "temporary" + gd::String::From(temporariesCount++);
+  }
+
+  gd::String GenerateExpressionWithTemporaries(
+      const gd::String& type,
+      const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+      const gd::String& expressionCode) override {
+    gd::String code = "(";
+    for (const auto& temporary : temporaries)
+      code += temporary.first + " = " + temporary.second + ", ";
+
+    return code + expressionCode + ")";
+  }
+
+ private:
+  std::size_t temporariesCount;
+};
+
+}  // namespace
+
 TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
   gd::Project project;
   gd::Platform platform;
@@ -423,4 +457,91 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
             "toString(+(-(getNumberWith3Params(12, \"hello world\", "
             "0))))).getChild(\"grandChild\")");
   }
+  SECTION("Constants folding") {
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "number",
+                "2*3+MyExtension::GetNumber()") == "6 + getNumber()");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator, context, "number", "(1 + 2) / 4") == "0.75");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator, context, "number", "1/3") ==
+            "0.33333333333333331");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator, context, "number", "2 - -(2*3)") == "8");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator, context, "number", "1 - 2 - 3 + 4") == "0");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "number",
+                "1 - 2 - MyExtension::GetNumber() - 3 + 4") ==
+            "(-1) - getNumber() - 3 + 4");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "number",
+                "MyExtension::GetNumber() - 3 + 4") == "getNumber() - 3 + 4");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "number",
+                "MyExtension::GetNumber() * -(2*3)") == "getNumber() * (-6)");
+
+    // Divisions by zero are not folded.
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator, context, "number", "1/(1-1)") == "1 / 0");
+
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "string",
+                "\"Hello\" + \" \" + \"world\" + "
+                "MyExtension::ToString(1+1)") ==
+            "\"Hello world\" + toString(2)");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "scenevar",
+                "myVariable[\"child\" + \"1\"]") ==
+            "getLayoutVariable(myVariable).getChild(\"child1\")");
+  }
+  SECTION("Functions results reuse") {
+    CodeGeneratorWithTemporaries codeGeneratorWithTemporaries(
+        project, layout1, platform);
+
+    // Only supported by code generators providing temporaries.
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGenerator,
+                context,
+                "number",
+                "MyExtension::GetNumber() + MyExtension::GetNumber() / 2") ==
+            "getNumber() + getNumber() / 2");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGeneratorWithTemporaries,
+                context,
+                "number",
+                "MyExtension::GetNumber() + MyExtension::GetNumber() / 2") ==
+            "(temporary0 = getNumber(), temporary0 + temporary0 / 2)");
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGeneratorWithTemporaries,
+                context,
+                "number",
+                "MySpriteObject.GetObjectNumber() + "
+                "MySpriteObject.GetObjectNumber() / 2 + "
+                "MyExtension::GetNumber()") ==
+            "(temporary1 = MySpriteObject.getObjectNumber() ?? 0, temporary1 + "
+            "temporary1 / 2 + getNumber())");
+
+    // Functions with side effects could change the results of the others.
+    REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
+                codeGeneratorWithTemporaries,
+                context,
+                "number",
+                "MyExtension::GetNumber() + MyExtension::GetNumber() + "
+                "MyExtension::GetVariableAsNumber(myVariable)") ==
+            "getNumber() + getNumber() + "
+            "returnVariable(getLayoutVariable(myVariable))");
+  }
 }
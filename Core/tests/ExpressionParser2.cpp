@@ -12,6 +12,8 @@
 #include "GDCore/Project/Project.h"
 #include "catch.hpp"
 
+#include <thread>
+
 TEST_CASE("ExpressionParser2", "[common][events]") {
   gd::Project project;
   gd::Platform platform;
@@ -611,6 +613,9 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
       REQUIRE(functionNode.functionName == "GetObjectNumber");
       REQUIRE(functionNode.objectName == "MySpriteObject");
       REQUIRE(functionNode.behaviorName == "");
+      REQUIRE(functionNode.objectNameLocation.IsValid());
+      REQUIRE(functionNode.objectNameLocation.GetStartPosition() == 0);
+      REQUIRE(functionNode.objectNameLocation.GetEndPosition() == 14);
 
       gd::ExpressionValidator validator;
       node->Visit(validator);
@@ -853,4 +858,53 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
                          "\fe'f\fwe'\te'w\f'reg[pto43o]"));
     }
   }
+
+  SECTION("Texts and identifiers with characters that are not ASCII") {
+    {
+      auto node = parser.ParseExpression(
+          "string", "\"h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80\"");
+      REQUIRE(node != nullptr);
+      auto &textNode = dynamic_cast<gd::TextNode &>(*node);
+      REQUIRE(textNode.text == "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80");
+    }
+    {
+      auto node = parser.ParseExpression("object", "\xC3\x89t\xC3\xA9 1  ");
+      REQUIRE(node != nullptr);
+      auto &identifierNode = dynamic_cast<gd::IdentifierNode &>(*node);
+      REQUIRE(identifierNode.identifierName == "\xC3\x89t\xC3\xA9 1");
+    }
+    {
+      // Positions are in characters, not in bytes.
+      auto node =
+          parser.ParseExpression("string", "\"\xC3\xA9\xE2\x82\xAC\xC3\xA9");
+      REQUIRE(node != nullptr);
+
+      gd::ExpressionValidator validator;
+      node->Visit(validator);
+      REQUIRE(validator.GetErrors().size() == 1);
+      REQUIRE(validator.GetErrors()[0]->GetStartPosition() == 4);
+    }
+  }
+
+  SECTION("Memory of destroyed trees is reused") {
+    gd::ExpressionNode *firstNode = nullptr;
+    {
+      auto node = parser.ParseExpression("number", "1");
+      firstNode = node.get();
+    }
+    auto node = parser.ParseExpression("number", "2");
+    REQUIRE(node.get() == firstNode);
+
+    // Trees can be destroyed by another thread than the one parsing them.
+    std::vector<std::unique_ptr<gd::ExpressionNode>> nodes;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      nodes.push_back(
+          parser.ParseExpression("string", "\"Hello\" + \"World\""));
+    }
+    std::thread([&nodes]() { nodes.clear(); }).join();
+    for (std::size_t i = 0; i < 1000; ++i) {
+      nodes.push_back(parser.ParseExpression("number", "1 + 2 * 3"));
+    }
+    REQUIRE(dynamic_cast<gd::OperatorNode *>(nodes.back().get()) != nullptr);
+  }
 }
@@ -0,0 +1,95 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include <chrono>
+#include <iostream>
+#include "DummyPlatform.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/IDE/Events/ExpressionValidator.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * Parse the expression the given number of times, print the mean duration
+ * and return the tree of the last parsing.
+ */
+std::unique_ptr<gd::ExpressionNode> BenchmarkParsing(
+    gd::ExpressionParser2 &parser,
+    const gd::String &name,
+    const gd::String &type,
+    const gd::String &expression,
+    std::size_t count = 20) {
+  std::unique_ptr<gd::ExpressionNode> node;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; ++i) {
+    node = parser.ParseExpression(type, expression);
+  }
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << "Parsing " << name << " (" << expression.Raw().size()
+            << " bytes): " << duration.count() / count << "us" << std::endl;
+  return node;
+}
+}  // namespace
+
+TEST_CASE("ExpressionParser2 - Benchmarks", "[.][benchmark][events]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+  auto &layout1 = project.InsertNewLayout("Layout1", 0);
+  layout1.InsertNewObject(project, "MyExtension::Sprite", "MySpriteObject", 0);
+
+  gd::ExpressionParser2 parser(platform, project, layout1);
+
+  SECTION("10 KB of text") {
+    gd::String text;
+    while (text.Raw().size() < 10 * 1024)
+      text += "H\xC3\xA9llo w\xE2\x82\xACrld ";
+
+    auto node =
+        BenchmarkParsing(parser, "a text", "string", "\"" + text + "\"");
+    REQUIRE(node != nullptr);
+    auto &textNode = dynamic_cast<gd::TextNode &>(*node);
+    REQUIRE(textNode.text == text);
+  }
+
+  SECTION("10 KB of operators") {
+    gd::String expression = "1";
+    while (expression.Raw().size() < 10 * 1024) expression += " * 2.5 / 3";
+
+    auto node = BenchmarkParsing(parser, "operators", "number", expression);
+    REQUIRE(node != nullptr);
+    gd::ExpressionValidator validator;
+    node->Visit(validator);
+    REQUIRE(validator.GetErrors().size() == 0);
+  }
+
+  SECTION("10 KB of function calls") {
+    gd::String expression = "0";
+    while (expression.Raw().size() < 10 * 1024)
+      expression +=
+          " * MySpriteObject.GetObjectNumber() / MyExtension::GetNumber()";
+
+    auto node =
+        BenchmarkParsing(parser, "function calls", "number", expression);
+    REQUIRE(node != nullptr);
+    gd::ExpressionValidator validator;
+    node->Visit(validator);
+    REQUIRE(validator.GetErrors().size() == 0);
+  }
+
+  SECTION("10 KB of identifiers with characters that are not ASCII") {
+    gd::String expression = "0";
+    while (expression.Raw().size() < 10 * 1024)
+      expression += " * \xC3\x89l\xC3\xA9ment";
+
+    auto node = BenchmarkParsing(parser, "identifiers", "number", expression);
+    REQUIRE(node != nullptr);
+  }
+}
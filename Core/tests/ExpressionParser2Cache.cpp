@@ -0,0 +1,119 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Events/Parsers/ExpressionParser2Cache.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include "DummyPlatform.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Tools/Threads.h"
+#include "catch.hpp"
+
+TEST_CASE("ExpressionParser2Cache", "[common][events]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+  auto &layout1 = project.InsertNewLayout("Layout1", 0);
+  layout1.InsertNewObject(project, "MyExtension::Sprite", "MySpriteObject", 0);
+  auto &layout2 = project.InsertNewLayout("Layout2", 1);
+  layout2.InsertNewObject(project, "MyExtension::Sprite", "MySpriteObject", 0);
+  auto &layout3 = project.InsertNewLayout("Layout3", 2);
+  layout3.InsertNewObject(project, "", "MySpriteObject", 0);
+
+  gd::ExpressionParser2Cache &cache = project.GetExpressionParser2Cache();
+
+  SECTION("Trees are reused") {
+    gd::String expression = "1 + MyExtension::MouseX(,)";
+    auto node =
+        cache.ParseExpression(platform, project, layout1, "number", expression);
+    REQUIRE(node != nullptr);
+    REQUIRE(dynamic_cast<gd::OperatorNode *>(node.get()) != nullptr);
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout1, "number", expression) == node);
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout2, "number", expression) == node);
+    REQUIRE(cache.GetTreesCount() == 1);
+
+    // Type and object name are part of the key.
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout1, "string", expression) != node);
+    REQUIRE(cache.ParseExpression(platform,
+                                  project,
+                                  layout1,
+                                  "number",
+                                  expression,
+                                  "MySpriteObject") != node);
+    REQUIRE(cache.GetTreesCount() == 3);
+  }
+
+  SECTION("Trees using objects are reused only if types are the same") {
+    gd::String expression = "MySpriteObject.GetObjectNumber()";
+    auto node =
+        cache.ParseExpression(platform, project, layout1, "number", expression);
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout2, "number", expression) == node);
+
+    auto otherNode =
+        cache.ParseExpression(platform, project, layout3, "number", expression);
+    REQUIRE(otherNode != node);
+    REQUIRE(cache.GetTreesCount() == 1);
+  }
+
+  SECTION("Trees are forgotten when extensions are changed") {
+    gd::String expression = "MyExtension::MouseX(,)";
+    auto node =
+        cache.ParseExpression(platform, project, layout1, "number", expression);
+    platform.RemoveExtension("MyExtension");
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout1, "number", expression) != node);
+    REQUIRE(cache.GetTreesCount() == 1);
+  }
+
+  SECTION("Trees are parsed by several threads at the same time") {
+    std::vector<std::function<void()>> parsings;
+    std::vector<std::shared_ptr<gd::ExpressionNode>> nodes(100);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      parsings.push_back([&, i]() {
+        nodes[i] = cache.ParseExpression(platform,
+                                         project,
+                                         i % 2 ? layout1 : layout2,
+                                         "number",
+                                         gd::String::From(i % 10) + " + 1");
+      });
+    }
+    gd::CallOnThreads(parsings, 4);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      REQUIRE(nodes[i] != nullptr);
+      REQUIRE(dynamic_cast<gd::OperatorNode *>(nodes[i].get()) != nullptr);
+    }
+    REQUIRE(cache.GetTreesCount() == 10);
+  }
+
+  SECTION("Memory is bounded") {
+    cache.SetMaximumMemory(100 * 1024);
+    for (std::size_t i = 0; i < 10000; ++i) {
+      cache.ParseExpression(
+          platform, project, layout1, "number", gd::String::From(i) + " + 1");
+    }
+    REQUIRE(cache.GetMemory() <= 100 * 1024);
+    REQUIRE(cache.GetTreesCount() < 10000);
+
+    // The most recently used trees are kept.
+    auto node = cache.ParseExpression(
+        platform, project, layout1, "number", "9999 + 1");
+    REQUIRE(cache.ParseExpression(
+                platform, project, layout1, "number", "9999 + 1") == node);
+
+    cache.Clear();
+    REQUIRE(cache.GetTreesCount() == 0);
+    REQUIRE(cache.GetMemory() == 0);
+  }
+}
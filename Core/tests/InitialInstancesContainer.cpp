@@ -14,6 +14,9 @@
 
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Serialization/JsonReader.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/Tools/VersionWrapper.h"
 
 void AddNewInitialInstance(gd::InitialInstancesContainer &container,
@@ -83,6 +86,15 @@ class AllInstancesFunctor : public gd::InitialInstanceFunctor {
   std::vector<gd::InitialInstance> allInitialInstances;
 };
 
+class NamesFunctor : public gd::InitialInstanceFunctor {
+ public:
+  void operator()(gd::InitialInstance &instance) {
+    names.push_back(instance.GetObjectName());
+  }
+
+  std::vector<gd::String> names;
+};
+
 TEST_CASE("InitialInstancesContainer", "[common][instances]") {
   gd::InitialInstancesContainer container;
 
@@ -168,6 +180,78 @@ TEST_CASE("InitialInstancesContainer", "[common][instances]") {
     }
   }
 
+  SECTION("Instances are kept in order and at the same address") {
+    std::vector<gd::InitialInstance *> instances;
+    for (std::size_t i = 0; i < 150; ++i) {
+      instances.push_back(&container.InsertNewInitialInstance());
+      instances.back()->SetObjectName("new" + gd::String::From(i));
+      instances.back()->SetX(i);
+    }
+    container.RemoveInstance(*instances[10]);
+    container.RemoveInstance(*instances[100]);
+    container.InsertNewInitialInstance().SetObjectName("last");
+
+    REQUIRE(container.GetInstancesCount() == 156);
+    REQUIRE(instances[0]->GetObjectName() == "new0");
+    REQUIRE(instances[149]->GetObjectName() == "new149");
+    REQUIRE(instances[149]->GetX() == 149);
+
+    NamesFunctor names;
+    container.IterateOverInstances(names);
+    REQUIRE(names.names.size() == 156);
+    REQUIRE(names.names[7] == "new0");
+    REQUIRE(names.names[17] == "new11");
+    REQUIRE(names.names[106] == "new101");
+    REQUIRE(names.names[155] == "last");
+
+    gd::InitialInstancesContainer copy(container);
+    NamesFunctor copiedNames;
+    copy.IterateOverInstances(copiedNames);
+    REQUIRE(copiedNames.names == names.names);
+  }
+
+  SECTION("Bulk operations on instances") {
+    std::vector<gd::InitialInstance *> instances;
+    for (std::size_t i = 0; i < 100; ++i) {
+      instances.push_back(&container.InsertNewInitialInstance());
+      instances.back()->SetObjectName("new" + gd::String::From(i));
+      instances.back()->SetLayer("layer3");
+      instances.back()->SetX(i * 10);
+      instances.back()->SetY(i * 10);
+    }
+
+    auto instancesInRect =
+        container.GetInstancesInRect("layer3", 95, 95, 300, 300);
+    REQUIRE(instancesInRect.size() == 21);
+    REQUIRE(instancesInRect[0] == instances[10]);
+    REQUIRE(instancesInRect[20] == instances[30]);
+    REQUIRE(container.GetInstancesInRect("layer1", 95, 95, 300, 300).empty());
+
+    container.MoveInstances(instancesInRect, 1000, 5);
+    REQUIRE(instances[10]->GetX() == 1100);
+    REQUIRE(instances[10]->GetY() == 105);
+    REQUIRE(instances[31]->GetX() == 310);
+
+    auto newInstances = container.DuplicateInstances(instancesInRect, 0, 10);
+    REQUIRE(container.GetInstancesCount() == 128);
+    REQUIRE(newInstances.size() == 21);
+    REQUIRE(newInstances[0]->GetObjectName() == "new10");
+    REQUIRE(newInstances[0]->GetY() == 115);
+    REQUIRE(instances[10]->GetObjectName() == "new10");
+    REQUIRE(instances[10]->GetY() == 105);
+
+    container.RemoveInstances(instancesInRect);
+    REQUIRE(container.GetInstancesCount() == 107);
+    REQUIRE(instances[9]->GetObjectName() == "new9");
+    REQUIRE(newInstances[20]->GetObjectName() == "new30");
+
+    NamesFunctor names;
+    container.IterateOverInstances(names);
+    REQUIRE(names.names[16] == "new9");
+    REQUIRE(names.names[17] == "new31");
+    REQUIRE(names.names[86] == "new10");
+  }
+
   SECTION("RemoveAllInstancesOnLayer") {
     container.RemoveAllInstancesOnLayer("layer1");
 
@@ -225,4 +309,36 @@ TEST_CASE("InitialInstancesContainer", "[common][instances]") {
     REQUIRE(container.SomeInstancesAreOnLayer("layer3") == false);
     REQUIRE(container.SomeInstancesAreOnLayer("layer5") == false);
   }
+
+  SECTION("Unserialize from a JsonReader") {
+    container.InsertNewInitialInstance().SetRawFloatProperty("animation", 2);
+    container.InsertNewInitialInstance().SetRawStringProperty("text", "Hi");
+
+    gd::SerializerElement element;
+    container.SerializeTo(element);
+    gd::String json = gd::Serializer::ToJSON(element);
+
+    gd::InitialInstancesContainer unserializedContainer;
+    AddNewInitialInstance(unserializedContainer, "object4", "layer4", 1);
+    gd::JsonReader reader(json.Raw());
+    reader.Next();
+    unserializedContainer.UnserializeFrom(reader);
+    REQUIRE(reader.HasError() == false);
+
+    AllInstancesFunctor func;
+    unserializedContainer.IterateOverInstances(func);
+    REQUIRE(func.Compare({MakeInstance("object1", "layer1", 10),
+                          MakeInstance("object1", "layer2", 10),
+                          MakeInstance("object1", "layer1", 14),
+                          MakeInstance("object2", "layer1", 12),
+                          MakeInstance("object2", "layer1", 10),
+                          MakeInstance("object3", "layer2", 11),
+                          MakeInstance("object3", "layer2", 9),
+                          MakeInstance("", "", 0),
+                          MakeInstance("", "", 0)}) == true);
+
+    gd::SerializerElement unserializedElement;
+    unserializedContainer.SerializeTo(unserializedElement);
+    REQUIRE(gd::Serializer::ToJSON(unserializedElement) == json);
+  }
 }
@@ -0,0 +1,49 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Events/InstructionSentenceFormatter.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "catch.hpp"
+
+TEST_CASE("InstructionSentenceFormatter", "[common][events]") {
+  gd::InstructionMetadata metadata("MyExtension",
+                                   "DoSomething",
+                                   "Do something",
+                                   "This does something",
+                                   "Do _PARAM0_ with _PARAM1_",
+                                   "",
+                                   "",
+                                   "");
+  metadata.AddParameter("expression", "Parameter 1")
+      .AddParameter("string", "Parameter 2");
+
+  gd::Instruction instruction("MyExtension::DoSomething");
+  instruction.SetParametersCount(2);
+  instruction.SetParameter(0, "1+1");
+  instruction.SetParameter(1, "\"Hello\"");
+
+  gd::InstructionSentenceFormatter *formatter =
+      gd::InstructionSentenceFormatter::Get();
+  formatter->LoadTypesFormattingFromConfig();
+
+  auto formattedTexts = formatter->GetAsFormattedText(instruction, metadata);
+  REQUIRE(formattedTexts.size() == 4);
+  REQUIRE(formattedTexts[0].first == "Do ");
+  REQUIRE(formattedTexts[1].first == "1+1");
+  REQUIRE(formattedTexts[1].second.userData == 0);
+  REQUIRE(formattedTexts[2].first == " with ");
+  REQUIRE(formattedTexts[3].first == "\"Hello\"");
+  REQUIRE(formattedTexts[3].second.userData == 1);
+
+  // The same sentence is returned from the cache...
+  REQUIRE(formatter->GetAsFormattedText(instruction, metadata).size() == 4);
+
+  // ...but a modified instruction is formatted again.
+  instruction.SetParameter(0, "2+2");
+  formattedTexts = formatter->GetAsFormattedText(instruction, metadata);
+  REQUIRE(formattedTexts.size() == 4);
+  REQUIRE(formattedTexts[1].first == "2+2");
+}
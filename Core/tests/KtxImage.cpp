@@ -0,0 +1,95 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the reading of compressed textures from KTX files.
+ */
+#include "GDCore/Tools/KtxImage.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+void Write(std::string& data, std::uint32_t value, bool bigEndian = false) {
+  for (int i = 0; i < 4; ++i) {
+    int shift = bigEndian ? (3 - i) * 8 : i * 8;
+    data += static_cast<char>((value >> shift) & 0xFF);
+  }
+}
+
+std::string MakeKtxFile(std::uint32_t glType,
+                        std::uint32_t width,
+                        std::uint32_t height,
+                        const std::vector<std::string>& levels,
+                        bool bigEndian = false) {
+  std::string data("\xAB\x4B\x54\x58\x20\x31\x31\xBB\x0D\x0A\x1A\x0A", 12);
+  Write(data, 0x04030201, bigEndian);
+  Write(data, glType, bigEndian);
+  Write(data, glType ? 1 : 0, bigEndian);      // glTypeSize
+  Write(data, glType ? 0x1908 : 0, bigEndian);  // glFormat
+  Write(data, 0x9278, bigEndian);  // GL_COMPRESSED_RGBA8_ETC2_EAC
+  Write(data, 0x1908, bigEndian);  // glBaseInternalFormat
+  Write(data, width, bigEndian);
+  Write(data, height, bigEndian);
+  Write(data, 0, bigEndian);  // pixelDepth
+  Write(data, 0, bigEndian);  // numberOfArrayElements
+  Write(data, 1, bigEndian);  // numberOfFaces
+  Write(data, levels.size(), bigEndian);
+  Write(data, 8, bigEndian);  // bytesOfKeyValueData
+  data += std::string(8, 'k');
+  for (auto& level : levels) {
+    Write(data, level.size(), bigEndian);
+    data += level;
+    data += std::string((4 - level.size() % 4) % 4, '\0');
+  }
+
+  return data;
+}
+}  // namespace
+
+TEST_CASE("KtxImage", "[common][resources]") {
+  SECTION("Compressed texture") {
+    for (bool bigEndian : {false, true}) {
+      std::string file = MakeKtxFile(
+          0, 8, 4, {std::string(32, 'a'), std::string(6, 'b')}, bigEndian);
+
+      gd::KtxImage image;
+      REQUIRE(image.LoadFromMemory(file.data(), file.size()) == true);
+      REQUIRE(image.GetWidth() == 8);
+      REQUIRE(image.GetHeight() == 4);
+      REQUIRE(image.GetInternalFormat() == 0x9278);
+      REQUIRE(image.GetLevelsCount() == 2);
+      REQUIRE(image.GetLevel(0) == std::string(32, 'a'));
+      REQUIRE(image.GetLevel(1) == std::string(6, 'b'));
+      REQUIRE(image.GetDataSize() == 38);
+    }
+  }
+  SECTION("Invalid files") {
+    gd::KtxImage image;
+    REQUIRE(image.LoadFromMemory(nullptr, 0) == false);
+
+    std::string file = MakeKtxFile(0, 8, 4, {std::string(32, 'a')});
+    REQUIRE(image.LoadFromMemory(file.data(), 40) == false);
+    REQUIRE(image.LoadFromMemory(file.data(), file.size() - 1) == false);
+    REQUIRE(image.GetLevelsCount() == 0);
+
+    std::string notKtx = file;
+    notKtx[1] = 'X';
+    REQUIRE(image.LoadFromMemory(notKtx.data(), notKtx.size()) == false);
+
+    // Uncompressed textures are not supported.
+    std::string uncompressed =
+        MakeKtxFile(0x1401, 2, 2, {std::string(16, 'a')});
+    REQUIRE(image.LoadFromMemory(uncompressed.data(), uncompressed.size()) ==
+            false);
+  }
+  SECTION("IsKtxFile") {
+    REQUIRE(gd::KtxImage::IsKtxFile("player.png.ktx") == true);
+    REQUIRE(gd::KtxImage::IsKtxFile("Player.KTX") == true);
+    REQUIRE(gd::KtxImage::IsKtxFile("player.png") == false);
+    REQUIRE(gd::KtxImage::IsKtxFile("ktx") == false);
+  }
+}
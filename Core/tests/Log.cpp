@@ -0,0 +1,60 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the log functions of GDevelop Core.
+ */
+#include "GDCore/Tools/Log.h"
+#include <vector>
+#include "GDCore/Tools/Threads.h"
+#include "catch.hpp"
+
+TEST_CASE("Logger", "[common]") {
+  std::vector<gd::String> messages;
+  gd::Logger logger;
+  logger.SetSink([&messages](gd::Logger::Level level,
+                             long long timestamp,
+                             const gd::String& message) {
+    messages.push_back(message);
+  });
+
+  SECTION("Messages are written when logged if the logger is not started") {
+    logger.Log(gd::Logger::Warning, "Hello");
+    REQUIRE(messages.size() == 1);
+    REQUIRE(messages[0] == "Hello");
+  }
+  SECTION("Messages of disabled levels are not formatted") {
+    logger.SetMinimumLevel(gd::Logger::Warning);
+    bool formatted = false;
+    logger.LogLazily(gd::Logger::Message, [&formatted]() {
+      formatted = true;
+      return gd::String("Hidden");
+    });
+    logger.LogLazily(gd::Logger::Error, []() { return gd::String("Shown"); });
+
+    REQUIRE(!formatted);
+    REQUIRE(messages.size() == 1);
+    REQUIRE(messages[0] == "Shown");
+  }
+  SECTION("Messages are written by the background thread") {
+    logger.Start(64);
+    std::vector<std::function<void()>> functions;
+    for (std::size_t i = 0; i < 4; ++i) {
+      functions.push_back([&logger, i]() {
+        for (std::size_t j = 0; j < 10; ++j)
+          logger.Log(gd::Logger::Message, gd::String::From(i * 10 + j));
+      });
+    }
+    gd::CallOnThreads(functions, 4);
+    logger.Flush();
+
+    REQUIRE(messages.size() == 40);
+    REQUIRE(logger.GetDroppedMessagesCount() == 0);
+    logger.Stop();
+
+    logger.Log(gd::Logger::Message, "After");
+    REQUIRE(messages.back() == "After");
+  }
+}
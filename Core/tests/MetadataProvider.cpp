@@ -0,0 +1,88 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include <memory>
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+TEST_CASE("MetadataProvider", "[common][extensions]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  SECTION("Instructions and expressions are found") {
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(
+                platform, "MyExtension::DoSomething")
+                .GetFullName() == "Do something");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(
+                platform, "MyExtension::DoSomething")
+                .GetExtension()
+                .GetName() == "MyExtension");
+    REQUIRE(gd::MetadataProvider::GetExpressionMetadata(
+                platform, "MyExtension::GetNumber")
+                .GetFullName() == "Get me a number");
+    REQUIRE(gd::MetadataProvider::GetObjectExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetObjectNumber")
+                .GetFullName() == "Get number from object");
+    REQUIRE(gd::MetadataProvider::GetObjectStrExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetObjectStringWith1Param")
+                .GetFullName() == "Get string from object with 1 param");
+    REQUIRE(gd::MetadataProvider::GetObjectMetadata(platform,
+                                                    "MyExtension::Sprite")
+                .GetFullName() == "Dummy Sprite");
+    REQUIRE(gd::MetadataProvider::GetBehaviorMetadata(
+                platform, "MyExtension::MyBehavior")
+                .GetFullName() == "Dummy behavior");
+
+    REQUIRE(gd::MetadataProvider::HasAction(platform,
+                                            "MyExtension::DoSomething"));
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+        platform, "MyExtension::Sprite", "GetObjectNumber"));
+  }
+
+  SECTION("Missing instructions and expressions are not found") {
+    REQUIRE(gd::MetadataProvider::HasAction(platform, "MyExtension::Nothing") ==
+            false);
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+                platform, "MyExtension::Sprite", "Nothing") == false);
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+                platform, "", "GetObjectNumber") == false);
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(platform,
+                                                    "MyExtension::Nothing")
+                .GetFullName() == "");
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Sprite", "Nothing")));
+  }
+
+  SECTION("Metadata of added and removed extensions are found or not") {
+    REQUIRE(gd::MetadataProvider::HasExpression(platform,
+                                                "MyExtension::GetNumber"));
+
+    platform.RemoveExtension("MyExtension");
+    REQUIRE(gd::MetadataProvider::HasExpression(
+                platform, "MyExtension::GetNumber") == false);
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+                platform, "MyExtension::Sprite", "GetObjectNumber") == false);
+
+    std::shared_ptr<gd::PlatformExtension> extension =
+        std::make_shared<gd::PlatformExtension>();
+    extension->SetExtensionInformation(
+        "MyExtension", "Another testing extension", "", "", "");
+    extension->AddExpression("GetNumber", "Get another number", "", "", "");
+    platform.AddExtension(extension);
+    REQUIRE(gd::MetadataProvider::GetExpressionMetadata(
+                platform, "MyExtension::GetNumber")
+                .GetFullName() == "Get another number");
+  }
+}
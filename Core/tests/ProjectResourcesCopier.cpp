@@ -0,0 +1,134 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ProjectResourcesCopier.
+ */
+#include "GDCore/IDE/Project/ProjectResourcesCopier.h"
+#include <map>
+#include <mutex>
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+
+/**
+ * \brief A file system keeping the files in memory, with their modification
+ * time given by a counter.
+ */
+class InMemoryFileSystem : public gd::AbstractFileSystem {
+ public:
+  struct File {
+    gd::String content;
+    std::int64_t time;
+  };
+
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return files.find(path) != files.end();
+  };
+  virtual gd::String FileNameFrom(const gd::String& file) {
+    return file.substr(file.rfind("/") + 1);
+  };
+  virtual gd::String DirNameFrom(const gd::String& file) {
+    return file.substr(0, file.rfind("/"));
+  };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    if (!IsAbsolute(filename)) filename = baseDirectory + "/" + filename;
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    if (filename.find(baseDirectory + "/") != 0) return false;
+    filename = filename.substr(baseDirectory.size() + 1);
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) {
+    return !filename.empty() && filename[0] == '/';
+  }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (files.find(file) == files.end()) return false;
+
+    files[destination] = File{files[file].content, ++time};
+    copies.push_back(destination);
+    return true;
+  }
+  virtual bool CopyDir(const gd::String& source,
+                       const gd::String& destination) {
+    return true;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return true; }
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    std::lock_guard<std::mutex> lock(mutex);
+    files[file] = File{content, ++time};
+    return true;
+  }
+  virtual gd::String ReadFile(const gd::String& file) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return files[file].content;
+  }
+  virtual bool GetFileInfo(const gd::String& file,
+                           std::uint64_t& size,
+                           std::int64_t& lastModificationTime) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!withFileInfo || files.find(file) == files.end()) return false;
+
+    size = files[file].content.size();
+    lastModificationTime = files[file].time;
+    return true;
+  }
+  virtual gd::String GetTempDir() { return "/tmp"; }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+
+  std::map<gd::String, File> files;
+  std::vector<gd::String> copies;
+  std::int64_t time = 0;
+  bool withFileInfo = true;
+  std::mutex mutex;
+};
+
+}  // namespace
+
+TEST_CASE("ProjectResourcesCopier", "[common][resources]") {
+  for (bool withFileInfo : {true, false}) {
+    InMemoryFileSystem fs;
+    fs.withFileInfo = withFileInfo;
+    fs.WriteToFile("/project/game.json", "{}");
+    fs.WriteToFile("/project/image1.png", "Image 1");
+    fs.WriteToFile("/project/image2.png", "Image 2");
+    fs.WriteToFile("/project/sound.wav", "Sound");
+
+    gd::Project project;
+    project.SetProjectFile("/project/game.json");
+    project.GetResourcesManager().AddResource("Image1", "image1.png", "image");
+    project.GetResourcesManager().AddResource("Image2", "image2.png", "image");
+    project.GetResourcesManager().AddResource("Sound", "sound.wav", "audio");
+
+    REQUIRE(gd::ProjectResourcesCopier::CopyAllResourcesTo(
+        project, fs, "/export", false, NULL, false, true, 4));
+    REQUIRE(fs.copies.size() == 3);
+    REQUIRE(fs.files["/export/image1.png"].content == "Image 1");
+    REQUIRE(fs.files["/export/image2.png"].content == "Image 2");
+    REQUIRE(fs.files["/export/sound.wav"].content == "Sound");
+
+    // Only the files that changed are copied again.
+    fs.copies.clear();
+    fs.WriteToFile("/project/image2.png", "Image 2 modified");
+    fs.WriteToFile("/project/sound.wav", "Sound");  // Same content.
+    REQUIRE(gd::ProjectResourcesCopier::CopyAllResourcesTo(
+        project, fs, "/export", false, NULL, false, true, 4));
+    REQUIRE(fs.copies.size() == 1);
+    REQUIRE(fs.copies[0] == "/export/image2.png");
+    REQUIRE(fs.files["/export/image2.png"].content == "Image 2 modified");
+  }
+}
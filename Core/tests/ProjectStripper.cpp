@@ -0,0 +1,72 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the stripping of projects for export.
+ */
+#include "GDCore/IDE/ProjectStripper.h"
+#include "DummyPlatform.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/ExternalEvents.h"
+#include "GDCore/Project/ExternalLayout.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+TEST_CASE("ProjectStripper", "[common]") {
+  SECTION("Project serialized for runtime") {
+    gd::Platform platform;
+    gd::Project project;
+    SetupProjectWithDummyPlatform(project, platform);
+    gd::Layout& layout = project.InsertNewLayout("Layout", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "Object", 0);
+    layout.GetInitialInstances().InsertNewInitialInstance().SetObjectName(
+        "Object");
+    gd::StandardEvent event;
+    layout.GetEvents().InsertEvent(event);
+    layout.GetObjectGroups().InsertNew("Group", 0);
+    project.InsertNewExternalEvents("ExternalEvents", 0);
+    project.InsertNewExternalLayout("ExternalLayout", 0)
+        .GetInitialInstances()
+        .InsertNewInitialInstance()
+        .SetObjectName("Object");
+
+    gd::SerializerElement element;
+    gd::ProjectStripper::SerializeProjectForRuntime(project, element);
+    REQUIRE(element.HasChild("externalEvents") == false);
+    REQUIRE(element.HasChild("objectsGroups") == false);
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 1);
+    const gd::SerializerElement& layoutElement =
+        element.GetChild("layouts").GetChild(0);
+    REQUIRE(layoutElement.HasChild("events") == false);
+    REQUIRE(layoutElement.HasChild("objectsGroups") == false);
+    REQUIRE(layoutElement.HasChild("instances") == true);
+
+    // The project is not modified.
+    REQUIRE(project.GetLayout("Layout").GetEvents().GetEventsCount() == 1);
+    REQUIRE(project.GetExternalEventsCount() == 1);
+
+    // The element is loaded like a full project, from the binary format.
+    gd::Project runtimeProject;
+    runtimeProject.AddPlatform(platform);
+    runtimeProject.UnserializeFrom(
+        gd::Serializer::FromBinary(gd::Serializer::ToBinary(element)));
+    REQUIRE(runtimeProject.GetLayoutsCount() == 1);
+    const gd::Layout& runtimeLayout = runtimeProject.GetLayout("Layout");
+    REQUIRE(runtimeLayout.HasObjectNamed("Object") == true);
+    REQUIRE(runtimeLayout.GetInitialInstances().GetInstancesCount() == 1);
+    REQUIRE(runtimeLayout.GetEvents().GetEventsCount() == 0);
+    REQUIRE(runtimeProject.GetExternalEventsCount() == 0);
+    REQUIRE(runtimeProject.GetExternalLayout("ExternalLayout")
+                .GetInitialInstances()
+                .GetInstancesCount() == 1);
+  }
+}
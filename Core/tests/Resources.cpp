@@ -7,11 +7,16 @@
  * @file Tests covering common features of GDevelop Core.
  */
 #include <string>
+#include "DummyPlatform.h"
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Extensions/Platform.h"
 #include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
 #include "GDCore/IDE/Project/ProjectResourcesAdder.h"
+#include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Project/Variable.h"
 #include "GDCore/Serialization/Serializer.h"
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
@@ -46,6 +51,29 @@ TEST_CASE("Resources", "[common][resources]") {
     image.SetFile("Lots\\\\Of\\\\\\..\\Backslashs");
     REQUIRE(image.GetFile() == "Lots//Of///../Backslashs");
   }
+  SECTION("Lookup by name") {
+    gd::ResourcesManager resources;
+    resources.AddResource("res1", "file1.png", "image");
+    resources.AddResource("res2", "file2.png", "image");
+    REQUIRE(resources.HasResource("res1") == true);
+    REQUIRE(resources.GetResourcePosition("res2") == 1);
+    REQUIRE(resources.HasResource("res3") == false);
+
+    resources.MoveResource(1, 0);
+    REQUIRE(resources.GetResourcePosition("res2") == 0);
+
+    resources.RenameResource("res2", "res3");
+    REQUIRE(resources.HasResource("res2") == false);
+    REQUIRE(resources.GetResource("res3").GetFile() == "file2.png");
+
+    resources.GetResource("res1").SetName("renamed");
+    REQUIRE(resources.HasResource("res1") == false);
+    REQUIRE(resources.GetResourcePosition("renamed") == 1);
+
+    resources.RemoveResource("res3");
+    REQUIRE(resources.GetResourcePosition("renamed") == 0);
+    REQUIRE(&resources.GetResource("res3") == &resources.GetResource("none"));
+  }
   SECTION("ArbitraryResourceWorker") {
     gd::Project project;
     project.GetResourcesManager().AddResource(
@@ -98,6 +126,37 @@ TEST_CASE("Resources", "[common][resources]") {
         REQUIRE(remainingResources[0] == "res1");
         REQUIRE(remainingResources[1] == "res4");
       }
+      SECTION("ProjectResourcesAdder with resources referred to by strings") {
+        gd::Platform platform;
+        SetupProjectWithDummyPlatform(project, platform);
+        gd::Layout& layout = project.InsertNewLayout("Scene", 0);
+        gd::StandardEvent event;
+        gd::Instruction action("MyExtension::DoSomething");
+        action.SetParametersCount(1);
+        action.SetParameter(0, "\"res2\"");
+        event.GetActions().Insert(action);
+        layout.GetEvents().InsertEvent(event);
+
+        std::vector<gd::String> unreferencedResources =
+            gd::ProjectResourcesAdder::GetAllUnreferenced(project, "image");
+        REQUIRE(unreferencedResources.size() == 1);
+        REQUIRE(unreferencedResources[0] == "res3");
+
+        // Resources can also be referred to by their files.
+        project.GetVariables().InsertNew("MyVariable", 0).SetString(
+            "path/to/file3.png");
+        REQUIRE(gd::ProjectResourcesAdder::GetAllUnreferenced(project, "image")
+                    .empty());
+
+        project.GetVariables().Remove("MyVariable");
+        gd::ProjectResourcesAdder::RemoveAllUnreferenced(project, "image");
+        std::vector<gd::String> remainingResources =
+            project.GetResourcesManager().GetAllResourceNames();
+        REQUIRE(remainingResources.size() == 3);
+        REQUIRE(remainingResources[0] == "res1");
+        REQUIRE(remainingResources[1] == "res2");
+        REQUIRE(remainingResources[2] == "res4");
+      }
     }
   }
 }
@@ -4,18 +4,24 @@
  * reserved. This project is released under the MIT License.
  */
 /**
- * @file Tests covering serialization to JSON.
+ * @file Tests covering serialization to JSON and to the binary format.
  */
 #include "GDCore/Serialization/Serializer.h"
+#include "DummyPlatform.h"
 #include "GDCore/CommonTools.h"
+#include "GDCore/Serialization/JsonReader.h"
+#include "GDCore/Serialization/XmlReader.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Serialization.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/Variable.h"
 #include "GDCore/Tools/SystemStats.h"
+#include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
 
@@ -46,6 +52,36 @@ TEST_CASE("SerializerElement", "[common]") {
     REQUIRE(copiedElement.GetChild("child2").GetDoubleValue() == 45.678);
     REQUIRE(copiedElement.GetStringAttribute("attr1") == "attr123 modified");
   }
+  SECTION("Many children and attributes") {
+    SerializerElement element;
+    for (int i = 0; i < 100; ++i) {
+      element.AddChild("child" + gd::String::From(i)).SetIntValue(i);
+      element.SetAttribute("attr" + gd::String::From(99 - i), i);
+    }
+    element.AddChild("child5").SetIntValue(1000);
+
+    REQUIRE(element.GetAllChildren().size() == 101);
+    REQUIRE(element.GetChild("child42").GetIntValue() == 42);
+    REQUIRE(element.GetChild("child5").GetIntValue() == 5);
+    REQUIRE(element.GetChild("child5", 1).GetIntValue() == 1000);
+    REQUIRE(element.GetChild("unknown", 0, "child7").GetIntValue() == 7);
+    REQUIRE(element.HasChild("child99"));
+    REQUIRE(!element.HasChild("child100"));
+    REQUIRE(element.GetIntAttribute("attr0") == 99);
+    REQUIRE(element.GetAllAttributes().front().first == "attr0");
+
+    element.RemoveChild("child42");
+    REQUIRE(!element.HasChild("child42"));
+    REQUIRE(element.GetChild("child43").GetIntValue() == 43);
+
+    SerializerElement movedElement = std::move(element);
+    REQUIRE(movedElement.GetChild("child99").GetIntValue() == 99);
+
+    // Copy a child in its parent.
+    movedElement = movedElement.GetChild("child3");
+    REQUIRE(movedElement.GetIntValue() == 3);
+    REQUIRE(movedElement.GetAllChildren().empty());
+  }
 }
 
 TEST_CASE("Serializer", "[common]") {
@@ -128,4 +164,271 @@ TEST_CASE("Serializer", "[common]") {
       REQUIRE(unserializeAndSerializeToJSON(test2) == test2);
     }
   }
+
+  SECTION("Binary basics") {
+    SerializerElement element;
+    element.SetStringAttribute("name", "value");
+    element.SetIntAttribute("negative", -123456);
+    element.SetDoubleAttribute("double", 45.678);
+    element.SetBoolAttribute("bool", true);
+    element.AddChild("child1").SetStringValue(u8"官话 value");
+    element.AddChild("child2").SetIntValue(42);
+    SerializerElement& array = element.AddChild("array");
+    array.ConsiderAsArrayOf("item");
+    array.AddChild("item").SetStringAttribute("name", "value");
+    array.AddChild("item").SetDoubleValue(-1.5);
+
+    std::string binary = Serializer::ToBinary(element);
+    REQUIRE(Serializer::IsBinary(binary) == true);
+
+    SerializerElement unserialized = Serializer::FromBinary(binary);
+    REQUIRE(unserialized.GetStringAttribute("name") == "value");
+    REQUIRE(unserialized.GetIntAttribute("negative") == -123456);
+    REQUIRE(unserialized.GetDoubleAttribute("double") == 45.678);
+    REQUIRE(unserialized.GetBoolAttribute("bool") == true);
+    REQUIRE(unserialized.GetChild("child1").GetStringValue() ==
+            u8"官话 value");
+    REQUIRE(unserialized.GetChild("child2").GetIntValue() == 42);
+    REQUIRE(unserialized.GetChild("array").ConsideredAsArrayOf() == "item");
+    REQUIRE(unserialized.GetChild("array").GetChildrenCount("item") == 2);
+    REQUIRE(unserialized.GetChild("array")
+                .GetChild("item", 0)
+                .GetStringAttribute("name") == "value");
+    REQUIRE(
+        unserialized.GetChild("array").GetChild("item", 1).GetDoubleValue() ==
+        -1.5);
+    REQUIRE(Serializer::ToJSON(unserialized) == Serializer::ToJSON(element));
+  }
+
+  SECTION("Binary round trip of JSON") {
+    gd::String originalJSON =
+        "{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1,\"-2\","
+        "{\"-3\": [-4]}]},\"ok\": true}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    SerializerElement unserialized =
+        Serializer::FromBinary(Serializer::ToBinary(element));
+    REQUIRE(Serializer::ToJSON(unserialized) == originalJSON);
+  }
+
+  SECTION("Invalid binary data") {
+    REQUIRE(Serializer::IsBinary("{\"ok\": true}") == false);
+
+    SerializerElement element;
+    element.AddChild("child").SetStringValue("value");
+    std::string binary = Serializer::ToBinary(element);
+    binary.resize(binary.size() - 2);
+    SerializerElement unserialized = Serializer::FromBinary(binary);
+    REQUIRE(unserialized.HasChild("child") == false);
+  }
+}
+
+TEST_CASE("JsonReader", "[common]") {
+  SECTION("Tokens") {
+    std::string json =
+        "{\"a\": [1, -2.5e1, true, null, \"\\\"\\u00e9\\ud83d\\ude00\"],"
+        "\"b\": {}}";
+    gd::JsonReader reader(json);
+    REQUIRE(reader.Next() == gd::JsonReader::BeginObject);
+    REQUIRE(reader.Next() == gd::JsonReader::Name);
+    REQUIRE(reader.GetString() == "a");
+    REQUIRE(reader.Next() == gd::JsonReader::BeginArray);
+    REQUIRE(reader.Next() == gd::JsonReader::Number);
+    REQUIRE(reader.GetValue().GetDouble() == 1);
+    REQUIRE(reader.Next() == gd::JsonReader::Number);
+    REQUIRE(reader.GetValue().GetDouble() == -25);
+    REQUIRE(reader.Next() == gd::JsonReader::Boolean);
+    REQUIRE(reader.GetValue().GetBool() == true);
+    REQUIRE(reader.Next() == gd::JsonReader::Null);
+    REQUIRE(reader.Next() == gd::JsonReader::String);
+    REQUIRE(reader.GetString() == u8"\"é😀");
+    REQUIRE(reader.Next() == gd::JsonReader::EndArray);
+    REQUIRE(reader.Next() == gd::JsonReader::Name);
+    REQUIRE(reader.GetString() == "b");
+    REQUIRE(reader.Next() == gd::JsonReader::BeginObject);
+    REQUIRE(reader.Next() == gd::JsonReader::EndObject);
+    REQUIRE(reader.Next() == gd::JsonReader::EndObject);
+    REQUIRE(reader.Next() == gd::JsonReader::End);
+  }
+
+  SECTION("Skipping values") {
+    std::string json = "{\"a\": {\"b\": [1, {\"c\": []}]}, \"d\": 2}";
+    gd::JsonReader reader(json);
+    REQUIRE(reader.Next() == gd::JsonReader::BeginObject);
+    REQUIRE(reader.Next() == gd::JsonReader::Name);
+    REQUIRE(reader.Next() == gd::JsonReader::BeginObject);
+    reader.SkipValue();
+    REQUIRE(reader.Next() == gd::JsonReader::Name);
+    REQUIRE(reader.GetString() == "d");
+    REQUIRE(reader.Next() == gd::JsonReader::Number);
+    REQUIRE(reader.Next() == gd::JsonReader::EndObject);
+  }
+
+  SECTION("Same elements as FromJSON") {
+    gd::String json =
+        "{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1,\"-2\","
+        "{\"-3\": [-4]}]},\"special-\\b\\f\\n\\r\\t\\\"\": "
+        "\"\\b\\f\\n\\r\\t\",\"ok\": true}";
+    gd::JsonReader reader(json.Raw());
+    reader.Next();
+    SerializerElement element;
+    reader.ReadElement(element);
+    REQUIRE(reader.HasError() == false);
+    REQUIRE(Serializer::ToJSON(element) == json);
+  }
+
+  SECTION("Invalid JSON") {
+    std::string json = "{\"a\": [1, 2}";
+    gd::JsonReader reader(json);
+    reader.Next();
+    SerializerElement element;
+    reader.ReadElement(element);
+    REQUIRE(reader.HasError() == true);
+    REQUIRE(reader.Next() == gd::JsonReader::Error);
+  }
+}
+
+TEST_CASE("XmlReader", "[common]") {
+  SECTION("Tokens") {
+    std::string xml =
+        "<?xml version=\"1.0\" ?><!-- Comment --><a b='1' c=\"&lt;&#233;\">"
+        "\n  Hello\n  world <d/><![CDATA[ <raw> ]]></a>";
+    gd::XmlReader reader(xml);
+    REQUIRE(reader.Next() == gd::XmlReader::BeginElement);
+    REQUIRE(reader.GetName() == "a");
+    REQUIRE(reader.Next() == gd::XmlReader::Attribute);
+    REQUIRE(reader.GetName() == "b");
+    REQUIRE(reader.GetString() == "1");
+    REQUIRE(reader.Next() == gd::XmlReader::Attribute);
+    REQUIRE(reader.GetName() == "c");
+    REQUIRE(reader.GetString() == u8"<é");
+    REQUIRE(reader.Next() == gd::XmlReader::Text);
+    REQUIRE(reader.GetString() == "Hello world");
+    REQUIRE(reader.Next() == gd::XmlReader::BeginElement);
+    REQUIRE(reader.GetName() == "d");
+    REQUIRE(reader.Next() == gd::XmlReader::EndElement);
+    REQUIRE(reader.Next() == gd::XmlReader::Text);
+    REQUIRE(reader.GetString() == " <raw> ");
+    REQUIRE(reader.Next() == gd::XmlReader::EndElement);
+    REQUIRE(reader.GetName() == "a");
+    REQUIRE(reader.Next() == gd::XmlReader::End);
+  }
+
+  SECTION("Skipping elements") {
+    std::string xml = "<a><b><c x=\"1\">text</c><d/></b><e/></a>";
+    gd::XmlReader reader(xml);
+    REQUIRE(reader.Next() == gd::XmlReader::BeginElement);
+    REQUIRE(reader.Next() == gd::XmlReader::BeginElement);
+    reader.SkipElement();
+    REQUIRE(reader.Next() == gd::XmlReader::BeginElement);
+    REQUIRE(reader.GetName() == "e");
+  }
+
+  SECTION("Same elements as FromXML with TinyXml") {
+    std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        "<Project version=\"3\">\n"
+        "  <Info name=\"My &quot;game&quot;\" empty=\"\" />\n"
+        "  <Text>  Spaces   are\n condensed &amp; decoded  </Text>\n"
+        "  <Mixed><Child />Not the value</Mixed>\n"
+        "  <Blank>   </Blank>\n"
+        "  <Raw><![CDATA[ kept  as is ]]></Raw>\n"
+        "  <Unknown>&nbsp;&#x41;&#66;</Unknown>\n"
+        "</Project>\n";
+
+    TiXmlDocument doc;
+    doc.Parse(xml.c_str());
+    SerializerElement tinyXmlElement;
+    Serializer::FromXML(tinyXmlElement, doc.FirstChildElement());
+
+    SerializerElement element;
+    REQUIRE(Serializer::FromXML(element, xml) == true);
+    REQUIRE(Serializer::ToJSON(element) == Serializer::ToJSON(tinyXmlElement));
+    REQUIRE(element.GetStringAttribute("version") == "3");
+    REQUIRE(element.GetChild("Text").GetStringValue() ==
+            "Spaces are condensed & decoded");
+  }
+
+  SECTION("Invalid XML") {
+    SerializerElement element;
+    REQUIRE(Serializer::FromXML(element, "<a><b></a></b>") == false);
+    REQUIRE(Serializer::FromXML(element, "<a attr=1></a>") == false);
+    REQUIRE(Serializer::FromXML(element, "<a>") == false);
+    REQUIRE(Serializer::FromXML(element, "No element") == false);
+  }
+}
+
+TEST_CASE("Project unserialization", "[common]") {
+  SECTION("Layouts and external events unserialized by several threads") {
+    gd::Platform platform;
+    gd::Project project;
+    SetupProjectWithDummyPlatform(project, platform);
+    for (std::size_t i = 0; i < 10; ++i) {
+      gd::String name = "Layout" + gd::String::From(i);
+      gd::Layout& layout = project.InsertNewLayout(name, i);
+      layout.InsertNewObject(project, "MyExtension::Sprite", "Object", 0);
+      layout.GetInitialInstances().InsertNewInitialInstance().SetObjectName(
+          "Object");
+      layout.GetVariables().InsertNew("Variable", 0).SetValue(i);
+      project.InsertNewExternalEvents("External" + name, i)
+          .SetAssociatedLayout(name);
+    }
+    SerializerElement element;
+    project.SerializeTo(element);
+
+    gd::Project unserializedProject;
+    unserializedProject.AddPlatform(platform);
+    unserializedProject.UnserializeFrom(element, 4);
+    REQUIRE(unserializedProject.GetLayoutsCount() == 10);
+    REQUIRE(unserializedProject.GetLayout(7).GetName() == "Layout7");
+    REQUIRE(unserializedProject.GetLayout(7)
+                .GetVariables()
+                .Get("Variable")
+                .GetValue() == 7);
+    REQUIRE(unserializedProject.GetExternalEventsCount() == 10);
+
+    SerializerElement unserializedElement;
+    unserializedProject.SerializeTo(unserializedElement);
+    REQUIRE(Serializer::ToJSON(unserializedElement) ==
+            Serializer::ToJSON(element));
+  }
+  SECTION("Layouts loaded lazily") {
+    gd::Platform platform;
+    gd::Project project;
+    SetupProjectWithDummyPlatform(project, platform);
+    for (std::size_t i = 0; i < 3; ++i) {
+      gd::Layout& layout =
+          project.InsertNewLayout("Layout" + gd::String::From(i), i);
+      layout.InsertNewObject(project, "MyExtension::Sprite", "Object", 0);
+      layout.GetVariables().InsertNew("Variable", 0).SetValue(i);
+    }
+    SerializerElement element;
+    project.SerializeTo(element);
+
+    gd::Project unserializedProject;
+    unserializedProject.AddPlatform(platform);
+    unserializedProject.SetLayoutsLoadedLazily(true);
+    unserializedProject.UnserializeFrom(element);
+    gd::Layout& layout = unserializedProject.GetLayout("Layout2");
+    REQUIRE(layout.IsLoaded() == false);
+    REQUIRE(layout.HasObjectNamed("Object") == false);
+
+    SerializerElement lazyElement;
+    unserializedProject.SerializeTo(lazyElement);
+    REQUIRE(Serializer::ToJSON(lazyElement) == Serializer::ToJSON(element));
+
+    layout.Load(unserializedProject);
+    REQUIRE(layout.IsLoaded() == true);
+    REQUIRE(layout.HasObjectNamed("Object") == true);
+    REQUIRE(layout.GetVariables().Get("Variable").GetValue() == 2);
+
+    gd::Layout copiedLayout = layout;
+    layout.Unload();
+    REQUIRE(layout.IsLoaded() == false);
+    REQUIRE(layout.GetName() == "Layout2");
+    REQUIRE(layout.HasObjectNamed("Object") == false);
+    REQUIRE(copiedLayout.HasObjectNamed("Object") == true);
+
+    layout.Load(unserializedProject);
+    REQUIRE(layout.GetVariables().Get("Variable").GetValue() == 2);
+  }
 }
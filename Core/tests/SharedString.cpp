@@ -0,0 +1,63 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the shared strings of GDevelop Core.
+ */
+#include "GDCore/Tools/SharedString.h"
+#include <memory>
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "catch.hpp"
+
+TEST_CASE("SharedString", "[common]") {
+  SECTION("Strings with the same content share their storage") {
+    gd::SharedString a("MyExtension::MyAction");
+    gd::SharedString b(gd::String("MyExtension::") + "MyAction");
+    gd::SharedString c("MyExtension::MyOtherAction");
+
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(&a.Get() == &b.Get());
+    REQUIRE(a == "MyExtension::MyAction");
+    REQUIRE(c.Get() == "MyExtension::MyOtherAction");
+
+    gd::SharedString empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty == gd::SharedString(""));
+  }
+  SECTION("Storage is released when no longer used") {
+    std::size_t count = gd::SharedString::GetSharedStringsCount();
+    {
+      auto a = std::make_shared<gd::SharedString>("A string only used here");
+      gd::SharedString b("A string only used here");
+      REQUIRE(gd::SharedString::GetSharedStringsCount() == count + 1);
+
+      a.reset();
+      REQUIRE(b == "A string only used here");
+      REQUIRE(gd::SharedString::GetSharedStringsCount() == count + 1);
+    }
+    REQUIRE(gd::SharedString::GetSharedStringsCount() == count);
+
+    gd::SharedString c("A string only used here");
+    REQUIRE(c == "A string only used here");
+  }
+  SECTION("Instructions and instances share the storage of their identifiers") {
+    gd::Instruction instruction1("MyExtension::DoSomething");
+    gd::Instruction instruction2;
+    instruction2.SetType("MyExtension::DoSomething");
+    REQUIRE(&instruction1.GetType() == &instruction2.GetType());
+
+    gd::InitialInstance instance1;
+    instance1.SetObjectName("MyObject");
+    instance1.SetLayer("MyLayer");
+    gd::InitialInstance instance2;
+    instance2.SetObjectName("MyObject");
+    instance2.SetLayer("MyLayer");
+    REQUIRE(&instance1.GetObjectName() == &instance2.GetObjectName());
+    REQUIRE(&instance1.GetLayer() == &instance2.GetLayer());
+    REQUIRE(instance2.GetLayer() == "MyLayer");
+  }
+}
@@ -0,0 +1,117 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the packing of images in texture atlases.
+ */
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+namespace {
+bool Overlap(const gd::TextureAtlasPacker::Region& region1,
+             const gd::TextureAtlasPacker::Region& region2,
+             unsigned int padding) {
+  return region1.atlas == region2.atlas &&
+         region1.x < region2.x + region2.width + padding &&
+         region2.x < region1.x + region1.width + padding &&
+         region1.y < region2.y + region2.height + padding &&
+         region2.y < region1.y + region1.height + padding;
+}
+}  // namespace
+
+TEST_CASE("TextureAtlasPacker", "[common][resources]") {
+  SECTION("Images are packed without overlapping") {
+    gd::TextureAtlasPacker packer(256, 2);
+    REQUIRE(packer.AddImage("Image1", 100, 50) == true);
+    REQUIRE(packer.AddImage("Image2", 60, 60) == true);
+    REQUIRE(packer.AddImage("Image3", 120, 20) == true);
+    REQUIRE(packer.AddImage("Image4", 30, 30) == true);
+    REQUIRE(packer.AddImage("Image4", 30, 30) == false);
+    packer.Pack();
+
+    REQUIRE(packer.GetAtlasesCount() == 1);
+    const auto& regions = packer.GetRegions();
+    REQUIRE(regions.size() == 4);
+    for (const auto& region1 : regions) {
+      REQUIRE(region1.second.x >= packer.GetPadding());
+      REQUIRE(region1.second.y >= packer.GetPadding());
+      unsigned int right =
+          region1.second.x + region1.second.width + packer.GetPadding();
+      unsigned int bottom =
+          region1.second.y + region1.second.height + packer.GetPadding();
+      REQUIRE(right <= packer.GetAtlasWidth(region1.second.atlas));
+      REQUIRE(bottom <= packer.GetAtlasHeight(region1.second.atlas));
+      for (const auto& region2 : regions) {
+        if (region1.first == region2.first) continue;
+        REQUIRE(Overlap(region1.second, region2.second, packer.GetPadding()) ==
+                false);
+      }
+    }
+    REQUIRE(regions.find("Image2")->second.x == 2);
+    REQUIRE(regions.find("Image2")->second.y == 2);
+    REQUIRE(regions.find("Image2")->second.width == 60);
+  }
+
+  SECTION("New atlases are started when needed") {
+    gd::TextureAtlasPacker packer(128, 0);
+    REQUIRE(packer.AddImage("TooLarge", 129, 10) == false);
+    for (int i = 0; i < 5; ++i)
+      REQUIRE(packer.AddImage("Image" + gd::String::From(i), 64, 64) == true);
+    packer.Pack();
+
+    REQUIRE(packer.GetAtlasesCount() == 2);
+    REQUIRE(packer.GetAtlasWidth(0) == 128);
+    REQUIRE(packer.GetAtlasHeight(0) == 128);
+    REQUIRE(packer.GetAtlasWidth(1) == 64);
+    REQUIRE(packer.GetAtlasHeight(1) == 64);
+    REQUIRE(packer.GetRegions().find("TooLarge") == packer.GetRegions().end());
+    REQUIRE(packer.GetRegions().find("Image4")->second.atlas == 1);
+  }
+
+  SECTION("Packing is the same whatever the order of the images") {
+    gd::TextureAtlasPacker packer1(256, 1);
+    gd::TextureAtlasPacker packer2(256, 1);
+    packer1.AddImage("A", 32, 32);
+    packer1.AddImage("B", 32, 32);
+    packer1.AddImage("C", 16, 48);
+    packer2.AddImage("C", 16, 48);
+    packer2.AddImage("B", 32, 32);
+    packer2.AddImage("A", 32, 32);
+    packer1.Pack();
+    packer2.Pack();
+
+    for (const auto& region : packer1.GetRegions()) {
+      const auto& otherRegion = packer2.GetRegions().find(region.first)->second;
+      REQUIRE(region.second.x == otherRegion.x);
+      REQUIRE(region.second.y == otherRegion.y);
+    }
+  }
+
+  SECTION("Atlas of image resources is serialized") {
+    gd::ImageResource image;
+    image.SetName("Image");
+    image.SetFile("image.png");
+    REQUIRE(image.IsInAtlas() == false);
+    image.SetAtlas("gdatlas0.png", 10, 20, 30, 40);
+
+    gd::SerializerElement element;
+    image.SerializeTo(element);
+    gd::ImageResource unserializedImage;
+    unserializedImage.UnserializeFrom(element);
+    REQUIRE(unserializedImage.IsInAtlas() == true);
+    REQUIRE(unserializedImage.GetAtlasFile() == "gdatlas0.png");
+    REQUIRE(unserializedImage.GetAtlasX() == 10);
+    REQUIRE(unserializedImage.GetAtlasY() == 20);
+    REQUIRE(unserializedImage.GetAtlasWidth() == 30);
+    REQUIRE(unserializedImage.GetAtlasHeight() == 40);
+
+    unserializedImage.SetAtlas("", 0, 0, 0, 0);
+    gd::SerializerElement otherElement;
+    unserializedImage.SerializeTo(otherElement);
+    REQUIRE(otherElement.HasChild("atlas") == false);
+  }
+}
@@ -10,6 +10,7 @@
 #include <SFML/System/String.hpp>
 #include <exception>
 #include <iostream>
+#include <type_traits>
 #include <string>
 #include <vector>
 #include "GDCore/String.h"
@@ -289,4 +290,55 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     gd::String str6 = u8"ßßß";
     REQUIRE(str6.FindAndReplace(u8"ßß", u8"ß") == u8"ßß");
   }
+  SECTION("ASCII strings") {
+    gd::String str = "Hello world";
+    REQUIRE(str.size() == 11);
+    REQUIRE(str[4] == U'o');
+    REQUIRE(str.substr(6) == "world");
+    REQUIRE(str.substr(6, 3) == "wor");
+    REQUIRE(str.substr(11) == "");
+    REQUIRE_THROWS_AS(str.substr(12), std::out_of_range);
+    REQUIRE(str.find("o") == 4);
+    REQUIRE(str.find("o", 5) == 7);
+    REQUIRE(str.find(u8"ß") == gd::String::npos);
+    REQUIRE(str.find("", 11) == gd::String::npos);
+    REQUIRE(str.rfind("o") == 7);
+    REQUIRE(str.rfind("o", 6) == 4);
+    REQUIRE(str.find_first_of(u8"ßw") == 6);
+    REQUIRE(str.find_first_not_of(u8"Hßel") == 4);
+    REQUIRE(str.find_last_of(u8"ßl", 8) == 3);
+    REQUIRE(str.find_last_not_of(u8"dßl") == 8);
+
+    // The searches are still right once the string is not ASCII anymore.
+    str += u8" ß";
+    REQUIRE(str.size() == 13);
+    REQUIRE(str[12] == U'ß');
+    REQUIRE(str.substr(6, 5) == "world");
+    REQUIRE(str.find(u8"ß") == 12);
+    str.pop_back();
+    str.push_back(U'!');
+    REQUIRE(str.size() == 13);
+    REQUIRE(str.find("!") == 12);
+    str.erase(5, 6);
+    REQUIRE(str == "Hello !");
+    REQUIRE(str.size() == 7);
+    str.insert(5, u8"ß");
+    REQUIRE(str.size() == 8);
+    str.Raw() += u8"ßß";
+    REQUIRE(str.size() == 10);
+    REQUIRE(str.find("!") == 7);
+    str.clear();
+    REQUIRE(str.size() == 0);
+
+    gd::String movedStr = u8"ßab";
+    REQUIRE(movedStr.size() == 3);
+    gd::String otherStr = std::move(movedStr);
+    REQUIRE(otherStr.size() == 3);
+    REQUIRE(otherStr[1] == U'a');
+    REQUIRE(otherStr[0] == U'ß');
+    REQUIRE(std::is_nothrow_move_constructible<gd::String>::value);
+    REQUIRE(std::is_nothrow_move_assignable<gd::String>::value);
+    movedStr = "abc";
+    REQUIRE(movedStr[2] == U'c');
+  }
 }
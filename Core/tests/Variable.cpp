@@ -9,7 +9,10 @@
 #include "catch.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <initializer_list>
+#include <iostream>
 #include <map>
 
 #include "GDCore/CommonTools.h"
@@ -39,6 +42,29 @@ TEST_CASE("Variable", "[common][variables]") {
     variable.SetString("MyString");
     REQUIRE(variable.GetValue() == 0);     // Used as a number...
     REQUIRE(variable.IsNumber() == true);  //...so consider as a number
+
+    variable.SetString("  -12.5e2abc");
+    REQUIRE(variable.GetValue() == -1250);
+    variable.SetString("0x10");
+    REQUIRE(variable.GetValue() == 0);
+    variable.SetString("inf");
+    REQUIRE(variable.GetValue() == 0);
+    variable.SetValue(1.0 / 3);
+    REQUIRE(variable.GetString() == "0.333333");
+    variable.SetValue(-1e20);
+    REQUIRE(variable.GetString() == "-1e+20");
+  }
+  SECTION("Conversions are kept") {
+    gd::Variable variable;
+    variable.SetValue(1.0 / 3);
+    REQUIRE(variable.GetString() == "0.333333");
+    REQUIRE(variable.GetValue() == 1.0 / 3);  // Not read from the string.
+    REQUIRE(variable.IsNumber() == true);
+
+    variable.SetString("12");
+    REQUIRE(variable.GetValue() == 12);
+    REQUIRE(variable.GetString() == "12");
+    REQUIRE(variable.IsNumber() == false);
   }
   SECTION("Use with int and string like semantics") {
     gd::Variable variable;
@@ -54,6 +80,24 @@ TEST_CASE("Variable", "[common][variables]") {
     REQUIRE(variable.GetString() == "MyRealStdString");
     REQUIRE(variable.IsNumber() == false);
   }
+  SECTION("Append to a string") {
+    gd::Variable variable;
+    variable = 12;
+    variable += gd::String("3");  // The number is converted to a string.
+    REQUIRE(variable.GetString() == "123");
+    REQUIRE(variable.IsNumber() == false);
+    REQUIRE(variable.GetValue() == 123);
+
+    variable.AppendString("4");
+    REQUIRE(variable.GetString() == "1234");
+    variable.AppendString(variable.GetString());
+    REQUIRE(variable.GetString() == "12341234");
+
+    gd::Variable structure;
+    structure.GetChild("Child");
+    structure.AppendString("Text");
+    REQUIRE(structure.IsStructure() == false);
+  }
   SECTION("Copy and assignment") {
     gd::Variable variable1;
     gd::Variable variable2;
@@ -87,4 +131,104 @@ TEST_CASE("Variable", "[common][variables]") {
             "Hello second copied World");
     REQUIRE(variable3.GetChild("Child2").GetValue() == 44);
   }
+
+  SECTION("Children") {
+    gd::Variable variable;
+    variable.GetChild("Child3").SetValue(3);
+    variable.GetChild("Child1").SetValue(1);
+    gd::Variable& child2 = variable.GetChild("Child2");
+    child2.SetValue(2);
+
+    // Children are kept sorted by name, and references to them stay valid.
+    REQUIRE(variable.GetAllChildrenNames() ==
+            std::vector<gd::String>({"Child1", "Child2", "Child3"}));
+    variable.GetChild("Child0");
+    variable.GetChild("Child4");
+    REQUIRE(child2.GetValue() == 2);
+
+    REQUIRE(variable.RenameChild("Child1", "Child5") == true);
+    REQUIRE(variable.RenameChild("Child2", "Child3") == false);
+    REQUIRE(variable.RenameChild("Nothing", "Child6") == false);
+    REQUIRE(variable.GetAllChildrenNames() ==
+            std::vector<gd::String>(
+                {"Child0", "Child2", "Child3", "Child4", "Child5"}));
+    REQUIRE(variable.GetChild("Child5").GetValue() == 1);
+
+    variable.RemoveChild("Child3");
+    variable.RemoveChild("Nothing");
+    REQUIRE(variable.HasChild("Child3") == false);
+    REQUIRE(variable.HasChild("Child2") == true);
+    REQUIRE(variable.GetAllChildren().size() == 4);
+    REQUIRE(variable.Contains(child2, false) == true);
+  }
+  SECTION("Structure version") {
+    gd::Variable variable;
+    gd::Variable otherVariable;
+    REQUIRE(variable.GetStructureVersion() !=
+            otherVariable.GetStructureVersion());
+
+    // Adding children or changing their values keeps the children valid.
+    std::size_t version = variable.GetStructureVersion();
+    variable.GetChild("Child1").SetValue(1);
+    variable.GetChild("Child2").SetString("Two");
+    REQUIRE(variable.GetStructureVersion() == version);
+
+    variable.RenameChild("Child2", "Child3");
+    REQUIRE(variable.GetStructureVersion() != version);
+
+    version = variable.GetStructureVersion();
+    variable.RemoveChild("Nothing");
+    REQUIRE(variable.GetStructureVersion() == version);
+    variable.RemoveChild("Child3");
+    REQUIRE(variable.GetStructureVersion() != version);
+
+    version = variable.GetStructureVersion();
+    variable.ClearChildren();
+    REQUIRE(variable.GetStructureVersion() != version);
+
+    version = variable.GetStructureVersion();
+    variable = otherVariable;
+    REQUIRE(variable.GetStructureVersion() != version);
+  }
+}
+
+TEST_CASE("Variable - Benchmarks", "[.][benchmark][variables]") {
+  auto benchmark = [](const gd::String& name, std::function<void()> run) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100000; ++i) run();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << name << ": " << duration.count() << "us" << std::endl;
+  };
+
+  SECTION("Number read alternately as a number and as a string") {
+    gd::Variable variable;
+    variable.SetValue(12345.5);
+    double sum = 0;
+    benchmark("Alternate reads of a number", [&]() {
+      sum += variable.GetValue();
+      sum += variable.GetString().size();
+    });
+    REQUIRE(sum == 100000 * (12345.5 + 7));
+  }
+
+  SECTION("Text built by appending") {
+    gd::Variable variable;
+    variable.SetString("");
+    benchmark("Appends to a string", [&]() {
+      variable += gd::String("Line;");
+    });
+    REQUIRE(variable.GetString().size() == 100000 * 5);
+  }
+
+  SECTION("Number changed then read as a string") {
+    gd::Variable variable;
+    std::size_t size = 0;
+    benchmark("Conversions of a number to a string", [&]() {
+      variable.SetValue(variable.GetValue() + 1);
+      size += variable.GetString().size();
+    });
+    REQUIRE(variable.GetValue() == 100000);
+    REQUIRE(size > 0);
+  }
 }
@@ -49,4 +49,26 @@ TEST_CASE("VariablesContainer", "[common][variables]") {
             "Hello second copied World");
     REQUIRE(container3.Get("Variable2").GetValue() == 44);
   }
+  SECTION("Modification count") {
+    gd::VariablesContainer container;
+    REQUIRE(container.GetModificationCount() == 0);
+
+    container.InsertNew("Variable1", 0);
+    container.InsertNew("Variable2", 1);
+    REQUIRE(container.GetModificationCount() == 2);
+    container.Rename("Variable1", "Variable3");
+    container.Move(0, 1);
+    container.Swap(0, 1);
+    REQUIRE(container.GetModificationCount() == 5);
+    container.Remove("Variable2");
+    REQUIRE(container.GetModificationCount() == 6);
+
+    // The changes to the variables are not counted.
+    container.Get("Variable3").SetValue(42);
+    REQUIRE(container.GetModificationCount() == 6);
+
+    gd::VariablesContainer otherContainer;
+    container = otherContainer;
+    REQUIRE(container.GetModificationCount() == 7);
+  }
 }
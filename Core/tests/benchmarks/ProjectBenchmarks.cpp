@@ -0,0 +1,210 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the operations done by the IDE on a whole project.
+ */
+#include <memory>
+#include "ProjectBenchmarks.h"
+#include "../../../GDCpp/tests/benchmarks/Benchmark.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/IDE/Events/ArbitraryEventsWorker.h"
+#include "GDCore/IDE/WholeProjectRefactorer.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+
+namespace {
+/**
+ * \brief Parse all the expressions of the instructions of the events, like
+ * the IDE does to validate or refactor them.
+ */
+class ExpressionsParser : public gd::ArbitraryEventsWorkerWithContext {
+ public:
+  ExpressionsParser(const gd::Platform& platform_)
+      : platform(platform_), parsedExpressionsCount(0){};
+  virtual ~ExpressionsParser(){};
+
+  std::size_t GetParsedExpressionsCount() const {
+    return parsedExpressionsCount;
+  }
+
+ private:
+  bool DoVisitInstruction(gd::Instruction& instruction,
+                          bool isCondition) override {
+    const gd::InstructionMetadata& metadata =
+        isCondition ? gd::MetadataProvider::GetConditionMetadata(
+                          platform, instruction.GetType())
+                    : gd::MetadataProvider::GetActionMetadata(
+                          platform, instruction.GetType());
+
+    gd::ExpressionParser2 parser(
+        platform, GetGlobalObjectsContainer(), GetObjectsContainer());
+    for (std::size_t i = 0; i < metadata.parameters.size() &&
+                            i < instruction.GetParametersCount();
+         ++i) {
+      const gd::String& type = metadata.parameters[i].type;
+      const gd::String& expression =
+          instruction.GetParameter(i).GetPlainString();
+      if (gd::ParameterMetadata::IsExpression("number", type))
+        parser.ParseExpression("number", expression);
+      else if (gd::ParameterMetadata::IsExpression("string", type))
+        parser.ParseExpression("string", expression);
+      else
+        continue;
+
+      parsedExpressionsCount++;
+    }
+
+    return false;
+  }
+
+  const gd::Platform& platform;
+  std::size_t parsedExpressionsCount;
+};
+
+gd::Instruction CreateAction(const gd::String& expression) {
+  gd::Instruction action("MyExtension::DoSomething");
+  action.SetParametersCount(1);
+  action.SetParameter(0, expression);
+  return action;
+}
+}  // namespace
+
+std::string GenerateProjectJSON(gd::Platform& platform,
+                                std::size_t layoutsCount,
+                                std::size_t eventsCount) {
+  gd::Project project;
+  project.AddPlatform(platform);
+  project.InsertNewObject(project, "MyExtension::Sprite", "MyGlobalObject", 0);
+
+  for (std::size_t i = 0; i < layoutsCount; ++i) {
+    gd::Layout& layout =
+        project.InsertNewLayout("Layout" + gd::String::From(i), i);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MySpriteObject", 0);
+    layout.InsertNewObject(project, "MyExtension::Sprite", "MyOtherObject", 1);
+
+    for (std::size_t j = 0; j < 100; ++j) {
+      gd::InitialInstance& instance =
+          layout.GetInitialInstances().InsertNewInitialInstance();
+      instance.SetObjectName(j % 2 ? "MySpriteObject" : "MyOtherObject");
+      instance.SetX(j * 32);
+      instance.SetY(j * 16);
+    }
+
+    for (std::size_t j = 0; j < eventsCount; ++j) {
+      gd::StandardEvent event;
+      event.SetType("BuiltinCommonInstructions::Standard");
+      event.GetActions().Insert(CreateAction(
+          "MySpriteObject.GetObjectNumber() * 2 + MyExtension::GetNumber()"));
+      event.GetActions().Insert(
+          CreateAction("MyExtension::GetVariableAsNumber(MyVariable) + " +
+                       gd::String::From(j)));
+      event.GetActions().Insert(CreateAction(
+          "MyExtension::GetNumberWith2Params(MyOtherObject.GetObjectNumber(), "
+          "MySpriteObject.GetObjectStringWith1Param(" +
+          gd::String::From(j) + ")) / (1 + MyExtension::MouseX())"));
+
+      gd::StandardEvent subEvent;
+      subEvent.SetType("BuiltinCommonInstructions::Standard");
+      subEvent.GetActions().Insert(
+          CreateAction("MyGlobalObject.GetObjectNumber() - 1"));
+      event.GetSubEvents().InsertEvent(subEvent);
+
+      layout.GetEvents().InsertEvent(event);
+    }
+  }
+
+  gd::SerializerElement element;
+  project.SerializeTo(element);
+  return gd::Serializer::ToJSON(element).ToUTF8();
+}
+
+void AddProjectBenchmarks(BenchmarkSuite& suite,
+                          gd::Platform& platform,
+                          const std::string& json) {
+  std::shared_ptr<gd::SerializerElement> element =
+      std::make_shared<gd::SerializerElement>(gd::Serializer::FromJSON(json));
+  std::shared_ptr<gd::Project> project = std::make_shared<gd::Project>();
+  project->AddPlatform(platform);
+  project->UnserializeFrom(*element);
+
+  ExpressionsParser counter(platform);
+  gd::WholeProjectRefactorer::ExposeProjectEvents(*project, counter);
+  gd::String size = " (" + gd::String::From(json.size() / 1024) + " KB, " +
+                    gd::String::From(project->GetLayoutsCount()) +
+                    " layouts, " +
+                    gd::String::From(counter.GetParsedExpressionsCount()) +
+                    " expressions)";
+
+  suite.Add("Serializer::FromJSON" + size,
+            [json](std::size_t) { gd::Serializer::FromJSON(json); });
+
+  // Arrays unserialized from JSON have unnamed children, skipped by ToJSON:
+  // serialize the element created by the project instead.
+  std::shared_ptr<gd::SerializerElement> projectElement =
+      std::make_shared<gd::SerializerElement>();
+  project->SerializeTo(*projectElement);
+  suite.Add("Serializer::ToJSON" + size, [projectElement](std::size_t) {
+    gd::Serializer::ToJSON(*projectElement);
+  });
+
+  suite.Add("Project::UnserializeFrom" + size,
+            [element, &platform](std::size_t) {
+              gd::Project unserializedProject;
+              unserializedProject.AddPlatform(platform);
+              unserializedProject.UnserializeFrom(*element);
+            });
+
+  suite.Add("Project::UnserializeFromJSON" + size,
+            [json, &platform](std::size_t) {
+              gd::Project unserializedProject;
+              unserializedProject.AddPlatform(platform);
+              unserializedProject.UnserializeFromJSON(json);
+            });
+
+  suite.Add("ExpressionParser2::ParseExpression on all expressions" + size,
+            [project, &platform](std::size_t) {
+              ExpressionsParser parser(platform);
+              gd::WholeProjectRefactorer::ExposeProjectEvents(*project,
+                                                              parser);
+            });
+
+  // The object is renamed back and forth, so that each rename changes all the
+  // expressions using it.
+  suite.Add(
+      "WholeProjectRefactorer::ObjectRenamedInLayout on all layouts" + size,
+      [project](std::size_t i) {
+        gd::String oldName = i % 2 ? "MySpriteObject" : "MyRenamedObject";
+        gd::String newName = i % 2 ? "MyRenamedObject" : "MySpriteObject";
+        for (std::size_t j = 0; j < project->GetLayoutsCount(); ++j)
+          gd::WholeProjectRefactorer::ObjectRenamedInLayout(
+              *project, project->GetLayout(j), oldName, newName);
+      });
+
+  suite.Add("EventsCodeGenerator on all layouts" + size,
+            [project, &platform](std::size_t) {
+              for (std::size_t j = 0; j < project->GetLayoutsCount(); ++j) {
+                gd::Layout& layout = project->GetLayout(j);
+                gd::EventsCodeGenerator codeGenerator(
+                    *project, layout, platform);
+                unsigned int maxDepthLevelReached = 0;
+                gd::EventsCodeGenerationContext context(
+                    &maxDepthLevelReached);
+                codeGenerator.GenerateEventsListCode(layout.GetEvents(),
+                                                     context);
+              }
+            });
+}
@@ -0,0 +1,36 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_PROJECTBENCHMARKS_H
+#define GDCORE_PROJECTBENCHMARKS_H
+
+#include <cstddef>
+#include <string>
+class BenchmarkSuite;
+namespace gd {
+class Platform;
+}  // namespace gd
+
+/**
+ * \brief Generate a project using the objects and the instructions of the
+ * platform set up by SetupProjectWithDummyPlatform, and return it in JSON.
+ */
+std::string GenerateProjectJSON(gd::Platform& platform,
+                                std::size_t layoutsCount,
+                                std::size_t eventsCount);
+
+/**
+ * \brief Add the benchmarks of the unserialization, the serialization, the
+ * parsing of the expressions, the refactoring and the code generation of the
+ * project \a json.
+ *
+ * \note Only the expressions of the instructions known by \a platform are
+ * parsed and generated.
+ */
+void AddProjectBenchmarks(BenchmarkSuite& suite,
+                          gd::Platform& platform,
+                          const std::string& json);
+
+#endif  // GDCORE_PROJECTBENCHMARKS_H
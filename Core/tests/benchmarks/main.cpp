@@ -0,0 +1,121 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Main file for GDevelop Core benchmarks
+ *
+ * Usage: GDCore_benchmarks [--project file.json] [--layouts N] [--events N]
+ * [--iterations N] [--filter text] [--output file.json]
+ *
+ * Without a project file, a project with the given number of layouts and of
+ * events per layout is generated. The results are written in JSON (on the
+ * standard output if no file is specified), with the version of GDevelop, so
+ * that the results of different versions can be compared.
+ */
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include "../DummyPlatform.h"
+#include "../../../GDCpp/tests/benchmarks/Benchmark.h"
+#include "ProjectBenchmarks.h"
+#include "GDCore/Extensions/Builtin/AllBuiltinExtensions.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Tools/VersionWrapper.h"
+
+int main(int argc, char* argv[]) {
+  gd::String projectFile;
+  std::size_t layoutsCount = 20;
+  std::size_t eventsCount = 200;
+  std::size_t iterationsCount = 20;
+  gd::String filter;
+  gd::String outputFile;
+
+  for (int i = 1; i < argc; ++i) {
+    gd::String argument = gd::String::FromLocale(argv[i]);
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << argv[i] << std::endl;
+      return 1;
+    }
+
+    gd::String value = gd::String::FromLocale(argv[++i]);
+    if (argument == "--project")
+      projectFile = value;
+    else if (argument == "--layouts")
+      layoutsCount = value.To<std::size_t>();
+    else if (argument == "--events")
+      eventsCount = value.To<std::size_t>();
+    else if (argument == "--iterations")
+      iterationsCount = value.To<std::size_t>();
+    else if (argument == "--filter")
+      filter = value;
+    else if (argument == "--output")
+      outputFile = value;
+    else {
+      std::cerr << "Unknown argument " << argv[i - 1] << std::endl;
+      return 1;
+    }
+  }
+
+  // The logs of GDCore are written on the standard output: send them to the
+  // error output, so that the standard output only contains the results.
+  std::streambuf* standardOutput = std::cout.rdbuf(std::cerr.rdbuf());
+
+  gd::Platform platform;
+  {
+    gd::Project project;
+    SetupProjectWithDummyPlatform(project, platform);
+  }
+  std::shared_ptr<gd::PlatformExtension> commonInstructions =
+      std::make_shared<gd::PlatformExtension>();
+  gd::BuiltinExtensionsImplementer::ImplementsCommonInstructionsExtension(
+      *commonInstructions);
+  platform.AddExtension(commonInstructions);
+
+  std::string json;
+  if (projectFile.empty()) {
+    json = GenerateProjectJSON(platform, layoutsCount, eventsCount);
+  } else {
+    std::ifstream file(projectFile.ToLocale().c_str(), std::ios_base::binary);
+    if (!file.is_open()) {
+      std::cerr << "Unable to read " << projectFile.ToLocale() << std::endl;
+      std::cout.rdbuf(standardOutput);
+      return 1;
+    }
+
+    json.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+  }
+
+  // Each call is measured separately, after a first call which is not
+  // measured.
+  BenchmarkSuite suite(1, iterationsCount, 1);
+  AddProjectBenchmarks(suite, platform, json);
+  suite.Run(filter);
+
+  gd::SerializerElement element;
+  element.SetAttribute("gdevelopVersion", gd::VersionWrapper::FullString());
+  element.SetAttribute(
+      "project", projectFile.empty() ? gd::String("generated") : projectFile);
+  suite.SerializeResultsTo(element.AddChild("benchmarks"));
+  std::string results = gd::Serializer::ToJSON(element).ToUTF8();
+
+  std::cout.rdbuf(standardOutput);
+  if (outputFile.empty()) {
+    std::cout << results << std::endl;
+    return 0;
+  }
+
+  std::ofstream file(outputFile.ToLocale().c_str());
+  file << results << std::endl;
+  if (!file) {
+    std::cerr << "Unable to write " << outputFile.ToLocale() << std::endl;
+    return 1;
+  }
+  return 0;
+}
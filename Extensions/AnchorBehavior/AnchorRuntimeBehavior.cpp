@@ -38,7 +38,15 @@ AnchorRuntimeBehavior::AnchorRuntimeBehavior(
       m_leftEdgeDistance(0.f),
       m_rightEdgeDistance(0.f),
       m_topEdgeDistance(0.f),
-      m_bottomEdgeDistance(0.f) {
+      m_bottomEdgeDistance(0.f),
+      m_invalidPosition(true),
+      m_lastCameraViewVersion(0),
+      m_lastWindowWidth(0),
+      m_lastWindowHeight(0),
+      m_lastX(0.f),
+      m_lastY(0.f),
+      m_lastWidth(0.f),
+      m_lastHeight(0.f) {
   m_relativeToOriginalWindowSize =
       behaviorContent.GetBoolAttribute("relativeToOriginalWindowSize");
   m_leftEdgeAnchor = static_cast<HorizontalAnchor>(
@@ -51,7 +59,10 @@ AnchorRuntimeBehavior::AnchorRuntimeBehavior(
       behaviorContent.GetIntAttribute("bottomEdgeAnchor"));
 }
 
-void AnchorRuntimeBehavior::OnActivate() { m_invalidDistances = true; }
+void AnchorRuntimeBehavior::OnActivate() {
+  m_invalidDistances = true;
+  m_invalidPosition = true;
+}
 
 namespace {
 sf::Vector2f mapFloatPixelToCoords(const sf::Vector2f& point,
@@ -93,7 +104,7 @@ sf::Vector2f mapCoordsToFloatPixel(const sf::Vector2f& point,
 void AnchorRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {}
 
 void AnchorRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
-  const RuntimeLayer& layer = scene.GetRuntimeLayer(object->GetLayer());
+  const RuntimeLayer& layer = scene.GetRuntimeLayer(object->GetInternedLayer());
   const RuntimeCamera& firstCamera = layer.GetCamera(0);
 
   if (m_invalidDistances) {
@@ -151,9 +162,20 @@ void AnchorRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
           bottomRightPixel.y / static_cast<float>(windowSize.y);
 
     m_invalidDistances = false;
+    m_invalidPosition = true;
   } else {
     sf::Vector2u windowSize = scene.renderWindow->getSize();
 
+    // Nothing to do if the object is still where it was put, for the same
+    // camera and window.
+    if (!m_invalidPosition &&
+        m_lastCameraViewVersion == firstCamera.GetViewVersion() &&
+        m_lastWindowWidth == windowSize.x &&
+        m_lastWindowHeight == windowSize.y && m_lastX == object->GetX() &&
+        m_lastY == object->GetY() && m_lastWidth == object->GetWidth() &&
+        m_lastHeight == object->GetHeight())
+      return;
+
     // Move and resize the object if needed
     sf::Vector2f topLeftPixel;
     sf::Vector2f bottomRightPixel;
@@ -208,5 +230,14 @@ void AnchorRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
       object->SetX(topLeftCoord.x + object->GetX() - object->GetDrawableX());
     if (m_topEdgeAnchor != ANCHOR_VERTICAL_NONE)
       object->SetY(topLeftCoord.y + object->GetY() - object->GetDrawableY());
+
+    m_invalidPosition = false;
+    m_lastCameraViewVersion = firstCamera.GetViewVersion();
+    m_lastWindowWidth = windowSize.x;
+    m_lastWindowHeight = windowSize.y;
+    m_lastX = object->GetX();
+    m_lastY = object->GetY();
+    m_lastWidth = object->GetWidth();
+    m_lastHeight = object->GetHeight();
   }
 }
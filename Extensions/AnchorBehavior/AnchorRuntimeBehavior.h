@@ -47,6 +47,11 @@ class GD_EXTENSION_API AnchorRuntimeBehavior : public RuntimeBehavior {
 
   virtual void OnActivate() override;
 
+  /**
+   * \brief The behavior does nothing before events.
+   */
+  virtual bool IsPreEventsStepParallelSafe() const override { return true; }
+
  private:
   virtual void DoStepPreEvents(RuntimeScene& scene) override;
   virtual void DoStepPostEvents(RuntimeScene& scene) override;
@@ -67,6 +72,17 @@ class GD_EXTENSION_API AnchorRuntimeBehavior : public RuntimeBehavior {
   float m_rightEdgeDistance;
   float m_topEdgeDistance;
   float m_bottomEdgeDistance;
+
+  // The camera, window and object when the object was last moved, so that it
+  // is only moved again when one of them changed.
+  bool m_invalidPosition;
+  std::size_t m_lastCameraViewVersion;
+  unsigned int m_lastWindowWidth;
+  unsigned int m_lastWindowHeight;
+  float m_lastX;
+  float m_lastY;
+  float m_lastWidth;
+  float m_lastHeight;
 };
 
 #endif  // ANCHORRuntimeBEHAVIOR_H
@@ -6,11 +6,8 @@ This project is released under the MIT License.
 */
 
 #include "DestroyOutsideRuntimeBehavior.h"
-#include <SFML/Graphics.hpp>
-#include <iostream>
-#include <memory>
-#include "GDCpp/Runtime/CommonTools.h"
-#include "GDCpp/Runtime/Project/Layout.h"
+#include <cmath>
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -22,34 +19,98 @@ DestroyOutsideRuntimeBehavior::DestroyOutsideRuntimeBehavior(
   extraBorder = behaviorContent.GetDoubleAttribute("extraBorder");
 }
 
+bool DestroyOutsideRuntimeBehavior::Reset(
+    const gd::SerializerElement& behaviorContent) {
+  extraBorder = behaviorContent.GetDoubleAttribute("extraBorder");
+  return true;
+}
+
 void DestroyOutsideRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
-  bool erase = true;
-  const RuntimeLayer& theLayer = scene.GetRuntimeLayer(object->GetLayer());
-  float objCenterX = object->GetDrawableX() + object->GetCenterX();
-  float objCenterY = object->GetDrawableY() + object->GetCenterY();
-  for (std::size_t cameraIndex = 0; cameraIndex < theLayer.GetCameraCount();
-       ++cameraIndex) {
-    const RuntimeCamera& theCamera = theLayer.GetCamera(cameraIndex);
-
-    float boundingCircleRadius =
-        sqrt(object->GetWidth() * object->GetWidth() +
-             object->GetHeight() * object->GetHeight()) /
-        2.0;
-    if (objCenterX + boundingCircleRadius + extraBorder <
-            theCamera.GetViewCenter().x - theCamera.GetWidth() / 2.0 ||
-        objCenterX - boundingCircleRadius - extraBorder >
-            theCamera.GetViewCenter().x + theCamera.GetWidth() / 2.0 ||
-        objCenterY + boundingCircleRadius + extraBorder <
-            theCamera.GetViewCenter().y - theCamera.GetHeight() / 2.0 ||
-        objCenterY - boundingCircleRadius - extraBorder >
-            theCamera.GetViewCenter().y + theCamera.GetHeight() / 2.0) {
-      // Ok we are outside the camera area.
-    } else {
-      // The object can be viewed by the camera.
-      erase = false;
-      break;
+  typedef RuntimeBehaviorsRegistry<DestroyOutsideRuntimeBehavior> Registry;
+  scene.GetExtensionData<Registry>().AddBehavior(this);
+}
+
+namespace {
+struct CameraBounds {
+  float left;
+  float top;
+  float right;
+  float bottom;
+};
+
+struct LayerBounds {
+  InternedString layerName;
+  std::size_t firstCamera;  ///< Index of the first camera in camerasBounds.
+  std::size_t camerasCount;
+};
+}  // namespace
+
+void DestroyOutsideRuntimeBehavior::StepAllPostEvents(
+    RuntimeScene& scene,
+    const std::vector<DestroyOutsideRuntimeBehavior*>& behaviors) {
+  std::vector<LayerBounds> layersBounds;
+  std::vector<CameraBounds> camerasBounds;
+  std::vector<RuntimeObject*> objectsToDelete;
+
+  // There are only a few layers, and the objects of the same layer often
+  // follow each other.
+  auto getLayerBounds =
+      [&](const InternedString& layerName) -> const LayerBounds& {
+    for (std::size_t i = layersBounds.size(); i > 0; --i) {
+      if (layersBounds[i - 1].layerName == layerName)
+        return layersBounds[i - 1];
     }
+
+    const RuntimeLayer& layer = scene.GetRuntimeLayer(layerName);
+    layersBounds.push_back(
+        LayerBounds{layerName, camerasBounds.size(), layer.GetCameraCount()});
+    for (std::size_t i = 0; i < layer.GetCameraCount(); ++i) {
+      const RuntimeCamera& camera = layer.GetCamera(i);
+      float halfWidth = camera.GetWidth() / 2.0f;
+      float halfHeight = camera.GetHeight() / 2.0f;
+      camerasBounds.push_back(
+          CameraBounds{camera.GetViewCenter().x - halfWidth,
+                       camera.GetViewCenter().y - halfHeight,
+                       camera.GetViewCenter().x + halfWidth,
+                       camera.GetViewCenter().y + halfHeight});
+    }
+
+    return layersBounds.back();
+  };
+
+  for (DestroyOutsideRuntimeBehavior* behavior : behaviors) {
+    RuntimeObject* object = behavior->object;
+    const LayerBounds& layerBounds = getLayerBounds(object->GetInternedLayer());
+
+    float objCenterX = object->GetDrawableX() + object->GetCenterX();
+    float objCenterY = object->GetDrawableY() + object->GetCenterY();
+    float margin = std::sqrt(object->GetWidth() * object->GetWidth() +
+                             object->GetHeight() * object->GetHeight()) /
+                       2.0f +
+                   behavior->extraBorder;
+
+    bool erase = true;
+    for (std::size_t i = layerBounds.firstCamera;
+         i < layerBounds.firstCamera + layerBounds.camerasCount;
+         ++i) {
+      const CameraBounds& camera = camerasBounds[i];
+      if (objCenterX + margin >= camera.left &&
+          objCenterX - margin <= camera.right &&
+          objCenterY + margin >= camera.top &&
+          objCenterY - margin <= camera.bottom) {
+        // The object can be viewed by the camera.
+        erase = false;
+        break;
+      }
+    }
+
+    if (erase) objectsToDelete.push_back(object);
   }
 
-  if (erase) object->DeleteFromScene(scene);
+  // Deleting an object can unregister its behaviors: the objects are deleted
+  // after checking all the behaviors.
+  for (RuntimeObject* object : objectsToDelete) {
+    // An object with more than one behavior is only deleted once.
+    if (!object->GetName().empty()) object->DeleteFromScene(scene);
+  }
 }
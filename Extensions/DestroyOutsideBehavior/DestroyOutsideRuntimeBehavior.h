@@ -8,6 +8,7 @@ This project is released under the MIT License.
 #ifndef DESTROYOUTSIDERUNTIMEBEHAVIOR_H
 #define DESTROYOUTSIDERUNTIMEBEHAVIOR_H
 #include <map>
+#include <vector>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 class RuntimeScene;
@@ -25,6 +26,24 @@ class GD_EXTENSION_API DestroyOutsideRuntimeBehavior : public RuntimeBehavior {
   virtual DestroyOutsideRuntimeBehavior* Clone() const {
     return new DestroyOutsideRuntimeBehavior(*this);
   }
+  virtual bool Reset(const gd::SerializerElement& behaviorContent);
+
+  /**
+   * \brief The behavior does nothing before events (objects are deleted after
+   * events).
+   */
+  virtual bool IsPreEventsStepParallelSafe() const { return true; }
+
+  /**
+   * \brief Delete the objects of the behaviors that are outside of all the
+   * cameras of their layer.
+   *
+   * The bounds of the cameras are computed once per layer, and the objects
+   * are deleted once all the behaviors are checked.
+   */
+  static void StepAllPostEvents(
+      RuntimeScene& scene,
+      const std::vector<DestroyOutsideRuntimeBehavior*>& behaviors);
 
   /**
    * \brief Return the value of the extra border.
@@ -38,6 +57,10 @@ class GD_EXTENSION_API DestroyOutsideRuntimeBehavior : public RuntimeBehavior {
   void SetExtraBorder(float extraBorder_) { extraBorder = extraBorder_; };
 
  private:
+  /**
+   * \brief Register the behavior in the registry of the scene, which steps
+   * all the behaviors at once (see StepAllPostEvents).
+   */
   virtual void DoStepPostEvents(RuntimeScene& scene);
 
   float extraBorder;  ///< The supplementary margin outside the screen that the
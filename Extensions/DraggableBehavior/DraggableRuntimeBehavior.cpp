@@ -11,6 +11,7 @@ This project is released under the MIT License.
 #include <memory>
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -23,50 +24,129 @@ DraggableRuntimeBehavior::DraggableRuntimeBehavior(
     const gd::SerializerElement& behaviorContent)
     : RuntimeBehavior(behaviorContent), dragged(false) {}
 
-void DraggableRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
+namespace {
+struct LayerCameras {
+  InternedString layerName;
+  std::size_t position;     ///< The position of the layer in the scene.
+  std::size_t firstCamera;  ///< Index of the first camera in mousePositions.
+  std::size_t camerasCount;
+};
+}  // namespace
+
+void DraggableRuntimeBehavior::StepAllPreEvents(
+    RuntimeScene& scene,
+    const std::vector<DraggableRuntimeBehavior*>& behaviors) {
+  // End dragging ?
+  if (!scene.GetInputManager().IsMouseButtonPressed("Left")) {
+    for (DraggableRuntimeBehavior* behavior : behaviors)
+      behavior->dragged = false;
+    somethingDragged = false;
+    return;
+  }
+
   // Begin drag ?
-  if (!dragged && scene.GetInputManager().IsMouseButtonPressed("Left") &&
-      !leftPressedLastFrame && !somethingDragged) {
-    RuntimeLayer& theLayer = scene.GetRuntimeLayer(object->GetLayer());
-    for (std::size_t cameraIndex = 0; cameraIndex < theLayer.GetCameraCount();
-         ++cameraIndex) {
-      sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
-          scene.GetInputManager().GetMousePosition(),
-          theLayer.GetCamera(cameraIndex).GetSFMLView());
-
-      if (object->GetDrawableX() <= mousePos.x &&
-          object->GetDrawableX() + object->GetWidth() >= mousePos.x &&
-          object->GetDrawableY() <= mousePos.y &&
-          object->GetDrawableY() + object->GetHeight() >= mousePos.y) {
-        dragged = true;
-        somethingDragged = true;
-        xOffset = mousePos.x - object->GetX();
-        yOffset = mousePos.y - object->GetY();
-        dragCameraIndex = cameraIndex;
-        break;
+  if (!leftPressedLastFrame && !somethingDragged) {
+    std::vector<LayerCameras> layersCameras;
+    std::vector<sf::Vector2f> mousePositions;
+
+    // There are only a few layers, and the objects of the same layer often
+    // follow each other.
+    auto getLayerCameras =
+        [&](const InternedString& layerName) -> const LayerCameras& {
+      for (std::size_t i = layersCameras.size(); i > 0; --i) {
+        if (layersCameras[i - 1].layerName == layerName)
+          return layersCameras[i - 1];
+      }
+
+      RuntimeLayer& layer = scene.GetRuntimeLayer(layerName);
+      layersCameras.push_back(
+          LayerCameras{layerName,
+                       scene.GetRuntimeLayerPosition(layerName),
+                       mousePositions.size(),
+                       layer.GetCameraCount()});
+      for (std::size_t i = 0; i < layer.GetCameraCount(); ++i) {
+        mousePositions.push_back(scene.renderWindow->mapPixelToCoords(
+            scene.GetInputManager().GetMousePosition(),
+            layer.GetCamera(i).GetSFMLView()));
+      }
+
+      return layersCameras.back();
+    };
+
+    DraggableRuntimeBehavior* pickedBehavior = nullptr;
+    std::size_t pickedLayerPosition = 0;
+    std::size_t pickedCameraIndex = 0;
+    sf::Vector2f pickedMousePos;
+    for (DraggableRuntimeBehavior* behavior : behaviors) {
+      RuntimeObject* object = behavior->object;
+      const LayerCameras& layerCameras =
+          getLayerCameras(object->GetInternedLayer());
+
+      // Only the objects above the one already picked can be picked.
+      if (pickedBehavior &&
+          (layerCameras.position < pickedLayerPosition ||
+           (layerCameras.position == pickedLayerPosition &&
+            object->GetZOrder() <= pickedBehavior->object->GetZOrder())))
+        continue;
+
+      for (std::size_t cameraIndex = 0;
+           cameraIndex < layerCameras.camerasCount;
+           ++cameraIndex) {
+        const sf::Vector2f& mousePos =
+            mousePositions[layerCameras.firstCamera + cameraIndex];
+        if (object->GetDrawableX() <= mousePos.x &&
+            object->GetDrawableX() + object->GetWidth() >= mousePos.x &&
+            object->GetDrawableY() <= mousePos.y &&
+            object->GetDrawableY() + object->GetHeight() >= mousePos.y) {
+          pickedBehavior = behavior;
+          pickedLayerPosition = layerCameras.position;
+          pickedCameraIndex = cameraIndex;
+          pickedMousePos = mousePos;
+          break;
+        }
       }
     }
-  }
-  // End dragging ?
-  else if (!scene.GetInputManager().IsMouseButtonPressed("Left")) {
-    dragged = false;
-    somethingDragged = false;
+
+    if (pickedBehavior) {
+      RuntimeObject* object = pickedBehavior->object;
+      pickedBehavior->dragged = true;
+      somethingDragged = true;
+      pickedBehavior->xOffset = pickedMousePos.x - object->GetX();
+      pickedBehavior->yOffset = pickedMousePos.y - object->GetY();
+      pickedBehavior->dragCameraIndex = pickedCameraIndex;
+    }
   }
 
   // Being dragging ?
-  if (dragged) {
-    RuntimeLayer& theLayer = scene.GetRuntimeLayer(object->GetLayer());
+  for (DraggableRuntimeBehavior* behavior : behaviors) {
+    if (!behavior->dragged) continue;
+
+    RuntimeObject* object = behavior->object;
+    RuntimeLayer& theLayer = scene.GetRuntimeLayer(object->GetInternedLayer());
     sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
         scene.GetInputManager().GetMousePosition(),
-        theLayer.GetCamera(dragCameraIndex).GetSFMLView());
+        theLayer.GetCamera(behavior->dragCameraIndex).GetSFMLView());
 
-    object->SetX(mousePos.x - xOffset);
-    object->SetY(mousePos.y - yOffset);
+    object->SetX(mousePos.x - behavior->xOffset);
+    object->SetY(mousePos.y - behavior->yOffset);
   }
 }
 
+void DraggableRuntimeBehavior::StepAllPostEvents(
+    RuntimeScene& scene,
+    const std::vector<DraggableRuntimeBehavior*>& behaviors) {
+  leftPressedLastFrame = scene.GetInputManager().IsMouseButtonPressed("Left");
+}
+
+void DraggableRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
+  StepAllPreEvents(scene, std::vector<DraggableRuntimeBehavior*>{this});
+}
+
 void DraggableRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
   leftPressedLastFrame = scene.GetInputManager().IsMouseButtonPressed("Left");
+
+  typedef RuntimeBehaviorsRegistry<DraggableRuntimeBehavior> Registry;
+  scene.GetExtensionData<Registry>().AddBehavior(this);
 }
 
 void DraggableRuntimeBehavior::OnDeActivate() {
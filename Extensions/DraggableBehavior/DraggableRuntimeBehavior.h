@@ -7,6 +7,7 @@ This project is released under the MIT License.
 
 #ifndef DRAGGABLERUNTIMEBEHAVIOR_H
 #define DRAGGABLERUNTIMEBEHAVIOR_H
+#include <vector>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 class RuntimeScene;
@@ -32,8 +33,37 @@ class GD_EXTENSION_API DraggableRuntimeBehavior : public RuntimeBehavior {
 
   virtual void OnDeActivate();
 
+  /**
+   * \brief Start dragging the topmost object under the mouse when the left
+   * button is pressed, and move the dragged objects.
+   *
+   * The mouse position is transformed once per camera of the layers, and the
+   * object picked is the one with the greatest Z order of the upper layer, so
+   * that only one of the overlapping objects is dragged.
+   */
+  static void StepAllPreEvents(
+      RuntimeScene& scene,
+      const std::vector<DraggableRuntimeBehavior*>& behaviors);
+
+  /**
+   * \brief Remember if the left button was pressed, to only start dragging
+   * when clicking.
+   */
+  static void StepAllPostEvents(
+      RuntimeScene& scene,
+      const std::vector<DraggableRuntimeBehavior*>& behaviors);
+
  private:
+  /**
+   * \brief Step the behavior alone, until it is registered in the registry
+   * of the scene (see StepAllPreEvents).
+   */
   virtual void DoStepPreEvents(RuntimeScene& scene);
+
+  /**
+   * \brief Register the behavior in the registry of the scene, which steps
+   * all the behaviors at once.
+   */
   virtual void DoStepPostEvents(RuntimeScene& scene);
 
   float xOffset;
@@ -1,21 +1,19 @@
 #include "Inventory.h"
+#include <algorithm>
 #include "GDCore/String.h"
 
 bool Inventory::Has(const gd::String& itemName) {
-  return items.find(itemName) != items.end() && items[itemName].count > 0;
+  Item* item = FindItem(itemName);
+  return item && item->count > 0;
 }
 
 size_t Inventory::Count(const gd::String& itemName) {
-  if (items.find(itemName) == items.end()) return 0;
-
-  return items[itemName].count;
+  Item* item = FindItem(itemName);
+  return item ? item->count : 0;
 }
 
 bool Inventory::Add(const gd::String& itemName) {
-  if (items.find(itemName) == items.end()) {
-    MakeItemEntry(itemName);
-  }
-
+  // The entry is created if it does not exist.
   auto& item = items[itemName];
   if (item.unlimited || item.count < item.maxCount) {
     item.count++;
@@ -27,10 +25,6 @@ bool Inventory::Add(const gd::String& itemName) {
 }
 
 bool Inventory::SetCount(const gd::String& itemName, size_t count) {
-  if (items.find(itemName) == items.end()) {
-    MakeItemEntry(itemName);
-  }
-
   auto& item = items[itemName];
   size_t newCount = item.unlimited ? count : std::min(count, item.maxCount);
   item.count = newCount;
@@ -39,21 +33,17 @@ bool Inventory::SetCount(const gd::String& itemName, size_t count) {
 }
 
 bool Inventory::IsFull(const gd::String& itemName) {
-  if (items.find(itemName) == items.end()) return false;
-
-  auto& item = items[itemName];
-  return !item.unlimited && item.count >= item.maxCount;
+  Item* item = FindItem(itemName);
+  return item && !item->unlimited && item->count >= item->maxCount;
 }
 
 bool Inventory::Remove(const gd::String& itemName) {
-  if (items.find(itemName) == items.end()) return false;
+  Item* item = FindItem(itemName);
+  if (item && item->count > 0) {
+    item->count--;
 
-  auto& item = items[itemName];
-  if (item.count > 0) {
-    item.count--;
-
-    if (item.count == 0) {
-      item.equipped = false;
+    if (item->count == 0) {
+      item->equipped = false;
     }
     return true;
   }
@@ -62,38 +52,26 @@ bool Inventory::Remove(const gd::String& itemName) {
 }
 
 void Inventory::SetMaximum(const gd::String& itemName, size_t maxCount) {
-  if (items.find(itemName) == items.end()) {
-    MakeItemEntry(itemName);
-  }
-
-  items[itemName].maxCount = maxCount;
-  items[itemName].unlimited = false;
+  auto& item = items[itemName];
+  item.maxCount = maxCount;
+  item.unlimited = false;
 }
 
 void Inventory::SetUnlimited(const gd::String& itemName, bool enable) {
-  if (items.find(itemName) == items.end()) {
-    MakeItemEntry(itemName);
-  }
-
   items[itemName].unlimited = enable;
 }
 
-void Inventory::MakeItemEntry(const gd::String& itemName) {
-  Item item;
-  items[itemName] = item;
-}
-
 bool Inventory::Equip(const gd::String& itemName, bool equip) {
-  if (items.find(itemName) == items.end()) {
+  Item* item = FindItem(itemName);
+  if (!item) {
     return false;
   }
 
-  auto& item = items[itemName];
   if (!equip) {
-    item.equipped = false;
+    item->equipped = false;
     return true;
-  } else if (item.count > 0) {
-    item.equipped = true;
+  } else if (item->count > 0) {
+    item->equipped = true;
     return true;
   }
 
@@ -101,11 +79,16 @@ bool Inventory::Equip(const gd::String& itemName, bool equip) {
 }
 
 bool Inventory::IsEquipped(const gd::String& itemName) {
-  if (items.find(itemName) == items.end()) {
-    return false;
-  }
+  Item* item = FindItem(itemName);
+  return item && item->equipped;
+}
 
-  return items[itemName].equipped;
+void Inventory::SetItem(const gd::String& itemName, const Item& item) {
+  Item& newItem = items[itemName];
+  newItem = item;
+  if (!newItem.unlimited)
+    newItem.count = std::min(newItem.count, newItem.maxCount);
+  newItem.equipped = newItem.equipped && newItem.count > 0;
 }
 
 void Inventory::Clear() { items.clear(); }
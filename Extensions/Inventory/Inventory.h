@@ -1,5 +1,5 @@
 #pragma once
-#include <map>
+#include <unordered_map>
 #include "GDCore/String.h"
 
 class GD_EXTENSION_API Inventory {
@@ -27,10 +27,22 @@ class GD_EXTENSION_API Inventory {
   bool IsEquipped(const gd::String& itemName);
   void Clear();
 
-  const std::map<gd::String, Item>& GetAllItems() { return items; };
+  /**
+   * \brief Set all the properties of an item at once, as if they were set
+   * with SetMaximum, SetUnlimited, SetCount and Equip.
+   */
+  void SetItem(const gd::String& itemName, const Item& item);
+
+  const std::unordered_map<gd::String, Item>& GetAllItems() { return items; };
 
  private:
-  void MakeItemEntry(const gd::String& itemName);
+  /**
+   * \brief Return the item, or nullptr if there is no entry for it.
+   */
+  Item* FindItem(const gd::String& itemName) {
+    auto it = items.find(itemName);
+    return it != items.end() ? &it->second : nullptr;
+  }
 
-  std::map<gd::String, Item> items;
+  std::unordered_map<gd::String, Item> items;
 };
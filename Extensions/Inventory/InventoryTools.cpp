@@ -1,4 +1,5 @@
 #include "InventoryTools.h"
 
-std::map<RuntimeGame *, std::map<gd::String, Inventory>>
+std::map<RuntimeGame *, std::unordered_map<gd::String, Inventory>>
     InventoryTools::inventories;
+std::mutex InventoryTools::inventoriesMutex;
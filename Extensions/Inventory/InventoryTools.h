@@ -1,4 +1,6 @@
 #pragma once
+#include <mutex>
+#include <unordered_map>
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "Inventory.h"
 
@@ -60,14 +62,14 @@ class GD_EXTENSION_API InventoryTools {
                                   gd::Variable &variable) {
     auto &allItems = Get(scene, inventoryName).GetAllItems();
     for (auto &it : allItems) {
-      Inventory::Item item = it.second;
+      const Inventory::Item &item = it.second;
       gd::Variable &serializedItem = variable.GetChild(it.first);
-      serializedItem.GetChild("count").SetValue(item.count);
-      serializedItem.GetChild("maxCount").SetValue(item.maxCount);
-      serializedItem.GetChild("unlimited")
-          .SetString(item.unlimited ? "true" : "false");
-      serializedItem.GetChild("equipped")
-          .SetString(item.equipped ? "true" : "false");
+      serializedItem.GetChild(CountName()).SetValue(item.count);
+      serializedItem.GetChild(MaxCountName()).SetValue(item.maxCount);
+      serializedItem.GetChild(UnlimitedName())
+          .SetString(item.unlimited ? TrueString() : FalseString());
+      serializedItem.GetChild(EquippedName())
+          .SetString(item.equipped ? TrueString() : FalseString());
     }
   }
 
@@ -77,30 +79,66 @@ class GD_EXTENSION_API InventoryTools {
     Inventory &inventory = Get(scene, inventoryName);
     inventory.Clear();
 
+    // Each item is set in a single lookup.
     for (auto &child : variable.GetAllChildren()) {
-      const gd::String &name = child.first;
-      const auto &serializedItem = child.second;
-      inventory.SetMaximum(name,
-                           serializedItem->GetChild("maxCount").GetValue());
-      inventory.SetUnlimited(
-          name, serializedItem->GetChild("unlimited").GetString() == "true");
-      inventory.SetCount(name, serializedItem->GetChild("count").GetValue());
-      inventory.Equip(
-          name, serializedItem->GetChild("equipped").GetString() == "true");
+      const gd::Variable &serializedItem = *child.second;
+      Inventory::Item item;
+      item.maxCount = serializedItem.GetChild(MaxCountName()).GetValue();
+      item.unlimited =
+          serializedItem.GetChild(UnlimitedName()).GetString() == TrueString();
+      item.count = serializedItem.GetChild(CountName()).GetValue();
+      item.equipped =
+          serializedItem.GetChild(EquippedName()).GetString() == TrueString();
+      inventory.SetItem(child.first, item);
     }
   }
 
   static void ClearAll(RuntimeScene &scene) {
-    std::map<gd::String, Inventory> clearedInventories;
-    inventories[scene.game] = clearedInventories;
+    std::lock_guard<std::mutex> lock(inventoriesMutex);
+    inventories[scene.game].clear();
   }
 
  private:
+  /**
+   * \brief Return the inventory, created if needed.
+   *
+   * The lookup is locked, as scenes of a game can be stepped in parallel (see
+   * SceneStack::StepAllWithoutRender). The inventory itself is not locked.
+   */
   static Inventory &Get(RuntimeScene &scene, const gd::String &name) {
+    std::lock_guard<std::mutex> lock(inventoriesMutex);
     return inventories[scene.game][name];
   }
 
-  static std::map<RuntimeGame *, std::map<gd::String, Inventory>> inventories;
+  // The names used for serialization, constructed only once.
+  static const gd::String &CountName() {
+    static const gd::String name = "count";
+    return name;
+  }
+  static const gd::String &MaxCountName() {
+    static const gd::String name = "maxCount";
+    return name;
+  }
+  static const gd::String &UnlimitedName() {
+    static const gd::String name = "unlimited";
+    return name;
+  }
+  static const gd::String &EquippedName() {
+    static const gd::String name = "equipped";
+    return name;
+  }
+  static const gd::String &TrueString() {
+    static const gd::String string = "true";
+    return string;
+  }
+  static const gd::String &FalseString() {
+    static const gd::String string = "false";
+    return string;
+  }
+
+  static std::map<RuntimeGame *, std::unordered_map<gd::String, Inventory>>
+      inventories;
+  static std::mutex inventoriesMutex;
 
   InventoryTools(){};
 };
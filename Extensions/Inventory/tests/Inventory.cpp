@@ -83,4 +83,21 @@ TEST_CASE( "Inventory", "[game-engine][inventory]" ) {
 		REQUIRE(inventory.Has("never sword") == false);
 		REQUIRE(inventory.Count("never sword") == 0);
 	}
+	SECTION("Setting all the properties of an item") {
+		Inventory inventory;
+		Inventory::Item item;
+		item.unlimited = false;
+		item.maxCount = 2;
+		item.count = 3;
+		item.equipped = true;
+		inventory.SetItem("shield", item);
+		REQUIRE(inventory.Count("shield") == 2);
+		REQUIRE(inventory.IsEquipped("shield") == true);
+		REQUIRE(inventory.IsFull("shield") == true);
+
+		item.count = 0;
+		inventory.SetItem("shield", item);
+		REQUIRE(inventory.Has("shield") == false);
+		REQUIRE(inventory.IsEquipped("shield") == false);
+	}
 }
@@ -6,6 +6,7 @@ This project is released under the MIT License.
 */
 
 #include "GDCpp/Extensions/ExtensionBase.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
 #include "ObjectsLinksManager.h"
 
 #include <iostream>
@@ -132,7 +133,7 @@ class LinkedObjectsCppExtension : public ExtensionBase {
    */
   virtual void ObjectDeletedFromScene(RuntimeScene& scene,
                                       RuntimeObject* object) {
-    GDpriv::LinkedObjects::ObjectsLinksManager::managers[&scene]
+    scene.GetExtensionData<GDpriv::LinkedObjects::ObjectsLinksManager>()
         .RemoveAllLinksOf(object);
   }
 
@@ -140,14 +141,8 @@ class LinkedObjectsCppExtension : public ExtensionBase {
    * Initialize manager of linked objects of scene
    */
   virtual void SceneLoaded(RuntimeScene& scene) {
-    GDpriv::LinkedObjects::ObjectsLinksManager::managers[&scene].ClearAll();
-  }
-
-  /**
-   * Destroy manager of linked objects of scene
-   */
-  virtual void SceneUnloaded(RuntimeScene& scene) {
-    GDpriv::LinkedObjects::ObjectsLinksManager::managers.erase(&scene);
+    scene.GetExtensionData<GDpriv::LinkedObjects::ObjectsLinksManager>()
+        .ClearAll();
   }
 };
 
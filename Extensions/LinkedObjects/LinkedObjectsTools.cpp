@@ -6,6 +6,7 @@ This project is released under the MIT License.
 */
 
 #include "LinkedObjectsTools.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -20,7 +21,8 @@ using namespace std;
 namespace GDpriv {
 namespace LinkedObjects {
 
-std::map<RuntimeScene*, ObjectsLinksManager> ObjectsLinksManager::managers;
+const std::size_t ObjectsLinksManager::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
 
 bool GD_EXTENSION_API PickObjectsLinkedTo(
     RuntimeScene& scene,
@@ -28,33 +30,51 @@ bool GD_EXTENSION_API PickObjectsLinkedTo(
     RuntimeObject* object) {
   if (!object) return false;
 
-  std::vector<RuntimeObject*> linkedObjects =
-      ObjectsLinksManager::managers[&scene].GetObjectsLinkedWith(object);
-  return PickObjectsIf(
-      pickedObjectsLists, false, [&linkedObjects](RuntimeObject* obj) {
-        return std::find(linkedObjects.begin(), linkedObjects.end(), obj) !=
-               linkedObjects.end();
-      });
+  const ObjectsLinksManager& manager = scene.GetExtensionData<ObjectsLinksManager>();
+  bool isTrue = false;
+  std::vector<RuntimeObject*> linkedObjects;
+  for (auto& it : pickedObjectsLists) {
+    if (!it.second) continue;
+    std::vector<RuntimeObject*>& arr = *it.second;
+
+    // Only the linked objects having the name of the list can be picked.
+    // Sort them so that each picked object is found with a binary search.
+    manager.GetObjectsLinkedWith(object, it.first, linkedObjects);
+    std::sort(linkedObjects.begin(), linkedObjects.end());
+
+    std::size_t finalSize = 0;
+    for (std::size_t k = 0; k < arr.size(); ++k) {
+      RuntimeObject* obj = arr[k];
+      if (std::binary_search(linkedObjects.begin(), linkedObjects.end(), obj)) {
+        arr[finalSize] = obj;
+        finalSize++;
+        isTrue = true;
+      }
+    }
+    arr.resize(finalSize);
+  }
+
+  return isTrue;
 }
 
 void GD_EXTENSION_API LinkObjects(RuntimeScene& scene,
                                   RuntimeObject* a,
                                   RuntimeObject* b) {
   if (!a || !b) return;
-  ObjectsLinksManager::managers[&scene].LinkObjects(a, b);
+  scene.GetExtensionData<ObjectsLinksManager>().LinkObjects(a, b);
 }
 
 void GD_EXTENSION_API RemoveLinkBetween(RuntimeScene& scene,
                                         RuntimeObject* a,
                                         RuntimeObject* b) {
   if (!a || !b) return;
-  ObjectsLinksManager::managers[&scene].RemoveLinkBetween(a, b);
+  scene.GetExtensionData<ObjectsLinksManager>().RemoveLinkBetween(a, b);
 }
 
 void GD_EXTENSION_API RemoveAllLinksOf(RuntimeScene& scene,
                                        RuntimeObject* object) {
   if (!object) return;
-  ObjectsLinksManager::managers[&scene].RemoveAllLinksOf(object);
+  scene.GetExtensionData<ObjectsLinksManager>().RemoveAllLinksOf(object);
 }
 
 }  // namespace LinkedObjects
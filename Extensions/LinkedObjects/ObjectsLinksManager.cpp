@@ -7,6 +7,7 @@ This project is released under the MIT License.
 
 #include "ObjectsLinksManager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include "LinkedObjectsTools.h"
@@ -21,55 +22,86 @@ namespace GDpriv {
 namespace LinkedObjects {
 
 void ObjectsLinksManager::LinkObjects(RuntimeObject* a, RuntimeObject* b) {
-  {
-    std::set<RuntimeObject*>& objectLinks = links[a];
-    objectLinks.insert(b);
-  }
-  {
-    std::set<RuntimeObject*>& objectLinks = links[b];
-    objectLinks.insert(a);
-  }
+  if (AreLinked(a, b)) return;
+
+  links[a].push_back(b);
+  if (a != b) links[b].push_back(a);
 }
 
 void ObjectsLinksManager::RemoveLinkBetween(RuntimeObject* a,
                                             RuntimeObject* b) {
-  {
-    std::set<RuntimeObject*>& objectLinks = links[a];
-    objectLinks.erase(b);
-  }
-  {
-    std::set<RuntimeObject*>& objectLinks = links[b];
-    objectLinks.erase(a);
-  }
+  RemoveLinkFrom(a, b);
+  RemoveLinkFrom(b, a);
 }
 
 void ObjectsLinksManager::RemoveAllLinksOf(RuntimeObject* object) {
-  std::set<RuntimeObject*>& objectLinks = links[object];
-  for (std::set<RuntimeObject*>::iterator linkedObj = objectLinks.begin();
-       linkedObj != objectLinks.end();
-       ++linkedObj) {
-    std::set<RuntimeObject*>& linkedObjectLinks = links[*linkedObj];
-    linkedObjectLinks.erase(object);
+  auto it = links.find(object);
+  if (it == links.end()) return;
+
+  for (RuntimeObject* linkedObj : it->second) {
+    if (linkedObj != object) RemoveLinkFrom(linkedObj, object);
   }
 
   links.erase(object);  // Remove all links of object
 }
 
+void ObjectsLinksManager::RemoveLinkFrom(RuntimeObject* object,
+                                         RuntimeObject* linkedObject) {
+  auto it = links.find(object);
+  if (it == links.end()) return;
+
+  std::vector<RuntimeObject*>& objectLinks = it->second;
+  auto linkIt =
+      std::find(objectLinks.begin(), objectLinks.end(), linkedObject);
+  if (linkIt == objectLinks.end()) return;
+
+  // The order of the links does not matter.
+  *linkIt = objectLinks.back();
+  objectLinks.pop_back();
+  if (objectLinks.empty()) links.erase(it);
+}
+
+bool ObjectsLinksManager::AreLinked(RuntimeObject* a, RuntimeObject* b) const {
+  auto it = links.find(a);
+  if (it == links.end()) return false;
+
+  const std::vector<RuntimeObject*>& objectLinks = it->second;
+  return std::find(objectLinks.begin(), objectLinks.end(), b) !=
+         objectLinks.end();
+}
+
 std::vector<RuntimeObject*> ObjectsLinksManager::GetObjectsLinkedWith(
     RuntimeObject* object) {
-  // Get links of object
-  const std::set<RuntimeObject*>& objectLinks = links[object];
   std::vector<RuntimeObject*> list;
-  list.reserve(objectLinks.size());
+  GetObjectsLinkedWith(object, list);
+  return list;
+}
+
+void ObjectsLinksManager::GetObjectsLinkedWith(
+    RuntimeObject* object, std::vector<RuntimeObject*>& result) const {
+  result.clear();
+  auto it = links.find(object);
+  if (it == links.end()) return;
 
   // Create the list, avoiding dead links or links to just deleted objects
-  for (std::set<RuntimeObject*>::iterator linkedObj = objectLinks.begin();
-       linkedObj != objectLinks.end();
-       ++linkedObj) {
-    if (!(*linkedObj)->GetName().empty()) list.push_back((*linkedObj));
+  for (RuntimeObject* linkedObj : it->second) {
+    if (!linkedObj->GetName().empty()) result.push_back(linkedObj);
   }
+}
 
-  return list;
+void ObjectsLinksManager::GetObjectsLinkedWith(
+    RuntimeObject* object,
+    const gd::String& objectName,
+    std::vector<RuntimeObject*>& result) const {
+  result.clear();
+  if (objectName.empty()) return;  // Dead links have no name.
+
+  auto it = links.find(object);
+  if (it == links.end()) return;
+
+  for (RuntimeObject* linkedObj : it->second) {
+    if (linkedObj->GetName() == objectName) result.push_back(linkedObj);
+  }
 }
 
 void ObjectsLinksManager::ClearAll() { links.clear(); }
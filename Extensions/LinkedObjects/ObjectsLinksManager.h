@@ -7,10 +7,11 @@ This project is released under the MIT License.
 
 #ifndef OBJECTSLINKSMANAGER_H
 #define OBJECTSLINKSMANAGER_H
-#include <map>
-#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+#include "GDCpp/Runtime/String.h"
 
 class RuntimeObject;
 class RuntimeScene;
@@ -21,9 +22,19 @@ namespace LinkedObjects {
 
 /**
  * \brief Manage links between objects of a scene
+ *
+ * The objects linked with each object are stored in a vector, found with a
+ * hash table: as objects usually have a few links, finding or removing a link
+ * is a short linear search, and the queries only copy the vector.
+ *
+ * The manager of a scene is stored in the scene (see
+ * RuntimeScene::GetExtensionData).
  */
-class GD_EXTENSION_API ObjectsLinksManager {
+class GD_EXTENSION_API ObjectsLinksManager : public RuntimeSceneExtensionData {
  public:
+  static const std::size_t sceneDataIndex;  ///< The slot of the managers in
+                                            ///< the scenes.
+
   /**
    * \brief Link two object
    */
@@ -39,22 +50,50 @@ class GD_EXTENSION_API ObjectsLinksManager {
    */
   void RemoveAllLinksOf(RuntimeObject* object);
 
+  /**
+   * \brief Return true if the two objects are linked.
+   */
+  bool AreLinked(RuntimeObject* a, RuntimeObject* b) const;
+
   /**
    * \brief Get a list of (raw pointers to) all objects linked with the
    * specified object
+   * \see GetObjectsLinkedWith(RuntimeObject*, std::vector<RuntimeObject*>&)
    */
   std::vector<RuntimeObject*> GetObjectsLinkedWith(RuntimeObject* object);
 
+  /**
+   * \brief Fill the list with (raw pointers to) all objects linked with the
+   * specified object.
+   * \param result The list of objects. It is cleared before adding the
+   * objects, so that its memory can be reused.
+   */
+  void GetObjectsLinkedWith(RuntimeObject* object,
+                            std::vector<RuntimeObject*>& result) const;
+
+  /**
+   * \brief Fill the list with (raw pointers to) the objects having the
+   * specified name that are linked with the specified object.
+   * \param result The list of objects. It is cleared before adding the
+   * objects, so that its memory can be reused.
+   */
+  void GetObjectsLinkedWith(RuntimeObject* object,
+                            const gd::String& objectName,
+                            std::vector<RuntimeObject*>& result) const;
+
   /**
    * \brief Delete all links
    */
   void ClearAll();
 
-  static std::map<RuntimeScene*, ObjectsLinksManager>
-      managers;  // List of managers associated with scenes.
-
  private:
-  std::map<RuntimeObject*, std::set<RuntimeObject*> > links;
+  /**
+   * \brief Remove \a linkedObject from the links of \a object.
+   */
+  void RemoveLinkFrom(RuntimeObject* object, RuntimeObject* linkedObject);
+
+  std::unordered_map<RuntimeObject*, std::vector<RuntimeObject*> >
+      links;  ///< The objects linked with each object (without duplicates).
 };
 
 }  // namespace LinkedObjects
@@ -8,6 +8,7 @@ This project is released under the MIT License.
  * @file Tests for the Linked Objects extension.
  */
 #define CATCH_CONFIG_MAIN
+#include <algorithm>
 #include "catch.hpp"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
@@ -39,7 +40,7 @@ TEST_CASE( "LinkedObjects", "[game-engine][linked-objects]" ) {
 		RuntimeObject obj2C(scene, obj2);
 
 		//Link two objects
-		GDpriv::LinkedObjects::ObjectsLinksManager & manager = GDpriv::LinkedObjects::ObjectsLinksManager::managers[&scene];
+		GDpriv::LinkedObjects::ObjectsLinksManager & manager = scene.GetExtensionData<GDpriv::LinkedObjects::ObjectsLinksManager>();
 		manager.LinkObjects(&obj1A, &obj2A);
 		{
 			std::vector<RuntimeObject*> linkedObjects = manager.GetObjectsLinkedWith(&obj1A);
@@ -85,4 +86,56 @@ TEST_CASE( "LinkedObjects", "[game-engine][linked-objects]" ) {
 		}
 
 	}
+	SECTION("Queries filling a list") {
+		gd::Object obj1("1");
+		gd::Object obj2("2");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		RuntimeObject obj1A(scene, obj1);
+		RuntimeObject obj1B(scene, obj1);
+		RuntimeObject obj2A(scene, obj2);
+		RuntimeObject obj2B(scene, obj2);
+
+		GDpriv::LinkedObjects::ObjectsLinksManager & manager = scene.GetExtensionData<GDpriv::LinkedObjects::ObjectsLinksManager>();
+		manager.LinkObjects(&obj1A, &obj1B);
+		manager.LinkObjects(&obj1A, &obj2A);
+		manager.LinkObjects(&obj1A, &obj2B);
+		REQUIRE(manager.AreLinked(&obj1A, &obj2B) == true);
+		REQUIRE(manager.AreLinked(&obj2B, &obj1A) == true);
+		REQUIRE(manager.AreLinked(&obj2A, &obj2B) == false);
+
+		//The list is cleared before being filled
+		std::vector<RuntimeObject*> linkedObjects;
+		linkedObjects.push_back(&obj2A);
+		manager.GetObjectsLinkedWith(&obj1A, linkedObjects);
+		REQUIRE(linkedObjects.size() == 3);
+
+		manager.GetObjectsLinkedWith(&obj1A, "2", linkedObjects);
+		REQUIRE(linkedObjects.size() == 2);
+		REQUIRE(std::find(linkedObjects.begin(), linkedObjects.end(), &obj2A) != linkedObjects.end());
+		REQUIRE(std::find(linkedObjects.begin(), linkedObjects.end(), &obj2B) != linkedObjects.end());
+
+		manager.GetObjectsLinkedWith(&obj1A, "1", linkedObjects);
+		REQUIRE(linkedObjects.size() == 1);
+		REQUIRE(linkedObjects[0] == &obj1B);
+
+		manager.GetObjectsLinkedWith(&obj2A, "2", linkedObjects);
+		REQUIRE(linkedObjects.size() == 0);
+
+		//Pick the linked objects in the lists
+		std::vector<RuntimeObject*> objects1 = {&obj1A, &obj1B};
+		std::vector<RuntimeObject*> objects2 = {&obj2A, &obj2B};
+		std::map<gd::String, std::vector<RuntimeObject*>*> lists;
+		lists["1"] = &objects1;
+		lists["2"] = &objects2;
+
+		manager.RemoveLinkBetween(&obj2A, &obj1A);
+		REQUIRE(GDpriv::LinkedObjects::PickObjectsLinkedTo(scene, lists, &obj1A) == true);
+		REQUIRE(objects1.size() == 1);
+		REQUIRE(objects1[0] == &obj1B);
+		REQUIRE(objects2.size() == 1);
+		REQUIRE(objects2[0] == &obj2B);
+	}
 }
@@ -17,6 +17,7 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "PanelSpriteObject.h"
 
 #if defined(GD_IDE_ONLY)
@@ -64,7 +65,11 @@ void PanelSpriteObject::DoSerializeTo(gd::SerializerElement& element) const {
 
 RuntimePanelSpriteObject::RuntimePanelSpriteObject(
     RuntimeScene& scene, const PanelSpriteObject& panelSpriteObject)
-    : RuntimeObject(scene, panelSpriteObject), width(32), height(32), angle(0) {
+    : RuntimeObject(scene, panelSpriteObject),
+      width(32),
+      height(32),
+      angle(0),
+      verticesNeedUpdate(true) {
   SetRightMargin(panelSpriteObject.GetRightMargin());
   SetLeftMargin(panelSpriteObject.GetLeftMargin());
   SetBottomMargin(panelSpriteObject.GetBottomMargin());
@@ -76,6 +81,63 @@ RuntimePanelSpriteObject::RuntimePanelSpriteObject(
   ChangeAndReloadImage(textureName, scene);
 }
 
+void RuntimePanelSpriteObject::UpdateVertices() {
+  verticesNeedUpdate = false;
+  verticesTextureSize = texture->texture.getSize();
+  vertices.clear();
+
+  float imageWidth = verticesTextureSize.x;
+  float imageHeight = verticesTextureSize.y;
+
+  // The columns and rows of the nine parts, on the object and on the image.
+  const float x[] = {-width / 2,
+                     -width / 2 + leftMargin,
+                     +width / 2 - rightMargin,
+                     +width / 2};
+  const float y[] = {-height / 2,
+                     -height / 2 + topMargin,
+                     +height / 2 - bottomMargin,
+                     +height / 2};
+  const float textureX[] = {
+      0, leftMargin, imageWidth - rightMargin, imageWidth};
+  const float textureY[] = {
+      0, topMargin, imageHeight - bottomMargin, imageHeight};
+
+  // Two triangles for each part, skipping the empty ones (no margin).
+  for (std::size_t row = 0; row < 3; ++row) {
+    for (std::size_t column = 0; column < 3; ++column) {
+      if (x[column] == x[column + 1] || y[row] == y[row + 1]) continue;
+
+      sf::Vertex topLeftCorner(sf::Vector2f(x[column], y[row]),
+                               sf::Vector2f(textureX[column], textureY[row]));
+      sf::Vertex topRightCorner(
+          sf::Vector2f(x[column + 1], y[row]),
+          sf::Vector2f(textureX[column + 1], textureY[row]));
+      sf::Vertex bottomRightCorner(
+          sf::Vector2f(x[column + 1], y[row + 1]),
+          sf::Vector2f(textureX[column + 1], textureY[row + 1]));
+      sf::Vertex bottomLeftCorner(
+          sf::Vector2f(x[column], y[row + 1]),
+          sf::Vector2f(textureX[column], textureY[row + 1]));
+
+      vertices.push_back(topLeftCorner);
+      vertices.push_back(topRightCorner);
+      vertices.push_back(bottomRightCorner);
+      vertices.push_back(topLeftCorner);
+      vertices.push_back(bottomRightCorner);
+      vertices.push_back(bottomLeftCorner);
+    }
+  }
+}
+
+sf::Transform RuntimePanelSpriteObject::GetTransform() const {
+  sf::Transform matrix;
+  matrix.translate(GetX() + GetCenterX(), GetY() + GetCenterY());
+  matrix.rotate(angle);
+
+  return matrix;
+}
+
 /**
  * Render object at runtime
  */
@@ -84,111 +146,34 @@ bool RuntimePanelSpriteObject::Draw(sf::RenderTarget& window) {
   if (hidden) return true;
   if (!texture) return true;
 
-  sf::Vector2f centerPosition =
-      sf::Vector2f(GetX() + GetCenterX(), GetY() + GetCenterY());
-
-  float imageWidth = texture->texture.getSize().x;
-  float imageHeight = texture->texture.getSize().y;
-
-  sf::Vertex centerVertices[] = {
-      sf::Vertex(sf::Vector2f(-width / 2 + leftMargin, -height / 2 + topMargin),
-                 sf::Vector2f(leftMargin, topMargin)),
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, -height / 2 + topMargin),
-          sf::Vector2f(imageWidth - rightMargin, topMargin)),
-      sf::Vertex(
-          sf::Vector2f(-width / 2 + leftMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(leftMargin, imageHeight - bottomMargin)),
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(imageWidth - rightMargin, imageHeight - bottomMargin)),
-  };
-
-  sf::Vertex topVertices[] = {
-      // Top-left
-      sf::Vertex(sf::Vector2f(-width / 2, -height / 2), sf::Vector2f(0, 0)),
-      sf::Vertex(sf::Vector2f(-width / 2, -height / 2 + topMargin),
-                 sf::Vector2f(0, topMargin)),
-      sf::Vertex(sf::Vector2f(-width / 2 + leftMargin, -height / 2),
-                 sf::Vector2f(leftMargin, 0)),
-      sf::Vertex(sf::Vector2f(-width / 2 + leftMargin, -height / 2 + topMargin),
-                 sf::Vector2f(leftMargin, topMargin)),
-
-      // Top
-      sf::Vertex(sf::Vector2f(+width / 2 - rightMargin, -height / 2),
-                 sf::Vector2f(imageWidth - rightMargin, 0)),
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, -height / 2 + topMargin),
-          sf::Vector2f(imageWidth - rightMargin, topMargin)),
-
-      // Top-right
-      sf::Vertex(sf::Vector2f(+width / 2, -height / 2),
-                 sf::Vector2f(imageWidth, 0)),
-      sf::Vertex(sf::Vector2f(+width / 2, -height / 2 + topMargin),
-                 sf::Vector2f(imageWidth, topMargin)),
-  };
-
-  sf::Vertex rightVertices[] = {
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, -height / 2 + topMargin),
-          sf::Vector2f(imageWidth - rightMargin, topMargin)),
-      sf::Vertex(sf::Vector2f(+width / 2, -height / 2 + topMargin),
-                 sf::Vector2f(imageWidth, topMargin)),
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(imageWidth - rightMargin, imageHeight - bottomMargin)),
-      sf::Vertex(sf::Vector2f(+width / 2, +height / 2 - bottomMargin),
-                 sf::Vector2f(imageWidth, imageHeight - bottomMargin))};
-
-  sf::Vertex bottomVertices[] = {
-      // Bottom-left
-      sf::Vertex(sf::Vector2f(-width / 2, +height / 2 - bottomMargin),
-                 sf::Vector2f(0, imageHeight - bottomMargin)),
-      sf::Vertex(sf::Vector2f(-width / 2, +height / 2),
-                 sf::Vector2f(0, imageHeight)),
-      sf::Vertex(
-          sf::Vector2f(-width / 2 + leftMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(leftMargin, imageHeight - bottomMargin)),
-      sf::Vertex(sf::Vector2f(-width / 2 + leftMargin, +height / 2),
-                 sf::Vector2f(leftMargin, imageHeight)),
-
-      // Bottom
-      sf::Vertex(
-          sf::Vector2f(+width / 2 - rightMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(imageWidth - rightMargin, imageHeight - bottomMargin)),
-      sf::Vertex(sf::Vector2f(+width / 2 - rightMargin, +height / 2),
-                 sf::Vector2f(imageWidth - rightMargin, imageHeight)),
-
-      // Bottom-right
-      sf::Vertex(sf::Vector2f(+width / 2, +height / 2 - bottomMargin),
-                 sf::Vector2f(imageWidth, imageHeight - bottomMargin)),
-      sf::Vertex(sf::Vector2f(+width / 2, +height / 2),
-                 sf::Vector2f(imageWidth, imageHeight))};
-
-  sf::Vertex leftVertices[] = {
-      sf::Vertex(sf::Vector2f(-width / 2, -height / 2 + topMargin),
-                 sf::Vector2f(0, topMargin)),
-      sf::Vertex(sf::Vector2f(-width / 2 + leftMargin, -height / 2 + topMargin),
-                 sf::Vector2f(leftMargin, topMargin)),
-      sf::Vertex(sf::Vector2f(-width / 2, +height / 2 - bottomMargin),
-                 sf::Vector2f(0, imageHeight - bottomMargin)),
-      sf::Vertex(
-          sf::Vector2f(-width / 2 + leftMargin, +height / 2 - bottomMargin),
-          sf::Vector2f(leftMargin, imageHeight - bottomMargin))};
-
-  sf::Transform matrix;
-  matrix.translate(centerPosition);
-  matrix.rotate(angle);
+  if (verticesNeedUpdate || texture->texture.getSize() != verticesTextureSize)
+    UpdateVertices();
 
+  // Moving or rotating the object only changes the transform.
   sf::RenderStates states;
-  states.transform = matrix;
+  states.transform = GetTransform();
   states.texture = &texture->texture;
 
-  window.draw(centerVertices, 4, sf::TrianglesStrip, states);
-  window.draw(leftVertices, 4, sf::TrianglesStrip, states);
-  window.draw(rightVertices, 4, sf::TrianglesStrip, states);
-  window.draw(topVertices, 8, sf::TrianglesStrip, states);
-  window.draw(bottomVertices, 8, sf::TrianglesStrip, states);
+  window.draw(vertices.data(), vertices.size(), sf::Triangles, states);
+
+  return true;
+}
+
+bool RuntimePanelSpriteObject::DrawBatched(sf::RenderTarget& window,
+                                           SpriteBatch& batch) {
+  if (hidden) return true;
+  if (!texture) return true;
+
+  if (verticesNeedUpdate || texture->texture.getSize() != verticesTextureSize)
+    UpdateVertices();
+
+  // Panels using the same image are drawn at once.
+  batch.Add(window,
+            texture->texture,
+            vertices,
+            GetTransform(),
+            sf::Color::White,
+            sf::BlendAlpha);
 
   return true;
 }
@@ -237,6 +222,7 @@ bool RuntimePanelSpriteObject::ChangeProperty(std::size_t propertyNb,
   } else if (propertyNb == 5) {
     bottomMargin = newValue.To<float>();
   }
+  verticesNeedUpdate = true;
 
   return true;
 }
@@ -250,4 +236,5 @@ void RuntimePanelSpriteObject::ChangeAndReloadImage(const gd::String& txtName,
                                                     const RuntimeScene& scene) {
   textureName = txtName;
   texture = scene.GetImageManager()->GetSFMLTexture(textureName);
+  verticesNeedUpdate = true;
 }
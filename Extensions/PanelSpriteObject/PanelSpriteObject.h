@@ -7,7 +7,10 @@ This project is released under the MIT License.
 
 #ifndef PANELSPRITEOBJECT_H
 #define PANELSPRITEOBJECT_H
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <memory>
+#include <vector>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 class SFMLTextureWrapper;
@@ -97,7 +100,10 @@ class GD_EXTENSION_API RuntimePanelSpriteObject : public RuntimeObject {
     return gd::make_unique<RuntimePanelSpriteObject>(*this);
   }
 
+  virtual bool CanBeRecycled() const { return false; };
+
   virtual bool Draw(sf::RenderTarget &renderTarget);
+  virtual bool DrawBatched(sf::RenderTarget &renderTarget, SpriteBatch &batch);
 
   virtual float GetWidth() const { return width; };
   virtual float GetHeight() const { return height; };
@@ -105,11 +111,13 @@ class GD_EXTENSION_API RuntimePanelSpriteObject : public RuntimeObject {
   virtual inline void SetWidth(float newWidth) {
     width = newWidth >= (leftMargin + rightMargin) ? newWidth
                                                    : (leftMargin + rightMargin);
+    verticesNeedUpdate = true;
   };
   virtual inline void SetHeight(float newHeight) {
     height = newHeight >= (topMargin + bottomMargin)
                  ? newHeight
                  : (topMargin + bottomMargin);
+    verticesNeedUpdate = true;
   };
 
   virtual bool SetAngle(float newAngle) {
@@ -119,16 +127,28 @@ class GD_EXTENSION_API RuntimePanelSpriteObject : public RuntimeObject {
   virtual float GetAngle() const { return angle; };
 
   float GetLeftMargin() const { return leftMargin; };
-  void SetLeftMargin(float newMargin) { leftMargin = newMargin; };
+  void SetLeftMargin(float newMargin) {
+    leftMargin = newMargin;
+    verticesNeedUpdate = true;
+  };
 
   float GetTopMargin() const { return topMargin; };
-  void SetTopMargin(float newMargin) { topMargin = newMargin; };
+  void SetTopMargin(float newMargin) {
+    topMargin = newMargin;
+    verticesNeedUpdate = true;
+  };
 
   float GetRightMargin() const { return rightMargin; };
-  void SetRightMargin(float newMargin) { rightMargin = newMargin; };
+  void SetRightMargin(float newMargin) {
+    rightMargin = newMargin;
+    verticesNeedUpdate = true;
+  };
 
   float GetBottomMargin() const { return bottomMargin; };
-  void SetBottomMargin(float newMargin) { bottomMargin = newMargin; };
+  void SetBottomMargin(float newMargin) {
+    bottomMargin = newMargin;
+    verticesNeedUpdate = true;
+  };
 
   void ChangeAndReloadImage(const gd::String &texture,
                             const RuntimeScene &scene);
@@ -155,6 +175,23 @@ class GD_EXTENSION_API RuntimePanelSpriteObject : public RuntimeObject {
   float angle;
 
   std::shared_ptr<SFMLTextureWrapper> texture;
+
+  /**
+   * \brief Compute the triangles of the nine parts of the panel, relative to
+   * its center and without rotation: they are only computed again when the
+   * size, the margins or the texture of the object is changed.
+   */
+  void UpdateVertices();
+
+  /**
+   * \brief Return the transformation used to draw the vertices.
+   */
+  sf::Transform GetTransform() const;
+
+  std::vector<sf::Vertex> vertices;  ///< The vertices drawn, see UpdateVertices
+  sf::Vector2u verticesTextureSize;  ///< The size of the texture when the
+                                     ///< vertices were computed.
+  bool verticesNeedUpdate;
 };
 
 #endif  // PANELSPRITEOBJECT_H
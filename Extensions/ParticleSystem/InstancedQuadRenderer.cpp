@@ -0,0 +1,431 @@
+/**
+
+GDevelop - Particle System Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "InstancedQuadRenderer.h"
+#include <cmath>
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_VERTEX_PROGRAM_POINT_SIZE
+#define GL_VERTEX_PROGRAM_POINT_SIZE 0x8642
+#endif
+#ifndef GL_POINT_SPRITE
+#define GL_POINT_SPRITE 0x8861
+#endif
+
+namespace {
+typedef GLuint(APIENTRY* CreateShaderProc)(GLenum);
+typedef void(APIENTRY* ShaderSourceProc)(GLuint,
+                                         GLsizei,
+                                         const char**,
+                                         const GLint*);
+typedef void(APIENTRY* CompileShaderProc)(GLuint);
+typedef void(APIENTRY* GetShaderivProc)(GLuint, GLenum, GLint*);
+typedef void(APIENTRY* DeleteShaderProc)(GLuint);
+typedef GLuint(APIENTRY* CreateProgramProc)();
+typedef void(APIENTRY* AttachShaderProc)(GLuint, GLuint);
+typedef void(APIENTRY* BindAttribLocationProc)(GLuint, GLuint, const char*);
+typedef void(APIENTRY* LinkProgramProc)(GLuint);
+typedef void(APIENTRY* GetProgramivProc)(GLuint, GLenum, GLint*);
+typedef void(APIENTRY* DeleteProgramProc)(GLuint);
+typedef void(APIENTRY* UseProgramProc)(GLuint);
+typedef GLint(APIENTRY* GetUniformLocationProc)(GLuint, const char*);
+typedef void(APIENTRY* Uniform1iProc)(GLint, GLint);
+typedef void(APIENTRY* Uniform1fProc)(GLint, GLfloat);
+typedef void(APIENTRY* Uniform2fProc)(GLint, GLfloat, GLfloat);
+typedef void(APIENTRY* GenBuffersProc)(GLsizei, GLuint*);
+typedef void(APIENTRY* BindBufferProc)(GLenum, GLuint);
+typedef void(APIENTRY* BufferDataProc)(GLenum,
+                                       std::ptrdiff_t,
+                                       const void*,
+                                       GLenum);
+typedef void(APIENTRY* VertexAttribPointerProc)(
+    GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+typedef void(APIENTRY* EnableVertexAttribArrayProc)(GLuint);
+typedef void(APIENTRY* DisableVertexAttribArrayProc)(GLuint);
+typedef void(APIENTRY* VertexAttribDivisorProc)(GLuint, GLuint);
+typedef void(APIENTRY* DrawArraysInstancedProc)(GLenum,
+                                                GLint,
+                                                GLsizei,
+                                                GLsizei);
+
+CreateShaderProc CreateShader = NULL;
+ShaderSourceProc ShaderSource = NULL;
+CompileShaderProc CompileShader = NULL;
+GetShaderivProc GetShaderiv = NULL;
+DeleteShaderProc DeleteShader = NULL;
+CreateProgramProc CreateProgram = NULL;
+AttachShaderProc AttachShader = NULL;
+BindAttribLocationProc BindAttribLocation = NULL;
+LinkProgramProc LinkProgram = NULL;
+GetProgramivProc GetProgramiv = NULL;
+DeleteProgramProc DeleteProgram = NULL;
+UseProgramProc UseProgram = NULL;
+GetUniformLocationProc GetUniformLocation = NULL;
+Uniform1iProc Uniform1i = NULL;
+Uniform1fProc Uniform1f = NULL;
+Uniform2fProc Uniform2f = NULL;
+GenBuffersProc GenBuffers = NULL;
+BindBufferProc BindBuffer = NULL;
+BufferDataProc BufferData = NULL;
+VertexAttribPointerProc VertexAttribPointer = NULL;
+EnableVertexAttribArrayProc EnableVertexAttribArray = NULL;
+DisableVertexAttribArrayProc DisableVertexAttribArray = NULL;
+VertexAttribDivisorProc VertexAttribDivisor = NULL;
+DrawArraysInstancedProc DrawArraysInstanced = NULL;
+
+// The locations of the attributes, bound before linking the programs.
+const GLuint cornerAttribute = 0;
+const GLuint positionAttribute = 1;
+const GLuint sizeAngleAttribute = 2;
+const GLuint colorAttribute = 3;
+
+// The quads are built in eye space, facing the camera like the quads of
+// GLQuadRenderer with the default orientation. The texture coordinates of the
+// corners are the ones used by GLQuadRenderer.
+const char* instancingVertexShader =
+    "#version 120\n"
+    "attribute vec2 corner;\n"
+    "attribute vec3 position;\n"
+    "attribute vec2 sizeAngle;\n"
+    "attribute vec4 color;\n"
+    "uniform vec2 scale;\n"
+    "varying vec4 particleColor;\n"
+    "varying vec2 textureCoord;\n"
+    "void main() {\n"
+    "  float c = cos(sizeAngle.y);\n"
+    "  float s = sin(sizeAngle.y);\n"
+    "  vec2 offset = corner * scale * sizeAngle.x;\n"
+    "  vec4 eye = gl_ModelViewMatrix * vec4(position, 1.0);\n"
+    "  eye.xy += vec2(c * offset.x - s * offset.y, s * offset.x + c * "
+    "offset.y);\n"
+    "  gl_Position = gl_ProjectionMatrix * eye;\n"
+    "  particleColor = color;\n"
+    "  textureCoord = vec2(corner.x + 1.0, 1.0 - corner.y) * 0.5;\n"
+    "}\n";
+
+const char* instancingFragmentShader =
+    "#version 120\n"
+    "uniform sampler2D texture;\n"
+    "uniform bool textured;\n"
+    "varying vec4 particleColor;\n"
+    "varying vec2 textureCoord;\n"
+    "void main() {\n"
+    "  gl_FragColor = textured ? texture2D(texture, textureCoord) * "
+    "particleColor : particleColor;\n"
+    "}\n";
+
+// The point sprites are large enough to contain the rotated quads.
+const char* pointSpritesVertexShader =
+    "#version 120\n"
+    "attribute vec3 position;\n"
+    "attribute vec2 sizeAngle;\n"
+    "attribute vec4 color;\n"
+    "uniform vec2 scale;\n"
+    "uniform float viewportHeight;\n"
+    "varying vec4 particleColor;\n"
+    "varying vec2 cornerScale;\n"
+    "varying vec2 rotation;\n"
+    "void main() {\n"
+    "  gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 1.0);\n"
+    "  float radius = sizeAngle.x * length(scale);\n"
+    "  gl_PointSize = radius * gl_ProjectionMatrix[1][1] / gl_Position.w * "
+    "viewportHeight;\n"
+    "  particleColor = color;\n"
+    "  cornerScale = vec2(length(scale)) / scale;\n"
+    "  rotation = vec2(cos(sizeAngle.y), sin(sizeAngle.y));\n"
+    "}\n";
+
+const char* pointSpritesFragmentShader =
+    "#version 120\n"
+    "uniform sampler2D texture;\n"
+    "uniform bool textured;\n"
+    "varying vec4 particleColor;\n"
+    "varying vec2 cornerScale;\n"
+    "varying vec2 rotation;\n"
+    "void main() {\n"
+    "  vec2 p = vec2(gl_PointCoord.x * 2.0 - 1.0, 1.0 - gl_PointCoord.y * "
+    "2.0);\n"
+    "  vec2 corner = vec2(rotation.x * p.x + rotation.y * p.y,\n"
+    "                     rotation.x * p.y - rotation.y * p.x) * "
+    "cornerScale;\n"
+    "  if (abs(corner.x) > 1.0 || abs(corner.y) > 1.0) discard;\n"
+    "  vec2 textureCoord = vec2(corner.x + 1.0, 1.0 - corner.y) * 0.5;\n"
+    "  gl_FragColor = textured ? texture2D(texture, textureCoord) * "
+    "particleColor : particleColor;\n"
+    "}\n";
+}  // namespace
+
+InstancedQuadRenderer::DrawingMode InstancedQuadRenderer::drawingMode =
+    InstancedQuadRenderer::NotChecked;
+unsigned int InstancedQuadRenderer::program = 0;
+unsigned int InstancedQuadRenderer::instancesBufferObject = 0;
+unsigned int InstancedQuadRenderer::cornersBufferObject = 0;
+int InstancedQuadRenderer::scaleLocation = -1;
+int InstancedQuadRenderer::texturedLocation = -1;
+int InstancedQuadRenderer::textureLocation = -1;
+int InstancedQuadRenderer::viewportHeightLocation = -1;
+std::vector<float> InstancedQuadRenderer::instancesBuffer;
+const std::size_t InstancedQuadRenderer::floatsPerParticle = 9;
+
+InstancedQuadRenderer::InstancedQuadRenderer(float scaleX, float scaleY)
+    : SPK::GL::GLQuadRenderer(scaleX, scaleY) {}
+
+bool InstancedQuadRenderer::LoadFunctions() {
+#define GD_LOAD_GL_FUNCTION(function, type, name) \
+  function = reinterpret_cast<type>(glGetProcAddress(name))
+
+  GD_LOAD_GL_FUNCTION(CreateShader, CreateShaderProc, "glCreateShader");
+  GD_LOAD_GL_FUNCTION(ShaderSource, ShaderSourceProc, "glShaderSource");
+  GD_LOAD_GL_FUNCTION(CompileShader, CompileShaderProc, "glCompileShader");
+  GD_LOAD_GL_FUNCTION(GetShaderiv, GetShaderivProc, "glGetShaderiv");
+  GD_LOAD_GL_FUNCTION(DeleteShader, DeleteShaderProc, "glDeleteShader");
+  GD_LOAD_GL_FUNCTION(CreateProgram, CreateProgramProc, "glCreateProgram");
+  GD_LOAD_GL_FUNCTION(AttachShader, AttachShaderProc, "glAttachShader");
+  GD_LOAD_GL_FUNCTION(
+      BindAttribLocation, BindAttribLocationProc, "glBindAttribLocation");
+  GD_LOAD_GL_FUNCTION(LinkProgram, LinkProgramProc, "glLinkProgram");
+  GD_LOAD_GL_FUNCTION(GetProgramiv, GetProgramivProc, "glGetProgramiv");
+  GD_LOAD_GL_FUNCTION(DeleteProgram, DeleteProgramProc, "glDeleteProgram");
+  GD_LOAD_GL_FUNCTION(UseProgram, UseProgramProc, "glUseProgram");
+  GD_LOAD_GL_FUNCTION(
+      GetUniformLocation, GetUniformLocationProc, "glGetUniformLocation");
+  GD_LOAD_GL_FUNCTION(Uniform1i, Uniform1iProc, "glUniform1i");
+  GD_LOAD_GL_FUNCTION(Uniform1f, Uniform1fProc, "glUniform1f");
+  GD_LOAD_GL_FUNCTION(Uniform2f, Uniform2fProc, "glUniform2f");
+  GD_LOAD_GL_FUNCTION(GenBuffers, GenBuffersProc, "glGenBuffers");
+  GD_LOAD_GL_FUNCTION(BindBuffer, BindBufferProc, "glBindBuffer");
+  GD_LOAD_GL_FUNCTION(BufferData, BufferDataProc, "glBufferData");
+  GD_LOAD_GL_FUNCTION(
+      VertexAttribPointer, VertexAttribPointerProc, "glVertexAttribPointer");
+  GD_LOAD_GL_FUNCTION(EnableVertexAttribArray,
+                      EnableVertexAttribArrayProc,
+                      "glEnableVertexAttribArray");
+  GD_LOAD_GL_FUNCTION(DisableVertexAttribArray,
+                      DisableVertexAttribArrayProc,
+                      "glDisableVertexAttribArray");
+  GD_LOAD_GL_FUNCTION(
+      VertexAttribDivisor, VertexAttribDivisorProc, "glVertexAttribDivisor");
+  if (!VertexAttribDivisor)
+    GD_LOAD_GL_FUNCTION(VertexAttribDivisor,
+                        VertexAttribDivisorProc,
+                        "glVertexAttribDivisorARB");
+  GD_LOAD_GL_FUNCTION(
+      DrawArraysInstanced, DrawArraysInstancedProc, "glDrawArraysInstanced");
+  if (!DrawArraysInstanced)
+    GD_LOAD_GL_FUNCTION(DrawArraysInstanced,
+                        DrawArraysInstancedProc,
+                        "glDrawArraysInstancedARB");
+#undef GD_LOAD_GL_FUNCTION
+
+  // The functions of the instancing are optional (point sprites are used
+  // without them).
+  return CreateShader && ShaderSource && CompileShader && GetShaderiv &&
+         DeleteShader && CreateProgram && AttachShader && BindAttribLocation &&
+         LinkProgram && GetProgramiv && DeleteProgram && UseProgram &&
+         GetUniformLocation && Uniform1i && Uniform1f && Uniform2f &&
+         GenBuffers && BindBuffer && BufferData && VertexAttribPointer &&
+         EnableVertexAttribArray && DisableVertexAttribArray;
+}
+
+unsigned int InstancedQuadRenderer::CompileProgram(const char* vertexShader,
+                                                   const char* fragmentShader) {
+  const char* sources[] = {vertexShader, fragmentShader};
+  const GLenum types[] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+  GLuint shaders[2] = {0, 0};
+  bool compiled = true;
+  for (int i = 0; i < 2; ++i) {
+    shaders[i] = CreateShader(types[i]);
+    ShaderSource(shaders[i], 1, &sources[i], NULL);
+    CompileShader(shaders[i]);
+
+    GLint status = 0;
+    GetShaderiv(shaders[i], GL_COMPILE_STATUS, &status);
+    compiled = compiled && status;
+  }
+
+  GLuint newProgram = 0;
+  if (compiled) {
+    newProgram = CreateProgram();
+    AttachShader(newProgram, shaders[0]);
+    AttachShader(newProgram, shaders[1]);
+    BindAttribLocation(newProgram, cornerAttribute, "corner");
+    BindAttribLocation(newProgram, positionAttribute, "position");
+    BindAttribLocation(newProgram, sizeAngleAttribute, "sizeAngle");
+    BindAttribLocation(newProgram, colorAttribute, "color");
+    LinkProgram(newProgram);
+
+    GLint status = 0;
+    GetProgramiv(newProgram, GL_LINK_STATUS, &status);
+    if (!status) {
+      DeleteProgram(newProgram);
+      newProgram = 0;
+    }
+  }
+
+  // The shaders are deleted with the program.
+  DeleteShader(shaders[0]);
+  DeleteShader(shaders[1]);
+  return newProgram;
+}
+
+InstancedQuadRenderer::DrawingMode InstancedQuadRenderer::GetDrawingMode() {
+  if (drawingMode != NotChecked) return drawingMode;
+
+  drawingMode = Unsupported;
+  if (!LoadFunctions()) return drawingMode;
+
+  if (VertexAttribDivisor && DrawArraysInstanced) {
+    program = CompileProgram(instancingVertexShader, instancingFragmentShader);
+    if (program) drawingMode = Instancing;
+  }
+  if (!program) {
+    program =
+        CompileProgram(pointSpritesVertexShader, pointSpritesFragmentShader);
+    if (program) drawingMode = PointSprites;
+  }
+  if (!program) return drawingMode;
+
+  scaleLocation = GetUniformLocation(program, "scale");
+  texturedLocation = GetUniformLocation(program, "textured");
+  textureLocation = GetUniformLocation(program, "texture");
+  viewportHeightLocation = GetUniformLocation(program, "viewportHeight");
+
+  GenBuffers(1, &instancesBufferObject);
+  if (drawingMode == Instancing) {
+    const float corners[] = {-1, -1, 1, -1, -1, 1, 1, 1};
+    GenBuffers(1, &cornersBufferObject);
+    BindBuffer(GL_ARRAY_BUFFER, cornersBufferObject);
+    BufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    BindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+
+  return drawingMode;
+}
+
+bool InstancedQuadRenderer::CanBeDrawnOnGPU() const {
+  return (texturingMode == SPK::TEXTURE_NONE ||
+          (texturingMode == SPK::TEXTURE_2D &&
+           getTextureBlending() == GL_MODULATE)) &&
+         getAtlasDimensionX() == 1 && getAtlasDimensionY() == 1 &&
+         getLookOrientation() == SPK::LOOK_CAMERA_PLANE &&
+         getUpOrientation() == SPK::UP_CAMERA &&
+         GetDrawingMode() != Unsupported;
+}
+
+void InstancedQuadRenderer::FillInstancesBuffer(
+    const SPK::Group& group) const {
+  instancesBuffer.resize(group.getNbParticles() * floatsPerParticle);
+  float* data = instancesBuffer.data();
+  for (std::size_t i = 0; i < group.getNbParticles(); ++i) {
+    const SPK::Particle& particle = group.getParticle(i);
+    *(data++) = particle.position().x;
+    *(data++) = particle.position().y;
+    *(data++) = particle.position().z;
+    *(data++) = particle.getParamCurrentValue(SPK::PARAM_SIZE);
+    *(data++) = particle.getParamCurrentValue(SPK::PARAM_ANGLE);
+    *(data++) = particle.getR();
+    *(data++) = particle.getG();
+    *(data++) = particle.getB();
+    *(data++) = particle.getParamCurrentValue(SPK::PARAM_ALPHA);
+  }
+}
+
+void InstancedQuadRenderer::render(const SPK::Group& group) {
+  if (!CanBeDrawnOnGPU()) {
+    SPK::GL::GLQuadRenderer::render(group);
+    return;
+  }
+  if (group.getNbParticles() == 0) return;
+
+  initBlending();
+  initRenderingHints();
+
+  bool textured = texturingMode == SPK::TEXTURE_2D;
+  if (getTexture3DGLExt() == SUPPORTED) glDisable(GL_TEXTURE_3D);
+  if (textured) {
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, getTexture());
+  } else
+    glDisable(GL_TEXTURE_2D);
+
+  UseProgram(program);
+  Uniform2f(scaleLocation, scaleX, scaleY);
+  Uniform1i(texturedLocation, textured ? 1 : 0);
+  Uniform1i(textureLocation, 0);
+
+  // Upload the particles in a new buffer (the previous one may still be used
+  // by the GPU).
+  FillInstancesBuffer(group);
+  BindBuffer(GL_ARRAY_BUFFER, instancesBufferObject);
+  BufferData(GL_ARRAY_BUFFER,
+             instancesBuffer.size() * sizeof(float),
+             instancesBuffer.data(),
+             GL_STREAM_DRAW);
+
+  GLsizei stride = floatsPerParticle * sizeof(float);
+  const GLuint attributes[] = {
+      positionAttribute, sizeAngleAttribute, colorAttribute};
+  const GLint sizes[] = {3, 2, 4};
+  std::size_t offset = 0;
+  for (int i = 0; i < 3; ++i) {
+    EnableVertexAttribArray(attributes[i]);
+    VertexAttribPointer(attributes[i],
+                        sizes[i],
+                        GL_FLOAT,
+                        GL_FALSE,
+                        stride,
+                        reinterpret_cast<const void*>(offset));
+    if (drawingMode == Instancing) VertexAttribDivisor(attributes[i], 1);
+    offset += sizes[i] * sizeof(float);
+  }
+
+  GLsizei count = static_cast<GLsizei>(group.getNbParticles());
+  if (drawingMode == Instancing) {
+    BindBuffer(GL_ARRAY_BUFFER, cornersBufferObject);
+    EnableVertexAttribArray(cornerAttribute);
+    VertexAttribPointer(cornerAttribute, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+
+    DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+
+    DisableVertexAttribArray(cornerAttribute);
+    for (int i = 0; i < 3; ++i) VertexAttribDivisor(attributes[i], 0);
+  } else {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    Uniform1f(viewportHeightLocation, static_cast<float>(viewport[3]));
+
+    glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+    glEnable(GL_POINT_SPRITE);
+    glDrawArrays(GL_POINTS, 0, count);
+    glDisable(GL_POINT_SPRITE);
+    glDisable(GL_VERTEX_PROGRAM_POINT_SIZE);
+  }
+
+  for (int i = 0; i < 3; ++i) DisableVertexAttribArray(attributes[i]);
+  BindBuffer(GL_ARRAY_BUFFER, 0);
+  UseProgram(0);
+}
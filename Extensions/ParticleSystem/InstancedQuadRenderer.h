@@ -0,0 +1,83 @@
+/**
+
+GDevelop - Particle System Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#ifndef INSTANCEDQUADRENDERER_H
+#define INSTANCEDQUADRENDERER_H
+
+#include <SPK.h>
+#include <SPK_GL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \brief A SPARK quad renderer drawing the particles on the GPU.
+ *
+ * The position, size, angle and color of the particles are copied in a single
+ * buffer, uploaded to a streaming vertex buffer for each group rendered. The
+ * quads are then built by a vertex shader, either drawing an instance of a
+ * quad for each particle (when instancing is supported) or drawing a point
+ * sprite for each particle, the quad being cut out of the sprite by the
+ * fragment shader.
+ *
+ * When shaders are not supported, or for the settings that the shaders don't
+ * handle (3D textures, texture atlases, other orientations than facing the
+ * camera, other texture blending than GL_MODULATE), the particles are
+ * rendered by SPK::GL::GLQuadRenderer, building the quads on the CPU.
+ */
+class InstancedQuadRenderer : public SPK::GL::GLQuadRenderer {
+  SPK_IMPLEMENT_REGISTERABLE(InstancedQuadRenderer)
+
+ public:
+  InstancedQuadRenderer(float scaleX = 1.0f, float scaleY = 1.0f);
+  virtual ~InstancedQuadRenderer(){};
+
+  virtual void render(const SPK::Group& group);
+
+  /**
+   * \brief The ways the particles can be drawn, depending on the OpenGL
+   * features supported.
+   */
+  enum DrawingMode {
+    NotChecked,    ///< The OpenGL features were not checked yet.
+    Instancing,    ///< An instance of a quad is drawn for each particle.
+    PointSprites,  ///< A point sprite is drawn for each particle.
+    Unsupported    ///< The quads are built on the CPU.
+  };
+
+  /**
+   * \brief Get the way the particles are drawn, checking the OpenGL features
+   * (and compiling the shaders) at the first call.
+   * \warning An OpenGL context must be active.
+   */
+  static DrawingMode GetDrawingMode();
+
+ private:
+  bool CanBeDrawnOnGPU() const;
+  void FillInstancesBuffer(const SPK::Group& group) const;
+
+  static bool LoadFunctions();
+  static unsigned int CompileProgram(const char* vertexShader,
+                                     const char* fragmentShader);
+
+  static DrawingMode drawingMode;
+  static unsigned int program;  ///< The shaders of drawingMode.
+  static unsigned int instancesBufferObject;  ///< The streaming vertex buffer.
+  static unsigned int cornersBufferObject;  ///< The corners of the instanced
+                                            ///< quad.
+  static int scaleLocation;
+  static int texturedLocation;
+  static int textureLocation;
+  static int viewportHeightLocation;
+  static std::vector<float>
+      instancesBuffer;  ///< The data of the particles, shared by all the
+                        ///< renderers (like the buffers of GLQuadRenderer).
+
+  static const std::size_t floatsPerParticle;
+};
+
+#endif  // INSTANCEDQUADRENDERER_H
@@ -7,6 +7,8 @@ This project is released under the MIT License.
 
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <cmath>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/FontManager.h"
@@ -16,10 +18,13 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "InstancedQuadRenderer.h"
 #include "ParticleEmitterObject.h"
 #include "ParticleSystemWrapper.h"
+#include "SceneParticleSystemsManager.h"
 
 #if defined(GD_IDE_ONLY)
 #include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
@@ -80,6 +85,8 @@ ParticleEmitterBase::ParticleEmitterBase()
       particleAngleRandomness2(0),
       maxParticleNb(300),
       destroyWhenNoParticles(true),
+      sleepWhenOffScreen(false),
+      lodDistance(0),
       particleSystem(NULL) {}
 
 ParticleEmitterObject::ParticleEmitterObject(gd::String name_)
@@ -154,6 +161,8 @@ void ParticleEmitterBase::UnserializeParticleEmitterBaseFrom(
   additive = element.GetBoolAttribute("additive");
   destroyWhenNoParticles =
       element.GetBoolAttribute("destroyWhenNoParticles", false);
+  sleepWhenOffScreen = element.GetBoolAttribute("sleepWhenOffScreen", false);
+  lodDistance = element.GetDoubleAttribute("lodDistance", 0);
   textureParticleName = element.GetStringAttribute("textureParticleName");
   maxParticleNb = element.GetIntAttribute("maxParticleNb", 5000);
 
@@ -272,6 +281,8 @@ void ParticleEmitterBase::SerializeParticleEmitterBaseTo(
   element.SetAttribute("particleAngleRandomness2", particleAngleRandomness2);
   element.SetAttribute("additive", additive);
   element.SetAttribute("destroyWhenNoParticles", destroyWhenNoParticles);
+  element.SetAttribute("sleepWhenOffScreen", sleepWhenOffScreen);
+  element.SetAttribute("lodDistance", lodDistance);
   element.SetAttribute("textureParticleName", textureParticleName);
   element.SetAttribute("maxParticleNb", (int)maxParticleNb);
 
@@ -326,9 +337,16 @@ void ParticleEmitterBase::SerializeParticleEmitterBaseTo(
 }
 #endif
 
-void ParticleEmitterBase::CreateParticleSystem() {
-  if (particleSystem) delete particleSystem;
+void ParticleEmitterBase::CreateParticleSystem(
+    SceneParticleSystemsManager* manager) {
+  std::shared_ptr<SFMLTextureWrapper> textureParticle;
+  if (particleSystem) {
+    textureParticle = particleSystem->textureParticle;
+    delete particleSystem;
+  }
   particleSystem = new ParticleSystemWrapper;
+  particleSystem->textureParticle = textureParticle;
+  particleSystem->manager = manager;
 
   int enabledFlag = 0;
   int mutableFlag = 0;
@@ -395,9 +413,18 @@ void ParticleEmitterBase::CreateParticleSystem() {
 
   if (rendererType == Quad) enabledFlag |= SPK::PARAM_TEXTURE_INDEX;
 
-  // Create the model
-  particleSystem->particleModel =
-      SPK::Model::create(enabledFlag, mutableFlag, randomFlag);
+  // Create the model and the group, or reuse the ones of a destroyed emitter
+  SceneParticleSystemsManager::GroupKey groupKey = {
+      enabledFlag, mutableFlag, randomFlag, maxParticleNb};
+  particleSystem->groupKey = groupKey;
+  if (!manager || !manager->TakeGroup(groupKey,
+                                      particleSystem->particleModel,
+                                      particleSystem->group)) {
+    particleSystem->particleModel =
+        SPK::Model::create(enabledFlag, mutableFlag, randomFlag);
+    particleSystem->group =
+        SPK::Group::create(particleSystem->particleModel, maxParticleNb);
+  }
   UpdateRedParameters();
   UpdateGreenParameters();
   UpdateBlueParameters();
@@ -406,41 +433,6 @@ void ParticleEmitterBase::CreateParticleSystem() {
   UpdateAngleParameters();
   UpdateLifeTime();
 
-  // Create the renderer
-  if (rendererType == Line)
-    particleSystem->renderer =
-        SPK::GL::GLLineRenderer::create(rendererParam1, rendererParam2);
-  else if (rendererType == Quad) {
-    SPK::GL::GLQuadRenderer* quadRenderer =
-        new SPK::GL::GLQuadRenderer(rendererParam1, rendererParam2);
-
-    if (particleSystem->textureParticle) {
-      quadRenderer->setTexturingMode(SPK::TEXTURE_2D);
-      quadRenderer->setTexture(
-          particleSystem->textureParticle->texture.getNativeHandle());
-    }
-
-    particleSystem->renderer = quadRenderer;
-  } else {
-    SPK::GL::GLPointRenderer* pointRenderer =
-        SPK::GL::GLPointRenderer::create();
-    pointRenderer->setType(SPK::POINT_CIRCLE);
-    pointRenderer->setSize(rendererParam1);
-
-    particleSystem->renderer = pointRenderer;
-  }
-
-  particleSystem->renderer->enableBlending(true);
-  if (additive)
-    particleSystem->renderer->setBlendingFunctions(GL_SRC_ALPHA, GL_ONE);
-  else
-    particleSystem->renderer->setBlendingFunctions(GL_SRC_ALPHA,
-                                                   GL_ONE_MINUS_SRC_ALPHA);
-  particleSystem->renderer->setTextureBlending(
-      GL_MODULATE);  // Texture color modulated with particle color
-  particleSystem->renderer->enableRenderingHint(
-      SPK::DEPTH_TEST, false);  // No depth test for performance
-
   // Create the zone
   particleSystem->zone = SPK::Sphere::create(SPK::Vector3D(0, 0), zoneRadius);
 
@@ -454,18 +446,74 @@ void ParticleEmitterBase::CreateParticleSystem() {
   particleSystem->emitter->setTank(tank);
   particleSystem->emitter->setFlow(flow);
 
-  // Create the Group
-  particleSystem->group =
-      SPK::Group::create(particleSystem->particleModel, maxParticleNb);
+  // Set up the Group
   particleSystem->group->addEmitter(particleSystem->emitter);
   particleSystem->group->setGravity(
       SPK::Vector3D(particleGravityX, -particleGravityY, particleGravityZ));
   particleSystem->group->setFriction(friction);
-  particleSystem->group->setRenderer(particleSystem->renderer);
+  SetUpRenderer();
 
   // Create the System
   particleSystem->particleSystem = SPK::System::create();
   particleSystem->particleSystem->addGroup(particleSystem->group);
+  particleSystem->UpdateMemoryAccount();
+}
+
+void ParticleEmitterBase::SetUpRenderer() {
+  SceneParticleSystemsManager* manager = particleSystem->manager;
+  SceneParticleSystemsManager::RendererKey rendererKey = {
+      rendererType,
+      rendererParam1,
+      rendererParam2,
+      additive,
+      rendererType == Quad && particleSystem->textureParticle
+          ? particleSystem->textureParticle->texture.getNativeHandle()
+          : 0};
+  SPK::GL::GLRenderer* renderer =
+      manager ? manager->GetRenderer(rendererKey) : NULL;
+
+  if (!renderer) {
+    // Create the renderer
+    if (rendererType == Line)
+      renderer =
+          SPK::GL::GLLineRenderer::create(rendererParam1, rendererParam2);
+    else if (rendererType == Quad) {
+      SPK::GL::GLQuadRenderer* quadRenderer =
+          new InstancedQuadRenderer(rendererParam1, rendererParam2);
+
+      if (particleSystem->textureParticle) {
+        quadRenderer->setTexturingMode(SPK::TEXTURE_2D);
+        quadRenderer->setTexture(
+            particleSystem->textureParticle->texture.getNativeHandle());
+      }
+
+      renderer = quadRenderer;
+    } else {
+      SPK::GL::GLPointRenderer* pointRenderer =
+          SPK::GL::GLPointRenderer::create();
+      pointRenderer->setType(SPK::POINT_CIRCLE);
+      pointRenderer->setSize(rendererParam1);
+
+      renderer = pointRenderer;
+    }
+
+    renderer->enableBlending(true);
+    if (additive)
+      renderer->setBlendingFunctions(GL_SRC_ALPHA, GL_ONE);
+    else
+      renderer->setBlendingFunctions(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    renderer->setTextureBlending(
+        GL_MODULATE);  // Texture color modulated with particle color
+    renderer->enableRenderingHint(SPK::DEPTH_TEST,
+                                  false);  // No depth test for performance
+
+    if (manager)
+      manager->AddRenderer(
+          rendererKey, renderer, particleSystem->textureParticle);
+  }
+
+  particleSystem->renderer = renderer;
+  particleSystem->group->setRenderer(renderer);
 }
 
 void ParticleEmitterBase::UpdateRedParameters() {
@@ -567,10 +615,13 @@ void ParticleEmitterBase::UpdateLifeTime() {
 
 RuntimeParticleEmitterObject::RuntimeParticleEmitterObject(
     RuntimeScene& scene, const ParticleEmitterObject& particleEmitterObject)
-    : RuntimeObject(scene, particleEmitterObject), hasSomeParticles(true) {
+    : RuntimeObject(scene, particleEmitterObject),
+      hasSomeParticles(true),
+      sleeping(false),
+      sleptTime(0) {
   ParticleEmitterBase::operator=(particleEmitterObject);
 
-  CreateParticleSystem();
+  CreateParticleSystem(&scene.GetExtensionData<SceneParticleSystemsManager>());
   SetTexture(scene, GetParticleTexture());
 
   OnPositionChanged();
@@ -584,8 +635,8 @@ ParticleEmitterBase::~ParticleEmitterBase() {
  * Render object at runtime
  */
 bool RuntimeParticleEmitterObject::Draw(sf::RenderTarget& renderTarget) {
-  // Don't draw anything if hidden
-  if (hidden) return true;
+  // Don't draw anything if hidden, or if the particles can't be seen.
+  if (hidden || sleeping) return true;
 
   renderTarget.popGLStates();
 
@@ -726,10 +777,86 @@ void ParticleEmitterBase::SetZoneRadius(float newValue) {
   if (particleSystem && particleSystem->zone)
     particleSystem->zone->setRadius(zoneRadius);
 }
+void ParticleEmitterBase::SetLODDistance(float newValue) {
+  lodDistance = newValue;
+  // Restore the flow reduced by the runtime object.
+  if (lodDistance <= 0 && particleSystem && particleSystem->emitter)
+    particleSystem->emitter->setFlow(flow);
+}
+
+float RuntimeParticleEmitterObject::GetParticlesReach() const {
+  float lifeTime = std::max(GetParticleLifeTimeMin(), GetParticleLifeTimeMax());
+  float speed =
+      std::max(std::abs(GetEmitterForceMin()), std::abs(GetEmitterForceMax()));
+  float particleSize = std::max(GetRendererParam1(), GetRendererParam2()) *
+                       std::max(GetParticleSize1(), GetParticleSize2()) /
+                       100.0f;
+
+  // The friction can only make the particles go less far. The units of the
+  // particle system are 4 pixels (see OnPositionChanged).
+  return 4.0f * (GetZoneRadius() + speed * lifeTime +
+                 GetParticleGravityLength() * lifeTime * lifeTime / 2.0f +
+                 particleSize);
+}
+
+float RuntimeParticleEmitterObject::GetDistanceToCameras(
+    const RuntimeScene& scene) const {
+  const RuntimeLayer& layer = scene.GetRuntimeLayer(GetInternedLayer());
+  if (layer.GetCameraCount() == 0) return 0;
+
+  float reach = GetParticlesReach();
+  float distance = -1;
+  for (std::size_t i = 0; i < layer.GetCameraCount(); ++i) {
+    sf::FloatRect area = layer.GetCamera(i).GetVisibleArea();
+    float dx = std::max(
+        0.0f, std::max(area.left - GetX(), GetX() - area.left - area.width));
+    float dy = std::max(
+        0.0f, std::max(area.top - GetY(), GetY() - area.top - area.height));
+    float cameraDistance = std::max(0.0f, std::sqrt(dx * dx + dy * dy) - reach);
+    if (distance < 0 || cameraDistance < distance) distance = cameraDistance;
+  }
+
+  return distance;
+}
 
 void RuntimeParticleEmitterObject::Update(const RuntimeScene& scene) {
   double elapsedTimeInSeconds =
       static_cast<double>(GetElapsedTime(scene)) / 1000000.0;
+
+  if (GetParticleSystem() &&
+      (GetSleepWhenOffScreen() || GetLODDistance() > 0)) {
+    float distance = GetDistanceToCameras(scene);
+    sleeping = GetSleepWhenOffScreen() && distance > 0;
+    if (sleeping) {
+      sleptTime += elapsedTimeInSeconds;
+      return;
+    }
+
+    // Reduce the emission of the emitters far from the cameras.
+    if (GetLODDistance() > 0 && GetFlow() > 0 &&
+        GetParticleSystem()->emitter) {
+      float lodFactor = std::max(0.0f, 1.0f - distance / GetLODDistance());
+      GetParticleSystem()->emitter->setFlow(GetFlow() * lodFactor);
+    }
+  } else {
+    sleeping = false;
+  }
+
+  if (sleptTime > 0 && GetParticleSystem()) {
+    // Fast-forward the particles, using steps of at most 1/30 of a second, so
+    // that they look as if they had been updated while sleeping. The particles
+    // older than their lifetime would be dead anyway.
+    double fastForwardTime = std::min(
+        sleptTime,
+        static_cast<double>(
+            std::max(GetParticleLifeTimeMin(), GetParticleLifeTimeMax())));
+    int steps =
+        std::min(30, static_cast<int>(std::ceil(fastForwardTime * 30.0)));
+    for (int i = 0; i < steps; ++i)
+      GetParticleSystem()->particleSystem->update(fastForwardTime / steps);
+    sleptTime = 0;
+  }
+
   if (GetParticleSystem())
     hasSomeParticles =
         GetParticleSystem()->particleSystem->update(elapsedTimeInSeconds);
@@ -803,6 +930,12 @@ void ParticleEmitterBase::SetTexture(RuntimeScene& scene,
     particleSystem->textureParticle =
         scene.GetImageManager()->GetSFMLTexture(textureParticleName);
 
+    // Shared renderers are not modified: use the renderer of the new texture.
+    if (particleSystem->manager) {
+      if (particleSystem->group) SetUpRenderer();
+      return;
+    }
+
     // Notify the renderer of the change
     SPK::GL::GLQuadRenderer* quadRenderer =
         dynamic_cast<SPK::GL::GLQuadRenderer*>(particleSystem->renderer);
@@ -873,4 +1006,6 @@ void ParticleEmitterBase::Init(const ParticleEmitterBase& other) {
   particleAngleRandomness2 = other.particleAngleRandomness2;
   maxParticleNb = other.maxParticleNb;
   destroyWhenNoParticles = other.destroyWhenNoParticles;
+  sleepWhenOffScreen = other.sleepWhenOffScreen;
+  lodDistance = other.lodDistance;
 }
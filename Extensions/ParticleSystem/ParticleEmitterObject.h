@@ -12,6 +12,7 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeObject.h"
 class ParticleSystemWrapper;
 class RuntimeScene;
+class SceneParticleSystemsManager;
 namespace gd {
 class ImageManager;
 class InitialInstance;
@@ -51,8 +52,11 @@ class GD_EXTENSION_API ParticleEmitterBase {
 
   /**
    * \brief Initialize the particle system with the current objects settings.
+   * \param manager If not NULL, the renderer is shared with the other emitters
+   * of the manager having the same settings, and the particles are stored in a
+   * group reused from a destroyed emitter when possible.
    */
-  void CreateParticleSystem();
+  void CreateParticleSystem(SceneParticleSystemsManager* manager = NULL);
 
   void UpdateRedParameters();
   void UpdateGreenParameters();
@@ -183,6 +187,10 @@ class GD_EXTENSION_API ParticleEmitterBase {
   void SetDestroyWhenNoParticles(bool enable = true) {
     destroyWhenNoParticles = enable;
   };
+  void SetSleepWhenOffScreen(bool enable = true) {
+    sleepWhenOffScreen = enable;
+  };
+  void SetLODDistance(float newValue);
 
   float GetRendererParam1() const { return rendererParam1; };
   float GetRendererParam2() const { return rendererParam2; };
@@ -207,6 +215,8 @@ class GD_EXTENSION_API ParticleEmitterBase {
   float GetParticleLifeTimeMax() const { return particleLifeTimeMax; };
   std::size_t GetMaxParticleNb() const { return maxParticleNb; };
   bool GetDestroyWhenNoParticles() const { return destroyWhenNoParticles; };
+  bool GetSleepWhenOffScreen() const { return sleepWhenOffScreen; };
+  float GetLODDistance() const { return lodDistance; };
 
   ParticleParameterType GetRedParameterType() const { return redParam; };
   ParticleParameterType GetGreenParameterType() const { return greenParam; };
@@ -260,6 +270,7 @@ class GD_EXTENSION_API ParticleEmitterBase {
 
  private:
   void Init(const ParticleEmitterBase& other);
+  void SetUpRenderer();
 
   gd::String textureParticleName;
   RendererType rendererType;
@@ -291,6 +302,11 @@ class GD_EXTENSION_API ParticleEmitterBase {
   bool destroyWhenNoParticles;  ///< If set to true, the object will removed
                                 ///< itself from the scene when it has no more
                                 ///< particles.
+  bool sleepWhenOffScreen;  ///< If set to true, the particles are not updated
+                            ///< when they can't be seen by any camera.
+  float lodDistance;  ///< The distance from the cameras, in pixels, at which
+                      ///< the emission flow is reduced to nothing. 0 to
+                      ///< disable the reduction.
 
   ParticleSystemWrapper*
       particleSystem;  ///< Pointer to the class wrapping all the real particle
@@ -344,6 +360,10 @@ class GD_EXTENSION_API RuntimeParticleEmitterObject
 
   virtual bool Draw(sf::RenderTarget& renderTarget);
 
+  // Particles are drawn far from the emitter position.
+  virtual bool CanBeCulled() const { return false; };
+  virtual bool CanBeRecycled() const { return false; };
+
   virtual void OnPositionChanged();
 
   virtual float GetWidth() const { return 32; };
@@ -353,6 +373,12 @@ class GD_EXTENSION_API RuntimeParticleEmitterObject
 
   bool NoMoreParticles() const { return !hasSomeParticles; };
 
+  /**
+   * \brief Return true if the particles are not updated because they can't be
+   * seen by any camera (see SetSleepWhenOffScreen).
+   */
+  bool IsSleeping() const { return sleeping; };
+
   /**
    * Changing object angle is equivalent to changing emission X/Y direction
    */
@@ -375,7 +401,22 @@ class GD_EXTENSION_API RuntimeParticleEmitterObject
   };
 
  private:
+  /**
+   * \brief Return the distance, in pixels, from the particles to the nearest
+   * area seen by a camera of the layer, or 0 if they can be seen.
+   */
+  float GetDistanceToCameras(const RuntimeScene& scene) const;
+
+  /**
+   * \brief Return the maximum distance, in pixels, from the emitter position
+   * that the particles can reach during their life.
+   */
+  float GetParticlesReach() const;
+
   bool hasSomeParticles;
+  bool sleeping;
+  double sleptTime;  ///< The time, in seconds, elapsed since the particles
+                     ///< were last updated, when sleeping.
 };
 
 #endif  // PARTICLEEMITTEROBJECT_H
@@ -18,7 +18,9 @@ ParticleSystemWrapper::ParticleSystemWrapper()
       emitter(NULL),
       zone(NULL),
       group(NULL),
-      renderer(NULL) {
+      renderer(NULL),
+      manager(NULL),
+      memoryAccount(gd::SystemStats::ParticleSystems) {
   if (!SPKinitialized) {
     SPK::randomSeed = static_cast<unsigned int>(time(NULL));
     SPK::System::setClampStep(true, 0.1f);  // clamp the step to 100 ms
@@ -30,23 +32,53 @@ ParticleSystemWrapper::ParticleSystemWrapper()
   }
 }
 
-ParticleSystemWrapper::~ParticleSystemWrapper() {
+ParticleSystemWrapper::~ParticleSystemWrapper() { Destroy(); }
+
+void ParticleSystemWrapper::Destroy() {
   if (particleSystem) delete particleSystem;
-  if (particleModel) delete particleModel;
+  if (manager && group && particleModel) {
+    if (emitter) group->removeEmitter(emitter);
+    manager->GiveBackGroup(groupKey, particleModel, group);
+  } else {
+    if (particleModel) delete particleModel;
+    if (group) delete group;
+  }
   if (emitter) delete emitter;
   if (zone) delete zone;
-  if (group) delete group;
-  if (renderer) delete renderer;
+  if (renderer && !manager) delete renderer;  // Shared renderers are owned by
+                                              // the manager.
+
+  particleSystem = NULL;
+  particleModel = NULL;
+  emitter = NULL;
+  zone = NULL;
+  group = NULL;
+  renderer = NULL;
+  memoryAccount.SetBytes(0);
+}
+
+void ParticleSystemWrapper::UpdateMemoryAccount() {
+  if (!group || !particleModel) {
+    memoryAccount.SetBytes(0);
+    return;
+  }
+
+  // Each particle has its data (positions, velocity, age...) and the arrays
+  // of the parameters enabled in the model.
+  std::size_t particleBytes =
+      sizeof(SPK::Particle) + sizeof(SPK::Vector3D) * 3 + sizeof(float) * 3 +
+      sizeof(float) * (particleModel->getSizeOfParticleCurrentArray() +
+                       particleModel->getSizeOfParticleExtendedArray());
+  memoryAccount.SetBytes(group->getParticles().getNbReserved() *
+                         particleBytes);
 }
 
 void ParticleSystemWrapper::Init(const ParticleSystemWrapper& other) {
+  Destroy();
   textureParticle = other.textureParticle;
-  if (particleSystem) delete particleSystem;
-  if (particleModel) delete particleModel;
-  if (emitter) delete emitter;
-  if (zone) delete zone;
-  if (group) delete group;
-  if (renderer) delete renderer;
+  manager = other.manager;
+  groupKey = other.groupKey;
+  if (manager) renderer = other.renderer;
 
   // Don't initialize members if the other object's member are NULL.
   if (other.particleModel == NULL) return;
@@ -65,4 +97,5 @@ void ParticleSystemWrapper::Init(const ParticleSystemWrapper& other) {
   particleSystem = new SPK::System(*other.particleSystem);
   particleSystem->removeGroup(other.group);
   particleSystem->addGroup(group);
+  UpdateMemoryAccount();
 }
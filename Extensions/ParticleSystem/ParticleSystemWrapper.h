@@ -9,6 +9,8 @@ This project is released under the MIT License.
 #define PARTICLESYSTEMWRAPPER_H
 
 #include <memory>
+#include "GDCore/Tools/SystemStats.h"
+#include "SceneParticleSystemsManager.h"
 class SFMLTextureWrapper;
 
 namespace SPK {
@@ -26,6 +28,10 @@ class GLRenderer;
  * Wrapper around SPARK related stuff.
  * This class gives direct access to these stuff,
  * it only manages the destruction and automatize the copy behaviour.
+ *
+ * When the wrapper has a manager, the renderer is owned by the manager and the
+ * model and the group are given back to the manager when the wrapper is
+ * destroyed.
  */
 class GD_EXTENSION_API ParticleSystemWrapper {
  public:
@@ -33,13 +39,14 @@ class GD_EXTENSION_API ParticleSystemWrapper {
   virtual ~ParticleSystemWrapper();
   ParticleSystemWrapper(
       const ParticleSystemWrapper& other)  // What a bad design
-  {
+      : memoryAccount(gd::SystemStats::ParticleSystems) {
     particleSystem = NULL;
     particleModel = NULL;
     emitter = NULL;
     zone = NULL;
     group = NULL;
     renderer = NULL;
+    manager = NULL;
     Init(other);
   };
   ParticleSystemWrapper& operator=(const ParticleSystemWrapper& other) {
@@ -55,9 +62,24 @@ class GD_EXTENSION_API ParticleSystemWrapper {
   SPK::Group* group;
   SPK::GL::GLRenderer* renderer;
   std::shared_ptr<SFMLTextureWrapper> textureParticle;
+  SceneParticleSystemsManager* manager;  ///< The manager sharing the renderer
+                                         ///< and pooling the group, or NULL.
+  SceneParticleSystemsManager::GroupKey
+      groupKey;  ///< The settings of the model and of the group.
+
+  /**
+   * \brief Account the memory reserved for the particles of the group in
+   * gd::SystemStats.
+   *
+   * To be called when the group is created.
+   */
+  void UpdateMemoryAccount();
 
  private:
   void Init(const ParticleSystemWrapper& other);
+  void Destroy();
+
+  gd::MemoryAccount memoryAccount;
 
   static bool SPKinitialized;
 };
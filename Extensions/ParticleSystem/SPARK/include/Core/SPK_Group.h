@@ -865,6 +865,8 @@ namespace SPK
 		mutable std::map<std::string,Buffer*> additionalBuffers;
 		mutable std::set<Buffer*> swappableBuffers;
 
+		std::vector<float> batchRatios; // The life ratios of the particles, used by updateParticlesInBatch
+
 		void pushParticle(std::vector<EmitterData>::iterator& emitterIt,unsigned int& nbManualBorn);
 		void launchParticle(Particle& p,std::vector<EmitterData>::iterator& emitterIt,unsigned int& nbManualBorn);
 
@@ -874,6 +876,10 @@ namespace SPK
 
 		void updateAABB(const Particle& particle);
 
+		// Updates all the particles as Particle::update does, pass after pass on all the particles.
+		// Only used when there are no modifiers, interpolators nor custom update.
+		void updateParticlesInBatch(float deltaTime);
+
 		void sortParticles(int start,int end);
 	};
 
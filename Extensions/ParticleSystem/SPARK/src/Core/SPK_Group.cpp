@@ -324,9 +324,17 @@ namespace SPK
 		}
 
 		// Updates particles
+		// In the common case, the particles are all updated first, then their deaths are processed in the same order
+		bool batchUpdate = (activeModifiers.empty())&&(fupdate == NULL)&&(model->getNbInterpolated() == 0);
+		if (batchUpdate)
+			updateParticlesInBatch(deltaTime);
+
 		for (size_t i = 0; i < pool.getNbActive(); ++i)
 		{
-			if ((pool[i].update(deltaTime))||((fupdate != NULL)&&((*fupdate)(pool[i],deltaTime))))
+			bool dead = batchUpdate ?
+				particleData[i].life <= 0.0f :
+				(pool[i].update(deltaTime))||((fupdate != NULL)&&((*fupdate)(pool[i],deltaTime)));
+			if (dead)
 			{
 				if (fdeath != NULL)
 					(*fdeath)(pool[i]);
@@ -612,6 +620,65 @@ namespace SPK
 			creationBuffer.pop_front();
 	}
 
+	void Group::updateParticlesInBatch(float deltaTime)
+	{
+		const size_t nbActive = pool.getNbActive();
+		const size_t currentSize = model->getSizeOfParticleCurrentArray();
+		const size_t extendedSize = model->getSizeOfParticleExtendedArray();
+
+		// Updates ages and the mutable parameters
+		if (!model->immortal)
+		{
+			batchRatios.resize(nbActive);
+			for (size_t i = 0; i < nbActive; ++i)
+			{
+				Particle::ParticleData& data = particleData[i];
+				data.age += deltaTime;
+				batchRatios[i] = std::min(1.0f,deltaTime / data.life);
+				data.life -= deltaTime;
+			}
+
+			for (size_t j = 0; j < model->nbMutableParams; ++j)
+			{
+				float* current = particleCurrentParams + model->particleEnableIndices[model->mutableParams[j]];
+				const float* final = particleExtendedParams + j;
+				for (size_t i = 0; i < nbActive; ++i)
+					current[i * currentSize] += (final[i * extendedSize] - current[i * currentSize]) * batchRatios[i];
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < nbActive; ++i)
+				particleData[i].age += deltaTime;
+		}
+
+		// Updates positions and velocities
+		const Vector3D gravityStep = gravity * deltaTime;
+		for (size_t i = 0; i < nbActive; ++i)
+		{
+			Particle::ParticleData& data = particleData[i];
+			data.oldPosition = data.position;
+			data.position += data.velocity * deltaTime;
+			data.velocity += gravityStep;
+		}
+
+		if (friction != 0.0f)
+		{
+			if (model->isEnabled(PARAM_MASS))
+			{
+				const float* mass = particleCurrentParams + model->particleEnableIndices[PARAM_MASS];
+				for (size_t i = 0; i < nbActive; ++i)
+					particleData[i].velocity *= 1.0f - std::min(1.0f,friction * deltaTime / mass[i * currentSize]);
+			}
+			else
+			{
+				const float frictionFactor = 1.0f - std::min(1.0f,friction * deltaTime / Model::DEFAULT_VALUES[PARAM_MASS]);
+				for (size_t i = 0; i < nbActive; ++i)
+					particleData[i].velocity *= frictionFactor;
+			}
+		}
+	}
+
 	void Group::updateAABB(const Particle& particle)
 	{
 		const Vector3D& position = particle.position();
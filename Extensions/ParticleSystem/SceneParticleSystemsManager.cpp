@@ -0,0 +1,69 @@
+/**
+
+GDevelop - Particle System Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "SceneParticleSystemsManager.h"
+#include <SPK.h>
+#include <SPK_GL.h>
+
+const std::size_t SceneParticleSystemsManager::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+const std::size_t SceneParticleSystemsManager::maxPooledGroupsCount = 64;
+
+SceneParticleSystemsManager::~SceneParticleSystemsManager() {
+  // Groups are destroyed before the renderers they were using.
+  for (auto& it : pooledGroups) {
+    for (auto& modelAndGroup : it.second) {
+      delete modelAndGroup.first;
+      delete modelAndGroup.second;
+    }
+  }
+
+  for (auto& it : renderers) delete it.second.renderer;
+}
+
+SPK::GL::GLRenderer* SceneParticleSystemsManager::GetRenderer(
+    const RendererKey& key) const {
+  auto it = renderers.find(key);
+  return it != renderers.end() ? it->second.renderer : NULL;
+}
+
+void SceneParticleSystemsManager::AddRenderer(
+    const RendererKey& key,
+    SPK::GL::GLRenderer* renderer,
+    std::shared_ptr<SFMLTextureWrapper> texture) {
+  RendererEntry& entry = renderers[key];
+  if (entry.renderer && entry.renderer != renderer) delete entry.renderer;
+
+  entry.renderer = renderer;
+  entry.texture = texture;
+}
+
+bool SceneParticleSystemsManager::TakeGroup(const GroupKey& key,
+                                            SPK::Model*& model,
+                                            SPK::Group*& group) {
+  auto it = pooledGroups.find(key);
+  if (it == pooledGroups.end() || it->second.empty()) return false;
+
+  model = it->second.back().first;
+  group = it->second.back().second;
+  it->second.pop_back();
+  return true;
+}
+
+void SceneParticleSystemsManager::GiveBackGroup(const GroupKey& key,
+                                                SPK::Model* model,
+                                                SPK::Group* group) {
+  std::vector<std::pair<SPK::Model*, SPK::Group*>>& groups = pooledGroups[key];
+  if (groups.size() >= maxPooledGroupsCount) {
+    delete model;
+    delete group;
+    return;
+  }
+
+  group->empty();
+  groups.push_back(std::make_pair(model, group));
+}
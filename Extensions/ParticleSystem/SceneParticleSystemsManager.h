@@ -0,0 +1,131 @@
+/**
+
+GDevelop - Particle System Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#ifndef SCENEPARTICLESYSTEMSMANAGER_H
+#define SCENEPARTICLESYSTEMSMANAGER_H
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+class SFMLTextureWrapper;
+
+namespace SPK {
+class Model;
+class Group;
+namespace GL {
+class GLRenderer;
+}
+}  // namespace SPK
+
+/**
+ * \brief Share the SPARK objects of the particle emitters of a scene.
+ *
+ * Renderers only depend on the settings of the emitters and are shared by
+ * all the emitters having the same settings. The models and the groups,
+ * storing the particles, are given back to the manager when an emitter is
+ * destroyed, and reused by the next emitters created with the same model
+ * flags and capacity: creating an emitter doesn't allocate its particles
+ * again.
+ *
+ * The manager of a scene is stored in the scene (see
+ * RuntimeScene::GetExtensionData).
+ */
+class SceneParticleSystemsManager : public RuntimeSceneExtensionData {
+ public:
+  static const std::size_t sceneDataIndex;  ///< The slot of the managers in
+                                            ///< the scenes.
+
+  /**
+   * \brief The settings from which a renderer is created.
+   */
+  struct RendererKey {
+    int rendererType;  ///< See ParticleEmitterBase::RendererType.
+    float rendererParam1;
+    float rendererParam2;
+    bool additive;
+    unsigned int texture;  ///< The OpenGL texture, or 0 if none.
+
+    bool operator<(const RendererKey& other) const {
+      return std::tie(
+                 rendererType, rendererParam1, rendererParam2, additive,
+                 texture) < std::tie(other.rendererType,
+                                     other.rendererParam1,
+                                     other.rendererParam2,
+                                     other.additive,
+                                     other.texture);
+    }
+  };
+
+  /**
+   * \brief The settings with which a model and its group were created.
+   */
+  struct GroupKey {
+    int enabledFlag;
+    int mutableFlag;
+    int randomFlag;
+    std::size_t capacity;  ///< The maximum number of particles of the group.
+
+    bool operator<(const GroupKey& other) const {
+      return std::tie(enabledFlag, mutableFlag, randomFlag, capacity) <
+             std::tie(other.enabledFlag,
+                      other.mutableFlag,
+                      other.randomFlag,
+                      other.capacity);
+    }
+  };
+
+  SceneParticleSystemsManager(){};
+  virtual ~SceneParticleSystemsManager();
+
+  /**
+   * \brief Get the renderer created for the specified settings.
+   * \return The renderer, or NULL if AddRenderer was not called for these
+   * settings.
+   */
+  SPK::GL::GLRenderer* GetRenderer(const RendererKey& key) const;
+
+  /**
+   * \brief Store a renderer, to be shared by all the emitters having the
+   * specified settings.
+   * \note The manager takes the ownership of the renderer, and keeps the
+   * texture used by the renderer alive.
+   */
+  void AddRenderer(const RendererKey& key,
+                   SPK::GL::GLRenderer* renderer,
+                   std::shared_ptr<SFMLTextureWrapper> texture);
+
+  /**
+   * \brief Take a model and its group given back by a destroyed emitter.
+   * \return true if a model and a group were available, false otherwise
+   * (model and group are left unchanged).
+   */
+  bool TakeGroup(const GroupKey& key, SPK::Model*& model, SPK::Group*& group);
+
+  /**
+   * \brief Give back the model and the group of a destroyed emitter, to be
+   * reused by another emitter. The particles of the group are removed.
+   * \note The manager takes the ownership of the model and of the group.
+   */
+  void GiveBackGroup(const GroupKey& key, SPK::Model* model, SPK::Group* group);
+
+ private:
+  struct RendererEntry {
+    SPK::GL::GLRenderer* renderer;
+    std::shared_ptr<SFMLTextureWrapper> texture;
+  };
+
+  std::map<RendererKey, RendererEntry> renderers;
+  std::map<GroupKey, std::vector<std::pair<SPK::Model*, SPK::Group*>>>
+      pooledGroups;  ///< The models and groups not used by any emitter.
+
+  static const std::size_t maxPooledGroupsCount;  ///< The maximum number of
+                                                  ///< groups kept for a key.
+};
+
+#endif  // SCENEPARTICLESYSTEMSMANAGER_H
@@ -54,6 +54,42 @@ void DeclarePathfindingBehaviorExtension(gd::PlatformExtension& extension) {
         .SetFunctionName("MoveTo")
         .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
 
+    aut.AddAction("MoveWithFlowField",
+                  _("Move to a shared position"),
+                  _("Move the object to a position, like a lot of other "
+                    "objects. Instead of computing a path for each object, the "
+                    "objects follow the directions computed once for all the "
+                    "objects moving to this position. The path of the object "
+                    "only contains the next position to move to."),
+                  _("Move _PARAM0_ to _PARAM3_;_PARAM4_ with the other "
+                    "objects moving to this position"),
+                  "",
+                  "CppPlatform/Extensions/AStaricon24.png",
+                  "CppPlatform/Extensions/AStaricon16.png")
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .AddCodeOnlyParameter("currentScene", "")
+
+        .AddParameter("expression", _("Destination X position"))
+        .AddParameter("expression", _("Destination Y position"))
+        .SetFunctionName("MoveWithFlowField")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddCondition("FollowingFlowField",
+                     _("Moving to a shared position"),
+                     _("Return true if the object is moving to a position "
+                       "shared with other objects (and has not reached it "
+                       "yet)."),
+                     _("_PARAM0_ is moving to a shared position"),
+                     "",
+                     "CppPlatform/Extensions/AStaricon24.png",
+                     "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .SetFunctionName("IsFollowingFlowField")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
     aut.AddCondition("PathFound",
                      _("Path found"),
                      _("Return true if a path has been found."),
@@ -67,6 +103,39 @@ void DeclarePathfindingBehaviorExtension(gd::PlatformExtension& extension) {
         .SetFunctionName("PathFound")
         .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
 
+    aut.AddCondition("PathPending",
+                     _("Path being computed"),
+                     _("Return true if the path is still being computed (when "
+                       "paths are computed over several frames)."),
+                     _("The path of _PARAM0_ is being computed"),
+                     "",
+                     "CppPlatform/Extensions/AStaricon24.png",
+                     "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .SetFunctionName("IsPathPending")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddAction("MaxNodesPerFrame",
+                  _("Path computation budget"),
+                  _("Change the maximum number of nodes explored at each frame "
+                    "to compute the paths of the objects of the scene. Paths "
+                    "are then computed over several frames, so that computing "
+                    "a lot of paths at once does not slow down the game. Use 0 "
+                    "to compute paths immediately (default)."),
+                  _("Explore at most _PARAM3_ nodes per frame to compute paths "
+                    "(_PARAM0_)"),
+                  "",
+                  "CppPlatform/Extensions/AStaricon24.png",
+                  "CppPlatform/Extensions/AStaricon16.png")
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .AddCodeOnlyParameter("currentScene", "")
+        .AddParameter("expression", _("Maximum number of nodes per frame"))
+        .SetFunctionName("SetMaxNodesPerFrame")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
     aut.AddCondition("DestinationReached",
                      _("Destination reached"),
                      _("Return true if the destination was reached."),
@@ -387,6 +456,98 @@ void DeclarePathfindingBehaviorExtension(gd::PlatformExtension& extension) {
         .SetFunctionName("DiagonalsAllowed")
         .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
 
+    aut.AddAction("Hierarchical",
+                  _("Fast computation of long paths"),
+                  _("Enable or disable the fast computation of long paths. "
+                    "Long paths are then computed on groups of cells: they "
+                    "are found a lot faster, but may be slightly longer than "
+                    "the shortest ones."),
+                  _("Enable fast computation of long paths for _PARAM0_: "
+                    "_PARAM2_"),
+                  _("Path"),
+                  "CppPlatform/Extensions/AStaricon24.png",
+                  "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .AddParameter("yesorno", _("Enable?"))
+        .SetFunctionName("SetHierarchical")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddCondition("IsHierarchical",
+                     _("Fast computation of long paths"),
+                     _("Return true if long paths are computed quickly for the "
+                       "object"),
+                     _("Fast computation of long paths enabled for _PARAM0_"),
+                     _("Path"),
+                     "CppPlatform/Extensions/AStaricon24.png",
+                     "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .SetFunctionName("IsHierarchical")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddAction("AnyAngle",
+                  _("Any angle paths"),
+                  _("Enable or disable any angle paths. The paths then go "
+                    "straight between the cells in sight of each other, "
+                    "instead of following the cells: they are shorter and "
+                    "have less nodes, but are a bit longer to compute."),
+                  _("Enable any angle paths for _PARAM0_: _PARAM2_"),
+                  _("Path"),
+                  "CppPlatform/Extensions/AStaricon24.png",
+                  "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .AddParameter("yesorno", _("Enable?"))
+        .SetFunctionName("SetAnyAngle")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddCondition("IsAnyAngle",
+                     _("Any angle paths"),
+                     _("Return true if any angle paths are computed for the "
+                       "object"),
+                     _("Any angle paths enabled for _PARAM0_"),
+                     _("Path"),
+                     "CppPlatform/Extensions/AStaricon24.png",
+                     "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .SetFunctionName("IsAnyAngle")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddAction("SmoothPath",
+                  _("Smooth the paths"),
+                  _("Enable or disable the smoothing of the paths. The nodes "
+                    "of the paths that can be skipped by going straight to "
+                    "the next ones are then removed."),
+                  _("Smooth the paths of _PARAM0_: _PARAM2_"),
+                  _("Path"),
+                  "CppPlatform/Extensions/AStaricon24.png",
+                  "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .AddParameter("yesorno", _("Enable?"))
+        .SetFunctionName("SetSmoothPath")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
+    aut.AddCondition("IsPathSmoothed",
+                     _("Smooth the paths"),
+                     _("Return true if the paths of the object are smoothed"),
+                     _("Paths of _PARAM0_ are smoothed"),
+                     _("Path"),
+                     "CppPlatform/Extensions/AStaricon24.png",
+                     "CppPlatform/Extensions/AStaricon16.png")
+
+        .AddParameter("object", _("Object"))
+        .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+        .SetFunctionName("IsPathSmoothed")
+        .SetIncludeFile("PathfindingBehavior/PathfindingRuntimeBehavior.h");
+
     aut.AddAction("RotateObject",
                   _("Rotate the object"),
                   _("Enable or disable rotation of the object on the path"),
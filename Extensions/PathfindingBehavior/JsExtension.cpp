@@ -43,6 +43,10 @@ class PathfindingBehaviorJsExtension : public gd::PlatformExtension {
           "pathFound");
       autActions["PathfindingBehavior::SetDestination"].SetFunctionName(
           "moveTo");
+      autActions["PathfindingBehavior::MoveWithFlowField"].SetFunctionName(
+          "moveWithFlowField");
+      autConditions["PathfindingBehavior::FollowingFlowField"]
+          .SetFunctionName("isFollowingFlowField");
       autConditions["PathfindingBehavior::DestinationReached"].SetFunctionName(
           "destinationReached");
       autActions["PathfindingBehavior::CellWidth"]
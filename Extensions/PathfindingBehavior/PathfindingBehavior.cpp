@@ -14,6 +14,9 @@ This project is released under the MIT License.
 void PathfindingBehavior::InitializeContent(
     gd::SerializerElement& behaviorContent) {
   behaviorContent.SetAttribute("allowDiagonals", true);
+  behaviorContent.SetAttribute("hierarchical", false);
+  behaviorContent.SetAttribute("anyAngle", false);
+  behaviorContent.SetAttribute("smoothPath", false);
   behaviorContent.SetAttribute("acceleration", 400);
   behaviorContent.SetAttribute("maxSpeed", 200);
   behaviorContent.SetAttribute("angularMaxSpeed", 180);
@@ -33,6 +36,20 @@ std::map<gd::String, gd::PropertyDescriptor> PathfindingBehavior::GetProperties(
       .SetValue(behaviorContent.GetBoolAttribute("allowDiagonals") ? "true"
                                                                    : "false")
       .SetType("Boolean");
+  properties[_("Fast computation of long paths")]
+      .SetValue(behaviorContent.GetBoolAttribute("hierarchical", false)
+                    ? "true"
+                    : "false")
+      .SetType("Boolean");
+  properties[_("Any angle paths")]
+      .SetValue(behaviorContent.GetBoolAttribute("anyAngle", false) ? "true"
+                                                                    : "false")
+      .SetType("Boolean");
+  properties[_("Smooth the paths")]
+      .SetValue(behaviorContent.GetBoolAttribute("smoothPath", false)
+                    ? "true"
+                    : "false")
+      .SetType("Boolean");
   properties[_("Acceleration")].SetValue(
       gd::String::From(behaviorContent.GetDoubleAttribute("acceleration")));
   properties[_("Max. speed")].SetValue(
@@ -63,6 +80,18 @@ bool PathfindingBehavior::UpdateProperty(gd::SerializerElement& behaviorContent,
     behaviorContent.SetAttribute("allowDiagonals", (value != "0"));
     return true;
   }
+  if (name == _("Fast computation of long paths")) {
+    behaviorContent.SetAttribute("hierarchical", (value != "0"));
+    return true;
+  }
+  if (name == _("Any angle paths")) {
+    behaviorContent.SetAttribute("anyAngle", (value != "0"));
+    return true;
+  }
+  if (name == _("Smooth the paths")) {
+    behaviorContent.SetAttribute("smoothPath", (value != "0"));
+    return true;
+  }
   if (name == _("Rotate object")) {
     behaviorContent.SetAttribute("rotateObject", (value != "0"));
     return true;
@@ -0,0 +1,122 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingFlowField.h"
+#include <cstddef>
+#include "PathfindingObstaclesGrid.h"
+
+const std::size_t PathfindingFlowField::maxSettledCells = 256 * 256;
+const float PathfindingFlowField::sqrt2 = 1.414213562;
+
+PathfindingFlowField::PathfindingFlowField(const PathfindingObstaclesGrid& grid_,
+                                           const sf::Vector2i& goal_,
+                                           bool allowDiagonals_)
+    : grid(grid_),
+      goal(goal_),
+      allowDiagonals(allowDiagonals_),
+      settledCount(0) {
+  if (grid.GetCost(goal.x, goal.y) < 0) return;  // The goal can't be reached.
+
+  FieldCell& goalCell = cells[GetKey(goal.x, goal.y)];
+  goalCell.distance = 0;
+  goalCell.next = goal;
+  openCells.push(OpenCell(0, goal));
+}
+
+bool PathfindingFlowField::GetNextCell(const sf::Vector2i& cell,
+                                       sf::Vector2i& nextCell) {
+  if (grid.GetCost(cell.x, cell.y) < 0) {
+    // Get out of the impassable cell by the cell closest to the goal.
+    float bestDistance = -1;
+    for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+      for (int offsetY = -1; offsetY <= 1; ++offsetY) {
+        if (offsetX == 0 && offsetY == 0) continue;
+        if (!allowDiagonals && offsetX != 0 && offsetY != 0) continue;
+
+        sf::Vector2i neighbor(cell.x + offsetX, cell.y + offsetY);
+        float distance = GetDistance(neighbor);
+        if (distance >= 0 && (bestDistance < 0 || distance < bestDistance)) {
+          bestDistance = distance;
+          nextCell = neighbor;
+        }
+      }
+    }
+
+    return bestDistance >= 0;
+  }
+
+  const FieldCell* fieldCell = Settle(cell);
+  if (!fieldCell) return false;
+
+  nextCell = fieldCell->next;
+  return true;
+}
+
+float PathfindingFlowField::GetDistance(const sf::Vector2i& cell) {
+  if (grid.GetCost(cell.x, cell.y) < 0) return -1;
+
+  const FieldCell* fieldCell = Settle(cell);
+  return fieldCell ? fieldCell->distance : -1;
+}
+
+const PathfindingFlowField::FieldCell* PathfindingFlowField::Settle(
+    const sf::Vector2i& cell) {
+  auto it = cells.find(GetKey(cell.x, cell.y));
+  if (it != cells.end() && it->second.settled) return &it->second;
+
+  // Continue the search until the cell is reached (note that references to
+  // the elements of an unordered_map stay valid when it grows).
+  while (!openCells.empty() && settledCount < maxSettledCells) {
+    OpenCell openCell = openCells.top();
+    openCells.pop();
+
+    FieldCell& fieldCell = cells[GetKey(openCell.second.x, openCell.second.y)];
+    if (fieldCell.settled || openCell.first > fieldCell.distance)
+      continue;  // Outdated entry, the cell was reached by a shorter path.
+
+    fieldCell.settled = true;
+    settledCount++;
+
+    const sf::Vector2i& from = openCell.second;
+    float fromCost = grid.GetCost(from.x, from.y);
+    ExploreNeighbor(from, fromCost, fieldCell.distance, 1, 0, 1);
+    ExploreNeighbor(from, fromCost, fieldCell.distance, -1, 0, 1);
+    ExploreNeighbor(from, fromCost, fieldCell.distance, 0, 1, 1);
+    ExploreNeighbor(from, fromCost, fieldCell.distance, 0, -1, 1);
+    if (allowDiagonals) {
+      ExploreNeighbor(from, fromCost, fieldCell.distance, 1, 1, sqrt2);
+      ExploreNeighbor(from, fromCost, fieldCell.distance, 1, -1, sqrt2);
+      ExploreNeighbor(from, fromCost, fieldCell.distance, -1, -1, sqrt2);
+      ExploreNeighbor(from, fromCost, fieldCell.distance, -1, 1, sqrt2);
+    }
+
+    if (from == cell) return &fieldCell;
+  }
+
+  return NULL;
+}
+
+void PathfindingFlowField::ExploreNeighbor(const sf::Vector2i& from,
+                                           float fromCost,
+                                           float fromDistance,
+                                           int offsetX,
+                                           int offsetY,
+                                           float factor) {
+  sf::Vector2i to(from.x + offsetX, from.y + offsetY);
+  float toCost = grid.GetCost(to.x, to.y);
+  if (toCost < 0) return;  // Impassable obstacle
+
+  FieldCell& fieldCell = cells[GetKey(to.x, to.y)];
+  if (fieldCell.settled) return;
+
+  // Costs are the same as the ones used by A* (see SearchContext).
+  float distance = fromDistance + (fromCost + toCost) / 2.0 * factor;
+  if (fieldCell.distance == -1 || distance < fieldCell.distance) {
+    fieldCell.distance = distance;
+    fieldCell.next = from;
+    openCells.push(OpenCell(distance, to));
+  }
+}
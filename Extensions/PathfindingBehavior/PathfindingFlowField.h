@@ -0,0 +1,94 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGFLOWFIELD_H
+#define PATHFINDINGFLOWFIELD_H
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+class PathfindingObstaclesGrid;
+
+/**
+ * \brief The cost of the shortest path from each cell of a
+ * PathfindingObstaclesGrid to a goal cell, and the direction to follow to get
+ * closer to the goal.
+ *
+ * The field is shared by all the objects moving to the same goal: it is
+ * computed with a Dijkstra search started from the goal, which is only
+ * continued when an object asks for a cell not explored yet.
+ *
+ * \see PathfindingObstaclesGrid::GetFlowField
+ */
+class PathfindingFlowField {
+ public:
+  PathfindingFlowField(const PathfindingObstaclesGrid& grid,
+                       const sf::Vector2i& goal,
+                       bool allowDiagonals);
+  virtual ~PathfindingFlowField(){};
+
+  /**
+   * \brief Get the cell to move to from the specified cell to get closer to
+   * the goal.
+   *
+   * If the cell is impassable, the best cell around it is returned.
+   * \param nextCell Filled with the next cell (the goal itself if \a cell is
+   * the goal).
+   * \return false if the goal can't be reached from the cell.
+   */
+  bool GetNextCell(const sf::Vector2i& cell, sf::Vector2i& nextCell);
+
+  /**
+   * \brief Get the cost of the shortest path from the cell to the goal.
+   * \return -1 if the goal can't be reached from the cell.
+   */
+  float GetDistance(const sf::Vector2i& cell);
+
+ private:
+  struct FieldCell {
+    FieldCell() : distance(-1), settled(false){};
+
+    float distance;  ///< The smallest cost found so far (-1 if none).
+    sf::Vector2i next;  ///< The cell to move to from this cell.
+    bool settled;       ///< True if distance is the cost of the shortest path.
+  };
+  typedef std::pair<float, sf::Vector2i> OpenCell;
+  struct OpenCellComparator {
+    bool operator()(const OpenCell& a, const OpenCell& b) const {
+      return a.first > b.first;
+    }
+  };
+
+  const FieldCell* Settle(const sf::Vector2i& cell);
+  void ExploreNeighbor(const sf::Vector2i& from,
+                       float fromCost,
+                       float fromDistance,
+                       int offsetX,
+                       int offsetY,
+                       float factor);
+  static std::int64_t GetKey(int x, int y) {
+    return static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)));
+  }
+
+  const PathfindingObstaclesGrid& grid;
+  sf::Vector2i goal;
+  bool allowDiagonals;
+  std::unordered_map<std::int64_t, FieldCell>
+      cells;  ///< The cells explored so far.
+  std::priority_queue<OpenCell, std::vector<OpenCell>, OpenCellComparator>
+      openCells;  ///< The cells to explore, possibly with outdated distances.
+  std::size_t settledCount;
+
+  static const std::size_t maxSettledCells;  ///< The maximum number of cells
+                                             ///< explored by a field.
+  static const float sqrt2;
+};
+
+#endif  // PATHFINDINGFLOWFIELD_H
@@ -0,0 +1,442 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingHierarchicalGraph.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include "PathfindingObstaclesGrid.h"
+
+namespace {
+const float sqrt2 = 1.414213562;
+
+/**
+ * \brief Internal tool class: an entry of the open lists of the searches,
+ * ordered by estimate cost (and then by insertion order).
+ */
+struct OpenEntry {
+  OpenEntry(float estimateCost_, std::size_t order_, float cost_, int index_)
+      : estimateCost(estimateCost_), order(order_), cost(cost_), index(index_){};
+
+  float estimateCost;
+  std::size_t order;
+  float cost;  ///< The cost to reach the node when the entry was added.
+  int index;
+
+  bool operator>(const OpenEntry& other) const {
+    return estimateCost > other.estimateCost ||
+           (estimateCost == other.estimateCost && order > other.order);
+  }
+};
+
+typedef std::priority_queue<OpenEntry,
+                            std::vector<OpenEntry>,
+                            std::greater<OpenEntry>>
+    OpenList;
+}  // namespace
+
+PathfindingHierarchicalGraph::PathfindingHierarchicalGraph(
+    const PathfindingObstaclesGrid& grid_, bool allowDiagonals_)
+    : grid(grid_), allowDiagonals(allowDiagonals_) {}
+
+float PathfindingHierarchicalGraph::GetTransitionCost(const sf::Vector2i& a,
+                                                      float aCost,
+                                                      const sf::Vector2i& b,
+                                                      float bCost) const {
+  float factor = (a.x != b.x && a.y != b.y) ? sqrt2 : 1;
+  return (aCost + bCost) / 2.0 * factor;
+}
+
+float PathfindingHierarchicalGraph::GetDistance(const sf::Vector2i& a,
+                                                const sf::Vector2i& b) const {
+  float dx = a.x - b.x;
+  float dy = a.y - b.y;
+  return allowDiagonals ? std::sqrt(dx * dx + dy * dy)
+                        : std::abs(dx) + std::abs(dy);
+}
+
+PathfindingHierarchicalGraph::Cluster& PathfindingHierarchicalGraph::GetCluster(
+    int clusterX, int clusterY) {
+  std::int64_t key = GetKey(clusterX, clusterY);
+  auto it = clusters.find(key);
+  if (it != clusters.end()) return it->second;
+
+  Cluster& cluster = clusters[key];
+  BuildCluster(cluster, clusterX, clusterY);
+  return cluster;
+}
+
+void PathfindingHierarchicalGraph::BuildCluster(Cluster& cluster,
+                                                int clusterX,
+                                                int clusterY) {
+  int originX = clusterX * clusterSize;
+  int originY = clusterY * clusterSize;
+  for (int y = 0; y < clusterSize; ++y)
+    for (int x = 0; x < clusterSize; ++x)
+      cluster.costs[y * clusterSize + x] =
+          grid.GetCost(originX + x, originY + y);
+
+  // Find the entrances on each border. The same cells are found when building
+  // the cluster on the other side, so that entrances are connected.
+  int last = clusterSize - 1;
+  cluster.entrances.clear();
+  AddBorderEntrances(cluster,
+                     sf::Vector2i(originX, originY),
+                     sf::Vector2i(0, 1),
+                     sf::Vector2i(-1, 0));
+  AddBorderEntrances(cluster,
+                     sf::Vector2i(originX + last, originY),
+                     sf::Vector2i(0, 1),
+                     sf::Vector2i(1, 0));
+  AddBorderEntrances(cluster,
+                     sf::Vector2i(originX, originY),
+                     sf::Vector2i(1, 0),
+                     sf::Vector2i(0, -1));
+  AddBorderEntrances(cluster,
+                     sf::Vector2i(originX, originY + last),
+                     sf::Vector2i(1, 0),
+                     sf::Vector2i(0, 1));
+
+  // Compute the paths between the entrances, inside the cluster.
+  std::size_t count = cluster.entrances.size();
+  cluster.distances.assign(count * count, -1);
+  for (std::size_t i = 0; i < count; ++i) {
+    SearchInCluster(
+        cluster, clusterX, clusterY, cluster.entrances[i].cell, search);
+    for (std::size_t j = 0; j < count; ++j) {
+      const sf::Vector2i& cell = cluster.entrances[j].cell;
+      cluster.distances[i * count + j] =
+          search.distances[(cell.y - originY) * clusterSize +
+                           (cell.x - originX)];
+    }
+  }
+}
+
+void PathfindingHierarchicalGraph::AddBorderEntrances(
+    Cluster& cluster,
+    const sf::Vector2i& first,
+    const sf::Vector2i& along,
+    const sf::Vector2i& across) {
+  int originX = GetClusterCoordinate(first.x) * clusterSize;
+  int originY = GetClusterCoordinate(first.y) * clusterSize;
+
+  auto addEntrance = [&](int i) {
+    sf::Vector2i cell = first + along * i;
+    sf::Vector2i neighbor = cell + across;
+    for (Entrance& entrance : cluster.entrances) {
+      if (entrance.cell == cell) {  // Corner cell, already an entrance.
+        entrance.neighbors.push_back(neighbor);
+        return;
+      }
+    }
+
+    Entrance entrance;
+    entrance.cell = cell;
+    entrance.neighbors.push_back(neighbor);
+    cluster.entrances.push_back(entrance);
+  };
+
+  // Entrances are made on each run of cells that are passable on both sides:
+  // one in the middle of short runs, two at the ends of long runs.
+  int runStart = -1;
+  for (int i = 0; i <= clusterSize; ++i) {
+    bool passable = false;
+    if (i < clusterSize) {
+      sf::Vector2i cell = first + along * i;
+      sf::Vector2i neighbor = cell + across;
+      passable = cluster.costs[(cell.y - originY) * clusterSize +
+                               (cell.x - originX)] >= 0 &&
+                 grid.GetCost(neighbor.x, neighbor.y) >= 0;
+    }
+
+    if (passable && runStart == -1) {
+      runStart = i;
+    } else if (!passable && runStart != -1) {
+      int runEnd = i - 1;
+      if (runEnd - runStart + 1 <= 6) {
+        addEntrance((runStart + runEnd) / 2);
+      } else {
+        addEntrance(runStart);
+        addEntrance(runEnd);
+      }
+      runStart = -1;
+    }
+  }
+}
+
+void PathfindingHierarchicalGraph::SearchInCluster(const Cluster& cluster,
+                                                   int clusterX,
+                                                   int clusterY,
+                                                   const sf::Vector2i& source,
+                                                   ClusterSearch& result) const {
+  int originX = clusterX * clusterSize;
+  int originY = clusterY * clusterSize;
+  for (int i = 0; i < clusterSize * clusterSize; ++i) {
+    result.distances[i] = -1;
+    result.parents[i] = -1;
+  }
+
+  int sourceIndex = (source.y - originY) * clusterSize + (source.x - originX);
+  result.distances[sourceIndex] = 0;
+
+  std::size_t order = 0;
+  OpenList openList;
+  openList.push(OpenEntry(0, order++, 0, sourceIndex));
+  while (!openList.empty()) {
+    OpenEntry entry = openList.top();
+    openList.pop();
+    if (entry.cost > result.distances[entry.index]) continue;  // Outdated.
+
+    sf::Vector2i cell(originX + entry.index % clusterSize,
+                      originY + entry.index / clusterSize);
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx == 0 && dy == 0) continue;
+        if (!allowDiagonals && dx != 0 && dy != 0) continue;
+
+        int x = entry.index % clusterSize + dx;
+        int y = entry.index / clusterSize + dy;
+        if (x < 0 || x >= clusterSize || y < 0 || y >= clusterSize) continue;
+
+        int index = y * clusterSize + x;
+        if (cluster.costs[index] < 0) continue;  // Impassable
+
+        float cost = entry.cost + GetTransitionCost(cell,
+                                                    cluster.costs[entry.index],
+                                                    cell + sf::Vector2i(dx, dy),
+                                                    cluster.costs[index]);
+        if (result.distances[index] < 0 || cost < result.distances[index]) {
+          result.distances[index] = cost;
+          result.parents[index] = entry.index;
+          openList.push(OpenEntry(cost, order++, cost, index));
+        }
+      }
+    }
+  }
+}
+
+bool PathfindingHierarchicalGraph::AddPathInCluster(
+    const sf::Vector2i& from,
+    const sf::Vector2i& to,
+    std::vector<sf::Vector2i>& path) {
+  int clusterX = GetClusterCoordinate(from.x);
+  int clusterY = GetClusterCoordinate(from.y);
+  int originX = clusterX * clusterSize;
+  int originY = clusterY * clusterSize;
+  SearchInCluster(GetCluster(clusterX, clusterY), clusterX, clusterY, from,
+                  search);
+
+  int index = (to.y - originY) * clusterSize + (to.x - originX);
+  if (search.distances[index] < 0) return false;
+
+  std::size_t firstAddedCell = path.size();
+  while (search.parents[index] != -1) {
+    path.push_back(sf::Vector2i(originX + index % clusterSize,
+                                originY + index / clusterSize));
+    index = search.parents[index];
+  }
+
+  std::reverse(path.begin() + firstAddedCell, path.end());
+  return true;
+}
+
+bool PathfindingHierarchicalGraph::ComputePath(
+    const sf::Vector2i& start,
+    const sf::Vector2i& goal,
+    std::size_t maxExpandedNodes,
+    std::vector<sf::Vector2i>& path) {
+  path.clear();
+  path.push_back(start);
+
+  int startClusterX = GetClusterCoordinate(start.x);
+  int startClusterY = GetClusterCoordinate(start.y);
+  int goalClusterX = GetClusterCoordinate(goal.x);
+  int goalClusterY = GetClusterCoordinate(goal.y);
+  if (startClusterX == goalClusterX && startClusterY == goalClusterY)
+    return AddPathInCluster(start, goal, path);
+
+  // Compute the costs from the start to the entrances of its cluster, and
+  // from the entrances of the goal cluster to the goal.
+  auto getEntrancesDistances = [this](int clusterX,
+                                      int clusterY,
+                                      const sf::Vector2i& cell,
+                                      std::vector<float>& distances) {
+    const Cluster& cluster = GetCluster(clusterX, clusterY);
+    SearchInCluster(cluster, clusterX, clusterY, cell, search);
+    distances.clear();
+    for (const Entrance& entrance : cluster.entrances) {
+      distances.push_back(
+          search.distances[(entrance.cell.y - clusterY * clusterSize) *
+                               clusterSize +
+                           (entrance.cell.x - clusterX * clusterSize)]);
+    }
+  };
+  std::vector<float> startDistances;
+  std::vector<float> goalDistances;
+  getEntrancesDistances(startClusterX, startClusterY, start, startDistances);
+  getEntrancesDistances(goalClusterX, goalClusterY, goal, goalDistances);
+
+  // Search a path between the entrances of the clusters.
+  struct AbstractNode {
+    sf::Vector2i cell;
+    float smallestCost;
+    int parent;  ///< -1 for the entrances reached from the start.
+    bool closed;
+  };
+  std::vector<AbstractNode> nodes;
+  std::unordered_map<std::int64_t, int> nodesIndices;
+  OpenList openList;
+  std::size_t order = 0;
+  const int goalIndex = -1;
+  float goalCost = -1;
+  int goalParent = -1;
+
+  auto addOrUpdateNode = [&](const sf::Vector2i& cell, float cost, int parent) {
+    std::int64_t key = GetKey(cell.x, cell.y);
+    auto it = nodesIndices.find(key);
+    int index = 0;
+    if (it == nodesIndices.end()) {
+      index = nodes.size();
+      nodesIndices[key] = index;
+      AbstractNode node = {cell, -1, -1, false};
+      nodes.push_back(node);
+    } else {
+      index = it->second;
+    }
+
+    AbstractNode& node = nodes[index];
+    if (node.closed) return;
+    if (node.smallestCost >= 0 && node.smallestCost <= cost) return;
+
+    node.smallestCost = cost;
+    node.parent = parent;
+    openList.push(
+        OpenEntry(cost + GetDistance(cell, goal), order++, cost, index));
+  };
+
+  const Cluster& startCluster = GetCluster(startClusterX, startClusterY);
+  for (std::size_t i = 0; i < startCluster.entrances.size(); ++i)
+    if (startDistances[i] >= 0)
+      addOrUpdateNode(startCluster.entrances[i].cell, startDistances[i], -1);
+
+  std::size_t expandedNodes = 0;
+  while (!openList.empty() && expandedNodes < maxExpandedNodes) {
+    OpenEntry entry = openList.top();
+    openList.pop();
+    if (entry.index == goalIndex) {
+      if (entry.cost == goalCost) break;  // The goal is reached.
+      continue;
+    }
+
+    AbstractNode& node = nodes[entry.index];
+    if (node.closed || entry.cost > node.smallestCost) continue;  // Outdated.
+    node.closed = true;
+    expandedNodes++;
+
+    int currentIndex = entry.index;
+    sf::Vector2i cell = node.cell;
+    float cost = node.smallestCost;
+    int clusterX = GetClusterCoordinate(cell.x);
+    int clusterY = GetClusterCoordinate(cell.y);
+    const Cluster& cluster = GetCluster(clusterX, clusterY);
+
+    std::size_t count = cluster.entrances.size();
+    std::size_t entranceIndex = 0;
+    while (entranceIndex < count &&
+           cluster.entrances[entranceIndex].cell != cell)
+      entranceIndex++;
+    if (entranceIndex == count) continue;  // Should not happen.
+
+    if (clusterX == goalClusterX && clusterY == goalClusterY &&
+        goalDistances[entranceIndex] >= 0) {
+      float newGoalCost = cost + goalDistances[entranceIndex];
+      if (goalCost < 0 || newGoalCost < goalCost) {
+        goalCost = newGoalCost;
+        goalParent = currentIndex;
+        openList.push(OpenEntry(goalCost, order++, goalCost, goalIndex));
+      }
+    }
+
+    // Go to the other entrances of the cluster...
+    for (std::size_t i = 0; i < count; ++i) {
+      float distance = cluster.distances[entranceIndex * count + i];
+      if (i != entranceIndex && distance >= 0)
+        addOrUpdateNode(
+            cluster.entrances[i].cell, cost + distance, currentIndex);
+    }
+
+    // ...or to the adjacent clusters.
+    float cellCost =
+        cluster.costs[(cell.y - clusterY * clusterSize) * clusterSize +
+                      (cell.x - clusterX * clusterSize)];
+    for (const sf::Vector2i& neighbor :
+         cluster.entrances[entranceIndex].neighbors) {
+      addOrUpdateNode(
+          neighbor,
+          cost + GetTransitionCost(cell,
+                                   cellCost,
+                                   neighbor,
+                                   grid.GetCost(neighbor.x, neighbor.y)),
+          currentIndex);
+    }
+  }
+
+  if (goalParent == -1) return false;
+
+  // Refine the path on the entrances into a path of cells.
+  std::vector<sf::Vector2i> entrancesPath;
+  entrancesPath.push_back(goal);
+  for (int index = goalParent; index != -1; index = nodes[index].parent)
+    entrancesPath.push_back(nodes[index].cell);
+  std::reverse(entrancesPath.begin(), entrancesPath.end());
+
+  sf::Vector2i previous = start;
+  for (const sf::Vector2i& cell : entrancesPath) {
+    if (GetClusterCoordinate(previous.x) == GetClusterCoordinate(cell.x) &&
+        GetClusterCoordinate(previous.y) == GetClusterCoordinate(cell.y)) {
+      if (!AddPathInCluster(previous, cell, path)) return false;
+    } else {
+      path.push_back(cell);  // Moving from a cluster to the next one.
+    }
+
+    previous = cell;
+  }
+
+  return true;
+}
+
+void PathfindingHierarchicalGraph::InvalidateCells(double minX,
+                                                   double minY,
+                                                   double maxX,
+                                                   double maxY) {
+  // Entrances depend on the cells on both sides of the borders: also
+  // invalidate the adjacent clusters if the cells are on a border.
+  double minClusterX = std::floor((minX - 1) / clusterSize);
+  double minClusterY = std::floor((minY - 1) / clusterSize);
+  double maxClusterX = std::floor((maxX + 1) / clusterSize);
+  double maxClusterY = std::floor((maxY + 1) / clusterSize);
+
+  if ((maxClusterX - minClusterX + 1) * (maxClusterY - minClusterY + 1) >
+      clusters.size()) {
+    for (auto it = clusters.begin(); it != clusters.end();) {
+      int clusterX = static_cast<std::int32_t>(
+          static_cast<std::uint64_t>(it->first) >> 32);
+      int clusterY = static_cast<std::int32_t>(
+          static_cast<std::uint64_t>(it->first) & 0xFFFFFFFF);
+      if (minClusterX <= clusterX && clusterX <= maxClusterX &&
+          minClusterY <= clusterY && clusterY <= maxClusterY)
+        it = clusters.erase(it);
+      else
+        ++it;
+    }
+    return;
+  }
+
+  for (int x = minClusterX; x <= maxClusterX; ++x)
+    for (int y = minClusterY; y <= maxClusterY; ++y)
+      clusters.erase(GetKey(x, y));
+}
@@ -0,0 +1,123 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGHIERARCHICALGRAPH_H
+#define PATHFINDINGHIERARCHICALGRAPH_H
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+class PathfindingObstaclesGrid;
+
+/**
+ * \brief An abstraction of the cells of a PathfindingObstaclesGrid, used to
+ * compute long paths quickly ("Hierarchical Path-Finding A*").
+ *
+ * The grid is divided into square clusters of cells. The entrances between
+ * adjacent clusters, and the costs of the paths between the entrances of a
+ * cluster, are computed the first time the cluster is used. They are computed
+ * again only when cells of the cluster changed. A path is searched between the
+ * entrances, then refined into a path of cells, cluster by cluster.
+ *
+ * \note The paths found are close to, but not always exactly, the shortest
+ * ones.
+ */
+class PathfindingHierarchicalGraph {
+ public:
+  PathfindingHierarchicalGraph(const PathfindingObstaclesGrid& grid,
+                               bool allowDiagonals);
+  virtual ~PathfindingHierarchicalGraph(){};
+
+  /**
+   * \brief Compute a path between two cells.
+   * \param maxExpandedNodes The maximum number of entrances explored before
+   * giving up.
+   * \param path Filled with the cells of the path, start and goal included.
+   * \return true if a path was found.
+   */
+  bool ComputePath(const sf::Vector2i& start,
+                   const sf::Vector2i& goal,
+                   std::size_t maxExpandedNodes,
+                   std::vector<sf::Vector2i>& path);
+
+  /**
+   * \brief Notify the graph that the cost of the specified cells (bounds
+   * included) changed.
+   */
+  void InvalidateCells(double minX, double minY, double maxX, double maxY);
+
+  /**
+   * \brief Notify the graph that the cost of any cell may have changed.
+   */
+  void InvalidateAll() { clusters.clear(); }
+
+  static const int clusterSize = 16;  ///< The size of a cluster, in cells.
+
+ private:
+  /**
+   * \brief A cell on the border of a cluster from which an adjacent cluster
+   * can be entered.
+   */
+  struct Entrance {
+    sf::Vector2i cell;
+    std::vector<sf::Vector2i> neighbors;  ///< The entrances on the other side
+                                          ///< of the borders.
+  };
+
+  struct Cluster {
+    float costs[clusterSize * clusterSize];  ///< The costs of the cells.
+    std::vector<Entrance> entrances;
+    std::vector<float> distances;  ///< The cost of the shortest path, inside
+                                   ///< the cluster, from each entrance to each
+                                   ///< other entrance (-1 if none).
+  };
+
+  /**
+   * \brief The result of a search of paths inside a cluster.
+   */
+  struct ClusterSearch {
+    float distances[clusterSize * clusterSize];  ///< -1 for unreachable cells.
+    int parents[clusterSize * clusterSize];      ///< -1 for the source cell.
+  };
+
+  Cluster& GetCluster(int clusterX, int clusterY);
+  void BuildCluster(Cluster& cluster, int clusterX, int clusterY);
+  void AddBorderEntrances(Cluster& cluster,
+                          const sf::Vector2i& first,
+                          const sf::Vector2i& along,
+                          const sf::Vector2i& across);
+  void SearchInCluster(const Cluster& cluster,
+                       int clusterX,
+                       int clusterY,
+                       const sf::Vector2i& source,
+                       ClusterSearch& result) const;
+  bool AddPathInCluster(const sf::Vector2i& from,
+                        const sf::Vector2i& to,
+                        std::vector<sf::Vector2i>& path);
+  float GetTransitionCost(const sf::Vector2i& a,
+                          float aCost,
+                          const sf::Vector2i& b,
+                          float bCost) const;
+  float GetDistance(const sf::Vector2i& a, const sf::Vector2i& b) const;
+
+  static int GetClusterCoordinate(int cellCoordinate) {
+    return cellCoordinate >= 0 ? cellCoordinate / clusterSize
+                               : (cellCoordinate + 1) / clusterSize - 1;
+  }
+  static std::int64_t GetKey(int x, int y) {
+    return static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)));
+  }
+
+  const PathfindingObstaclesGrid& grid;
+  bool allowDiagonals;
+  std::unordered_map<std::int64_t, Cluster>
+      clusters;  ///< The clusters built so far.
+  ClusterSearch search;  ///< Reused by the searches inside clusters.
+};
+
+#endif  // PATHFINDINGHIERARCHICALGRAPH_H
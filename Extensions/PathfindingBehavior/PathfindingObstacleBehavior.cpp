@@ -13,6 +13,7 @@ void PathfindingObstacleBehavior::InitializeContent(
     gd::SerializerElement& behaviorContent) {
   behaviorContent.SetAttribute("impassable", true);
   behaviorContent.SetAttribute("cost", 2);
+  behaviorContent.SetAttribute("static", false);
 }
 
 #if defined(GD_IDE_ONLY)
@@ -26,6 +27,10 @@ PathfindingObstacleBehavior::GetProperties(
       .SetType("Boolean");
   properties[_("Cost (if not impassable)")].SetValue(
       gd::String::From(behaviorContent.GetDoubleAttribute("cost")));
+  properties[_("Static (never moved nor changed)")]
+      .SetValue(behaviorContent.GetBoolAttribute("static", false) ? "true"
+                                                                  : "false")
+      .SetType("Boolean");
 
   return properties;
 }
@@ -39,6 +44,10 @@ bool PathfindingObstacleBehavior::UpdateProperty(
     behaviorContent.SetAttribute("impassable", (value != "0"));
     return true;
   }
+  if (name == _("Static (never moved nor changed)")) {
+    behaviorContent.SetAttribute("static", (value != "0"));
+    return true;
+  }
 
   if (value.To<float>() < 0) return false;
 
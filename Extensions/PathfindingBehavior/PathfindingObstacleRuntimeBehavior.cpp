@@ -26,9 +26,11 @@ PathfindingObstacleRuntimeBehavior::PathfindingObstacleRuntimeBehavior(
       sceneManager(NULL),
       registeredInManager(false),
       impassable(true),
-      cost(2) {
+      cost(2),
+      isStatic(false) {
   impassable = behaviorContent.GetBoolAttribute("impassable");
   cost = behaviorContent.GetDoubleAttribute("cost");
+  isStatic = behaviorContent.GetBoolAttribute("static", false);
 }
 
 PathfindingObstacleRuntimeBehavior::~PathfindingObstacleRuntimeBehavior() {
@@ -42,9 +44,10 @@ void PathfindingObstacleRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       sceneManager->RemoveObstacle(this);
 
     parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
+    sceneManager =
+        parentScene
+            ? &scene.GetExtensionData<ScenePathfindingObstaclesManager>()
+            : NULL;
     registeredInManager = false;
   }
 
@@ -57,6 +60,9 @@ void PathfindingObstacleRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       registeredInManager = true;
     }
   }
+
+  // Static obstacles moved or changed anyway are updated at the next frame.
+  if (isStatic && registeredInManager) sceneManager->UpdateStaticObstacle(this);
 }
 
 void PathfindingObstacleRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
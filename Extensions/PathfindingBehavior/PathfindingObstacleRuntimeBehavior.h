@@ -52,6 +52,14 @@ class GD_EXTENSION_API PathfindingObstacleRuntimeBehavior : public RuntimeBehavi
    */
   void SetCost(float newCost) { cost = newCost; }
 
+  /**
+   * \brief Return true if the obstacle is not expected to move or change.
+   *
+   * Static obstacles are only checked for changes once per frame, instead of
+   * each time a path is computed.
+   */
+  bool IsStatic() const { return isStatic; }
+
  private:
   virtual void OnActivate();
   virtual void OnDeActivate();
@@ -67,6 +75,7 @@ class GD_EXTENSION_API PathfindingObstacleRuntimeBehavior : public RuntimeBehavi
   bool impassable;
   float cost;  ///< The cost of moving on the obstacle (for when impassable ==
                ///< false)
+  bool isStatic;  ///< True if the obstacle is not expected to move or change.
 };
 
 #endif  // PATHFINDINGOBSTACLERUNTIMEBEHAVIOR_H
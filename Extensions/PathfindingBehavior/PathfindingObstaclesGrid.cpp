@@ -0,0 +1,313 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingObstaclesGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "PathfindingFlowField.h"
+#include "PathfindingHierarchicalGraph.h"
+#include "PathfindingObstacleRuntimeBehavior.h"
+
+const double PathfindingObstaclesGrid::maxCellsPerObstacle = 4096;
+const std::size_t PathfindingObstaclesGrid::maxCachedPathsCount = 256;
+const std::size_t PathfindingObstaclesGrid::maxFlowFieldsCount = 16;
+std::size_t PathfindingObstaclesGrid::lastVersion = 0;
+
+PathfindingObstaclesGrid::PathfindingObstaclesGrid(float cellWidth_,
+                                                   float cellHeight_,
+                                                   float leftBorder_,
+                                                   float topBorder_,
+                                                   float rightBorder_,
+                                                   float bottomBorder_)
+    : lastUseId(0),
+      cellWidth(cellWidth_),
+      cellHeight(cellHeight_),
+      leftBorder(leftBorder_),
+      topBorder(topBorder_),
+      rightBorder(rightBorder_),
+      bottomBorder(bottomBorder_),
+      version(++lastVersion) {}
+
+PathfindingObstaclesGrid::~PathfindingObstaclesGrid() {}
+
+PathfindingObstaclesGrid::ObstacleArea PathfindingObstaclesGrid::ComputeArea(
+    const PathfindingObstacleRuntimeBehavior* obstacle) const {
+  RuntimeObject* obj = obstacle->GetObject();
+
+  // An obstacle covers the cells strictly between these bounds (it is
+  // enlarged by the borders of the object moving on the grid).
+  ObstacleArea area;
+  area.minX =
+      std::floor((obj->GetDrawableX() - rightBorder) / (float)cellWidth) + 1;
+  area.minY =
+      std::floor((obj->GetDrawableY() - bottomBorder) / (float)cellHeight) + 1;
+  area.maxX = std::ceil((obj->GetDrawableX() + obj->GetWidth() + leftBorder) /
+                        (float)cellWidth) -
+              1;
+  area.maxY = std::ceil((obj->GetDrawableY() + obj->GetHeight() + topBorder) /
+                        (float)cellHeight) -
+              1;
+  area.cost = obstacle->GetCost();
+  area.impassable = obstacle->IsImpassable();
+
+  // Compare using doubles to avoid overflows with huge or far away obstacles
+  // (the comparison is also false for NaN or infinite values).
+  area.isLarge =
+      area.minX <= area.maxX && area.minY <= area.maxY &&
+      (!((area.maxX - area.minX + 1) * (area.maxY - area.minY + 1) <=
+         maxCellsPerObstacle) ||
+       std::abs(area.minX) > 1e9 || std::abs(area.minY) > 1e9);
+  return area;
+}
+
+void PathfindingObstaclesGrid::OnCellsChanged(const ObstacleArea& area) {
+  if (!area.isLarge && (area.minX > area.maxX || area.minY > area.maxY))
+    return;  // No cells covered.
+
+  version = ++lastVersion;
+  cachedPaths.clear();
+  for (auto& fields : flowFields) fields.clear();
+  for (auto& graph : hierarchicalGraphs) {
+    if (!graph) continue;
+
+    if (area.isLarge)
+      graph->InvalidateAll();
+    else
+      graph->InvalidateCells(area.minX, area.minY, area.maxX, area.maxY);
+  }
+}
+
+void PathfindingObstaclesGrid::Rasterize(const ObstacleArea& area) {
+  OnCellsChanged(area);
+  if (area.isLarge) {
+    largeAreas.push_back(area);
+    return;
+  }
+
+  for (int x = area.minX; x <= area.maxX; ++x) {
+    for (int y = area.minY; y <= area.maxY; ++y) {
+      Cell& cell = cells[GetCellKey(x, y)];
+      cell.obstaclesCount++;
+      if (area.impassable)
+        cell.impassableObstaclesCount++;
+      else
+        cell.cost += area.cost;
+    }
+  }
+}
+
+void PathfindingObstaclesGrid::Unrasterize(const ObstacleArea& area) {
+  OnCellsChanged(area);
+  if (area.isLarge) {
+    for (std::size_t i = 0; i < largeAreas.size(); ++i) {
+      if (largeAreas[i] == area) {
+        largeAreas[i] = largeAreas.back();
+        largeAreas.pop_back();
+        return;
+      }
+    }
+    return;
+  }
+
+  for (int x = area.minX; x <= area.maxX; ++x) {
+    for (int y = area.minY; y <= area.maxY; ++y) {
+      auto it = cells.find(GetCellKey(x, y));
+      if (it == cells.end()) continue;
+
+      Cell& cell = it->second;
+      if (cell.obstaclesCount <= 1) {
+        cells.erase(it);  // Erasing the cell also avoids accumulating rounding
+                          // errors on its cost.
+        continue;
+      }
+
+      cell.obstaclesCount--;
+      if (area.impassable)
+        cell.impassableObstaclesCount--;
+      else
+        cell.cost -= area.cost;
+    }
+  }
+}
+
+void PathfindingObstaclesGrid::UpdateObstacle(
+    const PathfindingObstacleRuntimeBehavior* obstacle) {
+  ObstacleArea area = ComputeArea(obstacle);
+
+  auto it = areas.find(obstacle);
+  if (it == areas.end()) {
+    Rasterize(area);
+    areas[obstacle] = area;
+    return;
+  }
+
+  if (it->second == area) return;
+
+  Unrasterize(it->second);
+  Rasterize(area);
+  it->second = area;
+}
+
+void PathfindingObstaclesGrid::RemoveObstacle(
+    const PathfindingObstacleRuntimeBehavior* obstacle) {
+  auto it = areas.find(obstacle);
+  if (it == areas.end()) return;
+
+  Unrasterize(it->second);
+  areas.erase(it);
+}
+
+float PathfindingObstaclesGrid::GetCost(int x, int y) const {
+  bool objectsOnCell = false;
+  float cost = 0;
+
+  auto it = cells.find(GetCellKey(x, y));
+  if (it != cells.end()) {
+    if (it->second.impassableObstaclesCount > 0) return -1;
+
+    objectsOnCell = true;
+    cost += it->second.cost;
+  }
+
+  for (const ObstacleArea& area : largeAreas) {
+    if (!area.Contains(x, y)) continue;
+
+    if (area.impassable) return -1;  // The cell is impassable, stop here.
+
+    objectsOnCell = true;
+    cost += area.cost;  // Superimpose obstacles
+  }
+
+  // Default cost when no objects put on the cell.
+  return objectsOnCell ? cost : 1;
+}
+
+bool PathfindingObstaclesGrid::GetCachedPath(
+    const sf::Vector2i& start,
+    const sf::Vector2i& goal,
+    bool allowDiagonals,
+    bool hierarchical,
+    bool anyAngle,
+    std::vector<sf::Vector2i>& path) const {
+  auto it = cachedPaths.find(
+      MakePathKey(start, goal, allowDiagonals, hierarchical, anyAngle));
+  if (it == cachedPaths.end()) return false;
+
+  path = it->second;
+  return true;
+}
+
+void PathfindingObstaclesGrid::CachePath(
+    const sf::Vector2i& start,
+    const sf::Vector2i& goal,
+    bool allowDiagonals,
+    bool hierarchical,
+    bool anyAngle,
+    const std::vector<sf::Vector2i>& path) {
+  if (cachedPaths.size() >= maxCachedPathsCount) cachedPaths.clear();
+
+  cachedPaths[MakePathKey(
+      start, goal, allowDiagonals, hierarchical, anyAngle)] = path;
+}
+
+float PathfindingObstaclesGrid::GetLineCost(const sf::Vector2i& from,
+                                            const sf::Vector2i& to) const {
+  float maxCost = GetCost(from.x, from.y);
+  if (maxCost < 0) return -1;
+
+  // Walk on the cells crossed by the segment between the centers of the
+  // cells, in the order they are crossed.
+  int stepsX = std::abs(to.x - from.x);
+  int stepsY = std::abs(to.y - from.y);
+  int signX = to.x > from.x ? 1 : -1;
+  int signY = to.y > from.y ? 1 : -1;
+  int x = from.x;
+  int y = from.y;
+  for (int i = 0, j = 0; i < stepsX || j < stepsY;) {
+    // Compare the positions on the segment of the next vertical and
+    // horizontal edges: (0.5 + i) / stepsX and (0.5 + j) / stepsY.
+    long long decision = (1 + 2 * static_cast<long long>(i)) * stepsY -
+                         (1 + 2 * static_cast<long long>(j)) * stepsX;
+    if (decision == 0) {
+      // Going through a corner: the cells on both sides are touched.
+      float costX = GetCost(x + signX, y);
+      float costY = GetCost(x, y + signY);
+      if (costX < 0 || costY < 0) return -1;
+      maxCost = std::max(maxCost, std::max(costX, costY));
+
+      x += signX;
+      y += signY;
+      i++;
+      j++;
+    } else if (decision < 0) {
+      x += signX;
+      i++;
+    } else {
+      y += signY;
+      j++;
+    }
+
+    float cost = GetCost(x, y);
+    if (cost < 0) return -1;
+    maxCost = std::max(maxCost, cost);
+  }
+
+  return maxCost;
+}
+
+void PathfindingObstaclesGrid::SmoothPath(
+    std::vector<sf::Vector2i>& path) const {
+  if (path.size() < 3) return;
+
+  // The kept cells are moved to the beginning of the path.
+  sf::Vector2i anchor = path[0];
+  float replacedMaxCost = GetCost(anchor.x, anchor.y);
+  std::size_t keptCount = 1;
+  for (std::size_t i = 1; i + 1 < path.size(); ++i) {
+    const sf::Vector2i& next = path[i + 1];
+    float maxCostWithNext =
+        std::max(replacedMaxCost, GetCost(next.x, next.y));
+    float lineCost = GetLineCost(anchor, next);
+    if (lineCost >= 0 && lineCost <= maxCostWithNext) {
+      replacedMaxCost = maxCostWithNext;  // path[i] can be skipped.
+      continue;
+    }
+
+    anchor = path[i];
+    path[keptCount++] = anchor;
+    replacedMaxCost =
+        std::max(GetCost(anchor.x, anchor.y), GetCost(next.x, next.y));
+  }
+
+  path[keptCount++] = path.back();
+  path.resize(keptCount);
+}
+
+PathfindingHierarchicalGraph& PathfindingObstaclesGrid::GetHierarchicalGraph(
+    bool allowDiagonals) {
+  std::unique_ptr<PathfindingHierarchicalGraph>& graph =
+      hierarchicalGraphs[allowDiagonals ? 1 : 0];
+  if (!graph)
+    graph.reset(new PathfindingHierarchicalGraph(*this, allowDiagonals));
+
+  return *graph;
+}
+
+PathfindingFlowField& PathfindingObstaclesGrid::GetFlowField(
+    const sf::Vector2i& goal, bool allowDiagonals) {
+  auto& fields = flowFields[allowDiagonals ? 1 : 0];
+  std::int64_t key = GetCellKey(goal.x, goal.y);
+  auto it = fields.find(key);
+  if (it != fields.end()) return *it->second;
+
+  if (fields.size() >= maxFlowFieldsCount) fields.clear();
+
+  std::unique_ptr<PathfindingFlowField>& field = fields[key];
+  field.reset(new PathfindingFlowField(*this, goal, allowDiagonals));
+  return *field;
+}
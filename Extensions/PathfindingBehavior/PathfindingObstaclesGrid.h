@@ -0,0 +1,259 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGOBSTACLESGRID_H
+#define PATHFINDINGOBSTACLESGRID_H
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+class PathfindingObstacleRuntimeBehavior;
+class PathfindingHierarchicalGraph;
+class PathfindingFlowField;
+
+/**
+ * \brief The cost of the cells of a grid, computed from the obstacles of a
+ * scene, for a given cell size and a given size of the object moving on the
+ * grid.
+ *
+ * Each obstacle is rasterized in the cells it is covering, so that the cost of
+ * a cell is a lookup instead of a test against all the obstacles. When an
+ * obstacle is updated, only the cells it was covering and the cells it is now
+ * covering are updated (and nothing is done if these cells have not changed).
+ *
+ * The grid also stores the paths and the flow fields computed recently, which
+ * are discarded as soon as a cell changes.
+ *
+ * \see ScenePathfindingObstaclesManager::GetObstaclesGrid
+ */
+class PathfindingObstaclesGrid {
+ public:
+  PathfindingObstaclesGrid(float cellWidth,
+                           float cellHeight,
+                           float leftBorder,
+                           float topBorder,
+                           float rightBorder,
+                           float bottomBorder);
+  virtual ~PathfindingObstaclesGrid();
+
+  /**
+   * \brief Return true if the grid was created for the specified cell size
+   * and object borders.
+   */
+  bool HasParameters(float cellWidth_,
+                     float cellHeight_,
+                     float leftBorder_,
+                     float topBorder_,
+                     float rightBorder_,
+                     float bottomBorder_) const {
+    return cellWidth == cellWidth_ && cellHeight == cellHeight_ &&
+           leftBorder == leftBorder_ && topBorder == topBorder_ &&
+           rightBorder == rightBorder_ && bottomBorder == bottomBorder_;
+  }
+
+  /**
+   * \brief Add the obstacle to the grid, or refresh the cells it is covering
+   * if its position, size or cost changed since the last update.
+   */
+  void UpdateObstacle(const PathfindingObstacleRuntimeBehavior* obstacle);
+
+  /**
+   * \brief Remove the obstacle from the grid. Does nothing if the obstacle was
+   * not in the grid.
+   */
+  void RemoveObstacle(const PathfindingObstacleRuntimeBehavior* obstacle);
+
+  /**
+   * \brief Get the cost of moving on the specified cell.
+   * \return -1 if the cell is impassable, the sum of the costs of the obstacles
+   * covering the cell otherwise, or 1 if the cell is not covered by any
+   * obstacle.
+   */
+  float GetCost(int x, int y) const;
+
+  /**
+   * \brief Get the highest cost of the cells crossed by the segment going
+   * from a cell to another one (the cells touched by the segment at a corner
+   * included).
+   * \return -1 if one of the cells is impassable.
+   */
+  float GetLineCost(const sf::Vector2i& from, const sf::Vector2i& to) const;
+
+  /**
+   * \brief Remove the cells of a path that can be skipped by going straight
+   * from the previous kept cell to the next one ("string pulling").
+   *
+   * A shortcut is only taken if all its cells are passable and not more
+   * costly than the most costly cell of the part of the path it replaces.
+   */
+  void SmoothPath(std::vector<sf::Vector2i>& path) const;
+
+  /**
+   * \brief Get an identifier of the state of the cells, changed each time a
+   * cell changes (and different from the versions of the other grids).
+   */
+  std::size_t GetVersion() const { return version; }
+
+  /**
+   * \brief Get a path computed before for the same cells and options, if the
+   * cells did not change since.
+   * \param path Filled with the cells of the path, or emptied if no path was
+   * found.
+   * \return true if the path was stored.
+   */
+  bool GetCachedPath(const sf::Vector2i& start,
+                     const sf::Vector2i& goal,
+                     bool allowDiagonals,
+                     bool hierarchical,
+                     bool anyAngle,
+                     std::vector<sf::Vector2i>& path) const;
+
+  /**
+   * \brief Store a computed path (or an empty path if no path was found), to
+   * be returned by GetCachedPath.
+   */
+  void CachePath(const sf::Vector2i& start,
+                 const sf::Vector2i& goal,
+                 bool allowDiagonals,
+                 bool hierarchical,
+                 bool anyAngle,
+                 const std::vector<sf::Vector2i>& path);
+
+  /**
+   * \brief Get the hierarchical graph used to compute long paths on the grid,
+   * kept up to date with the cells of the grid.
+   */
+  PathfindingHierarchicalGraph& GetHierarchicalGraph(bool allowDiagonals);
+
+  /**
+   * \brief Get the flow field leading to the specified goal cell, shared by
+   * all the objects moving to this cell.
+   * \warning The returned reference is only valid until a cell changes.
+   */
+  PathfindingFlowField& GetFlowField(const sf::Vector2i& goal,
+                                     bool allowDiagonals);
+
+  std::size_t lastUseId;  ///< Used by ScenePathfindingObstaclesManager to
+                          ///< discard the grids not used recently.
+
+ private:
+  /**
+   * \brief The cells covered by an obstacle (bounds included) and its cost,
+   * as rasterized in the grid.
+   */
+  struct ObstacleArea {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+    float cost;
+    bool impassable;
+    bool isLarge;  ///< True if the obstacle is covering too many cells to be
+                   ///< rasterized.
+
+    bool operator==(const ObstacleArea& other) const {
+      return minX == other.minX && minY == other.minY && maxX == other.maxX &&
+             maxY == other.maxY && cost == other.cost &&
+             impassable == other.impassable && isLarge == other.isLarge;
+    }
+    bool Contains(int x, int y) const {
+      return minX <= x && x <= maxX && minY <= y && y <= maxY;
+    }
+  };
+
+  struct Cell {
+    Cell() : cost(0), obstaclesCount(0), impassableObstaclesCount(0){};
+
+    float cost;  ///< The sum of the costs of the passable obstacles.
+    std::size_t obstaclesCount;
+    std::size_t impassableObstaclesCount;
+  };
+
+  ObstacleArea ComputeArea(
+      const PathfindingObstacleRuntimeBehavior* obstacle) const;
+  void Rasterize(const ObstacleArea& area);
+  void Unrasterize(const ObstacleArea& area);
+  void OnCellsChanged(const ObstacleArea& area);
+  static std::int64_t GetCellKey(int x, int y) {
+    return static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)));
+  }
+
+  float cellWidth;
+  float cellHeight;
+  float leftBorder;
+  float topBorder;
+  float rightBorder;
+  float bottomBorder;
+  std::unordered_map<const PathfindingObstacleRuntimeBehavior*, ObstacleArea>
+      areas;  ///< The area of each obstacle, as rasterized in the grid.
+  std::unordered_map<std::int64_t, Cell>
+      cells;  ///< The cells covered by at least one obstacle.
+  std::vector<ObstacleArea> largeAreas;  ///< Obstacles covering too many cells
+                                         ///< are stored apart and always
+                                         ///< tested.
+  std::size_t version;
+
+  /**
+   * \brief The start, goal and options of a cached path.
+   */
+  struct PathKey {
+    int startX;
+    int startY;
+    int goalX;
+    int goalY;
+    bool allowDiagonals;
+    bool hierarchical;
+    bool anyAngle;
+
+    bool operator==(const PathKey& other) const {
+      return startX == other.startX && startY == other.startY &&
+             goalX == other.goalX && goalY == other.goalY &&
+             allowDiagonals == other.allowDiagonals &&
+             hierarchical == other.hierarchical && anyAngle == other.anyAngle;
+    }
+  };
+  struct PathKeyHash {
+    std::size_t operator()(const PathKey& key) const {
+      std::size_t hash = key.startX;
+      hash = hash * 31 + key.startY;
+      hash = hash * 31 + key.goalX;
+      hash = hash * 31 + key.goalY;
+      return hash * 8 + key.allowDiagonals * 4 + key.hierarchical * 2 +
+             key.anyAngle;
+    }
+  };
+  static PathKey MakePathKey(const sf::Vector2i& start,
+                             const sf::Vector2i& goal,
+                             bool allowDiagonals,
+                             bool hierarchical,
+                             bool anyAngle) {
+    PathKey key = {start.x,
+                   start.y,
+                   goal.x,
+                   goal.y,
+                   allowDiagonals,
+                   hierarchical,
+                   anyAngle};
+    return key;
+  }
+  std::unordered_map<PathKey, std::vector<sf::Vector2i>, PathKeyHash>
+      cachedPaths;  ///< The paths computed since the cells last changed.
+  std::unique_ptr<PathfindingHierarchicalGraph>
+      hierarchicalGraphs[2];  ///< The graphs without and with diagonals.
+  std::unordered_map<std::int64_t, std::unique_ptr<PathfindingFlowField>>
+      flowFields[2];  ///< The flow fields, by goal cell, without and with
+                      ///< diagonals.
+
+  static const double maxCellsPerObstacle;
+  static const std::size_t maxCachedPathsCount;
+  static const std::size_t maxFlowFieldsCount;
+  static std::size_t lastVersion;  ///< The last version given to a grid.
+};
+
+#endif  // PATHFINDINGOBSTACLESGRID_H
@@ -8,18 +8,26 @@ This project is released under the MIT License.
 #include "PathfindingRuntimeBehavior.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
-#include <set>
 #include <unordered_map>
+#include <vector>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "PathfindingFlowField.h"
+#include "PathfindingHierarchicalGraph.h"
 #include "PathfindingObstacleRuntimeBehavior.h"
+#include "PathfindingObstaclesGrid.h"
 #include "ScenePathfindingObstaclesManager.h"
 
 /**
@@ -43,20 +51,6 @@ bool operator==(const NodePosition& a, const NodePosition& b) {
   return ((a.x == b.x) && (a.y == b.y));
 }
 
-namespace std {
-/**
- * \brief Tool function used to store a NodePosition as key in
- * std::unordered_set.
- */
-template <>
-struct hash<NodePosition> {
-  std::size_t operator()(NodePosition const& n) const {
-    return (std::hash<int>()(n.x)) ^ (std::hash<int>()(n.y) << 1);
-  }
-};
-
-}  // namespace std
-
 namespace {
 /**
  * \brief Internal tool class representing a node when looking for a path
@@ -69,21 +63,30 @@ class Node {
         smallestCost(-1),
         estimateCost(-1),
         parent(NULL),
-        open(true){};
+        open(true),
+        searchId(0),
+        heapIndex(0),
+        order(0){};
   Node(int x, int y)
       : pos(x, y),
         cost(0),
         smallestCost(-1),
         estimateCost(-1),
         parent(NULL),
-        open(true){};
+        open(true),
+        searchId(0),
+        heapIndex(0),
+        order(0){};
   Node(const NodePosition& pos_)
       : pos(pos_),
         cost(0),
         smallestCost(-1),
         estimateCost(-1),
         parent(NULL),
-        open(true){};
+        open(true),
+        searchId(0),
+        heapIndex(0),
+        order(0){};
 
   NodePosition pos;
   float cost;          ///< The cost for traveling on this node
@@ -96,23 +99,226 @@ class Node {
                        ///< (when considering the shortest path).
   bool open;  ///< true if the node is "open" (must be explored), false if
               ///< "close" (already explored)
+  std::size_t searchId;   ///< The search during which the node was initialized.
+  std::size_t heapIndex;  ///< The position of the node in the open nodes heap.
+  std::size_t order;  ///< The order of insertion in the open nodes heap, used
+                      ///< to sort nodes having the same estimate cost.
+};
+
+bool operator==(Node const& n1, Node const& n2) {
+  return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
+};
+
+typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
+
+/**
+ * \brief Internal tool class storing the nodes in chunks of cells, so that
+ * a node is found from its position with an array access.
+ *
+ * Nodes are never cleared: each node stores the search during which it was
+ * initialized, so that starting a new search only increments the current
+ * search identifier.
+ */
+class NodesStorage {
+ public:
+  NodesStorage() : searchId(0), lastChunk(NULL), lastChunkX(0), lastChunkY(0){};
 
   /**
-   * \brief Tool function used to store a Node in a priority_queue.
+   * \brief Invalidate all the nodes, to start a new search.
    */
-  class NodeComparator {
-   public:
-    bool operator()(const Node* n1, const Node* n2) {
-      return n1->estimateCost < n2->estimateCost;
+  void NewSearch() {
+    searchId++;
+
+    // Release the memory used by a previous huge search.
+    if (chunks.size() > maxChunksCount) {
+      chunks.clear();
+      chunksByKey.clear();
+      lastChunk = NULL;
     }
+  }
+
+  /**
+   * \brief Get the node at the specified position.
+   * \param isNew Set to true if the node was not used yet during the current
+   * search, in which case it is initialized.
+   */
+  Node& GetNode(const NodePosition& pos, bool& isNew) {
+    int chunkX = FloorDivide(pos.x);
+    int chunkY = FloorDivide(pos.y);
+    Chunk& chunk = GetChunk(chunkX, chunkY);
+
+    Node& node = chunk.nodes[(pos.y - chunkY * chunkSize) * chunkSize +
+                             (pos.x - chunkX * chunkSize)];
+    isNew = node.searchId != searchId;
+    if (isNew) {
+      node = Node(pos);
+      node.searchId = searchId;
+    }
+
+    return node;
+  }
+
+ private:
+  static const int chunkSize = 16;
+  static const std::size_t maxChunksCount = 1024;
+
+  struct Chunk {
+    Node nodes[chunkSize * chunkSize];
   };
+
+  static int FloorDivide(int value) {
+    return value >= 0 ? value / chunkSize : (value + 1) / chunkSize - 1;
+  }
+
+  Chunk& GetChunk(int chunkX, int chunkY) {
+    // Consecutive accesses are often done in the same chunk.
+    if (lastChunk && lastChunkX == chunkX && lastChunkY == chunkY)
+      return *lastChunk;
+
+    std::int64_t key = static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkY)));
+    auto it = chunksByKey.find(key);
+    if (it != chunksByKey.end()) {
+      lastChunk = it->second;
+    } else {
+      chunks.emplace_back();
+      lastChunk = &chunks.back();
+      chunksByKey[key] = lastChunk;
+    }
+
+    lastChunkX = chunkX;
+    lastChunkY = chunkY;
+    return *lastChunk;
+  }
+
+  std::size_t searchId;  ///< The identifier of the current search.
+  std::deque<Chunk> chunks;  ///< The chunks (std::deque keeps the references
+                             ///< to nodes valid when adding chunks).
+  std::unordered_map<std::int64_t, Chunk*> chunksByKey;
+  Chunk* lastChunk;
+  int lastChunkX;
+  int lastChunkY;
 };
 
-bool operator==(Node const& n1, Node const& n2) {
-  return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
+/**
+ * \brief Internal tool class containing the open nodes, as a 4-ary heap
+ * sorted by estimate cost.
+ *
+ * Nodes having the same estimate cost are sorted by their order of insertion
+ * (or of update), the first being returned first.
+ */
+class OpenNodesHeap {
+ public:
+  OpenNodesHeap() : nextOrder(0){};
+
+  bool IsEmpty() const { return nodes.empty(); }
+
+  void Clear() {
+    nodes.clear();
+    nextOrder = 0;
+  }
+
+  /**
+   * \brief Add a node to the heap.
+   */
+  void Push(Node* node) {
+    node->order = nextOrder++;
+    node->heapIndex = nodes.size();
+    nodes.push_back(node);
+    SiftUp(node->heapIndex);
+  }
+
+  /**
+   * \brief Remove and return the node with the lowest estimate cost.
+   */
+  Node* Pop() {
+    Node* top = nodes[0];
+    Node* last = nodes.back();
+    nodes.pop_back();
+    if (!nodes.empty()) {
+      nodes[0] = last;
+      last->heapIndex = 0;
+      SiftDown(0);
+    }
+
+    return top;
+  }
+
+  /**
+   * \brief Move a node already in the heap after its estimate cost changed.
+   */
+  void Update(Node* node) {
+    node->order = nextOrder++;
+    SiftUp(node->heapIndex);
+    SiftDown(node->heapIndex);
+  }
+
+ private:
+  static const std::size_t arity = 4;
+
+  static bool IsBefore(const Node* a, const Node* b) {
+    return a->estimateCost < b->estimateCost ||
+           (a->estimateCost == b->estimateCost && a->order < b->order);
+  }
+
+  void Place(Node* node, std::size_t index) {
+    nodes[index] = node;
+    node->heapIndex = index;
+  }
+
+  void SiftUp(std::size_t index) {
+    Node* node = nodes[index];
+    while (index > 0) {
+      std::size_t parentIndex = (index - 1) / arity;
+      if (!IsBefore(node, nodes[parentIndex])) break;
+
+      Place(nodes[parentIndex], index);
+      index = parentIndex;
+    }
+    Place(node, index);
+  }
+
+  void SiftDown(std::size_t index) {
+    Node* node = nodes[index];
+    while (true) {
+      std::size_t firstChild = index * arity + 1;
+      if (firstChild >= nodes.size()) break;
+
+      std::size_t bestChild = firstChild;
+      std::size_t lastChild = std::min(firstChild + arity, nodes.size());
+      for (std::size_t child = firstChild + 1; child < lastChild; ++child)
+        if (IsBefore(nodes[child], nodes[bestChild])) bestChild = child;
+
+      if (!IsBefore(nodes[bestChild], node)) break;
+
+      Place(nodes[bestChild], index);
+      index = bestChild;
+    }
+    Place(node, index);
+  }
+
+  std::vector<Node*> nodes;
+  std::size_t nextOrder;
 };
 
-typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
+/**
+ * \brief The storage of the nodes and the open nodes, kept from a search to
+ * another to avoid allocations and clearing.
+ *
+ * \note Paths computed immediately are computed one at a time, on the main
+ * thread, and share this storage. Paths computed over several frames have their
+ * own (see PathfindingRequestsQueue).
+ */
+struct SearchStorage {
+  NodesStorage nodes;
+  OpenNodesHeap openNodes;
+};
+
+SearchStorage& GetSearchStorage() {
+  static SearchStorage storage;
+  return storage;
+}
 
 /**
  * \brief Internal tool class containing the structures used by A* and members
@@ -120,21 +326,36 @@ typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
  */
 class SearchContext {
  public:
+  enum SearchStatus { SearchInProgress, SearchSucceeded, SearchFailed };
+
   SearchContext(ScenePathfindingObstaclesManager& obstacles_,
-                bool allowsDiagonal_ = true)
-      : obstacles(obstacles_),
-        finalNode(NULL),
+                bool allowsDiagonal_ = true,
+                bool hierarchical_ = false,
+                SearchStorage& storage = GetSearchStorage())
+      : nodes(storage.nodes),
+        openNodes(storage.openNodes),
+        obstacles(obstacles_),
+        obstaclesGrid(NULL),
+        obstaclesGridUpToDate(false),
+        gridVersion(0),
+        status(SearchFailed),
+        start(0, 0),
         destination(0, 0),
         startX(0),
         startY(0),
         allowsDiagonal(allowsDiagonal_),
+        hierarchical(hierarchical_),
+        anyAngle(false),
+        smoothPath(false),
         maxComplexityFactor(50),
         cellWidth(20),
         cellHeight(20),
         leftBorder(0),
         rightBorder(0),
         topBorder(0),
-        bottomBorder(0) {
+        bottomBorder(0),
+        iterationCount(0),
+        maxIterationCount(0) {
     distanceFunction = allowsDiagonal ? &SearchContext::EuclideanDistance
                                       : &SearchContext::ManhattanDistance;
   }
@@ -176,63 +397,190 @@ class SearchContext {
     return *this;
   }
 
+  /**
+   * \brief Search paths going straight through the cells in sight of each
+   * other (Theta*), instead of paths going from a cell to an adjacent one.
+   */
+  SearchContext& SetAnyAngle(bool anyAngle_) {
+    anyAngle = anyAngle_;
+    if (anyAngle) distanceFunction = &SearchContext::EuclideanDistance;
+    return *this;
+  }
+
+  /**
+   * \brief Remove the cells of the found paths that can be skipped by going
+   * straight from a cell to a next one (see
+   * PathfindingObstaclesGrid::SmoothPath).
+   */
+  SearchContext& SetSmoothPath(bool smoothPath_) {
+    smoothPath = smoothPath_;
+    return *this;
+  }
+
   /**
    * \brief Compute a path to the specified position, considering the obstacles
    * and the start position passed in the constructor.
    * \return true if computation found a path, in which case you can call
-   * GetFinalNode method to construct the path. \param x The coordinate on X
+   * GetPathCells method to construct the path. \param x The coordinate on X
    * axis of the target position, in "world" coordinates. \param y The
    * coordinate on Y axis of the target position, in "world" coordinates.
    */
   bool ComputePathTo(float targetX, float targetY) {
+    StartSearch(targetX, targetY);
+
+    std::size_t remainingNodes = std::numeric_limits<std::size_t>::max();
+    return ContinueSearch(remainingNodes) == SearchSucceeded;
+  }
+
+  /**
+   * \brief Initialize the search of a path to the specified position, to be
+   * computed with ContinueSearch.
+   *
+   * The path is taken from the cache of the grid if it was already computed
+   * since the obstacles last changed. Long paths are computed immediately
+   * on the hierarchical graph of the grid if the search is hierarchical.
+   */
+  void StartSearch(float targetX, float targetY) {
     destination = NodePosition(GDRound(targetX / cellWidth),
                                GDRound(targetY / cellHeight));
-    NodePosition start(GDRound(startX / cellWidth),
-                       GDRound(startY / cellHeight));
+    start = NodePosition(GDRound(startX / cellWidth),
+                         GDRound(startY / cellHeight));
+    UpdateObstaclesGrid();
+    pathCells.clear();
+
+    sf::Vector2i startCell(start.x, start.y);
+    sf::Vector2i destinationCell(destination.x, destination.y);
+    if (obstaclesGrid->GetCachedPath(startCell,
+                                     destinationCell,
+                                     allowsDiagonal,
+                                     hierarchical,
+                                     anyAngle,
+                                     pathCells)) {
+      if (smoothPath) obstaclesGrid->SmoothPath(pathCells);
+      status = pathCells.empty() ? SearchFailed : SearchSucceeded;
+      return;
+    }
+
+    int distance =
+        std::abs(destination.x - start.x) + std::abs(destination.y - start.y);
+    if (hierarchical &&
+        distance > 2 * PathfindingHierarchicalGraph::clusterSize) {
+      std::size_t maxExpandedNodes =
+          (distance / PathfindingHierarchicalGraph::clusterSize + 1) *
+          maxComplexityFactor;
+      if (!obstaclesGrid->GetHierarchicalGraph(allowsDiagonal)
+               .ComputePath(
+                   startCell, destinationCell, maxExpandedNodes, pathCells))
+        pathCells.clear();
+
+      // The hierarchical paths are approximated as any angle paths by
+      // removing their cells that can be skipped.
+      if (anyAngle) obstaclesGrid->SmoothPath(pathCells);
+      obstaclesGrid->CachePath(startCell,
+                               destinationCell,
+                               allowsDiagonal,
+                               hierarchical,
+                               anyAngle,
+                               pathCells);
+      if (smoothPath) obstaclesGrid->SmoothPath(pathCells);
+      status = pathCells.empty() ? SearchFailed : SearchSucceeded;
+      return;
+    }
 
     // Initialize the algorithm
-    allNodes.clear();
+    status = SearchInProgress;
+    gridVersion = obstaclesGrid->GetVersion();
+    nodes.NewSearch();
+    openNodes.Clear();
     Node& startNode = GetNode(start);
     startNode.smallestCost = 0;
     startNode.estimateCost = 0 + distanceFunction(start, destination);
-    openNodes.clear();
-    openNodes.insert(&startNode);
+    openNodes.Push(&startNode);
+
+    iterationCount = 0;
+    maxIterationCount = startNode.estimateCost * maxComplexityFactor;
+  }
+
+  /**
+   * \brief Continue the search started with StartSearch, exploring at most
+   * \a remainingNodes nodes.
+   * \param remainingNodes The number of nodes that can be explored, decreased
+   * by the number of explored nodes.
+   * \return SearchInProgress if the search must be continued later, or the
+   * result of the search. In case of success, call GetPathCells to construct
+   * the path.
+   */
+  SearchStatus ContinueSearch(std::size_t& remainingNodes) {
+    if (status != SearchInProgress) return status;
+
+    // Obstacles may have changed since the search was suspended.
+    if (!obstaclesGridUpToDate) UpdateObstaclesGrid();
+    obstaclesGridUpToDate = false;
 
     // A* algorithm main loop
-    std::size_t iterationCount = 0;
-    std::size_t maxIterationCount =
-        startNode.estimateCost * maxComplexityFactor;
-    while (!openNodes.empty()) {
+    while (!openNodes.IsEmpty()) {
+      if (remainingNodes == 0) return SearchInProgress;
+      remainingNodes--;
+
       if (iterationCount++ > maxIterationCount)
-        return false;  // Make sure we do not search forever.
+        return FinishSearch(NULL);  // Make sure we do not search forever.
 
-      Node* n = *openNodes.begin();  // Get the most promising node...
-      n->open = false;               //...and flag it as explored
-      openNodes.erase(
-          openNodes.begin());  // Be sure to remove ONLY the first element!
+      Node* n = openNodes.Pop();  // Get the most promising node...
+      n->open = false;            //...and flag it as explored
 
       // Check if we reached destination?
-      if (n->pos.x == destination.x && n->pos.y == destination.y) {
-        finalNode = n;
-        return true;
-      }
+      if (n->pos.x == destination.x && n->pos.y == destination.y)
+        return FinishSearch(n);
 
       // No, so add neighbors to the nodes to explore.
       InsertNeighbors(*n);
     }
 
-    return false;
+    return FinishSearch(NULL);
   }
 
   /**
-   * @return The final node of the computed path.
-   * Iterate on the parent member to create the path. Beware, the coordinates of
-   * the node must be multiplied by the cell size to get the "world" coordinates
-   * of the path.
+   * @return The cells of the computed path, from the start to the
+   * destination. Beware, the coordinates of the cells must be multiplied by the
+   * cell size to get the "world" coordinates of the path.
    */
-  Node* GetFinalNode() const { return finalNode; }
+  const std::vector<sf::Vector2i>& GetPathCells() const { return pathCells; }
 
  private:
+  /**
+   * \brief Store the result of the search, and cache it in the grid if the
+   * obstacles did not change during the search.
+   * \param finalNode The node of the destination, or NULL if no path was
+   * found.
+   */
+  SearchStatus FinishSearch(const Node* finalNode) {
+    for (const Node* node = finalNode; node; node = node->parent)
+      pathCells.push_back(sf::Vector2i(node->pos.x, node->pos.y));
+    std::reverse(pathCells.begin(), pathCells.end());
+
+    if (obstaclesGrid->GetVersion() == gridVersion)
+      obstaclesGrid->CachePath(sf::Vector2i(start.x, start.y),
+                               sf::Vector2i(destination.x, destination.y),
+                               allowsDiagonal,
+                               hierarchical,
+                               anyAngle,
+                               pathCells);
+
+    if (smoothPath) obstaclesGrid->SmoothPath(pathCells);
+    status = finalNode ? SearchSucceeded : SearchFailed;
+    return status;
+  }
+
+  void UpdateObstaclesGrid() {
+    obstaclesGrid = &obstacles.GetObstaclesGrid(cellWidth,
+                                                cellHeight,
+                                                leftBorder,
+                                                topBorder,
+                                                rightBorder,
+                                                bottomBorder);
+    obstaclesGridUpToDate = true;
+  }
+
   /**
    * Insert the neighbors of the current node in the open list
    * (Only if they are not closed, and if the cost is better than the already
@@ -271,47 +619,14 @@ class SearchContext {
    * \brief Get (or dynamically construct) a node.
    *
    * *All* nodes should be created using this method: The cost of the node is
-   * computed thanks to the objects flagged as obstacles.
+   * read from the grid computed from the objects flagged as obstacles.
    */
   Node& GetNode(const NodePosition& pos) {
-    if (allNodes.find(pos) != allNodes.end()) return allNodes.find(pos)->second;
-
-    Node newNode(pos);
-
-    bool objectsOnCell = false;
-    const std::set<PathfindingObstacleRuntimeBehavior*>& allObstacles =
-        obstacles.GetAllObstacles();
-    for (std::set<PathfindingObstacleRuntimeBehavior*>::const_iterator it =
-             allObstacles.begin();
-         it != allObstacles.end();
-         ++it) {
-      RuntimeObject* obj = (*it)->GetObject();
-      int topLeftCellX =
-          floor((obj->GetDrawableX() - rightBorder) / (float)cellWidth);
-      int topLeftCellY =
-          floor((obj->GetDrawableY() - bottomBorder) / (float)cellHeight);
-      int bottomRightCellX =
-          ceil((obj->GetDrawableX() + obj->GetWidth() + leftBorder) /
-               (float)cellWidth);
-      int bottomRightCellY =
-          ceil((obj->GetDrawableY() + obj->GetHeight() + topBorder) /
-               (float)cellHeight);
-      if (topLeftCellX < pos.x && pos.x < bottomRightCellX &&
-          topLeftCellY < pos.y && pos.y < bottomRightCellY) {
-        objectsOnCell = true;
-        if ((*it)->IsImpassable()) {
-          newNode.cost = -1;
-          break;  // The cell is impassable, stop here.
-        } else    // Superimpose obstacles
-          newNode.cost += (*it)->GetCost();
-      }
-    }
-
-    if (!objectsOnCell)
-      newNode.cost = 1;  // Default cost when no objects put on the cell.
+    bool isNew = false;
+    Node& node = nodes.GetNode(pos, isNew);
+    if (isNew) node.cost = obstaclesGrid->GetCost(pos.x, pos.y);
 
-    allNodes[pos] = newNode;
-    return allNodes[pos];
+    return node;
   }
 
   /**
@@ -331,6 +646,9 @@ class SearchContext {
   /**
    * Add a node to the openNodes (only if the cost to reach it is less than the
    * existing cost, if any).
+   *
+   * When searching any angle paths, the node can be reached straight from the
+   * parent of currentNode, if it is in sight (Theta*).
    */
   void AddOrUpdateNode(const NodePosition& newNodePosition,
                        const Node& currentNode,
@@ -340,38 +658,58 @@ class SearchContext {
         neighbor.cost < 0)  // cost < 0 means impassable obstacle
       return;
 
-    // Update the node costs and parent if the path coming from currentNode is
-    // better:
-    if (neighbor.smallestCost == -1 ||
-        neighbor.smallestCost >
-            currentNode.smallestCost +
-                (currentNode.cost + neighbor.cost) / 2.0 * factor) {
-      if (neighbor.smallestCost != -1)  // The node is already in the open list:
-      {
-        // remove it as its estimate cost will be updated.
-        auto it = openNodes.find(&neighbor);
-        if (it !=
-            openNodes.end())  // /!\ ALWAYS use an iterator with multiset::erase
-          openNodes.erase(it);  // otherwise, other nodes which are equivalent
-                                // get removed too.
+    const Node* newParent = &currentNode;
+    float newCost = currentNode.smallestCost +
+                    (currentNode.cost + neighbor.cost) / 2.0 * factor;
+    if (anyAngle && currentNode.parent) {
+      const Node& parent = *currentNode.parent;
+      float lineCost = obstaclesGrid->GetLineCost(
+          sf::Vector2i(parent.pos.x, parent.pos.y),
+          sf::Vector2i(neighbor.pos.x, neighbor.pos.y));
+      if (lineCost >= 0) {
+        float costFromParent =
+            parent.smallestCost +
+            lineCost * EuclideanDistance(parent.pos, neighbor.pos);
+        if (costFromParent <= newCost) {
+          newParent = &parent;
+          newCost = costFromParent;
+        }
       }
+    }
 
-      neighbor.smallestCost = currentNode.smallestCost +
-                              (currentNode.cost + neighbor.cost) / 2.0 * factor;
-      neighbor.parent = &currentNode;
+    // Update the node costs and parent if the path coming from newParent is
+    // better:
+    if (neighbor.smallestCost == -1 || neighbor.smallestCost > newCost) {
+      bool alreadyInOpenNodes = neighbor.smallestCost != -1;
+
+      neighbor.smallestCost = newCost;
+      neighbor.parent = newParent;
       neighbor.estimateCost =
           neighbor.smallestCost + distanceFunction(neighbor.pos, destination);
 
-      openNodes.insert(&neighbor);
+      // Move the node in the open list as its estimate cost was updated.
+      if (alreadyInOpenNodes)
+        openNodes.Update(&neighbor);
+      else
+        openNodes.Push(&neighbor);
     }
   }
 
-  std::unordered_map<NodePosition, Node> allNodes;  ///< All the nodes
-  std::multiset<Node*, Node::NodeComparator>
+  NodesStorage& nodes;  ///< All the nodes
+  OpenNodesHeap&
       openNodes;  ///< Only the open nodes (Such that Node::open == true)
-  const ScenePathfindingObstaclesManager&
-      obstacles;    ///< A reference to all the obstacles of the scene
-  Node* finalNode;  // If computation succeeded, the final node is stored here.
+  ScenePathfindingObstaclesManager&
+      obstacles;  ///< A reference to all the obstacles of the scene
+  PathfindingObstaclesGrid*
+      obstaclesGrid;  ///< The costs of the cells, computed from the obstacles.
+  bool obstaclesGridUpToDate;  ///< False if obstaclesGrid must be fetched
+                               ///< again before being used.
+  std::size_t gridVersion;  ///< The version of the grid when the search
+                            ///< started.
+  SearchStatus status;
+  std::vector<sf::Vector2i>
+      pathCells;  // If computation succeeded, the path is stored here.
+  NodePosition start;
   NodePosition destination;
   int startX;  ///< The start X position, in "world" coordinates (not in "node"
                ///< coordinates!).
@@ -379,6 +717,10 @@ class SearchContext {
                ///< coordinates!).
   DistanceFunPtr distanceFunction;
   bool allowsDiagonal;  ///< True to allow diagonals when planning the path.
+  bool hierarchical;  ///< True to compute long paths on the hierarchical graph.
+  bool anyAngle;      ///< True to search the paths with Theta*.
+  bool smoothPath;    ///< True to remove the cells that can be skipped from the
+                      ///< found paths.
   std::size_t maxComplexityFactor;
   float cellWidth;
   float cellHeight;
@@ -386,21 +728,190 @@ class SearchContext {
   float rightBorder;
   float topBorder;
   float bottomBorder;
+  std::size_t iterationCount;
+  std::size_t maxIterationCount;
 
   static const float sqrt2;
 };
 
 const float SearchContext::sqrt2 = 1.414213562;
 
+/**
+ * \brief Get the size to be considered for the object when moving on the
+ * grid.
+ */
+void GetObjectBorders(const RuntimeObject& object,
+                      float extraBorder,
+                      float& leftBorder,
+                      float& topBorder,
+                      float& rightBorder,
+                      float& bottomBorder) {
+  leftBorder = object.GetX() - object.GetDrawableX() + extraBorder;
+  topBorder = object.GetY() - object.GetDrawableY() + extraBorder;
+  rightBorder = object.GetWidth() - (object.GetX() - object.GetDrawableX()) +
+                extraBorder;
+  bottomBorder = object.GetHeight() - (object.GetY() - object.GetDrawableY()) +
+                 extraBorder;
+}
+
+/**
+ * \brief Set up the search context for the object and the settings of the
+ * behavior.
+ */
+void SetUpSearchContext(SearchContext& ctx,
+                        const RuntimeObject& object,
+                        PathfindingRuntimeBehavior& behavior) {
+  float leftBorder, topBorder, rightBorder, bottomBorder;
+  GetObjectBorders(object,
+                   behavior.GetExtraBorder(),
+                   leftBorder,
+                   topBorder,
+                   rightBorder,
+                   bottomBorder);
+  ctx.SetCellSize(behavior.GetCellWidth(), behavior.GetCellHeight())
+      .SetStartPosition(object.GetX(), object.GetY());
+  ctx.SetObjectSize(leftBorder, topBorder, rightBorder, bottomBorder);
+  ctx.SetAnyAngle(behavior.IsAnyAngle())
+      .SetSmoothPath(behavior.IsPathSmoothed());
+}
+
+/**
+ * \brief Construct the path, in "world" coordinates, going through the cells
+ * found by a search.
+ */
+void GetPathFromCells(const std::vector<sf::Vector2i>& cells,
+                      unsigned int cellWidth,
+                      unsigned int cellHeight,
+                      std::vector<sf::Vector2f>& path) {
+  path.reserve(cells.size());
+  for (const sf::Vector2i& cell : cells)
+    path.push_back(
+        sf::Vector2f(cell.x * (float)cellWidth, cell.y * (float)cellHeight));
+}
+
 }  // namespace
 
+/**
+ * \brief The paths to be computed for the objects of a scene when they are
+ * computed over several frames.
+ *
+ * Requests are handled in the order they were made. At each frame, the search
+ * of the paths is continued until the maximum number of nodes to be explored
+ * is reached.
+ *
+ * The queue of a scene is stored in the scene (see
+ * RuntimeScene::GetExtensionData).
+ */
+class PathfindingRequestsQueue : public RuntimeSceneExtensionData {
+ public:
+  static const std::size_t sceneDataIndex;  ///< The slot of the queues in the
+                                            ///< scenes.
+
+  PathfindingRequestsQueue()
+      : maxNodesPerFrame(0), processed(false), currentRequest(NULL){};
+
+  /**
+   * \brief Add the request of a path for the behavior (its destination must
+   * be stored in the behavior).
+   */
+  void AddRequest(PathfindingRuntimeBehavior* behavior) {
+    requests.push_back(behavior);
+  }
+
+  /**
+   * \brief Remove the request of the behavior, if any.
+   */
+  void RemoveRequest(PathfindingRuntimeBehavior* behavior) {
+    if (currentRequest == behavior) {
+      currentRequest = NULL;
+      currentSearch.reset();
+      return;
+    }
+
+    requests.erase(std::remove(requests.begin(), requests.end(), behavior),
+                   requests.end());
+  }
+
+  /**
+   * \brief Continue the computation of the requested paths, for the current
+   * frame.
+   */
+  void Process(ScenePathfindingObstaclesManager& obstacles);
+
+  std::size_t maxNodesPerFrame;  ///< The maximum number of nodes to explore
+                                 ///< at each frame, 0 to compute the paths
+                                 ///< immediately.
+  bool processed;  ///< True if the requests were processed during the current
+                   ///< frame.
+
+ private:
+  std::deque<PathfindingRuntimeBehavior*>
+      requests;  ///< The requests waiting for their computation to start.
+  PathfindingRuntimeBehavior* currentRequest;  ///< The request being computed.
+  std::unique_ptr<SearchContext> currentSearch;  ///< The search of the path of
+                                                 ///< currentRequest.
+  SearchStorage storage;  ///< The storage of the nodes of the current search.
+};
+
+const std::size_t PathfindingRequestsQueue::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+
+void PathfindingRequestsQueue::Process(
+    ScenePathfindingObstaclesManager& obstacles) {
+  // Finish the computation of the remaining paths if the budget was removed.
+  std::size_t remainingNodes = maxNodesPerFrame > 0
+                                   ? maxNodesPerFrame
+                                   : std::numeric_limits<std::size_t>::max();
+  while (remainingNodes > 0) {
+    if (!currentSearch) {
+      if (requests.empty()) return;
+
+      currentRequest = requests.front();
+      requests.pop_front();
+
+      currentSearch.reset(new SearchContext(obstacles,
+                                            currentRequest->DiagonalsAllowed(),
+                                            currentRequest->IsHierarchical(),
+                                            storage));
+      SetUpSearchContext(
+          *currentSearch, *currentRequest->object, *currentRequest);
+      currentSearch->StartSearch(currentRequest->pendingDestinationX,
+                                 currentRequest->pendingDestinationY);
+    }
+
+    SearchContext::SearchStatus status =
+        currentSearch->ContinueSearch(remainingNodes);
+    if (status == SearchContext::SearchInProgress) return;
+
+    std::vector<sf::Vector2f> computedPath;
+    if (status == SearchContext::SearchSucceeded)
+      GetPathFromCells(currentSearch->GetPathCells(),
+                       currentRequest->GetCellWidth(),
+                       currentRequest->GetCellHeight(),
+                       computedPath);
+
+    currentRequest->SetComputedPath(computedPath);
+    currentRequest = NULL;
+    currentSearch.reset();
+  }
+}
+
 PathfindingRuntimeBehavior::PathfindingRuntimeBehavior(
     const gd::SerializerElement& behaviorContent)
     : RuntimeBehavior(behaviorContent),
       parentScene(NULL),
       sceneManager(NULL),
       pathFound(false),
+      pathPending(false),
+      pendingDestinationX(0),
+      pendingDestinationY(0),
+      followingFlowField(false),
+      flowFieldDestinationX(0),
+      flowFieldDestinationY(0),
       allowDiagonals(true),
+      hierarchical(false),
+      anyAngle(false),
+      smoothPath(false),
       acceleration(400),
       maxSpeed(200),
       angularMaxSpeed(180),
@@ -416,6 +927,9 @@ PathfindingRuntimeBehavior::PathfindingRuntimeBehavior(
       currentSegment(0),
       reachedEnd(false) {
   allowDiagonals = behaviorContent.GetBoolAttribute("allowDiagonals");
+  hierarchical = behaviorContent.GetBoolAttribute("hierarchical", false);
+  anyAngle = behaviorContent.GetBoolAttribute("anyAngle", false);
+  smoothPath = behaviorContent.GetBoolAttribute("smoothPath", false);
   acceleration = behaviorContent.GetDoubleAttribute("acceleration");
   maxSpeed = behaviorContent.GetDoubleAttribute("maxSpeed");
   angularMaxSpeed = behaviorContent.GetDoubleAttribute("angularMaxSpeed");
@@ -432,13 +946,29 @@ PathfindingRuntimeBehavior::PathfindingRuntimeBehavior(
   }
 }
 
+PathfindingRuntimeBehavior::~PathfindingRuntimeBehavior() {
+  CancelPathRequest();
+}
+
+RuntimeBehavior* PathfindingRuntimeBehavior::Clone() const {
+  PathfindingRuntimeBehavior* clone = new PathfindingRuntimeBehavior(*this);
+  if (clone->pathPending)  // The path of the copy must be computed too.
+    parentScene->GetExtensionData<PathfindingRequestsQueue>().AddRequest(
+        clone);
+
+  return clone;
+}
+
 void PathfindingRuntimeBehavior::MoveTo(RuntimeScene& scene, float x, float y) {
+  CancelPathRequest();
+  followingFlowField = false;
   if (parentScene != &scene)  // Parent scene has changed
   {
     parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
+    sceneManager =
+        parentScene
+            ? &scene.GetExtensionData<ScenePathfindingObstaclesManager>()
+            : NULL;
   }
 
   path.clear();
@@ -456,36 +986,118 @@ void PathfindingRuntimeBehavior::MoveTo(RuntimeScene& scene, float x, float y) {
     return;
   }
 
+  // Let the queue compute the path during the next frames if asked to
+  PathfindingRequestsQueue& requestsQueue =
+      scene.GetExtensionData<PathfindingRequestsQueue>();
+  if (requestsQueue.maxNodesPerFrame > 0) {
+    pathFound = false;
+    pathPending = true;
+    pendingDestinationX = x;
+    pendingDestinationY = y;
+    requestsQueue.AddRequest(this);
+    return;
+  }
+
   // Start searching for a path
   // TODO: Customizable heuristic.
-  ::SearchContext ctx(*sceneManager, allowDiagonals);
-  ctx.SetCellSize(cellWidth, cellHeight)
-      .SetStartPosition(object->GetX(), object->GetY());
-  ctx.SetObjectSize(object->GetX() - object->GetDrawableX() + extraBorder,
-                    object->GetY() - object->GetDrawableY() + extraBorder,
-                    object->GetWidth() -
-                        (object->GetX() - object->GetDrawableX()) + extraBorder,
-                    object->GetHeight() -
-                        (object->GetY() - object->GetDrawableY()) +
-                        extraBorder);
-  if (ctx.ComputePathTo(x, y)) {
-    // Path found: memorize it
-    const ::Node* node = ctx.GetFinalNode();
-    while (node) {
-      path.push_back(sf::Vector2f(node->pos.x * (float)cellWidth,
-                                  node->pos.y * (float)cellHeight));
-      node = node->parent;
-    }
+  ::SearchContext ctx(*sceneManager, allowDiagonals, hierarchical);
+  SetUpSearchContext(ctx, *object, *this);
+
+  std::vector<sf::Vector2f> computedPath;
+  if (ctx.ComputePathTo(x, y))
+    GetPathFromCells(ctx.GetPathCells(), cellWidth, cellHeight, computedPath);
 
-    std::reverse(path.begin(), path.end());
-    path[0] = sf::Vector2f(object->GetX(), object->GetY());
+  SetComputedPath(computedPath);
+}
+
+void PathfindingRuntimeBehavior::MoveWithFlowField(RuntimeScene& scene,
+                                                   float x,
+                                                   float y) {
+  CancelPathRequest();
+  if (parentScene != &scene)  // Parent scene has changed
+  {
+    parentScene = &scene;
+    sceneManager =
+        parentScene
+            ? &scene.GetExtensionData<ScenePathfindingObstaclesManager>()
+            : NULL;
+  }
+
+  followingFlowField = true;
+  flowFieldDestinationX = x;
+  flowFieldDestinationY = y;
+  pathFound = UpdateFlowFieldPath(sf::Vector2f(object->GetX(), object->GetY()));
+}
+
+bool PathfindingRuntimeBehavior::UpdateFlowFieldPath(sf::Vector2f from) {
+  path.clear();
+  path.push_back(from);
+
+  sf::Vector2i cell(GDRound(from.x / (float)cellWidth),
+                    GDRound(from.y / (float)cellHeight));
+  sf::Vector2i goal(GDRound(flowFieldDestinationX / (float)cellWidth),
+                    GDRound(flowFieldDestinationY / (float)cellHeight));
+  if (cell == goal) {  // Go straight to the destination from its cell.
+    path.push_back(sf::Vector2f(flowFieldDestinationX, flowFieldDestinationY));
+    followingFlowField = false;
     EnterSegment(0);
-    pathFound = true;
+    return true;
+  }
+
+  float leftBorder, topBorder, rightBorder, bottomBorder;
+  GetObjectBorders(
+      *object, extraBorder, leftBorder, topBorder, rightBorder, bottomBorder);
+  PathfindingFlowField& flowField =
+      sceneManager
+          ->GetObstaclesGrid(cellWidth,
+                             cellHeight,
+                             leftBorder,
+                             topBorder,
+                             rightBorder,
+                             bottomBorder)
+          .GetFlowField(goal, allowDiagonals);
+
+  sf::Vector2i nextCell;
+  if (!flowField.GetNextCell(cell, nextCell)) {  // Destination unreachable
+    path.clear();
+    followingFlowField = false;
+    return false;
+  }
+
+  path.push_back(sf::Vector2f(nextCell.x * (float)cellWidth,
+                              nextCell.y * (float)cellHeight));
+  EnterSegment(0);
+  return true;
+}
+
+void PathfindingRuntimeBehavior::SetMaxNodesPerFrame(RuntimeScene& scene,
+                                                     float maxNodesPerFrame) {
+  scene.GetExtensionData<PathfindingRequestsQueue>().maxNodesPerFrame =
+      maxNodesPerFrame > 0 ? maxNodesPerFrame : 0;
+}
+
+void PathfindingRuntimeBehavior::SetComputedPath(
+    std::vector<sf::Vector2f>& computedPath) {
+  pathPending = false;
+  path.clear();
+  path.swap(computedPath);
+  if (path.empty()) {  // Not path found
+    pathFound = false;
     return;
   }
 
-  // Not path found
-  pathFound = false;
+  // Path found: memorize it
+  path[0] = sf::Vector2f(object->GetX(), object->GetY());
+  EnterSegment(0);
+  pathFound = true;
+}
+
+void PathfindingRuntimeBehavior::CancelPathRequest() {
+  if (!pathPending) return;
+
+  parentScene->GetExtensionData<PathfindingRequestsQueue>().RemoveRequest(
+      this);
+  pathPending = false;
 }
 
 void PathfindingRuntimeBehavior::EnterSegment(std::size_t segmentNumber) {
@@ -506,14 +1118,24 @@ void PathfindingRuntimeBehavior::EnterSegment(std::size_t segmentNumber) {
 void PathfindingRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   if (parentScene != &scene)  // Parent scene has changed
   {
+    CancelPathRequest();
     parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
+    sceneManager =
+        parentScene
+            ? &scene.GetExtensionData<ScenePathfindingObstaclesManager>()
+            : NULL;
   }
 
   if (!sceneManager) return;
 
+  // Continue the computation of the paths of the scene, once per frame.
+  PathfindingRequestsQueue& requestsQueue =
+      scene.GetExtensionData<PathfindingRequestsQueue>();
+  if (!requestsQueue.processed) {
+    requestsQueue.processed = true;
+    requestsQueue.Process(*sceneManager);
+  }
+
   if (path.empty() || reachedEnd) return;
 
   // Update the speed of the object
@@ -525,8 +1147,14 @@ void PathfindingRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 
   // Update the time on the segment and change segment if needed
   timeOnSegment += speed * timeDelta;
-  if (timeOnSegment >= totalSegmentTime && currentSegment < path.size())
-    EnterSegment(currentSegment + 1);
+  if (timeOnSegment >= totalSegmentTime && currentSegment < path.size()) {
+    if (followingFlowField) {
+      // Continue to the next cell given by the flow field.
+      pathFound = UpdateFlowFieldPath(path.back());
+      if (!pathFound) return;
+    } else
+      EnterSegment(currentSegment + 1);
+  }
 
   // Position object on the segment and update its angle
   sf::Vector2f newPos;
@@ -552,11 +1180,16 @@ void PathfindingRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 void PathfindingRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
   if (parentScene != &scene)  // Parent scene has changed
   {
+    CancelPathRequest();
     parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
+    sceneManager =
+        parentScene
+            ? &scene.GetExtensionData<ScenePathfindingObstaclesManager>()
+            : NULL;
   }
+
+  scene.GetExtensionData<PathfindingRequestsQueue>().processed =
+      false;  // Prepare for a new frame
 }
 
 float PathfindingRuntimeBehavior::GetNodeX(std::size_t index) const {
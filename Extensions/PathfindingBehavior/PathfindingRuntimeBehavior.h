@@ -17,6 +17,7 @@ class Layout;
 class RuntimeScene;
 class PlatformBehavior;
 class ScenePathfindingObstaclesManager;
+class PathfindingRequestsQueue;
 namespace gd {
 class SerializerElement;
 }
@@ -28,20 +29,59 @@ class RuntimeScenePlatformData;
 class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
  public:
   PathfindingRuntimeBehavior(const gd::SerializerElement& behaviorContent);
-  virtual ~PathfindingRuntimeBehavior(){};
-  virtual RuntimeBehavior* Clone() const { return new PathfindingRuntimeBehavior(*this); }
+  virtual ~PathfindingRuntimeBehavior();
+  virtual RuntimeBehavior* Clone() const;
 
   /**
    * \brief Compute and move on the path to the specified destination.
+   *
+   * The path is computed immediately, unless a budget was set with
+   * SetMaxNodesPerFrame: the path is then computed during the next frames
+   * (see IsPathPending).
    */
   void MoveTo(RuntimeScene& scene, float x, float y);
 
+  /**
+   * \brief Set the maximum number of nodes explored at each frame to compute
+   * the paths of the objects of the scene.
+   *
+   * When set, paths requested with MoveTo are queued and computed over several
+   * frames, so that a lot of paths requested at once don't slow down a frame.
+   * \param maxNodesPerFrame The number of nodes, or 0 to compute the paths
+   * immediately (default).
+   */
+  void SetMaxNodesPerFrame(RuntimeScene& scene, float maxNodesPerFrame);
+
+  /**
+   * \brief Move to the specified destination by following the flow field
+   * leading to it, shared by all the objects moving to the same destination.
+   *
+   * This is faster than computing a path for each object when a lot of objects
+   * are moving to the same destination. The path only contains the next cell
+   * to move to, and is updated each time a cell is reached.
+   * \see PathfindingFlowField
+   */
+  void MoveWithFlowField(RuntimeScene& scene, float x, float y);
+
   // Path information:
   /**
    * \brief Return true if the latest call to MoveTo succeeded.
+   * \note Return false while the path is being computed.
    */
   bool PathFound() { return pathFound; }
 
+  /**
+   * \brief Return true if the path requested by the latest call to MoveTo is
+   * still being computed.
+   */
+  bool IsPathPending() { return pathPending; }
+
+  /**
+   * \brief Return true if the object is moving with MoveWithFlowField and has
+   * not reached its destination yet.
+   */
+  bool IsFollowingFlowField() { return followingFlowField; }
+
   /**
    * \brief Return true if the object reached its destination
    */
@@ -60,6 +100,9 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
 
   // Configuration:
   bool DiagonalsAllowed() { return allowDiagonals; };
+  bool IsHierarchical() { return hierarchical; };
+  bool IsAnyAngle() { return anyAngle; };
+  bool IsPathSmoothed() { return smoothPath; };
   float GetAcceleration() { return acceleration; };
   float GetMaxSpeed() { return maxSpeed; };
   float GetAngularMaxSpeed() { return angularMaxSpeed; };
@@ -72,6 +115,9 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   void SetAllowDiagonals(bool allowDiagonals_) {
     allowDiagonals = allowDiagonals_;
   };
+  void SetHierarchical(bool hierarchical_) { hierarchical = hierarchical_; };
+  void SetAnyAngle(bool anyAngle_) { anyAngle = anyAngle_; };
+  void SetSmoothPath(bool smoothPath_) { smoothPath = smoothPath_; };
   void SetAcceleration(float acceleration_) { acceleration = acceleration_; };
   void SetMaxSpeed(float maxSpeed_) { maxSpeed = maxSpeed_; };
   void SetAngularMaxSpeed(float angularMaxSpeed_) {
@@ -91,14 +137,45 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   virtual void DoStepPostEvents(RuntimeScene& scene);
   void EnterSegment(std::size_t segmentNumber);
 
+  /**
+   * \brief Start moving on the computed path, or stop if \a computedPath is
+   * empty (no path was found).
+   * \note \a computedPath is emptied.
+   */
+  void SetComputedPath(std::vector<sf::Vector2f>& computedPath);
+
+  /**
+   * \brief Remove the path request from the queue of the scene, if any.
+   */
+  void CancelPathRequest();
+
+  /**
+   * \brief Set the path to the next cell given by the flow field, starting
+   * from the specified position.
+   * \return false, and clear the path, if the destination can't be reached.
+   */
+  bool UpdateFlowFieldPath(sf::Vector2f from);
+
   RuntimeScene* parentScene;  ///< The scene the object belongs to.
   ScenePathfindingObstaclesManager*
       sceneManager;  ///< The platform objects manager associated to the scene.
   std::vector<sf::Vector2f> path;  ///< The computed path
   bool pathFound;
+  bool pathPending;  ///< True if the path is queued to be computed.
+  float pendingDestinationX;  ///< The destination of the path being computed.
+  float pendingDestinationY;  ///< The destination of the path being computed.
+  bool followingFlowField;  ///< True if the path is given by a flow field.
+  float flowFieldDestinationX;
+  float flowFieldDestinationY;
 
   // Behavior configuration:
   bool allowDiagonals;
+  bool hierarchical;  ///< If true, long paths are computed quickly on clusters
+                      ///< of cells (the path may not be the shortest one).
+  bool anyAngle;  ///< If true, paths go straight between the cells in sight
+                  ///< of each other (Theta*), instead of following the cells.
+  bool smoothPath;  ///< If true, the cells that can be skipped by going
+                    ///< straight are removed from the computed paths.
   float acceleration;
   float maxSpeed;
   float angularMaxSpeed;
@@ -117,5 +194,7 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   float totalSegmentTime;
   std::size_t currentSegment;
   bool reachedEnd;
+
+  friend class PathfindingRequestsQueue;
 };
 #endif  // PATHFINDINGRUNTIMEBEHAVIOR_H
@@ -6,25 +6,165 @@ This project is released under the MIT License.
 */
 #include "ScenePathfindingObstaclesManager.h"
 #include <iostream>
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "PathfindingObstacleRuntimeBehavior.h"
 
-std::map<RuntimeScene*, ScenePathfindingObstaclesManager>
-    ScenePathfindingObstaclesManager::managers;
+const std::size_t ScenePathfindingObstaclesManager::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+
+const std::size_t ScenePathfindingObstaclesManager::maxGridsCount = 16;
 
 ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager() {
-  for (std::set<PathfindingObstacleRuntimeBehavior*>::iterator it =
-           allObstacles.begin();
-       it != allObstacles.end();
-       ++it) {
-    (*it)->Activate(false);
+  // Deactivating an obstacle removes it from allObstacles: move to the next
+  // obstacle before.
+  std::set<PathfindingObstacleRuntimeBehavior*>::iterator it =
+      allObstacles.begin();
+  while (it != allObstacles.end()) {
+    PathfindingObstacleRuntimeBehavior* obstacle = *it;
+    ++it;
+    obstacle->Activate(false);
   }
 }
 
 void ScenePathfindingObstaclesManager::AddObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.insert(obstacle);
+
+  // An object with more than one obstacle behavior is only stored once.
+  RuntimeObject* object = obstacle->GetObject();
+  objectsObstacles[object] = obstacle;
+  staticObstaclesHash.Remove(object);
+  dynamicObstaclesHash.Remove(object);
+  if (obstacle->IsStatic()) {
+    staticObstacles[obstacle] = GetObstacleState(obstacle);
+    staticObstaclesHash.Update(object);
+    for (auto& grid : grids) grid->UpdateObstacle(obstacle);
+  } else {
+    dynamicObstacles.insert(obstacle);
+    dynamicObstaclesHash.Update(object);
+  }
 }
 void ScenePathfindingObstaclesManager::RemoveObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.erase(obstacle);
+  dynamicObstacles.erase(obstacle);
+  staticObstacles.erase(obstacle);
+  for (auto& grid : grids) grid->RemoveObstacle(obstacle);
+
+  RuntimeObject* object = obstacle->GetObject();
+  auto it = objectsObstacles.find(object);
+  if (it == objectsObstacles.end() || it->second != obstacle) return;
+
+  objectsObstacles.erase(it);
+  staticObstaclesHash.Remove(object);
+  dynamicObstaclesHash.Remove(object);
+}
+
+void ScenePathfindingObstaclesManager::UpdateStaticObstacle(
+    PathfindingObstacleRuntimeBehavior* obstacle) {
+  auto it = staticObstacles.find(obstacle);
+  if (it == staticObstacles.end()) return;
+
+  ObstacleState state = GetObstacleState(obstacle);
+  if (state == it->second) return;
+
+  it->second = state;
+  RuntimeObject* object = obstacle->GetObject();
+  auto objectIt = objectsObstacles.find(object);
+  if (objectIt != objectsObstacles.end() && objectIt->second == obstacle)
+    staticObstaclesHash.Update(object);
+
+  for (auto& grid : grids) grid->UpdateObstacle(obstacle);
+}
+
+void ScenePathfindingObstaclesManager::QueryObstaclesInRect(
+    float x,
+    float y,
+    float width,
+    float height,
+    std::vector<PathfindingObstacleRuntimeBehavior*>& result) {
+  result.clear();
+
+  // Obstacles that are not static can be moved at any time by events.
+  for (PathfindingObstacleRuntimeBehavior* obstacle : dynamicObstacles) {
+    RuntimeObject* object = obstacle->GetObject();
+    if (objectsObstacles[object] == obstacle)
+      dynamicObstaclesHash.Update(object);
+  }
+
+  auto addObstacle = [this, &result](RuntimeObject* object) {
+    auto it = objectsObstacles.find(object);
+    if (it != objectsObstacles.end()) result.push_back(it->second);
+  };
+  sf::FloatRect area(x, y, width, height);
+  staticObstaclesHash.ForEachObjectInAABB(area, addObstacle);
+  dynamicObstaclesHash.ForEachObjectInAABB(area, addObstacle);
+}
+
+ScenePathfindingObstaclesManager::ObstacleState
+ScenePathfindingObstaclesManager::GetObstacleState(
+    const PathfindingObstacleRuntimeBehavior* obstacle) {
+  RuntimeObject* object = obstacle->GetObject();
+  ObstacleState state;
+  state.x = object->GetDrawableX();
+  state.y = object->GetDrawableY();
+  state.width = object->GetWidth();
+  state.height = object->GetHeight();
+  state.angle = object->GetAngle();
+  state.cost = obstacle->GetCost();
+  state.impassable = obstacle->IsImpassable();
+  return state;
+}
+
+PathfindingObstaclesGrid& ScenePathfindingObstaclesManager::GetObstaclesGrid(
+    float cellWidth,
+    float cellHeight,
+    float leftBorder,
+    float topBorder,
+    float rightBorder,
+    float bottomBorder) {
+  PathfindingObstaclesGrid* grid = NULL;
+  for (auto& existingGrid : grids) {
+    if (existingGrid->HasParameters(cellWidth,
+                                    cellHeight,
+                                    leftBorder,
+                                    topBorder,
+                                    rightBorder,
+                                    bottomBorder)) {
+      grid = existingGrid.get();
+      break;
+    }
+  }
+
+  if (!grid) {
+    // Discard the grid not used for the longest time if there are too many.
+    if (grids.size() >= maxGridsCount) {
+      std::size_t oldest = 0;
+      for (std::size_t i = 1; i < grids.size(); ++i)
+        if (grids[i]->lastUseId < grids[oldest]->lastUseId) oldest = i;
+
+      grids.erase(grids.begin() + oldest);
+    }
+
+    grids.push_back(std::unique_ptr<PathfindingObstaclesGrid>(
+        new PathfindingObstaclesGrid(cellWidth,
+                                     cellHeight,
+                                     leftBorder,
+                                     topBorder,
+                                     rightBorder,
+                                     bottomBorder)));
+    grid = grids.back().get();
+
+    // Static obstacles are then only updated when they change.
+    for (auto& it : staticObstacles) grid->UpdateObstacle(it.first);
+  }
+
+  // Other obstacles can be moved at any time by events: refresh them in the
+  // grid (only the obstacles covering other cells than before are rasterized
+  // again).
+  for (PathfindingObstacleRuntimeBehavior* obstacle : dynamicObstacles)
+    grid->UpdateObstacle(obstacle);
+
+  grid->lastUseId = ++lastGridUseId;
+  return *grid;
 }
@@ -7,25 +7,39 @@ This project is released under the MIT License.
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+#include "PathfindingObstaclesGrid.h"
 class PathfindingObstacleRuntimeBehavior;
+class RuntimeObject;
 
 /**
  * \brief Contains lists of all obstacle related objects of a scene.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * The manager also caches the grids of costs used to compute paths (one for
+ * each cell size and object size), so that they are not recomputed from all
+ * the obstacles for each cell visited when searching for a path.
+ *
+ * Obstacles are stored in spatial hashes (see QueryObstaclesInRect). Static
+ * obstacles are kept apart: they are indexed, and rasterized in the grids,
+ * only when they are added or changed (see UpdateStaticObstacle), while the
+ * other obstacles are refreshed each time they are used, as they can be moved
+ * at any time by events.
+ *
+ * The manager of a scene is stored in the scene (see
+ * RuntimeScene::GetExtensionData).
  */
-class ScenePathfindingObstaclesManager {
+class ScenePathfindingObstaclesManager : public RuntimeSceneExtensionData {
  public:
-  /**
-   * \brief Map containing, for each RuntimeScene, its associated
-   * ScenePathfindingObstaclesManager.
-   */
-  static std::map<RuntimeScene*, ScenePathfindingObstaclesManager> managers;
+  static const std::size_t sceneDataIndex;  ///< The slot of the managers in
+                                            ///< the scenes.
 
-  ScenePathfindingObstaclesManager(){};
+  ScenePathfindingObstaclesManager() : lastGridUseId(0){};
   virtual ~ScenePathfindingObstaclesManager();
 
   /**
@@ -40,6 +54,26 @@ class ScenePathfindingObstaclesManager {
    */
   void RemoveObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
 
+  /**
+   * \brief Notify the manager that a static obstacle may have moved or
+   * changed.
+   * \note Cheap if the position, size and cost of the obstacle did not change.
+   */
+  void UpdateStaticObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
+
+  /**
+   * \brief Get the obstacles having an AABB overlapping or touching the
+   * specified rectangle.
+   * \param result The vector where the obstacles are stored. It is cleared
+   * before adding the obstacles, so that its memory can be reused.
+   */
+  void QueryObstaclesInRect(
+      float x,
+      float y,
+      float width,
+      float height,
+      std::vector<PathfindingObstacleRuntimeBehavior*>& result);
+
   /**
    * \brief Get a read only access to the list of all obstacles
    */
@@ -47,9 +81,64 @@ class ScenePathfindingObstaclesManager {
     return allObstacles;
   }
 
+  /**
+   * \brief Get the grid of costs for the specified cell size and borders of
+   * the object moving on the grid.
+   *
+   * The grid is created if needed, and the obstacles that moved or changed
+   * since the last call are updated in the grid.
+   * \warning The returned reference is only valid until the next call.
+   */
+  PathfindingObstaclesGrid& GetObstaclesGrid(float cellWidth,
+                                             float cellHeight,
+                                             float leftBorder,
+                                             float topBorder,
+                                             float rightBorder,
+                                             float bottomBorder);
+
  private:
+  /**
+   * \brief The position, size and cost of an obstacle, used to know if a
+   * static obstacle changed.
+   */
+  struct ObstacleState {
+    float x;
+    float y;
+    float width;
+    float height;
+    float angle;
+    float cost;
+    bool impassable;
+
+    bool operator==(const ObstacleState& other) const {
+      return x == other.x && y == other.y && width == other.width &&
+             height == other.height && angle == other.angle &&
+             cost == other.cost && impassable == other.impassable;
+    }
+  };
+
+  static ObstacleState GetObstacleState(
+      const PathfindingObstacleRuntimeBehavior* obstacle);
+
   std::set<PathfindingObstacleRuntimeBehavior*>
       allObstacles;  ///< The list of all obstacles of the scene.
+  std::set<PathfindingObstacleRuntimeBehavior*>
+      dynamicObstacles;  ///< The obstacles that are not static.
+  std::unordered_map<PathfindingObstacleRuntimeBehavior*, ObstacleState>
+      staticObstacles;  ///< The static obstacles, with their state when they
+                        ///< were last indexed.
+  ObjectsSpatialHash staticObstaclesHash;  ///< The objects of the static
+                                           ///< obstacles, by position.
+  ObjectsSpatialHash dynamicObstaclesHash;  ///< The objects of the other
+                                            ///< obstacles, by position.
+  std::unordered_map<const RuntimeObject*, PathfindingObstacleRuntimeBehavior*>
+      objectsObstacles;  ///< The obstacle registered in the hashes for each
+                         ///< object.
+  std::vector<std::unique_ptr<PathfindingObstaclesGrid>>
+      grids;                  ///< The grids used recently to compute paths.
+  std::size_t lastGridUseId;  ///< Incremented each time a grid is used.
+
+  static const std::size_t maxGridsCount;
 };
 
 #endif
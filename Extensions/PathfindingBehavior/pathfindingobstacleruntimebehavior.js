@@ -16,8 +16,13 @@ gdjs.PathfindingObstaclesManager = function(runtimeScene)
 {
     this._obstaclesHSHG = new gdjs.HSHG.HSHG();
     //this._hshgNeedUpdate = true; Useless: The behaviors track by themselves changes in objects size or position.
+
+    this._flowFields = {}; //The flow fields computed since the obstacles last changed (see getFlowField).
+    this._flowFieldsCount = 0;
 };
 
+gdjs.PathfindingObstaclesManager.maxFlowFieldsCount = 16;
+
 /**
  * Get the obstacles manager of a scene.
  */
@@ -34,6 +39,7 @@ gdjs.PathfindingObstaclesManager.getManager = function(runtimeScene) {
  */
 gdjs.PathfindingObstaclesManager.prototype.addObstacle = function(pathfindingObstacleBehavior) {
     this._obstaclesHSHG.addObject(pathfindingObstacleBehavior);
+    this.obstacleChanged();
 };
 
 /**
@@ -42,6 +48,42 @@ gdjs.PathfindingObstaclesManager.prototype.addObstacle = function(pathfindingObs
  */
 gdjs.PathfindingObstaclesManager.prototype.removeObstacle = function(pathfindingObstacleBehavior) {
     this._obstaclesHSHG.removeObject(pathfindingObstacleBehavior);
+    this.obstacleChanged();
+};
+
+/**
+ * Notify the manager that an obstacle was added, removed, moved or changed, so that
+ * the flow fields computed before are discarded.
+ */
+gdjs.PathfindingObstaclesManager.prototype.obstacleChanged = function() {
+    if (this._flowFieldsCount === 0) return;
+
+    this._flowFields = {};
+    this._flowFieldsCount = 0;
+};
+
+/**
+ * Get the flow field stored with the specified key, if the obstacles did not change
+ * since it was stored.
+ * @param key The key identifying the goal and the settings of the flow field.
+ * @return The flow field, or null if there is no flow field for this key.
+ */
+gdjs.PathfindingObstaclesManager.prototype.getFlowField = function(key) {
+    return this._flowFields.hasOwnProperty(key) ? this._flowFields[key] : null;
+};
+
+/**
+ * Store a flow field, to be shared by all the objects moving to its goal.
+ * @param key The key identifying the goal and the settings of the flow field.
+ */
+gdjs.PathfindingObstaclesManager.prototype.setFlowField = function(key, flowField) {
+    if (this._flowFieldsCount >= gdjs.PathfindingObstaclesManager.maxFlowFieldsCount) {
+        this._flowFields = {};
+        this._flowFieldsCount = 0;
+    }
+
+    this._flowFields[key] = flowField;
+    this._flowFieldsCount++;
 };
 
 /**
@@ -183,6 +225,7 @@ gdjs.PathfindingObstacleRuntimeBehavior.prototype.getCost = function() {
 
 gdjs.PathfindingObstacleRuntimeBehavior.prototype.setCost = function(cost) {
     this._cost = cost;
+    if (this._registeredInManager) this._manager.obstacleChanged();
 };
 
 gdjs.PathfindingObstacleRuntimeBehavior.prototype.isImpassable = function() {
@@ -191,4 +234,5 @@ gdjs.PathfindingObstacleRuntimeBehavior.prototype.isImpassable = function() {
 
 gdjs.PathfindingObstacleRuntimeBehavior.prototype.setImpassable = function(impassable) {
     this._impassable = impassable;
+    if (this._registeredInManager) this._manager.obstacleChanged();
 };
@@ -38,6 +38,9 @@ gdjs.PathfindingRuntimeBehavior = function(runtimeScene, behaviorData, owner)
     this._totalSegmentTime = 0;
     this._currentSegment = 0;
     this._reachedEnd = false;
+    this._followingFlowField = false; //True if the path is given by a flow field (see moveWithFlowField).
+    this._flowFieldDestinationX = 0;
+    this._flowFieldDestinationY = 0;
 
     this._manager = gdjs.PathfindingObstaclesManager.getManager(runtimeScene);
 
@@ -181,12 +184,21 @@ gdjs.PathfindingRuntimeBehavior.prototype.destinationReached = function() {
     return this._reachedEnd;
 };
 
+/**
+ * Return true if the object is moving with moveWithFlowField and has not reached its
+ * destination yet.
+ */
+gdjs.PathfindingRuntimeBehavior.prototype.isFollowingFlowField = function() {
+    return this._followingFlowField;
+};
+
 /**
  * Compute and move on the path to the specified destination.
  */
 gdjs.PathfindingRuntimeBehavior.prototype.moveTo = function(runtimeScene, x, y)
 {
     var owner = this.owner;
+    this._followingFlowField = false;
 
     //First be sure that there is a path to compute.
     var targetCellX = Math.round(x/this._cellWidth);
@@ -245,6 +257,79 @@ gdjs.PathfindingRuntimeBehavior.prototype.moveTo = function(runtimeScene, x, y)
     this._pathFound = false;
 };
 
+/**
+ * Move to the specified destination by following the flow field leading to it, shared
+ * by all the objects moving to the same destination.
+ *
+ * This is faster than computing a path for each object when a lot of objects are moving
+ * to the same destination. The path only contains the next cell to move to, and is
+ * updated each time a cell is reached.
+ */
+gdjs.PathfindingRuntimeBehavior.prototype.moveWithFlowField = function(runtimeScene, x, y)
+{
+    this._followingFlowField = true;
+    this._flowFieldDestinationX = x;
+    this._flowFieldDestinationY = y;
+    this._pathFound = this._updateFlowFieldPath(this.owner.getX(), this.owner.getY());
+};
+
+/**
+ * Set the path to the next cell given by the flow field, starting from the specified
+ * position.
+ * @return false, and clear the path, if the destination can't be reached.
+ */
+gdjs.PathfindingRuntimeBehavior.prototype._updateFlowFieldPath = function(fromX, fromY)
+{
+    var owner = this.owner;
+    while (this._path.length < 2) this._path.push([0, 0]);
+    this._path.length = 2;
+    this._path[0][0] = fromX;
+    this._path[0][1] = fromY;
+
+    var cellX = Math.round(fromX/this._cellWidth);
+    var cellY = Math.round(fromY/this._cellHeight);
+    var goalX = Math.round(this._flowFieldDestinationX/this._cellWidth);
+    var goalY = Math.round(this._flowFieldDestinationY/this._cellHeight);
+    if ( cellX === goalX && cellY === goalY ) { //Go straight to the destination from its cell.
+        this._path[1][0] = this._flowFieldDestinationX;
+        this._path[1][1] = this._flowFieldDestinationY;
+        this._followingFlowField = false;
+        this._enterSegment(0);
+        return true;
+    }
+
+    var leftBorder = owner.getX()-owner.getDrawableX()+this._extraBorder;
+    var topBorder = owner.getY()-owner.getDrawableY()+this._extraBorder;
+    var rightBorder = owner.getWidth()-(owner.getX()-owner.getDrawableX())+this._extraBorder;
+    var bottomBorder = owner.getHeight()-(owner.getY()-owner.getDrawableY())+this._extraBorder;
+    var key = goalX+";"+goalY+";"+this._cellWidth+";"+this._cellHeight+";"+leftBorder+";"+
+        topBorder+";"+rightBorder+";"+bottomBorder+";"+this._allowDiagonals;
+
+    var flowField = this._manager.getFlowField(key);
+    if (!flowField) {
+        var searchContext = new gdjs.PathfindingRuntimeBehavior.SearchContext();
+        searchContext.allowDiagonals(this._allowDiagonals);
+        searchContext.setObstacles(this._manager);
+        searchContext.setCellSize(this._cellWidth, this._cellHeight);
+        searchContext.setObjectSize(leftBorder, topBorder, rightBorder, bottomBorder);
+
+        flowField = new gdjs.PathfindingRuntimeBehavior.FlowField(searchContext, goalX, goalY);
+        this._manager.setFlowField(key, flowField);
+    }
+
+    var nextCell = flowField.getNextCell(cellX, cellY);
+    if (nextCell === null) { //Destination unreachable
+        this._path.length = 0;
+        this._followingFlowField = false;
+        return false;
+    }
+
+    this._path[1][0] = nextCell[0]*this._cellWidth;
+    this._path[1][1] = nextCell[1]*this._cellHeight;
+    this._enterSegment(0);
+    return true;
+};
+
 gdjs.PathfindingRuntimeBehavior.prototype._enterSegment = function(segmentNumber)
 {
     if (this._path.length === 0) return;
@@ -275,8 +360,15 @@ gdjs.PathfindingRuntimeBehavior.prototype.doStepPreEvents = function(runtimeScen
 
     //Update the time on the segment and change segment if needed
     this._timeOnSegment += this._speed*timeDelta;
-    if (this._timeOnSegment >= this._totalSegmentTime && this._currentSegment < this._path.length)
-        this._enterSegment(this._currentSegment + 1);
+    if (this._timeOnSegment >= this._totalSegmentTime && this._currentSegment < this._path.length) {
+        if (this._followingFlowField) { //Continue to the next cell given by the flow field.
+            var lastNode = this._path[this._path.length-1];
+            this._pathFound = this._updateFlowFieldPath(lastNode[0], lastNode[1]);
+            if (!this._pathFound) return;
+        }
+        else
+            this._enterSegment(this._currentSegment + 1);
+    }
 
     //Position object on the segment and update its angle
     var newPos = [0, 0];
@@ -532,6 +624,19 @@ gdjs.PathfindingRuntimeBehavior.SearchContext.prototype._getNode = function(xPos
         newNode = new gdjs.PathfindingRuntimeBehavior.Node(xPos, yPos);
 
     //...and update its cost according to obstacles
+    newNode.cost = this._getCellCost(xPos, yPos);
+
+    this._allNodes[xPos][yPos] = newNode;
+    return newNode;
+};
+
+/**
+ * Compute the cost of moving on a cell, from the objects flagged as obstacles.
+ * @return -1 if the cell is impassable.
+ */
+gdjs.PathfindingRuntimeBehavior.SearchContext.prototype._getCellCost = function(xPos, yPos)
+{
+    var cost = 0;
     var objectsOnCell = false;
     var radius = this._cellHeight > this._cellWidth ? this._cellHeight*2 : this._cellWidth*2;
     this._obstacles.getAllObstaclesAround(xPos*this._cellWidth, yPos*this._cellHeight,
@@ -547,19 +652,16 @@ gdjs.PathfindingRuntimeBehavior.SearchContext.prototype._getNode = function(xPos
             && topLeftCellY < yPos && yPos < bottomRightCellY) {
 
             objectsOnCell = true;
-            if ( this._closeObstacles[k].isImpassable() ) {
-                newNode.cost = -1;
-                break; //The cell is impassable, stop here.
-            }
+            if ( this._closeObstacles[k].isImpassable() )
+                return -1; //The cell is impassable, stop here.
             else //Superimpose obstacles
-                newNode.cost += this._closeObstacles[k].getCost();
+                cost += this._closeObstacles[k].getCost();
         }
     }
 
-    if (!objectsOnCell) newNode.cost = 1; //Default cost when no objects put on the cell.
+    if (!objectsOnCell) return 1; //Default cost when no objects put on the cell.
 
-    this._allNodes[xPos][yPos] = newNode;
-    return newNode;
+    return cost;
 };
 
 /**
@@ -601,3 +703,191 @@ gdjs.PathfindingRuntimeBehavior.SearchContext.prototype._addOrUpdateNode = funct
         }
     }
 };
+
+/**
+ * Internal tool class storing the cost of the shortest path from each cell to a goal
+ * cell, and the direction to follow to get closer to the goal.
+ *
+ * The field is shared by all the objects moving to the same goal: it is computed with
+ * a Dijkstra search started from the goal, which is only continued when an object asks
+ * for a cell not explored yet.
+ *
+ * @param searchContext The search context used to get the costs of the cells.
+ */
+gdjs.PathfindingRuntimeBehavior.FlowField = function(searchContext, goalX, goalY)
+{
+    this._searchContext = searchContext;
+    this._allowDiagonals = searchContext._allowDiagonals;
+    this._cells = {}; //The cells explored so far, indexed by their position.
+    this._openCells = []; //A binary heap of the cells to explore, with their distance (possibly outdated).
+    this._settledCount = 0;
+    this._nextCell = [0, 0]; //Returned by getNextCell.
+
+    var goalCell = this._getCell(goalX, goalY);
+    if (goalCell.cost < 0) return; //The goal can't be reached.
+
+    goalCell.distance = 0;
+    goalCell.nextX = goalX;
+    goalCell.nextY = goalY;
+    this._pushOpenCell(0, goalCell);
+};
+
+gdjs.PathfindingRuntimeBehavior.FlowField.maxSettledCells = 256*256;
+
+/**
+ * Get the cell to move to from the specified cell to get closer to the goal. If the
+ * cell is impassable, the best cell around it is returned.
+ * @return An array containing the position of the next cell (the goal itself if the cell
+ * is the goal), or null if the goal can't be reached from the cell. The array is reused.
+ */
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype.getNextCell = function(x, y)
+{
+    if (this._getCell(x, y).cost < 0) {
+        //Get out of the impassable cell by the cell closest to the goal.
+        var bestDistance = -1;
+        for (var offsetX = -1; offsetX <= 1; ++offsetX) {
+            for (var offsetY = -1; offsetY <= 1; ++offsetY) {
+                if (offsetX === 0 && offsetY === 0) continue;
+                if (!this._allowDiagonals && offsetX !== 0 && offsetY !== 0) continue;
+
+                var distance = this.getDistance(x + offsetX, y + offsetY);
+                if (distance >= 0 && (bestDistance < 0 || distance < bestDistance)) {
+                    bestDistance = distance;
+                    this._nextCell[0] = x + offsetX;
+                    this._nextCell[1] = y + offsetY;
+                }
+            }
+        }
+
+        return bestDistance >= 0 ? this._nextCell : null;
+    }
+
+    var cell = this._settle(x, y);
+    if (cell === null) return null;
+
+    this._nextCell[0] = cell.nextX;
+    this._nextCell[1] = cell.nextY;
+    return this._nextCell;
+};
+
+/**
+ * Get the cost of the shortest path from the cell to the goal.
+ * @return -1 if the goal can't be reached from the cell.
+ */
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype.getDistance = function(x, y)
+{
+    if (this._getCell(x, y).cost < 0) return -1;
+
+    var cell = this._settle(x, y);
+    return cell !== null ? cell.distance : -1;
+};
+
+/**
+ * Get (or dynamically construct) a cell, with its cost read from the obstacles.
+ */
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype._getCell = function(x, y)
+{
+    var key = x+";"+y;
+    if (this._cells.hasOwnProperty(key)) return this._cells[key];
+
+    var cell = {
+        x: x,
+        y: y,
+        cost: this._searchContext._getCellCost(x, y),
+        distance: -1, //The smallest cost found so far (-1 if none).
+        nextX: x, //The cell to move to from this cell.
+        nextY: y,
+        settled: false //True if distance is the cost of the shortest path.
+    };
+    this._cells[key] = cell;
+    return cell;
+};
+
+/**
+ * Continue the search until the specified cell is reached.
+ * @return The cell, or null if it can't be reached.
+ */
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype._settle = function(x, y)
+{
+    var target = this._getCell(x, y);
+    if (target.settled) return target;
+
+    while (this._openCells.length !== 0 &&
+        this._settledCount < gdjs.PathfindingRuntimeBehavior.FlowField.maxSettledCells)
+    {
+        var openCell = this._popOpenCell();
+        var cell = openCell.cell;
+        if (cell.settled || openCell.distance > cell.distance)
+            continue; //Outdated entry, the cell was reached by a shorter path.
+
+        cell.settled = true;
+        this._settledCount++;
+
+        this._exploreNeighbor(cell, 1, 0, 1);
+        this._exploreNeighbor(cell, -1, 0, 1);
+        this._exploreNeighbor(cell, 0, 1, 1);
+        this._exploreNeighbor(cell, 0, -1, 1);
+        if ( this._allowDiagonals ) {
+            this._exploreNeighbor(cell, 1, 1, 1.414213562);
+            this._exploreNeighbor(cell, 1, -1, 1.414213562);
+            this._exploreNeighbor(cell, -1, -1, 1.414213562);
+            this._exploreNeighbor(cell, -1, 1, 1.414213562);
+        }
+
+        if (cell === target) return target;
+    }
+
+    return null;
+};
+
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype._exploreNeighbor = function(fromCell, offsetX, offsetY, factor)
+{
+    var cell = this._getCell(fromCell.x + offsetX, fromCell.y + offsetY);
+    if (cell.cost < 0 || cell.settled) return; //cost < 0 means impassable obstacle
+
+    //Costs are the same as the ones used by A* (see SearchContext).
+    var distance = fromCell.distance + (fromCell.cost+cell.cost)/2.0*factor;
+    if (cell.distance === -1 || distance < cell.distance) {
+        cell.distance = distance;
+        cell.nextX = fromCell.x;
+        cell.nextY = fromCell.y;
+        this._pushOpenCell(distance, cell);
+    }
+};
+
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype._pushOpenCell = function(distance, cell)
+{
+    var heap = this._openCells;
+    var entry = {distance: distance, cell: cell};
+    var i = heap.length;
+    heap.push(entry);
+    while (i > 0) {
+        var parent = (i - 1) >> 1;
+        if (heap[parent].distance <= distance) break;
+
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = entry;
+};
+
+gdjs.PathfindingRuntimeBehavior.FlowField.prototype._popOpenCell = function()
+{
+    var heap = this._openCells;
+    var top = heap[0];
+    var last = heap.pop();
+    if (heap.length === 0) return top;
+
+    var i = 0;
+    while (true) {
+        var child = 2 * i + 1;
+        if (child >= heap.length) break;
+        if (child + 1 < heap.length && heap[child + 1].distance < heap[child].distance) child++;
+        if (heap[child].distance >= last.distance) break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    return top;
+};
@@ -12,6 +12,7 @@ This project is released under the MIT License.
 #include "../PathfindingObstacleBehavior.h"
 #include "../PathfindingObstacleRuntimeBehavior.h"
 #include "../PathfindingRuntimeBehavior.h"
+#include "../ScenePathfindingObstaclesManager.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
@@ -149,6 +150,343 @@ TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
     REQUIRE(runtimeBehavior->PathFound() == true);
     REQUIRE(runtimeBehavior->GetNodeCount() == 92);
   }
+  SECTION("Obstacles moved and removed") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+
+    obstacle->SetX(1100);
+    obstacle->SetY(1200);
+    obstacle->SetWidth(200);
+    obstacle->SetHeight(200);
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    // Move the obstacle away, without stepping the scene
+    obstacle->SetX(2000);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+
+    // Move it back, then remove it
+    obstacle->SetX(1100);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    scene.objectsInstances.RemoveObject(obstacle);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+  }
+  SECTION("Static and moving obstacles queried by position") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+
+    gd::SerializerElement staticObstacleContent;
+    PathfindingObstacleBehavior obstacleBehavior;
+    obstacleBehavior.InitializeContent(staticObstacleContent);
+    staticObstacleContent.SetAttribute("static", true);
+
+    auto *staticObstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    staticObstacle->SetX(1100);
+    staticObstacle->SetY(1200);
+    staticObstacle->SetWidth(200);
+    staticObstacle->SetHeight(200);
+    staticObstacle->AddBehavior(
+        "PathfindingObstacle",
+        gd::make_unique<PathfindingObstacleRuntimeBehavior>(
+            staticObstacleContent));
+
+    auto *movingObstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    movingObstacle->SetX(500);
+    movingObstacle->SetY(500);
+    movingObstacle->SetWidth(100);
+    movingObstacle->SetHeight(100);
+    movingObstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    scene.RenderAndStep();
+
+    auto *staticBehavior = static_cast<PathfindingObstacleRuntimeBehavior *>(
+        staticObstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+    auto *movingBehavior = static_cast<PathfindingObstacleRuntimeBehavior *>(
+        movingObstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+    REQUIRE(staticBehavior->IsStatic() == true);
+    REQUIRE(movingBehavior->IsStatic() == false);
+
+    ScenePathfindingObstaclesManager &manager =
+        scene.GetExtensionData<ScenePathfindingObstaclesManager>();
+    std::vector<PathfindingObstacleRuntimeBehavior *> obstacles;
+    manager.QueryObstaclesInRect(1000, 1100, 400, 400, obstacles);
+    REQUIRE(obstacles.size() == 1);
+    REQUIRE(obstacles[0] == staticBehavior);
+
+    manager.QueryObstaclesInRect(0, 0, 2000, 2000, obstacles);
+    REQUIRE(obstacles.size() == 2);
+
+    manager.QueryObstaclesInRect(-500, -500, 100, 100, obstacles);
+    REQUIRE(obstacles.empty());
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    // Obstacles that are not static are found as soon as they are moved
+    movingObstacle->SetX(1150);
+    movingObstacle->SetY(1250);
+    manager.QueryObstaclesInRect(1000, 1100, 400, 400, obstacles);
+    REQUIRE(obstacles.size() == 2);
+
+    // Static obstacles are updated at the next frame if moved anyway
+    movingObstacle->SetX(2000);
+    staticObstacle->SetX(3000);
+    scene.RenderAndStep();
+    manager.QueryObstaclesInRect(1000, 1100, 400, 400, obstacles);
+    REQUIRE(obstacles.empty());
+
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+
+    // Removed obstacles are not found anymore
+    scene.objectsInstances.RemoveObject(staticObstacle);
+    manager.QueryObstaclesInRect(2900, 1100, 400, 400, obstacles);
+    REQUIRE(obstacles.empty());
+  }
+  SECTION("Paths computed over several frames") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+
+    runtimeBehavior->SetMaxNodesPerFrame(scene, 10);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->IsPathPending() == true);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+
+    scene.RenderAndStep();
+    REQUIRE(runtimeBehavior->IsPathPending() == true);
+
+    std::size_t framesCount = 1;
+    while (runtimeBehavior->IsPathPending() && framesCount < 1000) {
+      scene.RenderAndStep();
+      framesCount++;
+    }
+
+    REQUIRE(framesCount > 5);
+    REQUIRE(runtimeBehavior->IsPathPending() == false);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+    REQUIRE(runtimeBehavior->GetNodeX(65) == 1200);
+    REQUIRE(runtimeBehavior->GetNodeY(65) == 1300);
+
+    // Paths are computed immediately without a budget
+    runtimeBehavior->SetMaxNodesPerFrame(scene, 0);
+    runtimeBehavior->MoveTo(scene, 1200, 1300);
+    REQUIRE(runtimeBehavior->IsPathPending() == false);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+  }
+  SECTION("Long paths computed on clusters of cells") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(600);
+    obstacle->SetY(-400);
+    obstacle->SetWidth(40);
+    obstacle->SetHeight(800);
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    runtimeBehavior->SetHierarchical(true);
+
+    auto isPathAvoiding = [&runtimeBehavior](float minX, float minY,
+                                             float maxX, float maxY) {
+      for (std::size_t i = 0; i < runtimeBehavior->GetNodeCount(); ++i) {
+        float x = runtimeBehavior->GetNodeX(i);
+        float y = runtimeBehavior->GetNodeY(i);
+        if (x > minX && x < maxX && y > minY && y < maxY) return false;
+      }
+      return true;
+    };
+
+    // The path goes around the obstacle
+    runtimeBehavior->MoveTo(scene, 1400, 0);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetDestinationX() == 1400);
+    REQUIRE(runtimeBehavior->GetDestinationY() == 0);
+    REQUIRE(isPathAvoiding(600, -400, 640, 400) == true);
+    std::size_t nodeCount = runtimeBehavior->GetNodeCount();
+
+    // The same path is found again
+    runtimeBehavior->MoveTo(scene, 1400, 0);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == nodeCount);
+
+    // The path is updated when the obstacle moves
+    obstacle->SetX(1000);
+    runtimeBehavior->MoveTo(scene, 1400, 0);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->GetDestinationX() == 1400);
+    REQUIRE(isPathAvoiding(1000, -400, 1040, 400) == true);
+
+    // No path is found when the destination is on an obstacle
+    obstacle->SetX(1380);
+    obstacle->SetY(-20);
+    obstacle->SetWidth(40);
+    obstacle->SetHeight(40);
+    runtimeBehavior->MoveTo(scene, 1400, 0);
+    REQUIRE(runtimeBehavior->PathFound() == false);
+  }
+  SECTION("Flow field shared by objects moving to the same position") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+    auto *player2 = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+    player2->AddBehavior("Pathfinding",
+                         CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                  PathfindingBehavior>());
+
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(600);
+    obstacle->SetY(-400);
+    obstacle->SetWidth(40);
+    obstacle->SetHeight(800);
+    player2->SetX(620);  // Inside the obstacle
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    PathfindingRuntimeBehavior *runtimeBehavior2 =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player2->GetBehaviorRawPointer("Pathfinding"));
+
+    // Follow the field, cell by cell, up to the destination
+    runtimeBehavior->MoveWithFlowField(scene, 1000, 0);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+    REQUIRE(runtimeBehavior->IsFollowingFlowField() == true);
+    REQUIRE(runtimeBehavior->GetNodeCount() == 2);
+    REQUIRE(runtimeBehavior->GetNodeX(0) == 0);
+    REQUIRE(runtimeBehavior->GetNodeY(0) == 0);
+
+    std::size_t cellsCount = 0;
+    while (runtimeBehavior->IsFollowingFlowField() && cellsCount < 1000) {
+      float x = runtimeBehavior->GetNodeX(1);
+      float y = runtimeBehavior->GetNodeY(1);
+      REQUIRE(std::abs(x - player->GetX()) <= 20);
+      REQUIRE(std::abs(y - player->GetY()) <= 20);
+      REQUIRE((x <= 600 || x >= 640 || y <= -400 || y >= 400) == true);
+
+      player->SetX(x);
+      player->SetY(y);
+      runtimeBehavior->MoveWithFlowField(scene, 1000, 0);
+      REQUIRE(runtimeBehavior->PathFound() == true);
+      cellsCount++;
+    }
+    REQUIRE(cellsCount > 50);
+    REQUIRE(cellsCount < 1000);
+    REQUIRE(runtimeBehavior->GetDestinationX() == 1000);
+    REQUIRE(runtimeBehavior->GetDestinationY() == 0);
+
+    // An object on the obstacle gets out of it
+    runtimeBehavior2->MoveWithFlowField(scene, 1000, 0);
+    REQUIRE(runtimeBehavior2->PathFound() == true);
+    REQUIRE(runtimeBehavior2->GetNodeCount() == 2);
+    REQUIRE((runtimeBehavior2->GetNodeX(1) == 600 ||
+             runtimeBehavior2->GetNodeX(1) == 640) == true);
+
+    // No path is found when the destination is on an obstacle
+    runtimeBehavior2->MoveWithFlowField(scene, 620, 200);
+    REQUIRE(runtimeBehavior2->PathFound() == false);
+    REQUIRE(runtimeBehavior2->IsFollowingFlowField() == false);
+    REQUIRE(runtimeBehavior2->GetNodeCount() == 0);
+  }
   SECTION("Obstacles making a corridor") {
     // Prepare some objects and the context
     RuntimeGame game;
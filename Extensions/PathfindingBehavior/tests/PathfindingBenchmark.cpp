@@ -0,0 +1,172 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Benchmark of the path computation of the Pathfinding extension.
+ * Hidden by default: run the tests with "[benchmark]" as argument to launch
+ * it.
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../../../GDCpp/tests/benchmarks/StepsBenchmark.h"
+#include "../PathfindingBehavior.h"
+#include "../PathfindingObstacleBehavior.h"
+#include "../PathfindingObstacleRuntimeBehavior.h"
+#include "../PathfindingRuntimeBehavior.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+// Mock objects that can have a specific size
+class WallRuntimeObject : public RuntimeObject {
+ public:
+  WallRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj), width(0), height(0) {}
+
+  float GetWidth() const override { return width; }
+  float GetHeight() const override { return height; }
+  void SetWidth(float newWidth) override { width = newWidth; }
+  void SetHeight(float newHeight) override { height = newHeight; }
+
+ private:
+  float width;
+  float height;
+};
+
+template <class TRuntimeBehavior, class TBehavior>
+std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
+  gd::SerializerElement behaviorContent;
+  TBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
+};
+}  // namespace
+
+TEST_CASE("PathfindingRuntimeBehavior benchmark",
+          "[.][benchmark][pathfinding]") {
+  RuntimeGame game;
+
+  gd::Object playerObj("player");
+  gd::Object wallObj("wall");
+
+  RuntimeScene scene(NULL, &game);
+  auto *player = scene.objectsInstances.AddObject(
+      std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+  player->AddBehavior("Pathfinding",
+                      CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                               PathfindingBehavior>());
+
+  // A lot of obstacles between the start and the destination.
+  for (int x = 0; x < 22; ++x) {
+    for (int y = 0; y < 12; ++y) {
+      auto *wall = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(
+              new WallRuntimeObject(scene, wallObj)));
+      wall->AddBehavior(
+          "PathfindingObstacle",
+          CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                   PathfindingObstacleBehavior>());
+      wall->SetX(100 + x * 100);
+      wall->SetY(100 + y * 100);
+      wall->SetWidth(60);
+      wall->SetHeight(60);
+    }
+  }
+  scene.RenderAndStep();
+
+  PathfindingRuntimeBehavior *runtimeBehavior =
+      static_cast<PathfindingRuntimeBehavior *>(
+          player->GetBehaviorRawPointer("Pathfinding"));
+
+  const std::size_t pathsCount = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < pathsCount; ++i) {
+    runtimeBehavior->MoveTo(scene, 2400, 1400);
+    REQUIRE(runtimeBehavior->PathFound() == true);
+  }
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << "Pathfinding benchmark: " << pathsCount << " paths of "
+            << runtimeBehavior->GetNodeCount() << " nodes computed in "
+            << duration.count() / 1000.0 << "ms ("
+            << duration.count() / 1000.0 / pathsCount << "ms per path)."
+            << std::endl;
+}
+
+TEST_CASE("PathfindingRuntimeBehavior steps benchmark",
+          "[.][benchmark][pathfinding]") {
+  // The number of obstacles and of agents of each scene.
+  const std::size_t sizes[][2] = {{100, 10}, {500, 25}, {1000, 50}};
+  for (const auto &size : sizes) {
+    const std::size_t obstaclesCount = size[0];
+    const std::size_t agentsCount = size[1];
+
+    RuntimeGame game;
+    gd::Object agentObj("agent");
+    gd::Object wallObj("wall");
+    RuntimeScene scene(NULL, &game);
+
+    // A grid of obstacles, the agents moving in the corridors between them.
+    const std::size_t obstaclesPerRow = 40;
+    for (std::size_t i = 0; i < obstaclesCount; ++i) {
+      auto *wall = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(
+              new WallRuntimeObject(scene, wallObj)));
+      wall->AddBehavior(
+          "PathfindingObstacle",
+          CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                   PathfindingObstacleBehavior>());
+      wall->SetX(100 + (i % obstaclesPerRow) * 100);
+      wall->SetY(100 + (i / obstaclesPerRow) * 100);
+      wall->SetWidth(60);
+      wall->SetHeight(60);
+    }
+    const std::size_t width = obstaclesPerRow * 100 + 100;
+    const std::size_t rowsCount = obstaclesCount / obstaclesPerRow + 1;
+
+    std::vector<RuntimeObject *> agents;
+    std::vector<PathfindingRuntimeBehavior *> agentsBehaviors;
+    for (std::size_t i = 0; i < agentsCount; ++i) {
+      auto *agent = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, agentObj)));
+      agent->AddBehavior("Pathfinding",
+                         CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                  PathfindingBehavior>());
+      agent->SetX((i * 130) % width);
+      agent->SetY(80 + (i % rowsCount) * 100);  // Between two rows.
+      agents.push_back(agent);
+      agentsBehaviors.push_back(static_cast<PathfindingRuntimeBehavior *>(
+          agent->GetBehaviorRawPointer("Pathfinding")));
+    }
+    scene.StepWithoutRender(16666);
+
+    // Each agent gets a new destination, a few obstacles away from it, every
+    // second and at different steps so that the paths are computed along the
+    // steps.
+    StepsBenchmark::Result result = StepsBenchmark::Run(
+        300, [&](std::size_t step) {
+          for (std::size_t i = 0; i < agents.size(); ++i) {
+            if ((step + i) % 60 != 0) continue;
+            const float direction = (step / 60) % 2 == 0 ? 1 : -1;
+            agentsBehaviors[i]->MoveTo(scene,
+                                       agents[i]->GetX() + direction * 300,
+                                       agents[i]->GetY() + direction * 100);
+          }
+          scene.StepWithoutRender(16666);
+        });
+    StepsBenchmark::Print("Pathfinding steps benchmark (" +
+                              std::to_string(obstaclesCount) + " obstacles, " +
+                              std::to_string(agentsCount) + " agents)",
+                          result);
+    REQUIRE(result.stepsCount == 300);
+  }
+}
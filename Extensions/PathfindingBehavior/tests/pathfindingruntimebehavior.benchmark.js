@@ -0,0 +1,101 @@
+describe('gdjs.PathfindingRuntimeBehavior', function() {
+  // The scene has obstaclesCount obstacles in a grid, and agentsCount agents
+  // moving in the corridors between them.
+  var obstaclesPerRow = 40;
+  var makeScene = function(obstaclesCount, agentsCount) {
+    var runtimeGame = new gdjs.RuntimeGame({
+      variables: [],
+      properties: { windowWidth: 800, windowHeight: 600, minFPS: 10 },
+    });
+    var runtimeScene = new gdjs.RuntimeScene(runtimeGame, null);
+    runtimeScene.loadFromScene({
+      layers: [{ name: '', visibility: true }],
+      variables: [],
+      behaviorsSharedData: [],
+      objects: [],
+      instances: [],
+    });
+
+    for (var i = 0; i < obstaclesCount; ++i) {
+      var wall = new gdjs.RuntimeObject(runtimeScene, {
+        name: 'wall',
+        type: '',
+        behaviors: [
+          {
+            type: 'PathfindingBehavior::PathfindingObstacleBehavior',
+            name: 'PathfindingObstacle',
+            impassable: true,
+            cost: 2,
+          },
+        ],
+      });
+      wall.getWidth = function() { return 60; };
+      wall.getHeight = function() { return 60; };
+      runtimeScene.addObject(wall);
+      wall.setPosition(
+        100 + (i % obstaclesPerRow) * 100,
+        100 + Math.floor(i / obstaclesPerRow) * 100
+      );
+    }
+
+    var rowsCount = Math.floor(obstaclesCount / obstaclesPerRow) + 1;
+    var agents = [];
+    for (var i = 0; i < agentsCount; ++i) {
+      var agent = new gdjs.RuntimeObject(runtimeScene, {
+        name: 'agent',
+        type: '',
+        behaviors: [
+          {
+            type: 'PathfindingBehavior::PathfindingBehavior',
+            name: 'Pathfinding',
+            allowDiagonals: true,
+            acceleration: 400,
+            maxSpeed: 200,
+            angularMaxSpeed: 180,
+            rotateObject: true,
+            angleOffset: 0,
+            cellWidth: 20,
+            cellHeight: 20,
+            extraBorder: 0,
+          },
+        ],
+      });
+      runtimeScene.addObject(agent);
+      agent.setPosition(
+        (i * 130) % (obstaclesPerRow * 100 + 100),
+        80 + (i % rowsCount) * 100 // Between two rows.
+      );
+      agents.push(agent.getBehavior('Pathfinding'));
+    }
+    runtimeScene.renderAndStep(1000 / 60);
+
+    return { runtimeScene: runtimeScene, agents: agents };
+  };
+
+  [[100, 10], [500, 25], [1000, 50]].forEach(function(size) {
+    var title =
+      'benchmark steps with ' + size[0] + ' obstacles and ' +
+      size[1] + ' agents';
+    it(title, function() {
+      this.timeout(60000);
+      var scene = makeScene(size[0], size[1]);
+
+      // Each agent gets a new destination, a few obstacles away from it, every
+      // second and at different steps so that the paths are computed along
+      // the steps.
+      var result = benchmarkSteps({}, function(step) {
+        scene.agents.forEach(function(agent, i) {
+          if ((step + i) % 60 !== 0) return;
+          var direction = Math.floor(step / 60) % 2 === 0 ? 1 : -1;
+          agent.moveTo(
+            scene.runtimeScene,
+            agent.owner.getX() + direction * 300,
+            agent.owner.getY() + direction * 100
+          );
+        });
+        scene.runtimeScene.renderAndStep(1000 / 60);
+      });
+      console.log(title, result);
+    });
+  });
+});
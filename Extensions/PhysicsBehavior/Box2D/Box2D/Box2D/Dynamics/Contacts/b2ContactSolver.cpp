@@ -181,10 +181,19 @@ void b2ContactSolver::WarmStart()
 		{
 			b2ContactConstraintPoint* ccp = c->points + j;
 			b2Vec2 P = ccp->normalImpulse * normal + ccp->tangentImpulse * tangent;
-			bodyA->m_angularVelocity -= invIA * b2Cross(ccp->rA, P);
-			bodyA->m_linearVelocity -= invMassA * P;
-			bodyB->m_angularVelocity += invIB * b2Cross(ccp->rB, P);
-			bodyB->m_linearVelocity += invMassB * P;
+
+			// Static bodies are not modified, as they can be shared by islands
+			// solved at the same time (see b2IslandSolverPool).
+			if (bodyA->GetType() != b2_staticBody)
+			{
+				bodyA->m_angularVelocity -= invIA * b2Cross(ccp->rA, P);
+				bodyA->m_linearVelocity -= invMassA * P;
+			}
+			if (bodyB->GetType() != b2_staticBody)
+			{
+				bodyB->m_angularVelocity += invIB * b2Cross(ccp->rB, P);
+				bodyB->m_linearVelocity += invMassB * P;
+			}
 		}
 	}
 }
@@ -481,10 +490,16 @@ void b2ContactSolver::SolveVelocityConstraints()
 			}
 		}
 
-		bodyA->m_linearVelocity = vA;
-		bodyA->m_angularVelocity = wA;
-		bodyB->m_linearVelocity = vB;
-		bodyB->m_angularVelocity = wB;
+		if (bodyA->GetType() != b2_staticBody)
+		{
+			bodyA->m_linearVelocity = vA;
+			bodyA->m_angularVelocity = wA;
+		}
+		if (bodyB->GetType() != b2_staticBody)
+		{
+			bodyB->m_linearVelocity = vB;
+			bodyB->m_angularVelocity = wB;
+		}
 	}
 }
 
@@ -607,13 +622,19 @@ bool b2ContactSolver::SolvePositionConstraints(float32 baumgarte)
 
 			b2Vec2 P = impulse * normal;
 
-			bodyA->m_sweep.c -= invMassA * P;
-			bodyA->m_sweep.a -= invIA * b2Cross(rA, P);
-			bodyA->SynchronizeTransform();
+			if (bodyA->GetType() != b2_staticBody)
+			{
+				bodyA->m_sweep.c -= invMassA * P;
+				bodyA->m_sweep.a -= invIA * b2Cross(rA, P);
+				bodyA->SynchronizeTransform();
+			}
 
-			bodyB->m_sweep.c += invMassB * P;
-			bodyB->m_sweep.a += invIB * b2Cross(rB, P);
-			bodyB->SynchronizeTransform();
+			if (bodyB->GetType() != b2_staticBody)
+			{
+				bodyB->m_sweep.c += invMassB * P;
+				bodyB->m_sweep.a += invIB * b2Cross(rB, P);
+				bodyB->SynchronizeTransform();
+			}
 		}
 	}
 
@@ -160,6 +160,10 @@ b2Island::b2Island(
 	m_allocator = allocator;
 	m_listener = listener;
 
+	m_deferred = false;
+	m_impulses = NULL;
+	m_sleeping = false;
+
 	m_bodies = (b2Body**)m_allocator->Allocate(bodyCapacity * sizeof(b2Body*));
 	m_contacts = (b2Contact**)m_allocator->Allocate(contactCapacity	 * sizeof(b2Contact*));
 	m_joints = (b2Joint**)m_allocator->Allocate(jointCapacity * sizeof(b2Joint*));
@@ -180,6 +184,8 @@ b2Island::~b2Island()
 
 void b2Island::Solve(const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
 {
+	m_sleeping = false;
+
 	// Integrate velocities and apply damping.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
@@ -340,9 +346,15 @@ void b2Island::Solve(const b2TimeStep& step, const b2Vec2& gravity, bool allowSl
 
 		if (minSleepTime >= b2_timeToSleep)
 		{
+			m_sleeping = true;
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+				if (m_deferred && b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
@@ -351,7 +363,7 @@ void b2Island::Solve(const b2TimeStep& step, const b2Vec2& gravity, bool allowSl
 
 void b2Island::Report(const b2ContactConstraint* constraints)
 {
-	if (m_listener == NULL)
+	if (m_listener == NULL && m_deferred == false)
 	{
 		return;
 	}
@@ -369,7 +381,14 @@ void b2Island::Report(const b2ContactConstraint* constraints)
 			impulse.tangentImpulses[j] = cc->points[j].tangentImpulse;
 		}
 
-		m_listener->PostSolve(c, &impulse);
+		if (m_deferred)
+		{
+			m_impulses[i] = impulse;
+		}
+		else
+		{
+			m_listener->PostSolve(c, &impulse);
+		}
 	}
 }
 
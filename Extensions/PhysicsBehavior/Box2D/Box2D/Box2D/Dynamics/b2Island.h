@@ -27,6 +27,7 @@ class b2Contact;
 class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
+struct b2ContactImpulse;
 struct b2ContactConstraint;
 
 /// This is an internal structure.
@@ -100,6 +101,16 @@ public:
 	int32 m_jointCapacity;
 
 	int32 m_positionIterationCount;
+
+	// When the island is solved at the same time as other islands (see
+	// b2IslandSolverPool), the impulses are stored in m_impulses instead of
+	// being reported, and the static bodies (that can be shared with the
+	// other islands) are not put to sleep.
+	bool m_deferred;
+	b2ContactImpulse* m_impulses;
+
+	// True if the bodies were put to sleep by the last call to Solve.
+	bool m_sleeping;
 };
 
 #endif
@@ -0,0 +1,261 @@
+/*
+* Copyright (c) 2006-2009 Erin Catto http://www.gphysics.com
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include <Box2D/Dynamics/b2IslandSolverPool.h>
+#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Dynamics/b2Island.h>
+#include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Dynamics/Joints/b2Joint.h>
+#include <Box2D/Common/b2StackAllocator.h>
+#include <algorithm>
+#include <system_error>
+
+b2IslandSolverPool::b2IslandSolverPool(int32 threadCount)
+{
+	m_generation = 0;
+	m_busyWorkers = 0;
+	m_quit = false;
+	m_step = NULL;
+	m_allowSleep = true;
+	m_nextIsland = 0;
+
+	for (int32 i = 0; i < threadCount - 1; ++i)
+	{
+		m_allocators.push_back(new b2StackAllocator);
+	}
+
+	for (int32 i = 0; i < threadCount - 1; ++i)
+	{
+		try
+		{
+			m_threads.push_back(std::thread(&b2IslandSolverPool::WorkerMain, this, i));
+		}
+		catch (const std::system_error&)
+		{
+			// Threads are not available: solve with the threads started.
+			break;
+		}
+	}
+}
+
+b2IslandSolverPool::~b2IslandSolverPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_workAvailable.notify_all();
+
+	for (std::size_t i = 0; i < m_threads.size(); ++i)
+	{
+		m_threads[i].join();
+	}
+	for (std::size_t i = 0; i < m_allocators.size(); ++i)
+	{
+		delete m_allocators[i];
+	}
+}
+
+void b2IslandSolverPool::AddIsland(const b2Island& island)
+{
+	b2IslandRange range;
+	range.firstBody = int32(m_bodies.size());
+	range.bodyCount = island.m_bodyCount;
+	range.firstContact = int32(m_contacts.size());
+	range.contactCount = island.m_contactCount;
+	range.firstJoint = int32(m_joints.size());
+	range.jointCount = island.m_jointCount;
+	range.jointsWithStaticBodies = false;
+	range.sleeping = false;
+	for (int32 i = 0; i < island.m_jointCount; ++i)
+	{
+		b2Joint* joint = island.m_joints[i];
+		if (joint->GetBodyA()->GetType() == b2_staticBody ||
+			joint->GetBodyB()->GetType() == b2_staticBody)
+		{
+			range.jointsWithStaticBodies = true;
+		}
+	}
+	m_islands.push_back(range);
+
+	m_bodies.insert(m_bodies.end(), island.m_bodies, island.m_bodies + island.m_bodyCount);
+	m_contacts.insert(m_contacts.end(), island.m_contacts, island.m_contacts + island.m_contactCount);
+	m_joints.insert(m_joints.end(), island.m_joints, island.m_joints + island.m_jointCount);
+}
+
+void b2IslandSolverPool::SolveIslands(const b2TimeStep& step, const b2Vec2& gravity,
+									  bool allowSleep, b2ContactListener* listener,
+									  b2StackAllocator* allocator)
+{
+	m_step = &step;
+	m_gravity = gravity;
+	m_allowSleep = allowSleep;
+	m_impulses.resize(m_contacts.size());
+
+	// Solve the largest islands first so that the threads finish together.
+	m_solvingOrder.clear();
+	for (std::size_t i = 0; i < m_islands.size(); ++i)
+	{
+		if (m_islands[i].jointsWithStaticBodies == false)
+		{
+			m_solvingOrder.push_back(int32(i));
+		}
+	}
+	std::stable_sort(m_solvingOrder.begin(), m_solvingOrder.end(),
+		[this](int32 a, int32 b)
+		{
+			return m_islands[a].bodyCount + m_islands[a].contactCount >
+				m_islands[b].bodyCount + m_islands[b].contactCount;
+		});
+	m_nextIsland = 0;
+
+	if (m_solvingOrder.size() > 1 && m_threads.empty() == false)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_busyWorkers = int32(m_threads.size());
+			++m_generation;
+		}
+		m_workAvailable.notify_all();
+
+		SolveClaimedIslands(allocator);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_workDone.wait(lock, [this]() { return m_busyWorkers == 0; });
+	}
+	else
+	{
+		SolveClaimedIslands(allocator);
+	}
+
+	for (std::size_t i = 0; i < m_islands.size(); ++i)
+	{
+		if (m_islands[i].jointsWithStaticBodies)
+		{
+			SolveIsland(m_islands[i], allocator);
+		}
+	}
+
+	// Merge in the order the islands were built, as done when solving them
+	// one after the other.
+	for (std::size_t i = 0; i < m_islands.size(); ++i)
+	{
+		const b2IslandRange& range = m_islands[i];
+
+		if (listener != NULL)
+		{
+			for (int32 j = 0; j < range.contactCount; ++j)
+			{
+				int32 index = range.firstContact + j;
+				listener->PostSolve(m_contacts[index], &m_impulses[index]);
+			}
+		}
+
+		// The last island of a static body decides if it's sleeping.
+		for (int32 j = 0; j < range.bodyCount; ++j)
+		{
+			b2Body* b = m_bodies[range.firstBody + j];
+			if (b->GetType() == b2_staticBody)
+			{
+				b->SetAwake(!range.sleeping);
+			}
+		}
+	}
+
+	// Keep the memory for the next step.
+	m_islands.clear();
+	m_bodies.clear();
+	m_contacts.clear();
+	m_joints.clear();
+	m_step = NULL;
+}
+
+void b2IslandSolverPool::WorkerMain(int32 workerIndex)
+{
+	int32 generation = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(lock, [this, generation]()
+			{
+				return m_quit || m_generation != generation;
+			});
+			if (m_quit)
+			{
+				return;
+			}
+			generation = m_generation;
+		}
+
+		SolveClaimedIslands(m_allocators[workerIndex]);
+
+		bool lastWorker = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			lastWorker = --m_busyWorkers == 0;
+		}
+		if (lastWorker)
+		{
+			m_workDone.notify_one();
+		}
+	}
+}
+
+void b2IslandSolverPool::SolveClaimedIslands(b2StackAllocator* allocator)
+{
+	for (;;)
+	{
+		int32 next = m_nextIsland++;
+		if (next >= int32(m_solvingOrder.size()))
+		{
+			return;
+		}
+
+		SolveIsland(m_islands[m_solvingOrder[next]], allocator);
+	}
+}
+
+void b2IslandSolverPool::SolveIsland(b2IslandRange& range, b2StackAllocator* allocator)
+{
+	b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, NULL);
+	island.m_deferred = true;
+	island.m_impulses = range.contactCount > 0 ? &m_impulses[range.firstContact] : NULL;
+
+	// The bodies are not added with b2Island::Add, as their island index was
+	// set when the island was built (and static bodies are shared).
+	std::copy(m_bodies.begin() + range.firstBody,
+			  m_bodies.begin() + range.firstBody + range.bodyCount, island.m_bodies);
+	island.m_bodyCount = range.bodyCount;
+	for (int32 i = 0; i < range.contactCount; ++i)
+	{
+		island.Add(m_contacts[range.firstContact + i]);
+	}
+	for (int32 i = 0; i < range.jointCount; ++i)
+	{
+		island.Add(m_joints[range.firstJoint + i]);
+	}
+
+	island.Solve(*m_step, m_gravity, m_allowSleep);
+	range.sleeping = island.m_sleeping;
+
+	// Keep the contacts in the order they were reported.
+	std::copy(island.m_contacts, island.m_contacts + range.contactCount,
+			  m_contacts.begin() + range.firstContact);
+}
@@ -0,0 +1,117 @@
+/*
+* Copyright (c) 2006-2009 Erin Catto http://www.gphysics.com
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef B2_ISLAND_SOLVER_POOL_H
+#define B2_ISLAND_SOLVER_POOL_H
+
+#include <Box2D/Common/b2Math.h>
+#include <Box2D/Dynamics/b2WorldCallbacks.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class b2Body;
+class b2Contact;
+class b2Joint;
+class b2Island;
+class b2StackAllocator;
+struct b2TimeStep;
+
+/// Solves the islands of a world step on worker threads (see
+/// b2World::SetIslandSolverThreadCount).
+/// The islands are built by b2World::Solve as usual, then solved at the same
+/// time: the threads claim the islands to solve, largest first, until none is
+/// left. An island only modifies its own bodies, contacts and joints, so the
+/// results do not depend on the number of threads. What can't be done
+/// concurrently is then merged in the order the islands were built: the
+/// impulses are reported to the contact listener and the static bodies, which
+/// can be shared by several islands, are put to sleep or woken up.
+/// Joints modify their static bodies (even if they are not moved): the islands
+/// having a joint with a static body are solved after the others, by the thread
+/// stepping the world.
+class b2IslandSolverPool
+{
+public:
+	/// @param threadCount the number of threads solving the islands, including
+	/// the thread stepping the world.
+	b2IslandSolverPool(int32 threadCount);
+	~b2IslandSolverPool();
+
+	/// Get the number of threads solving the islands, including the thread
+	/// stepping the world. Can be less than requested if the threads could not
+	/// be started.
+	int32 GetThreadCount() const { return int32(m_threads.size()) + 1; }
+
+	/// Copy an island built by the world, to be solved by SolveIslands.
+	void AddIsland(const b2Island& island);
+
+	/// Solve the islands added since the last call, report their impulses to
+	/// the listener (if not NULL) and forget them.
+	/// @param allocator the allocator used by the calling thread.
+	void SolveIslands(const b2TimeStep& step, const b2Vec2& gravity,
+					  bool allowSleep, b2ContactListener* listener,
+					  b2StackAllocator* allocator);
+
+private:
+
+	/// The position of an island in the arrays of the pool.
+	struct b2IslandRange
+	{
+		int32 firstBody;
+		int32 bodyCount;
+		int32 firstContact;
+		int32 contactCount;
+		int32 firstJoint;
+		int32 jointCount;
+		bool jointsWithStaticBodies;
+		bool sleeping;
+	};
+
+	void WorkerMain(int32 workerIndex);
+	void SolveClaimedIslands(b2StackAllocator* allocator);
+	void SolveIsland(b2IslandRange& range, b2StackAllocator* allocator);
+
+	std::vector<std::thread> m_threads;
+	std::vector<b2StackAllocator*> m_allocators; ///< One for each worker.
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workDone;
+	int32 m_generation; ///< Incremented each time islands are to be solved.
+	int32 m_busyWorkers;
+	bool m_quit;
+
+	// The islands being solved.
+	const b2TimeStep* m_step;
+	b2Vec2 m_gravity;
+	bool m_allowSleep;
+	std::vector<b2IslandRange> m_islands;
+	std::vector<int32> m_solvingOrder; ///< Islands solved at the same time,
+									   ///< largest first.
+	std::atomic<int32> m_nextIsland; ///< Next index in m_solvingOrder.
+
+	std::vector<b2Body*> m_bodies;
+	std::vector<b2Contact*> m_contacts;
+	std::vector<b2Joint*> m_joints;
+	std::vector<b2ContactImpulse> m_impulses;
+};
+
+#endif
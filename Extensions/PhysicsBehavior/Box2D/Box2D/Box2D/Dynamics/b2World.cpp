@@ -20,6 +20,7 @@
 #include <Box2D/Dynamics/b2Body.h>
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2Island.h>
+#include <Box2D/Dynamics/b2IslandSolverPool.h>
 #include <Box2D/Dynamics/Joints/b2PulleyJoint.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 #include <Box2D/Dynamics/Contacts/b2ContactSolver.h>
@@ -52,11 +53,30 @@ b2World::b2World(const b2Vec2& gravity, bool doSleep)
 
 	m_inv_dt0 = 0.0f;
 
+	m_islandSolverPool = NULL;
+
 	m_contactManager.m_allocator = &m_blockAllocator;
 }
 
 b2World::~b2World()
 {
+	delete m_islandSolverPool;
+}
+
+void b2World::SetIslandSolverThreadCount(int32 count)
+{
+	if (count == GetIslandSolverThreadCount())
+	{
+		return;
+	}
+
+	delete m_islandSolverPool;
+	m_islandSolverPool = count > 1 ? new b2IslandSolverPool(count) : NULL;
+}
+
+int32 b2World::GetIslandSolverThreadCount() const
+{
+	return m_islandSolverPool != NULL ? m_islandSolverPool->GetThreadCount() : 1;
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -475,7 +495,15 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		island.Solve(step, m_gravity, m_allowSleep);
+		if (m_islandSolverPool != NULL)
+		{
+			// Solved later, at the same time as the other islands.
+			m_islandSolverPool->AddIsland(island);
+		}
+		else
+		{
+			island.Solve(step, m_gravity, m_allowSleep);
+		}
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -489,6 +517,13 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 	}
 
+	if (m_islandSolverPool != NULL)
+	{
+		m_islandSolverPool->SolveIslands(step, m_gravity, m_allowSleep,
+										 m_contactManager.m_contactListener,
+										 &m_stackAllocator);
+	}
+
 	m_stackAllocator.Free(stack);
 
 	// Synchronize fixtures, check for out of range bodies.
@@ -32,6 +32,7 @@ struct b2TimeStep;
 class b2Body;
 class b2Fixture;
 class b2Joint;
+class b2IslandSolverPool;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -166,6 +167,16 @@ public:
 	/// Get the flag that controls automatic clearing of forces after each time step.
 	bool GetAutoClearForces() const;
 
+	/// Set the number of threads solving the islands of the world at the same time
+	/// (including the thread calling Step). 1 (the default) to solve them one after
+	/// the other. The simulation gives the same results with any number of threads,
+	/// but the contact listener PostSolve callbacks are called once all the islands
+	/// are solved.
+	void SetIslandSolverThreadCount(int32 count);
+
+	/// Get the number of threads solving the islands of the world.
+	int32 GetIslandSolverThreadCount() const;
+
 private:
 
 	// m_flags
@@ -217,6 +228,9 @@ private:
 
 	// This is for debugging the solver.
 	bool m_continuousPhysics;
+
+	// Solves the islands on worker threads, NULL to solve them sequentially.
+	b2IslandSolverPool* m_islandSolverPool;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -5,28 +5,53 @@ Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
 This project is released under the MIT License.
 */
 #include "ContactListener.h"
+#include "ContactPairs.h"
+#include "MergedStaticBoxes.h"
 #include "PhysicsRuntimeBehavior.h"
 
+namespace {
+bool HasMergedFixture(b2Contact *contact) {
+  return MergedStaticBoxes::IsMergedFixture(contact->GetFixtureA()) ||
+         MergedStaticBoxes::IsMergedFixture(contact->GetFixtureB());
+}
+}  // namespace
+
 void ContactListener::BeginContact(b2Contact *contact) {
   if (!contact->GetFixtureA()->GetBody() || !contact->GetFixtureB()->GetBody())
     return;
+  if (HasMergedFixture(contact)) {
+    mergedStaticBoxes.BeginContact(contact);
+    return;
+  }
 
   PhysicsRuntimeBehavior *behavior1 = static_cast<PhysicsRuntimeBehavior *>(
       contact->GetFixtureA()->GetBody()->GetUserData());
   PhysicsRuntimeBehavior *behavior2 = static_cast<PhysicsRuntimeBehavior *>(
       contact->GetFixtureB()->GetBody()->GetUserData());
-  behavior1->currentContacts.insert(behavior2);
-  behavior2->currentContacts.insert(behavior1);
+  if (!behavior1 || !behavior2) return;
+
+  contactPairs.BeginContact(behavior1->GetObject(), behavior2->GetObject());
 }
 
 void ContactListener::EndContact(b2Contact *contact) {
   if (!contact->GetFixtureA()->GetBody() || !contact->GetFixtureB()->GetBody())
     return;
+  if (HasMergedFixture(contact)) {
+    mergedStaticBoxes.EndContact(contact);
+    return;
+  }
 
   PhysicsRuntimeBehavior *behavior1 = static_cast<PhysicsRuntimeBehavior *>(
       contact->GetFixtureA()->GetBody()->GetUserData());
   PhysicsRuntimeBehavior *behavior2 = static_cast<PhysicsRuntimeBehavior *>(
       contact->GetFixtureB()->GetBody()->GetUserData());
-  behavior1->currentContacts.erase(behavior2);
-  behavior2->currentContacts.erase(behavior1);
+  if (!behavior1 || !behavior2) return;
+
+  contactPairs.EndContact(behavior1->GetObject(), behavior2->GetObject());
+}
+
+void ContactListener::PreSolve(b2Contact *contact,
+                               const b2Manifold *oldManifold) {
+  // The boxes touched in a merged rectangle change as the bodies move.
+  if (HasMergedFixture(contact)) mergedStaticBoxes.UpdateContact(contact);
 }
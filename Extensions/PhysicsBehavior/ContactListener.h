@@ -8,17 +8,33 @@ This project is released under the MIT License.
 #define CONTACTLISTENER_H
 
 #include "Box2D/Box2D.h"
+class ContactPairs;
+class MergedStaticBoxes;
 
+/**
+ * \brief Record the contacts of the bodies of the world in the pairs of
+ * objects in contact.
+ *
+ * The contacts with the merged static boxes are resolved by
+ * MergedStaticBoxes, at each step.
+ */
 class ContactListener : public b2ContactListener {
  public:
-  ContactListener() : b2ContactListener() {}
+  ContactListener(ContactPairs& contactPairs_,
+                  MergedStaticBoxes& mergedStaticBoxes_)
+      : b2ContactListener(),
+        contactPairs(contactPairs_),
+        mergedStaticBoxes(mergedStaticBoxes_) {}
   virtual ~ContactListener(){};
 
   virtual void BeginContact(b2Contact* contact);
   virtual void EndContact(b2Contact* contact);
+  virtual void PreSolve(b2Contact* contact, const b2Manifold* oldManifold);
 
  protected:
  private:
+  ContactPairs& contactPairs;
+  MergedStaticBoxes& mergedStaticBoxes;
 };
 
 #endif  // CONTACTLISTENER_H
@@ -0,0 +1,120 @@
+/**
+
+GDevelop - Physics Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "ContactPairs.h"
+#include <cstdint>
+
+const std::size_t ContactPairs::notFound = static_cast<std::size_t>(-1);
+
+ContactPairs::ContactPairs() : entries(64), pairsCount(0) {}
+
+std::size_t ContactPairs::GetHomeSlot(const Pair &pair) const {
+  std::uint64_t hash =
+      static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pair.first));
+  hash ^= static_cast<std::uint64_t>(
+              reinterpret_cast<std::uintptr_t>(pair.second)) *
+          0x9E3779B97F4A7C15ULL;
+  hash ^= hash >> 29;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 32;
+  return static_cast<std::size_t>(hash) & (entries.size() - 1);
+}
+
+std::size_t ContactPairs::FindSlot(const Pair &pair) const {
+  std::size_t mask = entries.size() - 1;
+  for (std::size_t slot = GetHomeSlot(pair);; slot = (slot + 1) & mask) {
+    const Entry &entry = entries[slot];
+    if (entry.pair == pair) return slot;
+    if (entry.pair.first == NULL) return notFound;
+  }
+}
+
+void ContactPairs::BeginContact(const RuntimeObject *object1,
+                                const RuntimeObject *object2) {
+  Pair pair = MakePair(object1, object2);
+  if (pair.first == NULL) return;
+
+  std::size_t slot = FindSlot(pair);
+  if (slot == notFound) {
+    // Keep the table at most half full so that the probe sequences are short.
+    if ((pairsCount + 1) * 2 > entries.size()) Grow();
+
+    std::size_t mask = entries.size() - 1;
+    slot = GetHomeSlot(pair);
+    while (entries[slot].pair.first != NULL) slot = (slot + 1) & mask;
+
+    entries[slot].pair = pair;
+    entries[slot].fixturesContactsCount = 0;
+    pairsCount++;
+  }
+
+  if (entries[slot].fixturesContactsCount++ == 0)
+    startedContacts.push_back(pair);
+}
+
+void ContactPairs::EndContact(const RuntimeObject *object1,
+                              const RuntimeObject *object2) {
+  Pair pair = MakePair(object1, object2);
+  std::size_t slot = pair.first ? FindSlot(pair) : notFound;
+  if (slot == notFound || entries[slot].fixturesContactsCount == 0) return;
+
+  // The pair is erased at the next frame (see StartFrame).
+  if (--entries[slot].fixturesContactsCount == 0) endedContacts.push_back(pair);
+}
+
+bool ContactPairs::AreInContact(const RuntimeObject *object1,
+                                const RuntimeObject *object2) const {
+  Pair pair = MakePair(object1, object2);
+  return pair.first && FindSlot(pair) != notFound;
+}
+
+void ContactPairs::StartFrame() {
+  for (const Pair &pair : endedContacts) {
+    std::size_t slot = FindSlot(pair);
+    if (slot != notFound && entries[slot].fixturesContactsCount == 0)
+      Erase(slot);
+  }
+
+  startedContacts.clear();
+  endedContacts.clear();
+}
+
+void ContactPairs::Erase(std::size_t slot) {
+  // Move back the next entries of the probe sequence into the freed slot, so
+  // that no tombstone is needed for the lookups.
+  std::size_t mask = entries.size() - 1;
+  std::size_t next = slot;
+  for (;;) {
+    next = (next + 1) & mask;
+    if (entries[next].pair.first == NULL) break;
+
+    std::size_t home = GetHomeSlot(entries[next].pair);
+    bool canMove = slot <= next ? (home <= slot || home > next)
+                                : (home <= slot && home > next);
+    if (canMove) {
+      entries[slot] = entries[next];
+      slot = next;
+    }
+  }
+
+  entries[slot].pair = Pair(NULL, NULL);
+  entries[slot].fixturesContactsCount = 0;
+  pairsCount--;
+}
+
+void ContactPairs::Grow() {
+  std::vector<Entry> oldEntries(entries.size() * 2);
+  oldEntries.swap(entries);
+
+  std::size_t mask = entries.size() - 1;
+  for (const Entry &entry : oldEntries) {
+    if (entry.pair.first == NULL) continue;
+
+    std::size_t slot = GetHomeSlot(entry.pair);
+    while (entries[slot].pair.first != NULL) slot = (slot + 1) & mask;
+    entries[slot] = entry;
+  }
+}
@@ -0,0 +1,102 @@
+/**
+
+GDevelop - Physics Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef CONTACTPAIRS_H
+#define CONTACTPAIRS_H
+#include <cstddef>
+#include <utility>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief The pairs of objects whose bodies are in contact, stored in an open
+ * addressing hash table.
+ *
+ * Box2D reports the contacts between fixtures: the number of fixtures in
+ * contact is counted for each pair, so that objects made of several fixtures
+ * (custom polygons) stay in contact until all their fixtures are separated.
+ *
+ * A pair is still considered in contact until the next frame when it stops
+ * touching, so that the contacts starting and ending during the steps of the
+ * same frame are seen by the events.
+ */
+class ContactPairs {
+ public:
+  typedef std::pair<const RuntimeObject *, const RuntimeObject *> Pair;
+
+  ContactPairs();
+  virtual ~ContactPairs(){};
+
+  /**
+   * \brief To be called when a fixture of the first object starts touching a
+   * fixture of the second one.
+   */
+  void BeginContact(const RuntimeObject *object1,
+                    const RuntimeObject *object2);
+
+  /**
+   * \brief To be called when a fixture of the first object stops touching a
+   * fixture of the second one.
+   */
+  void EndContact(const RuntimeObject *object1, const RuntimeObject *object2);
+
+  /**
+   * \brief Return true if the objects are in contact, or were in contact
+   * during the current frame.
+   */
+  bool AreInContact(const RuntimeObject *object1,
+                    const RuntimeObject *object2) const;
+
+  /**
+   * \brief Forget the pairs that stopped touching during the last frame, and
+   * clear the lists of the pairs that started or stopped touching. To be
+   * called once a frame, before the world is stepped.
+   */
+  void StartFrame();
+
+  /**
+   * \brief Return the pairs of objects that started touching during the
+   * current frame.
+   */
+  const std::vector<Pair> &GetStartedContacts() const {
+    return startedContacts;
+  }
+
+  /**
+   * \brief Return the pairs of objects that stopped touching during the
+   * current frame.
+   */
+  const std::vector<Pair> &GetEndedContacts() const { return endedContacts; }
+
+  /**
+   * \brief Return the number of pairs stored in the table.
+   */
+  std::size_t GetPairsCount() const { return pairsCount; }
+
+ private:
+  struct Entry {
+    Pair pair;  ///< The objects, ordered by address. Both null if empty.
+    unsigned int fixturesContactsCount;
+  };
+
+  static Pair MakePair(const RuntimeObject *object1,
+                       const RuntimeObject *object2) {
+    return object1 < object2 ? Pair(object1, object2) : Pair(object2, object1);
+  }
+  std::size_t GetHomeSlot(const Pair &pair) const;
+  std::size_t FindSlot(const Pair &pair) const;
+  void Erase(std::size_t slot);
+  void Grow();
+
+  std::vector<Entry> entries;  ///< The slots, a power of two.
+  std::size_t pairsCount;
+  std::vector<Pair> startedContacts;
+  std::vector<Pair> endedContacts;
+
+  static const std::size_t notFound;
+};
+
+#endif  // CONTACTPAIRS_H
@@ -0,0 +1,287 @@
+/**
+
+GDevelop - Physics Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "MergedStaticBoxes.h"
+#include <algorithm>
+#include "Box2D/Box2D.h"
+#include "ContactPairs.h"
+#include "PhysicsRuntimeBehavior.h"
+
+#undef GetObject
+
+MergedStaticBoxes::MergedStaticBoxes(b2World& world_,
+                                     ContactPairs& contactPairs_,
+                                     float scaleX_,
+                                     float scaleY_)
+    : world(world_),
+      contactPairs(contactPairs_),
+      scaleX(scaleX_),
+      scaleY(scaleY_),
+      body(NULL) {}
+
+void MergedStaticBoxes::Add(PhysicsRuntimeBehavior* behavior,
+                            float left,
+                            float top,
+                            float right,
+                            float bottom,
+                            float friction,
+                            float restitution) {
+  if (behaviorsRectangles.find(behavior) != behaviorsRectangles.end()) return;
+
+  Box box = {behavior, left, top, right, bottom, friction, restitution};
+  pendingBoxes.push_back(box);
+  behaviorsRectangles[behavior] = nullptr;
+}
+
+void MergedStaticBoxes::Remove(PhysicsRuntimeBehavior* behavior) {
+  auto it = behaviorsRectangles.find(behavior);
+  if (it == behaviorsRectangles.end()) return;
+
+  Rectangle* rectangle = it->second;
+  behaviorsRectangles.erase(it);
+  if (!rectangle) {
+    auto pendingBox = std::find_if(
+        pendingBoxes.begin(), pendingBoxes.end(), [behavior](const Box& box) {
+          return box.behavior == behavior;
+        });
+    if (pendingBox != pendingBoxes.end()) {
+      *pendingBox = pendingBoxes.back();
+      pendingBoxes.pop_back();
+    }
+    return;
+  }
+
+  // Destroying the fixture ends its contacts: the other boxes get their
+  // contacts back when they are merged again, at the next step.
+  body->DestroyFixture(rectangle->fixture);
+  for (const Row& row : rectangle->rows) {
+    for (const Box& box : row.boxes) {
+      if (box.behavior == behavior) continue;
+
+      pendingBoxes.push_back(box);
+      behaviorsRectangles[box.behavior] = nullptr;
+    }
+  }
+
+  std::size_t index = rectangle->index;
+  rectangles[index].swap(rectangles.back());
+  rectangles[index]->index = index;
+  rectangles.pop_back();
+}
+
+void MergedStaticBoxes::MergePendingBoxes() {
+  if (pendingBoxes.empty()) return;
+
+  if (!body) {
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_staticBody;
+    body = world.CreateBody(&bodyDef);
+  }
+
+  // Merge the adjacent boxes having the same top and bottom in rows...
+  std::sort(pendingBoxes.begin(),
+            pendingBoxes.end(),
+            [](const Box& a, const Box& b) {
+              if (a.friction != b.friction) return a.friction < b.friction;
+              if (a.restitution != b.restitution)
+                return a.restitution < b.restitution;
+              if (a.top != b.top) return a.top < b.top;
+              if (a.bottom != b.bottom) return a.bottom < b.bottom;
+              return a.left < b.left;
+            });
+
+  std::vector<Row> rows;
+  for (const Box& box : pendingBoxes) {
+    if (!rows.empty()) {
+      Row& row = rows.back();
+      const Box& last = row.boxes.back();
+      if (last.friction == box.friction &&
+          last.restitution == box.restitution && row.top == box.top &&
+          row.bottom == box.bottom && last.right == box.left) {
+        row.boxes.push_back(box);
+        continue;
+      }
+    }
+
+    Row row;
+    row.top = box.top;
+    row.bottom = box.bottom;
+    row.boxes.push_back(box);
+    rows.push_back(std::move(row));
+  }
+  pendingBoxes.clear();
+
+  // ...and then the rows having the same left and right sides in rectangles.
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    const Box& aFirst = a.boxes.front();
+    const Box& bFirst = b.boxes.front();
+    if (aFirst.friction != bFirst.friction)
+      return aFirst.friction < bFirst.friction;
+    if (aFirst.restitution != bFirst.restitution)
+      return aFirst.restitution < bFirst.restitution;
+    if (aFirst.left != bFirst.left) return aFirst.left < bFirst.left;
+    if (a.boxes.back().right != b.boxes.back().right)
+      return a.boxes.back().right < b.boxes.back().right;
+    return a.top < b.top;
+  });
+
+  std::size_t firstNewRectangle = rectangles.size();
+  for (Row& row : rows) {
+    if (rectangles.size() > firstNewRectangle) {
+      Row& last = rectangles.back()->rows.back();
+      const Box& lastFirst = last.boxes.front();
+      const Box& rowFirst = row.boxes.front();
+      if (lastFirst.friction == rowFirst.friction &&
+          lastFirst.restitution == rowFirst.restitution &&
+          lastFirst.left == rowFirst.left &&
+          last.boxes.back().right == row.boxes.back().right &&
+          last.bottom == row.top) {
+        rectangles.back()->rows.push_back(std::move(row));
+        continue;
+      }
+    }
+
+    std::shared_ptr<Rectangle> rectangle = std::make_shared<Rectangle>();
+    rectangle->rows.push_back(std::move(row));
+    rectangle->fixture = NULL;
+    rectangle->index = rectangles.size();
+    rectangles.push_back(std::move(rectangle));
+  }
+
+  for (std::size_t i = firstNewRectangle; i < rectangles.size(); ++i) {
+    Rectangle& rectangle = *rectangles[i];
+    CreateFixture(rectangle);
+    for (const Row& row : rectangle.rows) {
+      for (const Box& box : row.boxes)
+        behaviorsRectangles[box.behavior] = &rectangle;
+    }
+  }
+}
+
+void MergedStaticBoxes::CreateFixture(Rectangle& rectangle) {
+  const Box& first = rectangle.rows.front().boxes.front();
+  float left = first.left;
+  float right = rectangle.rows.front().boxes.back().right;
+  float top = rectangle.rows.front().top;
+  float bottom = rectangle.rows.back().bottom;
+
+  // Y axis is inverted in the world.
+  b2PolygonShape shape;
+  shape.SetAsBox(
+      (right - left) / scaleX / 2,
+      (bottom - top) / scaleY / 2,
+      b2Vec2((left + right) / scaleX / 2, -(top + bottom) / scaleY / 2),
+      0);
+
+  b2FixtureDef fixtureDef;
+  fixtureDef.shape = &shape;
+  fixtureDef.friction = first.friction;
+  fixtureDef.restitution = first.restitution;
+  fixtureDef.userData = &rectangle;
+  rectangle.fixture = body->CreateFixture(&fixtureDef);
+}
+
+bool MergedStaticBoxes::IsMergedFixture(const b2Fixture* fixture) {
+  // Only the fixtures of the merged boxes have user data.
+  return fixture->GetUserData() != NULL;
+}
+
+void MergedStaticBoxes::FindTouchedBoxes(
+    b2Contact* contact, std::vector<const RuntimeObject*>& objects) const {
+  objects.clear();
+  int pointCount = contact->GetManifold()->pointCount;
+  if (pointCount == 0) return;
+
+  const b2Fixture* fixture = IsMergedFixture(contact->GetFixtureA())
+                                 ? contact->GetFixtureA()
+                                 : contact->GetFixtureB();
+  const Rectangle& rectangle =
+      *static_cast<const Rectangle*>(fixture->GetUserData());
+
+  // Find the boxes around the contact points, in scene coordinates.
+  b2WorldManifold worldManifold;
+  contact->GetWorldManifold(&worldManifold);
+  float left = worldManifold.points[0].x * scaleX;
+  float right = left;
+  float top = -worldManifold.points[0].y * scaleY;
+  float bottom = top;
+  for (int i = 1; i < pointCount; ++i) {
+    left = std::min(left, worldManifold.points[i].x * scaleX);
+    right = std::max(right, worldManifold.points[i].x * scaleX);
+    top = std::min(top, -worldManifold.points[i].y * scaleY);
+    bottom = std::max(bottom, -worldManifold.points[i].y * scaleY);
+  }
+
+  // The points are between the surfaces of the shapes, which have a skin.
+  const float tolerance = 2 * b2_polygonRadius + b2_linearSlop;
+  left -= tolerance * scaleX;
+  right += tolerance * scaleX;
+  top -= tolerance * scaleY;
+  bottom += tolerance * scaleY;
+
+  auto row = std::lower_bound(
+      rectangle.rows.begin(),
+      rectangle.rows.end(),
+      top,
+      [](const Row& row, float top) { return row.bottom < top; });
+  for (; row != rectangle.rows.end() && row->top <= bottom; ++row) {
+    auto box = std::lower_bound(
+        row->boxes.begin(),
+        row->boxes.end(),
+        left,
+        [](const Box& box, float left) { return box.right < left; });
+    for (; box != row->boxes.end() && box->left <= right; ++box)
+      objects.push_back(box->behavior->GetObject());
+  }
+}
+
+void MergedStaticBoxes::BeginContact(b2Contact* contact) {
+  b2Fixture* otherFixture = IsMergedFixture(contact->GetFixtureA())
+                                ? contact->GetFixtureB()
+                                : contact->GetFixtureA();
+  PhysicsRuntimeBehavior* otherBehavior = static_cast<PhysicsRuntimeBehavior*>(
+      otherFixture->GetBody()->GetUserData());
+  if (!otherBehavior) return;
+
+  ContactObjects& contactObjects = contactsObjects[contact];
+  contactObjects.otherObject = otherBehavior->GetObject();
+  contactObjects.boxesObjects.clear();
+  UpdateContact(contact);
+}
+
+void MergedStaticBoxes::UpdateContact(b2Contact* contact) {
+  auto it = contactsObjects.find(contact);
+  if (it == contactsObjects.end()) return;
+
+  // Keep the objects touched until there are contact points again.
+  if (contact->GetManifold()->pointCount == 0) return;
+
+  FindTouchedBoxes(contact, touchedObjects);
+  ContactObjects& contactObjects = it->second;
+  std::vector<const RuntimeObject*>& previousObjects =
+      contactObjects.boxesObjects;
+  for (const RuntimeObject* object : touchedObjects) {
+    if (std::find(previousObjects.begin(), previousObjects.end(), object) ==
+        previousObjects.end())
+      contactPairs.BeginContact(object, contactObjects.otherObject);
+  }
+  for (const RuntimeObject* object : previousObjects) {
+    if (std::find(touchedObjects.begin(), touchedObjects.end(), object) ==
+        touchedObjects.end())
+      contactPairs.EndContact(object, contactObjects.otherObject);
+  }
+
+  previousObjects.swap(touchedObjects);
+}
+
+void MergedStaticBoxes::EndContact(b2Contact* contact) {
+  auto it = contactsObjects.find(contact);
+  if (it == contactsObjects.end()) return;
+
+  for (const RuntimeObject* object : it->second.boxesObjects)
+    contactPairs.EndContact(object, it->second.otherObject);
+  contactsObjects.erase(it);
+}
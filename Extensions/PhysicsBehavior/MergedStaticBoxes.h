@@ -0,0 +1,149 @@
+/**
+
+GDevelop - Physics Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef MERGEDSTATICBOXES_H
+#define MERGEDSTATICBOXES_H
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+class b2World;
+class b2Body;
+class b2Fixture;
+class b2Contact;
+class ContactPairs;
+class PhysicsRuntimeBehavior;
+class RuntimeObject;
+
+/**
+ * \brief Merge the boxes of the static objects (ground tiles, walls...) into
+ * large rectangles, all being the fixtures of a single static body.
+ *
+ * Adjacent boxes with the same friction and restitution are merged in rows,
+ * and then the rows having the same width are merged in rectangles. This
+ * makes far less bodies and fixtures for Box2D than with a body for each
+ * object, and the objects do not get stuck on the seams between the boxes.
+ *
+ * The contacts with a merged rectangle are resolved back to the objects whose
+ * boxes contain the contact points, updated at each step of the world, so
+ * that the contacts of the objects are still stored in ContactPairs.
+ *
+ * When a merged object is removed (destroyed, moved or given its own body),
+ * its rectangle is split: the other boxes of the rectangle are merged again at
+ * the next step.
+ */
+class MergedStaticBoxes {
+ public:
+  MergedStaticBoxes(b2World& world_,
+                    ContactPairs& contactPairs_,
+                    float scaleX_,
+                    float scaleY_);
+  virtual ~MergedStaticBoxes(){};
+
+  /**
+   * \brief Add the box of a static object, to be merged at the next step.
+   *
+   * The box is in scene coordinates (pixels, with the Y axis going down).
+   */
+  void Add(PhysicsRuntimeBehavior* behavior,
+           float left,
+           float top,
+           float right,
+           float bottom,
+           float friction,
+           float restitution);
+
+  /**
+   * \brief Remove the box of the object, splitting its rectangle if it was
+   * merged. Does nothing if the box was not added.
+   */
+  void Remove(PhysicsRuntimeBehavior* behavior);
+
+  /**
+   * \brief Merge the boxes added since the last call in new rectangles.
+   */
+  void MergePendingBoxes();
+
+  /**
+   * \brief Return the number of rectangles made from the merged boxes.
+   */
+  std::size_t GetRectanglesCount() const { return rectangles.size(); }
+
+  /**
+   * \brief Return true if the fixture is a rectangle of merged boxes.
+   */
+  static bool IsMergedFixture(const b2Fixture* fixture);
+
+  /**
+   * \name Contacts
+   * To be called by the contact listener for the contacts with a fixture of
+   * merged boxes (see IsMergedFixture).
+   */
+  ///@{
+  void BeginContact(b2Contact* contact);
+  void UpdateContact(b2Contact* contact);
+  void EndContact(b2Contact* contact);
+  ///@}
+
+ private:
+  struct Box {
+    PhysicsRuntimeBehavior* behavior;
+    float left;
+    float top;
+    float right;
+    float bottom;
+    float friction;
+    float restitution;
+  };
+
+  /**
+   * \brief Adjacent boxes having the same top and bottom, sorted by their
+   * left side.
+   */
+  struct Row {
+    float top;
+    float bottom;
+    std::vector<Box> boxes;
+  };
+
+  /**
+   * \brief Rows having the same left and right sides, sorted by their top.
+   */
+  struct Rectangle {
+    std::vector<Row> rows;
+    b2Fixture* fixture;
+    std::size_t index;  ///< The position in MergedStaticBoxes::rectangles.
+  };
+
+  /**
+   * \brief The objects whose boxes are touched by a contact, and the object
+   * touching them.
+   */
+  struct ContactObjects {
+    const RuntimeObject* otherObject;
+    std::vector<const RuntimeObject*> boxesObjects;
+  };
+
+  void CreateFixture(Rectangle& rectangle);
+  void FindTouchedBoxes(b2Contact* contact,
+                        std::vector<const RuntimeObject*>& objects) const;
+
+  b2World& world;
+  ContactPairs& contactPairs;
+  float scaleX;
+  float scaleY;
+  b2Body* body;  ///< The static body of the fixtures, created when needed.
+  std::vector<Box> pendingBoxes;
+  std::vector<std::shared_ptr<Rectangle> > rectangles;
+  std::unordered_map<PhysicsRuntimeBehavior*, Rectangle*>
+      behaviorsRectangles;  ///< The rectangle of each box, or nullptr if not
+                            ///< merged yet.
+  std::unordered_map<b2Contact*, ContactObjects> contactsObjects;
+  std::vector<const RuntimeObject*> touchedObjects;  ///< Reused by the
+                                                     ///< contacts updates.
+};
+
+#endif  // MERGEDSTATICBOXES_H
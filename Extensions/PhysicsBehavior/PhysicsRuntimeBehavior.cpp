@@ -16,7 +16,6 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
 #include "RuntimeScenePhysicsDatas.h"
-#include "Triangulation/triangulate.h"
 
 #undef GetObject
 
@@ -32,8 +31,14 @@ PhysicsRuntimeBehavior::PhysicsRuntimeBehavior(
       averageRestitution(0),
       linearDamping(0.1),
       angularDamping(0.1),
+      previousBodyX(0),
+      previousBodyY(0),
+      previousBodyAngle(0),
+      restingPositionWritten(false),
       body(NULL),
-      runtimeScenesPhysicsDatas(NULL) {
+      mergedBox(false),
+      runtimeScenesPhysicsDatas(NULL),
+      sharedDataIndex(gd::String::npos) {
   polygonHeight = 200;
   polygonWidth = 200;
   automaticResizing = false;
@@ -77,6 +82,8 @@ PhysicsRuntimeBehavior::PhysicsRuntimeBehavior(
 PhysicsRuntimeBehavior::~PhysicsRuntimeBehavior() {
   if (runtimeScenesPhysicsDatas != NULL && body)
     runtimeScenesPhysicsDatas->world->DestroyBody(body);
+  if (runtimeScenesPhysicsDatas != NULL && mergedBox)
+    runtimeScenesPhysicsDatas->mergedStaticBoxes.Remove(this);
 }
 
 /**
@@ -84,7 +91,7 @@ PhysicsRuntimeBehavior::~PhysicsRuntimeBehavior() {
  * Simulate the world if necessary and update body positions.
  */
 void PhysicsRuntimeBehavior::DoStepPreEvents(RuntimeScene &scene) {
-  if (!body) CreateBody(scene);
+  if (!body && !mergedBox && !MergeStaticBox(scene)) CreateBody(scene);
 
   if (!runtimeScenesPhysicsDatas
            ->stepped)  // Simulate the world, once at each frame
@@ -94,29 +101,62 @@ void PhysicsRuntimeBehavior::DoStepPreEvents(RuntimeScene &scene) {
             1000000.0,
         6,
         10);
+    runtimeScenesPhysicsDatas->UpdateObjectsFromBodies();
     runtimeScenesPhysicsDatas->stepped = true;
   }
+}
+
+void PhysicsRuntimeBehavior::UpdateObjectFromBody() {
+  bool resting = !body->IsAwake() || body->GetType() == b2_staticBody;
 
   // Update object position according to Box2D body
   b2Vec2 position = body->GetPosition();
+  float angle = body->GetAngle();
+  float interpolationFactor =
+      runtimeScenesPhysicsDatas->GetInterpolationFactor();
+  if (resting) {
+    SavePreviousBodyTransform();
+  } else if (interpolationFactor < 1) {
+    position.x = previousBodyX + (position.x - previousBodyX) *
+                                     interpolationFactor;
+    position.y = previousBodyY + (position.y - previousBodyY) *
+                                     interpolationFactor;
+    angle = previousBodyAngle + (angle - previousBodyAngle) *
+                                    interpolationFactor;
+  }
+  restingPositionWritten = resting;
+
   object->SetX(position.x * runtimeScenesPhysicsDatas->GetScaleX() -
                object->GetWidth() / 2 + object->GetX() -
                object->GetDrawableX());
   object->SetY(-position.y * runtimeScenesPhysicsDatas->GetScaleY() -
                object->GetHeight() / 2 + object->GetY() -
                object->GetDrawableY());                  // Y axis is inverted
-  object->SetAngle(-body->GetAngle() * 180.0f / b2_pi);  // Angles are inverted
+  object->SetAngle(-angle * 180.0f / b2_pi);  // Angles are inverted
 
   objectOldX = object->GetX();
   objectOldY = object->GetY();
   objectOldAngle = object->GetAngle();
-};
+}
 
 /**
  * Called at each frame after events :
  * Update Box2D body if necessary
  */
 void PhysicsRuntimeBehavior::DoStepPostEvents(RuntimeScene &scene) {
+  if (!body && mergedBox) {
+    runtimeScenesPhysicsDatas->stepped = false;  // Prepare for a new simulation
+
+    // A merged box moved or resized by the events gets its own body.
+    if (objectOldX == object->GetX() && objectOldY == object->GetY() &&
+        objectOldAngle == object->GetAngle() &&
+        (int)objectOldWidth == (int)object->GetWidth() &&
+        (int)objectOldHeight == (int)object->GetHeight())
+      return;
+
+    CreateBody(scene);
+    return;
+  }
   if (!body) CreateBody(scene);
 
   // Note: Strange bug here, using SpriteObject, the tests objectOldWidth !=
@@ -152,15 +192,34 @@ void PhysicsRuntimeBehavior::DoStepPostEvents(RuntimeScene &scene) {
   body->SetTransform(
       oldPos, -object->GetAngle() * b2_pi / 180.0f);  // Angles are inverted
   body->SetAwake(true);
+  SavePreviousBodyTransform();  // Don't interpolate from the old position.
+  restingPositionWritten = false;
+}
+
+void PhysicsRuntimeBehavior::SavePreviousBodyTransform() {
+  if (!body) return;
+
+  previousBodyX = body->GetPosition().x;
+  previousBodyY = body->GetPosition().y;
+  previousBodyAngle = body->GetAngle();
 }
 
 /**
  * Prepare Box2D body, and set up also runtimeScenePhysicsDatasPtr.
  */
 void PhysicsRuntimeBehavior::CreateBody(const RuntimeScene &scene) {
-  if (runtimeScenesPhysicsDatas == NULL)
-    runtimeScenesPhysicsDatas = static_cast<RuntimeScenePhysicsDatas *>(
-        scene.GetBehaviorSharedData(name).get());
+  if (runtimeScenesPhysicsDatas == NULL) {
+    // The slot of the shared data is kept by the copies of the behavior.
+    if (sharedDataIndex == gd::String::npos)
+      sharedDataIndex = scene.GetBehaviorSharedDataIndex(name);
+    runtimeScenesPhysicsDatas =
+        scene.GetBehaviorSharedData<RuntimeScenePhysicsDatas>(sharedDataIndex);
+  }
+
+  if (mergedBox) {
+    runtimeScenesPhysicsDatas->mergedStaticBoxes.Remove(this);
+    mergedBox = false;
+  }
 
   // Create body from object
   b2BodyDef bodyDef;
@@ -194,61 +253,22 @@ void PhysicsRuntimeBehavior::CreateBody(const RuntimeScene &scene) {
 
     body->CreateFixture(&fixtureDef);
   } else if (shapeType == CustomPolygon && polygonCoords.size() > 2) {
-    // Make a polygon triangulation to make possible to use a concave polygon
-    // and more than 8 edged polygons
-    std::vector<sf::Vector2f> resultOfTriangulation;
-
-    Triangulate::Process(polygonCoords, resultOfTriangulation);
-
-    // Iterate over all triangles
-    for (std::size_t i = 0; i < resultOfTriangulation.size() / 3; i++) {
+    RuntimeScenePhysicsDatas::PolygonShapesKey key;
+    key.polygon = polygonCoords;
+    key.onCenter = polygonPositioning == OnCenter;
+    key.polygonScaleX = GetPolygonScaleX();
+    key.polygonScaleY = GetPolygonScaleY();
+    key.width = object->GetWidth();
+    key.height = object->GetHeight();
+    key.originX = object->GetX() - object->GetDrawableX();
+    key.originY = object->GetY() - object->GetDrawableY();
+
+    // The shapes are shared by all the bodies with the same polygon and size.
+    const std::vector<b2PolygonShape> &shapes =
+        runtimeScenesPhysicsDatas->GetPolygonShapes(key);
+    for (const b2PolygonShape &shape : shapes) {
       b2FixtureDef fixtureDef;
-      b2PolygonShape dynamicBox;
-
-      // Create vertices
-      b2Vec2 vertices[3];
-
-      std::size_t b = 0;
-      for (int a = 2; a >= 0; a--)  // Box2D use another direction for vertices
-      {
-        if (polygonPositioning == OnOrigin) {
-          vertices[b].Set(
-              (resultOfTriangulation.at(i * 3 + a).x * GetPolygonScaleX() -
-               object->GetWidth() / 2 -
-               (object->GetDrawableX() - object->GetX())) *
-                  runtimeScenesPhysicsDatas->GetInvScaleX(),
-              (((object->GetHeight() -
-                 (resultOfTriangulation.at(i * 3 + a).y * GetPolygonScaleY())) -
-                object->GetHeight() / 2 +
-                (object->GetDrawableY() - object->GetY())) *
-               runtimeScenesPhysicsDatas->GetInvScaleY()));
-        }
-        /*else if(polygonPositioning == OnTopLeftCorner)
-        {
-            vertices[b].Set((resultOfTriangulation.at(i*3 + a).x *
-        GetPolygonScaleX() - object->GetWidth()/2 ) *
-        runtimeScenesPhysicsDatas->GetInvScaleX(),
-                            (((object->GetHeight() -
-        (resultOfTriangulation.at(i*3 + a).y * GetPolygonScaleY())) -
-        object->GetHeight()/2)                   *
-        runtimeScenesPhysicsDatas->GetInvScaleY()));
-        }*/
-        else if (polygonPositioning == OnCenter) {
-          vertices[b].Set(
-              (resultOfTriangulation.at(i * 3 + a).x * GetPolygonScaleX()) *
-                  runtimeScenesPhysicsDatas->GetInvScaleX(),
-              (((object->GetHeight() -
-                 (resultOfTriangulation.at(i * 3 + a).y * GetPolygonScaleY())) -
-                object->GetHeight()) *
-               runtimeScenesPhysicsDatas->GetInvScaleY()));
-        }
-
-        b++;
-      }
-
-      dynamicBox.Set(vertices, 3);
-
-      fixtureDef.shape = &dynamicBox;
+      fixtureDef.shape = &shape;
       fixtureDef.density = massDensity;
       fixtureDef.friction = averageFriction;
       fixtureDef.restitution = averageRestitution;
@@ -273,6 +293,43 @@ void PhysicsRuntimeBehavior::CreateBody(const RuntimeScene &scene) {
 
   objectOldWidth = object->GetWidth();
   objectOldHeight = object->GetHeight();
+  SavePreviousBodyTransform();
+  restingPositionWritten = false;
+}
+
+bool PhysicsRuntimeBehavior::MergeStaticBox(const RuntimeScene &scene) {
+  if (runtimeScenesPhysicsDatas == NULL) {
+    // The slot of the shared data is kept by the copies of the behavior.
+    if (sharedDataIndex == gd::String::npos)
+      sharedDataIndex = scene.GetBehaviorSharedDataIndex(name);
+    runtimeScenesPhysicsDatas =
+        scene.GetBehaviorSharedData<RuntimeScenePhysicsDatas>(sharedDataIndex);
+  }
+
+  if (dynamic || shapeType != Box || object->GetAngle() != 0 ||
+      !runtimeScenesPhysicsDatas->IsMergingStaticBoxes())
+    return false;
+
+  // The same box as the one of a body (see CreateBody), in scene coordinates.
+  float centerX = object->GetDrawableX() + object->GetWidth() / 2;
+  float centerY = object->GetDrawableY() + object->GetHeight() / 2;
+  float width = object->GetWidth() > 0 ? object->GetWidth() : 1.0f;
+  float height = object->GetHeight() > 0 ? object->GetHeight() : 1.0f;
+  runtimeScenesPhysicsDatas->mergedStaticBoxes.Add(this,
+                                                   centerX - width / 2,
+                                                   centerY - height / 2,
+                                                   centerX + width / 2,
+                                                   centerY + height / 2,
+                                                   averageFriction,
+                                                   averageRestitution);
+  mergedBox = true;
+
+  objectOldX = object->GetX();
+  objectOldY = object->GetY();
+  objectOldAngle = object->GetAngle();
+  objectOldWidth = object->GetWidth();
+  objectOldHeight = object->GetHeight();
+  return true;
 }
 
 void PhysicsRuntimeBehavior::OnDeActivate() {
@@ -281,6 +338,10 @@ void PhysicsRuntimeBehavior::OnDeActivate() {
     body = NULL;  // Of course: body can ( and will ) be reused: Make sure we
                   // nullify the pointer as the body was destroyed.
   }
+  if (runtimeScenesPhysicsDatas && mergedBox) {
+    runtimeScenesPhysicsDatas->mergedStaticBoxes.Remove(this);
+    mergedBox = false;
+  }
 }
 
 /**
@@ -611,32 +672,19 @@ double PhysicsRuntimeBehavior::GetAngularDamping(const RuntimeScene &scene) {
 bool PhysicsRuntimeBehavior::CollisionWith(
     std::map<gd::String, std::vector<RuntimeObject *> *> otherObjectsLists,
     RuntimeScene &scene) {
-  if (!body) CreateBody(scene);
+  if (!body && !mergedBox) CreateBody(scene);
 
-  // Getting a list of all objects which are tested
-  std::vector<RuntimeObject *> objects;
+  // Test if an object of the lists is in contact with our object, looking up
+  // the pairs of objects in contact of the scene.
+  const ContactPairs &contactPairs = runtimeScenesPhysicsDatas->contactPairs;
   for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
            otherObjectsLists.begin();
        it != otherObjectsLists.end();
        ++it) {
-    if (it->second != NULL) {
-      objects.reserve(objects.size() + it->second->size());
-      std::copy(
-          it->second->begin(), it->second->end(), std::back_inserter(objects));
-    }
-  }
+    if (it->second == NULL) continue;
 
-  // Test if an object of the list is in collision with our object.
-  std::vector<RuntimeObject *>::const_iterator obj_end = objects.end();
-  for (std::vector<RuntimeObject *>::iterator obj = objects.begin();
-       obj != obj_end;
-       ++obj) {
-    std::set<PhysicsRuntimeBehavior *>::const_iterator it =
-        currentContacts.begin();
-    std::set<PhysicsRuntimeBehavior *>::const_iterator end =
-        currentContacts.end();
-    for (; it != end; ++it) {
-      if ((*it)->GetObject() == (*obj)) return true;
+    for (const RuntimeObject *otherObject : *it->second) {
+      if (contactPairs.AreInContact(object, otherObject)) return true;
     }
   }
 
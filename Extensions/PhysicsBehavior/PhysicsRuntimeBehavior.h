@@ -8,7 +8,6 @@ This project is released under the MIT License.
 #ifndef PHYSICSRUNTIMEBEHAVIOR_H
 #define PHYSICSRUNTIMEBEHAVIOR_H
 #include <map>
-#include <set>
 #include <vector>
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
@@ -47,10 +46,6 @@ class GD_EXTENSION_API PhysicsRuntimeBehavior : public RuntimeBehavior {
   inline RuntimeObject *GetObject() { return object; };
   inline const RuntimeObject *GetObject() const { return object; };
 
-  std::set<PhysicsRuntimeBehavior *>
-      currentContacts;  ///< List of other bodies that are in contact with this
-                        ///< body.
-
   void SetStatic(RuntimeScene &scene);
   void SetDynamic(RuntimeScene &scene);
   bool IsStatic();
@@ -143,11 +138,39 @@ class GD_EXTENSION_API PhysicsRuntimeBehavior : public RuntimeBehavior {
       std::map<gd::String, std::vector<RuntimeObject *> *> otherObjectsLists,
       RuntimeScene &scene);
 
+  /**
+   * \brief Store the current position and angle of the body, used to
+   * interpolate the position of the object until the next step of the world.
+   * \see RuntimeScenePhysicsDatas::GetInterpolationFactor
+   */
+  void SavePreviousBodyTransform();
+
+  /**
+   * \brief Update the position and the angle of the object from the body.
+   * \see RuntimeScenePhysicsDatas::UpdateObjectsFromBodies
+   */
+  void UpdateObjectFromBody();
+
+  /**
+   * \brief Return true if the body is sleeping (or static) and its position
+   * was already written in the object.
+   */
+  bool IsRestingPositionWritten() const { return restingPositionWritten; }
+
  private:
   virtual void DoStepPreEvents(RuntimeScene &scene);
   virtual void DoStepPostEvents(RuntimeScene &scene);
   void CreateBody(const RuntimeScene &scene);
 
+  /**
+   * \brief Add the box of the object to the merged static boxes of the scene,
+   * instead of creating a body, if the object is a static box that is not
+   * rotated.
+   * \return true if the box was added.
+   * \see MergedStaticBoxes
+   */
+  bool MergeStaticBox(const RuntimeScene &scene);
+
   enum ShapeType {
     Box,
     Circle,
@@ -185,11 +208,21 @@ class GD_EXTENSION_API PhysicsRuntimeBehavior : public RuntimeBehavior {
   float objectOldAngle;
   float objectOldWidth;
   float objectOldHeight;
+  float previousBodyX;  ///< The position of the body before the last step of
+                        ///< the world.
+  float previousBodyY;
+  float previousBodyAngle;
+  bool restingPositionWritten;  ///< True if the body did not move since its
+                                ///< position was last written in the object.
 
   sf::Clock *stepClock;
 
   b2Body *body;  ///< Box2D body, representing the object in the Box2D world
+  bool mergedBox;  ///< True if the object has no body and its box is in the
+                   ///< merged static boxes of the scene.
   RuntimeScenePhysicsDatas *runtimeScenesPhysicsDatas;
+  std::size_t sharedDataIndex;  ///< The slot of the shared data in the scene
+                                ///< (gd::String::npos if not resolved yet).
 };
 
 #endif  // PHYSICSRUNTIMEBEHAVIOR_H
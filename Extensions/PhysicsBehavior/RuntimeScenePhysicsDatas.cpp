@@ -10,7 +10,11 @@ This project is released under the MIT License.
 #include "Box2D/Box2D.h"
 #include "ContactListener.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "PhysicsRuntimeBehavior.h"
 #include "ScenePhysicsDatas.h"
+#include "Triangulation/triangulate.h"
+
+const std::size_t RuntimeScenePhysicsDatas::maxPolygonsShapesCount = 256;
 
 RuntimeScenePhysicsDatas::RuntimeScenePhysicsDatas(
     const gd::SerializerElement& behaviorSharedDataContent)
@@ -19,7 +23,12 @@ RuntimeScenePhysicsDatas::RuntimeScenePhysicsDatas(
           b2Vec2(behaviorSharedDataContent.GetDoubleAttribute("gravityX"),
                  -behaviorSharedDataContent.GetDoubleAttribute("gravityY")),
           true)),
-      contactListener(new ContactListener),
+      mergedStaticBoxes(
+          *world,
+          contactPairs,
+          behaviorSharedDataContent.GetDoubleAttribute("scaleX"),
+          behaviorSharedDataContent.GetDoubleAttribute("scaleY")),
+      contactListener(new ContactListener(contactPairs, mergedStaticBoxes)),
       staticBody(NULL),
       stepped(false),
       scaleX(behaviorSharedDataContent.GetDoubleAttribute("scaleX")),
@@ -28,15 +37,28 @@ RuntimeScenePhysicsDatas::RuntimeScenePhysicsDatas(
       invScaleY(1 / scaleY),
       fixedTimeStep(1.f / 60.f),
       maxSteps(5),
-      totalTime(0) {
+      interpolation(
+          behaviorSharedDataContent.GetBoolAttribute("interpolation", false)),
+      mergeStaticBoxes(behaviorSharedDataContent.GetBoolAttribute(
+          "mergeStaticBoxes", true)),
+      totalTime(0),
+      memoryAccount(gd::SystemStats::Physics) {
+  int maxStepsAttribute =
+      behaviorSharedDataContent.GetIntAttribute("maxSteps", 5);
+  if (maxStepsAttribute > 0) maxSteps = maxStepsAttribute;
+
   world->SetContactListener(contactListener);
   world->SetAutoClearForces(false);
+  world->SetIslandSolverThreadCount(
+      behaviorSharedDataContent.GetIntAttribute("solverThreads", 1));
 
   b2BodyDef bodyWithoutFixture;
   staticBody = world->CreateBody(&bodyWithoutFixture);
 }
 
 void RuntimeScenePhysicsDatas::StepWorld(float dt, int v, int p) {
+  contactPairs.StartFrame();
+  mergedStaticBoxes.MergePendingBoxes();
   totalTime += dt;
 
   if (totalTime > fixedTimeStep) {
@@ -46,10 +68,87 @@ void RuntimeScenePhysicsDatas::StepWorld(float dt, int v, int p) {
     std::size_t numberOfStepToProcess = std::min(numberOfSteps, maxSteps);
 
     for (std::size_t a = 0; a < numberOfStepToProcess; a++) {
+      // Objects are interpolated between the two last states of the world.
+      if (interpolation && a == numberOfStepToProcess - 1) {
+        for (b2Body* body = world->GetBodyList(); body;
+             body = body->GetNext()) {
+          if (body->IsAwake() && body->GetUserData())
+            static_cast<PhysicsRuntimeBehavior*>(body->GetUserData())
+                ->SavePreviousBodyTransform();
+        }
+      }
+
       world->Step(fixedTimeStep, v, p);
       world->ClearForces();
     }
   }
+
+  // Estimated from the objects of the world (each proxy being a fixture with
+  // its shape), as Box2D allocates them in its own block allocator.
+  memoryAccount.SetBytes(
+      sizeof(b2World) + world->GetBodyCount() * sizeof(b2Body) +
+      world->GetProxyCount() * (sizeof(b2Fixture) + sizeof(b2PolygonShape)) +
+      world->GetContactCount() * sizeof(b2Contact) +
+      world->GetJointCount() * sizeof(b2Joint));
+}
+
+void RuntimeScenePhysicsDatas::UpdateObjectsFromBodies() {
+  for (b2Body* body = world->GetBodyList(); body; body = body->GetNext()) {
+    PhysicsRuntimeBehavior* behavior =
+        static_cast<PhysicsRuntimeBehavior*>(body->GetUserData());
+    if (!behavior) continue;
+
+    bool resting = !body->IsAwake() || body->GetType() == b2_staticBody;
+    if (resting && behavior->IsRestingPositionWritten()) continue;
+
+    behavior->UpdateObjectFromBody();
+  }
+}
+
+const std::vector<b2PolygonShape>& RuntimeScenePhysicsDatas::GetPolygonShapes(
+    const PolygonShapesKey& key) {
+  auto it = polygonsShapes.find(key);
+  if (it != polygonsShapes.end()) return it->second;
+
+  // Objects with many different sizes would make too many shapes.
+  if (polygonsShapes.size() >= maxPolygonsShapesCount) polygonsShapes.clear();
+
+  // Make a polygon triangulation to make possible to use a concave polygon
+  // and more than 8 edged polygons
+  std::vector<sf::Vector2f> resultOfTriangulation;
+  Triangulate::Process(key.polygon, resultOfTriangulation);
+
+  std::vector<b2PolygonShape>& shapes = polygonsShapes[key];
+  shapes.resize(resultOfTriangulation.size() / 3);
+  for (std::size_t i = 0; i < shapes.size(); i++) {
+    // Create vertices
+    b2Vec2 vertices[3];
+
+    std::size_t b = 0;
+    for (int a = 2; a >= 0; a--)  // Box2D use another direction for vertices
+    {
+      const sf::Vector2f& point = resultOfTriangulation[i * 3 + a];
+      if (!key.onCenter) {
+        vertices[b].Set(
+            (point.x * key.polygonScaleX - key.width / 2 + key.originX) *
+                invScaleX,
+            (((key.height - (point.y * key.polygonScaleY)) - key.height / 2 -
+              key.originY) *
+             invScaleY));
+      } else {
+        vertices[b].Set(
+            (point.x * key.polygonScaleX) * invScaleX,
+            (((key.height - (point.y * key.polygonScaleY)) - key.height) *
+             invScaleY));
+      }
+
+      b++;
+    }
+
+    shapes[i].Set(vertices, 3);
+  }
+
+  return shapes;
 }
 
 RuntimeScenePhysicsDatas::~RuntimeScenePhysicsDatas() {
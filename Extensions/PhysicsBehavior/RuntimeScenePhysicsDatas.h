@@ -7,6 +7,13 @@ This project is released under the MIT License.
 
 #ifndef RUNTIMESCENEPHYSICSDATAS_H
 #define RUNTIMESCENEPHYSICSDATAS_H
+#include <SFML/System/Vector2.hpp>
+#include <unordered_map>
+#include <vector>
+#include "Box2D/Collision/Shapes/b2PolygonShape.h"
+#include "ContactPairs.h"
+#include "GDCore/Tools/SystemStats.h"
+#include "MergedStaticBoxes.h"
 namespace gd {
 class SerializerElement;
 }
@@ -30,6 +37,10 @@ class RuntimeScenePhysicsDatas : public BehaviorsRuntimeSharedData {
   }
 
   b2World* world;
+  ContactPairs contactPairs;  ///< The objects in contact, updated by
+                              ///< contactListener.
+  MergedStaticBoxes mergedStaticBoxes;  ///< The boxes of the static objects,
+                                        ///< merged in a single body.
   ContactListener* contactListener;
   b2Body*
       staticBody;  ///< A simple static body with no fixture. Used for joints.
@@ -56,12 +67,84 @@ class RuntimeScenePhysicsDatas : public BehaviorsRuntimeSharedData {
    */
   inline float GetInvScaleY() const { return invScaleY; }
 
+  /**
+   * \brief Return true if the boxes of the static objects are to be merged
+   * (see MergedStaticBoxes).
+   */
+  bool IsMergingStaticBoxes() const { return mergeStaticBoxes; }
+
   /**
    * Call world->Step(), ensuring that the timeStep passed to Step() is fixed.
    * This method is to be called once a frame ( by PhysicsBehavior ).
+   *
+   * The elapsed time is accumulated, and the world is stepped as many times as
+   * the accumulated time contains fixed time steps (at most maxSteps times).
+   * The contacts of the previous frame are forgotten first (see
+   * ContactPairs::StartFrame), and the boxes of the static objects added
+   * since the last step are merged (see MergedStaticBoxes).
    */
   void StepWorld(float dt, int v, int p);
 
+  /**
+   * \brief Get the position between the previous and the current state of the
+   * world to be used to render the objects.
+   *
+   * \return 1 if the positions are not interpolated, or the time accumulated
+   * since the last step, divided by the fixed time step.
+   * \see PhysicsRuntimeBehavior::SavePreviousBodyTransform
+   */
+  float GetInterpolationFactor() const {
+    return interpolation ? totalTime / fixedTimeStep : 1;
+  }
+
+  /**
+   * \brief Update the objects of the bodies of the world, once the world was
+   * stepped.
+   *
+   * All the bodies are walked at once. Sleeping and static bodies are not
+   * moved by the simulation: their objects are skipped once updated (when a
+   * body is moved by the events, it is woken up).
+   */
+  void UpdateObjectsFromBodies();
+
+  /**
+   * \brief The parameters from which the convex shapes of a custom polygon
+   * are made.
+   */
+  struct PolygonShapesKey {
+    std::vector<sf::Vector2f> polygon;
+    bool onCenter;  ///< True if the polygon is positioned on the center of
+                    ///< the object, false if positioned on its origin.
+    float polygonScaleX;
+    float polygonScaleY;
+    float width;    ///< The size of the object.
+    float height;
+    float originX;  ///< The position of the origin of the object, relative to
+                    ///< its drawable position.
+    float originY;
+
+    bool operator==(const PolygonShapesKey& other) const {
+      return polygon == other.polygon && onCenter == other.onCenter &&
+             polygonScaleX == other.polygonScaleX &&
+             polygonScaleY == other.polygonScaleY && width == other.width &&
+             height == other.height && originX == other.originX &&
+             originY == other.originY;
+    }
+  };
+
+  /**
+   * \brief Get the convex shapes of a custom polygon, in world coordinates
+   * relative to the center of the body.
+   *
+   * The polygon is triangulated only once for all the bodies created with the
+   * same polygon and object size: the shapes are shared by their fixtures.
+   *
+   * \warning The returned reference is only valid until the shapes of another
+   * polygon are requested.
+   */
+  const std::vector<b2PolygonShape>& GetPolygonShapes(
+      const PolygonShapesKey& key);
+
  private:
   float scaleX;
   float scaleY;
@@ -75,8 +158,35 @@ class RuntimeScenePhysicsDatas : public BehaviorsRuntimeSharedData {
       maxSteps;  ///< Maximum steps per frames, to prevent slow down (a slow
                  ///< down will force the computer to make more steps which will
                  ///< force it to make even more steps...)
+  bool interpolation;  ///< True to interpolate the positions of the objects
+                       ///< between the two last states of the world.
+  bool mergeStaticBoxes;
+
+  float totalTime;  ///< The time accumulated and not simulated yet.
+  gd::MemoryAccount memoryAccount;  ///< The memory of the world, updated at
+                                    ///< each step.
+
+  struct PolygonShapesKeyHash {
+    std::size_t operator()(const PolygonShapesKey& key) const {
+      std::hash<float> hashFloat;
+      std::size_t hash = key.onCenter;
+      hash = hash * 31 + hashFloat(key.polygonScaleX);
+      hash = hash * 31 + hashFloat(key.polygonScaleY);
+      hash = hash * 31 + hashFloat(key.width);
+      hash = hash * 31 + hashFloat(key.height);
+      for (const sf::Vector2f& point : key.polygon) {
+        hash = hash * 31 + hashFloat(point.x);
+        hash = hash * 31 + hashFloat(point.y);
+      }
+      return hash;
+    }
+  };
+  std::unordered_map<PolygonShapesKey,
+                     std::vector<b2PolygonShape>,
+                     PolygonShapesKeyHash>
+      polygonsShapes;  ///< The shapes of the custom polygons of the bodies.
 
-  float totalTime;
+  static const std::size_t maxPolygonsShapesCount;
 };
 
 #endif  // RUNTIMESCENEPHYSICSDATAS_H
@@ -22,6 +22,10 @@ void ScenePhysicsDatas::InitializeContent(
   behaviorSharedDataContent.SetAttribute("gravityY", 9);
   behaviorSharedDataContent.SetAttribute("scaleX", 100);
   behaviorSharedDataContent.SetAttribute("scaleY", 100);
+  behaviorSharedDataContent.SetAttribute("maxSteps", 5);
+  behaviorSharedDataContent.SetAttribute("interpolation", false);
+  behaviorSharedDataContent.SetAttribute("solverThreads", 1);
+  behaviorSharedDataContent.SetAttribute("mergeStaticBoxes", true);
 };
 
 #if defined(GD_IDE_ONLY)
@@ -37,6 +41,24 @@ std::map<gd::String, gd::PropertyDescriptor> ScenePhysicsDatas::GetProperties(
       gd::String::From(behaviorSharedDataContent.GetDoubleAttribute("scaleX")));
   properties[_("Y Scale: number of pixels for 1 meter")].SetValue(
       gd::String::From(behaviorSharedDataContent.GetDoubleAttribute("scaleY")));
+  properties[_("Maximum simulation steps per frame")].SetValue(
+      gd::String::From(
+          behaviorSharedDataContent.GetIntAttribute("maxSteps", 5)));
+  properties[_("Interpolate objects positions between simulation steps")]
+      .SetValue(
+          behaviorSharedDataContent.GetBoolAttribute("interpolation", false)
+              ? "true"
+              : "false")
+      .SetType("Boolean");
+  properties[_("Threads simulating separated groups of objects (1 for none)")]
+      .SetValue(gd::String::From(
+          behaviorSharedDataContent.GetIntAttribute("solverThreads", 1)));
+  properties[_("Merge the adjacent static boxes in a single body")]
+      .SetValue(behaviorSharedDataContent.GetBoolAttribute("mergeStaticBoxes",
+                                                           true)
+                    ? "true"
+                    : "false")
+      .SetType("Boolean");
 
   return properties;
 }
@@ -58,6 +80,21 @@ bool ScenePhysicsDatas::UpdateProperty(
   if (name == _("Y scale: number of pixels for 1 meter")) {
     behaviorSharedDataContent.SetAttribute("scaleY", value.To<float>());
   }
+  if (name == _("Maximum simulation steps per frame")) {
+    if (value.To<int>() < 1) return false;
+    behaviorSharedDataContent.SetAttribute("maxSteps", value.To<int>());
+  }
+  if (name == _("Interpolate objects positions between simulation steps")) {
+    behaviorSharedDataContent.SetAttribute("interpolation", (value != "0"));
+  }
+  if (name ==
+      _("Threads simulating separated groups of objects (1 for none)")) {
+    if (value.To<int>() < 1) return false;
+    behaviorSharedDataContent.SetAttribute("solverThreads", value.To<int>());
+  }
+  if (name == _("Merge the adjacent static boxes in a single body")) {
+    behaviorSharedDataContent.SetAttribute("mergeStaticBoxes", (value != "0"));
+  }
 
   return true;
 }
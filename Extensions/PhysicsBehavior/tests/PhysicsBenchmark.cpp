@@ -0,0 +1,119 @@
+/**
+
+GDevelop - Physics Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Benchmark of the steps of the bodies of the Physics extension.
+ * Hidden by default: run the tests with "[benchmark]" as argument to launch
+ * it.
+ */
+#define CATCH_CONFIG_MAIN
+#include <string>
+#include "../../../GDCpp/tests/benchmarks/StepsBenchmark.h"
+#include "../PhysicsBehavior.h"
+#include "../PhysicsRuntimeBehavior.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/BehaviorContent.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Extensions/CppPlatform.h"
+#include "GDCpp/Extensions/ExtensionBase.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+extern "C" ExtensionBase *GD_EXTENSION_API CreateGDExtension();
+
+namespace {
+// Mock objects that can have a specific size
+class ResizableRuntimeObject : public RuntimeObject {
+ public:
+  ResizableRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj), width(0), height(0) {}
+
+  float GetWidth() const override { return width; }
+  float GetHeight() const override { return height; }
+  void SetWidth(float newWidth) override { width = newWidth; }
+  void SetHeight(float newHeight) override { height = newHeight; }
+
+ private:
+  float width;
+  float height;
+};
+
+std::unique_ptr<PhysicsRuntimeBehavior> CreatePhysicsRuntimeBehavior(
+    bool dynamic) {
+  gd::SerializerElement behaviorContent;
+  PhysicsBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  behaviorContent.SetAttribute("dynamic", dynamic);
+  auto runtimeBehavior =
+      gd::make_unique<PhysicsRuntimeBehavior>(behaviorContent);
+  runtimeBehavior->SetName("Physics");  // To find the shared data.
+  return runtimeBehavior;
+}
+}  // namespace
+
+TEST_CASE("PhysicsRuntimeBehavior benchmark", "[.][benchmark][physics]") {
+  // The shared data of the behavior (the Box2D world) are created by the
+  // platform when the scene is loaded.
+  static bool extensionAdded = false;
+  if (!extensionAdded) {
+    CppPlatform::Get().AddExtension(
+        std::shared_ptr<gd::PlatformExtension>(CreateGDExtension()));
+    extensionAdded = true;
+  }
+
+  // The number of bodies of each scene, in piles of 10 boxes.
+  const std::size_t sizes[] = {100, 1000, 3000};
+  for (std::size_t bodiesCount : sizes) {
+    RuntimeGame game;
+    gd::Layout &layout = game.InsertNewLayout("Scene", 0);
+    gd::Object boxObj("box");
+    boxObj.AddBehavior(
+        gd::BehaviorContent("Physics", "PhysicsBehavior::PhysicsBehavior"));
+    layout.InsertObject(boxObj, 0);
+    layout.UpdateBehaviorsSharedData(game);
+
+    RuntimeScene scene(NULL, &game);
+    scene.LoadFromScene(layout);
+
+    // The runtime behaviors are created here to be named like the behavior
+    // of the layout.
+    gd::Object groundObj("ground");
+    gd::Object pileObj("pile");
+    const std::size_t pileHeight = 10;
+    const std::size_t pilesCount = (bodiesCount + pileHeight - 1) / pileHeight;
+    auto *ground = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, groundObj)));
+    ground->AddBehavior("Physics", CreatePhysicsRuntimeBehavior(false));
+    ground->SetX(-100);
+    ground->SetY(0);
+    ground->SetWidth(pilesCount * 60 + 200);
+    ground->SetHeight(50);
+
+    for (std::size_t i = 0; i < bodiesCount; ++i) {
+      auto *box = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(
+              new ResizableRuntimeObject(scene, pileObj)));
+      box->AddBehavior("Physics", CreatePhysicsRuntimeBehavior(true));
+      box->SetX((i / pileHeight) * 60);
+      box->SetY(-32.0f * (i % pileHeight + 1));
+      box->SetWidth(30);
+      box->SetHeight(30);
+    }
+
+    // The piles settle during the first steps, when most of the contacts
+    // are created.
+    StepsBenchmark::Result result = StepsBenchmark::Run(
+        300, [&](std::size_t) { scene.StepWithoutRender(16666); });
+    StepsBenchmark::Print(
+        "Physics benchmark (" + std::to_string(bodiesCount) + " bodies)",
+        result);
+    REQUIRE(result.stepsCount == 300);
+  }
+}
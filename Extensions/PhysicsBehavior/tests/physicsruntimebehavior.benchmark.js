@@ -0,0 +1,80 @@
+describe('gdjs.PhysicsRuntimeBehavior', function() {
+  var makeBody = function(runtimeScene, dynamic, width, height) {
+    var object = new gdjs.RuntimeObject(runtimeScene, {
+      name: dynamic ? 'box' : 'ground',
+      type: '',
+      behaviors: [
+        {
+          type: 'PhysicsBehavior::PhysicsBehavior',
+          name: 'Physics',
+          dynamic: dynamic,
+          fixedRotation: false,
+          isBullet: false,
+          massDensity: 1,
+          averageFriction: 0.8,
+          averageRestitution: 0,
+          linearDamping: 0.1,
+          angularDamping: 0.1,
+          shapeType: 'Box',
+          positioning: 'OnCenter',
+          autoResizing: false,
+          polygonWidth: 200,
+          polygonHeight: 200,
+          coordsList: '',
+        },
+      ],
+    });
+    object.getWidth = function() { return width; };
+    object.getHeight = function() { return height; };
+    runtimeScene.addObject(object);
+    return object;
+  };
+
+  // The scene has bodiesCount bodies, in piles of 10 boxes on a ground.
+  var makeScene = function(bodiesCount) {
+    var runtimeGame = new gdjs.RuntimeGame({
+      variables: [],
+      properties: { windowWidth: 800, windowHeight: 600, minFPS: 10 },
+    });
+    var runtimeScene = new gdjs.RuntimeScene(runtimeGame, null);
+    runtimeScene.loadFromScene({
+      layers: [{ name: '', visibility: true }],
+      variables: [],
+      behaviorsSharedData: [
+        { name: 'Physics', gravityX: 0, gravityY: 9, scaleX: 100, scaleY: 100 },
+      ],
+      objects: [],
+      instances: [],
+    });
+
+    var pileHeight = 10;
+    var pilesCount = Math.ceil(bodiesCount / pileHeight);
+    makeBody(runtimeScene, false, pilesCount * 60 + 200, 50).setPosition(
+      -100,
+      0
+    );
+    for (var i = 0; i < bodiesCount; ++i) {
+      makeBody(runtimeScene, true, 30, 30).setPosition(
+        Math.floor(i / pileHeight) * 60,
+        -32 * (i % pileHeight + 1)
+      );
+    }
+
+    return runtimeScene;
+  };
+
+  [100, 1000, 3000].forEach(function(bodiesCount) {
+    var title = 'benchmark steps with ' + bodiesCount + ' bodies';
+    it(title, function() {
+      this.timeout(60000);
+      var runtimeScene = makeScene(bodiesCount);
+
+      // The piles settle during the first steps, when most of the contacts
+      // are created.
+      var result = benchmarkSteps({}, function() {
+        runtimeScene.renderAndStep(1000 / 60);
+      });
+      console.log(title, result);
+    });
+  });
+});
@@ -582,21 +582,6 @@ class PlatformBehaviorCppExtension : public ExtensionBase {
 
     GD_COMPLETE_EXTENSION_COMPILATION_INFORMATION();
   };
-
-  /**
-   * \brief Initialize platforms list of the scene
-   */
-  virtual void SceneLoaded(RuntimeScene& scene) {
-    ScenePlatformObjectsManager emptyManager;
-    ScenePlatformObjectsManager::managers[&scene] = emptyManager;
-  }
-
-  /**
-   * \brief Destroy platforms list of the scene
-   */
-  virtual void SceneUnloaded(RuntimeScene& scene) {
-    ScenePlatformObjectsManager::managers.erase(&scene);
-  }
 };
 
 #if defined(ANDROID)
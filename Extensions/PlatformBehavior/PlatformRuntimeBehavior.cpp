@@ -45,8 +45,9 @@ void PlatformRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       sceneManager->RemovePlatform(this);
 
     parentScene = &scene;
-    sceneManager =
-        parentScene ? &ScenePlatformObjectsManager::managers[&scene] : NULL;
+    sceneManager = parentScene
+                       ? &scene.GetExtensionData<ScenePlatformObjectsManager>()
+                       : NULL;
     registeredInManager = false;
   }
 
@@ -58,10 +59,15 @@ void PlatformRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       sceneManager->AddPlatform(this);
       registeredInManager = true;
     }
+  } else if (registeredInManager) {
+    sceneManager->UpdatePlatform(this);
   }
 }
 
-void PlatformRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {}
+void PlatformRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
+  // Track the platform moved by the events or by forces.
+  if (sceneManager && registeredInManager) sceneManager->UpdatePlatform(this);
+}
 
 void PlatformRuntimeBehavior::ChangePlatformType(
     const gd::String& platformType_) {
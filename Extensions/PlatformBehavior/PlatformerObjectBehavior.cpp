@@ -39,6 +39,7 @@ void PlatformerObjectBehavior::InitializeContent(
   behaviorContent.SetAttribute("canGrabPlatforms", false);
   behaviorContent.SetAttribute("yGrabOffset", 0);
   behaviorContent.SetAttribute("xGrabTolerance", 10);
+  behaviorContent.SetAttribute("sweptCollisions", false);
 }
 
 #if defined(GD_IDE_ONLY)
@@ -80,6 +81,11 @@ PlatformerObjectBehavior::GetProperties(
                     ? "true"
                     : "false")
       .SetType("Boolean");
+  properties[_("Move up to the obstacles in a single step (boxes only)")]
+      .SetValue(behaviorContent.GetBoolAttribute("sweptCollisions", false)
+                    ? "true"
+                    : "false")
+      .SetType("Boolean");
 
   return properties;
 }
@@ -93,6 +99,8 @@ bool PlatformerObjectBehavior::UpdateProperty(
     behaviorContent.SetAttribute("ignoreDefaultControls", (value == "0"));
   if (name == _("Round coordinates"))
     behaviorContent.SetAttribute("roundCoordinates", (value == "1"));
+  else if (name == _("Move up to the obstacles in a single step (boxes only)"))
+    behaviorContent.SetAttribute("sweptCollisions", (value == "1"));
   else if (name == _("Can grab platform ledges"))
     behaviorContent.SetAttribute("canGrabPlatforms", (value == "1"));
   else if (name == _("Grab offset on Y axis"))
@@ -6,6 +6,7 @@ This project is released under the MIT License.
 */
 
 #include "PlatformerObjectRuntimeBehavior.h"
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Window.hpp>
 #include <algorithm>
 #include <cmath>
@@ -13,6 +14,7 @@ This project is released under the MIT License.
 #include <memory>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -20,11 +22,42 @@ This project is released under the MIT License.
 #include "PlatformRuntimeBehavior.h"
 #include "ScenePlatformObjectsManager.h"
 
+namespace {
+/**
+ * Compute the bounds of the hitboxes of the object, and return true if they
+ * are a single rectangle aligned with the axes.
+ */
+bool GetHitBoxesBounds(RuntimeObject* object, sf::FloatRect& bounds) {
+  const std::vector<Polygon2d>& hitBoxes = object->GetHitBoxesRef();
+  float left = 0, top = 0, right = 0, bottom = 0;
+  bool first = true;
+  for (const Polygon2d& hitBox : hitBoxes) {
+    for (const sf::Vector2f& vertex : hitBox.vertices) {
+      left = first ? vertex.x : std::min(left, vertex.x);
+      top = first ? vertex.y : std::min(top, vertex.y);
+      right = first ? vertex.x : std::max(right, vertex.x);
+      bottom = first ? vertex.y : std::max(bottom, vertex.y);
+      first = false;
+    }
+  }
+  bounds = sf::FloatRect(left, top, right - left, bottom - top);
+
+  if (hitBoxes.size() != 1 || hitBoxes[0].vertices.size() != 4) return false;
+  for (const sf::Vector2f& vertex : hitBoxes[0].vertices) {
+    if ((vertex.x != left && vertex.x != right) ||
+        (vertex.y != top && vertex.y != bottom))
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
 PlatformerObjectRuntimeBehavior::PlatformerObjectRuntimeBehavior(
     const gd::SerializerElement& behaviorContent)
     : RuntimeBehavior(behaviorContent),
       ignoreTouchingEdges(true),
       roundCoordinates(true),
+      sweptCollisions(false),
       gravity(1000),
       maxFallingSpeed(700),
       acceleration(1500),
@@ -62,6 +95,7 @@ PlatformerObjectRuntimeBehavior::PlatformerObjectRuntimeBehavior(
 
   roundCoordinates =
       behaviorContent.GetBoolAttribute("roundCoordinates", false);
+  sweptCollisions = behaviorContent.GetBoolAttribute("sweptCollisions", false);
   gravity = behaviorContent.GetDoubleAttribute("gravity");
   maxFallingSpeed = behaviorContent.GetDoubleAttribute("maxFallingSpeed");
   acceleration = behaviorContent.GetDoubleAttribute("acceleration");
@@ -99,8 +133,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   if (parentScene != &scene)  // Parent scene has changed
   {
     parentScene = &scene;
-    sceneManager =
-        parentScene ? &ScenePlatformObjectsManager::managers[&scene] : NULL;
+    sceneManager = parentScene
+                       ? &scene.GetExtensionData<ScenePlatformObjectsManager>()
+                       : NULL;
     floorPlatform = NULL;
   }
 
@@ -137,21 +172,21 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   requestedDeltaX += currentSpeed * timeDelta;
 
   // Compute the list of the objects that will be used
-  std::set<PlatformRuntimeBehavior*> potentialObjects =
-      GetPotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed));
-  std::set<PlatformRuntimeBehavior*> overlappedJumpThru =
-      GetJumpthruCollidingWith(potentialObjects);
+  UpdatePotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed));
+  GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
 
   // Check that the floor object still exists and is near the object.
   if (isOnFloor &&
-      potentialObjects.find(floorPlatform) == potentialObjects.end()) {
+      std::find(potentialObjects.begin(), potentialObjects.end(),
+                floorPlatform) == potentialObjects.end()) {
     isOnFloor = false;
     floorPlatform = NULL;
   }
 
   // Check that the grabbed platform object still exists and is near the object.
   if (isGrabbingPlatform &&
-      potentialObjects.find(grabbedPlatform) == potentialObjects.end()) {
+      std::find(potentialObjects.begin(), potentialObjects.end(),
+                grabbedPlatform) == potentialObjects.end()) {
     ReleaseGrabbedPlatform();
   }
 
@@ -192,7 +227,33 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   // Move the object on x axis.
   double oldX = object->GetX();
   if (requestedDeltaX != 0) {
-    object->SetX(object->GetX() + requestedDeltaX);
+    bool blocked = false;
+    if (!sweptCollisions || !SweepAxis(true,
+                                       requestedDeltaX,
+                                       floorPlatform,
+                                       NULL,
+                                       /*excludeJumpthrus=*/true,
+                                       blocked))
+      object->SetX(object->GetX() + requestedDeltaX);
+
+    if (blocked) {
+      currentSpeed = 0;  // Collided with a wall
+
+      // If on floor: try get up a bit to bypass not perfectly aligned floors.
+      if (isOnFloor) {
+        double sweptX = object->GetX();
+        object->SetX(oldX + requestedDeltaX);
+        object->SetY(object->GetY() - 1);
+        if (IsCollidingWith(
+                potentialObjects, floorPlatform, /*excludeJumpthrus=*/true)) {
+          object->SetX(sweptX);
+          object->SetY(object->GetY() + 1);
+        }
+      }
+    }
+
+    // Any remaining collision (with platforms that are not boxes, or due to
+    // rounding errors) is resolved by moving the object back.
     bool tryRounding = true;
     // Colliding: Try to push out from the solid.
     // Note that jump thru are never obstacle on X axis.
@@ -269,10 +330,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 
     object->SetX(object->GetX() +
                  (requestedDeltaX > 0 ? xGrabTolerance : -xGrabTolerance));
-    auto collidingObjects =
-        GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-    if (!collidingObjects.empty() &&
-        CanGrab(*collidingObjects.begin(), requestedDeltaY)) {
+    PlatformRuntimeBehavior* collidingPlatform =
+        GetPlatformCollidingWith(potentialObjects, overlappedJumpThru);
+    if (collidingPlatform && CanGrab(collidingPlatform, requestedDeltaY)) {
       tryGrabbingPlatform = true;
     }
     object->SetX(object->GetX() +
@@ -281,7 +341,6 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
     // Check if we can grab the collided platform
     if (tryGrabbingPlatform) {
       double oldY = object->GetY();
-      PlatformRuntimeBehavior* collidingPlatform = *collidingObjects.begin();
       object->SetY(collidingPlatform->GetObject()->GetY() +
                    collidingPlatform->GetYGrabOffset() - yGrabOffset);
       if (!IsCollidingWith(potentialObjects, NULL, /*excludeJumpthrus=*/true)) {
@@ -400,7 +459,21 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   // Move the object on Y axis
   if (requestedDeltaY != 0) {
     double oldY = object->GetY();
-    object->SetY(object->GetY() + requestedDeltaY);
+    bool blocked = false;
+    if (sweptCollisions &&
+        SweepAxis(false,
+                  requestedDeltaY,
+                  NULL,
+                  requestedDeltaY > 0 ? &overlappedJumpThru : NULL,
+                  /*excludeJumpThrus=*/requestedDeltaY < 0,
+                  blocked)) {
+      if (blocked) {
+        jumping = false;
+        currentJumpSpeed = 0;
+      }
+    } else {
+      object->SetY(object->GetY() + requestedDeltaY);
+    }
 
     // Stop when colliding with an obstacle.
     while ((requestedDeltaY < 0 &&
@@ -430,7 +503,7 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   }
 
   // 3) Update the current floor data for the next tick:
-  overlappedJumpThru = GetJumpthruCollidingWith(potentialObjects);
+  GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
   if (!isOnLadder) {
     // Check if the object is on a floor:
     // In priority, check if the last floor platform is still the floor.
@@ -443,9 +516,9 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       floorLastY = floorPlatform->GetObject()->GetY();
     } else {
       // Check if landing on a new floor: (Exclude already overlapped jump truh)
-      std::set<PlatformRuntimeBehavior*> collidingObjects =
-          GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-      if (!collidingObjects.empty())  // Just landed on floor
+      PlatformRuntimeBehavior* collidingPlatform =
+          GetPlatformCollidingWith(potentialObjects, overlappedJumpThru);
+      if (collidingPlatform)  // Just landed on floor
       {
         isOnFloor = true;
         canJump = true;
@@ -453,7 +526,7 @@ void PlatformerObjectRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
         currentJumpSpeed = 0;
         currentFallSpeed = 0;
 
-        floorPlatform = *collidingObjects.begin();
+        floorPlatform = collidingPlatform;
         floorLastX = floorPlatform->GetObject()->GetX();
         floorLastY = floorPlatform->GetObject()->GetY();
 
@@ -502,9 +575,11 @@ void PlatformerObjectRuntimeBehavior::ReleaseGrabbedPlatform() {
 }
 
 bool PlatformerObjectRuntimeBehavior::SeparateFromPlatforms(
-    const std::set<PlatformRuntimeBehavior*>& candidates, bool excludeJumpThrus) {
-  std::vector<RuntimeObject*> objects;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    bool excludeJumpThrus) {
+  separatedObjects.clear();
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
     if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
@@ -512,37 +587,101 @@ bool PlatformerObjectRuntimeBehavior::SeparateFromPlatforms(
         (*it)->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
       continue;
 
-    objects.push_back((*it)->GetObject());
+    separatedObjects.push_back((*it)->GetObject());
   }
 
-  return object->SeparateFromObjects(objects, ignoreTouchingEdges);
+  return object->SeparateFromObjects(separatedObjects, ignoreTouchingEdges);
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetPlatformsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
-    const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes) {
-  // TODO: This function could be refactored to return only the first colliding
-  // platform.
-  std::set<PlatformRuntimeBehavior*> result;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+bool PlatformerObjectRuntimeBehavior::SweepAxis(
+    bool xAxis,
+    double delta,
+    PlatformRuntimeBehavior* exceptThisOne,
+    const std::vector<PlatformRuntimeBehavior*>* exceptTheseOnes,
+    bool excludeJumpThrus,
+    bool& blocked) {
+  blocked = false;
+  sf::FloatRect bounds;
+  if (!GetHitBoxesBounds(object, bounds)) return false;
+
+  double start = xAxis ? bounds.left : bounds.top;
+  double end = start + (xAxis ? bounds.width : bounds.height);
+  double crossStart = xAxis ? bounds.top : bounds.left;
+  double crossEnd = crossStart + (xAxis ? bounds.height : bounds.width);
+
+  double allowedDelta = delta;
+  for (PlatformRuntimeBehavior* platform : potentialObjects) {
+    if (platform == exceptThisOne) continue;
+    if (platform->GetPlatformType() == PlatformRuntimeBehavior::Ladder)
+      continue;
+    if (excludeJumpThrus &&
+        platform->GetPlatformType() == PlatformRuntimeBehavior::Jumpthru)
+      continue;
+    if (exceptTheseOnes &&
+        std::find(exceptTheseOnes->begin(), exceptTheseOnes->end(), platform) !=
+            exceptTheseOnes->end())
+      continue;
+
+    sf::FloatRect platformBounds;
+    bool isBox = GetHitBoxesBounds(platform->GetObject(), platformBounds);
+    double platformStart = xAxis ? platformBounds.left : platformBounds.top;
+    double platformEnd =
+        platformStart + (xAxis ? platformBounds.width : platformBounds.height);
+    double platformCrossStart =
+        xAxis ? platformBounds.top : platformBounds.left;
+    double platformCrossEnd =
+        platformCrossStart +
+        (xAxis ? platformBounds.height : platformBounds.width);
+
+    // Touching edges are not collisions (see ignoreTouchingEdges).
+    if (platformCrossStart >= crossEnd || platformCrossEnd <= crossStart)
+      continue;
+    if (platformStart < end && platformEnd > start) return false;
+
+    // Distance to the platform, if it is on the way.
+    double distance = delta > 0 ? platformStart - end : platformEnd - start;
+    if ((delta > 0 && (distance < 0 || distance >= allowedDelta)) ||
+        (delta < 0 && (distance > 0 || distance <= allowedDelta)))
+      continue;
+
+    if (!isBox) return false;
+    allowedDelta = distance;
+    blocked = true;
+  }
+
+  if (xAxis)
+    object->SetX(object->GetX() + allowedDelta);
+  else
+    object->SetY(object->GetY() + allowedDelta);
+  return true;
+}
+
+PlatformRuntimeBehavior*
+PlatformerObjectRuntimeBehavior::GetPlatformCollidingWith(
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes) {
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
-    if (exceptTheseOnes.find(*it) != exceptTheseOnes.end()) continue;
+    if (std::find(exceptTheseOnes.begin(), exceptTheseOnes.end(), *it) !=
+        exceptTheseOnes.end())
+      continue;
     if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
 
     if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
-      result.insert(*it);
+      return *it;
   }
 
-  return result;
+  return NULL;
 }
 
 bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
     PlatformRuntimeBehavior* exceptThisOne,
     bool excludeJumpThrus) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
     if (*it == exceptThisOne) continue;
@@ -559,12 +698,15 @@ bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
 }
 
 bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates,
-    const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes) {
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
-    if (exceptTheseOnes.find(*it) != exceptTheseOnes.end()) continue;
+    if (std::find(exceptTheseOnes.begin(), exceptTheseOnes.end(), *it) !=
+        exceptTheseOnes.end())
+      continue;
     if ((*it)->GetPlatformType() == PlatformRuntimeBehavior::Ladder) continue;
 
     if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
@@ -574,25 +716,25 @@ bool PlatformerObjectRuntimeBehavior::IsCollidingWith(
   return false;
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetJumpthruCollidingWith(
-    const std::set<PlatformRuntimeBehavior*>& candidates) {
-  std::set<PlatformRuntimeBehavior*> result;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+void PlatformerObjectRuntimeBehavior::GetJumpthruCollidingWith(
+    const std::vector<PlatformRuntimeBehavior*>& candidates,
+    std::vector<PlatformRuntimeBehavior*>& result) {
+  result.clear();
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
     if ((*it)->GetPlatformType() != PlatformRuntimeBehavior::Jumpthru) continue;
 
     if (object->IsCollidingWith((*it)->GetObject(), ignoreTouchingEdges))
-      result.insert(*it);
+      result.push_back(*it);
   }
-
-  return result;
 }
 
 bool PlatformerObjectRuntimeBehavior::IsOverlappingLadder(
-    const std::set<PlatformRuntimeBehavior*>& candidates) {
-  for (std::set<PlatformRuntimeBehavior*>::iterator it = candidates.begin();
+    const std::vector<PlatformRuntimeBehavior*>& candidates) {
+  for (std::vector<PlatformRuntimeBehavior*>::const_iterator it =
+           candidates.begin();
        it != candidates.end();
        ++it) {
     if ((*it)->GetPlatformType() != PlatformRuntimeBehavior::Ladder) continue;
@@ -603,46 +745,18 @@ bool PlatformerObjectRuntimeBehavior::IsOverlappingLadder(
   return false;
 }
 
-std::set<PlatformRuntimeBehavior*>
-PlatformerObjectRuntimeBehavior::GetPotentialCollidingObjects(
+void PlatformerObjectRuntimeBehavior::UpdatePotentialCollidingObjects(
     double maxMovementLength) {
-  // Compute the "bounding circle" radius of the object.
-  float o1w = object->GetWidth();
-  float o1h = object->GetHeight();
-  float obj1BoundingRadius =
-      sqrt(o1w * o1w + o1h * o1h) / 2.0 +
-      maxMovementLength / 2.0;  // Add to it the maximum magnitude of movement.
-
-  std::set<PlatformRuntimeBehavior*> potentialObjects;
-  for (std::set<PlatformRuntimeBehavior*>::iterator it =
-           sceneManager->GetAllPlatforms().begin();
-       it != sceneManager->GetAllPlatforms().end();
-       ++it) {
-    // First check if bounding circle are too far.
-    RuntimeObject* obj2 = (*it)->GetObject();
-    float o2w = obj2->GetWidth();
-    float o2h = obj2->GetHeight();
-
-    float x = object->GetDrawableX() + object->GetCenterX() -
-              (obj2->GetDrawableX() + obj2->GetCenterX());
-    float y = object->GetDrawableY() + object->GetCenterY() -
-              (obj2->GetDrawableY() + obj2->GetCenterY());
-    float obj2BoundingRadius = sqrt(o2w * o2w + o2h * o2h) / 2.0;
-
-    if (sqrt(x * x + y * y) <= obj1BoundingRadius + obj2BoundingRadius) {
-      potentialObjects.insert(*it);
-    }
-  }
-
-  return potentialObjects;
+  sceneManager->GetPlatformsAround(object, maxMovementLength, potentialObjects);
 }
 
 void PlatformerObjectRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
   if (parentScene != &scene)  // Parent scene has changed
   {
     parentScene = &scene;
-    sceneManager =
-        parentScene ? &ScenePlatformObjectsManager::managers[&scene] : NULL;
+    sceneManager = parentScene
+                       ? &scene.GetExtensionData<ScenePlatformObjectsManager>()
+                       : NULL;
     floorPlatform = NULL;
   }
 }
@@ -9,7 +9,7 @@ This project is released under the MIT License.
 #define PLATFORMEROBJECTRUNTIMEBEHAVIOR_H
 #include <SFML/System/Vector2.hpp>
 #include <map>
-#include <set>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 namespace gd {
@@ -83,13 +83,12 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
   virtual void DoStepPostEvents(RuntimeScene& scene);
 
   /**
-   * \brief Return a list of all the platforms that could be colliding with the
-   * object if it is moved. \param maxMovementLength The maximum length of any
-   * movement that could be done by the object, in pixels. \warning sceneManager
-   * must be valid and not NULL.
+   * \brief Store in potentialObjects all the platforms that could be colliding
+   * with the object if it is moved. \param maxMovementLength The maximum length
+   * of any movement that could be done by the object, in pixels. \warning
+   * sceneManager must be valid and not NULL.
    */
-  std::set<PlatformRuntimeBehavior*> GetPotentialCollidingObjects(
-      double maxMovementLength);
+  void UpdatePotentialCollidingObjects(double maxMovementLength);
 
   /**
    * \brief Separate the object from all platforms passed as parameter, except
@@ -97,18 +96,42 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * excludeJumpThrus If set to true, the jump thru platform will be excluded.
    */
   bool SeparateFromPlatforms(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
       bool excludeJumpThrus);
 
   /**
-   * \brief Among the platforms passed in parameter, return a list of the
-   * platforms colliding with the object. \note Ladders are *always* excluded
-   * from the test. \param candidates The platform to be tested for collision
-   * \param exceptTheseOnes The platforms to be excluded from the test
+   * \brief Move the object on an axis up to the first platform on the way,
+   * using the bounding boxes of the object and of the platforms in a single
+   * pass over potentialObjects.
+   *
+   * \param xAxis True to move the object on X axis, false for Y axis.
+   * \param delta The requested movement, in pixels.
+   * \param exceptThisOne If not NULL, this platform is not an obstacle.
+   * \param exceptTheseOnes If not NULL, these platforms are not obstacles.
+   * \param excludeJumpThrus If set to true, the jump thru platforms are not
+   * obstacles.
+   * \param blocked Set to true if the movement was stopped by a platform.
+   * \return false, without moving the object, if the movement can't be
+   * resolved this way: the object or a platform on the way is not a box, or
+   * the object is already overlapping a platform.
    */
-  std::set<PlatformRuntimeBehavior*> GetPlatformsCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
-      const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes);
+  bool SweepAxis(bool xAxis,
+                 double delta,
+                 PlatformRuntimeBehavior* exceptThisOne,
+                 const std::vector<PlatformRuntimeBehavior*>* exceptTheseOnes,
+                 bool excludeJumpThrus,
+                 bool& blocked);
+
+  /**
+   * \brief Among the platforms passed in parameter, return the first platform
+   * colliding with the object, or NULL if there is none. \note Ladders are
+   * *always* excluded from the test. \param candidates The platform to be
+   * tested for collision \param exceptTheseOnes The platforms to be excluded
+   * from the test
+   */
+  PlatformRuntimeBehavior* GetPlatformCollidingWith(
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes);
 
   /**
    * \brief Among the platforms passed in parameter, return true if there is a
@@ -118,9 +141,10 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * collision. \param excludeJumpThrus If set to true, the jump thru platform
    * will be excluded.
    */
-  bool IsCollidingWith(const std::set<PlatformRuntimeBehavior*>& candidates,
-                       PlatformRuntimeBehavior* exceptThisOne = NULL,
-                       bool excludeJumpThrus = false);
+  bool IsCollidingWith(
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      PlatformRuntimeBehavior* exceptThisOne = NULL,
+      bool excludeJumpThrus = false);
 
   /**
    * \brief Among the platforms passed in parameter, return true if there is a
@@ -129,8 +153,8 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * \param exceptTheseOnes The platforms to be excluded from the test
    */
   bool IsCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates,
-      const std::set<PlatformRuntimeBehavior*>& exceptTheseOnes);
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      const std::vector<PlatformRuntimeBehavior*>& exceptTheseOnes);
 
   /**
    * \brief Among the platforms passed in parameter, return true if the object
@@ -138,15 +162,16 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
    * collision
    */
   bool IsOverlappingLadder(
-      const std::set<PlatformRuntimeBehavior*>& candidates);
+      const std::vector<PlatformRuntimeBehavior*>& candidates);
 
   /**
-   * \brief Among the platforms passed in parameter, return a list of the jump
-   * thru platforms colliding with the object. \param candidates The platform to
-   * be tested for collision
+   * \brief Among the platforms passed in parameter, store in \a result the
+   * jump thru platforms colliding with the object. \param candidates The
+   * platform to be tested for collision
    */
-  std::set<PlatformRuntimeBehavior*> GetJumpthruCollidingWith(
-      const std::set<PlatformRuntimeBehavior*>& candidates);
+  void GetJumpthruCollidingWith(
+      const std::vector<PlatformRuntimeBehavior*>& candidates,
+      std::vector<PlatformRuntimeBehavior*>& result);
 
   /**
    * \brief Return true if the object owning the behavior can grab the specified
@@ -178,6 +203,9 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
                              // collision handling functions.
   bool roundCoordinates;   ///< true to round coordinates when trying to move on
                            ///< X and Y axis.
+  bool sweptCollisions;    ///< true to move the object up to the platforms in a
+                           ///< single query per axis, instead of moving it
+                           ///< back pixel by pixel (see SweepAxis).
   double gravity;          ///< In pixels.seconds^-2
   double maxFallingSpeed;  ///< In pixels.seconds^-1
   double acceleration;     ///< In pixels.seconds^-2
@@ -235,5 +263,14 @@ class GD_EXTENSION_API PlatformerObjectRuntimeBehavior
   bool downKey;
   bool jumpKey;
   bool releaseKey;
+
+  std::vector<PlatformRuntimeBehavior*>
+      potentialObjects;  ///< The platforms around the object, kept between
+                         ///< steps so that their memory is reused.
+  std::vector<PlatformRuntimeBehavior*>
+      overlappedJumpThru;  ///< The jump thru platforms overlapped by the
+                           ///< object.
+  std::vector<RuntimeObject*>
+      separatedObjects;  ///< Reused by SeparateFromPlatforms.
 };
 #endif  // PLATFORMEROBJECTRUNTIMEBEHAVIOR_H
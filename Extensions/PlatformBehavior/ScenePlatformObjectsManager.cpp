@@ -1,8 +1,8 @@
 #include "ScenePlatformObjectsManager.h"
 #include "PlatformRuntimeBehavior.h"
 
-std::map<RuntimeScene*, ScenePlatformObjectsManager>
-    ScenePlatformObjectsManager::managers;
+const std::size_t ScenePlatformObjectsManager::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
 
 ScenePlatformObjectsManager::~ScenePlatformObjectsManager() {
   for (std::set<PlatformRuntimeBehavior*>::iterator it = allPlatforms.begin();
@@ -13,7 +13,47 @@ ScenePlatformObjectsManager::~ScenePlatformObjectsManager() {
 
 void ScenePlatformObjectsManager::AddPlatform(PlatformRuntimeBehavior* platform) {
   allPlatforms.insert(platform);
+
+  // An object with more than one platform behavior is only stored once.
+  RuntimeObject* object = platform->GetObject();
+  objectsPlatforms[object] = platform;
+  platformsHash.Update(object);
 }
 void ScenePlatformObjectsManager::RemovePlatform(PlatformRuntimeBehavior* platform) {
   allPlatforms.erase(platform);
+
+  RuntimeObject* object = platform->GetObject();
+  auto it = objectsPlatforms.find(object);
+  if (it == objectsPlatforms.end() || it->second != platform) return;
+
+  objectsPlatforms.erase(it);
+  platformsHash.Remove(object);
+}
+
+void ScenePlatformObjectsManager::UpdatePlatform(
+    PlatformRuntimeBehavior* platform) {
+  RuntimeObject* object = platform->GetObject();
+  auto it = objectsPlatforms.find(object);
+  if (it == objectsPlatforms.end() || it->second != platform) return;
+
+  platformsHash.Update(object);
+}
+
+void ScenePlatformObjectsManager::GetPlatformsAround(
+    RuntimeObject* object,
+    double maxMovementLength,
+    std::vector<PlatformRuntimeBehavior*>& result) {
+  result.clear();
+
+  sf::FloatRect searchArea = object->GetAABB();
+  searchArea.left -= maxMovementLength;
+  searchArea.top -= maxMovementLength;
+  searchArea.width += 2 * maxMovementLength;
+  searchArea.height += 2 * maxMovementLength;
+
+  platformsHash.ForEachObjectInAABB(
+      searchArea, [this, &result](RuntimeObject* platformObject) {
+        auto it = objectsPlatforms.find(platformObject);
+        if (it != objectsPlatforms.end()) result.push_back(it->second);
+      });
 }
@@ -8,22 +8,28 @@ This project is released under the MIT License.
 #define SCENEPLATFORMOBJECTSMANAGER_H
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
 class PlatformRuntimeBehavior;
+class RuntimeObject;
 
 /**
  * \brief Contains lists of all platform related objects of a scene.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * Platforms are also stored in a spatial hash, so that platformer objects
+ * only test the platforms around them (see GetPlatformsAround). Platforms
+ * must call UpdatePlatform when they move or change of size.
+ *
+ * The manager of a scene is stored in the scene (see
+ * RuntimeScene::GetExtensionData).
  */
-class ScenePlatformObjectsManager {
+class ScenePlatformObjectsManager : public RuntimeSceneExtensionData {
  public:
-  /**
-   * \brief Map containing, for each RuntimeScene, its associated
-   * ScenePlatformObjectsManager.
-   */
-  static std::map<RuntimeScene*, ScenePlatformObjectsManager> managers;
+  static const std::size_t sceneDataIndex;  ///< The slot of the managers in
+                                            ///< the scenes.
 
   ScenePlatformObjectsManager(){};
   virtual ~ScenePlatformObjectsManager();
@@ -40,6 +46,27 @@ class ScenePlatformObjectsManager {
    */
   void RemovePlatform(PlatformRuntimeBehavior* platform);
 
+  /**
+   * \brief Notify the manager that a platform may have moved or changed of
+   * size.
+   * \note Cheap if the platform is still covering the same cells of the
+   * spatial hash.
+   */
+  void UpdatePlatform(PlatformRuntimeBehavior* platform);
+
+  /**
+   * \brief Get the platforms that could be colliding with the object if it is
+   * moved.
+   * \param object The object to be tested.
+   * \param maxMovementLength The maximum length of any movement that could be
+   * done by the object, in pixels.
+   * \param result The vector where the platforms are stored. It is cleared
+   * before adding the platforms, so that its memory can be reused.
+   */
+  void GetPlatformsAround(RuntimeObject* object,
+                          double maxMovementLength,
+                          std::vector<PlatformRuntimeBehavior*>& result);
+
   /**
    * \brief Get a read only access to the list of all platforms
    */
@@ -50,6 +77,11 @@ class ScenePlatformObjectsManager {
  private:
   std::set<PlatformRuntimeBehavior*>
       allPlatforms;  ///< The list of all platforms of the scene.
+  ObjectsSpatialHash
+      platformsHash;  ///< The objects of the platforms, by position.
+  std::unordered_map<const RuntimeObject*, PlatformRuntimeBehavior*>
+      objectsPlatforms;  ///< The platform registered in platformsHash for
+                         ///< each object.
 };
 
 #endif
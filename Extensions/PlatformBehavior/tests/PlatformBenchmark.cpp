@@ -0,0 +1,119 @@
+/**
+
+GDevelop - Platform Behavior Extension
+Copyright (c) 2014-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Benchmark of the steps of the platformer characters of the Platform
+ * extension. Hidden by default: run the tests with "[benchmark]" as argument
+ * to launch it.
+ */
+#define CATCH_CONFIG_MAIN
+#include <string>
+#include "../../../GDCpp/tests/benchmarks/StepsBenchmark.h"
+#include "../PlatformBehavior.h"
+#include "../PlatformRuntimeBehavior.h"
+#include "../PlatformerObjectBehavior.h"
+#include "../PlatformerObjectRuntimeBehavior.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+// Mock objects that can have a specific size
+class ResizableRuntimeObject : public RuntimeObject {
+ public:
+  ResizableRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj), width(0), height(0) {}
+
+  float GetWidth() const override { return width; }
+  float GetHeight() const override { return height; }
+  void SetWidth(float newWidth) override { width = newWidth; }
+  void SetHeight(float newHeight) override { height = newHeight; }
+
+ private:
+  float width;
+  float height;
+};
+
+template <class TRuntimeBehavior, class TBehavior>
+std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
+  gd::SerializerElement behaviorContent;
+  TBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
+};
+}  // namespace
+
+TEST_CASE("PlatformerObjectRuntimeBehavior benchmark",
+          "[.][benchmark][platform]") {
+  // The number of platforms and of characters of each scene.
+  const std::size_t sizes[][2] = {{100, 10}, {1000, 100}, {5000, 500}};
+  for (const auto &size : sizes) {
+    const std::size_t platformsCount = size[0];
+    const std::size_t charactersCount = size[1];
+
+    RuntimeGame game;
+    gd::Object platformObj("platform");
+    gd::Object characterObj("character");
+    RuntimeScene scene(NULL, &game);
+
+    // Rows of platforms, with a gap between each platform.
+    const std::size_t platformsPerRow = 50;
+    for (std::size_t i = 0; i < platformsCount; ++i) {
+      auto *platform = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(
+              new ResizableRuntimeObject(scene, platformObj)));
+      platform->AddBehavior(
+          "Platform",
+          CreateNewRuntimeBehavior<PlatformRuntimeBehavior,
+                                   PlatformBehavior>());
+      platform->SetX((i % platformsPerRow) * 100);
+      platform->SetY((i / platformsPerRow) * 200);
+      platform->SetWidth(80);
+      platform->SetHeight(32);
+    }
+
+    // The characters fall on the platforms, then walk from one to another.
+    std::vector<PlatformerObjectRuntimeBehavior *> characters;
+    for (std::size_t i = 0; i < charactersCount; ++i) {
+      auto *character = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(
+              new ResizableRuntimeObject(scene, characterObj)));
+      character->AddBehavior(
+          "PlatformerObject",
+          CreateNewRuntimeBehavior<PlatformerObjectRuntimeBehavior,
+                                   PlatformerObjectBehavior>());
+      character->SetX((i * 37) % (platformsPerRow * 100));
+      character->SetY((i % (platformsCount / platformsPerRow + 1)) * 200 - 60);
+      character->SetWidth(20);
+      character->SetHeight(40);
+      characters.push_back(static_cast<PlatformerObjectRuntimeBehavior *>(
+          character->GetBehaviorRawPointer("PlatformerObject")));
+    }
+
+    StepsBenchmark::Result result = StepsBenchmark::Run(
+        300,
+        [&](std::size_t step) {
+          for (std::size_t i = 0; i < characters.size(); ++i) {
+            if ((step / 60 + i) % 2 == 0)
+              characters[i]->SimulateRightKey();
+            else
+              characters[i]->SimulateLeftKey();
+            if ((step + i) % 90 == 0) characters[i]->SimulateJumpKey();
+          }
+          scene.StepWithoutRender(16666);
+        },
+        60);
+    StepsBenchmark::Print("Platform benchmark (" +
+                              std::to_string(platformsCount) +
+                              " platforms, " + std::to_string(charactersCount) +
+                              " characters)",
+                          result);
+    REQUIRE(result.stepsCount == 300);
+  }
+}
@@ -0,0 +1,95 @@
+describe('gdjs.PlatformerObjectRuntimeBehavior', function() {
+  // The scene has platformsCount platforms, in rows with gaps between them,
+  // and charactersCount characters falling on them and walking.
+  var makeScene = function(platformsCount, charactersCount) {
+    var runtimeGame = new gdjs.RuntimeGame({
+      variables: [],
+      properties: { windowWidth: 800, windowHeight: 600, minFPS: 10 },
+    });
+    var runtimeScene = new gdjs.RuntimeScene(runtimeGame, null);
+    runtimeScene.loadFromScene({
+      layers: [{ name: '', visibility: true }],
+      variables: [],
+      behaviorsSharedData: [],
+      objects: [],
+      instances: [],
+    });
+
+    var platformsPerRow = 50;
+    for (var i = 0; i < platformsCount; ++i) {
+      var platform = new gdjs.RuntimeObject(runtimeScene, {
+        name: 'platform',
+        type: '',
+        behaviors: [
+          {
+            type: 'PlatformBehavior::PlatformBehavior',
+            name: 'Platform',
+            canBeGrabbed: true,
+          },
+        ],
+      });
+      platform.getWidth = function() { return 80; };
+      platform.getHeight = function() { return 32; };
+      runtimeScene.addObject(platform);
+      platform.setPosition(
+        (i % platformsPerRow) * 100,
+        Math.floor(i / platformsPerRow) * 200
+      );
+    }
+
+    var rowsCount = Math.floor(platformsCount / platformsPerRow) + 1;
+    var characters = [];
+    for (var i = 0; i < charactersCount; ++i) {
+      var character = new gdjs.RuntimeObject(runtimeScene, {
+        name: 'character',
+        type: '',
+        behaviors: [
+          {
+            type: 'PlatformBehavior::PlatformerObjectBehavior',
+            name: 'PlatformerObject',
+            gravity: 1000,
+            maxFallingSpeed: 700,
+            acceleration: 1500,
+            deceleration: 1500,
+            maxSpeed: 250,
+            jumpSpeed: 600,
+            canGrabPlatforms: false,
+            ignoreDefaultControls: true,
+            slopeMaxAngle: 60,
+          },
+        ],
+      });
+      character.getWidth = function() { return 20; };
+      character.getHeight = function() { return 40; };
+      runtimeScene.addObject(character);
+      character.setPosition(
+        (i * 37) % (platformsPerRow * 100),
+        (i % rowsCount) * 200 - 60
+      );
+      characters.push(character.getBehavior('PlatformerObject'));
+    }
+
+    return { runtimeScene: runtimeScene, characters: characters };
+  };
+
+  [[100, 10], [1000, 100], [5000, 500]].forEach(function(size) {
+    var title =
+      'benchmark steps with ' + size[0] + ' platforms and ' +
+      size[1] + ' characters';
+    it(title, function() {
+      this.timeout(60000);
+      var scene = makeScene(size[0], size[1]);
+
+      var result = benchmarkSteps({ warmUpStepsCount: 60 }, function(step) {
+        scene.characters.forEach(function(character, i) {
+          if ((Math.floor(step / 60) + i) % 2 === 0)
+            character.simulateRightKey();
+          else character.simulateLeftKey();
+          if ((step + i) % 90 === 0) character.simulateJumpKey();
+        });
+        scene.runtimeScene.renderAndStep(1000 / 60);
+      });
+      console.log(title, result);
+    });
+  });
+});
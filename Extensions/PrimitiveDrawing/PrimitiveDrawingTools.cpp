@@ -39,6 +39,7 @@ void GD_EXTENSION_API CopyImageOnAnother(const gd::String& destName,
                    sf::IntRect(0, 0, 0, 0),
                    useTransparency);
   dest->texture.loadFromImage(dest->image);
+  dest->collisionMasks.reset();
 }
 
 void GD_EXTENSION_API CaptureScreen(RuntimeScene& scene,
@@ -55,6 +56,7 @@ void GD_EXTENSION_API CaptureScreen(RuntimeScene& scene,
     sfmlTexture->image = capture;
     sfmlTexture->texture.loadFromImage(
         sfmlTexture->image);  // Do not forget to update the associated texture
+    sfmlTexture->collisionMasks.reset();
   }
 }
 
@@ -88,6 +90,7 @@ void GD_EXTENSION_API CreateSFMLTexture(RuntimeScene& scene,
 
   newTexture->texture.loadFromImage(
       newTexture->image);  // Do not forget to update the associated texture
+  newTexture->collisionMasks.reset();
 
   scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(
       imageName, newTexture);  // Otherwise
@@ -107,6 +110,7 @@ void GD_EXTENSION_API OpenSFMLTextureFromFile(RuntimeScene& scene,
   newTexture->image.loadFromFile(fileName.ToLocale());
   newTexture->texture.loadFromImage(
       newTexture->image);  // Do not forget to update the associated texture
+  newTexture->collisionMasks.reset();
 
   scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(imageName,
                                                              newTexture);
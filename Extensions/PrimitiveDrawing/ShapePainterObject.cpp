@@ -6,6 +6,8 @@ This project is released under the MIT License.
 */
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/FontManager.h"
@@ -40,7 +42,7 @@ ShapePainterObject::ShapePainterObject(gd::String name_) : gd::Object(name_) {}
 
 RuntimeShapePainterObject::RuntimeShapePainterObject(
     RuntimeScene& scene, const ShapePainterObject& shapePainterObject)
-    : RuntimeObject(scene, shapePainterObject) {
+    : RuntimeObject(scene, shapePainterObject), vertices(sf::Triangles) {
   ShapePainterObjectBase::operator=(shapePainterObject);
 }
 
@@ -107,16 +109,14 @@ void ShapePainterObject::DoSerializeTo(gd::SerializerElement& element) const {
 bool RuntimeShapePainterObject::Draw(sf::RenderTarget& renderTarget) {
   // Don't draw anything if hidden
   if (hidden) {
-    shapesToDraw.clear();
+    vertices.clear();
     return true;
   }
 
-  for (std::size_t i = 0; i < shapesToDraw.size(); ++i) {
-    renderTarget.draw(shapesToDraw[i].rectangleShape);
-    renderTarget.draw(shapesToDraw[i].circleShape);
-  }
-
-  shapesToDraw.clear();
+  // All the shapes are drawn at once. The vertices are cleared, keeping
+  // their memory for the next frame.
+  renderTarget.draw(vertices);
+  vertices.clear();
 
   return true;
 }
@@ -239,6 +239,73 @@ void ShapePainterObjectBase::SetOutlineColor(const gd::String& color) {
   outlineColorB = colors[2].To<int>();
 }
 
+namespace {
+/**
+ * \brief The maximum length of the segments of the circles, in pixels.
+ */
+const float circleSegmentLength = 4;
+const std::size_t minimumCircleSegmentsCount = 8;
+const std::size_t maximumCircleSegmentsCount = 256;
+const float pi = 3.14159265358979f;
+}  // namespace
+
+sf::Color RuntimeShapePainterObject::GetFillColor() const {
+  return sf::Color(
+      GetFillColorR(), GetFillColorG(), GetFillColorB(), GetFillOpacity());
+}
+
+sf::Color RuntimeShapePainterObject::GetOutlineColor() const {
+  return sf::Color(GetOutlineColorR(),
+                   GetOutlineColorG(),
+                   GetOutlineColorB(),
+                   GetOutlineOpacity());
+}
+
+void RuntimeShapePainterObject::AddQuad(const sf::Vector2f& a,
+                                        const sf::Vector2f& b,
+                                        const sf::Vector2f& c,
+                                        const sf::Vector2f& d,
+                                        const sf::Color& color) {
+  vertices.append(sf::Vertex(a, color));
+  vertices.append(sf::Vertex(b, color));
+  vertices.append(sf::Vertex(c, color));
+  vertices.append(sf::Vertex(a, color));
+  vertices.append(sf::Vertex(c, color));
+  vertices.append(sf::Vertex(d, color));
+}
+
+void RuntimeShapePainterObject::AddRectangle(const sf::Vector2f& center,
+                                             const sf::Vector2f& axis,
+                                             float halfWidth,
+                                             float halfHeight) {
+  sf::Vector2f normal(-axis.y, axis.x);
+  sf::Vector2f u = axis * halfWidth;
+  sf::Vector2f v = normal * halfHeight;
+  sf::Vector2f corners[4] = {
+      center - u - v, center + u - v, center + u + v, center - u + v};
+  AddQuad(corners[0], corners[1], corners[2], corners[3], GetFillColor());
+
+  float outlineSize = GetOutlineSize();
+  if (outlineSize == 0) return;
+
+  // The outline is around the rectangle, like for sf::RectangleShape.
+  sf::Vector2f outerU = axis * (halfWidth + outlineSize);
+  sf::Vector2f outerV = normal * (halfHeight + outlineSize);
+  sf::Vector2f outerCorners[4] = {center - outerU - outerV,
+                                  center + outerU - outerV,
+                                  center + outerU + outerV,
+                                  center - outerU + outerV};
+  sf::Color outlineColor = GetOutlineColor();
+  for (std::size_t i = 0; i < 4; ++i) {
+    std::size_t next = (i + 1) % 4;
+    AddQuad(corners[i],
+            corners[next],
+            outerCorners[next],
+            outerCorners[i],
+            outlineColor);
+  }
+}
+
 void RuntimeShapePainterObject::DrawRectangle(float x,
                                               float y,
                                               float x2,
@@ -246,17 +313,10 @@ void RuntimeShapePainterObject::DrawRectangle(float x,
   float Xgap = AreCoordinatesAbsolute() ? 0 : GetX();
   float Ygap = AreCoordinatesAbsolute() ? 0 : GetY();
 
-  DrawingCommand command(sf::RectangleShape(sf::Vector2f(x2 - x, y2 - y)));
-  command.rectangleShape.setPosition(x + Xgap, y + Ygap);
-  command.rectangleShape.setFillColor(sf::Color(
-      GetFillColorR(), GetFillColorG(), GetFillColorB(), GetFillOpacity()));
-  command.rectangleShape.setOutlineThickness(GetOutlineSize());
-  command.rectangleShape.setOutlineColor(sf::Color(GetOutlineColorR(),
-                                                   GetOutlineColorG(),
-                                                   GetOutlineColorB(),
-                                                   GetOutlineOpacity()));
-
-  shapesToDraw.push_back(command);
+  AddRectangle(sf::Vector2f((x + x2) / 2 + Xgap, (y + y2) / 2 + Ygap),
+               sf::Vector2f(1, 0),
+               std::abs(x2 - x) / 2,
+               std::abs(y2 - y) / 2);
 }
 
 void RuntimeShapePainterObject::DrawLine(
@@ -265,36 +325,45 @@ void RuntimeShapePainterObject::DrawLine(
   float Ygap = AreCoordinatesAbsolute() ? 0 : GetY();
 
   float length = sqrt((x - x2) * (x - x2) + (y - y2) * (y - y2));
-  DrawingCommand command(sf::RectangleShape(sf::Vector2f(length, thickness)));
-  command.rectangleShape.setPosition((x + x2) / 2 + Xgap, (y + y2) / 2 + Ygap);
-  command.rectangleShape.setOrigin(length / 2, thickness / 2);
-  command.rectangleShape.setRotation(atan2(y2 - y, x2 - x) * 180 / 3.14159);
-  command.rectangleShape.setFillColor(sf::Color(
-      GetFillColorR(), GetFillColorG(), GetFillColorB(), GetFillOpacity()));
-  command.rectangleShape.setOutlineThickness(GetOutlineSize());
-  command.rectangleShape.setOutlineColor(sf::Color(GetOutlineColorR(),
-                                                   GetOutlineColorG(),
-                                                   GetOutlineColorB(),
-                                                   GetOutlineOpacity()));
-
-  shapesToDraw.push_back(command);
+  sf::Vector2f axis = length != 0
+                          ? sf::Vector2f((x2 - x) / length, (y2 - y) / length)
+                          : sf::Vector2f(1, 0);
+  AddRectangle(sf::Vector2f((x + x2) / 2 + Xgap, (y + y2) / 2 + Ygap),
+               axis,
+               length / 2,
+               thickness / 2);
 }
 
 void RuntimeShapePainterObject::DrawCircle(float x, float y, float radius) {
   float Xgap = AreCoordinatesAbsolute() ? 0 : GetX();
   float Ygap = AreCoordinatesAbsolute() ? 0 : GetY();
 
-  sf::CircleShape circle(radius);
-  DrawingCommand command(circle);
-  command.circleShape.setPosition(x + Xgap, y + Ygap);
-  command.circleShape.setOrigin(radius, radius);
-  command.circleShape.setFillColor(sf::Color(
-      GetFillColorR(), GetFillColorG(), GetFillColorB(), GetFillOpacity()));
-  command.circleShape.setOutlineThickness(GetOutlineSize());
-  command.circleShape.setOutlineColor(sf::Color(GetOutlineColorR(),
-                                                GetOutlineColorG(),
-                                                GetOutlineColorB(),
-                                                GetOutlineOpacity()));
-
-  shapesToDraw.push_back(command);
+  sf::Vector2f center(x + Xgap, y + Ygap);
+  std::size_t segmentsCount = std::min(
+      maximumCircleSegmentsCount,
+      std::max(minimumCircleSegmentsCount,
+               static_cast<std::size_t>(2 * pi * std::abs(radius) /
+                                        circleSegmentLength)));
+
+  sf::Color fillColor = GetFillColor();
+  sf::Color outlineColor = GetOutlineColor();
+  float outlineSize = GetOutlineSize();
+  sf::Vector2f direction(1, 0);
+  for (std::size_t i = 1; i <= segmentsCount; ++i) {
+    float angle = 2 * pi * i / segmentsCount;
+    sf::Vector2f nextDirection(std::cos(angle), std::sin(angle));
+
+    vertices.append(sf::Vertex(center, fillColor));
+    vertices.append(sf::Vertex(center + direction * radius, fillColor));
+    vertices.append(sf::Vertex(center + nextDirection * radius, fillColor));
+    if (outlineSize != 0) {
+      AddQuad(center + direction * radius,
+              center + nextDirection * radius,
+              center + nextDirection * (radius + outlineSize),
+              center + direction * (radius + outlineSize),
+              outlineColor);
+    }
+
+    direction = nextDirection;
+  }
 }
@@ -8,8 +8,8 @@ This project is released under the MIT License.
 #ifndef DRAWEROBJECT_H
 #define DRAWEROBJECT_H
 
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 #include <vector>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
@@ -28,20 +28,6 @@ class Project;
 }
 #endif
 
-/**
- * \brief Internal class to define a shape to be drawn
- */
-class GD_EXTENSION_API DrawingCommand {
- public:
-  DrawingCommand(const sf::RectangleShape& rectangleShape_)
-      : rectangleShape(rectangleShape_){};
-  DrawingCommand(const sf::CircleShape& circleShape_)
-      : circleShape(circleShape_){};
-
-  sf::RectangleShape rectangleShape;
-  sf::CircleShape circleShape;
-};
-
 /**
  * \brief Base object storing the setup of a drawer object.
  */
@@ -138,6 +124,10 @@ class GD_EXTENSION_API RuntimeShapePainterObject
 
   virtual bool Draw(sf::RenderTarget& renderTarget);
 
+  // Shapes can be drawn anywhere on the scene.
+  virtual bool CanBeCulled() const { return false; };
+  virtual bool CanBeRecycled() const { return false; };
+
   virtual float GetWidth() const { return 32; };
   virtual float GetHeight() const { return 32; };
 
@@ -146,6 +136,9 @@ class GD_EXTENSION_API RuntimeShapePainterObject
 
   void DrawRectangle(float x, float y, float x2, float y2);
   void DrawLine(float x, float y, float x2, float y2, float thickness);
+  /**
+   * \brief Draw a circle, made of more segments as the radius grows.
+   */
   void DrawCircle(float x, float y, float radius);
 
 #if defined(GD_IDE_ONLY)
@@ -157,7 +150,30 @@ class GD_EXTENSION_API RuntimeShapePainterObject
 #endif
 
  private:
-  std::vector<DrawingCommand> shapesToDraw;
+  /**
+   * \brief Add the triangles of a rectangle, with its outline.
+   * \param center The center of the rectangle.
+   * \param axis The unit vector along the width of the rectangle.
+   */
+  void AddRectangle(const sf::Vector2f& center,
+                    const sf::Vector2f& axis,
+                    float halfWidth,
+                    float halfHeight);
+
+  /**
+   * \brief Add the two triangles of the quad a, b, c, d.
+   */
+  void AddQuad(const sf::Vector2f& a,
+               const sf::Vector2f& b,
+               const sf::Vector2f& c,
+               const sf::Vector2f& d,
+               const sf::Color& color);
+
+  sf::Color GetFillColor() const;
+  sf::Color GetOutlineColor() const;
+
+  sf::VertexArray vertices;  ///< The triangles of the shapes drawn since the
+                             ///< last rendering, drawn in a single call.
 };
 
 #endif  // DRAWEROBJECT_H
@@ -34,6 +34,8 @@ class GD_EXTENSION_API RuntimeTextEntryObject : public RuntimeObject {
     return gd::make_unique<RuntimeTextEntryObject>(*this);
   }
 
+  virtual bool CanBeRecycled() const { return false; };
+
 #if defined(GD_IDE_ONLY)
   virtual void GetPropertyForDebugger(std::size_t propertyNb,
                                       gd::String& name,
@@ -0,0 +1,297 @@
+/**
+
+GDevelop - Text Object Extension
+Copyright (c) 2008-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "TextLayout.h"
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "GDCpp/Runtime/GlyphAtlas.h"
+
+namespace {
+void AddLine(std::vector<sf::Vertex>& vertices,
+             float lineLength,
+             float lineTop,
+             float offset,
+             float thickness) {
+  float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+  float bottom = top + std::floor(thickness + 0.5f);
+
+  // The texture of fonts has white pixels at (1, 1), used for lines.
+  vertices.push_back(sf::Vertex(sf::Vector2f(0, top), sf::Vector2f(1, 1)));
+  vertices.push_back(
+      sf::Vertex(sf::Vector2f(lineLength, top), sf::Vector2f(1, 1)));
+  vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom), sf::Vector2f(1, 1)));
+  vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom), sf::Vector2f(1, 1)));
+  vertices.push_back(
+      sf::Vertex(sf::Vector2f(lineLength, top), sf::Vector2f(1, 1)));
+  vertices.push_back(
+      sf::Vertex(sf::Vector2f(lineLength, bottom), sf::Vector2f(1, 1)));
+}
+
+void AddGlyphQuad(std::vector<sf::Vertex>& vertices,
+                  sf::Vector2f position,
+                  const sf::FloatRect& bounds,
+                  const sf::IntRect& textureRect,
+                  float italic) {
+  float padding = 1.0;
+
+  float left = bounds.left - padding;
+  float top = bounds.top - padding;
+  float right = bounds.left + bounds.width + padding;
+  float bottom = bounds.top + bounds.height + padding;
+
+  float u1 = static_cast<float>(textureRect.left) - padding;
+  float v1 = static_cast<float>(textureRect.top) - padding;
+  float u2 =
+      static_cast<float>(textureRect.left + textureRect.width) + padding;
+  float v2 =
+      static_cast<float>(textureRect.top + textureRect.height) + padding;
+
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + left - italic * top, position.y + top),
+      sf::Vector2f(u1, v1)));
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + right - italic * top, position.y + top),
+      sf::Vector2f(u2, v1)));
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + left - italic * bottom, position.y + bottom),
+      sf::Vector2f(u1, v2)));
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + left - italic * bottom, position.y + bottom),
+      sf::Vector2f(u1, v2)));
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + right - italic * top, position.y + top),
+      sf::Vector2f(u2, v1)));
+  vertices.push_back(sf::Vertex(
+      sf::Vector2f(position.x + right - italic * bottom, position.y + bottom),
+      sf::Vector2f(u2, v2)));
+}
+
+struct TextLayoutKey {
+  const sf::Font* font;
+  unsigned int characterSize;
+  sf::Uint32 style;
+  sf::String string;
+  const GlyphAtlas* atlas;
+
+  bool operator<(const TextLayoutKey& other) const {
+    if (font != other.font) return font < other.font;
+    if (atlas != other.atlas) return atlas < other.atlas;
+    if (characterSize != other.characterSize)
+      return characterSize < other.characterSize;
+    if (style != other.style) return style < other.style;
+    return string < other.string;
+  }
+};
+}  // namespace
+
+TextLayout::TextLayout(const sf::Font& font_,
+                       unsigned int characterSize_,
+                       sf::Uint32 style_,
+                       const sf::String& string_,
+                       const TextLayout* previous,
+                       GlyphAtlas* atlas_)
+    : font(font_),
+      characterSize(characterSize_),
+      style(style_),
+      string(string_),
+      atlas(atlas_) {
+  if (string.isEmpty()) return;
+
+  bool isBold = style & sf::Text::Bold;
+  bool isUnderlined = style & sf::Text::Underlined;
+  bool isStrikeThrough = style & sf::Text::StrikeThrough;
+  float italic = (style & sf::Text::Italic) ? 0.208f : 0.f;
+  float underlineOffset = font.getUnderlinePosition(characterSize);
+  float underlineThickness = font.getUnderlineThickness(characterSize);
+
+  sf::FloatRect xBounds = font.getGlyph(L'x', characterSize, isBold).bounds;
+  float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+  float hspace = font.getGlyph(L' ', characterSize, isBold).advance;
+  float vspace = font.getLineSpacing(characterSize);
+
+  // Add all the new glyphs to the atlas at once.
+  if (atlas) atlas->Prewarm(font, characterSize, isBold, string);
+  const sf::Texture* fontTexture = &font.getTexture(characterSize);
+
+  // Lines use the white pixels of the texture of the previous glyph, to avoid
+  // changing of texture.
+  auto getLinesTexture = [&]() {
+    if (!quadsTextures.empty()) return quadsTextures.back();
+    return atlas ? &atlas->GetLinesTexture() : fontTexture;
+  };
+
+  // Start from the characters that are the same in the previous layout.
+  std::size_t first = 0;
+  if (previous && &previous->font == &font && previous->atlas == atlas &&
+      previous->characterSize == characterSize && previous->style == style) {
+    std::size_t maxFirst =
+        std::min(previous->string.getSize(), string.getSize());
+    while (first < maxFirst && previous->string[first] == string[first])
+      first++;
+  }
+
+  float x = 0.f;
+  float y = static_cast<float>(characterSize);
+  float minX = static_cast<float>(characterSize);
+  float minY = static_cast<float>(characterSize);
+  float maxX = 0.f;
+  float maxY = 0.f;
+  if (first > 0) {
+    const Character& state = previous->characters[first];
+    vertices.assign(previous->vertices.begin(),
+                    previous->vertices.begin() + state.firstVertex);
+    characters.assign(previous->characters.begin(),
+                      previous->characters.begin() + first);
+    quadsTextures.assign(
+        previous->quadsTextures.begin(),
+        previous->quadsTextures.begin() + state.firstVertex / 6);
+    x = state.x;
+    y = state.y;
+    minX = state.minX;
+    minY = state.minY;
+    maxX = state.maxX;
+    maxY = state.maxY;
+  }
+  characters.reserve(string.getSize() + 1);
+
+  sf::Uint32 prevChar = first > 0 ? string[first - 1] : 0;
+  for (std::size_t i = first; i <= string.getSize(); ++i) {
+    Character state = {vertices.size(), x, y, minX, minY, maxX, maxY};
+    characters.push_back(state);
+    if (i == string.getSize()) break;
+
+    sf::Uint32 curChar = string[i];
+
+    // Apply the kerning offset
+    x += font.getKerning(prevChar, curChar, characterSize);
+    prevChar = curChar;
+
+    // Draw the lines of the underlined and strike through styles at the end
+    // of each line.
+    if (isUnderlined && (curChar == L'\n')) {
+      AddLine(vertices, x, y, underlineOffset, underlineThickness);
+      quadsTextures.push_back(getLinesTexture());
+    }
+    if (isStrikeThrough && (curChar == L'\n')) {
+      AddLine(vertices, x, y, strikeThroughOffset, underlineThickness);
+      quadsTextures.push_back(getLinesTexture());
+    }
+
+    // Handle special characters
+    if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t')) {
+      minX = std::min(minX, x);
+      minY = std::min(minY, y);
+
+      switch (curChar) {
+        case L' ':
+          x += hspace;
+          break;
+        case L'\t':
+          x += hspace * 4;
+          break;
+        case L'\n':
+          y += vspace;
+          x = 0;
+          break;
+      }
+
+      maxX = std::max(maxX, x);
+      maxY = std::max(maxY, y);
+      continue;
+    }
+
+    const sf::Glyph& glyph = font.getGlyph(curChar, characterSize, isBold);
+    if (atlas) {
+      const GlyphAtlas::Glyph& atlasGlyph =
+          atlas->GetGlyph(font, characterSize, isBold, curChar);
+      AddGlyphQuad(vertices,
+                   sf::Vector2f(x, y),
+                   glyph.bounds,
+                   atlasGlyph.textureRect,
+                   italic);
+      quadsTextures.push_back(atlasGlyph.texture);
+    } else {
+      AddGlyphQuad(vertices,
+                   sf::Vector2f(x, y),
+                   glyph.bounds,
+                   glyph.textureRect,
+                   italic);
+      quadsTextures.push_back(fontTexture);
+    }
+
+    float left = glyph.bounds.left;
+    float top = glyph.bounds.top;
+    float right = glyph.bounds.left + glyph.bounds.width;
+    float bottom = glyph.bounds.top + glyph.bounds.height;
+
+    minX = std::min(minX, x + left - italic * bottom);
+    maxX = std::max(maxX, x + right - italic * top);
+    minY = std::min(minY, y + top);
+    maxY = std::max(maxY, y + bottom);
+
+    x += glyph.advance;
+  }
+
+  // Draw the lines of the last line
+  if (isUnderlined && (x > 0)) {
+    AddLine(vertices, x, y, underlineOffset, underlineThickness);
+    quadsTextures.push_back(getLinesTexture());
+  }
+  if (isStrikeThrough && (x > 0)) {
+    AddLine(vertices, x, y, strikeThroughOffset, underlineThickness);
+    quadsTextures.push_back(getLinesTexture());
+  }
+
+  for (std::size_t i = 0; i < quadsTextures.size(); ++i) {
+    if (runs.empty() || runs.back().texture != quadsTextures[i]) {
+      Run run = {quadsTextures[i], i * 6, 0};
+      runs.push_back(run);
+    }
+    runs.back().verticesCount += 6;
+  }
+
+  bounds.left = minX;
+  bounds.top = minY;
+  bounds.width = maxX - minX;
+  bounds.height = maxY - minY;
+}
+
+std::shared_ptr<const TextLayout> TextLayout::Get(
+    const sf::Font& font,
+    unsigned int characterSize,
+    sf::Uint32 style,
+    const sf::String& string,
+    const std::shared_ptr<const TextLayout>& previous,
+    GlyphAtlas* atlas) {
+  // Layouts are kept as long as a text uses them.
+  static std::map<TextLayoutKey, std::weak_ptr<const TextLayout> > layouts;
+  static std::size_t nextCleanSize = 64;
+
+  TextLayoutKey key = {&font, characterSize, style, string, atlas};
+  std::weak_ptr<const TextLayout>& cachedLayout = layouts[key];
+  if (auto layout = cachedLayout.lock()) return layout;
+
+  auto layout = std::make_shared<const TextLayout>(
+      font, characterSize, style, string, previous.get(), atlas);
+  cachedLayout = layout;
+
+  if (layouts.size() >= nextCleanSize) {
+    for (auto it = layouts.begin(); it != layouts.end();) {
+      if (it->second.expired())
+        it = layouts.erase(it);
+      else
+        ++it;
+    }
+    nextCleanSize = std::max<std::size_t>(64, layouts.size() * 2);
+  }
+
+  return layout;
+}
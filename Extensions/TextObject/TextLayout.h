@@ -0,0 +1,134 @@
+/**
+
+GDevelop - Text Object Extension
+Copyright (c) 2008-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#ifndef TEXTLAYOUT_H
+#define TEXTLAYOUT_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/String.hpp>
+#include <memory>
+#include <vector>
+class GlyphAtlas;
+namespace sf {
+class Font;
+class Texture;
+}
+
+/**
+ * \brief The glyphs of a text, laid out like sf::Text does.
+ *
+ * Layouts are immutable so that text objects displaying the same text with
+ * the same font, size and style share a single layout (see
+ * TextLayout::Get). Vertices are in the coordinates of the text and white:
+ * the transform and the color of the text are applied when the text is
+ * drawn.
+ *
+ * When laid out with a GlyphAtlas, the glyphs are in the textures of the
+ * atlas, so that texts of different fonts and sizes can be drawn in a single
+ * batch.
+ *
+ * \see RuntimeTextObject
+ */
+class GD_EXTENSION_API TextLayout {
+ public:
+  /**
+   * \brief Lay out \a string, reusing the glyphs of \a previous, if any, that
+   * are the same at the beginning of both strings.
+   *
+   * \a previous must have been laid out with the same font, character size
+   * and style. This makes changes at the end of texts (like scores, timers or
+   * counters) cheap, as only the glyphs that changed are laid out.
+   *
+   * \param atlas If not null, the glyphs are added to the atlas and the
+   * vertices use its textures. Otherwise, the texture of the font is used.
+   */
+  TextLayout(const sf::Font& font,
+             unsigned int characterSize,
+             sf::Uint32 style,
+             const sf::String& string,
+             const TextLayout* previous = nullptr,
+             GlyphAtlas* atlas = nullptr);
+
+  /**
+   * \brief Return the layout of a text, from the layouts used by other texts
+   * if possible.
+   *
+   * \param previous The layout previously used by the text, if any: it is
+   * used to lay out the text incrementally when no other text has the same
+   * layout.
+   */
+  static std::shared_ptr<const TextLayout> Get(
+      const sf::Font& font,
+      unsigned int characterSize,
+      sf::Uint32 style,
+      const sf::String& string,
+      const std::shared_ptr<const TextLayout>& previous = nullptr,
+      GlyphAtlas* atlas = nullptr);
+
+  /**
+   * \brief Consecutive vertices using the same texture.
+   */
+  struct Run {
+    const sf::Texture* texture;
+    std::size_t firstVertex;
+    std::size_t verticesCount;
+  };
+
+  /**
+   * \brief Return the triangles of the glyphs, with texture coordinates in
+   * the texture of the font for the character size, or in the textures of the
+   * atlas.
+   */
+  const std::vector<sf::Vertex>& GetVertices() const { return vertices; }
+
+  /**
+   * \brief Return the vertices to be drawn with each texture. There is a
+   * single run, unless the glyphs are in several pages of the atlas.
+   */
+  const std::vector<Run>& GetRuns() const { return runs; }
+
+  /**
+   * \brief Return the bounds of the text, like sf::Text::getLocalBounds.
+   */
+  const sf::FloatRect& GetBounds() const { return bounds; }
+
+  const sf::Font& GetFont() const { return font; }
+  unsigned int GetCharacterSize() const { return characterSize; }
+  sf::Uint32 GetStyle() const { return style; }
+  const sf::String& GetString() const { return string; }
+
+ private:
+  /**
+   * \brief The state of the layout before a character, to resume the layout
+   * from there.
+   */
+  struct Character {
+    std::size_t firstVertex;
+    float x;
+    float y;
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+  };
+
+  const sf::Font& font;
+  unsigned int characterSize;
+  sf::Uint32 style;
+  sf::String string;
+  GlyphAtlas* atlas;
+
+  std::vector<sf::Vertex> vertices;
+  std::vector<const sf::Texture*> quadsTextures;  ///< The texture of each quad
+                                                  ///< (6 vertices).
+  std::vector<Run> runs;
+  std::vector<Character> characters;  ///< The state before each character.
+  sf::FloatRect bounds;
+};
+
+#endif  // TEXTLAYOUT_H
@@ -14,6 +14,7 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/Project/InitialInstance.h"
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "TextObject.h"
 
 #if defined(GD_IDE_ONLY)
@@ -85,7 +86,14 @@ void TextObject::ExposeResources(gd::ArbitraryResourceWorker& worker) {
 
 RuntimeTextObject::RuntimeTextObject(RuntimeScene& scene,
                                      const TextObject& textObject)
-    : RuntimeObject(scene, textObject), opacity(255), angle(0) {
+    : RuntimeObject(scene, textObject),
+      font(nullptr),
+      characterSize(30),
+      style(sf::Text::Regular),
+      color(sf::Color::White),
+      opacity(255),
+      smoothed(textObject.IsSmoothed()),
+      angle(0) {
   ChangeFont(textObject.GetFontName());
   SetSmooth(textObject.IsSmoothed());
   SetColor(
@@ -101,12 +109,69 @@ RuntimeTextObject::RuntimeTextObject(RuntimeScene& scene,
 bool RuntimeTextObject::Draw(sf::RenderTarget& renderTarget) {
   if (hidden) return true;  // Don't draw anything if hidden
 
-  renderTarget.draw(text);
+  SpriteBatch batch;
+  DrawBatched(renderTarget, batch);
+  batch.Flush(renderTarget);
   return true;
 }
 
+bool RuntimeTextObject::DrawBatched(sf::RenderTarget& renderTarget,
+                                    SpriteBatch& batch) {
+  if (hidden) return true;  // Don't draw anything if hidden
+  if (!layout) return true;
+
+  // Glyphs are in the atlas shared by all the texts, so that consecutive texts
+  // are drawn in a single draw call, whatever their font and size.
+  sf::Transform transform = GetTransform();
+  for (const TextLayout::Run& run : layout->GetRuns()) {
+    batch.Add(renderTarget,
+              *run.texture,
+              layout->GetVertices().data() + run.firstVertex,
+              run.verticesCount,
+              transform,
+              color,
+              sf::BlendAlpha);
+  }
+  return true;
+}
+
+std::size_t RuntimeTextObject::GetRenderingHash() const {
+  // Layouts are shared by the texts having the same string, font, size and
+  // style, so that they are identified by their address.
+  std::size_t hash = RuntimeObject::GetRenderingHash();
+  hash = hash * 31 + reinterpret_cast<std::size_t>(layout.get());
+  hash = hash * 31 + color.toInteger();
+  hash = hash * 31 + (smoothed ? 1 : 0);
+  return hash;
+}
+
+sf::Transform RuntimeTextObject::GetTransform() const {
+  sf::Transform transform;
+  transform.translate(position);
+  transform.rotate(angle);
+  transform.translate(-origin);
+  return transform;
+}
+
+void RuntimeTextObject::UpdateLayout() {
+  if (font)
+    layout = TextLayout::Get(*font,
+                             characterSize,
+                             style,
+                             string.ToSfString(),
+                             layout,
+                             &FontManager::Get()->GetGlyphAtlas(smoothed));
+  else
+    layout.reset();
+}
+
+void RuntimeTextObject::UpdateOrigin() {
+  sf::FloatRect bounds = layout ? layout->GetBounds() : sf::FloatRect();
+  origin = sf::Vector2f(bounds.width / 2, bounds.height / 2);
+}
+
 void RuntimeTextObject::OnPositionChanged() {
-  text.setPosition(GetX() + text.getOrigin().x, GetY() + text.getOrigin().y);
+  position = sf::Vector2f(GetX() + origin.x, GetY() + origin.y);
 }
 
 /**
@@ -125,38 +190,43 @@ std::vector<Polygon2d> RuntimeTextObject::GetHitBoxes() const {
 /**
  * Get the real X position of the sprite
  */
-float RuntimeTextObject::GetDrawableX() const {
-  return text.getPosition().x - text.getOrigin().x;
-}
+float RuntimeTextObject::GetDrawableX() const { return position.x - origin.x; }
 
 /**
  * Get the real Y position of the text
  */
-float RuntimeTextObject::GetDrawableY() const {
-  return text.getPosition().y - text.getOrigin().y;
-}
+float RuntimeTextObject::GetDrawableY() const { return position.y - origin.y; }
 
 /**
  * Width is the width of the current sprite.
  */
 float RuntimeTextObject::GetWidth() const {
-  return text.getLocalBounds().width;
+  return layout ? layout->GetBounds().width : 0;
 }
 
 /**
  * Height is the height of the current sprite.
  */
 float RuntimeTextObject::GetHeight() const {
-  return text.getLocalBounds().height + text.getLocalBounds().top;
+  return layout ? layout->GetBounds().height + layout->GetBounds().top : 0;
 }
 
 void RuntimeTextObject::SetString(const gd::String& str) {
-  text.setString(str);
-  text.setOrigin(text.getLocalBounds().width / 2,
-                 text.getLocalBounds().height / 2);
+  // Texts like scores are often set to the same string at each frame.
+  if (str == string && layout) return;
+
+  string = str;
+  UpdateLayout();
+  UpdateOrigin();
 }
 
-gd::String RuntimeTextObject::GetString() const { return text.getString(); }
+gd::String RuntimeTextObject::GetString() const { return string; }
+
+void RuntimeTextObject::SetCharacterSize(float size) {
+  characterSize = size;
+  UpdateLayout();
+  UpdateOrigin();
+}
 
 /**
  * Change the color filter of the sprite object
@@ -164,7 +234,7 @@ gd::String RuntimeTextObject::GetString() const { return text.getString(); }
 void RuntimeTextObject::SetColor(unsigned int r,
                                  unsigned int g,
                                  unsigned int b) {
-  text.setFillColor(sf::Color(r, g, b, opacity));
+  color = sf::Color(r, g, b, opacity);
 }
 
 void RuntimeTextObject::SetColor(const gd::String& colorStr) {
@@ -182,28 +252,29 @@ void RuntimeTextObject::SetOpacity(float val) {
     val = 0;
 
   opacity = val;
-  const sf::Color& currentColor = text.getFillColor();
-  text.setFillColor(
-      sf::Color(currentColor.r, currentColor.g, currentColor.b, opacity));
+  color.a = opacity;
 }
 
 void RuntimeTextObject::ChangeFont(const gd::String& fontName_) {
-  if (!text.getFont() || fontName_ != fontName) {
+  if (!font || fontName_ != fontName) {
     fontName = fontName_;
-    text.setFont(*FontManager::Get()->GetFont(fontName));
-    text.setOrigin(text.getLocalBounds().width / 2,
-                   text.getLocalBounds().height / 2);
+    font = FontManager::Get()->GetFont(fontName);
+    UpdateLayout();
+    UpdateOrigin();
     OnPositionChanged();
     SetSmooth(smoothed);  // Ensure texture smoothing is up to date.
   }
 }
 
-void RuntimeTextObject::SetFontStyle(int style) { text.setStyle(style); }
+void RuntimeTextObject::SetFontStyle(int style_) {
+  style = style_;
+  UpdateLayout();
+}
 
-int RuntimeTextObject::GetFontStyle() { return text.getStyle(); }
+int RuntimeTextObject::GetFontStyle() { return style; }
 
-bool RuntimeTextObject::HasFontStyle(sf::Text::Style style) {
-  return (text.getStyle() & style) != 0;
+bool RuntimeTextObject::HasFontStyle(sf::Text::Style style_) {
+  return (style & style_) != 0;
 }
 
 bool RuntimeTextObject::IsBold() { return HasFontStyle(sf::Text::Bold); }
@@ -235,9 +306,11 @@ void RuntimeTextObject::SetUnderlined(bool underlined) {
 void RuntimeTextObject::SetSmooth(bool smooth) {
   smoothed = smooth;
 
-  if (text.getFont())
-    const_cast<sf::Texture&>(text.getFont()->getTexture(GetCharacterSize()))
+  // Glyphs too large for the atlas are still drawn from the font texture.
+  if (font)
+    const_cast<sf::Texture&>(font->getTexture(GetCharacterSize()))
         .setSmooth(smooth);
+  UpdateLayout();
 }
 
 #if defined(GD_IDE_ONLY)
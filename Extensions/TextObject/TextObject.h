@@ -9,9 +9,11 @@ This project is released under the MIT License.
 #define TEXTOBJECT_H
 
 #include <SFML/Graphics/Text.hpp>
+#include <memory>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/String.h"
+#include "TextLayout.h"
 class RuntimeScene;
 namespace gd {
 class Project;
@@ -102,7 +104,11 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
     return gd::make_unique<RuntimeTextObject>(*this);
   }
 
+  virtual bool CanBeRecycled() const { return false; };
+
   virtual bool Draw(sf::RenderTarget& renderTarget);
+  virtual bool DrawBatched(sf::RenderTarget& renderTarget, SpriteBatch& batch);
+  virtual std::size_t GetRenderingHash() const;
 
   virtual void OnPositionChanged();
 
@@ -114,7 +120,6 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
 
   virtual bool SetAngle(float newAngle) {
     angle = newAngle;
-    text.setRotation(angle);
     return true;
   };
   virtual float GetAngle() const { return angle; };
@@ -122,12 +127,8 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
   void SetString(const gd::String& str);
   gd::String GetString() const;
 
-  inline void SetCharacterSize(float size) {
-    text.setCharacterSize(size);
-    text.setOrigin(text.getLocalBounds().width / 2,
-                   text.getLocalBounds().height / 2);
-  };
-  inline float GetCharacterSize() const { return text.getCharacterSize(); };
+  void SetCharacterSize(float size);
+  inline float GetCharacterSize() const { return characterSize; };
 
   /** \brief Change the text object font filename and reload the font
    */
@@ -156,9 +157,9 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
 
   void SetColor(unsigned int r, unsigned int g, unsigned int b);
   void SetColor(const gd::String& colorStr);
-  unsigned int GetColorR() const { return text.getFillColor().r; };
-  unsigned int GetColorG() const { return text.getFillColor().g; };
-  unsigned int GetColorB() const { return text.getFillColor().b; };
+  unsigned int GetColorR() const { return color.r; };
+  unsigned int GetColorG() const { return color.g; };
+  unsigned int GetColorB() const { return color.b; };
 
   virtual std::vector<Polygon2d> GetHitBoxes() const;
 
@@ -171,7 +172,30 @@ class GD_EXTENSION_API RuntimeTextObject : public RuntimeObject {
 #endif
 
  private:
-  sf::Text text;
+  /**
+   * \brief Lay out the text again, after a change of its string, font,
+   * character size or style. Texts displaying the same string with the same
+   * font share their layout (see TextLayout::Get).
+   */
+  void UpdateLayout();
+
+  /**
+   * \brief Move the origin to the center of the text, like when the string,
+   * the font or the character size is changed.
+   */
+  void UpdateOrigin();
+
+  sf::Transform GetTransform() const;
+
+  gd::String string;
+  const sf::Font* font;
+  unsigned int characterSize;
+  sf::Uint32 style;
+  sf::Color color;  ///< The color of the text, with the opacity as alpha.
+  std::shared_ptr<const TextLayout> layout;
+  sf::Vector2f origin;    ///< The origin of the text, used for rotations.
+  sf::Vector2f position;  ///< The position of the origin.
+
   gd::String fontName;
   float opacity;
   bool smoothed;
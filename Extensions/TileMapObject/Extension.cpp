@@ -0,0 +1,101 @@
+/**
+
+GDevelop - Tile Map Extension
+Copyright (c) 2014-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "GDCpp/Extensions/ExtensionBase.h"
+
+#include "TileMapObject.h"
+
+void DeclareTileMapObjectExtension(gd::PlatformExtension& extension) {
+  extension.SetExtensionInformation(
+      "TileMapObject",
+      _("Tile Map Object"),
+      _("This Extension enables the use of Tile Map Objects, displaying a "
+        "grid of tiles with a single object."),
+      "Florian Rival",
+      "Open source (MIT License)")
+      .SetExtensionHelpPath("/objects/tile_map");
+
+  gd::ObjectMetadata& obj = extension.AddObject<TileMapObject>(
+      "TileMap",
+      _("Tile Map"),
+      _("Displays a grid of tiles, taken from a tileset image"),
+      "CppPlatform/Extensions/TiledSpriteIcon.png");
+
+#if defined(GD_IDE_ONLY)
+  obj.SetIncludeFile("TileMapObject/TileMapObject.h");
+
+  obj.AddAction("SetTile",
+                _("Change a tile"),
+                _("Change a tile of a Tile Map. Use -1 to remove the tile."),
+                _("Change the tile at column _PARAM1_, row _PARAM2_ of "
+                  "_PARAM0_ to _PARAM3_"),
+                _("Tiles"),
+                "res/actions/scaleWidth24.png",
+                "res/actions/scaleWidth.png")
+      .AddParameter("object", _("Object"), "TileMap")
+      .AddParameter("expression", _("Column"))
+      .AddParameter("expression", _("Row"))
+      .AddParameter("expression", _("Tile (-1 to remove the tile)"))
+      .SetFunctionName("SetTile")
+      .SetIncludeFile("TileMapObject/TileMapObject.h");
+
+  obj.AddExpression("Tile",
+                    _("Tile"),
+                    _("Tile at a column and a row (-1 if there is no tile)"),
+                    _("Tiles"),
+                    "res/actions/scaleWidth.png")
+      .AddParameter("object", _("Object"), "TileMap")
+      .AddParameter("expression", _("Column"))
+      .AddParameter("expression", _("Row"))
+      .SetFunctionName("GetTile")
+      .SetIncludeFile("TileMapObject/TileMapObject.h");
+
+  obj.AddExpression("TileAtPosition",
+                    _("Tile at a position"),
+                    _("Tile at a position on the scene (-1 if there is no "
+                      "tile)"),
+                    _("Tiles"),
+                    "res/actions/scaleWidth.png")
+      .AddParameter("object", _("Object"), "TileMap")
+      .AddParameter("expression", _("X position"))
+      .AddParameter("expression", _("Y position"))
+      .SetFunctionName("GetTileAtPosition")
+      .SetIncludeFile("TileMapObject/TileMapObject.h");
+#endif
+}
+
+/**
+ * \brief This class declares information about the extension.
+ */
+class TileMapObjectCppExtension : public ExtensionBase {
+ public:
+  /**
+   * Constructor of an extension declares everything the extension contains:
+   * objects, actions, conditions and expressions.
+   */
+  TileMapObjectCppExtension() {
+    DeclareTileMapObjectExtension(*this);
+    AddRuntimeObject<TileMapObject, RuntimeTileMapObject>(
+        GetObjectMetadata("TileMapObject::TileMap"), "RuntimeTileMapObject");
+
+    GD_COMPLETE_EXTENSION_COMPILATION_INFORMATION();
+  };
+};
+
+#if defined(ANDROID)
+extern "C" ExtensionBase* CreateGDCppTileMapObjectExtension() {
+  return new TileMapObjectCppExtension;
+}
+#elif !defined(EMSCRIPTEN)
+/**
+ * Used by GDevelop to create the extension class
+ * -- Do not need to be modified. --
+ */
+extern "C" ExtensionBase* GD_EXTENSION_API CreateGDExtension() {
+  return new TileMapObjectCppExtension;
+}
+#endif
@@ -0,0 +1,384 @@
+/**
+
+GDevelop - Tile Map Extension
+Copyright (c) 2014-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "TileMapObject.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include "GDCore/Tools/Localization.h"
+#include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/InitialInstance.h"
+#include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/Project/Project.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/Serialization/SerializerElement.h"
+
+#if defined(GD_IDE_ONLY)
+#include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
+#endif
+
+const std::size_t RuntimeTileMapObject::chunkSize = 16;
+
+TileMapObject::TileMapObject(gd::String name_)
+    : Object(name_),
+      textureName(""),
+      tileWidth(32),
+      tileHeight(32),
+      columnsCount(0),
+      rowsCount(0) {
+  SetSize(10, 10);
+}
+
+void TileMapObject::SetSize(std::size_t columnsCount_,
+                            std::size_t rowsCount_) {
+  std::vector<int> newTiles(columnsCount_ * rowsCount_, -1);
+  for (std::size_t row = 0; row < std::min(rowsCount, rowsCount_); ++row) {
+    for (std::size_t column = 0; column < std::min(columnsCount, columnsCount_);
+         ++column)
+      newTiles[row * columnsCount_ + column] = GetTile(column, row);
+  }
+
+  tiles.swap(newTiles);
+  columnsCount = columnsCount_;
+  rowsCount = rowsCount_;
+}
+
+int TileMapObject::GetTile(std::size_t column, std::size_t row) const {
+  if (column >= columnsCount || row >= rowsCount) return -1;
+
+  return tiles[row * columnsCount + column];
+}
+
+void TileMapObject::SetTile(std::size_t column, std::size_t row, int tile) {
+  if (column >= columnsCount || row >= rowsCount) return;
+
+  tiles[row * columnsCount + column] = tile < 0 ? -1 : tile;
+}
+
+void TileMapObject::DoUnserializeFrom(gd::Project& project,
+                                      const gd::SerializerElement& element) {
+  textureName = element.GetStringAttribute("texture");
+  tileWidth = element.GetDoubleAttribute("tileWidth", 32);
+  tileHeight = element.GetDoubleAttribute("tileHeight", 32);
+
+  // Tiles are stored as a single string, to keep big maps small.
+  columnsCount = 0;
+  rowsCount = 0;
+  tiles.clear();
+  SetSize(std::max(element.GetIntAttribute("columnsCount", 10), 0),
+          std::max(element.GetIntAttribute("rowsCount", 10), 0));
+
+  std::vector<gd::String> serializedTiles =
+      element.GetStringAttribute("tiles").Split(U',');
+  for (std::size_t i = 0; i < serializedTiles.size() && i < tiles.size(); ++i)
+    tiles[i] = std::max(serializedTiles[i].To<int>(), -1);
+}
+
+#if defined(GD_IDE_ONLY)
+void TileMapObject::DoSerializeTo(gd::SerializerElement& element) const {
+  element.SetAttribute("texture", textureName);
+  element.SetAttribute("tileWidth", tileWidth);
+  element.SetAttribute("tileHeight", tileHeight);
+  element.SetAttribute("columnsCount", static_cast<int>(columnsCount));
+  element.SetAttribute("rowsCount", static_cast<int>(rowsCount));
+
+  gd::String serializedTiles;
+  for (std::size_t i = 0; i < tiles.size(); ++i) {
+    if (i != 0) serializedTiles += ",";
+    serializedTiles += gd::String::From(tiles[i]);
+  }
+  element.SetAttribute("tiles", serializedTiles);
+}
+
+void TileMapObject::ExposeResources(gd::ArbitraryResourceWorker& worker) {
+  worker.ExposeImage(textureName);
+}
+#endif
+
+RuntimeTileMapObject::RuntimeTileMapObject(RuntimeScene& scene,
+                                           const TileMapObject& tileMapObject)
+    : RuntimeObject(scene, tileMapObject),
+      tileWidth(tileMapObject.GetTileWidth()),
+      tileHeight(tileMapObject.GetTileHeight()),
+      columnsCount(tileMapObject.GetColumnsCount()),
+      rowsCount(tileMapObject.GetRowsCount()),
+      tiles(tileMapObject.GetTiles()),
+      chunkColumnsCount((columnsCount + chunkSize - 1) / chunkSize),
+      collidersNeedUpdate(true),
+      hitBoxesNeedUpdate(true),
+      hitBoxesX(0),
+      hitBoxesY(0) {
+  std::size_t chunkRowsCount = (rowsCount + chunkSize - 1) / chunkSize;
+  chunks.resize(chunkColumnsCount * chunkRowsCount);
+
+  ChangeAndReloadImage(tileMapObject.GetTexture(), scene);
+}
+
+void RuntimeTileMapObject::ChangeAndReloadImage(const gd::String& txtName,
+                                                const RuntimeScene& scene) {
+  textureName = txtName;
+  texture = scene.GetImageManager()->GetSFMLTexture(textureName);
+  for (auto& chunk : chunks) chunk.needUpdate = true;
+}
+
+int RuntimeTileMapObject::GetTile(float column, float row) const {
+  if (column < 0 || row < 0 || column >= columnsCount || row >= rowsCount)
+    return -1;
+
+  return tiles[static_cast<std::size_t>(row) * columnsCount +
+               static_cast<std::size_t>(column)];
+}
+
+void RuntimeTileMapObject::SetTile(float column, float row, float tile) {
+  if (column < 0 || row < 0 || column >= columnsCount || row >= rowsCount)
+    return;
+
+  std::size_t tileColumn = static_cast<std::size_t>(column);
+  std::size_t tileRow = static_cast<std::size_t>(row);
+  int newTile = tile < 0 ? -1 : static_cast<int>(tile);
+  int& oldTile = tiles[tileRow * columnsCount + tileColumn];
+  if (oldTile == newTile) return;
+
+  // Colliders only depend on the tiles being solid or not.
+  if ((oldTile < 0) != (newTile < 0)) {
+    collidersNeedUpdate = true;
+    hitBoxesNeedUpdate = true;
+  }
+  oldTile = newTile;
+  GetChunk(tileColumn / chunkSize, tileRow / chunkSize).needUpdate = true;
+}
+
+int RuntimeTileMapObject::GetTileAtPosition(float x, float y) const {
+  if (tileWidth <= 0 || tileHeight <= 0) return -1;
+
+  return GetTile(std::floor((x - GetX()) / tileWidth),
+                 std::floor((y - GetY()) / tileHeight));
+}
+
+std::vector<sf::IntRect> RuntimeTileMapObject::ComputeColliders(
+    const std::vector<int>& tiles,
+    std::size_t columnsCount,
+    std::size_t rowsCount) {
+  std::vector<sf::IntRect> rectangles;
+
+  // The rectangles ending on the previous row, from left to right.
+  std::vector<std::size_t> openRectangles;
+  std::vector<std::size_t> nextOpenRectangles;
+  for (std::size_t row = 0; row < rowsCount; ++row) {
+    nextOpenRectangles.clear();
+    std::size_t openRectangle = 0;
+    std::size_t column = 0;
+    while (column < columnsCount) {
+      if (tiles[row * columnsCount + column] < 0) {
+        column++;
+        continue;
+      }
+
+      int begin = column;
+      while (column < columnsCount && tiles[row * columnsCount + column] >= 0)
+        column++;
+      int width = column - begin;
+
+      // Extend the rectangle of the previous row having the same columns, if
+      // any, or start a new one.
+      while (openRectangle < openRectangles.size() &&
+             rectangles[openRectangles[openRectangle]].left < begin)
+        openRectangle++;
+      if (openRectangle < openRectangles.size() &&
+          rectangles[openRectangles[openRectangle]].left == begin &&
+          rectangles[openRectangles[openRectangle]].width == width) {
+        rectangles[openRectangles[openRectangle]].height++;
+        nextOpenRectangles.push_back(openRectangles[openRectangle]);
+        openRectangle++;
+      } else {
+        rectangles.push_back(
+            sf::IntRect(begin, static_cast<int>(row), width, 1));
+        nextOpenRectangles.push_back(rectangles.size() - 1);
+      }
+    }
+
+    openRectangles.swap(nextOpenRectangles);
+  }
+
+  return rectangles;
+}
+
+const std::vector<Polygon2d>& RuntimeTileMapObject::GetHitBoxesRef() const {
+  if (collidersNeedUpdate) {
+    colliders = ComputeColliders(tiles, columnsCount, rowsCount);
+    collidersNeedUpdate = false;
+    hitBoxesNeedUpdate = true;
+  }
+
+  if (hitBoxesNeedUpdate || hitBoxesX != GetX() || hitBoxesY != GetY()) {
+    hitBoxes.clear();
+    for (const auto& collider : colliders) {
+      Polygon2d rectangle = Polygon2d::CreateRectangle(
+          collider.width * tileWidth, collider.height * tileHeight);
+      rectangle.Move(
+          GetX() + (collider.left + collider.width / 2.0f) * tileWidth,
+          GetY() + (collider.top + collider.height / 2.0f) * tileHeight);
+      hitBoxes.push_back(rectangle);
+    }
+
+    hitBoxesNeedUpdate = false;
+    hitBoxesX = GetX();
+    hitBoxesY = GetY();
+  }
+
+  return hitBoxes;
+}
+
+std::vector<Polygon2d> RuntimeTileMapObject::GetHitBoxes() const {
+  return GetHitBoxesRef();
+}
+
+std::vector<Polygon2d> RuntimeTileMapObject::GetHitBoxes(
+    sf::FloatRect hint) const {
+  const std::vector<Polygon2d>& allHitBoxes = GetHitBoxesRef();
+
+  std::vector<Polygon2d> result;
+  for (std::size_t i = 0; i < colliders.size(); ++i) {
+    sf::FloatRect rectangle(GetX() + colliders[i].left * tileWidth,
+                            GetY() + colliders[i].top * tileHeight,
+                            colliders[i].width * tileWidth,
+                            colliders[i].height * tileHeight);
+    if (rectangle.intersects(hint)) result.push_back(allHitBoxes[i]);
+  }
+
+  return result;
+}
+
+void RuntimeTileMapObject::UpdateChunk(std::size_t chunkColumn,
+                                       std::size_t chunkRow) {
+  Chunk& chunk = GetChunk(chunkColumn, chunkRow);
+  chunk.needUpdate = false;
+  chunk.vertices.clear();
+  if (!texture || tileWidth <= 0 || tileHeight <= 0) return;
+
+  const unsigned int tilesetColumnsCount =
+      static_cast<unsigned int>(texture->texture.getSize().x / tileWidth);
+  if (tilesetColumnsCount == 0) return;
+
+  // Two triangles for each tile, positioned relatively to the object.
+  std::size_t lastRow = std::min((chunkRow + 1) * chunkSize, rowsCount);
+  std::size_t lastColumn =
+      std::min((chunkColumn + 1) * chunkSize, columnsCount);
+  for (std::size_t row = chunkRow * chunkSize; row < lastRow; ++row) {
+    for (std::size_t column = chunkColumn * chunkSize; column < lastColumn;
+         ++column) {
+      int tile = tiles[row * columnsCount + column];
+      if (tile < 0) continue;
+
+      float left = column * tileWidth;
+      float top = row * tileHeight;
+      float textureLeft = (tile % tilesetColumnsCount) * tileWidth;
+      float textureTop = (tile / tilesetColumnsCount) * tileHeight;
+
+      sf::Vertex topLeftCorner(sf::Vector2f(left, top),
+                               sf::Vector2f(textureLeft, textureTop));
+      sf::Vertex topRightCorner(
+          sf::Vector2f(left + tileWidth, top),
+          sf::Vector2f(textureLeft + tileWidth, textureTop));
+      sf::Vertex bottomRightCorner(
+          sf::Vector2f(left + tileWidth, top + tileHeight),
+          sf::Vector2f(textureLeft + tileWidth, textureTop + tileHeight));
+      sf::Vertex bottomLeftCorner(
+          sf::Vector2f(left, top + tileHeight),
+          sf::Vector2f(textureLeft, textureTop + tileHeight));
+
+      chunk.vertices.push_back(topLeftCorner);
+      chunk.vertices.push_back(topRightCorner);
+      chunk.vertices.push_back(bottomRightCorner);
+      chunk.vertices.push_back(topLeftCorner);
+      chunk.vertices.push_back(bottomRightCorner);
+      chunk.vertices.push_back(bottomLeftCorner);
+    }
+  }
+}
+
+/**
+ * Render object at runtime
+ */
+bool RuntimeTileMapObject::Draw(sf::RenderTarget& window) {
+  // Don't draw anything if hidden
+  if (hidden) return true;
+  if (!texture || chunks.empty()) return true;
+
+  // Only draw the chunks that are visible by the camera.
+  sf::FloatRect visibleArea =
+      window.getView().getInverseTransform().transformRect(
+          sf::FloatRect(-1, -1, 2, 2));
+  float chunkWidth = chunkSize * tileWidth;
+  float chunkHeight = chunkSize * tileHeight;
+  if (chunkWidth <= 0 || chunkHeight <= 0) return true;
+
+  std::size_t chunkRowsCount = chunks.size() / chunkColumnsCount;
+  float firstColumn = std::floor((visibleArea.left - GetX()) / chunkWidth);
+  float firstRow = std::floor((visibleArea.top - GetY()) / chunkHeight);
+  float lastColumn = std::floor(
+      (visibleArea.left + visibleArea.width - GetX()) / chunkWidth);
+  float lastRow = std::floor(
+      (visibleArea.top + visibleArea.height - GetY()) / chunkHeight);
+  if (lastColumn < 0 || lastRow < 0 || firstColumn >= chunkColumnsCount ||
+      firstRow >= chunkRowsCount)
+    return true;
+
+  std::size_t chunkColumnBegin = std::max(firstColumn, 0.0f);
+  std::size_t chunkRowBegin = std::max(firstRow, 0.0f);
+  std::size_t chunkColumnEnd =
+      std::min<float>(lastColumn + 1, chunkColumnsCount);
+  std::size_t chunkRowEnd = std::min<float>(lastRow + 1, chunkRowsCount);
+
+  // Moving the object only changes the transform.
+  sf::Transform transform;
+  transform.translate(GetX(), GetY());
+  sf::RenderStates states(
+      sf::BlendAlpha, transform, &texture->texture, nullptr);
+  for (std::size_t chunkRow = chunkRowBegin; chunkRow < chunkRowEnd;
+       ++chunkRow) {
+    for (std::size_t chunkColumn = chunkColumnBegin;
+         chunkColumn < chunkColumnEnd;
+         ++chunkColumn) {
+      if (GetChunk(chunkColumn, chunkRow).needUpdate)
+        UpdateChunk(chunkColumn, chunkRow);
+
+      const Chunk& chunk = GetChunk(chunkColumn, chunkRow);
+      if (!chunk.vertices.empty())
+        window.draw(
+            chunk.vertices.data(), chunk.vertices.size(), sf::Triangles, states);
+    }
+  }
+
+  return true;
+}
+
+#if defined(GD_IDE_ONLY)
+void RuntimeTileMapObject::GetPropertyForDebugger(std::size_t propertyNb,
+                                                  gd::String& name,
+                                                  gd::String& value) const {
+  if (propertyNb == 0) {
+    name = _("Columns");
+    value = gd::String::From(columnsCount);
+  } else if (propertyNb == 1) {
+    name = _("Rows");
+    value = gd::String::From(rowsCount);
+  } else if (propertyNb == 2) {
+    name = _("Colliders");
+    value = gd::String::From(GetHitBoxesRef().size());
+  }
+}
+
+bool RuntimeTileMapObject::ChangeProperty(std::size_t propertyNb,
+                                          gd::String newValue) {
+  return false;
+}
+
+std::size_t RuntimeTileMapObject::GetNumberOfProperties() const { return 3; }
+#endif
@@ -0,0 +1,200 @@
+/**
+
+GDevelop - Tile Map Extension
+Copyright (c) 2014-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef TILEMAPOBJECT_H
+#define TILEMAPOBJECT_H
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <memory>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+class SFMLTextureWrapper;
+class RuntimeScene;
+namespace gd {
+class InitialInstance;
+}
+#if defined(GD_IDE_ONLY)
+namespace gd {
+class Project;
+}
+#endif
+
+/**
+ * \brief A grid of tiles, displayed using the images of a tileset.
+ *
+ * Each tile is the index of an image of the tileset (the images being numbered
+ * from left to right, then from top to bottom), or -1 for an empty tile.
+ * Non empty tiles are solid: they are used as the hitboxes of the object.
+ */
+class GD_EXTENSION_API TileMapObject : public gd::Object {
+ public:
+  TileMapObject(gd::String name_);
+  virtual ~TileMapObject(){};
+  virtual std::unique_ptr<gd::Object> Clone() const {
+    return gd::make_unique<TileMapObject>(*this);
+  }
+
+#if defined(GD_IDE_ONLY)
+  virtual void ExposeResources(gd::ArbitraryResourceWorker &worker);
+#endif
+
+  void SetTexture(const gd::String &newTextureName) {
+    textureName = newTextureName;
+  };
+  const gd::String &GetTexture() const { return textureName; };
+
+  float GetTileWidth() const { return tileWidth; };
+  float GetTileHeight() const { return tileHeight; };
+  void SetTileWidth(float newWidth) { tileWidth = newWidth; };
+  void SetTileHeight(float newHeight) { tileHeight = newHeight; };
+
+  std::size_t GetColumnsCount() const { return columnsCount; };
+  std::size_t GetRowsCount() const { return rowsCount; };
+
+  /**
+   * \brief Change the number of columns and rows, keeping the tiles that are
+   * still in the map.
+   */
+  void SetSize(std::size_t columnsCount_, std::size_t rowsCount_);
+
+  /**
+   * \brief Return the tile at the given column and row, or -1 if the tile is
+   * empty or outside of the map.
+   */
+  int GetTile(std::size_t column, std::size_t row) const;
+  void SetTile(std::size_t column, std::size_t row, int tile);
+
+  /**
+   * \brief Return the tiles, row by row.
+   */
+  const std::vector<int> &GetTiles() const { return tiles; };
+
+ private:
+  virtual void DoUnserializeFrom(gd::Project &project,
+                                 const gd::SerializerElement &element);
+#if defined(GD_IDE_ONLY)
+  virtual void DoSerializeTo(gd::SerializerElement &element) const;
+#endif
+
+  gd::String textureName;
+  float tileWidth;
+  float tileHeight;
+  std::size_t columnsCount;
+  std::size_t rowsCount;
+  std::vector<int> tiles;  ///< The tiles, row by row.
+};
+
+class GD_EXTENSION_API RuntimeTileMapObject : public RuntimeObject {
+ public:
+  RuntimeTileMapObject(RuntimeScene &scene,
+                       const TileMapObject &tileMapObject);
+  virtual ~RuntimeTileMapObject(){};
+  virtual std::unique_ptr<RuntimeObject> Clone() const {
+    return gd::make_unique<RuntimeTileMapObject>(*this);
+  }
+
+  virtual bool CanBeRecycled() const { return false; };
+
+  virtual bool Draw(sf::RenderTarget &renderTarget);
+
+  virtual float GetWidth() const { return columnsCount * tileWidth; };
+  virtual float GetHeight() const { return rowsCount * tileHeight; };
+
+  /**
+   * \brief Tile maps can't be rotated: the angle is always 0.
+   */
+  virtual bool SetAngle(float ang) { return false; };
+  virtual float GetAngle() const { return 0; };
+
+  /**
+   * \brief Return the merged colliders of the solid tiles, as rectangles.
+   */
+  virtual std::vector<Polygon2d> GetHitBoxes() const;
+
+  /**
+   * \brief Return the colliders of the solid tiles that are intersecting with
+   * \a hint.
+   */
+  virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
+
+  /**
+   * \brief Return the colliders of the solid tiles, only computed again when
+   * a tile is changed or the object is moved.
+   */
+  virtual const std::vector<Polygon2d> &GetHitBoxesRef() const;
+
+  int GetTile(float column, float row) const;
+  void SetTile(float column, float row, float tile);
+
+  /**
+   * \brief Return the tile at the given position on the scene, or -1 if the
+   * tile is empty or outside of the map.
+   */
+  int GetTileAtPosition(float x, float y) const;
+
+  void ChangeAndReloadImage(const gd::String &texture,
+                            const RuntimeScene &scene);
+
+  /**
+   * \brief Merge the solid tiles of a map into rectangles, in tiles.
+   *
+   * Consecutive solid tiles of a row are merged, then the merged rows are
+   * merged with the ones of the next row when they have the same columns.
+   */
+  static std::vector<sf::IntRect> ComputeColliders(
+      const std::vector<int> &tiles,
+      std::size_t columnsCount,
+      std::size_t rowsCount);
+
+#if defined(GD_IDE_ONLY)
+  virtual void GetPropertyForDebugger(std::size_t propertyNb,
+                                      gd::String &name,
+                                      gd::String &value) const;
+  virtual bool ChangeProperty(std::size_t propertyNb, gd::String newValue);
+  virtual std::size_t GetNumberOfProperties() const;
+#endif
+
+  gd::String textureName;
+
+ private:
+  /**
+   * \brief The vertices of a square of tiles, drawn in a single call.
+   */
+  struct Chunk {
+    std::vector<sf::Vertex> vertices;
+    bool needUpdate;
+  };
+
+  void UpdateChunk(std::size_t chunkColumn, std::size_t chunkRow);
+  Chunk &GetChunk(std::size_t chunkColumn, std::size_t chunkRow) {
+    return chunks[chunkRow * chunkColumnsCount + chunkColumn];
+  }
+
+  float tileWidth;
+  float tileHeight;
+  std::size_t columnsCount;
+  std::size_t rowsCount;
+  std::vector<int> tiles;  ///< The tiles, row by row.
+
+  std::shared_ptr<SFMLTextureWrapper> texture;
+
+  std::size_t chunkColumnsCount;
+  std::vector<Chunk> chunks;  ///< The chunks, row by row.
+
+  mutable std::vector<sf::IntRect> colliders;  ///< See ComputeColliders.
+  mutable bool collidersNeedUpdate;
+  mutable std::vector<Polygon2d> hitBoxes;  ///< The colliders, on the scene.
+  mutable bool hitBoxesNeedUpdate;
+  mutable float hitBoxesX;  ///< The position used to compute hitBoxes.
+  mutable float hitBoxesY;
+
+  static const std::size_t chunkSize;  ///< The number of columns and rows of
+                                       ///< tiles in a chunk.
+};
+
+#endif  // TILEMAPOBJECT_H
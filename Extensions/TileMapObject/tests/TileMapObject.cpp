@@ -0,0 +1,46 @@
+/**
+
+GDevelop - Tile Map Extension
+Copyright (c) 2014-present Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Tests for the Tile Map extension.
+ */
+#define CATCH_CONFIG_MAIN
+#include "../TileMapObject.h"
+#include "catch.hpp"
+
+TEST_CASE("TileMapObject", "[game-engine][tile-map]") {
+  SECTION("Tiles are kept when the map is resized") {
+    TileMapObject object("MyTileMap");
+    object.SetTile(1, 2, 5);
+    object.SetTile(9, 9, 3);
+    object.SetSize(4, 20);
+
+    REQUIRE(object.GetColumnsCount() == 4);
+    REQUIRE(object.GetRowsCount() == 20);
+    REQUIRE(object.GetTile(1, 2) == 5);
+    REQUIRE(object.GetTile(9, 9) == -1);
+    REQUIRE(object.GetTile(0, 15) == -1);
+  }
+  SECTION("Solid tiles are merged into rectangles") {
+    // 0 0 . 1
+    // 0 0 . 1
+    // 0 0 0 .
+    std::vector<int> tiles = {0, 0, -1, 1, 0, 0, -1, 1, 0, 0, 0, -1};
+    std::vector<sf::IntRect> colliders =
+        RuntimeTileMapObject::ComputeColliders(tiles, 4, 3);
+
+    REQUIRE(colliders.size() == 3);
+    REQUIRE(colliders[0] == sf::IntRect(0, 0, 2, 2));
+    REQUIRE(colliders[1] == sf::IntRect(3, 0, 1, 2));
+    REQUIRE(colliders[2] == sf::IntRect(0, 2, 3, 1));
+  }
+  SECTION("Empty maps have no colliders") {
+    std::vector<int> tiles(12, -1);
+    REQUIRE(RuntimeTileMapObject::ComputeColliders(tiles, 4, 3).empty());
+    REQUIRE(RuntimeTileMapObject::ComputeColliders(std::vector<int>(), 0, 0)
+                .empty());
+  }
+}
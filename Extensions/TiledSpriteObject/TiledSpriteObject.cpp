@@ -44,19 +44,6 @@ void TiledSpriteObject::DoSerializeTo(gd::SerializerElement& element) const {
 }
 #endif
 
-namespace {
-sf::Vector2f RotatePoint(sf::Vector2f point, float angle) {
-  float t, cosa = cos(-angle),
-           sina = sin(-angle);  // We want a clockwise rotation
-
-  t = point.x;
-  point.x = t * cosa + point.y * sina;
-  point.y = -t * sina + point.y * cosa;
-
-  return point;
-}
-}  // namespace
-
 RuntimeTiledSpriteObject::RuntimeTiledSpriteObject(
     RuntimeScene& scene, const TiledSpriteObject& tiledSpriteObject)
     : RuntimeObject(scene, tiledSpriteObject),
@@ -64,7 +51,8 @@ RuntimeTiledSpriteObject::RuntimeTiledSpriteObject(
       height(32),
       xOffset(0),
       yOffset(),
-      angle(0) {
+      angle(0),
+      verticesNeedUpdate(true) {
   SetWidth(tiledSpriteObject.GetWidth());
   SetHeight(tiledSpriteObject.GetHeight());
 
@@ -76,37 +64,32 @@ void RuntimeTiledSpriteObject::ChangeAndReloadImage(const gd::String& txtName,
                                                     const RuntimeScene& scene) {
   textureName = txtName;
   texture = scene.GetImageManager()->GetSFMLTexture(textureName);
+  verticesNeedUpdate = true;
 }
 
-/**
- * Render object at runtime
- */
-bool RuntimeTiledSpriteObject::Draw(sf::RenderTarget& window) {
-  // Don't draw anything if hidden
-  if (hidden) return true;
-  if (!texture) return true;
+void RuntimeTiledSpriteObject::UpdateVertices() {
+  verticesNeedUpdate = false;
+  vertices.clear();
 
 #if defined(ANDROID)
+  // Textures can't be repeated: create two triangles for each tile.
   const unsigned int textureWidth = texture->texture.getSize().x;
   const unsigned int textureHeight = texture->texture.getSize().y;
-  std::vector<sf::Vertex> vertices;
-  vertices.resize((static_cast<std::size_t>(GetWidth() / textureWidth) + 1u) *
-                  (static_cast<std::size_t>(GetHeight() / textureHeight) + 1u) *
-                  6);
-  for (unsigned int i = 0;
-       i < (static_cast<std::size_t>(GetWidth() / textureWidth) + 1u);
-       i++) {
-    for (unsigned int j = 0;
-         j < (static_cast<std::size_t>(GetHeight() / textureHeight) + 1u);
-         j++) {
+  if (textureWidth == 0 || textureHeight == 0) return;
+
+  const std::size_t columnsCount =
+      static_cast<std::size_t>(GetWidth() / textureWidth) + 1u;
+  const std::size_t rowsCount =
+      static_cast<std::size_t>(GetHeight() / textureHeight) + 1u;
+  vertices.resize(columnsCount * rowsCount * 6);
+  for (unsigned int i = 0; i < columnsCount; i++) {
+    for (unsigned int j = 0; j < rowsCount; j++) {
       // Create the four vertices
       sf::Vector2f textureEndPosition(
-          (i < static_cast<std::size_t>(GetWidth() / textureWidth))
-              ? textureWidth
-              : (GetWidth() - i * textureWidth),
-          (j < static_cast<std::size_t>(GetHeight() / textureHeight))
-              ? textureHeight
-              : (GetHeight() - j * textureHeight));
+          (i < columnsCount - 1) ? textureWidth
+                                 : (GetWidth() - i * textureWidth),
+          (j < rowsCount - 1) ? textureHeight
+                              : (GetHeight() - j * textureHeight));
 
       sf::Vertex topLeftCorner(
           sf::Vector2f(i * textureWidth, j * textureHeight),
@@ -125,9 +108,7 @@ bool RuntimeTiledSpriteObject::Draw(sf::RenderTarget& window) {
           sf::Vector2f(0.f, textureEndPosition.y));
 
       // Insert them to create two triangles
-      const unsigned int firstVerticePos =
-          (j * (static_cast<std::size_t>(GetWidth() / textureWidth) + 1u) + i) *
-          6;
+      const std::size_t firstVerticePos = (j * columnsCount + i) * 6;
       vertices[firstVerticePos] = topLeftCorner;
       vertices[firstVerticePos + 1u] = topRightCorner;
       vertices[firstVerticePos + 2u] = bottomRightCorner;
@@ -136,42 +117,49 @@ bool RuntimeTiledSpriteObject::Draw(sf::RenderTarget& window) {
       vertices[firstVerticePos + 5u] = bottomLeftCorner;
     }
   }
+#else
+  // A single quad is enough, as the texture is repeated when drawn.
+  vertices.push_back(
+      sf::Vertex(sf::Vector2f(0, 0), sf::Vector2f(xOffset, yOffset)));
+  vertices.push_back(sf::Vertex(sf::Vector2f(width, 0),
+                                sf::Vector2f(width + xOffset, yOffset)));
+  vertices.push_back(sf::Vertex(sf::Vector2f(0, height),
+                                sf::Vector2f(xOffset, height + yOffset)));
+  vertices.push_back(
+      sf::Vertex(sf::Vector2f(width, height),
+                 sf::Vector2f(width + xOffset, height + yOffset)));
+#endif
+}
 
+/**
+ * Render object at runtime
+ */
+bool RuntimeTiledSpriteObject::Draw(sf::RenderTarget& window) {
+  // Don't draw anything if hidden
+  if (hidden) return true;
+  if (!texture) return true;
+
+  if (verticesNeedUpdate) UpdateVertices();
+
+  // Moving or rotating the object only changes the transform.
   sf::Transform transform;
-  transform.translate(-GetWidth() / 2.f, -GetHeight() / 2.f);
+  transform.translate(GetX() + GetCenterX(), GetY() + GetCenterY());
   transform.rotate(angle);
-  transform.translate(GetX() + GetWidth() / 2.f, GetY() + GetHeight() / 2.f);
+  transform.translate(-GetCenterX(), -GetCenterY());
 
+#if defined(ANDROID)
   window.draw(
       vertices.data(),
       vertices.size(),
       sf::Triangles,
       sf::RenderStates(sf::BlendAlpha, transform, &texture->texture, nullptr));
 #else
-  sf::Vector2f centerPosition =
-      sf::Vector2f(GetX() + GetCenterX(), GetY() + GetCenterY());
-  float angleInRad = angle * 3.14159 / 180.0;
-
   texture->texture.setRepeated(true);
-  sf::Vertex vertices[] = {
-      sf::Vertex(
-          centerPosition +
-              RotatePoint(sf::Vector2f(-width / 2, -height / 2), angleInRad),
-          sf::Vector2f(0 + xOffset, 0 + yOffset)),
-      sf::Vertex(
-          centerPosition +
-              RotatePoint(sf::Vector2f(+width / 2, -height / 2), angleInRad),
-          sf::Vector2f(width + xOffset, 0 + yOffset)),
-      sf::Vertex(
-          centerPosition +
-              RotatePoint(sf::Vector2f(-width / 2, +height / 2), angleInRad),
-          sf::Vector2f(0 + xOffset, height + yOffset)),
-      sf::Vertex(
-          centerPosition +
-              RotatePoint(sf::Vector2f(+width / 2, +height / 2), angleInRad),
-          sf::Vector2f(width + xOffset, height + yOffset))};
-
-  window.draw(vertices, 4, sf::TrianglesStrip, &texture->texture);
+  window.draw(
+      vertices.data(),
+      vertices.size(),
+      sf::TrianglesStrip,
+      sf::RenderStates(sf::BlendAlpha, transform, &texture->texture, nullptr));
   texture->texture.setRepeated(false);
 #endif
 
@@ -201,9 +189,9 @@ void RuntimeTiledSpriteObject::GetPropertyForDebugger(std::size_t propertyNb,
 bool RuntimeTiledSpriteObject::ChangeProperty(std::size_t propertyNb,
                                               gd::String newValue) {
   if (propertyNb == 0) {
-    width = newValue.To<float>();
+    SetWidth(newValue.To<float>());
   } else if (propertyNb == 1) {
-    height = newValue.To<float>();
+    SetHeight(newValue.To<float>());
   } else if (propertyNb == 2) {
     angle = newValue.To<float>();
   }
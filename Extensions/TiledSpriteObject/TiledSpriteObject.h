@@ -7,7 +7,9 @@ This project is released under the MIT License.
 */
 #ifndef TILEDSPRITEOBJECT_H
 #define TILEDSPRITEOBJECT_H
+#include <SFML/Graphics/Vertex.hpp>
 #include <memory>
+#include <vector>
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 class SFMLTextureWrapper;
@@ -72,6 +74,8 @@ class GD_EXTENSION_API RuntimeTiledSpriteObject : public RuntimeObject {
     return gd::make_unique<RuntimeTiledSpriteObject>(*this);
   }
 
+  virtual bool CanBeRecycled() const { return false; };
+
   virtual bool Draw(sf::RenderTarget &renderTarget);
 
   virtual float GetWidth() const { return width; };
@@ -83,12 +87,24 @@ class GD_EXTENSION_API RuntimeTiledSpriteObject : public RuntimeObject {
     return true;
   };
 
-  virtual void SetWidth(float newWidth) { width = newWidth; };
-  virtual void SetHeight(float newHeight) { height = newHeight; };
+  virtual void SetWidth(float newWidth) {
+    width = newWidth;
+    verticesNeedUpdate = true;
+  };
+  virtual void SetHeight(float newHeight) {
+    height = newHeight;
+    verticesNeedUpdate = true;
+  };
 
-  void SetXOffset(float xOffset_) { xOffset = xOffset_; };
+  void SetXOffset(float xOffset_) {
+    xOffset = xOffset_;
+    verticesNeedUpdate = true;
+  };
   float GetXOffset() const { return xOffset; };
-  void SetYOffset(float yOffset_) { yOffset = yOffset_; };
+  void SetYOffset(float yOffset_) {
+    yOffset = yOffset_;
+    verticesNeedUpdate = true;
+  };
   float GetYOffset() const { return yOffset; };
 
   void ChangeAndReloadImage(const gd::String &texture,
@@ -113,6 +129,16 @@ class GD_EXTENSION_API RuntimeTiledSpriteObject : public RuntimeObject {
   float yOffset;
 
   std::shared_ptr<SFMLTextureWrapper> texture;
+
+  /**
+   * \brief Compute the vertices of the object, relative to its position and
+   * without rotation: they are only computed again when the size, the offset
+   * or the texture of the object is changed.
+   */
+  void UpdateVertices();
+
+  std::vector<sf::Vertex> vertices;  ///< The vertices drawn, see UpdateVertices
+  bool verticesNeedUpdate;
 };
 
 #endif  // TILEDSPRITEOBJECT_H
@@ -17,8 +17,11 @@ This project is released under the MIT License.
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
 
 TopDownMovementRuntimeBehavior::TopDownMovementRuntimeBehavior(
@@ -51,23 +54,106 @@ TopDownMovementRuntimeBehavior::TopDownMovementRuntimeBehavior(
       behaviorContent.GetBoolAttribute("ignoreDefaultControls");
 }
 
+bool TopDownMovementRuntimeBehavior::Reset(
+    const gd::SerializerElement& behaviorContent) {
+  allowDiagonals = behaviorContent.GetBoolAttribute("allowDiagonals");
+  acceleration = behaviorContent.GetDoubleAttribute("acceleration");
+  deceleration = behaviorContent.GetDoubleAttribute("deceleration");
+  maxSpeed = behaviorContent.GetDoubleAttribute("maxSpeed");
+  angularMaxSpeed = behaviorContent.GetDoubleAttribute("angularMaxSpeed");
+  rotateObject = behaviorContent.GetBoolAttribute("rotateObject");
+  angleOffset = behaviorContent.GetDoubleAttribute("angleOffset");
+  ignoreDefaultControls =
+      behaviorContent.GetBoolAttribute("ignoreDefaultControls");
+
+  xVelocity = 0;
+  yVelocity = 0;
+  angularSpeed = 0;
+  angle = 0;
+  leftKey = false;
+  rightKey = false;
+  upKey = false;
+  downKey = false;
+  return true;
+}
+
 float TopDownMovementRuntimeBehavior::GetSpeed() const {
   return sqrt(xVelocity * xVelocity + yVelocity * yVelocity);
 }
 
+void TopDownMovementRuntimeBehavior::SaveState(
+    SceneSnapshotWriter& writer) const {
+  writer.WriteFloat(xVelocity);
+  writer.WriteFloat(yVelocity);
+  writer.WriteFloat(angularSpeed);
+  writer.WriteFloat(angle);
+}
+
+void TopDownMovementRuntimeBehavior::RestoreState(
+    SceneSnapshotReader& reader) {
+  xVelocity = reader.ReadFloat();
+  yVelocity = reader.ReadFloat();
+  angularSpeed = reader.ReadFloat();
+  angle = reader.ReadFloat();
+}
+
+namespace {
+// The unit vectors of the 8 directions, avoiding the computation of their
+// cosine and sine.
+const float halfSqrt2 = 0.70710678f;
+const float directionsX[8] = {
+    1, halfSqrt2, 0, -halfSqrt2, -1, -halfSqrt2, 0, halfSqrt2};
+const float directionsY[8] = {
+    0, halfSqrt2, 1, halfSqrt2, 0, -halfSqrt2, -1, -halfSqrt2};
+}  // namespace
+
+TopDownMovementRuntimeBehavior::DefaultControls
+TopDownMovementRuntimeBehavior::GetDefaultControls(RuntimeScene& scene) {
+  const InputManager& inputManager = scene.GetInputManager();
+  return DefaultControls{inputManager.IsKeyPressed("Left"),
+                         inputManager.IsKeyPressed("Right"),
+                         inputManager.IsKeyPressed("Up"),
+                         inputManager.IsKeyPressed("Down")};
+}
+
+void TopDownMovementRuntimeBehavior::StepAllPreEvents(
+    RuntimeScene& scene,
+    const std::vector<TopDownMovementRuntimeBehavior*>& behaviors) {
+  DefaultControls controls = GetDefaultControls(scene);
+  auto step = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      behaviors[i]->UpdateMovement(scene, controls);
+  };
+
+  // Each behavior only moves its own object (see
+  // IsPreEventsStepParallelSafe).
+  if (scene.game)
+    scene.game->GetJobSystem().ParallelFor(behaviors.size(), 64, step);
+  else
+    step(0, behaviors.size());
+}
+
 void TopDownMovementRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
+  UpdateMovement(scene, GetDefaultControls(scene));
+}
+
+void TopDownMovementRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
+  typedef RuntimeBehaviorsRegistry<TopDownMovementRuntimeBehavior> Registry;
+  scene.GetExtensionData<Registry>().AddBehavior(this);
+}
+
+void TopDownMovementRuntimeBehavior::UpdateMovement(
+    RuntimeScene& scene, const DefaultControls& controls) {
   // Get the player input:
-  leftKey |=
-      !ignoreDefaultControls && scene.GetInputManager().IsKeyPressed("Left");
-  rightKey |=
-      !ignoreDefaultControls && scene.GetInputManager().IsKeyPressed("Right");
-  downKey |=
-      !ignoreDefaultControls && scene.GetInputManager().IsKeyPressed("Down");
-  upKey |= !ignoreDefaultControls && scene.GetInputManager().IsKeyPressed("Up");
+  leftKey |= !ignoreDefaultControls && controls.left;
+  rightKey |= !ignoreDefaultControls && controls.right;
+  downKey |= !ignoreDefaultControls && controls.down;
+  upKey |= !ignoreDefaultControls && controls.up;
 
   int direction = -1;
-  float directionInRad = 0;
-  float directionInDeg = 0;
+  // The unit vector of the movement direction.
+  float directionX = 1;
+  float directionY = 0;
   if (!allowDiagonals) {
     if (upKey && !downKey)
       direction = 6;
@@ -107,27 +193,30 @@ void TopDownMovementRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   float timeDelta =
       static_cast<double>(object->GetElapsedTime(scene)) / 1000000.0;
   if (direction != -1) {
-    directionInRad = static_cast<float>(direction) * gd::Pi() / 4.0;
-    directionInDeg = static_cast<float>(direction) * 45;
+    directionX = directionsX[direction];
+    directionY = directionsY[direction];
 
-    xVelocity += acceleration * timeDelta * cos(directionInRad);
-    yVelocity += acceleration * timeDelta * sin(directionInRad);
+    xVelocity += acceleration * timeDelta * directionX;
+    yVelocity += acceleration * timeDelta * directionY;
   } else {
-    directionInRad = atan2(yVelocity, xVelocity);
-    directionInDeg = atan2(yVelocity, xVelocity) * 180.0 / gd::Pi();
+    float speed = sqrt(xVelocity * xVelocity + yVelocity * yVelocity);
+    if (speed != 0) {
+      directionX = xVelocity / speed;
+      directionY = yVelocity / speed;
+    }
 
     bool xVelocityWasPositive = xVelocity >= 0;
     bool yVelocityWasPositive = yVelocity >= 0;
-    xVelocity -= deceleration * timeDelta * cos(directionInRad);
-    yVelocity -= deceleration * timeDelta * sin(directionInRad);
+    xVelocity -= deceleration * timeDelta * directionX;
+    yVelocity -= deceleration * timeDelta * directionY;
     if ((xVelocity > 0) ^ xVelocityWasPositive) xVelocity = 0;
     if ((yVelocity > 0) ^ yVelocityWasPositive) yVelocity = 0;
   }
 
   float speed = sqrt(xVelocity * xVelocity + yVelocity * yVelocity);
   if (speed > maxSpeed) {
-    xVelocity = maxSpeed * cos(directionInRad);
-    yVelocity = maxSpeed * sin(directionInRad);
+    xVelocity = maxSpeed * directionX;
+    yVelocity = maxSpeed * directionY;
   }
   angularSpeed = angularMaxSpeed;  // No acceleration for angular speed for now
 
@@ -137,6 +226,9 @@ void TopDownMovementRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
 
   // Also update angle if needed
   if ((xVelocity != 0 || yVelocity != 0)) {
+    float directionInDeg =
+        direction != -1 ? static_cast<float>(direction) * 45
+                        : atan2(directionY, directionX) * 180.0 / gd::Pi();
     angle = directionInDeg;
 
     if (rotateObject) {
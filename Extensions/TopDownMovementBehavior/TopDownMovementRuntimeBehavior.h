@@ -26,6 +26,28 @@ class GD_EXTENSION_API TopDownMovementRuntimeBehavior : public RuntimeBehavior {
   virtual TopDownMovementRuntimeBehavior* Clone() const {
     return new TopDownMovementRuntimeBehavior(*this);
   }
+  virtual bool Reset(const gd::SerializerElement& behaviorContent);
+
+  /**
+   * \brief The movement only reads the input and moves the object.
+   */
+  virtual bool IsPreEventsStepParallelSafe() const { return true; }
+
+  /**
+   * \brief Move the objects of all the behaviors of the scene, on the
+   * threads of the game.
+   *
+   * The default controls are read once for all the behaviors.
+   */
+  static void StepAllPreEvents(
+      RuntimeScene& scene,
+      const std::vector<TopDownMovementRuntimeBehavior*>& behaviors);
+
+  /**
+   * \brief Save the velocity and the angle of the movement.
+   */
+  virtual void SaveState(SceneSnapshotWriter& writer) const;
+  virtual void RestoreState(SceneSnapshotReader& reader);
 
   // Configuration:
   bool DiagonalsAllowed() const { return allowDiagonals; };
@@ -64,8 +86,35 @@ class GD_EXTENSION_API TopDownMovementRuntimeBehavior : public RuntimeBehavior {
   void SimulateDownKey() { downKey = true; };
 
  private:
+  /**
+   * \brief The state of the default controls.
+   */
+  struct DefaultControls {
+    bool left;
+    bool right;
+    bool up;
+    bool down;
+  };
+  static DefaultControls GetDefaultControls(RuntimeScene& scene);
+
+  /**
+   * \brief Move the object (only used until the behavior is registered, see
+   * StepAllPreEvents).
+   */
   virtual void DoStepPreEvents(RuntimeScene& scene);
 
+  /**
+   * \brief Register the behavior in the registry of the scene, so that it is
+   * stepped with the other behaviors (see StepAllPreEvents).
+   */
+  virtual void DoStepPostEvents(RuntimeScene& scene);
+
+  /**
+   * \brief Update the speed of the behavior and move the object, for the
+   * given pressed keys.
+   */
+  void UpdateMovement(RuntimeScene& scene, const DefaultControls& controls);
+
   // Behavior configuration:
   bool allowDiagonals;
   float acceleration;
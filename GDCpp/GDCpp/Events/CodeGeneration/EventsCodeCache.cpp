@@ -0,0 +1,48 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if defined(GD_IDE_ONLY)
+#include "GDCpp/Events/CodeGeneration/EventsCodeCache.h"
+#include <cstdint>
+#include <sstream>
+#include "GDCore/IDE/AbstractFileSystem.h"
+
+EventsCodeCache::EventsCodeCache(gd::AbstractFileSystem& fs_,
+                                 const gd::String& cacheDirectory_)
+    : fs(fs_), cacheDirectory(cacheDirectory_) {
+  if (!fs.DirExists(cacheDirectory)) fs.MkDir(cacheDirectory);
+}
+
+gd::String EventsCodeCache::GetCodeHash(const gd::String& code) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char byte : code.Raw()) {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream os;
+  os << std::hex << hash;
+  return gd::String::FromUTF8(os.str());
+}
+
+gd::String EventsCodeCache::GetSourceFile(const gd::String& code) const {
+  return cacheDirectory + "/" + GetCodeHash(code) + ".cpp";
+}
+
+gd::String EventsCodeCache::GetObjectFile(const gd::String& code) const {
+  return cacheDirectory + "/" + GetCodeHash(code) + ".o";
+}
+
+bool EventsCodeCache::WriteSourceFile(const gd::String& code) {
+  gd::String sourceFile = GetSourceFile(code);
+  if (fs.FileExists(sourceFile)) return true;
+
+  return fs.WriteToFile(sourceFile, code);
+}
+
+bool EventsCodeCache::HasObjectFile(const gd::String& code) {
+  return fs.FileExists(GetObjectFile(code));
+}
+#endif
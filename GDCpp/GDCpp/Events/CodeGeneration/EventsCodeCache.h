@@ -0,0 +1,82 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#if defined(GD_IDE_ONLY)
+
+#ifndef GDCPP_EVENTSCODECACHE_H
+#define GDCPP_EVENTSCODECACHE_H
+#include "GDCore/String.h"
+namespace gd {
+class AbstractFileSystem;
+}  // namespace gd
+
+/**
+ * \brief Store the C++ code generated for the events in a directory, in files
+ * named after the hash of the code, so that only the code that changed is
+ * compiled again.
+ *
+ * The code of each scene and of each external events compiled separately (see
+ * EventsCodeGenerator) is a compilation unit. For each of them, a build
+ * calls WriteSourceFile, compiles the source file into GetObjectFile if
+ * HasObjectFile is false, then links all the object files in the library
+ * loaded by CodeExecutionEngine. The code of a layout that did not change has
+ * the same hash, so its object file is reused without compiling it again.
+ *
+ * The generated code starts by including
+ * GDCpp/Runtime/EventsPrecompiledHeader.h: the build should precompile this
+ * header once (for example into EventsPrecompiledHeader.h.gch next to it for
+ * GCC and Clang) so that it's not parsed again for each compilation unit.
+ *
+ * \note The hash is only computed from the generated code: the directory must
+ * be cleared when the headers of GDCpp or the compilation options change.
+ */
+class GD_API EventsCodeCache {
+ public:
+  /**
+   * \brief Construct a cache storing its files in \a cacheDirectory, which is
+   * created if it does not exist.
+   */
+  EventsCodeCache(gd::AbstractFileSystem& fs,
+                  const gd::String& cacheDirectory);
+
+  /**
+   * \brief Return the hash (64 bits FNV-1a) of the code, as an hexadecimal
+   * string.
+   */
+  static gd::String GetCodeHash(const gd::String& code);
+
+  /**
+   * \brief Return the source file storing the code.
+   */
+  gd::String GetSourceFile(const gd::String& code) const;
+
+  /**
+   * \brief Return the object file in which the source file of the code must be
+   * compiled.
+   */
+  gd::String GetObjectFile(const gd::String& code) const;
+
+  /**
+   * \brief Write the source file of the code if it does not exist yet.
+   *
+   * An existing source file is never written again, so that its modification
+   * time does not change and an incremental build does not compile it again.
+   *
+   * \return true if the source file exists.
+   */
+  bool WriteSourceFile(const gd::String& code);
+
+  /**
+   * \brief Return true if the code was already compiled.
+   */
+  bool HasObjectFile(const gd::String& code);
+
+ private:
+  gd::AbstractFileSystem& fs;
+  gd::String cacheDirectory;
+};
+
+#endif  // GDCPP_EVENTSCODECACHE_H
+#endif
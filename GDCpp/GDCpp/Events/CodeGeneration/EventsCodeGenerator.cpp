@@ -24,6 +24,38 @@
 
 using namespace std;
 
+namespace {
+/**
+ * Return true if the getter of the object property is inline and not
+ * virtual, so that objects cannot redefine it.
+ */
+bool IsNonVirtualPropertyGetter(const gd::String& className,
+                                const gd::String& functionName) {
+  if (className.empty())
+    return functionName == "GetX" || functionName == "GetY" ||
+           functionName == "GetZOrder";
+  if (className == "RuntimeSpriteObject") return functionName == "GetOpacity";
+
+  return false;
+}
+
+/**
+ * Return true if the code of an expression is a number made only of literals,
+ * so that it can be evaluated once for all the objects.
+ */
+bool IsConstantNumberCode(const gd::String& code) {
+  if (code.empty()) return false;
+  for (char32_t c : code) {
+    if ((c < U'0' || c > U'9') && c != U'.' && c != U'+' && c != U'-' &&
+        c != U'*' && c != U'/' && c != U'(' && c != U')' && c != U'e' &&
+        c != U'E' && c != U' ')
+      return false;
+  }
+
+  return true;
+}
+}  // namespace
+
 gd::String EventsCodeGenerator::GenerateObjectFunctionCall(
     gd::String objectListName,
     const gd::ObjectMetadata& objMetadata,
@@ -82,28 +114,25 @@ gd::String EventsCodeGenerator::GenerateObjectBehaviorFunctionCall(
   } else if (context.GetCurrentObject() == objectListName &&
              !context.GetCurrentObject().empty()) {
     if (!castNeeded)
-      return "(" + ManObjListName(objectListName) +
-             "[i]->GetBehaviorRawPointer(" +
-             GenerateGetBehaviorNameCode(behaviorName) + ")->" +
+      return "(" + ManObjListName(objectListName) + "[i]->" +
+             GenerateGetBehaviorRawPointerCode(behaviorName) + "->" +
              codeInfo.functionCallName + "(" + parametersStr + "))";
     else
       return "(static_cast<" + autoInfo.className + "*>(" +
-             ManObjListName(objectListName) + "[i]->GetBehaviorRawPointer(\"" +
-             behaviorName + "\"))->" + codeInfo.functionCallName + "(" +
-             parametersStr + "))";
+             ManObjListName(objectListName) + "[i]->" +
+             GenerateGetBehaviorRawPointerCode(behaviorName) + ")->" +
+             codeInfo.functionCallName + "(" + parametersStr + "))";
   } else {
     if (!castNeeded)
       return "(( " + ManObjListName(objectListName) + ".empty() ) ? " +
              defaultOutput + " :" + ManObjListName(objectListName) +
-             "[0]->GetBehaviorRawPointer(" +
-             GenerateGetBehaviorNameCode(behaviorName) + ")->" +
+             "[0]->" + GenerateGetBehaviorRawPointerCode(behaviorName) + "->" +
              codeInfo.functionCallName + "(" + parametersStr + "))";
     else
       return "(( " + ManObjListName(objectListName) + ".empty() ) ? " +
              defaultOutput + " : " + "static_cast<" + autoInfo.className +
              "*>(" + ManObjListName(objectListName) +
-             "[0]->GetBehaviorRawPointer(" +
-             GenerateGetBehaviorNameCode(behaviorName) + "))->" +
+             "[0]->" + GenerateGetBehaviorRawPointerCode(behaviorName) + ")->" +
              codeInfo.functionCallName + "(" + parametersStr + "))";
   }
 }
@@ -116,7 +145,14 @@ gd::String EventsCodeGenerator::GenerateObjectCondition(
     const gd::String& returnBoolean,
     bool conditionInverted,
     gd::EventsCodeGenerationContext& context) {
-  gd::String conditionCode;
+  gd::String conditionCode =
+      GenerateObjectPropertyComparison(objectName,
+                                       objInfo,
+                                       arguments,
+                                       instrInfos,
+                                       returnBoolean,
+                                       conditionInverted);
+  if (!conditionCode.empty()) return conditionCode;
 
   // Prepare call
   // Add a static_cast if necessary
@@ -159,6 +195,59 @@ gd::String EventsCodeGenerator::GenerateObjectCondition(
   return conditionCode;
 }
 
+gd::String EventsCodeGenerator::GenerateObjectPropertyComparison(
+    const gd::String& objectName,
+    const gd::ObjectMetadata& objInfo,
+    const std::vector<gd::String>& arguments,
+    const gd::InstructionMetadata& instrInfos,
+    const gd::String& returnBoolean,
+    bool conditionInverted) {
+  // Only conditions with the object, the operator and the value are handled.
+  if (instrInfos.codeExtraInformation.type != "number" ||
+      instrInfos.parameters.size() != 3 || arguments.size() != 3 ||
+      instrInfos.parameters[1].type != "relationalOperator")
+    return "";
+
+  const gd::String& functionName =
+      instrInfos.codeExtraInformation.functionCallName;
+  gd::String className =
+      instrInfos.parameters[0].supplementaryInformation.empty()
+          ? ""
+          : objInfo.className;
+  if (!IsNonVirtualPropertyGetter(className, functionName) ||
+      !IsConstantNumberCode(arguments[2]))
+    return "";
+
+  gd::String relationalOperator;
+  if (arguments[1] == "\"==\"")
+    relationalOperator = "RelationalOperator::Equal";
+  else if (arguments[1] == "\"!=\"")
+    relationalOperator = "RelationalOperator::NotEqual";
+  else if (arguments[1] == "\"<\"")
+    relationalOperator = "RelationalOperator::Less";
+  else if (arguments[1] == "\"<=\"")
+    relationalOperator = "RelationalOperator::LessOrEqual";
+  else if (arguments[1] == "\">\"")
+    relationalOperator = "RelationalOperator::Greater";
+  else if (arguments[1] == "\">=\"")
+    relationalOperator = "RelationalOperator::GreaterOrEqual";
+  else
+    return "";
+
+  AddIncludeFile("GDCpp/Runtime/RuntimeObjectsListsTools.h");
+  gd::String getter =
+      className.empty()
+          ? "object->" + functionName + "()"
+          : "static_cast<" + className + "*>(object)->" + functionName + "()";
+
+  return "if (PickObjectsByComparison(*runtimeContext->scene, " +
+         ManObjListName(objectName) +
+         ", [](RuntimeObject* object) { return " + getter + "; }, " +
+         relationalOperator + ", " + arguments[2] + ", " +
+         (conditionInverted ? "true" : "false") + "))\n" + "    " +
+         returnBoolean + " = true;\n";
+}
+
 gd::String EventsCodeGenerator::GenerateBehaviorCondition(
     const gd::String& objectName,
     const gd::String& behaviorName,
@@ -175,11 +264,11 @@ gd::String EventsCodeGenerator::GenerateBehaviorCondition(
   gd::String objectFunctionCallNamePart =
       (!instrInfos.parameters[1].supplementaryInformation.empty())
           ? "static_cast<" + autoInfo.className + "*>(" +
-                ManObjListName(objectName) + "[i]->GetBehaviorRawPointer(" +
-                GenerateGetBehaviorNameCode(behaviorName) + "))->" +
+                ManObjListName(objectName) + "[i]->" +
+                GenerateGetBehaviorRawPointerCode(behaviorName) + ")->" +
                 instrInfos.codeExtraInformation.functionCallName
-          : ManObjListName(objectName) + "[i]->GetBehaviorRawPointer(" +
-                GenerateGetBehaviorNameCode(behaviorName) + ")->" +
+          : ManObjListName(objectName) + "[i]->" +
+                GenerateGetBehaviorRawPointerCode(behaviorName) + "->" +
                 instrInfos.codeExtraInformation.functionCallName;
 
   // Create call
@@ -251,6 +340,9 @@ gd::String EventsCodeGenerator::GenerateObjectAction(
           objectPart +
               instrInfos.codeExtraInformation.optionalAssociatedInstruction,
           1);
+    else if (instrInfos.codeExtraInformation.accessType ==
+             gd::InstructionMetadata::ExtraInformation::SettersAndGetters)
+      call = GenerateSettersCall(instrInfos, arguments, objectPart, 1);
     else if (instrInfos.codeExtraInformation.accessType ==
              gd::InstructionMetadata::ExtraInformation::Mutators)
       call = GenerateMutatorCall(
@@ -292,10 +384,10 @@ gd::String EventsCodeGenerator::GenerateBehaviorAction(
   gd::String objectPart =
       (!instrInfos.parameters[1].supplementaryInformation.empty())
           ? "static_cast<" + autoInfo.className + "*>(" +
-                ManObjListName(objectName) + "[i]->GetBehaviorRawPointer(" +
-                GenerateGetBehaviorNameCode(behaviorName) + "))->"
-          : ManObjListName(objectName) + "[i]->GetBehaviorRawPointer(" +
-                GenerateGetBehaviorNameCode(behaviorName) + ")->";
+                ManObjListName(objectName) + "[i]->" +
+                GenerateGetBehaviorRawPointerCode(behaviorName) + ")->"
+          : ManObjListName(objectName) + "[i]->" +
+                GenerateGetBehaviorRawPointerCode(behaviorName) + "->";
 
   // Create call
   gd::String call;
@@ -310,6 +402,9 @@ gd::String EventsCodeGenerator::GenerateBehaviorAction(
           objectPart +
               instrInfos.codeExtraInformation.optionalAssociatedInstruction,
           2);
+    else if (instrInfos.codeExtraInformation.accessType ==
+             gd::InstructionMetadata::ExtraInformation::SettersAndGetters)
+      call = GenerateSettersCall(instrInfos, arguments, objectPart, 2);
     else if (instrInfos.codeExtraInformation.accessType ==
              gd::InstructionMetadata::ExtraInformation::Mutators)
       call = GenerateMutatorCall(
@@ -374,7 +469,12 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
 gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
     const gd::String& behaviorName) {
   if (HasProjectAndLayout()) {
-    return ConvertToStringExplicit(behaviorName);
+    // The name is interned once, when the code is loaded, so that behaviors
+    // are found by comparing pointers.
+    gd::String internedName = ManObjListName(behaviorName) + "BehaviorName";
+    AddGlobalDeclaration("static const InternedString " + internedName + "(" +
+                         ConvertToStringExplicit(behaviorName) + ");");
+    return internedName;
   } else {
     // No support for events function in C++ generated code.
     // See GDJS for an example of proper implementation.
@@ -382,6 +482,39 @@ gd::String EventsCodeGenerator::GenerateGetBehaviorNameCode(
   }
 }
 
+gd::String EventsCodeGenerator::GenerateGetBehaviorRawPointerCode(
+    const gd::String& behaviorName) {
+  if (!HasProjectAndLayout())
+    return "GetBehaviorRawPointer(" +
+           GenerateGetBehaviorNameCode(behaviorName) + ")";
+
+  gd::String behaviorIdName = ManObjListName(behaviorName) + "BehaviorId";
+  AddGlobalDeclaration("static const std::size_t " + behaviorIdName +
+                       " = RuntimeContext::GetBehaviorId(" +
+                       ConvertToStringExplicit(behaviorName) + ");");
+  return "GetBehaviorRawPointerById(" + behaviorIdName + ")";
+}
+
+gd::String EventsCodeGenerator::GenerateExpressionTemporary(
+    const gd::String& type) {
+  return "expressionTemporary" + gd::String::From(expressionTemporariesCount++);
+}
+
+gd::String EventsCodeGenerator::GenerateExpressionWithTemporaries(
+    const gd::String& type,
+    const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+    const gd::String& expressionCode) {
+  // The temporaries are local to a lambda called immediately, so that the
+  // code stays an expression and can be run by several threads.
+  gd::String code = "[&]() -> " +
+                    gd::String(type == "string" ? "gd::String" : "double") +
+                    " {\n";
+  for (const auto& temporary : temporaries)
+    code += "const auto " + temporary.first + " = " + temporary.second + ";\n";
+
+  return code + "return " + expressionCode + ";\n}()";
+}
+
 gd::String EventsCodeGenerator::GenerateObject(
     const gd::String& objectName,
     const gd::String& type,
@@ -497,6 +630,30 @@ gd::String EventsCodeGenerator::GenerateGetVariable(
   return output;
 }
 
+gd::String EventsCodeGenerator::GenerateVariableChildrenAccessor(
+    const gd::String& variableCode,
+    const std::vector<gd::String>& childrenNames,
+    const VariableScope& scope) {
+  // Object variables are different for each object: a path would be resolved
+  // again for each object, so children are searched as usual.
+  if (scope == OBJECT_VARIABLE)
+    return gd::EventsCodeGenerator::GenerateVariableChildrenAccessor(
+        variableCode, childrenNames, scope);
+
+  gd::String childrenNamesCode;
+  for (auto& childName : childrenNames) {
+    if (!childrenNamesCode.empty()) childrenNamesCode += ", ";
+    childrenNamesCode += ConvertToStringExplicit(childName);
+  }
+
+  gd::String pathName =
+      "variablePath" + gd::String::From(variablePathsCount++);
+  AddIncludeFile("GDCpp/Runtime/CachedVariablePath.h");
+  AddGlobalDeclaration("static CachedVariablePath " + pathName + "({" +
+                       childrenNamesCode + "});");
+  return pathName + ".Get(" + variableCode + ")";
+}
+
 gd::String EventsCodeGenerator::GenerateSceneEventsCompleteCode(
     gd::Project& project,
     gd::Layout& scene,
@@ -519,13 +676,8 @@ gd::String EventsCodeGenerator::GenerateSceneEventsCompleteCode(
       codeGenerator.GenerateEventsListCode(generatedEvents, context);
 
   // Generate default code around events:
-  // Includes
-  output +=
-      "#include <vector>\n#include <map>\n#include <string>\n#include "
-      "<algorithm>\n#include <SFML/System/Clock.hpp>\n#include "
-      "<SFML/System/Vector2.hpp>\n#include <SFML/Graphics/Color.hpp>\n#include "
-      "\"GDCpp/Runtime/RuntimeContext.h\"\n#include "
-      "\"GDCpp/Runtime/RuntimeObject.h\"\n";
+  // Includes (the common ones first, so that they can be precompiled)
+  output += "#include \"GDCpp/Runtime/EventsPrecompiledHeader.h\"\n";
   for (set<gd::String>::iterator include =
            codeGenerator.GetIncludeFiles().begin();
        include != codeGenerator.GetIncludeFiles().end();
@@ -582,13 +734,8 @@ gd::String EventsCodeGenerator::GenerateExternalEventsCompleteCode(
       codeGenerator.GenerateEventsListCode(events.GetEvents(), context);
 
   // Generate default code around events:
-  // Includes
-  output +=
-      "#include <vector>\n#include <map>\n#include <string>\n#include "
-      "<algorithm>\n#include <SFML/System/Clock.hpp>\n#include "
-      "<SFML/System/Vector2.hpp>\n#include <SFML/Graphics/Color.hpp>\n#include "
-      "\"GDCpp/Runtime/RuntimeContext.h\"\n#include "
-      "\"GDCpp/Runtime/RuntimeObject.h\"\n";
+  // Includes (the common ones first, so that they can be precompiled)
+  output += "#include \"GDCpp/Runtime/EventsPrecompiledHeader.h\"\n";
   for (set<gd::String>::iterator include =
            codeGenerator.GetIncludeFiles().begin();
        include != codeGenerator.GetIncludeFiles().end();
@@ -618,7 +765,9 @@ gd::String EventsCodeGenerator::GenerateExternalEventsCompleteCode(
 
 EventsCodeGenerator::EventsCodeGenerator(gd::Project& project,
                                          const gd::Layout& layout)
-    : gd::EventsCodeGenerator(project, layout, CppPlatform::Get()) {}
+    : gd::EventsCodeGenerator(project, layout, CppPlatform::Get()),
+      expressionTemporariesCount(0),
+      variablePathsCount(0) {}
 
 EventsCodeGenerator::~EventsCodeGenerator() {}
 
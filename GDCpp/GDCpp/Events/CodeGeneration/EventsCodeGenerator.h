@@ -144,23 +144,70 @@ class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator {
     return ".GetChild(" + expressionCode + ")";
   };
 
+  /**
+   * \brief Generate the code to get a child of a scene or global variable
+   * using a CachedVariablePath, resolving the path only when the structure of
+   * the variables changed.
+   */
+  virtual gd::String GenerateVariableChildrenAccessor(
+      const gd::String& variableCode,
+      const std::vector<gd::String>& childrenNames,
+      const VariableScope& scope);
+
   virtual gd::String GenerateBadVariable() {
     return "runtimeContext->GetGameVariables().GetBadVariable()";
   }
 
   virtual gd::String GenerateBadObject() { return "NULL"; }
 
+  virtual gd::String GenerateExpressionTemporary(const gd::String& type);
+
+  virtual gd::String GenerateExpressionWithTemporaries(
+      const gd::String& type,
+      const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+      const gd::String& expressionCode);
+
   virtual gd::String GenerateObject(const gd::String& objectName,
                                     const gd::String& type,
                                     gd::EventsCodeGenerationContext& context);
 
   virtual gd::String GenerateGetBehaviorNameCode(const gd::String& behaviorName);
 
+  /**
+   * \brief Generate the call getting the behavior with the specified name
+   * from an object (the code to access the object must be put before).
+   *
+   * The identifier of the behavior is resolved once, when the code is loaded.
+   */
+  gd::String GenerateGetBehaviorRawPointerCode(const gd::String& behaviorName);
+
   /**
    * \brief Construct a code generator for the specified project and layout.
    */
   EventsCodeGenerator(gd::Project& project, const gd::Layout& layout);
   virtual ~EventsCodeGenerator();
+
+ private:
+  /**
+   * \brief Generate the code of a condition comparing a property of the
+   * objects with a constant value, done on the whole list at once (see
+   * PickObjectsByComparison).
+   *
+   * \return The code of the condition, or an empty string if the condition is
+   * not comparing a property read without a virtual call with a constant.
+   */
+  gd::String GenerateObjectPropertyComparison(
+      const gd::String& objectName,
+      const gd::ObjectMetadata& objInfo,
+      const std::vector<gd::String>& arguments,
+      const gd::InstructionMetadata& instrInfos,
+      const gd::String& returnBoolean,
+      bool conditionInverted);
+
+  std::size_t expressionTemporariesCount;  ///< The number of temporaries
+                                           ///< declared for expressions.
+  std::size_t variablePathsCount;  ///< The number of CachedVariablePath
+                                   ///< declared for variables.
 };
 
 #endif  // EventsCodeGenerator_H
@@ -88,6 +88,9 @@ AudioExtension::AudioExtension() {
   GetAllActions()["PlayMusic"]
       .SetFunctionName("PlayMusic")
       .SetIncludeFile("GDCpp/Extensions/Builtin/AudioTools.h");
+  GetAllActions()["PrefetchMusic"]
+      .SetFunctionName("PrefetchMusic")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/AudioTools.h");
 
   GetAllConditions()["MusicPlaying"]
       .SetFunctionName("MusicPlaying")
@@ -164,7 +167,8 @@ AudioExtension::AudioExtension() {
 void AudioExtension::ExposeActionsResources(
     gd::Instruction& action, gd::ArbitraryResourceWorker& worker) {
   if (action.GetType() == "PlaySound" || action.GetType() == "PlaySoundCanal" ||
-      action.GetType() == "PlayMusic" || action.GetType() == "PlayMusicCanal") {
+      action.GetType() == "PlayMusic" || action.GetType() == "PlayMusicCanal" ||
+      action.GetType() == "PrefetchMusic") {
     gd::String parameter = action.GetParameter(1).GetPlainString();
     worker.ExposeAudio(parameter);
     action.SetParameter(1, parameter);
@@ -148,6 +148,10 @@ void GD_API PlayMusic(RuntimeScene& scene,
   scene.game->GetSoundManager().PlayMusic(file, repeat, volume, pitch);
 }
 
+void GD_API PrefetchMusic(RuntimeScene& scene, const gd::String& file) {
+  scene.game->GetSoundManager().PrefetchMusic(file);
+}
+
 void GD_API PlayMusicOnChannel(RuntimeScene& scene,
                                const gd::String& file,
                                unsigned int channel,
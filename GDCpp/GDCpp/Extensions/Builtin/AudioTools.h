@@ -36,6 +36,7 @@ void GD_API PlayMusic(RuntimeScene& scene,
                       bool repeat,
                       float volume,
                       float pitch);
+void GD_API PrefetchMusic(RuntimeScene& scene, const gd::String& file);
 void GD_API PlayMusicOnChannel(RuntimeScene& scene,
                                const gd::String& file,
                                unsigned int channel,
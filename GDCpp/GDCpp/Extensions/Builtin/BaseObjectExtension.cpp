@@ -33,7 +33,9 @@ BaseObjectExtension::BaseObjectExtension() {
       .SetFunctionName("SetY")
       .SetManipulatedType("number")
       .SetGetter("GetY");
-  objectActions["MettreXY"].SetFunctionName("SetXY");
+  objectActions["MettreXY"]
+      .SetManipulatedType("number")
+      .SetSettersAndGetters({{"SetX", "GetX"}, {"SetY", "GetY"}});
   objectConditions["Angle"].SetFunctionName("GetAngle");
 
   objectActions["SetAngle"]
@@ -155,9 +157,15 @@ BaseObjectExtension::BaseObjectExtension() {
       .SetIncludeFile("GDCpp/Extensions/Builtin/RuntimeSceneTools.h");
 
   GetAllConditions()["SeDirige"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("MovesToward")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["Distance"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("DistanceBetweenObjects")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["AjoutObjConcern"]
@@ -177,12 +185,21 @@ BaseObjectExtension::BaseObjectExtension() {
       .SetFunctionName("HitBoxesCollision")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["EstTourne"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("ObjectsTurnedToward")
       .SetIncludeFile("GDCpp/Extensions/Builtin/ObjectTools.h");
   GetAllConditions()["Raycast"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("RaycastObject")
       .SetIncludeFile("GDCpp/Extensions/Builtin/RuntimeSceneTools.h");
   GetAllConditions()["RaycastToPosition"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("RaycastObjectToPosition")
       .SetIncludeFile("GDCpp/Extensions/Builtin/RuntimeSceneTools.h");
 
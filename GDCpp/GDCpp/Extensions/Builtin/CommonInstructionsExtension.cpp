@@ -121,8 +121,9 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
               // be filled with objects by conditions, but they will have no
               // incidence on further conditions, as conditions use "normal"
               // ones.
-              declarationsCode += "std::vector<RuntimeObject*> " +
-                                  ManObjListName(*it) + "final;\n";
+              declarationsCode +=
+                  codeGenerator.GenerateFrameObjectsListDeclaration(
+                      ManObjListName(*it) + "final");
             }
             for (std::size_t i = 0; i < conditions.size(); ++i)
               declarationsCode +=
@@ -153,8 +154,8 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
              gd::EventsCodeGenerationContext& parentContext) {
             gd::String outputCode;
 
-            outputCode += codeGenerator.GenerateConditionsListCode(
-                instruction.GetSubInstructions(), parentContext);
+            codeGenerator.AppendConditionsListCode(
+                instruction.GetSubInstructions(), parentContext, outputCode);
 
             gd::String ifPredicat = "true";
             for (std::size_t i = 0; i < instruction.GetSubInstructions().size();
@@ -241,8 +242,8 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         if (event.HasSubEvents())  // Sub events
         {
           actionsCode += "\n{ //Subevents\n";
-          actionsCode += codeGenerator.GenerateEventsListCode(
-              event.GetSubEvents(), actionsContext);
+          codeGenerator.AppendEventsListCode(
+              event.GetSubEvents(), actionsContext, actionsCode);
           actionsCode += "} //End of subevents\n";
         }
         gd::String actionsDeclarationsCode =
@@ -348,17 +349,30 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
           whileIfPredicat += " && condition" + gd::String::From(i) + "IsTrue";
         gd::String conditionsCode = codeGenerator.GenerateConditionsListCode(
             event.GetConditions(), context);
+        std::set<gd::String> pickedObjects =
+            codeGenerator.GetObjectsPickedInLoop(
+                context.GetAllObjectsToBeDeclared(),
+                event.GetActions(),
+                context);
         gd::String actionsCode =
             codeGenerator.GenerateActionsListCode(event.GetActions(), context);
         gd::String ifPredicat = "true";
         for (std::size_t i = 0; i < event.GetConditions().size(); ++i)
           ifPredicat += " && condition" + gd::String::From(i) + "IsTrue";
 
+        // The objects lists are declared once, and only the ones picked by
+        // the conditions or the actions are filled again at each iteration.
+        gd::String refillCode;
+        gd::String objectDeclaration =
+            codeGenerator.GenerateLoopObjectsDeclarationCode(
+                context, pickedObjects, refillCode);
+
         // Write final code
+        outputCode += objectDeclaration;
         outputCode += "bool stopDoWhile = false;";
         outputCode += "do";
         outputCode += "{\n";
-        outputCode += codeGenerator.GenerateObjectsDeclarationCode(context);
+        outputCode += refillCode;
         outputCode += whileConditionsStr;
         outputCode += "if (" + whileIfPredicat + ")\n";
         outputCode += "{\n";
@@ -401,25 +415,36 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         // Prepare conditions/actions codes
         gd::String conditionsCode = codeGenerator.GenerateConditionsListCode(
             event.GetConditions(), context);
+        std::set<gd::String> pickedObjects =
+            codeGenerator.GetObjectsPickedInLoop(
+                context.GetAllObjectsToBeDeclared(),
+                event.GetActions(),
+                context);
         gd::String actionsCode =
             codeGenerator.GenerateActionsListCode(event.GetActions(), context);
         gd::String ifPredicat = "true";
         for (std::size_t i = 0; i < event.GetConditions().size(); ++i)
           ifPredicat += " && condition" + gd::String::From(i) + "IsTrue";
 
-        // Prepare object declaration and sub events
+        // Prepare object declaration and sub events. The objects lists are
+        // declared once, and only the ones picked by the conditions or the
+        // actions are filled again at each iteration.
         gd::String subevents =
             codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+        gd::String refillCode;
         gd::String objectDeclaration =
-            codeGenerator.GenerateObjectsDeclarationCode(context) + "\n";
+            codeGenerator.GenerateLoopObjectsDeclarationCode(
+                context, pickedObjects, refillCode) +
+            "\n";
 
         // Write final code
         outputCode += "int repeatCount = " + repeatCountCode + ";\n";
+        outputCode += objectDeclaration;
         outputCode +=
             "for(std::size_t repeatIndex = 0;repeatIndex < "
             "repeatCount;++repeatIndex)\n";
         outputCode += "{\n";
-        outputCode += objectDeclaration;
+        outputCode += refillCode;
         outputCode += conditionsCode;
         outputCode += "if (" + ifPredicat + ")\n";
         outputCode += "{\n";
@@ -472,69 +497,59 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         gd::String objectDeclaration =
             codeGenerator.GenerateObjectsDeclarationCode(context) + "\n";
 
-        if (realObjects.size() !=
-            1)  //(We write a slighty more simple ( and optimized ) output code
-                // when only one object list is used.)
-        {
-          outputCode += "std::size_t forEachTotalCount = 0;";
-          outputCode += "std::vector<RuntimeObject*> forEachObjects;";
-          for (std::size_t i = 0; i < realObjects.size(); ++i) {
-            outputCode += "std::size_t forEachCount" + gd::String::From(i) +
-                          " = " + ManObjListName(realObjects[i]) +
-                          ".size(); forEachTotalCount += forEachCount" +
-                          gd::String::From(i) + ";";
-            outputCode += "forEachObjects.insert(" +
-                          gd::String(i == 0 ? "forEachObjects.begin()"
-                                            : "forEachObjects.end()") +
-                          ", " + ManObjListName(realObjects[i]) + ".begin(), " +
-                          ManObjListName(realObjects[i]) + ".end());";
-          }
+        // The parent lists are kept under other names, as the lists of the
+        // picked object are declared once with the same names and only
+        // contain the object of the current iteration: they are cleared and
+        // filled again at each iteration, without copying the parent lists
+        // or allocating memory.
+        outputCode += "{\n";
+        gd::String forEachTotalCount;
+        for (std::size_t i = 0; i < realObjects.size(); ++i) {
+          gd::String forEachObjects = "forEachObjects" + gd::String::From(i);
+          outputCode += "std::vector<RuntimeObject*> & " + forEachObjects +
+                        " = " + ManObjListName(realObjects[i]) + ";\n";
+          if (i != 0) forEachTotalCount += "+";
+          forEachTotalCount += forEachObjects + ".size()";
         }
+        for (std::size_t i = 0; i < realObjects.size(); ++i)
+          outputCode += codeGenerator.GenerateFrameObjectsListDeclaration(
+              ManObjListName(realObjects[i]));
+        outputCode +=
+            "const std::size_t forEachTotalCount = " + forEachTotalCount + ";\n";
 
         // Write final code :
 
         // For loop declaration
-        if (realObjects.size() ==
-            1)  // We write a slighty more simple ( and optimized ) output code
-                // when only one object list is used.
-          outputCode += "for(std::size_t forEachIndex = 0;forEachIndex < " +
-                        ManObjListName(realObjects[0]) +
-                        ".size();++forEachIndex)\n";
-        else
-          outputCode +=
-              "for(std::size_t forEachIndex = 0;forEachIndex < "
-              "forEachTotalCount;++forEachIndex)\n";
-
+        outputCode +=
+            "for(std::size_t forEachIndex = 0;forEachIndex < "
+            "forEachTotalCount;++forEachIndex)\n";
         outputCode += "{\n";
 
-        // Clear all concerned objects lists and keep only one object
+        // Keep only one object in the concerned objects lists
         if (realObjects.size() == 1) {
-          outputCode +=
-              "std::vector<RuntimeObject*> temporaryForEachList; "
-              "temporaryForEachList.push_back(" +
-              ManObjListName(realObjects[0]) + "[forEachIndex]);";
-          outputCode += "std::vector<RuntimeObject*> " +
-                        ManObjListName(realObjects[0]) +
-                        " = temporaryForEachList;\n";
+          // We write a slighty more simple ( and optimized ) output code
+          // when only one object list is used.
+          outputCode += ManObjListName(realObjects[0]) + ".clear();\n";
+          outputCode += ManObjListName(realObjects[0]) +
+                        ".push_back(forEachObjects0[forEachIndex]);\n";
         } else {
-          // Declare all lists of concerned objects empty
-          for (std::size_t j = 0; j < realObjects.size(); ++j)
-            outputCode += "std::vector<RuntimeObject*> " +
-                          ManObjListName(realObjects[j]) + ";\n";
-
-          for (std::size_t i = 0; i < realObjects.size();
-               ++i)  // Pick then only one object
-          {
-            gd::String count;
-            for (std::size_t j = 0; j <= i; ++j) {
-              if (j != 0) count += "+";
-              count += "forEachCount" + gd::String::From(j);
-            }
+          for (std::size_t i = 0; i < realObjects.size(); ++i)
+            outputCode += ManObjListName(realObjects[i]) + ".clear();\n";
 
-            if (i != 0) outputCode += "else ";
-            outputCode += "if (forEachIndex < " + count + ") {\n";
+          // Pick then only one object, the index being made relative to each
+          // list in turn.
+          outputCode += "std::size_t forEachListIndex = forEachIndex;\n";
+          for (std::size_t i = 0; i < realObjects.size(); ++i) {
+            gd::String forEachObjects = "forEachObjects" + gd::String::From(i);
+            if (i == 0)
+              outputCode += "if (forEachListIndex < ";
+            else
+              outputCode += "else if ((forEachListIndex -= forEachObjects" +
+                            gd::String::From(i - 1) + ".size()) < ";
+            outputCode += forEachObjects + ".size()) {\n";
             outputCode += "    " + ManObjListName(realObjects[i]) +
-                          ".push_back(forEachObjects[forEachIndex]);\n";
+                          ".push_back(" + forEachObjects +
+                          "[forEachListIndex]);\n";
             outputCode += "}\n";
           }
         }
@@ -557,6 +572,7 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         outputCode += "}";
 
         outputCode += "}\n";  // End of for loop
+        outputCode += "}\n";
 
         return outputCode;
       });
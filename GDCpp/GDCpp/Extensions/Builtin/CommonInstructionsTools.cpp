@@ -5,61 +5,41 @@
  */
 #include "GDCpp/Extensions/Builtin/CommonInstructionsTools.h"
 #include <SFML/Graphics.hpp>
-#include <chrono>
-#include <random>
 #include <cmath>
 #include <sstream>
+#include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/profile.h"
 
 namespace GDpriv {
 
 namespace CommonInstructions {
 
-namespace {
-/**
- * Create and initialize the random engine.
- * If the system provides a undeterministic random_device, it's used to get
- * a totally random seed for the pseudo-random engine. Otherwise, the time
- * since epoch is used
- */
-std::mt19937 InitializeRandomEngine() {
-  std::random_device randomDevice;
-  return std::mt19937(randomDevice.entropy() > 0
-                          ? randomDevice()
-                          : std::chrono::high_resolution_clock::now()
-                                .time_since_epoch()
-                                .count());
-}
-
-// Global variable storing the current seed
-std::mt19937 randomEngine = InitializeRandomEngine();
-}  // namespace
-
-double GD_API Random(int end) {
+double GD_API Random(int end, RuntimeScene& scene) {
   if (end <= 0) return 0;
 
-  std::uniform_int_distribution<int> randomDist(0, end);
-  return randomDist(randomEngine);
+  return scene.GetRandomGenerator().NextInteger(end);
 }
 
-double GD_API RandomInRange(int min, int max) {
-  return min + Random(max - min); // return min if min >= max
+double GD_API RandomInRange(int min, int max, RuntimeScene& scene) {
+  return min + Random(max - min, scene); // return min if min >= max
 }
 
-double GD_API RandomFloat(float end) {
+double GD_API RandomFloat(float end, RuntimeScene& scene) {
   if (end <= 0) return 0;
 
-  std::uniform_real_distribution<double> randomDist(0, end);
-  return randomDist(randomEngine);
+  return scene.GetRandomGenerator().NextDouble() * end;
 }
 
-double GD_API RandomFloatInRange(float min, float max) {
-  return min + RandomFloat(max - min); // return min if min >= max
+double GD_API RandomFloatInRange(float min, float max, RuntimeScene& scene) {
+  return min + RandomFloat(max - min, scene); // return min if min >= max
 }
 
-double GD_API RandomWithStep(float min, float max, float step) {
-  if (step <= 0) return min + Random(max - min);
-  return min + Random(std::floor((max - min) / step)) * step; // return min if min >= max
+double GD_API RandomWithStep(float min,
+                             float max,
+                             float step,
+                             RuntimeScene& scene) {
+  if (step <= 0) return min + Random(max - min, scene);
+  return min + Random(std::floor((max - min) / step), scene) * step; // return min if min >= max
 }
 
 bool GD_API LogicalNegation(bool param) { return !param; }
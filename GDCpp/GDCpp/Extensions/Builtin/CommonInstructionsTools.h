@@ -8,35 +8,41 @@
 
 #include <string>
 #include "GDCpp/Runtime/String.h"
+class RuntimeScene;
 
 namespace GDpriv {
 
 namespace CommonInstructions {
 
 /**
- * Generate a random integer between 0 and max
+ * Generate a random integer between 0 and max, using the random generator of
+ * the scene.
+ * \see RuntimeScene::GetRandomGenerator
  */
-double GD_API Random(int max);
+double GD_API Random(int max, RuntimeScene& scene);
 
 /**
  * Generate a random integer between min and max
  */
-double GD_API RandomInRange(int min, int max);
+double GD_API RandomInRange(int min, int max, RuntimeScene& scene);
 
 /**
  * Generate a random float between 0 and max
  */
-double GD_API RandomFloat(float max);
+double GD_API RandomFloat(float max, RuntimeScene& scene);
 
 /**
  * Generate a random float between min and max
  */
-double GD_API RandomFloatInRange(float min, float max);
+double GD_API RandomFloatInRange(float min, float max, RuntimeScene& scene);
 
 /**
  * Generate a random number between min and max in steps
  */
-double GD_API RandomWithStep(float min, float max, float step);
+double GD_API RandomWithStep(float min,
+                             float max,
+                             float step,
+                             RuntimeScene& scene);
 
 /**
  * Logical negation
@@ -10,13 +10,14 @@ CreateObjectsFromExternalLayout(RuntimeScene& scene,
                                 const gd::String& externalLayoutName,
                                 float xOffset,
                                 float yOffset) {
-  for (std::size_t i = 0; i < scene.game->GetExternalLayoutsCount(); ++i) {
-    if (scene.game->GetExternalLayout(i).GetName() == externalLayoutName)
-      scene.CreateObjectsFrom(
-          scene.game->GetExternalLayout(i).GetInitialInstances(),
-          xOffset,
-          yOffset);
-  }
+  // The objects are prepared the first time the external layout is used,
+  // as external layouts are usually created many times.
+  if (!scene.game->HasExternalLayoutNamed(externalLayoutName)) return;
+
+  scene.CreateObjectsFromPreparedInstances(
+      scene.game->GetExternalLayout(externalLayoutName).GetInitialInstances(),
+      xOffset,
+      yOffset);
 }
 
 }  // namespace ExternalLayoutsTools
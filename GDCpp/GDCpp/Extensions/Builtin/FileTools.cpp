@@ -6,20 +6,22 @@
 #include "FileTools.h"
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Project/Variable.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/Tools/FileStream.h"
 #include "GDCpp/Runtime/XmlFilesHelper.h"
 
 using namespace std;
 
 bool GD_API FileExists(const gd::String& file) {
-  TiXmlDocument doc;
-  if (!gd::LoadXmlFromFile(doc, file) && doc.ErrorId() == 2) return false;
+  if (XmlFilesManager::IsSavePending(file)) return true;
 
-  return true;
+  gd::FileStream stream(file, std::ios_base::in);
+  return stream.is_open();
 }
 
 bool GD_API GroupExists(const gd::String& filename, const gd::String& group) {
@@ -82,6 +84,7 @@ void GD_API ExecuteCmd(const gd::String& cmd) {
  * Delete a file
  */
 void GD_API GDDeleteFile(const gd::String& filename) {
+  XmlFilesManager::ForgetFile(filename);
   remove(filename.ToLocale().c_str());
 
   return;
@@ -108,6 +111,7 @@ void GD_API UnloadFileFromMemory(const gd::String& filename) {
 void GD_API DeleteGroupFromFile(const gd::String& filename,
                                 const gd::String& group) {
   std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
+  std::lock_guard<std::mutex> lock(file->GetMutex());
   TiXmlHandle hdl(&file->GetTinyXmlDocument());
 
   // D�coupage des groupes
@@ -132,6 +136,7 @@ void GD_API DeleteGroupFromFile(const gd::String& filename,
     if (i >= (groups.size() - 1) - 1) {
       hdl.ToNode()->RemoveChild(
           hdl.FirstChildElement(groups.at(i).c_str()).ToNode());
+      file->MarkAsModified();
       return;
     }
 
@@ -145,6 +150,7 @@ void GD_API WriteValueInFile(const gd::String& filename,
                              const gd::String& group,
                              double value) {
   std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
+  std::lock_guard<std::mutex> lock(file->GetMutex());
   TiXmlHandle hdl(&file->GetTinyXmlDocument());
 
   // D�coupage des groupes
@@ -189,6 +195,7 @@ void GD_API WriteValueInFile(const gd::String& filename,
 
   // Ecriture dans le groupe
   if (hdl.Element() != NULL) hdl.Element()->SetDoubleAttribute("value", value);
+  file->MarkAsModified();
 
   return;
 }
@@ -197,6 +204,7 @@ void GD_API WriteStringInFile(const gd::String& filename,
                               const gd::String& group,
                               const gd::String& str) {
   std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
+  std::lock_guard<std::mutex> lock(file->GetMutex());
   TiXmlHandle hdl(&file->GetTinyXmlDocument());
 
   // D�coupage des groupes
@@ -241,6 +249,7 @@ void GD_API WriteStringInFile(const gd::String& filename,
 
   // Ecriture dans le groupe
   if (hdl.Element() != NULL) hdl.Element()->SetAttribute("texte", str.c_str());
+  file->MarkAsModified();
 
   return;
 }
@@ -249,7 +258,7 @@ void GD_API ReadValueFromFile(const gd::String& filename,
                               const gd::String& group,
                               RuntimeScene& scene,
                               gd::Variable& variable) {
-  std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename, false);
+  std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
   TiXmlHandle hdl(&file->GetTinyXmlDocument());
 
   // D�coupage des groupes
@@ -285,7 +294,7 @@ void GD_API ReadStringFromFile(const gd::String& filename,
                                const gd::String& group,
                                RuntimeScene& scene,
                                gd::Variable& variable) {
-  std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename, false);
+  std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
   TiXmlHandle hdl(&file->GetTinyXmlDocument());
 
   // D�coupage des groupes
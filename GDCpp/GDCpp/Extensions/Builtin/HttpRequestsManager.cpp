@@ -0,0 +1,267 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Extensions/Builtin/HttpRequestsManager.h"
+#include <SFML/Network.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include "GDCpp/Runtime/Project/Variable.h"
+
+const std::size_t HttpRequestsManager::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+
+/**
+ * \brief The request and its result, shared by the scene and the thread
+ * sending the request.
+ */
+struct HttpRequestsManager::RequestState {
+  RequestState()
+      : port(0), cancelled(false), finished(false), succeeded(false){};
+
+  std::string host;
+  unsigned short port;
+  sf::Http::Request request;
+  sf::Time timeout;
+  gd::String outputFilename;  ///< The file to write, for downloads.
+
+  std::atomic<bool> cancelled;
+  std::atomic<bool> finished;  ///< Set by the thread once the result is set.
+  bool succeeded;
+  std::string body;
+};
+
+namespace {
+typedef HttpRequestsManager::RequestState RequestState;
+
+const std::size_t workersCount = 2;
+
+/**
+ * \brief The connections of a thread, by host and port.
+ */
+typedef std::map<std::pair<std::string, unsigned short>,
+                 std::unique_ptr<sf::Http> >
+    HttpConnections;
+
+/**
+ * \brief Send the request, using the connection to the host if it was
+ * already used.
+ */
+void PerformRequest(RequestState& state, HttpConnections& connections) {
+  state.succeeded = false;
+  if (state.cancelled) {
+    state.finished = true;
+    return;
+  }
+
+  std::unique_ptr<sf::Http>& http =
+      connections[std::make_pair(state.host, state.port)];
+  if (!http) {
+    http.reset(new sf::Http);
+    http->setHost(state.host, state.port);
+  }
+
+  sf::Http::Response response = http->sendRequest(state.request, state.timeout);
+  if (!state.cancelled && response.getStatus() == sf::Http::Response::Ok) {
+    if (state.outputFilename.empty()) {
+      state.body = response.getBody();
+      state.succeeded = true;
+    } else {
+      std::ofstream file(state.outputFilename.ToLocale().c_str(),
+                         std::ios_base::binary);
+      if (file.is_open()) {
+        file.write(response.getBody().c_str(), response.getBody().size());
+        state.succeeded = static_cast<bool>(file);
+      }
+    }
+  }
+
+  state.finished = true;
+}
+
+/**
+ * \brief The threads sending the requests of all the scenes.
+ */
+class HttpRequestsWorkers {
+ public:
+  static HttpRequestsWorkers& Get() {
+    // Never destroyed, as the threads can be waiting for a server when the
+    // game is closed.
+    static HttpRequestsWorkers* workers = new HttpRequestsWorkers;
+    return *workers;
+  }
+
+  void Push(std::shared_ptr<RequestState> state) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (threadsCount < workersCount) {
+      try {
+        std::thread(&HttpRequestsWorkers::Run, this).detach();
+        threadsCount++;
+      } catch (const std::system_error&) {
+        break;
+      }
+    }
+
+    if (threadsCount == 0) {
+      // No thread can be started: send the request now.
+      lock.unlock();
+      HttpConnections connections;
+      PerformRequest(*state, connections);
+      return;
+    }
+
+    queue.push_back(state);
+    lock.unlock();
+    condition.notify_one();
+  }
+
+ private:
+  HttpRequestsWorkers() : threadsCount(0){};
+
+  void Run() {
+    HttpConnections connections;
+    while (true) {
+      std::shared_ptr<RequestState> state;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return !queue.empty(); });
+        state = queue.front();
+        queue.pop_front();
+      }
+
+      PerformRequest(*state, connections);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::shared_ptr<RequestState> > queue;
+  std::size_t threadsCount;
+};
+
+/**
+ * \brief Create the state of a request, or return NULL if the host is not
+ * valid.
+ */
+std::shared_ptr<RequestState> CreateRequestState(const gd::String& host,
+                                                 const gd::String& uri,
+                                                 double timeout) {
+  // Separate the host and the port number
+  auto hostInfo = host.Split(U':');
+  if (hostInfo.size() < 2)
+    return std::shared_ptr<RequestState>();  // Invalid address (there should
+                                             // be two elements: "http" and
+                                             // "//the.domain.com")
+
+  std::shared_ptr<RequestState> state = std::make_shared<RequestState>();
+  state->host = hostInfo[0].ToUTF8() + ":" + hostInfo[1].ToUTF8();
+  state->port = hostInfo.size() > 2 ? hostInfo[2].To<unsigned short>() : 0;
+  state->request.setUri(uri.ToUTF8());
+  state->timeout = timeout > 0 ? sf::seconds(timeout) : sf::Time::Zero;
+
+  return state;
+}
+}  // namespace
+
+HttpRequestsManager::~HttpRequestsManager() {
+  for (auto& it : requests)
+    if (it.second.state) it.second.state->cancelled = true;
+}
+
+void HttpRequestsManager::SendRequest(const gd::String& name,
+                                      const gd::String& host,
+                                      const gd::String& uri,
+                                      const gd::String& body,
+                                      const gd::String& method,
+                                      const gd::String& contentType,
+                                      gd::Variable* response,
+                                      double timeout) {
+  std::shared_ptr<RequestState> state =
+      CreateRequestState(host, uri, timeout);
+  if (state) {
+    state->request.setMethod(method == "POST" ? sf::Http::Request::Post
+                                              : sf::Http::Request::Get);
+    state->request.setField("Content-Type",
+                            contentType.empty()
+                                ? "application/x-www-form-urlencoded"
+                                : contentType.ToUTF8());
+    state->request.setBody(body.ToUTF8());
+  }
+
+  Send(name, state, response);
+}
+
+void HttpRequestsManager::DownloadFile(const gd::String& name,
+                                       const gd::String& host,
+                                       const gd::String& uri,
+                                       const gd::String& outputFilename,
+                                       double timeout) {
+  std::shared_ptr<RequestState> state =
+      CreateRequestState(host, uri, timeout);
+  if (state) {
+    state->request.setMethod(sf::Http::Request::Get);
+    state->outputFilename = outputFilename;
+  }
+
+  Send(name, state, nullptr);
+}
+
+void HttpRequestsManager::Send(const gd::String& name,
+                               std::shared_ptr<RequestState> state,
+                               gd::Variable* response) {
+  CancelRequest(name);
+
+  // Invalid requests are finished (and failed) at the next frame, like the
+  // requests that could not be sent.
+  bool isValid = state != nullptr;
+  if (!isValid) {
+    state = std::make_shared<RequestState>();
+    state->finished = true;
+  }
+
+  Request& request = requests[name];
+  request.state = state;
+  request.response = response;
+  request.finished = false;
+  request.succeeded = false;
+
+  if (isValid) HttpRequestsWorkers::Get().Push(state);
+}
+
+void HttpRequestsManager::CancelRequest(const gd::String& name) {
+  auto it = requests.find(name);
+  if (it == requests.end()) return;
+
+  if (it->second.state) it->second.state->cancelled = true;
+  requests.erase(it);
+}
+
+bool HttpRequestsManager::IsRequestFinished(const gd::String& name) const {
+  auto it = requests.find(name);
+  return it != requests.end() && it->second.finished;
+}
+
+bool HttpRequestsManager::HasRequestSucceeded(const gd::String& name) const {
+  auto it = requests.find(name);
+  return it != requests.end() && it->second.finished && it->second.succeeded;
+}
+
+void HttpRequestsManager::Update() {
+  for (auto& it : requests) {
+    Request& request = it.second;
+    if (!request.state || !request.state->finished) continue;
+
+    request.finished = true;
+    request.succeeded = request.state->succeeded;
+    if (request.succeeded && request.response)
+      request.response->SetString(gd::String::FromUTF8(request.state->body));
+    request.state.reset();
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef HTTPREQUESTSMANAGER_H
+#define HTTPREQUESTSMANAGER_H
+
+#include <map>
+#include <memory>
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+#include "GDCpp/Runtime/String.h"
+namespace gd {
+class Variable;
+}
+
+/**
+ * \brief Manage the HTTP requests sent in the background by a scene.
+ *
+ * Requests are sent by a few threads shared by all the scenes, which keep the
+ * connection to the hosts (the address of a host is resolved only once).
+ * Requests are identified by a name: the response of a finished request is
+ * stored in its variable at the beginning of the next frame, before the
+ * events. Requests not finished when the scene is destroyed are cancelled.
+ *
+ * \ingroup NetworkExtension
+ */
+class GD_API HttpRequestsManager : public RuntimeSceneExtensionData {
+ public:
+  HttpRequestsManager(){};
+
+  /**
+   * \brief Cancel the requests not finished yet.
+   */
+  virtual ~HttpRequestsManager();
+
+  static const std::size_t sceneDataIndex;
+
+  /**
+   * \brief Send a request in the background, cancelling the request with the
+   * same name, if any.
+   *
+   * \param response The variable where the body of the response is stored if
+   * the request succeeds. It must exist until the request is finished.
+   * \param timeout The timeout, in seconds (0 for no timeout).
+   */
+  void SendRequest(const gd::String& name,
+                   const gd::String& host,
+                   const gd::String& uri,
+                   const gd::String& body,
+                   const gd::String& method,
+                   const gd::String& contentType,
+                   gd::Variable* response,
+                   double timeout);
+
+  /**
+   * \brief Download a file in the background, cancelling the request with the
+   * same name, if any. The file is written only if the request succeeds.
+   */
+  void DownloadFile(const gd::String& name,
+                    const gd::String& host,
+                    const gd::String& uri,
+                    const gd::String& outputFilename,
+                    double timeout);
+
+  /**
+   * \brief Cancel a request: its response is ignored.
+   */
+  void CancelRequest(const gd::String& name);
+
+  /**
+   * \brief Return true if the request is finished, successfully or not.
+   */
+  bool IsRequestFinished(const gd::String& name) const;
+
+  /**
+   * \brief Return true if the request is finished and the server answered
+   * successfully.
+   */
+  bool HasRequestSucceeded(const gd::String& name) const;
+
+  /**
+   * \brief Store the responses of the requests finished since the last call
+   * in their variables.
+   */
+  void Update();
+
+  virtual void PreEvents(RuntimeScene& scene) { Update(); }
+
+  struct RequestState;
+
+ private:
+  struct Request {
+    std::shared_ptr<RequestState> state;  ///< Shared with the threads. NULL
+                                          ///< once the request is finished.
+    gd::Variable* response;
+    bool finished;
+    bool succeeded;
+  };
+
+  void Send(const gd::String& name,
+            std::shared_ptr<RequestState> state,
+            gd::Variable* response);
+
+  std::map<gd::String, Request> requests;
+};
+
+#endif  // HTTPREQUESTSMANAGER_H
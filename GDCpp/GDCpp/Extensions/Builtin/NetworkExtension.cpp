@@ -20,6 +20,21 @@ NetworkExtension::NetworkExtension() {
   GetAllActions()["DownloadFile"]
       .SetFunctionName("DownloadFile")
       .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
+  GetAllActions()["SendAsyncRequest"]
+      .SetFunctionName("SendAsyncHttpRequest")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
+  GetAllActions()["DownloadFileAsync"]
+      .SetFunctionName("DownloadFileAsync")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
+  GetAllActions()["CancelAsyncRequest"]
+      .SetFunctionName("CancelAsyncHttpRequest")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
+  GetAllConditions()["AsyncRequestFinished"]
+      .SetFunctionName("AsyncHttpRequestFinished")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
+  GetAllConditions()["AsyncRequestSucceeded"]
+      .SetFunctionName("AsyncHttpRequestSucceeded")
+      .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
   GetAllActions()["JSONToVariableStructure"]
       .SetFunctionName("JSONToVariableStructure")
       .SetIncludeFile("GDCpp/Extensions/Builtin/NetworkTools.h");
@@ -5,10 +5,13 @@
  */
 #include "GDCpp/Extensions/Builtin/NetworkTools.h"
 #include <SFML/Network.hpp>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
-#include <iomanip>
+#include <iostream>
 #include <string>
+#include "GDCpp/Extensions/Builtin/HttpRequestsManager.h"
 #include "GDCpp/Runtime/CommonTools.h"
 #include "GDCpp/Runtime/Project/Variable.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -87,114 +90,126 @@ void GD_API DownloadFile(const gd::String& host,
   return;
 }
 
-// Private functions for JSON reading
-namespace {
-/**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-static inline bool isControlCharacter(char ch) { return ch > 0 && ch <= 0x1F; }
+void GD_API SendAsyncHttpRequest(RuntimeScene& scene,
+                                 const gd::String& name,
+                                 const gd::String& host,
+                                 const gd::String& uri,
+                                 const gd::String& body,
+                                 const gd::String& method,
+                                 const gd::String& contentType,
+                                 gd::Variable& response,
+                                 double timeout) {
+  scene.GetExtensionData<HttpRequestsManager>().SendRequest(
+      name, host, uri, body, method, contentType, &response, timeout);
+}
 
-/**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-static bool containsControlCharacter(const char* str) {
-  while (*str) {
-    if (isControlCharacter(*(str++))) return true;
-  }
-  return false;
+void GD_API DownloadFileAsync(RuntimeScene& scene,
+                              const gd::String& name,
+                              const gd::String& host,
+                              const gd::String& uri,
+                              const gd::String& outputfilename,
+                              double timeout) {
+  scene.GetExtensionData<HttpRequestsManager>().DownloadFile(
+      name, host, uri, outputfilename, timeout);
+}
+
+void GD_API CancelAsyncHttpRequest(RuntimeScene& scene,
+                                   const gd::String& name) {
+  scene.GetExtensionData<HttpRequestsManager>().CancelRequest(name);
+}
+
+bool GD_API AsyncHttpRequestFinished(RuntimeScene& scene,
+                                     const gd::String& name) {
+  return scene.GetExtensionData<HttpRequestsManager>().IsRequestFinished(name);
+}
+
+bool GD_API AsyncHttpRequestSucceeded(RuntimeScene& scene,
+                                      const gd::String& name) {
+  return scene.GetExtensionData<HttpRequestsManager>().HasRequestSucceeded(
+      name);
 }
 
+// Private functions for JSON writing
+namespace {
 /**
- * Tool function converting a string to a quoted string that can be inserted
- * into a JSON file. Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
+ * Append to the output the string, quoted and escaped so that it can be
+ * inserted into a JSON file.
  */
-std::string StringToQuotedJSONString(const char* value) {
-  if (value == NULL) return "";
-  // Not sure how to handle unicode...
-  if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL &&
-      !containsControlCharacter(value))
-    return std::string("\"") + value + "\"";
-  // We have to walk value and escape any special characters.
-  // Appending to std::string is not efficient, but this should be rare.
-  // (Note: forward slashes are *not* rare, but I am not escaping them.)
-  std::string::size_type maxsize =
-      strlen(value) * 2 + 3;  // allescaped+quotes+NULL
-  std::string result;
-  result.reserve(maxsize);  // to avoid lots of mallocs
-  result += "\"";
-  for (const char* c = value; *c != 0; ++c) {
-    switch (*c) {
-      case '\"':
-        result += "\\\"";
+void WriteQuotedJSONString(const std::string& value, std::string& output) {
+  output += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        output += "\\\"";
         break;
       case '\\':
-        result += "\\\\";
+        output += "\\\\";
         break;
       case '\b':
-        result += "\\b";
+        output += "\\b";
         break;
       case '\f':
-        result += "\\f";
+        output += "\\f";
         break;
       case '\n':
-        result += "\\n";
+        output += "\\n";
         break;
       case '\r':
-        result += "\\r";
+        output += "\\r";
         break;
       case '\t':
-        result += "\\t";
+        output += "\\t";
         break;
-      // case '/':
-      // Even though \/ is considered a legal escape in JSON, a bare
-      // slash is also legal, so I see no reason to escape it.
-      // (I hope I am not misunderstanding something.
-      // blep notes: actually escaping \/ may be useful in javascript to avoid
-      // </ sequence. Should add a flag to allow this compatibility mode and
-      // prevent this sequence from occurring.
       default:
-        if (isControlCharacter(*c)) {
-          std::ostringstream oss;
-          oss << "\\u" << std::hex << std::uppercase << std::setfill('0')
-              << std::setw(4) << static_cast<int>(*c);
-          result += oss.str();
+        if (c > 0 && c <= 0x1F) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04X", c);
+          output += escaped;
         } else {
-          result += *c;
+          output += c;
         }
         break;
     }
   }
-  result += "\"";
-  return result;
+  output += '"';
 }
-}  // namespace
 
-gd::String GD_API VariableStructureToJSON(const gd::Variable& variable) {
+/**
+ * Append to the output the JSON of the variable and of its children.
+ */
+void WriteJSON(const gd::Variable& variable, std::string& output) {
   if (!variable.IsStructure()) {
-    if (variable.IsNumber())
-      return gd::String::From(variable.GetValue());
-    else
-      return gd::String::FromUTF8(
-          StringToQuotedJSONString(variable.GetString().c_str()));
+    if (variable.IsNumber()) {
+      // Same format as gd::String::From.
+      char number[32];
+      snprintf(number, sizeof(number), "%g", variable.GetValue());
+      output += number;
+    } else {
+      WriteQuotedJSONString(variable.GetString().Raw(), output);
+    }
+    return;
   }
 
-  gd::String str = "{";
+  output += '{';
   bool firstChild = true;
-  for (auto i = variable.GetAllChildren().begin();
-       i != variable.GetAllChildren().end();
-       ++i) {
-    if (!firstChild) str += ",";
-    str += gd::String::FromUTF8(StringToQuotedJSONString(i->first.c_str())) +
-           ": " + VariableStructureToJSON(*i->second);
+  for (const auto& child : variable.GetAllChildren()) {
+    if (!firstChild) output += ',';
+    WriteQuotedJSONString(child.first.Raw(), output);
+    output += ": ";
+    WriteJSON(*child.second, output);
 
     firstChild = false;
   }
+  output += '}';
+}
+}  // namespace
 
-  str += "}";
-  return str;
+gd::String GD_API VariableStructureToJSON(const gd::Variable& variable) {
+  std::string output;
+  output.reserve(256);
+  WriteJSON(variable, output);
+
+  return gd::String::FromUTF8(output);
 }
 
 gd::String GD_API ObjectVariableStructureToJSON(RuntimeObject* object,
@@ -204,213 +219,280 @@ gd::String GD_API ObjectVariableStructureToJSON(RuntimeObject* object,
 
 // Private functions for JSON parsing
 namespace {
-size_t SkipBlankChar(const std::string& str, size_t pos) {
-  const std::string blankChar = " \n";
-  return str.find_first_not_of(blankChar, pos);
-}
-
 /**
- * Adapted from https://github.com/hjiang/jsonxx
+ * \brief Parse a JSON string in a single pass, storing the values directly
+ * into a variable (and its children).
+ *
+ * Arrays are converted to children called "0", "1"... Parsing stops at the
+ * first error, keeping the values parsed so far.
  */
-std::string DecodeString(const std::string& original) {
-  std::string value;
-  value.reserve(original.size());
-  std::istringstream input("\"" + original + "\"");
-
-  char ch = '\0', delimiter = '"';
-  input.get(ch);
-  if (ch != delimiter) return "";
-
-  while (!input.eof() && input.good()) {
-    input.get(ch);
-    if (ch == delimiter) {
+class JSONParser {
+ public:
+  JSONParser(const std::string& json)
+      : pos(json.data()), end(json.data() + json.size()){};
+
+  /**
+   * \brief Parse the value at the current position into the variable.
+   * \return false if the JSON is not properly formed.
+   */
+  bool ParseValue(gd::Variable& variable) {
+    SkipBlanks();
+    if (pos >= end) return false;
+
+    if (*pos == '{')
+      return ParseObject(variable);
+    else if (*pos == '[')
+      return ParseArray(variable);
+    else if (*pos == '"') {
+      if (!ParseString(buffer)) {
+        std::cout << "Parsing error: Invalid string";
+        return false;
+      }
+      variable.SetString(gd::String::FromUTF8(buffer));
+      return true;
+    }
+
+    ParseLiteral(variable);
+    return true;
+  }
+
+ private:
+  bool ParseObject(gd::Variable& variable) {
+    pos++;  // Skip {
+    SkipBlanks();
+    if (pos < end && *pos == '}') {
+      pos++;
+      return true;
+    }
+
+    while (pos < end) {
+      SkipBlanks();
+      if (!ParseName(buffer)) break;
+
+      SkipBlanks();
+      if (pos >= end || *pos != ':') break;
+      pos++;
+
+      if (!ParseValue(variable.GetChild(gd::String::FromUTF8(buffer))))
+        return false;
+
+      SkipBlanks();
+      if (pos < end && *pos == ',') {
+        pos++;
+        continue;
+      }
+      if (pos < end && *pos == '}') {
+        pos++;
+        return true;
+      }
+      break;
+    }
+
+    std::cout << "Parsing error: Object not properly formed.";
+    return false;
+  }
+
+  bool ParseArray(gd::Variable& variable) {
+    pos++;  // Skip [
+    SkipBlanks();
+    if (pos < end && *pos == ']') {
+      pos++;
+      return true;
+    }
+
+    std::size_t index = 0;
+    char name[24];
+    while (pos < end) {
+      snprintf(name, sizeof(name), "%lu", static_cast<unsigned long>(index));
+      if (!ParseValue(variable.GetChild(gd::String(name)))) return false;
+      index++;
+
+      SkipBlanks();
+      if (pos < end && *pos == ',') {
+        pos++;
+        continue;
+      }
+      if (pos < end && *pos == ']') {
+        pos++;
+        return true;
+      }
       break;
     }
-    if (ch == '\\') {
-      input.get(ch);
+
+    std::cout << "Parsing error: array not properly ended";
+    return false;
+  }
+
+  /**
+   * Parse the name of a member of an object, which is usually quoted.
+   */
+  bool ParseName(std::string& name) {
+    if (pos < end && *pos == '"') return ParseString(name);
+
+    const char* nameStart = pos;
+    while (pos < end && *pos != ':' && !IsBlank(*pos)) pos++;
+    name.assign(nameStart, pos);
+    return !name.empty();
+  }
+
+  /**
+   * Parse the quoted string at the current position, decoding escaped
+   * characters.
+   */
+  bool ParseString(std::string& str) {
+    str.clear();
+    pos++;  // Skip "
+
+    while (pos < end) {
+      // Copy the characters that are not escaped all at once.
+      const char* chunkStart = pos;
+      while (pos < end && *pos != '"' && *pos != '\\') pos++;
+      str.append(chunkStart, pos);
+      if (pos >= end) return false;
+
+      if (*pos == '"') {
+        pos++;
+        return true;
+      }
+
+      pos++;  // Skip the backslash
+      if (pos >= end) return false;
+      char ch = *(pos++);
       switch (ch) {
+        case '"':
         case '\\':
         case '/':
-          value.push_back(ch);
+          str += ch;
           break;
         case 'b':
-          value.push_back('\b');
+          str += '\b';
           break;
         case 'f':
-          value.push_back('\f');
+          str += '\f';
           break;
         case 'n':
-          value.push_back('\n');
+          str += '\n';
           break;
         case 'r':
-          value.push_back('\r');
+          str += '\r';
           break;
         case 't':
-          value.push_back('\t');
+          str += '\t';
           break;
         case 'u': {
-          int i;
-          std::stringstream ss;
-          for (i = 0; (!input.eof() && input.good()) && i < 4; ++i) {
-            input.get(ch);
-            ss << ch;
+          unsigned long codePoint = 0;
+          if (!ParseHexCodeUnit(codePoint)) return false;
+          // Surrogate pair, for characters out of the basic multilingual
+          // plane.
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF && end - pos >= 6 &&
+              pos[0] == '\\' && pos[1] == 'u') {
+            const char* lowSurrogatePos = pos;
+            pos += 2;
+            unsigned long lowSurrogate = 0;
+            if (ParseHexCodeUnit(lowSurrogate) && lowSurrogate >= 0xDC00 &&
+                lowSurrogate <= 0xDFFF)
+              codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                          (lowSurrogate - 0xDC00);
+            else
+              pos = lowSurrogatePos;
           }
-          if (input.good() && (ss >> i)) value.push_back(i);
+          WriteUTF8(codePoint, str);
         } break;
         default:
-          if (ch != delimiter) {
-            value.push_back('\\');
-            value.push_back(ch);
-          } else
-            value.push_back(ch);
+          str += '\\';
+          str += ch;
           break;
       }
-    } else {
-      value.push_back(ch);
     }
-  }
-  if (input && ch == delimiter) {
-    return value;
-  } else {
-    return "";
-  }
-}
 
-/**
- * Return the position of the end of the string. Blank are skipped if necessary
- * @param str The string to be used
- * @param startPos The start position
- * @param strContent A reference to a string that will be filled with the string
- * content.
- */
-size_t SkipString(const std::string& str,
-                  size_t startPos,
-                  std::string& strContent) {
-  startPos = SkipBlankChar(str, startPos);
-  if (startPos >= str.length()) return std::string::npos;
-
-  size_t endPos = startPos;
-
-  if (str[startPos] == '"') {
-    if (startPos + 1 >= str.length()) return std::string::npos;
+    return false;
+  }
 
-    while (endPos == startPos || (str[endPos - 1] == '\\')) {
-      endPos = str.find_first_of('\"', endPos + 1);
-      if (endPos == std::string::npos)
-        return std::string::npos;  // Invalid string
+  /**
+   * Parse the 4 hexadecimal digits following "\u".
+   */
+  bool ParseHexCodeUnit(unsigned long& codeUnit) {
+    if (end - pos < 4) return false;
+
+    codeUnit = 0;
+    for (int i = 0; i < 4; ++i, ++pos) {
+      char ch = *pos;
+      codeUnit <<= 4;
+      if (ch >= '0' && ch <= '9')
+        codeUnit += ch - '0';
+      else if (ch >= 'a' && ch <= 'f')
+        codeUnit += ch - 'a' + 10;
+      else if (ch >= 'A' && ch <= 'F')
+        codeUnit += ch - 'A' + 10;
+      else
+        return false;
     }
-
-    strContent = DecodeString(str.substr(startPos + 1, endPos - 1 - startPos));
-    return endPos;
+    return true;
   }
 
-  endPos = str.find_first_of(" \n,:");
-  if (endPos >= str.length()) return std::string::npos;  // Invalid string
-
-  strContent = DecodeString(str.substr(startPos, endPos - 1 - startPos));
-  return endPos - 1;
-}
-
-/**
- * Parse a JSON string, starting from pos, and storing the result into the
- * specified variable. Note that the parsing is stopped as soon as a valid
- * object is parsed. \return The position at the end of the valid object stored
- * into the variable.
- */
-size_t ParseJSONObject(const std::string& jsonStr,
-                       size_t startPos,
-                       gd::Variable& variable) {
-  size_t pos = SkipBlankChar(jsonStr, startPos);
-  if (pos >= jsonStr.length()) return std::string::npos;
-
-  if (jsonStr[pos] == '{')  // Object
-  {
-    bool firstChild = true;
-    while (firstChild || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == '}') break;
-
-      std::string childName;
-      pos = SkipString(jsonStr, pos, childName);
-
-      pos++;
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length() || jsonStr[pos] != ':')
-        return std::string::npos;
-
-      pos++;
-      pos = ::ParseJSONObject(
-          jsonStr, pos, variable.GetChild(gd::String::FromUTF8(childName)));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) return std::string::npos;
-      firstChild = false;
+  static void WriteUTF8(unsigned long codePoint, std::string& str) {
+    if (codePoint < 0x80) {
+      str += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      str += static_cast<char>(0xC0 | (codePoint >> 6));
+      str += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+      str += static_cast<char>(0xE0 | (codePoint >> 12));
+      str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      str += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      str += static_cast<char>(0xF0 | (codePoint >> 18));
+      str += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      str += static_cast<char>(0x80 | (codePoint & 0x3F));
     }
+  }
 
-    if (jsonStr[pos] != '}') {
-      std::cout << "Parsing error: Object not properly formed.";
-      return std::string::npos;
-    }
-    return pos + 1;
-  } else if (jsonStr[pos] ==
-             '[')  // Array are translated into child named 0,1,2...
-  {
-    std::size_t index = 0;
-    while (index == 0 || jsonStr[pos] == ',') {
+  /**
+   * Parse a number, true, false or null (stored as 0). Anything else is
+   * also stored as 0.
+   */
+  void ParseLiteral(gd::Variable& variable) {
+    const char* literalStart = pos;
+    while (pos < end && *pos != ',' && *pos != '}' && *pos != ']' &&
+           !IsBlank(*pos))
       pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == ']') break;
-      pos = ::ParseJSONObject(
-          jsonStr, pos, variable.GetChild(gd::String::From(index)));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) {
-        std::cout << "Parsing error: element of array not properly formed.";
-        return std::string::npos;
-      }
-      index++;
-    }
 
-    if (jsonStr[pos] != ']') {
-      std::cout << "Parsing error: array not properly ended";
-      return std::string::npos;
-    }
-    return pos + 1;
-  } else if (jsonStr[pos] == '"')  // String
-  {
-    std::string str;
-    pos = SkipString(jsonStr, pos, str);
-    if (pos >= jsonStr.length()) {
-      std::cout << "Parsing error: Invalid string";
-      return std::string::npos;
+    std::size_t length = pos - literalStart;
+    if (length == 4 && strncmp(literalStart, "true", 4) == 0)
+      variable.SetValue(1);
+    else if (length == 5 && strncmp(literalStart, "false", 5) == 0)
+      variable.SetValue(0);
+    else {
+      // strtod stops at the end of the literal, as the JSON string is
+      // terminated by a null character.
+      char* numberEnd = nullptr;
+      double value = strtod(literalStart, &numberEnd);
+      variable.SetValue(numberEnd == pos ? value : 0);
     }
+  }
 
-    variable.SetString(gd::String::FromUTF8(str));
-    return pos + 1;
-  } else {
-    std::string str;
-    size_t endPos = pos;
-    const std::string separators = " \n,}";
-    while (endPos < jsonStr.length() &&
-           separators.find_first_of(jsonStr[endPos]) == std::string::npos) {
-      endPos++;
-    }
+  static bool IsBlank(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+  }
 
-    str = jsonStr.substr(pos, endPos - pos);
-    if (str == "true")
-      variable.SetValue(1);
-    else if (str == "false")
-      variable.SetValue(0);
-    else
-      variable.SetValue(gd::String::FromUTF8(str).To<double>());
-    return endPos;
+  void SkipBlanks() {
+    while (pos < end && IsBlank(*pos)) pos++;
   }
-}
+
+  const char* pos;  ///< The current position in the JSON string.
+  const char* end;
+  std::string buffer;  ///< Buffer reused to decode strings, to avoid
+                       ///< allocations.
+};
 }  // namespace
 
 void GD_API JSONToVariableStructure(const gd::String& jsonStr,
                                     gd::Variable& variable) {
   if (jsonStr.empty()) return;
-  ::ParseJSONObject(jsonStr.c_str(), 0, variable);
+
+  JSONParser parser(jsonStr.Raw());
+  parser.ParseValue(variable);
 }
 
 void GD_API JSONToObjectVariableStructure(const gd::String& JSON,
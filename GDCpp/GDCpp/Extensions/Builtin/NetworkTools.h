@@ -10,6 +10,7 @@
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/String.h"
 
+class RuntimeScene;
 namespace gd {
 class Variable;
 }
@@ -24,6 +25,27 @@ void GD_API DownloadFile(const gd::String& host,
                          const gd::String& uri,
                          const gd::String& outputfilename);
 
+void GD_API SendAsyncHttpRequest(RuntimeScene& scene,
+                                 const gd::String& name,
+                                 const gd::String& host,
+                                 const gd::String& uri,
+                                 const gd::String& body,
+                                 const gd::String& method,
+                                 const gd::String& contentType,
+                                 gd::Variable& response,
+                                 double timeout);
+void GD_API DownloadFileAsync(RuntimeScene& scene,
+                              const gd::String& name,
+                              const gd::String& host,
+                              const gd::String& uri,
+                              const gd::String& outputfilename,
+                              double timeout);
+void GD_API CancelAsyncHttpRequest(RuntimeScene& scene, const gd::String& name);
+bool GD_API AsyncHttpRequestFinished(RuntimeScene& scene,
+                                     const gd::String& name);
+bool GD_API AsyncHttpRequestSucceeded(RuntimeScene& scene,
+                                      const gd::String& name);
+
 gd::String GD_API VariableStructureToJSON(const gd::Variable& variable);
 gd::String GD_API ObjectVariableStructureToJSON(RuntimeObject* object,
                                                 const gd::Variable& variable);
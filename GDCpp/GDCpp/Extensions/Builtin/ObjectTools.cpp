@@ -10,6 +10,7 @@
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
 #include "MathematicalTools.h"
 
 using namespace std;
@@ -32,9 +33,10 @@ bool GD_API HitBoxesCollision(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     bool conditionInverted,
-    RuntimeScene & /*scene*/,
+    RuntimeScene &scene,
     bool ignoreTouchingEdges) {
-  return TwoObjectListsTest(
+  return TwoObjectListsOverlappingTest(
+      scene,
       objectsLists1,
       objectsLists2,
       conditionInverted,
@@ -47,8 +49,10 @@ bool GD_API ObjectsTurnedToward(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     float tolerance,
-    bool conditionInverted) {
+    bool conditionInverted,
+    RuntimeScene &scene) {
   return TwoObjectListsTest(
+      scene,
       objectsLists1,
       objectsLists2,
       conditionInverted,
@@ -69,28 +73,33 @@ float GD_API DistanceBetweenObjects(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     float length,
-    bool conditionInverted) {
-  length *= length;
-  return TwoObjectListsTest(
+    bool conditionInverted,
+    RuntimeScene &scene) {
+  float sqLength = length * length;
+  return TwoObjectListsOverlappingTest(
+      scene,
       objectsLists1,
       objectsLists2,
       conditionInverted,
-      [length](RuntimeObject *obj1, RuntimeObject *obj2) {
+      [sqLength](RuntimeObject *obj1, RuntimeObject *obj2) {
         float X = obj1->GetDrawableX() + obj1->GetCenterX() -
                   (obj2->GetDrawableX() + obj2->GetCenterX());
         float Y = obj1->GetDrawableY() + obj1->GetCenterY() -
                   (obj2->GetDrawableY() + obj2->GetCenterY());
 
-        return (X * X + Y * Y) <= length;
-      });
+        return (X * X + Y * Y) <= sqLength;
+      },
+      std::abs(length));
 }
 
 bool GD_API
 MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
             std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
             float tolerance,
-            bool conditionInverted) {
+            bool conditionInverted,
+            RuntimeScene &scene) {
   return TwoObjectListsTest(
+      scene,
       objectsLists1,
       objectsLists2,
       conditionInverted,
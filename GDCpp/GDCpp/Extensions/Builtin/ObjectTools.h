@@ -21,7 +21,8 @@ bool GD_API ObjectsTurnedToward(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     float tolerance,
-    bool conditionInverted);
+    bool conditionInverted,
+    RuntimeScene &scene);
 
 /**
  * Only used internally by GD events generated code.
@@ -46,7 +47,8 @@ float GD_API DistanceBetweenObjects(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
     float length,
-    bool conditionInverted);
+    bool conditionInverted,
+    RuntimeScene &scene);
 
 /**
  * Only used internally by GD events generated code.
@@ -55,6 +57,7 @@ bool GD_API
 MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
             std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
             float tolerance,
-            bool conditionInverted);
+            bool conditionInverted,
+            RuntimeScene &scene);
 
 #endif  // OBJECTTOOLS_H
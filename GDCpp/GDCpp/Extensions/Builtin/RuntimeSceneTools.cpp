@@ -3,6 +3,8 @@
  * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include "GDCore/Tools/Log.h"
@@ -114,10 +116,10 @@ void DoCreateObjectOnScene(
 
   if (sceneObject !=
       scene.GetObjects().end())  // We check first scene's objects' list.
-    newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
+    newObject = scene.objectsInstances.CreateObject(scene, **sceneObject);
   else if (globalObject !=
            scene.game->GetObjects().end())  // Then the global object list
-    newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
+    newObject = scene.objectsInstances.CreateObject(scene, **globalObject);
 
   if (newObject == std::unique_ptr<RuntimeObject>())
     return;  // Unable to create the object
@@ -185,7 +187,7 @@ bool GD_API PickAllObjects(
 }
 
 bool GD_API PickRandomObject(
-    RuntimeScene &,
+    RuntimeScene &scene,
     std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
   // Create a list with all objects
   std::vector<RuntimeObject *> allObjects;
@@ -199,7 +201,8 @@ bool GD_API PickRandomObject(
 
   if (allObjects.empty()) return false;
 
-  std::size_t id = GDpriv::CommonInstructions::Random(allObjects.size() - 1);
+  std::size_t id =
+      scene.GetRandomGenerator().NextInteger(allObjects.size() - 1);
   PickOnly(pickedObjectLists, allObjects[id]);
   return true;
 }
@@ -242,12 +245,13 @@ bool GD_API RaycastObject(
     float dist,
     gd::Variable &varX,
     gd::Variable &varY,
-    bool inverted) {
+    bool inverted,
+    RuntimeScene &scene) {
   return RaycastObjectToPosition(pickedObjectLists,
                                  x, y,
                                  x + dist*cos(angle*3.14159/180.0),
                                  y + dist*sin(angle*3.14159/180.0),
-                                 varX, varY, inverted);
+                                 varX, varY, inverted, scene);
 }
 
 bool GD_API RaycastObjectToPosition(
@@ -258,32 +262,70 @@ bool GD_API RaycastObjectToPosition(
     float endY,
     gd::Variable &varX,
     gd::Variable &varY,
-    bool inverted) {
+    bool inverted,
+    RuntimeScene &scene) {
   RuntimeObject *matchObject = NULL;
-  float testSqDist = inverted ? 0 : (endX - x)*(endX - x) + (endY - y)*(endY - y);
+  float sqLength = (endX - x)*(endX - x) + (endY - y)*(endY - y);
+  float testSqDist = inverted ? 0 : sqLength;
   float resultX = 0.0f;
   float resultY = 0.0f;
-  for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end(); ++it) {
-    if (it->second == NULL) continue;
-    auto list = *it->second;
+  auto testObject = [&](RuntimeObject *object) {
+    RaycastResult result = object->RaycastTest(x, y, endX, endY, !inverted);
+
+    if (result.collision) {
+      if (!inverted && (result.closeSqDist <= testSqDist)) {
+        testSqDist = result.closeSqDist;
+        matchObject = object;
+        resultX = result.closePoint.x;
+        resultY = result.closePoint.y;
+      } else if (inverted && (result.farSqDist >= testSqDist)) {
+        testSqDist = result.farSqDist;
+        matchObject = object;
+        resultX = result.farPoint.x;
+        resultY = result.farPoint.y;
+      }
+    }
+  };
 
-    for (std::size_t i = 0; i < list.size(); ++i) {
-      RaycastResult result = list[i]->RaycastTest(x, y, endX, endY, !inverted);
-
-      if (result.collision) {
-        if (!inverted && (result.closeSqDist <= testSqDist)) {
-          testSqDist = result.closeSqDist;
-          matchObject = list[i];
-          resultX = result.closePoint.x;
-          resultY = result.closePoint.y;
-        } else if (inverted && (result.farSqDist >= testSqDist)) {
-          testSqDist = result.farSqDist;
-          matchObject = list[i];
-          resultX = result.farPoint.x;
-          resultY = result.farPoint.y;
-        }
+  std::size_t objectsCount = 0;
+  for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end(); ++it)
+    if (it->second != NULL) objectsCount += it->second->size();
+
+  if (objectsCount <= 8) {
+    // For a few objects, testing all of them is faster.
+    for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end(); ++it) {
+      if (it->second == NULL) continue;
+      auto &list = *it->second;
+
+      for (std::size_t i = 0; i < list.size(); ++i) testObject(list[i]);
+    }
+  } else {
+    // Refresh the objects in the spatial hash and only test the ones in the
+    // cells crossed by the ray, stopping after the closest intersection.
+    ObjectsSpatialHash &spatialHash = scene.GetObjectsSpatialHash();
+    ScratchArena &arena = scene.GetScratchArena();
+    ScratchArena::Scope arenaScope(arena);
+
+    RuntimeObject **objects = arena.AllocateArray<RuntimeObject *>(objectsCount);
+    RuntimeObject **objectsEnd = objects;
+    for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end(); ++it) {
+      if (it->second == NULL) continue;
+
+      for (RuntimeObject *object : *it->second) {
+        spatialHash.Update(object);
+        *(objectsEnd++) = object;
       }
     }
+    std::sort(objects, objectsEnd);
+
+    spatialHash.ForEachObjectAlongSegment(
+        x, y, endX, endY, [&](RuntimeObject *candidate) {
+          if (std::binary_search(objects, objectsEnd, candidate))
+            testObject(candidate);
+
+          if (inverted || !matchObject || sqLength <= 0) return 1.0f;
+          return std::sqrt(testSqDist / sqLength);
+        });
   }
 
   if (!matchObject) return false;
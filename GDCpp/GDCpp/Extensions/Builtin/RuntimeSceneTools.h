@@ -128,10 +128,14 @@ bool GD_API RaycastObject(
     float dist,
     gd::Variable &varX,
     gd::Variable &varY,
-    bool inverted);
+    bool inverted,
+    RuntimeScene &scene);
 
 /**
  * Only used internally by GD events generated code.
+ *
+ * The spatial hash of the scene is used to only test the objects near the
+ * ray.
  */
 bool GD_API RaycastObjectToPosition(
     std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
@@ -141,7 +145,8 @@ bool GD_API RaycastObjectToPosition(
     float targetY,
     gd::Variable &varX,
     gd::Variable &varY,
-    bool inverted);
+    bool inverted,
+    RuntimeScene &scene);
 
 /**
  * Only used internally by GD events generated code.
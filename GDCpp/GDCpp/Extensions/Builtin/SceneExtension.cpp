@@ -22,18 +22,33 @@ SceneExtension::SceneExtension() {
 
 #if defined(GD_IDE_ONLY)
   GetAllExpressions()["Random"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("GDpriv::CommonInstructions::Random")
       .SetIncludeFile("GDCpp/Extensions/Builtin/CommonInstructionsTools.h");
   GetAllExpressions()["RandomInRange"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("GDpriv::CommonInstructions::RandomInRange")
       .SetIncludeFile("GDCpp/Extensions/Builtin/CommonInstructionsTools.h");
   GetAllExpressions()["RandomFloat"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("GDpriv::CommonInstructions::RandomFloat")
       .SetIncludeFile("GDCpp/Extensions/Builtin/CommonInstructionsTools.h");
   GetAllExpressions()["RandomFloatInRange"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("GDpriv::CommonInstructions::RandomFloatInRange")
       .SetIncludeFile("GDCpp/Extensions/Builtin/CommonInstructionsTools.h");
   GetAllExpressions()["RandomWithStep"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("GDpriv::CommonInstructions::RandomWithStep")
       .SetIncludeFile("GDCpp/Extensions/Builtin/CommonInstructionsTools.h");
   GetAllStrExpressions()["CurrentSceneName"]
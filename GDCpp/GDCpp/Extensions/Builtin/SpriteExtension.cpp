@@ -65,7 +65,9 @@ SpriteExtension::SpriteExtension() {
       .SetFunctionName("RotateTowardPosition")
       .SetIncludeFile("GDCpp/Runtime/RuntimeSpriteObject.h");
   objectActions["ChangeScale"]
-      .SetFunctionName("ChangeScale")
+      .SetManipulatedType("number")
+      .SetSettersAndGetters(
+          {{"SetScaleX", "GetScaleX"}, {"SetScaleY", "GetScaleY"}})
       .SetIncludeFile("GDCpp/Runtime/RuntimeSpriteObject.h");
   objectActions["ChangeScaleWidth"]
       .SetFunctionName("SetScaleX")
@@ -188,6 +190,9 @@ SpriteExtension::SpriteExtension() {
       .SetIncludeFile("GDCpp/Runtime/RuntimeSpriteObject.h");
 
   GetAllConditions()["Collision"]
+      .AddCodeOnlyParameter(
+          "currentScene",
+          "")  // We need an extra parameter pointing to the scene.
       .SetFunctionName("SpriteCollision")
       .SetIncludeFile("GDCpp/Extensions/Builtin/SpriteTools.h");
 #endif
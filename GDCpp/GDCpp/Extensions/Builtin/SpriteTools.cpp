@@ -21,13 +21,15 @@ using namespace std;
 bool GD_API SpriteCollision(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted) {
-  return TwoObjectListsTest(objectsLists1,
-                            objectsLists2,
-                            conditionInverted,
-                            [](RuntimeObject *obj1, RuntimeObject *obj2) {
-                              return CheckCollision(
-                                  static_cast<RuntimeSpriteObject *>(obj1),
-                                  static_cast<RuntimeSpriteObject *>(obj2));
-                            });
+    bool conditionInverted,
+    RuntimeScene &scene) {
+  return TwoObjectListsOverlappingTest(
+      scene,
+      objectsLists1,
+      objectsLists2,
+      conditionInverted,
+      [](RuntimeObject *obj1, RuntimeObject *obj2) {
+        return CheckCollision(static_cast<RuntimeSpriteObject *>(obj1),
+                              static_cast<RuntimeSpriteObject *>(obj2));
+      });
 }
@@ -13,6 +13,7 @@ class RuntimeObject;
 bool GD_API SpriteCollision(
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
     std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted);
+    bool conditionInverted,
+    RuntimeScene &scene);
 
 #endif  // SPRITETOOLS_H
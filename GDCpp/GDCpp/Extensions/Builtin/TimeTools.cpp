@@ -2,15 +2,22 @@
 #include "GDCpp/Runtime/ManualTimer.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 
+namespace {
+ManualTimer& GetOrAddTimer(RuntimeScene& scene, const gd::String& timerName) {
+  ManualTimer* timer = scene.GetTimeManager().FindTimer(timerName);
+  return timer ? *timer : scene.GetTimeManager().AddTimer(timerName);
+}
+}  // namespace
+
 bool GD_API TimerElapsedTime(RuntimeScene& scene,
                              double timeInSeconds,
                              const gd::String& timerName) {
-  if (!scene.GetTimeManager().HasTimer(timerName))
+  const ManualTimer* timer = scene.GetTimeManager().FindTimer(timerName);
+  if (!timer)
     return true;  // Inconsistency to keep compatibility with games relying on
                   // this behavior.
 
-  return scene.GetTimeManager().GetTimer(timerName).GetTime() >=
-         timeInSeconds * 1000000.0;
+  return timer->GetTime() >= timeInSeconds * 1000000.0;
 }
 
 double GD_API GetTimerElapsedTimeInSeconds(RuntimeScene& scene,
@@ -21,9 +28,8 @@ double GD_API GetTimerElapsedTimeInSeconds(RuntimeScene& scene,
 }
 
 bool GD_API TimerPaused(RuntimeScene& scene, const gd::String& timerName) {
-  if (!scene.GetTimeManager().HasTimer(timerName)) return false;
-
-  return scene.GetTimeManager().GetTimer(timerName).IsPaused();
+  const ManualTimer* timer = scene.GetTimeManager().FindTimer(timerName);
+  return timer && timer->IsPaused();
 }
 
 double GD_API GetTimeScale(RuntimeScene& scene) {
@@ -31,24 +37,15 @@ double GD_API GetTimeScale(RuntimeScene& scene) {
 }
 
 void GD_API ResetTimer(RuntimeScene& scene, const gd::String& timerName) {
-  if (!scene.GetTimeManager().HasTimer(timerName))
-    scene.GetTimeManager().AddTimer(timerName);
-
-  scene.GetTimeManager().GetTimer(timerName).Reset();
+  GetOrAddTimer(scene, timerName).Reset();
 }
 
 void GD_API PauseTimer(RuntimeScene& scene, const gd::String& timerName) {
-  if (!scene.GetTimeManager().HasTimer(timerName))
-    scene.GetTimeManager().AddTimer(timerName);
-
-  scene.GetTimeManager().GetTimer(timerName).SetPaused(true);
+  GetOrAddTimer(scene, timerName).SetPaused(true);
 }
 
 void GD_API UnPauseTimer(RuntimeScene& scene, const gd::String& timerName) {
-  if (!scene.GetTimeManager().HasTimer(timerName))
-    scene.GetTimeManager().AddTimer(timerName);
-
-  scene.GetTimeManager().GetTimer(timerName).SetPaused(false);
+  GetOrAddTimer(scene, timerName).SetPaused(false);
 }
 
 void GD_API RemoveTimer(RuntimeScene& scene, const gd::String& timerName) {
@@ -6,13 +6,131 @@
 
 #if defined(GD_IDE_ONLY)
 #include "GDCpp/IDE/BaseDebugger.h"
+#include <algorithm>
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include "GDCpp/Runtime/TimeManager.h"
 
-void BaseDebugger::Update() {
+void BaseDebugger::Update(RuntimeScene& scene) {
   if (timeInterval.getElapsedTime().asMilliseconds() >
       200)  // Update each 200 ms
   {
     UpdateGUI();
     timeInterval.restart();
   }
+
+  if (snapshotsInterval > 0 &&
+      snapshotsClock.getElapsedTime().asMilliseconds() >= snapshotsInterval) {
+    WriteSnapshot(scene, snapshot);
+    PublishSnapshot(snapshot);
+    snapshotsClock.restart();
+  }
+}
+
+void BaseDebugger::WatchObjects(const gd::String& objectName) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  if (std::find(watchedObjects.begin(), watchedObjects.end(), objectName) ==
+      watchedObjects.end())
+    watchedObjects.push_back(objectName);
+}
+
+void BaseDebugger::UnwatchObjects(const gd::String& objectName) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  watchedObjects.erase(
+      std::remove(watchedObjects.begin(), watchedObjects.end(), objectName),
+      watchedObjects.end());
+}
+
+void BaseDebugger::WatchVariable(const gd::String& variableName) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  if (std::find(watchedVariables.begin(),
+                watchedVariables.end(),
+                variableName) == watchedVariables.end())
+    watchedVariables.push_back(variableName);
+}
+
+void BaseDebugger::UnwatchVariable(const gd::String& variableName) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  watchedVariables.erase(std::remove(watchedVariables.begin(),
+                                     watchedVariables.end(),
+                                     variableName),
+                         watchedVariables.end());
+}
+
+void BaseDebugger::WriteSnapshot(RuntimeScene& scene,
+                                 std::string& snapshot) {
+  std::vector<gd::String> objectNames;
+  std::vector<gd::String> variableNames;
+  {
+    std::lock_guard<std::mutex> lock(snapshotsMutex);
+    objectNames = watchedObjects;
+    variableNames = watchedVariables;
+  }
+
+  // Values are written in the same order for each snapshot, so that the
+  // unchanged ones are removed by the delta encoding.
+  snapshot.clear();
+  SceneSnapshotWriter writer(snapshot);
+  writer.WriteInt(scene.GetTimeManager().GetTimeFromStart());
+
+  writer.WriteUInt(variableNames.size());
+  for (const gd::String& name : variableNames) {
+    writer.WriteString(name);
+    bool exists = scene.GetVariables().Has(name);
+    writer.WriteBool(exists);
+    if (exists) writer.WriteVariable(scene.GetVariables().Get(name));
+  }
+
+  writer.WriteUInt(objectNames.size());
+  for (const gd::String& name : objectNames) {
+    // Objects deleted during the events (having no name) are not written.
+    const RuntimeObjList& objects = scene.objectsInstances.GetObjects(name);
+    std::size_t count = std::count_if(
+        objects.begin(), objects.end(), [](const RuntimeObjSPtr& object) {
+          return !object->GetName().empty();
+        });
+
+    writer.WriteString(name);
+    writer.WriteUInt(count);
+    for (const RuntimeObjSPtr& object : objects) {
+      if (object->GetName().empty()) continue;
+
+      writer.WriteFloat(object->GetX());
+      writer.WriteFloat(object->GetY());
+      writer.WriteFloat(object->GetAngle());
+      writer.WriteFloat(object->GetWidth());
+      writer.WriteFloat(object->GetHeight());
+      writer.WriteInt(object->GetZOrder());
+      writer.WriteBool(object->IsHidden());
+      writer.WriteString(object->GetLayer());
+      writer.WriteVariables(object->GetVariables());
+    }
+  }
+}
+
+void BaseDebugger::PublishSnapshot(const std::string& newSnapshot) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  if (pendingDeltaConsumed) {
+    consumedSnapshot.swap(pendingSnapshot);
+    pendingDeltaConsumed = false;
+  }
+
+  // The delta is from the snapshot that the reader has, so that it stays
+  // valid if the previous delta was not consumed.
+  SceneSnapshot::ComputeDelta(consumedSnapshot, newSnapshot, pendingDelta);
+  pendingSnapshot = newSnapshot;
+  hasPendingDelta = true;
+}
+
+bool BaseDebugger::ConsumeSnapshot(std::string& delta) {
+  std::lock_guard<std::mutex> lock(snapshotsMutex);
+  if (!hasPendingDelta) return false;
+
+  delta.swap(pendingDelta);
+  hasPendingDelta = false;
+  pendingDeltaConsumed = true;
+  return true;
 }
 #endif
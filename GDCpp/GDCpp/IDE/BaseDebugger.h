@@ -1,44 +1,129 @@
 /*
  * GDevelop C++ Platform
- * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
- * This project is released under the MIT License.
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
  */
 
 #if defined(GD_IDE_ONLY)
 #ifndef BASEDEBUGGER_H
 #define BASEDEBUGGER_H
 #include <SFML/System.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
 
 class RuntimeObject;
+class RuntimeScene;
 
 /**
  * \brief Internal base class to implement a debugger.
  * Derive from this class and implement
  * UpdateGUI function which be called
  * automatically by the scene
+ *
+ * The debugger can also take binary snapshots of the watched objects and
+ * variables at a regular interval (see SetSnapshotsInterval), to be read by
+ * another thread with ConsumeSnapshot, without querying the properties of the
+ * objects one by one.
  */
-class GD_API BaseDebugger
-{
-    public:
-        BaseDebugger() {};
-        virtual ~BaseDebugger() {};
+class GD_API BaseDebugger {
+ public:
+  BaseDebugger()
+      : snapshotsInterval(0),
+        hasPendingDelta(false),
+        pendingDeltaConsumed(false){};
+  virtual ~BaseDebugger(){};
 
-        /**
-         * Called at each frame by RuntimeScene
-         */
-        void Update();
+  /**
+   * Called at each frame by RuntimeScene
+   */
+  void Update(RuntimeScene& scene);
 
-        virtual void OnRuntimeObjectAdded(RuntimeObject * object) {};
-        virtual void OnRuntimeObjectAboutToBeRemoved(RuntimeObject * object) {};
+  virtual void OnRuntimeObjectAdded(RuntimeObject* object){};
+  virtual void OnRuntimeObjectAboutToBeRemoved(RuntimeObject* object){};
 
-        virtual void OnRuntimeObjectListFullRefresh() {};
+  virtual void OnRuntimeObjectListFullRefresh(){};
 
-    protected:
-    private:
-        virtual void UpdateGUI() = 0;
+  /**
+   * \name Snapshots
+   * The watched objects and variables can be changed from any thread.
+   */
+  ///@{
+  /**
+   * \brief Set the minimum time between two snapshots, in milliseconds. 0 (the
+   * default) to disable the snapshots.
+   */
+  void SetSnapshotsInterval(float milliseconds) {
+    snapshotsInterval = milliseconds;
+  }
+  float GetSnapshotsInterval() const { return snapshotsInterval; }
 
-        sf::Clock timeInterval;
+  /**
+   * \brief Add the instances of an object to the snapshots.
+   */
+  void WatchObjects(const gd::String& objectName);
+  void UnwatchObjects(const gd::String& objectName);
+
+  /**
+   * \brief Add a variable of the scene to the snapshots.
+   */
+  void WatchVariable(const gd::String& variableName);
+  void UnwatchVariable(const gd::String& variableName);
+
+  /**
+   * \brief Write a snapshot of the watched objects and variables of the scene,
+   * replacing the content of \a snapshot.
+   *
+   * The snapshot contains the time from the start of the scene, followed by
+   * each watched variable (its name and its value, see
+   * SceneSnapshotWriter::WriteVariable, if it exists) and the instances of
+   * each watched object (the object name, the number of instances, and for
+   * each of them its position, angle, size, Z order, visibility, layer and
+   * variables).
+   */
+  void WriteSnapshot(RuntimeScene& scene, std::string& snapshot);
+
+  /**
+   * \brief Make a snapshot available to ConsumeSnapshot.
+   *
+   * Only the difference with the last snapshot consumed is kept (see
+   * SceneSnapshot::ComputeDelta), so that unchanged values are not copied. If
+   * the previous snapshot was not consumed yet, it is replaced.
+   */
+  void PublishSnapshot(const std::string& snapshot);
+
+  /**
+   * \brief Get the last snapshot published, if it was not consumed yet.
+   *
+   * \param delta Replaced by the difference between this snapshot and the one
+   * consumed before (an empty one for the first call), to be applied with
+   * SceneSnapshot::ApplyDelta.
+   * \return false if no snapshot was published since the last call.
+   * \note Can be called from another thread than the game.
+   */
+  bool ConsumeSnapshot(std::string& delta);
+  ///@}
+
+ protected:
+ private:
+  virtual void UpdateGUI() = 0;
+
+  sf::Clock timeInterval;
+
+  float snapshotsInterval;  ///< In milliseconds, 0 to disable snapshots.
+  sf::Clock snapshotsClock;
+  std::string snapshot;  ///< Reused to write the snapshots.
+
+  std::mutex snapshotsMutex;  ///< Protects the members below.
+  std::vector<gd::String> watchedObjects;
+  std::vector<gd::String> watchedVariables;
+  std::string consumedSnapshot;  ///< The snapshot that the reader has.
+  std::string pendingSnapshot;   ///< The snapshot of pendingDelta.
+  std::string pendingDelta;  ///< From consumedSnapshot to pendingSnapshot.
+  bool hasPendingDelta;
+  bool pendingDeltaConsumed;
 };
 
-#endif // BASEDEBUGGER_H
+#endif  // BASEDEBUGGER_H
 #endif
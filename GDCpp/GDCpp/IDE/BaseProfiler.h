@@ -46,6 +46,8 @@ public:
     unsigned long int lastRenderingTime; ///< Time used by rendering during the last frame
     unsigned long int totalSceneTime; ///< Total time used by events and rendering since the beginning.
     unsigned long int totalEventsTime; ///< Total time used by events since the beginning.
+    std::size_t lastDrawnObjectsCount; ///< Number of objects drawn during the last frame (an object drawn by two cameras is counted twice).
+    std::size_t lastCulledObjectsCount; ///< Number of objects not drawn during the last frame because they were outside of the camera.
 
     btClock eventsClock; ///< Used to compute time used by events during the frame
     btClock renderingClock; ///< Used to compute time used by rendering during the frame
@@ -12,13 +12,22 @@
 const std::shared_ptr<BehaviorsRuntimeSharedData>&
 BehaviorsRuntimeSharedDataHolder::GetBehaviorSharedData(
     const gd::String& behaviorName) const {
-  return behaviorsSharedDatas.find(behaviorName)->second;
+  return behaviorsSharedDatas[behaviorsSharedDatasIndex.find(behaviorName)
+                                  ->second];
+}
+
+std::size_t BehaviorsRuntimeSharedDataHolder::GetBehaviorSharedDataIndex(
+    const gd::String& behaviorName) const {
+  auto it = behaviorsSharedDatasIndex.find(behaviorName);
+  return it != behaviorsSharedDatasIndex.end() ? it->second
+                                               : gd::String::npos;
 }
 
 void BehaviorsRuntimeSharedDataHolder::LoadFrom(
     const std::map<gd::String, std::unique_ptr<gd::BehaviorContent>>&
         sharedData) {
   behaviorsSharedDatas.clear();
+  behaviorsSharedDatasIndex.clear();
   for (auto& it : sharedData) {
     const gd::String& type = it.second->GetTypeName();
     const gd::String& name = it.second->GetName();
@@ -27,9 +36,10 @@ void BehaviorsRuntimeSharedDataHolder::LoadFrom(
         CppPlatform::Get().CreateBehaviorsRuntimeSharedData(
             type, it.second->GetContent());
 
-    if (runtimeSharedData)
-      behaviorsSharedDatas[name] = std::move(runtimeSharedData);
-    else
+    if (runtimeSharedData) {
+      behaviorsSharedDatasIndex[name] = behaviorsSharedDatas.size();
+      behaviorsSharedDatas.push_back(std::move(runtimeSharedData));
+    } else
       std::cout << "ERROR: Unable to create shared data for behavior \"" << type
                 << "\".";
   }
@@ -50,11 +60,8 @@ BehaviorsRuntimeSharedDataHolder& BehaviorsRuntimeSharedDataHolder::operator=(
 void BehaviorsRuntimeSharedDataHolder::Init(
     const BehaviorsRuntimeSharedDataHolder& other) {
   behaviorsSharedDatas.clear();
-  for (std::map<gd::String,
-                std::shared_ptr<BehaviorsRuntimeSharedData>>::const_iterator
-           it = other.behaviorsSharedDatas.begin();
-       it != other.behaviorsSharedDatas.end();
-       ++it) {
-    behaviorsSharedDatas[it->first] = it->second->Clone();
-  }
+  for (auto& sharedData : other.behaviorsSharedDatas)
+    behaviorsSharedDatas.push_back(sharedData->Clone());
+
+  behaviorsSharedDatasIndex = other.behaviorsSharedDatasIndex;
 }
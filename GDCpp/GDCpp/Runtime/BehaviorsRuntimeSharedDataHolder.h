@@ -8,6 +8,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "GDCpp/Runtime/String.h"
 class BehaviorsRuntimeSharedData;
 namespace gd {
@@ -16,6 +18,11 @@ class BehaviorContent;
 
 /**
  * \brief Contains all the shared data of the behaviors of a RuntimeScene.
+ *
+ * The shared data are stored in slots, resolved from the names of the
+ * behaviors when the scene is loaded: code getting the shared data often
+ * (for example at the creation of each behavior) can get the index of the slot
+ * once and then access the data without looking up the name.
  */
 class GD_API BehaviorsRuntimeSharedDataHolder {
  public:
@@ -33,6 +40,45 @@ class GD_API BehaviorsRuntimeSharedDataHolder {
   const std::shared_ptr<BehaviorsRuntimeSharedData>& GetBehaviorSharedData(
       const gd::String& behaviorName) const;
 
+  /**
+   * \brief Return the index of the slot of the shared data for a behavior, or
+   * gd::String::npos if the behavior has no shared data.
+   *
+   * The index is valid until the shared data are loaded again, and is the same
+   * for all the scenes loaded from the same layout.
+   */
+  std::size_t GetBehaviorSharedDataIndex(const gd::String& behaviorName) const;
+
+  /**
+   * \brief Return the shared data stored in the slot at the given index,
+   * without taking ownership of it.
+   * \warning No check is made to ensure that the index is valid.
+   */
+  BehaviorsRuntimeSharedData* GetBehaviorSharedData(std::size_t index) const {
+    return behaviorsSharedDatas[index].get();
+  }
+
+  /**
+   * \brief Return the shared data stored in the slot at the given index, cast
+   * to the type T of the shared data of the behavior.
+   * \warning No check is made to ensure that the index and the type are valid.
+   */
+  template <class T>
+  T* GetBehaviorSharedData(std::size_t index) const {
+    return static_cast<T*>(GetBehaviorSharedData(index));
+  }
+
+  /**
+   * \brief Return the shared data for a behavior, cast to the type T of the
+   * shared data of the behavior, or nullptr if the behavior has no shared data.
+   */
+  template <class T>
+  T* GetBehaviorSharedData(const gd::String& behaviorName) const {
+    std::size_t index = GetBehaviorSharedDataIndex(behaviorName);
+    return index != gd::String::npos ? GetBehaviorSharedData<T>(index)
+                                     : nullptr;
+  }
+
   /**
    * \brief Create all runtime shared data according to the shared data content
    * passed as argument.
@@ -44,8 +90,11 @@ class GD_API BehaviorsRuntimeSharedDataHolder {
  private:
   void Init(const BehaviorsRuntimeSharedDataHolder& other);
 
-  std::map<gd::String, std::shared_ptr<BehaviorsRuntimeSharedData>>
-      behaviorsSharedDatas;
+  std::vector<std::shared_ptr<BehaviorsRuntimeSharedData>>
+      behaviorsSharedDatas;  ///< The shared data, by their slot index.
+  std::unordered_map<gd::String, std::size_t>
+      behaviorsSharedDatasIndex;  ///< The slot index of the shared data, by
+                                  ///< the names of the behaviors.
 };
 
 #endif
@@ -0,0 +1,20 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/CachedVariablePath.h"
+
+void CachedVariablePath::Resolve(gd::Variable& variable) {
+  resolvedVariables.clear();
+
+  gd::Variable* current = &variable;
+  for (auto& childName : childrenNames) {
+    gd::Variable& next = current->GetChild(childName);
+    resolvedVariables.push_back(
+        std::make_pair(current, current->GetStructureVersion()));
+    current = &next;
+  }
+
+  child = current;
+}
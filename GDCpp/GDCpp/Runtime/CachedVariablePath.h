@@ -0,0 +1,76 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef CACHEDVARIABLEPATH_H
+#define CACHEDVARIABLEPATH_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief A path to a child of a variable (for example, `b.c` in
+ * `MyVariable.b.c`), resolved once into a pointer to the child.
+ *
+ * The path is resolved again only if the variable is not the same as the last
+ * time, or if a variable of the path had a child removed, renamed or replaced
+ * (see gd::Variable::GetStructureVersion). Otherwise, getting the child is
+ * only a comparison of the structure versions, instead of a search for each
+ * child.
+ *
+ * Used by the code generated from events, as a static variable, for the
+ * children of scene and global variables accessed with their names.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API CachedVariablePath {
+ public:
+  /**
+   * \brief Construct the path from the names of the children, starting from
+   * the child of the variable.
+   */
+  CachedVariablePath(std::vector<gd::String> childrenNames_)
+      : childrenNames(std::move(childrenNames_)), child(nullptr){};
+
+  /**
+   * \brief Return the child of the variable at the end of the path, creating
+   * the missing children as gd::Variable::GetChild does.
+   */
+  gd::Variable& Get(gd::Variable& variable) {
+    if (!resolvedVariables.empty() &&
+        resolvedVariables[0].first == &variable) {
+      // Versions are checked from the variable to the child: if a variable
+      // still has the same version, the next variable of the path is still
+      // its child, and so can be read.
+      bool isUpToDate = true;
+      for (auto& resolvedVariable : resolvedVariables) {
+        if (resolvedVariable.first->GetStructureVersion() !=
+            resolvedVariable.second) {
+          isUpToDate = false;
+          break;
+        }
+      }
+
+      if (isUpToDate) return *child;
+    }
+
+    Resolve(variable);
+    return *child;
+  }
+
+ private:
+  void Resolve(gd::Variable& variable);
+
+  std::vector<gd::String> childrenNames;
+  std::vector<std::pair<gd::Variable*, std::size_t> >
+      resolvedVariables;  ///< The variables of the path (except the child) and
+                          ///< their structure version when the path was
+                          ///< resolved.
+  gd::Variable* child;    ///< The child at the end of the path.
+};
+
+#endif  // CACHEDVARIABLEPATH_H
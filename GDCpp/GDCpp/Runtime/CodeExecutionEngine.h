@@ -21,9 +21,14 @@ signature of the function
 void functionName(RuntimeContext *);
  \endcode
  *
+ * The code of each scene is generated by
+ * EventsCodeGenerator::GenerateSceneEventsCompleteCode, in a function
+ * called "GDSceneEvents" followed by the mangled name of the scene. It is
+ * compiled outside of GDevelop (no compiler is embedded): EventsCodeCache
+ * stores the code of each scene in a file named after its hash, so that the
+ * build only compiles the scenes that changed.
+ *
  * \TODO: This class is unecessarily complicated.
- * \see CodeCompilationHelpers
- * \see CodeCompiler
  *
  * \ingroup CodeExecutionEngine
  */
@@ -0,0 +1,169 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/CollisionMask.h"
+#include <algorithm>
+#include <cmath>
+
+const std::size_t CollisionMasksCache::maxTransformedMasks = 8;
+
+void CollisionMask::Create(int width_, int height_) {
+  width = std::max(width_, 0);
+  height = std::max(height_, 0);
+  wordsPerRow = (width + 63) / 64;
+  bits.assign(static_cast<std::size_t>(wordsPerRow) * height, 0);
+}
+
+void CollisionMask::UpdateRowsSpans() {
+  rowsSpans.assign(height, RowSpan{width, 0});
+  for (int y = 0; y < height; ++y) {
+    const std::uint64_t* row = bits.data() + y * wordsPerRow;
+    RowSpan& span = rowsSpans[y];
+    for (int word = 0; word < wordsPerRow; ++word) {
+      if (!row[word]) continue;
+
+      for (int bit = 0; bit < 64; ++bit) {
+        if ((row[word] >> bit) & 1) {
+          span.begin = std::min(span.begin, word * 64 + bit);
+          span.end = word * 64 + bit + 1;
+        }
+      }
+    }
+  }
+}
+
+CollisionMask::CollisionMask(const sf::Image& image, sf::Uint8 alphaLimit)
+    : offsetX(0), offsetY(0) {
+  Create(image.getSize().x, image.getSize().y);
+
+  const sf::Uint8* pixels = image.getPixelsPtr();
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      if (pixels[(static_cast<std::size_t>(y) * width + x) * 4 + 3] >
+          alphaLimit)
+        bits[y * wordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+  }
+  UpdateRowsSpans();
+}
+
+CollisionMask CollisionMask::Transform(const CollisionMask& mask,
+                                       const sf::Transform& transform) {
+  const float* matrix = transform.getMatrix();
+  double a = matrix[0], c = matrix[4];
+  double b = matrix[1], d = matrix[5];
+
+  CollisionMask result;
+  double determinant = a * d - b * c;
+  if (determinant == 0 || !std::isfinite(determinant)) return result;
+
+  // Find the rectangle containing the corners of the transformed mask.
+  double cornersX[4] = {0, a * mask.width, c * mask.height, 0};
+  double cornersY[4] = {0, b * mask.width, d * mask.height, 0};
+  cornersX[3] = cornersX[1] + cornersX[2];
+  cornersY[3] = cornersY[1] + cornersY[2];
+  double minX = *std::min_element(cornersX, cornersX + 4);
+  double maxX = *std::max_element(cornersX, cornersX + 4);
+  double minY = *std::min_element(cornersY, cornersY + 4);
+  double maxY = *std::max_element(cornersY, cornersY + 4);
+  if (maxX - minX > 1e5 || maxY - minY > 1e5) return result;
+
+  // Rotations of 90 degrees are not exact: ignore tiny errors to avoid adding
+  // an empty column or row.
+  const double epsilon = 1e-4;
+  result.offsetX = static_cast<int>(std::floor(minX + epsilon));
+  result.offsetY = static_cast<int>(std::floor(minY + epsilon));
+  result.Create(static_cast<int>(std::ceil(maxX - epsilon)) - result.offsetX,
+                static_cast<int>(std::ceil(maxY - epsilon)) - result.offsetY);
+
+  // Set each pixel having its center on a pixel set in the mask.
+  for (int y = 0; y < result.height; ++y) {
+    double worldY = y + result.offsetY + 0.5;
+    for (int x = 0; x < result.width; ++x) {
+      double worldX = x + result.offsetX + 0.5;
+      double localX = (d * worldX - c * worldY) / determinant;
+      double localY = (a * worldY - b * worldX) / determinant;
+      if (localX < 0 || localY < 0) continue;
+
+      if (mask.IsSet(static_cast<int>(localX), static_cast<int>(localY)))
+        result.bits[y * result.wordsPerRow + x / 64] |=
+            std::uint64_t(1) << (x % 64);
+    }
+  }
+  result.UpdateRowsSpans();
+
+  return result;
+}
+
+std::uint64_t CollisionMask::GetBits(int y, int x) const {
+  if (x >= width || x <= -64) return 0;
+
+  const std::uint64_t* row = bits.data() + y * wordsPerRow;
+  if (x < 0) return row[0] << (-x);
+
+  int word = x / 64;
+  int shift = x % 64;
+  std::uint64_t result = row[word] >> shift;
+  if (shift != 0 && word + 1 < wordsPerRow)
+    result |= row[word + 1] << (64 - shift);
+
+  return result;
+}
+
+bool CollisionMask::AreOverlapping(const CollisionMask& a,
+                                   int ax,
+                                   int ay,
+                                   const CollisionMask& b,
+                                   int bx,
+                                   int by) {
+  int top = std::max(ay, by);
+  int bottom = std::min(ay + a.height, by + b.height);
+  for (int y = top; y < bottom; ++y) {
+    const RowSpan& spanA = a.rowsSpans[y - ay];
+    const RowSpan& spanB = b.rowsSpans[y - by];
+    int begin = std::max(ax + spanA.begin, bx + spanB.begin);
+    int end = std::min(ax + spanA.end, bx + spanB.end);
+    for (int x = begin; x < end; x += 64) {
+      std::uint64_t overlap =
+          a.GetBits(y - ay, x - ax) & b.GetBits(y - by, x - bx);
+      if (overlap) return true;
+    }
+  }
+
+  return false;
+}
+
+CollisionMasksCache::CollisionMasksCache(const sf::Image& image,
+                                         sf::Uint8 alphaLimit)
+    : mask(std::make_shared<CollisionMask>(image, alphaLimit)) {}
+
+std::shared_ptr<const CollisionMask> CollisionMasksCache::GetMask(
+    const sf::Transform& transform) {
+  const float* matrix = transform.getMatrix();
+  if (matrix[0] == 1 && matrix[4] == 0 && matrix[1] == 0 && matrix[5] == 1)
+    return mask;
+
+  for (auto& transformedMask : transformedMasks) {
+    if (transformedMask.matrix[0] == matrix[0] &&
+        transformedMask.matrix[1] == matrix[4] &&
+        transformedMask.matrix[2] == matrix[1] &&
+        transformedMask.matrix[3] == matrix[5])
+      return transformedMask.mask;
+  }
+
+  if (transformedMasks.size() >= maxTransformedMasks)
+    transformedMasks.erase(transformedMasks.begin());
+
+  TransformedMask transformedMask;
+  transformedMask.matrix[0] = matrix[0];
+  transformedMask.matrix[1] = matrix[4];
+  transformedMask.matrix[2] = matrix[1];
+  transformedMask.matrix[3] = matrix[5];
+  transformedMask.mask = std::make_shared<CollisionMask>(
+      CollisionMask::Transform(*mask, transform));
+  transformedMasks.push_back(transformedMask);
+
+  return transformedMask.mask;
+}
@@ -0,0 +1,148 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef COLLISIONMASK_H
+#define COLLISIONMASK_H
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * \brief The opaque pixels of an image, stored as bits (64 pixels of a row
+ * for each word), used for pixel perfect collisions.
+ *
+ * The mask can be the one of a transformed image (rotated, scaled or
+ * flipped): it is then the image drawn with the transformation, in a
+ * rectangle starting at (GetOffsetX(), GetOffsetY()) from the translation of
+ * the transformation.
+ *
+ * \see CollisionMasksCache
+ * \ingroup GameEngine
+ */
+class GD_API CollisionMask {
+ public:
+  CollisionMask()
+      : width(0), height(0), wordsPerRow(0), offsetX(0), offsetY(0){};
+
+  /**
+   * \brief Construct the mask of the pixels of the image having an alpha
+   * greater than \a alphaLimit.
+   */
+  CollisionMask(const sf::Image& image, sf::Uint8 alphaLimit);
+
+  /**
+   * \brief Construct the mask of \a mask, drawn with the rotation, scale and
+   * flipping of \a transform (the translation is ignored).
+   *
+   * Each pixel is set if the center of the pixel is on a pixel set in \a mask.
+   */
+  static CollisionMask Transform(const CollisionMask& mask,
+                                 const sf::Transform& transform);
+
+  int GetWidth() const { return width; }
+  int GetHeight() const { return height; }
+
+  /**
+   * \brief Return the position of the mask, relative to the translation of the
+   * transformation used to create it.
+   */
+  int GetOffsetX() const { return offsetX; }
+  int GetOffsetY() const { return offsetY; }
+
+  /**
+   * \brief Return true if the pixel is in the mask and set.
+   */
+  bool IsSet(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return (bits[y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+  }
+
+  /**
+   * \brief Return true if the two masks have a pixel set at the same
+   * position, the pixel (0, 0) of the masks being at the given positions.
+   *
+   * Rows are compared 64 pixels at once, and only on the part of the rows
+   * between their first and last pixels set.
+   */
+  static bool AreOverlapping(const CollisionMask& a,
+                             int ax,
+                             int ay,
+                             const CollisionMask& b,
+                             int bx,
+                             int by);
+
+ private:
+  /**
+   * \brief The pixels of a row between the first pixel set (included) and the
+   * last one (excluded). \a begin is greater than \a end for empty rows.
+   */
+  struct RowSpan {
+    int begin;
+    int end;
+  };
+
+  void Create(int width_, int height_);
+  void UpdateRowsSpans();
+
+  /**
+   * \brief Return the 64 pixels of the row starting at \a x, the first one
+   * being the lowest bit. Pixels outside of the mask are not set.
+   */
+  std::uint64_t GetBits(int y, int x) const;
+
+  int width;
+  int height;
+  int wordsPerRow;
+  int offsetX;
+  int offsetY;
+  std::vector<std::uint64_t> bits;
+  std::vector<RowSpan> rowsSpans;
+};
+
+/**
+ * \brief The collision masks of an image: the mask of the image itself, and
+ * the masks of the image drawn with the last transformations used.
+ *
+ * Stored in the SFMLTextureWrapper of the image (see
+ * SFMLTextureWrapper::collisionMasks), created the first time a pixel perfect
+ * collision is tested with the image.
+ *
+ * \see CollisionMask
+ * \ingroup GameEngine
+ */
+class GD_API CollisionMasksCache {
+ public:
+  /**
+   * \brief Construct the masks of the image, where pixels are set if they have
+   * an alpha greater than \a alphaLimit.
+   */
+  CollisionMasksCache(const sf::Image& image, sf::Uint8 alphaLimit);
+
+  /**
+   * \brief Get the mask of the image drawn with the rotation, scale and
+   * flipping of \a transform.
+   *
+   * The masks of a few transformations are kept, so that objects that are not
+   * rotated or scaled from a frame to another don't need a new mask.
+   */
+  std::shared_ptr<const CollisionMask> GetMask(const sf::Transform& transform);
+
+ private:
+  struct TransformedMask {
+    float matrix[4];  ///< The rotation, scale and flipping part of the
+                      ///< transformation.
+    std::shared_ptr<const CollisionMask> mask;
+  };
+
+  std::shared_ptr<const CollisionMask> mask;
+  std::vector<TransformedMask> transformedMasks;  ///< The oldest first.
+
+  static const std::size_t maxTransformedMasks;
+};
+
+#endif  // COLLISIONMASK_H
@@ -5,64 +5,60 @@
  */
 #include "GDCpp/Runtime/Collisions.h"
 #include <SFML/Graphics.hpp>
+#include <cmath>
 #include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
 #include "GDCore/Project/ImageManager.h"
+#include "GDCpp/Runtime/CollisionMask.h"
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
 
-bool PixelPerfectTest(const sf::Sprite& object1,
-                      const sf::Sprite& object2,
-                      sf::Uint8 AlphaLimit,
-                      const sf::Image& object1CollisionMask,
-                      const sf::Image& object2CollisionMask) {
-  sf::FloatRect intersection;
-  if (object1.getGlobalBounds().intersects(object2.getGlobalBounds(),
-                                           intersection)) {
-    // We've got an intersection we need to process the pixels
-    // in that Rect.
+namespace {
 
-    // Bail out now if AlphaLimit = 0
-    if (AlphaLimit == 0) return true;
+/**
+ * \brief The alpha above which a pixel is considered as opaque for the
+ * collisions.
+ */
+const sf::Uint8 alphaLimit = 1;
 
-    // There are a few hacks here, sometimes the TransformToLocal returns
-    // negative points Or Points outside the image.  We need to check for these
-    // as they print to the error console which is slow, and then return black
-    // which registers as a hit.
+/**
+ * \brief Get the mask of the sprite, drawn with its rotation, scale
+ * and flipping, and the position of the mask in the scene.
+ *
+ * The position of the sprite is rounded to the nearest pixel, so that the masks
+ * of the sprites can be compared row by row.
+ */
+std::shared_ptr<const CollisionMask> GetCollisionMask(
+    const sf::Sprite& sprite, SFMLTextureWrapper& texture, int& x, int& y) {
+  if (!texture.collisionMasks)
+    texture.collisionMasks =
+        std::make_shared<CollisionMasksCache>(texture.image, alphaLimit);
 
-    sf::Vector2f o1v;
-    sf::Vector2f o2v;
-    // Loop through our pixels
-    for (int i = intersection.left; i < intersection.left + intersection.width;
-         i++)  // 4ian : Rect now uses width/height.
-    {
-      for (int j = intersection.top; j < intersection.top + intersection.height;
-           j++)  // 4ian : Rect now uses width/height.
-      {
-        o1v = object1.getInverseTransform().transformPoint(
-            i, j);  // Creating objects each loop :(
-        o2v = object2.getInverseTransform().transformPoint(i, j);
+  const sf::Transform& transform = sprite.getTransform();
+  std::shared_ptr<const CollisionMask> mask =
+      texture.collisionMasks->GetMask(transform);
 
-        // Hack to make sure pixels fall within the Sprite's Image
-        if (o1v.x > 0 && o1v.y > 0 && o2v.x > 0 && o2v.y > 0 &&
-            o1v.x < object1CollisionMask.getSize().x &&
-            o1v.y < object1CollisionMask.getSize().y &&
-            o2v.x < object2CollisionMask.getSize().x &&
-            o2v.y < object2CollisionMask.getSize().y) {
-          // If both sprites have opaque pixels at the same point we've got a
-          // hit
-          if ((object1CollisionMask
-                   .getPixel(static_cast<int>(o1v.x), static_cast<int>(o1v.y))
-                   .a > AlphaLimit) &&
-              (object2CollisionMask
-                   .getPixel(static_cast<int>(o2v.x), static_cast<int>(o2v.y))
-                   .a > AlphaLimit)) {
-            return true;
-          }
-        }
-      }
-    }
+  const float* matrix = transform.getMatrix();
+  x = static_cast<int>(std::floor(matrix[12] + 0.5f)) + mask->GetOffsetX();
+  y = static_cast<int>(std::floor(matrix[13] + 0.5f)) + mask->GetOffsetY();
+  return mask;
+}
+
+}  // namespace
+
+bool PixelPerfectTest(const sf::Sprite& object1,
+                      const sf::Sprite& object2,
+                      SFMLTextureWrapper& object1Texture,
+                      SFMLTextureWrapper& object2Texture) {
+  if (!object1.getGlobalBounds().intersects(object2.getGlobalBounds()))
     return false;
-  }
-  return false;
+
+  // Compare the opaque pixels of the images, as drawn in the scene.
+  int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+  std::shared_ptr<const CollisionMask> mask1 =
+      GetCollisionMask(object1, object1Texture, x1, y1);
+  std::shared_ptr<const CollisionMask> mask2 =
+      GetCollisionMask(object2, object2Texture, x2, y2);
+
+  return CollisionMask::AreOverlapping(*mask1, x1, y1, *mask2, x2, y2);
 }
 
 /**
@@ -72,7 +68,6 @@ bool GD_API CheckCollision(const RuntimeSpriteObject* const objet1,
                            const RuntimeSpriteObject* const objet2) {
   return PixelPerfectTest(objet1->GetCurrentSFMLSprite(),
                           objet2->GetCurrentSFMLSprite(),
-                          1,
-                          objet1->GetCurrentSprite().GetSFMLTexture()->image,
-                          objet2->GetCurrentSprite().GetSFMLTexture()->image);
+                          *objet1->GetCurrentSprite().GetSFMLTexture(),
+                          *objet2->GetCurrentSprite().GetSFMLTexture());
 }
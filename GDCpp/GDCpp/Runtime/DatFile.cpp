@@ -1,202 +1,287 @@
-
 #include "GDCpp/Runtime/DatFile.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include "GDCpp/Runtime/Tools/FileStream.h"
+#if defined(WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+uint64_t AlignedOffset(uint64_t offset) {
+  return (offset + DatFile::alignment - 1) / DatFile::alignment *
+         DatFile::alignment;
+}
+}  // namespace
 
-DatFile::DatFile(void) { m_buffer = NULL; }
+DatFile::DatFile(void)
+    : m_data(NULL),
+      m_size(0),
+      m_header(NULL),
+      m_entries(NULL),
+      m_names(NULL),
+      m_fileHandle(NULL),
+      m_mappingHandle(NULL) {}
 
-DatFile::~DatFile(void) {
-  if (m_buffer != NULL) delete[] m_buffer;
+DatFile::~DatFile(void) { Close(); }
+
+uint64_t DatFile::Hash(const char* name, std::size_t size) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
 }
+
 bool DatFile::Create(std::vector<gd::String> files,
                      gd::String directory,
                      gd::String destination) {
-  // An file entry in order to push it in the object's std::vector
-  sFileEntry entry;
   // An input file stream to read each file included
   gd::FileStream file;
   // An output file stream to write our DAT file
   gd::FileStream datfile;
-  // The buffer used to read/write the DAT file
-  char buffer[1];
 
   // DATHeader
+  sDATHeader header;
   // We start by filling it with 0
-  memset(&m_header, 0, sizeof(m_header));
+  memset(&header, 0, sizeof(header));
   // Then we copy the ID
-  memcpy(m_header.uniqueID, "EXEGD", 5);  // EXEcutable GDevelop
+  memcpy(header.uniqueID, "EXEGD", 5);  // EXEcutable GDevelop
   // Then the version
-  memcpy(m_header.version, "0.1", 3);
+  memcpy(header.version, "0.2", 3);
   // Then the number of files to include
-  m_header.nb_files = files.size();
+  header.nb_files = files.size();
 
-  // Next, we open each file in orderto create the File Entries Table
+  // Next, we open each file in order to create the File Entries Table
+  std::vector<sFileEntry> entries;
+  std::string names;
   for (std::size_t i = 0; i < files.size(); i++) {
     gd::String fileToOpen = directory + "/" + files[i];
     file.open(fileToOpen, std::ios_base::in | std::ios_base::binary);
-    if (file.is_open()) {
-      // Filling the FileEntry with 0
-      memset(&entry, 0, sizeof(sFileEntry));
-      // We keep the file name
-      memcpy(entry.name, files[i].c_str(), strlen(files[i].c_str()));
-      // We calculate its size
-      file.seekg(0, std::ios::end);
-      entry.size = file.tellg();
-      // Since we don't know exactly its final position in the DAT file, let's
-      // use 0
-      entry.offset = 0;
-      // We finished with this file
-      file.close();
-
-      // Finally, we add this File Entry in our std::vector
-      m_entries.push_back(entry);
-    } else {
+    if (!file.is_open()) {
       // Simple error track
       std::cout << "File " << files[i] << " raise an error." << std::endl;
       return (false);
     }
+
+    // Filling the FileEntry with 0
+    sFileEntry entry;
+    memset(&entry, 0, sizeof(sFileEntry));
+    // We keep the file name, in the names table
+    const std::string& name = files[i].Raw();
+    entry.hash = Hash(name.data(), name.size());
+    entry.name_offset = names.size();
+    entry.name_size = name.size();
+    names += name;
+    // We calculate its size
+    file.seekg(0, std::ios::end);
+    entry.size = file.tellg();
+    // We finished with this file
+    file.close();
+
+    entries.push_back(entry);
   }
+  header.names_size = names.size();
+
+  // Entries are sorted by hashes so that files can be found quickly.
+  std::vector<std::size_t> order(files.size());
+  for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::stable_sort(
+      order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return entries[a].hash < entries[b].hash;
+      });
 
   // Now, we know everything about our files, we can update offsets
-  long actual_offset = 0;
-  actual_offset += sizeof(sDATHeader);
-  actual_offset += m_header.nb_files * sizeof(sFileEntry);
-  for (std::size_t i = 0; i < m_entries.size(); i++) {
-    m_entries[i].offset = actual_offset;
-    actual_offset += m_entries[i].size;
+  uint64_t actual_offset = sizeof(sDATHeader) +
+                           entries.size() * sizeof(sFileEntry) + names.size();
+  for (std::size_t i : order) {
+    entries[i].offset = AlignedOffset(actual_offset);
+    actual_offset = entries[i].offset + entries[i].size;
   }
 
   // And finally, we are writing the DAT file
   datfile.open(destination, std::ios_base::out | std::ios_base::binary);
+  if (!datfile.is_open()) return false;
 
   // First, we write the header
-  datfile.write((char*)&m_header, sizeof(sDATHeader));
+  datfile.write((char*)&header, sizeof(sDATHeader));
 
-  // Then, the File Entries Table
-  for (std::size_t i = 0; i < m_entries.size(); i++) {
-    datfile.write((char*)&m_entries[i], sizeof(sFileEntry));
+  // Then, the File Entries Table and the names
+  for (std::size_t i : order) {
+    datfile.write((char*)&entries[i], sizeof(sFileEntry));
   }
+  datfile.write(names.data(), names.size());
+
+  // Finally, we write each file, padded so that it is aligned
+  const char padding[alignment] = {0};
+  uint64_t written = sizeof(sDATHeader) + entries.size() * sizeof(sFileEntry) +
+                     names.size();
+  for (std::size_t i : order) {
+    datfile.write(padding, entries[i].offset - written);
+    written = entries[i].offset;
 
-  // Finally, we write each file
-  for (std::size_t i = 0; i < m_entries.size(); i++) {
     gd::String fileToOpen = directory + "/" + files[i];
     file.open(fileToOpen, std::ios_base::in | std::ios_base::binary);
     if (file.is_open()) {
       file.seekg(0, std::ios::beg);
-      datfile << file.rdbuf();
+      if (entries[i].size > 0) datfile << file.rdbuf();
       file.close();
     }
+    written += entries[i].size;
   }
+  // The end of the last file is padded too, so that blocks of
+  // DatFile::alignment bytes can always be read.
+  datfile.write(padding, AlignedOffset(written) - written);
+
   // And it's finished
   datfile.close();
-  return true;
+  return static_cast<bool>(datfile);
 }
 
 /**
  * Load the DatFile from a file. Return true on success
  */
 bool DatFile::Read(gd::String source) {
-  bool success = false;
+  Close();
 
-  // The input file stream from which we want informations
-  gd::FileStream datfile;
-  // A file entry in order to push it in the object's std::vector
-  sFileEntry entry;
-
-  // Filling the header with 0
-  memset(&m_header, 0, sizeof(m_header));
-  // We open the DAT file to read it
-  datfile.open(source, std::ios_base::in | std::ios_base::binary);
-  if (datfile.is_open()) {
-    // Getting to the Header position
-    datfile.seekg(0, std::ios::beg);
-    // Reading the DAT Header
-    datfile.read((char*)&m_header, sizeof(sDATHeader));
-    // Next we are reading each file entry
-    for (std::size_t i = 0; i < m_header.nb_files; i++) {
-      // Reading a File Entry
-      datfile.read((char*)&entry, sizeof(sFileEntry));
-      // Pushing it in our std::vector
-      m_entries.push_back(entry);
+  // Map the whole DAT file in memory
+#if defined(WINDOWS)
+  HANDLE file = CreateFileW(source.ToWide().c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            NULL,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            NULL);
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = NULL;
+  void* data = NULL;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping) data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data) {
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  m_fileHandle = file;
+  m_mappingHandle = mapping;
+  m_size = fileSize.QuadPart;
+#else
+  int file = open(source.ToLocale().c_str(), O_RDONLY);
+  if (file == -1) return false;
+
+  struct stat fileStat;
+  void* data = MAP_FAILED;
+  if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);  // The mapping stays valid.
+  if (data == MAP_FAILED) return false;
+
+  m_size = fileStat.st_size;
+#endif
+  m_data = static_cast<const char*>(data);
+
+  // Check the header and the File Entries Table, to be sure that files can
+  // be read from the mapping without checking anything else.
+  bool valid = false;
+  if (m_size >= sizeof(sDATHeader)) {
+    m_header = reinterpret_cast<const sDATHeader*>(m_data);
+    uint64_t namesOffset =
+        sizeof(sDATHeader) + uint64_t(m_header->nb_files) * sizeof(sFileEntry);
+    valid = memcmp(m_header->uniqueID, "EXEGD", 5) == 0 &&
+            memcmp(m_header->version, "0.2", 3) == 0 &&
+            namesOffset + m_header->names_size <= m_size;
+    if (valid) {
+      m_entries =
+          reinterpret_cast<const sFileEntry*>(m_data + sizeof(sDATHeader));
+      m_names = m_data + namesOffset;
+      for (std::size_t i = 0; i < m_header->nb_files && valid; i++) {
+        const sFileEntry& entry = m_entries[i];
+        valid = entry.offset <= m_size && entry.size <= m_size - entry.offset &&
+                uint64_t(entry.name_offset) + entry.name_size <=
+                    m_header->names_size &&
+                (i == 0 || m_entries[i - 1].hash <= entry.hash);
+      }
     }
-    // Since all seems ok, we keep the DAT file name
-    m_datfile = source;
-    success = true;
   }
-  // Closing the DAT file
-  datfile.close();
-  return success;
-}
+  if (!valid) {
+    cout << "Invalid or unsupported resource file: " << source << endl;
+    Close();
+    return false;
+  }
 
-////////////////////////////////////////////////////////////
-/// Check if the DatFile contains a file
-////////////////////////////////////////////////////////////
-bool DatFile::ContainsFile(const gd::String& filename) {
-  if (m_header.nb_files != m_entries.size()) return false;
+  // Since all seems ok, we keep the DAT file name
+  m_datfile = source;
+  return true;
+}
 
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    if (gd::String(m_entries[i].name) == filename) return true;
+void DatFile::Close() {
+  if (m_data != NULL) {
+#if defined(WINDOWS)
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+#else
+    munmap(const_cast<char*>(m_data), m_size);
+#endif
   }
 
-  return false;
+  m_datfile.clear();
+  m_data = NULL;
+  m_size = 0;
+  m_header = NULL;
+  m_entries = NULL;
+  m_names = NULL;
+  m_fileHandle = NULL;
+  m_mappingHandle = NULL;
 }
 
-char* DatFile::GetFile(gd::String filename) {
-  // The input file stream from which we want information
-  gd::FileStream datfile;
+const sFileEntry* DatFile::FindEntry(const gd::String& filename) const {
+  if (m_header == NULL) return NULL;
 
-  // Cleaning properly an ancient file loaded
-  if (m_buffer != NULL) {
-    delete[] m_buffer;
-    m_buffer = NULL;
+  const std::string& name = filename.Raw();
+  uint64_t hash = Hash(name.data(), name.size());
+  const sFileEntry* end = m_entries + m_header->nb_files;
+  const sFileEntry* entry = std::lower_bound(
+      m_entries, end, hash, [](const sFileEntry& entry, uint64_t hash) {
+        return entry.hash < hash;
+      });
+  for (; entry != end && entry->hash == hash; ++entry) {
+    if (entry->name_size == name.size() &&
+        memcmp(m_names + entry->name_offset, name.data(), name.size()) == 0)
+      return entry;
   }
 
-  // First, we have to find the file needed
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    // If we found it
-    if (gd::String(m_entries[i].name) == filename) {
-      // We are allocating memory to the buffer
-      m_buffer = new char[(m_entries[i].size)];
-      // Simple error catch
-      if (m_buffer == NULL) {
-        cout << "Unable to allocate a buffer of length " << (m_entries[i].size)
-             << " when loading " << filename << endl;
-        return (NULL);
-      }
+  return NULL;
+}
 
-      // Opening the DAT file ot read the file datas needed
-      datfile.open(m_datfile, std::ios_base::in | std::ios_base::binary);
-      if (datfile.is_open()) {
-        // Going to the right position
-        datfile.seekg(m_entries[i].offset, std::ios::beg);
-        // Reading
-        datfile.read(m_buffer, m_entries[i].size);
-        // We can close the DAT file
-        datfile.close();
-        // Returning the buffer
-        cout << "Successfully loaded " << filename << endl;
-        return (m_buffer);
-      }
-      cout << "Unable to open file " << m_datfile << " when loading "
-           << filename << endl;
-    }
-  }
-  // Finally, there is no such file in our DAT file
-  return (NULL);
+////////////////////////////////////////////////////////////
+/// Check if the DatFile contains a file
+////////////////////////////////////////////////////////////
+bool DatFile::ContainsFile(const gd::String& filename) const {
+  return FindEntry(filename) != NULL;
 }
 
-long int DatFile::GetFileSize(gd::String filename) {
-  // First, we have to find the file needed
-  for (std::size_t i = 0; i < m_header.nb_files; i++) {
-    // If we found it
-    if (gd::String(m_entries[i].name) == filename) {
-      // Returning the size of the file found
-      return (m_entries[i].size);
-    }
-  }
-  return (0);
+const char* DatFile::GetFile(const gd::String& filename) const {
+  const sFileEntry* entry = FindEntry(filename);
+  return entry ? m_data + entry->offset : NULL;
+}
+
+long int DatFile::GetFileSize(const gd::String& filename) const {
+  const sFileEntry* entry = FindEntry(filename);
+  return entry ? entry->size : 0;
 }
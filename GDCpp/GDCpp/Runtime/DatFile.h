@@ -8,6 +8,7 @@
 #ifndef DATFILE_H
 #define DATFILE_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "GDCpp/Runtime/String.h"
@@ -23,7 +24,8 @@ struct sDATHeader {
   char uniqueID[5];  /// Unique ID used to know if this file is a DAT File from
                      /// this class
   char version[3];   /// Version of the DAT file format
-  unsigned int nb_files;  /// Number of files in the DAT file
+  uint32_t nb_files;    /// Number of files in the DAT file
+  uint32_t names_size;  /// Size of the names table, following the entries
 };
 
 /**
@@ -32,32 +34,71 @@ struct sDATHeader {
  * \ingroup ResourcesManagement
  */
 struct sFileEntry {
-  char name[1024];  /// Name of the data file
-  long size;        /// Size of the data file
-  long offset;      /// Offset, in the DAT file where the file is
+  uint64_t hash;         /// Hash of the name (entries are sorted by hashes)
+  uint64_t offset;       /// Offset, in the DAT file where the file is
+  uint64_t size;         /// Size of the data file
+  uint32_t name_offset;  /// Offset of the name in the names table
+  uint32_t name_size;    /// Size of the name, in bytes
 };
 
 /**
  * \brief Internal class used to create and access "DAT files".
  *
+ * The DAT file is mapped in memory when read: the content of files is not
+ * copied and can be decoded directly from the mapping. Files are found with
+ * the hashes of their names, and their contents are aligned on
+ * DatFile::alignment bytes.
+ *
  * \ingroup ResourcesManagement
  */
 class GD_API DatFile {
  private:
-  gd::String m_datfile;               /// name of the DAT file
-  sDATHeader m_header;                /// file header
-  std::vector<sFileEntry> m_entries;  /// vector of files entries
-  char* m_buffer;                     /// Buffer pointing on a file in memory
+  gd::String m_datfile;         /// name of the DAT file
+  const char* m_data;           /// The DAT file mapped in memory
+  std::size_t m_size;           /// Size of the DAT file
+  const sDATHeader* m_header;   /// file header, in the mapping
+  const sFileEntry* m_entries;  /// files entries, in the mapping
+  const char* m_names;          /// names of the files, in the mapping
+  void* m_fileHandle;           /// Platform specific handles of the mapping
+  void* m_mappingHandle;
+
+  const sFileEntry* FindEntry(const gd::String& filename) const;
+  static uint64_t Hash(const char* name, std::size_t size);
+
  public:
+  static const std::size_t alignment = 16;  ///< Alignment of the contents
+
   DatFile(void);
+  DatFile(const DatFile&) = delete;
+  DatFile& operator=(const DatFile&) = delete;
   ~DatFile(void);
   bool Create(std::vector<gd::String> files,
               gd::String directory,
               gd::String destination);
-  bool ContainsFile(const gd::String& filename);
+
+  /**
+   * \brief Map the DAT file in memory, closing the previous one (if any).
+   * \return true if the file is a valid DAT file.
+   */
   bool Read(gd::String source);
-  char* GetFile(gd::String filename);
-  long int GetFileSize(gd::String filename);
+
+  /**
+   * \brief Unmap the DAT file. Pointers returned by GetFile are not valid
+   * anymore.
+   */
+  void Close();
+
+  bool ContainsFile(const gd::String& filename) const;
+
+  /**
+   * \brief Return a pointer to the content of a file, or NULL if the file is
+   * not in the DAT file.
+   *
+   * The content is not copied: it stays valid until the DAT file is closed,
+   * and can be read by several threads at the same time.
+   */
+  const char* GetFile(const gd::String& filename) const;
+  long int GetFileSize(const gd::String& filename) const;
 };
 
 #endif  // DATFILE_H
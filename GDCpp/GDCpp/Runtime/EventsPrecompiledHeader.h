@@ -1,5 +1,6 @@
-// This file contains some common includes and is automatically used for each
-// source file compiled within GDevelop
+// This file contains some common includes and is included first by the code
+// generated for the events, so that it can be precompiled once for all the
+// scenes (see EventsCodeCache).
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/System/Clock.hpp>
 #include <SFML/System/Vector2.hpp>
@@ -22,6 +22,8 @@ void FontManager::UnloadAllFonts() {
 
   fonts.clear();
   fontsBuffer.clear();
+  smoothGlyphAtlas.Clear();
+  glyphAtlas.Clear();
   if (defaultFont) delete defaultFont;
   defaultFont = nullptr;
 }
@@ -6,8 +6,10 @@
 #ifndef FONTMANAGER_H
 #define FONTMANAGER_H
 #include <SFML/Graphics.hpp>
+#include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/GlyphAtlas.h"
 #include "GDCpp/Runtime/ResourcesLoader.h"
 #include "GDCpp/Runtime/String.h"
 
@@ -30,6 +32,15 @@ class GD_API FontManager {
    */
   const sf::Font* GetFont(const gd::String& fontName);
 
+  /**
+   * \brief Return the atlas where the glyphs of all the fonts are packed.
+   *
+   * \param smooth true to get the atlas whose textures are smoothed.
+   */
+  GlyphAtlas& GetGlyphAtlas(bool smooth) {
+    return smooth ? smoothGlyphAtlas : glyphAtlas;
+  }
+
   /**
    * \brief Unload all fonts from memory
    */
@@ -59,8 +70,11 @@ class GD_API FontManager {
       fontsBuffer;        ///< The buffer associated to each font, if any.
   sf::Font* defaultFont;  ///< The default font used when no font is specified.
                           ///< Initialized at first use.
+  GlyphAtlas smoothGlyphAtlas;
+  GlyphAtlas glyphAtlas;
 
-  FontManager() : defaultFont(NULL){};
+  FontManager()
+      : defaultFont(NULL), smoothGlyphAtlas(true), glyphAtlas(false){};
   virtual ~FontManager();
 
   static FontManager* _singleton;
@@ -0,0 +1,133 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer::FramePacer(std::size_t framesCapacity_)
+    : targetFPS(0),
+      frameStarted(false),
+      lastFrameTime(0),
+      framesCapacity(std::max<std::size_t>(framesCapacity_, 1)),
+      framesCount(0),
+      frameTimes(framesCapacity, 0),
+      workTimes(framesCapacity, 0),
+      missedDeadlinesCount(0),
+      sleepsCount(0),
+      sleepsMean(0),
+      sleepsM2(0) {}
+
+void FramePacer::BeginFrame() {
+  Clock::time_point now = Clock::now();
+  if (!frameStarted) {
+    frameStarted = true;
+    frameStart = now;
+    workStart = now;
+    lastFrameTime = 0;
+    return;
+  }
+
+  Clock::time_point previousStart = frameStart;
+  if (targetFPS > 0) {
+    Clock::duration frameDuration =
+        std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::micro>(1000000.0 / targetFPS));
+    Clock::time_point deadline = frameStart + frameDuration;
+    if (now < deadline) {
+      WaitUntil(deadline);
+      frameStart = deadline;
+    } else {
+      missedDeadlinesCount++;
+      // Catching up with the missed deadlines would make the next frames too
+      // short.
+      frameStart = now - deadline < frameDuration ? deadline : now;
+    }
+  } else {
+    frameStart = now;
+  }
+
+  workStart = Clock::now();
+  lastFrameTime = ToMicroseconds(frameStart - previousStart);
+}
+
+void FramePacer::EndFrame() {
+  // The first frame is not recorded, as it has no frame time.
+  if (lastFrameTime == 0) return;
+
+  frameTimes[framesCount % framesCapacity] = lastFrameTime;
+  workTimes[framesCount % framesCapacity] =
+      ToMicroseconds(Clock::now() - workStart);
+  framesCount++;
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline) {
+  Clock::time_point now = Clock::now();
+  while (ToMicroseconds(deadline - now) > GetSleepEstimate()) {
+    Clock::time_point beforeSleep = now;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    now = Clock::now();
+
+    double duration = ToMicroseconds(now - beforeSleep);
+    sleepsCount++;
+    double delta = duration - sleepsMean;
+    sleepsMean += delta / sleepsCount;
+    sleepsM2 += delta * (duration - sleepsMean);
+  }
+
+  while (Clock::now() < deadline) {
+  }
+}
+
+double FramePacer::GetSleepEstimate() const {
+  // Be conservative until the sleeps were measured.
+  if (sleepsCount < 2) return 2000;
+
+  return sleepsMean + std::sqrt(sleepsM2 / (sleepsCount - 1));
+}
+
+FramePacer::Statistics FramePacer::GetStatistics() const {
+  Statistics statistics;
+  statistics.framesCount = std::min(framesCount, framesCapacity);
+  statistics.averageFrameTime = 0;
+  statistics.minimumFrameTime = 0;
+  statistics.maximumFrameTime = 0;
+  statistics.frameTimeDeviation = 0;
+  statistics.averageWorkTime = 0;
+  statistics.maximumWorkTime = 0;
+  statistics.missedDeadlinesCount = missedDeadlinesCount;
+  if (statistics.framesCount == 0) return statistics;
+
+  statistics.minimumFrameTime = frameTimes[0];
+  for (std::size_t i = 0; i < statistics.framesCount; ++i) {
+    double frameTime = frameTimes[i];
+    statistics.averageFrameTime += frameTime;
+    statistics.minimumFrameTime =
+        std::min(statistics.minimumFrameTime, frameTime);
+    statistics.maximumFrameTime =
+        std::max(statistics.maximumFrameTime, frameTime);
+    statistics.averageWorkTime += workTimes[i];
+    statistics.maximumWorkTime =
+        std::max(statistics.maximumWorkTime, double(workTimes[i]));
+  }
+  statistics.averageFrameTime /= statistics.framesCount;
+  statistics.averageWorkTime /= statistics.framesCount;
+
+  double variance = 0;
+  for (std::size_t i = 0; i < statistics.framesCount; ++i) {
+    double delta = frameTimes[i] - statistics.averageFrameTime;
+    variance += delta * delta;
+  }
+  statistics.frameTimeDeviation =
+      std::sqrt(variance / statistics.framesCount);
+
+  return statistics;
+}
+
+void FramePacer::ResetStatistics() {
+  framesCount = 0;
+  missedDeadlinesCount = 0;
+}
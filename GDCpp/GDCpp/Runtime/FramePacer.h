@@ -0,0 +1,133 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_FRAMEPACER_H
+#define GDCPP_FRAMEPACER_H
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/**
+ * \brief Wait for the deadline of each frame of a RuntimeScene, so that
+ * frames start at regular intervals, and record the time of the frames.
+ *
+ * The waiting is done at the start of the frame, before the input is polled,
+ * so that the input is as recent as possible when the frame is updated and
+ * rendered. The thread sleeps while the remaining time is greater than the
+ * time a sleep is measured to take, then spins until the deadline: the
+ * frames start on time without the imprecision of the sleeps of the system.
+ *
+ * \see RuntimeScene::EnableFramePacing
+ * \ingroup GameEngine
+ */
+class GD_API FramePacer {
+ public:
+  /**
+   * \brief The times of the last recorded frames, in microseconds.
+   */
+  struct Statistics {
+    std::size_t framesCount;  ///< The number of frames recorded.
+    double averageFrameTime;  ///< The time between the starts of two frames.
+    double minimumFrameTime;
+    double maximumFrameTime;
+    double frameTimeDeviation;  ///< The standard deviation of the frame time.
+    double averageWorkTime;     ///< The time spent updating and rendering.
+    double maximumWorkTime;
+    std::size_t missedDeadlinesCount;  ///< The number of frames started after
+                                       ///< their deadline, since the last
+                                       ///< reset.
+  };
+
+  /**
+   * \param framesCapacity The number of frames kept to compute the
+   * statistics.
+   */
+  FramePacer(std::size_t framesCapacity = 120);
+
+  /**
+   * \brief Set the number of frames per second to reach. If 0, frames are
+   * not waited for, but are still recorded.
+   */
+  void SetTargetFPS(double fps) { targetFPS = fps; }
+
+  /**
+   * \brief Return the number of frames per second to reach.
+   */
+  double GetTargetFPS() const { return targetFPS; }
+
+  /**
+   * \brief Wait until the deadline of the frame, then start it.
+   *
+   * The deadline is the start of the previous frame plus the duration of a
+   * frame. If a frame starts late by more than a frame, the next deadlines
+   * are computed from its start instead of catching up.
+   */
+  void BeginFrame();
+
+  /**
+   * \brief Record the time spent to update and render the frame started
+   * with BeginFrame.
+   */
+  void EndFrame();
+
+  /**
+   * \brief Return the time between the start of the last frame and the start
+   * of the previous one, in microseconds (or 0 for the first frame).
+   */
+  signed long long GetLastFrameTime() const { return lastFrameTime; }
+
+  /**
+   * \brief Return the time a sleep of 1 millisecond is expected to take, in
+   * microseconds, as measured during the frames (the mean plus the standard
+   * deviation of the measures).
+   */
+  double GetSleepEstimate() const;
+
+  /**
+   * \brief Compute the statistics of the last recorded frames.
+   */
+  Statistics GetStatistics() const;
+
+  /**
+   * \brief Forget the recorded frames (but not the precision of the sleeps).
+   */
+  void ResetStatistics();
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  /**
+   * \brief Sleep then spin until the deadline, updating the estimate of the
+   * duration of the sleeps.
+   */
+  void WaitUntil(Clock::time_point deadline);
+
+  static signed long long ToMicroseconds(Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+  }
+
+  double targetFPS;
+  bool frameStarted;  ///< False until the first frame is started.
+  Clock::time_point frameStart;  ///< The start of the frame (its deadline
+                                 ///< if it was on time).
+  Clock::time_point workStart;   ///< The end of the wait of the frame.
+  signed long long lastFrameTime;
+
+  std::size_t framesCapacity;
+  std::size_t framesCount;  ///< Number of frames recorded (since the reset).
+  std::vector<signed long long> frameTimes;  ///< Ring buffer of the frames
+                                             ///< times.
+  std::vector<signed long long> workTimes;   ///< Ring buffer of the work
+                                             ///< times.
+  std::size_t missedDeadlinesCount;
+
+  // The durations of the sleeps, accumulated with Welford's algorithm.
+  std::size_t sleepsCount;
+  double sleepsMean;
+  double sleepsM2;
+};
+
+#endif  // GDCPP_FRAMEPACER_H
@@ -0,0 +1,196 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include <cstdio>
+#include <sstream>
+
+namespace {
+void WriteJsonString(std::ostringstream &output, const std::string &str) {
+  output << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      output << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped,
+                    sizeof(escaped),
+                    "\\u%04x",
+                    static_cast<unsigned int>(c));
+      output << escaped;
+    } else {
+      output << c;
+    }
+  }
+  output << '"';
+}
+
+void WriteCompleteEvent(std::ostringstream &output,
+                        bool &firstEvent,
+                        const std::string &name,
+                        const char *category,
+                        signed long long startTime,
+                        signed long long duration) {
+  if (!firstEvent) output << ",";
+  firstEvent = false;
+
+  output << "{\"name\":";
+  WriteJsonString(output, name);
+  output << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":" << startTime
+         << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":1";
+}
+}  // namespace
+
+FrameProfiler::FrameProfiler(std::size_t framesCapacity)
+    : frames(framesCapacity > 0 ? framesCapacity : 1),
+      recordedFramesCount(0) {}
+
+void FrameProfiler::BeginFrame() {
+  recordedFramesCount++;
+  FrameRecord &frame = GetCurrentFrame();
+  frame.startTime = GetTime();
+  frame.duration = 0;
+  for (std::size_t i = 0; i < PhasesCount; ++i) {
+    frame.phasesStartTimes[i] = frame.startTime;
+    frame.phasesDurations[i] = 0;
+  }
+  frame.behaviors.clear();  // The memory of the vector is kept.
+}
+
+void FrameProfiler::EndFrame() {
+  if (recordedFramesCount == 0) return;
+
+  FrameRecord &frame = GetCurrentFrame();
+  frame.duration = GetTime() - frame.startTime;
+}
+
+void FrameProfiler::BeginPhase(Phase phase) {
+  if (recordedFramesCount == 0) return;
+
+  GetCurrentFrame().phasesStartTimes[phase] = GetTime();
+}
+
+void FrameProfiler::EndPhase(Phase phase) {
+  if (recordedFramesCount == 0) return;
+
+  FrameRecord &frame = GetCurrentFrame();
+  frame.phasesDurations[phase] += GetTime() - frame.phasesStartTimes[phase];
+}
+
+void FrameProfiler::AddBehaviorTime(const gd::String &behaviorName,
+                                    bool postEvents,
+                                    signed long long duration) {
+  if (recordedFramesCount == 0) return;
+
+  std::size_t nameIndex = 0;
+  auto it = behaviorsNamesIndices.find(behaviorName);
+  if (it != behaviorsNamesIndices.end()) {
+    nameIndex = it->second;
+  } else {
+    nameIndex = behaviorsNames.size();
+    behaviorsNames.push_back(behaviorName);
+    behaviorsNamesIndices[behaviorName] = nameIndex;
+  }
+
+  // Scenes have a few different behaviors: a linear search is enough.
+  std::vector<BehaviorTiming> &behaviors = GetCurrentFrame().behaviors;
+  for (BehaviorTiming &timing : behaviors) {
+    if (timing.nameIndex == nameIndex && timing.postEvents == postEvents) {
+      timing.callsCount++;
+      timing.duration += duration;
+      return;
+    }
+  }
+
+  BehaviorTiming timing;
+  timing.nameIndex = nameIndex;
+  timing.postEvents = postEvents;
+  timing.callsCount = 1;
+  timing.duration = duration;
+  behaviors.push_back(timing);
+}
+
+std::size_t FrameProfiler::GetFramesCount() const {
+  return recordedFramesCount < frames.size() ? recordedFramesCount
+                                             : frames.size();
+}
+
+const FrameProfiler::FrameRecord &FrameProfiler::GetFrame(
+    std::size_t index) const {
+  std::size_t firstFrame = recordedFramesCount - GetFramesCount();
+  return frames[(firstFrame + index) % frames.size()];
+}
+
+const char *FrameProfiler::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case RenderTargetEvents:
+      return "Window events";
+    case ObjectsBeforeEvents:
+      return "Objects before events";
+    case SoundsGarbage:
+      return "Sounds garbage collection";
+    case Events:
+      return "Events";
+    case ObjectsAfterEvents:
+      return "Objects after events";
+    case Rendering:
+      return "Rendering";
+    default:
+      return "Unknown";
+  }
+}
+
+gd::String FrameProfiler::ExportToChromeTrace() const {
+  std::ostringstream output;
+  output << "{\"traceEvents\":[";
+
+  bool firstEvent = true;
+  for (std::size_t i = 0; i < GetFramesCount(); ++i) {
+    const FrameRecord &frame = GetFrame(i);
+    WriteCompleteEvent(output,
+                       firstEvent,
+                       "Frame",
+                       "frame",
+                       frame.startTime,
+                       frame.duration);
+    output << "}";
+
+    for (std::size_t phase = 0; phase < PhasesCount; ++phase) {
+      WriteCompleteEvent(output,
+                         firstEvent,
+                         GetPhaseName(static_cast<Phase>(phase)),
+                         "phase",
+                         frame.phasesStartTimes[phase],
+                         frame.phasesDurations[phase]);
+      output << "}";
+
+      // Behaviors are stepped by the objects before and after the events.
+      if (phase != ObjectsBeforeEvents && phase != ObjectsAfterEvents)
+        continue;
+
+      signed long long behaviorStartTime = frame.phasesStartTimes[phase];
+      for (const BehaviorTiming &timing : frame.behaviors) {
+        if (timing.postEvents != (phase == ObjectsAfterEvents)) continue;
+
+        WriteCompleteEvent(output,
+                           firstEvent,
+                           behaviorsNames[timing.nameIndex].ToUTF8(),
+                           "behavior",
+                           behaviorStartTime,
+                           timing.duration);
+        output << ",\"args\":{\"calls\":" << timing.callsCount << "}}";
+        behaviorStartTime += timing.duration;
+      }
+    }
+  }
+
+  output << "],\"displayTimeUnit\":\"ms\"}";
+  return gd::String::FromUTF8(output.str());
+}
+
+void FrameProfiler::Clear() {
+  recordedFramesCount = 0;
+  for (FrameRecord &frame : frames) frame.behaviors.clear();
+}
@@ -0,0 +1,194 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <SFML/System/Clock.hpp>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Record the time spent in each phase of the frames of a RuntimeScene,
+ * and by each behavior.
+ *
+ * The records of the last frames are kept in a ring buffer, allocated when the
+ * profiler is created: recording a frame does not lock anything and, once the
+ * behaviors of the scene were seen once, does not allocate memory. The records
+ * can be exported in the trace format of Chrome (chrome://tracing).
+ *
+ * \note The profiler is only used by the thread running the scene.
+ *
+ * \see RuntimeScene::EnableFrameProfiler
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfiler {
+ public:
+  /**
+   * \brief The phases of a frame (see RuntimeScene::RenderAndStep).
+   */
+  enum Phase {
+    RenderTargetEvents = 0,
+    ObjectsBeforeEvents,
+    SoundsGarbage,
+    Events,
+    ObjectsAfterEvents,
+    Rendering,
+    PhasesCount
+  };
+
+  /**
+   * \brief The time spent during a frame by all the behaviors having the same
+   * name, before or after the events.
+   */
+  struct BehaviorTiming {
+    std::size_t nameIndex;   ///< The index of the name of the behaviors (see
+                             ///< GetBehaviorName).
+    bool postEvents;         ///< True for the steps done after the events.
+    std::size_t callsCount;  ///< The number of behaviors stepped.
+    signed long long duration;  ///< The time spent, in microseconds.
+  };
+
+  /**
+   * \brief The times recorded during a frame, in microseconds.
+   */
+  struct FrameRecord {
+    signed long long startTime;  ///< The time of the start of the frame,
+                                 ///< since the creation of the profiler.
+    signed long long duration;
+    signed long long phasesStartTimes[PhasesCount];
+    signed long long phasesDurations[PhasesCount];
+    std::vector<BehaviorTiming> behaviors;
+  };
+
+  /**
+   * \brief Scoped timer recording the time spent in a phase.
+   * \note Does nothing if the profiler is NULL.
+   */
+  class PhaseTimer {
+   public:
+    PhaseTimer(FrameProfiler *profiler_, Phase phase_)
+        : profiler(profiler_), phase(phase_) {
+      if (profiler) profiler->BeginPhase(phase);
+    }
+    ~PhaseTimer() {
+      if (profiler) profiler->EndPhase(phase);
+    }
+
+   private:
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    FrameProfiler *profiler;
+    Phase phase;
+  };
+
+  /**
+   * \param framesCapacity The number of frames kept in the ring buffer.
+   */
+  FrameProfiler(std::size_t framesCapacity = 600);
+  virtual ~FrameProfiler(){};
+
+  /**
+   * \brief Start the record of a new frame, replacing the oldest record if
+   * the ring buffer is full.
+   */
+  void BeginFrame();
+
+  /**
+   * \brief Finish the record of the current frame.
+   */
+  void EndFrame();
+
+  void BeginPhase(Phase phase);
+  void EndPhase(Phase phase);
+
+  /**
+   * \brief Add the time spent by a behavior to the current frame.
+   */
+  void AddBehaviorTime(const gd::String &behaviorName,
+                       bool postEvents,
+                       signed long long duration);
+
+  /**
+   * \brief Get the time elapsed since the creation of the profiler, in
+   * microseconds.
+   */
+  signed long long GetTime() const {
+    return clock.getElapsedTime().asMicroseconds();
+  }
+
+  /**
+   * \brief Get the number of frames records available (at most the capacity
+   * of the ring buffer).
+   */
+  std::size_t GetFramesCount() const;
+
+  /**
+   * \brief Get the record of a frame.
+   * \param index The index of the frame, from 0 (the oldest frame available)
+   * to GetFramesCount() - 1 (the last frame).
+   */
+  const FrameRecord &GetFrame(std::size_t index) const;
+
+  /**
+   * \brief Get the number of frames recorded since the creation of the
+   * profiler (or the last Clear), including the ones no more available.
+   *
+   * The frame at \a index is the frame number GetRecordedFramesCount() -
+   * GetFramesCount() + index.
+   */
+  std::size_t GetRecordedFramesCount() const { return recordedFramesCount; }
+
+  /**
+   * \brief Get the name of the behaviors of a BehaviorTiming.
+   */
+  const gd::String &GetBehaviorName(std::size_t nameIndex) const {
+    return behaviorsNames[nameIndex];
+  }
+
+  /**
+   * \brief Get the number of behaviors names seen since the creation of the
+   * profiler. New names are added at the end.
+   */
+  std::size_t GetBehaviorsNamesCount() const { return behaviorsNames.size(); }
+
+  /**
+   * \brief Get the name of a phase, as shown in the exported traces.
+   */
+  static const char *GetPhaseName(Phase phase);
+
+  /**
+   * \brief Export the recorded frames in the JSON trace format of Chrome.
+   *
+   * Frames and phases are exported as complete events. The times of the
+   * behaviors are also exported as complete events, nested in the phase
+   * where they were recorded: as their calls are interleaved between the
+   * objects, they are put one after the other from the start of the phase.
+   */
+  gd::String ExportToChromeTrace() const;
+
+  /**
+   * \brief Remove all the frames records.
+   */
+  void Clear();
+
+ private:
+  FrameRecord &GetCurrentFrame() {
+    return frames[(recordedFramesCount - 1) % frames.size()];
+  }
+
+  sf::Clock clock;
+  std::vector<FrameRecord> frames;  ///< The ring buffer of the frames records.
+  std::size_t recordedFramesCount;  ///< The number of frames recorded since
+                                    ///< the last Clear.
+  std::vector<gd::String> behaviorsNames;
+  std::unordered_map<gd::String, std::size_t>
+      behaviorsNamesIndices;  ///< The index of each name in behaviorsNames.
+};
+
+#endif  // FRAMEPROFILER_H
@@ -0,0 +1,170 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/FrameProfilerStream.h"
+#include <SFML/Network/IpAddress.hpp>
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+
+const std::size_t FrameProfilerStream::maxPendingDataSize = 1024 * 1024;
+
+FrameProfilerStream::FrameProfilerStream()
+    : connected(false),
+      interval(250),
+      samplingRate(1),
+      lastProfiler(NULL),
+      sentFramesCount(0),
+      sentBehaviorsNamesCount(0),
+      pendingDataOffset(0) {}
+
+bool FrameProfilerStream::Connect(const gd::String& address,
+                                  unsigned short port,
+                                  int timeout) {
+  Disconnect();
+  if (socket.connect(sf::IpAddress(address.ToUTF8()),
+                     port,
+                     sf::milliseconds(timeout)) != sf::Socket::Done)
+    return false;
+
+  socket.setBlocking(false);
+  connected = true;
+  clock.restart();
+  return true;
+}
+
+void FrameProfilerStream::Disconnect() {
+  socket.disconnect();
+  connected = false;
+  lastProfiler = NULL;
+  pendingData.clear();
+  pendingDataOffset = 0;
+}
+
+void FrameProfilerStream::Update(RuntimeScene& scene) {
+  if (!connected) return;
+
+  FlushPendingData();
+  if (!connected || clock.getElapsedTime().asMilliseconds() < interval)
+    return;
+
+  const FrameProfiler* profiler = scene.GetFrameProfiler();
+  if (!profiler) return;
+
+  // Keep the frames in the profiler until the previous messages are sent.
+  if (pendingData.size() - pendingDataOffset > maxPendingDataSize) return;
+
+  clock.restart();
+  MemoryStats stats;
+  stats.objectsCount = scene.objectsInstances.GetObjectsCount();
+  stats.scratchArenaCapacity = scene.GetScratchArena().GetCapacity();
+  for (std::size_t i = 0; i < gd::SystemStats::MemoryCategoriesCount; ++i) {
+    auto category = static_cast<gd::SystemStats::MemoryCategory>(i);
+    stats.usedMemory[i] = gd::SystemStats::GetUsedMemory(category);
+    stats.usedMemoryHighWaterMarks[i] =
+        gd::SystemStats::GetUsedMemoryHighWaterMark(category);
+  }
+  WriteMessage(*profiler, stats, messageData);
+  Send(messageData);
+}
+
+void FrameProfilerStream::WriteMessage(const FrameProfiler& profiler,
+                                       const MemoryStats& stats,
+                                       std::string& message) {
+  message.clear();
+  SceneSnapshotWriter writer(message);
+
+  bool newProfiler = &profiler != lastProfiler ||
+                     profiler.GetRecordedFramesCount() < sentFramesCount;
+  if (newProfiler) {
+    lastProfiler = &profiler;
+    sentFramesCount = 0;
+    sentBehaviorsNamesCount = 0;
+  }
+  writer.WriteBool(newProfiler);
+
+  std::size_t behaviorsNamesCount = profiler.GetBehaviorsNamesCount();
+  writer.WriteUInt(behaviorsNamesCount - sentBehaviorsNamesCount);
+  for (std::size_t i = sentBehaviorsNamesCount; i < behaviorsNamesCount; ++i)
+    writer.WriteString(profiler.GetBehaviorName(i));
+  sentBehaviorsNamesCount = behaviorsNamesCount;
+
+  std::size_t recordedFramesCount = profiler.GetRecordedFramesCount();
+  std::size_t firstFrame = recordedFramesCount - profiler.GetFramesCount();
+  if (sentFramesCount < firstFrame) sentFramesCount = firstFrame;
+
+  std::size_t framesCount = 0;
+  for (std::size_t frame = sentFramesCount; frame < recordedFramesCount;
+       ++frame) {
+    if (frame % samplingRate == 0) framesCount++;
+  }
+
+  writer.WriteUInt(framesCount);
+  for (std::size_t frame = sentFramesCount; frame < recordedFramesCount;
+       ++frame) {
+    if (frame % samplingRate != 0) continue;
+
+    const FrameProfiler::FrameRecord& record =
+        profiler.GetFrame(frame - firstFrame);
+    writer.WriteUInt(frame);
+    writer.WriteInt(record.startTime);
+    writer.WriteInt(record.duration);
+    for (std::size_t phase = 0; phase < FrameProfiler::PhasesCount; ++phase)
+      writer.WriteInt(record.phasesDurations[phase]);
+
+    writer.WriteUInt(record.behaviors.size());
+    for (const FrameProfiler::BehaviorTiming& timing : record.behaviors) {
+      writer.WriteUInt(timing.nameIndex);
+      writer.WriteBool(timing.postEvents);
+      writer.WriteUInt(timing.callsCount);
+      writer.WriteInt(timing.duration);
+    }
+  }
+  sentFramesCount = recordedFramesCount;
+
+  writer.WriteUInt(stats.objectsCount);
+  writer.WriteUInt(stats.scratchArenaCapacity);
+  writer.WriteUInt(gd::SystemStats::MemoryCategoriesCount);
+  for (std::size_t i = 0; i < gd::SystemStats::MemoryCategoriesCount; ++i) {
+    writer.WriteUInt(stats.usedMemory[i]);
+    writer.WriteUInt(stats.usedMemoryHighWaterMarks[i]);
+  }
+}
+
+void FrameProfilerStream::Send(const std::string& message) {
+  // Messages are sent as blocks (their size on 4 bytes, then their content)
+  // so that the remote profiler can split the stream.
+  if (pendingDataOffset > 0) {
+    pendingData.erase(0, pendingDataOffset);
+    pendingDataOffset = 0;
+  }
+  SceneSnapshotWriter writer(pendingData);
+  std::size_t block = writer.BeginBlock();
+  pendingData.append(message);
+  writer.EndBlock(block);
+
+  FlushPendingData();
+}
+
+void FrameProfilerStream::FlushPendingData() {
+  while (pendingDataOffset < pendingData.size()) {
+    std::size_t sent = 0;
+    sf::Socket::Status status =
+        socket.send(pendingData.data() + pendingDataOffset,
+                    pendingData.size() - pendingDataOffset,
+                    sent);
+    pendingDataOffset += sent;
+
+    if (status == sf::Socket::Disconnected || status == sf::Socket::Error) {
+      Disconnect();
+      return;
+    }
+    if (status == sf::Socket::NotReady || sent == 0)
+      return;  // Sent again at the next frame.
+  }
+
+  pendingData.clear();
+  pendingDataOffset = 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef FRAMEPROFILERSTREAM_H
+#define FRAMEPROFILERSTREAM_H
+
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <cstddef>
+#include <string>
+#include "GDCore/Tools/SystemStats.h"
+#include "GDCpp/Runtime/String.h"
+class FrameProfiler;
+class RuntimeScene;
+
+/**
+ * \brief Send the frames recorded by the FrameProfiler of a scene to a remote
+ * profiler (the IDE), so that games running on devices where no profiler can
+ * be attached can be profiled live.
+ *
+ * At a regular interval, the frames recorded since the last message are
+ * written in a binary message (see WriteMessage) and sent on a TCP
+ * connection. The socket is not blocking: if the messages can't be sent fast
+ * enough, the frames are not sent until the pending data is sent. Only one
+ * frame out of the sampling rate is sent, to reduce the bandwidth used.
+ *
+ * \see RuntimeScene::SetFrameProfilerStream
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfilerStream {
+ public:
+  /**
+   * \brief The statistics of the memory used by a scene, sent with the
+   * frames.
+   */
+  struct MemoryStats {
+    std::size_t objectsCount;
+    std::size_t scratchArenaCapacity;  ///< In bytes.
+    std::size_t usedMemory[gd::SystemStats::MemoryCategoriesCount];  ///< In
+    ///< bytes, for each category of gd::SystemStats.
+    std::size_t usedMemoryHighWaterMarks
+        [gd::SystemStats::MemoryCategoriesCount];  ///< In bytes.
+  };
+
+  FrameProfilerStream();
+  virtual ~FrameProfilerStream(){};
+
+  /**
+   * \brief Connect to the remote profiler.
+   * \param timeout The maximum time to wait for the connection, in
+   * milliseconds.
+   * \return false if the connection failed.
+   */
+  bool Connect(const gd::String& address,
+               unsigned short port,
+               int timeout = 1000);
+
+  void Disconnect();
+
+  /**
+   * \brief Return true if the connection is open.
+   */
+  bool IsConnected() const { return connected; }
+
+  /**
+   * \brief Set the minimum time between two messages, in milliseconds.
+   */
+  void SetInterval(float milliseconds) { interval = milliseconds; }
+  float GetInterval() const { return interval; }
+
+  /**
+   * \brief Set the sampling rate: only the frames whose number is a multiple
+   * of the rate are sent. 1 (the default) to send all the frames.
+   */
+  void SetSamplingRate(std::size_t rate) {
+    samplingRate = rate > 0 ? rate : 1;
+  }
+  std::size_t GetSamplingRate() const { return samplingRate; }
+
+  /**
+   * \brief Send the last frames recorded by the profiler of the scene, if the
+   * interval elapsed. Does nothing if the profiler of the scene is not
+   * enabled.
+   * \note Called at the end of each frame by RuntimeScene.
+   */
+  void Update(RuntimeScene& scene);
+
+  /**
+   * \brief Write the frames recorded by \a profiler since the last message,
+   * replacing the content of \a message.
+   *
+   * The message is written with a SceneSnapshotWriter. It contains:
+   * - a boolean, true if the profiler is not the one of the previous message
+   *   (the frames numbers and the behaviors names start again from 0),
+   * - the behaviors names seen since the last message (their count and the
+   *   names, in the order of their indices),
+   * - the frames (their count, and for each one its number, start time,
+   *   duration, the duration of each phase, and the behaviors timings: the
+   *   count, and for each one its name index, postEvents, calls count and
+   *   duration),
+   * - the memory stats: the objects count, the scratch arena capacity, then
+   *   the count of memory categories, and for each one the used memory and
+   *   its high-water mark.
+   *
+   * The frames no longer available in the ring buffer of the profiler are
+   * skipped: the remote profiler can find them with the frames numbers.
+   */
+  void WriteMessage(const FrameProfiler& profiler,
+                    const MemoryStats& stats,
+                    std::string& message);
+
+ private:
+  void Send(const std::string& message);
+  void FlushPendingData();
+
+  sf::TcpSocket socket;
+  bool connected;
+  float interval;  ///< In milliseconds.
+  std::size_t samplingRate;
+  sf::Clock clock;
+
+  const FrameProfiler* lastProfiler;  ///< The profiler of the last message.
+  std::size_t sentFramesCount;        ///< The frame number of the next frame
+                                      ///< to be sent.
+  std::size_t sentBehaviorsNamesCount;
+
+  std::string messageData;  ///< Reused to write the messages.
+  std::string pendingData;  ///< The data not sent yet by the socket.
+  std::size_t pendingDataOffset;
+
+  static const std::size_t maxPendingDataSize;
+};
+
+#endif  // FRAMEPROFILERSTREAM_H
@@ -0,0 +1,177 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/GlyphAtlas.h"
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+
+namespace {
+// The glyphs are copied with the transparent pixels around them in the
+// texture of the font, used when drawing the glyphs (see TextLayout).
+const unsigned int padding = 1;
+}  // namespace
+
+GlyphAtlas::GlyphAtlas(bool smooth_) : smooth(smooth_), pageSize(0) {}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(const sf::Font& font,
+                                              unsigned int characterSize,
+                                              bool bold,
+                                              sf::Uint32 codePoint) {
+  GlyphKey key(&font, characterSize, bold, codePoint);
+  auto it = glyphs.find(key);
+  if (it != glyphs.end()) return it->second;
+
+  Prewarm(font, characterSize, bold, sf::String(codePoint));
+  return glyphs[key];
+}
+
+void GlyphAtlas::Prewarm(const sf::Font& font,
+                         unsigned int characterSize,
+                         bool bold,
+                         const sf::String& string) {
+  newCodePoints.clear();
+  if (prewarmedFonts.insert(FontKey(&font, characterSize, bold)).second) {
+    for (sf::Uint32 codePoint = 0x21; codePoint < 0x7F; ++codePoint)
+      newCodePoints.push_back(codePoint);
+  }
+  for (std::size_t i = 0; i < string.getSize(); ++i) {
+    sf::Uint32 codePoint = string[i];
+    if (codePoint == L' ' || codePoint == L'\n' || codePoint == L'\t')
+      continue;
+    if (glyphs.find(GlyphKey(&font, characterSize, bold, codePoint)) ==
+        glyphs.end())
+      newCodePoints.push_back(codePoint);
+  }
+  if (newCodePoints.empty()) return;
+
+  // Render all the glyphs in the texture of the font before reading it back,
+  // as the texture can be resized when glyphs are added.
+  for (sf::Uint32 codePoint : newCodePoints)
+    font.getGlyph(codePoint, characterSize, bold);
+  const sf::Texture& fontTexture = font.getTexture(characterSize);
+  sf::Image fontImage = fontTexture.copyToImage();
+  const sf::Uint8* fontPixels = fontImage.getPixelsPtr();
+  int fontWidth = static_cast<int>(fontImage.getSize().x);
+  int fontHeight = static_cast<int>(fontImage.getSize().y);
+
+  for (sf::Uint32 codePoint : newCodePoints) {
+    GlyphKey key(&font, characterSize, bold, codePoint);
+    if (glyphs.find(key) != glyphs.end()) continue;  // Duplicated characters.
+
+    const sf::IntRect& rect =
+        font.getGlyph(codePoint, characterSize, bold).textureRect;
+    unsigned int width = std::max(rect.width, 0) + 2 * padding;
+    unsigned int height = std::max(rect.height, 0) + 2 * padding;
+
+    Glyph& glyph = glyphs[key];
+    Page* page = NULL;
+    sf::Vector2u position;
+    if (!Allocate(width, height, page, position)) {
+      glyph.texture = &fontTexture;
+      glyph.textureRect = rect;
+      continue;
+    }
+
+    pixels.assign(width * height * 4, 0);
+    for (unsigned int y = 0; y < height; ++y) {
+      int fontY = rect.top - static_cast<int>(padding) + static_cast<int>(y);
+      if (fontY < 0 || fontY >= fontHeight) continue;
+      for (unsigned int x = 0; x < width; ++x) {
+        int fontX =
+            rect.left - static_cast<int>(padding) + static_cast<int>(x);
+        if (fontX < 0 || fontX >= fontWidth) continue;
+        std::copy(fontPixels + (fontY * fontWidth + fontX) * 4,
+                  fontPixels + (fontY * fontWidth + fontX) * 4 + 4,
+                  pixels.begin() + (y * width + x) * 4);
+      }
+    }
+    page->texture.update(pixels.data(), width, height, position.x, position.y);
+
+    glyph.texture = &page->texture;
+    glyph.textureRect = sf::IntRect(position.x + padding,
+                                    position.y + padding,
+                                    rect.width,
+                                    rect.height);
+  }
+}
+
+const sf::Texture& GlyphAtlas::GetLinesTexture() {
+  return pages.empty() ? AddPage().texture : pages.front()->texture;
+}
+
+void GlyphAtlas::Clear() {
+  pages.clear();
+  glyphs.clear();
+  prewarmedFonts.clear();
+}
+
+GlyphAtlas::Page& GlyphAtlas::AddPage() {
+  if (pageSize == 0)
+    pageSize = std::min(1024u, sf::Texture::getMaximumSize());
+
+  pages.push_back(std::unique_ptr<Page>(new Page));
+  Page& page = *pages.back();
+  page.nextTop = 0;
+  page.texture.create(pageSize, pageSize);
+  page.texture.setSmooth(smooth);
+
+  // The content of new textures is undefined.
+  pixels.assign(pageSize * pageSize * 4, 0);
+  page.texture.update(pixels.data());
+
+  // White pixels for the lines, like sf::Font.
+  sf::Vector2u position;
+  AllocateInPage(page, 4, 4, position);
+  pixels.assign(4 * 4 * 4, 255);
+  page.texture.update(pixels.data(), 4, 4, position.x, position.y);
+
+  return page;
+}
+
+bool GlyphAtlas::Allocate(unsigned int width,
+                          unsigned int height,
+                          Page*& page,
+                          sf::Vector2u& position) {
+  if (pageSize == 0)
+    pageSize = std::min(1024u, sf::Texture::getMaximumSize());
+  if (width > pageSize || height > pageSize) return false;
+
+  for (auto& existingPage : pages) {
+    if (AllocateInPage(*existingPage, width, height, position)) {
+      page = existingPage.get();
+      return true;
+    }
+  }
+
+  page = &AddPage();
+  return AllocateInPage(*page, width, height, position);
+}
+
+bool GlyphAtlas::AllocateInPage(Page& page,
+                                unsigned int width,
+                                unsigned int height,
+                                sf::Vector2u& position) {
+  // Use the shelf wasting the least height...
+  Shelf* bestShelf = NULL;
+  for (Shelf& shelf : page.shelves) {
+    if (shelf.height < height || shelf.nextLeft + width > pageSize) continue;
+    if (!bestShelf || shelf.height < bestShelf->height) bestShelf = &shelf;
+  }
+
+  // ...unless it's much higher than the glyph and a new shelf can be added.
+  bool canAddShelf = page.nextTop + height <= pageSize;
+  if (canAddShelf && (!bestShelf || bestShelf->height > height + height / 2)) {
+    Shelf shelf = {page.nextTop, height, 0};
+    page.shelves.push_back(shelf);
+    page.nextTop += height;
+    bestShelf = &page.shelves.back();
+  }
+  if (!bestShelf) return false;
+
+  position = sf::Vector2u(bestShelf->nextLeft, bestShelf->top);
+  bestShelf->nextLeft += width;
+  return true;
+}
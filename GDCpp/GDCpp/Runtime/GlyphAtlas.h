@@ -0,0 +1,137 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/String.hpp>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+namespace sf {
+class Font;
+}
+
+/**
+ * \brief Pack the glyphs of all the fonts and character sizes in use into a
+ * few shared textures, so that texts using different fonts or sizes can be
+ * drawn in a single batch (see SpriteBatch).
+ *
+ * Glyphs are rendered by the sf::Font and then copied into the pages of the
+ * atlas, once for each glyph. Each page has white pixels at (1, 1), like the
+ * textures of sf::Font, to draw the lines of the underlined and strike
+ * through styles.
+ *
+ * \see FontManager::GetGlyphAtlas
+ * \ingroup ResourcesManagement
+ */
+class GD_API GlyphAtlas {
+ public:
+  /**
+   * \brief The position of a glyph in the atlas.
+   */
+  struct Glyph {
+    const sf::Texture* texture;  ///< The page of the atlas, or the texture of
+                                 ///< the font if the glyph is too large.
+    sf::IntRect textureRect;  ///< Same as sf::Glyph::textureRect, but in
+                              ///< \a texture.
+  };
+
+  /**
+   * \param smooth true to smooth the textures of the atlas.
+   */
+  GlyphAtlas(bool smooth);
+  virtual ~GlyphAtlas(){};
+
+  /**
+   * \brief Return the position of a glyph in the atlas, adding it to the
+   * atlas if needed.
+   */
+  const Glyph& GetGlyph(const sf::Font& font,
+                        unsigned int characterSize,
+                        bool bold,
+                        sf::Uint32 codePoint);
+
+  /**
+   * \brief Add the glyphs of a string to the atlas, reading back the texture
+   * of the font only once for all the new glyphs.
+   *
+   * The first time a font is used with a character size, the printable ASCII
+   * characters are added too, so that texts changing often (scores, timers...)
+   * don't add glyphs one by one.
+   */
+  void Prewarm(const sf::Font& font,
+               unsigned int characterSize,
+               bool bold,
+               const sf::String& string);
+
+  /**
+   * \brief Return the texture having white pixels at (1, 1), to draw lines
+   * when a text has no glyphs.
+   */
+  const sf::Texture& GetLinesTexture();
+
+  /**
+   * \brief Return the number of textures of the atlas.
+   */
+  std::size_t GetPagesCount() const { return pages.size(); }
+
+  /**
+   * \brief Remove all the glyphs and the textures of the atlas.
+   * \note Must be called when the fonts are unloaded.
+   */
+  void Clear();
+
+ private:
+  /**
+   * \brief A row of glyphs in a page. Glyphs are added from left to right.
+   */
+  struct Shelf {
+    unsigned int top;
+    unsigned int height;
+    unsigned int nextLeft;
+  };
+
+  struct Page {
+    sf::Texture texture;
+    std::vector<Shelf> shelves;
+    unsigned int nextTop;  ///< The top of the next shelf.
+  };
+
+  typedef std::tuple<const sf::Font*, unsigned int, bool, sf::Uint32>
+      GlyphKey;
+  typedef std::tuple<const sf::Font*, unsigned int, bool> FontKey;
+
+  Page& AddPage();
+
+  /**
+   * \brief Find room for a rectangle in the pages, adding a page if needed.
+   * \return false if the rectangle is larger than a page.
+   */
+  bool Allocate(unsigned int width,
+                unsigned int height,
+                Page*& page,
+                sf::Vector2u& position);
+  bool AllocateInPage(Page& page,
+                      unsigned int width,
+                      unsigned int height,
+                      sf::Vector2u& position);
+
+  bool smooth;
+  unsigned int pageSize;
+  std::vector<std::unique_ptr<Page> > pages;
+  std::map<GlyphKey, Glyph> glyphs;
+  std::set<FontKey> prewarmedFonts;  ///< The fonts and sizes whose ASCII
+                                     ///< characters were added.
+  std::vector<sf::Uint32> newCodePoints;  ///< Reused by Prewarm.
+  std::vector<sf::Uint8> pixels;         ///< Reused to copy the glyphs.
+};
+
+#endif  // GLYPHATLAS_H
@@ -1,174 +1,206 @@
-/*
- * GDevelop C++ Platform
- * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
- * reserved. This project is released under the MIT License.
- */
-#ifndef INPUTMANAGER_H
-#define INPUTMANAGER_H
-#include <SFML/Window.hpp>
-#include <map>
-#include <set>
-#include <string>
-#include <vector>
-#include "GDCpp/Runtime/String.h"
-
-/**
- * \brief Manage the events and mouse, keyboard
- * and touches inputs of a sf::Window.
- *
- * In particular, each RuntimeScene owns an InputManager.
- *
- * \see RuntimeScene
- */
-class GD_API InputManager {
- public:
-  /**
-   * @brief Default constructor.
-   *
-   * Call SetWindow to set the window for which events must be handled
-   */
-  InputManager()
-      : window(nullptr),
-        lastPressedKey(0),
-        mouseWheelDelta(0),
-        keyWasPressed(false),
-        touchSimulateMouse(true),
-        windowHasFocus(true),
-        disableInputWhenNotFocused(true) {}
-
-  /**
-   * @brief Constructor with a window to manage.
-   */
-  InputManager(sf::Window* win);
-
-  /** \name Connection with window and events management
-   */
-  ///@{
-  /**
-   * \brief Set the window managed by the input manager.
-   */
-  InputManager& SetWindow(sf::Window* win) {
-    window = win;
-    return *this;
-  }
-
-  /**
-   * Set if the input must be disabled when window lose focus.
-   */
-  void DisableInputWhenFocusIsLost(bool disable = true) {
-    disableInputWhenNotFocused = disable;
-  }
-
-  /**
-   * \brief Handle a SFML event made on the window.
-   */
-  void HandleEvent(sf::Event& event);
-
-  /**
-   * \brief Call it when a new frame is rendered.
-   */
-  void NextFrame();
-  ///@}
-
-  /** \name Keyboard
-   */
-  ///@{
-  /**
-   * \brief Return the key name of the latest pressed key.
-   */
-  gd::String GetLastPressedKey() const;
-
-  /**
-   * \brief Return true if the specified key name is pressed.
-   */
-  bool IsKeyPressed(gd::String key) const;
-
-  /**
-   * \brief Return true if the specified key name was just released.
-   */
-  bool WasKeyReleased(gd::String key) const;
-
-  /**
-   * \brief Return true if any key was pressed since the last call
-   * to NextFrame.
-   */
-  bool AnyKeyIsPressed() const;
-
-  /**
-   * @brief Get the unicode value of the characters entered during the last
-   * frame.
-   */
-  std::vector<sf::Uint32> GetCharactersEntered() const {
-    return charactersEntered;
-  };
-
-  static const std::map<gd::String, int>& GetKeyNameToSfKeyMap();
-  static const std::map<int, gd::String>& GetSfKeyToKeyNameMap();
-  ///@}
-
-  /** \name Mouse
-   */
-  ///@{
-  /**
-   * @brief Return the position of the mouse, in window coordinates.
-   */
-  sf::Vector2i GetMousePosition() const;
-
-  /**
-   * @brief Return true if the specified mouse button is pressed.
-   */
-  bool IsMouseButtonPressed(const gd::String& button) const;
-
-  /**
-   * @brief Return true if the specified mouse button was released in this
-   * frame.
-   */
-  bool IsMouseButtonReleased(const gd::String& button) const;
-
-  /**
-   * @brief Get the number of ticks the wheel moved during last frame.
-   */
-  int GetMouseWheelDelta() const;
-
-  static const std::map<gd::String, int>& GetButtonNameToSfButtonMap();
-  static const std::map<int, gd::String>& GetSfButtonToButtonNameMap();
-  ///@}
-
-  /** \name Touches
-   */
-  ///@{
-  /**
-   * @brief Get all touches being made on the screen, along with their
-   * coordinates.
-   */
-  const std::map<int, sf::Vector2i>& GetAllTouches() { return touches; }
-  ///@}
-
- private:
-  sf::Window* window;
-
-  int lastPressedKey;  ///< SFML key code of the last pressed key.
-  bool keyWasPressed;  ///< True if a key was pressed during the last step.
-  std::map<gd::String, bool> keysPressed;  ///< The keys pressed for this frame.
-  std::map<gd::String, bool>
-      oldKeysPressed;  ///< The keys pressed during the last frame.
-  std::vector<sf::Uint32>
-      charactersEntered;  ///< The characters entered for this frame.
-
-  int mouseWheelDelta;
-  sf::Vector2i mousePosition;  ///< The mouse position for this frame.
-  std::map<gd::String, bool>
-      buttonsPressed;  ///< The buttons pressed for this frame.
-  std::map<gd::String, bool>
-      oldButtonsPressed;  ///< The buttons pressed during the last frame.
-
-  void SimulateMousePressed(sf::Vector2i pos);
-  bool touchSimulateMouse;
-  std::map<int, sf::Vector2i> touches;
-
-  bool windowHasFocus;  ///< True if the render target has the focus.
-  bool disableInputWhenNotFocused;  ///< True if input should be ignored when
-                                    ///< focus is lost.
-};
-
-#endif
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef INPUTMANAGER_H
+#define INPUTMANAGER_H
+#include <SFML/Window.hpp>
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Manage the events and mouse, keyboard
+ * and touches inputs of a sf::Window.
+ *
+ * In particular, each RuntimeScene owns an InputManager.
+ *
+ * The state of the keys and of the mouse buttons is updated from the events
+ * of the window, in arrays indexed by SFML key and button codes. The devices
+ * are only polled when the window gains the focus (or at each frame when the
+ * window doesn't have the focus and the input is not disabled), as events are
+ * not received without the focus.
+ *
+ * \see RuntimeScene
+ */
+class GD_API InputManager {
+ public:
+  /**
+   * @brief Default constructor.
+   *
+   * Call SetWindow to set the window for which events must be handled
+   */
+  InputManager() : InputManager(nullptr) {}
+
+  /**
+   * @brief Constructor with a window to manage.
+   */
+  InputManager(sf::Window* win);
+
+  /** \name Connection with window and events management
+   */
+  ///@{
+  /**
+   * \brief Set the window managed by the input manager.
+   */
+  InputManager& SetWindow(sf::Window* win) {
+    window = win;
+    devicesSynchronized = false;
+    return *this;
+  }
+
+  /**
+   * Set if the input must be disabled when window lose focus.
+   */
+  void DisableInputWhenFocusIsLost(bool disable = true) {
+    disableInputWhenNotFocused = disable;
+  }
+
+  /**
+   * \brief Handle a SFML event made on the window.
+   */
+  void HandleEvent(sf::Event& event);
+
+  /**
+   * \brief Call it when a new frame is rendered.
+   */
+  void NextFrame();
+  ///@}
+
+  /** \name Keyboard
+   */
+  ///@{
+  /**
+   * \brief Return the key name of the latest pressed key.
+   */
+  gd::String GetLastPressedKey() const;
+
+  /**
+   * \brief Return true if the specified key name is pressed.
+   */
+  bool IsKeyPressed(gd::String key) const;
+
+  /**
+   * \brief Return true if the specified key was pressed during the last
+   * frame.
+   */
+  bool WasKeyJustPressed(gd::String key) const;
+
+  /**
+   * \brief Return true if the specified key name was just released.
+   */
+  bool WasKeyReleased(gd::String key) const;
+
+  /**
+   * \brief Return true if any key was pressed since the last call
+   * to NextFrame.
+   */
+  bool AnyKeyIsPressed() const;
+
+  /**
+   * @brief Get the unicode value of the characters entered during the last
+   * frame.
+   */
+  std::vector<sf::Uint32> GetCharactersEntered() const {
+    return charactersEntered;
+  };
+
+  static const std::map<gd::String, int>& GetKeyNameToSfKeyMap();
+  static const std::map<int, gd::String>& GetSfKeyToKeyNameMap();
+  ///@}
+
+  /** \name Mouse
+   */
+  ///@{
+  /**
+   * @brief Return the position of the mouse, in window coordinates.
+   */
+  sf::Vector2i GetMousePosition() const;
+
+  /**
+   * @brief Return true if the specified mouse button is pressed.
+   */
+  bool IsMouseButtonPressed(const gd::String& button) const;
+
+  /**
+   * @brief Return true if the specified mouse button was released in this
+   * frame.
+   */
+  bool IsMouseButtonReleased(const gd::String& button) const;
+
+  /**
+   * @brief Get the number of ticks the wheel moved during last frame.
+   */
+  int GetMouseWheelDelta() const;
+
+  static const std::map<gd::String, int>& GetButtonNameToSfButtonMap();
+  static const std::map<int, gd::String>& GetSfButtonToButtonNameMap();
+  ///@}
+
+  /** \name Touches
+   */
+  ///@{
+  /**
+   * @brief Get all touches being made on the screen, along with their
+   * coordinates.
+   */
+  const std::map<int, sf::Vector2i>& GetAllTouches() { return touches; }
+  ///@}
+
+ private:
+  sf::Window* window;
+
+  /**
+   * \brief Return the SFML code of a key name, or -1 if it's unknown.
+   */
+  static int GetKeyCode(const gd::String& key);
+
+  /**
+   * \brief Return the SFML code of a button name, or -1 if it's unknown.
+   */
+  static int GetButtonCode(const gd::String& button);
+
+  void SetKeyDown(int key, bool down);
+  void SetButtonDown(int button, bool down);
+
+  /**
+   * \brief Poll the state of the keys, of the mouse buttons and the position
+   * of the mouse.
+   */
+  void SynchronizeWithDevices();
+
+  int lastPressedKey;  ///< SFML key code of the last pressed key.
+  bool keyWasPressed;  ///< True if a key was pressed during the last step.
+  std::array<bool, sf::Keyboard::KeyCount>
+      keysDown;  ///< The keys being pressed.
+  std::array<bool, sf::Keyboard::KeyCount>
+      keysJustPressed;  ///< The keys pressed during the last frame.
+  std::array<bool, sf::Keyboard::KeyCount>
+      keysJustReleased;  ///< The keys released during the last frame.
+  std::vector<sf::Uint32>
+      charactersEntered;  ///< The characters entered for this frame.
+
+  int mouseWheelDelta;
+  sf::Vector2i mousePosition;  ///< The mouse position for this frame.
+  std::array<bool, sf::Mouse::ButtonCount>
+      buttonsDown;  ///< The buttons being pressed.
+  std::array<bool, sf::Mouse::ButtonCount>
+      buttonsJustReleased;  ///< The buttons released during the last frame.
+
+  void SimulateMousePressed(sf::Vector2i pos);
+  bool touchSimulateMouse;
+  bool leftButtonSimulated;  ///< True if a touch simulates the left button.
+  std::map<int, sf::Vector2i> touches;
+
+  bool windowHasFocus;  ///< True if the render target has the focus.
+  bool disableInputWhenNotFocused;  ///< True if input should be ignored when
+                                    ///< focus is lost.
+  bool devicesSynchronized;  ///< False until the devices are polled for the
+                             ///< window.
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/InputRecording.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+
+namespace {
+const char recordingMagic[] = "GDIR";
+const std::uint64_t recordingVersion = 1;
+
+void WriteEvent(SceneSnapshotWriter& writer, const sf::Event& event) {
+  writer.WriteUInt(event.type);
+  switch (event.type) {
+    case sf::Event::KeyPressed:
+    case sf::Event::KeyReleased:
+      writer.WriteInt(event.key.code);
+      writer.WriteBool(event.key.alt);
+      writer.WriteBool(event.key.control);
+      writer.WriteBool(event.key.shift);
+      writer.WriteBool(event.key.system);
+      break;
+    case sf::Event::TextEntered:
+      writer.WriteUInt(event.text.unicode);
+      break;
+    case sf::Event::MouseWheelMoved:
+      writer.WriteInt(event.mouseWheel.delta);
+      writer.WriteInt(event.mouseWheel.x);
+      writer.WriteInt(event.mouseWheel.y);
+      break;
+    case sf::Event::MouseMoved:
+      writer.WriteInt(event.mouseMove.x);
+      writer.WriteInt(event.mouseMove.y);
+      break;
+    case sf::Event::MouseButtonPressed:
+    case sf::Event::MouseButtonReleased:
+      writer.WriteInt(event.mouseButton.button);
+      writer.WriteInt(event.mouseButton.x);
+      writer.WriteInt(event.mouseButton.y);
+      break;
+    case sf::Event::TouchBegan:
+    case sf::Event::TouchMoved:
+    case sf::Event::TouchEnded:
+      writer.WriteUInt(event.touch.finger);
+      writer.WriteInt(event.touch.x);
+      writer.WriteInt(event.touch.y);
+      break;
+    default:
+      break;  // Other events are not used by the InputManager.
+  }
+}
+
+void ReadEvent(SceneSnapshotReader& reader, sf::Event& event) {
+  event.type = static_cast<sf::Event::EventType>(reader.ReadUInt());
+  switch (event.type) {
+    case sf::Event::KeyPressed:
+    case sf::Event::KeyReleased:
+      event.key.code = static_cast<sf::Keyboard::Key>(reader.ReadInt());
+      event.key.alt = reader.ReadBool();
+      event.key.control = reader.ReadBool();
+      event.key.shift = reader.ReadBool();
+      event.key.system = reader.ReadBool();
+      break;
+    case sf::Event::TextEntered:
+      event.text.unicode = static_cast<sf::Uint32>(reader.ReadUInt());
+      break;
+    case sf::Event::MouseWheelMoved:
+      event.mouseWheel.delta = static_cast<int>(reader.ReadInt());
+      event.mouseWheel.x = static_cast<int>(reader.ReadInt());
+      event.mouseWheel.y = static_cast<int>(reader.ReadInt());
+      break;
+    case sf::Event::MouseMoved:
+      event.mouseMove.x = static_cast<int>(reader.ReadInt());
+      event.mouseMove.y = static_cast<int>(reader.ReadInt());
+      break;
+    case sf::Event::MouseButtonPressed:
+    case sf::Event::MouseButtonReleased:
+      event.mouseButton.button =
+          static_cast<sf::Mouse::Button>(reader.ReadInt());
+      event.mouseButton.x = static_cast<int>(reader.ReadInt());
+      event.mouseButton.y = static_cast<int>(reader.ReadInt());
+      break;
+    case sf::Event::TouchBegan:
+    case sf::Event::TouchMoved:
+    case sf::Event::TouchEnded:
+      event.touch.finger = static_cast<unsigned int>(reader.ReadUInt());
+      event.touch.x = static_cast<int>(reader.ReadInt());
+      event.touch.y = static_cast<int>(reader.ReadInt());
+      break;
+    default:
+      break;
+  }
+}
+}  // namespace
+
+void InputRecording::EndFrame(signed long long elapsedTime) {
+  frames.push_back(Frame());
+  frames.back().elapsedTime = elapsedTime;
+  frames.back().events.swap(pendingEvents);
+}
+
+void InputRecording::Clear() {
+  frames.clear();
+  pendingEvents.clear();
+}
+
+void InputRecording::SaveTo(std::string& data) const {
+  data.assign(recordingMagic, 4);
+  SceneSnapshotWriter writer(data);
+  writer.WriteUInt(recordingVersion);
+  writer.WriteUInt(randomSeed);
+  writer.WriteUInt(frames.size());
+  for (const Frame& frame : frames) {
+    writer.WriteInt(frame.elapsedTime);
+    writer.WriteUInt(frame.events.size());
+    for (const sf::Event& event : frame.events) WriteEvent(writer, event);
+  }
+}
+
+bool InputRecording::LoadFrom(const std::string& data) {
+  Clear();
+  if (data.size() < 4 || data.compare(0, 4, recordingMagic, 4) != 0)
+    return false;
+
+  SceneSnapshotReader reader(data.data() + 4, data.size() - 4);
+  if (reader.ReadUInt() != recordingVersion) return false;
+
+  randomSeed = static_cast<unsigned int>(reader.ReadUInt());
+  std::uint64_t framesCount = reader.ReadUInt();
+  for (std::uint64_t i = 0; i < framesCount && reader.IsValid(); ++i) {
+    frames.push_back(Frame());
+    Frame& frame = frames.back();
+    frame.elapsedTime = reader.ReadInt();
+
+    std::uint64_t eventsCount = reader.ReadUInt();
+    for (std::uint64_t j = 0; j < eventsCount && reader.IsValid(); ++j) {
+      frame.events.push_back(sf::Event());
+      ReadEvent(reader, frame.events.back());
+    }
+  }
+
+  if (!reader.IsValid()) {
+    Clear();
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <SFML/Window/Event.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \brief The input events and the elapsed time of the frames of a scene,
+ * recorded to be replayed later.
+ *
+ * With the seed of the random numbers, a recording makes a session replayable
+ * without a window and with the same results, for example to compare the
+ * performance of versions of the game engine on real content.
+ *
+ * \note The devices polled by the InputManager when the window has not the
+ * focus are not recorded: only the events are.
+ *
+ * \see RuntimeScene::StartInputRecording
+ * \see RuntimeScene::ReplayInputRecording
+ * \ingroup GameEngine
+ */
+class GD_API InputRecording {
+ public:
+  /**
+   * \brief The events handled during a frame, and the time elapsed since the
+   * previous one.
+   */
+  struct Frame {
+    signed long long elapsedTime;  ///< In microseconds.
+    std::vector<sf::Event> events;
+  };
+
+  InputRecording(unsigned int randomSeed_ = 0) : randomSeed(randomSeed_){};
+
+  /**
+   * \brief The seed of the random numbers, set when the recording or the
+   * replay is started.
+   */
+  unsigned int GetRandomSeed() const { return randomSeed; }
+  void SetRandomSeed(unsigned int seed) { randomSeed = seed; }
+
+  /**
+   * \brief Add an event to the frame being recorded.
+   */
+  void AddEvent(const sf::Event& event) { pendingEvents.push_back(event); }
+
+  /**
+   * \brief Finish the frame being recorded, with the events added since the
+   * previous frame.
+   */
+  void EndFrame(signed long long elapsedTime);
+
+  const std::vector<Frame>& GetFrames() const { return frames; }
+  std::size_t GetFramesCount() const { return frames.size(); }
+
+  /**
+   * \brief Remove the frames and the events.
+   */
+  void Clear();
+
+  /**
+   * \brief Write the recording in a binary buffer, replacing its content.
+   *
+   * Only the events used by the InputManager are written with their data.
+   */
+  void SaveTo(std::string& data) const;
+
+  /**
+   * \brief Read a recording written by SaveTo, replacing the frames.
+   * \return false if the data is invalid.
+   */
+  bool LoadFrom(const std::string& data);
+
+ private:
+  unsigned int randomSeed;
+  std::vector<Frame> frames;
+  std::vector<sf::Event> pendingEvents;  ///< The events of the frame being
+                                         ///< recorded.
+};
+
+#endif  // INPUTRECORDING_H
@@ -0,0 +1,177 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/InstancesStreamer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "GDCpp/Runtime/Project/InitialInstance.h"
+#include "GDCpp/Runtime/Project/InitialInstancesContainer.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+
+namespace {
+/**
+ * \brief Add a pointer to each instance to the chunk of the instance.
+ */
+class InstancesPartitioner : public gd::InitialInstanceFunctor {
+ public:
+  InstancesPartitioner(std::function<void(const gd::InitialInstance&)> add_)
+      : add(add_){};
+  virtual ~InstancesPartitioner(){};
+
+  virtual void operator()(gd::InitialInstance& instance) { add(instance); }
+
+ private:
+  std::function<void(const gd::InitialInstance&)> add;
+};
+}  // namespace
+
+void InstancesStreamer::Load(const gd::InitialInstancesContainer& instances,
+                             float chunkSize_,
+                             float radius_) {
+  Clear();
+  chunkSize = chunkSize_;
+  radius = radius_;
+  if (chunkSize <= 0) return;
+
+  InstancesPartitioner partitioner([this](
+      const gd::InitialInstance& instance) {
+    int x = static_cast<int>(std::floor(instance.GetX() / chunkSize));
+    int y = static_cast<int>(std::floor(instance.GetY() / chunkSize));
+    Chunk& chunk = chunks[GetChunkKey(x, y)];
+    if (chunk.instances.empty()) {
+      chunk.x = x;
+      chunk.y = y;
+      chunk.nextInstance = 0;
+      chunk.loaded = false;
+    }
+    chunk.instances.push_back(&instance);
+  });
+  const_cast<gd::InitialInstancesContainer&>(instances).IterateOverInstances(
+      partitioner);
+
+  for (auto& it : chunks) {
+    Chunk& chunk = it.second;
+    chunk.objects.assign(chunk.instances.size(), nullptr);
+    chunk.deleted.assign(chunk.instances.size(), false);
+  }
+}
+
+void InstancesStreamer::Clear() {
+  chunks.clear();
+  loadedChunks.clear();
+  objectsInstances.clear();
+  chunkSize = 0;
+}
+
+std::size_t InstancesStreamer::Update(RuntimeScene& scene,
+                                      float centerX,
+                                      float centerY,
+                                      std::size_t maximumCreatedObjects) {
+  if (!IsEnabled()) return 0;
+
+  // Chunks are unloaded a bit farther than where they are loaded, so that
+  // moving around the limit of a chunk doesn't load and unload it repeatedly.
+  float unloadRadius = radius + chunkSize;
+  auto isInRadius = [&](const Chunk& chunk, float margin) {
+    float left = chunk.x * chunkSize;
+    float top = chunk.y * chunkSize;
+    return left - margin <= centerX && centerX <= left + chunkSize + margin &&
+           top - margin <= centerY && centerY <= top + chunkSize + margin;
+  };
+
+  for (std::size_t i = 0; i < loadedChunks.size();) {
+    if (!isInRadius(*loadedChunks[i], unloadRadius)) {
+      UnloadChunk(scene, *loadedChunks[i]);
+      loadedChunks[i] = loadedChunks.back();
+      loadedChunks.pop_back();
+    } else
+      ++i;
+  }
+
+  auto loadChunk = [this](Chunk& chunk) {
+    if (chunk.loaded) return;
+    chunk.loaded = true;
+    loadedChunks.push_back(&chunk);
+  };
+  int minX = static_cast<int>(std::floor((centerX - radius) / chunkSize));
+  int maxX = static_cast<int>(std::floor((centerX + radius) / chunkSize));
+  int minY = static_cast<int>(std::floor((centerY - radius) / chunkSize));
+  int maxY = static_cast<int>(std::floor((centerY + radius) / chunkSize));
+  double cellsCount = (double(maxX) - minX + 1) * (double(maxY) - minY + 1);
+  if (cellsCount <= chunks.size()) {
+    for (int x = minX; x <= maxX; ++x) {
+      for (int y = minY; y <= maxY; ++y) {
+        auto it = chunks.find(GetChunkKey(x, y));
+        if (it != chunks.end()) loadChunk(it->second);
+      }
+    }
+  } else {
+    for (auto& it : chunks) {
+      if (isInRadius(it.second, radius)) loadChunk(it.second);
+    }
+  }
+
+  // Create the objects of the nearest chunks first.
+  auto distance = [&](const Chunk* chunk) {
+    float x = (chunk->x + 0.5f) * chunkSize - centerX;
+    float y = (chunk->y + 0.5f) * chunkSize - centerY;
+    return x * x + y * y;
+  };
+  std::sort(loadedChunks.begin(),
+            loadedChunks.end(),
+            [&](const Chunk* a, const Chunk* b) {
+              return distance(a) < distance(b);
+            });
+
+  std::size_t createdObjects = 0;
+  for (Chunk* chunk : loadedChunks) {
+    for (; chunk->nextInstance < chunk->instances.size();
+         ++chunk->nextInstance) {
+      if (maximumCreatedObjects != 0 &&
+          createdObjects >= maximumCreatedObjects)
+        return createdObjects;
+
+      std::size_t i = chunk->nextInstance;
+      if (chunk->deleted[i]) continue;
+
+      RuntimeObject* object =
+          scene.CreateObjectFromInitialInstance(*chunk->instances[i]);
+      if (!object) {
+        chunk->deleted[i] = true;  // Don't try again to create the object.
+        continue;
+      }
+
+      chunk->objects[i] = object;
+      objectsInstances[object] = std::make_pair(chunk, i);
+      createdObjects++;
+    }
+  }
+
+  return createdObjects;
+}
+
+void InstancesStreamer::UnloadChunk(RuntimeScene& scene, Chunk& chunk) {
+  for (std::size_t i = 0; i < chunk.objects.size(); ++i) {
+    if (!chunk.objects[i]) continue;
+
+    objectsInstances.erase(chunk.objects[i]);
+    chunk.objects[i]->DeleteFromScene(scene);
+    chunk.objects[i] = nullptr;
+  }
+  chunk.nextInstance = 0;
+  chunk.loaded = false;
+}
+
+void InstancesStreamer::ObjectDeleted(RuntimeObject* object) {
+  auto it = objectsInstances.find(object);
+  if (it == objectsInstances.end()) return;
+
+  Chunk& chunk = *it->second.first;
+  chunk.objects[it->second.second] = nullptr;
+  chunk.deleted[it->second.second] = true;
+  objectsInstances.erase(it);
+}
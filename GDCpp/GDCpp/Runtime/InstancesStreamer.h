@@ -0,0 +1,114 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef INSTANCESSTREAMER_H
+#define INSTANCESSTREAMER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+class RuntimeScene;
+class RuntimeObject;
+namespace gd {
+class InitialInstance;
+class InitialInstancesContainer;
+}
+
+/**
+ * \brief Create the objects of the initial instances of a scene only when
+ * they are near the camera.
+ *
+ * Instances are grouped in square chunks. The objects of a chunk are created
+ * when the chunk enters the radius around the camera (a limited number at
+ * each frame) and deleted when it leaves it. Objects always belong to the
+ * chunk of their initial instance, even if they are moved. Objects deleted by
+ * the game are not created again when their chunk is loaded again.
+ *
+ * \see gd::Layout::SetStreamingChunkSize
+ * \ingroup GameEngine
+ */
+class GD_API InstancesStreamer {
+ public:
+  InstancesStreamer() : chunkSize(0), radius(0){};
+
+  /**
+   * \brief Group the instances in chunks of \a chunkSize pixels, removing the
+   * chunks loaded before.
+   *
+   * \warning The instances are not copied: the container must not be modified
+   * or destroyed while the InstancesStreamer is used.
+   */
+  void Load(const gd::InitialInstancesContainer& instances,
+            float chunkSize,
+            float radius);
+
+  /**
+   * \brief Forget all the chunks, without deleting their objects.
+   */
+  void Clear();
+
+  /**
+   * \brief Return true if instances are streamed.
+   */
+  bool IsEnabled() const { return chunkSize > 0; }
+
+  /**
+   * \brief Create the objects of the chunks entering the radius around the
+   * center, and delete the objects of the chunks leaving it.
+   *
+   * \param maximumCreatedObjects The maximum number of objects created by this
+   * call, so that the creation of big chunks is spread over several frames. 0
+   * to create all the objects.
+   * \return The number of objects created.
+   */
+  std::size_t Update(RuntimeScene& scene,
+                     float centerX,
+                     float centerY,
+                     std::size_t maximumCreatedObjects);
+
+  /**
+   * \brief Forget an object deleted by the game, so that it's not created
+   * again when its chunk is loaded again.
+   */
+  void ObjectDeleted(RuntimeObject* object);
+
+  /**
+   * \brief Return the number of chunks containing instances.
+   */
+  std::size_t GetChunksCount() const { return chunks.size(); }
+
+  /**
+   * \brief Return the number of chunks in the radius around the center.
+   */
+  std::size_t GetLoadedChunksCount() const { return loadedChunks.size(); }
+
+ private:
+  struct Chunk {
+    int x;
+    int y;
+    std::vector<const gd::InitialInstance*> instances;
+    std::vector<RuntimeObject*>
+        objects;  ///< The objects created for the instances, if any.
+    std::vector<bool> deleted;  ///< True for the instances whose objects
+                                ///< were deleted by the game.
+    std::size_t nextInstance;   ///< The next instance to create.
+    bool loaded;
+  };
+
+  static std::int64_t GetChunkKey(int x, int y) {
+    return (static_cast<std::int64_t>(x) << 32) ^
+           static_cast<std::uint32_t>(y);
+  }
+  void UnloadChunk(RuntimeScene& scene, Chunk& chunk);
+
+  float chunkSize;
+  float radius;
+  std::unordered_map<std::int64_t, Chunk> chunks;
+  std::vector<Chunk*> loadedChunks;
+  std::unordered_map<RuntimeObject*, std::pair<Chunk*, std::size_t> >
+      objectsInstances;  ///< The chunk and the instance of each object.
+};
+
+#endif  // INSTANCESSTREAMER_H
@@ -0,0 +1,51 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/InternedString.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+struct InternedString::Table {
+  std::mutex mutex;
+  std::unordered_map<gd::String, std::unique_ptr<Entry>> entries;
+};
+
+InternedString::Table& InternedString::GetTable() {
+  static Table table;
+  return table;
+}
+
+InternedString::InternedString() {
+  static const Entry* emptyStringEntry = Intern("");
+  entry = emptyStringEntry;
+}
+
+InternedString::InternedString(const gd::String& string)
+    : entry(Intern(string)) {}
+
+InternedString::InternedString(const char* string)
+    : entry(Intern(gd::String(string))) {}
+
+const InternedString::Entry* InternedString::Intern(const gd::String& string) {
+  Table& table = GetTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  auto it = table.entries.find(string);
+  if (it != table.entries.end()) return it->second.get();
+
+  std::unique_ptr<Entry> entry(new Entry);
+  entry->string = string;
+  entry->hash = std::hash<gd::String>()(string);
+  const Entry* internedEntry = entry.get();
+  table.entries.emplace(string, std::move(entry));
+  return internedEntry;
+}
+
+std::size_t InternedString::GetInternedStringsCount() {
+  Table& table = GetTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  return table.entries.size();
+}
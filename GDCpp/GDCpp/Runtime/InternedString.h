@@ -0,0 +1,102 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef INTERNEDSTRING_H
+#define INTERNEDSTRING_H
+
+#include <cstddef>
+#include <functional>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief An identifier (name of a layer, of a behavior...) stored only once
+ * for the whole game, so that identifiers can be compared by comparing
+ * pointers and hashed without reading the string.
+ *
+ * Strings are interned when an InternedString is constructed from them: this
+ * is a lookup in a table shared by all the threads, so construct the
+ * InternedString once (for example as a static constant in the code
+ * generated from events) and then use it. The constructors are explicit so
+ * that strings are not interned by mistake.
+ *
+ * \note Interned strings are never released: only use InternedString for
+ * identifiers, not for arbitrary texts.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API InternedString {
+ public:
+  /**
+   * \brief Construct an interned empty string.
+   */
+  InternedString();
+
+  /**
+   * \brief Construct an InternedString from a string, interning the string
+   * if it was not already.
+   */
+  explicit InternedString(const gd::String& string);
+
+  /**
+   * \brief Construct an InternedString from a string encoded in UTF8.
+   */
+  explicit InternedString(const char* string);
+
+  /**
+   * \brief Return the interned string.
+   */
+  const gd::String& GetString() const { return entry->string; }
+
+  operator const gd::String&() const { return entry->string; }
+
+  /**
+   * \brief Return the hash of the string, computed when it was interned.
+   */
+  std::size_t GetHash() const { return entry->hash; }
+
+  bool empty() const { return entry->string.empty(); }
+
+  bool operator==(const InternedString& other) const {
+    return entry == other.entry;
+  }
+  bool operator!=(const InternedString& other) const {
+    return entry != other.entry;
+  }
+
+  /**
+   * \brief Return the number of strings interned in the game.
+   */
+  static std::size_t GetInternedStringsCount();
+
+ private:
+  struct Entry {
+    gd::String string;
+    std::size_t hash;
+  };
+
+  struct Table;
+
+  static const Entry* Intern(const gd::String& string);
+
+  /**
+   * \brief Return the table of the interned strings, constructed on first
+   * use so that InternedString can be used to initialize static constants.
+   */
+  static Table& GetTable();
+
+  const Entry* entry;  ///< The interned string, shared by all the
+                       ///< InternedString constructed from the same string.
+};
+
+namespace std {
+template <>
+struct hash<InternedString> {
+  size_t operator()(const InternedString& string) const {
+    return string.GetHash();
+  }
+};
+}  // namespace std
+
+#endif  // INTERNEDSTRING_H
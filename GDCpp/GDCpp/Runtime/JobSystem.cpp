@@ -0,0 +1,154 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/JobSystem.h"
+#include <algorithm>
+#include <system_error>
+
+JobSystem::JobSystem(std::size_t threadsCount_)
+    : threadsCount(threadsCount_),
+      threadsStarted(false),
+      generation(0),
+      stopping(false),
+      job(nullptr),
+      remainingRanges(0),
+      running(false) {
+  if (threadsCount == 0) {
+    threadsCount = std::min<std::size_t>(
+        std::max<unsigned int>(std::thread::hardware_concurrency(), 1), 8);
+  }
+
+  for (std::size_t i = 0; i < threadsCount; ++i)
+    queues.push_back(std::unique_ptr<Queue>(new Queue));
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+  for (auto& thread : threads) thread.join();
+}
+
+bool JobSystem::StartThreads() {
+  if (threadsStarted) return !threads.empty();
+
+  threadsStarted = true;
+  for (std::size_t i = 1; i < threadsCount; ++i) {
+    try {
+      threads.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+    } catch (const std::system_error&) {
+      break;  // Use the threads already started, if any.
+    }
+  }
+
+  // Ranges are still put in the queues of threads that could not be started,
+  // and are stolen by the others.
+  return !threads.empty();
+}
+
+void JobSystem::ParallelFor(
+    std::size_t count,
+    std::size_t grainSize,
+    const std::function<void(std::size_t, std::size_t)>& fn) {
+  if (count == 0) return;
+  if (grainSize == 0) grainSize = 1;
+  if (count <= grainSize || threadsCount <= 1) {
+    fn(0, count);
+    return;
+  }
+
+  // Only one ParallelFor uses the threads at a time: the others (nested ones,
+  // or ones called at the same time by other threads) run on their thread.
+  bool alreadyRunning = false;
+  if (!running.compare_exchange_strong(alreadyRunning, true)) {
+    fn(0, count);
+    return;
+  }
+  if (!StartThreads()) {
+    running = false;
+    fn(0, count);
+    return;
+  }
+
+  // The job is set before the ranges are queued, so that any thread taking a
+  // range sees it.
+  job = &fn;
+  remainingRanges = (count + grainSize - 1) / grainSize;
+  std::size_t queueIndex = 0;
+  for (std::size_t begin = 0; begin < count; begin += grainSize) {
+    Queue& queue = *queues[queueIndex];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.ranges.push_back(Range{begin, std::min(begin + grainSize, count)});
+    }
+    queueIndex = (queueIndex + 1) % queues.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    generation++;
+  }
+  workAvailable.notify_all();
+
+  RunRanges(0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  workDone.wait(lock, [this]() { return remainingRanges == 0; });
+  job = nullptr;
+  running = false;
+}
+
+bool JobSystem::TakeRange(std::size_t queueIndex, Range& range) {
+  {
+    Queue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.ranges.empty()) {
+      range = queue.ranges.back();
+      queue.ranges.pop_back();
+      return true;
+    }
+  }
+
+  for (std::size_t i = 1; i < queues.size(); ++i) {
+    Queue& queue = *queues[(queueIndex + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.ranges.empty()) {
+      range = queue.ranges.front();
+      queue.ranges.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void JobSystem::RunRanges(std::size_t queueIndex) {
+  Range range;
+  while (TakeRange(queueIndex, range)) {
+    (*job)(range.begin, range.end);
+    if (--remainingRanges == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      workDone.notify_all();
+    }
+  }
+}
+
+void JobSystem::WorkerLoop(std::size_t queueIndex) {
+  std::size_t lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      workAvailable.wait(lock, [this, lastGeneration]() {
+        return stopping || generation != lastGeneration;
+      });
+      if (stopping) return;
+      lastGeneration = generation;
+    }
+
+    RunRanges(queueIndex);
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_JOBSYSTEM_H
+#define GDCPP_JOBSYSTEM_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Run work split in ranges on a pool of threads, each thread taking
+ * ranges from its own queue then stealing ranges from the other queues, so
+ * that threads stay busy even when ranges don't have the same cost.
+ *
+ * The threads are only started at the first call to ParallelFor having more
+ * than one range, and wait for work between the calls.
+ *
+ * \see RuntimeGame::GetJobSystem
+ * \ingroup GameEngine
+ */
+class GD_API JobSystem {
+ public:
+  /**
+   * \param threadsCount The number of threads running the work, including the
+   * thread calling ParallelFor. If 0, the number of hardware threads is used
+   * (up to 8).
+   */
+  JobSystem(std::size_t threadsCount = 0);
+  ~JobSystem();
+
+  /**
+   * \brief Call \a fn on ranges of at most \a grainSize indices, covering the
+   * indices from 0 to \a count, and return once all the ranges are done.
+   *
+   * The calling thread runs ranges too. If there is only one range, if
+   * threads can't be started or if another ParallelFor is running (called by
+   * \a fn or by another thread), \a fn is called on the calling thread only.
+   *
+   * \note \a fn must not throw.
+   */
+  void ParallelFor(std::size_t count,
+                   std::size_t grainSize,
+                   const std::function<void(std::size_t, std::size_t)>& fn);
+
+  /**
+   * \brief Return the number of threads running the work, including the
+   * thread calling ParallelFor.
+   */
+  std::size_t GetThreadsCount() const { return threadsCount; }
+
+ private:
+  struct Range {
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /**
+   * \brief The ranges to be run by a thread, also stolen by the others.
+   */
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+  };
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  /**
+   * \brief Start the threads, if not done yet.
+   * \return false if the threads can't be started.
+   */
+  bool StartThreads();
+
+  /**
+   * \brief Pop a range from the back of the queue of the thread or, if empty,
+   * steal one from the front of the queue of another thread.
+   */
+  bool TakeRange(std::size_t queueIndex, Range& range);
+
+  /**
+   * \brief Run ranges until there is none left.
+   */
+  void RunRanges(std::size_t queueIndex);
+
+  void WorkerLoop(std::size_t queueIndex);
+
+  std::size_t threadsCount;
+  bool threadsStarted;
+  std::vector<std::unique_ptr<Queue>> queues;  ///< One queue per thread, the
+                                               ///< first one being for the
+                                               ///< calling thread.
+  std::vector<std::thread> threads;
+
+  std::mutex mutex;  ///< Protects generation and stopping.
+  std::condition_variable workAvailable;
+  std::condition_variable workDone;
+  std::size_t generation;  ///< Incremented at each ParallelFor to wake up the
+                           ///< threads.
+  bool stopping;
+  std::atomic<const std::function<void(std::size_t, std::size_t)>*> job;
+  std::atomic<std::size_t> remainingRanges;
+  std::atomic<bool> running;  ///< True while a ParallelFor uses the threads.
+};
+
+#endif  // GDCPP_JOBSYSTEM_H
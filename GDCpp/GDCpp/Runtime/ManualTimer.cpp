@@ -5,4 +5,4 @@
  */
 #include "GDCpp/Runtime/ManualTimer.h"
 
-ManualTimer::ManualTimer() : time(0), isPaused(false) {}
+ManualTimer::ManualTimer() : time(0), isPaused(false), lastClockTime(0) {}
@@ -11,6 +11,10 @@
 /**
  * \brief Manual timer, updated using ManualTimer::UpdateTime member function.
  *
+ * The timer can also be updated lazily, using ManualTimer::UpdateTimeTo: it
+ * then remembers the time of the clock when it was last updated, so that a
+ * clock can run without updating all its timers at each frame.
+ *
  * \ingroup GameEngine
  */
 class GD_API ManualTimer {
@@ -27,6 +31,20 @@ class GD_API ManualTimer {
     if (!isPaused) time += time_;
   };
 
+  /**
+   * \brief Update the time of the timer with the time elapsed on a clock since
+   * the last call to UpdateTimeTo.
+   *
+   * The timer must be updated before being reset, paused or unpaused, so that
+   * the change happens at the current time of the clock.
+   *
+   * \param clockTime The current time of the clock, in microseconds.
+   */
+  inline void UpdateTimeTo(signed long long clockTime) {
+    UpdateTime(clockTime - lastClockTime);
+    lastClockTime = clockTime;
+  };
+
   /**
    * \brief Reset time to zero.
    */
@@ -58,6 +76,8 @@ class GD_API ManualTimer {
  private:
   signed long long time;  ///< Time elapsed in microseconds
   bool isPaused;          ///< True if timer is paused
+  signed long long lastClockTime;  ///< Time of the clock when the timer was
+                                   ///< last updated by UpdateTimeTo.
 };
 
 #endif  // MANUALTIMER_H
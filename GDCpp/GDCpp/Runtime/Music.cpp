@@ -7,7 +7,10 @@
 
 using namespace std;
 
-Music::Music() : buffer(NULL), volume(100) {}
+Music::Music()
+    : buffer(NULL),
+      volume(100),
+      bufferMemoryAccount(gd::SystemStats::Sounds) {}
 
 bool Music::OpenFromFile(const gd::String& filename) {
 #if defined(GD_IDE_ONLY)
@@ -22,10 +25,11 @@ void Music::SetBuffer(const char* newbuffer, std::size_t size) {
     return;
   }
 
-  if (buffer != NULL) delete buffer;
+  delete[] buffer;
 
   buffer = new char[size];
   memcpy(buffer, newbuffer, size);
+  bufferMemoryAccount.SetBytes(size);
 }
 
 bool Music::OpenFromMemory(std::size_t size) {
@@ -34,6 +38,10 @@ bool Music::OpenFromMemory(std::size_t size) {
   return true;
 }
 
+bool Music::OpenFromMemory(const char* data, std::size_t size) {
+  return music.openFromMemory(data, size);
+}
+
 void Music::Play() { music.play(); }
 
 void Music::Pause() { music.pause(); }
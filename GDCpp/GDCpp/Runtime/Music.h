@@ -7,6 +7,7 @@
 #define MUSIC_H
 #include <SFML/Audio.hpp>
 #include <string>
+#include "GDCore/Tools/SystemStats.h"
 #include "GDCpp/Runtime/String.h"
 
 /**
@@ -18,7 +19,7 @@
 class GD_API Music {
  public:
   Music();
-  virtual ~Music(){};
+  virtual ~Music() { delete[] buffer; };
 
   /**
    * \brief Open the music from a file.
@@ -45,6 +46,12 @@ class GD_API Music {
    */
   bool OpenFromMemory(std::size_t size);
 
+  /**
+   * \brief Open music stored in memory, without copying it: \a data must stay
+   * valid while the music is used.
+   */
+  bool OpenFromMemory(const char* data, std::size_t size);
+
   sf::Music music;  ///< SFML Music
   char* buffer;     ///< Music buffer when music have been loaded from memory
 
@@ -125,6 +132,7 @@ class GD_API Music {
 
  private:
   float volume;  ///< Music volume
+  gd::MemoryAccount bufferMemoryAccount;  ///< The memory of the buffer.
 };
 
 #endif  // MUSIC_H
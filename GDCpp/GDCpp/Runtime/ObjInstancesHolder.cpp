@@ -4,59 +4,319 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Extensions/CppPlatform.h"
+#include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/profile.h"
 
+namespace {
+// Function local statics are used so that the identifiers can be safely
+// requested during the static initialization of the events compiled code.
+std::unordered_map<gd::String, std::size_t>& GetObjectTypeIds() {
+  static std::unordered_map<gd::String, std::size_t> typeIds;
+  return typeIds;
+}
+
+std::vector<gd::String>& GetObjectTypeNames() {
+  static std::vector<gd::String> typeNames;
+  return typeNames;
+}
+}  // namespace
+
+std::size_t ObjInstancesHolder::GetObjectTypeId(const gd::String& name) {
+  auto& typeIds = GetObjectTypeIds();
+  auto it = typeIds.find(name);
+  if (it != typeIds.end()) return it->second;
+
+  std::size_t typeId = GetObjectTypeNames().size();
+  GetObjectTypeNames().push_back(name);
+  typeIds[name] = typeId;
+  return typeId;
+}
+
+const gd::String& ObjInstancesHolder::GetObjectTypeName(std::size_t typeId) {
+  static const gd::String badName;
+  auto& typeNames = GetObjectTypeNames();
+  return typeId < typeNames.size() ? typeNames[typeId] : badName;
+}
+
+const std::size_t ObjInstancesHolder::maxRenderQueueChangesCount = 16;
+const std::size_t ObjInstancesHolder::maxRecycledObjectsCount = 128;
+
 RuntimeObject* ObjInstancesHolder::AddObject(RuntimeObjSPtr&& object) {
-  auto it = objectsInstances[object->GetName()].insert(
-      objectsInstances[object->GetName()].end(), std::move(object));
-  objectsInstancesRefs[(*it)->GetName()].push_back(it->get());
+  object->instancesHolder = this;
+  object->recyclingTypeId = GetObjectTypeId(object->GetName());
+  object->renderSequence = nextRenderSequence++;
+  InsertInRenderQueue(renderQueues[object->GetInternedLayer()], object.get());
+  transforms.Add(*object);
+
+  return AddObjectToLists(std::move(object));
+}
+
+RuntimeObject* ObjInstancesHolder::AddObjectToLists(RuntimeObjSPtr&& object) {
+  std::size_t typeId = GetObjectTypeId(object->GetName());
+  EnsureListsExist(typeId);
+
+  RuntimeObjList& list = objectsInstances[typeId];
+  object->objectsListTypeId = typeId;
+  object->objectsListIndex = list.size();
+  auto it = list.insert(list.end(), std::move(object));
+  objectsInstancesRefs[typeId].push_back(it->get());
 
   return it->get();
 }
 
-RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
-    const gd::String& name) {
-  return objectsInstancesRefs[name];
+RuntimeObjSPtr ObjInstancesHolder::TakeObject(const RuntimeObject* object) {
+  std::size_t typeId = object->objectsListTypeId;
+  std::size_t index = object->objectsListIndex;
+  if (typeId >= objectsInstances.size() ||
+      index >= objectsInstances[typeId].size() ||
+      objectsInstances[typeId][index].get() != object)
+    return RuntimeObjSPtr();  // The object is not in this container.
+
+  RuntimeObjList& list = objectsInstances[typeId];
+  RuntimeObjNonOwningPtrList& refsList = objectsInstancesRefs[typeId];
+  RuntimeObjSPtr theObject = std::move(list[index]);
+
+  if (keepObjectsOrder) {
+    // Leave a hole, removed later in a single pass so that removing a lot of
+    // objects is not quadratic.
+    refsList[index] = nullptr;
+    listsToCompact[typeId] = true;
+    hasListsToCompact = true;
+  } else {
+    // Move the last object in place of the removed one.
+    if (index + 1 != list.size()) {
+      list[index] = std::move(list.back());
+      refsList[index] = refsList.back();
+      list[index]->objectsListIndex = index;
+    }
+    list.pop_back();
+    refsList.pop_back();
+  }
+
+  return theObject;
 }
 
-void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
-  std::unique_ptr<RuntimeObject> theObject;  // We need the object to keep
-                                             // alive.
-
-  // Find and erase the object from the object lists.
-  for (auto it = objectsInstances.begin(); it != objectsInstances.end(); ++it) {
-    RuntimeObjList& list = it->second;
-    for (std::size_t i = 0; i < list.size(); ++i) {
-      if (list[i].get() == object) {
-        theObject = std::move(list[i]);
-        list.erase(list.begin() + i);
-        break;
-      }
+void ObjInstancesHolder::RemoveObject(RuntimeObject* object) {
+  RuntimeObjSPtr theObject = TakeObject(object);
+  if (!theObject) return;
+
+  RemoveFromRenderQueue(renderQueues[object->GetInternedLayer()], object);
+  transforms.Remove(*theObject);
+  theObject->instancesHolder = NULL;
+  RecycleObject(std::move(theObject));
+}
+
+void ObjInstancesHolder::RecycleObject(RuntimeObjSPtr object) {
+  // The object is destroyed with the pointer if it is not kept.
+  if (!object->CanBeRecycled()) return;
+
+  std::size_t typeId = object->recyclingTypeId;
+  if (typeId >= recycledObjects.size()) recycledObjects.resize(typeId + 1);
+
+  RuntimeObjList& recycled = recycledObjects[typeId];
+  if (recycled.size() >= maxRecycledObjectsCount) return;
+
+  // Behaviors must not act on the scene while the object is not used.
+  if (object->coldData)
+    for (auto& behavior : object->coldData->behaviors)
+      behavior.second->Activate(false);
+  recycled.push_back(std::move(object));
+}
+
+RuntimeObjSPtr ObjInstancesHolder::CreateObject(RuntimeScene& scene,
+                                                gd::Object& object) {
+  std::size_t typeId = GetObjectTypeId(object.GetName());
+  if (typeId < recycledObjects.size()) {
+    RuntimeObjList& recycled = recycledObjects[typeId];
+    while (!recycled.empty()) {
+      RuntimeObjSPtr recycledObject = std::move(recycled.back());
+      recycled.pop_back();
+
+      if (recycledObject->Reset(scene, object)) return recycledObject;
     }
   }
-  // Find and erase the object from the object raw pointers lists.
-  for (auto it = objectsInstancesRefs.begin(); it != objectsInstancesRefs.end();
-       ++it) {
-    RuntimeObjNonOwningPtrList& associatedList = it->second;
-    associatedList.erase(
-        std::remove(associatedList.begin(), associatedList.end(), object),
-        associatedList.end());
+
+  return CppPlatform::Get().CreateRuntimeObject(scene, object);
+}
+
+void ObjInstancesHolder::RemoveObjects(const gd::String& name) {
+  std::size_t typeId = GetObjectTypeId(name);
+  EnsureListsExist(typeId);
+
+  for (auto& object : objectsInstances[typeId]) {
+    if (!object) continue;
+
+    RemoveFromRenderQueue(renderQueues[object->GetInternedLayer()], object.get());
+    transforms.Remove(*object);
+    object->instancesHolder = NULL;
+  }
+  objectsInstances[typeId].clear();
+  objectsInstancesRefs[typeId].clear();
+  listsToCompact[typeId] = false;
+}
+
+void ObjInstancesHolder::InsertInRenderQueue(RenderQueue& queue,
+                                             RuntimeObject* object) {
+  RuntimeObjNonOwningPtrList& objects = queue.objects;
+  if (queue.needsSort || objects.empty() ||
+      !IsRenderedBefore(object, objects.back())) {
+    objects.push_back(object);
+    return;
+  }
+
+  // Sort the list again when it is accessed if a lot of objects were moved,
+  // rather than inserting them one by one.
+  if (++queue.changesCount > maxRenderQueueChangesCount) {
+    objects.push_back(object);
+    queue.needsSort = true;
+    return;
+  }
+
+  objects.insert(
+      std::upper_bound(objects.begin(), objects.end(), object, IsRenderedBefore),
+      object);
+}
+
+void ObjInstancesHolder::RemoveFromRenderQueue(RenderQueue& queue,
+                                               const RuntimeObject* object) {
+  RuntimeObjNonOwningPtrList& objects = queue.objects;
+  if (!queue.needsSort) {
+    auto it = std::lower_bound(
+        objects.begin(), objects.end(), object, IsRenderedBefore);
+    if (it != objects.end() && *it == object) {
+      objects.erase(it);
+      return;
+    }
+  }
+
+  objects.erase(std::remove(objects.begin(), objects.end(), object),
+                objects.end());
+}
+
+const RuntimeObjNonOwningPtrList&
+ObjInstancesHolder::GetLayerObjectsSortedByZOrder(
+    const InternedString& layer) {
+  RenderQueue& queue = renderQueues[layer];
+  if (queue.needsSort) {
+    std::sort(queue.objects.begin(), queue.objects.end(), IsRenderedBefore);
+    queue.needsSort = false;
   }
 
-  AddObject(std::move(theObject));
+  queue.changesCount = 0;
+  return queue.objects;
+}
+
+void ObjInstancesHolder::SetObjectZOrder(RuntimeObject* object, int zOrder) {
+  if (object->zOrder == zOrder) return;
+
+  RenderQueue& queue = renderQueues[object->GetInternedLayer()];
+  if (queue.needsSort) {
+    object->zOrder = zOrder;  // The list will be sorted anyway.
+    return;
+  }
+
+  RemoveFromRenderQueue(queue, object);
+  object->zOrder = zOrder;
+  InsertInRenderQueue(queue, object);
+}
+
+void ObjInstancesHolder::SetObjectLayer(RuntimeObject* object,
+                                        const gd::String& layer) {
+  InternedString internedLayer(layer);
+  if (object->layer == internedLayer) return;
+
+  RemoveFromRenderQueue(renderQueues[object->layer], object);
+  object->layer = internedLayer;
+  InsertInRenderQueue(renderQueues[internedLayer], object);
+}
+
+void ObjInstancesHolder::CompactObjectsList(std::size_t typeId) {
+  RuntimeObjList& list = objectsInstances[typeId];
+  RuntimeObjNonOwningPtrList& refsList = objectsInstancesRefs[typeId];
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < list.size(); ++i) {
+    if (!list[i]) continue;
+
+    if (i != count) {
+      list[count] = std::move(list[i]);
+      refsList[count] = refsList[i];
+      list[count]->objectsListIndex = count;
+    }
+    count++;
+  }
+
+  list.resize(count);
+  refsList.resize(count);
+  listsToCompact[typeId] = false;
+}
+
+void ObjInstancesHolder::CompactObjectsLists() {
+  for (std::size_t typeId = 0; typeId < listsToCompact.size(); ++typeId) {
+    if (listsToCompact[typeId]) CompactObjectsList(typeId);
+  }
+
+  hasListsToCompact = false;
+}
+
+std::size_t ObjInstancesHolder::GetObjectsCount() {
+  if (hasListsToCompact) CompactObjectsLists();
+
+  std::size_t count = 0;
+  for (const auto& list : objectsInstances) count += list.size();
+  return count;
+}
+
+void ObjInstancesHolder::SetKeepObjectsOrder(bool keep) {
+  if (hasListsToCompact) CompactObjectsLists();
+  keepObjectsOrder = keep;
+}
+
+RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
+    const gd::String& name) {
+  return GetObjectsRawPointers(GetObjectTypeId(name));
+}
+
+RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
+    std::size_t typeId) {
+  if (typeId >= objectsInstancesRefs.size())
+    return RuntimeObjNonOwningPtrList();
+  if (listsToCompact[typeId]) CompactObjectsList(typeId);
+
+  return objectsInstancesRefs[typeId];
+}
+
+void ObjInstancesHolder::GetObjectsRawPointers(
+    std::size_t typeId, RuntimeObjNonOwningPtrList& list) {
+  if (typeId >= objectsInstancesRefs.size()) {
+    list.clear();
+    return;
+  }
+  if (listsToCompact[typeId]) CompactObjectsList(typeId);
+
+  list.assign(objectsInstancesRefs[typeId].begin(),
+              objectsInstancesRefs[typeId].end());
+}
+
+void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
+  // The object is still stored in the list of its previous name.
+  RuntimeObjSPtr theObject = TakeObject(object);
+  if (theObject) AddObjectToLists(std::move(theObject));
 }
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder& other) {
-  objectsInstances.clear();
-  objectsInstancesRefs.clear();
+  Clear();
+  keepObjectsOrder = other.keepObjectsOrder;
 
   for (auto it = other.objectsInstances.cbegin();
        it != other.objectsInstances.cend();
        ++it) {
-    for (std::size_t i = 0; i < it->second.size();
+    for (std::size_t i = 0; i < it->size();
          ++i)  // We need to really copy the objects
-      AddObject(std::unique_ptr<RuntimeObject>(it->second[i]->Clone()));
+      if ((*it)[i])
+        AddObject(std::unique_ptr<RuntimeObject>((*it)[i]->Clone()));
   }
 }
 
@@ -2,6 +2,7 @@
 #define OBJINSTANCESHOLDER_H
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -20,6 +21,10 @@ using RuntimeObjSPtr = std::unique_ptr<RuntimeObject>;
 /**
  * \brief Contains lists of objects classified by the name of the objects.
  *
+ * Lists are stored according to an identifier associated to each object name
+ * (see ObjInstancesHolder::GetObjectTypeId), so that generated code can access
+ * them without hashing the names of the objects.
+ *
  * \see RuntimeScene
  * \ingroup GameEngine
  */
@@ -28,7 +33,10 @@ class GD_API ObjInstancesHolder {
   /**
    * \brief Default constructor
    */
-  ObjInstancesHolder(){};
+  ObjInstancesHolder()
+      : hasListsToCompact(false),
+        keepObjectsOrder(false),
+        nextRenderSequence(0){};
 
   /**
    * \brief Copy constructor
@@ -53,11 +61,54 @@ class GD_API ObjInstancesHolder {
    */
   RuntimeObject* AddObject(RuntimeObjSPtr&& object);
 
+  /**
+   * \brief Create a new object from \a object, reusing an instance deleted
+   * before if possible (see RuntimeObject::Reset).
+   * \note The new object is not added to the container.
+   * \return The new object, or an empty pointer if it could not be created.
+   */
+  RuntimeObjSPtr CreateObject(RuntimeScene& scene, gd::Object& object);
+
+  /**
+   * \brief Get the number of deleted instances kept to be reused by
+   * CreateObject, for the specified identifier.
+   * \see ObjInstancesHolder::GetObjectTypeId
+   */
+  std::size_t GetRecycledObjectsCount(std::size_t typeId) const {
+    return typeId < recycledObjects.size() ? recycledObjects[typeId].size()
+                                           : 0;
+  }
+
+  /**
+   * \brief Get the identifier associated to the specified object name.
+   *
+   * Identifiers are small integers, shared by all the containers and stable
+   * for the whole lifetime of the program: they can be resolved once (at scene
+   * loading or when generated code is loaded) and then used to access objects
+   * lists without any string hashing.
+   */
+  static std::size_t GetObjectTypeId(const gd::String& name);
+
+  /**
+   * \brief Get the object name associated to the specified identifier.
+   */
+  static const gd::String& GetObjectTypeName(std::size_t typeId);
+
   /**
    * \brief Get all objects with the specified name
    */
   inline const RuntimeObjList& GetObjects(const gd::String& name) {
-    return objectsInstances[name];
+    return GetObjects(GetObjectTypeId(name));
+  }
+
+  /**
+   * \brief Get all objects associated to the specified identifier.
+   * \see ObjInstancesHolder::GetObjectTypeId
+   */
+  inline const RuntimeObjList& GetObjects(std::size_t typeId) {
+    EnsureListsExist(typeId);
+    if (listsToCompact[typeId]) CompactObjectsList(typeId);
+    return objectsInstances[typeId];
   }
 
   /**
@@ -65,15 +116,36 @@ class GD_API ObjInstancesHolder {
    */
   RuntimeObjNonOwningPtrList GetObjectsRawPointers(const gd::String& name);
 
+  /**
+   * \brief Get a "raw pointers" list to objects associated to the specified
+   * identifier.
+   * \see ObjInstancesHolder::GetObjectTypeId
+   */
+  RuntimeObjNonOwningPtrList GetObjectsRawPointers(std::size_t typeId);
+
+  /**
+   * \brief Same as GetObjectsRawPointers(typeId), storing the objects in \a
+   * list (replacing its content) so that its memory can be reused.
+   */
+  void GetObjectsRawPointers(std::size_t typeId,
+                             RuntimeObjNonOwningPtrList& list);
+
+  /**
+   * \brief Create the (empty) list of objects for the specified identifier,
+   * if it does not exist yet.
+   */
+  inline void AddObjectsList(std::size_t typeId) { EnsureListsExist(typeId); }
+
   /**
    * \brief Get a list of all objects contained.
    */
   inline RuntimeObjNonOwningPtrList GetAllObjects() {
+    if (hasListsToCompact) CompactObjectsLists();
     RuntimeObjNonOwningPtrList objList;
 
     for (auto it = objectsInstances.begin(); it != objectsInstances.end();
          ++it) {
-      for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
+      for (auto it2 = it->begin(); it2 != it->end(); ++it2) {
         objList.push_back(it2->get());
       }
     }
@@ -81,45 +153,31 @@ class GD_API ObjInstancesHolder {
     return objList;
   }
 
+  /**
+   * \brief Get the number of objects contained.
+   */
+  std::size_t GetObjectsCount();
+
   /**
    * \brief Remove an object
    *
+   * Removal is done in constant time, by moving the last object of the list
+   * in place of the removed one, unless the order of objects is kept (see
+   * SetKeepObjectsOrder). The object is then kept to be reused by
+   * CreateObject if it can be recycled, or destroyed.
+   *
    * \warning During the game, do not directly remove an object using this
    * function, but make its name empty instead. Example: \code
    * myObject->SetName(""); //The scene will take care of deleting the object
    * scene.objectsInstances.ObjectNameHasChanged(myObject);
    * \endcode
    */
-  inline void RemoveObject(RuntimeObject* object) {
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      RuntimeObjList& associatedList = it->second;
-      associatedList.erase(
-          std::remove_if(
-              associatedList.begin(),
-              associatedList.end(),
-              [&object](const std::unique_ptr<RuntimeObject>& objectPtr) {
-                return objectPtr.get() == object;
-              }),
-          associatedList.end());
-    }
-    for (auto it = objectsInstancesRefs.begin();
-         it != objectsInstancesRefs.end();
-         ++it) {
-      RuntimeObjNonOwningPtrList& associatedList = it->second;
-      associatedList.erase(
-          std::remove(associatedList.begin(), associatedList.end(), object),
-          associatedList.end());
-    }
-  }
+  void RemoveObject(RuntimeObject* object);
 
   /**
    * \brief Remove an entire list of object with a given name
    */
-  inline void RemoveObjects(const gd::String& name) {
-    objectsInstances[name].clear();
-    objectsInstancesRefs[name].clear();
-  }
+  void RemoveObjects(const gd::String& name);
 
   /**
    * \brief To be called when an object has changed its name.
@@ -133,16 +191,157 @@ class GD_API ObjInstancesHolder {
   inline void Clear() {
     objectsInstances.clear();
     objectsInstancesRefs.clear();
+    listsToCompact.clear();
+    hasListsToCompact = false;
+    renderQueues.clear();
+    nextRenderSequence = 0;
+    recycledObjects.clear();
+  }
+
+  /**
+   * \brief Get the objects of a layer, sorted by z-order. Objects having the
+   * same z-order are sorted in the order they were added.
+   *
+   * The lists are kept sorted when objects are added, removed or when their
+   * z-order or layer is changed, so that they are only entirely sorted again
+   * if a lot of objects were changed since the last call.
+   */
+  const RuntimeObjNonOwningPtrList& GetLayerObjectsSortedByZOrder(
+      const InternedString& layer);
+
+  /**
+   * \brief Get the objects of a layer, sorted by z-order.
+   */
+  const RuntimeObjNonOwningPtrList& GetLayerObjectsSortedByZOrder(
+      const gd::String& layer) {
+    return GetLayerObjectsSortedByZOrder(InternedString(layer));
   }
 
+  /**
+   * \brief Change the z-order of an object of the container.
+   * \note Called by RuntimeObject::SetZOrder.
+   */
+  void SetObjectZOrder(RuntimeObject* object, int zOrder);
+
+  /**
+   * \brief Change the layer of an object of the container.
+   * \note Called by RuntimeObject::SetLayer.
+   */
+  void SetObjectLayer(RuntimeObject* object, const gd::String& layer);
+
+  /**
+   * \brief Set if the objects must stay in the order they were added when
+   * objects are removed.
+   *
+   * By default, a removed object is replaced by the last object of its list
+   * so that removing objects is done in constant time. When the order is kept,
+   * removed objects leave holes in the lists, which are compacted in a single
+   * pass the next time the lists are accessed.
+   */
+  void SetKeepObjectsOrder(bool keep = true);
+
+  /**
+   * \brief Return true if the objects stay in the order they were added.
+   */
+  bool IsKeepingObjectsOrder() const { return keepObjectsOrder; }
+
+  /**
+   * \brief Get the table storing the positions of the objects of the
+   * container.
+   */
+  ObjectsTransforms& GetTransforms() { return transforms; }
+
  private:
+  /**
+   * \brief The objects of a layer, sorted by z-order.
+   */
+  struct RenderQueue {
+    RenderQueue() : needsSort(false), changesCount(0){};
+
+    RuntimeObjNonOwningPtrList objects;
+    bool needsSort;  ///< True if the objects must be sorted again.
+    std::size_t changesCount;  ///< The number of objects moved in the list
+                               ///< since the last access.
+  };
+
   void Init(const ObjInstancesHolder& other);
 
-  std::unordered_map<gd::String, RuntimeObjList>
-      objectsInstances;  ///< The list of all objects, classified by name
-  std::unordered_map<gd::String, RuntimeObjNonOwningPtrList>
+  /**
+   * \brief Add the object to its lists, without adding it to the render
+   * queues.
+   */
+  RuntimeObject* AddObjectToLists(RuntimeObjSPtr&& object);
+
+  void InsertInRenderQueue(RenderQueue& queue, RuntimeObject* object);
+  void RemoveFromRenderQueue(RenderQueue& queue, const RuntimeObject* object);
+
+  /**
+   * \brief Return true if \a a must be rendered before \a b.
+   */
+  static bool IsRenderedBefore(const RuntimeObject* a, const RuntimeObject* b) {
+    return a->zOrder < b->zOrder ||
+           (a->zOrder == b->zOrder && a->renderSequence < b->renderSequence);
+  }
+
+  /**
+   * \brief Remove the object from its lists, without destroying it.
+   * \return The object, or an empty pointer if it was not in the container.
+   */
+  RuntimeObjSPtr TakeObject(const RuntimeObject* object);
+
+  /**
+   * \brief Keep a removed object to be reused by CreateObject, or destroy it
+   * if it can't be recycled.
+   */
+  void RecycleObject(RuntimeObjSPtr object);
+
+  /**
+   * \brief Remove the holes left by removed objects in a list, when the order
+   * of objects is kept.
+   */
+  void CompactObjectsList(std::size_t typeId);
+
+  /**
+   * \brief Compact all the lists having holes.
+   */
+  void CompactObjectsLists();
+
+  /**
+   * \brief Create the lists up to the specified identifier, if needed.
+   * \note Lists are stored in a std::deque so that references to existing
+   * lists stay valid when lists are added.
+   */
+  inline void EnsureListsExist(std::size_t typeId) {
+    if (typeId < objectsInstances.size()) return;
+
+    objectsInstances.resize(typeId + 1);
+    objectsInstancesRefs.resize(typeId + 1);
+    listsToCompact.resize(typeId + 1, false);
+  }
+
+  ObjectsTransforms transforms;  ///< The positions of the objects. Declared
+                                 ///< before the lists so that it is
+                                 ///< destroyed after the objects.
+  std::deque<RuntimeObjList>
+      objectsInstances;  ///< The list of all objects, indexed by the
+                         ///< identifier of their name.
+  std::deque<RuntimeObjNonOwningPtrList>
       objectsInstancesRefs;  ///< Clones of the objectsInstances lists, but with
                              ///< references instead.
+  std::deque<bool> listsToCompact;  ///< True for the lists having holes left
+                                    ///< by removed objects.
+  bool hasListsToCompact;  ///< True if at least one list must be compacted.
+  bool keepObjectsOrder;   ///< True to keep the order of objects when
+                           ///< objects are removed.
+  std::unordered_map<InternedString, RenderQueue>
+      renderQueues;  ///< The objects of each layer, sorted by z-order.
+  std::size_t nextRenderSequence;
+  std::deque<RuntimeObjList>
+      recycledObjects;  ///< The deleted objects kept to be reused, indexed by
+                        ///< the identifier of their name.
+
+  static const std::size_t maxRenderQueueChangesCount;
+  static const std::size_t maxRecycledObjectsCount;
 };
 
 #endif  // OBJINSTANCESHOLDER_H
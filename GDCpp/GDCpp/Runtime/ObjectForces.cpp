@@ -0,0 +1,67 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectForces.h"
+#include <cmath>
+#include "GDCpp/Runtime/SceneSnapshot.h"
+
+void ObjectForces::Add(float x, float y, float clearing) {
+  forces.push_back(AppliedForce{x, y, std::sqrt(x * x + y * y), clearing});
+  totalX += x;
+  totalY += y;
+}
+
+void ObjectForces::Clear() {
+  forces.clear();
+  totalX = 0;
+  totalY = 0;
+}
+
+void ObjectForces::Update(float elapsedTime) {
+  // Forces are compacted in a single pass, keeping their order, and the
+  // totals are computed with the new values.
+  std::size_t count = 0;
+  totalX = 0;
+  totalY = 0;
+  for (std::size_t i = 0; i < forces.size(); ++i) {
+    AppliedForce force = forces[i];
+    if (force.clearing == 0 || force.length <= 0.001) continue;
+
+    float scale = 1 - (1 - force.clearing) * elapsedTime;
+    force.x *= scale;
+    force.y *= scale;
+    force.length *= scale;
+    totalX += force.x;
+    totalY += force.y;
+    forces[count++] = force;
+  }
+
+  forces.resize(count);
+}
+
+void ObjectForces::SaveState(SceneSnapshotWriter& writer) const {
+  writer.WriteUInt(forces.size());
+  for (const AppliedForce& force : forces) {
+    writer.WriteFloat(force.x);
+    writer.WriteFloat(force.y);
+    writer.WriteFloat(force.length);
+    writer.WriteFloat(force.clearing);
+  }
+}
+
+void ObjectForces::RestoreState(SceneSnapshotReader& reader) {
+  Clear();
+  std::size_t count = reader.ReadUInt();
+  for (std::size_t i = 0; i < count && reader.IsValid(); ++i) {
+    AppliedForce force;
+    force.x = reader.ReadFloat();
+    force.y = reader.ReadFloat();
+    force.length = reader.ReadFloat();
+    force.clearing = reader.ReadFloat();
+    forces.push_back(force);
+    totalX += force.x;
+    totalY += force.y;
+  }
+}
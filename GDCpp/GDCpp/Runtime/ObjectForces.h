@@ -0,0 +1,83 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_OBJECTFORCES_H
+#define GDCPP_OBJECTFORCES_H
+#include <cstddef>
+#include <vector>
+class SceneSnapshotReader;
+class SceneSnapshotWriter;
+
+/**
+ * \brief The forces applied to a RuntimeObject, stored as their cartesian
+ * coordinates with the total of the forces kept up to date.
+ *
+ * Forces are reduced by their clearing factor by scaling their coordinates,
+ * so that updating them does not need any trigonometry.
+ *
+ * \see RuntimeObject::AddForce
+ * \ingroup GameEngine
+ */
+class GD_API ObjectForces {
+ public:
+  ObjectForces() : totalX(0), totalY(0){};
+
+  /**
+   * \brief Add a force.
+   * \param clearing The part of the force kept after one second (0 to only
+   * apply the force once, 1 to never reduce it).
+   */
+  void Add(float x, float y, float clearing);
+
+  /**
+   * \brief Remove all the forces.
+   */
+  void Clear();
+
+  /**
+   * \brief Reduce the forces by their clearing factor during \a elapsedTime
+   * seconds, removing the forces applied once or having a null length.
+   */
+  void Update(float elapsedTime);
+
+  /**
+   * \brief Get the sum of the forces on the X axis.
+   */
+  float GetTotalX() const { return totalX; }
+
+  /**
+   * \brief Get the sum of the forces on the Y axis.
+   */
+  float GetTotalY() const { return totalY; }
+
+  /**
+   * \brief Return the number of forces.
+   */
+  std::size_t GetCount() const { return forces.size(); }
+
+  /**
+   * \brief Write the forces in a snapshot of the scene.
+   */
+  void SaveState(SceneSnapshotWriter& writer) const;
+
+  /**
+   * \brief Restore the forces written by SaveState.
+   */
+  void RestoreState(SceneSnapshotReader& reader);
+
+ private:
+  struct AppliedForce {
+    float x;
+    float y;
+    float length;  ///< Can be negative once the force is reduced beyond 0.
+    float clearing;
+  };
+
+  std::vector<AppliedForce> forces;
+  float totalX;
+  float totalY;
+};
+
+#endif  // GDCPP_OBJECTFORCES_H
@@ -0,0 +1,266 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+const int ObjectsSpatialHash::maxCellsPerObject = 64;
+
+ObjectsSpatialHash::ObjectsSpatialHash(float cellSize_)
+    : cellSize(cellSize_ > 0 ? cellSize_ : 128.0f), queryId(0) {}
+
+ObjectsSpatialHash::CellsRange ObjectsSpatialHash::GetCellsRange(
+    const sf::FloatRect& aabb) const {
+  double minX = std::floor(aabb.left / cellSize);
+  double minY = std::floor(aabb.top / cellSize);
+  double maxX = std::floor((aabb.left + aabb.width) / cellSize);
+  double maxY = std::floor((aabb.top + aabb.height) / cellSize);
+
+  // Compute the number of cells using doubles to avoid overflows with huge
+  // or far away objects (the comparison is also false for NaN or infinite
+  // values).
+  CellsRange range;
+  range.isLarge =
+      !((maxX - minX + 1) * (maxY - minY + 1) <= maxCellsPerObject) ||
+      std::abs(minX) > 1e9 || std::abs(minY) > 1e9;
+  if (range.isLarge) {
+    range.minX = range.minY = range.maxX = range.maxY = 0;
+    return range;
+  }
+
+  range.minX = static_cast<int>(minX);
+  range.minY = static_cast<int>(minY);
+  range.maxX = static_cast<int>(maxX);
+  range.maxY = static_cast<int>(maxY);
+  return range;
+}
+
+void ObjectsSpatialHash::InsertInCells(Entry& entry) {
+  if (entry.range.isLarge) {
+    largeEntries.push_back(&entry);
+    return;
+  }
+
+  for (int x = entry.range.minX; x <= entry.range.maxX; ++x)
+    for (int y = entry.range.minY; y <= entry.range.maxY; ++y)
+      cells[GetCellKey(x, y)].push_back(&entry);
+}
+
+void ObjectsSpatialHash::RemoveFromCells(const Entry& entry) {
+  auto removeEntry = [&entry](std::vector<Entry*>& list) {
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      if (list[i] == &entry) {
+        list[i] = list.back();
+        list.pop_back();
+        return;
+      }
+    }
+  };
+
+  if (entry.range.isLarge) {
+    removeEntry(largeEntries);
+    return;
+  }
+
+  for (int x = entry.range.minX; x <= entry.range.maxX; ++x) {
+    for (int y = entry.range.minY; y <= entry.range.maxY; ++y) {
+      auto cell = cells.find(GetCellKey(x, y));
+      if (cell == cells.end()) continue;
+
+      removeEntry(cell->second);
+      if (cell->second.empty()) cells.erase(cell);
+    }
+  }
+}
+
+const sf::FloatRect& ObjectsSpatialHash::Update(RuntimeObject* object) {
+  sf::FloatRect aabb = object->GetAABB();
+  float centerX = object->GetDrawableX() + object->GetCenterX();
+  float centerY = object->GetDrawableY() + object->GetCenterY();
+  if (centerX < aabb.left) {
+    aabb.width += aabb.left - centerX;
+    aabb.left = centerX;
+  } else if (centerX > aabb.left + aabb.width) {
+    aabb.width = centerX - aabb.left;
+  }
+  if (centerY < aabb.top) {
+    aabb.height += aabb.top - centerY;
+    aabb.top = centerY;
+  } else if (centerY > aabb.top + aabb.height) {
+    aabb.height = centerY - aabb.top;
+  }
+  CellsRange range = GetCellsRange(aabb);
+
+  auto it = entries.find(object);
+  if (it == entries.end()) {
+    Entry& entry = entries[object];
+    entry.object = object;
+    entry.aabb = aabb;
+    entry.centerX = centerX;
+    entry.centerY = centerY;
+    entry.range = range;
+    entry.lastQueryId = queryId;
+    InsertInCells(entry);
+
+    return entry.aabb;
+  }
+
+  Entry& entry = it->second;
+  entry.aabb = aabb;
+  entry.centerX = centerX;
+  entry.centerY = centerY;
+  if (!(entry.range == range)) {
+    RemoveFromCells(entry);
+    entry.range = range;
+    InsertInCells(entry);
+  }
+
+  return entry.aabb;
+}
+
+void ObjectsSpatialHash::Remove(const RuntimeObject* object) {
+  auto it = entries.find(object);
+  if (it == entries.end()) return;
+
+  RemoveFromCells(it->second);
+  entries.erase(it);
+}
+
+void ObjectsSpatialHash::Clear() {
+  entries.clear();
+  cells.clear();
+  largeEntries.clear();
+}
+
+void ObjectsSpatialHash::QueryAABB(const sf::FloatRect& area,
+                                   std::vector<RuntimeObject*>& result) {
+  ForEachObjectInAABB(
+      area, [&result](RuntimeObject* object) { result.push_back(object); });
+}
+
+void ObjectsSpatialHash::QueryPoint(float x,
+                                    float y,
+                                    std::vector<RuntimeObject*>& result) {
+  QueryAABB(sf::FloatRect(x, y, 0, 0), result);
+}
+
+void ObjectsSpatialHash::QueryRadius(float x,
+                                     float y,
+                                     float radius,
+                                     std::vector<RuntimeObject*>& result) {
+  if (!(radius >= 0)) return;
+
+  double sqRadius = double(radius) * radius;
+  sf::FloatRect area(x - radius, y - radius, 2 * radius, 2 * radius);
+  queryId++;
+
+  auto testEntry = [this, x, y, sqRadius, &result](Entry* entry) {
+    if (entry->lastQueryId == queryId) return;
+    entry->lastQueryId = queryId;
+
+    double dx = entry->centerX - x;
+    double dy = entry->centerY - y;
+    if (dx * dx + dy * dy <= sqRadius) result.push_back(entry->object);
+  };
+
+  for (Entry* entry : largeEntries) testEntry(entry);
+
+  CellsRange range = GetCellsRange(area);
+  if (range.isLarge) {
+    for (auto& it : entries) testEntry(&it.second);
+    return;
+  }
+
+  for (int cellX = range.minX; cellX <= range.maxX; ++cellX) {
+    for (int cellY = range.minY; cellY <= range.maxY; ++cellY) {
+      auto cell = cells.find(GetCellKey(cellX, cellY));
+      if (cell == cells.end()) continue;
+
+      for (Entry* entry : cell->second) testEntry(entry);
+    }
+  }
+}
+
+void ObjectsSpatialHash::QueryNearest(float x,
+                                      float y,
+                                      std::size_t count,
+                                      std::vector<RuntimeObject*>& result) {
+  if (count == 0 || entries.empty()) return;
+  queryId++;
+
+  std::vector<std::pair<double, Entry*>> candidates;
+  auto addEntry = [this, x, y, &candidates](Entry* entry) {
+    if (entry->lastQueryId == queryId) return;
+    entry->lastQueryId = queryId;
+
+    double dx = entry->centerX - x;
+    double dy = entry->centerY - y;
+    candidates.push_back(std::make_pair(dx * dx + dy * dy, entry));
+  };
+  auto isNearer = [](const std::pair<double, Entry*>& a,
+                     const std::pair<double, Entry*>& b) {
+    return a.first < b.first;
+  };
+
+  for (Entry* entry : largeEntries) addEntry(entry);
+
+  double pointCellX = std::floor(x / cellSize);
+  double pointCellY = std::floor(y / cellSize);
+  bool searchAllEntries =
+      !(std::abs(pointCellX) <= 1e9 && std::abs(pointCellY) <= 1e9);
+  int centerX = searchAllEntries ? 0 : static_cast<int>(pointCellX);
+  int centerY = searchAllEntries ? 0 : static_cast<int>(pointCellY);
+  std::size_t visitedCellsCount = 0;
+  for (int ring = 0; !searchAllEntries && candidates.size() < entries.size();
+       ++ring) {
+    // Visit the cells at the border of the square of cells around the point.
+    for (int cellX = centerX - ring; cellX <= centerX + ring; ++cellX) {
+      int stepY = (cellX == centerX - ring || cellX == centerX + ring)
+                      ? 1
+                      : std::max(2 * ring, 1);
+      for (int cellY = centerY - ring; cellY <= centerY + ring;
+           cellY += stepY) {
+        visitedCellsCount++;
+        auto cell = cells.find(GetCellKey(cellX, cellY));
+        if (cell == cells.end()) continue;
+
+        for (Entry* entry : cell->second) addEntry(entry);
+      }
+    }
+
+    // The objects not found yet are outside the square, so they can't be
+    // nearer than the distance between the point and the border of the square.
+    if (candidates.size() >= count) {
+      std::nth_element(candidates.begin(),
+                       candidates.begin() + (count - 1),
+                       candidates.end(),
+                       isNearer);
+      double distanceToBorder =
+          std::min(std::min(x - (centerX - ring) * double(cellSize),
+                            (centerX + ring + 1) * double(cellSize) - x),
+                   std::min(y - (centerY - ring) * double(cellSize),
+                            (centerY + ring + 1) * double(cellSize) - y));
+      if (candidates[count - 1].first <= distanceToBorder * distanceToBorder)
+        break;
+    }
+
+    // Iterating on the entries is faster than visiting a lot of empty cells.
+    if (visitedCellsCount > 4 * cells.size() + maxCellsPerObject)
+      searchAllEntries = true;
+  }
+  if (searchAllEntries)
+    for (auto& it : entries) addEntry(&it.second);
+
+  count = std::min(count, candidates.size());
+  std::partial_sort(candidates.begin(),
+                    candidates.begin() + count,
+                    candidates.end(),
+                    isNearer);
+  for (std::size_t i = 0; i < count; ++i)
+    result.push_back(candidates[i].second->object);
+}
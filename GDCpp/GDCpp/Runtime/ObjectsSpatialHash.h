@@ -0,0 +1,317 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSSPATIALHASH_H
+#define OBJECTSSPATIALHASH_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief A spatial hash storing objects according to their axis aligned
+ * bounding box, used as a broadphase by collision related conditions.
+ *
+ * The scene is divided into square cells and each object is registered in
+ * each cell overlapped by its AABB. Updating an object only moves it from
+ * cells to cells when its AABB covers a different range of cells, so that
+ * objects moving a little or not moving at all are cheap to keep in sync.
+ *
+ * The AABB stored for an object is extended to contain its center, so that
+ * queries based on the distance to the centers of the objects (like
+ * QueryRadius or QueryNearest) can use the cells too.
+ *
+ * \note The hash does not own the objects. RuntimeScene is responsible for
+ * removing objects that are deleted.
+ *
+ * \see RuntimeScene::GetObjectsSpatialHash
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsSpatialHash {
+ public:
+  ObjectsSpatialHash(float cellSize = 128.0f);
+  virtual ~ObjectsSpatialHash(){};
+
+  /**
+   * \brief Insert the object or refresh its position in the hash, using its
+   * current AABB and center.
+   * \return The AABB of the object, extended to contain its center, as stored
+   * in the hash.
+   */
+  const sf::FloatRect& Update(RuntimeObject* object);
+
+  /**
+   * \brief Remove the object from the hash. Does nothing if the object was
+   * not in the hash.
+   */
+  void Remove(const RuntimeObject* object);
+
+  /**
+   * \brief Remove all the objects from the hash.
+   */
+  void Clear();
+
+  /**
+   * \brief Return true if the object was inserted in the hash.
+   */
+  bool Has(const RuntimeObject* object) const {
+    return entries.find(object) != entries.end();
+  }
+
+  /**
+   * \brief Return the number of objects stored in the hash.
+   */
+  std::size_t GetObjectsCount() const { return entries.size(); }
+
+  /**
+   * \brief Add to \a result the objects having an AABB (as known during their
+   * last update) overlapping or touching \a area.
+   *
+   * Each object is added only once, even if it is registered in several cells.
+   * \a result is not cleared before adding the objects.
+   */
+  void QueryAABB(const sf::FloatRect& area,
+                 std::vector<RuntimeObject*>& result);
+
+  /**
+   * \brief Call \a callback with each object having an AABB (as known during
+   * its last update) overlapping or touching \a area.
+   *
+   * Same as QueryAABB, without storing the objects in a temporary list.
+   * \warning The callback must not update, remove or query objects of the hash.
+   */
+  template <typename Callback>
+  void ForEachObjectInAABB(const sf::FloatRect& area, Callback callback);
+
+  /**
+   * \brief Add to \a result the objects having an AABB (as known during their
+   * last update) containing the point.
+   */
+  void QueryPoint(float x, float y, std::vector<RuntimeObject*>& result);
+
+  /**
+   * \brief Add to \a result the objects having their center (as known during
+   * their last update) at a distance of \a radius or less from the point.
+   */
+  void QueryRadius(float x,
+                   float y,
+                   float radius,
+                   std::vector<RuntimeObject*>& result);
+
+  /**
+   * \brief Add to \a result the \a count objects having their center (as
+   * known during their last update) the nearest to the point, from the
+   * nearest to the farthest.
+   *
+   * The cells are visited in rings around the point, until no object of the
+   * cells not visited yet can be nearer than the ones already found.
+   */
+  void QueryNearest(float x,
+                    float y,
+                    std::size_t count,
+                    std::vector<RuntimeObject*>& result);
+
+  /**
+   * \brief Call \a callback with each object having an AABB (as known during
+   * its last update) overlapping the AABB of the segment, in the cells crossed
+   * by the segment.
+   *
+   * The cells are visited from the start of the segment to its end. The
+   * callback returns the part of the segment (from 0 to 1) that must still be
+   * searched: returning 1 visits all the cells, returning the position of the
+   * closest intersection found so far stops the traversal after the cells
+   * before it. Useful for raycasts.
+   *
+   * \warning The callback must not update, remove or query objects of the hash.
+   */
+  template <typename Callback>
+  void ForEachObjectAlongSegment(
+      float x1, float y1, float x2, float y2, Callback callback);
+
+  /**
+   * \brief Get the size of the cells, in pixels.
+   */
+  float GetCellSize() const { return cellSize; }
+
+  /**
+   * \brief Return true if the two rectangles are overlapping or touching.
+   * \note Contrary to sf::FloatRect::intersects, touching edges are considered
+   * as overlapping.
+   */
+  static bool AreOverlapping(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+           a.top <= b.top + b.height && b.top <= a.top + a.height;
+  }
+
+ private:
+  /**
+   * \brief The range of cells covered by an object, or
+   * isLarge set to true if the object is covering too many cells.
+   */
+  struct CellsRange {
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+    bool isLarge;
+
+    bool operator==(const CellsRange& other) const {
+      return isLarge == other.isLarge && minX == other.minX &&
+             minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+    }
+  };
+
+  struct Entry {
+    RuntimeObject* object;
+    sf::FloatRect aabb;
+    float centerX;
+    float centerY;
+    CellsRange range;
+    std::size_t lastQueryId;
+  };
+
+  CellsRange GetCellsRange(const sf::FloatRect& aabb) const;
+  void InsertInCells(Entry& entry);
+  void RemoveFromCells(const Entry& entry);
+  static std::int64_t GetCellKey(int x, int y) {
+    return static_cast<std::int64_t>(
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+        static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)));
+  }
+
+  float cellSize;
+  std::size_t queryId;  ///< Incremented at each query to avoid returning an
+                        ///< object more than once.
+  std::unordered_map<const RuntimeObject*, Entry> entries;
+  std::unordered_map<std::int64_t, std::vector<Entry*>> cells;
+  std::vector<Entry*> largeEntries;  ///< Objects covering too many cells are
+                                     ///< stored apart and always tested.
+
+  static const int maxCellsPerObject;
+};
+
+template <typename Callback>
+void ObjectsSpatialHash::ForEachObjectInAABB(const sf::FloatRect& area,
+                                             Callback callback) {
+  queryId++;
+
+  auto testEntry = [this, &area, &callback](Entry* entry) {
+    if (entry->lastQueryId == queryId) return;
+    entry->lastQueryId = queryId;
+
+    if (AreOverlapping(entry->aabb, area)) callback(entry->object);
+  };
+
+  for (Entry* entry : largeEntries) testEntry(entry);
+
+  CellsRange range = GetCellsRange(area);
+  if (range.isLarge) {
+    // Iterating on the entries is faster than visiting a lot of cells.
+    for (auto& it : entries) testEntry(&it.second);
+    return;
+  }
+
+  for (int x = range.minX; x <= range.maxX; ++x) {
+    for (int y = range.minY; y <= range.maxY; ++y) {
+      auto cell = cells.find(GetCellKey(x, y));
+      if (cell == cells.end()) continue;
+
+      for (Entry* entry : cell->second) testEntry(entry);
+    }
+  }
+}
+
+template <typename Callback>
+void ObjectsSpatialHash::ForEachObjectAlongSegment(
+    float x1, float y1, float x2, float y2, Callback callback) {
+  queryId++;
+
+  float searchedPart = 1;
+  sf::FloatRect segmentAABB(std::min(x1, x2),
+                            std::min(y1, y2),
+                            std::abs(x2 - x1),
+                            std::abs(y2 - y1));
+  auto testEntry = [this, &segmentAABB, &searchedPart, &callback](
+                       Entry* entry) {
+    if (entry->lastQueryId == queryId) return;
+    entry->lastQueryId = queryId;
+
+    if (AreOverlapping(entry->aabb, segmentAABB))
+      searchedPart = std::min(searchedPart, callback(entry->object));
+  };
+
+  for (Entry* entry : largeEntries) testEntry(entry);
+
+  double cellX = std::floor(x1 / cellSize);
+  double cellY = std::floor(y1 / cellSize);
+  double endCellX = std::floor(x2 / cellSize);
+  double endCellY = std::floor(y2 / cellSize);
+  double cellsCount =
+      std::abs(endCellX - cellX) + std::abs(endCellY - cellY) + 1;
+  if (!(cellsCount <= entries.size() + maxCellsPerObject) ||
+      std::abs(cellX) > 1e9 || std::abs(cellY) > 1e9) {
+    // Iterating on the entries is faster than visiting a lot of cells.
+    for (auto& it : entries) testEntry(&it.second);
+    return;
+  }
+
+  auto visitCell = [this, &testEntry](int x, int y) {
+    auto cell = cells.find(GetCellKey(x, y));
+    if (cell == cells.end()) return;
+
+    for (Entry* entry : cell->second) testEntry(entry);
+  };
+
+  // Walk through the cells crossed by the segment (DDA), nextX and nextY being
+  // the positions on the segment (from 0 to 1) where the next cells on each
+  // axis are entered.
+  double dx = x2 - x1;
+  double dy = y2 - y1;
+  int x = static_cast<int>(cellX);
+  int y = static_cast<int>(cellY);
+  int endX = static_cast<int>(endCellX);
+  int endY = static_cast<int>(endCellY);
+  int stepX = dx > 0 ? 1 : -1;
+  int stepY = dy > 0 ? 1 : -1;
+  const double infinity = std::numeric_limits<double>::infinity();
+  double nextX =
+      dx != 0 ? ((x + (dx > 0 ? 1 : 0)) * double(cellSize) - x1) / dx
+              : infinity;
+  double nextY =
+      dy != 0 ? ((y + (dy > 0 ? 1 : 0)) * double(cellSize) - y1) / dy
+              : infinity;
+  double deltaX = dx != 0 ? cellSize / std::abs(dx) : infinity;
+  double deltaY = dy != 0 ? cellSize / std::abs(dy) : infinity;
+
+  visitCell(x, y);
+  for (std::size_t i = 1; i < cellsCount && (x != endX || y != endY); ++i) {
+    if (std::min(nextX, nextY) > searchedPart) return;
+
+    bool stepOnX = nextX <= nextY;
+    bool stepOnY = nextY <= nextX;
+    if (stepOnX && stepOnY) {
+      // The segment is going through a corner: the cells sharing the corner
+      // are visited too, so that objects touching it are not missed.
+      visitCell(x + stepX, y);
+      visitCell(x, y + stepY);
+    }
+    if (stepOnX) {
+      x += stepX;
+      nextX += deltaX;
+    }
+    if (stepOnY) {
+      y += stepY;
+      nextY += deltaY;
+    }
+    visitCell(x, y);
+  }
+}
+
+#endif  // OBJECTSSPATIALHASH_H
@@ -0,0 +1,75 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+ObjectsTransforms::~ObjectsTransforms() {
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    objects[i]->X = x[i];
+    objects[i]->Y = y[i];
+    objects[i]->transforms = nullptr;
+  }
+}
+
+void ObjectsTransforms::Add(RuntimeObject& object) {
+  if (object.transforms) return;
+
+  object.transformIndex = objects.size();
+  x.push_back(object.X);
+  y.push_back(object.Y);
+  forceX.push_back(0);
+  forceY.push_back(0);
+  objects.push_back(&object);
+  object.transforms = this;
+}
+
+void ObjectsTransforms::Remove(RuntimeObject& object) {
+  if (object.transforms != this) return;
+
+  std::size_t index = object.transformIndex;
+  object.X = x[index];
+  object.Y = y[index];
+  object.transforms = nullptr;
+
+  // Move the last object in place of the removed one.
+  std::size_t last = objects.size() - 1;
+  if (index != last) {
+    x[index] = x[last];
+    y[index] = y[last];
+    forceX[index] = forceX[last];
+    forceY[index] = forceY[last];
+    objects[index] = objects[last];
+    objects[index]->transformIndex = index;
+  }
+  x.pop_back();
+  y.pop_back();
+  forceX.pop_back();
+  forceY.pop_back();
+  objects.pop_back();
+}
+
+void ObjectsTransforms::ApplyForces(double elapsedTime) {
+  const std::size_t count = objects.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    forceX[i] = objects[i]->TotalForceX();
+    forceY[i] = objects[i]->TotalForceY();
+  }
+
+  // Plain loop on the arrays, so that it is vectorized.
+  const float time = static_cast<float>(elapsedTime);
+  float* __restrict xs = x.data();
+  float* __restrict ys = y.data();
+  const float* __restrict forceXs = forceX.data();
+  const float* __restrict forceYs = forceY.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    xs[i] += forceXs[i] * time;
+    ys[i] += forceYs[i] * time;
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (forceXs[i] != 0 || forceYs[i] != 0) objects[i]->OnPositionChanged();
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_OBJECTSTRANSFORMS_H
+#define GDCPP_OBJECTSTRANSFORMS_H
+#include <cstddef>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief Store the positions of the objects of an ObjInstancesHolder in
+ * contiguous arrays, so that the objects can be moved by their forces in a
+ * single loop that the compiler can vectorize.
+ *
+ * Objects added to the table read and write their position in it (see
+ * RuntimeObject::GetX and RuntimeObject::SetX). A removed object gets back
+ * its position.
+ *
+ * \see ObjInstancesHolder::GetTransforms
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsTransforms {
+ public:
+  ObjectsTransforms(){};
+  ~ObjectsTransforms();
+
+  /**
+   * \brief Add the object to the table. Its position is copied in the table.
+   * \note Nothing is done if the object is already in a table.
+   */
+  void Add(RuntimeObject& object);
+
+  /**
+   * \brief Remove the object from the table. Its position is copied back in
+   * the object.
+   *
+   * Removal is done in constant time, by moving the last object of the table
+   * in place of the removed one.
+   */
+  void Remove(RuntimeObject& object);
+
+  /**
+   * \brief Move all the objects by their forces during \a elapsedTime
+   * seconds.
+   *
+   * RuntimeObject::OnPositionChanged is then only called for the objects that
+   * have a force.
+   */
+  void ApplyForces(double elapsedTime);
+
+  /**
+   * \brief Return the number of objects in the table.
+   */
+  std::size_t GetCount() const { return objects.size(); }
+
+ private:
+  friend class RuntimeObject;
+
+  ObjectsTransforms(const ObjectsTransforms&) = delete;
+  ObjectsTransforms& operator=(const ObjectsTransforms&) = delete;
+
+  std::vector<float> x;  ///< X position of each object.
+  std::vector<float> y;  ///< Y position of each object.
+  std::vector<float> forceX;  ///< Total force of each object on the X axis,
+                              ///< gathered by ApplyForces.
+  std::vector<float> forceY;  ///< Total force of each object on the Y axis,
+                              ///< gathered by ApplyForces.
+  std::vector<RuntimeObject*> objects;  ///< The object of each position.
+};
+
+#endif  // GDCPP_OBJECTSTRANSFORMS_H
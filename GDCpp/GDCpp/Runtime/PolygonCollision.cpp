@@ -59,11 +59,269 @@ float distance(float minA, float maxA, float minB, float maxB) {
     return minA - maxB;
 }
 
+CollisionResult NoCollision() {
+  CollisionResult result;
+  result.collision = false;
+  result.move_axis.x = 0.0f;
+  result.move_axis.y = 0.0f;
+  return result;
+}
+
+/**
+ * \brief A polygon copied in fixed-capacity arrays, with its edges and
+ * normalised axes, so that it can be tested against several polygons or rays
+ * with loops that the compiler can vectorize.
+ */
+struct PreparedPolygon {
+  static const std::size_t maxVerticesCount = 8;
+
+  std::size_t verticesCount;
+  float x[maxVerticesCount];
+  float y[maxVerticesCount];
+  float edgeX[maxVerticesCount];
+  float edgeY[maxVerticesCount];
+  float axisX[maxVerticesCount];  ///< Only computed by PrepareAxes.
+  float axisY[maxVerticesCount];  ///< Only computed by PrepareAxes.
+};
+
+/**
+ * \brief Copy the vertices of the polygon and compute its edges.
+ * \return false if the polygon has too many vertices to be prepared.
+ */
+bool PrepareVertices(const Polygon2d& polygon, PreparedPolygon& prepared) {
+  const std::size_t count = polygon.vertices.size();
+  if (count == 0 || count > PreparedPolygon::maxVerticesCount) return false;
+
+  prepared.verticesCount = count;
+  for (std::size_t i = 0; i < count; ++i) {
+    prepared.x[i] = polygon.vertices[i].x;
+    prepared.y[i] = polygon.vertices[i].y;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    std::size_t next = i + 1 < count ? i + 1 : 0;
+    prepared.edgeX[i] = prepared.x[next] - prepared.x[i];
+    prepared.edgeY[i] = prepared.y[next] - prepared.y[i];
+  }
+
+  return true;
+}
+
+/**
+ * \brief Compute the axes on which the polygon is projected by the
+ * collision tests.
+ */
+void PrepareAxes(PreparedPolygon& prepared) {
+  for (std::size_t i = 0; i < prepared.verticesCount; ++i) {
+    float axisX = -prepared.edgeY[i];
+    float axisY = prepared.edgeX[i];
+    float length = sqrt(axisX * axisX + axisY * axisY);
+    prepared.axisX[i] = length != 0.0f ? axisX / length : axisX;
+    prepared.axisY[i] = length != 0.0f ? axisY / length : axisY;
+  }
+}
+
+/**
+ * \brief Prepare a polygon for the collision tests.
+ * \return false if the polygon can't be prepared, or is not a polygon.
+ */
+bool PrepareForCollisions(const Polygon2d& polygon,
+                          PreparedPolygon& prepared) {
+  if (polygon.vertices.size() < 3 || !PrepareVertices(polygon, prepared))
+    return false;
+
+  PrepareAxes(prepared);
+  return true;
+}
+
+/**
+ * \brief Project the polygon on each axis.
+ */
+void ProjectOnAxes(const float* axisX,
+                   const float* axisY,
+                   std::size_t axesCount,
+                   const PreparedPolygon& p,
+                   float* min,
+                   float* max) {
+  for (std::size_t a = 0; a < axesCount; ++a) {
+    min[a] = axisX[a] * p.x[0] + axisY[a] * p.y[0];
+    max[a] = min[a];
+  }
+
+  // The axes are the inner loop, so that they are projected together.
+  for (std::size_t i = 1; i < p.verticesCount; ++i) {
+    const float x = p.x[i];
+    const float y = p.y[i];
+    for (std::size_t a = 0; a < axesCount; ++a) {
+      float dp = axisX[a] * x + axisY[a] * y;
+      min[a] = std::min(min[a], dp);
+      max[a] = std::max(max[a], dp);
+    }
+  }
+}
+
+sf::Vector2f ComputeCenter(const PreparedPolygon& p) {
+  sf::Vector2f center;
+  for (std::size_t i = 0; i < p.verticesCount; i++) {
+    center.x += p.x[i];
+    center.y += p.y[i];
+  }
+  center.x /= p.verticesCount;
+  center.y /= p.verticesCount;
+
+  return center;
+}
+
+/**
+ * \brief Same as PolygonCollisionTest, for prepared polygons.
+ */
+CollisionResult PreparedPolygonsCollisionTest(const PreparedPolygon& p1,
+                                              const PreparedPolygon& p2,
+                                              bool ignoreTouchingEdges) {
+  const std::size_t maxAxesCount = 2 * PreparedPolygon::maxVerticesCount;
+  const std::size_t axesCount = p1.verticesCount + p2.verticesCount;
+  float axisX[maxAxesCount];
+  float axisY[maxAxesCount];
+  std::copy(p1.axisX, p1.axisX + p1.verticesCount, axisX);
+  std::copy(p1.axisY, p1.axisY + p1.verticesCount, axisY);
+  std::copy(p2.axisX, p2.axisX + p2.verticesCount, axisX + p1.verticesCount);
+  std::copy(p2.axisY, p2.axisY + p2.verticesCount, axisY + p1.verticesCount);
+
+  float minA[maxAxesCount];
+  float maxA[maxAxesCount];
+  float minB[maxAxesCount];
+  float maxB[maxAxesCount];
+  ProjectOnAxes(axisX, axisY, axesCount, p1, minA, maxA);
+  ProjectOnAxes(axisX, axisY, axesCount, p2, minB, maxB);
+
+  // The axes are then checked in the same order as PolygonCollisionTest.
+  float min_dist = FLT_MAX;
+  sf::Vector2f move_axis(0, 0);
+  for (std::size_t a = 0; a < axesCount; ++a) {
+    float dist = distance(minA[a], maxA[a], minB[a], maxB[a]);
+    if (dist > 0.0f || (dist == 0.0 && ignoreTouchingEdges))
+      return NoCollision();
+
+    float absDist = std::abs(dist);
+    if (absDist < min_dist) {
+      min_dist = absDist;
+      move_axis = sf::Vector2f(axisX[a], axisY[a]);
+    }
+  }
+
+  CollisionResult result;
+  result.collision = true;
+
+  sf::Vector2f d = ComputeCenter(p1) - ComputeCenter(p2);
+  if (dotProduct(d, move_axis) < 0.0f) move_axis = -move_axis;
+  result.move_axis = move_axis * min_dist;
+
+  return result;
+}
+
+/**
+ * \brief Same as PolygonRaycastTest, for a prepared polygon.
+ */
+RaycastResult PreparedPolygonRaycastTest(const PreparedPolygon& poly,
+                                         float startX,
+                                         float startY,
+                                         float endX,
+                                         float endY) {
+  RaycastResult result;
+  result.collision = false;
+
+  // Ray segment: p + t*r, with p = start and r = end - start
+  sf::Vector2f p(startX, startY);
+  sf::Vector2f r(endX - startX, endY - startY);
+
+  // Intersections of the ray with the line of every edge (q + u*s), computed
+  // together.
+  const std::size_t count = poly.verticesCount;
+  float crossRS[PreparedPolygon::maxVerticesCount];
+  float crossQPR[PreparedPolygon::maxVerticesCount];
+  float t[PreparedPolygon::maxVerticesCount];
+  float u[PreparedPolygon::maxVerticesCount];
+  for (std::size_t i = 0; i < count; ++i) {
+    float deltaQPX = poly.x[i] - startX;
+    float deltaQPY = poly.y[i] - startY;
+    crossRS[i] = r.x * poly.edgeY[i] - r.y * poly.edgeX[i];
+    crossQPR[i] = deltaQPX * r.y - deltaQPY * r.x;
+    t[i] = (deltaQPX * poly.edgeY[i] - deltaQPY * poly.edgeX[i]) / crossRS[i];
+    u[i] = crossQPR[i] / crossRS[i];
+  }
+
+  float minSqDist = FLT_MAX;
+  for (std::size_t i = 0; i < count; ++i) {
+    // Collinear
+    if (std::abs(crossRS[i]) <= 0.0001 && std::abs(crossQPR[i]) <= 0.0001) {
+      sf::Vector2f deltaQP(poly.x[i] - startX, poly.y[i] - startY);
+      sf::Vector2f s(poly.edgeX[i], poly.edgeY[i]);
+      // Project the ray and the edge to work on floats, keeping linearity
+      // through t
+      sf::Vector2f axis(r.x, r.y);
+      normalise(axis);
+      float rayA = 0.0f;
+      float rayB = dotProduct(axis, r);
+      float edgeA = dotProduct(axis, deltaQP);
+      float edgeB = dotProduct(axis, deltaQP + s);
+      // Get overlapping range
+      float minOverlap = std::max(std::min(rayA, rayB), std::min(edgeA, edgeB));
+      float maxOverlap = std::min(std::max(rayA, rayB), std::max(edgeA, edgeB));
+      if (minOverlap > maxOverlap) {
+        return result;
+      }
+      result.collision = true;
+      // Zero distance ray
+      if (rayB == 0.0f) {
+        result.closePoint = p;
+        result.closeSqDist = 0.0f;
+        result.farPoint = p;
+        result.farSqDist = 0.0f;
+      }
+      float t1 = minOverlap / std::abs(rayB);
+      float t2 = maxOverlap / std::abs(rayB);
+      result.closePoint = p + t1 * r;
+      result.closeSqDist = t1 * t1 * (r.x * r.x + r.y * r.y);
+      result.farPoint = p + t2 * r;
+      result.farSqDist = t2 * t2 * (r.x * r.x + r.y * r.y);
+
+      return result;
+    } else if (crossRS[i] != 0 && 0 <= t[i] && t[i] <= 1 && 0 <= u[i] &&
+               u[i] <= 1) {
+      sf::Vector2f point = p + t[i] * r;
+
+      float sqDist = (point.x - startX) * (point.x - startX) +
+                     (point.y - startY) * (point.y - startY);
+      if (sqDist < minSqDist) {
+        if (!result.collision) {
+          result.farPoint = point;
+          result.farSqDist = sqDist;
+        }
+        minSqDist = sqDist;
+        result.closePoint = point;
+        result.closeSqDist = sqDist;
+        result.collision = true;
+      } else {
+        result.farPoint = point;
+        result.farSqDist = sqDist;
+      }
+    }
+  }
+
+  return result;
+}
+
 }  // namespace
 
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges) {
+  PreparedPolygon preparedP1;
+  PreparedPolygon preparedP2;
+  if (PrepareForCollisions(p1, preparedP1) &&
+      PrepareForCollisions(p2, preparedP2))
+    return PreparedPolygonsCollisionTest(
+        preparedP1, preparedP2, ignoreTouchingEdges);
+
   if (p1.vertices.size() < 3 || p2.vertices.size() < 3) {
     CollisionResult result;
     result.collision = false;
@@ -132,8 +390,50 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
   return result;
 }
 
+bool GD_API PolygonCollisionTestAny(const Polygon2d& polygon,
+                                    const std::vector<Polygon2d>& candidates,
+                                    bool ignoreTouchingEdges) {
+  PreparedPolygon prepared;
+  PreparedPolygon preparedCandidate;
+  bool isPrepared = PrepareForCollisions(polygon, prepared);
+  for (const Polygon2d& candidate : candidates) {
+    CollisionResult result =
+        isPrepared && PrepareForCollisions(candidate, preparedCandidate)
+            ? PreparedPolygonsCollisionTest(
+                  prepared, preparedCandidate, ignoreTouchingEdges)
+            : PolygonCollisionTest(polygon, candidate, ignoreTouchingEdges);
+    if (result.collision) return true;
+  }
+
+  return false;
+}
+
+std::size_t GD_API
+PolygonCollisionTestAll(const Polygon2d& polygon,
+                        const std::vector<Polygon2d>& candidates,
+                        sf::Vector2f& moveAxisSum,
+                        bool ignoreTouchingEdges) {
+  PreparedPolygon prepared;
+  PreparedPolygon preparedCandidate;
+  bool isPrepared = PrepareForCollisions(polygon, prepared);
+  std::size_t collisionsCount = 0;
+  for (const Polygon2d& candidate : candidates) {
+    CollisionResult result =
+        isPrepared && PrepareForCollisions(candidate, preparedCandidate)
+            ? PreparedPolygonsCollisionTest(
+                  prepared, preparedCandidate, ignoreTouchingEdges)
+            : PolygonCollisionTest(polygon, candidate, ignoreTouchingEdges);
+    if (result.collision) {
+      moveAxisSum += result.move_axis;
+      collisionsCount++;
+    }
+  }
+
+  return collisionsCount;
+}
+
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY) {
+    const Polygon2d& poly, float startX, float startY, float endX, float endY) {
   RaycastResult result;
   result.collision = false;
 
@@ -141,6 +441,10 @@ RaycastResult GD_API PolygonRaycastTest(
     return result;
   }
 
+  PreparedPolygon prepared;
+  if (PrepareVertices(poly, prepared))
+    return PreparedPolygonRaycastTest(prepared, startX, startY, endX, endY);
+
   poly.ComputeEdges();
   sf::Vector2f p, q, r, s;
   float minSqDist = FLT_MAX;
@@ -161,7 +465,8 @@ RaycastResult GD_API PolygonRaycastTest(
     float u = crossProduct(deltaQP, r) / crossRS;
 
     // Collinear
-    if (abs(crossRS) <= 0.0001 && abs(crossProduct(deltaQP, r)) <= 0.0001) {
+    if (std::abs(crossRS) <= 0.0001 &&
+        std::abs(crossProduct(deltaQP, r)) <= 0.0001) {
       // Project the ray and the edge to work on floats, keeping linearity
       // through t
       sf::Vector2f axis(r.x, r.y);
@@ -184,8 +489,8 @@ RaycastResult GD_API PolygonRaycastTest(
         result.farPoint = p;
         result.farSqDist = 0.0f;
       }
-      float t1 = minOverlap / abs(rayB);
-      float t2 = maxOverlap / abs(rayB);
+      float t1 = minOverlap / std::abs(rayB);
+      float t2 = maxOverlap / std::abs(rayB);
       result.closePoint = p + t1 * r;
       result.closeSqDist = t1 * t1 * (r.x * r.x + r.y * r.y);
       result.farPoint = p + t2 * r;
@@ -216,7 +521,43 @@ RaycastResult GD_API PolygonRaycastTest(
   return result;
 }
 
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y) {
+RaycastResult GD_API PolygonsRaycastTest(const std::vector<Polygon2d>& polygons,
+                                         float startX,
+                                         float startY,
+                                         float endX,
+                                         float endY,
+                                         bool closest) {
+  float sqDist =
+      (endX - startX) * (endX - startX) + (endY - startY) * (endY - startY);
+  float testSqDist = closest ? sqDist : 0.0f;
+
+  RaycastResult result;
+  result.collision = false;
+
+  PreparedPolygon prepared;
+  for (const Polygon2d& polygon : polygons) {
+    if (polygon.vertices.size() < 2) continue;
+
+    RaycastResult res =
+        PrepareVertices(polygon, prepared)
+            ? PreparedPolygonRaycastTest(prepared, startX, startY, endX, endY)
+            : PolygonRaycastTest(polygon, startX, startY, endX, endY);
+    if (res.collision) {
+      if (closest && (res.closeSqDist < testSqDist)) {
+        testSqDist = res.closeSqDist;
+        result = res;
+      } else if (!closest && (res.farSqDist > testSqDist) &&
+                 (res.farSqDist <= sqDist)) {
+        testSqDist = res.farSqDist;
+        result = res;
+      }
+    }
+  }
+
+  return result;
+}
+
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y) {
   bool inside = false;
   sf::Vector2f vi, vj;
 
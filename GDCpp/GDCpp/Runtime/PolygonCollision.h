@@ -6,6 +6,7 @@
 #ifndef POLYGONCOLLISION_H
 #define POLYGONCOLLISION_H
 #include <SFML/System.hpp>
+#include <vector>
 class Polygon2d;
 
 /**
@@ -44,10 +45,41 @@ struct RaycastResult {
  *
  * \ingroup GameEngine
  */
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges = false);
 
+/**
+ * Do a collision test between \a polygon and each of the \a candidates,
+ * stopping at the first collision.
+ *
+ * Polygons having up to 8 vertices (like rectangular hitboxes) are copied in
+ * fixed-capacity arrays, and the axes of \a polygon are only computed once.
+ *
+ * \return true if \a polygon is overlapping one of the candidates.
+ *
+ * \see PolygonCollisionTest
+ * \ingroup GameEngine
+ */
+bool GD_API PolygonCollisionTestAny(const Polygon2d& polygon,
+                                    const std::vector<Polygon2d>& candidates,
+                                    bool ignoreTouchingEdges = false);
+
+/**
+ * Do a collision test between \a polygon and each of the \a candidates,
+ * adding the move axis of each collision to \a moveAxisSum.
+ *
+ * \return The number of candidates overlapping \a polygon.
+ *
+ * \see PolygonCollisionTest
+ * \ingroup GameEngine
+ */
+std::size_t GD_API
+PolygonCollisionTestAll(const Polygon2d& polygon,
+                        const std::vector<Polygon2d>& candidates,
+                        sf::Vector2f& moveAxisSum,
+                        bool ignoreTouchingEdges = false);
+
 /**
  * Do a raycast test.
  * \warning Polygon must be convex.
@@ -59,7 +91,22 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
  * \ingroup GameEngine
  */
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY);
+    const Polygon2d& poly, float startX, float startY, float endX, float endY);
+
+/**
+ * Do a raycast test against each polygon, keeping the closest contact point
+ * (or the farthest one, if \a closest is false) that is not farther than the
+ * end of the ray.
+ *
+ * \see PolygonRaycastTest
+ * \ingroup GameEngine
+ */
+RaycastResult GD_API PolygonsRaycastTest(const std::vector<Polygon2d>& polygons,
+                                         float startX,
+                                         float startY,
+                                         float endX,
+                                         float endY,
+                                         bool closest);
 
 /**
  * Check if a point is inside a polygon.
@@ -71,6 +118,6 @@ RaycastResult GD_API PolygonRaycastTest(
  *
  * \ingroup GameEngine
  */
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y);
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y);
 
 #endif  // POLYGONCOLLISION_H
@@ -0,0 +1,49 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/PreparedInstances.h"
+#include <functional>
+#include "GDCpp/Runtime/Project/InitialInstance.h"
+#include "GDCpp/Runtime/Project/InitialInstancesContainer.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+
+namespace {
+class InstancesPreparer : public gd::InitialInstanceFunctor {
+ public:
+  InstancesPreparer(std::function<void(const gd::InitialInstance&)> prepare_)
+      : prepare(prepare_){};
+  virtual ~InstancesPreparer(){};
+
+  virtual void operator()(gd::InitialInstance& instance) { prepare(instance); }
+
+ private:
+  std::function<void(const gd::InitialInstance&)> prepare;
+};
+}  // namespace
+
+PreparedInstances::PreparedInstances(
+    RuntimeScene& scene, const gd::InitialInstancesContainer& instances) {
+  prototypes.reserve(instances.GetInstancesCount());
+  InstancesPreparer preparer(
+      [this, &scene](const gd::InitialInstance& instance) {
+        std::unique_ptr<RuntimeObject> prototype =
+            scene.PrepareObjectFromInitialInstance(instance);
+        if (prototype) prototypes.push_back(std::move(prototype));
+      });
+  const_cast<gd::InitialInstancesContainer&>(instances).IterateOverInstances(
+      preparer);
+}
+
+void PreparedInstances::CreateObjects(RuntimeScene& scene,
+                                      float xOffset,
+                                      float yOffset) const {
+  for (const std::unique_ptr<RuntimeObject>& prototype : prototypes) {
+    std::unique_ptr<RuntimeObject> object = prototype->Clone();
+    object->SetX(prototype->GetX() + xOffset);
+    object->SetY(prototype->GetY() + yOffset);
+    scene.objectsInstances.AddObject(std::move(object));
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef PREPAREDINSTANCES_H
+#define PREPAREDINSTANCES_H
+
+#include <memory>
+#include <vector>
+class RuntimeScene;
+class RuntimeObject;
+namespace gd {
+class InitialInstancesContainer;
+}
+
+/**
+ * \brief The objects of initial instances created many times in a scene
+ * (usually the instances of an external layout), prepared once.
+ *
+ * The object of each instance is found and initialized from the instance
+ * (position, layer, angle, size, variables...) only once, as a prototype.
+ * The objects are then created by cloning the prototypes, which avoids the
+ * searches by name and the creation of the variables and behaviors from
+ * their initial content.
+ *
+ * \see RuntimeScene::CreateObjectsFromPreparedInstances
+ * \ingroup GameEngine
+ */
+class GD_API PreparedInstances {
+ public:
+  /**
+   * \brief Prepare the objects of the instances of the container. The
+   * instances of objects not existing in the scene are skipped.
+   */
+  PreparedInstances(RuntimeScene& scene,
+                    const gd::InitialInstancesContainer& instances);
+
+  /**
+   * \brief Create the objects of the instances and add them to the scene.
+   */
+  void CreateObjects(RuntimeScene& scene, float xOffset, float yOffset) const;
+
+  /**
+   * \brief Return the number of objects created by CreateObjects.
+   */
+  std::size_t GetPrototypesCount() const { return prototypes.size(); }
+
+ private:
+  std::vector<std::unique_ptr<RuntimeObject>>
+      prototypes;  ///< The objects, not added to the scene, positioned at
+                   ///< the position of their instance.
+};
+
+#endif  // PREPAREDINSTANCES_H
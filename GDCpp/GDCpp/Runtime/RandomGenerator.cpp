@@ -0,0 +1,65 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RandomGenerator.h"
+#include <chrono>
+#include <random>
+
+RandomGenerator::RandomGenerator() {
+  std::random_device randomDevice;
+  Seed(randomDevice.entropy() > 0
+           ? (std::uint64_t(randomDevice()) << 32) | randomDevice()
+           : std::chrono::high_resolution_clock::now()
+                 .time_since_epoch()
+                 .count());
+}
+
+void RandomGenerator::Seed(std::uint64_t seed) {
+  // Expand the seed with splitmix64, as the state must not be all zeros.
+  for (std::uint64_t& s : state.s) {
+    seed += 0x9E3779B97F4A7C15ULL;
+    std::uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    s = z ^ (z >> 31);
+  }
+}
+
+std::uint64_t RandomGenerator::NextInteger(std::uint64_t max) {
+  if (max == UINT64_MAX) return Next();
+
+  const std::uint64_t range = max + 1;
+  if (range <= UINT32_MAX) {
+    // Lemire's method: the high bits of the product of a random 32 bits
+    // integer by the range are uniform, once the few products which would
+    // be biased are rejected.
+    std::uint64_t product = (Next() >> 32) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < range) {
+      const std::uint32_t threshold =
+          static_cast<std::uint32_t>((0x100000000ULL - range) % range);
+      while (low < threshold) {
+        product = (Next() >> 32) * range;
+        low = static_cast<std::uint32_t>(product);
+      }
+    }
+    return product >> 32;
+  }
+
+  // Larger ranges are rare: reject the integers above max, masked to the
+  // bits of max.
+  std::uint64_t mask = max;
+  mask |= mask >> 1;
+  mask |= mask >> 2;
+  mask |= mask >> 4;
+  mask |= mask >> 8;
+  mask |= mask >> 16;
+  mask |= mask >> 32;
+  std::uint64_t result;
+  do {
+    result = Next() & mask;
+  } while (result > max);
+  return result;
+}
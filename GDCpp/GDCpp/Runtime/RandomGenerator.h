@@ -0,0 +1,97 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_RANDOMGENERATOR_H
+#define GDCPP_RANDOMGENERATOR_H
+#include <cstdint>
+
+/**
+ * \brief Generate the pseudo-random numbers of a RuntimeScene.
+ *
+ * The numbers are generated with xoshiro256**, which is much faster than
+ * std::mt19937 and has a state small enough to be saved and restored (see
+ * GetState and SetState), so that the same numbers can be generated again
+ * when replaying a recording or restoring a snapshot of the scene.
+ *
+ * \see RuntimeScene::GetRandomGenerator
+ * \ingroup GameEngine
+ */
+class GD_API RandomGenerator {
+ public:
+  /**
+   * \brief The state of the generator, to generate the same numbers again.
+   */
+  struct State {
+    std::uint64_t s[4];
+  };
+
+  /**
+   * \brief Create a generator seeded with a random seed (from the
+   * random_device of the system if any, or the time otherwise).
+   */
+  RandomGenerator();
+
+  /**
+   * \brief Create a generator seeded with the specified seed.
+   */
+  explicit RandomGenerator(std::uint64_t seed) { Seed(seed); }
+
+  /**
+   * \brief Reset the generator so that it generates the numbers associated
+   * to the seed.
+   */
+  void Seed(std::uint64_t seed);
+
+  /**
+   * \brief Generate a random integer, uniformly distributed over all the
+   * 64 bits integers.
+   */
+  std::uint64_t Next() {
+    const std::uint64_t result = RotateLeft(state.s[1] * 5, 7) * 9;
+    const std::uint64_t t = state.s[1] << 17;
+
+    state.s[2] ^= state.s[0];
+    state.s[3] ^= state.s[1];
+    state.s[1] ^= state.s[2];
+    state.s[0] ^= state.s[3];
+    state.s[2] ^= t;
+    state.s[3] = RotateLeft(state.s[3], 45);
+
+    return result;
+  }
+
+  /**
+   * \brief Generate a random integer between 0 and max (included), without
+   * the bias of a modulo.
+   */
+  std::uint64_t NextInteger(std::uint64_t max);
+
+  /**
+   * \brief Generate a random number between 0 (included) and 1 (excluded).
+   */
+  double NextDouble() {
+    // The 53 high bits fill the mantissa of the double.
+    return (Next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * \brief Return the state of the generator.
+   */
+  const State& GetState() const { return state; }
+
+  /**
+   * \brief Replace the state of the generator by one returned by GetState.
+   */
+  void SetState(const State& state_) { state = state_; }
+
+ private:
+  static std::uint64_t RotateLeft(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  State state;
+};
+
+#endif  // GDCPP_RANDOMGENERATOR_H
@@ -12,6 +12,8 @@
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
+#include "GDCore/Tools/KtxImage.h"
 #include "GDCpp/Runtime/Music.h"
 #undef LoadImage  // Undef a macro from windows.h
 #if defined(ANDROID)
@@ -35,12 +37,7 @@ bool ResourcesLoader::SetResourceFile(const gd::String& filename) {
 
 void ResourcesLoader::LoadSFMLImage(const gd::String& filename,
                                     sf::Image& image) {
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
-      cout << "Failed to get the file of a SFML image from resource file: "
-           << filename << endl;
-
+  if (const char* buffer = resFile.GetFile(filename)) {
     if (!image.loadFromMemory(buffer, resFile.GetFileSize(filename)))
       cout << "Failed to load a SFML image from resource file: " << filename
            << endl;
@@ -61,12 +58,7 @@ sf::Texture ResourcesLoader::LoadSFMLTexture(const gd::String& filename) {
 
 void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
                                       sf::Texture& texture) {
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
-      cout << "Failed to get the file of a SFML texture from resource file: "
-           << filename << endl;
-
+  if (const char* buffer = resFile.GetFile(filename)) {
     if (!texture.loadFromMemory(buffer, resFile.GetFileSize(filename)))
       cout << "Failed to load a SFML texture from resource file: " << filename
            << endl;
@@ -77,31 +69,33 @@ void ResourcesLoader::LoadSFMLTexture(const gd::String& filename,
   }
 }
 
+bool ResourcesLoader::LoadKtxImage(const gd::String& filename,
+                                   gd::KtxImage& image) {
+  bool loaded = false;
+  if (const char* buffer = resFile.GetFile(filename)) {
+    loaded = image.LoadFromMemory(buffer, resFile.GetFileSize(filename));
+  } else if (char* fileBuffer = LoadBinaryFile(filename)) {
+    loaded = image.LoadFromMemory(fileBuffer, GetBinaryFileSize(filename));
+    delete[] fileBuffer;
+  }
+
+  if (!loaded) cout << "Failed to load a KTX image: " << filename << endl;
+  return loaded;
+}
+
 std::pair<sf::Font*, StreamHolder*> ResourcesLoader::LoadFont(
     const gd::String& filename) {
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    size_t bufferSize = resFile.GetFileSize(filename);
-    if (buffer == nullptr) {
-      cout << "Failed to get the file of a font from resource file:" << filename
-           << endl;
-      return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
-    }
-
+  if (const char* buffer = resFile.GetFile(filename)) {
+    // The font is read from the mapping of the resource file, which stays
+    // valid as long as the resource file is open.
     sf::Font* font = new sf::Font();
-    char* fontBuffer = new char[bufferSize];
-    memcpy(fontBuffer, buffer, bufferSize);
-
-    if (!font->loadFromMemory(fontBuffer, bufferSize)) {
+    if (!font->loadFromMemory(buffer, resFile.GetFileSize(filename))) {
       cout << "Failed to load a font from resource file: " << filename << endl;
       delete font;
-      delete fontBuffer;
       return std::make_pair((sf::Font*)nullptr, (StreamHolder*)nullptr);
     }
 
-    StreamHolder* streamHolder = new StreamHolder();
-    streamHolder->buffer = fontBuffer;
-    return std::make_pair(font, streamHolder);
+    return std::make_pair(font, (StreamHolder*)nullptr);
   } else {
     sf::Font* font = new sf::Font();
     StreamHolder* streamHolder = new StreamHolder();
@@ -121,12 +115,7 @@ std::pair<sf::Font*, StreamHolder*> ResourcesLoader::LoadFont(
 sf::SoundBuffer ResourcesLoader::LoadSoundBuffer(const gd::String& filename) {
   sf::SoundBuffer sbuffer;
 
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
-      cout << "Failed to get the file of a sound buffer from resource file: "
-           << filename << endl;
-
+  if (const char* buffer = resFile.GetFile(filename)) {
     if (!sbuffer.loadFromMemory(buffer, resFile.GetFileSize(filename)))
       cout << "Failed to load a sound buffer from resource file: " << filename
            << endl;
@@ -142,20 +131,16 @@ sf::SoundBuffer ResourcesLoader::LoadSoundBuffer(const gd::String& filename) {
 gd::String ResourcesLoader::LoadPlainText(const gd::String& filename) {
   gd::String text;
 
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (!buffer) {
-      cout << "Failed to read a file from resource file: " << filename << endl;
-    } else {
-      text = gd::String::FromUTF8(std::string(buffer));
-    }
+  if (const char* buffer = resFile.GetFile(filename)) {
+    text = gd::String::FromUTF8(
+        std::string(buffer, resFile.GetFileSize(filename)));
   } else {
-    char* buffer = LoadBinaryFile(filename);
-    if (!buffer)
+    char* fileBuffer = LoadBinaryFile(filename);
+    if (!fileBuffer)
       cout << "Failed to read plain text from a file: " << filename << endl;
     else {
-      text = gd::String::FromUTF8(std::string(buffer));
-      delete[] buffer;
+      text = gd::String::FromUTF8(std::string(fileBuffer));
+      delete[] fileBuffer;
     }
   }
 
@@ -165,14 +150,21 @@ gd::String ResourcesLoader::LoadPlainText(const gd::String& filename) {
 /**
  * Load a binary text file
  */
-char* ResourcesLoader::LoadBinaryFile(const gd::String& filename) {
-  if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
-      cout << "Failed to read a binary file from resource file: " << filename
-           << endl;
+const char* ResourcesLoader::GetMappedFile(const gd::String& filename,
+                                           std::size_t& size) {
+  const char* buffer = resFile.GetFile(filename);
+  size = buffer ? resFile.GetFileSize(filename) : 0;
+  return buffer;
+}
 
-    return buffer;
+char* ResourcesLoader::LoadBinaryFile(const gd::String& filename) {
+  if (const char* buffer = resFile.GetFile(filename)) {
+    // The resource file is read-only: return a copy, to be deleted by the
+    // caller like when the file is not in the resource file.
+    long int size = resFile.GetFileSize(filename);
+    char* memblock = new char[size];
+    memcpy(memblock, buffer, size);
+    return memblock;
   } else {
 #if defined(ANDROID)
     sf::FileInputStream file;
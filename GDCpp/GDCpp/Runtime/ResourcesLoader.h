@@ -20,6 +20,9 @@ class Music;
 #include "GDCpp/Runtime/String.h"
 #include "GDCpp/Runtime/Tools/FileStream.h"
 #undef LoadImage  // Undef macro from windows.h
+namespace gd {
+class KtxImage;
+}
 
 namespace gd {
 
@@ -51,21 +54,40 @@ class GD_API ResourcesLoader {
    */
   bool SetResourceFile(const gd::String &filename);
 
+  /**
+   * \brief Load an image from a file or from the resource file.
+   * \note Can be called by several threads at the same time (see
+   * gd::ImageManager::PreloadImages).
+   */
   void LoadSFMLImage(const gd::String &filename, sf::Image &image);
 
   sf::Texture LoadSFMLTexture(const gd::String &filename);
   void LoadSFMLTexture(const gd::String &filename, sf::Texture &texture);
 
+  bool LoadKtxImage(const gd::String &filename, gd::KtxImage &image);
+
   std::pair<sf::Font *, StreamHolder *> LoadFont(const gd::String &filename);
 
   sf::SoundBuffer LoadSoundBuffer(const gd::String &filename);
 
   gd::String LoadPlainText(const gd::String &filename);
 
+  /**
+   * \brief Load a file in a new buffer, which must be deleted by the caller.
+   */
   char *LoadBinaryFile(const gd::String &filename);
 
   long int GetBinaryFileSize(const gd::String &filename);
 
+  /**
+   * \brief Return the content of a file of the resource file, without copying
+   * it, or NULL if the file is not in the resource file.
+   *
+   * The content stays valid until another resource file is set, so that it
+   * can be streamed (see SoundManager::PlayMusic).
+   */
+  const char *GetMappedFile(const gd::String &filename, std::size_t &size);
+
   bool HasFile(const gd::String &filename);
 
   static ResourcesLoader *Get() {
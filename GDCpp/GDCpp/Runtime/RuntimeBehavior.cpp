@@ -4,5 +4,33 @@
  * reserved. This project is released under the MIT License.
  */
 #include "RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
 
-RuntimeBehavior::~RuntimeBehavior(){};
\ No newline at end of file
+RuntimeBehavior::~RuntimeBehavior() {
+  if (registry) registry->RemoveBehavior(this);
+};
+
+void RuntimeBehavior::Activate(bool enable) {
+  if (!activated && enable) {
+    activated = true;
+    OnActivate();
+  } else if (activated && !enable) {
+    activated = false;
+    if (registry) registry->RemoveBehavior(this);
+    OnDeActivate();
+  } else
+    return;
+
+  // The owner only steps the behaviors that are activated.
+  if (object) object->activatedBehaviorsChanged = true;
+}
+
+void RuntimeBehavior::SetRegistry(RuntimeBehaviorsRegistryBase* registry_,
+                                  std::size_t index) {
+  registry = registry_;
+  registryIndex = index;
+
+  // The owner doesn't step the behaviors stepped in batch.
+  if (object) object->activatedBehaviorsChanged = true;
+}
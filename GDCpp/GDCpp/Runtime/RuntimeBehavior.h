@@ -5,13 +5,18 @@
  */
 #ifndef RUNTIMEBEHAVIOR_H
 #define RUNTIMEBEHAVIOR_H
+#include <cstddef>
 #include <map>
+#include <vector>
 #include "GDCore/String.h"
 namespace gd {
 class SerializerElement;
 }  // namespace gd
 class RuntimeObject;
 class RuntimeScene;
+class RuntimeBehaviorsRegistryBase;
+class SceneSnapshotReader;
+class SceneSnapshotWriter;
 
 /**
  * \brief Base class used to represents a behavior that can be applied to an
@@ -22,11 +27,40 @@ class RuntimeScene;
 class GD_CORE_API RuntimeBehavior {
  public:
   RuntimeBehavior(const gd::SerializerElement& behaviorContent)
-      : activated(true){
-        };
+      : object(nullptr), activated(true), registry(nullptr), registryIndex(0){};
+  /**
+   * \brief Copies are not registered in the registry of the behavior.
+   */
+  RuntimeBehavior(const RuntimeBehavior& other)
+      : name(other.name),
+        object(other.object),
+        activated(other.activated),
+        registry(nullptr),
+        registryIndex(0){};
+  RuntimeBehavior& operator=(const RuntimeBehavior& other) {
+    name = other.name;
+    object = other.object;
+    activated = other.activated;
+    return *this;
+  };
   virtual ~RuntimeBehavior();
   virtual RuntimeBehavior* Clone() const { return new RuntimeBehavior(*this); }
 
+  /**
+   * \brief Reset the behavior so that it is in the same state as a behavior
+   * newly created from \a behaviorContent.
+   *
+   * Called when the object owning the behavior is recycled (see
+   * RuntimeObject::Reset). The behavior was deactivated when the object was
+   * deleted, and is activated again after being reset.
+   *
+   * \return true if the behavior was reset. The default implementation returns
+   * false, so that the behavior is destroyed and created again.
+   */
+  virtual bool Reset(const gd::SerializerElement& behaviorContent) {
+    return false;
+  }
+
   /**
    * \brief Change the name identifying the behavior.
    */
@@ -59,18 +93,52 @@ class GD_CORE_API RuntimeBehavior {
     if (activated) DoStepPostEvents(scene);
   };
 
+  /**
+   * \brief Return true if the work done by the behavior before events can be
+   * done at the same time as the work of the behaviors of other objects.
+   *
+   * Redefine this method to return true only if DoStepPreEvents modifies
+   * nothing but the behavior and its object (no objects created or deleted,
+   * no scene, extension or shared data modified) and only reads other objects.
+   * The objects having only such behaviors are stepped in parallel, after the
+   * other objects.
+   *
+   * \see RuntimeScene::ManageObjectsBeforeEvents
+   */
+  virtual bool IsPreEventsStepParallelSafe() const { return false; }
+
+  /**
+   * \brief Return true if the behavior is stepped by a
+   * RuntimeBehaviorsRegistry, with the other behaviors of its type, instead of
+   * by its object.
+   */
+  bool IsSteppedInBatch() const { return registry != nullptr; }
+
+  /**
+   * \brief Step all the behaviors of type T registered in a
+   * RuntimeBehaviorsRegistry, before events.
+   *
+   * Declare a static method with the same name, taking the behaviors of the
+   * derived class, to step them. The default does nothing.
+   */
+  template <class T>
+  static void StepAllPreEvents(RuntimeScene& scene,
+                               const std::vector<T*>& behaviors){};
+
+  /**
+   * \brief Step all the behaviors of type T registered in a
+   * RuntimeBehaviorsRegistry, after events.
+   *
+   * \see RuntimeBehavior::StepAllPreEvents
+   */
+  template <class T>
+  static void StepAllPostEvents(RuntimeScene& scene,
+                                const std::vector<T*>& behaviors){};
+
   /**
    * De/Activate the behavior
    */
-  inline void Activate(bool enable = true) {
-    if (!activated && enable) {
-      activated = true;
-      OnActivate();
-    } else if (activated && !enable) {
-      activated = false;
-      OnDeActivate();
-    }
-  };
+  void Activate(bool enable = true);
 
   /**
    * Return true if the behavior is activated
@@ -86,7 +154,25 @@ class GD_CORE_API RuntimeBehavior {
    */
   virtual void OnDeActivate(){};
 
+  /**
+   * \brief Write the state of the behavior changing during the game (speed,
+   * elapsed time...) in a snapshot of the scene (see
+   * RuntimeScene::TakeSnapshot).
+   *
+   * The default implementation writes nothing: behaviors having such a state
+   * should redefine it, as well as RestoreState.
+   */
+  virtual void SaveState(SceneSnapshotWriter& writer) const {};
+
+  /**
+   * \brief Restore the state written by SaveState.
+   */
+  virtual void RestoreState(SceneSnapshotReader& reader){};
+
  protected:
+  friend class RuntimeObject;  // Steps the activated behaviors directly.
+  friend class RuntimeBehaviorsRegistryBase;
+
   /**
    * Called at each frame before events
    */
@@ -105,6 +191,17 @@ class GD_CORE_API RuntimeBehavior {
   gd::String name;        ///< Name of the behavior
   RuntimeObject* object;  ///< Object owning the behavior
   bool activated;         ///< True if behavior is running
+
+ private:
+  /**
+   * \brief Set the registry stepping the behavior (nullptr if stepped by its
+   * object).
+   */
+  void SetRegistry(RuntimeBehaviorsRegistryBase* registry_, std::size_t index);
+
+  RuntimeBehaviorsRegistryBase* registry;  ///< The registry stepping the
+                                           ///< behavior, if any.
+  std::size_t registryIndex;  ///< The index of the behavior in the registry.
 };
 
 #endif  // RUNTIMEBEHAVIOR_H
@@ -0,0 +1,32 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
+
+RuntimeBehaviorsRegistryBase::~RuntimeBehaviorsRegistryBase() {
+  // The behaviors can outlive the registry: they are stepped by their objects
+  // again.
+  for (RuntimeBehavior* behavior : behaviors) behavior->SetRegistry(nullptr, 0);
+}
+
+void RuntimeBehaviorsRegistryBase::AddBehavior(RuntimeBehavior* behavior) {
+  if (behavior->registry == this || !behavior->Activated()) return;
+  if (behavior->registry) behavior->registry->RemoveBehavior(behavior);
+
+  behavior->SetRegistry(this, behaviors.size());
+  behaviors.push_back(behavior);
+}
+
+void RuntimeBehaviorsRegistryBase::RemoveBehavior(RuntimeBehavior* behavior) {
+  if (behavior->registry != this) return;
+
+  // Move the last behavior in the hole.
+  std::size_t index = behavior->registryIndex;
+  behaviors[index] = behaviors.back();
+  behaviors[index]->registryIndex = index;
+  behaviors.pop_back();
+
+  behavior->SetRegistry(nullptr, 0);
+}
@@ -0,0 +1,139 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef RUNTIMEBEHAVIORSREGISTRY_H
+#define RUNTIMEBEHAVIORSREGISTRY_H
+#include <cstddef>
+#include <vector>
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+
+/**
+ * \brief Contains the behaviors of a scene that are stepped all at once by
+ * their type, instead of one by one by their objects.
+ *
+ * \see RuntimeBehaviorsRegistry
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeBehaviorsRegistryBase : public RuntimeSceneExtensionData {
+ public:
+  RuntimeBehaviorsRegistryBase(){};
+  virtual ~RuntimeBehaviorsRegistryBase();
+
+  /**
+   * \brief Register the behavior, so that it is stepped by the registry
+   * (from the next step) and not by its object anymore.
+   *
+   * The behavior is unregistered when it is deactivated or destroyed.
+   * \note Deactivated behaviors are not registered.
+   */
+  void AddBehavior(RuntimeBehavior* behavior);
+
+  /**
+   * \brief Unregister the behavior, in constant time, so that it is stepped
+   * again by its object.
+   */
+  void RemoveBehavior(RuntimeBehavior* behavior);
+
+  /**
+   * \brief Return the number of registered behaviors.
+   */
+  std::size_t GetBehaviorsCount() const { return behaviors.size(); }
+
+ protected:
+  std::vector<RuntimeBehavior*>
+      behaviors;  ///< The registered behaviors, each one knowing its index.
+};
+
+/**
+ * \brief A registry of all the activated behaviors of type T of a scene,
+ * stepping them in batches.
+ *
+ * Before events, the registry calls:
+ * \code
+ * static void T::StepAllPreEvents(RuntimeScene& scene,
+ *                                 const std::vector<T*>& behaviors);
+ * \endcode
+ * once the objects stepped their other behaviors, and after events:
+ * \code
+ * static void T::StepAllPostEvents(RuntimeScene& scene,
+ *                                  const std::vector<T*>& behaviors);
+ * \endcode
+ * once the objects were updated. T only needs to declare the ones it uses
+ * (see RuntimeBehavior::StepAllPreEvents). Stepping all the behaviors of a
+ * type in a single loop avoids a virtual call per behavior, and lets the
+ * behaviors share the work that does not depend on their objects.
+ *
+ * A behavior registers itself during its first step:
+ * \code
+ * void MyRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
+ *   scene.GetExtensionData<RuntimeBehaviorsRegistry<MyRuntimeBehavior>>()
+ *       .AddBehavior(this);
+ * }
+ * \endcode
+ * The batch step of the same phase runs after the steps of the objects, so
+ * this first step must not do the work of the behavior. Registering a
+ * behavior is not parallel-safe (see
+ * RuntimeBehavior::IsPreEventsStepParallelSafe).
+ *
+ * \ingroup GameEngine
+ */
+template <class T>
+class RuntimeBehaviorsRegistry : public RuntimeBehaviorsRegistryBase {
+ public:
+  static const std::size_t sceneDataIndex;  ///< The slot of the registries
+                                            ///< of T in the scenes.
+
+  RuntimeBehaviorsRegistry(){};
+  virtual ~RuntimeBehaviorsRegistry(){};
+
+  virtual void PreEvents(RuntimeScene& scene) override {
+    if (!PrepareStep()) return;
+
+    FrameProfiler* profiler = scene.GetFrameProfiler();
+    signed long long startTime = profiler ? profiler->GetTime() : 0;
+    T::StepAllPreEvents(scene, steppedBehaviors);
+    if (profiler)
+      profiler->AddBehaviorTime(steppedBehaviors.front()->GetName(),
+                                false,
+                                profiler->GetTime() - startTime);
+  }
+
+  virtual void PostEvents(RuntimeScene& scene) override {
+    if (!PrepareStep()) return;
+
+    FrameProfiler* profiler = scene.GetFrameProfiler();
+    signed long long startTime = profiler ? profiler->GetTime() : 0;
+    T::StepAllPostEvents(scene, steppedBehaviors);
+    if (profiler)
+      profiler->AddBehaviorTime(steppedBehaviors.front()->GetName(),
+                                true,
+                                profiler->GetTime() - startTime);
+  }
+
+ private:
+  /**
+   * \brief Copy the registered behaviors, so that behaviors can be
+   * registered or unregistered during the step.
+   * \return false if there is nothing to step.
+   */
+  bool PrepareStep() {
+    steppedBehaviors.clear();
+    for (RuntimeBehavior* behavior : behaviors)
+      steppedBehaviors.push_back(static_cast<T*>(behavior));
+
+    return !steppedBehaviors.empty();
+  }
+
+  std::vector<T*> steppedBehaviors;  ///< Only valid during a step.
+};
+
+template <class T>
+const std::size_t RuntimeBehaviorsRegistry<T>::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+
+#endif  // RUNTIMEBEHAVIORSREGISTRY_H
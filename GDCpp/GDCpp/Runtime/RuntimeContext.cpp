@@ -1,6 +1,7 @@
 #include "RuntimeContext.h"
 #include <vector>
 #include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/profile.h"
 
@@ -25,6 +26,34 @@ std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
   return scene->objectsInstances.GetObjectsRawPointers(name);
 }
 
+std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
+    std::size_t typeId) {
+  return scene->objectsInstances.GetObjectsRawPointers(typeId);
+}
+
+void RuntimeContext::GetObjectsRawPointers(
+    std::size_t typeId, std::vector<RuntimeObject *> &list) {
+  scene->objectsInstances.GetObjectsRawPointers(typeId, list);
+}
+
+std::vector<RuntimeObject *> &RuntimeContext::AcquireFrameObjectsList() {
+  if (usedFrameObjectsListsCount >= frameObjectsLists.size())
+    frameObjectsLists.emplace_back();
+
+  std::vector<RuntimeObject *> &list =
+      frameObjectsLists[usedFrameObjectsListsCount++];
+  list.clear();  // Keep the capacity of the list to avoid allocations.
+  return list;
+}
+
+std::size_t RuntimeContext::GetObjectTypeId(const gd::String &name) {
+  return ObjInstancesHolder::GetObjectTypeId(name);
+}
+
+std::size_t RuntimeContext::GetBehaviorId(const gd::String &name) {
+  return RuntimeObject::GetBehaviorId(name);
+}
+
 RuntimeVariablesContainer &RuntimeContext::GetSceneVariables() {
   return scene->GetVariables();
 }
@@ -48,5 +77,7 @@ RuntimeContext &RuntimeContext::AddObjectListToMap(
 
 std::map<gd::String, std::vector<RuntimeObject *> *>
 RuntimeContext::ReturnObjectListsMap() {
-  return temporaryMap;
+  // The map is cleared before being filled again, so its nodes can be moved
+  // instead of copied.
+  return std::move(temporaryMap);
 }
@@ -1,6 +1,7 @@
 #ifndef RUNTIMECONTEXT_H
 #define RUNTIMECONTEXT_H
 
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -15,11 +16,66 @@ class RuntimeVariablesContainer;
  */
 class GD_API RuntimeContext {
  public:
+  /**
+   * \brief A list of objects taken from the lists kept by the context for
+   * the frame, and given back to the context when destroyed.
+   *
+   * Used by events generated code to declare the lists of picked objects:
+   * as the lists are reused from one frame to another, their memory is
+   * only allocated during the first frames.
+   *
+   * \note Lists must be destroyed in the reverse order of their construction,
+   * which is the case for local variables.
+   */
+  class FrameObjectsList {
+   public:
+    /**
+     * \brief Take an empty list from the context.
+     */
+    FrameObjectsList(RuntimeContext &context_)
+        : context(context_), list(context_.AcquireFrameObjectsList()){};
+
+    /**
+     * \brief Take a list from the context, filled with the objects having the
+     * specified identifier.
+     * \see RuntimeContext::GetObjectTypeId
+     */
+    FrameObjectsList(RuntimeContext &context_, std::size_t typeId)
+        : context(context_), list(context_.AcquireFrameObjectsList()) {
+      context.GetObjectsRawPointers(typeId, list);
+    };
+
+    /**
+     * \brief Take a list from the context, filled with the objects of \a
+     * objects.
+     */
+    FrameObjectsList(RuntimeContext &context_,
+                     const std::vector<RuntimeObject *> &objects)
+        : context(context_), list(context_.AcquireFrameObjectsList()) {
+      list.assign(objects.begin(), objects.end());
+    };
+
+    ~FrameObjectsList() { context.ReleaseFrameObjectsList(); };
+
+    /**
+     * \brief Get the list of objects.
+     */
+    std::vector<RuntimeObject *> &Get() { return list; };
+
+   private:
+    FrameObjectsList(const FrameObjectsList &) = delete;
+    FrameObjectsList &operator=(const FrameObjectsList &) = delete;
+
+    RuntimeContext &context;
+    std::vector<RuntimeObject *> &list;
+  };
+
   /**
    * \brief Construct the context for a scene.
    * \param scene The scene associated to the context.
    */
-  RuntimeContext(RuntimeScene *scene_) : scene(scene_){};
+  RuntimeContext(RuntimeScene *scene_)
+      : scene(scene_), usedFrameObjectsListsCount(0){};
   virtual ~RuntimeContext(){};
 
   /**
@@ -30,6 +86,54 @@ class GD_API RuntimeContext {
    */
   std::vector<RuntimeObject *> GetObjectsRawPointers(const gd::String &name);
 
+  /**
+   * \brief Same as GetObjectsRawPointers, using the identifier of the objects
+   * name instead of the name, to avoid hashing strings.
+   * \see RuntimeContext::GetObjectTypeId
+   */
+  std::vector<RuntimeObject *> GetObjectsRawPointers(std::size_t typeId);
+
+  /**
+   * \brief Same as GetObjectsRawPointers, storing the objects in \a list
+   * (replacing its content) instead of returning a new vector.
+   */
+  void GetObjectsRawPointers(std::size_t typeId,
+                             std::vector<RuntimeObject *> &list);
+
+  /**
+   * \brief Get an empty list from the lists kept by the context for the frame.
+   * \note Prefer using a RuntimeContext::FrameObjectsList, which gives back
+   * the list automatically.
+   */
+  std::vector<RuntimeObject *> &AcquireFrameObjectsList();
+
+  /**
+   * \brief Give back the last list returned by AcquireFrameObjectsList.
+   */
+  void ReleaseFrameObjectsList() {
+    if (usedFrameObjectsListsCount > 0) usedFrameObjectsListsCount--;
+  };
+
+  /**
+   * \brief Give back all the lists returned by AcquireFrameObjectsList.
+   * Called at the end of each frame by the scene.
+   */
+  void ResetFrameObjectsLists() { usedFrameObjectsListsCount = 0; };
+
+  /**
+   * \brief Shortcut for ObjInstancesHolder::GetObjectTypeId(name).
+   * Used by the generated code to resolve objects identifiers once, when the
+   * code is loaded.
+   */
+  static std::size_t GetObjectTypeId(const gd::String &name);
+
+  /**
+   * \brief Shortcut for RuntimeObject::GetBehaviorId(name).
+   * Used by the generated code to resolve behaviors identifiers once, when the
+   * code is loaded.
+   */
+  static std::size_t GetBehaviorId(const gd::String &name);
+
   /**
    * \brief Shortcut for scene->GetVariables();
    */
@@ -61,6 +165,11 @@ class GD_API RuntimeContext {
 
  private:
   std::map<gd::String, std::vector<RuntimeObject *> *> temporaryMap;
+  std::deque<std::vector<RuntimeObject *>>
+      frameObjectsLists;  ///< The lists reused by FrameObjectsList. A deque
+                          ///< is used so that lists are never moved.
+  std::size_t usedFrameObjectsListsCount;  ///< The number of lists of
+                                           ///< frameObjectsLists in use.
   std::map<std::size_t, bool> onceConditionsTriggered;
   std::map<std::size_t, bool> onceConditionsTriggeredLastFrame;
 };
@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/JobSystem.h"
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/SoundManager.h"
@@ -30,6 +31,11 @@ class GD_API RuntimeGame : public gd::Project {
 
   /**
    * \brief Set up the RuntimeGame using a gd::Project.
+   *
+   * \note The layouts of the project that were not loaded yet (see
+   * gd::Project::SetLayoutsLoadedLazily) are not unserialized: they share
+   * their serialized content with the project, and are loaded by SceneStack
+   * when a scene is started.
    */
   void LoadFromProject(const gd::Project& project);
 
@@ -43,6 +49,12 @@ class GD_API RuntimeGame : public gd::Project {
    */
   const SoundManager& GetSoundManager() const { return soundManager; };
 
+  /**
+   * \brief Return the threads used by the scenes to do work in parallel, for
+   * example the steps of parallel-safe behaviors before events.
+   */
+  JobSystem& GetJobSystem() { return jobSystem; };
+
   /**
    * \brief Provide access to the global variables container
    */
@@ -72,6 +84,7 @@ class GD_API RuntimeGame : public gd::Project {
  private:
   RuntimeVariablesContainer variables;  ///< List of the global variables
   SoundManager soundManager;
+  JobSystem jobSystem;
 
   unsigned int
       windowOriginalWidth;  ///< Game window width at the start of the game
@@ -5,11 +5,18 @@
  */
 #include "RuntimeLayer.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include "GDCpp/Runtime/Project/Layer.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 
 RuntimeLayer::RuntimeLayer(gd::Layer& layer, const sf::View& defaultView)
-    : name(layer.GetName()), isVisible(layer.GetVisibility()), timeScale(1) {
+    : name(InternedString(layer.GetName())),
+      isVisible(layer.GetVisibility()),
+      isCached(layer.IsCached()),
+      timeScale(1) {
   for (std::size_t i = 0; i < layer.GetCameraCount(); ++i)
     cameras.push_back(RuntimeCamera(layer.GetCamera(i), defaultView));
 }
@@ -18,11 +25,106 @@ signed long long RuntimeLayer::GetElapsedTime(const RuntimeScene& scene) const {
   return scene.GetTimeManager().GetElapsedTime() * timeScale;
 }
 
+void RuntimeLayer::SetCached(bool isCached_) {
+  isCached = isCached_;
+  if (!isCached) cache.reset();
+}
+
+sf::IntRect RuntimeLayer::ComputeCacheArea(
+    const std::vector<RuntimeObject*>& objects) {
+  float left = 0, top = 0, right = 0, bottom = 0;
+  bool isEmpty = true;
+  for (const RuntimeObject* object : objects) {
+    if (object->IsHidden()) continue;
+
+    sf::FloatRect aabb = object->GetAABB();
+    if (aabb.width <= 0 || aabb.height <= 0) continue;
+
+    if (isEmpty) {
+      left = aabb.left;
+      top = aabb.top;
+      right = aabb.left + aabb.width;
+      bottom = aabb.top + aabb.height;
+      isEmpty = false;
+    } else {
+      left = std::min(left, aabb.left);
+      top = std::min(top, aabb.top);
+      right = std::max(right, aabb.left + aabb.width);
+      bottom = std::max(bottom, aabb.top + aabb.height);
+    }
+  }
+  if (isEmpty) return sf::IntRect();
+
+  int areaLeft = static_cast<int>(std::floor(left));
+  int areaTop = static_cast<int>(std::floor(top));
+  return sf::IntRect(areaLeft,
+                     areaTop,
+                     static_cast<int>(std::ceil(right)) - areaLeft,
+                     static_cast<int>(std::ceil(bottom)) - areaTop);
+}
+
+bool RuntimeLayer::UpdateCache(const std::vector<RuntimeObject*>& objects,
+                               SpriteBatch& batch) {
+  std::size_t hash = objects.size();
+  for (const RuntimeObject* object : objects)
+    hash = hash * 31 + object->GetRenderingHash();
+
+  if (!cache) {
+    cache = std::make_shared<Cache>();
+  } else if (cache->hash == hash) {
+    return cache->isRendered;
+  }
+
+  cache->hash = hash;
+  cache->isRendered = false;
+
+  sf::IntRect area = ComputeCacheArea(objects);
+  unsigned int maximumSize = sf::Texture::getMaximumSize();
+  if (static_cast<unsigned int>(area.width) > maximumSize ||
+      static_cast<unsigned int>(area.height) > maximumSize)
+    return false;
+
+  // The texture is only created again when it's too small.
+  unsigned int width = std::max(area.width, 1);
+  unsigned int height = std::max(area.height, 1);
+  sf::Vector2u textureSize = cache->texture.getSize();
+  if (textureSize.x < width || textureSize.y < height) {
+    if (!cache->texture.create(std::max(textureSize.x, width),
+                               std::max(textureSize.y, height)))
+      return false;
+  }
+
+  sf::RenderTexture& texture = cache->texture;
+  texture.setView(sf::View(sf::FloatRect(area.left, area.top, width, height)));
+  texture.clear(sf::Color::Transparent);
+  for (RuntimeObject* object : objects) object->DrawBatched(texture, batch);
+  batch.Flush(texture);
+  texture.display();
+
+  cache->sprite.setTexture(texture.getTexture());
+  cache->sprite.setTextureRect(sf::IntRect(0, 0, width, height));
+  cache->sprite.setPosition(area.left, area.top);
+  cache->isRendered = true;
+  return true;
+}
+
+void RuntimeLayer::DrawCache(sf::RenderTarget& renderTarget) const {
+  if (!cache || !cache->isRendered) return;
+
+  // Objects drawn with alpha blending in a transparent texture leave their
+  // colors multiplied by their alpha: the texture must not be multiplied
+  // again when it is drawn.
+  static const sf::BlendMode premultipliedAlpha(
+      sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+  renderTarget.draw(cache->sprite, premultipliedAlpha);
+}
+
 RuntimeCamera::RuntimeCamera(sf::View& view)
     : originalWidth(view.getSize().x),
       originalHeight(view.getSize().y),
       angle(0),
-      zoomFactor(1) {
+      zoomFactor(1),
+      viewVersion(NewViewVersion()) {
   sfmlView = view;
 }
 
@@ -30,7 +132,8 @@ RuntimeCamera::RuntimeCamera(gd::Camera& camera, const sf::View& defaultView)
     : originalWidth(defaultView.getSize().x),
       originalHeight(defaultView.getSize().y),
       angle(0),
-      zoomFactor(1) {
+      zoomFactor(1),
+      viewVersion(NewViewVersion()) {
   sfmlView = defaultView;
   if (!camera.UseDefaultViewport()) {
     sfmlView.setViewport(
@@ -47,24 +150,34 @@ RuntimeCamera::RuntimeCamera(gd::Camera& camera, const sf::View& defaultView)
   }
 }
 
+std::size_t RuntimeCamera::NewViewVersion() {
+  // Cameras are only modified by the thread running the scene.
+  static std::size_t lastViewVersion = 0;
+  return ++lastViewVersion;
+}
+
 void RuntimeCamera::SetZoom(float newZoom) {
   if (newZoom == 0) return;
 
+  viewVersion = NewViewVersion();
   zoomFactor = newZoom;
   sfmlView.setSize(
       sf::Vector2f(originalWidth / zoomFactor, originalHeight / zoomFactor));
 }
 
 void RuntimeCamera::SetRotation(float newAngle) {
+  viewVersion = NewViewVersion();
   angle = newAngle;
   sfmlView.setRotation(angle);
 }
 
 void RuntimeCamera::SetViewCenter(const sf::Vector2f& newCenter) {
+  viewVersion = NewViewVersion();
   sfmlView.setCenter(newCenter);
 }
 
 void RuntimeCamera::SetSize(float width_, float height_) {
+  viewVersion = NewViewVersion();
   originalWidth = width_;
   originalHeight = height_;
   sfmlView.setSize(originalWidth, originalHeight);
@@ -72,5 +185,13 @@ void RuntimeCamera::SetSize(float width_, float height_) {
 }
 
 void RuntimeCamera::SetViewport(float x1, float y1, float x2, float y2) {
+  viewVersion = NewViewVersion();
   sfmlView.setViewport(sf::FloatRect(x1, y1, x2 - x1, y2 - y1));
 }
+
+sf::FloatRect RuntimeCamera::GetVisibleArea() const {
+  // The inverse transform of the view maps the normalized device coordinates
+  // (from -1 to 1) back to scene coordinates.
+  return sfmlView.getInverseTransform().transformRect(
+      sf::FloatRect(-1, -1, 2, 2));
+}
@@ -6,6 +6,9 @@
 #ifndef RUNTIMELAYER_H
 #define RUNTIMELAYER_H
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "GDCpp/Runtime/InternedString.h"
 #include "GDCpp/Runtime/String.h"
 namespace gd {
 class Camera;
@@ -14,6 +17,8 @@ namespace gd {
 class Layer;
 }
 class RuntimeScene;
+class RuntimeObject;
+class SpriteBatch;
 
 /**
  * \brief A camera which is displayed on a part of a window ( see Viewport
@@ -30,7 +35,11 @@ class GD_API RuntimeCamera {
    * alternatives.
    */
   RuntimeCamera()
-      : originalWidth(0), originalHeight(0), angle(0), zoomFactor(1){};
+      : originalWidth(0),
+        originalHeight(0),
+        angle(0),
+        zoomFactor(1),
+        viewVersion(NewViewVersion()){};
 
   /**
    * Construct a runtime camera from a sf::View ( The SFML equivalent of a
@@ -104,11 +113,30 @@ class GD_API RuntimeCamera {
    */
   void SetViewport(float x1, float y1, float x2, float y2);
 
+  /**
+   * \brief Get the axis aligned bounding box of the area of the scene
+   * rendered by the camera, taking into account its rotation and zoom.
+   */
+  sf::FloatRect GetVisibleArea() const;
+
+  /**
+   * \brief Return a number changing each time the view of the camera is
+   * modified (position, size, zoom, rotation or viewport).
+   *
+   * Versions are unique among all the cameras, so that comparing them is
+   * enough to know if the view used for a previous computation changed, even
+   * if it's another camera.
+   */
+  std::size_t GetViewVersion() const { return viewVersion; }
+
  private:
+  static std::size_t NewViewVersion();
+
   float originalWidth;
   float originalHeight;
   float angle;       ///< Angle of the camera
   float zoomFactor;  ///< Zoom factor of the camera
+  std::size_t viewVersion;  ///< Changed each time the view is modified.
 
   sf::View
       sfmlView;  ///< The sf::View which is the SFML equivalent of a camera.
@@ -121,19 +149,26 @@ class GD_API RuntimeCamera {
  */
 class GD_API RuntimeLayer {
  public:
-  RuntimeLayer() : isVisible(true), timeScale(1){};
+  RuntimeLayer() : isVisible(true), isCached(false), timeScale(1){};
   RuntimeLayer(gd::Layer& layer, const sf::View& defaultView);
   virtual ~RuntimeLayer(){};
 
   /**
    * Change layer name
    */
-  virtual void SetName(const gd::String& name_) { name = name_; }
+  virtual void SetName(const gd::String& name_) {
+    name = InternedString(name_);
+  }
 
   /**
    * Get layer name
    */
-  virtual const gd::String& GetName() const { return name; }
+  virtual const gd::String& GetName() const { return name.GetString(); }
+
+  /**
+   * Get the interned layer name
+   */
+  const InternedString& GetInternedName() const { return name; }
 
   /**
    * Change if layer is displayed or not
@@ -145,6 +180,46 @@ class GD_API RuntimeLayer {
    */
   virtual bool GetVisibility() const { return isVisible; }
 
+  /**
+   * \brief Change if the layer is cached (see IsCached).
+   */
+  void SetCached(bool isCached_);
+
+  /**
+   * \brief Return true if the objects of the layer are rendered once in a
+   * texture, which is displayed by the cameras until the objects are
+   * created, deleted or modified.
+   *
+   * The texture is rendered with a pixel for each unit of the scene, so that
+   * moving the cameras is free but zooming in displays a magnified texture.
+   */
+  bool IsCached() const { return isCached; }
+
+  /**
+   * \brief Render the objects of a cached layer in its texture, if they were
+   * modified since the texture was last rendered (see
+   * RuntimeObject::GetRenderingHash).
+   *
+   * \param objects The objects of the layer, sorted by z-order.
+   * \param batch The batch used to draw the objects.
+   * \return false if the objects can't be rendered in a texture (as the area
+   * covered by them is too large), in which case they must be drawn directly.
+   */
+  bool UpdateCache(const std::vector<RuntimeObject*>& objects,
+                   SpriteBatch& batch);
+
+  /**
+   * \brief Draw the texture of a cached layer, rendered by UpdateCache.
+   */
+  void DrawCache(sf::RenderTarget& renderTarget) const;
+
+  /**
+   * \brief Return the area, in pixels, covered by the objects, used to render
+   * them in the texture of a cached layer.
+   */
+  static sf::IntRect ComputeCacheArea(
+      const std::vector<RuntimeObject*>& objects);
+
   /**
    * Get cameras count.
    */
@@ -195,8 +270,21 @@ class GD_API RuntimeLayer {
   signed long long GetElapsedTime(const RuntimeScene& scene) const;
 
  private:
-  gd::String name;                     ///< The name of the layer
+  /**
+   * \brief The texture in which the objects of a cached layer are rendered.
+   */
+  struct Cache {
+    sf::RenderTexture texture;
+    sf::Sprite sprite;   ///< The rendered part of the texture, on the scene.
+    std::size_t hash;    ///< The hash of the objects rendered in the texture.
+    bool isRendered;     ///< False if the objects can't be rendered.
+  };
+
+  InternedString name;                 ///< The name of the layer
   bool isVisible;                      ///< True if the layer is visible
+  bool isCached;                       ///< True if the layer is cached
+  std::shared_ptr<Cache> cache;  ///< The texture of a cached layer, created
+                                 ///< when it is first rendered.
   std::vector<RuntimeCamera> cameras;  ///< The camera displayed by the layer
   double
       timeScale;  ///< Time scale that is applied on the (objects of the) layer.
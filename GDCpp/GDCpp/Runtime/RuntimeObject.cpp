@@ -5,35 +5,55 @@
  */
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include <SFML/System.hpp>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <unordered_map>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
 #include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 
 using namespace std;
 
 RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
     : name(object.GetName()),
       type(object.GetType()),
-      X(0),
-      Y(0),
       zOrder(0),
       hidden(false),
-      objectVariables(object.GetVariables()) {
+      objectsListTypeId(0),
+      objectsListIndex(0),
+      instancesHolder(NULL),
+      renderSequence(0),
+      recyclingTypeId(0),
+      activatedBehaviorsChanged(true),
+      parallelSafePreEvents(false),
+      X(0),
+      Y(0),
+      transforms(nullptr),
+      transformIndex(0),
+      memoryAccount(gd::SystemStats::Objects) {
+  // The size of the derived classes is not known here: their members are
+  // usually small compared to the ones of RuntimeObject.
+  memoryAccount.SetBytes(sizeof(RuntimeObject));
   ClearForce();
+  if (object.GetVariables().Count() > 0)
+    GetColdData().variables = object.GetVariables();
 
   // Create the behaviors
-  behaviors.clear();
   for (auto &it : object.GetAllBehaviorContents()) {
     std::unique_ptr<RuntimeBehavior> behavior =
         CppPlatform::Get().CreateRuntimeBehavior(it.second->GetTypeName(),
@@ -44,28 +64,129 @@ RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
   }
 }
 
-RuntimeObject::~RuntimeObject() {}
+RuntimeObject::~RuntimeObject() {
+  if (transforms) transforms->Remove(*this);
+}
 
 void RuntimeObject::Init(const RuntimeObject &object) {
   name = object.name;
   type = object.type;
-  objectVariables = object.objectVariables;
+  coldData.reset();
+  behaviorsById.clear();
+  if (object.coldData) GetColdData().variables = object.coldData->variables;
 
-  X = object.X;
-  Y = object.Y;
-  zOrder = object.zOrder;
+  PositionX() = object.GetX();
+  PositionY() = object.GetY();
+  SetZOrder(object.zOrder);
   hidden = object.hidden;
-  layer = object.layer;
+  SetLayer(object.layer);
   force5 = object.force5;
   forces = object.forces;
 
   // Clone behaviors
-  behaviors.clear();
-  for (auto it = object.behaviors.cbegin(); it != object.behaviors.cend();
+  activatedBehaviorsChanged = true;
+  if (!object.coldData) return;
+  for (auto it = object.coldData->behaviors.cbegin();
+       it != object.coldData->behaviors.cend();
        ++it) {
-    behaviors[it->first] =
-        gd::make_unique<RuntimeBehavior>(*it->second->Clone());
-    behaviors[it->first]->SetOwner(this);
+    AddBehavior(it->first,
+                std::unique_ptr<RuntimeBehavior>(it->second->Clone()));
+  }
+}
+
+bool RuntimeObject::Reset(RuntimeScene &scene, const gd::Object &object) {
+  if (type != object.GetType()) return false;
+
+  name = object.GetName();
+  PositionX() = 0;
+  PositionY() = 0;
+  zOrder = 0;
+  hidden = false;
+  layer = InternedString();
+  if (coldData || object.GetVariables().Count() > 0)
+    GetColdData().variables = object.GetVariables();
+  ClearForce();
+
+  // Reset the behaviors, or create them again if they can't be reset.
+  std::map<gd::String, std::unique_ptr<RuntimeBehavior>> oldBehaviors;
+  if (coldData) oldBehaviors.swap(coldData->behaviors);
+  behaviorsById.clear();
+  activatedBehaviorsChanged = true;
+  for (auto &it : object.GetAllBehaviorContents()) {
+    auto oldBehavior = oldBehaviors.find(it.first);
+    if (oldBehavior != oldBehaviors.end() &&
+        oldBehavior->second->Reset(it.second->GetContent())) {
+      RuntimeBehavior* behavior = oldBehavior->second.get();
+      AddBehavior(it.first, std::move(oldBehavior->second));
+      behavior->Activate(true);
+      continue;
+    }
+
+    std::unique_ptr<RuntimeBehavior> behavior =
+        CppPlatform::Get().CreateRuntimeBehavior(it.second->GetTypeName(),
+                                                  it.second->GetContent());
+    if (behavior) {
+      AddBehavior(it.first, std::move(behavior));
+    }
+  }
+
+  return true;
+}
+
+void RuntimeObject::SaveState(SceneSnapshotWriter &writer) const {
+  writer.WriteFloat(GetX());
+  writer.WriteFloat(GetY());
+  writer.WriteFloat(GetAngle());
+  writer.WriteInt(zOrder);
+  writer.WriteBool(hidden);
+  writer.WriteString(layer.GetString());
+  writer.WriteFloat(force5.GetX());
+  writer.WriteFloat(force5.GetY());
+  writer.WriteFloat(force5.GetClearing());
+  forces.SaveState(writer);
+  writer.WriteVariables(GetVariables());
+
+  // The state of each behavior is written in a block, so that it can be
+  // skipped if the behavior is missing when the state is restored.
+  if (!coldData) {
+    writer.WriteUInt(0);
+    return;
+  }
+  writer.WriteUInt(coldData->behaviors.size());
+  for (const auto &it : coldData->behaviors) {
+    writer.WriteString(it.first);
+    writer.WriteBool(it.second->Activated());
+    std::size_t block = writer.BeginBlock();
+    it.second->SaveState(writer);
+    writer.EndBlock(block);
+  }
+}
+
+void RuntimeObject::RestoreState(SceneSnapshotReader &reader) {
+  SetX(reader.ReadFloat());
+  SetY(reader.ReadFloat());
+  SetAngle(reader.ReadFloat());
+  int newZOrder = static_cast<int>(reader.ReadInt());
+  if (newZOrder != zOrder) SetZOrder(newZOrder);
+  hidden = reader.ReadBool();
+  gd::String newLayer = reader.ReadString();
+  if (newLayer != layer.GetString()) SetLayer(newLayer);
+  force5.SetX(reader.ReadFloat());
+  force5.SetY(reader.ReadFloat());
+  force5.SetClearing(reader.ReadFloat());
+  forces.RestoreState(reader);
+  reader.ReadVariables(GetVariables());
+
+  std::size_t behaviorsCount = reader.ReadUInt();
+  for (std::size_t i = 0; i < behaviorsCount && reader.IsValid(); ++i) {
+    gd::String behaviorName = reader.ReadString();
+    bool activated = reader.ReadBool();
+    SceneSnapshotReader block = reader.ReadBlock();
+
+    RuntimeBehavior *behavior = GetBehaviorRawPointer(behaviorName);
+    if (!behavior) continue;
+    behavior->Activate(activated);
+    behavior->RestoreState(block);
   }
 }
 
@@ -74,10 +195,36 @@ void RuntimeObject::Init(const RuntimeObject &object) {
  */
 void RuntimeObject::AddBehavior(const gd::String &name,
                                 std::unique_ptr<RuntimeBehavior> behavior) {
-  behaviors[name] = std::move(behavior);
-  behaviors[name]->SetOwner(this);
+  RuntimeBehavior* behaviorRawPointer = behavior.get();
+  GetColdData().behaviors[name] = std::move(behavior);
+  behaviorRawPointer->SetOwner(this);
+
+  std::size_t behaviorId = GetBehaviorId(name);
+  if (behaviorId >= behaviorsById.size())
+    behaviorsById.resize(behaviorId + 1, nullptr);
+  behaviorsById[behaviorId] = behaviorRawPointer;
+  activatedBehaviorsChanged = true;
 };
 
+namespace {
+// A function local static is used so that the identifiers can be safely
+// requested during the static initialization of the events compiled code.
+std::unordered_map<gd::String, std::size_t>& GetBehaviorIds() {
+  static std::unordered_map<gd::String, std::size_t> behaviorIds;
+  return behaviorIds;
+}
+}  // namespace
+
+std::size_t RuntimeObject::GetBehaviorId(const gd::String &name) {
+  auto &behaviorIds = GetBehaviorIds();
+  auto it = behaviorIds.find(name);
+  if (it != behaviorIds.end()) return it->second;
+
+  std::size_t behaviorId = behaviorIds.size();
+  behaviorIds[name] = behaviorId;
+  return behaviorId;
+}
+
 #if defined(GD_IDE_ONLY)
 void RuntimeObject::GetPropertyForDebugger(std::size_t propertyNb,
                                            gd::String &name,
@@ -96,7 +243,7 @@ void RuntimeObject::GetPropertyForDebugger(std::size_t propertyNb,
     value = hidden ? _("Hidden") : _("Displayed");
   } else if (propertyNb == 4) {
     name = _("Layer");
-    value = layer;
+    value = layer.GetString();
   } else if (propertyNb == 5) {
     name = _("Z order");
     value = gd::String::From(zOrder);
@@ -137,7 +284,7 @@ bool RuntimeObject::ChangeProperty(std::size_t propertyNb,
     } else
       SetHidden(false);
   } else if (propertyNb == 4) {
-    layer = newValue;
+    SetLayer(newValue);
   } else if (propertyNb == 5) {
     SetZOrder(newValue.To<int>());
   } else if (propertyNb == 6) {
@@ -159,6 +306,38 @@ std::size_t RuntimeObject::GetNumberOfProperties() const {
 }
 #endif
 
+void RuntimeObject::SetZOrder(int zOrder_) {
+  if (instancesHolder)
+    instancesHolder->SetObjectZOrder(this, zOrder_);
+  else
+    zOrder = zOrder_;
+}
+
+void RuntimeObject::SetLayer(const gd::String &layer_) {
+  if (instancesHolder)
+    instancesHolder->SetObjectLayer(this, layer_);
+  else
+    layer = InternedString(layer_);
+}
+
+bool RuntimeObject::DrawBatched(sf::RenderTarget &renderTarget,
+                                SpriteBatch &batch) {
+  batch.Flush(renderTarget);
+  return Draw(renderTarget);
+}
+
+std::size_t RuntimeObject::GetRenderingHash() const {
+  std::hash<float> hashFloat;
+  std::size_t hash = hidden;
+  hash = hash * 31 + static_cast<std::size_t>(zOrder);
+  hash = hash * 31 + hashFloat(GetDrawableX());
+  hash = hash * 31 + hashFloat(GetDrawableY());
+  hash = hash * 31 + hashFloat(GetWidth());
+  hash = hash * 31 + hashFloat(GetHeight());
+  hash = hash * 31 + hashFloat(GetAngle());
+  return hash;
+}
+
 signed long long RuntimeObject::GetElapsedTime(
     const RuntimeScene &scene) const {
   const RuntimeLayer &theLayer = scene.GetRuntimeLayer(layer);
@@ -188,14 +367,14 @@ void RuntimeObject::PutAroundAPosition(float positionX,
 }
 
 void RuntimeObject::AddForce(float x, float y, float clearing) {
-  forces.push_back(Force(x, y, clearing));
+  forces.Add(x, y, clearing);
 }
 
 void RuntimeObject::AddForceUsingPolarCoordinates(float angle,
                                                   float length,
                                                   float clearing) {
   angle *= 3.14159 / 180.0;
-  forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  forces.Add(cos(angle) * length, sin(angle) * length, clearing);
 }
 /**
  * Add a force toward a position
@@ -209,7 +388,7 @@ void RuntimeObject::AddForceTowardPosition(float positionX,
   double x = positionX - (GetDrawableX() + GetCenterX());
   float angle = atan2(y, x);
 
-  forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  forces.Add(cos(angle) * length, sin(angle) * length, clearing);
 }
 
 void RuntimeObject::AddForceToMoveAround(float positionX,
@@ -233,7 +412,7 @@ void RuntimeObject::AddForceToMoveAround(float positionX,
   int newX = cos(newangle / 180.f * 3.14159f) * distance;
   int newY = sin(newangle / 180.f * 3.14159f) * distance;
 
-  forces.push_back(Force(newX - oldX, newY - oldY, clearing));
+  forces.Add(newX - oldX, newY - oldY, clearing);
 }
 
 void RuntimeObject::Duplicate(
@@ -249,7 +428,9 @@ void RuntimeObject::Duplicate(
     pickedObjectLists[name]->push_back(newObject);
 }
 
-bool RuntimeObject::IsStopped() { return TotalForceLength() == 0; }
+bool RuntimeObject::IsStopped() {
+  return TotalForceX() == 0 && TotalForceY() == 0;
+}
 
 bool RuntimeObject::TestAngleOfDisplacement(float angle, float tolerance) {
   if (TotalForceLength() == 0) return false;
@@ -297,44 +478,112 @@ double RuntimeObject::GetDistanceWithObject(RuntimeObject *object) {
   return sqrt(GetSqDistanceWithObject(object));
 }
 
+namespace {
+/**
+ * \brief Compute the bounding box of the vertices of the hitboxes.
+ * \return false if the hitboxes have no vertices.
+ */
+bool GetHitBoxesBounds(const std::vector<Polygon2d> &hitBoxes,
+                       sf::FloatRect &bounds) {
+  bool hasVertices = false;
+  float minX = 0, minY = 0, maxX = 0, maxY = 0;
+  for (const Polygon2d &hitBox : hitBoxes) {
+    for (const sf::Vector2f &vertex : hitBox.vertices) {
+      if (!hasVertices) {
+        minX = maxX = vertex.x;
+        minY = maxY = vertex.y;
+        hasVertices = true;
+        continue;
+      }
+
+      minX = std::min(minX, vertex.x);
+      minY = std::min(minY, vertex.y);
+      maxX = std::max(maxX, vertex.x);
+      maxY = std::max(maxY, vertex.y);
+    }
+  }
+
+  bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+  return hasVertices;
+}
+
+/**
+ * \brief Add to \a moveVector the move vectors separating the hitboxes from
+ * the hitboxes of \a other.
+ *
+ * The polygons are only tested if the bounding boxes of the hitboxes are
+ * overlapping or touching, so that objects far away are discarded without
+ * testing each pair of polygons.
+ *
+ * \return true if a hitbox is overlapping a hitbox of \a other.
+ */
+bool AddSeparationMoveVector(const std::vector<Polygon2d> &hitBoxes,
+                             const sf::FloatRect &bounds,
+                             RuntimeObject &other,
+                             bool ignoreTouchingEdges,
+                             sf::Vector2f &moveVector) {
+  const vector<Polygon2d> &otherHitBoxes = other.GetHitBoxesRef();
+  sf::FloatRect otherBounds;
+  if (!GetHitBoxesBounds(otherHitBoxes, otherBounds) ||
+      !ObjectsSpatialHash::AreOverlapping(bounds, otherBounds))
+    return false;
+
+  bool overlapping = false;
+  for (std::size_t k = 0; k < hitBoxes.size(); ++k) {
+    if (PolygonCollisionTestAll(
+            hitBoxes[k], otherHitBoxes, moveVector, ignoreTouchingEdges))
+      overlapping = true;
+  }
+
+  return overlapping;
+}
+}  // namespace
+
 bool RuntimeObject::SeparateFromObjects(
     std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
     bool ignoreTouchingEdges) {
-  vector<RuntimeObject *> objects;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
-       it != pickedObjectLists.end();
-       ++it) {
-    if (it->second != NULL) {
-      objects.reserve(objects.size() + it->second->size());
-      std::copy(
-          it->second->begin(), it->second->end(), std::back_inserter(objects));
+  bool moved = false;
+  sf::Vector2f moveVector;
+  const std::vector<Polygon2d> &hitBoxes = GetHitBoxesRef();
+  sf::FloatRect bounds;
+  if (GetHitBoxesBounds(hitBoxes, bounds)) {
+    // The lists are iterated directly, without copying the objects in a
+    // single list.
+    for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator
+             it = pickedObjectLists.begin();
+         it != pickedObjectLists.end();
+         ++it) {
+      if (it->second == NULL) continue;
+
+      for (RuntimeObject *object : *it->second) {
+        if (object != this &&
+            AddSeparationMoveVector(
+                hitBoxes, bounds, *object, ignoreTouchingEdges, moveVector))
+          moved = true;
+      }
     }
   }
 
-  return SeparateFromObjects(objects, ignoreTouchingEdges);
+  SetX(GetX() + moveVector.x);
+  SetY(GetY() + moveVector.y);
+  return moved;
 }
 
 bool RuntimeObject::SeparateFromObjects(
     const std::vector<RuntimeObject *> &objects, bool ignoreTouchingEdges) {
   bool moved = false;
   sf::Vector2f moveVector;
-  for (std::size_t j = 0; j < objects.size(); ++j) {
-    if (objects[j] != this) {
-      std::vector<Polygon2d> hitBoxes = GetHitBoxes(objects[j]->GetAABB());
-      vector<Polygon2d> otherHitBoxes = objects[j]->GetHitBoxes(GetAABB());
-      for (std::size_t k = 0; k < hitBoxes.size(); ++k) {
-        for (std::size_t l = 0; l < otherHitBoxes.size(); ++l) {
-          CollisionResult result = PolygonCollisionTest(
-              hitBoxes[k], otherHitBoxes[l], ignoreTouchingEdges);
-          if (result.collision) {
-            moveVector += result.move_axis;
-            moved = true;
-          }
-        }
-      }
+  const std::vector<Polygon2d> &hitBoxes = GetHitBoxesRef();
+  sf::FloatRect bounds;
+  if (GetHitBoxesBounds(hitBoxes, bounds)) {
+    for (std::size_t j = 0; j < objects.size(); ++j) {
+      if (objects[j] != this &&
+          AddSeparationMoveVector(
+              hitBoxes, bounds, *objects[j], ignoreTouchingEdges, moveVector))
+        moved = true;
     }
   }
+
   SetX(GetX() + moveVector.x);
   SetY(GetY() + moveVector.y);
   return moved;
@@ -404,28 +653,19 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
     return false;
 
   // Do a real check if necessary.
-
-  // Get the bounding rect of the two objects to use them
-  // as a hint to get the other's hitboxes
-  sf::FloatRect objRect = obj1->GetAABB();
-  sf::FloatRect obj2Rect = obj2->GetAABB();
-
-  vector<Polygon2d> objHitboxes = obj1->GetHitBoxes(obj2Rect);
-  vector<Polygon2d> obj2Hitboxes = obj2->GetHitBoxes(objRect);
+  const vector<Polygon2d>& objHitboxes = obj1->GetHitBoxesRef();
+  const vector<Polygon2d>& obj2Hitboxes = obj2->GetHitBoxesRef();
   for (std::size_t k = 0; k < objHitboxes.size(); ++k) {
-    for (std::size_t l = 0; l < obj2Hitboxes.size(); ++l) {
-      if (PolygonCollisionTest(
-              objHitboxes[k], obj2Hitboxes[l], ignoreTouchingEdges)
-              .collision)
-        return true;
-    }
+    if (PolygonCollisionTestAny(
+            objHitboxes[k], obj2Hitboxes, ignoreTouchingEdges))
+      return true;
   }
 
   return false;
 }
 
 bool RuntimeObject::IsCollidingWithPoint(float pointX, float pointY) {
-  vector<Polygon2d> hitBoxes = GetHitBoxes();
+  const vector<Polygon2d>& hitBoxes = GetHitBoxesRef();
   for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
     if (IsPointInsidePolygon(hitBoxes[i], pointX, pointY)) return true;
   }
@@ -442,32 +682,14 @@ RaycastResult RuntimeObject::RaycastTest(
   float sqBoundingR = (objW * objW + objH * objH) / 4.0;
   float sqDist = (endX - x) * (endX - x) + (endY - y) * (endY - y);
 
-  RaycastResult result;
-  result.collision = false;
-
   if (diffX * diffX + diffY * diffY >
-      sqBoundingR + sqDist + 2 * sqrt(sqDist * sqBoundingR))
+      sqBoundingR + sqDist + 2 * sqrt(sqDist * sqBoundingR)) {
+    RaycastResult result;
+    result.collision = false;
     return result;
-
-  float testSqDist = closest ? sqDist : 0.0f;
-
-  vector<Polygon2d> hitboxes = GetHitBoxes();
-  for (std::size_t i = 0; i < hitboxes.size(); ++i) {
-    RaycastResult res = PolygonRaycastTest(hitboxes[i], x, y, endX, endY);
-
-    if (res.collision) {
-      if (closest && (res.closeSqDist < testSqDist)) {
-        testSqDist = res.closeSqDist;
-        result = res;
-      } else if (!closest && (res.farSqDist > testSqDist) &&
-                 (res.farSqDist <= sqDist)) {
-        testSqDist = res.farSqDist;
-        result = res;
-      }
-    }
   }
 
-  return result;
+  return PolygonsRaycastTest(GetHitBoxesRef(), x, y, endX, endY, closest);
 }
 
 void RuntimeObject::SeparateObjectsWithoutForces(
@@ -581,33 +803,6 @@ void RuntimeObject::PutAroundObject(RuntimeObject *object,
                      angleInDegrees);
 }
 
-void RuntimeObject::SetXY(const char *xOperator,
-                          float xValue,
-                          const char *yOperator,
-                          float yValue) {
-  if (strcmp(xOperator, "") == 0 || strcmp(xOperator, "=") == 0)
-    SetX(xValue);
-  else if (strcmp(xOperator, "+") == 0)
-    SetX(GetX() + xValue);
-  else if (strcmp(xOperator, "-") == 0)
-    SetX(GetX() - xValue);
-  else if (strcmp(xOperator, "*") == 0)
-    SetX(GetX() * xValue);
-  else if (strcmp(xOperator, "/") == 0)
-    SetX(GetX() / xValue);
-
-  if (strcmp(yOperator, "") == 0 || strcmp(yOperator, "=") == 0)
-    SetY(yValue);
-  else if (strcmp(yOperator, "+") == 0)
-    SetY(GetY() + yValue);
-  else if (strcmp(yOperator, "-") == 0)
-    SetY(GetY() - yValue);
-  else if (strcmp(yOperator, "*") == 0)
-    SetY(GetY() * yValue);
-  else if (strcmp(yOperator, "/") == 0)
-    SetY(GetY() / yValue);
-}
-
 sf::FloatRect RuntimeObject::GetAABB() const {
   sf::FloatRect notTransformedAABB(
       -GetCenterX(), -GetCenterY(), GetWidth(), GetHeight());
@@ -640,6 +835,11 @@ std::vector<Polygon2d> RuntimeObject::GetHitBoxes(sf::FloatRect hint) const {
   return GetHitBoxes();
 }
 
+const std::vector<Polygon2d> &RuntimeObject::GetHitBoxesRef() const {
+  hitBoxesCache = GetHitBoxes();
+  return hitBoxesCache;
+}
+
 bool RuntimeObject::CursorOnObject(RuntimeScene &scene, bool) {
   RuntimeLayer &theLayer = scene.GetRuntimeLayer(layer);
   auto insideObject = [this](const sf::Vector2f &pos) {
@@ -668,19 +868,27 @@ bool RuntimeObject::CursorOnObject(RuntimeScene &scene, bool) {
 }
 
 RuntimeBehavior *RuntimeObject::GetBehaviorRawPointer(const gd::String &name) {
-  return behaviors.find(name)->second.get();
+  return const_cast<const RuntimeObject *>(this)->GetBehaviorRawPointer(name);
 }
 
 RuntimeBehavior *RuntimeObject::GetBehaviorRawPointer(
     const gd::String &name) const {
-  return behaviors.find(name)->second.get();
+  if (!coldData) return nullptr;
+
+  auto it = coldData->behaviors.find(name);
+  return it != coldData->behaviors.end() ? it->second.get() : nullptr;
+}
+
+const RuntimeVariablesContainer &RuntimeObject::GetVariables() const {
+  static const RuntimeVariablesContainer noVariables;
+  return coldData ? coldData->variables : noVariables;
 }
 
 bool RuntimeObject::ClearForce() {
   force5.SetLength(0);  // Clear the deprecated force
   force5.SetClearing(0);
 
-  forces.clear();
+  forces.Clear();
 
   return true;
 }
@@ -691,34 +899,17 @@ bool RuntimeObject::UpdateForce(float elapsedTime) {
                                             elapsedTime);
   if (force5.GetClearing() == 0) force5.SetLength(0);
 
-  for (std::size_t i = 0; i < forces.size();) {
-    if (forces[i].GetClearing() == 0 || forces[i].GetLength() <= 0.001)
-      forces.erase(forces.begin() + i);
-    else {
-      forces[i].SetLength(forces[i].GetLength() -
-                          forces[i].GetLength() *
-                              (1 - forces[i].GetClearing()) * elapsedTime);
-      ++i;
-    }
-  }
+  forces.Update(elapsedTime);
 
   return true;
 }
 
 float RuntimeObject::TotalForceX() const {
-  float ForceXsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
-    ForceXsimple += forces[i].GetX();
-
-  return ForceXsimple + force5.GetX();
+  return forces.GetTotalX() + force5.GetX();
 }
 
 float RuntimeObject::TotalForceY() const {
-  float ForceYsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
-    ForceYsimple += forces[i].GetY();
-
-  return ForceYsimple + force5.GetY();
+  return forces.GetTotalY() + force5.GetY();
 }
 
 float RuntimeObject::TotalForceAngle() const {
@@ -730,25 +921,74 @@ float RuntimeObject::TotalForceAngle() const {
 }
 
 float RuntimeObject::TotalForceLength() const {
-  Force ForceMoyenne;
-  ForceMoyenne.SetX(TotalForceX());
-  ForceMoyenne.SetY(TotalForceY());
+  float x = TotalForceX();
+  float y = TotalForceY();
+
+  return sqrt(x * x + y * y);
+}
 
-  return ForceMoyenne.GetLength();
+void RuntimeObject::UpdateActivatedBehaviors() {
+  if (!activatedBehaviorsChanged) return;
+
+  activatedBehaviors.clear();
+  parallelSafePreEvents = true;
+  if (coldData) {
+    for (const auto &it : coldData->behaviors) {
+      if (it.second->Activated() && !it.second->IsSteppedInBatch()) {
+        activatedBehaviors.emplace_back(&it.first, it.second.get());
+        parallelSafePreEvents &= it.second->IsPreEventsStepParallelSafe();
+      }
+    }
+  }
+  parallelSafePreEvents &= !activatedBehaviors.empty();
+  activatedBehaviorsChanged = false;
 }
 
 void RuntimeObject::DoBehaviorsPreEvents(RuntimeScene &scene) {
-  for (auto it = behaviors.cbegin(); it != behaviors.cend(); ++it)
-    it->second->StepPreEvents(scene);
+  UpdateActivatedBehaviors();
+
+  // Behaviors deactivated by a previous behavior during this step are
+  // skipped. Behaviors activated during this step are stepped from the next
+  // frame.
+  FrameProfiler *profiler = scene.GetFrameProfiler();
+  for (std::size_t i = 0; i < activatedBehaviors.size(); ++i) {
+    RuntimeBehavior *behavior = activatedBehaviors[i].second;
+    if (activatedBehaviorsChanged && !behavior->Activated()) continue;
+    if (!profiler) {
+      behavior->DoStepPreEvents(scene);
+      continue;
+    }
+
+    signed long long startTime = profiler->GetTime();
+    behavior->DoStepPreEvents(scene);
+    profiler->AddBehaviorTime(*activatedBehaviors[i].first,
+                              false,
+                              profiler->GetTime() - startTime);
+  }
 }
 
 void RuntimeObject::DoBehaviorsPostEvents(RuntimeScene &scene) {
-  for (auto it = behaviors.cbegin(); it != behaviors.cend(); ++it)
-    it->second->StepPostEvents(scene);
+  UpdateActivatedBehaviors();
+
+  FrameProfiler *profiler = scene.GetFrameProfiler();
+  for (std::size_t i = 0; i < activatedBehaviors.size(); ++i) {
+    RuntimeBehavior *behavior = activatedBehaviors[i].second;
+    if (activatedBehaviorsChanged && !behavior->Activated()) continue;
+    if (!profiler) {
+      behavior->DoStepPostEvents(scene);
+      continue;
+    }
+
+    signed long long startTime = profiler->GetTime();
+    behavior->DoStepPostEvents(scene);
+    profiler->AddBehaviorTime(*activatedBehaviors[i].first,
+                              true,
+                              profiler->GetTime() - startTime);
+  }
 }
 
 bool RuntimeObject::VariableExists(const gd::String &variable) {
-  return objectVariables.Has(variable);
+  return coldData && coldData->variables.Has(variable);
 }
 
 bool RuntimeObject::VariableChildExists(const gd::Variable &variable,
@@ -12,7 +12,12 @@
 #include <string>
 #include <vector>
 #include "GDCore/Tools/MakeUnique.h"
+#include "GDCore/Tools/SystemStats.h"
 #include "GDCpp/Runtime/Force.h"
+#include "GDCpp/Runtime/InternedString.h"
+#include "GDCpp/Runtime/ObjectForces.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/String.h"
@@ -23,9 +28,12 @@ class Object;
 namespace sf {
 class RenderTarget;
 }
-class Polygon2d;
+class ObjInstancesHolder;
 class RaycastResult;
 class RuntimeScene;
+class SceneSnapshotReader;
+class SceneSnapshotWriter;
+class SpriteBatch;
 
 /**
  * \brief A RuntimeObject is something displayed on the scene.
@@ -90,7 +98,19 @@ class GD_API RuntimeObject {
   /**
    * \brief Copy constructor. Calls Init().
    */
-  RuntimeObject(const RuntimeObject& object) { Init(object); };
+  RuntimeObject(const RuntimeObject& object)
+      : objectsListTypeId(0),
+        objectsListIndex(0),
+        instancesHolder(NULL),
+        renderSequence(0),
+        recyclingTypeId(0),
+        activatedBehaviorsChanged(true),
+        parallelSafePreEvents(false),
+        transforms(nullptr),
+        transformIndex(0),
+        memoryAccount(object.memoryAccount) {
+    Init(object);
+  };
 
   /**
    * \brief Assignment operator. Calls Init().
@@ -136,6 +156,84 @@ class GD_API RuntimeObject {
    */
   virtual bool Draw(sf::RenderTarget& renderTarget) { return true; };
 
+  /**
+   * \brief Draw the object, using a batch so that consecutive objects using
+   * the same texture can be drawn at once.
+   *
+   * The default implementation flushes the batch and calls Draw. Objects
+   * drawn with a single sprite should redefine it to add their sprite to the
+   * batch.
+   *
+   * \param renderTarget The SFML Rendertarget where object must be drawn.
+   * \param batch The batch used to accumulate sprites.
+   */
+  virtual bool DrawBatched(sf::RenderTarget& renderTarget, SpriteBatch& batch);
+
+  /**
+   * \brief Return true if the object can be skipped during rendering when its
+   * AABB is outside of the area rendered by a camera.
+   *
+   * \note Objects drawing outside of their AABB should redefine it to return
+   * false.
+   */
+  virtual bool CanBeCulled() const { return true; }
+
+  /**
+   * \brief Return a value changing when the object is rendered differently,
+   * used to know if the texture of a cached layer must be rendered again (see
+   * RuntimeLayer::IsCached).
+   *
+   * The default implementation combines the position, size, angle, z-order
+   * and visibility of the object. Objects having other properties changing
+   * their appearance should redefine it, combining these properties with the
+   * value returned by the original method.
+   */
+  virtual std::size_t GetRenderingHash() const;
+
+  /**
+   * \brief Return true if the object can be kept by ObjInstancesHolder when
+   * it is deleted, to be reused for a new object later (see Reset).
+   *
+   * \note Objects owning resources that can't be reset (or not implementing
+   * Reset for their own members) should redefine it to return false.
+   */
+  virtual bool CanBeRecycled() const { return true; }
+
+  /**
+   * \brief Reset a deleted object so that it is in the same state as an
+   * object newly created from \a object.
+   *
+   * The default implementation resets the common properties (name, position,
+   * variables, forces...) and the behaviors (see RuntimeBehavior::Reset).
+   * Objects redefining it must call the original method:
+   * \code
+   * bool MyRuntimeObject::Reset(RuntimeScene & scene, const gd::Object & object)
+   * {
+   *     if (!RuntimeObject::Reset(scene, object)) return false;
+   *     //...
+   * }
+   * \endcode
+   * \return false if the object could not be reset, in which case it must be
+   * destroyed.
+   */
+  virtual bool Reset(RuntimeScene& scene, const gd::Object& object);
+
+  /**
+   * \brief Write the state of the object in a snapshot of the scene (see
+   * RuntimeScene::TakeSnapshot).
+   *
+   * The default implementation writes the position, angle, z-order, layer,
+   * visibility, forces, variables and behaviors (see
+   * RuntimeBehavior::SaveState). Objects redefining it must call the original
+   * method first, then write their own members changing during the game.
+   */
+  virtual void SaveState(SceneSnapshotWriter& writer) const;
+
+  /**
+   * \brief Restore the state written by SaveState.
+   */
+  virtual void RestoreState(SceneSnapshotReader& reader);
+
   /** \name Object's variables
    * Members functions providing access to the object's variables.
    */
@@ -143,15 +241,17 @@ class GD_API RuntimeObject {
 
   /**
    * \brief Provide access to variables of the object.
+   *
+   * \note An empty container is returned if the object has no variables.
    */
-  inline const RuntimeVariablesContainer& GetVariables() const {
-    return objectVariables;
-  }
+  const RuntimeVariablesContainer& GetVariables() const;
 
   /**
    * \brief Provide access to variables of the object.
    */
-  inline RuntimeVariablesContainer& GetVariables() { return objectVariables; }
+  inline RuntimeVariablesContainer& GetVariables() {
+    return GetColdData().variables;
+  }
 
   ///@}
 
@@ -164,6 +264,18 @@ class GD_API RuntimeObject {
    */
   void DoBehaviorsPreEvents(RuntimeScene& scene);
 
+  /**
+   * \brief Return true if the object has activated behaviors and all of them
+   * can do their work before events at the same time as the behaviors of
+   * other objects.
+   *
+   * \see RuntimeBehavior::IsPreEventsStepParallelSafe
+   */
+  bool CanDoBehaviorsPreEventsInParallel() {
+    UpdateActivatedBehaviors();
+    return parallelSafePreEvents;
+  }
+
   /**
    * \brief Call each behavior so that they do their work after the events were
    * runn.
@@ -180,11 +292,33 @@ class GD_API RuntimeObject {
    */
   RuntimeBehavior* GetBehaviorRawPointer(const gd::String& name) const;
 
+  /**
+   * \brief Return the behavior with the specified identifier, or nullptr if
+   * the object has no such behavior.
+   *
+   * \note Used by the code generated from events, where the identifiers of
+   * the behaviors are resolved once, when the code is loaded.
+   * \see RuntimeObject::GetBehaviorId
+   */
+  RuntimeBehavior* GetBehaviorRawPointerById(std::size_t behaviorId) const {
+    return behaviorId < behaviorsById.size() ? behaviorsById[behaviorId]
+                                             : nullptr;
+  }
+
+  /**
+   * \brief Return the identifier of the behaviors having the specified name.
+   *
+   * Identifiers are shared by all objects and are allocated in the order the
+   * names are first requested, so that they can be used as indices.
+   */
+  static std::size_t GetBehaviorId(const gd::String& name);
+
   /**
    * \brief Return true if the object has the behavior with the specified name.
    */
   bool HasBehaviorNamed(const gd::String& name) const {
-    return behaviors.find(name) != behaviors.end();
+    return coldData &&
+           coldData->behaviors.find(name) != coldData->behaviors.end();
   };
 
   /**
@@ -210,8 +344,10 @@ class GD_API RuntimeObject {
 
   /**
    * \brief Change the Z order of the object
+   * \note If the object is in a ObjInstancesHolder, its position in the lists
+   * of objects sorted by z-order is updated.
    */
-  inline void SetZOrder(int zOrder_) { zOrder = zOrder_; }
+  void SetZOrder(int zOrder_);
 
   /**
    * \brief Return if the object is hidden or not
@@ -231,24 +367,39 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the layer of the object
    */
-  inline void SetLayer(const gd::String& layer_) { layer = layer_; }
+  void SetLayer(const gd::String& layer_);
 
   /**
    * \brief Get the layer of the object
    */
-  inline const gd::String& GetLayer() const { return layer; }
+  inline const gd::String& GetLayer() const { return layer.GetString(); }
+
+  /**
+   * \brief Get the interned name of the layer of the object.
+   */
+  inline const InternedString& GetInternedLayer() const { return layer; }
 
   /**
    * \brief Check if the object is on a layer.
    */
   inline bool IsOnLayer(const gd::String& layer_) const {
+    return layer.GetString() == layer_;
+  }
+
+  /**
+   * \brief Check if the object is on a layer, comparing the interned names.
+   */
+  inline bool IsOnLayer(const InternedString& layer_) const {
     return layer == layer_;
   }
 
   /**
    * \brief Get the object AABB
+   * \note Default implementation computes the AABB using the object
+   * width/height, center and angle. Objects can redefine it to return a cached
+   * AABB.
    */
-  sf::FloatRect GetAABB() const;
+  virtual sf::FloatRect GetAABB() const;
 
   /**
    * \brief Get the object hitbox(es)
@@ -264,6 +415,15 @@ class GD_API RuntimeObject {
    */
   virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
 
+  /**
+   * \brief Get a reference to the object hitbox(es), to avoid copying them.
+   * \note The default implementation stores the result of GetHitBoxes() in the
+   * object. Objects caching their hitboxes (like RuntimeSpriteObject) redefine
+   * it to return them without recomputing them.
+   * \warning The reference is only valid until the object is modified.
+   */
+  virtual const std::vector<Polygon2d>& GetHitBoxesRef() const;
+
   /**
    * \brief Check collision between two objects using their hitboxes.
    *
@@ -380,12 +540,16 @@ class GD_API RuntimeObject {
   /**
    * \brief Get the X coordinate of the object in the layout.
    */
-  inline float GetX() const { return X; }
+  inline float GetX() const {
+    return transforms ? transforms->x[transformIndex] : X;
+  }
 
   /**
    * \brief Get the Y coordinate of the object in the layout.
    */
-  inline float GetY() const { return Y; }
+  inline float GetY() const {
+    return transforms ? transforms->y[transformIndex] : Y;
+  }
 
   /**
    * \brief Change X position of the object.
@@ -393,7 +557,7 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetX(float x_) {
-    X = x_;
+    PositionX() = x_;
     OnPositionChanged();
   }
 
@@ -403,7 +567,7 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetY(float y_) {
-    Y = y_;
+    PositionY() = y_;
     OnPositionChanged();
   }
 
@@ -571,11 +735,6 @@ class GD_API RuntimeObject {
   static void VariableClearChildren(gd::Variable& variable);
   static unsigned int GetVariableChildCount(gd::Variable& variable);
 
-  void SetXY(const char* xOperator,
-             float xValue,
-             const char* yOperator,
-             float yValue);
-
   void Duplicate(
       RuntimeScene& scene,
       std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
@@ -607,24 +766,92 @@ class GD_API RuntimeObject {
   gd::String name;  ///< The full name of the object
   gd::String type;  ///< Which type is the object. ( To test if we can do
                     ///< something reserved to some objects with it )
-  float X;          ///< X position on the scene
-  float Y;          ///< Y position on the scene
   int zOrder;   ///< Z order on the scene, to choose if an object is displayed
                 ///< before another object.
   bool hidden;  ///< True to prevent the object from being rendered.
-  gd::String layer;  ///< Name of the layer on which the object is.
-  std::map<gd::String, std::unique_ptr<RuntimeBehavior>>
-      behaviors;  ///< Contains all behaviors of the object. Behaviors are the
-                  ///< ownership of the object
-  RuntimeVariablesContainer
-      objectVariables;        ///< List of the variables of the object
-  std::vector<Force> forces;  ///< Forces applied to the object
+  InternedString layer;  ///< Name of the layer on which the object is.
+  std::vector<RuntimeBehavior*>
+      behaviorsById;  ///< The behaviors, indexed by their identifier (see
+                      ///< GetBehaviorId), or nullptr.
+  ObjectForces forces;        ///< Forces applied to the object
 
   /**
    * \brief Initialize object using another object. Used by copy-ctor and
    * assign-op. \warning Don't forget to update me if members were changed!
    */
   void Init(const RuntimeObject& object);
+
+ private:
+  friend class ObjInstancesHolder;
+  friend class ObjectsTransforms;
+  friend class RuntimeBehavior;
+
+  /**
+   * \brief The members of the object that are rarely used during a frame,
+   * stored apart so that they don't take the place of the members used by the
+   * frequent operations (position, rendering...) in the cache.
+   */
+  struct ColdData {
+    RuntimeVariablesContainer variables;  ///< The variables of the object.
+    std::map<gd::String, std::unique_ptr<RuntimeBehavior>>
+        behaviors;  ///< All the behaviors of the object, by their names.
+                    ///< Behaviors are the ownership of the object.
+  };
+
+  /**
+   * \brief Get the cold members, allocating them if the object had no
+   * variables and no behaviors.
+   */
+  ColdData& GetColdData() {
+    if (!coldData) coldData = gd::make_unique<ColdData>();
+    return *coldData;
+  }
+
+  /**
+   * \brief Update the list of the activated behaviors, if behaviors were
+   * added, activated or deactivated since the last update.
+   */
+  void UpdateActivatedBehaviors();
+
+  /**
+   * \brief Get the storage of the position, in the ObjectsTransforms table
+   * if the object is in one.
+   */
+  float& PositionX() { return transforms ? transforms->x[transformIndex] : X; }
+  float& PositionY() { return transforms ? transforms->y[transformIndex] : Y; }
+
+  std::size_t objectsListTypeId;  ///< Identifier of the list containing the
+                                  ///< object in its ObjInstancesHolder. Not
+                                  ///< copied by Init.
+  std::size_t objectsListIndex;   ///< Position of the object in this list.
+  ObjInstancesHolder* instancesHolder;  ///< The container of the object, if
+                                        ///< any.
+  std::size_t renderSequence;  ///< Used to render objects having the same
+                               ///< z-order in the order they were added.
+  std::size_t recyclingTypeId;  ///< Identifier of the name of the object when
+                                ///< it was added to its ObjInstancesHolder,
+                                ///< used to recycle it once deleted.
+  std::unique_ptr<ColdData> coldData;  ///< See ColdData. Not allocated for
+                                       ///< the objects without variables and
+                                       ///< behaviors.
+  mutable std::vector<Polygon2d>
+      hitBoxesCache;  ///< Used by the default GetHitBoxesRef implementation.
+  std::vector<std::pair<const gd::String*, RuntimeBehavior*>>
+      activatedBehaviors;  ///< The activated behaviors with their names, in
+                           ///< the order they are stepped.
+  bool activatedBehaviorsChanged;  ///< True if activatedBehaviors must be
+                                   ///< updated.
+  bool parallelSafePreEvents;  ///< True if all the activated behaviors can
+                               ///< be stepped in parallel before events.
+  float X;  ///< X position on the scene, only used when the object is not in
+            ///< an ObjectsTransforms table: use GetX.
+  float Y;  ///< Y position on the scene, only used when the object is not in
+            ///< an ObjectsTransforms table: use GetY.
+  ObjectsTransforms* transforms;  ///< The table storing the position of the
+                                  ///< object, if any. Not copied by Init.
+  std::size_t transformIndex;     ///< Position of the object in this table.
+  gd::MemoryAccount memoryAccount;  ///< The memory of the object, accounted
+                                    ///< in gd::SystemStats::Objects.
 };
 
 #endif  // RUNTIMEOBJECT_H
@@ -17,6 +17,82 @@ void GD_API PickOnly(RuntimeObjectsLists& pickedObjectsLists,
     if (it->second != NULL) it->second->clear();
   }
 
-  if (pickedObjectsLists[thisOne->GetName()] != NULL)
-    pickedObjectsLists[thisOne->GetName()]->push_back(thisOne);
+  auto list = pickedObjectsLists.find(thisOne->GetName());
+  if (list != pickedObjectsLists.end() && list->second != NULL)
+    list->second->push_back(thisOne);
 }
+
+namespace GDpriv {
+namespace ObjectsListsTools {
+
+std::size_t GD_API StoreListsSizes(const RuntimeObjectsLists& objectsLists,
+                                   std::size_t* listsSizes) {
+  std::size_t objectsCount = 0;
+  std::size_t i = 0;
+  for (auto it = objectsLists.begin(); it != objectsLists.end(); ++it, ++i) {
+    listsSizes[i] = it->second ? it->second->size() : 0;
+    objectsCount += listsSizes[i];
+  }
+
+  return objectsCount;
+}
+
+void GD_API TrimNotPickedObjects(const RuntimeObjectsLists& objectsLists,
+                                 const std::size_t* listsSizes,
+                                 const bool* picked) {
+  std::size_t i = 0;
+  std::size_t offset = 0;
+  for (auto it = objectsLists.begin(); it != objectsLists.end();
+       offset += listsSizes[i], ++it, ++i) {
+    if (!it->second) continue;
+    std::vector<RuntimeObject*>& arr = *it->second;
+    if (arr.size() != listsSizes[i]) continue;  // Already trimmed.
+
+    std::size_t finalSize = 0;
+    for (std::size_t k = 0; k < arr.size(); ++k) {
+      RuntimeObject* obj = arr[k];
+      if (picked[offset + k]) {
+        arr[finalSize] = obj;
+        finalSize++;
+      }
+    }
+    arr.resize(finalSize);
+  }
+}
+
+void GD_API CompareValues(const double* values,
+                          std::size_t count,
+                          RelationalOperator relationalOperator,
+                          double value,
+                          bool negate,
+                          bool* picked) {
+  switch (relationalOperator) {
+    case RelationalOperator::Equal:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] == value) != negate;
+      break;
+    case RelationalOperator::NotEqual:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] != value) != negate;
+      break;
+    case RelationalOperator::Less:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] < value) != negate;
+      break;
+    case RelationalOperator::LessOrEqual:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] <= value) != negate;
+      break;
+    case RelationalOperator::Greater:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] > value) != negate;
+      break;
+    case RelationalOperator::GreaterOrEqual:
+      for (std::size_t k = 0; k < count; ++k)
+        picked[k] = (values[k] >= value) != negate;
+      break;
+  }
+}
+
+}  // namespace ObjectsListsTools
+}  // namespace GDpriv
@@ -9,12 +9,30 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <tuple>
+#include "ObjectsSpatialHash.h"
 #include "RuntimeObject.h"
 #include "RuntimeScene.h"
+#include "ScratchArena.h"
 
 typedef std::map<gd::String, std::vector<RuntimeObject *> *>
     RuntimeObjectsLists;
 
+/**
+ * \brief The relational operators of the conditions comparing a property of
+ * objects with a value (see PickObjectsByComparison).
+ * \ingroup GameEngine
+ */
+enum class RelationalOperator {
+  Equal,
+  NotEqual,
+  Less,
+  LessOrEqual,
+  Greater,
+  GreaterOrEqual
+};
+
 /**
  * \brief Keep only the specified object in the lists of picked objects.
  * \param objectsLists The lists of objects to trim
@@ -24,10 +42,51 @@ typedef std::map<gd::String, std::vector<RuntimeObject *> *>
 void GD_API PickOnly(RuntimeObjectsLists &pickedObjectsLists,
                      RuntimeObject *thisOne);
 
+namespace GDpriv {
+namespace ObjectsListsTools {
+
+/**
+ * \brief Store in \a listsSizes the size of each list of \a objectsLists.
+ * \return The total number of objects in the lists.
+ */
+std::size_t GD_API StoreListsSizes(const RuntimeObjectsLists &objectsLists,
+                                   std::size_t *listsSizes);
+
+/**
+ * \brief Remove from the lists the objects for which the flag in \a picked is
+ * false. \a picked contains a flag for each object of the lists, in the order
+ * of the lists.
+ *
+ * Lists with a size different from the one stored in \a listsSizes are
+ * skipped, as they have already been trimmed (see TwoObjectListsTest).
+ */
+void GD_API TrimNotPickedObjects(const RuntimeObjectsLists &objectsLists,
+                                 const std::size_t *listsSizes,
+                                 const bool *picked);
+
+/**
+ * \brief Set in \a picked, for each of the \a count values, the result of the
+ * comparison of the value with \a value, negated if \a negate is true.
+ *
+ * The operator is tested once, so that each comparison loop has no branches
+ * and is vectorized by the compiler.
+ */
+void GD_API CompareValues(const double *values,
+                          std::size_t count,
+                          RelationalOperator relationalOperator,
+                          double value,
+                          bool negate,
+                          bool *picked);
+
+}  // namespace ObjectsListsTools
+}  // namespace GDpriv
+
 /**
  * \brief Filter objects to keep only the one that fullfil the predicate
  *
  * Objects that do not fullfil the predicate are removed from objects lists.
+ * The lists are compacted in place while the predicate is evaluated, so no
+ * memory is allocated.
  *
  * \param objectsLists The lists of objects to trim
  * \param negatePredicate If set to true, the result of the predicate is
@@ -43,46 +102,21 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
                    Pred predicate) {
   bool isTrue = false;
 
-  // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList;
   for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
        it != pickedObjectsLists.end();
        ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList.push_back(arr);
-  }
-
-  // Pick objects which are fulfulling the predicate.
-  std::size_t i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it, ++i) {
-    if (!it->second) continue;
-    const std::vector<RuntimeObject *> &arr1 = *it->second;
-
-    for (std::size_t k = 0; k < arr1.size(); ++k) {
-      if (negatePredicate ^ predicate(arr1[k])) {
-        pickedList[i][k] = true;
-        isTrue = true;
-      }
-    }
-  }
-
-  // Trim not picked objects from lists.
-  i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it, ++i) {
-    size_t finalSize = 0;
     if (!it->second) continue;
     std::vector<RuntimeObject *> &arr = *it->second;
 
+    // Keep objects which are fulfilling the predicate at the beginning of the
+    // list, then trim the others.
+    std::size_t finalSize = 0;
     for (std::size_t k = 0; k < arr.size(); ++k) {
       RuntimeObject *obj = arr[k];
-      if (pickedList[i][k]) {
+      if (negatePredicate ^ predicate(obj)) {
         arr[finalSize] = obj;
         finalSize++;
+        isTrue = true;
       }
     }
     arr.resize(finalSize);
@@ -91,6 +125,57 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
   return isTrue;
 }
 
+/**
+ * \brief Filter the objects to keep only the ones having a property fulfilling
+ * the comparison with \a value.
+ *
+ * Used by the conditions comparing a property that is read without a virtual
+ * call (like the position or the Z order) with a value that is the same for
+ * all the objects. The properties are first gathered in a contiguous array,
+ * then compared with the value in a single vectorized loop (see
+ * GDpriv::ObjectsListsTools::CompareValues) and the list is compacted in
+ * place, keeping the order of the objects.
+ *
+ * \param scene The scene of the objects, giving the temporary memory.
+ * \param objects The list of objects to trim.
+ * \param getProperty The function returning the property of an object.
+ * \param relationalOperator The comparison to do.
+ * \param value The value to compare the properties with.
+ * \param negateComparison If set to true, the result of the comparison is
+ * negated.
+ * \return true if at least one object fulfills the comparison.
+ *
+ * \ingroup GameEngine
+ */
+template <typename Getter>
+bool PickObjectsByComparison(RuntimeScene &scene,
+                             std::vector<RuntimeObject *> &objects,
+                             Getter getProperty,
+                             RelationalOperator relationalOperator,
+                             double value,
+                             bool negateComparison) {
+  const std::size_t count = objects.size();
+  if (count == 0) return false;
+
+  ScratchArena &arena = scene.GetScratchArena();
+  ScratchArena::Scope arenaScope(arena);
+  double *values = arena.AllocateArray<double>(count);
+  bool *picked = arena.AllocateArray<bool>(count);
+
+  for (std::size_t k = 0; k < count; ++k) values[k] = getProperty(objects[k]);
+  GDpriv::ObjectsListsTools::CompareValues(
+      values, count, relationalOperator, value, negateComparison, picked);
+
+  std::size_t finalSize = 0;
+  for (std::size_t k = 0; k < count; ++k) {
+    objects[finalSize] = objects[k];
+    finalSize += picked[k];
+  }
+  objects.resize(finalSize);
+
+  return finalSize != 0;
+}
+
 /**
  * \brief Picks objects that fullfil the predicate with at least another object.
  *
@@ -106,66 +191,71 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
  * to some lists (See *This is important* comment at the end of the algorithm,
  * when trimming the list).
  *
+ * The flags marking picked objects are allocated from the scratch arena of the
+ * scene, so that no heap allocation is made.
+ *
  * Cost (Worst case, predicate being always false):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 flags)
  *  + Cost(predicate)*NbObjList1*NbObjList2
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
  *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
  *
  * Cost (Best case, predicate being always true):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 flags)
  *  + Cost(predicate)*(NbObjList1+NbObjList2)
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Testing NbObjList1+NbObjList2 flags)
  *
  * \ingroup GameEngine
  */
 template <typename Pred>
-bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
-                        RuntimeObjectsLists objectsLists2,
+bool TwoObjectListsTest(RuntimeScene &scene,
+                        const RuntimeObjectsLists &objectsLists1,
+                        const RuntimeObjectsLists &objectsLists2,
                         bool negatePredicate,
                         Pred predicate) {
+  using namespace GDpriv::ObjectsListsTools;
   bool isTrue = false;
 
-  // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList1;
-  std::vector<std::vector<bool> > pickedList2;
+  ScratchArena &arena = scene.GetScratchArena();
+  ScratchArena::Scope arenaScope(arena);
 
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-       it != objectsLists1.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList1.push_back(arr);
-  }
-  for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-       it != objectsLists2.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList2.push_back(arr);
-  }
+  // Create a flag for each object
+  std::size_t *listsSizes1 =
+      arena.AllocateArray<std::size_t>(objectsLists1.size());
+  std::size_t *listsSizes2 =
+      arena.AllocateArray<std::size_t>(objectsLists2.size());
+  std::size_t objectsCount1 = StoreListsSizes(objectsLists1, listsSizes1);
+  std::size_t objectsCount2 = StoreListsSizes(objectsLists2, listsSizes2);
+
+  bool *pickedList1 = arena.AllocateArray<bool>(objectsCount1);
+  bool *pickedList2 = arena.AllocateArray<bool>(objectsCount2);
+  std::fill(pickedList1, pickedList1 + objectsCount1, false);
+  std::fill(pickedList2, pickedList2 + objectsCount2, false);
 
   // Launch the function each object of the first list with each object
   // of the second list.
   std::size_t i = 0;
+  std::size_t offset1 = 0;
   for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
        it != objectsLists1.end();
-       ++it, ++i) {
+       offset1 += listsSizes1[i], ++it, ++i) {
     if (!it->second) continue;
     const std::vector<RuntimeObject *> &arr1 = *it->second;
 
     for (std::size_t k = 0; k < arr1.size(); ++k) {
       bool atLeastOneObject = false;
+      bool &picked1 = pickedList1[offset1 + k];
 
       std::size_t j = 0;
+      std::size_t offset2 = 0;
       for (RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
            it2 != objectsLists2.end();
-           ++it2, ++j) {
+           offset2 += listsSizes2[j], ++it2, ++j) {
         if (!it2->second) continue;
         const std::vector<RuntimeObject *> &arr2 = *it2->second;
 
         for (std::size_t l = 0; l < arr2.size(); ++l) {
-          if (pickedList1[i][k] && pickedList2[j][l])
+          bool &picked2 = pickedList2[offset2 + l];
+          if (picked1 && picked2)
             continue;  // Avoid unnecessary costly call to functor.
 
           if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
@@ -174,8 +264,8 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
               isTrue = true;
 
               // Pick the objects
-              pickedList1[i][k] = true;
-              pickedList2[j][l] = true;
+              picked1 = true;
+              picked2 = true;
             }
 
             atLeastOneObject = true;
@@ -186,57 +276,173 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
       if (!atLeastOneObject &&
           negatePredicate) {  // The object is not overlapping any other object.
         isTrue = true;
-        pickedList1[i][k] = true;
+        picked1 = true;
       }
     }
   }
 
   // Trim not picked objects from lists.
-  i = 0;
+  TrimNotPickedObjects(objectsLists1, listsSizes1, pickedList1);
+
+  //*This is important*! We can have a list that has already been trimmed
+  // just before: the lists with a size different from the size of the
+  // list when the flags were created are skipped.
+  if (!negatePredicate)
+    TrimNotPickedObjects(objectsLists2, listsSizes2, pickedList2);
+
+  return isTrue;
+}
+
+/**
+ * \brief Same as TwoObjectListsTest, but for predicates that can only be true
+ * if the axis aligned bounding boxes of the objects are overlapping (like
+ * collision tests), or are at most \a distance apart (like tests on the
+ * distance between the centers of the objects, as the AABBs stored in the
+ * spatial hash contain the centers).
+ *
+ * The spatial hash of the scene is used to find, for each object of the first
+ * lists, the objects of the second lists that are near it, so that the
+ * predicate is only called on these candidate pairs. Objects of the lists are
+ * updated in the hash before doing the test.
+ *
+ * Cost (Worst case, predicate being always false):
+ *    Cost(Updating NbObjList1+NbObjList2 objects in the hash)
+ *  + Cost(Sorting NbObjList2 objects)
+ *  + Cost(predicate)*NbCandidatePairs
+ *
+ * \see TwoObjectListsTest
+ * \ingroup GameEngine
+ */
+template <typename Pred>
+bool TwoObjectListsOverlappingTest(RuntimeScene &scene,
+                                   const RuntimeObjectsLists &objectsLists1,
+                                   const RuntimeObjectsLists &objectsLists2,
+                                   bool negatePredicate,
+                                   Pred predicate,
+                                   float distance = 0) {
+  using namespace GDpriv::ObjectsListsTools;
+  ObjectsSpatialHash &spatialHash = scene.GetObjectsSpatialHash();
+  ScratchArena &arena = scene.GetScratchArena();
+  ScratchArena::Scope arenaScope(arena);
+
+  std::size_t *listsSizes1 =
+      arena.AllocateArray<std::size_t>(objectsLists1.size());
+  std::size_t *listsSizes2 =
+      arena.AllocateArray<std::size_t>(objectsLists2.size());
+  std::size_t objectsCount1 = StoreListsSizes(objectsLists1, listsSizes1);
+  std::size_t objectsCount2 = StoreListsSizes(objectsLists2, listsSizes2);
+
+  // For a few objects, testing all the pairs is faster.
+  if (objectsCount1 * objectsCount2 <= 64)
+    return TwoObjectListsTest(
+        scene, objectsLists1, objectsLists2, negatePredicate, predicate);
+
+  bool isTrue = false;
+
+  // Create a flag for each object
+  bool *pickedList1 = arena.AllocateArray<bool>(objectsCount1);
+  bool *pickedList2 = arena.AllocateArray<bool>(objectsCount2);
+  std::fill(pickedList1, pickedList1 + objectsCount1, false);
+  std::fill(pickedList2, pickedList2 + objectsCount2, false);
+
+  // Refresh the objects of the second lists in the hash and remember where
+  // they are in the lists (an object can be in more than one list).
+  struct ObjectPosition {
+    RuntimeObject *object;
+    std::size_t flagIndex;  // The index of the flag of the object.
+    std::size_t index;      // The index of the object in its list.
+    const std::vector<RuntimeObject *> *list;
+  };
+  auto isBefore = [](const ObjectPosition &a, const ObjectPosition &b) {
+    return a.object < b.object;
+  };
+
+  ObjectPosition *objectsPositions2 =
+      arena.AllocateArray<ObjectPosition>(objectsCount2);
+  std::size_t positionsCount2 = 0;
+  std::size_t j = 0;
+  std::size_t offset2 = 0;
+  for (RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
+       it2 != objectsLists2.end();
+       offset2 += listsSizes2[j], ++it2, ++j) {
+    if (!it2->second) continue;
+    const std::vector<RuntimeObject *> &arr2 = *it2->second;
+
+    for (std::size_t l = 0; l < arr2.size(); ++l) {
+      spatialHash.Update(arr2[l]);
+      objectsPositions2[positionsCount2++] =
+          ObjectPosition{arr2[l], offset2 + l, l, &arr2};
+    }
+  }
+  ObjectPosition *objectsPositions2End = objectsPositions2 + positionsCount2;
+  std::sort(objectsPositions2, objectsPositions2End, isBefore);
+
+  // Launch the function on each object of the first list with each object
+  // of the second list that is near enough.
+  std::size_t i = 0;
+  std::size_t offset1 = 0;
   for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
        it != objectsLists1.end();
-       ++it, ++i) {
-    size_t finalSize = 0;
+       offset1 += listsSizes1[i], ++it, ++i) {
     if (!it->second) continue;
-    std::vector<RuntimeObject *> &arr = *it->second;
+    const std::vector<RuntimeObject *> &arr1 = *it->second;
 
-    for (std::size_t k = 0; k < arr.size(); ++k) {
-      RuntimeObject *obj = arr[k];
-      if (pickedList1[i][k]) {
-        arr[finalSize] = obj;
-        finalSize++;
-      }
-    }
-    arr.resize(finalSize);
-  }
+    for (std::size_t k = 0; k < arr1.size(); ++k) {
+      bool atLeastOneObject = false;
+      bool &picked1 = pickedList1[offset1 + k];
+
+      // Enlarge the AABB by a pixel to be sure to get objects with edges
+      // touching the object.
+      sf::FloatRect area = spatialHash.Update(arr1[k]);
+      area.left -= 1 + distance;
+      area.top -= 1 + distance;
+      area.width += 2 * (1 + distance);
+      area.height += 2 * (1 + distance);
+
+      spatialHash.ForEachObjectInAABB(area, [&](RuntimeObject *candidate) {
+        auto range = std::equal_range(objectsPositions2,
+                                      objectsPositions2End,
+                                      ObjectPosition{candidate, 0, 0, NULL},
+                                      isBefore);
+
+        for (auto position = range.first; position != range.second;
+             ++position) {
+          bool &picked2 = pickedList2[position->flagIndex];
+          if (picked1 && picked2)
+            continue;  // Avoid unnecessary costly call to functor.
+
+          // Same check as TwoObjectListsTest: only skip an object tested
+          // against itself when the same list is in both lists of lists.
+          if (position->list == &arr1 && position->index == k) continue;
 
-  if (!negatePredicate) {
-    std::size_t i = 0;
-    for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-         it != objectsLists2.end();
-         ++it, ++i) {
-      size_t finalSize = 0;
-      if (!it->second) continue;
-      std::vector<RuntimeObject *> &arr = *it->second;
-
-      //*This is important*! We can have a list that has already been trimmed
-      // just before
-      if (arr.size() !=
-          pickedList2[i].size())  // If the size of the objects list != size of
-                                  // the boolean "picked" list...
-        continue;  //... then the object list was already trimmed, skip it.
-
-      for (std::size_t k = 0; k < arr.size(); ++k) {
-        RuntimeObject *obj = arr[k];
-        if (pickedList2[i][k]) {
-          arr[finalSize] = obj;
-          finalSize++;
+          if (predicate(arr1[k], candidate)) {
+            if (!negatePredicate) {
+              isTrue = true;
+
+              // Pick the objects
+              picked1 = true;
+              picked2 = true;
+            }
+
+            atLeastOneObject = true;
+          }
         }
+      });
+
+      if (!atLeastOneObject &&
+          negatePredicate) {  // The object is not overlapping any other object.
+        isTrue = true;
+        picked1 = true;
       }
-      arr.resize(finalSize);
     }
   }
 
+  // Trim not picked objects from lists, skipping lists already trimmed just
+  // before (see TwoObjectListsTest).
+  TrimNotPickedObjects(objectsLists1, listsSizes1, pickedList1);
+  if (!negatePredicate)
+    TrimNotPickedObjects(objectsLists2, listsSizes2, pickedList2);
+
   return isTrue;
 }
 #endif
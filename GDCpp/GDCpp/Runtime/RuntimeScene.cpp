@@ -13,7 +13,9 @@
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedData.h"
 #include "GDCpp/Runtime/FontManager.h"
+#include "GDCpp/Runtime/FrameProfilerStream.h"
 #include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/InputRecording.h"
 #include "GDCpp/Runtime/ManualTimer.h"
 #include "GDCpp/Runtime/Project/BehaviorsSharedData.h"
 #include "GDCpp/Runtime/Project/InitialInstance.h"
@@ -26,6 +28,7 @@
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeObjectHelpers.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
 #include "GDCpp/Runtime/SoundManager.h"
 #include "GDCpp/Runtime/profile.h"
 #if !defined(ANDROID)  // TODO: OpenGL
@@ -45,6 +48,11 @@
 #include "GDCpp/Extensions/ExtensionBase.h"
 #undef GetObject  // Disable an annoying macro
 
+namespace {
+// The objects of the streamed instances created at each frame at most.
+const std::size_t maximumStreamedObjectsPerFrame = 200;
+}  // namespace
+
 RuntimeLayer RuntimeScene::badRuntimeLayer;
 
 RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
@@ -55,6 +63,9 @@ RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
 #endif
       isFullScreen(false),
       inputManager(renderWindow_),
+      inputRecording(nullptr),
+      frameProfilerStream(nullptr),
+      framePacingEnabled(false),
       codeExecutionEngine(new CodeExecutionEngine) {
   ChangeRenderWindow(renderWindow);
 }
@@ -69,6 +80,8 @@ RuntimeScene::~RuntimeScene() {
       extension->SceneUnloaded(*this);
   }
 
+  objectsSpatialHash.Clear();
+  preparedInstances.clear();
   objectsInstances.Clear();  // Force destroy objects NOW as they can have
                              // pointers to some RuntimeScene members which so
                              // need to be destroyed AFTER objects.
@@ -87,13 +100,24 @@ void RuntimeScene::ChangeRenderWindow(sf::RenderWindow* newWindow) {
   renderWindow->setTitle(GetWindowDefaultTitle());
 
   if (game) {
-    renderWindow->setFramerateLimit(game->GetMaximumFPS());
+    // The frame pacer waits before the frame, instead of the window after it.
+    renderWindow->setFramerateLimit(
+        framePacingEnabled ? 0 : game->GetMaximumFPS());
     renderWindow->setVerticalSyncEnabled(
+        !framePacingEnabled &&
         game->IsVerticalSynchronizationEnabledByDefault());
   }
   SetupOpenGLProjection();
 }
 
+void RuntimeScene::EnableFramePacing(bool enable) {
+  if (framePacingEnabled == enable) return;
+
+  framePacingEnabled = enable;
+  framePacer = FramePacer();
+  if (renderWindow) ChangeRenderWindow(renderWindow);
+}
+
 void RuntimeScene::SetupOpenGLProjection() {
 #if !defined(ANDROID)  // TODO: OpenGL
   glEnable(GL_DEPTH_TEST);
@@ -117,12 +141,74 @@ void RuntimeScene::RequestChange(SceneChange::Change change,
   requestedChange.requestedScene = sceneName;
 }
 
-bool RuntimeScene::RenderAndStep() {
+void RuntimeScene::EnableFrameProfiler(bool enable,
+                                       std::size_t framesCapacity) {
+  if (enable)
+    frameProfiler.reset(new FrameProfiler(framesCapacity));
+  else
+    frameProfiler.reset();
+}
+
+bool RuntimeScene::RenderAndStep() { return StepFrame(true, 0); }
+
+bool RuntimeScene::StepWithoutRender(signed long long elapsedTime) {
+  return StepFrame(false, elapsedTime);
+}
+
+void RuntimeScene::StartInputRecording(InputRecording& recording) {
+  randomGenerator.Seed(recording.GetRandomSeed());
+  inputRecording = &recording;
+}
+
+std::size_t RuntimeScene::ReplayInputRecording(
+    const InputRecording& recording) {
+  randomGenerator.Seed(recording.GetRandomSeed());
+
+  std::size_t framesCount = 0;
+  for (const InputRecording::Frame& frame : recording.GetFrames()) {
+    inputManager.NextFrame();
+    for (sf::Event event : frame.events) inputManager.HandleEvent(event);
+
+    ++framesCount;
+    if (StepFrame(false, frame.elapsedTime)) break;
+  }
+
+  return framesCount;
+}
+
+bool RuntimeScene::StepFrame(bool render, signed long long elapsedTime) {
+  FrameProfiler* profiler = frameProfiler.get();
+  if (profiler) profiler->BeginFrame();
+
   requestedChange.change = SceneChange::CONTINUE;
-  ManageRenderTargetEvents();
-  timeManager.Update(clock.restart().asMicroseconds(), game->GetMinimumFPS());
-  ManageObjectsBeforeEvents();
-  if (game) game->GetSoundManager().ManageGarbage();
+  if (render) {
+    // Wait for the deadline of the frame before polling the input, so that
+    // the frame uses the latest input.
+    if (framePacingEnabled) {
+      framePacer.SetTargetFPS(game ? game->GetMaximumFPS() : 0);
+      framePacer.BeginFrame();
+    }
+
+    FrameProfiler::PhaseTimer timer(profiler,
+                                    FrameProfiler::RenderTargetEvents);
+    ManageRenderTargetEvents();
+    elapsedTime = clock.restart().asMicroseconds();
+    if (framePacingEnabled && framePacer.GetLastFrameTime() > 0)
+      elapsedTime = framePacer.GetLastFrameTime();
+  }
+  if (inputRecording) inputRecording->EndFrame(elapsedTime);
+  timeManager.Update(elapsedTime, game->GetMinimumFPS());
+  {
+    FrameProfiler::PhaseTimer timer(profiler,
+                                    FrameProfiler::ObjectsBeforeEvents);
+    UpdateInstancesStreamer(maximumStreamedObjectsPerFrame);
+    ManageObjectsBeforeEvents();
+    extensionsDatas.PreEvents(*this);
+  }
+  if (render) {
+    FrameProfiler::PhaseTimer timer(profiler, FrameProfiler::SoundsGarbage);
+    if (game) game->GetSoundManager().ManageGarbage();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler()) {
@@ -131,7 +217,10 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
-  GetCodeExecutionEngine()->Execute();
+  {
+    FrameProfiler::PhaseTimer timer(profiler, FrameProfiler::Events);
+    GetCodeExecutionEngine()->Execute();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler() && GetProfiler()->profilingActivated) {
@@ -141,14 +230,22 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
-  ManageObjectsAfterEvents();
+  {
+    FrameProfiler::PhaseTimer timer(profiler,
+                                    FrameProfiler::ObjectsAfterEvents);
+    ManageObjectsAfterEvents();
+    extensionsDatas.PostEvents(*this);
+  }
 
 #if defined(GD_IDE_ONLY)
-  if (debugger) debugger->Update();
+  if (debugger) debugger->Update(*this);
 #endif
 
   // Rendering
-  Render();
+  if (render) {
+    FrameProfiler::PhaseTimer timer(profiler, FrameProfiler::Rendering);
+    Render();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler() && GetProfiler()->profilingActivated) {
@@ -161,6 +258,11 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
+  scratchArena.Reset();
+  GetCodeExecutionEngine()->runtimeContext.ResetFrameObjectsLists();
+  if (render && framePacingEnabled) framePacer.EndFrame();
+  if (profiler) profiler->EndFrame();
+  if (frameProfilerStream) frameProfilerStream->Update(*this);
   return requestedChange.change != SceneChange::CONTINUE;
 }
 
@@ -181,6 +283,7 @@ void RuntimeScene::ManageRenderTargetEvents() {
       // Most events will be input related and should be forwarded
       // to the InputManager:
       inputManager.HandleEvent(event);
+      if (inputRecording) inputRecording->AddEvent(event);
     }
   }
 }
@@ -190,7 +293,7 @@ void RuntimeScene::RenderWithoutStep() {
   Render();
 
 #if defined(GD_IDE_ONLY)
-  if (debugger) debugger->Update();
+  if (debugger) debugger->Update(*this);
 #endif
 }
 
@@ -201,10 +304,6 @@ void RuntimeScene::Render() {
                                 GetBackgroundColorGreen(),
                                 GetBackgroundColorBlue()));
 
-  // Sort object by order to render them
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  OrderObjectsByZOrder(allObjects);
-
 #if !defined(ANDROID)  // TODO: OpenGL
   // To allow using OpenGL to draw:
   glClear(GL_DEPTH_BUFFER_BIT);  // Clear the depth buffer
@@ -212,9 +311,25 @@ void RuntimeScene::Render() {
 #endif
   renderWindow->setActive();
 
+  std::size_t drawnObjectsCount = 0;
+  std::size_t culledObjectsCount = 0;
+
   // Draw layer by layer
   for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
     if (layers[layerIndex].GetVisibility()) {
+      // Objects of the layer are kept sorted by z-order by objectsInstances.
+      const RuntimeObjNonOwningPtrList& layerObjects =
+          objectsInstances.GetLayerObjectsSortedByZOrder(
+              layers[layerIndex].GetInternedName());
+
+      // Cached layers are rendered in their texture only when their objects
+      // are modified.
+      bool drawCache = false;
+      if (layers[layerIndex].IsCached()) {
+        drawCache = layers[layerIndex].UpdateCache(layerObjects, spriteBatch);
+        renderWindow->setActive();
+      }
+
       for (std::size_t cameraIndex = 0;
            cameraIndex < layers[layerIndex].GetCameraCount();
            ++cameraIndex) {
@@ -248,11 +363,26 @@ void RuntimeScene::Render() {
         // Prepare SFML rendering
         renderWindow->setView(camera.GetSFMLView());
 
-        // Rendering all objects
-        for (std::size_t id = 0; id < allObjects.size(); ++id) {
-          if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-            allObjects[id]->Draw(*renderWindow);
+        if (drawCache) {
+          layers[layerIndex].DrawCache(*renderWindow);
+          continue;
+        }
+
+        // Rendering the objects of the layer visible by the camera, batching
+        // consecutive sprites
+        sf::FloatRect visibleArea = camera.GetVisibleArea();
+        for (RuntimeObject* object : layerObjects) {
+          if (object->CanBeCulled() &&
+              !ObjectsSpatialHash::AreOverlapping(object->GetAABB(),
+                                                  visibleArea)) {
+            culledObjectsCount++;
+            continue;
+          }
+
+          object->DrawBatched(*renderWindow, spriteBatch);
+          drawnObjectsCount++;
         }
+        spriteBatch.Flush(*renderWindow);
       }
     }
   }
@@ -263,6 +393,13 @@ void RuntimeScene::Render() {
   renderWindow->popGLStates();
 #endif
   renderWindow->display();
+
+#if defined(GD_IDE_ONLY)
+  if (GetProfiler() && GetProfiler()->profilingActivated) {
+    GetProfiler()->lastDrawnObjectsCount = drawnObjectsCount;
+    GetProfiler()->lastCulledObjectsCount = culledObjectsCount;
+  }
+#endif
 }
 
 bool RuntimeScene::OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList) {
@@ -283,57 +420,114 @@ bool RuntimeScene::OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList) {
 }
 
 RuntimeLayer& RuntimeScene::GetRuntimeLayer(const gd::String& name) {
-  for (RuntimeLayer& layer : layers) {
-    if (layer.GetName() == name) return layer;
-  }
-
-  return badRuntimeLayer;
+  auto it = layersIndex.find(name);
+  return it != layersIndex.end() ? layers[it->second] : badRuntimeLayer;
 }
 
 const RuntimeLayer& RuntimeScene::GetRuntimeLayer(
     const gd::String& name) const {
-  for (const RuntimeLayer& layer : layers) {
-    if (layer.GetName() == name) return layer;
-  }
+  auto it = layersIndex.find(name);
+  return it != layersIndex.end() ? layers[it->second] : badRuntimeLayer;
+}
+
+RuntimeLayer& RuntimeScene::GetRuntimeLayer(const InternedString& name) {
+  auto it = internedLayersIndex.find(name);
+  return it != internedLayersIndex.end() ? layers[it->second]
+                                         : badRuntimeLayer;
+}
+
+const RuntimeLayer& RuntimeScene::GetRuntimeLayer(
+    const InternedString& name) const {
+  auto it = internedLayersIndex.find(name);
+  return it != internedLayersIndex.end() ? layers[it->second]
+                                         : badRuntimeLayer;
+}
 
-  return badRuntimeLayer;
+std::size_t RuntimeScene::GetRuntimeLayerPosition(
+    const InternedString& name) const {
+  auto it = internedLayersIndex.find(name);
+  return it != internedLayersIndex.end() ? it->second : gd::String::npos;
+}
+
+void RuntimeScene::UpdateInstancesStreamer(std::size_t maximumCreatedObjects) {
+  if (!instancesStreamer.IsEnabled()) return;
+
+  const RuntimeLayer& baseLayer = GetRuntimeLayer("");
+  if (baseLayer.GetCameraCount() == 0) return;
+
+  const sf::Vector2f& center = baseLayer.GetCamera(0).GetViewCenter();
+  instancesStreamer.Update(*this, center.x, center.y, maximumCreatedObjects);
 }
 
 void RuntimeScene::ManageObjectsAfterEvents() {
   // Delete objects that were removed.
   RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
   for (std::size_t id = 0; id < allObjects.size(); ++id) {
-    if (allObjects[id]->GetName().empty()) {
-      for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
-           ++i)
-        extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(
-            *this, allObjects[id]);
-
-      objectsInstances.RemoveObject(
-          allObjects[id]);  // Remove from objects instances, not from the
-                            // temporary list!
-    }
+    if (allObjects[id]->GetName().empty())
+      RemoveObject(allObjects[id]);  // Remove from objects instances, not from
+                                     // the temporary list!
   }
 
-  // Update objects positions, forces and behaviors
+  // Update objects positions, forces and behaviors. When all the layers have
+  // the same time scale, objects are all moved at once by the table storing
+  // their positions.
   allObjects = objectsInstances.GetAllObjects();
+  bool sameTimeScale = true;
+  for (RuntimeLayer& layer : layers)
+    sameTimeScale &= layer.GetTimeScale() == badRuntimeLayer.GetTimeScale();
+  if (sameTimeScale) {
+    objectsInstances.GetTransforms().ApplyForces(
+        static_cast<double>(badRuntimeLayer.GetElapsedTime(*this)) /
+        1000000.0);
+  } else {
+    for (RuntimeObject* object : allObjects) {
+      double elapsedTimeInSeconds =
+          static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0;
+      object->SetX(object->GetX() +
+                   (object->TotalForceX() * elapsedTimeInSeconds));
+      object->SetY(object->GetY() +
+                   (object->TotalForceY() * elapsedTimeInSeconds));
+    }
+  }
+
   for (RuntimeObject* object : allObjects) {
     double elapsedTimeInSeconds =
         static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0;
-    object->SetX(object->GetX() +
-                 (object->TotalForceX() * elapsedTimeInSeconds));
-    object->SetY(object->GetY() +
-                 (object->TotalForceY() * elapsedTimeInSeconds));
     object->Update(*this);
     object->UpdateForce(elapsedTimeInSeconds);
     object->DoBehaviorsPostEvents(*this);
+
+    // Objects are only moved in the hash if they changed of cells.
+    objectsSpatialHash.Update(object);
   }
 }
 
 void RuntimeScene::ManageObjectsBeforeEvents() {
   RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  for (std::size_t id = 0; id < allObjects.size(); ++id)
-    allObjects[id]->DoBehaviorsPreEvents(*this);
+  // The time of behaviors is recorded by the profiler from a single thread.
+  if (!game || GetFrameProfiler()) {
+    for (std::size_t id = 0; id < allObjects.size(); ++id)
+      allObjects[id]->DoBehaviorsPreEvents(*this);
+    return;
+  }
+
+  // Objects having only parallel-safe behaviors are stepped after the others,
+  // on the threads of the game.
+  parallelPreEventsObjects.clear();
+  for (std::size_t id = 0; id < allObjects.size(); ++id) {
+    if (allObjects[id]->CanDoBehaviorsPreEventsInParallel())
+      parallelPreEventsObjects.push_back(allObjects[id]);
+    else
+      allObjects[id]->DoBehaviorsPreEvents(*this);
+  }
+
+  game->GetJobSystem().ParallelFor(
+      parallelPreEventsObjects.size(),
+      64,
+      [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          parallelPreEventsObjects[i]->DoBehaviorsPreEvents(*this);
+      });
 }
 
 /**
@@ -349,44 +543,7 @@ class ObjectsFromInitialInstanceCreator : public gd::InitialInstanceFunctor {
   virtual ~ObjectsFromInitialInstanceCreator(){};
 
   virtual void operator()(gd::InitialInstance& instance) {
-    std::vector<ObjSPtr>::const_iterator sceneObject =
-        std::find_if(scene.GetObjects().begin(),
-                     scene.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-    std::vector<ObjSPtr>::const_iterator globalObject =
-        std::find_if(game.GetObjects().begin(),
-                     game.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-
-    RuntimeObjSPtr newObject;
-
-    if (sceneObject !=
-        scene.GetObjects().end())  // We check first scene's objects' list.
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
-    else if (globalObject !=
-             scene.game->GetObjects().end())  // Then the global object list
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
-
-    if (newObject != std::unique_ptr<RuntimeObject>()) {
-      newObject->SetX(instance.GetX() + xOffset);
-      newObject->SetY(instance.GetY() + yOffset);
-      newObject->SetZOrder(instance.GetZOrder());
-      newObject->SetLayer(instance.GetLayer());
-      newObject->ExtraInitializationFromInitialInstance(instance);
-      newObject->SetAngle(instance.GetAngle());
-
-      if (instance.HasCustomSize()) {
-        newObject->SetWidth(instance.GetCustomWidth());
-        newObject->SetHeight(instance.GetCustomHeight());
-      }
-
-      // Substitute initial variables specific to that object instance.
-      newObject->GetVariables().Merge(instance.GetVariables());
-
-      scene.objectsInstances.AddObject(std::move(newObject));
-    } else
-      std::cout << "Could not find and put object " << instance.GetObjectName()
-                << std::endl;
+    scene.CreateObjectFromInitialInstance(instance, xOffset, yOffset);
   }
 
  private:
@@ -405,6 +562,176 @@ void RuntimeScene::CreateObjectsFrom(
       func);
 }
 
+void RuntimeScene::RemoveObject(RuntimeObject* object) {
+  for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
+       ++i)
+    extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(*this,
+                                                                      object);
+
+  objectsSpatialHash.Remove(object);
+  instancesStreamer.ObjectDeleted(object);
+  objectsInstances.RemoveObject(object);
+}
+
+RuntimeObjSPtr RuntimeScene::CreateObjectNamed(const gd::String& name) {
+  std::vector<ObjSPtr>::const_iterator sceneObject =
+      std::find_if(GetObjects().begin(),
+                   GetObjects().end(),
+                   std::bind2nd(ObjectHasName(), name));
+  std::vector<ObjSPtr>::const_iterator globalObject =
+      std::find_if(game->GetObjects().begin(),
+                   game->GetObjects().end(),
+                   std::bind2nd(ObjectHasName(), name));
+
+  RuntimeObjSPtr newObject;
+
+  // We check first scene's objects' list, then the global object list.
+  if (sceneObject != GetObjects().end())
+    newObject = objectsInstances.CreateObject(*this, **sceneObject);
+  else if (globalObject != game->GetObjects().end())
+    newObject = objectsInstances.CreateObject(*this, **globalObject);
+
+  return newObject;
+}
+
+namespace {
+const char snapshotMagic[] = "GDSS";
+const std::uint64_t snapshotVersion = 2;
+}
+
+void RuntimeScene::TakeSnapshot(std::string& snapshot) {
+  snapshot.assign(snapshotMagic, 4);
+  SceneSnapshotWriter writer(snapshot);
+  writer.WriteUInt(snapshotVersion);
+  timeManager.SaveState(writer);
+  for (std::uint64_t s : randomGenerator.GetState().s) writer.WriteUInt(s);
+  writer.WriteVariables(variables);
+
+  // Objects deleted during the events (having no name) are not written.
+  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
+  allObjects.erase(std::remove_if(allObjects.begin(),
+                                  allObjects.end(),
+                                  [](RuntimeObject* object) {
+                                    return object->GetName().empty();
+                                  }),
+                   allObjects.end());
+
+  writer.WriteUInt(allObjects.size());
+  for (RuntimeObject* object : allObjects) {
+    writer.WriteString(object->GetName());
+    std::size_t block = writer.BeginBlock();
+    object->SaveState(writer);
+    writer.EndBlock(block);
+  }
+}
+
+bool RuntimeScene::RestoreSnapshot(const std::string& snapshot) {
+  if (snapshot.size() < 4 || snapshot.compare(0, 4, snapshotMagic, 4) != 0)
+    return false;
+
+  SceneSnapshotReader reader(snapshot.data() + 4, snapshot.size() - 4);
+  if (reader.ReadUInt() != snapshotVersion) return false;
+
+  timeManager.RestoreState(reader);
+  RandomGenerator::State randomState;
+  for (std::uint64_t& s : randomState.s) s = reader.ReadUInt();
+  randomGenerator.SetState(randomState);
+  reader.ReadVariables(variables);
+
+  // For each name, the objects of the scene and the number of them reused.
+  std::unordered_map<gd::String,
+                     std::pair<RuntimeObjNonOwningPtrList, std::size_t>>
+      sceneObjects;
+  std::uint64_t count = reader.ReadUInt();
+  for (std::uint64_t i = 0; i < count && reader.IsValid(); ++i) {
+    gd::String name = reader.ReadString();
+    SceneSnapshotReader objectReader = reader.ReadBlock();
+    if (!reader.IsValid()) break;
+
+    auto it = sceneObjects.find(name);
+    if (it == sceneObjects.end())
+      it = sceneObjects
+               .emplace(name,
+                        std::make_pair(
+                            objectsInstances.GetObjectsRawPointers(name), 0))
+               .first;
+
+    RuntimeObjNonOwningPtrList& objects = it->second.first;
+    std::size_t& reusedCount = it->second.second;
+    RuntimeObject* object = nullptr;
+    if (reusedCount < objects.size()) {
+      object = objects[reusedCount++];
+    } else {
+      RuntimeObjSPtr newObject = CreateObjectNamed(name);
+      if (!newObject) continue;
+      object = objectsInstances.AddObject(std::move(newObject));
+    }
+
+    object->RestoreState(objectReader);
+    objectsSpatialHash.Update(object);
+  }
+
+  // Delete the objects that were not reused.
+  for (RuntimeObject* object : objectsInstances.GetAllObjects()) {
+    if (sceneObjects.find(object->GetName()) == sceneObjects.end())
+      RemoveObject(object);
+  }
+  for (auto& it : sceneObjects) {
+    RuntimeObjNonOwningPtrList& objects = it.second.first;
+    for (std::size_t i = it.second.second; i < objects.size(); ++i)
+      RemoveObject(objects[i]);
+  }
+
+  return reader.IsValid();
+}
+
+void RuntimeScene::CreateObjectsFromPreparedInstances(
+    const gd::InitialInstancesContainer& container,
+    float xOffset,
+    float yOffset) {
+  std::unique_ptr<PreparedInstances>& prepared = preparedInstances[&container];
+  if (!prepared)
+    prepared = gd::make_unique<PreparedInstances>(*this, container);
+
+  prepared->CreateObjects(*this, xOffset, yOffset);
+}
+
+RuntimeObject* RuntimeScene::CreateObjectFromInitialInstance(
+    const gd::InitialInstance& instance, float xOffset, float yOffset) {
+  RuntimeObjSPtr newObject =
+      PrepareObjectFromInitialInstance(instance, xOffset, yOffset);
+  if (!newObject) return nullptr;
+
+  return objectsInstances.AddObject(std::move(newObject));
+}
+
+RuntimeObjSPtr RuntimeScene::PrepareObjectFromInitialInstance(
+    const gd::InitialInstance& instance, float xOffset, float yOffset) {
+  RuntimeObjSPtr newObject = CreateObjectNamed(instance.GetObjectName());
+  if (newObject == std::unique_ptr<RuntimeObject>()) {
+    std::cout << "Could not find and put object " << instance.GetObjectName()
+              << std::endl;
+    return nullptr;
+  }
+
+  newObject->SetX(instance.GetX() + xOffset);
+  newObject->SetY(instance.GetY() + yOffset);
+  newObject->SetZOrder(instance.GetZOrder());
+  newObject->SetLayer(instance.GetLayer());
+  newObject->ExtraInitializationFromInitialInstance(instance);
+  newObject->SetAngle(instance.GetAngle());
+
+  if (instance.HasCustomSize()) {
+    newObject->SetWidth(instance.GetCustomWidth());
+    newObject->SetHeight(instance.GetCustomHeight());
+  }
+
+  // Substitute initial variables specific to that object instance.
+  newObject->GetVariables().Merge(instance.GetVariables());
+
+  return newObject;
+}
+
 bool RuntimeScene::LoadFromScene(const gd::Layout& scene) {
   return LoadFromSceneAndCustomInstances(scene, scene.GetInitialInstances());
 }
@@ -423,7 +750,9 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
   Scene::operator=(scene);
 
   // Clear RuntimeScene datas
+  objectsSpatialHash.Clear();
   objectsInstances.Clear();
+  objectsInstances.SetKeepObjectsOrder(KeepObjectsOrder());
   timeManager.Reset();
 
   std::cout << ".";
@@ -444,9 +773,38 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
     layers.push_back(RuntimeLayer(GetLayer(i), defaultView));
   }
 
-  // Create object instances which are originally positioned on scene
+  // The first layer with a name is found, like with a linear search.
+  layersIndex.clear();
+  internedLayersIndex.clear();
+  for (std::size_t i = layers.size(); i-- > 0;) {
+    layersIndex[layers[i].GetName()] = i;
+    internedLayersIndex[layers[i].GetInternedName()] = i;
+  }
+
+  // Resolve the identifiers of the objects lists once for all.
+  std::cout << ".";
+  for (std::size_t i = 0; i < game->GetObjectsCount(); ++i)
+    objectsInstances.AddObjectsList(
+        ObjInstancesHolder::GetObjectTypeId(game->GetObject(i).GetName()));
+  for (std::size_t i = 0; i < GetObjectsCount(); ++i)
+    objectsInstances.AddObjectsList(
+        ObjInstancesHolder::GetObjectTypeId(GetObject(i).GetName()));
+
+  // Create object instances which are originally positioned on scene, or
+  // only the ones near the camera if they are streamed.
   std::cout << ".";
-  CreateObjectsFrom(instances);
+  instancesStreamer.Clear();
+  preparedInstances.clear();
+  if (GetStreamingChunkSize() > 0) {
+    // The streamer keeps pointers to the instances: they must be owned by
+    // the scene.
+    if (&instances != &scene.GetInitialInstances())
+      GetInitialInstances() = instances;
+    instancesStreamer.Load(
+        GetInitialInstances(), GetStreamingChunkSize(), GetStreamingRadius());
+    UpdateInstancesStreamer(0);
+  } else
+    CreateObjectsFrom(instances);
 
   // Behaviors shared data
   std::cout << ".";
@@ -10,13 +10,23 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedDataHolder.h"
+#include "GDCpp/Runtime/FramePacer.h"
+#include "GDCpp/Runtime/FrameProfiler.h"
 #include "GDCpp/Runtime/InputManager.h"
+#include "GDCpp/Runtime/InstancesStreamer.h"
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
+#include "GDCpp/Runtime/PreparedInstances.h"
 #include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/RandomGenerator.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+#include "GDCpp/Runtime/ScratchArena.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "GDCpp/Runtime/TimeManager.h"
 namespace sf {
 class RenderWindow;
@@ -29,6 +39,8 @@ class ImageManager;
 }
 class RuntimeLayer;
 class RuntimeGame;
+class InputRecording;
+class FrameProfilerStream;
 class BehaviorsRuntimeSharedData;
 class ExtensionBase;
 class CodeExecutionEngine;
@@ -102,6 +114,84 @@ class GD_API RuntimeScene : public Scene {
    */
   TimeManager& GetTimeManager() { return timeManager; }
 
+  /**
+   * \brief Get the spatial hash containing the objects of the scene, used as
+   * a broadphase by collision conditions.
+   *
+   * \note Objects are refreshed in the hash at the end of each frame. Call
+   * ObjectsSpatialHash::Update on objects before querying the hash if their
+   * position may have changed during the frame.
+   */
+  ObjectsSpatialHash& GetObjectsSpatialHash() { return objectsSpatialHash; }
+
+  /**
+   * \brief Get the arena used to allocate temporary buffers during the frame
+   * (for example by functions picking objects).
+   *
+   * \note The arena is reset at the end of each frame.
+   */
+  ScratchArena& GetScratchArena() { return scratchArena; }
+
+  /**
+   * \brief Start or stop recording the time spent in each phase of the
+   * frames, and by the behaviors.
+   * \param framesCapacity The number of frames records to be kept.
+   * \note Stopping the profiler destroys its records.
+   */
+  void EnableFrameProfiler(bool enable = true,
+                           std::size_t framesCapacity = 600);
+
+  /**
+   * \brief Get the profiler recording the frames of the scene.
+   * \return NULL if the profiler is not enabled.
+   */
+  FrameProfiler* GetFrameProfiler() { return frameProfiler.get(); }
+
+  /**
+   * \brief Send the frames recorded by the frame profiler to a remote
+   * profiler, with \a stream (NULL to stop).
+   * \note The stream must be kept alive until it's removed from the scene.
+   * \see EnableFrameProfiler
+   */
+  void SetFrameProfilerStream(FrameProfilerStream* stream) {
+    frameProfilerStream = stream;
+  }
+
+  /**
+   * \brief Enable or disable the pacing of the frames by the scene, instead
+   * of by the framerate limit or the vertical synchronization of the window.
+   *
+   * When enabled, RenderAndStep waits for the deadline of the frame (computed
+   * from the maximum FPS of the game) before polling the input, so that the
+   * input is as recent as possible when the frame is updated and rendered,
+   * and the time elapsed is the one between the deadlines of the frames. The
+   * framerate limit and the vertical synchronization of the window are
+   * disabled, as they would wait after the rendering.
+   *
+   * \see FramePacer
+   */
+  void EnableFramePacing(bool enable = true);
+
+  /**
+   * \brief Return true if the frames are paced by the scene.
+   */
+  bool IsFramePacingEnabled() const { return framePacingEnabled; }
+
+  /**
+   * \brief Get the frame pacer, recording the times of the frames when the
+   * frame pacing is enabled (see FramePacer::GetStatistics).
+   */
+  const FramePacer& GetFramePacer() const { return framePacer; }
+
+  /**
+   * \brief Get the generator of the random numbers of the scene.
+   *
+   * It is seeded with the seed of the input recording when one is started or
+   * replayed, and its state is saved in the snapshots of the scene, so that
+   * the same numbers are generated again.
+   */
+  RandomGenerator& GetRandomGenerator() { return randomGenerator; }
+
   /**
    * Get the layer with specified name.
    */
@@ -112,6 +202,23 @@ class GD_API RuntimeScene : public Scene {
    */
   const RuntimeLayer& GetRuntimeLayer(const gd::String& name) const;
 
+  /**
+   * Get the layer with specified interned name.
+   */
+  RuntimeLayer& GetRuntimeLayer(const InternedString& name);
+
+  /**
+   * Get the layer with specified interned name.
+   */
+  const RuntimeLayer& GetRuntimeLayer(const InternedString& name) const;
+
+  /**
+   * \brief Return the position of the layer in the scene (layers with a
+   * greater position are displayed above), or gd::String::npos if the layer
+   * does not exist.
+   */
+  std::size_t GetRuntimeLayerPosition(const InternedString& name) const;
+
   /**
    * \brief Return the shared data for a behavior.
    * \warning Be careful, no check is made to ensure that the shared data exist.
@@ -122,6 +229,55 @@ class GD_API RuntimeScene : public Scene {
     return behaviorsSharedDatas.GetBehaviorSharedData(behaviorName);
   }
 
+  /**
+   * \brief Return the index of the slot of the shared data for a behavior, to
+   * be used with GetBehaviorSharedData, or gd::String::npos if the behavior
+   * has no shared data.
+   *
+   * \see BehaviorsRuntimeSharedDataHolder::GetBehaviorSharedDataIndex
+   */
+  std::size_t GetBehaviorSharedDataIndex(const gd::String& behaviorName) const {
+    return behaviorsSharedDatas.GetBehaviorSharedDataIndex(behaviorName);
+  }
+
+  /**
+   * \brief Return the shared data of type T stored in the slot at the given
+   * index, without taking ownership of it.
+   * \warning No check is made to ensure that the index and the type are valid.
+   */
+  template <class T>
+  T* GetBehaviorSharedData(std::size_t index) const {
+    return behaviorsSharedDatas.GetBehaviorSharedData<T>(index);
+  }
+
+  /**
+   * \brief Return the shared data of type T for a behavior, without taking
+   * ownership of it, or nullptr if the behavior has no shared data.
+   */
+  template <class T>
+  T* GetBehaviorSharedData(const gd::String& behaviorName) const {
+    return behaviorsSharedDatas.GetBehaviorSharedData<T>(behaviorName);
+  }
+
+  /**
+   * \brief Get the data of type T stored by an extension in the scene (see
+   * RuntimeSceneExtensionData). The data is created if it does not exist yet,
+   * and is destroyed with the scene.
+   */
+  template <class T>
+  T& GetExtensionData() {
+    return extensionsDatas.Get<T>();
+  }
+
+  /**
+   * \brief Destroy the data of type T stored by an extension in the scene, if
+   * any.
+   */
+  template <class T>
+  void RemoveExtensionData() {
+    extensionsDatas.Remove<T>();
+  }
+
   /**
    * \brief Set up the RuntimeScene using a gd::Layout.
    *
@@ -151,6 +307,80 @@ class GD_API RuntimeScene : public Scene {
                          float xOffset = 0,
                          float yOffset = 0);
 
+  /**
+   * \brief Create the object of an initial instance and add it to the scene.
+   * \return The object created, or nullptr if the object of the instance
+   * does not exist.
+   */
+  RuntimeObject* CreateObjectFromInitialInstance(
+      const gd::InitialInstance& instance,
+      float xOffset = 0,
+      float yOffset = 0);
+
+  /**
+   * \brief Create the object of an initial instance, without adding it to
+   * the scene.
+   * \return The object created, or nullptr if the object of the instance
+   * does not exist.
+   */
+  RuntimeObjSPtr PrepareObjectFromInitialInstance(
+      const gd::InitialInstance& instance,
+      float xOffset = 0,
+      float yOffset = 0);
+
+  /**
+   * \brief Create the objects from a gd::InitialInstancesContainer created
+   * many times in the scene, like the one of an external layout.
+   *
+   * The objects are prepared the first time the container is used, and then
+   * cloned (see PreparedInstances).
+   *
+   * \warning The container must not be modified or destroyed while the scene
+   * is used.
+   */
+  void CreateObjectsFromPreparedInstances(
+      const gd::InitialInstancesContainer& container,
+      float xOffset = 0,
+      float yOffset = 0);
+
+  /**
+   * \brief Return the InstancesStreamer creating the objects of the initial
+   * instances near the camera, when the scene streams its instances.
+   *
+   * \see gd::Layout::SetStreamingChunkSize
+   */
+  InstancesStreamer& GetInstancesStreamer() { return instancesStreamer; }
+
+  /** \name Snapshots
+   */
+  ///@{
+  /**
+   * \brief Write the state of the scene in \a snapshot, replacing its content:
+   * the time and timers, the state of the random generator, the scene
+   * variables and the objects (see RuntimeObject::SaveState).
+   *
+   * The snapshot is a compact binary buffer that can be reused to avoid
+   * allocations. Consecutive snapshots can be stored as deltas (see
+   * SceneSnapshot::ComputeDelta).
+   */
+  void TakeSnapshot(std::string& snapshot);
+
+  /**
+   * \brief Restore the state of the scene written in a snapshot.
+   *
+   * The objects of the scene are reused, in the order of their lists, for the
+   * objects of the snapshot having the same name. Missing objects are created
+   * and the other ones are deleted.
+   *
+   * \note Variables created after the snapshot was taken are kept. Cameras,
+   * layers, shared data of behaviors and the data of extensions are not part
+   * of the snapshot.
+   * \return false if the snapshot is invalid, in which case the scene can be
+   * partially restored.
+   */
+  bool RestoreSnapshot(const std::string& snapshot);
+  ///@}
+
   /**
    * \brief Change the window used for rendering the scene
    */
@@ -174,6 +404,42 @@ class GD_API RuntimeScene : public Scene {
    */
   bool RenderAndStep();
 
+  /**
+   * \brief Play one frame without rendering it, handling the events of the
+   * window or managing the sounds.
+   *
+   * The scene doesn't need a window: this is used to simulate scenes as fast
+   * as possible, for example on a server or in benchmarks.
+   * \param elapsedTime The time elapsed since the last frame, in microseconds.
+   * \return true if a scene change was request, false otherwise.
+   */
+  bool StepWithoutRender(signed long long elapsedTime);
+
+  /**
+   * \brief Record the input events and the elapsed time of the next frames in
+   * \a recording, after having seeded the random numbers with its seed.
+   *
+   * \note The recording must be kept alive until StopInputRecording is called.
+   */
+  void StartInputRecording(InputRecording& recording);
+
+  /**
+   * \brief Stop recording the frames.
+   */
+  void StopInputRecording() { inputRecording = nullptr; }
+
+  /**
+   * \brief Play the frames of a recording without rendering them, after having
+   * seeded the random numbers with its seed, so that the recorded session is
+   * played again with the same results.
+   *
+   * Enable the frame profiler (see EnableFrameProfiler) to get the time spent
+   * during each frame.
+   * \return The number of frames played: the replay stops if a scene change
+   * is requested.
+   */
+  std::size_t ReplayInputRecording(const InputRecording& recording);
+
   /**
    * \brief Just render a frame, without applying logic or events on objects.
    */
@@ -232,6 +498,14 @@ class GD_API RuntimeScene : public Scene {
    */
   void Render();
 
+  /**
+   * \brief Play a frame, rendering it (and measuring the elapsed time) if \a
+   * render is true.
+   * \see RenderAndStep
+   * \see StepWithoutRender
+   */
+  bool StepFrame(bool render, signed long long elapsedTime);
+
   /**
    * \brief To be called once during a step, to launch behaviors pre-events
    * steps.
@@ -244,6 +518,27 @@ class GD_API RuntimeScene : public Scene {
    */
   void ManageObjectsAfterEvents();
 
+  /**
+   * \brief Create an object of the scene or of the game, without adding it to
+   * the scene.
+   * \return The object created, or nullptr if there is no object with this
+   * name.
+   */
+  RuntimeObjSPtr CreateObjectNamed(const gd::String& name);
+
+  /**
+   * \brief Remove an object from the scene, notifying the extensions.
+   */
+  void RemoveObject(RuntimeObject* object);
+
+  /**
+   * \brief Create and delete the objects of the streamed instances according
+   * to the position of the first camera of the base layer.
+   * \param maximumCreatedObjects The maximum number of objects to create, 0
+   * for no limit.
+   */
+  void UpdateInstancesStreamer(std::size_t maximumCreatedObjects);
+
   /**
    * \brief Set the OpenGL projection according to the window size and OpenGL
    * scene options.
@@ -253,8 +548,27 @@ class GD_API RuntimeScene : public Scene {
   bool isFullScreen;  ///< As sf::RenderWindow can't say if it is fullscreen or
                       ///< not
   InputManager inputManager;
+  InputRecording* inputRecording;  ///< Records the frames, if not NULL.
   TimeManager timeManager;
   RuntimeVariablesContainer variables;  ///< List of the scene variables
+  ObjectsSpatialHash objectsSpatialHash;  ///< Broadphase used by collision
+                                          ///< conditions.
+  ScratchArena scratchArena;  ///< Temporary memory, reset at each frame.
+  std::vector<RuntimeObject*>
+      parallelPreEventsObjects;  ///< The objects having their behaviors
+                                 ///< stepped in parallel before events.
+  InstancesStreamer instancesStreamer;  ///< Create the initial instances near
+                                        ///< the camera, if enabled.
+  std::unordered_map<const gd::InitialInstancesContainer*,
+                     std::unique_ptr<PreparedInstances>>
+      preparedInstances;  ///< See CreateObjectsFromPreparedInstances.
+  std::unique_ptr<FrameProfiler>
+      frameProfiler;  ///< Records the frames, NULL if not enabled.
+  FrameProfilerStream* frameProfilerStream;  ///< Sends the frames records,
+                                             ///< if not NULL.
+  bool framePacingEnabled;  ///< True if the frames are paced by framePacer.
+  FramePacer framePacer;
+  RandomGenerator randomGenerator;
   std::vector<ExtensionBase*>
       extensionsToBeNotifiedOnObjectDeletion;  ///< List, built during
                                                ///< LoadFromScene, containing a
@@ -263,8 +577,17 @@ class GD_API RuntimeScene : public Scene {
                                                ///< object is deleted.
   BehaviorsRuntimeSharedDataHolder
       behaviorsSharedDatas;  ///< Contains all behaviors shared datas.
+  RuntimeSceneExtensionsDataHolder
+      extensionsDatas;  ///< Contains the data stored by extensions.
   std::vector<RuntimeLayer>
       layers;  ///< The layers used at runtime to display the scene.
+  std::unordered_map<gd::String, std::size_t>
+      layersIndex;  ///< The position of the layers, by their names.
+  std::unordered_map<InternedString, std::size_t>
+      internedLayersIndex;  ///< The position of the layers, by their
+                            ///< interned names.
+  SpriteBatch spriteBatch;  ///< Used to draw consecutive sprites sharing the
+                            ///< same texture at once.
   std::shared_ptr<CodeExecutionEngine> codeExecutionEngine;
   SceneChange
       requestedChange;  ///< What should be done at the end of the frame.
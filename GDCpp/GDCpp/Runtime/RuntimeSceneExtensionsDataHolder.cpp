@@ -0,0 +1,25 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+
+namespace {
+std::size_t dataIndexesCount = 0;
+}
+
+std::size_t RuntimeSceneExtensionsDataHolder::NewDataIndex() {
+  return dataIndexesCount++;
+}
+
+void RuntimeSceneExtensionsDataHolder::PreEvents(RuntimeScene& scene) {
+  // Data can be created while iterating.
+  for (std::size_t i = 0; i < datas.size(); ++i)
+    if (datas[i]) datas[i]->PreEvents(scene);
+}
+
+void RuntimeSceneExtensionsDataHolder::PostEvents(RuntimeScene& scene) {
+  for (std::size_t i = 0; i < datas.size(); ++i)
+    if (datas[i]) datas[i]->PostEvents(scene);
+}
@@ -0,0 +1,127 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef RUNTIMESCENEEXTENSIONSDATAHOLDER_H
+#define RUNTIMESCENEEXTENSIONSDATAHOLDER_H
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+class RuntimeScene;
+
+/**
+ * \brief Base class for the data stored by extensions in a RuntimeScene (for
+ * example the managers of the objects using a behavior).
+ *
+ * Classes deriving from it must be default constructible and declare a
+ * static member giving the index of their slot, defined in a single
+ * translation unit:
+ *
+ * \code
+ * // In the header:
+ * static const std::size_t sceneDataIndex;
+ * // In the source file:
+ * const std::size_t MyManager::sceneDataIndex =
+ *     RuntimeSceneExtensionsDataHolder::NewDataIndex();
+ * \endcode
+ *
+ * \see RuntimeScene::GetExtensionData
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeSceneExtensionData {
+ public:
+  RuntimeSceneExtensionData(){};
+  virtual ~RuntimeSceneExtensionData(){};
+
+  /**
+   * \brief Called at each frame, before the events of the scene are run.
+   */
+  virtual void PreEvents(RuntimeScene& scene){};
+
+  /**
+   * \brief Called at each frame, after the objects and their behaviors were
+   * updated following the events.
+   */
+  virtual void PostEvents(RuntimeScene& scene){};
+};
+
+/**
+ * \brief Contains the data stored by extensions in a RuntimeScene, by slot
+ * index.
+ *
+ * Getting the data is an index in a vector, instead of a lookup in a map
+ * shared by all the scenes.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeSceneExtensionsDataHolder {
+ public:
+  RuntimeSceneExtensionsDataHolder(){};
+  /**
+   * \brief The data belongs to a scene: copies are created empty.
+   */
+  RuntimeSceneExtensionsDataHolder(const RuntimeSceneExtensionsDataHolder&){};
+  RuntimeSceneExtensionsDataHolder& operator=(
+      const RuntimeSceneExtensionsDataHolder&) {
+    return *this;
+  };
+  virtual ~RuntimeSceneExtensionsDataHolder(){};
+
+  /**
+   * \brief Return a new slot index, to be stored in the static member
+   * sceneDataIndex of a class deriving from RuntimeSceneExtensionData.
+   */
+  static std::size_t NewDataIndex();
+
+  /**
+   * \brief Call RuntimeSceneExtensionData::PreEvents for each data.
+   */
+  void PreEvents(RuntimeScene& scene);
+
+  /**
+   * \brief Call RuntimeSceneExtensionData::PostEvents for each data.
+   */
+  void PostEvents(RuntimeScene& scene);
+
+  /**
+   * \brief Get the data of type T, which is created if it does not exist
+   * yet.
+   */
+  template <class T>
+  T& Get() {
+    const std::size_t index = T::sceneDataIndex;
+    if (index >= datas.size()) datas.resize(index + 1);
+    if (!datas[index]) datas[index].reset(new T);
+
+    return static_cast<T&>(*datas[index]);
+  }
+
+  /**
+   * \brief Return true if the data of type T exists.
+   */
+  template <class T>
+  bool Has() const {
+    return T::sceneDataIndex < datas.size() && datas[T::sceneDataIndex];
+  }
+
+  /**
+   * \brief Destroy the data of type T, if it exists.
+   */
+  template <class T>
+  void Remove() {
+    if (T::sceneDataIndex >= datas.size()) return;
+
+    // Take the data out of the slot first, in case its destructor accesses
+    // the holder.
+    std::unique_ptr<RuntimeSceneExtensionData> data =
+        std::move(datas[T::sceneDataIndex]);
+  }
+
+ private:
+  std::vector<std::unique_ptr<RuntimeSceneExtensionData>>
+      datas;  ///< The data of each slot (NULL if not created).
+};
+
+#endif  // RUNTIMESCENEEXTENSIONSDATAHOLDER_H
@@ -5,6 +5,7 @@
  */
 
 #include <SFML/Graphics.hpp>
+#include <functional>
 #include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
 #include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
 #include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
@@ -16,6 +17,8 @@
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include "GDCpp/Runtime/SpriteBatch.h"
 #include "GDCpp/Runtime/TinyXml/tinyxml.h"
 #include "RuntimeSpriteObject.h"
 #if defined(GD_IDE_ONLY)
@@ -42,8 +45,14 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
       animationStopped(false),
       timeElapsedOnCurrentSprite(0.f),
       animationSpeedScale(1.f),
+      updateIfNotVisible(spriteObject.GetUpdateIfNotVisible()),
+      pendingAnimationTime(0),
+      drawnSinceLastUpdate(true),
       ptrToCurrentSprite(NULL),
       needUpdateCurrentSprite(true),
+      needUpdateHitBoxes(true),
+      needUpdateAABB(true),
+      hasOwnImages(false),
       opacity(255),
       blendMode(0),
       isFlippedX(false),
@@ -55,6 +64,13 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
       colorB(255) {
   if (!badSpriteDatas) badSpriteDatas = new gd::Sprite();
 
+  LoadAnimations(scene, spriteObject);
+}
+
+RuntimeSpriteObject::~RuntimeSpriteObject(){};
+
+void RuntimeSpriteObject::LoadAnimations(RuntimeScene& scene,
+                                         const gd::SpriteObject& spriteObject) {
   animations.clear();
   for (std::size_t i = 0; i < spriteObject.GetAllAnimations().size(); ++i)
     animations.push_back(AnimationProxy(spriteObject.GetAllAnimations()[i]));
@@ -73,7 +89,45 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
   }
 }
 
-RuntimeSpriteObject::~RuntimeSpriteObject(){};
+bool RuntimeSpriteObject::Reset(RuntimeScene& scene,
+                                const gd::Object& object) {
+  const gd::SpriteObject* spriteObject =
+      dynamic_cast<const gd::SpriteObject*>(&object);
+  if (!spriteObject || !RuntimeObject::Reset(scene, object)) return false;
+
+  currentAnimation = 0;
+  currentDirection = 0;
+  currentAngle = 0;
+  currentSprite = 0;
+  animationStopped = false;
+  timeElapsedOnCurrentSprite = 0.f;
+  animationSpeedScale = 1.f;
+  updateIfNotVisible = spriteObject->GetUpdateIfNotVisible();
+  pendingAnimationTime = 0;
+  drawnSinceLastUpdate = true;
+  ptrToCurrentSprite = NULL;
+  needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
+  needUpdateAABB = true;
+  opacity = 255;
+  blendMode = 0;
+  isFlippedX = false;
+  isFlippedY = false;
+  scaleX = 1;
+  scaleY = 1;
+  colorR = 255;
+  colorV = 255;
+  colorB = 255;
+
+  // Modified images are not shared with the object, so the animations must be
+  // loaded again.
+  if (hasOwnImages) {
+    LoadAnimations(scene, *spriteObject);
+    hasOwnImages = false;
+  }
+
+  return true;
+}
 
 bool RuntimeSpriteObject::ExtraInitializationFromInitialInstance(
     const gd::InitialInstance& position) {
@@ -86,25 +140,104 @@ bool RuntimeSpriteObject::ExtraInitializationFromInitialInstance(
 bool RuntimeSpriteObject::Draw(sf::RenderTarget& renderTarget) {
   // Don't draw anything if hidden
   if (hidden) return true;
+  drawnSinceLastUpdate = true;
 
-  renderTarget.draw(
-      GetCurrentSFMLSprite(),
-      sf::RenderStates(
-          blendMode == 0
-              ? sf::BlendAlpha
-              : (blendMode == 1
-                     ? sf::BlendAdd
-                     : (blendMode == 2 ? sf::BlendMultiply : sf::BlendNone))));
+  renderTarget.draw(GetCurrentSFMLSprite(),
+                    sf::RenderStates(GetSFMLBlendMode()));
 
   return true;
 }
 
+bool RuntimeSpriteObject::DrawBatched(sf::RenderTarget& renderTarget,
+                                      SpriteBatch& batch) {
+  // Don't draw anything if hidden
+  if (hidden) return true;
+  drawnSinceLastUpdate = true;
+
+  batch.Add(renderTarget, GetCurrentSFMLSprite(), GetSFMLBlendMode());
+  return true;
+}
+
+void RuntimeSpriteObject::SaveState(SceneSnapshotWriter& writer) const {
+  RuntimeObject::SaveState(writer);
+
+  CatchUpAnimation();
+  writer.WriteUInt(currentAnimation);
+  writer.WriteUInt(currentDirection);
+  writer.WriteFloat(currentAngle);
+  writer.WriteUInt(currentSprite);
+  writer.WriteBool(animationStopped);
+  writer.WriteFloat(timeElapsedOnCurrentSprite);
+  writer.WriteFloat(animationSpeedScale);
+  writer.WriteFloat(opacity);
+  writer.WriteUInt(blendMode);
+  writer.WriteBool(isFlippedX);
+  writer.WriteBool(isFlippedY);
+  writer.WriteFloat(scaleX);
+  writer.WriteFloat(scaleY);
+  writer.WriteUInt((colorR << 16) | (colorV << 8) | colorB);
+}
+
+void RuntimeSpriteObject::RestoreState(SceneSnapshotReader& reader) {
+  RuntimeObject::RestoreState(reader);
+
+  // Invalid frames are displayed with the "bad" sprite by
+  // UpdateCurrentSprite, so the values are not checked.
+  currentAnimation = reader.ReadUInt();
+  currentDirection = reader.ReadUInt();
+  currentAngle = reader.ReadFloat();
+  currentSprite = reader.ReadUInt();
+  animationStopped = reader.ReadBool();
+  timeElapsedOnCurrentSprite = reader.ReadFloat();
+  animationSpeedScale = reader.ReadFloat();
+  pendingAnimationTime = 0;
+  opacity = reader.ReadFloat();
+  blendMode = reader.ReadUInt();
+  isFlippedX = reader.ReadBool();
+  isFlippedY = reader.ReadBool();
+  scaleX = reader.ReadFloat();
+  scaleY = reader.ReadFloat();
+  std::size_t color = reader.ReadUInt();
+  colorR = (color >> 16) & 0xFF;
+  colorV = (color >> 8) & 0xFF;
+  colorB = color & 0xFF;
+
+  needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
+  needUpdateAABB = true;
+}
+
+std::size_t RuntimeSpriteObject::GetRenderingHash() const {
+  // The frame being displayed can depend on the time elapsed while the object
+  // was not drawn.
+  CatchUpAnimation();
+
+  std::hash<float> hashFloat;
+  std::size_t hash = RuntimeObject::GetRenderingHash();
+  hash = hash * 31 + currentAnimation;
+  hash = hash * 31 + currentDirection;
+  hash = hash * 31 + currentSprite;
+  hash = hash * 31 + hashFloat(opacity);
+  hash = hash * 31 + ((colorR << 16) | (colorV << 8) | colorB);
+  hash = hash * 31 + blendMode;
+  hash = hash * 31 + (isFlippedX ? 1 : 0) + (isFlippedY ? 2 : 0);
+  return hash;
+}
+
+const sf::BlendMode& RuntimeSpriteObject::GetSFMLBlendMode() const {
+  return blendMode == 0
+             ? sf::BlendAlpha
+             : (blendMode == 1
+                    ? sf::BlendAdd
+                    : (blendMode == 2 ? sf::BlendMultiply : sf::BlendNone));
+}
+
 float RuntimeSpriteObject::GetDrawableX() const {
-  return X - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
+  return GetX() - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
 }
 
 float RuntimeSpriteObject::GetDrawableY() const {
-  return Y - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
+  return GetY() - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
 }
 
 float RuntimeSpriteObject::GetWidth() const {
@@ -165,29 +298,6 @@ float RuntimeSpriteObject::GetPointY(const gd::String& name) const {
   return GetY();
 }
 
-void RuntimeSpriteObject::ChangeScale(const gd::String& operatorStr,
-                                      double newScale) {
-  // TODO : Generate appropriate code calling SetScaleX/Y instead of this.
-  if (operatorStr == "=") {
-    SetScaleX(newScale);
-    SetScaleY(newScale);
-  } else if (operatorStr == "+") {
-    SetScaleX(GetScaleX() + newScale);
-    SetScaleY(GetScaleY() + newScale);
-  } else if (operatorStr == "-") {
-    SetScaleX(GetScaleX() - newScale);
-    SetScaleY(GetScaleY() - newScale);
-  } else if (operatorStr == "*") {
-    SetScaleX(GetScaleX() * newScale);
-    SetScaleY(GetScaleY() * newScale);
-  } else if (operatorStr == "/") {
-    SetScaleX(GetScaleX() / newScale);
-    SetScaleY(GetScaleY() / newScale);
-  }
-
-  return;
-}
-
 void RuntimeSpriteObject::SetScaleX(float val) {
   if (val == GetScaleX()) return;
   if (val < 0) val = 0;
@@ -220,6 +330,7 @@ void RuntimeSpriteObject::CopyImageOnImageOfCurrentSprite(
       ->MakeSpriteOwnsItsImage();  // We want to modify only the image of the
                                    // object, not all objects which have the
                                    // same image.
+  hasOwnImages = true;
   std::shared_ptr<SFMLTextureWrapper> dest =
       ptrToCurrentSprite->GetSFMLTexture();
 
@@ -238,6 +349,7 @@ void RuntimeSpriteObject::CopyImageOnImageOfCurrentSprite(
                    sf::IntRect(0, 0, 0, 0),
                    useTransparency);
   dest->texture.loadFromImage(dest->image);
+  dest->collisionMasks.reset();
 }
 
 void RuntimeSpriteObject::MakeColorTransparent(const gd::String& colorStr) {
@@ -247,6 +359,7 @@ void RuntimeSpriteObject::MakeColorTransparent(const gd::String& colorStr) {
       ->MakeSpriteOwnsItsImage();  // We want to modify only the image of the
                                    // object, not all objects which have the
                                    // same image.
+  hasOwnImages = true;
   std::shared_ptr<SFMLTextureWrapper> dest =
       ptrToCurrentSprite->GetSFMLTexture();
 
@@ -258,6 +371,7 @@ void RuntimeSpriteObject::MakeColorTransparent(const gd::String& colorStr) {
   dest->image.createMaskFromColor(
       sf::Color(colors[0].To<int>(), colors[1].To<int>(), colors[2].To<int>()));
   dest->texture.loadFromImage(dest->image);
+  dest->collisionMasks.reset();
 }
 
 void RuntimeSpriteObject::SetColor(const gd::String& colorStr) {
@@ -297,12 +411,12 @@ void RuntimeSpriteObject::UpdateCurrentSprite() const {
   ptrToCurrentSprite->GetSFMLSprite().setRotation(
       multipleDirections ? 0 : currentAngle);
   ptrToCurrentSprite->GetSFMLSprite().setPosition(
-      X + (ptrToCurrentSprite->GetCenter().GetX() -
-           ptrToCurrentSprite->GetOrigin().GetX()) *
-              fabs(scaleX),
-      Y + (ptrToCurrentSprite->GetCenter().GetY() -
-           ptrToCurrentSprite->GetOrigin().GetY()) *
-              fabs(scaleY));
+      GetX() + (ptrToCurrentSprite->GetCenter().GetX() -
+                ptrToCurrentSprite->GetOrigin().GetX()) *
+                   fabs(scaleX),
+      GetY() + (ptrToCurrentSprite->GetCenter().GetY() -
+                ptrToCurrentSprite->GetOrigin().GetY()) *
+                   fabs(scaleY));
   if (isFlippedX)
     ptrToCurrentSprite->GetSFMLSprite().move(
         (ptrToCurrentSprite->GetSFMLSprite().getLocalBounds().width / 2 -
@@ -320,14 +434,35 @@ void RuntimeSpriteObject::UpdateCurrentSprite() const {
       sf::Color(colorR, colorV, colorB, opacity));
 
   needUpdateCurrentSprite = false;
+  needUpdateHitBoxes = true;
+  needUpdateAABB = true;
 }
 
 void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
+  bool drawn = drawnSinceLastUpdate;
+  drawnSinceLastUpdate = false;
   if (animationStopped || currentAnimation >= GetAnimationsCount()) return;
 
   double elapsedTimeInSeconds =
       static_cast<double>(GetElapsedTime(scene)) / 1000000.0;
-  timeElapsedOnCurrentSprite += elapsedTimeInSeconds * animationSpeedScale;
+
+  // Objects that were hidden or outside of the cameras during the last frame
+  // only store the elapsed time: their animation is caught up when they are
+  // drawn again or when their frame is read.
+  if (!updateIfNotVisible && !drawn) {
+    pendingAnimationTime += elapsedTimeInSeconds * animationSpeedScale;
+    return;
+  }
+
+  CatchUpAnimation();
+  AdvanceAnimation(elapsedTimeInSeconds * animationSpeedScale);
+}
+
+void RuntimeSpriteObject::AdvanceAnimation(double time) const {
+  if (currentAnimation >= GetAnimationsCount()) return;
+  std::size_t previousSprite = currentSprite;
+
+  timeElapsedOnCurrentSprite += time;
 
   const gd::Direction& direction =
       animations[currentAnimation].Get().GetDirection(currentDirection);
@@ -351,45 +486,66 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
       currentSprite = direction.GetSpritesCount() - 1;
   }
 
-  needUpdateCurrentSprite = true;
+  // Avoid invalidating the hitboxes if the frame was not changed.
+  if (currentSprite != previousSprite) needUpdateCurrentSprite = true;
 }
 
 const sf::Sprite& RuntimeSpriteObject::GetCurrentSFMLSprite() const {
+  CatchUpAnimation();
   if (needUpdateCurrentSprite) UpdateCurrentSprite();
 
   return ptrToCurrentSprite->GetSFMLSprite();
 }
 
 const gd::Sprite& RuntimeSpriteObject::GetCurrentSprite() const {
+  CatchUpAnimation();
   if (needUpdateCurrentSprite) UpdateCurrentSprite();
 
   return *ptrToCurrentSprite;
 }
 
 std::vector<Polygon2d> RuntimeSpriteObject::GetHitBoxes() const {
+  return GetHitBoxesRef();
+}
+
+const std::vector<Polygon2d>& RuntimeSpriteObject::GetHitBoxesRef() const {
+  if (needUpdateCurrentSprite) UpdateCurrentSprite();
+  if (!needUpdateHitBoxes) return hitBoxes;
+
+  needUpdateHitBoxes = false;
   if (currentAnimation >= animations.size()) {
-    std::vector<Polygon2d> hitboxes;  // Invalid animation, bail out.
-    return hitboxes;
+    hitBoxes.clear();  // Invalid animation, bail out.
+    return hitBoxes;
   }
   const sf::Sprite& currentSFMLSprite = GetCurrentSFMLSprite();
 
-  std::vector<Polygon2d> polygons = GetCurrentSprite().GetCollisionMask();
-  for (std::size_t i = 0; i < polygons.size(); ++i) {
-    for (std::size_t j = 0; j < polygons[i].vertices.size(); ++j) {
+  hitBoxes = GetCurrentSprite().GetCollisionMask();
+  for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
+    for (std::size_t j = 0; j < hitBoxes[i].vertices.size(); ++j) {
       sf::Vector2f newVertice = currentSFMLSprite.getTransform().transformPoint(
           !isFlippedX
-              ? polygons[i].vertices[j].x
+              ? hitBoxes[i].vertices[j].x
               : GetCurrentSprite().GetSFMLSprite().getLocalBounds().width -
-                    polygons[i].vertices[j].x,
+                    hitBoxes[i].vertices[j].x,
           !isFlippedY
-              ? polygons[i].vertices[j].y
+              ? hitBoxes[i].vertices[j].y
               : GetCurrentSprite().GetSFMLSprite().getLocalBounds().height -
-                    polygons[i].vertices[j].y);
-      polygons[i].vertices[j] = newVertice;
+                    hitBoxes[i].vertices[j].y);
+      hitBoxes[i].vertices[j] = newVertice;
     }
   }
 
-  return polygons;
+  return hitBoxes;
+}
+
+sf::FloatRect RuntimeSpriteObject::GetAABB() const {
+  if (needUpdateCurrentSprite) UpdateCurrentSprite();
+  if (needUpdateAABB) {
+    aabb = RuntimeObject::GetAABB();
+    needUpdateAABB = false;
+  }
+
+  return aabb;
 }
 
 bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
@@ -404,6 +560,7 @@ bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
 
   currentSprite = nb;
   timeElapsedOnCurrentSprite = 0;
+  pendingAnimationTime = 0;
 
   needUpdateCurrentSprite = true;
   return true;
@@ -416,6 +573,7 @@ bool RuntimeSpriteObject::SetCurrentAnimation(std::size_t nb) {
   currentAnimation = nb;
   currentSprite = 0;
   timeElapsedOnCurrentSprite = 0;
+  pendingAnimationTime = 0;
 
   needUpdateCurrentSprite = true;
   return true;
@@ -459,6 +617,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     currentDirection = nb;
     currentSprite = 0;
     timeElapsedOnCurrentSprite = 0;
+    pendingAnimationTime = 0;
 
     needUpdateCurrentSprite = true;
     return true;
@@ -501,6 +660,7 @@ float RuntimeSpriteObject::GetCurrentDirectionOrAngle() const {
 }
 
 bool RuntimeSpriteObject::AnimationEnded() const {
+  CatchUpAnimation();
   if (currentAnimation >= GetAnimationsCount()) return true;
 
   const gd::Direction& direction =
@@ -19,6 +19,7 @@ class PropertyDescriptor;
 }
 namespace sf {
 class Sprite;
+struct BlendMode;
 }
 
 /**
@@ -57,8 +58,13 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
 
   virtual bool ExtraInitializationFromInitialInstance(
       const gd::InitialInstance& position);
+  virtual bool Reset(RuntimeScene& scene, const gd::Object& object);
+  virtual void SaveState(SceneSnapshotWriter& writer) const;
+  virtual void RestoreState(SceneSnapshotReader& reader);
 
   virtual bool Draw(sf::RenderTarget& renderTarget);
+  virtual bool DrawBatched(sf::RenderTarget& renderTarget, SpriteBatch& batch);
+  virtual std::size_t GetRenderingHash() const;
 
 #if defined(GD_IDE_ONLY)
   virtual void GetPropertyForDebugger(std::size_t propertyNb,
@@ -86,7 +92,9 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   virtual bool SetAngle(float newAngle);
   virtual float GetAngle() const;
 
+  virtual sf::FloatRect GetAABB() const;
   virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual const std::vector<Polygon2d>& GetHitBoxesRef() const;
   virtual bool CursorOnObject(RuntimeScene& scene, bool accurate);
 
   /**
@@ -125,7 +133,10 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   /**
    * \brief Stop the animation being played.
    */
-  void StopAnimation() { animationStopped = true; };
+  void StopAnimation() {
+    CatchUpAnimation();
+    animationStopped = true;
+  };
 
   /**
    * \brief Play the current animation.
@@ -181,7 +192,10 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   bool AnimationEnded() const;
 
   float GetAnimationSpeedScale() const { return animationSpeedScale; }
-  void SetAnimationSpeedScale(float ratio) { animationSpeedScale = ratio; }
+  void SetAnimationSpeedScale(float ratio) {
+    CatchUpAnimation();
+    animationSpeedScale = ratio;
+  }
 
   /**
    * \brief Change the frame of the animation being displayed.
@@ -194,7 +208,10 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   /**
    * \brief Return the index of the frame of the animation being displayed.
    */
-  inline std::size_t GetSpriteNb() const { return currentSprite; }
+  inline std::size_t GetSpriteNb() const {
+    CatchUpAnimation();
+    return currentSprite;
+  }
   ///@}
 
   bool SetDirection(float nb);
@@ -310,27 +327,68 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
    */
   void TurnTowardObject(RuntimeObject* object, RuntimeScene& scene);
 
+ private:
   /**
-   * Only used internally by GD events generated code: Prefer using
-   * (Get/Set)Scale(X/Y).
+   * \brief Get the SFML blend mode corresponding to the object blend mode.
    */
-  void ChangeScale(const gd::String& operatorStr, double newValue);
+  const sf::BlendMode& GetSFMLBlendMode() const;
 
- private:
-  // Animations, direction and current frame:
+  /**
+   * \brief Copy the animations of the object and load their images.
+   */
+  void LoadAnimations(RuntimeScene& scene,
+                      const gd::SpriteObject& spriteObject);
+
+  /**
+   * \brief Advance the animation being played by \a time seconds (already
+   * multiplied by the animation speed scale).
+   */
+  void AdvanceAnimation(double time) const;
+
+  /**
+   * \brief Advance the animation by the time elapsed while the object was not
+   * drawn, if any (see pendingAnimationTime).
+   */
+  inline void CatchUpAnimation() const {
+    if (pendingAnimationTime != 0) {
+      double time = pendingAnimationTime;
+      pendingAnimationTime = 0;
+      AdvanceAnimation(time);
+    }
+  }
+
+  // Animations, direction and current frame. The frame is mutable as it can
+  // be caught up when it is read (see CatchUpAnimation).
   std::size_t currentAnimation;
   std::size_t currentDirection;
   float currentAngle;
-  std::size_t currentSprite;
+  mutable std::size_t currentSprite;
   bool animationStopped;
 
-  float timeElapsedOnCurrentSprite;
+  mutable float timeElapsedOnCurrentSprite;
   float animationSpeedScale;
 
+  bool updateIfNotVisible;  ///< If false, the animation is not played while
+                            ///< the object is not drawn: the elapsed time is
+                            ///< stored in pendingAnimationTime instead.
+  mutable double pendingAnimationTime;  ///< Time, in seconds, elapsed on the
+                                        ///< animation since it was last
+                                        ///< played.
+  bool drawnSinceLastUpdate;  ///< True if the object was drawn since the last
+                              ///< call to Update.
+
   mutable gd::Sprite* ptrToCurrentSprite;  // Pointer to the current sprite
   mutable bool needUpdateCurrentSprite;
 
+  // Hitboxes and AABB, updated only when the current sprite is updated:
+  mutable std::vector<Polygon2d> hitBoxes;
+  mutable bool needUpdateHitBoxes;
+  mutable sf::FloatRect aabb;
+  mutable bool needUpdateAABB;
+
   std::vector<AnimationProxy> animations;
+  bool hasOwnImages;  ///< True if the images of some sprites were modified, so
+                      ///< that they are not shared with the other objects.
 
   float opacity;
   unsigned int blendMode;
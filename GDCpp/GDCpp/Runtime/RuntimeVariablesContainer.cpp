@@ -14,10 +14,39 @@ BadVariable RuntimeVariablesContainer::badVariable;
 BadRuntimeVariablesContainer RuntimeVariablesContainer::badVariablesContainer;
 
 RuntimeVariablesContainer::RuntimeVariablesContainer(
-    const gd::VariablesContainer& container) {
+    const gd::VariablesContainer& container)
+    : memoryAccount(gd::SystemStats::Variables) {
   Merge(container);
 }
 
+RuntimeVariablesContainer::RuntimeVariablesContainer(
+    const RuntimeVariablesContainer& other)
+    : memoryAccount(gd::SystemStats::Variables) {
+  Init(other);
+}
+
+RuntimeVariablesContainer& RuntimeVariablesContainer::operator=(
+    const RuntimeVariablesContainer& other) {
+  if (this != &other) {
+    Clear();
+    Init(other);
+  }
+
+  return *this;
+}
+
+void RuntimeVariablesContainer::Init(const RuntimeVariablesContainer& other) {
+  std::unordered_map<const gd::Variable*, gd::Variable*> copies;
+  for (const gd::Variable& variable : other.storage)
+    copies[&variable] = Store(variable);
+
+  variablesArray.reserve(other.variablesArray.size());
+  for (const gd::Variable* variable : other.variablesArray)
+    variablesArray.push_back(copies[variable]);
+  for (const auto& it : other.variables)
+    variables[it.first] = copies[it.second];
+}
+
 RuntimeVariablesContainer& RuntimeVariablesContainer::operator=(
     const gd::VariablesContainer& container) {
   Clear();
@@ -28,11 +57,9 @@ RuntimeVariablesContainer& RuntimeVariablesContainer::operator=(
 
 void RuntimeVariablesContainer::Clear() {
   variablesArray.clear();
-  for (std::map<gd::String, gd::Variable*>::iterator it = variables.begin();
-       it != variables.end();
-       ++it)
-    delete it->second;
   variables.clear();
+  storage.clear();
+  memoryAccount.SetBytes(0);
 }
 
 void RuntimeVariablesContainer::Merge(const gd::VariablesContainer& container) {
@@ -43,7 +70,7 @@ void RuntimeVariablesContainer::Merge(const gd::VariablesContainer& container) {
     if (Has(name))
       Get(name) = variable;
     else {
-      gd::Variable* newVariable = new gd::Variable(variable);
+      gd::Variable* newVariable = Store(variable);
       variablesArray.push_back(newVariable);
       variables[name] = newVariable;
     }
@@ -51,24 +78,22 @@ void RuntimeVariablesContainer::Merge(const gd::VariablesContainer& container) {
 }
 
 gd::Variable& RuntimeVariablesContainer::Get(const gd::String& name) {
-  std::map<gd::String, gd::Variable*>::const_iterator var =
-      variables.find(name);
+  auto var = variables.find(name);
 
   if (var != variables.end()) return *(var->second);
 
-  gd::Variable* newVariable = new gd::Variable;
+  gd::Variable* newVariable = Store(gd::Variable());
   variables[name] = newVariable;
   return *newVariable;
 }
 
 const gd::Variable& RuntimeVariablesContainer::Get(
     const gd::String& name) const {
-  std::map<gd::String, gd::Variable*>::const_iterator var =
-      variables.find(name);
+  auto var = variables.find(name);
 
   if (var != variables.end()) return *(var->second);
 
-  gd::Variable* newVariable = new gd::Variable;
+  gd::Variable* newVariable = Store(gd::Variable());
   variables[name] = newVariable;
   return *newVariable;
 }
@@ -6,10 +6,12 @@
 
 #ifndef RUNTIMEVARIABLESCONTAINER_H
 #define RUNTIMEVARIABLESCONTAINER_H
-#include <map>
+#include <deque>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/Project/Variable.h"
+#include "GDCore/Tools/SystemStats.h"
 namespace gd {
 class VariablesContainer;
 };
@@ -40,7 +42,18 @@ class GD_API RuntimeVariablesContainer {
   /**
    * \brief Construct an empty container.
    */
-  RuntimeVariablesContainer(){};
+  RuntimeVariablesContainer() : memoryAccount(gd::SystemStats::Variables){};
+
+  /**
+   * \brief Copy the variables of another container.
+   */
+  RuntimeVariablesContainer(const RuntimeVariablesContainer& other);
+
+  /**
+   * \brief Replace the variables by a copy of the variables of another
+   * container.
+   */
+  RuntimeVariablesContainer& operator=(const RuntimeVariablesContainer& other);
 
   /**
    * \brief Initialize a RuntimeVariablesContainer from a
@@ -128,7 +141,7 @@ class GD_API RuntimeVariablesContainer {
   /**
    * Get a map containing all variables.
    */
-  const std::map<gd::String, gd::Variable*>& DumpAllVariables() {
+  const std::unordered_map<gd::String, gd::Variable*>& DumpAllVariables() {
     return variables;
   };
 
@@ -138,8 +151,33 @@ class GD_API RuntimeVariablesContainer {
    */
   void Clear();
 
+  /**
+   * \brief Copy the variables of another container, which must be empty.
+   */
+  void Init(const RuntimeVariablesContainer& other);
+
+  /**
+   * \brief Store a new variable and return a pointer to it.
+   */
+  gd::Variable* Store(const gd::Variable& variable) const {
+    storage.push_back(variable);
+    memoryAccount.AddBytes(sizeof(gd::Variable));
+    return &storage.back();
+  }
+
+  mutable std::deque<gd::Variable>
+      storage;  ///< The variables, stored in a deque so that they don't move
+                ///< when others are added (and to avoid an allocation for each
+                ///< variable).
   std::vector<gd::Variable*> variablesArray;
-  mutable std::map<gd::String, gd::Variable*> variables;
+  mutable std::unordered_map<gd::String, gd::Variable*>
+      variables;  ///< All the variables, by name. Variables declared in the
+                  ///< containers given to Merge are also in variablesArray, so
+                  ///< that the code generated from events can access them
+                  ///< with their index.
+  mutable gd::MemoryAccount memoryAccount;  ///< The memory of the stored
+                                           ///< variables (without their
+                                           ///< children).
   static BadVariable badVariable;
   static BadRuntimeVariablesContainer badVariablesContainer;
 };
@@ -0,0 +1,291 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+
+namespace {
+enum VariableType { NumberVariable = 0, StringVariable, StructureVariable };
+}
+
+void SceneSnapshotWriter::WriteUInt(std::uint64_t value) {
+  while (value >= 0x80) {
+    data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<char>(value));
+}
+
+void SceneSnapshotWriter::WriteInt(std::int64_t value) {
+  // Zigzag encoding, so that small negative numbers are written with a few
+  // bytes.
+  WriteUInt((static_cast<std::uint64_t>(value) << 1) ^
+            static_cast<std::uint64_t>(value >> 63));
+}
+
+void SceneSnapshotWriter::WriteFloat(float value) {
+  char bytes[sizeof(float)];
+  std::memcpy(bytes, &value, sizeof(float));
+  data.append(bytes, sizeof(float));
+}
+
+void SceneSnapshotWriter::WriteDouble(double value) {
+  char bytes[sizeof(double)];
+  std::memcpy(bytes, &value, sizeof(double));
+  data.append(bytes, sizeof(double));
+}
+
+void SceneSnapshotWriter::WriteString(const gd::String& value) {
+  const std::string& bytes = value.Raw();
+  WriteUInt(bytes.size());
+  data.append(bytes);
+}
+
+void SceneSnapshotWriter::WriteVariable(const gd::Variable& variable) {
+  if (variable.IsStructure()) {
+    data.push_back(StructureVariable);
+    WriteUInt(variable.GetChildrenCount());
+    for (const auto& child : variable.GetAllChildren()) {
+      WriteString(child.first);
+      WriteVariable(*child.second);
+    }
+  } else if (variable.IsNumber()) {
+    data.push_back(NumberVariable);
+    WriteDouble(variable.GetValue());
+  } else {
+    data.push_back(StringVariable);
+    WriteString(variable.GetString());
+  }
+}
+
+void SceneSnapshotWriter::WriteVariables(
+    const RuntimeVariablesContainer& variables) {
+  // The map is only read: the const_cast is needed as DumpAllVariables is not
+  // const.
+  const auto& allVariables =
+      const_cast<RuntimeVariablesContainer&>(variables).DumpAllVariables();
+  WriteUInt(allVariables.size());
+  for (const auto& variable : allVariables) {
+    WriteString(variable.first);
+    WriteVariable(*variable.second);
+  }
+}
+
+std::size_t SceneSnapshotWriter::BeginBlock() {
+  std::size_t block = data.size();
+  data.append(4, 0);
+  return block;
+}
+
+void SceneSnapshotWriter::EndBlock(std::size_t block) {
+  std::uint32_t size = static_cast<std::uint32_t>(data.size() - block - 4);
+  for (std::size_t i = 0; i < 4; ++i)
+    data[block + i] = static_cast<char>((size >> (i * 8)) & 0xFF);
+}
+
+bool SceneSnapshotReader::Read(void* output, std::size_t count) {
+  if (!valid || size - position < count) {
+    valid = false;
+    std::memset(output, 0, count);
+    return false;
+  }
+
+  std::memcpy(output, data + position, count);
+  position += count;
+  return true;
+}
+
+std::uint64_t SceneSnapshotReader::ReadUInt() {
+  std::uint64_t value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    unsigned char byte = 0;
+    if (!Read(&byte, 1)) return 0;
+
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return value;
+  }
+
+  valid = false;
+  return 0;
+}
+
+std::int64_t SceneSnapshotReader::ReadInt() {
+  std::uint64_t value = ReadUInt();
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+float SceneSnapshotReader::ReadFloat() {
+  float value;
+  Read(&value, sizeof(float));
+  return value;
+}
+
+double SceneSnapshotReader::ReadDouble() {
+  double value;
+  Read(&value, sizeof(double));
+  return value;
+}
+
+bool SceneSnapshotReader::ReadBool() {
+  char value;
+  Read(&value, 1);
+  return value != 0;
+}
+
+gd::String SceneSnapshotReader::ReadString() {
+  std::uint64_t length = ReadUInt();
+  if (!valid || size - position < length) {
+    valid = false;
+    return gd::String();
+  }
+
+  gd::String value =
+      gd::String::FromUTF8(std::string(data + position, length));
+  position += length;
+  return value;
+}
+
+void SceneSnapshotReader::ReadVariable(gd::Variable& variable) {
+  char type = 0;
+  Read(&type, 1);
+  if (type == NumberVariable) {
+    variable.SetValue(ReadDouble());
+  } else if (type == StringVariable) {
+    variable.SetString(ReadString());
+  } else if (type == StructureVariable) {
+    // Children are updated in place, so that they are not allocated again
+    // when the structure did not change.
+    std::uint64_t count = ReadUInt();
+    std::vector<gd::String> names;
+    for (std::uint64_t i = 0; i < count && valid; ++i) {
+      names.push_back(ReadString());
+      ReadVariable(variable.GetChild(names.back()));
+    }
+
+    if (!variable.IsStructure()) {
+      // Make the variable an empty structure.
+      variable.GetChild("");
+      variable.RemoveChild("");
+    }
+    if (variable.GetChildrenCount() != names.size()) {
+      std::sort(names.begin(), names.end());
+      for (const gd::String& name : variable.GetAllChildrenNames()) {
+        if (!std::binary_search(names.begin(), names.end(), name))
+          variable.RemoveChild(name);
+      }
+    }
+  } else {
+    valid = false;
+  }
+}
+
+void SceneSnapshotReader::ReadVariables(RuntimeVariablesContainer& variables) {
+  std::uint64_t count = ReadUInt();
+  for (std::uint64_t i = 0; i < count && valid; ++i) {
+    gd::String name = ReadString();
+    ReadVariable(variables.Get(name));
+  }
+}
+
+bool SceneSnapshotReader::ReadBytes(std::string& output, std::size_t count) {
+  if (!valid || size - position < count) {
+    valid = false;
+    return false;
+  }
+
+  output.append(data + position, count);
+  position += count;
+  return true;
+}
+
+SceneSnapshotReader SceneSnapshotReader::ReadBlock() {
+  unsigned char bytes[4] = {0, 0, 0, 0};
+  Read(bytes, 4);
+  std::size_t blockSize = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                          (static_cast<std::size_t>(bytes[3]) << 24);
+  if (!valid || size - position < blockSize) {
+    valid = false;
+    return SceneSnapshotReader(nullptr, 0);
+  }
+
+  SceneSnapshotReader block(data + position, blockSize);
+  position += blockSize;
+  return block;
+}
+
+void SceneSnapshot::ComputeDelta(const std::string& previous,
+                                 const std::string& current,
+                                 std::string& delta) {
+  // The delta is the size of the current snapshot, followed by runs of
+  // unchanged bytes and changed bytes: the length of the unchanged run, the
+  // length of the changed run and the changed bytes.
+  delta.clear();
+  SceneSnapshotWriter writer(delta);
+  writer.WriteUInt(current.size());
+
+  std::size_t commonSize = std::min(previous.size(), current.size());
+  std::size_t position = 0;
+  while (position < current.size()) {
+    std::size_t unchangedStart = position;
+    while (position < commonSize && previous[position] == current[position])
+      ++position;
+    if (position == current.size()) break;
+
+    // Changed runs are ended by at least 4 unchanged bytes, so that the
+    // lengths of a new run don't take more space than the bytes.
+    std::size_t changedStart = position;
+    std::size_t unchangedCount = 0;
+    while (position < current.size() && unchangedCount < 4) {
+      if (position < commonSize && previous[position] == current[position])
+        ++unchangedCount;
+      else
+        unchangedCount = 0;
+      ++position;
+    }
+    position -= unchangedCount;
+
+    writer.WriteUInt(changedStart - unchangedStart);
+    writer.WriteUInt(position - changedStart);
+    delta.append(current, changedStart, position - changedStart);
+  }
+}
+
+bool SceneSnapshot::ApplyDelta(const std::string& previous,
+                               const std::string& delta,
+                               std::string& current) {
+  SceneSnapshotReader reader(delta.data(), delta.size());
+  std::uint64_t size = reader.ReadUInt();
+  if (!reader.IsValid()) return false;
+
+  current.clear();
+  current.reserve(size);
+  std::size_t position = 0;  // The position of the next byte in previous.
+  while (!reader.IsAtEnd()) {
+    std::uint64_t unchangedCount = reader.ReadUInt();
+    std::uint64_t changedCount = reader.ReadUInt();
+    std::size_t remaining =
+        position < previous.size() ? previous.size() - position : 0;
+    if (!reader.IsValid() || unchangedCount > remaining) return false;
+
+    current.append(previous, position, unchangedCount);
+    if (!reader.ReadBytes(current, changedCount)) return false;
+    position += unchangedCount + changedCount;
+  }
+
+  // The bytes after the last changed run are unchanged.
+  std::size_t remaining =
+      position < previous.size() ? previous.size() - position : 0;
+  if (size < current.size() || size - current.size() > remaining)
+    return false;
+
+  if (size > current.size())
+    current.append(previous, position, size - current.size());
+  return true;
+}
@@ -0,0 +1,156 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef SCENESNAPSHOT_H
+#define SCENESNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "GDCpp/Runtime/String.h"
+namespace gd {
+class Variable;
+}
+class RuntimeVariablesContainer;
+
+/**
+ * \brief Write the state of a scene in the binary data of a snapshot.
+ *
+ * Numbers are written as varints, floating point numbers with their bytes.
+ * The data is appended to a string, that can be reused for the next snapshot
+ * to avoid allocations.
+ *
+ * \see RuntimeScene::TakeSnapshot
+ * \ingroup GameEngine
+ */
+class GD_API SceneSnapshotWriter {
+ public:
+  SceneSnapshotWriter(std::string& data_) : data(data_){};
+
+  void WriteUInt(std::uint64_t value);
+  void WriteInt(std::int64_t value);
+  void WriteFloat(float value);
+  void WriteDouble(double value);
+  void WriteBool(bool value) { data.push_back(value ? 1 : 0); }
+  void WriteString(const gd::String& value);
+
+  /**
+   * \brief Write the value of a variable, and its children if it's a
+   * structure.
+   */
+  void WriteVariable(const gd::Variable& variable);
+
+  /**
+   * \brief Write the variables of a container, with their names.
+   */
+  void WriteVariables(const RuntimeVariablesContainer& variables);
+
+  /**
+   * \brief Start a block, written with its size so that it can be skipped
+   * when it's read (see SceneSnapshotReader::ReadBlock).
+   * \return The position of the block, to give to EndBlock.
+   */
+  std::size_t BeginBlock();
+
+  /**
+   * \brief End a block started by BeginBlock.
+   */
+  void EndBlock(std::size_t block);
+
+ private:
+  std::string& data;
+};
+
+/**
+ * \brief Read the data written by a SceneSnapshotWriter.
+ *
+ * Reading past the end of the data returns zeros and empty strings, and makes
+ * the reader invalid (see IsValid).
+ *
+ * \ingroup GameEngine
+ */
+class GD_API SceneSnapshotReader {
+ public:
+  SceneSnapshotReader(const char* data_, std::size_t size_)
+      : data(data_), size(size_), position(0), valid(true){};
+
+  std::uint64_t ReadUInt();
+  std::int64_t ReadInt();
+  float ReadFloat();
+  double ReadDouble();
+  bool ReadBool();
+  gd::String ReadString();
+
+  /**
+   * \brief Append \a count bytes to \a output.
+   * \return false if there are not enough bytes.
+   */
+  bool ReadBytes(std::string& output, std::size_t count);
+
+  /**
+   * \brief Read a variable written by SceneSnapshotWriter::WriteVariable.
+   */
+  void ReadVariable(gd::Variable& variable);
+
+  /**
+   * \brief Read the variables written by SceneSnapshotWriter::WriteVariables.
+   *
+   * \note The variables of the container that were not written are kept.
+   */
+  void ReadVariables(RuntimeVariablesContainer& variables);
+
+  /**
+   * \brief Return a reader for the content of a block, and skip it.
+   */
+  SceneSnapshotReader ReadBlock();
+
+  /**
+   * \brief Return false if data was read past the end.
+   */
+  bool IsValid() const { return valid; }
+
+  /**
+   * \brief Return true if all the data was read.
+   */
+  bool IsAtEnd() const { return position >= size; }
+
+ private:
+  bool Read(void* output, std::size_t count);
+
+  const char* data;
+  std::size_t size;
+  std::size_t position;
+  bool valid;
+};
+
+/**
+ * \brief Tools to encode a snapshot as the difference with the previous one.
+ *
+ * Consecutive snapshots of a scene are mostly identical, as long as the
+ * objects are the same: the delta only stores the bytes that changed.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API SceneSnapshot {
+ public:
+  /**
+   * \brief Compute the delta to obtain \a current from \a previous, replacing
+   * the content of \a delta.
+   */
+  static void ComputeDelta(const std::string& previous,
+                           const std::string& current,
+                           std::string& delta);
+
+  /**
+   * \brief Apply a delta computed by ComputeDelta on \a previous, replacing
+   * the content of \a current.
+   * \return false if the delta is invalid.
+   */
+  static bool ApplyDelta(const std::string& previous,
+                         const std::string& delta,
+                         std::string& current);
+};
+
+#endif  // SCENESNAPSHOT_H
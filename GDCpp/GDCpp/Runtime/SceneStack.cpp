@@ -4,31 +4,84 @@
  * reserved. This project is released under the MIT License.
  */
 #include "SceneStack.h"
+#include <SFML/System.hpp>
+#include <system_error>
 #include "CodeExecutionEngine.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/JobSystem.h"
+#include "GDCpp/Runtime/Project/Object.h"
 #include "RuntimeGame.h"
 #include "RuntimeScene.h"
 #include "SceneNameMangler.h"
+#if defined(GD_IDE_ONLY)
+#include "GDCore/IDE/Project/ResourcesInUseHelper.h"
+#endif
+
+SceneStack::~SceneStack() { WaitForPreloadedLayout(); }
 
 bool SceneStack::Step() {
   if (stack.empty()) return false;
 
-  auto& scene = stack.back();
-  if (scene->RenderAndStep()) {
-    auto request = scene->GetRequestedChange();
-    if (request.change == RuntimeScene::SceneChange::STOP_GAME) {
-      return false;
-    } else if (request.change == RuntimeScene::SceneChange::POP_SCENE) {
-      Pop();
-    } else if (request.change == RuntimeScene::SceneChange::PUSH_SCENE) {
-      Push(request.requestedScene);
-    } else if (request.change == RuntimeScene::SceneChange::REPLACE_SCENE) {
-      Replace(request.requestedScene);
-    } else if (request.change == RuntimeScene::SceneChange::CLEAR_SCENES) {
-      Replace(request.requestedScene, true);
-    } else {
-      if (errorCallback) errorCallback("Unrecognized change in scene stack.");
-      return false;
-    }
+  UpdatePreloadedScene();
+
+  if (stack.back()->RenderAndStep()) return ApplyRequestedChange();
+
+  return true;
+}
+
+bool SceneStack::StepWithoutRender(signed long long elapsedTime) {
+  if (stack.empty()) return false;
+
+  if (stack.back()->StepWithoutRender(elapsedTime))
+    return ApplyRequestedChange();
+
+  return true;
+}
+
+std::vector<bool> SceneStack::StepAllWithoutRender(
+    const std::vector<SceneStack*>& stacks,
+    signed long long elapsedTime,
+    JobSystem& jobSystem) {
+  // Not a std::vector<bool>, as its elements are written by several threads.
+  std::vector<char> changeRequested(stacks.size(), false);
+  jobSystem.ParallelFor(
+      stacks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          if (stacks[i]->stack.empty()) continue;
+          changeRequested[i] =
+              stacks[i]->stack.back()->StepWithoutRender(elapsedTime);
+        }
+      });
+
+  std::vector<bool> results;
+  results.reserve(stacks.size());
+  for (std::size_t i = 0; i < stacks.size(); ++i) {
+    if (stacks[i]->stack.empty())
+      results.push_back(false);
+    else
+      results.push_back(changeRequested[i] ? stacks[i]->ApplyRequestedChange()
+                                           : true);
+  }
+
+  return results;
+}
+
+bool SceneStack::ApplyRequestedChange() {
+  // Copied, as the scene can be destroyed by the change.
+  auto request = stack.back()->GetRequestedChange();
+  if (request.change == RuntimeScene::SceneChange::STOP_GAME) {
+    return false;
+  } else if (request.change == RuntimeScene::SceneChange::POP_SCENE) {
+    Pop();
+  } else if (request.change == RuntimeScene::SceneChange::PUSH_SCENE) {
+    Push(request.requestedScene);
+  } else if (request.change == RuntimeScene::SceneChange::REPLACE_SCENE) {
+    Replace(request.requestedScene);
+  } else if (request.change == RuntimeScene::SceneChange::CLEAR_SCENES) {
+    Replace(request.requestedScene, true);
+  } else {
+    if (errorCallback) errorCallback("Unrecognized change in scene stack.");
+    return false;
   }
 
   return true;
@@ -49,8 +102,22 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
     return nullptr;
   }
 
+  // The layout is unserialized now if the game was loaded lazily (and it was
+  // not preloaded).
+  gd::Layout &layout = game.GetLayout(newSceneName);
+  if (preloadedScene) {
+    WaitForPreloadedLayout();
+    if (unloadLayouts && preloadedScene->name != newSceneName)
+      game.GetLayout(preloadedScene->name).Unload();
+    preloadedScene.reset();
+  }
+  layout.Load(game);
+  PreloadImages(layout);
+
   std::unique_ptr<RuntimeScene> newScene(new RuntimeScene(window, &game));
-  if (!newScene->LoadFromScene(game.GetLayout(newSceneName))) {
+  bool sceneLoaded = newScene->LoadFromScene(layout);
+  if (unloadLayouts) layout.Unload();
+  if (!sceneLoaded) {
     if (errorCallback)
       errorCallback("Unable to load scene \"" + newSceneName + "\".");
     return nullptr;
@@ -76,3 +143,92 @@ RuntimeScene* SceneStack::Replace(gd::String newSceneName, bool clear) {
   }
   return Push(newSceneName);
 }
+
+bool SceneStack::Preload(gd::String sceneName) {
+  if (!game.HasLayoutNamed(sceneName)) {
+    if (errorCallback)
+      errorCallback("Scene \"" + sceneName + "\" does not exist.");
+    return false;
+  }
+  if (preloadedScene && preloadedScene->name == sceneName) return true;
+
+  WaitForPreloadedLayout();
+  if (preloadedScene && unloadLayouts)
+    game.GetLayout(preloadedScene->name).Unload();
+  preloadedScene.reset(new PreloadedScene);
+  preloadedScene->name = sceneName;
+  preloadedScene->layoutLoaded = false;
+  preloadedScene->imagesPreloaded = false;
+
+  // Only the layout of the preloaded scene is modified by the thread: it's
+  // not used by the scenes being played. The images are listed once the
+  // layout is loaded.
+  gd::Layout& layout = game.GetLayout(sceneName);
+  PreloadedScene* scene = preloadedScene.get();
+  auto loadLayout = [this, &layout, scene]() {
+    layout.Load(game);
+    scene->layoutLoaded = true;
+  };
+  try {
+    preloadedScene->thread = std::thread(loadLayout);
+  } catch (const std::system_error&) {
+    loadLayout();  // Threads are not available.
+  }
+
+  return true;
+}
+
+bool SceneStack::IsPreloaded(const gd::String& sceneName) const {
+  return preloadedScene && preloadedScene->name == sceneName &&
+         preloadedScene->imagesPreloaded &&
+         game.GetImageManager()->GetPreloadingProgress() >= 1.f;
+}
+
+void SceneStack::UpdatePreloadedScene() {
+  if (!preloadedScene || !preloadedScene->layoutLoaded) return;
+
+  WaitForPreloadedLayout();
+  std::shared_ptr<gd::ImageManager> imageManager = game.GetImageManager();
+  if (!preloadedScene->imagesPreloaded) {
+    imageManager->PreloadImages(
+        GetImagesUsed(game.GetLayout(preloadedScene->name)));
+    preloadedScene->imagesPreloaded = true;
+  }
+
+  // Keep most of the frame for the current scene.
+  imageManager->UploadPreloadedImages(sf::milliseconds(2));
+}
+
+void SceneStack::WaitForPreloadedLayout() {
+  if (preloadedScene && preloadedScene->thread.joinable())
+    preloadedScene->thread.join();
+}
+
+std::set<gd::String> SceneStack::GetImagesUsed(gd::Layout& layout) {
+#if defined(GD_IDE_ONLY)
+  gd::ResourcesInUseHelper resourcesInUse;
+  for (std::size_t i = 0; i < game.GetObjectsCount(); ++i)
+    game.GetObject(i).ExposeResources(resourcesInUse);
+  for (std::size_t i = 0; i < layout.GetObjectsCount(); ++i)
+    layout.GetObject(i).ExposeResources(resourcesInUse);
+
+  return resourcesInUse.GetAllImages();
+#else
+  return std::set<gd::String>();
+#endif
+}
+
+void SceneStack::PreloadImages(gd::Layout& layout) {
+#if defined(GD_IDE_ONLY)
+  // Textures are created a bit at a time, so that a loading screen can be
+  // rendered while the other images are decoded.
+  std::shared_ptr<gd::ImageManager> imageManager = game.GetImageManager();
+  imageManager->PreloadImages(GetImagesUsed(layout));
+  while (!imageManager->UploadPreloadedImages(sf::milliseconds(10))) {
+    if (loadingProgressCallback)
+      loadingProgressCallback(imageManager->GetPreloadingProgress());
+    else
+      sf::sleep(sf::milliseconds(1));
+  }
+#endif
+}
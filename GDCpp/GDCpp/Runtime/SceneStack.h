@@ -4,11 +4,18 @@
  * reserved. This project is released under the MIT License.
  */
 #include <GDCpp/Runtime/String.h>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <set>
+#include <thread>
 #include <vector>
+class JobSystem;
 class RuntimeGame;
 class RuntimeScene;
+namespace gd {
+class Layout;
+}
 namespace sf {
 class RenderWindow;
 }
@@ -26,19 +33,55 @@ class GD_API SceneStack {
    * execute for scenes.
    */
   SceneStack(RuntimeGame &game_, sf::RenderWindow *window_)
-      : game(game_), window(window_){};
+      : game(game_), window(window_), unloadLayouts(false){};
+  ~SceneStack();
 
   /**
    * \brief Execute one step of the game.
    *
    * RuntimeScene::RenderAndStep is called on the current scene. If a scene
-   * change was requested, the stack is updated.
+   * change was requested, the stack is updated. The textures of the scene
+   * being preloaded, if any, are then created within a small time budget.
    *
    * This method is typically called in a loop until it returns false.
    * \return false if game must be stopped.
    */
   bool Step();
 
+  /**
+   * \brief Execute one step of the game without rendering it.
+   *
+   * RuntimeScene::StepWithoutRender is called on the current scene, and the
+   * stack is updated if a scene change was requested. Scenes being preloaded
+   * don't progress, as their textures are not created.
+   *
+   * \param elapsedTime The time elapsed since the last step, in microseconds.
+   * \return false if game must be stopped.
+   */
+  bool StepWithoutRender(signed long long elapsedTime);
+
+  /**
+   * \brief Execute one step of several stacks without rendering them, for
+   * example to simulate independent matches on a server.
+   *
+   * The current scenes of the stacks are stepped in parallel using the job
+   * system (their own parallel work is then done on the thread stepping
+   * them). The requested scene changes are then applied one stack after the
+   * other, as loading scenes is not thread-safe.
+   *
+   * \warning The scenes of the stacks must not share state that their events
+   * or extensions modify without synchronisation: the global variables of a
+   * game shared by the stacks, the sound manager or the fonts and resources
+   * loaders for example. Use a RuntimeGame for each stack to isolate them.
+   *
+   * \param elapsedTime The time elapsed since the last step, in microseconds.
+   * \return For each stack, false if its game must be stopped.
+   */
+  static std::vector<bool> StepAllWithoutRender(
+      const std::vector<SceneStack *> &stacks,
+      signed long long elapsedTime,
+      JobSystem &jobSystem);
+
   /**
    * \brief Stop and remove the current scene from the stack, unless there is
    * only one or zero scene in the stack.
@@ -64,6 +107,27 @@ class GD_API SceneStack {
    */
   RuntimeScene *Replace(gd::String newSceneName, bool clear = false);
 
+  /**
+   * \brief Start loading a scene while the current scene is played, so that
+   * pushing it (with Push or Replace) later is almost instant.
+   *
+   * The layout of the scene is unserialized (if the game is loaded lazily) and
+   * the images it uses are decoded in background threads, then the textures
+   * are created a bit at each Step. The preloaded scene is forgotten if
+   * another scene is pushed.
+   *
+   * \note Images are only preloaded when resources can be listed, i.e in the
+   * IDE.
+   * \return false if the scene does not exist.
+   */
+  bool Preload(gd::String sceneName);
+
+  /**
+   * \brief Return true if the scene was preloaded and all its images are
+   * loaded, so that pushing it will not stop the game.
+   */
+  bool IsPreloaded(const gd::String &sceneName) const;
+
   /**
    * \brief Set the callback called when an error occurs (loading failed...)
    */
@@ -76,10 +140,77 @@ class GD_API SceneStack {
     loadCallback = cb;
   }
 
+  /**
+   * \brief Set if the layouts of the game loaded lazily must be unloaded once
+   * a scene was loaded from them, to save memory. They are then unserialized
+   * again each time a scene is loaded from them.
+   *
+   * \see gd::Project::SetLayoutsLoadedLazily
+   */
+  void UnloadLayoutsAfterLoadingScenes(bool enable) { unloadLayouts = enable; }
+
+  /**
+   * \brief Set a function to call while the images used by a scene are
+   * preloaded, with the proportion of the images already loaded, so that a
+   * loading screen can be displayed.
+   *
+   * \note Images are only preloaded when resources can be listed, i.e in the
+   * IDE.
+   * \see gd::ImageManager::PreloadImages
+   */
+  void OnLoadingProgress(std::function<void(float)> cb) {
+    loadingProgressCallback = cb;
+  }
+
  private:
+  /**
+   * \brief Update the stack according to the change requested by the current
+   * scene.
+   * \return false if game must be stopped.
+   */
+  bool ApplyRequestedChange();
+
+  /**
+   * \brief Decode the images used by the objects of the layout (and by the
+   * global objects) in background threads, and wait for them to be loaded.
+   */
+  void PreloadImages(gd::Layout &layout);
+
+  /**
+   * \brief Return the images used by the objects of the layout and by the
+   * global objects (only in the IDE: resources can't be listed otherwise).
+   */
+  std::set<gd::String> GetImagesUsed(gd::Layout &layout);
+
+  /**
+   * \brief Continue to preload the scene given to Preload, once its layout
+   * is loaded.
+   */
+  void UpdatePreloadedScene();
+
+  /**
+   * \brief Wait for the end of the work of the background thread of the
+   * scene being preloaded.
+   */
+  void WaitForPreloadedLayout();
+
+  /**
+   * \brief The scene being preloaded.
+   */
+  struct PreloadedScene {
+    gd::String name;
+    std::thread thread;  ///< Load the layout in the background.
+    std::atomic<bool> layoutLoaded;
+    bool imagesPreloaded;  ///< True once the images are given to the
+                           ///< gd::ImageManager.
+  };
+
   RuntimeGame &game;
   sf::RenderWindow *window;
+  bool unloadLayouts;  ///< True to unload the layouts once a scene is loaded.
   std::vector<std::unique_ptr<RuntimeScene>> stack;
   std::function<void(gd::String)> errorCallback;
   std::function<bool(RuntimeScene &)> loadCallback;
+  std::function<void(float)> loadingProgressCallback;
+  std::unique_ptr<PreloadedScene> preloadedScene;
 };
@@ -0,0 +1,48 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ScratchArena.h"
+#include <algorithm>
+#include <cstdint>
+
+ScratchArena::ScratchArena(std::size_t blockSize_)
+    : currentBlock(0),
+      currentOffset(0),
+      blockSize(blockSize_ > 0 ? blockSize_ : 64 * 1024) {}
+
+void *ScratchArena::Allocate(std::size_t size, std::size_t alignment) {
+  if (size == 0) size = 1;
+
+  for (; currentBlock < blocks.size(); ++currentBlock, currentOffset = 0) {
+    Block &block = blocks[currentBlock];
+    std::uintptr_t start =
+        reinterpret_cast<std::uintptr_t>(block.data.get()) + currentOffset;
+    std::size_t padding = (alignment - start % alignment) % alignment;
+
+    if (currentOffset + padding + size <= block.size) {
+      void *memory = block.data.get() + currentOffset + padding;
+      currentOffset += padding + size;
+      return memory;
+    }
+  }
+
+  // No block is large enough: create a new one at the end, doubling the
+  // capacity of the arena so that few blocks are needed after a few frames.
+  Block block;
+  block.size = std::max(std::max(blockSize, size + alignment), GetCapacity());
+  block.data.reset(new char[block.size]);
+  blocks.push_back(std::move(block));
+
+  currentBlock = blocks.size() - 1;
+  currentOffset = 0;
+  return Allocate(size, alignment);
+}
+
+std::size_t ScratchArena::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (const Block &block : blocks) capacity += block.size;
+
+  return capacity;
+}
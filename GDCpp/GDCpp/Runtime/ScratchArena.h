@@ -0,0 +1,111 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * \brief A bump allocator for temporary buffers, reset at the end of each
+ * frame.
+ *
+ * Memory is allocated from blocks that are kept when the arena is reset or
+ * rewound, so that once the blocks are large enough for a frame, no more heap
+ * allocations are made.
+ *
+ * \warning Memory returned by the arena is not initialized and destructors
+ * are never called: only use it for trivial types (pointers, numbers, flags).
+ *
+ * \see RuntimeScene::GetScratchArena
+ * \ingroup GameEngine
+ */
+class GD_API ScratchArena {
+ public:
+  /**
+   * \brief A position in the arena, used to free at once the memory allocated
+   * after it.
+   */
+  struct Marker {
+    std::size_t blockIndex;
+    std::size_t offset;
+  };
+
+  /**
+   * \brief Rewind the arena to its state at the construction of the scope
+   * when the scope is destroyed.
+   */
+  class Scope {
+   public:
+    Scope(ScratchArena &arena_) : arena(arena_), marker(arena_.GetMarker()) {}
+    ~Scope() { arena.Rewind(marker); }
+
+   private:
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    ScratchArena &arena;
+    Marker marker;
+  };
+
+  ScratchArena(std::size_t blockSize = 64 * 1024);
+  virtual ~ScratchArena(){};
+
+  /**
+   * \brief Allocate \a size bytes aligned on \a alignment (which must be a
+   * power of two).
+   */
+  void *Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * \brief Allocate an array of \a count elements of type T.
+   * \note The elements are not initialized.
+   */
+  template <typename T>
+  T *AllocateArray(std::size_t count) {
+    return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  /**
+   * \brief Get the current position in the arena.
+   */
+  Marker GetMarker() const { return Marker{currentBlock, currentOffset}; }
+
+  /**
+   * \brief Free all the memory allocated since \a marker was got.
+   */
+  void Rewind(const Marker &marker) {
+    currentBlock = marker.blockIndex;
+    currentOffset = marker.offset;
+  }
+
+  /**
+   * \brief Free all the memory allocated from the arena. Blocks are kept to
+   * be reused.
+   */
+  void Reset() { Rewind(Marker{0, 0}); }
+
+  /**
+   * \brief Return the total size of the blocks allocated by the arena, in
+   * bytes.
+   */
+  std::size_t GetCapacity() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  std::vector<Block> blocks;
+  std::size_t currentBlock;   ///< The block used for the next allocations.
+  std::size_t currentOffset;  ///< The first free byte in the current block.
+  std::size_t blockSize;      ///< The default size of new blocks.
+};
+
+#endif  // SCRATCHARENA_H
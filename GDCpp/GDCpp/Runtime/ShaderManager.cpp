@@ -1,4 +1,5 @@
 #include "ShaderManager.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include "GDCpp/Runtime/ResourcesLoader.h"
@@ -9,14 +10,41 @@ ShaderManager::ShaderManager() {}
 
 std::shared_ptr<sf::Shader> ShaderManager::GetSFMLShader(
     const std::vector<gd::String>& shaders) {
-  if (alreadyLoadedShader.find(shaders) != alreadyLoadedShader.end())
-    return alreadyLoadedShader[shaders].lock();
+  auto sourceIt = mergedSources.find(shaders);
+  if (sourceIt == mergedSources.end())
+    sourceIt =
+        mergedSources.insert(std::make_pair(shaders, MergeShaders(shaders)))
+            .first;
 
-  // Loading a new (compilation of) shader(s)
-  std::vector<gd::String> declarations;
-  gd::String mainFunctions;
+  // Different files can give the same source: the shader is compiled once.
+  const std::string& shaderSource = sourceIt->second.Raw();
+  std::weak_ptr<sf::Shader>& loadedShader = alreadyLoadedShader[shaderSource];
+  if (std::shared_ptr<sf::Shader> shader = loadedShader.lock()) return shader;
 
   std::shared_ptr<sf::Shader> shader(new sf::Shader);
+  shader->loadFromMemory(shaderSource, sf::Shader::Fragment);
+  shadersParameters.erase(shader.get());  // In case of a destroyed shader
+                                          // with the same address.
+  loadedShader = shader;
+
+  return shader;
+}
+
+void ShaderManager::SetParameters(
+    sf::Shader& shader, const std::map<gd::String, float>& parameters) {
+  std::map<gd::String, float>& lastParameters = shadersParameters[&shader];
+  for (auto& parameter : parameters) {
+    auto it = lastParameters.find(parameter.first);
+    if (it != lastParameters.end() && it->second == parameter.second) continue;
+
+    shader.setUniform(parameter.first.ToLocale(), parameter.second);
+    lastParameters[parameter.first] = parameter.second;
+  }
+}
+
+gd::String ShaderManager::MergeShaders(const std::vector<gd::String>& shaders) {
+  std::vector<gd::String> declarations;
+  gd::String mainFunctions;
 
   for (std::size_t i = 0; i < shaders.size(); ++i) {
     gd::String file = gd::ResourcesLoader::Get()->LoadPlainText(shaders[i]);
@@ -48,10 +76,6 @@ std::shared_ptr<sf::Shader> ShaderManager::GetSFMLShader(
   for (std::size_t i = 0; i < declarations.size(); ++i)
     shaderSource += declarations[i];
   shaderSource += "\nvoid main()\n{" + mainFunctions + "}";
-  std::cout << "ShaderSource:" << shaderSource << std::endl;
-  shader->loadFromMemory(shaderSource.c_str(), sf::Shader::Fragment);
-
-  alreadyLoadedShader[shaders] = shader;
 
-  return shader;
+  return shaderSource;
 }
@@ -8,6 +8,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 #include "GDCpp/Runtime/String.h"
@@ -19,6 +21,11 @@ class Project;
 /**
  * \brief Still work in progress class to manage shaders
  *
+ * Shaders are compiled once for all the requests resulting in the same
+ * source, and the parameters sent to a shader are only the ones that
+ * changed, so that layers using the same effect with the same parameters
+ * share the state of the shader.
+ *
  * \todo Unfinished class.
  *
  * \ingroup GameEngine
@@ -28,12 +35,34 @@ class ShaderManager {
   ShaderManager();
   virtual ~ShaderManager(){};
 
+  /**
+   * \brief Return the fragment shader made by merging the shaders of the
+   * files. The shader is kept as long as a shared pointer to it is kept.
+   */
   std::shared_ptr<sf::Shader> GetSFMLShader(
       const std::vector<gd::String>& shaders);
 
+  /**
+   * \brief Set the parameters of the shader, only sending to the GPU the
+   * ones that changed since the last call for this shader.
+   */
+  void SetParameters(sf::Shader& shader,
+                     const std::map<gd::String, float>& parameters);
+
  private:
-  mutable std::map<std::vector<gd::String>, std::weak_ptr<sf::Shader> >
-      alreadyLoadedShader;
+  /**
+   * \brief Return the source of the shader made by merging the shaders of
+   * the files: their declarations, then their main functions.
+   */
+  static gd::String MergeShaders(const std::vector<gd::String>& shaders);
+
+  std::map<std::vector<gd::String>, gd::String>
+      mergedSources;  ///< The source of the shader made from each list of
+                      ///< files.
+  std::unordered_map<std::string, std::weak_ptr<sf::Shader> >
+      alreadyLoadedShader;  ///< The shaders, by their source.
+  std::map<const sf::Shader*, std::map<gd::String, float> >
+      shadersParameters;  ///< The last parameters set for each shader.
 };
 
 #endif  // SHADERMANAGER_H
@@ -13,16 +13,39 @@
 
 using namespace std;
 
-Sound::Sound(gd::String pFile) : file(pFile), volume(100) {
-  buffer = gd::ResourcesLoader::Get()->LoadSoundBuffer(file);
-  sound.setBuffer(buffer);
+Sound::Sound(gd::String pFile)
+    : buffer(std::make_shared<sf::SoundBuffer>(
+          gd::ResourcesLoader::Get()->LoadSoundBuffer(pFile))),
+      file(pFile),
+      volume(100) {
+  sound.setBuffer(*buffer);
 }
 
-Sound::Sound() : volume(100) { sound.setBuffer(buffer); }
+Sound::Sound(const gd::String& pFile, std::shared_ptr<sf::SoundBuffer> buffer_)
+    : buffer(buffer_), file(pFile), volume(100) {
+  sound.setBuffer(*buffer);
+}
+
+Sound::Sound()
+    : buffer(std::make_shared<sf::SoundBuffer>()), volume(100) {
+  sound.setBuffer(*buffer);
+}
+
+Sound::Sound(const Sound& copy)
+    : buffer(copy.buffer), file(copy.file), volume(copy.volume) {
+  sound.setBuffer(*buffer);
+}
+
+void Sound::SetBuffer(const gd::String& pFile,
+                      std::shared_ptr<sf::SoundBuffer> buffer_) {
+  sound.stop();
+  if (buffer_)
+    sound.setBuffer(*buffer_);
+  else
+    sound.resetBuffer();
 
-Sound::Sound(const Sound& copy) : file(copy.file) {
-  buffer = gd::ResourcesLoader::Get()->LoadSoundBuffer(file);
-  sound.setBuffer(buffer);
+  buffer = buffer_;  // The previous buffer is released after being detached.
+  file = pFile;
 }
 
 void Sound::SetVolume(float volume_, float globalVolume) {
@@ -6,6 +6,7 @@
 #ifndef SOUND_H
 #define SOUND_H
 #include <SFML/Audio.hpp>
+#include <memory>
 #include "GDCpp/Runtime/String.h"
 
 /**
@@ -18,9 +19,23 @@ class GD_API Sound : sf::NonCopyable {
  public:
   Sound();
   Sound(gd::String file);
+
+  /**
+   * \brief Create a sound playing \a buffer, which can be shared with other
+   * sounds (see SoundManager::GetSoundBuffer).
+   */
+  Sound(const gd::String& file, std::shared_ptr<sf::SoundBuffer> buffer);
   Sound(const Sound& copy);
   virtual ~Sound(){};
 
+  /**
+   * \brief Stop the sound and change the buffer it plays, so that the sound
+   * can be reused to play another file.
+   * \param buffer The new buffer, or nullptr to only release the buffer.
+   */
+  void SetBuffer(const gd::String& file,
+                 std::shared_ptr<sf::SoundBuffer> buffer);
+
   /**
    * \brief Get the sound status
    * \return sf::Music::Paused, sf::Music::Playing or sf::Music::Stopped.
@@ -64,7 +79,8 @@ class GD_API Sound : sf::NonCopyable {
   };
 
   // Order is important :
-  sf::SoundBuffer buffer;
+  std::shared_ptr<sf::SoundBuffer>
+      buffer;  ///< The buffer played, possibly shared with other sounds.
   sf::Sound sound;
 
   gd::String file;
@@ -4,16 +4,162 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCpp/Runtime/SoundManager.h"
+#include <algorithm>
+#include <condition_variable>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
+#include "GDCore/Tools/SystemStats.h"
 #include "GDCpp/Runtime/Music.h"
 #include "GDCpp/Runtime/Project/ResourcesManager.h"
 #include "GDCpp/Runtime/ResourcesLoader.h"
 #include "GDCpp/Runtime/Sound.h"
 #include "GDCpp/Runtime/String.h"
 
-SoundManager::SoundManager() : globalVolume(100), resourcesManager(nullptr) {}
+namespace {
+/**
+ * \brief Open a music from the resource file (without copying it) or from
+ * its file.
+ */
+void OpenMusic(Music& music, const gd::String& file) {
+#if !defined(GD_IDE_ONLY)
+  std::size_t size = 0;
+  const char* data = gd::ResourcesLoader::Get()->GetMappedFile(file, size);
+  if (data) {
+    music.OpenFromMemory(data, size);
+    return;
+  }
+#endif
+  music.OpenFromFile(file);
+}
+
+/**
+ * \brief Read the content of a music of the resource file, so that it's in
+ * memory when the music is streamed.
+ */
+void ReadAheadMusic(const gd::String& file) {
+#if !defined(GD_IDE_ONLY)
+  std::size_t size = 0;
+  const char* data = gd::ResourcesLoader::Get()->GetMappedFile(file, size);
+  if (!data) return;
+
+  // Reading a byte of each page is enough to load the page in memory.
+  volatile char sum = 0;
+  for (std::size_t i = 0; i < size; i += 4096) sum = sum + data[i];
+#endif
+}
+}  // namespace
+
+/**
+ * \brief Open the musics to prefetch on a dedicated thread, and hold them
+ * until they are played.
+ *
+ * If the thread can't be started, musics are opened when they are played.
+ */
+class SoundManager::MusicPrefetcher {
+ public:
+  MusicPrefetcher() : stopping(false), threadStarted(false) {}
+  ~MusicPrefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    condition.notify_all();
+    if (thread.joinable()) thread.join();
+  }
+
+  void Prefetch(const gd::String& file) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (musics.find(file) != musics.end()) return;
+
+    PrefetchedMusic& prefetched = musics[file];
+    prefetched.music = std::make_shared<Music>();
+    prefetched.opened = false;
+    queue.push_back(file);
+
+    if (!threadStarted) {
+      threadStarted = true;
+      gd::ResourcesLoader::Get();  // Created before being used by the thread.
+      try {
+        thread = std::thread(&MusicPrefetcher::OpenMusics, this);
+      } catch (const std::system_error&) {
+      }
+    }
+    condition.notify_all();
+  }
+
+  /**
+   * \brief Return the music prefetched for \a file, once opened, or nullptr
+   * if the music was not prefetched.
+   */
+  std::shared_ptr<Music> Take(const gd::String& file) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = musics.find(file);
+    if (it == musics.end()) return nullptr;
+
+    std::shared_ptr<Music> music = it->second.music;
+    auto queued = std::find(queue.begin(), queue.end(), file);
+    if (queued != queue.end()) {
+      // Not opened by the thread yet: open it now rather than waiting.
+      queue.erase(queued);
+      musics.erase(it);
+      lock.unlock();
+      OpenMusic(*music, file);
+      return music;
+    }
+
+    condition.wait(lock, [&it]() { return it->second.opened; });
+    musics.erase(it);
+    return music;
+  }
+
+ private:
+  struct PrefetchedMusic {
+    std::shared_ptr<Music> music;
+    bool opened;
+  };
+
+  void OpenMusics() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      condition.wait(lock, [this]() { return stopping || !queue.empty(); });
+      if (stopping) return;
+
+      gd::String file = queue.front();
+      queue.pop_front();
+      std::shared_ptr<Music> music = musics[file].music;
+
+      lock.unlock();
+      OpenMusic(*music, file);
+      ReadAheadMusic(file);
+      lock.lock();
+
+      musics[file].opened = true;
+      condition.notify_all();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::map<gd::String, PrefetchedMusic> musics;
+  std::list<gd::String> queue;  ///< The musics to be opened by the thread.
+  bool stopping;
+  bool threadStarted;
+  std::thread thread;
+};
+
+SoundManager::SoundManager()
+    : maximumCachedSoundBuffersCount(32),
+      maximumSoundsCount(64),
+      musicPrefetcher(new MusicPrefetcher),
+      globalVolume(100),
+      resourcesManager(nullptr) {}
+
+SoundManager::~SoundManager() {}
 
 const gd::String& SoundManager::GetFileFromSoundName(
     const gd::String& name) const {
@@ -22,13 +168,92 @@ const gd::String& SoundManager::GetFileFromSoundName(
   return resourcesManager->GetResource(name).GetFile();
 }
 
+std::shared_ptr<sf::SoundBuffer> SoundManager::GetSoundBuffer(
+    const gd::String& file) {
+  auto it = soundBuffers.find(file);
+  if (it != soundBuffers.end()) {
+    soundBuffersUsage.splice(
+        soundBuffersUsage.begin(), soundBuffersUsage, it->second.usage);
+    return it->second.buffer;
+  }
+
+  CachedSoundBuffer& cached = soundBuffers[file];
+  sf::SoundBuffer* soundBuffer =
+      new sf::SoundBuffer(gd::ResourcesLoader::Get()->LoadSoundBuffer(file));
+
+  // The samples are accounted until the last sound using them is destroyed.
+  std::size_t bytes = soundBuffer->getSampleCount() * sizeof(sf::Int16);
+  gd::SystemStats::AddUsedMemory(gd::SystemStats::Sounds, bytes);
+  cached.buffer = std::shared_ptr<sf::SoundBuffer>(
+      soundBuffer, [bytes](sf::SoundBuffer* soundBuffer) {
+        gd::SystemStats::RemoveUsedMemory(gd::SystemStats::Sounds, bytes);
+        delete soundBuffer;
+      });
+  soundBuffersUsage.push_front(file);
+  cached.usage = soundBuffersUsage.begin();
+
+  std::shared_ptr<sf::SoundBuffer> buffer = cached.buffer;
+  RemoveExtraSoundBuffers();
+  return buffer;
+}
+
+void SoundManager::SetMaximumCachedSoundBuffersCount(std::size_t count) {
+  maximumCachedSoundBuffersCount = count;
+  RemoveExtraSoundBuffers();
+}
+
+void SoundManager::RemoveExtraSoundBuffers() {
+  // Buffers still played by sounds are only freed when the sounds release
+  // them.
+  while (soundBuffers.size() > maximumCachedSoundBuffersCount &&
+         !soundBuffersUsage.empty()) {
+    soundBuffers.erase(soundBuffersUsage.back());
+    soundBuffersUsage.pop_back();
+  }
+}
+
+std::shared_ptr<Sound> SoundManager::AcquireSound(const gd::String& file) {
+  std::shared_ptr<sf::SoundBuffer> buffer = GetSoundBuffer(file);
+
+  std::shared_ptr<Sound> sound;
+  if (sounds.size() >= maximumSoundsCount) {
+    // All voices are used: steal the first stopped one, or the oldest sound
+    // not repeated, or the oldest sound.
+    auto stolen = std::find_if(
+        sounds.begin(), sounds.end(), [](const std::shared_ptr<Sound>& sound) {
+          return sound->GetStatus() == sf::Sound::Stopped;
+        });
+    if (stolen == sounds.end())
+      stolen = std::find_if(sounds.begin(),
+                            sounds.end(),
+                            [](const std::shared_ptr<Sound>& sound) {
+                              return !sound->sound.getLoop();
+                            });
+    if (stolen == sounds.end()) stolen = sounds.begin();
+
+    sound = *stolen;
+    sounds.erase(stolen);
+  } else if (!freeSounds.empty()) {
+    sound = freeSounds.back();
+    freeSounds.pop_back();
+  }
+
+  if (sound)
+    sound->SetBuffer(file, buffer);
+  else
+    sound = std::make_shared<Sound>(file, buffer);
+
+  return sound;
+}
+
 void SoundManager::PlaySoundOnChannel(const gd::String& name,
                                       unsigned int channel,
                                       bool repeat,
                                       float volume,
                                       float pitch) {
+  const gd::String& file = GetFileFromSoundName(name);
   std::shared_ptr<Sound> sound =
-      std::make_shared<Sound>(GetFileFromSoundName(name));
+      std::make_shared<Sound>(file, GetSoundBuffer(file));
   sound->sound.play();
   sound->sound.setRelativeToListener(true);
 
@@ -42,8 +267,7 @@ void SoundManager::PlaySound(const gd::String& name,
                              bool repeat,
                              float volume,
                              float pitch) {
-  sounds.push_back(
-      std::shared_ptr<Sound>(new Sound(GetFileFromSoundName(name))));
+  sounds.push_back(AcquireSound(GetFileFromSoundName(name)));
   sounds.back()->sound.play();
   sounds.back()->sound.setRelativeToListener(true);
 
@@ -52,23 +276,25 @@ void SoundManager::PlaySound(const gd::String& name,
   sounds.back()->SetPitch(pitch);
 }
 
+std::shared_ptr<Music> SoundManager::TakeMusic(const gd::String& file) {
+  std::shared_ptr<Music> music = musicPrefetcher->Take(file);
+  if (!music) {
+    music = std::make_shared<Music>();
+    OpenMusic(*music, file);
+  }
+
+  return music;
+}
+
+void SoundManager::PrefetchMusic(const gd::String& name) {
+  musicPrefetcher->Prefetch(GetFileFromSoundName(name));
+}
+
 void SoundManager::PlayMusic(const gd::String& name,
                              bool repeat,
                              float volume,
                              float pitch) {
-  const gd::String& file = GetFileFromSoundName(name);
-  std::shared_ptr<Music> music(new Music);
-#if !defined(GD_IDE_ONLY)
-  gd::ResourcesLoader* ressourcesLoader = gd::ResourcesLoader::Get();
-  if (ressourcesLoader->HasFile(file)) {
-    std::size_t size = ressourcesLoader->GetBinaryFileSize(file);
-    music->SetBuffer(ressourcesLoader->LoadBinaryFile(file), size);
-    music->OpenFromMemory(size);
-  } else
-#endif
-  {
-    music->OpenFromFile(file);
-  }
+  std::shared_ptr<Music> music = TakeMusic(GetFileFromSoundName(name));
 
   musics.push_back(music);
   musics.back()->music.setRelativeToListener(true);
@@ -84,19 +310,7 @@ void SoundManager::PlayMusicOnChannel(const gd::String& name,
                                       bool repeat,
                                       float volume,
                                       float pitch) {
-  const gd::String& file = GetFileFromSoundName(name);
-  std::shared_ptr<Music> music(new Music);
-#if !defined(GD_IDE_ONLY)
-  gd::ResourcesLoader* ressourcesLoader = gd::ResourcesLoader::Get();
-  if (ressourcesLoader->HasFile(file)) {
-    std::size_t size = ressourcesLoader->GetBinaryFileSize(file);
-    music->SetBuffer(ressourcesLoader->LoadBinaryFile(file), size);
-    music->OpenFromMemory(size);
-  } else
-#endif
-  {
-    music->OpenFromFile(file);
-  }
+  std::shared_ptr<Music> music = TakeMusic(GetFileFromSoundName(name));
 
   SetMusicOnChannel(channel, music);
   music->music.setRelativeToListener(true);
@@ -108,15 +322,30 @@ void SoundManager::PlayMusicOnChannel(const gd::String& name,
 }
 
 void SoundManager::ManageGarbage() {
+  // Compact the sounds in a single pass, keeping them in the order they were
+  // played. Stopped sounds that are not used elsewhere are kept to be reused.
+  std::size_t kept = 0;
   for (std::size_t i = 0; i < sounds.size(); i++) {
-    if (sounds[i]->sound.getStatus() == sf::Sound::Stopped)
-      sounds.erase(sounds.begin() + i);
+    if (sounds[i]->sound.getStatus() == sf::Sound::Stopped) {
+      if (sounds[i].use_count() == 1 &&
+          freeSounds.size() < maximumSoundsCount) {
+        sounds[i]->SetBuffer("", nullptr);
+        freeSounds.push_back(std::move(sounds[i]));
+      }
+    } else {
+      if (kept != i) sounds[kept] = std::move(sounds[i]);
+      kept++;
+    }
   }
+  sounds.resize(kept);
 
-  for (std::size_t i = 0; i < musics.size(); i++) {
-    if (musics[i]->GetStatus() == sf::Music::Stopped)
-      musics.erase(musics.begin() + i);
-  }
+  musics.erase(
+      std::remove_if(musics.begin(),
+                     musics.end(),
+                     [](const std::shared_ptr<Music>& music) {
+                       return music->GetStatus() == sf::Music::Stopped;
+                     }),
+      musics.end());
 }
 
 std::shared_ptr<Music>& SoundManager::GetMusicOnChannel(int channel) {
@@ -7,6 +7,7 @@
 #define SOUNDMANAGER_H
 
 #include <SFML/Audio.hpp>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -23,6 +24,17 @@ using namespace std;
 /**
  * \brief Manage sounds and musics played by games.
  *
+ * Sounds played without channels are voices of a pool of at most
+ * GetMaximumSoundsCount() sounds: stopped sounds are reused, and when all
+ * voices are playing, the oldest sound which is not repeated (or else the
+ * oldest sound) is stopped to play the new one. The decoded buffers of the
+ * sounds are shared by the voices and the last used ones are kept in a cache,
+ * so that playing a sound again does not load it again.
+ *
+ * Musics are streamed (from the resource file, when the game has one, without
+ * copying them) and can be prefetched on a dedicated thread with
+ * PrefetchMusic.
+ *
  * \see Sound
  * \see Music
  *
@@ -31,7 +43,7 @@ using namespace std;
 class GD_API SoundManager {
  public:
   SoundManager();
-  ~SoundManager(){};
+  ~SoundManager();
 
   /**
    * \brief Set the gd::ResourcesManager used by the SoundManager.
@@ -41,7 +53,8 @@ class GD_API SoundManager {
   }
 
   vector<std::shared_ptr<Music> > musics;
-  vector<std::shared_ptr<Sound> > sounds;
+  vector<std::shared_ptr<Sound> >
+      sounds;  ///< The sounds without channels, from the oldest to the newest.
 
   /**
    * \brief Play a sound (wav files).
@@ -67,6 +80,17 @@ class GD_API SoundManager {
                  float volume,
                  float pitch);
 
+  /**
+   * \brief Open a music (ogg files) and read its content on a dedicated
+   * thread, so that playing it later with PlayMusic or PlayMusicOnChannel
+   * does not stall the game.
+   *
+   * The prefetched music is kept (even when sounds and musics are cleared)
+   * until it's played.
+   * \param file The resource name, or filename to load.
+   */
+  void PrefetchMusic(const gd::String& name);
+
   /**
    * \brief Play a sound (wav files) on a channel.
    * \param file The resource name, or filename to load.
@@ -134,17 +158,73 @@ class GD_API SoundManager {
     musicsChannel.clear();
     soundsChannel.clear();
     sounds.clear();
+    freeSounds.clear();
     musics.clear();
   }
 
   /**
    * Ensure sounds and musics without channels and stopped are destroyed.
+   * Stopped sounds are kept to be reused by the next sounds played.
    */
   void ManageGarbage();
 
+  /**
+   * \brief Return the decoded buffer of a sound file, loading it if it's not
+   * in the cache of the last used buffers.
+   */
+  std::shared_ptr<sf::SoundBuffer> GetSoundBuffer(const gd::String& file);
+
+  /**
+   * \brief Change the maximum number of sounds played at the same time
+   * without channels (64 by default).
+   */
+  void SetMaximumSoundsCount(std::size_t count) {
+    maximumSoundsCount = count > 0 ? count : 1;
+  }
+  std::size_t GetMaximumSoundsCount() const { return maximumSoundsCount; }
+
+  /**
+   * \brief Change the maximum number of sound buffers kept in the cache when
+   * they are not played anymore (32 by default).
+   */
+  void SetMaximumCachedSoundBuffersCount(std::size_t count);
+  std::size_t GetMaximumCachedSoundBuffersCount() const {
+    return maximumCachedSoundBuffersCount;
+  }
+
  private:
   const gd::String& GetFileFromSoundName(const gd::String& name) const;
 
+  /**
+   * \brief Return a sound to play \a file: a stopped sound of the pool, or the
+   * sound stolen from the oldest voice if all voices are playing.
+   * The sound is not added to SoundManager::sounds.
+   */
+  std::shared_ptr<Sound> AcquireSound(const gd::String& file);
+
+  /**
+   * \brief Return the music prefetched for \a file, or open it.
+   */
+  std::shared_ptr<Music> TakeMusic(const gd::String& file);
+  void RemoveExtraSoundBuffers();
+
+  struct CachedSoundBuffer {
+    std::shared_ptr<sf::SoundBuffer> buffer;
+    std::list<gd::String>::iterator usage;
+  };
+  std::map<gd::String, CachedSoundBuffer> soundBuffers;
+  std::list<gd::String>
+      soundBuffersUsage;  ///< Files of the buffers, most recently used first.
+  std::size_t maximumCachedSoundBuffersCount;
+
+  std::vector<std::shared_ptr<Sound> >
+      freeSounds;  ///< Stopped sounds, without buffers, ready to be reused.
+  std::size_t maximumSoundsCount;
+
+  class MusicPrefetcher;
+  std::unique_ptr<MusicPrefetcher>
+      musicPrefetcher;  ///< Open the musics to prefetch on its thread.
+
   std::map<std::size_t, std::shared_ptr<Sound> > soundsChannel;
   std::map<std::size_t, std::shared_ptr<Music> > musicsChannel;
 
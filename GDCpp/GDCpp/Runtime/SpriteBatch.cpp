@@ -0,0 +1,101 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/SpriteBatch.h"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+SpriteBatch::SpriteBatch()
+    : vertices(sf::Triangles), texture(NULL), drawCallsCount(0) {}
+
+void SpriteBatch::Add(sf::RenderTarget& target,
+                      const sf::Sprite& sprite,
+                      const sf::BlendMode& blendMode_) {
+  const sf::Texture* spriteTexture = sprite.getTexture();
+  if (!spriteTexture) return;  // SFML does not draw sprites without texture.
+
+  if (vertices.getVertexCount() != 0 &&
+      (spriteTexture != texture || blendMode_ != blendMode))
+    Flush(target);
+
+  texture = spriteTexture;
+  blendMode = blendMode_;
+
+  // Compute the vertices the same way as sf::Sprite, but in world coordinates.
+  const sf::Transform& transform = sprite.getTransform();
+  const sf::IntRect& textureRect = sprite.getTextureRect();
+  sf::FloatRect bounds = sprite.getLocalBounds();
+  const sf::Color& color = sprite.getColor();
+
+  float left = static_cast<float>(textureRect.left);
+  float right = left + textureRect.width;
+  float top = static_cast<float>(textureRect.top);
+  float bottom = top + textureRect.height;
+
+  sf::Vertex topLeft(transform.transformPoint(0, 0), color, {left, top});
+  sf::Vertex topRight(
+      transform.transformPoint(bounds.width, 0), color, {right, top});
+  sf::Vertex bottomRight(transform.transformPoint(bounds.width, bounds.height),
+                         color,
+                         {right, bottom});
+  sf::Vertex bottomLeft(
+      transform.transformPoint(0, bounds.height), color, {left, bottom});
+
+  vertices.append(topLeft);
+  vertices.append(topRight);
+  vertices.append(bottomLeft);
+  vertices.append(topRight);
+  vertices.append(bottomRight);
+  vertices.append(bottomLeft);
+}
+
+void SpriteBatch::Add(sf::RenderTarget& target,
+                      const sf::Texture& texture_,
+                      const std::vector<sf::Vertex>& triangles,
+                      const sf::Transform& transform,
+                      const sf::Color& color,
+                      const sf::BlendMode& blendMode_) {
+  Add(target,
+      texture_,
+      triangles.data(),
+      triangles.size(),
+      transform,
+      color,
+      blendMode_);
+}
+
+void SpriteBatch::Add(sf::RenderTarget& target,
+                      const sf::Texture& texture_,
+                      const sf::Vertex* triangles,
+                      std::size_t count,
+                      const sf::Transform& transform,
+                      const sf::Color& color,
+                      const sf::BlendMode& blendMode_) {
+  if (vertices.getVertexCount() != 0 &&
+      (&texture_ != texture || blendMode_ != blendMode))
+    Flush(target);
+
+  texture = &texture_;
+  blendMode = blendMode_;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const sf::Vertex& vertex = triangles[i];
+    vertices.append(sf::Vertex(transform.transformPoint(vertex.position),
+                               color * vertex.color,
+                               vertex.texCoords));
+  }
+}
+
+void SpriteBatch::Flush(sf::RenderTarget& target) {
+  if (vertices.getVertexCount() == 0) return;
+
+  sf::RenderStates states(blendMode);
+  states.texture = texture;
+  target.draw(vertices, states);
+  drawCallsCount++;
+
+  vertices.clear();
+}
@@ -0,0 +1,93 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <cstddef>
+#include <vector>
+namespace sf {
+class RenderTarget;
+class Sprite;
+class Texture;
+class Transform;
+}
+
+/**
+ * \brief Accumulate sprites sharing the same texture and blend mode, so that
+ * they are drawn with a single draw call.
+ *
+ * Sprites are drawn in the order they were added: adding a sprite using
+ * another texture (or blend mode) first flushes the sprites accumulated so
+ * far.
+ *
+ * \see RuntimeObject::DrawBatched
+ * \ingroup GameEngine
+ */
+class GD_API SpriteBatch {
+ public:
+  SpriteBatch();
+  virtual ~SpriteBatch(){};
+
+  /**
+   * \brief Add a sprite to the batch. The batch is flushed before if the
+   * sprite can't be drawn with the sprites already in the batch.
+   */
+  void Add(sf::RenderTarget& target,
+           const sf::Sprite& sprite,
+           const sf::BlendMode& blendMode);
+
+  /**
+   * \brief Add triangles to the batch, moved by \a transform and with the
+   * color \a color. The batch is flushed before if the triangles can't be
+   * drawn with the sprites already in the batch.
+   */
+  void Add(sf::RenderTarget& target,
+           const sf::Texture& texture,
+           const std::vector<sf::Vertex>& triangles,
+           const sf::Transform& transform,
+           const sf::Color& color,
+           const sf::BlendMode& blendMode);
+
+  /**
+   * \brief Add \a count vertices of triangles to the batch.
+   * \see Add
+   */
+  void Add(sf::RenderTarget& target,
+           const sf::Texture& texture,
+           const sf::Vertex* triangles,
+           std::size_t count,
+           const sf::Transform& transform,
+           const sf::Color& color,
+           const sf::BlendMode& blendMode);
+
+  /**
+   * \brief Draw the sprites accumulated in the batch, and empty it.
+   * \note Must be called before drawing anything else than sprites, and when
+   * the rendering of a layer/camera is done.
+   */
+  void Flush(sf::RenderTarget& target);
+
+  /**
+   * \brief Return the number of draw calls made since the last call to
+   * ResetStatistics.
+   */
+  std::size_t GetDrawCallsCount() const { return drawCallsCount; }
+
+  /**
+   * \brief Reset the count of draw calls.
+   */
+  void ResetStatistics() { drawCallsCount = 0; }
+
+ private:
+  sf::VertexArray vertices;    ///< The vertices of the sprites to be drawn.
+  const sf::Texture* texture;  ///< The texture shared by the sprites.
+  sf::BlendMode blendMode;     ///< The blend mode shared by the sprites.
+  std::size_t drawCallsCount;
+};
+
+#endif  // SPRITEBATCH_H
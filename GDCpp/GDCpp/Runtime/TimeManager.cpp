@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "TimeManager.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
 
 void TimeManager::Reset() {
   firstLoop = true;
@@ -32,33 +33,66 @@ bool TimeManager::Update(signed int realElapsedTime, double minimumFPS) {
   // Apply time scale
   elapsedTime = realElapsedTime * timeScale;
 
-  // Update timers
   timeFromStart += elapsedTime;
   pauseTime = 0;
 
-  for (auto it = timers.begin(); it != timers.end(); ++it)
-    it->second.UpdateTime(elapsedTime);
-
   return true;
 }
 
-void TimeManager::AddTimer(gd::String name) {
-  ManualTimer newTimer;
-  timers[name] = newTimer;
+ManualTimer& TimeManager::AddTimer(const gd::String& name) {
+  ManualTimer& timer = timers[name];
+  timer = ManualTimer();
+  timer.UpdateTimeTo(timeFromStart);
+  timer.Reset();  // The timer starts now, not at the beginning.
+
+  return timer;
 }
 
-bool TimeManager::HasTimer(gd::String name) const {
+bool TimeManager::HasTimer(const gd::String& name) const {
   return timers.find(name) != timers.end();
 }
 
-ManualTimer& TimeManager::GetTimer(gd::String name) {
-  if (!HasTimer(name)) return nullTimer;
+ManualTimer& TimeManager::GetTimer(const gd::String& name) {
+  ManualTimer* timer = FindTimer(name);
+  return timer ? *timer : nullTimer;
+}
+
+ManualTimer* TimeManager::FindTimer(const gd::String& name) {
+  auto it = timers.find(name);
+  if (it == timers.end()) return nullptr;
 
-  return timers[name];
+  it->second.UpdateTimeTo(timeFromStart);
+  return &it->second;
 }
 
-void TimeManager::RemoveTimer(gd::String name) {
-  if (!HasTimer(name)) return;
+void TimeManager::RemoveTimer(const gd::String& name) { timers.erase(name); }
+
+std::map<gd::String, ManualTimer>& TimeManager::GetTimers() {
+  for (auto& it : timers) it.second.UpdateTimeTo(timeFromStart);
 
-  timers.erase(name);
+  return timers;
+}
+
+void TimeManager::SaveState(SceneSnapshotWriter& writer) {
+  writer.WriteInt(timeFromStart);
+  writer.WriteDouble(timeScale);
+  writer.WriteUInt(timers.size());
+  for (auto& it : GetTimers()) {
+    writer.WriteString(it.first);
+    writer.WriteInt(it.second.GetTime());
+    writer.WriteBool(it.second.IsPaused());
+  }
+}
+
+void TimeManager::RestoreState(SceneSnapshotReader& reader) {
+  timeFromStart = reader.ReadInt();
+  timeScale = reader.ReadDouble();
+
+  timers.clear();
+  std::size_t count = reader.ReadUInt();
+  for (std::size_t i = 0; i < count && reader.IsValid(); ++i) {
+    ManualTimer& timer = AddTimer(reader.ReadString());
+    timer.SetTime(reader.ReadInt());
+    timer.SetPaused(reader.ReadBool());
+  }
 }
@@ -8,6 +8,8 @@
 #include <map>
 #include "GDCpp/Runtime/ManualTimer.h"
 #include "GDCpp/Runtime/String.h"
+class SceneSnapshotReader;
+class SceneSnapshotWriter;
 
 /**
  * \brief Manage the timers and times elapsed during last
@@ -69,22 +71,55 @@ class GD_API TimeManager {
   }
 
   /** \name Timers
-   * Functions to manipulate timers
+   * Functions to manipulate timers.
+   *
+   * Timers are not updated at each frame: they are brought up to date with
+   * the time elapsed since the beginning when they are accessed, so that a
+   * scene can have a lot of timers without slowing down each frame.
    */
   ///@{
-  void AddTimer(gd::String name);
-  bool HasTimer(gd::String name) const;
-  ManualTimer& GetTimer(gd::String name);
-  void RemoveTimer(gd::String name);
+  /**
+   * \brief Add a timer starting at 0, replacing the existing timer with the
+   * same name, if any.
+   */
+  ManualTimer& AddTimer(const gd::String& name);
+  bool HasTimer(const gd::String& name) const;
+
+  /**
+   * \brief Return the timer, or a timer with a time always equal to 0 if
+   * there is no timer with this name.
+   */
+  ManualTimer& GetTimer(const gd::String& name);
+
+  /**
+   * \brief Return a pointer to the timer, up to date, or nullptr if there is
+   * no timer with this name.
+   *
+   * Prefer this to HasTimer followed by GetTimer, which looks for the timer
+   * twice.
+   */
+  ManualTimer* FindTimer(const gd::String& name);
+  void RemoveTimer(const gd::String& name);
 
   /**
-   * \brief Provide a direct access to all the timers.
+   * \brief Provide a direct access to all the timers, up to date.
    *
    * Useful to build a custom interface (i.e: debugger) displaying the timers.
    */
-  std::map<gd::String, ManualTimer>& GetTimers() { return timers; }
+  std::map<gd::String, ManualTimer>& GetTimers();
   ///@}
 
+  /**
+   * \brief Write the time elapsed since the beginning, the time scale and the
+   * timers in a snapshot of the scene.
+   */
+  void SaveState(SceneSnapshotWriter& writer);
+
+  /**
+   * \brief Restore the state written by SaveState, replacing the timers.
+   */
+  void RestoreState(SceneSnapshotReader& reader);
+
  private:
   bool firstLoop;
   bool firstUpdateDone;
@@ -1169,6 +1169,161 @@ void GD_API aes_ecb_decrypt(const uint8_t *in,
   PUTU32(out + 12, s3);
 }
 
+/*
+ * Hardware AES instructions (AES-NI on x86, detected at runtime, and the
+ * cryptography extension of ARMv8 when the compiler targets it). The round
+ * keys of the key schedules are converted to bytes, in the order expected by
+ * the instructions: the decryption key schedule already is the one of the
+ * "equivalent inverse cipher" used by these instructions.
+ */
+#if defined(__EMSCRIPTEN__) || defined(EMSCRIPTEN)
+#define AES_HW_NONE
+#elif (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define AES_HW_X86
+#define AES_HW_TARGET __attribute__((target("aes,sse2")))
+#include <wmmintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define AES_HW_X86
+#define AES_HW_TARGET
+#include <intrin.h>
+#include <wmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO)
+#define AES_HW_ARM
+#include <arm_neon.h>
+#else
+#define AES_HW_NONE
+#endif
+
+static int aes_hw_supported(void) {
+#if defined(AES_HW_X86) && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 25)) != 0;
+#elif defined(AES_HW_X86)
+  return __builtin_cpu_supports("aes");
+#elif defined(AES_HW_ARM)
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+static int aes_hw_used = -1; /* -1 until the CPU is checked. */
+
+int GD_API aes_hw_enable(int enable) {
+  aes_hw_used = enable && aes_hw_supported();
+  return aes_hw_used;
+}
+
+static int aes_hw_is_used(void) {
+  if (aes_hw_used < 0) aes_hw_used = aes_hw_supported();
+  return aes_hw_used;
+}
+
+/* Convert the round keys to bytes, for the hardware instructions. */
+static void aes_ks_to_bytes(const aes_ks_t *ks, uint8_t *rk_bytes) {
+  int i;
+  for (i = 0; i < 4 * (ks->rounds + 1); ++i)
+    PUTU32(rk_bytes + 4 * i, ks->rd_key[i]);
+}
+
+#if defined(AES_HW_X86)
+AES_HW_TARGET static void aes_hw_encrypt_blocks(const uint8_t *rk_bytes,
+                                                int rounds,
+                                                uint8_t *blocks,
+                                                size_t blks) {
+  __m128i rk[AES_MAXNR + 1];
+  int r;
+  for (r = 0; r <= rounds; ++r)
+    rk[r] = _mm_loadu_si128((const __m128i *)(rk_bytes + 16 * r));
+
+  /* Blocks are encrypted 4 by 4, so that the instructions are pipelined. */
+  for (; blks >= 4; blks -= 4, blocks += 4 * AES_BLOCK_SIZE) {
+    __m128i s0 = _mm_xor_si128(_mm_loadu_si128((__m128i *)blocks), rk[0]);
+    __m128i s1 = _mm_xor_si128(_mm_loadu_si128((__m128i *)blocks + 1), rk[0]);
+    __m128i s2 = _mm_xor_si128(_mm_loadu_si128((__m128i *)blocks + 2), rk[0]);
+    __m128i s3 = _mm_xor_si128(_mm_loadu_si128((__m128i *)blocks + 3), rk[0]);
+    for (r = 1; r < rounds; ++r) {
+      s0 = _mm_aesenc_si128(s0, rk[r]);
+      s1 = _mm_aesenc_si128(s1, rk[r]);
+      s2 = _mm_aesenc_si128(s2, rk[r]);
+      s3 = _mm_aesenc_si128(s3, rk[r]);
+    }
+    _mm_storeu_si128((__m128i *)blocks, _mm_aesenclast_si128(s0, rk[rounds]));
+    _mm_storeu_si128((__m128i *)blocks + 1, _mm_aesenclast_si128(s1, rk[rounds]));
+    _mm_storeu_si128((__m128i *)blocks + 2, _mm_aesenclast_si128(s2, rk[rounds]));
+    _mm_storeu_si128((__m128i *)blocks + 3, _mm_aesenclast_si128(s3, rk[rounds]));
+  }
+  for (; blks > 0; --blks, blocks += AES_BLOCK_SIZE) {
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((__m128i *)blocks), rk[0]);
+    for (r = 1; r < rounds; ++r) s = _mm_aesenc_si128(s, rk[r]);
+    _mm_storeu_si128((__m128i *)blocks, _mm_aesenclast_si128(s, rk[rounds]));
+  }
+}
+
+AES_HW_TARGET static void aes_hw_cbc_decrypt(const uint8_t *rk_bytes,
+                                             int rounds,
+                                             const uint8_t *in,
+                                             uint8_t *out,
+                                             uint8_t *iv,
+                                             size_t blks) {
+  __m128i rk[AES_MAXNR + 1];
+  __m128i vec = _mm_loadu_si128((const __m128i *)iv);
+  int r;
+  for (r = 0; r <= rounds; ++r)
+    rk[r] = _mm_loadu_si128((const __m128i *)(rk_bytes + 16 * r));
+
+  for (; blks > 0; --blks, in += AES_BLOCK_SIZE, out += AES_BLOCK_SIZE) {
+    __m128i block = _mm_loadu_si128((const __m128i *)in);
+    __m128i s = _mm_xor_si128(block, rk[0]);
+    for (r = 1; r < rounds; ++r) s = _mm_aesdec_si128(s, rk[r]);
+    s = _mm_aesdeclast_si128(s, rk[rounds]);
+    _mm_storeu_si128((__m128i *)out, _mm_xor_si128(s, vec));
+    vec = block;
+  }
+  _mm_storeu_si128((__m128i *)iv, vec);
+}
+#elif defined(AES_HW_ARM)
+static void aes_hw_encrypt_blocks(const uint8_t *rk_bytes,
+                                  int rounds,
+                                  uint8_t *blocks,
+                                  size_t blks) {
+  uint8x16_t rk[AES_MAXNR + 1];
+  int r;
+  for (r = 0; r <= rounds; ++r) rk[r] = vld1q_u8(rk_bytes + 16 * r);
+
+  for (; blks > 0; --blks, blocks += AES_BLOCK_SIZE) {
+    uint8x16_t s = vld1q_u8(blocks);
+    for (r = 0; r < rounds - 1; ++r) s = vaesmcq_u8(vaeseq_u8(s, rk[r]));
+    s = veorq_u8(vaeseq_u8(s, rk[rounds - 1]), rk[rounds]);
+    vst1q_u8(blocks, s);
+  }
+}
+
+static void aes_hw_cbc_decrypt(const uint8_t *rk_bytes,
+                               int rounds,
+                               const uint8_t *in,
+                               uint8_t *out,
+                               uint8_t *iv,
+                               size_t blks) {
+  uint8x16_t rk[AES_MAXNR + 1];
+  uint8x16_t vec = vld1q_u8(iv);
+  int r;
+  for (r = 0; r <= rounds; ++r) rk[r] = vld1q_u8(rk_bytes + 16 * r);
+
+  for (; blks > 0; --blks, in += AES_BLOCK_SIZE, out += AES_BLOCK_SIZE) {
+    uint8x16_t block = vld1q_u8(in);
+    uint8x16_t s = block;
+    for (r = 0; r < rounds - 1; ++r) s = vaesimcq_u8(vaesdq_u8(s, rk[r]));
+    s = veorq_u8(vaesdq_u8(s, rk[rounds - 1]), rk[rounds]);
+    vst1q_u8(out, veorq_u8(s, vec));
+    vec = block;
+  }
+  vst1q_u8(iv, vec);
+}
+#endif
+
 #define AES_BLOCK_OP64(dst, src, op)    \
   do {                                  \
     uint64_t *_dst = (uint64_t *)(dst); \
@@ -1219,6 +1374,15 @@ void GD_API aes_cbc_decrypt(const uint8_t *in,
                             const aes_ks_t *ks) {
   const uint8_t *vec = iv;
 
+#if !defined(AES_HW_NONE)
+  if (aes_hw_is_used()) {
+    uint8_t rk_bytes[16 * (AES_MAXNR + 1)];
+    aes_ks_to_bytes(ks, rk_bytes);
+    aes_hw_cbc_decrypt(rk_bytes, ks->rounds, in, out, iv, blks);
+    return;
+  }
+#endif
+
   while (blks--) {
     AES_BLOCK_OP(out, in, =);
     aes_ecb_decrypt(out, out, ks);
@@ -1229,4 +1393,96 @@ void GD_API aes_cbc_decrypt(const uint8_t *in,
   }
 
   memcpy(iv, vec, AES_BLOCK_SIZE);
-}
\ No newline at end of file
+}
+
+#define AES_CTR_BATCH_BLOCKS 8
+
+static void aes_ctr_keystream(aes_ctr_t *ctx, uint8_t *keystream, size_t blks);
+
+int GD_API aes_ctr_init(aes_ctr_t *ctx,
+                        const uint8_t *keybuf,
+                        int kbits,
+                        const uint8_t *iv) {
+  int result = aes_setks_encrypt(keybuf, kbits, &ctx->ks);
+  if (result != 0) return result;
+
+  aes_ks_to_bytes(&ctx->ks, ctx->rk_bytes);
+  aes_ctr_seek(ctx, iv, 0);
+  return 0;
+}
+
+void GD_API aes_ctr_seek(aes_ctr_t *ctx, const uint8_t *iv, uint64_t offset) {
+  /* Add the number of blocks before the offset to the 128 bits counter. */
+  uint64_t carry = offset / AES_BLOCK_SIZE;
+  int i;
+  for (i = AES_BLOCK_SIZE - 1; i >= 0; --i) {
+    carry += iv[i];
+    ctx->counter[i] = (uint8_t)carry;
+    carry >>= 8;
+  }
+
+  ctx->used = AES_BLOCK_SIZE;
+  if (offset % AES_BLOCK_SIZE != 0) {
+    aes_ctr_keystream(ctx, ctx->keystream, 1);
+    ctx->used = offset % AES_BLOCK_SIZE;
+  }
+}
+
+/* Encrypt the next blks counter blocks in keystream. */
+static void aes_ctr_keystream(aes_ctr_t *ctx, uint8_t *keystream, size_t blks) {
+  size_t b;
+  int i;
+  for (b = 0; b < blks; ++b) {
+    memcpy(keystream + b * AES_BLOCK_SIZE, ctx->counter, AES_BLOCK_SIZE);
+    for (i = AES_BLOCK_SIZE - 1; i >= 0 && ++ctx->counter[i] == 0; --i)
+      ;
+  }
+
+#if !defined(AES_HW_NONE)
+  if (aes_hw_is_used()) {
+    aes_hw_encrypt_blocks(ctx->rk_bytes, ctx->ks.rounds, keystream, blks);
+    return;
+  }
+#endif
+  for (b = 0; b < blks; ++b)
+    aes_ecb_encrypt(keystream + b * AES_BLOCK_SIZE,
+                    keystream + b * AES_BLOCK_SIZE,
+                    &ctx->ks);
+}
+
+void GD_API aes_ctr_crypt(aes_ctr_t *ctx,
+                          const uint8_t *in,
+                          uint8_t *out,
+                          size_t len) {
+  uint8_t keystream[AES_CTR_BATCH_BLOCKS * AES_BLOCK_SIZE];
+  size_t i;
+
+  /* Use the rest of the keystream block of the previous call. */
+  while (len > 0 && ctx->used < AES_BLOCK_SIZE) {
+    *out++ = *in++ ^ ctx->keystream[ctx->used++];
+    --len;
+  }
+
+  while (len >= AES_BLOCK_SIZE) {
+    size_t blks = len / AES_BLOCK_SIZE;
+    if (blks > AES_CTR_BATCH_BLOCKS) blks = AES_CTR_BATCH_BLOCKS;
+
+    aes_ctr_keystream(ctx, keystream, blks);
+    for (i = 0; i < blks * AES_BLOCK_SIZE; i += 8) {
+      uint64_t data, key;
+      memcpy(&data, in + i, 8);
+      memcpy(&key, keystream + i, 8);
+      data ^= key;
+      memcpy(out + i, &data, 8);
+    }
+    in += blks * AES_BLOCK_SIZE;
+    out += blks * AES_BLOCK_SIZE;
+    len -= blks * AES_BLOCK_SIZE;
+  }
+
+  if (len > 0) {
+    aes_ctr_keystream(ctx, ctx->keystream, 1);
+    for (ctx->used = 0; ctx->used < len; ++ctx->used)
+      out[ctx->used] = in[ctx->used] ^ ctx->keystream[ctx->used];
+  }
+}
@@ -63,6 +63,16 @@ typedef struct {
   int rounds;
 } aes_ks_t;
 
+/* State of a CTR mode encryption/decryption, done by chunks. */
+typedef struct {
+  aes_ks_t ks;
+  uint8_t rk_bytes[16 * (AES_MAXNR + 1)]; /* Round keys for the hardware
+                                             instructions. */
+  uint8_t counter[AES_BLOCK_SIZE];        /* The next counter block. */
+  uint8_t keystream[AES_BLOCK_SIZE];      /* The last keystream block. */
+  size_t used; /* The bytes of the last keystream block already used. */
+} aes_ctr_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -96,6 +106,27 @@ void GD_API aes_cbc_decrypt(const uint8_t *in,
                             size_t blks,
                             const aes_ks_t *ks);
 
+/* CTR mode functions, the same for encryption and decryption.
+ * Data can be processed by chunks of any size: call aes_ctr_crypt for each
+ * chunk, in order, or use aes_ctr_seek to start at any offset of the data.
+ * in and out can be the same.
+ */
+int GD_API aes_ctr_init(aes_ctr_t *ctx,
+                        const uint8_t *keybuf,
+                        int kbits,
+                        const uint8_t *iv);
+void GD_API aes_ctr_seek(aes_ctr_t *ctx, const uint8_t *iv, uint64_t offset);
+void GD_API aes_ctr_crypt(aes_ctr_t *ctx,
+                          const uint8_t *in,
+                          uint8_t *out,
+                          size_t len);
+
+/* The hardware AES instructions (AES-NI, ARMv8 cryptography extension) are
+ * used when the CPU supports them. Returns 1 if they are used after the call:
+ * they can be disabled with enable = 0.
+ */
+int GD_API aes_hw_enable(int enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,3 @@
+#if !defined(GD_IDE_ONLY)
+#include "GDCore/Tools/Threads.cpp"
+#endif
@@ -5,5 +5,231 @@
  */
 
 #include "XmlFilesHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <system_error>
+#include <thread>
+#if defined(WINDOWS)
+#include <windows.h>
+#endif
 
 std::map<gd::String, std::shared_ptr<XmlFile> > XmlFilesManager::openedFiles;
+XmlFilesManager::CachedFilesMap XmlFilesManager::cachedFiles;
+std::size_t XmlFilesManager::filesUsesCount = 0;
+
+namespace {
+const std::size_t maximumCachedFilesCount = 16;
+const std::chrono::milliseconds saveDelay(200);
+const std::chrono::milliseconds maximumSaveDelay(1000);
+
+/**
+ * \brief Replace \a to by \a from, as an atomic operation if possible.
+ */
+bool ReplaceFile(const gd::String& from, const gd::String& to) {
+#if defined(WINDOWS)
+  return MoveFileExW(from.ToWide().c_str(),
+                     to.ToWide().c_str(),
+                     MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.ToLocale().c_str(), to.ToLocale().c_str()) == 0;
+#endif
+}
+
+/**
+ * \brief Save a copy of the document of the file to a temporary file, and
+ * then replace the file by it.
+ */
+void SaveFile(XmlFile& file) {
+  std::unique_lock<std::mutex> lock(file.GetMutex());
+  TiXmlDocument doc(file.GetTinyXmlDocument());
+  lock.unlock();
+
+  gd::String temporaryFilename = file.GetFilename() + ".tmp";
+  if (!gd::SaveXmlToFile(doc, temporaryFilename) ||
+      !ReplaceFile(temporaryFilename, file.GetFilename()))
+    std::remove(temporaryFilename.ToLocale().c_str());
+}
+
+/**
+ * \brief Save the modified files on a thread, a short time after their last
+ * modification.
+ */
+class XmlFilesSaver {
+ public:
+  XmlFilesSaver() : stopped(false), saveNow(false){};
+
+  /**
+   * \brief Stop the thread and save the files not saved yet.
+   */
+  ~XmlFilesSaver() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    condition.notify_all();
+    if (thread.joinable()) thread.join();
+
+    for (auto& it : pendingFiles) SaveFile(*it.second);
+  }
+
+  static XmlFilesSaver& Get() {
+    static XmlFilesSaver saver;
+    return saver;
+  }
+
+  void Schedule(std::shared_ptr<XmlFile> file) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto now = std::chrono::steady_clock::now();
+    if (pendingFiles.empty()) firstModification = now;
+    lastModification = now;
+    pendingFiles[file->GetFilename()] = file;
+
+    // If no thread can be started, the files are saved by SaveAll or when the
+    // game is closed.
+    if (!thread.joinable()) {
+      try {
+        thread = std::thread(&XmlFilesSaver::Run, this);
+      } catch (const std::system_error&) {
+      }
+    }
+
+    lock.unlock();
+    condition.notify_all();
+  }
+
+  /**
+   * \brief Return the file if it's not saved yet.
+   */
+  std::shared_ptr<XmlFile> GetPendingFile(const gd::String& filename) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = pendingFiles.find(filename);
+    if (it != pendingFiles.end()) return it->second;
+    if (savedFile && savedFile->GetFilename() == filename) return savedFile;
+
+    return std::shared_ptr<XmlFile>();
+  }
+
+  /**
+   * \brief Cancel the save of the file, waiting for the end of the save if
+   * it's already started.
+   */
+  void Cancel(const gd::String& filename) {
+    std::unique_lock<std::mutex> lock(mutex);
+    pendingFiles.erase(filename);
+    condition.wait(lock, [&]() {
+      return !savedFile || savedFile->GetFilename() != filename;
+    });
+  }
+
+  void SaveAll() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!thread.joinable()) {
+      std::map<gd::String, std::shared_ptr<XmlFile> > files;
+      files.swap(pendingFiles);
+      lock.unlock();
+      for (auto& it : files) SaveFile(*it.second);
+      return;
+    }
+
+    saveNow = true;
+    condition.notify_all();
+    condition.wait(lock,
+                   [this]() { return pendingFiles.empty() && !savedFile; });
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopped) {
+      if (pendingFiles.empty()) {
+        saveNow = false;
+        condition.wait(lock);
+        continue;
+      }
+
+      // Wait for the end of the modifications, but not too long if the files
+      // are constantly modified.
+      auto saveTime = std::min(lastModification + saveDelay,
+                               firstModification + maximumSaveDelay);
+      if (!saveNow && std::chrono::steady_clock::now() < saveTime) {
+        condition.wait_until(lock, saveTime);
+        continue;
+      }
+
+      savedFile = pendingFiles.begin()->second;
+      pendingFiles.erase(pendingFiles.begin());
+      lock.unlock();
+      SaveFile(*savedFile);
+      lock.lock();
+      savedFile.reset();
+      if (!pendingFiles.empty()) firstModification = lastModification;
+      condition.notify_all();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::thread thread;
+  bool stopped;
+  bool saveNow;  ///< True to save the pending files without waiting.
+  std::map<gd::String, std::shared_ptr<XmlFile> > pendingFiles;
+  std::shared_ptr<XmlFile> savedFile;  ///< The file being saved, if any.
+  std::chrono::steady_clock::time_point firstModification;
+  std::chrono::steady_clock::time_point lastModification;
+};
+}  // namespace
+
+void XmlFile::MarkAsModified() {
+  XmlFilesManager::ScheduleSave(shared_from_this());
+}
+
+void XmlFilesManager::LoadFile(gd::String filename) {
+  if (openedFiles.find(filename) == openedFiles.end())
+    openedFiles[filename] = GetFile(filename);
+}
+
+std::shared_ptr<XmlFile> XmlFilesManager::GetFile(gd::String filename) {
+  auto openedFile = openedFiles.find(filename);
+  if (openedFile != openedFiles.end()) return openedFile->second;
+
+  std::pair<std::shared_ptr<XmlFile>, std::size_t>& cachedFile =
+      cachedFiles[filename];
+  cachedFile.second = ++filesUsesCount;
+  if (cachedFile.first) return cachedFile.first;
+
+  // A file not saved yet must not be loaded again from the disk.
+  std::shared_ptr<XmlFile> file =
+      XmlFilesSaver::Get().GetPendingFile(filename);
+  if (!file) file = std::make_shared<XmlFile>(filename);
+  cachedFile.first = file;
+
+  if (cachedFiles.size() > maximumCachedFilesCount) {
+    auto leastRecentlyUsed = std::min_element(
+        cachedFiles.begin(),
+        cachedFiles.end(),
+        [](const CachedFilesMap::value_type& a,
+           const CachedFilesMap::value_type& b) {
+          return a.second.second < b.second.second;
+        });
+    cachedFiles.erase(leastRecentlyUsed);
+  }
+
+  return file;
+}
+
+void XmlFilesManager::ForgetFile(const gd::String& filename) {
+  cachedFiles.erase(filename);
+  XmlFilesSaver::Get().Cancel(filename);
+}
+
+bool XmlFilesManager::IsSavePending(const gd::String& filename) {
+  return XmlFilesSaver::Get().GetPendingFile(filename) != nullptr;
+}
+
+void XmlFilesManager::SaveModifiedFiles() { XmlFilesSaver::Get().SaveAll(); }
+
+void XmlFilesManager::ScheduleSave(std::shared_ptr<XmlFile> file) {
+  XmlFilesSaver::Get().Schedule(file);
+}
@@ -9,6 +9,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "GDCpp/Runtime/String.h"
 #include "GDCpp/Runtime/TinyXml/tinyxml.h"
@@ -17,28 +18,35 @@
 /**
  * \brief Helper class wrapping a tinyxml document in RAII fashion
  *
+ * The document is not saved by the object: when it is marked as modified,
+ * the file is saved in the background by XmlFilesManager.
+ *
  * \ingroup FileExtension
  */
-class XmlFile {
+class XmlFile : public std::enable_shared_from_this<XmlFile> {
  public:
   /**
    * Open file
    */
-  XmlFile(gd::String filename) : doc(), filename(filename), modified(false) {
+  XmlFile(gd::String filename) : doc(), filename(filename) {
     gd::LoadXmlFromFile(doc, filename);
   };
 
   /**
-   * Save file is the document was marked as modified.
+   * \brief Schedule the file to be saved.
+   *
+   * Must be called after the document was modified, while the mutex of the
+   * file is still locked (see GetMutex).
    */
-  ~XmlFile() {
-    if (modified) gd::SaveXmlToFile(doc, filename);
-  }
+  void MarkAsModified();
 
   /**
-   * Set the file to be saved when the object is destroyed.
+   * \brief Return the mutex to be locked while the document is modified, so
+   * that it's not saved at the same time.
    */
-  void MarkAsModified() { modified = true; }
+  std::mutex& GetMutex() { return mutex; }
+
+  const gd::String& GetFilename() const { return filename; }
 
   /**
    * Access to the tinyxml representation of the file
@@ -53,25 +61,35 @@ class XmlFile {
  private:
   TiXmlDocument doc;
   gd::String filename;
-  bool modified;
+  std::mutex mutex;
 };
 
 /**
  * \brief Helper class for opening XML files.
  *
+ * Files used by the game are kept in memory so that they are parsed only once.
+ * Modified files are saved in the background, a short time after their last
+ * modification so that consecutive modifications are saved at once. Files are
+ * first written to a temporary file which then replaces the file, so that a
+ * file is never left half written.
+ *
  * \ingroup FileExtension
  */
 class XmlFilesManager {
+  typedef std::map<gd::String,
+                   std::pair<std::shared_ptr<XmlFile>, std::size_t> >
+      CachedFilesMap;
+
   static std::map<gd::String, std::shared_ptr<XmlFile> > openedFiles;
+  static CachedFilesMap
+      cachedFiles;  ///< Files used without being loaded, with their last use.
+  static std::size_t filesUsesCount;
 
  public:
   /**
    * Load a file and keep it in memory
    */
-  static void LoadFile(gd::String filename) {
-    if (openedFiles.find(filename) == openedFiles.end())
-      openedFiles[filename] = std::make_shared<XmlFile>(filename);
-  }
+  static void LoadFile(gd::String filename);
 
   /**
    * Unload a file kept in memory
@@ -83,18 +101,32 @@ class XmlFilesManager {
 
   /**
    * Get access to a file. If the file has not been loaded with LoadFile,
-   * it will be loaded now, and unload as soon as it is not used anymore.
+   * it will be loaded now, and kept in memory with the last used files.
    */
-  static std::shared_ptr<XmlFile> GetFile(gd::String filename,
-                                          bool isGoingToModifyFile = true) {
-    std::shared_ptr<XmlFile> file =
-        openedFiles.find(filename) != openedFiles.end()
-            ? openedFiles[filename]
-            : std::make_shared<XmlFile>(filename);
-    if (isGoingToModifyFile) file->MarkAsModified();
-
-    return file;
-  }
+  static std::shared_ptr<XmlFile> GetFile(gd::String filename);
+
+  /**
+   * \brief Forget the file if it's not loaded with LoadFile, and cancel the
+   * save of the file if it's not started. To be called before the file is
+   * deleted.
+   */
+  static void ForgetFile(const gd::String& filename);
+
+  /**
+   * \brief Return true if the file is modified and not saved yet.
+   */
+  static bool IsSavePending(const gd::String& filename);
+
+  /**
+   * \brief Save now the modified files, and wait until they are saved.
+   */
+  static void SaveModifiedFiles();
+
+  /**
+   * \brief Schedule the file to be saved in the background.
+   * \see XmlFile::MarkAsModified
+   */
+  static void ScheduleSave(std::shared_ptr<XmlFile> file);
 
   static std::map<gd::String, std::shared_ptr<XmlFile> > GetOpenedFilesList() {
     return openedFiles;
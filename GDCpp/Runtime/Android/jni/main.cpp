@@ -87,16 +87,17 @@ int main(int argc, char *argv[])
     GDLogBanner();
 
     gd::Project game;
+    game.SetLayoutsLoadedLazily(true);
     gd::String json = gd::ResourcesLoader::Get()->LoadPlainText("gd-project.json");
 
-    SerializerElement rootElement = Serializer::FromJSON(json);
-    game.UnserializeFrom(rootElement);
+    game.UnserializeFromJSON(json.Raw());
 
     RuntimeGame runtimeGame;
     runtimeGame.LoadFromProject(game);
 
     bool abort = false;
     SceneStack sceneStack(runtimeGame, &window);
+    sceneStack.UnloadLayoutsAfterLoadingScenes(true);
     sceneStack.OnError([&abort](gd::String error) {
         std::cout << error << std::endl;
         abort = true;
@@ -18,6 +18,7 @@
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/ResourcesLoader.h"
 #include "GDCpp/Runtime/FontManager.h"
+#include "GDCpp/Runtime/FrameProfilerStream.h"
 #include "GDCpp/Runtime/SoundManager.h"
 #include "GDCpp/Runtime/SceneNameMangler.h"
 #include "GDCpp/Runtime/Project/Project.h"
@@ -30,7 +31,6 @@
 #include "GDCpp/Runtime/Tools/AES.h"
 #include "GDCpp/Runtime/Serialization/Serializer.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
-#include "GDCpp/Runtime/TinyXml/tinyxml.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "CompilationChecker.h"
 
@@ -100,6 +100,7 @@ int main( int argc, char *p_argv[] )
     }
 
     gd::Project game;
+    game.SetLayoutsLoadedLazily(true);
 
     //Load game data
     {
@@ -123,17 +124,21 @@ int main( int argc, char *p_argv[] )
 
         std::string uncryptedSrc = std::string(obuffer, size);
         delete [] obuffer;
+        delete [] ibuffer;
 
         cout << "Loading game data..." << endl;
-        TiXmlDocument doc;
-        if ( !doc.Parse(uncryptedSrc.c_str()) )
+        gd::SerializerElement rootElement;
+        if ( gd::Serializer::IsBinary(uncryptedSrc) )
         {
-            return DisplayMessage("Unable to parse game data. Aborting.");
+            rootElement = gd::Serializer::FromBinary(uncryptedSrc);
+            if ( rootElement.GetAllChildren().empty() )
+                return DisplayMessage("Unable to parse game data. Aborting.");
+        }
+        else
+        {
+            if ( !gd::Serializer::FromXML(rootElement, uncryptedSrc) )
+                return DisplayMessage("Unable to parse game data. Aborting.");
         }
-
-        TiXmlHandle hdl(&doc);
-        gd::SerializerElement rootElement;
-        gd::Serializer::FromXML(rootElement, hdl.FirstChildElement().Element());
         game.UnserializeFrom(rootElement);
 	}
 
@@ -181,14 +186,27 @@ int main( int argc, char *p_argv[] )
         "", sf::Style::Close, sf::ContextSettings(24, 8));
     window.setActive(true);
 
+    //Handle special argument to stream the profiler frames to a remote profiler (the IDE)
+    FrameProfilerStream profilerStream;
+    for (int i = 1; i < argc; ++i)
+    {
+        gd::String argument(p_argv[i]);
+        if ( argument.size() <= 10 || argument.substr(0, 10) != "-profiler=" ) continue;
+
+        auto address = argument.substr(10, gd::String::npos).Split(U':');
+        if ( address.size() != 2 || !profilerStream.Connect(address[0], address[1].To<unsigned short>()) )
+            cout << "Unable to connect to the profiler " << argument.substr(10, gd::String::npos) << endl;
+    }
+
     //Game main loop
     bool abort = false;
     SceneStack sceneStack(runtimeGame, &window);
+    sceneStack.UnloadLayoutsAfterLoadingScenes(true);
     sceneStack.OnError([&abort](gd::String error) {
         DisplayMessage(error);
         abort = true;
     });
-    sceneStack.OnLoadScene([&codeLibraryName](RuntimeScene & scene) {
+    sceneStack.OnLoadScene([&codeLibraryName, &profilerStream](RuntimeScene & scene) {
         if (!codeLibraryName.empty() &&
             !scene.GetCodeExecutionEngine()->LoadFromDynamicLibrary(codeLibraryName,
             "GDSceneEvents"+gd::SceneNameMangler::GetMangledSceneName(scene.GetName())))
@@ -196,6 +214,12 @@ int main( int argc, char *p_argv[] )
             return false;
         }
 
+        if (profilerStream.IsConnected())
+        {
+            scene.EnableFrameProfiler();
+            scene.SetFrameProfilerStream(&profilerStream);
+        }
+
         return true;
     });
 
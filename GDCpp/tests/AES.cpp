@@ -0,0 +1,91 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the AES functions, with the test vectors of NIST SP
+ * 800-38A.
+ */
+#include "GDCpp/Runtime/Tools/AES.h"
+#include <cstring>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+std::vector<uint8_t> FromHex(const std::string& hex) {
+  std::vector<uint8_t> bytes;
+  for (std::size_t i = 0; i + 1 < hex.size(); i += 2)
+    bytes.push_back(std::stoi(hex.substr(i, 2), nullptr, 16));
+  return bytes;
+}
+
+const std::string plaintext =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+}  // namespace
+
+TEST_CASE("AES", "[common]") {
+  std::vector<uint8_t> plain = FromHex(plaintext);
+  std::vector<uint8_t> key = FromHex("2b7e151628aed2a6abf7158809cf4f3c");
+
+  // Test with and without the hardware instructions, if available.
+  for (int hardware = 1; hardware >= 0; --hardware) {
+    aes_hw_enable(hardware);
+
+    {  // CBC decryption.
+      std::vector<uint8_t> iv = FromHex("000102030405060708090a0b0c0d0e0f");
+      std::vector<uint8_t> cipher = FromHex(
+          "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+          "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7");
+
+      aes_ks_t ks;
+      REQUIRE(aes_setks_decrypt(key.data(), 128, &ks) == 0);
+      std::vector<uint8_t> output(cipher.size());
+      aes_cbc_decrypt(cipher.data(), output.data(), iv.data(), 4, &ks);
+      REQUIRE(output == plain);
+    }
+    {  // CTR decryption, by chunks.
+      std::vector<uint8_t> iv = FromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+      std::vector<uint8_t> cipher = FromHex(
+          "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+          "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+      aes_ctr_t ctx;
+      REQUIRE(aes_ctr_init(&ctx, key.data(), 128, iv.data()) == 0);
+      std::vector<uint8_t> output(cipher.size());
+      aes_ctr_crypt(&ctx, cipher.data(), output.data(), cipher.size());
+      REQUIRE(output == plain);
+
+      std::size_t chunks[] = {3, 1, 17, 0, 20, 23};
+      std::size_t position = 0;
+      aes_ctr_seek(&ctx, iv.data(), 0);
+      output.assign(cipher.size(), 0);
+      for (std::size_t chunk : chunks) {
+        aes_ctr_crypt(
+            &ctx, cipher.data() + position, output.data() + position, chunk);
+        position += chunk;
+      }
+      REQUIRE(output == plain);
+
+      // Decrypt in place, from the middle of a block.
+      aes_ctr_seek(&ctx, iv.data(), 37);
+      aes_ctr_crypt(&ctx, cipher.data() + 37, cipher.data() + 37, 27);
+      REQUIRE(std::memcmp(cipher.data() + 37, plain.data() + 37, 27) == 0);
+    }
+    {  // CTR encryption with a 192 bits key.
+      std::vector<uint8_t> key192 =
+          FromHex("8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b");
+      std::vector<uint8_t> iv = FromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+
+      aes_ctr_t ctx;
+      REQUIRE(aes_ctr_init(&ctx, key192.data(), 192, iv.data()) == 0);
+      std::vector<uint8_t> output(16);
+      aes_ctr_crypt(&ctx, plain.data(), output.data(), 16);
+      REQUIRE(output == FromHex("1abc932417521ca24f2b0459fe7e6e0b"));
+    }
+  }
+
+  aes_hw_enable(1);
+}
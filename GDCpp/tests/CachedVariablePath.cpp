@@ -0,0 +1,50 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering CachedVariablePath class.
+ */
+#include "GDCpp/Runtime/CachedVariablePath.h"
+#include "GDCore/Project/Variable.h"
+#include "catch.hpp"
+
+TEST_CASE("CachedVariablePath", "[game-engine]") {
+  SECTION("Children are created and found") {
+    gd::Variable variable;
+    CachedVariablePath path({"Child", "GrandChild"});
+
+    path.Get(variable).SetValue(42);
+    REQUIRE(variable.GetChild("Child").GetChild("GrandChild").GetValue() == 42);
+    REQUIRE(&path.Get(variable) ==
+            &variable.GetChild("Child").GetChild("GrandChild"));
+  }
+
+  SECTION("Path is resolved again when the structure changed") {
+    gd::Variable variable;
+    CachedVariablePath path({"Child", "GrandChild"});
+    path.Get(variable).SetValue(1);
+
+    variable.RemoveChild("Child");
+    REQUIRE(path.Get(variable).GetValue() == 0);
+    REQUIRE(&path.Get(variable) ==
+            &variable.GetChild("Child").GetChild("GrandChild"));
+
+    variable.GetChild("Child").ClearChildren();
+    path.Get(variable).SetString("Hello");
+    REQUIRE(variable.GetChild("Child").GetChild("GrandChild").GetString() ==
+            "Hello");
+  }
+
+  SECTION("Path is resolved for each variable") {
+    gd::Variable variable1;
+    gd::Variable variable2;
+    CachedVariablePath path({"Child"});
+
+    path.Get(variable1).SetValue(1);
+    path.Get(variable2).SetValue(2);
+    REQUIRE(path.Get(variable1).GetValue() == 1);
+    REQUIRE(path.Get(variable2).GetValue() == 2);
+  }
+}
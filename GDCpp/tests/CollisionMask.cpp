@@ -0,0 +1,79 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering CollisionMask and CollisionMasksCache classes.
+ */
+#include "GDCpp/Runtime/CollisionMask.h"
+#include "catch.hpp"
+
+TEST_CASE("CollisionMask", "[game-engine]") {
+  // A 100x10 image with an opaque pixel at (70, 5) and a pixel at (10, 2)
+  // having an alpha equal to the limit.
+  sf::Image image;
+  image.create(100, 10, sf::Color(255, 255, 255, 0));
+  image.setPixel(70, 5, sf::Color(255, 255, 255, 255));
+  image.setPixel(10, 2, sf::Color(255, 255, 255, 1));
+  CollisionMask mask(image, 1);
+
+  SECTION("Opaque pixels") {
+    REQUIRE(mask.GetWidth() == 100);
+    REQUIRE(mask.GetHeight() == 10);
+    REQUIRE(mask.IsSet(70, 5) == true);
+    REQUIRE(mask.IsSet(10, 2) == false);
+    REQUIRE(mask.IsSet(69, 5) == false);
+    REQUIRE(mask.IsSet(-1, 5) == false);
+    REQUIRE(mask.IsSet(170, 5) == false);
+  }
+  SECTION("Overlapping masks") {
+    sf::Image otherImage;
+    otherImage.create(80, 1, sf::Color(255, 255, 255, 0));
+    otherImage.setPixel(3, 0, sf::Color(255, 255, 255, 255));
+    CollisionMask otherMask(otherImage, 1);
+
+    REQUIRE(CollisionMask::AreOverlapping(mask, 0, 0, otherMask, 67, 5) ==
+            true);
+    REQUIRE(CollisionMask::AreOverlapping(mask, 0, 0, otherMask, 68, 5) ==
+            false);
+    REQUIRE(CollisionMask::AreOverlapping(mask, 0, 0, otherMask, 67, 4) ==
+            false);
+    REQUIRE(CollisionMask::AreOverlapping(mask, 1000, 0, otherMask, 1067, 5) ==
+            true);
+    REQUIRE(CollisionMask::AreOverlapping(mask, -50, -3, otherMask, 17, 2) ==
+            true);
+  }
+  SECTION("Transformed masks") {
+    sf::Transform transform;
+    transform.rotate(90);
+    CollisionMask rotatedMask = CollisionMask::Transform(mask, transform);
+
+    REQUIRE(rotatedMask.GetWidth() == 10);
+    REQUIRE(rotatedMask.GetHeight() == 100);
+    REQUIRE(rotatedMask.GetOffsetX() == -10);
+    REQUIRE(rotatedMask.GetOffsetY() == 0);
+    REQUIRE(rotatedMask.IsSet(4, 70) == true);
+
+    sf::Transform scale;
+    scale.scale(2, 2);
+    CollisionMask scaledMask = CollisionMask::Transform(mask, scale);
+    REQUIRE(scaledMask.GetWidth() == 200);
+    REQUIRE(scaledMask.IsSet(140, 10) == true);
+    REQUIRE(scaledMask.IsSet(141, 11) == true);
+    REQUIRE(scaledMask.IsSet(142, 11) == false);
+  }
+  SECTION("Masks cache") {
+    CollisionMasksCache cache(image, 1);
+
+    sf::Transform translation;
+    translation.translate(50, 50);
+    REQUIRE(cache.GetMask(translation) == cache.GetMask(sf::Transform()));
+
+    sf::Transform rotation;
+    rotation.rotate(45);
+    auto rotatedMask = cache.GetMask(rotation);
+    REQUIRE(rotatedMask != cache.GetMask(sf::Transform()));
+    REQUIRE(cache.GetMask(rotation) == rotatedMask);
+  }
+}
@@ -0,0 +1,66 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering DatFile class.
+ */
+#include "GDCpp/Runtime/DatFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "catch.hpp"
+
+TEST_CASE("DatFile", "[game-engine]") {
+  {
+    std::ofstream file1("DatFileTest1.test", std::ios_base::binary);
+    file1 << "Hello world";
+    std::ofstream file2("DatFileTest2.test", std::ios_base::binary);
+    file2 << std::string("Binary\0content", 14);
+    std::ofstream emptyFile("DatFileTest3.test", std::ios_base::binary);
+  }
+  std::vector<gd::String> files = {
+      "DatFileTest1.test", "DatFileTest2.test", "DatFileTest3.test"};
+
+  SECTION("Files are read from the mapping") {
+    DatFile datFile;
+    REQUIRE(datFile.Create(files, ".", "DatFileTest.egd") == true);
+    REQUIRE(datFile.Read("DatFileTest.egd") == true);
+
+    REQUIRE(datFile.ContainsFile("DatFileTest1.test") == true);
+    REQUIRE(datFile.ContainsFile("DatFileTest4.test") == false);
+    REQUIRE(datFile.GetFile("DatFileTest4.test") == NULL);
+    REQUIRE(datFile.GetFileSize("DatFileTest4.test") == 0);
+
+    REQUIRE(datFile.GetFileSize("DatFileTest1.test") == 11);
+    REQUIRE(std::string(datFile.GetFile("DatFileTest1.test"), 11) ==
+            "Hello world");
+    REQUIRE(datFile.GetFileSize("DatFileTest2.test") == 14);
+    REQUIRE(memcmp(datFile.GetFile("DatFileTest2.test"),
+                   "Binary\0content",
+                   14) == 0);
+    REQUIRE(datFile.ContainsFile("DatFileTest3.test") == true);
+    REQUIRE(datFile.GetFileSize("DatFileTest3.test") == 0);
+
+    const char* begin = datFile.GetFile("DatFileTest1.test");
+    const char* other = datFile.GetFile("DatFileTest2.test");
+    REQUIRE(((other - begin) % DatFile::alignment) == 0);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(begin) % DatFile::alignment) ==
+            0);
+
+    datFile.Close();
+    REQUIRE(datFile.ContainsFile("DatFileTest1.test") == false);
+  }
+
+  SECTION("Invalid files are not read") {
+    DatFile datFile;
+    REQUIRE(datFile.Read("DatFileTest1.test") == false);
+    REQUIRE(datFile.Read("DatFileTestMissing.egd") == false);
+    REQUIRE(datFile.ContainsFile("DatFileTest1.test") == false);
+  }
+
+  std::remove("DatFileTest.egd");
+  for (auto& file : files) std::remove(file.c_str());
+}
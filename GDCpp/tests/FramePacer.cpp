@@ -0,0 +1,96 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering FramePacer class.
+ */
+#include "GDCpp/Runtime/FramePacer.h"
+#include <chrono>
+#include <thread>
+#include "catch.hpp"
+
+TEST_CASE("FramePacer", "[game-engine]") {
+  typedef std::chrono::steady_clock Clock;
+  auto microsecondsSince = [](Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                 start)
+        .count();
+  };
+
+  SECTION("Frames start at the target rate") {
+    FramePacer pacer;
+    pacer.SetTargetFPS(100);
+
+    Clock::time_point start = Clock::now();
+    pacer.BeginFrame();  // The first frame starts immediately.
+    pacer.EndFrame();
+    REQUIRE(pacer.GetLastFrameTime() == 0);
+    REQUIRE(pacer.GetStatistics().framesCount == 0);
+
+    for (int i = 0; i < 10; ++i) {
+      pacer.BeginFrame();
+      REQUIRE(pacer.GetLastFrameTime() == 10000);
+      pacer.EndFrame();
+    }
+    REQUIRE(microsecondsSince(start) >= 100000);
+
+    FramePacer::Statistics statistics = pacer.GetStatistics();
+    REQUIRE(statistics.framesCount == 10);
+    REQUIRE(statistics.averageFrameTime == 10000);
+    REQUIRE(statistics.frameTimeDeviation == 0);
+    REQUIRE(statistics.missedDeadlinesCount == 0);
+    REQUIRE(statistics.averageWorkTime < 10000);
+  }
+  SECTION("Late frames are not caught up") {
+    FramePacer pacer;
+    pacer.SetTargetFPS(200);
+    pacer.BeginFrame();
+    pacer.EndFrame();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pacer.BeginFrame();
+    REQUIRE(pacer.GetLastFrameTime() >= 20000);
+    pacer.EndFrame();
+
+    // The next frame waits for a whole frame after the late one.
+    Clock::time_point start = Clock::now();
+    pacer.BeginFrame();
+    pacer.EndFrame();
+    REQUIRE(microsecondsSince(start) >= 4000);
+
+    FramePacer::Statistics statistics = pacer.GetStatistics();
+    REQUIRE(statistics.framesCount == 2);
+    REQUIRE(statistics.missedDeadlinesCount == 1);
+    REQUIRE(statistics.maximumFrameTime >= 20000);
+
+    pacer.ResetStatistics();
+    REQUIRE(pacer.GetStatistics().framesCount == 0);
+    REQUIRE(pacer.GetStatistics().missedDeadlinesCount == 0);
+  }
+  SECTION("Frames are not waited for without a target") {
+    FramePacer pacer;
+    pacer.BeginFrame();
+    pacer.EndFrame();
+
+    Clock::time_point start = Clock::now();
+    pacer.BeginFrame();
+    pacer.EndFrame();
+    REQUIRE(microsecondsSince(start) < 2000);
+    REQUIRE(pacer.GetSleepEstimate() == 2000);  // No sleep was measured.
+  }
+  SECTION("Statistics are computed on the last frames") {
+    FramePacer pacer(4);
+    pacer.SetTargetFPS(1000);
+    pacer.BeginFrame();
+    pacer.EndFrame();
+    for (int i = 0; i < 10; ++i) {
+      pacer.BeginFrame();
+      pacer.EndFrame();
+    }
+
+    REQUIRE(pacer.GetStatistics().framesCount == 4);
+    REQUIRE(pacer.GetStatistics().minimumFrameTime >= 1000);
+  }
+}
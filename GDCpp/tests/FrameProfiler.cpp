@@ -0,0 +1,193 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering FrameProfiler class.
+ */
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include "GDCore/CommonTools.h"
+#include "GDCpp/Runtime/FrameProfilerStream.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+TEST_CASE("FrameProfiler", "[game-engine]") {
+  SECTION("Frames kept in a ring buffer") {
+    FrameProfiler profiler(3);
+    REQUIRE(profiler.GetFramesCount() == 0);
+
+    for (int i = 0; i < 5; ++i) {
+      profiler.BeginFrame();
+      profiler.AddBehaviorTime("Behavior", false, i);
+      profiler.EndFrame();
+    }
+
+    // Only the last 3 frames are kept, from the oldest to the newest.
+    REQUIRE(profiler.GetFramesCount() == 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+      const FrameProfiler::FrameRecord& frame = profiler.GetFrame(i);
+      REQUIRE(frame.behaviors.size() == 1);
+      REQUIRE(frame.behaviors[0].duration == static_cast<int>(i) + 2);
+    }
+    REQUIRE(profiler.GetFrame(0).startTime <= profiler.GetFrame(2).startTime);
+
+    profiler.Clear();
+    REQUIRE(profiler.GetFramesCount() == 0);
+  }
+  SECTION("Behaviors times") {
+    FrameProfiler profiler;
+    profiler.BeginFrame();
+    profiler.AddBehaviorTime("Platformer", false, 10);
+    profiler.AddBehaviorTime("Pathfinding", false, 5);
+    profiler.AddBehaviorTime("Platformer", false, 20);
+    profiler.AddBehaviorTime("Platformer", true, 1);
+    profiler.EndFrame();
+
+    const FrameProfiler::FrameRecord& frame = profiler.GetFrame(0);
+    REQUIRE(frame.behaviors.size() == 3);
+    REQUIRE(profiler.GetBehaviorName(frame.behaviors[0].nameIndex) ==
+            "Platformer");
+    REQUIRE(frame.behaviors[0].postEvents == false);
+    REQUIRE(frame.behaviors[0].callsCount == 2);
+    REQUIRE(frame.behaviors[0].duration == 30);
+    REQUIRE(profiler.GetBehaviorName(frame.behaviors[1].nameIndex) ==
+            "Pathfinding");
+    REQUIRE(frame.behaviors[2].nameIndex == frame.behaviors[0].nameIndex);
+    REQUIRE(frame.behaviors[2].postEvents == true);
+  }
+  SECTION("Chrome trace export") {
+    FrameProfiler profiler;
+    REQUIRE(profiler.ExportToChromeTrace() ==
+            "{\"traceEvents\":[],\"displayTimeUnit\":\"ms\"}");
+
+    profiler.BeginFrame();
+    {
+      FrameProfiler::PhaseTimer timer(&profiler, FrameProfiler::Events);
+    }
+    profiler.AddBehaviorTime("My \"behavior\"", true, 7);
+    profiler.EndFrame();
+
+    gd::String trace = profiler.ExportToChromeTrace();
+    REQUIRE(trace.find("{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\"") !=
+            gd::String::npos);
+    REQUIRE(trace.find("{\"name\":\"Events\",\"cat\":\"phase\"") !=
+            gd::String::npos);
+    REQUIRE(trace.find("{\"name\":\"My \\\"behavior\\\"\",\"cat\":"
+                       "\"behavior\"") != gd::String::npos);
+    REQUIRE(trace.find("\"dur\":7,\"pid\":1,\"tid\":1,"
+                       "\"args\":{\"calls\":1}}") != gd::String::npos);
+  }
+  SECTION("Stream messages") {
+    FrameProfiler profiler(3);
+    FrameProfilerStream stream;
+    stream.SetSamplingRate(2);
+    FrameProfilerStream::MemoryStats stats;
+    stats.objectsCount = 12;
+    stats.scratchArenaCapacity = 4096;
+    for (std::size_t i = 0; i < gd::SystemStats::MemoryCategoriesCount; ++i) {
+      stats.usedMemory[i] = i * 10;
+      stats.usedMemoryHighWaterMarks[i] = i * 20;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+      profiler.BeginFrame();
+      profiler.AddBehaviorTime(i < 3 ? "Platformer" : "Pathfinding", true, i);
+      profiler.EndFrame();
+    }
+
+    // Frames 0 and 1 are not in the ring buffer anymore: only the frames 2
+    // and 4 are sampled.
+    std::string message;
+    stream.WriteMessage(profiler, stats, message);
+    SceneSnapshotReader reader(message.data(), message.size());
+    REQUIRE(reader.ReadBool() == true);
+    REQUIRE(reader.ReadUInt() == 2);
+    REQUIRE(reader.ReadString() == "Platformer");
+    REQUIRE(reader.ReadString() == "Pathfinding");
+    REQUIRE(reader.ReadUInt() == 2);
+    for (std::size_t frame = 2; frame <= 4; frame += 2) {
+      REQUIRE(reader.ReadUInt() == frame);
+      reader.ReadInt();  // Start time
+      reader.ReadInt();  // Duration
+      for (std::size_t phase = 0; phase < FrameProfiler::PhasesCount; ++phase)
+        reader.ReadInt();
+
+      REQUIRE(reader.ReadUInt() == 1);
+      REQUIRE(reader.ReadUInt() == (frame == 2 ? 0 : 1));
+      REQUIRE(reader.ReadBool() == true);
+      REQUIRE(reader.ReadUInt() == 1);
+      REQUIRE(reader.ReadInt() == static_cast<int>(frame));
+    }
+    REQUIRE(reader.ReadUInt() == 12);
+    REQUIRE(reader.ReadUInt() == 4096);
+    REQUIRE(reader.ReadUInt() == gd::SystemStats::MemoryCategoriesCount);
+    for (std::size_t i = 0; i < gd::SystemStats::MemoryCategoriesCount; ++i) {
+      REQUIRE(reader.ReadUInt() == i * 10);
+      REQUIRE(reader.ReadUInt() == i * 20);
+    }
+    REQUIRE(reader.IsAtEnd());
+    REQUIRE(reader.IsValid());
+
+    // Only the new frames and names are sent in the next messages.
+    profiler.BeginFrame();
+    profiler.AddBehaviorTime("Physics", false, 3);
+    profiler.EndFrame();
+    stream.WriteMessage(profiler, stats, message);
+    SceneSnapshotReader nextReader(message.data(), message.size());
+    REQUIRE(nextReader.ReadBool() == false);
+    REQUIRE(nextReader.ReadUInt() == 1);
+    REQUIRE(nextReader.ReadString() == "Physics");
+    REQUIRE(nextReader.ReadUInt() == 0);  // Frame 5 is not sampled.
+
+    // A new profiler starts again from the first frame.
+    profiler.Clear();
+    profiler.BeginFrame();
+    profiler.EndFrame();
+    stream.WriteMessage(profiler, stats, message);
+    SceneSnapshotReader clearedReader(message.data(), message.size());
+    REQUIRE(clearedReader.ReadBool() == true);
+    REQUIRE(clearedReader.ReadUInt() == 3);
+  }
+  SECTION("Frames of a scene") {
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    gd::Object object("object");
+    RuntimeObject* runtimeObject =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new RuntimeObject(scene, object)));
+    gd::SerializerElement behaviorContent;
+    runtimeObject->AddBehavior(
+        "MyBehavior", gd::make_unique<RuntimeBehavior>(behaviorContent));
+
+    REQUIRE(scene.GetFrameProfiler() == NULL);
+    scene.RenderAndStep();
+
+    scene.EnableFrameProfiler(true, 10);
+    REQUIRE(scene.GetFrameProfiler() != NULL);
+    scene.RenderAndStep();
+    scene.RenderAndStep();
+
+    FrameProfiler& profiler = *scene.GetFrameProfiler();
+    REQUIRE(profiler.GetFramesCount() == 2);
+
+    const FrameProfiler::FrameRecord& frame = profiler.GetFrame(1);
+    REQUIRE(frame.duration >= 0);
+    REQUIRE(frame.behaviors.size() == 2);
+    REQUIRE(profiler.GetBehaviorName(frame.behaviors[0].nameIndex) ==
+            "MyBehavior");
+    REQUIRE(frame.behaviors[0].postEvents == false);
+    REQUIRE(frame.behaviors[1].postEvents == true);
+    REQUIRE(frame.phasesStartTimes[FrameProfiler::Rendering] >=
+            frame.phasesStartTimes[FrameProfiler::Events]);
+
+    scene.EnableFrameProfiler(false);
+    REQUIRE(scene.GetFrameProfiler() == NULL);
+  }
+}
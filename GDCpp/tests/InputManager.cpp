@@ -52,6 +52,40 @@ TEST_CASE("InputManager", "[game-engine]") {
     m.HandleEvent(keyEvent);
     REQUIRE(m.AnyKeyIsPressed() == false);
   }
+  SECTION("Key states") {
+    InputManager m;
+
+    sf::Event keyPressed;
+    keyPressed.type = sf::Event::KeyPressed;
+    keyPressed.key = {sf::Keyboard::Space, false, false, false, false};
+    sf::Event keyReleased;
+    keyReleased.type = sf::Event::KeyReleased;
+    keyReleased.key = {sf::Keyboard::Space, false, false, false, false};
+    sf::Event unknownKey;
+    unknownKey.type = sf::Event::KeyPressed;
+    unknownKey.key = {sf::Keyboard::Unknown, false, false, false, false};
+
+    m.NextFrame();
+    m.HandleEvent(unknownKey);
+    m.HandleEvent(keyPressed);
+    REQUIRE(m.IsKeyPressed("Space") == true);
+    REQUIRE(m.WasKeyJustPressed("Space") == true);
+    REQUIRE(m.IsKeyPressed("a") == false);
+    REQUIRE(m.IsKeyPressed("NotAKey") == false);
+
+    m.NextFrame();
+    REQUIRE(m.IsKeyPressed("Space") == true);
+    REQUIRE(m.WasKeyJustPressed("Space") == false);
+    REQUIRE(m.WasKeyReleased("Space") == false);
+
+    m.NextFrame();
+    m.HandleEvent(keyReleased);
+    REQUIRE(m.IsKeyPressed("Space") == false);
+    REQUIRE(m.WasKeyReleased("Space") == true);
+
+    m.NextFrame();
+    REQUIRE(m.WasKeyReleased("Space") == false);
+  }
   SECTION("Mouse event management") {
     InputManager m;
 
@@ -60,6 +94,47 @@ TEST_CASE("InputManager", "[game-engine]") {
     REQUIRE(m.IsMouseButtonReleased("Left") == false);
     REQUIRE(m.IsMouseButtonReleased("Right") == false);
 
-    // We can't mock mouse buttons.
+    sf::Event buttonPressed;
+    buttonPressed.type = sf::Event::MouseButtonPressed;
+    buttonPressed.mouseButton = {sf::Mouse::Right, 10, 20};
+    sf::Event buttonReleased;
+    buttonReleased.type = sf::Event::MouseButtonReleased;
+    buttonReleased.mouseButton = {sf::Mouse::Right, 30, 40};
+
+    m.NextFrame();
+    m.HandleEvent(buttonPressed);
+    REQUIRE(m.IsMouseButtonPressed("Right") == true);
+    REQUIRE(m.IsMouseButtonPressed("Left") == false);
+    REQUIRE(m.GetMousePosition() == sf::Vector2i(10, 20));
+
+    m.NextFrame();
+    m.HandleEvent(buttonReleased);
+    REQUIRE(m.IsMouseButtonPressed("Right") == false);
+    REQUIRE(m.IsMouseButtonReleased("Right") == true);
+    REQUIRE(m.GetMousePosition() == sf::Vector2i(30, 40));
+
+    m.NextFrame();
+    REQUIRE(m.IsMouseButtonReleased("Right") == false);
+  }
+  SECTION("Touches simulating the mouse") {
+    InputManager m;
+
+    sf::Event touchBegan;
+    touchBegan.type = sf::Event::TouchBegan;
+    touchBegan.touch = {0, 15, 25};
+    sf::Event touchEnded;
+    touchEnded.type = sf::Event::TouchEnded;
+    touchEnded.touch = {0, 15, 25};
+
+    m.NextFrame();
+    m.HandleEvent(touchBegan);
+    REQUIRE(m.IsMouseButtonPressed("Left") == true);
+    REQUIRE(m.GetMousePosition() == sf::Vector2i(15, 25));
+
+    m.NextFrame();
+    m.HandleEvent(touchEnded);
+    m.NextFrame();
+    REQUIRE(m.IsMouseButtonPressed("Left") == false);
+    REQUIRE(m.IsMouseButtonReleased("Left") == true);
   }
 }
@@ -0,0 +1,97 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering InputRecording class.
+ */
+#include "GDCpp/Runtime/InputRecording.h"
+#include "GDCpp/Extensions/Builtin/CommonInstructionsTools.h"
+#include "GDCpp/Runtime/InputManager.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("InputRecording", "[game-engine]") {
+  sf::Event keyPressed;
+  keyPressed.type = sf::Event::KeyPressed;
+  keyPressed.key.code = sf::Keyboard::Left;
+  keyPressed.key.alt = false;
+  keyPressed.key.control = true;
+  keyPressed.key.shift = false;
+  keyPressed.key.system = false;
+
+  sf::Event mouseMoved;
+  mouseMoved.type = sf::Event::MouseMoved;
+  mouseMoved.mouseMove.x = -12;
+  mouseMoved.mouseMove.y = 345;
+
+  SECTION("Events are recorded by frame") {
+    InputRecording recording;
+    recording.AddEvent(keyPressed);
+    recording.AddEvent(mouseMoved);
+    recording.EndFrame(16000);
+    recording.EndFrame(17000);
+
+    REQUIRE(recording.GetFramesCount() == 2);
+    REQUIRE(recording.GetFrames()[0].elapsedTime == 16000);
+    REQUIRE(recording.GetFrames()[0].events.size() == 2);
+    REQUIRE(recording.GetFrames()[1].elapsedTime == 17000);
+    REQUIRE(recording.GetFrames()[1].events.size() == 0);
+  }
+  SECTION("Recordings are saved and loaded") {
+    InputRecording recording(42);
+    recording.AddEvent(keyPressed);
+    recording.EndFrame(16000);
+    recording.AddEvent(mouseMoved);
+    recording.EndFrame(17000);
+
+    std::string data;
+    recording.SaveTo(data);
+
+    InputRecording loadedRecording;
+    REQUIRE(loadedRecording.LoadFrom(data));
+    REQUIRE(loadedRecording.GetRandomSeed() == 42);
+    REQUIRE(loadedRecording.GetFramesCount() == 2);
+
+    const auto& frames = loadedRecording.GetFrames();
+    REQUIRE(frames[0].elapsedTime == 16000);
+    REQUIRE(frames[0].events.size() == 1);
+    REQUIRE(frames[0].events[0].type == sf::Event::KeyPressed);
+    REQUIRE(frames[0].events[0].key.code == sf::Keyboard::Left);
+    REQUIRE(frames[0].events[0].key.control == true);
+    REQUIRE(frames[1].events[0].type == sf::Event::MouseMoved);
+    REQUIRE(frames[1].events[0].mouseMove.x == -12);
+    REQUIRE(frames[1].events[0].mouseMove.y == 345);
+
+    REQUIRE(!loadedRecording.LoadFrom(data.substr(0, data.size() - 1)));
+    REQUIRE(loadedRecording.GetFramesCount() == 0);
+    REQUIRE(!loadedRecording.LoadFrom("Not a recording"));
+  }
+  SECTION("Replayed events are handled by the input manager") {
+    InputRecording recording;
+    recording.AddEvent(keyPressed);
+    recording.EndFrame(16000);
+
+    InputManager inputManager;
+    inputManager.NextFrame();
+    for (sf::Event event : recording.GetFrames()[0].events)
+      inputManager.HandleEvent(event);
+    REQUIRE(inputManager.IsKeyPressed("Left"));
+  }
+  SECTION("Random numbers can be generated again") {
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    InputRecording recording(42);
+    scene.StartInputRecording(recording);
+    double first = GDpriv::CommonInstructions::Random(1000000, scene);
+    double second = GDpriv::CommonInstructions::RandomFloat(1, scene);
+    scene.StopInputRecording();
+
+    RuntimeScene otherScene(NULL, &game);
+    otherScene.ReplayInputRecording(recording);
+    REQUIRE(GDpriv::CommonInstructions::Random(1000000, otherScene) == first);
+    REQUIRE(GDpriv::CommonInstructions::RandomFloat(1, otherScene) == second);
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering InstancesStreamer class.
+ */
+#include "GDCpp/Runtime/InstancesStreamer.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+void AddInstance(gd::InitialInstancesContainer& instances, float x, float y) {
+  gd::InitialInstance& instance = instances.InsertNewInitialInstance();
+  instance.SetObjectName("MyObject");
+  instance.SetX(x);
+  instance.SetY(y);
+}
+}  // namespace
+
+TEST_CASE("InstancesStreamer", "[game-engine]") {
+  RuntimeGame game;
+  gd::Layout& layout = game.InsertNewLayout("Scene", 0);
+  layout.InsertObject(gd::Object("MyObject"), 0);
+
+  gd::InitialInstancesContainer instances;
+  AddInstance(instances, 10, 10);
+  AddInstance(instances, 20, 30);
+  AddInstance(instances, 150, 10);
+  AddInstance(instances, 1050, 10);
+  AddInstance(instances, -50, -50);
+
+  RuntimeScene scene(NULL, &game);
+  scene.LoadFromScene(layout);
+  REQUIRE(scene.objectsInstances.GetAllObjects().size() == 0);
+
+  InstancesStreamer streamer;
+  REQUIRE(streamer.IsEnabled() == false);
+  streamer.Load(instances, 100, 100);
+  REQUIRE(streamer.IsEnabled() == true);
+  REQUIRE(streamer.GetChunksCount() == 4);
+
+  SECTION("Objects of the chunks near the center are created") {
+    REQUIRE(streamer.Update(scene, 50, 50, 0) == 4);
+    REQUIRE(streamer.GetLoadedChunksCount() == 3);
+    REQUIRE(scene.objectsInstances.GetAllObjects().size() == 4);
+
+    // Nothing changes while the center stays in the same area.
+    REQUIRE(streamer.Update(scene, 60, 50, 0) == 0);
+    REQUIRE(scene.objectsInstances.GetAllObjects().size() == 4);
+  }
+
+  SECTION("Objects are created over several updates") {
+    REQUIRE(streamer.Update(scene, 50, 50, 3) == 3);
+    REQUIRE(streamer.Update(scene, 50, 50, 3) == 1);
+    REQUIRE(streamer.Update(scene, 50, 50, 3) == 0);
+  }
+
+  SECTION("Objects of the chunks leaving the radius are deleted") {
+    streamer.Update(scene, 50, 50, 0);
+    REQUIRE(streamer.Update(scene, 1050, 50, 0) == 1);
+    REQUIRE(streamer.GetLoadedChunksCount() == 1);
+
+    std::size_t deletedObjects = 0;
+    for (RuntimeObject* object : scene.objectsInstances.GetAllObjects())
+      if (object->GetName().empty()) deletedObjects++;
+    REQUIRE(deletedObjects == 4);
+  }
+
+  SECTION("Objects deleted by the game are not created again") {
+    streamer.Update(scene, 50, 50, 0);
+    RuntimeObject* object = scene.objectsInstances.GetAllObjects()[0];
+    object->DeleteFromScene(scene);
+    streamer.ObjectDeleted(object);
+
+    streamer.Update(scene, 1050, 50, 0);
+    REQUIRE(streamer.Update(scene, 50, 50, 0) == 3);
+  }
+}
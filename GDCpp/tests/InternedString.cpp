@@ -0,0 +1,45 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering InternedString class.
+ */
+#include "GDCpp/Runtime/InternedString.h"
+#include <functional>
+#include <unordered_map>
+#include "catch.hpp"
+
+TEST_CASE("InternedString", "[game-engine]") {
+  SECTION("Strings are interned only once") {
+    InternedString layer1("Layer");
+    InternedString layer2(gd::String("Layer"));
+    InternedString otherLayer("OtherLayer");
+    std::size_t count = InternedString::GetInternedStringsCount();
+
+    REQUIRE(layer1 == layer2);
+    REQUIRE(layer1 != otherLayer);
+    REQUIRE(&layer1.GetString() == &layer2.GetString());
+    REQUIRE(layer1.GetString() == "Layer");
+    REQUIRE(layer1.GetHash() == std::hash<gd::String>()("Layer"));
+    REQUIRE(InternedString("Layer") == layer1);
+    REQUIRE(InternedString::GetInternedStringsCount() == count);
+  }
+
+  SECTION("Empty string") {
+    InternedString empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty == InternedString(""));
+    REQUIRE(empty != InternedString("Layer"));
+  }
+
+  SECTION("Use as a key") {
+    std::unordered_map<InternedString, int> values;
+    values[InternedString("A")] = 1;
+    values[InternedString("B")] = 2;
+    REQUIRE(values[InternedString("A")] == 1);
+    REQUIRE(values[InternedString("B")] == 2);
+    REQUIRE(values.size() == 2);
+  }
+}
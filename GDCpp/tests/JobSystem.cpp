@@ -0,0 +1,84 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering JobSystem class.
+ */
+#include "GDCpp/Runtime/JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+
+TEST_CASE("JobSystem", "[game-engine]") {
+  SECTION("All the indices are covered once") {
+    JobSystem jobSystem(4);
+    REQUIRE(jobSystem.GetThreadsCount() == 4);
+
+    // Catch assertions can't be used by other threads: results are checked
+    // once ParallelFor returned.
+    for (std::size_t count : {0, 1, 10, 1000, 1001}) {
+      std::vector<std::atomic<int>> calls(count);
+      for (auto& call : calls) call = 0;
+      std::atomic<std::size_t> largestRange(0);
+
+      jobSystem.ParallelFor(
+          count, 16, [&calls, &largestRange](std::size_t begin,
+                                             std::size_t end) {
+            if (end - begin > largestRange) largestRange = end - begin;
+            for (std::size_t i = begin; i < end; ++i) calls[i]++;
+          });
+      REQUIRE(largestRange <= 16);
+      for (std::size_t i = 0; i < count; ++i) REQUIRE(calls[i] == 1);
+    }
+  }
+  SECTION("Ranges are run by several threads") {
+    JobSystem jobSystem(4);
+    std::atomic<int> runningRanges(0);
+    std::atomic<int> maxRunningRanges(0);
+    jobSystem.ParallelFor(64, 1, [&](std::size_t, std::size_t) {
+      int running = ++runningRanges;
+      int max = maxRunningRanges;
+      while (running > max && !maxRunningRanges.compare_exchange_weak(max,
+                                                                      running))
+        ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      runningRanges--;
+    });
+
+    REQUIRE(maxRunningRanges > 1);
+    REQUIRE(maxRunningRanges <= 4);
+  }
+  SECTION("Nested calls are run on the calling thread") {
+    JobSystem jobSystem(4);
+    std::atomic<std::size_t> done(0);
+    std::atomic<bool> nestedOnCallingThread(true);
+    jobSystem.ParallelFor(8, 1, [&](std::size_t, std::size_t) {
+      std::thread::id thread = std::this_thread::get_id();
+      jobSystem.ParallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+        if (std::this_thread::get_id() != thread)
+          nestedOnCallingThread = false;
+        done += end - begin;
+      });
+    });
+
+    REQUIRE(done == 800);
+    REQUIRE(nestedOnCallingThread);
+  }
+  SECTION("Work is done on the calling thread without other threads") {
+    JobSystem jobSystem(1);
+    std::thread::id callingThread = std::this_thread::get_id();
+    std::size_t done = 0;
+    bool onCallingThread = true;
+    jobSystem.ParallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+      onCallingThread &= std::this_thread::get_id() == callingThread;
+      done += end - begin;
+    });
+
+    REQUIRE(done == 100);
+    REQUIRE(onCallingThread);
+  }
+}
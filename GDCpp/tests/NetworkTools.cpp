@@ -7,6 +7,9 @@
  * @file Tests covering network features and JSON serialization.
  */
 #include "GDCpp/Extensions/Builtin/NetworkTools.h"
+#include "GDCpp/Extensions/Builtin/HttpRequestsManager.h"
+#include <chrono>
+#include <iostream>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
@@ -48,5 +51,98 @@ TEST_CASE("NetworkTools", "[game-engine]") {
           VariableStructureToJSON(var) ==
           "{\"0\": \"Hello \\\"you\\\"\",\"1\": 42,\"2\": {\"a\": \"world\"}}");
     }
+
+    SECTION("Blanks, numbers and literals") {
+      gd::Variable var;
+      gd::String originalJSON =
+          "{\r\n\t\"a\" : [1, 2.5,-3e2],\n\"b\":{ },\"c\":[],\"d\" :true,"
+          "\"e\": false, \"f\": null}";
+      JSONToVariableStructure(originalJSON, var);
+      REQUIRE(var.GetChild("a").GetChild("0").GetValue() == 1);
+      REQUIRE(var.GetChild("a").GetChild("1").GetValue() == 2.5);
+      REQUIRE(var.GetChild("a").GetChild("2").GetValue() == -300);
+      REQUIRE(var.GetChild("d").GetValue() == 1);
+      REQUIRE(var.GetChild("e").GetValue() == 0);
+      REQUIRE(var.GetChild("f").GetValue() == 0);
+      REQUIRE(VariableStructureToJSON(var) ==
+              "{\"a\": {\"0\": 1,\"1\": 2.5,\"2\": -300},\"b\": 0,\"c\": "
+              "0,\"d\": 1,\"e\": 0,\"f\": 0}");
+    }
+
+    SECTION("Unicode") {
+      gd::Variable var;
+      JSONToVariableStructure(
+          "[\"\\u00e9t\\u00E9\", \"\\ud83d\\ude00\", \"\xC3\xA9\"]", var);
+      REQUIRE(var.GetChild("0").GetString() == u8"\u00e9t\u00e9");
+      REQUIRE(var.GetChild("1").GetString() == u8"\U0001F600");
+      REQUIRE(var.GetChild("2").GetString() == u8"\u00e9");
+    }
+
+    SECTION("Invalid JSON") {
+      gd::Variable var;
+      JSONToVariableStructure("{\"a\": 1, \"b\": \"unfinished", var);
+      REQUIRE(var.GetChild("a").GetValue() == 1);
+      JSONToVariableStructure("[1, 2", var);
+      JSONToVariableStructure("{\"a\" 1}", var);
+    }
+  }
+}
+
+TEST_CASE("NetworkTools - Benchmarks", "[.][benchmark][game-engine]") {
+  // Build a large structure, similar to a save of a game.
+  gd::Variable save;
+  for (std::size_t i = 0; i < 20000; ++i) {
+    gd::Variable& item = save.GetChild("Item" + gd::String::From(i));
+    item.GetChild("name").SetString("An \"item\" with a name " +
+                                    gd::String::From(i));
+    item.GetChild("x").SetValue(i * 1.5);
+    item.GetChild("y").SetValue(-1.0 * i);
+    item.GetChild("tags").GetChild("0").SetString("first");
+    item.GetChild("tags").GetChild("1").SetString("second");
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  gd::String json = VariableStructureToJSON(save);
+  auto middle = std::chrono::steady_clock::now();
+  gd::Variable loadedSave;
+  JSONToVariableStructure(json, loadedSave);
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(VariableStructureToJSON(loadedSave) == json);
+  std::cout << "VariableStructureToJSON of " << json.Raw().size()
+            << " bytes took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(middle -
+                                                                     start)
+                   .count()
+            << "ms, JSONToVariableStructure took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     middle)
+                   .count()
+            << "ms." << std::endl;
+}
+
+TEST_CASE("HttpRequestsManager", "[game-engine]") {
+  HttpRequestsManager manager;
+  gd::Variable response;
+  response.SetString("Not sent");
+
+  SECTION("Invalid requests fail at the next update") {
+    manager.SendRequest(
+        "MyRequest", "invalid host", "/", "", "GET", "", &response, 30);
+    REQUIRE(manager.IsRequestFinished("MyRequest") == false);
+
+    manager.Update();
+    REQUIRE(manager.IsRequestFinished("MyRequest") == true);
+    REQUIRE(manager.HasRequestSucceeded("MyRequest") == false);
+    REQUIRE(response.GetString() == "Not sent");
+    REQUIRE(manager.IsRequestFinished("OtherRequest") == false);
+  }
+
+  SECTION("Cancelled requests are forgotten") {
+    manager.DownloadFile("MyRequest", "invalid host", "/", "file.txt", 30);
+    manager.CancelRequest("MyRequest");
+
+    manager.Update();
+    REQUIRE(manager.IsRequestFinished("MyRequest") == false);
   }
 }
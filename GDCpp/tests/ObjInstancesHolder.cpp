@@ -62,4 +62,177 @@ TEST_CASE("ObjInstancesHolder", "[common]") {
     REQUIRE(container.GetObjects("2").size() == 3);
     REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
   }
+  SECTION("Removing objects with or without keeping the order") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+
+    for (bool keepObjectsOrder : {false, true}) {
+      RuntimeScene scene(NULL, &game);
+      ObjInstancesHolder& container = scene.objectsInstances;
+      container.SetKeepObjectsOrder(keepObjectsOrder);
+
+      std::vector<RuntimeObject*> objects;
+      for (int i = 0; i < 5; ++i)
+        objects.push_back(container.AddObject(
+            std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1))));
+
+      container.RemoveObject(objects[1]);
+      container.RemoveObject(objects[3]);
+      objects[0]->DeleteFromScene(scene);
+
+      auto remainingObjects = container.GetObjectsRawPointers("1");
+      REQUIRE(remainingObjects.size() == 2);
+      REQUIRE(container.GetObjects("").size() == 1);
+      REQUIRE(container.GetAllObjects().size() == 3);
+      if (keepObjectsOrder) {
+        REQUIRE(remainingObjects[0] == objects[2]);
+        REQUIRE(remainingObjects[1] == objects[4]);
+      }
+
+      // Removing the remaining objects must still work after they were moved.
+      container.RemoveObject(objects[4]);
+      container.RemoveObject(objects[2]);
+      container.RemoveObject(objects[0]);
+      REQUIRE(container.GetAllObjects().size() == 0);
+    }
+  }
+  SECTION("Recycling deleted objects") {
+    gd::Object obj1("1");
+    obj1.GetVariables().Insert("MyVariable", gd::Variable(), 0).SetValue(1);
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    ObjInstancesHolder& container = scene.objectsInstances;
+    std::size_t typeId = ObjInstancesHolder::GetObjectTypeId("1");
+
+    RuntimeObject* object = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    object->SetX(42);
+    object->SetZOrder(5);
+    object->SetLayer("OtherLayer");
+    object->GetVariables().Get("MyVariable").SetValue(10);
+
+    object->DeleteFromScene(scene);
+    container.RemoveObject(object);
+    REQUIRE(container.GetAllObjects().size() == 0);
+    REQUIRE(container.GetRecycledObjectsCount(typeId) == 1);
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("OtherLayer").empty());
+
+    // The deleted instance is reused, as if it was a new object.
+    std::unique_ptr<RuntimeObject> newObject =
+        container.CreateObject(scene, obj1);
+    REQUIRE(newObject.get() == object);
+    REQUIRE(container.GetRecycledObjectsCount(typeId) == 0);
+    REQUIRE(newObject->GetName() == "1");
+    REQUIRE(newObject->GetX() == 0);
+    REQUIRE(newObject->GetZOrder() == 0);
+    REQUIRE(newObject->GetLayer() == "");
+    REQUIRE(newObject->GetVariables().Get("MyVariable").GetValue() == 1);
+
+    container.AddObject(std::move(newObject));
+    REQUIRE(container.GetObjects("1").size() == 1);
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("") ==
+            std::vector<RuntimeObject*>({object}));
+
+    // Deleted instances are destroyed when the container is cleared.
+    object->DeleteFromScene(scene);
+    container.RemoveObject(object);
+    REQUIRE(container.GetRecycledObjectsCount(typeId) == 1);
+    container.Clear();
+    REQUIRE(container.GetRecycledObjectsCount(typeId) == 0);
+  }
+  SECTION("Objects sorted by z-order") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder container;
+    std::vector<RuntimeObject*> objects;
+    for (int i = 0; i < 4; ++i) {
+      std::unique_ptr<RuntimeObject> object(new RuntimeObject(scene, obj1));
+      object->SetZOrder(10 - i);
+      objects.push_back(container.AddObject(std::move(object)));
+    }
+
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("") ==
+            std::vector<RuntimeObject*>(
+                {objects[3], objects[2], objects[1], objects[0]}));
+
+    // Objects with the same z-order are kept in the order they were added.
+    objects[0]->SetZOrder(7);
+    objects[3]->SetZOrder(9);
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("") ==
+            std::vector<RuntimeObject*>(
+                {objects[0], objects[2], objects[1], objects[3]}));
+
+    objects[1]->SetLayer("OtherLayer");
+    container.RemoveObject(objects[2]);
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("") ==
+            std::vector<RuntimeObject*>({objects[0], objects[3]}));
+    REQUIRE(container.GetLayerObjectsSortedByZOrder("OtherLayer") ==
+            std::vector<RuntimeObject*>({objects[1]}));
+  }
+  SECTION("Positions and forces of the objects") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    std::unique_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+    obj1A->SetX(10);
+    obj1A->SetY(20);
+    obj1A->AddForce(100, -50, 1);
+
+    ObjInstancesHolder container;
+    RuntimeObject* obj1APtr = container.AddObject(std::move(obj1A));
+    RuntimeObject* obj1BPtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    REQUIRE(container.GetTransforms().GetCount() == 2);
+    REQUIRE(obj1APtr->GetX() == 10);
+    REQUIRE(obj1APtr->GetY() == 20);
+
+    obj1BPtr->SetX(-5);
+    container.GetTransforms().ApplyForces(0.5);
+    REQUIRE(obj1APtr->GetX() == 60);
+    REQUIRE(obj1APtr->GetY() == -5);
+    REQUIRE(obj1BPtr->GetX() == -5);
+    REQUIRE(obj1BPtr->GetY() == 0);
+
+    // Removed objects keep their position.
+    container.RemoveObject(obj1APtr);
+    REQUIRE(container.GetTransforms().GetCount() == 1);
+    REQUIRE(obj1BPtr->GetX() == -5);
+
+    ObjInstancesHolder copy = container;
+    REQUIRE(copy.GetTransforms().GetCount() == 1);
+    REQUIRE(copy.GetAllObjects()[0]->GetX() == -5);
+
+    container.RemoveObjects("1");
+    REQUIRE(container.GetTransforms().GetCount() == 0);
+  }
+  SECTION("Objects type identifiers") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    std::size_t typeId = ObjInstancesHolder::GetObjectTypeId("1");
+    REQUIRE(ObjInstancesHolder::GetObjectTypeId("1") == typeId);
+    REQUIRE(ObjInstancesHolder::GetObjectTypeId("NotAnObject") != typeId);
+    REQUIRE(ObjInstancesHolder::GetObjectTypeName(typeId) == "1");
+
+    ObjInstancesHolder container;
+    REQUIRE(container.GetObjects(typeId).size() == 0);
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    REQUIRE(container.GetObjects(typeId).size() == 2);
+    REQUIRE(container.GetObjectsRawPointers(typeId).size() == 2);
+    REQUIRE(container.GetObjectsRawPointers(
+                ObjInstancesHolder::GetObjectTypeId("UnusedObject"))
+                .size() == 0);
+  }
 }
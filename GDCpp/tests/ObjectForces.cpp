@@ -0,0 +1,58 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ObjectForces class.
+ */
+#include "GDCpp/Runtime/ObjectForces.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjectForces", "[game-engine]") {
+  SECTION("Totals") {
+    ObjectForces forces;
+    REQUIRE(forces.GetTotalX() == 0);
+    REQUIRE(forces.GetTotalY() == 0);
+
+    forces.Add(10, -5, 1);
+    forces.Add(2, 3, 0.5);
+    REQUIRE(forces.GetCount() == 2);
+    REQUIRE(forces.GetTotalX() == 12);
+    REQUIRE(forces.GetTotalY() == -2);
+
+    forces.Clear();
+    REQUIRE(forces.GetCount() == 0);
+    REQUIRE(forces.GetTotalX() == 0);
+    REQUIRE(forces.GetTotalY() == 0);
+  }
+  SECTION("Forces are reduced by their clearing") {
+    ObjectForces forces;
+    forces.Add(10, -5, 1);   // Permanent force.
+    forces.Add(4, 8, 0.5);   // Halved after one second.
+    forces.Add(100, 0, 0);   // Instant force, applied only once.
+
+    forces.Update(1);
+    REQUIRE(forces.GetCount() == 2);
+    REQUIRE(forces.GetTotalX() == Approx(12));
+    REQUIRE(forces.GetTotalY() == Approx(-1));
+
+    forces.Update(0.5);
+    REQUIRE(forces.GetCount() == 2);
+    REQUIRE(forces.GetTotalX() == Approx(11.5));
+    REQUIRE(forces.GetTotalY() == Approx(-2));
+  }
+  SECTION("Forces reduced to nothing are removed") {
+    ObjectForces forces;
+    forces.Add(3, 4, 0.5);
+
+    // Reduced beyond 0, then removed at the next update.
+    forces.Update(3);
+    REQUIRE(forces.GetCount() == 1);
+    REQUIRE(forces.GetTotalX() == Approx(-1.5));
+    forces.Update(1);
+    REQUIRE(forces.GetCount() == 0);
+    REQUIRE(forces.GetTotalX() == 0);
+    REQUIRE(forces.GetTotalY() == 0);
+  }
+}
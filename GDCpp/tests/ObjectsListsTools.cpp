@@ -59,6 +59,31 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1.size() == 1);
     REQUIRE(list1[0] == &obj1A);
   }
+  SECTION("PickObjectsByComparison") {
+    obj1A.SetX(100);
+    obj1B.SetX(600);
+    obj1C.SetX(700);
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    auto getX = [](RuntimeObject* object) { return object->GetX(); };
+
+    REQUIRE(PickObjectsByComparison(
+                scene, list1, getX, RelationalOperator::Greater, 500, false) ==
+            true);
+    REQUIRE(list1.size() == 2);
+    REQUIRE(list1[0] == &obj1B);
+    REQUIRE(list1[1] == &obj1C);
+
+    REQUIRE(PickObjectsByComparison(
+                scene, list1, getX, RelationalOperator::Equal, 600, true) ==
+            true);
+    REQUIRE(list1.size() == 1);
+    REQUIRE(list1[0] == &obj1C);
+
+    REQUIRE(PickObjectsByComparison(
+                scene, list1, getX, RelationalOperator::Less, 700, false) ==
+            false);
+    REQUIRE(list1.empty());
+  }
   SECTION("TwoObjectListsTest") {
     std::map<gd::String, std::vector<RuntimeObject*>*> map1;
     std::map<gd::String, std::vector<RuntimeObject*>*> map2;
@@ -68,11 +93,11 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     map2["2"] = &list2;
 
     REQUIRE(TwoObjectListsTest(
-                map1, map2, false, [](RuntimeObject*, RuntimeObject*) {
+                scene, map1, map2, false, [](RuntimeObject*, RuntimeObject*) {
                   return true;
                 }) == true);
     REQUIRE(TwoObjectListsTest(
-                map1, map2, true, [](RuntimeObject*, RuntimeObject*) {
+                scene, map1, map2, true, [](RuntimeObject*, RuntimeObject*) {
                   return false;
                 }) == true);
 
@@ -80,6 +105,7 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list2.size() == 3);
 
     REQUIRE(TwoObjectListsTest(
+                scene,
                 map1,
                 map2,
                 true,
@@ -90,6 +116,7 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list2.size() == 3);  // but not obj2C
 
     REQUIRE(TwoObjectListsTest(
+                scene,
                 map1,
                 map2,
                 false,
@@ -101,6 +128,29 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
     REQUIRE(list2[0] == &obj2C);
   }
+  SECTION("TwoObjectListsTest with the same objects in both lists") {
+    std::map<gd::String, std::vector<RuntimeObject*>*> map;
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    map["1"] = &list1;
+
+    ScratchArena::Marker marker = scene.GetScratchArena().GetMarker();
+    REQUIRE(TwoObjectListsTest(
+                scene,
+                map,
+                map,
+                false,
+                [&obj1A, &obj1C](RuntimeObject* obj1, RuntimeObject* obj2) {
+                  return obj1 == &obj1A && obj2 == &obj1C;
+                }) == true);
+    REQUIRE(list1.size() == 2);
+    REQUIRE(list1[0] == &obj1A);
+    REQUIRE(list1[1] == &obj1C);
+
+    // Temporary memory must have been given back to the arena.
+    REQUIRE(scene.GetScratchArena().GetMarker().blockIndex ==
+            marker.blockIndex);
+    REQUIRE(scene.GetScratchArena().GetMarker().offset == marker.offset);
+  }
   SECTION("PickNearestObject") {
     std::map<gd::String, std::vector<RuntimeObject*>*> map;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
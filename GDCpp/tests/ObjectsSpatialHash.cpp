@@ -0,0 +1,141 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ObjectsSpatialHash class.
+ */
+#include "GDCpp/Runtime/ObjectsSpatialHash.h"
+#include <algorithm>
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjectsSpatialHash", "[game-engine]") {
+  gd::Object obj("1");
+
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  RuntimeObject objA(scene, obj);
+  RuntimeObject objB(scene, obj);
+  RuntimeObject objC(scene, obj);
+  objA.SetX(10);
+  objA.SetY(10);
+  objB.SetX(500);
+  objB.SetY(20);
+  objC.SetX(-300);
+  objC.SetY(-300);
+
+  ObjectsSpatialHash spatialHash(100);
+  spatialHash.Update(&objA);
+  spatialHash.Update(&objB);
+  spatialHash.Update(&objC);
+  REQUIRE(spatialHash.GetObjectsCount() == 3);
+
+  auto query = [&spatialHash](float left, float top, float width, float height) {
+    std::vector<RuntimeObject*> result;
+    spatialHash.QueryAABB(sf::FloatRect(left, top, width, height), result);
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  SECTION("Queries") {
+    REQUIRE(query(0, 0, 50, 50) == std::vector<RuntimeObject*>{&objA});
+    REQUIRE(query(600, 600, 50, 50).empty());
+
+    std::vector<RuntimeObject*> expected = {&objA, &objB, &objC};
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(query(-1000, -1000, 2000, 2000) == expected);
+
+    // Touching edges are considered as overlapping
+    REQUIRE(query(500, 20, 10, 10) == std::vector<RuntimeObject*>{&objB});
+  }
+  SECTION("Objects moving and removed") {
+    objA.SetX(510);
+    REQUIRE(query(0, 0, 50, 50) == std::vector<RuntimeObject*>{&objA});
+
+    spatialHash.Update(&objA);
+    REQUIRE(query(0, 0, 50, 50).empty());
+
+    std::vector<RuntimeObject*> expected = {&objA, &objB};
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(query(450, 0, 100, 50) == expected);
+
+    spatialHash.Remove(&objB);
+    REQUIRE(spatialHash.Has(&objB) == false);
+    REQUIRE(spatialHash.GetObjectsCount() == 2);
+    REQUIRE(query(450, 0, 100, 50) == std::vector<RuntimeObject*>{&objA});
+
+    spatialHash.Clear();
+    REQUIRE(spatialHash.GetObjectsCount() == 0);
+    REQUIRE(query(-1000, -1000, 2000, 2000).empty());
+  }
+  SECTION("Point, radius and nearest queries") {
+    std::vector<RuntimeObject*> result;
+    spatialHash.QueryPoint(10, 10, result);
+    REQUIRE(result == std::vector<RuntimeObject*>{&objA});
+
+    result.clear();
+    spatialHash.QueryPoint(11, 10, result);
+    REQUIRE(result.empty());
+
+    result.clear();
+    spatialHash.QueryRadius(200, 20, 300, result);
+    std::sort(result.begin(), result.end());
+    std::vector<RuntimeObject*> expected = {&objA, &objB};
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(result == expected);
+
+    result.clear();
+    spatialHash.QueryRadius(200, 20, 100, result);
+    REQUIRE(result.empty());
+
+    result.clear();
+    spatialHash.QueryNearest(400, 0, 2, result);
+    REQUIRE(result == (std::vector<RuntimeObject*>{&objB, &objA}));
+
+    result.clear();
+    spatialHash.QueryNearest(-1000, -1000, 1, result);
+    REQUIRE(result == std::vector<RuntimeObject*>{&objC});
+
+    result.clear();
+    spatialHash.QueryNearest(0, 0, 10, result);
+    REQUIRE(result == (std::vector<RuntimeObject*>{&objA, &objC, &objB}));
+  }
+  SECTION("Segment queries") {
+    auto querySegment = [&spatialHash](
+                            float x1, float y1, float x2, float y2) {
+      std::vector<RuntimeObject*> result;
+      spatialHash.ForEachObjectAlongSegment(
+          x1, y1, x2, y2, [&result](RuntimeObject* object) {
+            result.push_back(object);
+            return 1.0f;
+          });
+      return result;
+    };
+
+    REQUIRE(querySegment(0, 10, 1000, 10) ==
+            std::vector<RuntimeObject*>{&objA});
+    REQUIRE(querySegment(0, 0, 1000, 40) ==
+            (std::vector<RuntimeObject*>{&objA, &objB}));
+    REQUIRE(querySegment(1000, 40, 0, 0) ==
+            (std::vector<RuntimeObject*>{&objB, &objA}));
+    REQUIRE(querySegment(-1000, -1000, 0, 0) ==
+            std::vector<RuntimeObject*>{&objC});
+    REQUIRE(querySegment(0, 100, 1000, 100).empty());
+
+    // The traversal stops after the part of the segment returned by the
+    // callback.
+    std::vector<RuntimeObject*> result;
+    spatialHash.ForEachObjectAlongSegment(
+        0, 0, 1000, 40, [&result](RuntimeObject* object) {
+          result.push_back(object);
+          return 0.1f;
+        });
+    REQUIRE(result == std::vector<RuntimeObject*>{&objA});
+  }
+}
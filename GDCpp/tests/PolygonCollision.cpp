@@ -0,0 +1,118 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the collision and raycast tests between polygons.
+ */
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include <cmath>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "catch.hpp"
+
+namespace {
+Polygon2d CreateRectangle(float x, float y, float width, float height) {
+  Polygon2d rectangle;
+  rectangle.vertices.push_back(sf::Vector2f(x, y));
+  rectangle.vertices.push_back(sf::Vector2f(x + width, y));
+  rectangle.vertices.push_back(sf::Vector2f(x + width, y + height));
+  rectangle.vertices.push_back(sf::Vector2f(x, y + height));
+  return rectangle;
+}
+
+Polygon2d CreateRegularPolygon(float x,
+                               float y,
+                               float radius,
+                               std::size_t verticesCount) {
+  Polygon2d polygon;
+  for (std::size_t i = 0; i < verticesCount; ++i) {
+    float angle = 2 * 3.14159265f * i / verticesCount;
+    polygon.vertices.push_back(
+        sf::Vector2f(x + radius * cos(angle), y + radius * sin(angle)));
+  }
+  return polygon;
+}
+}  // namespace
+
+TEST_CASE("PolygonCollision", "[game-engine]") {
+  SECTION("Collision between rectangles") {
+    Polygon2d a = CreateRectangle(0, 0, 10, 10);
+    Polygon2d b = CreateRectangle(8, 0, 10, 10);
+    Polygon2d c = CreateRectangle(10, 0, 10, 10);
+    Polygon2d d = CreateRectangle(30, 0, 10, 10);
+
+    CollisionResult result = PolygonCollisionTest(a, b);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.move_axis.x == Approx(-2));
+    REQUIRE(result.move_axis.y == Approx(0));
+
+    REQUIRE(PolygonCollisionTest(a, c).collision == true);
+    REQUIRE(PolygonCollisionTest(a, c, true).collision == false);
+    REQUIRE(PolygonCollisionTest(a, d).collision == false);
+  }
+  SECTION("Collision with polygons having a lot of vertices") {
+    Polygon2d a = CreateRectangle(0, 0, 10, 10);
+    Polygon2d circle = CreateRegularPolygon(12, 5, 4, 16);  // Spans 8 to 16.
+
+    CollisionResult result = PolygonCollisionTest(a, circle);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.move_axis.x == Approx(-2));
+    REQUIRE(std::abs(result.move_axis.y) < 0.0001);
+    REQUIRE(PolygonCollisionTest(
+                a, CreateRegularPolygon(30, 5, 4, 16)).collision == false);
+  }
+  SECTION("Collision with a list of polygons") {
+    Polygon2d a = CreateRectangle(0, 0, 10, 10);
+    std::vector<Polygon2d> candidates;
+    candidates.push_back(CreateRectangle(30, 0, 10, 10));
+    REQUIRE(PolygonCollisionTestAny(a, candidates) == false);
+
+    candidates.push_back(CreateRectangle(8, 0, 10, 10));
+    candidates.push_back(CreateRectangle(0, 7, 10, 10));
+    candidates.push_back(CreateRegularPolygon(12, 5, 4, 16));
+    REQUIRE(PolygonCollisionTestAny(a, candidates) == true);
+
+    sf::Vector2f moveAxisSum;
+    REQUIRE(PolygonCollisionTestAll(a, candidates, moveAxisSum) == 3);
+    REQUIRE(moveAxisSum.x == Approx(-4));
+    REQUIRE(moveAxisSum.y == Approx(-3));
+  }
+  SECTION("Raycast") {
+    Polygon2d a = CreateRectangle(10, 0, 10, 10);
+
+    RaycastResult result = PolygonRaycastTest(a, 0, 5, 30, 5);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.closePoint.x == Approx(10));
+    REQUIRE(result.closeSqDist == Approx(100));
+    REQUIRE(result.farPoint.x == Approx(20));
+    REQUIRE(result.farSqDist == Approx(400));
+
+    REQUIRE(PolygonRaycastTest(a, 0, 5, 5, 5).collision == false);
+    REQUIRE(PolygonRaycastTest(a, 0, 20, 30, 20).collision == false);
+
+    // Ray along an edge
+    result = PolygonRaycastTest(a, 0, 0, 15, 0);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.closePoint.x == Approx(10));
+    REQUIRE(result.farPoint.x == Approx(15));
+  }
+  SECTION("Raycast against a list of polygons") {
+    std::vector<Polygon2d> polygons;
+    polygons.push_back(CreateRectangle(40, 0, 10, 10));
+    polygons.push_back(CreateRectangle(10, 0, 10, 10));
+    polygons.push_back(CreateRegularPolygon(100, 5, 4, 16));
+
+    RaycastResult result = PolygonsRaycastTest(polygons, 0, 5, 60, 5, true);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.closePoint.x == Approx(10));
+
+    result = PolygonsRaycastTest(polygons, 0, 5, 60, 5, false);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.farPoint.x == Approx(50));
+
+    REQUIRE(PolygonsRaycastTest(polygons, 0, 20, 60, 20, true).collision ==
+            false);
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering PreparedInstances class.
+ */
+#include "GDCpp/Runtime/PreparedInstances.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("PreparedInstances", "[game-engine]") {
+  RuntimeGame game;
+  gd::Layout& layout = game.InsertNewLayout("Scene", 0);
+  layout.InsertObject(gd::Object("MyObject"), 0);
+
+  gd::InitialInstancesContainer instances;
+  gd::InitialInstance& instance = instances.InsertNewInitialInstance();
+  instance.SetObjectName("MyObject");
+  instance.SetX(10);
+  instance.SetY(20);
+  instance.SetZOrder(3);
+  instance.SetLayer("Foreground");
+  instance.GetVariables().InsertNew("MyVariable").SetValue(42);
+  instances.InsertNewInitialInstance().SetObjectName("UnknownObject");
+
+  RuntimeScene scene(NULL, &game);
+  scene.LoadFromScene(layout);
+
+  SECTION("Objects are created from the prototypes") {
+    PreparedInstances prepared(scene, instances);
+    REQUIRE(prepared.GetPrototypesCount() == 1);
+    REQUIRE(scene.objectsInstances.GetAllObjects().size() == 0);
+
+    prepared.CreateObjects(scene, 100, 200);
+    prepared.CreateObjects(scene, 300, 400);
+    RuntimeObjNonOwningPtrList objects =
+        scene.objectsInstances.GetObjectsRawPointers("MyObject");
+    REQUIRE(objects.size() == 2);
+    REQUIRE(objects[0]->GetX() == 110);
+    REQUIRE(objects[0]->GetY() == 220);
+    REQUIRE(objects[1]->GetX() == 310);
+    REQUIRE(objects[1]->GetY() == 420);
+    REQUIRE(objects[1]->GetZOrder() == 3);
+    REQUIRE(objects[1]->GetLayer() == "Foreground");
+    REQUIRE(objects[1]->GetVariables().Get("MyVariable").GetValue() == 42);
+
+    // The objects don't share their variables.
+    objects[0]->GetVariables().Get("MyVariable").SetValue(1);
+    REQUIRE(objects[1]->GetVariables().Get("MyVariable").GetValue() == 42);
+  }
+
+  SECTION("The instances are prepared once by the scene") {
+    scene.CreateObjectsFromPreparedInstances(instances, 0, 0);
+    instance.SetX(500);
+    scene.CreateObjectsFromPreparedInstances(instances, 0, 0);
+    RuntimeObjNonOwningPtrList objects =
+        scene.objectsInstances.GetObjectsRawPointers("MyObject");
+    REQUIRE(objects.size() == 2);
+    REQUIRE(objects[1]->GetX() == 10);
+  }
+}
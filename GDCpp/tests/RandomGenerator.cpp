@@ -0,0 +1,73 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RandomGenerator class.
+ */
+#include "GDCpp/Runtime/RandomGenerator.h"
+#include <vector>
+#include "catch.hpp"
+
+TEST_CASE("RandomGenerator", "[game-engine]") {
+  SECTION("Seeded generators generate the same numbers") {
+    RandomGenerator generator(42);
+    RandomGenerator sameGenerator(42);
+    RandomGenerator otherGenerator(43);
+    bool allDifferent = true;
+    for (int i = 0; i < 100; ++i) {
+      std::uint64_t number = generator.Next();
+      REQUIRE(sameGenerator.Next() == number);
+      if (otherGenerator.Next() == number) allDifferent = false;
+    }
+    REQUIRE(allDifferent);
+
+    generator.Seed(42);
+    sameGenerator.Seed(42);
+    REQUIRE(generator.NextInteger(1000) == sameGenerator.NextInteger(1000));
+  }
+  SECTION("The state can be restored") {
+    RandomGenerator generator(7);
+    generator.Next();
+    RandomGenerator::State state = generator.GetState();
+    double first = generator.NextDouble();
+    std::uint64_t second = generator.NextInteger(10);
+
+    generator.Next();
+    generator.SetState(state);
+    REQUIRE(generator.NextDouble() == first);
+    REQUIRE(generator.NextInteger(10) == second);
+  }
+  SECTION("Integers are between 0 and the maximum") {
+    RandomGenerator generator(1);
+    std::vector<int> counts(7, 0);
+    for (int i = 0; i < 7000; ++i) {
+      std::uint64_t number = generator.NextInteger(6);
+      REQUIRE(number <= 6);
+      counts[number]++;
+    }
+    for (int count : counts) {
+      REQUIRE(count > 800);
+      REQUIRE(count < 1200);
+    }
+
+    REQUIRE(generator.NextInteger(0) == 0);
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(generator.NextInteger(5000000000ULL) <= 5000000000ULL);
+    }
+  }
+  SECTION("Floats are between 0 and 1") {
+    RandomGenerator generator(2);
+    double sum = 0;
+    for (int i = 0; i < 10000; ++i) {
+      double number = generator.NextDouble();
+      REQUIRE(number >= 0);
+      REQUIRE(number < 1);
+      sum += number;
+    }
+    double average = sum / 10000;
+    REQUIRE(average > 0.45);
+    REQUIRE(average < 0.55);
+  }
+}
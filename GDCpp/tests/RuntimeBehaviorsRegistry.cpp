@@ -0,0 +1,98 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeBehaviorsRegistry class.
+ */
+#include "GDCpp/Runtime/RuntimeBehaviorsRegistry.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+namespace {
+class BatchedRuntimeBehavior;
+typedef RuntimeBehaviorsRegistry<BatchedRuntimeBehavior> Registry;
+
+class BatchedRuntimeBehavior : public RuntimeBehavior {
+ public:
+  BatchedRuntimeBehavior(const gd::SerializerElement& behaviorContent)
+      : RuntimeBehavior(behaviorContent), registrationsCount(0) {}
+
+  static void StepAllPreEvents(
+      RuntimeScene& scene,
+      const std::vector<BatchedRuntimeBehavior*>& behaviors) {
+    lastSteppedCount = behaviors.size();
+  }
+
+  int registrationsCount;
+  static std::size_t lastSteppedCount;
+
+ protected:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    registrationsCount++;
+    scene.GetExtensionData<Registry>().AddBehavior(this);
+  }
+};
+std::size_t BatchedRuntimeBehavior::lastSteppedCount = 0;
+}  // namespace
+
+TEST_CASE("RuntimeBehaviorsRegistry", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object object("object");
+  RuntimeObject runtimeObject1(scene, object);
+  std::unique_ptr<RuntimeObject> runtimeObject2(
+      new RuntimeObject(scene, object));
+  gd::SerializerElement behaviorContent;
+  Registry& registry = scene.GetExtensionData<Registry>();
+
+  auto behavior1 = new BatchedRuntimeBehavior(behaviorContent);
+  auto behavior2 = new BatchedRuntimeBehavior(behaviorContent);
+  runtimeObject1.AddBehavior("Behavior",
+                             std::unique_ptr<RuntimeBehavior>(behavior1));
+  runtimeObject2->AddBehavior("Behavior",
+                              std::unique_ptr<RuntimeBehavior>(behavior2));
+
+  SECTION("Registered behaviors are stepped in batch") {
+    runtimeObject1.DoBehaviorsPreEvents(scene);
+    runtimeObject2->DoBehaviorsPreEvents(scene);
+    REQUIRE(registry.GetBehaviorsCount() == 2);
+    REQUIRE(behavior1->IsSteppedInBatch() == true);
+
+    registry.PreEvents(scene);
+    REQUIRE(BatchedRuntimeBehavior::lastSteppedCount == 2);
+
+    // The objects don't step the registered behaviors anymore.
+    runtimeObject1.DoBehaviorsPreEvents(scene);
+    REQUIRE(behavior1->registrationsCount == 1);
+  }
+
+  SECTION("Deactivated and destroyed behaviors are unregistered") {
+    runtimeObject1.DoBehaviorsPreEvents(scene);
+    runtimeObject2->DoBehaviorsPreEvents(scene);
+
+    runtimeObject1.ActivateBehavior("Behavior", false);
+    REQUIRE(registry.GetBehaviorsCount() == 1);
+    REQUIRE(behavior1->IsSteppedInBatch() == false);
+    registry.PreEvents(scene);
+    REQUIRE(BatchedRuntimeBehavior::lastSteppedCount == 1);
+
+    // Activated again, the behavior is stepped by its object and registers
+    // again.
+    runtimeObject1.ActivateBehavior("Behavior", true);
+    runtimeObject1.DoBehaviorsPreEvents(scene);
+    REQUIRE(behavior1->registrationsCount == 2);
+    REQUIRE(registry.GetBehaviorsCount() == 2);
+
+    runtimeObject2.reset();
+    REQUIRE(registry.GetBehaviorsCount() == 1);
+    registry.PreEvents(scene);
+    REQUIRE(BatchedRuntimeBehavior::lastSteppedCount == 1);
+  }
+}
@@ -0,0 +1,62 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeContext class.
+ */
+#include "GDCpp/Runtime/RuntimeContext.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("RuntimeContext", "[game-engine]") {
+  gd::Object obj1("1");
+
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  RuntimeObject* obj1A = scene.objectsInstances.AddObject(
+      std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+  RuntimeObject* obj1B = scene.objectsInstances.AddObject(
+      std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+
+  RuntimeContext context(&scene);
+  std::size_t typeId = RuntimeContext::GetObjectTypeId("1");
+
+  SECTION("Frame objects lists") {
+    std::vector<RuntimeObject*>* firstList = NULL;
+    {
+      RuntimeContext::FrameObjectsList list(context, typeId);
+      REQUIRE(list.Get() == std::vector<RuntimeObject*>({obj1A, obj1B}));
+      firstList = &list.Get();
+
+      {
+        RuntimeContext::FrameObjectsList copy(context, list.Get());
+        REQUIRE(&copy.Get() != &list.Get());
+        REQUIRE(copy.Get() == list.Get());
+
+        copy.Get().pop_back();
+        REQUIRE(list.Get().size() == 2);
+      }
+
+      RuntimeContext::FrameObjectsList empty(context);
+      REQUIRE(empty.Get().empty());
+    }
+
+    // Lists are reused after being given back.
+    RuntimeContext::FrameObjectsList list(context);
+    REQUIRE(&list.Get() == firstList);
+    REQUIRE(list.Get().empty());
+    REQUIRE(list.Get().capacity() >= 2);
+  }
+  SECTION("Reset at the end of a frame") {
+    std::vector<RuntimeObject*>& list = context.AcquireFrameObjectsList();
+    context.AcquireFrameObjectsList();
+    context.ResetFrameObjectsLists();
+
+    REQUIRE(&context.AcquireFrameObjectsList() == &list);
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeLayer and RuntimeCamera classes.
+ */
+#include "GDCpp/Runtime/RuntimeLayer.h"
+#include <SFML/Graphics/View.hpp>
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class SquareRuntimeObject : public RuntimeObject {
+ public:
+  SquareRuntimeObject(RuntimeScene& scene, const gd::Object& object)
+      : RuntimeObject(scene, object) {}
+
+  virtual float GetWidth() const { return 32; }
+  virtual float GetHeight() const { return 32; }
+};
+}  // namespace
+
+TEST_CASE("RuntimeCamera", "[game-engine]") {
+  SECTION("Visible area") {
+    sf::View view(sf::FloatRect(0, 0, 800, 600));
+    RuntimeCamera camera(view);
+
+    sf::FloatRect area = camera.GetVisibleArea();
+    REQUIRE(area.left == Approx(0));
+    REQUIRE(area.top == Approx(0));
+    REQUIRE(area.width == Approx(800));
+    REQUIRE(area.height == Approx(600));
+
+    camera.SetZoom(2);
+    camera.SetViewCenter(sf::Vector2f(1000, 1000));
+    area = camera.GetVisibleArea();
+    REQUIRE(area.left == Approx(800));
+    REQUIRE(area.top == Approx(850));
+    REQUIRE(area.width == Approx(400));
+    REQUIRE(area.height == Approx(300));
+
+    // The area of a rotated camera is the bounding box of the rendered area.
+    camera.SetZoom(1);
+    camera.SetRotation(90);
+    area = camera.GetVisibleArea();
+    REQUIRE(area.left == Approx(700));
+    REQUIRE(area.top == Approx(600));
+    REQUIRE(area.width == Approx(600));
+    REQUIRE(area.height == Approx(800));
+  }
+  SECTION("View version") {
+    sf::View view(sf::FloatRect(0, 0, 800, 600));
+    RuntimeCamera camera(view);
+    RuntimeCamera otherCamera(view);
+    REQUIRE(camera.GetViewVersion() != otherCamera.GetViewVersion());
+
+    std::size_t version = camera.GetViewVersion();
+    camera.GetVisibleArea();
+    REQUIRE(camera.GetViewVersion() == version);
+
+    camera.SetViewCenter(sf::Vector2f(1000, 1000));
+    REQUIRE(camera.GetViewVersion() != version);
+    version = camera.GetViewVersion();
+    camera.SetZoom(2);
+    REQUIRE(camera.GetViewVersion() != version);
+
+    // Copies have the same view, so the same version.
+    RuntimeCamera copy(camera);
+    REQUIRE(copy.GetViewVersion() == camera.GetViewVersion());
+  }
+}
+
+TEST_CASE("RuntimeLayer", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object object("object");
+
+  SECTION("Area of a cached layer") {
+    SquareRuntimeObject objectA(scene, object);
+    SquareRuntimeObject objectB(scene, object);
+    SquareRuntimeObject hiddenObject(scene, object);
+    objectA.SetX(10.5);
+    objectA.SetY(-20);
+    objectB.SetX(100);
+    objectB.SetY(50);
+    hiddenObject.SetX(1000);
+    hiddenObject.SetHidden();
+
+    REQUIRE(RuntimeLayer::ComputeCacheArea({}) == sf::IntRect());
+    REQUIRE(RuntimeLayer::ComputeCacheArea(
+                {&objectA, &objectB, &hiddenObject}) ==
+            sf::IntRect(10, -20, 122, 102));
+  }
+  SECTION("Objects modifications change their rendering hash") {
+    SquareRuntimeObject square(scene, object);
+    std::size_t hash = square.GetRenderingHash();
+    REQUIRE(square.GetRenderingHash() == hash);
+
+    square.SetX(10);
+    REQUIRE(square.GetRenderingHash() != hash);
+    hash = square.GetRenderingHash();
+    square.SetZOrder(3);
+    REQUIRE(square.GetRenderingHash() != hash);
+    hash = square.GetRenderingHash();
+    square.SetHidden();
+    REQUIRE(square.GetRenderingHash() != hash);
+  }
+}
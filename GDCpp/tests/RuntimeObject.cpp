@@ -0,0 +1,154 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeObject class.
+ */
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+namespace {
+class CountingRuntimeBehavior : public RuntimeBehavior {
+ public:
+  CountingRuntimeBehavior(const gd::SerializerElement& behaviorContent,
+                          RuntimeBehavior* other_ = nullptr)
+      : RuntimeBehavior(behaviorContent),
+        preEventsCount(0),
+        postEventsCount(0),
+        other(other_) {}
+
+  int preEventsCount;
+  int postEventsCount;
+
+ protected:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    preEventsCount++;
+    if (other) other->Activate(false);
+  }
+  virtual void DoStepPostEvents(RuntimeScene& scene) { postEventsCount++; }
+
+ private:
+  RuntimeBehavior* other;  ///< Deactivated at each step, if any.
+};
+
+class SquareRuntimeObject : public RuntimeObject {
+ public:
+  SquareRuntimeObject(RuntimeScene& scene, const gd::Object& object)
+      : RuntimeObject(scene, object) {}
+
+  virtual float GetWidth() const { return 32; }
+  virtual float GetHeight() const { return 32; }
+};
+}  // namespace
+
+TEST_CASE("RuntimeObject", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object object("object");
+  RuntimeObject runtimeObject(scene, object);
+  gd::SerializerElement behaviorContent;
+
+  SECTION("Behaviors identifiers") {
+    std::size_t behaviorId = RuntimeObject::GetBehaviorId("MyBehavior");
+    REQUIRE(RuntimeObject::GetBehaviorId("MyBehavior") == behaviorId);
+    REQUIRE(RuntimeObject::GetBehaviorId("MyOtherBehavior") != behaviorId);
+    REQUIRE(runtimeObject.GetBehaviorRawPointerById(behaviorId) == nullptr);
+
+    runtimeObject.AddBehavior(
+        "MyBehavior", gd::make_unique<RuntimeBehavior>(behaviorContent));
+    REQUIRE(runtimeObject.GetBehaviorRawPointerById(behaviorId) ==
+            runtimeObject.GetBehaviorRawPointer("MyBehavior"));
+    REQUIRE(runtimeObject.GetBehaviorRawPointerById(
+                RuntimeObject::GetBehaviorId("MyOtherBehavior")) == nullptr);
+    REQUIRE(runtimeObject.GetBehaviorRawPointerById(1000) == nullptr);
+
+    RuntimeObject copy(runtimeObject);
+    REQUIRE(copy.GetBehaviorRawPointerById(behaviorId) != nullptr);
+    REQUIRE(copy.GetBehaviorRawPointerById(behaviorId) !=
+            runtimeObject.GetBehaviorRawPointerById(behaviorId));
+  }
+
+  SECTION("Objects are kept small") {
+    // Variables and behaviors are allocated apart from the other members
+    // (see RuntimeObject::ColdData): iterating on objects must not load them.
+    REQUIRE(sizeof(RuntimeObject) <= 40 * sizeof(void*));
+
+    const RuntimeObject& constObject = runtimeObject;
+    REQUIRE(constObject.GetVariables().Has("MyVariable") == false);
+    REQUIRE(runtimeObject.HasBehaviorNamed("MyBehavior") == false);
+    REQUIRE(runtimeObject.GetBehaviorRawPointer("MyBehavior") == nullptr);
+
+    runtimeObject.GetVariables().Get("MyVariable").SetValue(42);
+    RuntimeObject copy(runtimeObject);
+    REQUIRE(copy.GetVariables().Get("MyVariable").GetValue() == 42);
+    copy.GetVariables().Get("MyVariable").SetValue(1);
+    REQUIRE(runtimeObject.GetVariables().Get("MyVariable").GetValue() == 42);
+  }
+
+  SECTION("Only activated behaviors are stepped") {
+    auto behavior1 = new CountingRuntimeBehavior(behaviorContent);
+    auto behavior2 = new CountingRuntimeBehavior(behaviorContent);
+    runtimeObject.AddBehavior("Behavior1",
+                              std::unique_ptr<RuntimeBehavior>(behavior1));
+    runtimeObject.AddBehavior("Behavior2",
+                              std::unique_ptr<RuntimeBehavior>(behavior2));
+
+    runtimeObject.DoBehaviorsPreEvents(scene);
+    runtimeObject.DoBehaviorsPostEvents(scene);
+    REQUIRE(behavior1->preEventsCount == 1);
+    REQUIRE(behavior2->postEventsCount == 1);
+
+    runtimeObject.ActivateBehavior("Behavior1", false);
+    REQUIRE(runtimeObject.BehaviorActivated("Behavior1") == false);
+    runtimeObject.DoBehaviorsPreEvents(scene);
+    runtimeObject.DoBehaviorsPostEvents(scene);
+    REQUIRE(behavior1->preEventsCount == 1);
+    REQUIRE(behavior1->postEventsCount == 1);
+    REQUIRE(behavior2->preEventsCount == 2);
+
+    runtimeObject.ActivateBehavior("Behavior1", true);
+    runtimeObject.DoBehaviorsPreEvents(scene);
+    REQUIRE(behavior1->preEventsCount == 2);
+    REQUIRE(behavior2->preEventsCount == 3);
+  }
+
+  SECTION("Behaviors deactivated while stepping are not stepped") {
+    auto behavior2 = new CountingRuntimeBehavior(behaviorContent);
+    auto behavior1 = new CountingRuntimeBehavior(behaviorContent, behavior2);
+    runtimeObject.AddBehavior("Behavior1",
+                              std::unique_ptr<RuntimeBehavior>(behavior1));
+    runtimeObject.AddBehavior("Behavior2",
+                              std::unique_ptr<RuntimeBehavior>(behavior2));
+
+    runtimeObject.DoBehaviorsPreEvents(scene);
+    REQUIRE(behavior1->preEventsCount == 1);
+    REQUIRE(behavior2->preEventsCount == 0);
+    REQUIRE(behavior2->Activated() == false);
+  }
+  SECTION("Objects are separated from the overlapping objects") {
+    SquareRuntimeObject objectA(scene, object);
+    SquareRuntimeObject objectB(scene, object);
+    SquareRuntimeObject objectC(scene, object);
+    objectB.SetX(20);
+    objectC.SetX(500);
+    objectC.SetY(500);
+
+    std::vector<RuntimeObject*> farObjects = {&objectC};
+    REQUIRE(objectA.SeparateFromObjects(farObjects) == false);
+    REQUIRE(objectA.GetX() == 0);
+    REQUIRE(objectA.GetY() == 0);
+
+    std::vector<RuntimeObject*> objects = {&objectA, &objectB, &objectC};
+    REQUIRE(objectA.SeparateFromObjects(objects) == true);
+    REQUIRE(objectA.GetX() == Approx(-12));
+    REQUIRE(objectA.GetY() == Approx(0));
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeSceneExtensionsDataHolder class.
+ */
+#include "GDCpp/Runtime/RuntimeSceneExtensionsDataHolder.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class CounterData : public RuntimeSceneExtensionData {
+ public:
+  CounterData() : count(0){};
+  virtual ~CounterData() { destroyedCount++; };
+
+  static const std::size_t sceneDataIndex;
+  static int destroyedCount;
+  int count;
+};
+const std::size_t CounterData::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+int CounterData::destroyedCount = 0;
+
+class OtherData : public RuntimeSceneExtensionData {
+ public:
+  static const std::size_t sceneDataIndex;
+  gd::String name;
+};
+const std::size_t OtherData::sceneDataIndex =
+    RuntimeSceneExtensionsDataHolder::NewDataIndex();
+}  // namespace
+
+TEST_CASE("RuntimeSceneExtensionsDataHolder", "[game-engine]") {
+  SECTION("Data created on demand and removed") {
+    RuntimeSceneExtensionsDataHolder holder;
+    REQUIRE(CounterData::sceneDataIndex != OtherData::sceneDataIndex);
+    REQUIRE(holder.Has<CounterData>() == false);
+
+    holder.Get<CounterData>().count = 3;
+    REQUIRE(holder.Has<CounterData>() == true);
+    REQUIRE(holder.Has<OtherData>() == false);
+    REQUIRE(holder.Get<CounterData>().count == 3);
+
+    holder.Get<OtherData>().name = "Hello";
+    REQUIRE(holder.Get<OtherData>().name == "Hello");
+    REQUIRE(holder.Get<CounterData>().count == 3);
+
+    int destroyedCount = CounterData::destroyedCount;
+    holder.Remove<CounterData>();
+    REQUIRE(CounterData::destroyedCount == destroyedCount + 1);
+    REQUIRE(holder.Has<CounterData>() == false);
+    REQUIRE(holder.Get<CounterData>().count == 0);
+    REQUIRE(holder.Get<OtherData>().name == "Hello");
+  }
+  SECTION("Data of each scene") {
+    RuntimeGame game;
+    RuntimeScene scene1(NULL, &game);
+    RuntimeScene scene2(NULL, &game);
+
+    scene1.GetExtensionData<CounterData>().count = 1;
+    scene2.GetExtensionData<CounterData>().count = 2;
+    REQUIRE(scene1.GetExtensionData<CounterData>().count == 1);
+    REQUIRE(scene2.GetExtensionData<CounterData>().count == 2);
+
+    // Copies of the holder don't share the data.
+    RuntimeSceneExtensionsDataHolder holder;
+    holder.Get<CounterData>().count = 4;
+    RuntimeSceneExtensionsDataHolder copy(holder);
+    REQUIRE(copy.Has<CounterData>() == false);
+  }
+}
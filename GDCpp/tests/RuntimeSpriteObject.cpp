@@ -29,6 +29,8 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     anim.SetName("First animation");
     gd::Sprite sprite;
     sprite.SetImageName("Image.png");
+    sprite.SetCustomCollisionMask({Polygon2d::CreateRectangle(10, 20)});
+    sprite.SetCollisionMaskAutomatic(false);
     anim.SetDirectionsCount(1);
     anim.GetDirection(0).AddSprite(sprite);
     obj1.AddAnimation(anim);
@@ -60,6 +62,32 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     object.SetAngle(42);
     REQUIRE(object.GetAngle() == 42);
   }
+  SECTION("Hitboxes") {
+    auto getFirstVertex = [&object]() {
+      const std::vector<Polygon2d>& hitBoxes = object.GetHitBoxesRef();
+      REQUIRE(hitBoxes.size() == 1);
+      return hitBoxes[0].vertices[0];
+    };
+
+    sf::Vector2f vertex = getFirstVertex();
+    REQUIRE(vertex.x == -5);
+    REQUIRE(vertex.y == -10);
+
+    // Hitboxes must be updated when the object is moved.
+    object.SetX(100);
+    object.SetY(200);
+    vertex = getFirstVertex();
+    REQUIRE(vertex.x == 95);
+    REQUIRE(vertex.y == 190);
+    REQUIRE(object.GetHitBoxes().size() == 1);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0] == vertex);
+
+    // ...or rotated.
+    object.SetAngle(90);
+    vertex = getFirstVertex();
+    REQUIRE(vertex.x == Approx(110));
+    REQUIRE(vertex.y == Approx(195));
+  }
   SECTION("Animations") {
     REQUIRE(object.GetCurrentAnimation() == 0);
     REQUIRE(object.GetCurrentAnimationName() == "First animation");
@@ -87,3 +115,43 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     }
   }
 }
+
+TEST_CASE("RuntimeSpriteObject animations", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  gd::SpriteObject obj1("SpriteObject");
+  gd::Animation anim;
+  anim.SetDirectionsCount(1);
+  anim.GetDirection(0).SetTimeBetweenFrames(1);
+  anim.GetDirection(0).SetLoop(false);
+  for (std::size_t i = 0; i < 3; ++i) {
+    gd::Sprite sprite;
+    sprite.SetImageName("Image.png");
+    anim.GetDirection(0).AddSprite(sprite);
+  }
+  obj1.AddAnimation(anim);
+
+  SECTION("Animations of objects that are not drawn are caught up") {
+    obj1.SetUpdateIfNotVisible(false);
+    RuntimeSpriteObject object(scene, obj1);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+      scene.GetTimeManager().Update(500000, 0);
+      object.Update(scene);
+    }
+    REQUIRE(object.GetSpriteNb() == 2);
+    REQUIRE(object.AnimationEnded() == true);
+  }
+  SECTION("Animations can be played even if the object is not drawn") {
+    obj1.SetUpdateIfNotVisible(true);
+    RuntimeSpriteObject object(scene, obj1);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+      scene.GetTimeManager().Update(500000, 0);
+      object.Update(scene);
+    }
+    REQUIRE(object.GetSpriteNb() == 1);
+    REQUIRE(object.AnimationEnded() == false);
+  }
+}
@@ -0,0 +1,183 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the snapshots of scenes.
+ */
+#include "GDCpp/Runtime/SceneSnapshot.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+#include "GDCpp/Runtime/TimeManager.h"
+#include "catch.hpp"
+
+TEST_CASE("SceneSnapshot", "[game-engine]") {
+  SECTION("Values are read as they were written") {
+    std::string data;
+    SceneSnapshotWriter writer(data);
+    writer.WriteUInt(0);
+    writer.WriteUInt(300);
+    writer.WriteInt(-5);
+    writer.WriteInt(123456789);
+    writer.WriteFloat(1.5f);
+    writer.WriteDouble(-2.25);
+    writer.WriteBool(true);
+    writer.WriteString(u8"Hello wörld");
+    REQUIRE(data.size() < 40);
+
+    SceneSnapshotReader reader(data.data(), data.size());
+    REQUIRE(reader.ReadUInt() == 0);
+    REQUIRE(reader.ReadUInt() == 300);
+    REQUIRE(reader.ReadInt() == -5);
+    REQUIRE(reader.ReadInt() == 123456789);
+    REQUIRE(reader.ReadFloat() == 1.5f);
+    REQUIRE(reader.ReadDouble() == -2.25);
+    REQUIRE(reader.ReadBool() == true);
+    REQUIRE(reader.ReadString() == u8"Hello wörld");
+    REQUIRE(reader.IsValid());
+    REQUIRE(reader.IsAtEnd());
+
+    // Reading past the end.
+    REQUIRE(reader.ReadUInt() == 0);
+    REQUIRE(reader.ReadString() == "");
+    REQUIRE(!reader.IsValid());
+  }
+  SECTION("Blocks") {
+    std::string data;
+    SceneSnapshotWriter writer(data);
+    std::size_t block = writer.BeginBlock();
+    writer.WriteUInt(42);
+    writer.WriteString("Skipped");
+    writer.EndBlock(block);
+    writer.WriteUInt(7);
+
+    SceneSnapshotReader reader(data.data(), data.size());
+    SceneSnapshotReader blockReader = reader.ReadBlock();
+    REQUIRE(reader.ReadUInt() == 7);
+    REQUIRE(reader.IsAtEnd());
+    REQUIRE(blockReader.ReadUInt() == 42);
+
+    SceneSnapshotReader truncatedReader(data.data(), 5);
+    truncatedReader.ReadBlock();
+    REQUIRE(!truncatedReader.IsValid());
+  }
+  SECTION("Variables") {
+    RuntimeVariablesContainer variables;
+    variables.Get("Number").SetValue(3);
+    variables.Get("String").SetString("Text");
+    variables.Get("Structure").GetChild("A").SetValue(1);
+    variables.Get("Structure").GetChild("B").GetChild("C").SetString("D");
+
+    std::string data;
+    SceneSnapshotWriter writer(data);
+    writer.WriteVariables(variables);
+
+    variables.Get("Number").SetValue(4);
+    variables.Get("String").SetValue(5);
+    variables.Get("Structure").GetChild("A").SetValue(2);
+    variables.Get("Structure").GetChild("E").SetValue(6);
+    variables.Get("Other").SetValue(7);
+
+    SceneSnapshotReader reader(data.data(), data.size());
+    reader.ReadVariables(variables);
+    REQUIRE(reader.IsValid());
+    REQUIRE(variables.Get("Number").GetValue() == 3);
+    REQUIRE(variables.Get("String").GetString() == "Text");
+    REQUIRE(variables.Get("Structure").GetChildrenCount() == 2);
+    REQUIRE(variables.Get("Structure").GetChild("A").GetValue() == 1);
+    REQUIRE(variables.Get("Structure").GetChild("B").GetChild("C").GetString() ==
+            "D");
+    REQUIRE(variables.Get("Other").GetValue() == 7);
+  }
+  SECTION("Deltas") {
+    std::string previous(1000, 'a');
+    std::string current = previous;
+    current[10] = 'b';
+    current[500] = 'c';
+    current[501] = 'd';
+
+    std::string delta;
+    SceneSnapshot::ComputeDelta(previous, current, delta);
+    REQUIRE(delta.size() < 20);
+
+    std::string restored;
+    REQUIRE(SceneSnapshot::ApplyDelta(previous, delta, restored));
+    REQUIRE(restored == current);
+
+    // Snapshots being longer or shorter than the previous one.
+    std::string longer = current + "More data";
+    SceneSnapshot::ComputeDelta(previous, longer, delta);
+    REQUIRE(SceneSnapshot::ApplyDelta(previous, delta, restored));
+    REQUIRE(restored == longer);
+
+    std::string shorter = current.substr(0, 600);
+    SceneSnapshot::ComputeDelta(previous, shorter, delta);
+    REQUIRE(SceneSnapshot::ApplyDelta(previous, delta, restored));
+    REQUIRE(restored == shorter);
+
+    SceneSnapshot::ComputeDelta(previous, previous, delta);
+    REQUIRE(SceneSnapshot::ApplyDelta(previous, delta, restored));
+    REQUIRE(restored == previous);
+
+    // Deltas applied on another snapshot are invalid.
+    SceneSnapshot::ComputeDelta(previous, longer, delta);
+    REQUIRE(!SceneSnapshot::ApplyDelta("Too short", delta, restored));
+  }
+  SECTION("Objects") {
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    gd::Object object("MyObject");
+
+    RuntimeObject runtimeObject(scene, object);
+    runtimeObject.SetX(10);
+    runtimeObject.SetY(-20);
+    runtimeObject.SetZOrder(3);
+    runtimeObject.AddForce(1, 2, 0.5);
+    runtimeObject.GetVariables().Get("MyVariable").SetValue(4);
+
+    std::string data;
+    SceneSnapshotWriter writer(data);
+    runtimeObject.SaveState(writer);
+
+    runtimeObject.SetX(0);
+    runtimeObject.SetZOrder(0);
+    runtimeObject.ClearForce();
+    runtimeObject.GetVariables().Get("MyVariable").SetValue(5);
+
+    SceneSnapshotReader reader(data.data(), data.size());
+    runtimeObject.RestoreState(reader);
+    REQUIRE(reader.IsValid());
+    REQUIRE(reader.IsAtEnd());
+    REQUIRE(runtimeObject.GetX() == 10);
+    REQUIRE(runtimeObject.GetY() == -20);
+    REQUIRE(runtimeObject.GetZOrder() == 3);
+    REQUIRE(runtimeObject.TotalForceX() == 1);
+    REQUIRE(runtimeObject.TotalForceY() == 2);
+    REQUIRE(runtimeObject.GetVariables().Get("MyVariable").GetValue() == 4);
+  }
+  SECTION("Timers") {
+    TimeManager timeManager;
+    timeManager.Update(1000, 0);
+    timeManager.AddTimer("MyTimer");
+    timeManager.Update(2000, 0);
+
+    std::string data;
+    SceneSnapshotWriter writer(data);
+    timeManager.SaveState(writer);
+
+    timeManager.Update(3000, 0);
+    timeManager.AddTimer("OtherTimer");
+
+    SceneSnapshotReader reader(data.data(), data.size());
+    timeManager.RestoreState(reader);
+    REQUIRE(reader.IsValid());
+    REQUIRE(timeManager.GetTimeFromStart() == 3000);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 2000);
+    REQUIRE(timeManager.FindTimer("OtherTimer") == nullptr);
+  }
+}
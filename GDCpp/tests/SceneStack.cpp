@@ -7,10 +7,13 @@
  * @file Tests covering scene stacking of GDevelop C++ Platform.
  */
 #include "GDCpp/Runtime/SceneStack.h"
+#include <chrono>
+#include <thread>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/JobSystem.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
@@ -46,6 +49,49 @@ TEST_CASE("SceneStack", "[game-engine]") {
     REQUIRE(stack.Step() == true);
   }
 
+  SECTION("StepWithoutRender") {
+    REQUIRE(stack.StepWithoutRender(20000) == false);
+
+    auto scene = stack.Replace("Scene 1", true);
+    REQUIRE(stack.StepWithoutRender(20000) == true);
+    REQUIRE(stack.StepWithoutRender(20000) == true);
+    REQUIRE(scene->GetTimeManager().GetElapsedTime() == 20000);
+    REQUIRE(scene->GetTimeManager().GetTimeFromStart() == 40000);
+  }
+
+  SECTION("StepAllWithoutRender") {
+    SceneStack otherStack(game, NULL);
+    SceneStack emptyStack(game, NULL);
+    auto scene = stack.Replace("Scene 1", true);
+    auto otherScene = otherStack.Replace("Scene 2", true);
+
+    JobSystem jobSystem(2);
+    std::vector<SceneStack *> stacks = {&stack, &otherStack, &emptyStack};
+    auto results = SceneStack::StepAllWithoutRender(stacks, 20000, jobSystem);
+    REQUIRE(results == std::vector<bool>({true, true, false}));
+    results = SceneStack::StepAllWithoutRender(stacks, 20000, jobSystem);
+    REQUIRE(scene->GetTimeManager().GetTimeFromStart() == 40000);
+    REQUIRE(otherScene->GetTimeManager().GetTimeFromStart() == 40000);
+  }
+
+  SECTION("Preload") {
+    REQUIRE(stack.Preload("test") == false);
+
+    stack.Push("Scene 1");
+    REQUIRE(stack.Preload("Scene 2") == true);
+    REQUIRE(stack.IsPreloaded("Scene 1") == false);
+    for (int i = 0; i < 1000 && !stack.IsPreloaded("Scene 2"); ++i) {
+      REQUIRE(stack.Step() == true);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(stack.IsPreloaded("Scene 2") == true);
+
+    auto scene = stack.Push("Scene 2");
+    REQUIRE(scene != nullptr);
+    REQUIRE(scene->GetName() == "Scene 2");
+    REQUIRE(stack.IsPreloaded("Scene 2") == false);
+  }
+
   SECTION("OnLoadScene") {
     stack.OnLoadScene([](RuntimeScene& scene) {
       REQUIRE(scene.GetName() == "Scene 2");
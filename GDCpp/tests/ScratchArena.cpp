@@ -0,0 +1,49 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ScratchArena class.
+ */
+#include "GDCpp/Runtime/ScratchArena.h"
+#include <cstdint>
+#include "catch.hpp"
+
+TEST_CASE("ScratchArena", "[game-engine]") {
+  ScratchArena arena(256);
+
+  SECTION("Allocations") {
+    char* a = arena.AllocateArray<char>(3);
+    double* b = arena.AllocateArray<double>(4);
+    REQUIRE(a != NULL);
+    REQUIRE(b != NULL);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(b) % alignof(double)) == 0);
+    REQUIRE(static_cast<void*>(a) != static_cast<void*>(b));
+
+    // Allocations larger than the blocks are supported.
+    int* c = arena.AllocateArray<int>(1000);
+    c[999] = 42;
+    REQUIRE(c[999] == 42);
+    REQUIRE(arena.GetCapacity() >= 256 + 1000 * sizeof(int));
+  }
+  SECTION("Memory is reused after a reset") {
+    void* a = arena.Allocate(100);
+    arena.AllocateArray<int>(1000);
+    std::size_t capacity = arena.GetCapacity();
+
+    arena.Reset();
+    REQUIRE(arena.Allocate(100) == a);
+    arena.AllocateArray<int>(1000);
+    REQUIRE(arena.GetCapacity() == capacity);
+  }
+  SECTION("Scopes") {
+    arena.Allocate(10);
+    void* a = NULL;
+    {
+      ScratchArena::Scope scope(arena);
+      a = arena.Allocate(20);
+    }
+    REQUIRE(arena.Allocate(20) == a);
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering TimeManager class.
+ */
+#include "GDCpp/Runtime/TimeManager.h"
+#include "catch.hpp"
+
+TEST_CASE("TimeManager", "[game-engine]") {
+  TimeManager timeManager;
+
+  SECTION("Timers are updated with the time elapsed since they were added") {
+    timeManager.Update(1000, 0);
+    timeManager.AddTimer("MyTimer");
+    timeManager.Update(2000, 0);
+    timeManager.Update(3000, 0);
+
+    REQUIRE(timeManager.GetTimeFromStart() == 6000);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 5000);
+    REQUIRE(timeManager.GetTimers()["MyTimer"].GetTime() == 5000);
+
+    timeManager.GetTimer("MyTimer").Reset();
+    timeManager.Update(500, 0);
+    REQUIRE(timeManager.FindTimer("MyTimer")->GetTime() == 500);
+  }
+  SECTION("Paused timers") {
+    timeManager.AddTimer("MyTimer");
+    timeManager.Update(1000, 0);
+    timeManager.GetTimer("MyTimer").SetPaused(true);
+    timeManager.Update(2000, 0);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 1000);
+
+    timeManager.GetTimer("MyTimer").SetPaused(false);
+    timeManager.Update(3000, 0);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 4000);
+  }
+  SECTION("Missing timers") {
+    REQUIRE(timeManager.HasTimer("MyTimer") == false);
+    REQUIRE(timeManager.FindTimer("MyTimer") == nullptr);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 0);
+
+    timeManager.AddTimer("MyTimer");
+    timeManager.RemoveTimer("MyTimer");
+    REQUIRE(timeManager.HasTimer("MyTimer") == false);
+  }
+  SECTION("Time scale") {
+    timeManager.AddTimer("MyTimer");
+    timeManager.SetTimeScale(2);
+    timeManager.Update(1000, 0);
+    REQUIRE(timeManager.GetTimer("MyTimer").GetTime() == 2000);
+  }
+}
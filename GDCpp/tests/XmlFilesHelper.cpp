@@ -0,0 +1,74 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering XmlFilesManager class.
+ */
+#include "GDCpp/Runtime/XmlFilesHelper.h"
+#include <cstdio>
+#include "GDCpp/Extensions/Builtin/FileTools.h"
+#include "catch.hpp"
+
+namespace {
+double ReadValueFromDisk(const gd::String& filename, const char* group) {
+  TiXmlDocument doc;
+  gd::LoadXmlFromFile(doc, filename);
+  double value = 0;
+  TiXmlElement* element = TiXmlHandle(&doc)
+                              .FirstChildElement("Save")
+                              .FirstChildElement(group)
+                              .ToElement();
+  if (element) element->Attribute("value", &value);
+
+  return value;
+}
+}  // namespace
+
+TEST_CASE("XmlFilesManager", "[game-engine]") {
+  gd::String filename = "XmlFilesManagerTest.xml";
+  GDDeleteFile(filename);
+
+  SECTION("Modified files are saved in the background") {
+    WriteValueInFile(filename, "Save/Score", 42);
+    WriteValueInFile(filename, "Save/Level", 3);
+    REQUIRE(FileExists(filename) == true);
+
+    XmlFilesManager::SaveModifiedFiles();
+    REQUIRE(XmlFilesManager::IsSavePending(filename) == false);
+    REQUIRE(ReadValueFromDisk(filename, "Score") == 42);
+    REQUIRE(ReadValueFromDisk(filename, "Level") == 3);
+
+    // The file is kept in memory: it's not loaded again from the disk.
+    std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
+    REQUIRE(XmlFilesManager::GetFile(filename) == file);
+  }
+
+  SECTION("Deleted files are not saved") {
+    WriteValueInFile(filename, "Save/Score", 42);
+    GDDeleteFile(filename);
+    REQUIRE(XmlFilesManager::IsSavePending(filename) == false);
+
+    XmlFilesManager::SaveModifiedFiles();
+    REQUIRE(FileExists(filename) == false);
+  }
+
+  SECTION("Files are read from memory if not saved yet") {
+    LoadFileInMemory(filename);
+    WriteValueInFile(filename, "Save/Score", 42);
+    UnloadFileFromMemory(filename);
+
+    std::shared_ptr<XmlFile> file = XmlFilesManager::GetFile(filename);
+    double value = 0;
+    TiXmlHandle(&file->GetTinyXmlDocument())
+        .FirstChildElement("Save")
+        .FirstChildElement("Score")
+        .ToElement()
+        ->Attribute("value", &value);
+    REQUIRE(value == 42);
+  }
+
+  XmlFilesManager::SaveModifiedFiles();
+  GDDeleteFile(filename);
+}
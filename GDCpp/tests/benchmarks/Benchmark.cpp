@@ -0,0 +1,119 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "GDCore/Serialization/SerializerElement.h"
+#if defined(WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+/**
+ * \brief Return the value below which \a percentile percent of the sorted
+ * \a samples are.
+ */
+double GetPercentile(const std::vector<double>& samples, double percentile) {
+  if (samples.empty()) return 0;
+
+  std::size_t rank = static_cast<std::size_t>(
+      std::ceil(percentile / 100.0 * samples.size()));
+  return samples[std::min(std::max<std::size_t>(rank, 1), samples.size()) -
+                 1];
+}
+}  // namespace
+
+BenchmarkSuite& BenchmarkSuite::Add(const gd::String& title,
+                                    std::function<void(std::size_t)> fn) {
+  Benchmark benchmark;
+  benchmark.title = title;
+  benchmark.fn = fn;
+  benchmarks.push_back(benchmark);
+  return *this;
+}
+
+void BenchmarkSuite::Run(const gd::String& filter) {
+  typedef std::chrono::steady_clock Clock;
+  results.clear();
+  for (const Benchmark& benchmark : benchmarks) {
+    if (!filter.empty() && benchmark.title.find(filter) == gd::String::npos)
+      continue;
+
+    std::size_t callIndex = 0;
+    for (std::size_t run = 0; run < warmUpRunsCount; ++run)
+      for (std::size_t i = 0; i < iterationsCount; ++i)
+        benchmark.fn(callIndex++);
+
+    std::vector<double> samples;
+    for (std::size_t run = 0; run < runsCount; ++run) {
+      Clock::time_point start = Clock::now();
+      for (std::size_t i = 0; i < iterationsCount; ++i)
+        benchmark.fn(callIndex++);
+      std::chrono::duration<double, std::nano> duration = Clock::now() - start;
+
+      samples.push_back(
+          iterationsCount > 0 ? duration.count() / iterationsCount : 0);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.title = benchmark.title;
+    result.iterationsCount = iterationsCount;
+    result.runsCount = runsCount;
+    result.mean = 0;
+    for (double sample : samples) result.mean += sample;
+    if (!samples.empty()) result.mean /= samples.size();
+    result.p50 = GetPercentile(samples, 50);
+    result.p99 = GetPercentile(samples, 99);
+    result.min = samples.empty() ? 0 : samples.front();
+    result.max = samples.empty() ? 0 : samples.back();
+    result.peakMemory = GetPeakMemoryUsage();
+
+    results.push_back(result);
+  }
+}
+
+void BenchmarkSuite::SerializeResultsTo(gd::SerializerElement& element) const {
+  element.ConsiderAsArrayOf("benchmark");
+  for (const Result& result : results) {
+    gd::SerializerElement& resultElement = element.AddChild("benchmark");
+    resultElement.SetAttribute("title", result.title);
+    resultElement.SetAttribute("iterationsCount",
+                               static_cast<int>(result.iterationsCount));
+    resultElement.SetAttribute("runsCount",
+                               static_cast<int>(result.runsCount));
+    resultElement.SetAttribute("meanNs", result.mean);
+    resultElement.SetAttribute("p50Ns", result.p50);
+    resultElement.SetAttribute("p99Ns", result.p99);
+    resultElement.SetAttribute("minNs", result.min);
+    resultElement.SetAttribute("maxNs", result.max);
+    resultElement.SetAttribute("peakMemoryKB",
+                               static_cast<double>(result.peakMemory));
+  }
+}
+
+std::size_t BenchmarkSuite::GetPeakMemoryUsage() {
+#if defined(WINDOWS)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+
+  return counters.PeakWorkingSetSize / 1024;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+#if defined(MACOS)
+  return usage.ru_maxrss / 1024;  // In bytes on macOS.
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
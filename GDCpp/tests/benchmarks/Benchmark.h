@@ -0,0 +1,104 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "GDCore/String.h"
+namespace gd {
+class SerializerElement;
+}
+
+/**
+ * \brief Run benchmarks measuring the time spent to execute a number of
+ * iterations of one or more functions.
+ *
+ * Each benchmark is run several times, so that the results report the
+ * average, the median, the 99th percentile, the fastest and the slowest runs.
+ * The results can be exported in JSON, to be compared between versions.
+ *
+ * Used by the benchmarks of GDCpp and of GDCore. For long operations (like
+ * loading a project), use one iteration per run, so that each call is
+ * measured separately: the slowest calls are the ones making the IDE stutter.
+ */
+class BenchmarkSuite {
+ public:
+  /**
+   * \brief The time spent by the iterations of a benchmark, in nanoseconds
+   * per iteration.
+   */
+  struct Result {
+    gd::String title;
+    std::size_t iterationsCount;  ///< The number of iterations of each run.
+    std::size_t runsCount;
+    double mean;
+    double p50;
+    double p99;
+    double min;
+    double max;
+    std::size_t peakMemory;  ///< The peak memory usage of the process once
+                             ///< the benchmark is done, in kilobytes.
+  };
+
+  /**
+   * \param iterationsCount The number of times the function of a benchmark is
+   * called during a run.
+   * \param runsCount The number of runs of each benchmark.
+   * \param warmUpRunsCount The number of runs done before the measured ones,
+   * to fill the caches and allocate the memory reused by the next runs.
+   */
+  BenchmarkSuite(std::size_t iterationsCount = 1000,
+                 std::size_t runsCount = 20,
+                 std::size_t warmUpRunsCount = 0)
+      : iterationsCount(iterationsCount),
+        runsCount(runsCount),
+        warmUpRunsCount(warmUpRunsCount){};
+
+  /**
+   * \brief Add a benchmark calling \a fn at each iteration, with the index of
+   * the call (counting the calls of all the runs, starting from 0).
+   */
+  BenchmarkSuite& Add(const gd::String& title,
+                      std::function<void(std::size_t)> fn);
+
+  /**
+   * \brief Run the benchmarks having a title containing \a filter (all the
+   * benchmarks if empty).
+   */
+  void Run(const gd::String& filter = "");
+
+  /**
+   * \brief Get the results of the benchmarks run by the last call to Run.
+   */
+  const std::vector<Result>& GetResults() const { return results; }
+
+  /**
+   * \brief Serialize the results, as an array of benchmarks.
+   */
+  void SerializeResultsTo(gd::SerializerElement& element) const;
+
+  /**
+   * \brief Return the peak memory usage of the process, in kilobytes (0 if
+   * unknown).
+   */
+  static std::size_t GetPeakMemoryUsage();
+
+ private:
+  struct Benchmark {
+    gd::String title;
+    std::function<void(std::size_t)> fn;
+  };
+
+  std::size_t iterationsCount;
+  std::size_t runsCount;
+  std::size_t warmUpRunsCount;
+  std::vector<Benchmark> benchmarks;
+  std::vector<Result> results;
+};
+
+#endif  // BENCHMARK_H
@@ -0,0 +1,185 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the objects, of the conditions used by the events and of
+ * the frames of a scene.
+ */
+#include <memory>
+#include <random>
+#include "SceneBenchmarks.h"
+#include "Benchmark.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Variable.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCpp/Extensions/Builtin/ObjectTools.h"
+#include "GDCpp/Runtime/CodeExecutionEngine.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeContext.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeSpriteObject.h"
+
+namespace {
+/**
+ * \brief A behavior moving its object at each frame.
+ */
+class MovingBehavior : public RuntimeBehavior {
+ public:
+  MovingBehavior() : RuntimeBehavior(gd::SerializerElement()){};
+  virtual ~MovingBehavior(){};
+  virtual RuntimeBehavior* Clone() const { return new MovingBehavior(*this); }
+
+ protected:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    object->SetX(object->GetX() + 1);
+  }
+};
+
+/**
+ * \brief A scene with sprites ("Sprite" objects) and a few players ("Player"
+ * objects) at random positions, with random z-orders.
+ */
+struct BenchmarkScene {
+  BenchmarkScene(std::size_t objectsCount)
+      : sprite("Sprite"), player("Player"), scene(NULL, &game) {
+    gd::Animation animation;
+    animation.SetName("Animation");
+    gd::Sprite frame;
+    frame.SetImageName("Image.png");
+    frame.SetCustomCollisionMask({Polygon2d::CreateRectangle(32, 32)});
+    frame.SetCollisionMaskAutomatic(false);
+    animation.SetDirectionsCount(1);
+    animation.GetDirection(0).AddSprite(frame);
+    sprite.AddAnimation(animation);
+    sprite.GetVariables().Insert("Life", gd::Variable(), 0);
+    player.AddAnimation(animation);
+
+    gd::Layout& layout = game.InsertNewLayout("Scene", 0);
+    layout.GetVariables().Insert("Score", gd::Variable(), 0);
+    scene.LoadFromScene(layout);
+
+    std::mt19937 generator(42);  // Same scene at each run.
+    std::uniform_real_distribution<float> position(0, 2000);
+    std::uniform_int_distribution<int> zOrder(0, 100);
+    for (std::size_t i = 0; i < objectsCount; ++i) {
+      RuntimeObjSPtr object(new RuntimeSpriteObject(scene, sprite));
+      object->SetX(position(generator));
+      object->SetY(position(generator));
+      object->SetZOrder(zOrder(generator));
+      object->AddBehavior("Moving",
+                          std::unique_ptr<RuntimeBehavior>(new MovingBehavior));
+      sprites.push_back(scene.objectsInstances.AddObject(std::move(object)));
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+      RuntimeObjSPtr object(new RuntimeSpriteObject(scene, player));
+      object->SetX(position(generator));
+      object->SetY(position(generator));
+      players.push_back(scene.objectsInstances.AddObject(std::move(object)));
+    }
+  }
+
+  RuntimeGame game;
+  gd::SpriteObject sprite;
+  gd::SpriteObject player;
+  RuntimeScene scene;
+  std::vector<RuntimeObject*> sprites;
+  std::vector<RuntimeObject*> players;
+};
+
+/**
+ * \brief Events picking the sprites on the right of the scene and changing a
+ * variable of the picked sprites, like the code generated from events.
+ */
+int BenchmarkEvents(RuntimeContext* runtimeContext) {
+  static const std::size_t spriteTypeId =
+      RuntimeContext::GetObjectTypeId("Sprite");
+
+  RuntimeContext::FrameObjectsList sprites(*runtimeContext, spriteTypeId);
+  RuntimeObjectsLists objectsLists;
+  objectsLists["Sprite"] = &sprites.Get();
+  if (PickObjectsIf(objectsLists, false, [](RuntimeObject* object) {
+        return object->GetX() > 1000;
+      })) {
+    for (RuntimeObject* object : sprites.Get())
+      object->GetVariables().Get(0) += 1;
+  }
+
+  return 0;
+}
+}  // namespace
+
+void AddSceneBenchmarks(BenchmarkSuite& suite, std::size_t objectsCount) {
+  std::shared_ptr<BenchmarkScene> benchmarkScene =
+      std::make_shared<BenchmarkScene>(objectsCount);
+  RuntimeScene& scene = benchmarkScene->scene;
+  gd::String objects = " (" + gd::String::From(objectsCount) + " objects)";
+
+  suite.Add("ObjInstancesHolder add and remove" + objects,
+            [benchmarkScene, &scene](std::size_t) {
+              RuntimeObject* object = scene.objectsInstances.AddObject(
+                  scene.objectsInstances.CreateObject(scene,
+                                                      benchmarkScene->sprite));
+              if (object) scene.objectsInstances.RemoveObject(object);
+            });
+
+  suite.Add("PickObjectsIf" + objects, [benchmarkScene](std::size_t) {
+    std::vector<RuntimeObject*> sprites = benchmarkScene->sprites;
+    RuntimeObjectsLists objectsLists;
+    objectsLists["Sprite"] = &sprites;
+    PickObjectsIf(objectsLists, false, [](RuntimeObject* object) {
+      return object->GetX() > 1000;
+    });
+  });
+
+  suite.Add("HitBoxesCollision with 10 objects" + objects,
+            [benchmarkScene, &scene](std::size_t) {
+              std::vector<RuntimeObject*> sprites = benchmarkScene->sprites;
+              std::vector<RuntimeObject*> players = benchmarkScene->players;
+              RuntimeObjectsLists spritesLists;
+              spritesLists["Sprite"] = &sprites;
+              RuntimeObjectsLists playersLists;
+              playersLists["Player"] = &players;
+              HitBoxesCollision(spritesLists, playersLists, false, scene);
+            });
+
+  suite.Add("Z-order change and sort" + objects,
+            [benchmarkScene, &scene](std::size_t i) {
+              const std::vector<RuntimeObject*>& sprites =
+                  benchmarkScene->sprites;
+              if (!sprites.empty())
+                sprites[i % sprites.size()]->SetZOrder(i % 101);
+              scene.objectsInstances.GetLayerObjectsSortedByZOrder("");
+            });
+
+  suite.Add("RuntimeVariablesContainer access by name" + objects,
+            [benchmarkScene, &scene](std::size_t) {
+              scene.GetVariables().Get("Score") += 1;
+              for (RuntimeObject* object : benchmarkScene->sprites)
+                object->GetVariables().Get("Life") += 1;
+            });
+
+  suite.Add("RuntimeVariablesContainer access by index" + objects,
+            [benchmarkScene, &scene](std::size_t) {
+              scene.GetVariables().Get(0) += 1;
+              for (RuntimeObject* object : benchmarkScene->sprites)
+                object->GetVariables().Get(0) += 1;
+            });
+
+  suite.Add("RenderAndStep without events" + objects,
+            [benchmarkScene, &scene](std::size_t) { scene.RenderAndStep(); });
+
+  // The events are added after the previous benchmark, as it doesn't use
+  // them: benchmarks are run in the order they were added.
+  suite.Add("RenderAndStep with events" + objects,
+            [benchmarkScene, &scene](std::size_t i) {
+              if (i == 0)
+                scene.GetCodeExecutionEngine()->LoadFunction(&BenchmarkEvents);
+              scene.RenderAndStep();
+            });
+}
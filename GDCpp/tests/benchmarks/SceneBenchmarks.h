@@ -0,0 +1,18 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef SCENEBENCHMARKS_H
+#define SCENEBENCHMARKS_H
+
+#include <cstddef>
+class BenchmarkSuite;
+
+/**
+ * \brief Add the benchmarks of the scenes, using scenes with \a objectsCount
+ * sprites.
+ */
+void AddSceneBenchmarks(BenchmarkSuite& suite, std::size_t objectsCount);
+
+#endif  // SCENEBENCHMARKS_H
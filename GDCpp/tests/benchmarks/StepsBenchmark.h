@@ -0,0 +1,107 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef STEPSBENCHMARK_H
+#define STEPSBENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Measure the time of each step of a scene, to report the percentiles
+ * of the times of the steps and not only their average: a behavior doing
+ * expensive work only at some frames is noticed by the slowest steps.
+ *
+ * Header only, so that the benchmarks of the extensions (run from the tests
+ * of the extensions with "[benchmark]" as argument) can use it.
+ */
+class StepsBenchmark {
+ public:
+  /**
+   * \brief The times of the steps, in microseconds.
+   */
+  struct Result {
+    std::size_t stepsCount;
+    double mean;
+    double median;
+    double percentile90;
+    double percentile99;
+    double max;
+  };
+
+  /**
+   * \brief Call \a step \a stepsCount times, with the index of the step, and
+   * return the statistics of the time of the calls.
+   *
+   * \param warmUpStepsCount The number of steps done before the measures, for
+   * example to let the objects fall on the floor or the paths be computed.
+   */
+  template <class Fn>
+  static Result Run(std::size_t stepsCount,
+                    Fn step,
+                    std::size_t warmUpStepsCount = 0) {
+    typedef std::chrono::steady_clock Clock;
+    for (std::size_t i = 0; i < warmUpStepsCount; ++i) step(i);
+
+    std::vector<double> times;
+    times.reserve(stepsCount);
+    for (std::size_t i = 0; i < stepsCount; ++i) {
+      Clock::time_point start = Clock::now();
+      step(warmUpStepsCount + i);
+      times.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - start)
+              .count());
+    }
+
+    Result result;
+    result.stepsCount = stepsCount;
+    result.mean = 0;
+    result.median = 0;
+    result.percentile90 = 0;
+    result.percentile99 = 0;
+    result.max = 0;
+    if (times.empty()) return result;
+
+    std::sort(times.begin(), times.end());
+    for (double time : times) result.mean += time;
+    result.mean /= times.size();
+    result.median = GetPercentile(times, 50);
+    result.percentile90 = GetPercentile(times, 90);
+    result.percentile99 = GetPercentile(times, 99);
+    result.max = times.back();
+    return result;
+  }
+
+  /**
+   * \brief Print the result on a line, in milliseconds.
+   */
+  static void Print(const std::string& title,
+                    const Result& result,
+                    std::ostream& output = std::cout) {
+    output << title << ": " << result.stepsCount
+           << " steps, mean: " << result.mean / 1000.0
+           << "ms, p50: " << result.median / 1000.0
+           << "ms, p90: " << result.percentile90 / 1000.0
+           << "ms, p99: " << result.percentile99 / 1000.0
+           << "ms, max: " << result.max / 1000.0 << "ms" << std::endl;
+  }
+
+ private:
+  /**
+   * \brief Return the percentile of sorted times (nearest rank).
+   */
+  static double GetPercentile(const std::vector<double>& sortedTimes,
+                              double percentile) {
+    std::size_t rank = static_cast<std::size_t>(
+        percentile / 100.0 * (sortedTimes.size() - 1) + 0.5);
+    return sortedTimes[std::min(rank, sortedTimes.size() - 1)];
+  }
+};
+
+#endif  // STEPSBENCHMARK_H
@@ -0,0 +1,78 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Main file for GDevelop C++ Platform benchmarks
+ *
+ * Usage: GDCpp_benchmarks [--objects N] [--iterations N] [--runs N]
+ * [--filter text] [--output file.json]
+ *
+ * The results are written in JSON (on the standard output if no file is
+ * specified), with the version of GDevelop and the parameters, so that the
+ * results of different versions can be compared.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include "Benchmark.h"
+#include "SceneBenchmarks.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Tools/VersionWrapper.h"
+
+int main(int argc, char* argv[]) {
+  std::size_t objectsCount = 1000;
+  std::size_t iterationsCount = 100;
+  std::size_t runsCount = 20;
+  gd::String filter;
+  gd::String outputFile;
+
+  for (int i = 1; i < argc; ++i) {
+    gd::String argument = gd::String::FromLocale(argv[i]);
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << argv[i] << std::endl;
+      return 1;
+    }
+
+    gd::String value = gd::String::FromLocale(argv[++i]);
+    if (argument == "--objects")
+      objectsCount = value.To<std::size_t>();
+    else if (argument == "--iterations")
+      iterationsCount = value.To<std::size_t>();
+    else if (argument == "--runs")
+      runsCount = value.To<std::size_t>();
+    else if (argument == "--filter")
+      filter = value;
+    else if (argument == "--output")
+      outputFile = value;
+    else {
+      std::cerr << "Unknown argument " << argv[i - 1] << std::endl;
+      return 1;
+    }
+  }
+
+  BenchmarkSuite suite(iterationsCount, runsCount);
+  AddSceneBenchmarks(suite, objectsCount);
+  suite.Run(filter);
+
+  gd::SerializerElement element;
+  element.SetAttribute("gdevelopVersion", gd::VersionWrapper::FullString());
+  element.SetAttribute("objectsCount", static_cast<int>(objectsCount));
+  suite.SerializeResultsTo(element.AddChild("benchmarks"));
+  std::string json = gd::Serializer::ToJSON(element).ToUTF8();
+
+  if (outputFile.empty()) {
+    std::cout << json << std::endl;
+    return 0;
+  }
+
+  std::ofstream file(outputFile.ToLocale().c_str());
+  file << json << std::endl;
+  if (!file) {
+    std::cerr << "Unable to write " << outputFile.ToLocale() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -38,6 +38,28 @@ gd::String BehaviorCodeGenerator::GenerateRuntimeBehaviorCompleteCode(
     gd::String methodFullyQualifiedName = codeNamespace + "." +
                                           eventsBasedBehavior.GetName() +
                                           ".prototype." + functionName;
+
+    // The steps are generated as static functions stepping all the
+    // behaviors of the scene at once (see gdjs.RuntimeBehaviorsRegistry),
+    // called by the methods for a single behavior.
+    gd::String batchFunctionName = GetBatchFunctionName(*eventsFunction);
+    if (!batchFunctionName.empty()) {
+      gd::String batchFullyQualifiedName =
+          codeNamespace + "." + eventsBasedBehavior.GetName() + "." +
+          batchFunctionName;
+      runtimeBehaviorMethodsCode +=
+          EventsCodeGenerator::GenerateBehaviorEventsFunctionBatchCode(
+              project,
+              *eventsFunction,
+              batchFullyQualifiedName + "Context",
+              batchFullyQualifiedName,
+              includeFiles,
+              compilationForRuntime) +
+          methodFullyQualifiedName + " = function() {\n  " +
+          batchFullyQualifiedName + "(this._runtimeScene, [this]);\n};\n";
+      continue;
+    }
+
     runtimeBehaviorMethodsCode +=
         EventsCodeGenerator::GenerateBehaviorEventsFunctionCode(
             project,
@@ -51,6 +73,15 @@ gd::String BehaviorCodeGenerator::GenerateRuntimeBehaviorCompleteCode(
   return runtimeBehaviorCode + runtimeBehaviorMethodsCode;
 }
 
+gd::String BehaviorCodeGenerator::GetBatchFunctionName(
+    const gd::EventsFunction& eventsFunction) {
+  if (eventsFunction.GetName() == "doStepPreEvents") return "stepAllPreEvents";
+  if (eventsFunction.GetName() == "doStepPostEvents")
+    return "stepAllPostEvents";
+
+  return "";
+}
+
 gd::String BehaviorCodeGenerator::GetRuntimeBehaviorTemplateCode() {
   return R"jscode_template(
 CODE_NAMESPACE = CODE_NAMESPACE || {};
@@ -38,6 +38,14 @@ class BehaviorCodeGenerator {
  private:
   gd::String GetRuntimeBehaviorTemplateCode();
 
+  /**
+   * \brief Return the name of the static function stepping all the behaviors
+   * at once for the lifecycle function, or an empty string if the function
+   * is not stepped in batches.
+   */
+  static gd::String GetBatchFunctionName(
+      const gd::EventsFunction& eventsFunction);
+
   gd::Project& project;
 };
 
@@ -5,18 +5,23 @@
  */
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include <algorithm>
+#include <utility>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include "GDCore/Events/CodeGeneration/ExpressionCodeGenerator.h"
 #include "GDCore/Events/Tools/EventsCodeNameMangler.h"
 #include "GDCore/Extensions/Metadata/EventMetadata.h"
 #include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
 #include "GDCore/Extensions/Metadata/InstructionMetadata.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
 #include "GDCore/Extensions/Metadata/ParameterMetadataTools.h"
+#include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/EventsFunctionTools.h"
 #include "GDCore/IDE/SceneNameMangler.h"
 #include "GDCore/Project/Behavior.h"
 #include "GDCore/Project/EventsFunction.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
@@ -29,6 +34,8 @@ using namespace std;
 
 namespace gdjs {
 
+const std::size_t EventsCodeGenerator::maxInlinedActionsCount = 4;
+
 gd::String EventsCodeGenerator::GenerateEventsListCompleteFunctionCode(
     gd::Project& project,
     gdjs::EventsCodeGenerator& codeGenerator,
@@ -45,9 +52,44 @@ gd::String EventsCodeGenerator::GenerateEventsListCompleteFunctionCode(
   // Preprocessing then code generation can make changes to the events, so we
   // need to do the work on a copy of the events.
   gd::EventsList generatedEvents = events;
+  std::map<const gd::BaseEvent*, std::size_t> eventsIds;
+  for (std::size_t i = 0; i < generatedEvents.size(); ++i)
+    eventsIds[&generatedEvents[i]] = i;
+
   codeGenerator.PreprocessEventList(generatedEvents);
+
+  // When not generating for runtime, measure the time spent in each event,
+  // identified by its position in the original events list. The events
+  // inserted by a link are measured as the link that was replaced by them.
+  gd::String profilerSection;
+  if (!codeGenerator.GenerateCodeForRuntime()) {
+    std::map<const gd::BaseEvent*, std::size_t> profilerIds;
+    std::size_t nextEventId = events.size();
+    for (std::size_t i = generatedEvents.size(); i-- > 0;) {
+      auto eventId = eventsIds.find(&generatedEvents[i]);
+      if (eventId != eventsIds.end()) {
+        nextEventId = eventId->second;
+        profilerIds[&generatedEvents[i]] = nextEventId;
+      } else if (nextEventId > 0) {
+        // Inserted by the link that was just before the next event.
+        profilerIds[&generatedEvents[i]] = nextEventId - 1;
+      }
+    }
+    codeGenerator.SetRootEventsProfilerIds(profilerIds);
+
+    // The scenes events are already measured by the runtime scene.
+    if (!codeGenerator.HasProjectAndLayout())
+      profilerSection = fullyQualifiedFunctionName;
+  }
+
   gd::String wholeEventsCode =
       codeGenerator.GenerateEventsListCode(generatedEvents, context);
+  if (!profilerSection.empty()) {
+    wholeEventsCode =
+        codeGenerator.GenerateProfilerSectionBegin(profilerSection) + "\n" +
+        wholeEventsCode + "\n" +
+        codeGenerator.GenerateProfilerSectionEnd(profilerSection);
+  }
 
   // Extra declarations needed by events
   gd::String globalDeclarations;
@@ -85,6 +127,10 @@ gd::String EventsCodeGenerator::GenerateSceneEventsCompleteCode(
     std::set<gd::String>& includeFiles,
     bool compilationForRuntime) {
   EventsCodeGenerator codeGenerator(project, scene);
+  codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+  codeGenerator.SetGenerateMonomorphicCode(compilationForRuntime);
+  if (compilationForRuntime)
+    codeGenerator.SetEventsFunctionsInliningProject(&project);
 
   gd::String output = GenerateEventsListCompleteFunctionCode(
       project,
@@ -119,6 +165,10 @@ gd::String EventsCodeGenerator::GenerateEventsFunctionCode(
   EventsCodeGenerator codeGenerator(globalObjectsAndGroups, objectsAndGroups);
   codeGenerator.SetCodeNamespace(codeNamespace);
   codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+  codeGenerator.SetGenerateMonomorphicCode(compilationForRuntime);
+  if (compilationForRuntime)
+    codeGenerator.SetEventsFunctionsInliningProject(&project);
+  codeGenerator.inlinedEventsFunctions.insert(&eventsFunction);
 
   gd::String output = GenerateEventsListCompleteFunctionCode(
       project,
@@ -151,6 +201,10 @@ gd::String EventsCodeGenerator::GenerateBehaviorEventsFunctionCode(
   EventsCodeGenerator codeGenerator(globalObjectsAndGroups, objectsAndGroups);
   codeGenerator.SetCodeNamespace(codeNamespace);
   codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+  codeGenerator.SetGenerateMonomorphicCode(compilationForRuntime);
+  if (compilationForRuntime)
+    codeGenerator.SetEventsFunctionsInliningProject(&project);
+  codeGenerator.inlinedEventsFunctions.insert(&eventsFunction);
 
   // Generate the code setting up the context of the function.
   gd::String prelude =
@@ -183,6 +237,62 @@ gd::String EventsCodeGenerator::GenerateBehaviorEventsFunctionCode(
   return output;
 }
 
+gd::String EventsCodeGenerator::GenerateBehaviorEventsFunctionBatchCode(
+    gd::Project& project,
+    const gd::EventsFunction& eventsFunction,
+    const gd::String& codeNamespace,
+    const gd::String& fullyQualifiedFunctionName,
+    std::set<gd::String>& includeFiles,
+    bool compilationForRuntime) {
+  gd::ObjectsContainer globalObjectsAndGroups;
+  gd::ObjectsContainer objectsAndGroups;
+  gd::EventsFunctionTools::EventsFunctionToObjectsContainer(
+      project, eventsFunction, globalObjectsAndGroups, objectsAndGroups);
+
+  EventsCodeGenerator codeGenerator(globalObjectsAndGroups, objectsAndGroups);
+  codeGenerator.SetCodeNamespace(codeNamespace);
+  codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+  codeGenerator.SetGenerateMonomorphicCode(compilationForRuntime);
+  if (compilationForRuntime)
+    codeGenerator.SetEventsFunctionsInliningProject(&project);
+  codeGenerator.inlinedEventsFunctions.insert(&eventsFunction);
+
+  // Generate the code setting up the context once, before the loop on the
+  // behaviors: the list containing the object ("Object") and the name of
+  // the behavior ("Behavior") are changed for each behavior. The names of
+  // the variables of the loop must not be used by the code of the events,
+  // which often declares variables like "i".
+  gd::String prelude =
+      gd::String("var thisObjectList = [];\n") +
+      "var Object = Hashtable.newFrom({Object: thisObjectList});\n" +
+      "var Behavior = \"\";\n" + "var parentEventsFunctionContext = null;\n" +
+      codeGenerator.GenerateEventsFunctionContext(
+          eventsFunction.GetParameters(), "Object") +
+      "for (var batchedBehaviorIndex = 0; batchedBehaviorIndex < "
+      "batchedBehaviors.length; ++batchedBehaviorIndex) {\n" +
+      "var batchedBehavior = batchedBehaviors[batchedBehaviorIndex];\n" +
+      "if (!batchedBehavior.activated()) continue;\n" +
+      "thisObjectList.length = 0;\n" +
+      "thisObjectList.push(batchedBehavior.owner);\n" +
+      "Behavior = batchedBehavior.name;\n" +
+      "eventsFunctionContext._behaviorNamesMap.Behavior = Behavior;\n";
+
+  // The objects lists are reset for each behavior, before its events (see
+  // GenerateEventsListCompleteFunctionCode): the loop is closed after them.
+  gd::String output = GenerateEventsListCompleteFunctionCode(
+      project,
+      codeGenerator,
+      fullyQualifiedFunctionName,
+      "runtimeScene, batchedBehaviors",
+      prelude,
+      eventsFunction.GetEvents(),
+      "}\nreturn;");
+
+  includeFiles.insert(codeGenerator.GetIncludeFiles().begin(),
+                      codeGenerator.GetIncludeFiles().end());
+  return output;
+}
+
 gd::String EventsCodeGenerator::GenerateEventsFunctionParameterDeclarationsList(
     const vector<gd::ParameterMetadata>& parameters,
     bool isBehaviorEventsFunction) {
@@ -340,6 +450,17 @@ EventsCodeGenerator::GenerateAllObjectsDeclarationsAndResets(
                                     ManObjListName(object.GetName()) +
                                     gd::String::From(j) + ".length = 0;\n";
         }
+
+        // The arrays of instances are stable for the lifetime of a scene, but
+        // are resolved at each frame as the code can be run by several scenes.
+        if (resolvedInstancesLists.count(object.GetName())) {
+          gd::String instancesListName =
+              GetObjectInstancesListName(object.GetName());
+          globalObjectLists += instancesListName + " = [];\n";
+          globalObjectListsReset +=
+              instancesListName + " = runtimeScene.getObjects(" +
+              ConvertToStringExplicit(object.GetName()) + ");\n";
+        }
       };
 
   for (std::size_t i = 0; i < globalObjectsAndGroups.GetObjectsCount(); ++i)
@@ -442,6 +563,20 @@ gd::String EventsCodeGenerator::GenerateFreeCondition(
     const gd::String& returnBoolean,
     bool conditionInverted,
     gd::EventsCodeGenerationContext& context) {
+  const gd::EventsFunction* eventsFunction =
+      GetEventsFunctionToInline(instrInfos.codeExtraInformation.functionCallName);
+  gd::String inlinedCode;
+  if (eventsFunction &&
+      GenerateInlinedEventsFunctionActions(
+          *eventsFunction,
+          arguments,
+          conditionInverted
+              ? GenerateBooleanFullName(returnBoolean, context) + ".val = !"
+              : GenerateBooleanFullName(returnBoolean, context) + ".val = ",
+          context,
+          inlinedCode))
+    return inlinedCode;
+
   // Generate call
   gd::String predicat;
   if (instrInfos.codeExtraInformation.type == "number" ||
@@ -471,6 +606,361 @@ gd::String EventsCodeGenerator::GenerateFreeCondition(
          ".val = " + predicat + ";\n";
 }
 
+gd::String EventsCodeGenerator::GenerateFreeAction(
+    const std::vector<gd::String>& arguments,
+    const gd::InstructionMetadata& instrInfos,
+    gd::EventsCodeGenerationContext& context) {
+  const gd::EventsFunction* eventsFunction =
+      GetEventsFunctionToInline(instrInfos.codeExtraInformation.functionCallName);
+  gd::String inlinedCode;
+  if (eventsFunction &&
+      GenerateInlinedEventsFunctionActions(
+          *eventsFunction, arguments, "", context, inlinedCode))
+    return inlinedCode;
+
+  return gd::EventsCodeGenerator::GenerateFreeAction(
+      arguments, instrInfos, context);
+}
+
+gd::String EventsCodeGenerator::GenerateFreeFunctionCall(
+    const std::vector<gd::String>& arguments,
+    const gd::ExpressionMetadata& expressionMetadata,
+    gd::EventsCodeGenerationContext& context) {
+  const gd::EventsFunction* eventsFunction = GetEventsFunctionToInline(
+      expressionMetadata.codeExtraInformation.functionCallName);
+  gd::String inlinedCode;
+  if (eventsFunction &&
+      GenerateInlinedEventsFunctionExpression(
+          *eventsFunction, arguments, context, inlinedCode))
+    return inlinedCode;
+
+  return gd::EventsCodeGenerator::GenerateFreeFunctionCall(
+      arguments, expressionMetadata, context);
+}
+
+void EventsCodeGenerator::SetEventsFunctionsInliningProject(
+    gd::Project* project_) {
+  eventsFunctionsInliningProject = project_;
+  eventsFunctionsToInline.clear();
+  if (!eventsFunctionsInliningProject) return;
+
+  // Functions are found by the name of the JS function declared in their
+  // metadata, as this is what is known when generating the code of a call.
+  for (std::size_t i = 0;
+       i < eventsFunctionsInliningProject->GetEventsFunctionsExtensionsCount();
+       ++i) {
+    const gd::EventsFunctionsExtension& extension =
+        eventsFunctionsInliningProject->GetEventsFunctionsExtension(i);
+    for (std::size_t j = 0; j < extension.GetEventsFunctionsCount(); ++j) {
+      const gd::EventsFunction& eventsFunction = extension.GetEventsFunction(j);
+      if (!CanBeInlined(eventsFunction)) continue;
+
+      gd::String type = extension.GetName() +
+                        gd::PlatformExtension::GetNamespaceSeparator() +
+                        eventsFunction.GetName();
+      gd::String functionCallName;
+      auto functionType = eventsFunction.GetFunctionType();
+      if (functionType == gd::EventsFunction::Action)
+        functionCallName =
+            gd::MetadataProvider::GetActionMetadata(GetPlatform(), type)
+                .codeExtraInformation.functionCallName;
+      else if (functionType == gd::EventsFunction::Condition)
+        functionCallName =
+            gd::MetadataProvider::GetConditionMetadata(GetPlatform(), type)
+                .codeExtraInformation.functionCallName;
+      else if (functionType == gd::EventsFunction::Expression)
+        functionCallName =
+            gd::MetadataProvider::GetExpressionMetadata(GetPlatform(), type)
+                .codeExtraInformation.functionCallName;
+      else
+        functionCallName =
+            gd::MetadataProvider::GetStrExpressionMetadata(GetPlatform(), type)
+                .codeExtraInformation.functionCallName;
+
+      if (!functionCallName.empty())
+        eventsFunctionsToInline[functionCallName] = &eventsFunction;
+    }
+  }
+}
+
+bool EventsCodeGenerator::CanBeInlined(
+    const gd::EventsFunction& eventsFunction) {
+  for (const auto& parameter : eventsFunction.GetParameters()) {
+    if (gd::ParameterMetadata::IsObject(parameter.GetType()) ||
+        gd::ParameterMetadata::IsBehavior(parameter.GetType()))
+      return false;
+  }
+
+  std::size_t actionsCount = 0;
+  const gd::Instruction* lastAction = nullptr;
+  const gd::EventsList& events = eventsFunction.GetEvents();
+  for (std::size_t i = 0; i < events.GetEventsCount(); ++i) {
+    const gd::BaseEvent& event = events.GetEvent(i);
+    if (event.IsDisabled() ||
+        event.GetType() == "BuiltinCommonInstructions::Comment")
+      continue;
+
+    auto standardEvent = dynamic_cast<const gd::StandardEvent*>(&event);
+    if (!standardEvent || !standardEvent->GetConditions().IsEmpty() ||
+        standardEvent->HasSubEvents())
+      return false;
+
+    const gd::InstructionsList& actions = standardEvent->GetActions();
+    actionsCount += actions.size();
+    if (!actions.IsEmpty()) lastAction = &actions[actions.size() - 1];
+  }
+  if (actionsCount > maxInlinedActionsCount) return false;
+
+  // Expressions are replaced by the expression of the returned value.
+  if (eventsFunction.GetFunctionType() == gd::EventsFunction::Expression)
+    return actionsCount == 1 && lastAction->GetType() == "SetReturnNumber";
+  if (eventsFunction.GetFunctionType() == gd::EventsFunction::StringExpression)
+    return actionsCount == 1 && lastAction->GetType() == "SetReturnString";
+
+  return true;
+}
+
+const gd::EventsFunction* EventsCodeGenerator::GetEventsFunctionToInline(
+    const gd::String& functionCallName) {
+  if (!eventsFunctionsInliningProject) return nullptr;
+
+  auto it = eventsFunctionsToInline.find(functionCallName);
+  if (it == eventsFunctionsToInline.end() ||
+      inlinedEventsFunctions.count(it->second))
+    return nullptr;
+
+  return it->second;
+}
+
+void EventsCodeGenerator::SetUpInlinedEventsFunctionCodeGenerator(
+    EventsCodeGenerator& inlinedCodeGenerator,
+    const gd::EventsFunction& eventsFunction,
+    InlinedEventsFunctionCall& inlinedCall_) {
+  inlinedCodeGenerator.SetCodeNamespace(GetCodeNamespace());
+  inlinedCodeGenerator.SetGenerateCodeForRuntime(GenerateCodeForRuntime());
+  inlinedCodeGenerator.SetGenerateMonomorphicCode(generateMonomorphicCode);
+  inlinedCodeGenerator.eventsFunctionsInliningProject =
+      eventsFunctionsInliningProject;
+  inlinedCodeGenerator.eventsFunctionsToInline = eventsFunctionsToInline;
+  inlinedCodeGenerator.inlinedEventsFunctions = inlinedEventsFunctions;
+  inlinedCodeGenerator.inlinedEventsFunctions.insert(&eventsFunction);
+  inlinedCodeGenerator.inlinedCall = &inlinedCall_;
+  inlinedCodeGenerator.inliningDepth = inliningDepth + 1;
+}
+
+void EventsCodeGenerator::AddInlinedEventsFunctionRequirements(
+    const EventsCodeGenerator& inlinedCodeGenerator) {
+  includeFiles.insert(inlinedCodeGenerator.GetIncludeFiles().begin(),
+                      inlinedCodeGenerator.GetIncludeFiles().end());
+  AddCustomCodeOutsideMain(inlinedCodeGenerator.GetCustomCodeOutsideMain());
+  for (auto& declaration : inlinedCodeGenerator.GetCustomGlobalDeclaration())
+    AddGlobalDeclaration(declaration);
+}
+
+void EventsCodeGenerator::GenerateInlinedContextCodes(
+    gd::EventsCodeGenerationContext& context,
+    InlinedEventsFunctionCall& inlinedCall_) {
+  // The inlined events have no objects: the code-only parameters giving the
+  // context are the ones of the caller.
+  gd::ParameterMetadata objectsContextMetadata;
+  objectsContextMetadata.SetType("objectsContext");
+  inlinedCall_.objectsContextCode =
+      GenerateParameterCodes("", objectsContextMetadata, context, "", nullptr);
+
+  gd::ParameterMetadata eventsFunctionContextMetadata;
+  eventsFunctionContextMetadata.SetType("eventsFunctionContext");
+  inlinedCall_.eventsFunctionContextCode = GenerateParameterCodes(
+      "", eventsFunctionContextMetadata, context, "", nullptr);
+}
+
+bool EventsCodeGenerator::GenerateInlinedEventsFunctionActions(
+    const gd::EventsFunction& eventsFunction,
+    const std::vector<gd::String>& arguments,
+    const gd::String& resultAssignment,
+    gd::EventsCodeGenerationContext& context,
+    gd::String& output) {
+  // Functions are called with the scene, their parameters and the context of
+  // the caller.
+  const auto& parameters = eventsFunction.GetParameters();
+  if (arguments.size() != parameters.size() + 2) return false;
+
+  InlinedEventsFunctionCall call;
+  call.aborted = false;
+  GenerateInlinedContextCodes(context, call);
+
+  // Arguments are evaluated once, before the events, like for a call.
+  gd::String depth = gd::String::From(inliningDepth);
+  gd::String argumentsDeclarations;
+  for (std::size_t i = 0; i < parameters.size(); ++i) {
+    if (parameters[i].GetName().empty()) continue;
+
+    gd::String argumentName =
+        "inlinedArgument" + depth + "_" + gd::String::From(i);
+    argumentsDeclarations +=
+        "var " + argumentName + " = " + arguments[i + 1] + ";\n";
+    call.argumentsCodes[parameters[i].GetName()] = argumentName;
+  }
+  if (!resultAssignment.empty())
+    call.returnValueCode = "inlinedReturnValue" + depth;
+
+  gd::ObjectsContainer globalObjectsAndGroups;
+  gd::ObjectsContainer objectsAndGroups;
+  gd::EventsFunctionTools::EventsFunctionToObjectsContainer(
+      *eventsFunctionsInliningProject,
+      eventsFunction,
+      globalObjectsAndGroups,
+      objectsAndGroups);
+  EventsCodeGenerator inlinedCodeGenerator(globalObjectsAndGroups,
+                                           objectsAndGroups);
+  SetUpInlinedEventsFunctionCodeGenerator(
+      inlinedCodeGenerator, eventsFunction, call);
+
+  unsigned int maxDepthLevelReached = 0;
+  gd::EventsCodeGenerationContext inlinedContext(&maxDepthLevelReached);
+  gd::String actionsCode;
+  const gd::EventsList& events = eventsFunction.GetEvents();
+  for (std::size_t i = 0; i < events.GetEventsCount(); ++i) {
+    auto standardEvent =
+        dynamic_cast<const gd::StandardEvent*>(&events.GetEvent(i));
+    if (!standardEvent || standardEvent->IsDisabled()) continue;
+
+    // Code generation can make changes to the instructions, so work on a copy.
+    gd::InstructionsList actions = standardEvent->GetActions();
+    actionsCode +=
+        inlinedCodeGenerator.GenerateActionsListCode(actions, inlinedContext);
+  }
+  if (call.aborted) return false;
+
+  AddInlinedEventsFunctionRequirements(inlinedCodeGenerator);
+  output = "{\n" + argumentsDeclarations;
+  if (!call.returnValueCode.empty())
+    output += "var " + call.returnValueCode + " = false;\n";
+  output += actionsCode;
+  if (!call.returnValueCode.empty())
+    output += resultAssignment + call.returnValueCode + ";\n";
+  output += "}\n";
+  return true;
+}
+
+bool EventsCodeGenerator::GenerateInlinedEventsFunctionExpression(
+    const gd::EventsFunction& eventsFunction,
+    const std::vector<gd::String>& arguments,
+    gd::EventsCodeGenerationContext& context,
+    gd::String& output) {
+  const auto& parameters = eventsFunction.GetParameters();
+  if (arguments.size() != parameters.size() + 2) return false;
+
+  InlinedEventsFunctionCall call;
+  call.aborted = false;
+  GenerateInlinedContextCodes(context, call);
+  for (std::size_t i = 0; i < parameters.size(); ++i) {
+    if (parameters[i].GetName().empty()) continue;
+
+    call.argumentsCodes[parameters[i].GetName()] = "(" + arguments[i + 1] + ")";
+  }
+
+  // CanBeInlined checked that the only action sets the returned value.
+  const gd::Instruction* returnAction = nullptr;
+  const gd::EventsList& events = eventsFunction.GetEvents();
+  for (std::size_t i = 0; i < events.GetEventsCount() && !returnAction; ++i) {
+    auto standardEvent =
+        dynamic_cast<const gd::StandardEvent*>(&events.GetEvent(i));
+    if (standardEvent && !standardEvent->IsDisabled() &&
+        !standardEvent->GetActions().IsEmpty())
+      returnAction = &standardEvent->GetActions()[0];
+  }
+  if (!returnAction || returnAction->GetParametersCount() < 1) return false;
+
+  gd::ObjectsContainer globalObjectsAndGroups;
+  gd::ObjectsContainer objectsAndGroups;
+  gd::EventsFunctionTools::EventsFunctionToObjectsContainer(
+      *eventsFunctionsInliningProject,
+      eventsFunction,
+      globalObjectsAndGroups,
+      objectsAndGroups);
+  EventsCodeGenerator inlinedCodeGenerator(globalObjectsAndGroups,
+                                           objectsAndGroups);
+  SetUpInlinedEventsFunctionCodeGenerator(
+      inlinedCodeGenerator, eventsFunction, call);
+
+  bool isNumber =
+      eventsFunction.GetFunctionType() == gd::EventsFunction::Expression;
+  unsigned int maxDepthLevelReached = 0;
+  gd::EventsCodeGenerationContext inlinedContext(&maxDepthLevelReached);
+  gd::String expressionCode =
+      gd::ExpressionCodeGenerator::GenerateExpressionCode(
+          inlinedCodeGenerator,
+          inlinedContext,
+          isNumber ? "number" : "string",
+          returnAction->GetParameter(0).GetPlainString());
+  if (call.aborted) return false;
+
+  // The code of the arguments is not stored in variables, so it must not be
+  // evaluated more than once.
+  for (const auto& usesCount : call.argumentsUsesCounts) {
+    if (usesCount.second > 1) return false;
+  }
+
+  AddInlinedEventsFunctionRequirements(inlinedCodeGenerator);
+  output = isNumber ? "(Number(" + expressionCode + ") || 0)"
+                    : "(\"\" + " + expressionCode + ")";
+  return true;
+}
+
+gd::String EventsCodeGenerator::GenerateExpressionTemporary(
+    const gd::String& type) {
+  // Temporaries are declared in the namespace of the code. The depth of
+  // inlining is part of the name, as the inlined code shares the namespace of
+  // its caller.
+  gd::String name = GetCodeNamespaceAccessor() + "expressionTemporary" +
+                    gd::String::From(inliningDepth) + "_" +
+                    gd::String::From(expressionTemporariesCount++);
+  AddGlobalDeclaration(name + " = " + (type == "string" ? "\"\"" : "0") +
+                       ";\n");
+  return name;
+}
+
+gd::String EventsCodeGenerator::GenerateExpressionWithTemporaries(
+    const gd::String& type,
+    const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+    const gd::String& expressionCode) {
+  // The comma operator evaluates the temporaries first, in order.
+  gd::String code = "(";
+  for (const auto& temporary : temporaries)
+    code += temporary.first + " = " + temporary.second + ", ";
+
+  return code + expressionCode + ")";
+}
+
+gd::String EventsCodeGenerator::GenerateInlinedArgumentCode(
+    const gd::String& argumentName) {
+  if (!inlinedCall) return "\"\"";
+
+  // Only an argument named with a text can be known when generating the code.
+  if (argumentName.size() < 2 || argumentName.substr(0, 1) != "\"" ||
+      argumentName.substr(argumentName.size() - 1) != "\"" ||
+      argumentName.substr(1, argumentName.size() - 2).find_first_of("\"\\") !=
+          gd::String::npos) {
+    inlinedCall->aborted = true;
+    return "\"\"";
+  }
+
+  gd::String name = argumentName.substr(1, argumentName.size() - 2);
+  auto it = inlinedCall->argumentsCodes.find(name);
+  if (it == inlinedCall->argumentsCodes.end())
+    return "\"\"";  // Unknown arguments are empty, like for a call.
+
+  inlinedCall->argumentsUsesCounts[name]++;
+  return it->second;
+}
+
+gd::String EventsCodeGenerator::GenerateInlinedReturnCode(
+    const gd::String& valueCode) {
+  if (!inlinedCall || inlinedCall->returnValueCode.empty()) return "";
+
+  return inlinedCall->returnValueCode + " = " + valueCode + ";";
+}
+
 gd::String EventsCodeGenerator::GenerateObjectCondition(
     const gd::String& objectName,
     const gd::ObjectMetadata& objInfo,
@@ -597,6 +1087,9 @@ gd::String EventsCodeGenerator::GenerateObjectAction(
           objectPart +
               instrInfos.codeExtraInformation.optionalAssociatedInstruction,
           1);
+    else if (instrInfos.codeExtraInformation.accessType ==
+             gd::InstructionMetadata::ExtraInformation::SettersAndGetters)
+      call = GenerateSettersCall(instrInfos, arguments, objectPart, 1);
     else if (instrInfos.codeExtraInformation.accessType ==
              gd::InstructionMetadata::ExtraInformation::Mutators)
       call = GenerateMutatorCall(
@@ -651,6 +1144,9 @@ gd::String EventsCodeGenerator::GenerateBehaviorAction(
           objectPart +
               instrInfos.codeExtraInformation.optionalAssociatedInstruction,
           2);
+    else if (instrInfos.codeExtraInformation.accessType ==
+             gd::InstructionMetadata::ExtraInformation::SettersAndGetters)
+      call = GenerateSettersCall(instrInfos, arguments, objectPart, 2);
     else if (instrInfos.codeExtraInformation.accessType ==
              gd::InstructionMetadata::ExtraInformation::Mutators)
       call = GenerateMutatorCall(
@@ -766,9 +1262,82 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   return declarationsCode;
 }
 
+gd::String EventsCodeGenerator::GenerateLoopObjectsDeclarationCode(
+    gd::EventsCodeGenerationContext& context,
+    const std::set<gd::String>& repickedObjects,
+    gd::String& refillCode) {
+  // The lists are global, so they are only filled: the copies of the lists of
+  // the parent context are done before the loop, unless they are picked
+  // again by the iterations.
+  auto declareObjectList = [this, &repickedObjects, &refillCode](
+                               gd::String object,
+                               gd::EventsCodeGenerationContext& context,
+                               bool refill) {
+    gd::String objectListName = GetObjectListName(object, context);
+    if (!context.GetParentContext()) {
+      std::cout << "ERROR: During code generation, a context tried to use an "
+                   "already declared object list without having a parent"
+                << std::endl;
+      return "/* Could not declare " + objectListName + " */";
+    }
+
+    if (context.IsSameObjectsList(object, *context.GetParentContext()))
+      return "/* Reuse " + objectListName + " */";
+
+    gd::String copiedListName =
+        GetObjectListName(object, *context.GetParentContext());
+    gd::String copyCode =
+        objectListName + ".createFrom(" + copiedListName + ");\n";
+    if (refill || repickedObjects.count(object) != 0) {
+      refillCode += copyCode;
+      return gd::String();
+    }
+    return copyCode;
+  };
+
+  gd::String declarationsCode;
+  for (auto object : context.GetObjectsListsToBeDeclared()) {
+    if (!context.ObjectAlreadyDeclared(object)) {
+      // The instances can be created or deleted by the iterations: they are
+      // always picked again.
+      refillCode += GetObjectListName(object, context) + ".createFrom(" +
+                    GenerateAllInstancesGetterCode(object) + ");\n";
+      context.SetObjectDeclared(object);
+    } else
+      declarationsCode += declareObjectList(object, context, false);
+  }
+  for (auto object : context.GetObjectsListsToBeDeclaredWithoutPicking()) {
+    if (!context.ObjectAlreadyDeclared(object)) {
+      refillCode += GetObjectListName(object, context) + ".length = 0;\n";
+      context.SetObjectDeclared(object);
+    } else
+      declarationsCode += declareObjectList(object, context, true);
+  }
+  for (auto object : context.GetObjectsListsToBeDeclaredEmpty()) {
+    if (!context.ObjectAlreadyDeclared(object))
+      context.SetObjectDeclared(object);
+
+    refillCode += GetObjectListName(object, context) + ".length = 0;\n";
+  }
+
+  return declarationsCode;
+}
+
+gd::String EventsCodeGenerator::GetObjectInstancesListName(
+    const gd::String& objectName) {
+  return GetCodeNamespaceAccessor() + ManObjListName(objectName) + "Instances";
+}
+
 gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
     gd::String& objectName) {
   if (HasProjectAndLayout()) {
+    if (generateMonomorphicCode &&
+        (GetObjectsAndGroups().HasObjectNamed(objectName) ||
+         GetGlobalObjectsAndGroups().HasObjectNamed(objectName))) {
+      resolvedInstancesLists.insert(objectName);
+      return GetObjectInstancesListName(objectName);
+    }
+
     return "runtimeScene.getObjects(" + ConvertToStringExplicit(objectName) +
            ")";
   } else {
@@ -777,8 +1346,10 @@ gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
   }
 }
 
-gd::String EventsCodeGenerator::GenerateEventsListCode(
-    gd::EventsList& events, const gd::EventsCodeGenerationContext& context) {
+void EventsCodeGenerator::AppendEventsListCode(
+    gd::EventsList& events,
+    const gd::EventsCodeGenerationContext& context,
+    gd::String& output) {
   // *Optimization*: generating all JS code of events in a single, enormous
   // function is badly handled by JS engines and in particular the garbage
   // collectors, leading to intermittent lag/freeze while the garbage collector
@@ -786,8 +1357,8 @@ gd::String EventsCodeGenerator::GenerateEventsListCode(
   // stress on the JS engines, we generate a new function for each list of
   // events.
 
-  gd::String code =
-      gd::EventsCodeGenerator::GenerateEventsListCode(events, context);
+  gd::String code;
+  gd::EventsCodeGenerator::AppendEventsListCode(events, context, code);
 
   gd::String parametersCode = HasProjectAndLayout()
                                   ? "runtimeScene"
@@ -801,20 +1372,20 @@ gd::String EventsCodeGenerator::GenerateEventsListCode(
   // are stored in static variables that are globally available by the whole
   // code.
   AddCustomCodeOutsideMain(functionName + " = function(" + parametersCode +
-                           ") {\n" + code + "\n" + "}; //End of " +
-                           functionName + "\n");
+                           ") {\n");
+  AddCustomCodeOutsideMain(std::move(code));
+  AddCustomCodeOutsideMain("\n}; //End of " + functionName + "\n");
 
   // Replace the code of the events by the call to the function. This does not
   // interfere with the objects picking as the lists are in static variables
   // globally available.
-  return functionName + "(" + parametersCode + ");";
+  output += functionName + "(" + parametersCode + ");";
 }
 
-gd::String EventsCodeGenerator::GenerateConditionsListCode(
+void EventsCodeGenerator::AppendConditionsListCode(
     gd::InstructionsList& conditions,
-    gd::EventsCodeGenerationContext& context) {
-  gd::String outputCode;
-
+    gd::EventsCodeGenerationContext& context,
+    gd::String& outputCode) {
   for (std::size_t i = 0; i < conditions.size(); ++i)
     outputCode += GenerateBooleanInitializationToFalse(
         "condition" + gd::String::From(i) + "IsTrue", context);
@@ -827,10 +1398,6 @@ gd::String EventsCodeGenerator::GenerateConditionsListCode(
               "condition" + gd::String::From(cId - 1) + "IsTrue", context) +
           ".val ) {\n";
 
-    gd::InstructionMetadata instrInfos =
-        gd::MetadataProvider::GetConditionMetadata(platform,
-                                                   conditions[cId].GetType());
-
     gd::String conditionCode =
         GenerateConditionCode(conditions[cId],
                               "condition" + gd::String::From(cId) + "IsTrue",
@@ -847,8 +1414,6 @@ gd::String EventsCodeGenerator::GenerateConditionsListCode(
   }
 
   maxConditionsListsSize = std::max(maxConditionsListsSize, conditions.size());
-
-  return outputCode;
 }
 
 gd::String EventsCodeGenerator::GenerateParameterCodes(
@@ -866,15 +1431,29 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
   }
   // Code only parameter type
   else if (metadata.type == "objectsContext") {
-    argOutput =
-        "(typeof eventsFunctionContext !== 'undefined' ? eventsFunctionContext "
-        ": runtimeScene)";
+    // eventsFunctionContext is only defined in the code of events functions,
+    // which have no layout.
+    if (inlinedCall)
+      argOutput = inlinedCall->objectsContextCode;
+    else if (generateMonomorphicCode)
+      argOutput =
+          HasProjectAndLayout() ? "runtimeScene" : "eventsFunctionContext";
+    else
+      argOutput =
+          "(typeof eventsFunctionContext !== 'undefined' ? "
+          "eventsFunctionContext : runtimeScene)";
   }
   // Code only parameter type
   else if (metadata.type == "eventsFunctionContext") {
-    argOutput =
-        "(typeof eventsFunctionContext !== 'undefined' ? eventsFunctionContext "
-        ": undefined)";
+    if (inlinedCall)
+      argOutput = inlinedCall->eventsFunctionContextCode;
+    else if (generateMonomorphicCode)
+      argOutput =
+          HasProjectAndLayout() ? "undefined" : "eventsFunctionContext";
+    else
+      argOutput =
+          "(typeof eventsFunctionContext !== 'undefined' ? "
+          "eventsFunctionContext : undefined)";
   } else
     return gd::EventsCodeGenerator::GenerateParameterCodes(
         parameter,
@@ -1077,13 +1656,23 @@ gd::String EventsCodeGenerator::GenerateProfilerSectionEnd(
 
 EventsCodeGenerator::EventsCodeGenerator(gd::Project& project,
                                          const gd::Layout& layout)
-    : gd::EventsCodeGenerator(project, layout, JsPlatform::Get()) {}
+    : gd::EventsCodeGenerator(project, layout, JsPlatform::Get()),
+      generateMonomorphicCode(false),
+      eventsFunctionsInliningProject(nullptr),
+      inlinedCall(nullptr),
+      inliningDepth(0),
+      expressionTemporariesCount(0) {}
 
 EventsCodeGenerator::EventsCodeGenerator(
     gd::ObjectsContainer& globalObjectsAndGroups,
     const gd::ObjectsContainer& objectsAndGroups)
     : gd::EventsCodeGenerator(
-          JsPlatform::Get(), globalObjectsAndGroups, objectsAndGroups) {}
+          JsPlatform::Get(), globalObjectsAndGroups, objectsAndGroups),
+      generateMonomorphicCode(false),
+      eventsFunctionsInliningProject(nullptr),
+      inlinedCall(nullptr),
+      inliningDepth(0),
+      expressionTemporariesCount(0) {}
 
 EventsCodeGenerator::~EventsCodeGenerator() {}
 
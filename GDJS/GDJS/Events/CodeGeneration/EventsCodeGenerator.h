@@ -5,6 +5,7 @@
  */
 #ifndef EVENTSCODEGENERATOR_H
 #define EVENTSCODEGENERATOR_H
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -14,6 +15,7 @@
 namespace gd {
 class ObjectsContainer;
 class EventsFunction;
+class ExpressionMetadata;
 class ObjectMetadata;
 class BehaviorMetadata;
 class InstructionMetadata;
@@ -90,19 +92,48 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
       std::set<gd::String>& includeFiles,
       bool compilationForRuntime = false);
 
+  /**
+   * Generate JavaScript for executing the events of an events based behavior
+   * function for several behaviors at once, in a function taking the scene
+   * and an array of behaviors (see gdjs.RuntimeBehaviorsRegistry).
+   *
+   * The context of the function is created once, and the object and the
+   * behavior given to the events are changed for each behavior. Only
+   * functions without parameters other than the object and the behavior
+   * (like the lifecycle functions) can be generated this way.
+   *
+   * \param project Project used.
+   * \param eventsFunction The events function to be compiled.
+   * \param codeNamespace Where to store the context used by the function.
+   * \param includeFiles Will be filled with the necessary include files.
+   * \param compilationForRuntime Set this to true if the code is generated for
+   * runtime.
+   *
+   * \return JavaScript code
+   */
+  static gd::String GenerateBehaviorEventsFunctionBatchCode(
+      gd::Project& project,
+      const gd::EventsFunction& eventsFunction,
+      const gd::String& codeNamespace,
+      const gd::String& fullyQualifiedFunctionName,
+      std::set<gd::String>& includeFiles,
+      bool compilationForRuntime = false);
+
   /**
    * \brief Generate code for executing an event list
    * \note To reduce the stress on JS engines, the code is generated inside
    * a separate JS function (see
-   * gd::EventsCodeGenerator::AddCustomCodeOutsideMain). This method will return
-   * the code to call this separate function.
+   * gd::EventsCodeGenerator::AddCustomCodeOutsideMain). This method will
+   * append the code to call this separate function.
    *
    * \param events std::vector of events
    * \param context Context used for generation
-   * \return Code
+   * \param output The code to which the generated code is appended.
    */
-  virtual gd::String GenerateEventsListCode(
-      gd::EventsList& events, const gd::EventsCodeGenerationContext& context);
+  virtual void AppendEventsListCode(
+      gd::EventsList& events,
+      const gd::EventsCodeGenerationContext& context,
+      gd::String& output);
 
   /**
    * Generate code for executing a condition list
@@ -111,11 +142,12 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
    * \param scene Scene used
    * \param conditions std::vector of conditions
    * \param context Context used for generation
-   * \return JS code.
+   * \param output The JS code to which the generated code is appended.
    */
-  virtual gd::String GenerateConditionsListCode(
+  virtual void AppendConditionsListCode(
       gd::InstructionsList& conditions,
-      gd::EventsCodeGenerationContext& context);
+      gd::EventsCodeGenerationContext& context,
+      gd::String& output);
 
   /**
    * \brief Generate the full name for accessing to a boolean variable used for
@@ -167,6 +199,72 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
     codeNamespace = codeNamespace_;
   };
 
+  /**
+   * \brief Set if the generated code must avoid the patterns that JS engines
+   * can't optimize well:
+   * - The instances of the objects are resolved once per frame, at the start
+   * of the events of the scene, instead of being searched by their name each
+   * time a list of objects is declared.
+   * - The code-only parameters giving the context of the events are resolved
+   * when generating the code, instead of being checked at runtime.
+   *
+   * Enabled by the generation functions when the code is generated for
+   * runtime (i.e: for exports).
+   */
+  void SetGenerateMonomorphicCode(bool enable = true) {
+    generateMonomorphicCode = enable;
+  };
+
+  /**
+   * \brief Return true if the code is generated as described in
+   * SetGenerateMonomorphicCode.
+   */
+  bool IsGeneratingMonomorphicCode() const { return generateMonomorphicCode; };
+
+  /**
+   * \brief Set the project where the events functions called by the events
+   * are searched, so that the small ones are generated directly in the code
+   * of the caller ("inlined") instead of being called.
+   *
+   * A free function of an events functions extension is inlined when:
+   * - it has no object or behavior parameter, so that it doesn't access to
+   * objects and its "eventsFunctionContext" can be elided,
+   * - its events are standard events without conditions nor sub-events, with
+   * at most maxInlinedActionsCount actions (an expression must be made of a
+   * single action setting the returned value),
+   * - it is not already being inlined (recursive functions are still called).
+   *
+   * \param project_ The project, or nullptr to disable inlining.
+   */
+  void SetEventsFunctionsInliningProject(gd::Project* project_);
+
+  /**
+   * \brief Return true if the code being generated is the code of an events
+   * function inlined in the code of its caller.
+   */
+  bool IsGeneratingInlinedEventsFunction() const {
+    return inlinedCall != nullptr;
+  };
+
+  /**
+   * \brief Generate the code to get the value of an argument of the events
+   * function being inlined.
+   *
+   * \param argumentName The (not yet generated) expression giving the name of
+   * the argument. Inlining is aborted if it's not a simple text.
+   */
+  gd::String GenerateInlinedArgumentCode(const gd::String& argumentName);
+
+  /**
+   * \brief Generate the code setting the value returned by the events function
+   * being inlined.
+   */
+  gd::String GenerateInlinedReturnCode(const gd::String& valueCode);
+
+  static const std::size_t
+      maxInlinedActionsCount;  ///< The maximum number of actions of an inlined
+                               ///< events function.
+
  protected:
   virtual gd::String GenerateParameterCodes(
       const gd::String& parameter,
@@ -219,6 +317,16 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
       bool conditionInverted,
       gd::EventsCodeGenerationContext& context);
 
+  virtual gd::String GenerateFreeAction(
+      const std::vector<gd::String>& arguments,
+      const gd::InstructionMetadata& instrInfos,
+      gd::EventsCodeGenerationContext& context);
+
+  virtual gd::String GenerateFreeFunctionCall(
+      const std::vector<gd::String>& arguments,
+      const gd::ExpressionMetadata& expressionMetadata,
+      gd::EventsCodeGenerationContext& context);
+
   virtual gd::String GenerateObjectAction(
       const gd::String& objectName,
       const gd::ObjectMetadata& objInfo,
@@ -257,6 +365,13 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
 
   virtual gd::String GenerateBadObject() { return "null"; }
 
+  virtual gd::String GenerateExpressionTemporary(const gd::String& type);
+
+  virtual gd::String GenerateExpressionWithTemporaries(
+      const gd::String& type,
+      const std::vector<std::pair<gd::String, gd::String> >& temporaries,
+      const gd::String& expressionCode);
+
   virtual gd::String GenerateObject(const gd::String& objectName,
                                     const gd::String& type,
                                     gd::EventsCodeGenerationContext& context);
@@ -273,6 +388,11 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
   virtual gd::String GenerateObjectsDeclarationCode(
       gd::EventsCodeGenerationContext& context);
 
+  virtual gd::String GenerateLoopObjectsDeclarationCode(
+      gd::EventsCodeGenerationContext& context,
+      const std::set<gd::String>& repickedObjects,
+      gd::String& refillCode);
+
   virtual gd::String GenerateAllInstancesGetterCode(gd::String& objectName);
 
   virtual gd::String GenerateProfilerSectionBegin(const gd::String& section);
@@ -346,8 +466,110 @@ class EventsCodeGenerator : public gd::EventsCodeGenerator {
                       const gd::ObjectsContainer& objectsAndGroups);
   virtual ~EventsCodeGenerator();
 
+  /**
+   * \brief Get the name of the static variable where the instances of the
+   * object are resolved once per frame.
+   * \see SetGenerateMonomorphicCode
+   */
+  gd::String GetObjectInstancesListName(const gd::String& objectName);
+
+  /**
+   * \brief The arguments and the returned value of a call to an events
+   * function being inlined.
+   */
+  struct InlinedEventsFunctionCall {
+    std::map<gd::String, gd::String> argumentsCodes;
+    std::map<gd::String, std::size_t> argumentsUsesCounts;
+    gd::String returnValueCode;  ///< Empty if the returned value is not used.
+    gd::String objectsContextCode;
+    gd::String eventsFunctionContextCode;
+    bool aborted;
+  };
+
+  /**
+   * \brief Return true if the events function can be inlined.
+   * \see SetEventsFunctionsInliningProject
+   */
+  static bool CanBeInlined(const gd::EventsFunction& eventsFunction);
+
+  /**
+   * \brief Return the events function to be inlined instead of calling the
+   * specified function, if any.
+   */
+  const gd::EventsFunction* GetEventsFunctionToInline(
+      const gd::String& functionCallName);
+
+  /**
+   * \brief Prepare a code generator to generate the code of an events function
+   * inlined in the code generated by this generator.
+   */
+  void SetUpInlinedEventsFunctionCodeGenerator(
+      EventsCodeGenerator& inlinedCodeGenerator,
+      const gd::EventsFunction& eventsFunction,
+      InlinedEventsFunctionCall& inlinedCall);
+
+  /**
+   * \brief Add the include files and the declarations required by the code of
+   * an inlined events function.
+   */
+  void AddInlinedEventsFunctionRequirements(
+      const EventsCodeGenerator& inlinedCodeGenerator);
+
+  /**
+   * \brief Get the code of the code-only parameters of the events function
+   * being inlined, as generated by its caller.
+   */
+  void GenerateInlinedContextCodes(gd::EventsCodeGenerationContext& context,
+                                   InlinedEventsFunctionCall& inlinedCall);
+
+  /**
+   * \brief Generate the code of an action or a condition events function in
+   * place of its call.
+   *
+   * \param resultAssignment The code assigning the result of a condition
+   * (like "condition.val = "), or an empty string for an action.
+   * \return true if the function was inlined in the output.
+   */
+  bool GenerateInlinedEventsFunctionActions(
+      const gd::EventsFunction& eventsFunction,
+      const std::vector<gd::String>& arguments,
+      const gd::String& resultAssignment,
+      gd::EventsCodeGenerationContext& context,
+      gd::String& output);
+
+  /**
+   * \brief Generate the code of an expression events function in place of its
+   * call.
+   *
+   * Arguments are replaced by their code, so only functions using each
+   * argument at most once are inlined.
+   *
+   * \return true if the function was inlined in the output.
+   */
+  bool GenerateInlinedEventsFunctionExpression(
+      const gd::EventsFunction& eventsFunction,
+      const std::vector<gd::String>& arguments,
+      gd::EventsCodeGenerationContext& context,
+      gd::String& output);
+
   gd::String codeNamespace;  ///< Optional namespace for the generated code,
                              ///< used when generating events function.
+  bool generateMonomorphicCode;  ///< See SetGenerateMonomorphicCode.
+  std::set<gd::String>
+      resolvedInstancesLists;  ///< The objects whose instances are resolved
+                               ///< at the start of the events.
+  gd::Project* eventsFunctionsInliningProject;  ///< The project of the
+                                                ///< functions to inline.
+  std::map<gd::String, const gd::EventsFunction*>
+      eventsFunctionsToInline;  ///< The functions that can be inlined, by the
+                                ///< name of the JS function generated for them.
+  std::set<const gd::EventsFunction*>
+      inlinedEventsFunctions;  ///< The functions being generated, never
+                               ///< inlined again.
+  InlinedEventsFunctionCall* inlinedCall;  ///< The call being inlined, if any.
+  std::size_t inliningDepth;  ///< The number of callers inlining the code.
+  std::size_t expressionTemporariesCount;  ///< The number of temporaries
+                                           ///< declared for expressions.
 };
 
 }  // namespace gdjs
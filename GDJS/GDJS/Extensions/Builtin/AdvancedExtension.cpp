@@ -10,9 +10,25 @@
 #include "GDCore/Events/CodeGeneration/ExpressionCodeGenerator.h"
 #include "GDCore/Extensions/Builtin/AllBuiltinExtensions.h"
 #include "GDCore/Tools/Localization.h"
+#include "GDJS/Events/CodeGeneration/EventsCodeGenerator.h"
 
 namespace gdjs {
 
+namespace {
+/**
+ * \brief Return the code generator if it's generating an events function
+ * inlined in the code of its caller, or nullptr otherwise.
+ */
+gdjs::EventsCodeGenerator* GetInliningCodeGenerator(
+    gd::EventsCodeGenerator& codeGenerator) {
+  auto jsCodeGenerator =
+      dynamic_cast<gdjs::EventsCodeGenerator*>(&codeGenerator);
+  return jsCodeGenerator && jsCodeGenerator->IsGeneratingInlinedEventsFunction()
+             ? jsCodeGenerator
+             : nullptr;
+}
+}  // namespace
+
 AdvancedExtension::AdvancedExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsAdvancedExtension(*this);
 
@@ -31,6 +47,12 @@ AdvancedExtension::AdvancedExtension() {
                 "number",
                 instruction.GetParameter(0).GetPlainString());
 
+        gdjs::EventsCodeGenerator* inliningCodeGenerator =
+            GetInliningCodeGenerator(codeGenerator);
+        if (inliningCodeGenerator)
+          return inliningCodeGenerator->GenerateInlinedReturnCode(
+              expressionCode);
+
         return "if (typeof eventsFunctionContext !== 'undefined') { "
                "eventsFunctionContext.returnValue = " +
                expressionCode + "; }";
@@ -48,6 +70,12 @@ AdvancedExtension::AdvancedExtension() {
                 "string",
                 instruction.GetParameter(0).GetPlainString());
 
+        gdjs::EventsCodeGenerator* inliningCodeGenerator =
+            GetInliningCodeGenerator(codeGenerator);
+        if (inliningCodeGenerator)
+          return inliningCodeGenerator->GenerateInlinedReturnCode(
+              expressionCode);
+
         return "if (typeof eventsFunctionContext !== 'undefined') { "
                "eventsFunctionContext.returnValue = " +
                expressionCode + "; }";
@@ -63,6 +91,11 @@ AdvancedExtension::AdvancedExtension() {
         gd::String booleanCode =
             (parameter == "True" || parameter == "Vrai") ? "true" : "false";
 
+        gdjs::EventsCodeGenerator* inliningCodeGenerator =
+            GetInliningCodeGenerator(codeGenerator);
+        if (inliningCodeGenerator)
+          return inliningCodeGenerator->GenerateInlinedReturnCode(booleanCode);
+
         return "if (typeof eventsFunctionContext !== 'undefined') { "
                "eventsFunctionContext.returnValue = " +
                booleanCode + "; }";
@@ -73,6 +106,15 @@ AdvancedExtension::AdvancedExtension() {
       .SetCustomCodeGenerator([](const std::vector<gd::Expression>& parameters,
                                  gd::EventsCodeGenerator& codeGenerator,
                                  gd::EventsCodeGenerationContext& context) {
+        gdjs::EventsCodeGenerator* inliningCodeGenerator =
+            GetInliningCodeGenerator(codeGenerator);
+        if (inliningCodeGenerator)
+          return "(Number(" +
+                 inliningCodeGenerator->GenerateInlinedArgumentCode(
+                     !parameters.empty() ? parameters[0].GetPlainString()
+                                         : "") +
+                 ") || 0)";
+
         gd::String parameterNameCode =
             gd::ExpressionCodeGenerator::GenerateExpressionCode(
                 codeGenerator,
@@ -90,6 +132,15 @@ AdvancedExtension::AdvancedExtension() {
       .SetCustomCodeGenerator([](const std::vector<gd::Expression>& parameters,
                                  gd::EventsCodeGenerator& codeGenerator,
                                  gd::EventsCodeGenerationContext& context) {
+        gdjs::EventsCodeGenerator* inliningCodeGenerator =
+            GetInliningCodeGenerator(codeGenerator);
+        if (inliningCodeGenerator)
+          return "(\"\" + " +
+                 inliningCodeGenerator->GenerateInlinedArgumentCode(
+                     !parameters.empty() ? parameters[0].GetPlainString()
+                                         : "") +
+                 ")";
+
         gd::String parameterNameCode =
             gd::ExpressionCodeGenerator::GenerateExpressionCode(
                 codeGenerator,
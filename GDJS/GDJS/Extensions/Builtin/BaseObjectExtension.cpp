@@ -34,6 +34,10 @@ BaseObjectExtension::BaseObjectExtension() {
       .SetFunctionName("setY")
       .SetGetter("getY")
       .SetIncludeFile("runtimeobject.js");
+  objectActions["MettreXY"]
+      .SetManipulatedType("number")
+      .SetSettersAndGetters({{"setX", "getX"}, {"setY", "getY"}})
+      .SetIncludeFile("runtimeobject.js");
   objectConditions["PosX"].SetFunctionName("getX").SetIncludeFile(
       "runtimeobject.js");
   objectConditions["PosY"].SetFunctionName("getY").SetIncludeFile(
@@ -252,68 +256,6 @@ BaseObjectExtension::BaseObjectExtension() {
         return "runtimeScene.updateObjectsForces();";
       });
 
-  objectActions["MettreXY"].codeExtraInformation.SetCustomCodeGenerator(
-      [](gd::Instruction &instruction,
-         gd::EventsCodeGenerator &codeGenerator,
-         gd::EventsCodeGenerationContext &context) -> gd::String {
-        gd::String outputCode;
-
-        std::vector<gd::String> realObjects = codeGenerator.ExpandObjectsName(
-            instruction.GetParameter(0).GetPlainString(), context);
-        for (std::size_t i = 0; i < realObjects.size(); ++i) {
-          context.SetCurrentObject(realObjects[i]);
-          context.ObjectsListNeeded(realObjects[i]);
-
-          gd::String newX, newY;
-
-          gd::String expression1Code =
-              gd::ExpressionCodeGenerator::GenerateExpressionCode(
-                  codeGenerator,
-                  context,
-                  "number",
-                  instruction.GetParameters()[2].GetPlainString());
-
-          gd::String expression2Code =
-              gd::ExpressionCodeGenerator::GenerateExpressionCode(
-                  codeGenerator,
-                  context,
-                  "number",
-                  instruction.GetParameters()[4].GetPlainString());
-
-          gd::String op1 = instruction.GetParameter(1).GetPlainString();
-          if (op1 == "=" || op1.empty())
-            newX = expression1Code;
-          else if (op1 == "/" || op1 == "*" || op1 == "-" || op1 == "+")
-            newX = codeGenerator.GetObjectListName(realObjects[i], context) +
-                   "[i].getX() " + op1 + expression1Code;
-          else
-            return "";
-          gd::String op2 = instruction.GetParameter(3).GetPlainString();
-          if (op2 == "=" || op2.empty())
-            newY = expression2Code;
-          else if (op2 == "/" || op2 == "*" || op2 == "-" || op2 == "+")
-            newY = codeGenerator.GetObjectListName(realObjects[i], context) +
-                   "[i].getY() " + op2 + expression2Code;
-          else
-            return "";
-
-          gd::String call =
-              codeGenerator.GetObjectListName(realObjects[i], context) +
-              "[i].setPosition(" + newX + "," + newY + ")";
-
-          outputCode +=
-              "for(var i = 0, len = " +
-              codeGenerator.GetObjectListName(realObjects[i], context) +
-              ".length ;i < len;++i) {\n";
-          outputCode += "    " + call + ";\n";
-          outputCode += "}\n";
-
-          context.SetNoCurrentObject();
-        }
-
-        return outputCode;
-      });
-
   StripUnimplementedInstructionsAndExpressions();  // Unimplemented things are
                                                    // listed here:
   /*
@@ -80,8 +80,8 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         if (event.HasSubEvents())  // Sub events
         {
           actionsCode += "\n{ //Subevents\n";
-          actionsCode += codeGenerator.GenerateEventsListCode(
-              event.GetSubEvents(), actionsContext);
+          codeGenerator.AppendEventsListCode(
+              event.GetSubEvents(), actionsContext, actionsCode);
           actionsCode += "} //End of subevents\n";
         }
         gd::String actionsDeclarationsCode =
@@ -242,8 +242,8 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
              gd::EventsCodeGenerationContext& parentContext) {
             gd::String outputCode;
 
-            outputCode += codeGenerator.GenerateConditionsListCode(
-                instruction.GetSubInstructions(), parentContext);
+            codeGenerator.AppendConditionsListCode(
+                instruction.GetSubInstructions(), parentContext, outputCode);
 
             gd::String predicat = "true";
             for (unsigned int i = 0;
@@ -363,6 +363,11 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
 
         gd::String conditionsCode = codeGenerator.GenerateConditionsListCode(
             event.GetConditions(), context);
+        std::set<gd::String> pickedObjects =
+            codeGenerator.GetObjectsPickedInLoop(
+                context.GetAllObjectsToBeDeclared(),
+                event.GetActions(),
+                context);
         gd::String actionsCode =
             codeGenerator.GenerateActionsListCode(event.GetActions(), context);
         gd::String ifPredicat = "true";
@@ -375,22 +380,30 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
                   context) +
               ".val";
 
+        // The objects lists are declared once, and only the ones picked by
+        // the conditions or the actions are filled again at each iteration.
+        gd::String refillCode;
+        gd::String objectDeclaration =
+            codeGenerator.GenerateLoopObjectsDeclarationCode(
+                context, pickedObjects, refillCode);
+
         // Write final code
         gd::String whileBoolean = codeGenerator.GetCodeNamespaceAccessor() +
                                   "stopDoWhile" +
                                   gd::String::From(context.GetContextDepth());
         codeGenerator.AddGlobalDeclaration(whileBoolean + " = false;\n");
+        outputCode += objectDeclaration;
         outputCode += whileBoolean + " = false;\n";
         outputCode += "do {";
-        outputCode += codeGenerator.GenerateObjectsDeclarationCode(context);
+        outputCode += refillCode;
         outputCode += whileConditionsStr;
         outputCode += "if (" + whileIfPredicat + ") {\n";
         outputCode += conditionsCode;
         outputCode += "if (" + ifPredicat + ") {\n";
         outputCode += actionsCode;
         outputCode += "\n{ //Subevents: \n";
-        outputCode +=
-            codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+        codeGenerator.AppendEventsListCode(
+            event.GetSubEvents(), context, outputCode);
         outputCode += "} //Subevents end.\n";
         outputCode += "}\n";
         outputCode += "} else " + whileBoolean + " = true; \n";
@@ -423,6 +436,11 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
         // Prepare conditions/actions codes
         gd::String conditionsCode = codeGenerator.GenerateConditionsListCode(
             event.GetConditions(), context);
+        std::set<gd::String> pickedObjects =
+            codeGenerator.GetObjectsPickedInLoop(
+                context.GetAllObjectsToBeDeclared(),
+                event.GetActions(),
+                context);
         gd::String actionsCode =
             codeGenerator.GenerateActionsListCode(event.GetActions(), context);
         gd::String ifPredicat = "true";
@@ -435,11 +453,16 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
                   context) +
               ".val";
 
-        // Prepare object declaration and sub events
+        // Prepare object declaration and sub events. The objects lists are
+        // declared once, and only the ones picked by the conditions or the
+        // actions are filled again at each iteration.
         gd::String subevents =
             codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+        gd::String refillCode;
         gd::String objectDeclaration =
-            codeGenerator.GenerateObjectsDeclarationCode(context) + "\n";
+            codeGenerator.GenerateLoopObjectsDeclarationCode(
+                context, pickedObjects, refillCode) +
+            "\n";
 
         // Write final code
         gd::String repeatCountVar = codeGenerator.GetCodeNamespaceAccessor() +
@@ -451,9 +474,10 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
                                     gd::String::From(context.GetContextDepth());
         codeGenerator.AddGlobalDeclaration(repeatIndexVar + " = 0;\n");
         outputCode += repeatCountVar + " = " + repeatCountCode + ";\n";
+        outputCode += objectDeclaration;
         outputCode += "for(" + repeatIndexVar + " = 0;" + repeatIndexVar +
                       " < " + repeatCountVar + ";++" + repeatIndexVar + ") {\n";
-        outputCode += objectDeclaration;
+        outputCode += refillCode;
         outputCode += conditionsCode;
         outputCode += "if (" + ifPredicat + ")\n";
         outputCode += "{\n";
@@ -523,34 +547,24 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
             codeGenerator.GetCodeNamespaceAccessor() + "forEachIndex" +
             gd::String::From(context.GetContextDepth());
         codeGenerator.AddGlobalDeclaration(forEachIndexVar + " = 0;\n");
-        gd::String forEachObjectsList =
-            codeGenerator.GetCodeNamespaceAccessor() + "forEachObjects" +
+        gd::String forEachListIndexVar =
+            codeGenerator.GetCodeNamespaceAccessor() + "forEachListIndex" +
             gd::String::From(context.GetContextDepth());
-        codeGenerator.AddGlobalDeclaration(forEachObjectsList + " = [];\n");
 
+        // The objects are not gathered in a single array: the index is made
+        // relative to the parent list of each object in turn, so that the
+        // parent lists are never copied.
         if (realObjects.size() !=
             1)  //(We write a slighty more simple ( and optimized ) output code
                 // when only one object list is used.)
         {
+          codeGenerator.AddGlobalDeclaration(forEachListIndexVar + " = 0;\n");
           outputCode += forEachTotalCountVar + " = 0;\n";
-          outputCode += forEachObjectsList + ".length = 0;\n";
           for (unsigned int i = 0; i < realObjects.size(); ++i) {
-            gd::String forEachCountVar =
-                codeGenerator.GetCodeNamespaceAccessor() + "forEachCount" +
-                gd::String::From(i) + "_" +
-                gd::String::From(context.GetContextDepth());
-            codeGenerator.AddGlobalDeclaration(forEachCountVar + " = 0;\n");
-
             outputCode +=
-                forEachCountVar + " = " +
+                forEachTotalCountVar + " += " +
                 codeGenerator.GetObjectListName(realObjects[i], parentContext) +
                 ".length;\n";
-            outputCode +=
-                forEachTotalCountVar + " += " + forEachCountVar + ";\n";
-            outputCode +=
-                forEachObjectsList + ".push.apply(" + forEachObjectsList + "," +
-                codeGenerator.GetObjectListName(realObjects[i], parentContext) +
-                ");\n";
           }
         }
 
@@ -590,24 +604,23 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
               ".push(" + temporary + ");\n";
         } else {
           // Generate the code to pick only one object in the lists
+          outputCode += forEachListIndexVar + " = " + forEachIndexVar + ";\n";
           for (unsigned int i = 0; i < realObjects.size(); ++i) {
-            gd::String count;
-            for (unsigned int j = 0; j <= i; ++j) {
-              gd::String forEachCountVar =
-                  codeGenerator.GetCodeNamespaceAccessor() + "forEachCount" +
-                  gd::String::From(j) + "_" +
-                  gd::String::From(context.GetContextDepth());
-
-              if (j != 0) count += "+";
-              count += forEachCountVar;
-            }
-
-            if (i != 0) outputCode += "else ";
-            outputCode += "if (" + forEachIndexVar + " < " + count + ") {\n";
+            gd::String parentList =
+                codeGenerator.GetObjectListName(realObjects[i], parentContext);
+
+            if (i != 0)
+              outputCode += "else if ((" + forEachListIndexVar + " -= " +
+                            codeGenerator.GetObjectListName(realObjects[i - 1],
+                                                            parentContext) +
+                            ".length) < " + parentList + ".length) {\n";
+            else
+              outputCode += "if (" + forEachListIndexVar + " < " + parentList +
+                            ".length) {\n";
             outputCode +=
                 "    " +
                 codeGenerator.GetObjectListName(realObjects[i], context) +
-                ".push(" + forEachObjectsList + "[" + forEachIndexVar + "]);\n";
+                ".push(" + parentList + "[" + forEachListIndexVar + "]);\n";
             outputCode += "}\n";
           }
         }
@@ -636,8 +649,8 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
 
         outputCode +=
             codeGenerator.GenerateProfilerSectionBegin(event.GetName());
-        outputCode +=
-            codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+        codeGenerator.AppendEventsListCode(
+            event.GetSubEvents(), context, outputCode);
         outputCode += codeGenerator.GenerateProfilerSectionEnd(event.GetName());
 
         return outputCode;
@@ -17,6 +17,14 @@ NetworkExtension::NetworkExtension() {
 
   GetAllActions()["SendRequest"].SetFunctionName(
       "gdjs.evtTools.network.sendHttpRequest");
+  GetAllActions()["SendAsyncRequest"].SetFunctionName(
+      "gdjs.evtTools.network.sendAsyncHttpRequest");
+  GetAllActions()["CancelAsyncRequest"].SetFunctionName(
+      "gdjs.evtTools.network.cancelAsyncHttpRequest");
+  GetAllConditions()["AsyncRequestFinished"].SetFunctionName(
+      "gdjs.evtTools.network.asyncHttpRequestFinished");
+  GetAllConditions()["AsyncRequestSucceeded"].SetFunctionName(
+      "gdjs.evtTools.network.asyncHttpRequestSucceeded");
   GetAllActions()["JSONToVariableStructure"].SetFunctionName(
       "gdjs.evtTools.network.jsonToVariableStructure");
   GetAllActions()["JSONToGlobalVariableStructure"].SetFunctionName(
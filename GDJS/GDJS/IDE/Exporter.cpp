@@ -10,6 +10,7 @@
 #include <string>
 #include "GDCore/CommonTools.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/Project/ProjectResourcesAdder.h"
 #include "GDCore/IDE/Project/ProjectResourcesCopier.h"
 #include "GDCore/IDE/ProjectStripper.h"
 #include "GDCore/Project/ExternalEvents.h"
@@ -42,6 +43,20 @@ bool Exporter::ExportLayoutForPixiPreview(gd::Project& project,
   return helper.ExportLayoutForPixiPreview(project, layout, exportDir, "");
 }
 
+bool Exporter::ExportLayoutChangesForPixiPreview(
+    gd::Project& project,
+    gd::String exportDir,
+    std::vector<gd::String>& changedCodeFiles) {
+  ExporterHelper helper(fs, gdjsRoot, codeOutputDir);
+  if (!helper.ExportLayoutChangesForPixiPreview(
+          project, exportDir, changedCodeFiles)) {
+    lastError = helper.GetLastError();
+    return false;
+  }
+
+  return true;
+}
+
 bool Exporter::ExportExternalLayoutForPixiPreview(
     gd::Project& project,
     gd::Layout& layout,
@@ -65,9 +80,14 @@ bool Exporter::ExportWholePixiProject(
   auto exportProject = [this, &exportedProject, &exportOptions, &helper](
                            gd::String exportDir) {
     bool minify = exportOptions["minify"];
+    bool exportOnlyUsedResources = exportOptions["exportOnlyUsedResources"];
     bool exportForCordova = exportOptions["exportForCordova"];
     bool exportForFacebookInstantGames =
         exportOptions["exportForFacebookInstantGames"];
+    bool exportCompactProjectData = exportOptions["exportCompactProjectData"];
+    bool exportLazyScenesData = exportOptions["exportLazyScenesData"];
+    bool exportScenesResourcesManifests =
+        exportOptions["exportScenesResourcesManifests"];
 
     // Always disable the splash for Facebook Instant Games
     if (exportForFacebookInstantGames)
@@ -79,6 +99,14 @@ bool Exporter::ExportWholePixiProject(
     fs.MkDir(exportDir);
     std::vector<gd::String> includesFiles;
 
+    // Remove the resources that are not used (nor referred to by their names)
+    // so that they are not exported.
+    if (exportOnlyUsedResources) {
+      for (const gd::String resourceType : {"image", "audio", "font"})
+        gd::ProjectResourcesAdder::RemoveAllUnreferenced(exportedProject,
+                                                         resourceType);
+    }
+
     // Export the resources (before generating events as some resources
     // filenames may be updated)
     helper.ExportResources(fs, exportedProject, exportDir, progressDialogPtr);
@@ -103,18 +131,50 @@ bool Exporter::ExportWholePixiProject(
       return false;
     }
 
+    // List the resources used by each scene (before stripping the events), so
+    // that only the resources of the first scene are loaded before starting.
+    if (exportScenesResourcesManifests) {
+      helper.ExportLayoutsResourcesManifests(
+          fs, exportedProject, codeOutputDir + "/resources-manifests.js");
+      includesFiles.push_back(codeOutputDir + "/resources-manifests.js");
+    }
+
     // Strip the project (*after* generating events as the events may use
     // stripped things like objects groups...)...
     gd::ProjectStripper::StripProjectForExport(exportedProject);
 
-    //...and export it
-    helper.ExportToJSON(
-        fs, exportedProject, codeOutputDir + "/data.js", "gdjs.projectData");
+    //...and export it (without the editors only content if requested, in
+    // the binary format decoded by the game engine).
+    // The data of the scenes can be in separate files, parsed only when the
+    // scenes are loaded.
+    if (exportCompactProjectData)
+      includesFiles.push_back("binaryprojectdata.js");
+    std::vector<gd::String> layoutsDataFiles;
+    if (exportLazyScenesData) {
+      helper.ExportProjectDataWithLazyLayouts(fs,
+                                              exportedProject,
+                                              codeOutputDir + "/data.js",
+                                              "gdjs.projectData",
+                                              exportCompactProjectData,
+                                              layoutsDataFiles);
+    } else if (exportCompactProjectData) {
+      helper.ExportRuntimeProjectData(
+          fs, exportedProject, codeOutputDir + "/data.js", "gdjs.projectData");
+    } else {
+      helper.ExportToJSON(
+          fs, exportedProject, codeOutputDir + "/data.js", "gdjs.projectData");
+    }
     includesFiles.push_back(codeOutputDir + "/data.js");
+    includesFiles.insert(
+        includesFiles.end(), layoutsDataFiles.begin(), layoutsDataFiles.end());
 
     // Copy all dependencies and the index (or metadata) file.
     helper.RemoveIncludes(false, true, includesFiles);
-    helper.ExportIncludesAndLibs(includesFiles, exportDir, minify);
+    if (minify) helper.RemoveUnusedIncludes(exportedProject, includesFiles);
+    if (!helper.ExportIncludesAndLibs(includesFiles, exportDir, minify)) {
+      gd::LogError(_("Error during export:\n") + helper.GetLastError());
+      return false;
+    }
 
     gd::String source = gdjsRoot + "/Runtime/index.html";
     if (exportForCordova)
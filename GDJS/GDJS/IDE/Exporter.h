@@ -41,6 +41,21 @@ class Exporter {
                                   gd::Layout& layout,
                                   gd::String exportDir);
 
+  /**
+   * \brief Update a preview created by ExportLayoutForPixiPreview with the
+   * changes made to the project, without exporting it again.
+   *
+   * \param exportDir The directory where the preview was created.
+   * \param changedCodeFiles Filled with the code files that the running game
+   * must load to use the new events.
+   * \return true if the preview was updated, false if it must be created
+   * again.
+   */
+  bool ExportLayoutChangesForPixiPreview(
+      gd::Project& project,
+      gd::String exportDir,
+      std::vector<gd::String>& changedCodeFiles);
+
   /**
    * \brief Create a preview for the specified external layout and layout.
    * \note The preview is not launched, it is the caller responsibility to open
@@ -60,6 +75,12 @@ class Exporter {
    * \brief Export the specified project, using Pixi.js.
    *
    * Called by ShowProjectExportDialog if the user clicked on Ok.
+   *
+   * \param exportOptions The options of the export: "minify" to bundle the
+   * includes into a single minified file, "exportOnlyUsedResources" to skip
+   * the images, audios and fonts not referred to by the project,
+   * "exportForCordova", "exportForElectron" and
+   * "exportForFacebookInstantGames" to choose the target.
    */
   bool ExportWholePixiProject(gd::Project& project,
                               gd::String exportDir,
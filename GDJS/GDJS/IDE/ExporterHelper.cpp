@@ -4,26 +4,42 @@
  * reserved. This project is released under the MIT License.
  */
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <sstream>
 #include <streambuf>
 #include <string>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Serialization.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/DependenciesAnalyzer.h"
+#include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
+#include "GDCore/IDE/Project/ResourcesInUseHelper.h"
 #include "GDCore/IDE/Project/ProjectResourcesCopier.h"
 #include "GDCore/IDE/ProjectStripper.h"
 #include "GDCore/IDE/SceneNameMangler.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/ExternalLayout.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/SourceFile.h"
 #include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/MakeUnique.h"
+#include "GDCore/Tools/Threads.h"
+#include "GDCore/Tools/VersionWrapper.h"
 #include "GDJS/Events/CodeGeneration/EventsCodeGenerator.h"
 #include "GDJS/IDE/ExporterHelper.h"
+#include "GDJS/IDE/JsMinifier.h"
 #undef CopyFile  // Disable an annoying macro
 
 namespace gdjs {
@@ -34,6 +50,48 @@ static void InsertUnique(std::vector<gd::String> &container, gd::String str) {
     container.push_back(str);
 }
 
+/**
+ * \brief Encode binary data in base64, to be embedded in a javascript file.
+ */
+static std::string EncodeBase64(const std::string &data) {
+  static const char characters[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string output;
+  output.reserve((data.size() + 2) / 3 * 4);
+  for (std::size_t i = 0; i < data.size(); i += 3) {
+    std::uint32_t bytes = static_cast<unsigned char>(data[i]) << 16;
+    if (i + 1 < data.size())
+      bytes |= static_cast<unsigned char>(data[i + 1]) << 8;
+    if (i + 2 < data.size()) bytes |= static_cast<unsigned char>(data[i + 2]);
+
+    output.push_back(characters[(bytes >> 18) & 0x3F]);
+    output.push_back(characters[(bytes >> 12) & 0x3F]);
+    output.push_back(i + 1 < data.size() ? characters[(bytes >> 6) & 0x3F]
+                                         : '=');
+    output.push_back(i + 2 < data.size() ? characters[bytes & 0x3F] : '=');
+  }
+
+  return output;
+}
+
+/**
+ * \brief Return the list of the files included by a preview, as stored in the
+ * preview directory to know if it can be updated by
+ * ExportLayoutChangesForPixiPreview.
+ */
+static gd::String SerializeIncludes(
+    const std::vector<gd::String> &includesFiles) {
+  gd::SerializerElement includes;
+  includes.ConsiderAsArrayOf("include");
+  for (const gd::String &include : includesFiles)
+    includes.AddChild("include").SetValue(include);
+
+  return gd::Serializer::ToJSON(includes);
+}
+
+static const char *previewIncludesFilename = "previewIncludes.json";
+
 static void GenerateFontsDeclaration(
     const gd::ResourcesManager &resourcesManager,
     gd::AbstractFileSystem &fs,
@@ -86,10 +144,86 @@ static void GenerateFontsDeclaration(
   // end of compatibility code
 }
 
+/**
+ * \brief Return the hash (64 bits FNV-1a) of the given data, as an
+ * hexadecimal string.
+ */
+static gd::String ComputeHash(const std::string &data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char byte : data) {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream os;
+  os << std::hex << hash;
+  return gd::String::FromUTF8(os.str());
+}
+
+/**
+ * \brief Return a hash of everything used to generate the code of the events
+ * of a layout: the layout (without its instances), the events it links to,
+ * the global objects and groups, and the events functions extensions.
+ */
+static gd::String ComputeLayoutEventsCodeHash(gd::Project &project,
+                                              gd::Layout &layout,
+                                              const gd::String &filename,
+                                              bool compilationForRuntime) {
+  gd::SerializerElement element;
+  element.SetAttribute("gdVersion", gd::VersionWrapper::FullString());
+  element.SetAttribute("filename", filename);
+  element.SetAttribute("compilationForRuntime", compilationForRuntime);
+
+  gd::SerializerElement &layoutElement = element.AddChild("layout");
+  layout.SerializeTo(layoutElement);
+  layoutElement.RemoveChild("instances");
+
+  project.SerializeObjectsTo(element.AddChild("objects"));
+  project.GetObjectGroups().SerializeTo(element.AddChild("objectsGroups"));
+  gd::SerializerElement &extensionsElement =
+      element.AddChild("eventsFunctionsExtensions");
+  extensionsElement.ConsiderAsArrayOf("eventsFunctionsExtension");
+  for (std::size_t i = 0; i < project.GetEventsFunctionsExtensionsCount();
+       ++i) {
+    project.GetEventsFunctionsExtension(i).SerializeTo(
+        extensionsElement.AddChild("eventsFunctionsExtension"));
+  }
+
+  DependenciesAnalyzer analyzer(project, layout);
+  analyzer.Analyze();
+  gd::SerializerElement &externalEventsElement =
+      element.AddChild("externalEvents");
+  externalEventsElement.ConsiderAsArrayOf("oneExternalEvents");
+  for (const gd::String &name : analyzer.GetExternalEventsDependencies()) {
+    if (!project.HasExternalEventsNamed(name)) continue;
+
+    project.GetExternalEvents(name).SerializeTo(
+        externalEventsElement.AddChild("oneExternalEvents"));
+  }
+  gd::SerializerElement &scenesEventsElement =
+      element.AddChild("scenesEvents");
+  scenesEventsElement.ConsiderAsArrayOf("sceneEvents");
+  for (const gd::String &name : analyzer.GetScenesDependencies()) {
+    if (!project.HasLayoutNamed(name)) continue;
+
+    gd::SerializerElement &sceneEventsElement =
+        scenesEventsElement.AddChild("sceneEvents");
+    sceneEventsElement.SetAttribute("name", name);
+    gd::EventsListSerialization::SerializeEventsTo(
+        project.GetLayout(name).GetEvents(),
+        sceneEventsElement.AddChild("events"));
+  }
+
+  return ComputeHash(gd::Serializer::ToBinary(element));
+}
+
 ExporterHelper::ExporterHelper(gd::AbstractFileSystem &fileSystem,
                                gd::String gdjsRoot_,
                                gd::String codeOutputDir_)
-    : fs(fileSystem), gdjsRoot(gdjsRoot_), codeOutputDir(codeOutputDir_){};
+    : fs(fileSystem),
+      gdjsRoot(gdjsRoot_),
+      codeOutputDir(codeOutputDir_),
+      codeGenerationThreadsCount(gd::GetHardwareThreadsCount()){};
 
 bool ExporterHelper::ExportLayoutForPixiPreview(gd::Project &project,
                                                 gd::Layout &layout,
@@ -135,6 +269,8 @@ bool ExporterHelper::ExportLayoutForPixiPreview(gd::Project &project,
 
   // Copy all the dependencies
   RemoveIncludes(false, true, includesFiles);
+  fs.WriteToFile(exportDir + "/" + previewIncludesFilename,
+                 SerializeIncludes(includesFiles));
   ExportIncludesAndLibs(includesFiles, exportDir, false);
 
   // Create the index file
@@ -148,6 +284,62 @@ bool ExporterHelper::ExportLayoutForPixiPreview(gd::Project &project,
   return true;
 }
 
+bool ExporterHelper::ExportLayoutChangesForPixiPreview(
+    gd::Project &project,
+    gd::String exportDir,
+    std::vector<gd::String> &changedCodeFiles) {
+  gd::String previewIncludesFile = exportDir + "/" + previewIncludesFilename;
+  if (!fs.FileExists(previewIncludesFile)) {
+    lastError = _("No preview to update in ") + exportDir;
+    return false;
+  }
+
+  std::vector<gd::String> includesFiles;
+  gd::Project exportedProject = project;
+
+  // Export the new resources (the ones that did not change are not copied
+  // again).
+  ExportResources(fs, exportedProject, exportDir);
+
+  // Generate the code of the layouts that changed
+  AddLibsInclude(true, false, true, includesFiles);
+  std::vector<gd::String> generatedCodeFiles;
+  if (!ExportEventsCode(exportedProject,
+                        codeOutputDir,
+                        includesFiles,
+                        true,
+                        &generatedCodeFiles))
+    return false;
+
+  if (!ExportExternalSourceFiles(
+          exportedProject, codeOutputDir, includesFiles))
+    return false;
+
+  includesFiles.push_back(codeOutputDir + "/data.js");
+  RemoveIncludes(false, true, includesFiles);
+
+  // Only the events functions can be replaced in the running game: if other
+  // files are now needed (for example because an extension is used by the
+  // events), the whole preview must be exported again.
+  if (fs.ReadFile(previewIncludesFile) != SerializeIncludes(includesFiles)) {
+    lastError = _("The files included by the game changed, the preview must "
+                  "be exported again.");
+    return false;
+  }
+
+  for (const gd::String &codeFile : generatedCodeFiles) {
+    gd::String filename = fs.FileNameFrom(codeFile);
+    if (!fs.CopyFile(codeFile, exportDir + "/" + filename)) {
+      lastError = _("Unable to write ") + exportDir + "/" + filename;
+      return false;
+    }
+
+    changedCodeFiles.push_back(filename);
+  }
+
+  return true;
+}
+
 gd::String ExporterHelper::ExportToJSON(gd::AbstractFileSystem &fs,
                                         const gd::Project &project,
                                         gd::String filename,
@@ -167,6 +359,124 @@ gd::String ExporterHelper::ExportToJSON(gd::AbstractFileSystem &fs,
   return "";
 }
 
+gd::String ExporterHelper::ExportRuntimeProjectData(
+    gd::AbstractFileSystem &fs,
+    const gd::Project &project,
+    gd::String filename,
+    gd::String wrapIntoVariable) {
+  fs.MkDir(fs.DirNameFrom(filename));
+
+  gd::SerializerElement rootElement;
+  gd::ProjectStripper::SerializeProjectForRuntime(project, rootElement);
+
+  // Base64 only uses ASCII characters, so it can be stored in a gd::String.
+  gd::String data = gd::String::FromUTF8(
+      EncodeBase64(gd::Serializer::ToBinary(rootElement)));
+  gd::String output =
+      wrapIntoVariable + " = gdjs.decodeBinaryProjectData(\"" + data + "\");";
+
+  if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
+
+  return "";
+}
+
+gd::String ExporterHelper::ExportProjectDataWithLazyLayouts(
+    gd::AbstractFileSystem &fs,
+    const gd::Project &project,
+    gd::String filename,
+    gd::String wrapIntoVariable,
+    bool binary,
+    std::vector<gd::String> &includesFiles) {
+  gd::String directory = fs.DirNameFrom(filename);
+  fs.MkDir(directory);
+
+  gd::SerializerElement rootElement;
+  if (binary)
+    gd::ProjectStripper::SerializeProjectForRuntime(project, rootElement);
+  else
+    project.SerializeTo(rootElement);
+
+  auto toString = [binary](const gd::SerializerElement &element) {
+    // Base64 only uses ASCII characters, so it can be stored in a gd::String.
+    return binary ? gd::String::FromUTF8(
+                        EncodeBase64(gd::Serializer::ToBinary(element)))
+                  : gd::Serializer::ToJSON(element);
+  };
+  auto toJSONString = [](const gd::String &str) {
+    gd::SerializerElement element;
+    element.SetStringValue(str);
+    return gd::Serializer::ToJSON(element);
+  };
+
+  // Write each layout as a string, and only keep its name in the project.
+  gd::SerializerElement &layoutsElement = rootElement.GetChild("layouts");
+  for (std::size_t i = 0; i < layoutsElement.GetChildrenCount(); ++i) {
+    gd::SerializerElement &layoutElement = layoutsElement.GetChild(i);
+    gd::String name = layoutElement.GetStringAttribute("name");
+
+    gd::String layoutFilename =
+        directory + "/data-layout" + gd::String::From(i) + ".js";
+    gd::String output =
+        "gdjs.projectLayoutsData = gdjs.projectLayoutsData || {};\n"
+        "gdjs.projectLayoutsData[" + toJSONString(name) +
+        "] = " + toJSONString(toString(layoutElement)) + ";";
+    if (!fs.WriteToFile(layoutFilename, output))
+      return "Unable to write " + layoutFilename;
+    includesFiles.push_back(layoutFilename);
+
+    layoutElement = gd::SerializerElement();
+    layoutElement.SetAttribute("name", name);
+    layoutElement.SetAttribute("lazilyLoaded", true);
+  }
+
+  gd::String output =
+      binary ? wrapIntoVariable + " = gdjs.decodeBinaryProjectData(\"" +
+                   toString(rootElement) + "\");"
+             : wrapIntoVariable + " = " + toString(rootElement) + ";";
+  if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
+
+  return "";
+}
+
+gd::String ExporterHelper::ExportLayoutsResourcesManifests(
+    gd::AbstractFileSystem &fs, gd::Project &project, gd::String filename) {
+  fs.MkDir(fs.DirNameFrom(filename));
+
+  gd::SerializerElement rootElement;
+  for (std::size_t i = 0; i < project.GetLayoutsCount(); ++i) {
+    gd::Layout &layout = project.GetLayout(i);
+
+    gd::ResourcesInUseHelper resourcesInUse;
+    for (std::size_t j = 0; j < project.GetObjectsCount(); ++j)
+      project.GetObject(j).ExposeResources(resourcesInUse);
+    for (std::size_t j = 0; j < layout.GetObjectsCount(); ++j)
+      layout.GetObject(j).ExposeResources(resourcesInUse);
+    gd::LaunchResourceWorkerOnEvents(
+        project, layout.GetEvents(), resourcesInUse);
+    for (std::size_t j = 0; j < project.GetExternalEventsCount(); ++j) {
+      gd::ExternalEvents &externalEvents = project.GetExternalEvents(j);
+      if (externalEvents.GetAssociatedLayout() == layout.GetName())
+        gd::LaunchResourceWorkerOnEvents(
+            project, externalEvents.GetEvents(), resourcesInUse);
+    }
+
+    gd::SerializerElement &resourcesElement =
+        rootElement.AddChild(layout.GetName());
+    resourcesElement.ConsiderAsArray();
+    for (const gd::String resourceType : {"image", "audio", "font"}) {
+      for (const gd::String &name : resourcesInUse.GetAll(resourceType))
+        resourcesElement.AddChild("").SetStringValue(name);
+    }
+  }
+
+  gd::String output =
+      "gdjs.projectLayoutsResources = " + gd::Serializer::ToJSON(rootElement) +
+      ";";
+  if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
+
+  return "";
+}
+
 bool ExporterHelper::ExportPixiIndexFile(
     const gd::Project &project,
     gd::String source,
@@ -513,6 +823,7 @@ void ExporterHelper::AddLibsInclude(bool pixiRenderers,
   InsertUnique(includesFiles, "variablescontainer.js");
   InsertUnique(includesFiles, "oncetriggers.js");
   InsertUnique(includesFiles, "runtimebehavior.js");
+  InsertUnique(includesFiles, "runtimebehaviorsregistry.js");
   InsertUnique(includesFiles, "spriteruntimeobject.js");
 
   // Common includes for events only.
@@ -595,39 +906,116 @@ void ExporterHelper::RemoveIncludes(bool pixiRenderers,
   }
 }
 
-bool ExporterHelper::ExportEventsCode(gd::Project &project,
-                                      gd::String outputDir,
-                                      std::vector<gd::String> &includesFiles,
-                                      bool exportForPreview) {
+bool ExporterHelper::ExportEventsCode(
+    gd::Project &project,
+    gd::String outputDir,
+    std::vector<gd::String> &includesFiles,
+    bool exportForPreview,
+    std::vector<gd::String> *generatedCodeFiles) {
   fs.MkDir(outputDir);
 
+  // Read the hashes and includes of the code generated by the last export,
+  // so that code is generated only for the layouts that changed.
+  gd::String cacheFilename = outputDir + "/codeCache.json";
+  gd::SerializerElement lastCache;
+  if (fs.FileExists(cacheFilename))
+    lastCache = gd::Serializer::FromJSON(fs.ReadFile(cacheFilename));
+  lastCache.ConsiderAsArrayOf("codeFile");
+
+  // Find the layouts whose code must be generated again.
+  struct LayoutCode {
+    gd::String filename;
+    gd::String hash;
+    const gd::SerializerElement *lastCodeFile = nullptr;
+    std::unique_ptr<gd::EventsList> events;
+    gd::String output;
+    std::set<gd::String> includes;
+  };
+  std::vector<LayoutCode> layoutsCode(project.GetLayoutsCount());
+  std::vector<std::function<void()>> codeGenerations;
   for (std::size_t i = 0; i < project.GetLayoutsCount(); ++i) {
-    std::set<gd::String> eventsIncludes;
     gd::Layout &exportedLayout = project.GetLayout(i);
-    gd::String eventsOutput =
-        EventsCodeGenerator::GenerateSceneEventsCompleteCode(
-            project,
-            exportedLayout,
-            exportedLayout.GetEvents(),
-            eventsIncludes,
-            !exportForPreview);
-    gd::String filename =
+    LayoutCode &layoutCode = layoutsCode[i];
+    layoutCode.filename =
         outputDir + "/" + "code" + gd::String::From(i) + ".js";
+    layoutCode.hash = ComputeLayoutEventsCodeHash(
+        project, exportedLayout, layoutCode.filename, !exportForPreview);
+
+    for (std::size_t j = 0; j < lastCache.GetChildrenCount(); ++j) {
+      const gd::SerializerElement &codeFile = lastCache.GetChild(j);
+      if (codeFile.GetStringAttribute("filename") == layoutCode.filename &&
+          codeFile.GetStringAttribute("hash") == layoutCode.hash) {
+        layoutCode.lastCodeFile = &codeFile;
+        break;
+      }
+    }
+    if (layoutCode.lastCodeFile && fs.FileExists(layoutCode.filename))
+      continue;  // The events did not change: the code will be reused.
+
+    layoutCode.lastCodeFile = nullptr;
+
+    // Code generation modifies the events it is given (links are replaced by
+    // the linked events, which can be the events of another layout), so events
+    // are copied before generating the code of layouts at the same time.
+    layoutCode.events =
+        gd::make_unique<gd::EventsList>(exportedLayout.GetEvents());
+    codeGenerations.push_back([&project, &exportedLayout, &layoutCode,
+                               exportForPreview]() {
+      layoutCode.output = EventsCodeGenerator::GenerateSceneEventsCompleteCode(
+          project,
+          exportedLayout,
+          *layoutCode.events,
+          layoutCode.includes,
+          !exportForPreview);
+      layoutCode.events.reset();
+    });
+  }
+
+  gd::CallOnThreads(codeGenerations, codeGenerationThreadsCount);
+
+  // Write the code and the includes in the order of the layouts, so that the
+  // result does not depend on the order in which the code was generated.
+  gd::SerializerElement cache;
+  cache.ConsiderAsArrayOf("codeFile");
+  for (const LayoutCode &layoutCode : layoutsCode) {
+    gd::SerializerElement &codeFile = cache.AddChild("codeFile");
+    if (layoutCode.lastCodeFile) {
+      // The events did not change: reuse the code generated last time.
+      codeFile = *layoutCode.lastCodeFile;
+
+      const gd::SerializerElement &includes =
+          layoutCode.lastCodeFile->GetChild("includes");
+      includes.ConsiderAsArrayOf("include");
+      for (std::size_t j = 0; j < includes.GetChildrenCount(); ++j) {
+        InsertUnique(includesFiles,
+                     includes.GetChild(j).GetValue().GetString());
+      }
+
+      InsertUnique(includesFiles, layoutCode.filename);
+      continue;
+    }
 
     // Export the code
-    if (fs.WriteToFile(filename, eventsOutput)) {
-      for (std::set<gd::String>::iterator include = eventsIncludes.begin();
-           include != eventsIncludes.end();
-           ++include)
-        InsertUnique(includesFiles, *include);
+    if (fs.WriteToFile(layoutCode.filename, layoutCode.output)) {
+      codeFile.SetAttribute("filename", layoutCode.filename);
+      codeFile.SetAttribute("hash", layoutCode.hash);
+      gd::SerializerElement &includes = codeFile.AddChild("includes");
+      includes.ConsiderAsArrayOf("include");
+      for (const gd::String &include : layoutCode.includes) {
+        includes.AddChild("include").SetValue(include);
+        InsertUnique(includesFiles, include);
+      }
 
-      InsertUnique(includesFiles, filename);
+      InsertUnique(includesFiles, layoutCode.filename);
+      if (generatedCodeFiles)
+        generatedCodeFiles->push_back(layoutCode.filename);
     } else {
-      lastError = _("Unable to write ") + filename;
+      lastError = _("Unable to write ") + layoutCode.filename;
       return false;
     }
   }
 
+  fs.WriteToFile(cacheFilename, gd::Serializer::ToJSON(cache));
   return true;
 }
 
@@ -654,8 +1042,136 @@ bool ExporterHelper::ExportExternalSourceFiles(
   return true;
 }
 
+/**
+ * \brief Return true if the given code uses the given global (i.e: if the name
+ * is found, not followed by another character of an identifier).
+ */
+static bool UsesGlobal(const std::string &code, const std::string &name) {
+  for (std::size_t pos = code.find(name); pos != std::string::npos;
+       pos = code.find(name, pos + 1)) {
+    std::size_t end = pos + name.size();
+    if (end >= code.size() ||
+        (!std::isalnum(static_cast<unsigned char>(code[end])) &&
+         code[end] != '_' && code[end] != '$'))
+      return true;
+  }
+
+  return false;
+}
+
+void ExporterHelper::RemoveUnusedIncludes(
+    const gd::Project &project, std::vector<gd::String> &includesFiles) {
+  auto hasSprites = [](const gd::ObjectsContainer &container) {
+    for (std::size_t i = 0; i < container.GetObjectsCount(); ++i)
+      if (container.GetObject(i).GetType() == "Sprite") return true;
+
+    return false;
+  };
+  bool projectHasSprites = hasSprites(project);
+  for (std::size_t i = 0; i < project.GetLayoutsCount() && !projectHasSprites;
+       ++i)
+    projectHasSprites = hasSprites(project.GetLayout(i));
+
+  // Read the includes to know which events tools are used. Events tools are
+  // only used through their namespace, like "gdjs.evtTools.sound".
+  std::vector<std::string> sources(includesFiles.size());
+  for (std::size_t i = 0; i < includesFiles.size(); ++i) {
+    gd::String source = includesFiles[i];
+    if (!fs.IsAbsolute(source)) source = gdjsRoot + "/Runtime/" + source;
+    if (fs.FileExists(source)) sources[i] = fs.ReadFile(source).Raw();
+  }
+
+  std::vector<gd::String> usedIncludesFiles;
+  for (std::size_t i = 0; i < includesFiles.size(); ++i) {
+    const gd::String &include = includesFiles[i];
+    if (!projectHasSprites &&
+        (include == "spriteruntimeobject.js" ||
+         include.find("/spriteruntimeobject-") != gd::String::npos))
+      continue;
+
+    if (include.find("events-tools/") == 0) {
+      const std::string prefix = "gdjs.evtTools.";
+      std::size_t namespaceStart = sources[i].find("\n" + prefix);
+      if (namespaceStart != std::string::npos) {
+        namespaceStart++;
+        std::size_t namespaceEnd = namespaceStart + prefix.size();
+        while (namespaceEnd < sources[i].size() &&
+               (std::isalnum(
+                    static_cast<unsigned char>(sources[i][namespaceEnd])) ||
+                sources[i][namespaceEnd] == '_'))
+          namespaceEnd++;
+        std::string name =
+            sources[i].substr(namespaceStart, namespaceEnd - namespaceStart);
+
+        bool used = false;
+        for (std::size_t j = 0; j < sources.size() && !used; ++j)
+          used = j != i && UsesGlobal(sources[j], name);
+        if (!used) continue;
+      }
+    }
+
+    usedIncludesFiles.push_back(include);
+  }
+
+  includesFiles = usedIncludesFiles;
+}
+
+bool ExporterHelper::ExportIncludesBundle(
+    std::vector<gd::String> &includesFiles, gd::String exportDir) {
+  gd::String cacheDir = codeOutputDir + "/minified";
+  fs.MkDir(cacheDir);
+
+  std::string bundle;
+  for (const gd::String &include : includesFiles) {
+    gd::String source = include;
+    if (!fs.IsAbsolute(source)) source = gdjsRoot + "/Runtime/" + source;
+    if (!fs.FileExists(source)) {
+      std::cout << "Could not find include file " << source << std::endl;
+      continue;
+    }
+
+    std::string code = fs.ReadFile(source).Raw();
+    const std::string minifiedExtension = ".min.js";
+    if (source.Raw().size() < minifiedExtension.size() ||
+        source.Raw().compare(source.Raw().size() - minifiedExtension.size(),
+                             minifiedExtension.size(),
+                             minifiedExtension) != 0) {
+      // The minified code only depends on the source, so it is cached using
+      // the hash of the source.
+      gd::String cachedFilename =
+          cacheDir + "/" +
+          ComputeHash(std::to_string(JsMinifier::version) + "\n" + code) +
+          ".js";
+      if (fs.FileExists(cachedFilename)) {
+        code = fs.ReadFile(cachedFilename).Raw();
+      } else {
+        code = JsMinifier::Minify(code);
+        fs.WriteToFile(cachedFilename, gd::String::FromUTF8(code));
+      }
+    }
+
+    // Separate the files in case one of them ends with a comment or without a
+    // semicolon.
+    bundle += code;
+    if (!code.empty() && code.back() != '\n') bundle += '\n';
+    bundle += ";\n";
+  }
+
+  gd::String bundleFilename = exportDir + "/bundle.js";
+  if (!fs.WriteToFile(bundleFilename, gd::String::FromUTF8(bundle))) {
+    lastError = _("Unable to write ") + bundleFilename;
+    return false;
+  }
+
+  includesFiles.clear();
+  includesFiles.push_back("bundle.js");
+  return true;
+}
+
 bool ExporterHelper::ExportIncludesAndLibs(
-    std::vector<gd::String> &includesFiles, gd::String exportDir, bool /*minify*/) {
+    std::vector<gd::String> &includesFiles, gd::String exportDir, bool minify) {
+  if (minify) return ExportIncludesBundle(includesFiles, exportDir);
+
   for (std::vector<gd::String>::iterator include = includesFiles.begin();
         include != includesFiles.end();
         ++include) {
@@ -695,8 +1211,22 @@ void ExporterHelper::ExportResources(gd::AbstractFileSystem &fs,
                                      gd::Project &project,
                                      gd::String exportDir,
                                      wxProgressDialog *progressDialog) {
-  gd::ProjectResourcesCopier::CopyAllResourcesTo(
-      project, fs, exportDir, true, progressDialog, false, false);
+#if defined(EMSCRIPTEN)
+  // The file system is implemented in Javascript, and can only be used from
+  // the main thread.
+  std::size_t threadsCount = 1;
+#else
+  std::size_t threadsCount = gd::GetHardwareThreadsCount();
+#endif
+
+  gd::ProjectResourcesCopier::CopyAllResourcesTo(project,
+                                                 fs,
+                                                 exportDir,
+                                                 true,
+                                                 progressDialog,
+                                                 false,
+                                                 false,
+                                                 threadsCount);
 }
 
 }  // namespace gdjs
@@ -5,6 +5,7 @@
  */
 #ifndef EXPORTER_HELPER_H
 #define EXPORTER_HELPER_H
+#include <cstddef>
 #include <set>
 #include <string>
 #include <vector>
@@ -34,6 +35,24 @@ class ExporterHelper {
    */
   const gd::String &GetLastError() const { return lastError; };
 
+  /**
+   * \brief Change the number of threads generating the code of the layouts
+   * (including the calling thread). By default, it's the number of threads
+   * that the system can run at the same time.
+   *
+   * \note The generated files are the same whatever the number of threads.
+   */
+  void SetCodeGenerationThreadsCount(std::size_t count) {
+    codeGenerationThreadsCount = count;
+  };
+
+  /**
+   * \brief Return the number of threads generating the code of the layouts.
+   */
+  std::size_t GetCodeGenerationThreadsCount() const {
+    return codeGenerationThreadsCount;
+  };
+
   /**
    * \brief Export a project to JSON
    *
@@ -50,10 +69,85 @@ class ExporterHelper {
                                  gd::String filename,
                                  gd::String wrapIntoVariable);
 
+  /**
+   * \brief Export only the content of the project used by the game engine
+   * (see gd::ProjectStripper::SerializeProjectForRuntime), in the binary
+   * format.
+   *
+   * The data is encoded in base64 and decoded by
+   * gdjs.decodeBinaryProjectData, so "binaryprojectdata.js" must be included
+   * before the file.
+   *
+   * \param fs The abstract file system to use to write the file
+   * \param project The project to be exported.
+   * \param filename The filename where export the project
+   * \param wrapIntoVariable The javascript variable receiving the decoded
+   * project data.
+   * \return Empty string if everthing is ok, description of the error
+   * otherwise.
+   */
+  static gd::String ExportRuntimeProjectData(gd::AbstractFileSystem &fs,
+                                             const gd::Project &project,
+                                             gd::String filename,
+                                             gd::String wrapIntoVariable);
+
+  /**
+   * \brief Export the project like ExportToJSON (or like
+   * ExportRuntimeProjectData if \a binary is true), but with the data of each
+   * layout in its own file, only parsed by the game engine when the scene is
+   * loaded (see gdjs.RuntimeGame#getSceneData).
+   *
+   * The layouts of the project data only contain their names, and the data of
+   * each layout is stored as a string in gdjs.projectLayoutsData, by the
+   * files added to \a includesFiles after the project data file.
+   *
+   * \param fs The abstract file system to use to write the files
+   * \param project The project to be exported.
+   * \param filename The filename where export the project
+   * \param wrapIntoVariable The javascript variable receiving the project
+   * data.
+   * \param binary If true, the data is exported in the binary format.
+   * \param includesFiles The files of the layouts are added to it.
+   * \return Empty string if everthing is ok, description of the error
+   * otherwise.
+   */
+  static gd::String ExportProjectDataWithLazyLayouts(
+      gd::AbstractFileSystem &fs,
+      const gd::Project &project,
+      gd::String filename,
+      gd::String wrapIntoVariable,
+      bool binary,
+      std::vector<gd::String> &includesFiles);
+
+  /**
+   * \brief Export the names of the resources used by each layout, so that the
+   * game engine loads the resources of the first scene before starting the
+   * game, and the others in the background (see
+   * gdjs.RuntimeGame#loadAllAssets).
+   *
+   * The resources used by the objects (including the global objects) and the
+   * events of a layout, and by the external events associated to it, are
+   * stored in gdjs.projectLayoutsResources.
+   *
+   * \note The events must not be stripped from the project yet.
+   *
+   * \param fs The abstract file system to use to write the file
+   * \param project The project to be exported.
+   * \param filename The filename where export the resources names
+   * \return Empty string if everthing is ok, description of the error
+   * otherwise.
+   */
+  static gd::String ExportLayoutsResourcesManifests(gd::AbstractFileSystem &fs,
+                                                    gd::Project &project,
+                                                    gd::String filename);
+
   /**
    * \brief Copy all the resources of the project to to the export directory,
    * updating the resources filenames.
    *
+   * Files are copied on several threads, and only if they changed since the
+   * last export.
+   *
    * \param fs The abstract file system to use
    * \param project The project with resources to be exported.
    * \param exportDir The directory where the preview must be created.
@@ -90,27 +184,63 @@ class ExporterHelper {
    *
    * \param includesFiles A vector with filenames to be copied.
    * \param exportDir The directory where the preview must be created.
-   * \param minify If true, the includes files must be merged into one file
-   * using Google Closure Compiler. ( includesFiles parameter will be updated
-   * with the new filename )
+   * \param minify If true, the includes files are minified and merged into
+   * a single file, see ExportIncludesBundle. ( includesFiles parameter will be
+   * updated with the new filename )
    */
   bool ExportIncludesAndLibs(std::vector<gd::String> &includesFiles,
                              gd::String exportDir,
                              bool minify);
 
+  /**
+   * \brief Minify all the includes files and merge them, in the same order,
+   * into a single "bundle.js" file in the export directory.
+   *
+   * The minified version of each file is cached in the code output directory,
+   * so that only the files that changed since the last export are minified
+   * again. Files ending with ".min.js" are bundled as is.
+   *
+   * \param includesFiles A vector with filenames to be bundled. It is updated
+   * so as to only contain the bundle file.
+   * \param exportDir The directory where the bundle must be created.
+   */
+  bool ExportIncludesBundle(std::vector<gd::String> &includesFiles,
+                            gd::String exportDir);
+
+  /**
+   * \brief Remove the runtime files that are not used by the project from the
+   * includes files.
+   *
+   * The Sprite object and its renderers are removed if the project has no
+   * sprite, and the events tools are removed if they are not used by any
+   * other include.
+   *
+   * \note The events code and the external source files must be already in
+   * the includes files, as they are the main users of the events tools.
+   */
+  void RemoveUnusedIncludes(const gd::Project &project,
+                            std::vector<gd::String> &includesFiles);
+
   /**
    * \brief Generate the events JS code, and save them to the export directory.
    *
    * Files are named "codeX.js", X being the number of the layout in the
-   * project. \param project The project with resources to be exported. \param
+   * project. The hashes of the events of the layouts are stored in
+   * "codeCache.json" in the output directory: the code of a layout is only
+   * generated again if its events (or the objects, extensions and external
+   * events it uses) changed since the last export.
+   * \param project The project with resources to be exported. \param
    * outputDir The directory where the events code must be generated. \param
    * includesFiles A reference to a vector that will be filled with JS files to
    * be exported along with the project. ( including "codeX.js" files ).
+   * \param generatedCodeFiles If not null, filled with the code files that were
+   * generated again (the others were reused from the last export).
    */
   bool ExportEventsCode(gd::Project &project,
                         gd::String outputDir,
                         std::vector<gd::String> &includesFiles,
-                        bool exportForPreview);
+                        bool exportForPreview,
+                        std::vector<gd::String> *generatedCodeFiles = nullptr);
 
   /**
    * \brief Copy the external source files used by the game into the export
@@ -218,6 +348,28 @@ class ExporterHelper {
                                   gd::String exportDir,
                                   gd::String additionalSpec);
 
+  /**
+   * \brief Update a preview exported by ExportLayoutForPixiPreview, so that
+   * it can be reloaded by the running game without restarting it.
+   *
+   * Only the resources and the code of the layouts that changed since the
+   * last export are written in the preview directory. The game must then load
+   * the files listed in \a changedCodeFiles, which replace the events
+   * functions of the layouts (see the "hotReload" command of the debugger
+   * client).
+   *
+   * \param exportDir The directory where the preview was created.
+   * \param changedCodeFiles Filled with the code files (relative to the
+   * preview directory) that must be loaded by the game.
+   * \return true if the preview was updated, false if it must be exported
+   * again (for example because the game now uses an extension that was not
+   * included in the preview).
+   */
+  bool ExportLayoutChangesForPixiPreview(
+      gd::Project &project,
+      gd::String exportDir,
+      std::vector<gd::String> &changedCodeFiles);
+
   /**
    * \brief Change the directory where code files are generated.
    *
@@ -234,6 +386,9 @@ class ExporterHelper {
       gdjsRoot;  ///< The root directory of GDJS, used to copy runtime files.
   gd::String codeOutputDir;  ///< The directory where JS code is outputted. Will
                              ///< be then copied to the final output directory.
+  std::size_t codeGenerationThreadsCount;  ///< The number of threads
+                                           ///< generating the code of the
+                                           ///< layouts.
 };
 
 }  // namespace gdjs
@@ -0,0 +1,202 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDJS/IDE/JsMinifier.h"
+#include <algorithm>
+#include <cctype>
+
+namespace gdjs {
+
+const int JsMinifier::version = 1;
+
+namespace {
+
+bool IsWordChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+         c == '$' || c == '\\' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+/**
+ * \brief Return true if a slash after the given word starts a regular
+ * expression (instead of being a division).
+ */
+bool IsRegexAllowedAfterWord(const std::string &word) {
+  static const char *keywords[] = {"return",
+                                   "typeof",
+                                   "instanceof",
+                                   "in",
+                                   "of",
+                                   "new",
+                                   "delete",
+                                   "void",
+                                   "throw",
+                                   "case",
+                                   "do",
+                                   "else",
+                                   "yield",
+                                   "await"};
+  for (const char *keyword : keywords)
+    if (word == keyword) return true;
+
+  return false;
+}
+
+bool IsLicenseComment(const std::string &comment) {
+  return (comment.size() > 2 && comment[2] == '!') ||
+         comment.find("@license") != std::string::npos ||
+         comment.find("@preserve") != std::string::npos;
+}
+
+/**
+ * \brief Return the position after the end of the string, template or regular
+ * expression literal starting at the given position.
+ */
+std::size_t FindLiteralEnd(const std::string &source, std::size_t start) {
+  char quote = source[start];
+  std::size_t n = source.size();
+  std::size_t i = start + 1;
+  std::size_t templateDepth = 0;
+  bool inClass = false;
+  while (i < n) {
+    char c = source[i];
+    if (c == '\\') {
+      i += 2;
+      continue;
+    }
+    if (quote == '`') {
+      if (templateDepth == 0 && c == '`') break;
+      if (c == '$' && i + 1 < n && source[i + 1] == '{') {
+        templateDepth++;
+        i += 2;
+        continue;
+      }
+      if (templateDepth > 0 && c == '{') templateDepth++;
+      if (templateDepth > 0 && c == '}') templateDepth--;
+    } else {
+      if (c == '\n') return i;  // Unterminated literal, stop at the line end.
+      if (quote == '/') {
+        if (inClass) {
+          if (c == ']') inClass = false;
+        } else if (c == '[') {
+          inClass = true;
+        } else if (c == '/') {
+          break;
+        }
+      } else if (c == quote) {
+        break;
+      }
+    }
+    i++;
+  }
+
+  return std::min(i + 1, n);
+}
+
+}  // namespace
+
+std::string JsMinifier::Minify(const std::string &source) {
+  std::string output;
+  output.reserve(source.size());
+
+  bool pendingSpace = false;
+  bool pendingNewline = false;
+  bool regexAllowed = true;
+  char lastPunctuator = 0;
+
+  // Write the whitespace that was skipped before the next token, if needed.
+  auto writeWhitespace = [&](char next) {
+    if (!output.empty()) {
+      char previous = output.back();
+      if (pendingNewline) {
+        // Line breaks after these characters can't change how semicolons are
+        // inserted.
+        if (previous != ';' && previous != '{' && previous != ',' &&
+            previous != '\n')
+          output += '\n';
+      } else if (pendingSpace) {
+        if ((IsWordChar(previous) && IsWordChar(next)) ||
+            (previous == next &&
+             (next == '+' || next == '-' || next == '/')) ||
+            (previous == '/' && next == '*') ||
+            (std::isdigit(static_cast<unsigned char>(previous)) &&
+             next == '.'))
+          output += ' ';
+      }
+    }
+
+    pendingSpace = false;
+    pendingNewline = false;
+  };
+
+  std::size_t n = source.size();
+  std::size_t i = 0;
+  if (source.compare(0, 3, "\xEF\xBB\xBF") == 0) i = 3;  // Skip the BOM.
+
+  while (i < n) {
+    char c = source[i];
+    if (c == '\n') {
+      pendingNewline = true;
+      i++;
+    } else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+      pendingSpace = true;
+      i++;
+    } else if (c == '/' && i + 1 < n && source[i + 1] == '/') {
+      i = source.find('\n', i);
+      if (i == std::string::npos) i = n;
+    } else if (c == '/' && i + 1 < n && source[i + 1] == '*') {
+      std::size_t end = source.find("*/", i + 2);
+      end = end == std::string::npos ? n : end + 2;
+
+      std::string comment = source.substr(i, end - i);
+      if (IsLicenseComment(comment)) {
+        writeWhitespace(c);
+        output += comment;
+        pendingNewline = true;
+      } else if (comment.find('\n') != std::string::npos) {
+        pendingNewline = true;
+      } else {
+        pendingSpace = true;
+      }
+      i = end;
+    } else if (c == '"' || c == '\'' || c == '`' ||
+               (c == '/' && regexAllowed)) {
+      std::size_t end = FindLiteralEnd(source, i);
+      writeWhitespace(c);
+      output.append(source, i, end - i);
+      regexAllowed = false;
+      lastPunctuator = 0;
+      i = end;
+    } else if (IsWordChar(c)) {
+      std::size_t end = i;
+      while (end < n && IsWordChar(source[end])) {
+        // Skip the character after a backslash (unicode escape sequence).
+        end += source[end] == '\\' ? 2 : 1;
+      }
+      end = std::min(end, n);
+
+      writeWhitespace(c);
+      std::string word = source.substr(i, end - i);
+      output += word;
+      regexAllowed = IsRegexAllowedAfterWord(word);
+      lastPunctuator = 0;
+      i = end;
+    } else {
+      writeWhitespace(c);
+      output += c;
+
+      // A division can follow a closing parenthesis or bracket, or a postfix
+      // increment or decrement.
+      regexAllowed = c != ')' && c != ']' &&
+                     !((c == '+' || c == '-') && lastPunctuator == c);
+      lastPunctuator = c;
+      i++;
+    }
+  }
+
+  if (!output.empty() && output.back() != '\n') output += '\n';
+  return output;
+}
+
+}  // namespace gdjs
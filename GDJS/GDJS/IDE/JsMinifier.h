@@ -0,0 +1,40 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDJS_JSMINIFIER_H
+#define GDJS_JSMINIFIER_H
+#include <string>
+
+namespace gdjs {
+
+/**
+ * \brief Reduce the size of Javascript sources, without changing their
+ * behavior.
+ *
+ * Comments (except license comments, starting with an exclamation mark or
+ * containing "@license" or "@preserve") and useless whitespaces are removed.
+ * Identifiers are not renamed and line breaks that could be meaningful for
+ * the automatic insertion of semicolons are kept, so that the result is
+ * always equivalent to the original code.
+ *
+ * The result only depends on the source, so that it can be cached.
+ */
+class JsMinifier {
+ public:
+  /**
+   * \brief Return the minified version of the given Javascript code (UTF8
+   * encoded).
+   */
+  static std::string Minify(const std::string &source);
+
+  /**
+   * \brief The version of the minification: change it when the output of
+   * Minify changes, to invalidate the minified files that were cached.
+   */
+  static const int version;
+};
+
+}  // namespace gdjs
+#endif  // GDJS_JSMINIFIER_H
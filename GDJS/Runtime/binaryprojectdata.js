@@ -0,0 +1,121 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2013-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+/**
+ * Decode the project data exported in the binary format of GDCore
+ * (see gd::Serializer::ToBinary), encoded in base64, into the same object
+ * as the one exported in JSON (see gd::Serializer::ToJSON).
+ *
+ * @param {string} base64Data The binary data, encoded in base64.
+ * @return {Object} The project data.
+ */
+gdjs.decodeBinaryProjectData = function(base64Data) {
+  var binaryString = atob(base64Data);
+  var bytes = new Uint8Array(binaryString.length);
+  for (var i = 0; i < binaryString.length; ++i) {
+    bytes[i] = binaryString.charCodeAt(i);
+  }
+
+  if (
+    bytes.length < 8 ||
+    String.fromCharCode(bytes[0], bytes[1], bytes[2], bytes[3]) !== 'GDBN'
+  ) {
+    throw new Error('The project data is not in the binary format.');
+  }
+
+  var position = 8; // After the header and the version.
+  var dataView = new DataView(bytes.buffer);
+
+  var readVarint = function() {
+    var value = 0;
+    var multiplier = 1;
+    while (position < bytes.length) {
+      var byte = bytes[position++];
+      value += (byte & 0x7f) * multiplier;
+      if (!(byte & 0x80)) return value;
+      multiplier *= 128;
+    }
+    throw new Error('Unexpected end of the project data.');
+  };
+
+  var decodeUTF8 =
+    typeof TextDecoder !== 'undefined'
+      ? (function() {
+          var decoder = new TextDecoder('utf-8');
+          return function(start, end) {
+            return decoder.decode(bytes.subarray(start, end));
+          };
+        })()
+      : function(start, end) {
+          var str = '';
+          for (var i = start; i < end; ++i) {
+            str += String.fromCharCode(bytes[i]);
+          }
+          return decodeURIComponent(escape(str));
+        };
+
+  // The strings table, referred to by the elements with indices.
+  var strings = [];
+  var stringsCount = readVarint();
+  for (var i = 0; i < stringsCount; ++i) {
+    var length = readVarint();
+    strings.push(decodeUTF8(position, position + length));
+    position += length;
+  }
+
+  var readValue = function() {
+    var type = bytes[position++];
+    if (type === 1) {
+      return bytes[position++] !== 0;
+    } else if (type === 3) {
+      // Zigzag encoding (see BinaryWriter::WriteValue).
+      var value = readVarint();
+      return value % 2 ? -(value + 1) / 2 : value / 2;
+    } else if (type === 4) {
+      var doubleValue = dataView.getFloat64(position, true);
+      position += 8;
+      return doubleValue;
+    }
+
+    return strings[readVarint()]; // Strings and unknown values.
+  };
+
+  var readElement = function() {
+    var flags = readVarint();
+    var hasValue = !!(flags & 1);
+    var isArray = !!(flags & 2);
+
+    var value = hasValue ? readValue() : undefined;
+    var arrayOf = isArray ? strings[readVarint()] : '';
+
+    var object = {};
+    var attributesCount = readVarint();
+    for (var i = 0; i < attributesCount; ++i) {
+      var name = strings[readVarint()];
+      object[name] = readValue();
+    }
+
+    var array = [];
+    var childrenCount = readVarint();
+    for (var i = 0; i < childrenCount; ++i) {
+      var childName = strings[readVarint()];
+      position += 4; // The size of the child, only used to skip it.
+      var child = readElement();
+
+      if (isArray) {
+        if (childName === arrayOf) array.push(child);
+      } else {
+        object[childName] = child;
+      }
+    }
+
+    // Values are preferred to arrays, and arrays to objects, like in JSON.
+    if (hasValue) return value;
+    return isArray ? array : object;
+  };
+
+  return readElement();
+};
@@ -42,6 +42,91 @@ gdjs.evtTools.network.sendHttpRequest = function(host, uri, body, method, conten
 	catch(e){}
 };
 
+/**
+ * Send a request in the background, cancelling the request with the same name
+ * sent by the scene, if any. The response is stored in the variable when the
+ * request succeeds. Requests not finished are cancelled when the scene is
+ * unloaded.
+ * @param {gdjs.RuntimeScene} runtimeScene The scene sending the request
+ * @param {string} name The name of the request
+ * @param {number} timeout The timeout, in seconds (0 for no timeout)
+ */
+gdjs.evtTools.network.sendAsyncHttpRequest = function(runtimeScene, name, host, uri, body, method, contentType, responseVar, timeout)
+{
+	gdjs.evtTools.network.cancelAsyncHttpRequest(runtimeScene, name);
+
+	var requests = runtimeScene.asyncHttpRequests = runtimeScene.asyncHttpRequests || {};
+	var request = requests[name] = {xhr: null, finished: false, succeeded: false};
+	var finish = function(succeeded) {
+		request.finished = true;
+		request.succeeded = succeeded;
+		request.xhr = null;
+	};
+
+	try {
+		if (typeof XMLHttpRequest === 'undefined') return finish(false);
+
+		var xhr = request.xhr = new XMLHttpRequest();
+		xhr.open(method === "POST" ? "POST" : "GET", host+uri, true);
+		xhr.setRequestHeader( "Content-Type", contentType === "" ? "application/x-www-form-urlencoded" : contentType );
+		if (timeout > 0) xhr.timeout = timeout * 1000;
+		xhr.onload = function() {
+			if (request.xhr !== xhr) return;
+
+			var succeeded = xhr.status === 200;
+			if (succeeded) responseVar.setString(xhr.responseText);
+			finish(succeeded);
+		};
+		xhr.onerror = xhr.ontimeout = function() {
+			if (request.xhr === xhr) finish(false);
+		};
+		xhr.send(body);
+	}
+	catch(e){
+		finish(false);
+	}
+};
+
+/**
+ * Cancel a request sent in the background: its response is ignored.
+ */
+gdjs.evtTools.network.cancelAsyncHttpRequest = function(runtimeScene, name)
+{
+	var requests = runtimeScene.asyncHttpRequests;
+	if (!requests || !requests.hasOwnProperty(name)) return;
+
+	var xhr = requests[name].xhr;
+	delete requests[name];
+	if (xhr) xhr.abort();
+};
+
+gdjs.evtTools.network.asyncHttpRequestFinished = function(runtimeScene, name)
+{
+	var requests = runtimeScene.asyncHttpRequests;
+	return !!requests && requests.hasOwnProperty(name) && requests[name].finished;
+};
+
+gdjs.evtTools.network.asyncHttpRequestSucceeded = function(runtimeScene, name)
+{
+	var requests = runtimeScene.asyncHttpRequests;
+	return !!requests && requests.hasOwnProperty(name) && requests[name].succeeded;
+};
+
+/**
+ * Cancel the requests of a scene when it's unloaded.
+ * @private
+ */
+gdjs.evtTools.network.gdjsCallbackRuntimeSceneUnloaded = function(runtimeScene)
+{
+	var requests = runtimeScene.asyncHttpRequests;
+	if (!requests) return;
+
+	for(var name in requests) {
+		if (requests.hasOwnProperty(name))
+			gdjs.evtTools.network.cancelAsyncHttpRequest(runtimeScene, name);
+	}
+};
+
 /**
  * Convert a variable to JSON.
  * TODO: Move to gdjs.Variable static
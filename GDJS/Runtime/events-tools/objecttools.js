@@ -19,16 +19,16 @@ gdjs.evtTools.object = gdjs.evtTools.object || {};
  * @param runtimeObject {gdjs.RuntimeObject} The object to keep in the lists
  */
 gdjs.evtTools.object.pickOnly = function(objectsLists, runtimeObject) {
-    for (var listName in objectsLists.items) {
-        if (objectsLists.items.hasOwnProperty(listName)) {
-            var list = objectsLists.items[listName];
-
-            if (list.indexOf(runtimeObject) === -1) {
-                list.length = 0; //Be sure not to lose the reference to the original array
-            } else {
-                list.length = 0; //Be sure not to lose the reference to the original array
-                list.push(runtimeObject);
-            }
+    var lists = gdjs.staticArray(gdjs.evtTools.object.pickOnly);
+    objectsLists.values(lists);
+    for (var i = 0, len = lists.length; i < len; ++i) {
+        var list = lists[i];
+
+        if (list.indexOf(runtimeObject) === -1) {
+            list.length = 0; //Be sure not to lose the reference to the original array
+        } else {
+            list.length = 0; //Be sure not to lose the reference to the original array
+            list.push(runtimeObject);
         }
     }
 };
@@ -244,13 +244,13 @@ gdjs.evtTools.object.turnedTowardTest = function(objectsLists1, objectsLists2, t
 
 gdjs.evtTools.object.pickAllObjects = function(objectsContext, objectsLists) {
 
-    for (var name in objectsLists.items) {
-        if (objectsLists.items.hasOwnProperty(name)) {
-            var allObjects = objectsContext.getObjects(name);
-            var objectsList = objectsLists.items[name];
-            objectsList.length = 0;
-            objectsList.push.apply(objectsList, allObjects);
-        }
+    var names = gdjs.staticArray(gdjs.evtTools.object.pickAllObjects);
+    objectsLists.keys(names);
+    for (var i = 0, len = names.length; i < len; ++i) {
+        var allObjects = objectsContext.getObjects(names[i]);
+        var objectsList = objectsLists.get(names[i]);
+        objectsList.length = 0;
+        objectsList.push.apply(objectsList, allObjects);
     }
 
     return true;
@@ -259,11 +259,10 @@ gdjs.evtTools.object.pickAllObjects = function(objectsContext, objectsLists) {
 gdjs.evtTools.object.pickRandomObject = function(runtimeScene, objectsLists) {
     // Compute one many objects we have
     var objectsCount = 0;
-    for (var listName in objectsLists.items) {
-        if (objectsLists.items.hasOwnProperty(listName)) {
-            var list = objectsLists.items[listName];
-            objectsCount += list.length;
-        }
+    var lists = gdjs.staticArray(gdjs.evtTools.object.pickRandomObject);
+    objectsLists.values(lists);
+    for (var i = 0, len = lists.length; i < len; ++i) {
+        objectsCount += lists[i].length;
     }
     
     if (objectsCount === 0) 
@@ -276,17 +275,15 @@ gdjs.evtTools.object.pickRandomObject = function(runtimeScene, objectsLists) {
     // Find the object
     var startIndex = 0;
     var theChosenOne = null;
-    for (var listName in objectsLists.items) {
-        if (objectsLists.items.hasOwnProperty(listName)) {
-            var list = objectsLists.items[listName];
-
-            if (index - startIndex < list.length) {
-                theChosenOne = list[index - startIndex];
-                break;
-            }
+    for (var i = 0, len = lists.length; i < len; ++i) {
+        var list = lists[i];
 
-            startIndex += list.length;
+        if (index - startIndex < list.length) {
+            theChosenOne = list[index - startIndex];
+            break;
         }
+
+        startIndex += list.length;
     }
     
     gdjs.evtTools.object.pickOnly(objectsLists, theChosenOne);
@@ -155,5 +155,5 @@ gdjs.evtTools.runtimeScene.createObjectsFromExternalLayout = function(scene, ext
     var externalLayoutData = scene.getGame().getExternalLayoutData(externalLayout);
     if ( externalLayoutData === null ) return;
 
-    scene.createObjectsFrom(externalLayoutData.instances, xPos, yPos);
+    scene.createObjectsFromPreparedInstances(externalLayout, externalLayoutData.instances, xPos, yPos);
 };
@@ -2,6 +2,12 @@ function Hashtable()
 {
     // console.log("New hashtable");
     this.items = {};
+    //The keys and the values are also kept in arrays, built the first time
+    //they are requested and reset when the hashtable is modified, so that
+    //iterating on unchanged hashtables (like the maps of objects lists given by
+    //events) does not use for...in loops.
+    this._keysCache = null;
+    this._valuesCache = null;
 }
 
 Hashtable.newFrom = function(items) {
@@ -12,6 +18,8 @@ Hashtable.newFrom = function(items) {
 
 Hashtable.prototype.put = function(key, value) {
     this.items[key] = value;
+    this._keysCache = null;
+    this._valuesCache = null;
 }
 
 Hashtable.prototype.get = function(key) {
@@ -24,40 +32,54 @@ Hashtable.prototype.containsKey = function(key) {
 
 Hashtable.prototype.remove = function(key) {
     delete this.items[key];
+    this._keysCache = null;
+    this._valuesCache = null;
 }
 
 Hashtable.prototype.firstKey = function() {
-    for (var k in this.items) {
-        if (this.items.hasOwnProperty(k)) {
-            return k;
-        }
-    }
-
-    return undefined;
+    this._updateCaches();
+    return this._keysCache.length !== 0 ? this._keysCache[0] : undefined;
 }
 
 Hashtable.prototype.keys = function(result) {
-    result.length = 0;
-    for (var k in this.items) {
-        if (this.items.hasOwnProperty(k)) {
-            result.push(k);
-        }
+    this._updateCaches();
+    var keys = this._keysCache;
+    result.length = keys.length;
+    for (var i = 0, len = keys.length; i < len; ++i) {
+        result[i] = keys[i];
     }
 }
 
 Hashtable.prototype.values = function(result) {
-    result.length = 0;
+    this._updateCaches();
+    var values = this._valuesCache;
+    result.length = values.length;
+    for (var i = 0, len = values.length; i < len; ++i) {
+        result[i] = values[i];
+    }
+}
+
+Hashtable.prototype.clear = function() {
     for (var k in this.items) {
         if (this.items.hasOwnProperty(k)) {
-            result.push(this.items[k]);
+            delete this.items[k];
         }
     }
+    this._keysCache = null;
+    this._valuesCache = null;
 }
 
-Hashtable.prototype.clear = function() {
+Hashtable.prototype._updateCaches = function() {
+    if (this._keysCache !== null) return;
+
+    var keys = [];
+    var values = [];
     for (var k in this.items) {
         if (this.items.hasOwnProperty(k)) {
-            delete this.items[k];
+            keys.push(k);
+            values.push(this.items[k]);
         }
     }
+    this._keysCache = keys;
+    this._valuesCache = values;
 }
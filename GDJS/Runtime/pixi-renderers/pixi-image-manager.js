@@ -116,6 +116,7 @@ gdjs.PixiImageManager.prototype.loadTextures = function(onProgress, onComplete,
 	//Construct the list of files to be loaded.
 	//For one loaded file, it can have one or more resources
 	//that use it.
+    var loader = PIXI.loader;
     var files = {};
 	for(var i = 0, len = resources.length;i<len;++i) {
 		var res = resources[i];
@@ -126,6 +127,13 @@ gdjs.PixiImageManager.prototype.loadTextures = function(onProgress, onComplete,
         		continue;
         	}
 
+        	//The file can't be added again to the loader if it was loaded
+        	//by an earlier call (for another resource using it).
+        	if (loader.resources[res.file] && loader.resources[res.file].texture) {
+        		this._loadedTextures.put(res.name, loader.resources[res.file].texture);
+        		continue;
+        	}
+
             files[res.file] = files[res.file] ? files[res.file].concat(res) : [res];
         }
     }
@@ -135,7 +143,6 @@ gdjs.PixiImageManager.prototype.loadTextures = function(onProgress, onComplete,
     	return onComplete(totalCount); //Nothing to load.
 
     var loadingCount = 0;
-    var loader = PIXI.loader;
 	var that = this;
     loader.once('complete', function(loader, loadedFiles) {
     	//Store the loaded textures so that they are ready to use.
@@ -153,12 +160,14 @@ gdjs.PixiImageManager.prototype.loadTextures = function(onProgress, onComplete,
     		}
     	}
 
+    	loader.off('progress', onLoaderProgress); //The loader can be used again later.
     	onComplete(totalCount);
     });
-    loader.on('progress', function() {
+    var onLoaderProgress = function() {
     	loadingCount++;
     	onProgress(loadingCount, totalCount);
-    });
+    };
+    loader.on('progress', onLoaderProgress);
 
 	for (var file in files) {
 		if (files.hasOwnProperty(file)) {
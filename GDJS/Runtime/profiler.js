@@ -12,6 +12,7 @@ gdjs.Profiler = function() {
 
   this._maxFramesCount = 600;
   this._framesCount = 0; // The number of frames that have been measured
+  this._recordedFramesCount = 0; // The number of frames measured since the creation of the profiler
   while (this._framesMeasures.length < this._maxFramesCount) {
     this._framesMeasures.push({
       parent: null,
@@ -69,6 +70,7 @@ gdjs.Profiler.prototype.endFrame = function() {
 
   this.end();
 
+  this._recordedFramesCount++;
   this._framesCount++;
   if (this._framesCount > this._maxFramesCount)
     this._framesCount = this._maxFramesCount;
@@ -130,6 +132,62 @@ gdjs.Profiler.prototype.getFramesAverageMeasures = function() {
   return framesAverageMeasures;
 };
 
+gdjs.Profiler._copySection = function(section) {
+  var copiedSection = {
+    time: section.time,
+    subsections: {},
+  };
+  for (var sectionName in section.subsections) {
+    if (section.subsections.hasOwnProperty(sectionName)) {
+      copiedSection.subsections[sectionName] = gdjs.Profiler._copySection(
+        section.subsections[sectionName]
+      );
+    }
+  }
+
+  return copiedSection;
+};
+
+/**
+ * Get the number of frames measured since the creation of the profiler,
+ * including the ones that are no more kept.
+ */
+gdjs.Profiler.prototype.getRecordedFramesCount = function() {
+  return this._recordedFramesCount;
+};
+
+/**
+ * Return the measures of the frames captured since a frame, to be sent to
+ * a remote profiler. The frames that are no more kept are skipped.
+ *
+ * @param {number} firstFrame The number of the first frame to return (see getRecordedFramesCount).
+ * @param {number} samplingRate Only the frames whose number is a multiple of the rate are returned.
+ * @return {Object[]} The frames, with their number (`frame`) and their measures (`measures`, without the references to the parent sections).
+ */
+gdjs.Profiler.prototype.getFramesMeasuresSince = function(
+  firstFrame,
+  samplingRate
+) {
+  var framesMeasures = [];
+  var oldestFrame = this._recordedFramesCount - this._framesCount;
+  for (
+    var frame = Math.max(firstFrame, oldestFrame);
+    frame < this._recordedFramesCount;
+    ++frame
+  ) {
+    if (frame % samplingRate !== 0) continue;
+
+    framesMeasures.push({
+      frame: frame,
+      measures: gdjs.Profiler._copySection(
+        this._framesMeasures[frame % this._maxFramesCount]
+      ),
+    });
+  }
+
+  return framesMeasures;
+};
+
 /**
  * Get stats measured during the frames captured.
  */
@@ -20,6 +20,14 @@ gdjs.RuntimeBehavior = function(runtimeScene, behaviorData, owner)
     this._nameId = gdjs.RuntimeObject.getNameIdentifier(this.name);
     this._activated = true;
     this.owner = owner;
+
+    // True if the behavior is stepped by the registry of its type (see gdjs.RuntimeBehaviorsRegistry).
+    this._steppedInBatches = gdjs.RuntimeBehaviorsRegistry.isBatchedConstructor(
+        gdjs.behaviorsTypes.get(this.type));
+
+    /** @type gdjs.RuntimeBehaviorsRegistry */
+    this._registry = null; // The registry stepping the behavior, once registered.
+    this._registryIndex = 0;
 };
 /**
  * Get the name of the behavior.
@@ -43,7 +51,14 @@ gdjs.RuntimeBehavior.prototype.getNameId = function() {
  * @param {gdjs.RuntimeScene} runtimeScene The runtimeScene owning the object
  */
 gdjs.RuntimeBehavior.prototype.stepPreEvents = function(runtimeScene) {
-	if ( this._activated ) {
+	if ( this._activated && !this._registry ) {
+		// The behaviors stepped in batches are registered during their first step,
+		// and stepped by the registry of their type after the objects.
+		if (this._steppedInBatches) {
+			runtimeScene.getBehaviorsRegistry(this.type).add(this);
+			return;
+		}
+
 		var profiler = runtimeScene.getProfiler();
 		if (profiler) profiler.begin(this.name);
 
@@ -59,7 +74,12 @@ gdjs.RuntimeBehavior.prototype.stepPreEvents = function(runtimeScene) {
  * @param {gdjs.RuntimeScene} runtimeScene The runtimeScene owning the object
  */
 gdjs.RuntimeBehavior.prototype.stepPostEvents = function(runtimeScene) {
-	if ( this._activated ) {
+	if ( this._activated && !this._registry ) {
+		if (this._steppedInBatches) {
+			runtimeScene.getBehaviorsRegistry(this.type).add(this);
+			return;
+		}
+
 		var profiler = runtimeScene.getProfiler();
 		if (profiler) profiler.begin(this.name);
 
@@ -81,6 +101,7 @@ gdjs.RuntimeBehavior.prototype.activate = function(enable) {
 	}
 	else if ( this._activated && !enable ) {
 		this._activated = false;
+		if (this._registry) this._registry.remove(this);
 		this.onDeActivate();
 	}
 };
@@ -0,0 +1,147 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2013-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+/**
+ * A registry of all the activated behaviors of a type of a scene, stepping
+ * them in batches instead of one by one by their objects.
+ *
+ * It is used for the types of behaviors having a static `stepAllPreEvents`
+ * and/or `stepAllPostEvents` function (like the behaviors generated from
+ * events), called with the scene and the array of the behaviors:
+ * ```
+ * MyRuntimeBehavior.stepAllPreEvents = function(runtimeScene, behaviors) {};
+ * ```
+ * The behaviors register themselves during their first step (see
+ * gdjs.RuntimeBehavior#stepPreEvents) and are stepped by the registry once
+ * all the objects of the scene are stepped. A phase without a static function
+ * calls the `doStepPreEvents` (or `doStepPostEvents`) method of each behavior.
+ *
+ * @class RuntimeBehaviorsRegistry
+ * @memberof gdjs
+ * @param {Function} behaviorConstructor The constructor of the behaviors.
+ * @see gdjs.RuntimeScene#getBehaviorsRegistry
+ */
+gdjs.RuntimeBehaviorsRegistry = function(behaviorConstructor) {
+  this._behaviorConstructor = behaviorConstructor;
+
+  /** @type gdjs.RuntimeBehavior[] */
+  this._behaviors = []; // The registered behaviors, each one knowing its index.
+
+  /** @type gdjs.RuntimeBehavior[] */
+  this._steppedBehaviors = []; // Only valid during a step.
+};
+
+/**
+ * Return true if the behaviors built by the constructor can be stepped by a
+ * registry.
+ * @param {Function} behaviorConstructor The constructor of the behaviors.
+ */
+gdjs.RuntimeBehaviorsRegistry.isBatchedConstructor = function(
+  behaviorConstructor
+) {
+  return (
+    !!behaviorConstructor &&
+    (typeof behaviorConstructor.stepAllPreEvents === 'function' ||
+      typeof behaviorConstructor.stepAllPostEvents === 'function')
+  );
+};
+
+/**
+ * Register the behavior, so that it is stepped by the registry and not by its
+ * object anymore.
+ * @param {gdjs.RuntimeBehavior} behavior The behavior to register.
+ */
+gdjs.RuntimeBehaviorsRegistry.prototype.add = function(behavior) {
+  if (behavior._registry) behavior._registry.remove(behavior);
+
+  behavior._registry = this;
+  behavior._registryIndex = this._behaviors.length;
+  this._behaviors.push(behavior);
+};
+
+/**
+ * Unregister the behavior, in constant time, so that it is stepped again by
+ * its object.
+ * @param {gdjs.RuntimeBehavior} behavior The behavior to unregister.
+ */
+gdjs.RuntimeBehaviorsRegistry.prototype.remove = function(behavior) {
+  var index = behavior._registryIndex;
+  if (behavior._registry !== this || this._behaviors[index] !== behavior)
+    return;
+
+  var lastBehavior = this._behaviors.pop();
+  if (lastBehavior !== behavior) {
+    this._behaviors[index] = lastBehavior;
+    lastBehavior._registryIndex = index;
+  }
+
+  behavior._registry = null;
+};
+
+/**
+ * Return the number of registered behaviors.
+ */
+gdjs.RuntimeBehaviorsRegistry.prototype.getBehaviorsCount = function() {
+  return this._behaviors.length;
+};
+
+/**
+ * Step all the registered behaviors before events.
+ * @param {gdjs.RuntimeScene} runtimeScene The scene of the behaviors.
+ */
+gdjs.RuntimeBehaviorsRegistry.prototype.stepPreEvents = function(
+  runtimeScene
+) {
+  this._step(runtimeScene, false);
+};
+
+/**
+ * Step all the registered behaviors after events.
+ * @param {gdjs.RuntimeScene} runtimeScene The scene of the behaviors.
+ */
+gdjs.RuntimeBehaviorsRegistry.prototype.stepPostEvents = function(
+  runtimeScene
+) {
+  this._step(runtimeScene, true);
+};
+
+gdjs.RuntimeBehaviorsRegistry.prototype._step = function(
+  runtimeScene,
+  postEvents
+) {
+  // Copy the registered behaviors, so that behaviors can be registered or
+  // unregistered during the step.
+  var steppedBehaviors = this._steppedBehaviors;
+  steppedBehaviors.length = 0;
+  for (var i = 0, len = this._behaviors.length; i < len; ++i) {
+    steppedBehaviors.push(this._behaviors[i]);
+  }
+  if (steppedBehaviors.length === 0) return;
+
+  // The time of the batch is measured under the name of its first behavior.
+  var profiler = runtimeScene.getProfiler();
+  var name = steppedBehaviors[0].name;
+  if (profiler) profiler.begin(name);
+
+  var behaviorConstructor = this._behaviorConstructor;
+  var stepAll = postEvents
+    ? behaviorConstructor.stepAllPostEvents
+    : behaviorConstructor.stepAllPreEvents;
+  if (typeof stepAll === 'function') {
+    stepAll.call(behaviorConstructor, runtimeScene, steppedBehaviors);
+  } else {
+    for (var i = 0, len = steppedBehaviors.length; i < len; ++i) {
+      var behavior = steppedBehaviors[i];
+      if (!behavior.activated()) continue;
+
+      if (postEvents) behavior.doStepPostEvents(runtimeScene);
+      else behavior.doStepPreEvents(runtimeScene);
+    }
+  }
+
+  if (profiler) profiler.end(name);
+  steppedBehaviors.length = 0;
+};
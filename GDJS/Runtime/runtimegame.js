@@ -124,7 +124,7 @@ gdjs.RuntimeGame.prototype.getSceneData = function(sceneName) {
     var sceneData = this._data.layouts[i];
 
     if (sceneName === undefined || sceneData.name === sceneName) {
-      scene = sceneData;
+      scene = this._parseLazySceneData(i);
       break;
     }
   }
@@ -135,6 +135,59 @@ gdjs.RuntimeGame.prototype.getSceneData = function(sceneName) {
   return scene;
 };
 
+/**
+ * Parse the data of a scene exported in its own file (see
+ * gdjs.projectLayoutsData), if not done yet.
+ *
+ * @param {number} sceneIndex The index of the scene in the game data.
+ * @return The data associated to the scene.
+ */
+gdjs.RuntimeGame.prototype._parseLazySceneData = function(sceneIndex) {
+  var sceneData = this._data.layouts[sceneIndex];
+  if (!sceneData.lazilyLoaded) return sceneData;
+
+  var sceneName = sceneData.name;
+  var layoutsData = gdjs.projectLayoutsData || {};
+  var data = layoutsData[sceneName];
+  if (typeof data !== 'string') {
+    console.warn('The data of the scene "' + sceneName + '" is missing');
+    return sceneData;
+  }
+
+  // The data is in JSON or, if exported in the binary format, in base64.
+  sceneData = this._data.layouts[sceneIndex] =
+    data.charAt(0) === '{'
+      ? JSON.parse(data)
+      : gdjs.decodeBinaryProjectData(data);
+  delete layoutsData[sceneName]; // The string is not needed anymore.
+
+  return sceneData;
+};
+
+/**
+ * Parse the data of a scene exported in its own file when the game is idle,
+ * so that it is ready when the scene is loaded.
+ *
+ * @param {string} sceneName The name of the scene.
+ */
+gdjs.RuntimeGame.prototype.prefetchSceneData = function(sceneName) {
+  if (typeof requestIdleCallback === 'undefined') return;
+
+  for (var i = 0, len = this._data.layouts.length; i < len; ++i) {
+    if (
+      this._data.layouts[i].name === sceneName &&
+      this._data.layouts[i].lazilyLoaded
+    ) {
+      var that = this;
+      var sceneIndex = i;
+      requestIdleCallback(function() {
+        that._parseLazySceneData(sceneIndex);
+      });
+      return;
+    }
+  }
+};
+
 /**
  * Check if a scene exists
  *
@@ -263,6 +316,12 @@ gdjs.RuntimeGame.prototype.pause = function(enable) {
 
 /**
  * Load all assets, displaying progress in renderer.
+ *
+ * If the resources used by each scene were exported (see
+ * gdjs.projectLayoutsResources), only the resources of the first scene (and
+ * the ones not used by any scene) are loaded before calling the callback: the
+ * resources of the other scenes are then loaded in the background, in the
+ * order of the scenes in the game.
  */
 gdjs.RuntimeGame.prototype.loadAllAssets = function(
   callback,
@@ -272,41 +331,123 @@ gdjs.RuntimeGame.prototype.loadAllAssets = function(
     this.getRenderer(),
     this._data.properties.loadingScreen
   );
-  var allAssetsTotal = this._data.resources.resources.length;
+  var scenesResources = this._getScenesResources();
+  var firstResources = scenesResources.shift();
 
   var that = this;
-  this._imageManager.loadTextures(
+  this._loadResources(
+    firstResources,
     function(count, total) {
-      var percent = Math.floor((count / allAssetsTotal) * 100);
+      var percent = Math.floor((count / total) * 100);
       loadingScreen.render(percent);
       if (progressCallback) progressCallback(percent);
     },
+    function() {
+      loadingScreen.unload();
+      callback();
+
+      var loadNextSceneResources = function() {
+        if (scenesResources.length === 0) return;
+        that._loadResources(
+          scenesResources.shift(),
+          function() {},
+          loadNextSceneResources
+        );
+      };
+      loadNextSceneResources();
+    }
+  );
+};
+
+/**
+ * Return the resources of the game split by the scenes using them, in the
+ * order they are loaded: the first array contains the resources of the first
+ * scene and the ones not used by any scene (or all the resources if the
+ * resources used by each scene were not exported).
+ *
+ * @return {Array<Object[]>} The resources to be loaded for each scene.
+ */
+gdjs.RuntimeGame.prototype._getScenesResources = function() {
+  var allResources = this._data.resources.resources;
+  var layoutsResources = gdjs.projectLayoutsResources;
+  if (!layoutsResources) return [allResources];
+
+  var resourcesByName = {};
+  for (var i = 0, len = allResources.length; i < len; ++i) {
+    resourcesByName[allResources[i].name] = allResources[i];
+  }
+
+  // The first scene is followed by the next ones, in the order of the game.
+  var layouts = this._data.layouts;
+  var firstIndex = 0;
+  for (var i = 0, len = layouts.length; i < len; ++i) {
+    if (layouts[i].name === this._data.firstLayout) firstIndex = i;
+  }
+
+  var scenesResources = [];
+  var addedResources = {};
+  for (var i = 0, len = layouts.length; i < len; ++i) {
+    var names = layoutsResources[layouts[(firstIndex + i) % len].name] || [];
+    var sceneResources = [];
+    for (var j = 0; j < names.length; ++j) {
+      var resource = resourcesByName[names[j]];
+      if (resource && !addedResources.hasOwnProperty(names[j])) {
+        addedResources[names[j]] = true;
+        sceneResources.push(resource);
+      }
+    }
+    scenesResources.push(sceneResources);
+  }
+  if (scenesResources.length === 0) scenesResources.push([]);
+
+  // Resources not used by any scene could be used by their names (in
+  // expressions for example), so they are loaded with the first scene.
+  for (var i = 0, len = allResources.length; i < len; ++i) {
+    if (!addedResources.hasOwnProperty(allResources[i].name))
+      scenesResources[0].push(allResources[i]);
+  }
+
+  return scenesResources;
+};
+
+/**
+ * Load the textures, audio and fonts of the specified resources.
+ *
+ * @param {Object[]} resources The resources to be loaded.
+ * @param {Function} onProgress Called with the number of loaded resources and
+ * the total number of resources.
+ * @param {Function} onComplete Called when all the resources are loaded.
+ */
+gdjs.RuntimeGame.prototype._loadResources = function(
+  resources,
+  onProgress,
+  onComplete
+) {
+  var total = resources.length;
+
+  var that = this;
+  this._imageManager.loadTextures(
+    function(count) {
+      onProgress(count, total);
+    },
     function(texturesTotalCount) {
       that._soundManager.preloadAudio(
-        function(count, total) {
-          loadingScreen.render(
-            Math.floor(((texturesTotalCount + count) / allAssetsTotal) * 100)
-          );
+        function(count) {
+          onProgress(texturesTotalCount + count, total);
         },
         function(audioTotalCount) {
           that._fontManager.loadFonts(
-            function(count, total) {
-              loadingScreen.render(
-                Math.floor(
-                  ((texturesTotalCount + audioTotalCount + count) /
-                    allAssetsTotal) *
-                    100
-                )
-              );
+            function(count) {
+              onProgress(texturesTotalCount + audioTotalCount + count, total);
             },
-            function() {
-              loadingScreen.unload();
-              callback();
-            }
+            onComplete,
+            resources
           );
-        }
+        },
+        resources
       );
-    }
+    },
+    resources
   );
 };
 
@@ -20,6 +20,11 @@ gdjs.RuntimeScene = function(runtimeGame)
     this._objectsCtor = new Hashtable();
     this._layers = new Hashtable();
     this._initialBehaviorSharedData = new Hashtable();
+    this._preparedInstances = new Hashtable(); //The instances of the external layouts, prepared when first created (see createObjectsFromPreparedInstances).
+    this._behaviorsRegistries = new Hashtable(); //The registries of the behaviors stepped in batches, by type.
+
+    /** @type gdjs.RuntimeBehaviorsRegistry[] */
+    this._behaviorsRegistriesList = []; //The registries, in the order of their creation.
     this._renderer = new gdjs.RuntimeSceneRenderer(this,
         runtimeGame ? runtimeGame.getRenderer() : null);
     this._variables = new gdjs.VariablesContainer();
@@ -185,6 +190,9 @@ gdjs.RuntimeScene.prototype.unloadScene = function() {
     this._objects = new Hashtable();
     this._instances = new Hashtable();
     this._instancesCache = new Hashtable();
+    this._preparedInstances = new Hashtable();
+    this._behaviorsRegistries = new Hashtable();
+    this._behaviorsRegistriesList = [];
     this._initialObjectsData = null;
     this._eventsFunction = null;
     this._objectsCtor = new Hashtable();
@@ -224,6 +232,53 @@ gdjs.RuntimeScene.prototype.createObjectsFrom = function(data, xPos, yPos) {
     }
 };
 
+/**
+ * Create objects from initial instances data that are created many times
+ * (like the instances of an external layout).
+ *
+ * The instances are prepared the first time they are created: their numbers are
+ * parsed only once and the instances of objects not existing in the scene are skipped.
+ *
+ * @param {string} name The name identifying the instances (the name of the external layout).
+ * @param {Object[]} data The instances data.
+ * @param {number} xPos The offset on X axis
+ * @param {number} yPos The offset on Y axis
+ */
+gdjs.RuntimeScene.prototype.createObjectsFromPreparedInstances = function(name, data, xPos, yPos) {
+    if ( !this._preparedInstances.containsKey(name) ) {
+        var preparedInstances = [];
+        for(var i = 0, len = data.length;i<len;++i) {
+            var instanceData = data[i];
+            if ( !this._objects.containsKey(instanceData.name) ) continue;
+
+            preparedInstances.push({
+                name: instanceData.name,
+                x: parseFloat(instanceData.x),
+                y: parseFloat(instanceData.y),
+                zOrder: parseFloat(instanceData.zOrder),
+                angle: parseFloat(instanceData.angle),
+                data: instanceData
+            });
+        }
+        this._preparedInstances.put(name, preparedInstances);
+    }
+
+    var instances = this._preparedInstances.get(name);
+    for(var i = 0, len = instances.length;i<len;++i) {
+        var instance = instances[i];
+        var newObject = this.createObject(instance.name);
+
+        if ( newObject !== null ) {
+            newObject.setPosition(instance.x + xPos, instance.y + yPos);
+            newObject.setZOrder(instance.zOrder);
+            newObject.setAngle(instance.angle);
+            newObject.setLayer(instance.data.layer);
+            newObject.getVariables().initFrom(instance.data.initialVariables, true);
+            newObject.extraInitializationFromInitialInstance(instance.data);
+        }
+    }
+};
+
 /**
  * Set the function called each time the scene is stepped.
  * The function will be passed the `runtimeScene` as argument.
@@ -425,6 +480,11 @@ gdjs.RuntimeScene.prototype._updateObjectsPreEvents = function() {
         this._allInstancesList[i].stepBehaviorsPreEvents(this);
     }
 
+    //The behaviors stepped in batches are stepped once the objects are updated.
+    for(var i = 0;i<this._behaviorsRegistriesList.length;++i) {
+        this._behaviorsRegistriesList[i].stepPreEvents(this);
+    }
+
     this._cacheOrClearRemovedInstances(); //Some behaviors may have request objects to be deleted.
 };
 
@@ -442,9 +502,30 @@ gdjs.RuntimeScene.prototype._updateObjectsPostEvents = function() {
         this._allInstancesList[i].stepBehaviorsPostEvents(this);
     }
 
+    for(var i = 0;i<this._behaviorsRegistriesList.length;++i) {
+        this._behaviorsRegistriesList[i].stepPostEvents(this);
+    }
+
     this._cacheOrClearRemovedInstances(); //Some behaviors may have request objects to be deleted.
 };
 
+/**
+ * Get the registry stepping the behaviors of a type in batches, created if needed.
+ *
+ * @param {string} type The type of the behaviors, which constructor must have a
+ * static stepAllPreEvents and/or stepAllPostEvents function.
+ * @return {gdjs.RuntimeBehaviorsRegistry} The registry of the type.
+ */
+gdjs.RuntimeScene.prototype.getBehaviorsRegistry = function(type) {
+    var registry = this._behaviorsRegistries.get(type);
+    if (registry) return registry;
+
+    registry = new gdjs.RuntimeBehaviorsRegistry(gdjs.getBehaviorConstructor(type));
+    this._behaviorsRegistries.put(type, registry);
+    this._behaviorsRegistriesList.push(registry);
+    return registry;
+};
+
 /**
  * Change the background color
  */
@@ -567,7 +648,9 @@ gdjs.RuntimeScene.prototype.markObjectForDeletion = function(obj) {
     //Notify the object it was removed from the scene
     obj.onDeletedFromScene(this);
     for(var j = 0, lenj = obj._behaviors.length;j<lenj;++j) {
-        obj._behaviors[j].onOwnerRemovedFromScene();
+        var behavior = obj._behaviors[j];
+        if (behavior._registry) behavior._registry.remove(behavior);
+        behavior.onOwnerRemovedFromScene();
     }
 
     //Call global callback
@@ -94,6 +94,17 @@ gdjs.SceneStack.prototype.push = function(newSceneName, externalLayoutName) {
     }
 
     this._stack.push(newScene);
+
+    // The next scene of the game is the most likely to be loaded after this
+    // one: its data is prepared in advance, if not parsed yet.
+    var gameData = this._runtimeGame.getGameData();
+    for (var i = 0; i + 1 < gameData.layouts.length; ++i) {
+        if (gameData.layouts[i].name === newScene.getName()) {
+            this._runtimeGame.prefetchSceneData(gameData.layouts[i + 1].name);
+            break;
+        }
+    }
+
     return newScene;
 };
 
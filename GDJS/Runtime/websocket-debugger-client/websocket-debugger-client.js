@@ -9,6 +9,9 @@
  */
 gdjs.WebsocketDebuggerClient = function(runtimegame) {
   this._runtimegame = runtimegame;
+  this._profilerStreamTimer = null;
+  this._streamedProfiler = null; // The profiler of the frames sent by the stream
+  this._streamedFramesCount = 0; // The number of the next frame to be sent by the stream
 
   if (typeof WebSocket === 'undefined') {
     console.log("WebSocket is not defined, debugger won't work");
@@ -32,6 +35,7 @@ gdjs.WebsocketDebuggerClient = function(runtimegame) {
 
   ws.onclose = function close() {
     console.info('Debugger connection closed');
+    that.stopProfilerStream();
   };
 
   ws.onerror = function errored(error) {
@@ -69,6 +73,12 @@ gdjs.WebsocketDebuggerClient = function(runtimegame) {
         that.sendProfilerStarted();
       } else if (data.command === 'profiler.stop') {
         runtimegame.stopCurrentSceneProfiler();
+      } else if (data.command === 'profiler.stream.start') {
+        that.startProfilerStream(data.payload || {});
+      } else if (data.command === 'profiler.stream.stop') {
+        that.stopProfilerStream();
+      } else if (data.command === 'hotReload') {
+        that.hotReload(data.payload.codeFiles);
       } else {
         console.info(
           'Unknown command "' + data.command + '" received by the debugger.'
@@ -144,6 +154,65 @@ gdjs.WebsocketDebuggerClient.prototype.call = function(path, args) {
   return true;
 };
 
+/**
+ * Load the given code files (generated from the events of the scenes) and
+ * replace the events functions of the running scenes by the new ones,
+ * without restarting the game.
+ *
+ * @param {string[]} codeFiles The files to load, relative to the game.
+ */
+gdjs.WebsocketDebuggerClient.prototype.hotReload = function(codeFiles) {
+  if (typeof document === 'undefined') {
+    console.warn('Scripts cannot be loaded, hot reload aborted');
+    return;
+  }
+
+  var that = this;
+  var runtimegame = this._runtimegame;
+  var remainingFilesCount = codeFiles.length;
+  var onAllFilesLoaded = function() {
+    // Scenes created after this will use the new code, but the running ones
+    // must be updated.
+    var scenes = runtimegame._sceneStack._stack;
+    for (var i = 0; i < scenes.length; ++i) {
+      var sceneData = runtimegame.getSceneData(scenes[i].getName());
+      var module = sceneData ? gdjs[sceneData.mangledName + 'Code'] : null;
+      if (module && module.func) scenes[i].setEventsFunction(module.func);
+    }
+
+    console.info('Hot reload done (' + codeFiles.length + ' files loaded)');
+    that.sendHotReloadDone();
+  };
+
+  if (remainingFilesCount === 0) return onAllFilesLoaded();
+
+  codeFiles.forEach(function(codeFile) {
+    var script = document.createElement('script');
+    script.onload = script.onerror = function() {
+      document.head.removeChild(script);
+      remainingFilesCount--;
+      if (remainingFilesCount === 0) onAllFilesLoaded();
+    };
+    // Avoid the cached version of the file to be used.
+    script.src = codeFile + '?' + Date.now();
+    document.head.appendChild(script);
+  });
+};
+
+gdjs.WebsocketDebuggerClient.prototype.sendHotReloadDone = function() {
+  if (!this._ws) {
+    console.warn('No connection to debugger opened');
+    return;
+  }
+
+  this._ws.send(
+    this._circularSafeStringify({
+      command: 'hotReload.done',
+      payload: null,
+    })
+  );
+};
+
 gdjs.WebsocketDebuggerClient.prototype.sendRuntimeGameDump = function() {
   if (!this._ws) {
     console.warn('No connection to debugger opened to send RuntimeGame dump');
@@ -271,6 +340,108 @@ gdjs.WebsocketDebuggerClient.prototype.sendProfilerOutput = function(
   );
 };
 
+/**
+ * Start sending the frames measured by the profiler of the current scene at
+ * a regular interval, so that they can be displayed live by the debugger.
+ * If the scene is changed, a profiler is started on the new scene.
+ *
+ * @param {Object} options The `interval` between two messages (in milliseconds, 250 by default)
+ * and the `samplingRate` (only one frame out of `samplingRate` is sent, 1 by default).
+ */
+gdjs.WebsocketDebuggerClient.prototype.startProfilerStream = function(
+  options
+) {
+  this.stopProfilerStream();
+
+  var that = this;
+  var interval = options.interval || 250;
+  var samplingRate = Math.max(1, options.samplingRate || 1);
+  this._profilerStreamTimer = setInterval(function() {
+    that._sendProfilerFrames(samplingRate);
+  }, interval);
+  this._sendProfilerFrames(samplingRate);
+  this.sendProfilerStreamStarted();
+};
+
+gdjs.WebsocketDebuggerClient.prototype.stopProfilerStream = function() {
+  if (this._profilerStreamTimer === null) return;
+
+  clearInterval(this._profilerStreamTimer);
+  this._profilerStreamTimer = null;
+  this._streamedProfiler = null;
+  this._runtimegame.stopCurrentSceneProfiler();
+  this.sendProfilerStreamStopped();
+};
+
+gdjs.WebsocketDebuggerClient.prototype._sendProfilerFrames = function(
+  samplingRate
+) {
+  var currentScene = this._runtimegame._sceneStack.getCurrentScene();
+  if (!currentScene || !this._ws) return;
+
+  var profiler = currentScene.getProfiler();
+  if (!profiler) {
+    currentScene.startProfiler(null);
+    profiler = currentScene.getProfiler();
+  }
+  if (profiler !== this._streamedProfiler) {
+    this._streamedProfiler = profiler;
+    this._streamedFramesCount = profiler.getRecordedFramesCount();
+  }
+
+  var frames = profiler.getFramesMeasuresSince(
+    this._streamedFramesCount,
+    samplingRate
+  );
+  this._streamedFramesCount = profiler.getRecordedFramesCount();
+  if (!frames.length) return;
+
+  var memory =
+    typeof performance !== 'undefined' && performance.memory
+      ? performance.memory
+      : null;
+  this._ws.send(
+    JSON.stringify({
+      command: 'profiler.frames',
+      payload: {
+        frames: frames,
+        stats: {
+          objectsCount: currentScene.getAdhocListOfAllInstances().length,
+          usedJSHeapSize: memory ? memory.usedJSHeapSize : null,
+        },
+      },
+    })
+  );
+};
+
+gdjs.WebsocketDebuggerClient.prototype.sendProfilerStreamStarted = function() {
+  if (!this._ws) {
+    console.warn('No connection to debugger opened');
+    return;
+  }
+
+  this._ws.send(
+    this._circularSafeStringify({
+      command: 'profiler.stream.started',
+      payload: null,
+    })
+  );
+};
+
+gdjs.WebsocketDebuggerClient.prototype.sendProfilerStreamStopped = function() {
+  if (!this._ws) {
+    console.warn('No connection to debugger opened');
+    return;
+  }
+
+  this._ws.send(
+    this._circularSafeStringify({
+      command: 'profiler.stream.stopped',
+      payload: null,
+    })
+  );
+};
+
 // This is an alternative to JSON.stringify that ensure that circular reference
 // are replaced by a placeholder.
 gdjs.WebsocketDebuggerClient.prototype._circularSafeStringify = function(
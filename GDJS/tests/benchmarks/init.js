@@ -45,3 +45,38 @@ let makeBenchmarkSuite = (options = {}) => {
   };
   return suite;
 };
+
+/**
+ * Helper measuring the time of each step of a scene, to report the percentiles
+ * of the times of the steps (in milliseconds) and not only their average: a
+ * behavior doing expensive work only at some frames is noticed by the slowest
+ * steps.
+ *
+ * @param {*} options The number of steps measured (stepsCount) and of steps
+ * done before the measures (warmUpStepsCount).
+ * @param {Function} step Called with the index of the step.
+ */
+let benchmarkSteps = (options = {}, step) => {
+  const stepsCount = options.stepsCount || 300;
+  const warmUpStepsCount = options.warmUpStepsCount || 0;
+  for (let i = 0; i < warmUpStepsCount; i++) step(i);
+
+  const times = [];
+  for (let i = 0; i < stepsCount; i++) {
+    const start = performance.now();
+    step(warmUpStepsCount + i);
+    times.push(performance.now() - start);
+  }
+
+  times.sort((a, b) => a - b);
+  const getPercentile = percentile =>
+    times[Math.round(percentile / 100 * (times.length - 1))];
+  return {
+    stepsCount,
+    mean: times.reduce((sum, value) => sum + value, 0) / times.length,
+    p50: getPercentile(50),
+    p90: getPercentile(90),
+    p99: getPercentile(99),
+    max: times[times.length - 1],
+  };
+};
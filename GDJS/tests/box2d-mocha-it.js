@@ -0,0 +1,4 @@
+// box2d.js declares a global "it" variable, replacing the "it" function of
+// mocha: restore it from its alias, "specify" (only b2RevoluteJoint's
+// GetLocalAnchorB, not used by the tests, needs the variable of box2d.js).
+it = specify;
@@ -28,11 +28,13 @@ module.exports = function(config) {
       '../Runtime/timer.js',
       '../Runtime/inputmanager.js',
       '../Runtime/runtimegame.js',
+      '../Runtime/binaryprojectdata.js',
       '../Runtime/variable.js',
       '../Runtime/variablescontainer.js',
       '../Runtime/oncetriggers.js',
       '../Runtime/runtimescene.js',
       '../Runtime/runtimebehavior.js',
+      '../Runtime/runtimebehaviorsregistry.js',
       '../Runtime/runtimeobject.js',
       '../Runtime/spriteruntimeobject.js',
       '../Runtime/events-tools/commontools.js',
@@ -50,6 +52,11 @@ module.exports = function(config) {
       '../../Extensions/DraggableBehavior/draggableruntimebehavior.js',
       '../../Extensions/PlatformBehavior/platformerobjectruntimebehavior.js',
       '../../Extensions/PlatformBehavior/platformruntimebehavior.js',
+      '../../Extensions/PathfindingBehavior/pathfindingobstacleruntimebehavior.js',
+      '../../Extensions/PathfindingBehavior/pathfindingruntimebehavior.js',
+      '../../Extensions/PhysicsBehavior/box2djs/box2d.js',
+      './box2d-mocha-it.js',
+      '../../Extensions/PhysicsBehavior/physicsruntimebehavior.js',
       '../../Extensions/LinkedObjects/linkedobjects.js',
       '../../Extensions/Inventory/inventory.js',
       '../../Extensions/Inventory/inventorytools.js',
@@ -61,7 +68,8 @@ module.exports = function(config) {
 
       //All benchmark files:
       './benchmarks/init.js',
-      './benchmarks/**/*.js'
+      './benchmarks/**/*.js',
+      '../../Extensions/**/tests/**.benchmark.js'
     ]
   });
 };
@@ -0,0 +1,32 @@
+/**
+ * Tests for gdjs.decodeBinaryProjectData.
+ */
+describe('gdjs.decodeBinaryProjectData', function() {
+  it('should decode the binary format like the JSON export', function() {
+    // The binary format (see gd::Serializer::ToBinary) of:
+    // {"firstLayout": "Scène", "name": "Game", "layouts": [
+    //   {"name": "Scène", "x": -3, "y": 2.5, "visible": true},
+    //   {"name": "Other"}
+    // ]}
+    var data = gdjs.decodeBinaryProjectData(
+      'R0RCTgEAAAAKC2ZpcnN0TGF5b3V0BlNjw6huZQRuYW1lBEdhbWUHbGF5b3V0cwZsYXlvdXQBeAF5' +
+        'B3Zpc2libGUFT3RoZXIAAQACAQICBQAAAAECAwAABD8AAAACBQACBSsAAAAAAQICAQMGBQAA' +
+        'AAEDBQAABwwAAAABBAAAAAAAAARAAAAIBQAAAAEBAQAABQYAAAAAAQICCQA='
+    );
+
+    expect(data).to.eql({
+      firstLayout: 'Scène',
+      name: 'Game',
+      layouts: [
+        { name: 'Scène', x: -3, y: 2.5, visible: true },
+        { name: 'Other' },
+      ],
+    });
+  });
+
+  it('should refuse data not in the binary format', function() {
+    expect(function() {
+      gdjs.decodeBinaryProjectData(btoa('{"name": "Game"}'));
+    }).to.throwException();
+  });
+});
@@ -164,3 +164,37 @@ describe('gdjs.evtTools.object.pickNearestObject', function() {
 		expect(list1[0]).to.be(obj1C);
 	});
 });
+
+describe('Hashtable', function() {
+	it('should give keys and values updated after changes', function(){
+		var map = new Hashtable();
+		var keys = [];
+		var values = [];
+		map.keys(keys);
+		expect(keys).to.have.length(0);
+
+		map.put("a", 1);
+		map.put("b", 2);
+		map.keys(keys);
+		map.values(values);
+		expect(keys).to.eql(["a", "b"]);
+		expect(values).to.eql([1, 2]);
+		expect(map.firstKey()).to.be("a");
+
+		map.put("b", 3);
+		map.remove("a");
+		map.keys(keys);
+		map.values(values);
+		expect(keys).to.eql(["b"]);
+		expect(values).to.eql([3]);
+
+		map.clear();
+		map.values(values);
+		expect(values).to.have.length(0);
+		expect(map.firstKey()).to.be(undefined);
+
+		var mapFromItems = Hashtable.newFrom({c: 4});
+		mapFromItems.keys(keys);
+		expect(keys).to.eql(["c"]);
+	});
+});
@@ -0,0 +1,103 @@
+/**
+ * Tests for gdjs.RuntimeBehaviorsRegistry.
+ */
+describe('gdjs.RuntimeBehaviorsRegistry', function() {
+  // A behavior stepped in batches before events, and one by one (by the
+  // registry) after events.
+  gdjs.BatchedTestRuntimeBehavior = function(runtimeScene, behaviorData, owner) {
+    gdjs.RuntimeBehavior.call(this, runtimeScene, behaviorData, owner);
+    this.preEventsStepsCount = 0;
+    this.postEventsStepsCount = 0;
+  };
+  gdjs.BatchedTestRuntimeBehavior.prototype = Object.create(
+    gdjs.RuntimeBehavior.prototype
+  );
+  gdjs.BatchedTestRuntimeBehavior.thisIsARuntimeBehaviorConstructor =
+    'TestBehavior::BatchedTestBehavior';
+  gdjs.BatchedTestRuntimeBehavior.batchesSizes = [];
+  gdjs.BatchedTestRuntimeBehavior.stepAllPreEvents = function(
+    runtimeScene,
+    behaviors
+  ) {
+    gdjs.BatchedTestRuntimeBehavior.batchesSizes.push(behaviors.length);
+    for (var i = 0; i < behaviors.length; ++i) {
+      behaviors[i].preEventsStepsCount++;
+    }
+  };
+  gdjs.BatchedTestRuntimeBehavior.prototype.doStepPostEvents = function() {
+    this.postEventsStepsCount++;
+  };
+  gdjs.behaviorsTypes.put(
+    'TestBehavior::BatchedTestBehavior',
+    gdjs.BatchedTestRuntimeBehavior
+  );
+
+  var runtimeGame = new gdjs.RuntimeGame({
+    variables: [],
+    properties: { windowWidth: 800, windowHeight: 600 },
+  });
+  var runtimeScene = new gdjs.RuntimeScene(runtimeGame);
+  runtimeScene.loadFromScene({
+    layers: [{ name: '', visibility: true }],
+    variables: [],
+    behaviorsSharedData: [],
+    objects: [
+      {
+        name: 'obj1',
+        type: '',
+        variables: [],
+        behaviors: [
+          { type: 'TestBehavior::BatchedTestBehavior', name: 'Behavior' },
+        ],
+      },
+    ],
+    instances: [],
+  });
+
+  var objects = [
+    runtimeScene.createObject('obj1'),
+    runtimeScene.createObject('obj1'),
+    runtimeScene.createObject('obj1'),
+  ];
+  var getBehavior = function(i) {
+    return objects[i].getBehavior('Behavior');
+  };
+
+  it('steps all the behaviors of a type at once', function() {
+    runtimeScene.renderAndStep();
+    expect(gdjs.BatchedTestRuntimeBehavior.batchesSizes).to.eql([3]);
+    expect(getBehavior(0).preEventsStepsCount).to.be(1);
+    expect(getBehavior(0).postEventsStepsCount).to.be(1);
+    expect(
+      runtimeScene
+        .getBehaviorsRegistry('TestBehavior::BatchedTestBehavior')
+        .getBehaviorsCount()
+    ).to.be(3);
+
+    runtimeScene.renderAndStep();
+    expect(gdjs.BatchedTestRuntimeBehavior.batchesSizes).to.eql([3, 3]);
+    expect(getBehavior(2).preEventsStepsCount).to.be(2);
+    expect(getBehavior(2).postEventsStepsCount).to.be(2);
+  });
+
+  it('does not step the deactivated or deleted behaviors', function() {
+    getBehavior(0).activate(false);
+    objects[1].deleteFromScene(runtimeScene);
+    runtimeScene.renderAndStep();
+    expect(gdjs.BatchedTestRuntimeBehavior.batchesSizes).to.eql([3, 3, 1]);
+    expect(getBehavior(0).preEventsStepsCount).to.be(2);
+    expect(getBehavior(2).preEventsStepsCount).to.be(3);
+    expect(getBehavior(2).postEventsStepsCount).to.be(3);
+
+    // A reactivated behavior is registered again.
+    getBehavior(0).activate(true);
+    runtimeScene.renderAndStep();
+    expect(gdjs.BatchedTestRuntimeBehavior.batchesSizes).to.eql([
+      3,
+      3,
+      1,
+      2,
+    ]);
+    expect(getBehavior(0).preEventsStepsCount).to.be(3);
+  });
+});
@@ -0,0 +1,91 @@
+/**
+ * Tests for gdjs.RuntimeGame.
+ */
+describe('gdjs.RuntimeGame', function() {
+  var makeResource = function(name, kind) {
+    return { name: name, kind: kind, file: name + '.file' };
+  };
+
+  // Managers loading the resources immediately, remembering their names.
+  var fakeManagers = function(runtimeGame, loadedNames) {
+    var makeLoader = function(kind) {
+      return function(onProgress, onComplete, resources) {
+        var count = 0;
+        resources.forEach(function(resource) {
+          if (resource.kind !== kind) return;
+          loadedNames.push(resource.name);
+          onProgress(++count, resources.length);
+        });
+        onComplete(count);
+      };
+    };
+    runtimeGame._imageManager = { loadTextures: makeLoader('image') };
+    runtimeGame._soundManager = { preloadAudio: makeLoader('audio') };
+    runtimeGame._fontManager = { loadFonts: makeLoader('font') };
+  };
+
+  var makeGameData = function() {
+    return {
+      variables: [],
+      properties: { windowWidth: 800, windowHeight: 600 },
+      firstLayout: 'Scene 2',
+      resources: {
+        resources: [
+          makeResource('Image1', 'image'),
+          makeResource('Image2', 'image'),
+          makeResource('Audio1', 'audio'),
+          makeResource('Font1', 'font'),
+          makeResource('Unused', 'image'),
+        ],
+      },
+      layouts: [{ name: 'Scene 1' }, { name: 'Scene 2' }],
+    };
+  };
+
+  it('should load all the resources before starting the game', function() {
+    var runtimeGame = new gdjs.RuntimeGame(makeGameData());
+    var loadedNames = [];
+    fakeManagers(runtimeGame, loadedNames);
+
+    var loadedNamesAtStart = null;
+    runtimeGame.loadAllAssets(function() {
+      loadedNamesAtStart = loadedNames.slice();
+    });
+    expect(loadedNamesAtStart).to.eql([
+      'Image1',
+      'Image2',
+      'Unused',
+      'Audio1',
+      'Font1',
+    ]);
+  });
+
+  it('should load the resources of the first scene first', function() {
+    gdjs.projectLayoutsResources = {
+      'Scene 1': ['Image1', 'Audio1', 'Font1'],
+      'Scene 2': ['Image2', 'Audio1'],
+    };
+    var runtimeGame = new gdjs.RuntimeGame(makeGameData());
+    var loadedNames = [];
+    fakeManagers(runtimeGame, loadedNames);
+
+    var loadedNamesAtStart = null;
+    runtimeGame.loadAllAssets(function() {
+      loadedNamesAtStart = loadedNames.slice();
+    });
+
+    // The resources not used by any scene are loaded with the first scene.
+    expect(loadedNamesAtStart).to.eql(['Image2', 'Unused', 'Audio1']);
+
+    // The other resources are loaded after.
+    expect(loadedNames).to.eql([
+      'Image2',
+      'Unused',
+      'Audio1',
+      'Image1',
+      'Font1',
+    ]);
+
+    delete gdjs.projectLayoutsResources;
+  });
+});
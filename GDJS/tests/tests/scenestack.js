@@ -91,4 +91,34 @@ describe('gdjs.SceneStack', function() {
     delete gdjs.callbackAssertions;
     gdjs.registerGlobalCallbacks();
   });
+
+  it('should parse the data of scenes exported in their own file', function() {
+    gdjs.projectLayoutsData = {
+      'Lazy scene': JSON.stringify({
+        name: 'Lazy scene',
+        objects: [],
+        layers: [],
+        instances: [],
+        behaviorsSharedData: [],
+      }),
+    };
+    var lazyRuntimeGame = new gdjs.RuntimeGame({
+      variables: [],
+      properties: { windowWidth: 800, windowHeight: 600 },
+      layouts: [{ name: 'Lazy scene', lazilyLoaded: true }],
+    });
+    var lazySceneStack = new gdjs.SceneStack(lazyRuntimeGame);
+
+    expect(lazyRuntimeGame.getSceneData('Lazy scene').lazilyLoaded).to.be(
+      undefined
+    );
+    expect(lazyRuntimeGame.getSceneData('Lazy scene').instances).to.eql([]);
+    expect(gdjs.projectLayoutsData['Lazy scene']).to.be(undefined);
+
+    var scene = lazySceneStack.push('Lazy scene');
+    expect(scene.getName()).to.be('Lazy scene');
+    expect(lazySceneStack.pop()).to.be(null);
+
+    delete gdjs.projectLayoutsData;
+  });
 });
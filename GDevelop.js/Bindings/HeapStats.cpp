@@ -0,0 +1,42 @@
+#include "HeapStats.h"
+#include <malloc.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<unsigned int> allocationsCount(0);
+std::atomic<unsigned int> deletionsCount(0);
+
+void* CountedAllocation(std::size_t size) {
+  void* pointer = std::malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+
+  allocationsCount++;
+  return pointer;
+}
+
+void CountedDeletion(void* pointer) {
+  if (!pointer) return;
+
+  deletionsCount++;
+  std::free(pointer);
+}
+}  // namespace
+
+// The replacements of the global operators are used by all the C++ code of
+// the module. The nothrow versions call these ones.
+void* operator new(std::size_t size) { return CountedAllocation(size); }
+void* operator new[](std::size_t size) { return CountedAllocation(size); }
+void operator delete(void* pointer) noexcept { CountedDeletion(pointer); }
+void operator delete[](void* pointer) noexcept { CountedDeletion(pointer); }
+
+unsigned int HeapStats::GetAllocatedBytes() { return mallinfo().uordblks; }
+
+unsigned int HeapStats::GetReservedBytes() { return mallinfo().arena; }
+
+unsigned int HeapStats::GetAllocationsCount() { return allocationsCount; }
+
+unsigned int HeapStats::GetLiveAllocationsCount() {
+  return allocationsCount - deletionsCount;
+}
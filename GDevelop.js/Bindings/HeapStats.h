@@ -0,0 +1,41 @@
+#ifndef GDEVELOPJS_HEAPSTATS_H
+#define GDEVELOPJS_HEAPSTATS_H
+
+/**
+ * \brief Report the memory used by libGD.js, so that the IDE can find what
+ * makes the heap grow during long editing sessions.
+ *
+ * The allocations done with the C++ operator new are counted (see
+ * HeapStats.cpp). The objects still referenced by JavaScript wrappers are
+ * reported by gd.getHeapStats and gd.findLeakedWrappers (see postjs.js).
+ */
+class HeapStats {
+ public:
+  /**
+   * \brief Return the bytes allocated by malloc and not freed.
+   */
+  static unsigned int GetAllocatedBytes();
+
+  /**
+   * \brief Return the bytes of the heap reserved by malloc (allocated or
+   * free).
+   */
+  static unsigned int GetReservedBytes();
+
+  /**
+   * \brief Return the number of allocations done with operator new since the
+   * start of the module.
+   */
+  static unsigned int GetAllocationsCount();
+
+  /**
+   * \brief Return the number of allocations done with operator new and not
+   * deleted.
+   */
+  static unsigned int GetLiveAllocationsCount();
+
+ private:
+  HeapStats(){};
+};
+
+#endif  // GDEVELOPJS_HEAPSTATS_H
@@ -0,0 +1,138 @@
+#ifndef GDEVELOPJS_INSTANCESTRANSFORMS_H
+#define GDEVELOPJS_INSTANCESTRANSFORMS_H
+#include <vector>
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "InternedNames.h"
+
+/**
+ * \brief Store the positions, angles, Z orders and layers of all the instances
+ * of a container in packed buffers, read and modified as typed arrays from
+ * JavaScript (see getTransforms and applyTransforms in postjs.js), instead of
+ * calling the getters and setters of each instance.
+ *
+ * For each instance, in the order of the container, the float buffer contains
+ * the X, Y and angle, the int buffer the Z order and the handle of the name of
+ * the layer (see GetLayerName) and the instances buffer the address of the
+ * instance.
+ */
+class InstancesTransforms {
+ public:
+  InstancesTransforms() : version(0){};
+
+  /**
+   * \brief Store the transforms of the instances of the container, replacing
+   * the ones previously stored.
+   * \return The number of instances stored.
+   */
+  unsigned int Collect(gd::InitialInstancesContainer& instances) {
+    floats.clear();
+    ints.clear();
+    instancesAddresses.clear();
+    TransformsCollector collector(*this);
+    instances.IterateOverInstances(collector);
+
+    version++;
+    return instancesAddresses.size();
+  }
+
+  /**
+   * \brief Set the transforms stored in the buffers (possibly modified from
+   * JavaScript) to the instances they were collected from.
+   *
+   * \return false, without modifying the instances, if the number of instances
+   * of the container changed since the transforms were collected.
+   */
+  bool Apply(gd::InitialInstancesContainer& instances) {
+    if (instances.GetInstancesCount() != instancesAddresses.size())
+      return false;
+
+    for (std::size_t i = 0; i < instancesAddresses.size(); ++i) {
+      gd::InitialInstance& instance =
+          *reinterpret_cast<gd::InitialInstance*>(instancesAddresses[i]);
+      instance.SetX(floats[i * 3]);
+      instance.SetY(floats[i * 3 + 1]);
+      instance.SetAngle(floats[i * 3 + 2]);
+      instance.SetZOrder(ints[i * 2]);
+      instance.SetLayer(layerNames.GetName(ints[i * 2 + 1]));
+    }
+
+    version++;
+    return true;
+  }
+
+  /**
+   * \brief Return the handle of the name of a layer, to be stored in the int
+   * buffer.
+   */
+  unsigned int GetLayerHandle(const gd::String& layerName) {
+    return layerNames.Intern(layerName);
+  }
+
+  /**
+   * \brief Return the name of the layer having the handle.
+   */
+  const gd::String& GetLayerName(unsigned int handle) const {
+    return layerNames.GetName(handle);
+  }
+
+  /**
+   * \brief Return a number incremented each time the transforms are collected
+   * or applied, so that JavaScript can know that its views are outdated.
+   */
+  unsigned int GetVersion() const { return version; }
+
+  /**
+   * \brief Return the address of the float buffer (valid until the next call
+   * to Collect).
+   */
+  unsigned int GetFloatsAddress() const {
+    return reinterpret_cast<std::size_t>(floats.data());
+  }
+
+  /**
+   * \brief Return the address of the int buffer (valid until the next call
+   * to Collect).
+   */
+  unsigned int GetIntsAddress() const {
+    return reinterpret_cast<std::size_t>(ints.data());
+  }
+
+  /**
+   * \brief Return the address of the buffer of the addresses of the instances
+   * (valid until the next call to Collect).
+   */
+  unsigned int GetInstancesAddress() const {
+    return reinterpret_cast<std::size_t>(instancesAddresses.data());
+  }
+
+ private:
+  class TransformsCollector : public gd::InitialInstanceFunctor {
+   public:
+    TransformsCollector(InstancesTransforms& transforms_)
+        : transforms(transforms_){};
+    virtual ~TransformsCollector(){};
+
+    virtual void operator()(gd::InitialInstance& instance) {
+      transforms.floats.push_back(instance.GetX());
+      transforms.floats.push_back(instance.GetY());
+      transforms.floats.push_back(instance.GetAngle());
+      transforms.ints.push_back(instance.GetZOrder());
+      transforms.ints.push_back(
+          transforms.layerNames.Intern(instance.GetLayer()));
+      transforms.instancesAddresses.push_back(
+          reinterpret_cast<std::size_t>(&instance));
+    }
+
+   private:
+    InstancesTransforms& transforms;
+  };
+
+  std::vector<float> floats;  ///< X, Y and angle of each instance.
+  std::vector<int> ints;      ///< Z order and layer handle of each instance.
+  std::vector<unsigned int> instancesAddresses;
+  InternedNames layerNames;
+  unsigned int version;
+};
+
+#endif  // GDEVELOPJS_INSTANCESTRANSFORMS_H
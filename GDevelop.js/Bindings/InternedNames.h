@@ -0,0 +1,107 @@
+#ifndef GDEVELOPJS_INTERNEDNAMES_H
+#define GDEVELOPJS_INTERNEDNAMES_H
+#include <unordered_map>
+#include <vector>
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/ObjectsContainer.h"
+#include "GDCore/String.h"
+
+/**
+ * \brief Give a stable number, called a handle, to each name, so that names
+ * are converted to JavaScript strings only once.
+ *
+ * The Collect methods store the handles of the names of many objects or
+ * instances at once, in a buffer read as an Uint32Array from JavaScript (see
+ * getObjectNames and getInstanceObjectNames in postjs.js), instead of calling
+ * a method of each object.
+ */
+class InternedNames {
+ public:
+  InternedNames(){};
+
+  /**
+   * \brief Return the handle of the name, adding it if it's not known yet.
+   */
+  unsigned int Intern(const gd::String& name) {
+    auto it = handles.find(name);
+    if (it != handles.end()) return it->second;
+
+    names.push_back(name);
+    handles[name] = names.size() - 1;
+    return names.size() - 1;
+  }
+
+  /**
+   * \brief Return the name having the handle (an empty string if the handle
+   * is unknown).
+   */
+  const gd::String& GetName(unsigned int handle) const {
+    static const gd::String badName;
+    return handle < names.size() ? names[handle] : badName;
+  }
+
+  /**
+   * \brief Return the number of names interned, so that handles can be
+   * cached from JavaScript.
+   */
+  unsigned int GetNamesCount() const { return names.size(); }
+
+  /**
+   * \brief Store the handles of the names of the objects of the container, in
+   * their order.
+   * \return The number of handles stored.
+   */
+  unsigned int CollectObjectNames(const gd::ObjectsContainer& container) {
+    collectedHandles.clear();
+    for (std::size_t i = 0; i < container.GetObjectsCount(); ++i)
+      collectedHandles.push_back(Intern(container.GetObject(i).GetName()));
+
+    return collectedHandles.size();
+  }
+
+  /**
+   * \brief Store the handles of the names of the objects of the instances, in
+   * their order.
+   * \return The number of handles stored.
+   */
+  unsigned int CollectInstanceObjectNames(
+      gd::InitialInstancesContainer& instances) {
+    collectedHandles.clear();
+    InstanceObjectNamesCollector collector(*this);
+    instances.IterateOverInstances(collector);
+
+    return collectedHandles.size();
+  }
+
+  /**
+   * \brief Return the address of the handles stored by the last call to a
+   * Collect method (valid until the next call).
+   */
+  unsigned int GetCollectedHandlesAddress() const {
+    return reinterpret_cast<std::size_t>(collectedHandles.data());
+  }
+
+ private:
+  class InstanceObjectNamesCollector : public gd::InitialInstanceFunctor {
+   public:
+    InstanceObjectNamesCollector(InternedNames& internedNames_)
+        : internedNames(internedNames_){};
+    virtual ~InstanceObjectNamesCollector(){};
+
+    virtual void operator()(gd::InitialInstance& instance) {
+      internedNames.collectedHandles.push_back(
+          internedNames.Intern(instance.GetObjectName()));
+    }
+
+   private:
+    InternedNames& internedNames;
+  };
+
+  std::vector<gd::String> names;  ///< The names, by handle.
+  std::unordered_map<gd::String, unsigned int> handles;
+  std::vector<unsigned int> collectedHandles;
+};
+
+#endif  // GDEVELOPJS_INTERNEDNAMES_H
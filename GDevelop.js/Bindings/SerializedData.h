@@ -0,0 +1,104 @@
+#include <string>
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+
+/**
+ * \brief A buffer, in the memory of libGD.js, containing a serialized project
+ * or layout (in JSON, encoded in UTF8, or in the binary format of
+ * gd::Serializer).
+ *
+ * The data is exchanged with JavaScript as bytes (see toArrayBuffer and
+ * fromArrayBuffer in postjs.js), instead of being converted to/from a
+ * JavaScript string, which is both slow and memory hungry for a whole project.
+ */
+class SerializedData {
+ public:
+  SerializedData(){};
+
+  /**
+   * \brief Serialize the project in the buffer, in JSON or in the binary
+   * format.
+   */
+  void SerializeProject(const gd::Project& project, bool binary) {
+    gd::SerializerElement element;
+    project.SerializeTo(element);
+    SetData(element, binary);
+  }
+
+  /**
+   * \brief Serialize the layout in the buffer, in JSON or in the binary
+   * format.
+   */
+  void SerializeLayout(const gd::Layout& layout, bool binary) {
+    gd::SerializerElement element;
+    layout.SerializeTo(element);
+    SetData(element, binary);
+  }
+
+  /**
+   * \brief Unserialize the project from the buffer (the format is detected
+   * automatically).
+   *
+   * JSON is read directly with gd::Project::UnserializeFromJSON.
+   */
+  void UnserializeProject(gd::Project& project) const {
+    if (gd::Serializer::IsBinary(data))
+      project.UnserializeFrom(gd::Serializer::FromBinary(data));
+    else
+      project.UnserializeFromJSON(data);
+  }
+
+  /**
+   * \brief Unserialize the layout from the buffer (the format is detected
+   * automatically).
+   */
+  void UnserializeLayout(gd::Project& project, gd::Layout& layout) const {
+    layout.UnserializeFrom(project,
+                           gd::Serializer::IsBinary(data)
+                               ? gd::Serializer::FromBinary(data)
+                               : gd::Serializer::FromJSON(data));
+  }
+
+  /**
+   * \brief Resize the buffer to \a size bytes, so that the data to unserialize
+   * can be written in it.
+   * \return The address of the buffer.
+   */
+  unsigned int Resize(unsigned int size) {
+    data.resize(size);
+    return GetDataAddress();
+  }
+
+  /**
+   * \brief Return the address of the buffer in the memory of libGD.js (valid
+   * until the buffer is modified).
+   */
+  unsigned int GetDataAddress() const {
+    return reinterpret_cast<std::size_t>(data.data());
+  }
+
+  /**
+   * \brief Return the size of the data, in bytes.
+   */
+  unsigned int GetSize() const { return data.size(); }
+
+  /**
+   * \brief Release the memory used by the buffer.
+   */
+  void Clear() { std::string().swap(data); }
+
+ private:
+  void SetData(const gd::SerializerElement& element, bool binary) {
+    Clear();
+    if (binary) {
+      data = gd::Serializer::ToBinary(element);
+    } else {
+      gd::String json = gd::Serializer::ToJSON(element);
+      data.swap(json.Raw());
+    }
+  }
+
+  std::string data;
+};
@@ -75,7 +75,11 @@
 #include <GDJS/IDE/Exporter.h>
 
 #include <emscripten.h>
+#include "HeapStats.h"
+#include "InstancesTransforms.h"
+#include "InternedNames.h"
 #include "ProjectHelper.h"
+#include "SerializedData.h"
 
 #include "BehaviorJsImplementation.h"
 #include "BehaviorSharedDataJsImplementation.h"
@@ -299,6 +303,34 @@ class AbstractFileSystemJS : public AbstractFileSystem {
         (int)this,
         file.c_str());
   }
+  virtual bool GetFileInfo(const gd::String &file,
+                           std::uint64_t &size,
+                           std::int64_t &lastModificationTime) {
+    double fileSize = EM_ASM_DOUBLE(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          // Optional: files are compared using their contents otherwise.
+          if (!self.hasOwnProperty('getFileSize')) return -1;
+          return self.getFileSize(Pointer_stringify($1));
+        },
+        (int)this,
+        file.c_str());
+    if (fileSize < 0) return false;
+
+    double modificationTime = EM_ASM_DOUBLE(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          if (!self.hasOwnProperty('getFileModificationTime')) return -1;
+          return self.getFileModificationTime(Pointer_stringify($1));
+        },
+        (int)this,
+        file.c_str());
+    if (modificationTime < 0) return false;
+
+    size = static_cast<std::uint64_t>(fileSize);
+    lastModificationTime = static_cast<std::int64_t>(modificationTime);
+    return true;
+  }
   virtual gd::String GetTempDir() {
     return (const char *)EM_ASM_INT(
         {
@@ -369,6 +401,7 @@ typedef std::pair<gd::String, TextFormatting> PairStringTextFormatting;
 typedef std::vector<std::pair<gd::String, TextFormatting>>
     VectorPairStringTextFormatting;
 typedef std::vector<gd::ObjectGroup> VectorObjectGroup;
+typedef std::vector<gd::InitialInstance*> VectorInitialInstance;
 typedef std::map<gd::String, gd::String> MapStringString;
 typedef std::map<gd::String, bool> MapStringBoolean;
 typedef std::map<gd::String, gd::ExpressionMetadata>
@@ -544,6 +577,11 @@ typedef ExtensionAndMetadata<ExpressionMetadata> ExtensionAndExpressionMetadata;
 #define STATIC_UseOldExpressionParser UseOldExpressionParser
 #define STATIC_IsUsingOldExpressionParser IsUsingOldExpressionParser
 
+#define STATIC_GetAllocatedBytes GetAllocatedBytes
+#define STATIC_GetReservedBytes GetReservedBytes
+#define STATIC_GetAllocationsCount GetAllocationsCount
+#define STATIC_GetLiveAllocationsCount GetLiveAllocationsCount
+
 // We postfix some methods with "At" as Javascript does not support overloading
 #define GetLayoutAt GetLayout
 #define GetExternalEventsAt GetExternalEvents
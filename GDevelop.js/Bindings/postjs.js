@@ -75,6 +75,7 @@
             proto.delete = function() { gd.destroy(this) };
         }
 
+        gd._boundClassesNames = [];
         for(var gdClass in gd) {
             if (gd.hasOwnProperty(gdClass)) {
                 if (typeof gd[gdClass] !== "function") continue;
@@ -82,6 +83,7 @@
                 if (!gd[gdClass].prototype.hasOwnProperty("__class__")) continue;
 
                 adaptClassMethods(gd[gdClass]);
+                gd._boundClassesNames.push(gdClass);
             }
         }
 
@@ -153,6 +155,163 @@
             return element;
         };
 
+        // Add methods to exchange the content of gd.SerializedData with an
+        // ArrayBuffer owned by JavaScript, without converting it to a string.
+        gd.SerializedData.prototype.toArrayBuffer = function() {
+            var address = this.getDataAddress();
+            return gd.HEAPU8.slice(address, address + this.getSize()).buffer;
+        };
+
+        gd.SerializedData.prototype.fromArrayBuffer = function(arrayBuffer) {
+            var bytes = new Uint8Array(arrayBuffer);
+            var address = this.resize(bytes.length); // Can grow the memory.
+            gd.HEAPU8.set(bytes, address);
+            return this;
+        };
+
+        // Add methods to get the names of all the objects or instances of a
+        // container at once, converting each name to a string only once.
+        gd.InternedNames.prototype.getNameFromHandle = function(handle) {
+            if (!this._names) this._names = [];
+            if (this._names[handle] === undefined)
+                this._names[handle] = this.getName(handle);
+
+            return this._names[handle];
+        };
+
+        gd.InternedNames.prototype._getCollectedNames = function(count) {
+            var start = this.getCollectedHandlesAddress() >> 2;
+            var handles = gd.HEAPU32.subarray(start, start + count);
+            var names = new Array(count);
+            for (var i = 0; i < count; ++i)
+                names[i] = this.getNameFromHandle(handles[i]);
+
+            return names;
+        };
+
+        gd.InternedNames.prototype.getObjectNames = function(container) {
+            return this._getCollectedNames(this.collectObjectNames(container));
+        };
+
+        gd.InternedNames.prototype.getInstanceObjectNames = function(instances) {
+            return this._getCollectedNames(
+                this.collectInstanceObjectNames(instances));
+        };
+
+        // Add methods to read and modify the transforms of all the instances of
+        // a container as typed arrays, which are views into the memory of
+        // libGD.js (valid until the next call to collect, or until the memory
+        // grows).
+        gd.InstancesTransforms.prototype.getTransforms = function(instances) {
+            var count = this.collect(instances);
+            var floatsStart = this.getFloatsAddress() >> 2;
+            var intsStart = this.getIntsAddress() >> 2;
+            var instancesStart = this.getInstancesAddress() >> 2;
+
+            return {
+                count: count,
+                version: this.getVersion(),
+                floats: gd.HEAPF32.subarray(floatsStart, floatsStart + count * 3),
+                ints: gd.HEAP32.subarray(intsStart, intsStart + count * 2),
+                instances: gd.HEAPU32.subarray(
+                    instancesStart, instancesStart + count),
+            };
+        };
+
+        gd.InstancesTransforms.prototype.applyTransforms = function(instances) {
+            return this.apply(instances);
+        };
+
+        // Add methods to follow the memory used by libGD.js. The wrappers are
+        // the JavaScript objects created for the C++ objects (with `new` or
+        // when returned by a method): they are kept until `delete` is called.
+        gd._getLiveWrappers = function() {
+            var liveWrappers = {};
+            gd._boundClassesNames.forEach(function(className) {
+                var cache = gd.getCache(gd[className]);
+                var ptrs = Object.keys(cache);
+                if (ptrs.length) liveWrappers[className] = cache;
+            });
+
+            return liveWrappers;
+        };
+
+        gd.getHeapStats = function() {
+            var liveWrappers = gd._getLiveWrappers();
+            var liveWrappersCounts = {};
+            for (var className in liveWrappers) {
+                liveWrappersCounts[className] =
+                    Object.keys(liveWrappers[className]).length;
+            }
+
+            return {
+                heapSize: gd.HEAP8.length,
+                allocatedBytes: gd.HeapStats.getAllocatedBytes(),
+                reservedBytes: gd.HeapStats.getReservedBytes(),
+                allocationsCount: gd.HeapStats.getAllocationsCount(),
+                liveAllocationsCount: gd.HeapStats.getLiveAllocationsCount(),
+                liveWrappersCounts: liveWrappersCounts,
+            };
+        };
+
+        // Remember the current stats and wrappers, to be compared later with
+        // getHeapStatsSince and findLeakedWrappers.
+        gd.createHeapCheckpoint = function() {
+            var checkpoint = gd.getHeapStats();
+            var liveWrappers = gd._getLiveWrappers();
+            checkpoint.wrappers = {};
+            for (var className in liveWrappers) {
+                checkpoint.wrappers[className] =
+                    Object.assign({}, liveWrappers[className]);
+            }
+
+            return checkpoint;
+        };
+
+        gd.getHeapStatsSince = function(checkpoint) {
+            var stats = gd.getHeapStats();
+            var liveWrappersCounts = {};
+            gd._boundClassesNames.forEach(function(className) {
+                var difference =
+                    (stats.liveWrappersCounts[className] || 0) -
+                    (checkpoint.liveWrappersCounts[className] || 0);
+                if (difference) liveWrappersCounts[className] = difference;
+            });
+
+            return {
+                heapSize: stats.heapSize,
+                allocatedBytes: stats.allocatedBytes - checkpoint.allocatedBytes,
+                allocationsCount:
+                    stats.allocationsCount - checkpoint.allocationsCount,
+                liveAllocationsCount:
+                    stats.liveAllocationsCount - checkpoint.liveAllocationsCount,
+                liveWrappersCounts: liveWrappersCounts,
+            };
+        };
+
+        // Return the wrappers created since the checkpoint and not deleted,
+        // with the address of the C++ object that each one keeps alive (or
+        // that can be dangling, if the object was destroyed by its owner).
+        gd.findLeakedWrappers = function(checkpoint) {
+            var leakedWrappers = [];
+            var liveWrappers = gd._getLiveWrappers();
+            for (var className in liveWrappers) {
+                var cache = liveWrappers[className];
+                var previousCache = checkpoint.wrappers[className] || {};
+                for (var ptr in cache) {
+                    if (previousCache[ptr] === cache[ptr]) continue;
+
+                    leakedWrappers.push({
+                        className: className,
+                        ptr: Number(ptr),
+                        wrapper: cache[ptr],
+                    });
+                }
+            }
+
+            return leakedWrappers;
+        };
+
         //Preserve backward compatibility with some alias for methods:
         gd.VectorString.prototype.get = gd.VectorString.prototype.at;
         gd.VectorPlatformExtension.prototype.get = gd.VectorPlatformExtension.prototype.at;
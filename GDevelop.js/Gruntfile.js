@@ -5,6 +5,10 @@ module.exports = function(grunt) {
     emscriptenPath + '/cmake/Modules/Platform/Emscripten.cmake';
   var buildOutputPath = '../Binaries/Output/libGD.js/Release/';
   var buildPath = '../Binaries/embuild';
+  // The variant with WebAssembly SIMD and threads, used by the IDE when
+  // SharedArrayBuffer is available (see newIDE/app/public/index.html).
+  var threadsBuildOutputPath = '../Binaries/Output/libGD.js/Release-threads/';
+  var threadsBuildPath = '../Binaries/embuild-threads';
 
   var isWin = /^win/.test(process.platform);
   var cmakeBinary = isWin
@@ -55,6 +59,15 @@ module.exports = function(grunt) {
         ],
         dest: buildOutputPath + 'libGD.js',
       },
+      threads: {
+        src: [
+          'Bindings/prejs.js',
+          threadsBuildOutputPath + 'libGD.raw.js',
+          'Bindings/glue.js',
+          'Bindings/postjs.js',
+        ],
+        dest: threadsBuildOutputPath + 'libGD.js',
+      },
     },
     mkdir: {
       embuild: {
@@ -62,6 +75,11 @@ module.exports = function(grunt) {
           create: [buildPath],
         },
       },
+      'embuild-threads': {
+        options: {
+          create: [threadsBuildPath],
+        },
+      },
     },
     shell: {
       //Launch CMake if needed
@@ -80,6 +98,21 @@ module.exports = function(grunt) {
           },
         },
       },
+      'cmake-threads': {
+        src: [threadsBuildPath + '/CMakeCache.txt', 'CMakeLists.txt'],
+        command:
+          cmakeBinary +
+          ' ' +
+          cmakeArgs +
+          ' ../.. -DFULL_VERSION_NUMBER=FALSE -DEMSCRIPTEN_THREADS=TRUE',
+        options: {
+          execOptions: {
+            cwd: threadsBuildPath,
+            env: process.env,
+            maxBuffer: Infinity,
+          },
+        },
+      },
       //Generate glue.cpp and glue.js file using Bindings.idl, and patch them
       updateGDBindings: {
         src: 'Bindings/Bindings.idl',
@@ -95,6 +128,15 @@ module.exports = function(grunt) {
           },
         },
       },
+      'make-threads': {
+        command: makeBinary + ' -j 4',
+        options: {
+          execOptions: {
+            cwd: threadsBuildPath,
+            env: process.env,
+          },
+        },
+      },
     },
     uglify: {
       build: {
@@ -138,6 +180,19 @@ module.exports = function(grunt) {
           },
         ],
       },
+      'newIDE-threads': {
+        files: [
+          {
+            src: [threadsBuildOutputPath + 'libGD.js'],
+            dest: '../newIDE/app/public/libGD-threads.js',
+          },
+          {
+            // Script of the workers running the threads.
+            src: [threadsBuildOutputPath + 'libGD.raw.worker.js'],
+            dest: '../newIDE/app/public/libGD.raw.worker.js',
+          },
+        ],
+      },
     },
   });
 
@@ -163,6 +218,14 @@ module.exports = function(grunt) {
     'compress',
     'copy:newIDE',
   ]);
+  grunt.registerTask('build:threads', [
+    'mkdir:embuild-threads',
+    'newer:shell:cmake-threads',
+    'newer:shell:updateGDBindings',
+    'shell:make-threads',
+    'concat:threads',
+    'copy:newIDE-threads',
+  ]);
   grunt.registerTask('build:with-profiler', [
     'build:raw',
     'concat:with-profiler',
@@ -344,12 +344,117 @@ describe('libGD.js', function() {
       expect(container.serializeTo).not.toBe(undefined);
       expect(container.unserializeFrom).not.toBe(undefined);
     });
+    it('can move, duplicate and remove several instances', function() {
+      const otherContainer = new gd.InitialInstancesContainer();
+      for (let i = 0; i < 10; i++) {
+        const instance = otherContainer.insertNewInitialInstance();
+        instance.setX(i * 10);
+        instance.setY(i * 10);
+      }
+
+      const instances = otherContainer.getInstancesInRect('', 15, 15, 50, 50);
+      expect(instances.size()).toBe(3);
+      expect(instances.at(0).getX()).toBe(20);
+
+      otherContainer.moveInstances(instances, 100, 0);
+      expect(instances.at(0).getX()).toBe(120);
+
+      const newInstances = otherContainer.duplicateInstances(instances, 0, 5);
+      expect(otherContainer.getInstancesCount()).toBe(13);
+      expect(newInstances.at(2).getX()).toBe(140);
+      expect(newInstances.at(2).getY()).toBe(45);
+
+      otherContainer.removeInstances(instances);
+      expect(otherContainer.getInstancesCount()).toBe(10);
+
+      newInstances.delete();
+      instances.delete();
+      otherContainer.delete();
+    });
 
     afterAll(function() {
       container.delete();
     });
   });
 
+  describe('gd.InternedNames', function() {
+    it('gives the same handle to the same name', function() {
+      const internedNames = new gd.InternedNames();
+      const handle = internedNames.intern('MyObject');
+      expect(internedNames.intern('MyOtherObject')).not.toBe(handle);
+      expect(internedNames.intern('MyObject')).toBe(handle);
+      expect(internedNames.getNamesCount()).toBe(2);
+      expect(internedNames.getName(handle)).toBe('MyObject');
+      expect(internedNames.getNameFromHandle(handle)).toBe('MyObject');
+      internedNames.delete();
+    });
+    it('gets the names of the objects and of the instances', function() {
+      const project = gd.ProjectHelper.createNewGDJSProject();
+      const layout = project.insertNewLayout('Scene', 0);
+      layout.insertNewObject(project, 'Sprite', 'MyObject', 0);
+      layout.insertNewObject(project, 'Sprite', 'MyOtherObject', 1);
+      const instances = layout.getInitialInstances();
+      instances.insertNewInitialInstance().setObjectName('MyOtherObject');
+      instances.insertNewInitialInstance().setObjectName('MyObject');
+      instances.insertNewInitialInstance().setObjectName('MyOtherObject');
+
+      const internedNames = new gd.InternedNames();
+      expect(internedNames.getObjectNames(layout)).toEqual([
+        'MyObject',
+        'MyOtherObject',
+      ]);
+      expect(internedNames.getInstanceObjectNames(instances)).toEqual([
+        'MyOtherObject',
+        'MyObject',
+        'MyOtherObject',
+      ]);
+      expect(internedNames.getNamesCount()).toBe(2);
+
+      internedNames.delete();
+      project.delete();
+    });
+  });
+
+  describe('gd.InstancesTransforms', function() {
+    it('reads and modifies the transforms of the instances', function() {
+      const instances = new gd.InitialInstancesContainer();
+      const instance1 = instances.insertNewInitialInstance();
+      instance1.setX(10);
+      instance1.setY(20);
+      instance1.setAngle(45);
+      instance1.setZOrder(3);
+      instance1.setLayer('Layer');
+      const instance2 = instances.insertNewInitialInstance();
+      instance2.setX(-5);
+
+      const instancesTransforms = new gd.InstancesTransforms();
+      const transforms = instancesTransforms.getTransforms(instances);
+      expect(transforms.count).toBe(2);
+      expect(Array.from(transforms.floats)).toEqual([10, 20, 45, -5, 0, 0]);
+      expect(transforms.ints[0]).toBe(3);
+      expect(instancesTransforms.getLayerName(transforms.ints[1])).toBe(
+        'Layer'
+      );
+      expect(transforms.instances[0]).toBe(instance1.ptr);
+      expect(transforms.instances[1]).toBe(instance2.ptr);
+
+      transforms.floats[3] = 100;
+      transforms.ints[2] = 7;
+      transforms.ints[3] = instancesTransforms.getLayerHandle('Layer');
+      expect(instancesTransforms.applyTransforms(instances)).toBe(true);
+      expect(instance2.getX()).toBe(100);
+      expect(instance2.getZOrder()).toBe(7);
+      expect(instance2.getLayer()).toBe('Layer');
+      expect(instancesTransforms.getVersion()).toBe(transforms.version + 1);
+
+      instances.insertNewInitialInstance();
+      expect(instancesTransforms.applyTransforms(instances)).toBe(false);
+
+      instancesTransforms.delete();
+      instances.delete();
+    });
+  });
+
   describe('gd.InitialInstance', function() {
     let project = null;
     let layout = null;
@@ -2061,16 +2166,92 @@ describe('libGD.js', function() {
       fs.dirNameFrom = function(fullpath) {
         return path.dirname(fullpath);
       };
+      fs.fileExists = function(path) {
+        return false;
+      };
+      fs.readFile = function(path) {
+        return '';
+      };
       fs.writeToFile = function(path, content) {
         //Validate that some code have been generated:
-        expect(content).toMatch('runtimeScene.getOnceTriggers().startNewFrame');
-        done();
+        if (path.endsWith('code0.js')) {
+          expect(content).toMatch(
+            'runtimeScene.getOnceTriggers().startNewFrame'
+          );
+          done();
+        }
       };
 
       var exporter = new gd.Exporter(fs);
       exporter.exportLayoutForPixiPreview(project, layout, '/path/for/export/');
       exporter.delete();
     });
+
+    it('should export only the code of the changed layouts to update a preview', function() {
+      var fs = new gd.AbstractFileSystemJS();
+      var project = new gd.ProjectHelper.createNewGDJSProject();
+      project.insertNewLayout('Scene', 0);
+      var layout2 = project.insertNewLayout('Scene2', 1);
+
+      var files = {};
+      fs.mkDir = fs.clearDir = function() {};
+      fs.dirExists = function() {
+        return true;
+      };
+      fs.getTempDir = function(path) {
+        return '/tmp';
+      };
+      fs.fileNameFrom = function(fullpath) {
+        return path.basename(fullpath);
+      };
+      fs.dirNameFrom = function(fullpath) {
+        return path.dirname(fullpath);
+      };
+      fs.isAbsolute = function(fullpath) {
+        return path.isAbsolute(fullpath);
+      };
+      fs.makeRelative = function(fullpath, baseDirectory) {
+        return path.relative(baseDirectory, fullpath);
+      };
+      fs.fileExists = function(path) {
+        return files.hasOwnProperty(path);
+      };
+      fs.readFile = function(path) {
+        return files[path] || '';
+      };
+      fs.writeToFile = function(path, content) {
+        files[path] = content;
+        return true;
+      };
+      fs.copyFile = function(source, destination) {
+        if (!files.hasOwnProperty(source)) return false;
+        files[destination] = files[source];
+        return true;
+      };
+
+      var exporter = new gd.Exporter(fs);
+      expect(
+        exporter.exportLayoutForPixiPreview(project, layout2, '/preview')
+      ).toBe(true);
+
+      layout2
+        .getEvents()
+        .insertNewEvent(project, 'BuiltinCommonInstructions::Standard', 0);
+      var changedCodeFiles = new gd.VectorString();
+      expect(
+        exporter.exportLayoutChangesForPixiPreview(
+          project,
+          '/preview',
+          changedCodeFiles
+        )
+      ).toBe(true);
+      expect(changedCodeFiles.size()).toBe(1);
+      expect(changedCodeFiles.at(0)).toBe('code1.js');
+
+      changedCodeFiles.delete();
+      exporter.delete();
+      project.delete();
+    });
   });
 
   describe('gd.EventsRemover', function() {
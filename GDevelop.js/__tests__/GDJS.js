@@ -37,6 +37,90 @@ describe('libGD.js - GDJS related tests', function() {
       condition.delete();
     });
 
+    it('can generate code for a layout with instances lists resolved once per frame', function() {
+      const project = gd.ProjectHelper.createNewGDJSProject();
+      const layout = project.insertNewLayout('Scene', 0);
+      layout.insertNewObject(project, 'Sprite', 'MyObject', 0);
+
+      // Create an event with an action to update a variable of MyObject
+      const evt = layout
+        .getEvents()
+        .insertNewEvent(project, 'BuiltinCommonInstructions::Standard', 0);
+      const action = new gd.Instruction();
+      action.setType('ModVarObjet');
+      action.setParametersCount(4);
+      action.setParameter(0, 'MyObject');
+      action.setParameter(1, 'ObjectVariable');
+      action.setParameter(2, '+');
+      action.setParameter(3, '42');
+      gd.asStandardEvent(evt)
+        .getActions()
+        .insert(action, 0);
+
+      const runtimeCode = gd.EventsCodeGenerator.generateSceneEventsCompleteCode(
+        project,
+        layout,
+        layout.getEvents(),
+        new gd.SetString(),
+        true
+      );
+
+      // The instances are fetched at the beginning of the frame...
+      expect(runtimeCode).toMatch(
+        'GDMyObjectObjectsInstances = runtimeScene.getObjects("MyObject");'
+      );
+      // ...and the array is then used directly by the events.
+      expect(runtimeCode).toMatch(
+        'GDMyObjectObjects1.createFrom(gdjs.SceneCode.GDMyObjectObjectsInstances);'
+      );
+
+      const previewCode = gd.EventsCodeGenerator.generateSceneEventsCompleteCode(
+        project,
+        layout,
+        layout.getEvents(),
+        new gd.SetString(),
+        false
+      );
+      expect(previewCode).not.toMatch('GDMyObjectObjectsInstances');
+      expect(previewCode).toMatch(
+        'GDMyObjectObjects1.createFrom(runtimeScene.getObjects("MyObject"));'
+      );
+
+      action.delete();
+    });
+
+    it('can generate code measuring the time spent in each event for previews', function() {
+      const project = gd.ProjectHelper.createNewGDJSProject();
+      const layout = project.insertNewLayout('Scene', 0);
+      layout
+        .getEvents()
+        .insertNewEvent(project, 'BuiltinCommonInstructions::Standard', 0);
+      layout
+        .getEvents()
+        .insertNewEvent(project, 'BuiltinCommonInstructions::Standard', 1);
+
+      const previewCode = gd.EventsCodeGenerator.generateSceneEventsCompleteCode(
+        project,
+        layout,
+        layout.getEvents(),
+        new gd.SetString(),
+        false
+      );
+      expect(previewCode).toMatch(
+        'runtimeScene.getProfiler().begin("Event #1");'
+      );
+      expect(previewCode).toMatch('runtimeScene.getProfiler().end("Event #2");');
+
+      const runtimeCode = gd.EventsCodeGenerator.generateSceneEventsCompleteCode(
+        project,
+        layout,
+        layout.getEvents(),
+        new gd.SetString(),
+        true
+      );
+      expect(runtimeCode).not.toMatch('getProfiler');
+    });
+
     it('can generate code for a layout with generateEventsFunctionCode', function() {
       const project = new gd.ProjectHelper.createNewGDJSProject();
 
@@ -82,6 +82,72 @@ describe('libGD.js object serialization', function() {
     });
   });
 
+  describe('gd.SerializedData', function() {
+    const makeProject = () => {
+      const project = gd.ProjectHelper.createNewGDJSProject();
+      project.setName('My project');
+      const layout = project.insertNewLayout('Scene', 0);
+      layout.insertNewObject(project, 'Sprite', 'MyObject', 0);
+      const instance = layout.getInitialInstances().insertNewInitialInstance();
+      instance.setObjectName('MyObject');
+      instance.setX(42);
+      return project;
+    };
+
+    it('should serialize a project to JSON in an ArrayBuffer', function() {
+      const project = makeProject();
+      const serializedData = new gd.SerializedData();
+      serializedData.serializeProject(project, false);
+      const arrayBuffer = serializedData.toArrayBuffer();
+      serializedData.delete();
+
+      const element = new gd.SerializerElement();
+      project.serializeTo(element);
+      const json = gd.Serializer.toJSON(element);
+      element.delete();
+      project.delete();
+
+      expect(arrayBuffer.byteLength).toBe(Buffer.byteLength(json));
+      expect(Buffer.from(arrayBuffer).toString('utf8')).toBe(json);
+    });
+
+    [false, true].forEach(binary => {
+      it(
+        'should unserialize a project and a layout from an ArrayBuffer' +
+          (binary ? ' (binary)' : ' (JSON)'),
+        function() {
+          const project = makeProject();
+          const serializedData = new gd.SerializedData();
+          serializedData.serializeProject(project, binary);
+          const projectBuffer = serializedData.toArrayBuffer();
+          serializedData.serializeLayout(project.getLayout('Scene'), binary);
+          const layoutBuffer = serializedData.toArrayBuffer();
+          project.delete();
+
+          const newProject = gd.ProjectHelper.createNewGDJSProject();
+          serializedData.fromArrayBuffer(projectBuffer);
+          serializedData.unserializeProject(newProject);
+          expect(newProject.getName()).toBe('My project');
+          const instances = newProject.getLayout('Scene').getInitialInstances();
+          expect(instances.getInstancesCount()).toBe(1);
+
+          const newLayout = new gd.Layout();
+          serializedData.fromArrayBuffer(layoutBuffer);
+          serializedData.unserializeLayout(newProject, newLayout);
+          expect(newLayout.getName()).toBe('Scene');
+          expect(newLayout.hasObjectNamed('MyObject')).toBe(true);
+          expect(newLayout.getInitialInstances().getInstancesCount()).toBe(1);
+
+          serializedData.clear();
+          expect(serializedData.getSize()).toBe(0);
+          serializedData.delete();
+          newLayout.delete();
+          newProject.delete();
+        }
+      );
+    });
+  });
+
   describe('gd.Serializer.fromJSObject', function() {
     it('should unserialize and reserialize JSON', function() {
       var json =
@@ -20,4 +20,31 @@ describe('libGD.js - stress tests', function() {
       layout.delete();
     }
   });
+  it('should report the objects still alive after being deleted', function() {
+    var gd = initGDevelopJS();
+    var checkpoint = gd.createHeapCheckpoint();
+    var newLayout = new gd.Layout();
+    for (var i = 0; i < 10; ++i) {
+      var project = gd.ProjectHelper.createNewGDJSProject();
+      project.insertNewLayout('Scene', 0);
+      project.delete();
+    }
+
+    // The wrappers of the layouts returned by insertNewLayout are still
+    // alive (but their C++ objects were destroyed with the projects).
+    var stats = gd.getHeapStatsSince(checkpoint);
+    expect(stats.allocationsCount).toBeGreaterThan(0);
+    expect(stats.liveWrappersCounts.Project).toBe(undefined);
+    expect(stats.liveWrappersCounts.Layout).toBeGreaterThan(1);
+
+    var isLayout = leak => leak.className === 'Layout';
+    var leakedLayouts = gd.findLeakedWrappers(checkpoint).filter(isLayout);
+    expect(leakedLayouts.length).toBe(stats.liveWrappersCounts.Layout);
+    expect(leakedLayouts.some(leak => leak.wrapper === newLayout)).toBe(true);
+
+    newLayout.delete();
+    expect(gd.findLeakedWrappers(checkpoint).filter(isLayout).length).toBe(
+      leakedLayouts.length - 1
+    );
+  });
 });
@@ -24,6 +24,7 @@ declare type gdExternalEvents = gdEmscriptenObject;
 declare type gdSerializerElement = gdEmscriptenObject;
 declare type gdInitialInstance = gdEmscriptenObject;
 declare type gdInitialInstancesContainer = gdEmscriptenObject;
+declare type gdVectorInitialInstance = gdEmscriptenObject;
 declare type gdBaseEvent = gdEmscriptenObject;
 declare type gdResource = gdEmscriptenObject;
 declare type gdResourcesManager = gdEmscriptenObject;
@@ -21,7 +21,7 @@ import Flash from 'material-ui/svg-icons/image/flash-on';
 import FlashOff from 'material-ui/svg-icons/image/flash-off';
 import HelpButton from '../UI/HelpButton';
 import Profiler from './Profiler';
-import { type ProfilerOutput } from '.';
+import { type ProfilerOutput, type ProfilerLiveOutput } from '.';
 
 type Props = {|
   gameData: ?any,
@@ -34,6 +34,10 @@ type Props = {|
   onStopProfiler: () => void,
   profilerOutput: ?ProfilerOutput,
   profilingInProgress: boolean,
+  onStartProfilerStream: () => void,
+  onStopProfilerStream: () => void,
+  profilerLiveOutput: ?ProfilerLiveOutput,
+  profilerStreamInProgress: boolean,
 |};
 
 type State = {|
@@ -69,6 +73,10 @@ export default class DebuggerContent extends React.Component<Props, State> {
       onStopProfiler,
       profilerOutput,
       profilingInProgress,
+      onStartProfilerStream,
+      onStopProfilerStream,
+      profilerLiveOutput,
+      profilerStreamInProgress,
     } = this.props;
     const {
       selectedInspector,
@@ -178,12 +186,18 @@ export default class DebuggerContent extends React.Component<Props, State> {
               // Pass profilerOutput to force MosaicWindow update when profilerOutput is changed
               profilerOutput={profilerOutput}
               profilingInProgress={profilingInProgress}
+              profilerLiveOutput={profilerLiveOutput}
+              profilerStreamInProgress={profilerStreamInProgress}
             >
               <Profiler
                 onStart={onStartProfiler}
                 onStop={onStopProfiler}
                 profilerOutput={profilerOutput}
                 profilingInProgress={profilingInProgress}
+                onStartStream={onStartProfilerStream}
+                onStopStream={onStopProfilerStream}
+                profilerLiveOutput={profilerLiveOutput}
+                profilerStreamInProgress={profilerStreamInProgress}
               />
             </MosaicWindow>
           ),
@@ -0,0 +1,128 @@
+// @flow
+import * as React from 'react';
+import { type ProfilerMeasuresSection, type ProfilerFrame } from '..';
+
+const styles = {
+  container: {
+    display: 'flex',
+    padding: 8,
+    overflowY: 'auto',
+  },
+  section: {
+    display: 'flex',
+    flexDirection: 'column',
+    minWidth: 0,
+  },
+  label: {
+    height: 20,
+    lineHeight: '20px',
+    fontSize: 12,
+    padding: '0 4px',
+    overflow: 'hidden',
+    whiteSpace: 'nowrap',
+    textOverflow: 'ellipsis',
+    color: '#000',
+    borderRight: '1px solid #fff',
+    borderBottom: '1px solid #fff',
+  },
+  subsections: {
+    display: 'flex',
+  },
+};
+
+/**
+ * Compute the average time of each section of the frames.
+ */
+export const getAverageMeasures = (
+  frames: Array<ProfilerFrame>
+): ProfilerMeasuresSection => {
+  const averageMeasures = { time: 0, subsections: {} };
+  const addSection = (
+    section: ProfilerMeasuresSection,
+    destinationSection: ProfilerMeasuresSection
+  ) => {
+    destinationSection.time += section.time / frames.length;
+    Object.keys(section.subsections).forEach(sectionName => {
+      const destinationSubsection = (destinationSection.subsections[
+        sectionName
+      ] = destinationSection.subsections[sectionName] || {
+        time: 0,
+        subsections: {},
+      });
+      addSection(section.subsections[sectionName], destinationSubsection);
+    });
+  };
+
+  frames.forEach(frame => addSection(frame.measures, averageMeasures));
+  return averageMeasures;
+};
+
+// Give a stable color to each section, whatever its position in the graph.
+const getSectionColor = (name: string) => {
+  let hash = 0;
+  for (let i = 0; i < name.length; ++i) {
+    hash = (hash * 31 + name.charCodeAt(i)) % 360;
+  }
+  return `hsl(${hash}, 70%, 70%)`;
+};
+
+type SectionProps = {|
+  name: string,
+  section: ProfilerMeasuresSection,
+  widthPercent: number,
+|};
+
+const FlameGraphSection = ({ name, section, widthPercent }: SectionProps) => {
+  const subsectionsNames = Object.keys(section.subsections);
+  return (
+    <div style={{ ...styles.section, width: `${widthPercent}%` }}>
+      <div
+        style={{ ...styles.label, backgroundColor: getSectionColor(name) }}
+        title={`${name}: ${section.time.toFixed(2)}ms`}
+      >
+        {name}
+      </div>
+      <div style={styles.subsections}>
+        {subsectionsNames.map(subsectionName => {
+          const subsection = section.subsections[subsectionName];
+          return (
+            <FlameGraphSection
+              key={subsectionName}
+              name={subsectionName}
+              section={subsection}
+              widthPercent={
+                section.time ? (subsection.time / section.time) * 100 : 0
+              }
+            />
+          );
+        })}
+      </div>
+    </div>
+  );
+};
+
+type Props = {|
+  frames: Array<ProfilerFrame>,
+|};
+
+/**
+ * Display the average time of the sections of the last frames received from
+ * a game: each section is drawn above its subsections, with a width
+ * proportional to its time.
+ */
+export default class FlameGraph extends React.Component<Props, void> {
+  render() {
+    const { frames } = this.props;
+    if (!frames.length) return null;
+
+    return (
+      <div style={styles.container}>
+        <FlameGraphSection
+          name="Frame"
+          section={getAverageMeasures(frames)}
+          widthPercent={100}
+        />
+      </div>
+    );
+  }
+}
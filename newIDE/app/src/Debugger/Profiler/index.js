@@ -4,7 +4,8 @@ import { Trans } from '@lingui/macro';
 import * as React from 'react';
 import RaisedButton from 'material-ui/RaisedButton/RaisedButton';
 import MeasuresTable from './MeasuresTable';
-import { type ProfilerOutput } from '..';
+import FlameGraph from './FlameGraph';
+import { type ProfilerOutput, type ProfilerLiveOutput } from '..';
 import EmptyMessage from '../../UI/EmptyMessage';
 import { Line } from '../../UI/Grid';
 import Background from '../../UI/Background';
@@ -21,11 +22,65 @@ type Props = {|
   onStop: () => void,
   profilerOutput: ?ProfilerOutput,
   profilingInProgress: boolean,
+  onStartStream: () => void,
+  onStopStream: () => void,
+  profilerLiveOutput: ?ProfilerLiveOutput,
+  profilerStreamInProgress: boolean,
 |};
 
 export default class Profiler extends React.Component<Props, void> {
+  _renderLiveStats(profilerLiveOutput: ProfilerLiveOutput) {
+    const { stats } = profilerLiveOutput;
+    const { memory } = stats;
+    const lastFrame =
+      profilerLiveOutput.frames[profilerLiveOutput.frames.length - 1];
+    return (
+      <Line alignItems="center" justifyContent="center">
+        <p>
+          <Trans>
+            Average of the last {profilerLiveOutput.frames.length} frames
+            received (last frame: {lastFrame.measures.time.toFixed(2)}ms).
+          </Trans>{' '}
+          {stats.objectsCount !== undefined && (
+            <Trans>{stats.objectsCount} objects.</Trans>
+          )}{' '}
+          {typeof stats.usedJSHeapSize === 'number' && (
+            <Trans>
+              {(stats.usedJSHeapSize / 1024 / 1024).toFixed(1)} MB of memory
+              used.
+            </Trans>
+          )}
+        </p>
+        {memory && (
+          <p>
+            {Object.keys(memory).map(categoryName => {
+              const { used, highWaterMark } = memory[categoryName];
+              return (
+                <span key={categoryName}>
+                  {categoryName}: {(used / 1024).toFixed(0)}KB (max:{' '}
+                  {(highWaterMark / 1024).toFixed(0)}KB).{' '}
+                </span>
+              );
+            })}
+          </p>
+        )}
+      </Line>
+    );
+  }
+
   render() {
-    const { onStart, onStop, profilerOutput, profilingInProgress } = this.props;
+    const {
+      onStart,
+      onStop,
+      profilerOutput,
+      profilingInProgress,
+      onStartStream,
+      onStopStream,
+      profilerLiveOutput,
+      profilerStreamInProgress,
+    } = this.props;
+    const hasLiveFrames =
+      !!profilerLiveOutput && profilerLiveOutput.frames.length > 0;
 
     return (
       <Background>
@@ -52,7 +107,25 @@ export default class Profiler extends React.Component<Props, void> {
               onClick={onStop}
             />
           )}
+          {!profilerStreamInProgress && (
+            <RaisedButton
+              label={<Trans>Start live profiling</Trans>}
+              onClick={onStartStream}
+            />
+          )}
+          {profilerStreamInProgress && (
+            <RaisedButton
+              label={<Trans>Stop live profiling</Trans>}
+              onClick={onStopStream}
+            />
+          )}
         </Line>
+        {profilerLiveOutput &&
+          hasLiveFrames &&
+          this._renderLiveStats(profilerLiveOutput)}
+        {profilerLiveOutput && hasLiveFrames && (
+          <FlameGraph frames={profilerLiveOutput.frames} />
+        )}
         {profilingInProgress && (
           <Line alignItems="center">
             <LinearProgress style={{ flex: 1 }} mode={'indeterminate'} />
@@ -64,7 +137,7 @@ export default class Profiler extends React.Component<Props, void> {
               profilerMeasures={profilerOutput.framesAverageMeasures}
             />
           )}
-          {!profilerOutput && (
+          {!profilerOutput && !hasLiveFrames && (
             <EmptyMessage>
               <Trans>
                 Start profiling and then stop it after a few seconds to see the
@@ -29,6 +29,24 @@ export type ProfilerOutput = {|
   },
 |};
 
+export type ProfilerFrame = {|
+  frame: number,
+  measures: ProfilerMeasuresSection,
+|};
+
+export type ProfilerLiveOutput = {|
+  frames: Array<ProfilerFrame>,
+  stats: {
+    objectsCount?: number,
+    usedJSHeapSize?: ?number,
+    scratchArenaCapacity?: number,
+    memory?: { [string]: {| used: number, highWaterMark: number |} },
+  },
+|};
+
+// The number of frames kept to display the live profiler.
+const maxProfilerLiveFramesCount = 120;
+
 type Props = {|
   project: gdProject,
   setToolbar: React.Node => void,
@@ -43,6 +61,8 @@ type State = {|
   debuggerGameData: { [DebuggerId]: any },
   profilerOutputs: { [DebuggerId]: ProfilerOutput },
   profilingInProgress: { [DebuggerId]: boolean },
+  profilerLiveOutputs: { [DebuggerId]: ProfilerLiveOutput },
+  profilerStreamInProgress: { [DebuggerId]: boolean },
   selectedId: DebuggerId,
 |};
 
@@ -58,6 +78,8 @@ export default class Debugger extends React.Component<Props, State> {
     debuggerGameData: {},
     profilerOutputs: {},
     profilingInProgress: {},
+    profilerLiveOutputs: {},
+    profilerStreamInProgress: {},
     selectedId: 0,
   };
 
@@ -200,6 +222,37 @@ export default class Debugger extends React.Component<Props, State> {
       this.setState(state => ({
         profilingInProgress: { ...state.profilingInProgress, [id]: false },
       }));
+    } else if (data.command === 'profiler.frames') {
+      this.setState(state => {
+        const liveOutput = state.profilerLiveOutputs[id];
+        const frames = (liveOutput ? liveOutput.frames : [])
+          .concat(data.payload.frames)
+          .slice(-maxProfilerLiveFramesCount);
+        return {
+          profilerLiveOutputs: {
+            ...state.profilerLiveOutputs,
+            [id]: { frames, stats: data.payload.stats },
+          },
+        };
+      });
+    } else if (data.command === 'profiler.stream.started') {
+      this.setState(state => ({
+        profilerStreamInProgress: {
+          ...state.profilerStreamInProgress,
+          [id]: true,
+        },
+        profilerLiveOutputs: {
+          ...state.profilerLiveOutputs,
+          [id]: { frames: [], stats: {} },
+        },
+      }));
+    } else if (data.command === 'profiler.stream.stopped') {
+      this.setState(state => ({
+        profilerStreamInProgress: {
+          ...state.profilerStreamInProgress,
+          [id]: false,
+        },
+      }));
     } else {
       console.warn(
         'Unknown command received from debugger client:',
@@ -285,6 +338,27 @@ export default class Debugger extends React.Component<Props, State> {
     });
   };
 
+  _startProfilerStream = (id: DebuggerId) => {
+    if (!ipcRenderer) return;
+
+    ipcRenderer.send('debugger-send-message', {
+      id,
+      message: JSON.stringify({
+        command: 'profiler.stream.start',
+        payload: { interval: 250, samplingRate: 1 },
+      }),
+    });
+  };
+
+  _stopProfilerStream = (id: DebuggerId) => {
+    if (!ipcRenderer) return;
+
+    ipcRenderer.send('debugger-send-message', {
+      id,
+      message: '{"command": "profiler.stream.stop"}',
+    });
+  };
+
   _hasSelectedDebugger = () => {
     const { selectedId, debuggerIds } = this.state;
     return debuggerIds.indexOf(selectedId) !== -1;
@@ -299,6 +373,8 @@ export default class Debugger extends React.Component<Props, State> {
       debuggerGameData,
       profilerOutputs,
       profilingInProgress,
+      profilerLiveOutputs,
+      profilerStreamInProgress,
     } = this.state;
 
     return (
@@ -347,6 +423,14 @@ export default class Debugger extends React.Component<Props, State> {
                 onStopProfiler={() => this._stopProfiler(selectedId)}
                 profilerOutput={profilerOutputs[selectedId]}
                 profilingInProgress={profilingInProgress[selectedId]}
+                onStartProfilerStream={() =>
+                  this._startProfilerStream(selectedId)
+                }
+                onStopProfilerStream={() =>
+                  this._stopProfilerStream(selectedId)
+                }
+                profilerLiveOutput={profilerLiveOutputs[selectedId]}
+                profilerStreamInProgress={profilerStreamInProgress[selectedId]}
               />
             )}
             {!this._hasSelectedDebugger() && (
@@ -152,6 +152,22 @@ export default {
       return false;
     }
   },
+  getFileSize: function(filename) {
+    filename = this._translateURL(filename);
+    try {
+      return fs.statSync(filename).size;
+    } catch (e) {
+      return -1;
+    }
+  },
+  getFileModificationTime: function(filename) {
+    filename = this._translateURL(filename);
+    try {
+      return fs.statSync(filename).mtime.getTime();
+    } catch (e) {
+      return -1;
+    }
+  },
   _isExternalURL: function(filename) {
     return filename.substr(0, 4) === 'http' || filename.substr(0, 4) === 'ftp';
   },
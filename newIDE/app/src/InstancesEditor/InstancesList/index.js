@@ -23,27 +23,47 @@ export default class InstancesList extends Component {
 
   componentWillMount() {
     this.renderedRows = [];
+    this.internedNames = new gd.InternedNames();
+    this.instancesTransforms = new gd.InstancesTransforms();
+  }
+
+  componentWillUnmount() {
+    this.internedNames.delete();
+    this.instancesTransforms.delete();
+  }
+
+  _updateRenderedRows(instances) {
+    // The names of the objects (first, as it can grow the memory of libGD.js)
+    // and the transforms of all the instances are read at once.
+    const objectNames = this.internedNames.getInstanceObjectNames(instances);
+    const {
+      count,
+      floats,
+      ints,
+      instances: instancesPtrs,
+    } = this.instancesTransforms.getTransforms(instances);
+    const layerNames = [];
 
-    // Functor used to display an instance row
-    this.instanceRowRenderer = new gd.InitialInstanceJSFunctor();
-    this.instanceRowRenderer.invoke = instancePtr => {
-      const instance = gd.wrapPointer(instancePtr, gd.InitialInstance);
+    this.renderedRows.length = 0;
+    for (let i = 0; i < count; i++) {
+      const instance = gd.wrapPointer(instancesPtrs[i], gd.InitialInstance);
+      const layerHandle = ints[i * 2 + 1];
+      if (layerNames[layerHandle] === undefined)
+        layerNames[layerHandle] = this.instancesTransforms.getLayerName(
+          layerHandle
+        );
 
       this.renderedRows.push({
         instance,
-        name: instance.getObjectName(),
+        name: objectNames[i],
         locked: instance.isLocked() ? '🔒' : '',
-        x: instance.getX().toFixed(2),
-        y: instance.getY().toFixed(2),
-        angle: instance.getAngle().toFixed(2),
-        layer: instance.getLayer(),
-        zOrder: instance.getZOrder(),
+        x: floats[i * 3].toFixed(2),
+        y: floats[i * 3 + 1].toFixed(2),
+        angle: floats[i * 3 + 2].toFixed(2),
+        layer: layerNames[layerHandle],
+        zOrder: ints[i * 2],
       });
-    };
-  }
-
-  componentWillUnmount() {
-    this.instanceRowRenderer.delete();
+    }
   }
 
   _onRowClick = ({ index }) => {
@@ -70,8 +90,7 @@ export default class InstancesList extends Component {
   render() {
     const { instances } = this.props;
 
-    this.renderedRows.length = 0;
-    instances.iterateOverInstances(this.instanceRowRenderer);
+    this._updateRenderedRows(instances);
 
     // Force Table component to be mounted again if instances
     // has been changed. Avoid accessing to invalid objects that could
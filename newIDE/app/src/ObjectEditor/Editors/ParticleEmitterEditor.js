@@ -234,6 +234,35 @@ export default class ParticleEmitterEditor extends React.Component<
             }}
           />
         </Line>
+        <Line>
+          <Checkbox
+            label={<Trans>Pause the particles when off-screen</Trans>}
+            checked={particleEmitterObject.getSleepWhenOffScreen()}
+            onCheck={(e, checked) => {
+              particleEmitterObject.setSleepWhenOffScreen(checked);
+              this.forceUpdate();
+            }}
+          />
+        </Line>
+        <Line>
+          <Column expand noMargin>
+            <SemiControlledTextField
+              floatingLabelText={
+                <Trans>
+                  Distance from the screen at which the emission stops, in
+                  pixels (0 to never reduce the emission)
+                </Trans>
+              }
+              fullWidth
+              type="number"
+              value={particleEmitterObject.getLODDistance()}
+              onChange={value => {
+                particleEmitterObject.setLODDistance(parseFloat(value));
+                this.forceUpdate();
+              }}
+            />
+          </Column>
+        </Line>
         <Line>
           <Column expand noMargin>
             <SemiControlledTextField
@@ -1,5 +1,5 @@
 // @flow
-import { serializeToJSObject } from '../Utils/Serializer';
+import { serializeToJSObject, serializeToJSON } from '../Utils/Serializer';
 import optionalRequire from '../Utils/OptionalRequire.js';
 import {
   split,
@@ -9,23 +9,94 @@ import {
 const fs = optionalRequire('fs-extra');
 const path = optionalRequire('path');
 
+// The content last read or written for each file, so that files which are
+// unchanged (for example the layouts that were not edited in a split project)
+// are not written again. The content is compared, rather than the
+// modification counts of the project, as they don't cover all the changes.
+const lastWrittenContents: Map<string, string> = new Map();
+
+const readFileIfExists = (filepath: string): Promise<?string> =>
+  new Promise(resolve => {
+    fs.readFile(filepath, { encoding: 'utf8' }, (err, data) => {
+      resolve(err ? null : data);
+    });
+  });
+
+const isFileContentUnchanged = (
+  filepath: string,
+  content: string
+): Promise<boolean> => {
+  const lastWrittenContent = lastWrittenContents.get(filepath);
+  if (lastWrittenContent !== undefined) {
+    return Promise.resolve(lastWrittenContent === content);
+  }
+
+  // Compare with the file on disk the first time it is saved.
+  return readFileIfExists(filepath).then(data => {
+    if (data !== null && data !== undefined)
+      lastWrittenContents.set(filepath, data);
+    return data === content;
+  });
+};
+
+/**
+ * Write the content in a temporary file renamed to the file, so that the file
+ * is never left partially written.
+ */
+const writeFileAtomically = (
+  filepath: string,
+  content: string
+): Promise<void> => {
+  const temporaryFilepath = filepath + '.tmp';
+  return new Promise((resolve, reject) => {
+    fs.writeFile(temporaryFilepath, content, (err: ?Error) => {
+      if (err) {
+        return reject(err);
+      }
+
+      fs.rename(temporaryFilepath, filepath, (err: ?Error) => {
+        if (err) {
+          return reject(err);
+        }
+
+        return resolve();
+      });
+    });
+  });
+};
+
+// The autosaves being written, with the content of the next autosave to be
+// written once they are done (if the project was autosaved again meanwhile).
+const autoSavesInProgress: Map<string, ?string> = new Map();
+
+const writeAutoSave = (filepath: string, content: string) => {
+  autoSavesInProgress.set(filepath, null);
+  writeFileAtomically(filepath, content)
+    .catch(err => {
+      console.error(`Unable to write ${filepath}:`, err);
+    })
+    .then(() => {
+      const nextContent = autoSavesInProgress.get(filepath);
+      autoSavesInProgress.delete(filepath);
+      if (nextContent) writeAutoSave(filepath, nextContent);
+    });
+};
+
 const writeJSONFile = (object: Object, filepath: string): Promise<void> => {
   if (!fs) return Promise.reject(new Error('Filesystem is not supported.'));
 
   try {
     const content = JSON.stringify(object, null, 2);
-    return fs.ensureDir(path.dirname(filepath)).then(
-      () =>
-        new Promise((resolve, reject) => {
-          fs.writeFile(filepath, content, (err: ?Error) => {
-            if (err) {
-              return reject(err);
-            }
-
-            return resolve();
-          });
-        })
-    );
+    return isFileContentUnchanged(filepath, content).then(unchanged => {
+      if (unchanged) return;
+
+      return fs
+        .ensureDir(path.dirname(filepath))
+        .then(() => writeFileAtomically(filepath, content))
+        .then(() => {
+          lastWrittenContents.set(filepath, content);
+        });
+    });
   } catch (stringifyException) {
     return Promise.reject(stringifyException);
   }
@@ -81,10 +152,18 @@ export default class LocalProjectWriter {
   };
 
   static autoSaveProject = (project: gdProject) => {
+    if (!fs) return;
     const autoSavePath = project.getProjectFile() + '.autosave';
-    writeJSONFile(serializeToJSObject(project), autoSavePath).catch(err => {
-      console.error(`Unable to write ${autoSavePath}:`, err);
-      throw err;
-    });
+
+    // Only the serialization of the project is done before returning: the
+    // JSON (not indented, as the autosave is only read back by GDevelop) is a
+    // snapshot of the project, written in the background while editing goes
+    // on.
+    const content = serializeToJSON(project);
+    if (autoSavesInProgress.has(autoSavePath)) {
+      autoSavesInProgress.set(autoSavePath, content);
+    } else {
+      writeAutoSave(autoSavePath, content);
+    }
   };
 }
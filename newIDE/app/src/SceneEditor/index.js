@@ -764,9 +764,12 @@ export default class SceneEditor extends React.Component<Props, State> {
 
   deleteSelection = () => {
     const selectedInstances = this.instancesSelection.getSelectedInstances();
-    selectedInstances.map(instance =>
-      this.props.initialInstances.removeInstance(instance)
+    const instancesToRemove = new gd.VectorInitialInstance();
+    selectedInstances.forEach(instance =>
+      instancesToRemove.push_back(instance)
     );
+    this.props.initialInstances.removeInstances(instancesToRemove);
+    instancesToRemove.delete();
 
     this.instancesSelection.clearSelection();
     if (this.editor) this.editor.clearHighlightedInstance();
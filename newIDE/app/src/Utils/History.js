@@ -11,6 +11,79 @@ export type HistoryState = {|
   maxSize: number,
 |};
 
+/**
+ * Return `next`, with the parts that are equal to the ones of `previous`
+ * replaced by the parts of `previous` (or `previous` itself if both are equal).
+ *
+ * This is used so that the states stored in the history share all the parts
+ * that were not changed (usually almost all the events of a sheet): the memory
+ * used by the history is then proportional to the changes, and not to the
+ * size of the states. The states must never be mutated once in the history.
+ *
+ * `next` is mutated, so it must be a new object, not shared with anything.
+ */
+export const shareUnchangedParts = (previous: any, next: any): any => {
+  if (
+    previous === next ||
+    typeof previous !== 'object' ||
+    typeof next !== 'object' ||
+    previous === null ||
+    next === null ||
+    Array.isArray(previous) !== Array.isArray(next)
+  ) {
+    return next;
+  }
+
+  if (Array.isArray(next)) {
+    return shareUnchangedItems(previous, next);
+  }
+
+  const keys = Object.keys(next);
+  let allShared = keys.length === Object.keys(previous).length;
+  keys.forEach(key => {
+    if (!previous.hasOwnProperty(key)) {
+      allShared = false;
+      return;
+    }
+
+    next[key] = shareUnchangedParts(previous[key], next[key]);
+    if (next[key] !== previous[key]) allShared = false;
+  });
+
+  return allShared ? previous : next;
+};
+
+const shareUnchangedItems = (previous: Array<any>, next: Array<any>) => {
+  // Compare the items from the start and from the end, so that the items
+  // are still shared after one or more items were inserted or removed
+  // (for example, when an event is added or deleted).
+  let start = 0;
+  while (start < previous.length && start < next.length) {
+    next[start] = shareUnchangedParts(previous[start], next[start]);
+    if (next[start] !== previous[start]) break;
+    start++;
+  }
+  if (start === previous.length && start === next.length) return previous;
+
+  let previousEnd = previous.length;
+  let nextEnd = next.length;
+  while (previousEnd > start && nextEnd > start) {
+    next[nextEnd - 1] = shareUnchangedParts(
+      previous[previousEnd - 1],
+      next[nextEnd - 1]
+    );
+    if (next[nextEnd - 1] !== previous[previousEnd - 1]) break;
+    previousEnd--;
+    nextEnd--;
+  }
+
+  for (let i = start + 1; i < previousEnd && i < nextEnd; i++) {
+    next[i] = shareUnchangedParts(previous[i], next[i]);
+  }
+
+  return next;
+};
+
 /**
  * Return the initial state of the history
  * @param {*} serializableObject
@@ -59,7 +132,10 @@ export const saveToHistory = (
 
   return {
     undoHistory: newUndoHistory,
-    current: serializeToJSObject(serializableObject),
+    current: shareUnchangedParts(
+      history.current,
+      serializeToJSObject(serializableObject)
+    ),
     redoHistory: [],
     maxSize: history.maxSize,
   };
@@ -85,6 +85,36 @@ describe('History', () => {
     expect(testLayout.getWindowDefaultTitle()).toBe('New name 1');
   });
 
+  it('shares the unchanged parts between the saved states', () => {
+    const events = new gd.EventsList();
+    for (let i = 0; i < 3; i++) {
+      events.insertNewEvent(project, 'BuiltinCommonInstructions::Standard', i);
+    }
+    let history = getHistoryInitialState(events, { historyMaxSize: 50 });
+    const originalState = history.current;
+
+    history = saveToHistory(history, events);
+    expect(history.current).toBe(originalState);
+
+    events.insertNewEvent(project, 'BuiltinCommonInstructions::Comment', 1);
+    history = saveToHistory(history, events);
+    expect(history.current).not.toBe(originalState);
+    expect(history.current).toHaveLength(4);
+    expect(history.current[0]).toBe(originalState[0]);
+    expect(history.current[1].type).toBe('BuiltinCommonInstructions::Comment');
+    expect(history.current[2]).toBe(originalState[1]);
+    expect(history.current[3]).toBe(originalState[2]);
+
+    history = undo(history, events, project);
+    expect(events.getEventsCount()).toBe(3);
+    history = redo(history, events, project);
+    expect(events.getEventsCount()).toBe(4);
+    expect(events.getEventAt(1).getType()).toBe(
+      'BuiltinCommonInstructions::Comment'
+    );
+    events.delete();
+  });
+
   it('is limited to the maximum specified size', () => {
     const gdVariable = new gd.Variable();
 
@@ -22,6 +22,27 @@ export function serializeToJSObject(
   return object;
 }
 
+/**
+ * Tool function to save a serializable object to a JSON string.
+ * This is faster than serializeToJSObject when the object is only written
+ * (the JSON is not parsed), and the string is an immutable snapshot of
+ * the serializable that can be used while it is modified.
+ *
+ * @param {*} serializable
+ * @param {*} methodName The name of the serialization method. "serializeTo" by default
+ */
+export function serializeToJSON(
+  serializable: gdSerializable,
+  methodName: string = 'serializeTo'
+): string {
+  const serializedElement = new gd.SerializerElement();
+  serializable[methodName](serializedElement);
+  const json = gd.Serializer.toJSON(serializedElement);
+  serializedElement.delete();
+
+  return json;
+}
+
 /**
  * Tool function to restore a serializable object from a JS object.
  * Most gd.* objects are "serializable", meaning they have a serializeTo
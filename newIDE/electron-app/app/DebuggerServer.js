@@ -1,14 +1,56 @@
 const WebSocket = require('ws');
+const net = require('net');
 const log = require('electron-log');
+const NativeProfilerStream = require('./NativeProfilerStream');
 
 let wsServer = null;
+let nativeProfilerServer = null;
 let webSockets = [];
 
 const closeServer = () => {
+  if (nativeProfilerServer) nativeProfilerServer.close();
   wsServer = null;
+  nativeProfilerServer = null;
   webSockets = [];
 };
 
+/**
+ * Listen to the native games sending their profiler frames (see
+ * FrameProfilerStream in GDCpp). They are seen as debugger connections
+ * sending only "profiler.frames" messages: no message can be sent to them.
+ */
+const startNativeProfilerServer = options => {
+  nativeProfilerServer = net.createServer(socket => {
+    const id = webSockets.length;
+    webSockets.push(null);
+    log.info(`Native profiler connection #${id} opened.`);
+
+    const stream = new NativeProfilerStream(message => {
+      options.onMessage({ id, message: JSON.stringify(message) });
+    });
+    socket.on('data', data => {
+      try {
+        stream.receive(data);
+      } catch (error) {
+        log.error(`Native profiler connection #${id} sent bad data.`, error);
+        socket.destroy();
+      }
+    });
+    socket.on('close', () => {
+      log.info(`Native profiler connection #${id} closed.`);
+      options.onConnectionClose({ id });
+    });
+    socket.on('error', () => {});
+
+    options.onConnectionOpen({ id });
+  });
+
+  nativeProfilerServer.on('error', error => {
+    log.error('Native profiler server errored.', error);
+  });
+  nativeProfilerServer.listen(3031);
+};
+
 /**
  * This module creates a WebSocket server listening for a connection
  * and simply forwards the messages.
@@ -45,6 +87,7 @@ module.exports = {
 
     wsServer.on('listening', () => {
       log.info('Debugger listening for connections.');
+      startNativeProfilerServer(options);
       options.onListening();
     });
 
@@ -0,0 +1,170 @@
+/**
+ * Decode the messages sent by FrameProfilerStream (in GDCpp) into the
+ * same frames measures as the ones sent by the profiler of GDJS, so that
+ * the Debugger (in newIDE) displays native games like web games.
+ */
+
+// The phases of FrameProfiler (see FrameProfiler::GetPhaseName),
+// in the order of FrameProfiler::Phase.
+const phasesNames = [
+  'Window events',
+  'Objects before events',
+  'Sounds garbage collection',
+  'Events',
+  'Objects after events',
+  'Rendering',
+];
+// The memory categories of gd::SystemStats, in the order of
+// SystemStats::MemoryCategory.
+const memoryCategoriesNames = [
+  'Textures',
+  'Sounds',
+  'Objects',
+  'Variables',
+  'Particle systems',
+  'Physics',
+];
+const behaviorsPhases = {
+  preEvents: 'Objects before events',
+  postEvents: 'Objects after events',
+};
+
+/**
+ * Read the data written by a SceneSnapshotWriter.
+ */
+class SnapshotReader {
+  constructor(buffer) {
+    this.buffer = buffer;
+    this.position = 0;
+  }
+
+  readUInt() {
+    let value = 0;
+    let multiplier = 1;
+    while (this.position < this.buffer.length) {
+      const byte = this.buffer[this.position++];
+      value += (byte & 0x7f) * multiplier;
+      if (!(byte & 0x80)) return value;
+      multiplier *= 128;
+    }
+    throw new Error('Unexpected end of profiler message');
+  }
+
+  readInt() {
+    // Zigzag encoding (see SceneSnapshotWriter::WriteInt).
+    const value = this.readUInt();
+    return value % 2 ? -(value + 1) / 2 : value / 2;
+  }
+
+  readBool() {
+    if (this.position >= this.buffer.length)
+      throw new Error('Unexpected end of profiler message');
+    return this.buffer[this.position++] !== 0;
+  }
+
+  readString() {
+    const length = this.readUInt();
+    if (this.position + length > this.buffer.length)
+      throw new Error('Unexpected end of profiler message');
+    const value = this.buffer.toString(
+      'utf8',
+      this.position,
+      this.position + length
+    );
+    this.position += length;
+    return value;
+  }
+}
+
+const microsecondsToMilliseconds = time => time / 1000;
+
+/**
+ * Split the data received from a native game in messages and decode them.
+ * @param {(message: Object) => void} onMessage Called with each decoded message.
+ */
+class NativeProfilerStream {
+  constructor(onMessage) {
+    this.onMessage = onMessage;
+    this.pendingData = Buffer.alloc(0);
+    this.behaviorsNames = [];
+  }
+
+  /**
+   * To be called with the data received on the socket.
+   */
+  receive(data) {
+    this.pendingData = Buffer.concat([this.pendingData, data]);
+
+    // Messages are blocks: their size on 4 bytes, then their content.
+    while (this.pendingData.length >= 4) {
+      const size = this.pendingData.readUInt32LE(0);
+      if (this.pendingData.length < 4 + size) return;
+
+      const message = this.pendingData.slice(4, 4 + size);
+      this.pendingData = this.pendingData.slice(4 + size);
+      this.onMessage(this._decodeMessage(message));
+    }
+  }
+
+  _decodeMessage(message) {
+    const reader = new SnapshotReader(message);
+    if (reader.readBool()) this.behaviorsNames = [];
+
+    const newBehaviorsNamesCount = reader.readUInt();
+    for (let i = 0; i < newBehaviorsNamesCount; ++i)
+      this.behaviorsNames.push(reader.readString());
+
+    const frames = [];
+    const framesCount = reader.readUInt();
+    for (let i = 0; i < framesCount; ++i) {
+      const frame = reader.readUInt();
+      reader.readInt(); // Start time
+      const measures = {
+        time: microsecondsToMilliseconds(reader.readInt()),
+        subsections: {},
+      };
+      phasesNames.forEach(phaseName => {
+        measures.subsections[phaseName] = {
+          time: microsecondsToMilliseconds(reader.readInt()),
+          subsections: {},
+        };
+      });
+
+      const behaviorsCount = reader.readUInt();
+      for (let j = 0; j < behaviorsCount; ++j) {
+        const name = this.behaviorsNames[reader.readUInt()] || '?';
+        const phaseName = reader.readBool()
+          ? behaviorsPhases.postEvents
+          : behaviorsPhases.preEvents;
+        reader.readUInt(); // Calls count
+        measures.subsections[phaseName].subsections[name] = {
+          time: microsecondsToMilliseconds(reader.readInt()),
+          subsections: {},
+        };
+      }
+
+      frames.push({ frame, measures });
+    }
+
+    const objectsCount = reader.readUInt();
+    const scratchArenaCapacity = reader.readUInt();
+    const memory = {};
+    const memoryCategoriesCount = reader.readUInt();
+    for (let i = 0; i < memoryCategoriesCount; ++i) {
+      memory[memoryCategoriesNames[i] || `Category ${i}`] = {
+        used: reader.readUInt(),
+        highWaterMark: reader.readUInt(),
+      };
+    }
+
+    return {
+      command: 'profiler.frames',
+      payload: {
+        frames,
+        stats: { objectsCount, scratchArenaCapacity, memory },
+      },
+    };
+  }
+}
+
+module.exports = NativeProfilerStream;